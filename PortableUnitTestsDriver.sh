@@ -10,6 +10,9 @@
 # The COMPILER environment variable can be used to specify
 # a different compiler, eg g++-4.9.
 #
+# The SHARDS environment variable sets how many gtest shards
+# are run in parallel (default the number of CPUs).
+#
 # Intended to be run without arguments from top-level dir of project.
 #
 # Run as:
@@ -41,12 +44,18 @@ GLIBDIRS="-L/usr/local/lib"
 GINCLUDES="-I/usr/local/include"
 # Source includes (paths).
 INCLUDES="-I${PROJSRCROOT} -I${PROJSRCROOT}/utility -I${TESTSRCDIR}"
+# Host-only harnesses shared with the tests.
+INCLUDES="${INCLUDES} -IportableFuzz -IportableGateway"
 
 #echo "Using test sources: $TESTSRCS"
 #echo "Using project sources: $PROJSRCS"
 
 EXTRACPPFLAGS=
 
+# Ambient light occupancy sample data sets, by absolute path
+# so that the tests can be run from any directory.
+ALOCCSAMPLESDIR="`pwd`/${TESTSRCDIR}/AmbientLightOccupancyData"
+
 # If OTAESGCM code is present, add it to the source path,
 # and set the flag to allow the extra tests based on it.
 # Try via a the 'unpacked master' path first, then a relative path.
@@ -68,16 +77,34 @@ else
 fi
 
 rm -f ${EXENAME}
-if ${COMPILER:-g++} -o ${EXENAME} -std=c++0x -O0 -Wall -Werror -fstack-check -fstack-protector-strong ${EXTRACPPFLAGS} ${INCLUDES} ${GINCLUDES} ${PROJSRCS} ${TESTSRCS} ${GLIBDIRS} ${GLIBS} ${OTHERLIBS} ; then
+if ${COMPILER:-g++} -o ${EXENAME} -std=c++0x -O0 -pthread -Wall -Werror -fstack-check -fstack-protector-strong ${EXTRACPPFLAGS} -DOTRL_ALOCC_SAMPLES_DIR="\"${ALOCCSAMPLESDIR}\"" ${INCLUDES} ${GINCLUDES} ${PROJSRCS} ${TESTSRCS} ${GLIBDIRS} ${GLIBS} ${OTHERLIBS} ; then
     echo Compiled.
 else
     echo Failed to compile.
     exit 2
 fi
 
+# Number of gtest shards to run in parallel; defaults to the number of CPUs.
+SHARDS=${SHARDS:-`getconf _NPROCESSORS_ONLN 2>/dev/null || echo 4`}
+
+# Run the test executable with the given arguments as SHARDS parallel gtest shards.
+# Fails if any shard fails.
+runsharded() {
+    PIDS=
+    i=0
+    while [ $i -lt ${SHARDS} ]; do
+        GTEST_TOTAL_SHARDS=${SHARDS} GTEST_SHARD_INDEX=$i ./${EXENAME} "$@" &
+        PIDS="${PIDS} $!"
+        i=`expr $i + 1`
+    done
+    STATUS=0
+    for p in ${PIDS}; do wait $p || STATUS=1; done
+    return ${STATUS}
+}
+
 # Run the tests, repeatedly, shuffled (except first run to make diffs easier).
 # Run in increasingly large blocks.
-./${EXENAME} --gtest_repeat=1 \
-  && ./${EXENAME} --gtest_shuffle --gtest_repeat=10 \
-  && ./${EXENAME} --gtest_shuffle --gtest_repeat=100 \
+runsharded --gtest_repeat=1 \
+  && runsharded --gtest_shuffle --gtest_repeat=10 \
+  && runsharded --gtest_shuffle --gtest_repeat=100 \
   && echo OK
@@ -1,28 +1,32 @@
-/*
-The OpenTRV project licenses this file to you
-under the Apache Licence, Version 2.0 (the "Licence");
-you may not use this file except in compliance
-with the Licence. You may obtain a copy of the Licence at
-
-http://www.apache.org/licenses/LICENSE-2.0
-
-Unless required by applicable law or agreed to in writing,
-software distributed under the Licence is distributed on an
-"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
-KIND, either express or implied. See the Licence for the
-specific language governing permissions and limitations
-under the Licence.
-
-Author(s) / Copyright (s): Damon Hart-Davis 2015
-*/
-
-#ifndef ARDUINO_LIB_OTRFM23BLINK_H
-#define ARDUINO_LIB_OTRFM23BLINK_H
-
-#define ARDUINO_LIB_OTRFM23BLINK_VERSION_MAJOR 3
-#define ARDUINO_LIB_OTRFM23BLINK_VERSION_MINOR 0
-
-// RFM23B support.
-#include "utility/OTRFM23BLink_OTRFM23BLink.h"
-
-#endif
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2015
+*/
+
+#ifndef ARDUINO_LIB_OTRFM23BLINK_H
+#define ARDUINO_LIB_OTRFM23BLINK_H
+
+#define ARDUINO_LIB_OTRFM23BLINK_VERSION_MAJOR 3
+#define ARDUINO_LIB_OTRFM23BLINK_VERSION_MINOR 0
+
+// RFM23B support.
+#include "utility/OTRFM23BLink_OTRFM23BLink.h"
+// SPI transport for the RFM23B register protocol, eg with DMA on EFR32.
+#include "utility/OTRFM23BLink_SPITransport.h"
+// Compile-time register tables for FSK/GFSK channels.
+#include "utility/OTRFM23BLink_RegConfig.h"
+
+#endif
@@ -34,21 +34,39 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015--2016
 // Simple valve programmer/scheduler.
 #include "utility/OTRadValve_SimpleValveSchedule.h"
 
+// Learned room warm-up rate for predictive pre-warming.
+#include "utility/OTRadValve_WarmupRateEstimator.h"
+
 // Temperature control/setting for OpenTRV thermostatic radiator valve.
 #include "utility/OTRadValve_TempControl.h"
 
+// Table of per-room valve control parameter profiles.
+#include "utility/OTRadValve_ValveControlProfiles.h"
+
 // Abstract/base interface for basic (thermostatic) radiator valves.
 #include "utility/OTRadValve_AbstractRadValve.h"
 
 // OpenTRV model and smart control of (thermostatic) radiator valve.
 #include "utility/OTRadValve_ModelledRadValve.h"
 
+// Several modelled valves in one room driven from one board.
+#include "utility/OTRadValve_ModelledRadValveMulti.h"
+
+// Many modelled valve states advanced together, eg for simulation or hub-side modelling.
+#include "utility/OTRadValve_ModelledRadValveStateBatch.h"
+
+// Hub-pushed valve setpoint and mode commands.
+#include "utility/OTRadValve_ValveCommand.h"
+
 // Physical valve control UI, treated as an actuator.
 #include "utility/OTRadValve_ActuatorPhysicalUI.h"
 
 // Driver for FHT8V wireless valve actuator (and FS20 protocol encode/decode).
 #include "utility/OTRadValve_FHT8VRadValve.h"
 
+// Many FHT8V valves (house codes) interleaved on one radio.
+#include "utility/OTRadValve_FHT8VMultiValve.h"
+
 // Hardware-independent logic for direct proportional valve motor drive..
 #include "utility/OTRadValve_CurrentSenseValveMotorDirect.h"
 
@@ -64,6 +82,9 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015--2016
 // Driver for boiler.
 #include "utility/OTRadValve_BoilerDriver.h"
 
+// Weather-compensated flow temperature target for a modulating boiler.
+#include "utility/OTRadValve_FlowTemperature.h"
+
 // Test motor driver
 #include "utility/OTRadValve_TestValve.h"
 
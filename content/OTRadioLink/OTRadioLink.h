@@ -28,11 +28,41 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015--2016
 #include "utility/OTRadioLink_FrameType.h"
 #include "utility/OTRadioLink_SecureableFrameType.h"
 #include "utility/OTRadioLink_SecureableFrameType_V0p2Impl.h"
+#include "utility/OTRadioLink_SecureableFrameType_HWCrypto.h"
 #include "utility/OTRadioLink_Messaging.h"
 
 // Radio Link base class definition.
 #include "utility/OTRadioLink_OTRadioLink.h"
 
+// Simple fixed-size TX frame queue for radio drivers.
+#include "utility/OTRadioLink_TXQueue.h"
+
+// Batching of frames from several nodes into one uplink message.
+#include "utility/OTRadioLink_UplinkBatch.h"
+
+// Suppression of re-relaying recently-relayed frames.
+#include "utility/OTRadioLink_RelayDedup.h"
+
+// Compact framed binary hub-to-gateway serial output.
+#include "utility/OTRadioLink_HubBinaryOutput.h"
+
+// Hub table of when each associated node was last heard.
+#include "utility/OTRadioLink_NodeLastSeen.h"
+
+// Optional hub-coordinated TX time slots for node stats.
+#include "utility/OTRadioLink_TXSlots.h"
+
+// Per-destination adaptive TX power from link-quality feedback.
+#include "utility/OTRadioLink_TXPowerControl.h"
+
+// Stats TX interval adapting to value changes and hub backpressure.
+#include "utility/OTRadioLink_StatsTXRate.h"
+// Acknowledged secure frame delivery with retransmit backoff.
+#include "utility/OTRadioLink_SecureAck.h"
+
+// Compile-time composable quick RX frame filters.
+#include "utility/OTRadioLink_FrameFilter.h"
+
 // Radio Link Null class definition.
 #include "utility/OTRadioLink_OTNullRadioLink.h"
 
@@ -58,15 +58,33 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015--2016
 
 // Hardware tests, eg as used in POST (Power On Self Test).
 #include "utility/OTV0P2BASE_HardwareTests.h"
+// Continuous RC oscillator calibration against the RTC crystal.
+#include "utility/OTV0P2BASE_OscCalibration.h"
 
 // Some basic utility functions and definitions.
 #include "utility/OTV0P2BASE_Util.h"
+// Fast integer to ASCII formatting for stats and status output.
+#include "utility/OTV0P2BASE_FastFormat.h"
 
 // EEPROM space allocation and utilities.
 #include "utility/OTV0P2BASE_EEPROM.h"
+// Batched and wear-levelled EEPROM updates.
+#include "utility/OTV0P2BASE_EEPROMJournal.h"
+// Persistent binary error/event log (OT_EVENT()).
+#include "utility/OTV0P2BASE_EventLog.h"
+// EEPROM-layout tables over any byte store, and host EEPROM image files.
+#include "utility/OTV0P2BASE_EEPROMImage.h"
+// Host-side playback of recorded sensor time series into mocks.
+#include "utility/OTV0P2BASE_TimeSeriesPlayback.h"
+// EEPROM emulation in flash, eg for EFR32.
+#include "utility/OTV0P2BASE_FlashEEPROM.h"
+// Long-term time-series log on external SPI NOR flash.
+#include "utility/OTV0P2BASE_SPIFlashTimeSeries.h"
 
 // Simple rolling stats management.
 #include "utility/OTV0P2BASE_Stats.h"
+// Compact in-RAM per-minute sensor history.
+#include "utility/OTV0P2BASE_SensorHistory.h"
 
 // Quick/simple PRNG (Pseudo-Random Number Generator).
 #include "utility/OTV0P2BASE_QuickPRNG.h"
@@ -91,13 +109,42 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015--2016
 #include "utility/OTV0P2BASE_SensorDS18B20.h"
 #include "utility/OTV0P2BASE_SensorQM1.h"
 #include "utility/OTV0P2BASE_SensorOccupancy.h"
+// Weighted fusion of occupancy evidence from several sources.
+#include "utility/OTV0P2BASE_OccupancyFusion.h"
+#include "utility/OTV0P2BASE_PinChangeCapture.h"
+// Debounced interrupt-driven button events and non-blocking LED patterns.
+#include "utility/OTV0P2BASE_ButtonEvents.h"
+#include "utility/OTV0P2BASE_LEDPattern.h"
+#include "utility/OTV0P2BASE_SensorScheduler.h"
+// Cooperative task runner scheduled by sub-cycle time.
+#include "utility/OTV0P2BASE_CycleTaskRunner.h"
+// Resumable (protothread-style) tasks for non-blocking driver sequences.
+#include "utility/OTV0P2BASE_ResumableTask.h"
+// Staged boot with step dependencies and urgency.
+#include "utility/OTV0P2BASE_BootSequencer.h"
+// Wake-time profiling marks and accounting.
+#include "utility/OTV0P2BASE_WakeProfile.h"
+// Low-overhead ring-buffer tracing (OT_TRACE()).
+#include "utility/OTV0P2BASE_Trace.h"
+// Interrupt-masking and ISR latency marks and measurement.
+#include "utility/OTV0P2BASE_ISRLatency.h"
 
 // Basic immutable GPIO assignments and similar.
 #include "utility/OTV0P2BASE_BasicPinAssignments.h"
+// Compile-time board/feature descriptors.
+#include "utility/OTV0P2BASE_BoardConfig.h"
 
 // Power, micro timing, I/O management and other misc support.
 #include "utility/OTV0P2BASE_Sleep.h"
 #include "utility/OTV0P2BASE_PowerManagement.h"
+// Power-state accounting: on-time per peripheral and per CPU state.
+#include "utility/OTV0P2BASE_PowerAccounting.h"
+// Supply current budget to stagger motor, radio TX and LED loads.
+#include "utility/OTV0P2BASE_CurrentBudget.h"
+// Battery state estimate and energy policy level.
+#include "utility/OTV0P2BASE_BatteryPolicy.h"
+// Reduced CPU clock for compute bursts, full speed for timing-critical code.
+#include "utility/OTV0P2BASE_CPUClockPolicy.h"
 
 // Software Real-Time Clock (RTC) support.
 #include "utility/OTV0P2BASE_RTC.h"
@@ -107,12 +154,17 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015--2016
 
 // Basic security support.
 #include "utility/OTV0P2BASE_Security.h"
+#include "utility/OTV0P2BASE_NodeAssociationStore.h"
+#include "utility/OTV0P2BASE_Provisioning.h"
 
 // Entropy management.
 #include "utility/OTV0P2BASE_Entropy.h"
+#include "utility/OTV0P2BASE_EntropyPool.h"
 
 // Serial IO (hardware Serial + debug support).
 #include "utility/OTV0P2BASE_Serial_IO.h"
+// Serial TX ring drained by ISR or non-blocking pump.
+#include "utility/OTV0P2BASE_SerialTXRing.h"
 // Soft Serial.
 #include "utility/OTV0P2BASE_SoftSerial.h"
 #include "utility/OTV0P2BASE_SoftSerial2.h"
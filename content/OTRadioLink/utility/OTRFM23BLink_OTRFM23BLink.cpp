@@ -44,6 +44,13 @@ void OTRFM23BLinkBase::setMaxTypicalFrameBytes(const uint8_t _maxTypicalFrameByt
     maxTypicalFrameBytes = max(1, min(_maxTypicalFrameBytes, 63));
     }
 
+// Set duty-cycled (wake-on-radio) RX for listening, or continuous RX if config is NULL or disabled.
+void OTRFM23BLinkBase::setRXDutyCycle(const RFM23BLowDutyCycleConfig *const config)
+    {
+    rxDutyCycle = (NULL == config) ? RFM23BLowDutyCycleConfig() : *config;
+    if(-1 != getListenChannel()) { _dolisten(); }
+    }
+
 // Returns true if RFM23 appears to be correctly connected.
 bool OTRFM23BLinkBase::_checkConnected() const
     {
@@ -83,6 +90,10 @@ void OTRFM23BLinkBase::_registerBlockSetup(const uint8_t registerValues[][2])
     ATOMIC_BLOCK (ATOMIC_RESTORESTATE)
         {
         const bool neededEnable = _upSPI_();
+        // Runs of consecutive registers are written as a single burst,
+        // relying on the RFM23B auto-incrementing the address within one select cycle.
+        bool selected = false;
+        uint8_t nextReg = 0;
         for( ; ; )
             {
             const uint8_t reg = pgm_read_byte(&(registerValues[0][0]));
@@ -95,9 +106,20 @@ void OTRFM23BLinkBase::_registerBlockSetup(const uint8_t registerValues[][2])
             V0P2BASE_DEBUG_SERIAL_PRINTFMT(val, HEX);
             V0P2BASE_DEBUG_SERIAL_PRINTLN();
 #endif
-            _writeReg8Bit_(reg, val);
+            // Start a new burst unless this register follows on from the previous one.
+            // (The FIFO address does not auto-increment so never extend a burst past it.)
+            if(!selected || (reg != nextReg) || (REG_FIFO == reg))
+                {
+                if(selected) { _DESELECT_(); }
+                _SELECT_();
+                _wr(reg | 0x80); // Force to write.
+                selected = true;
+                }
+            _wr(val);
+            nextReg = reg + 1;
             ++registerValues;
             }
+        if(selected) { _DESELECT_(); }
         if(neededEnable) { _downSPI_(); }
         }
     }
@@ -128,7 +150,7 @@ void OTRFM23BLinkBase::_queueFrameInTXFIFO(const uint8_t *bptr, uint8_t buflen)
         // Select RFM23B for duration of batch/burst write.
         _SELECT_();
         _wr(REG_FIFO | 0x80); // Start burst write to TX FIFO.
-        while(buflen-- > 0) { _wr(*bptr++); }
+        _wrn(bptr, buflen);
         // Burst write finished; deselect RFM23B.
         _DESELECT_();
 
@@ -195,6 +217,8 @@ bool OTRFM23BLinkBase::_TXFIFO()
  *   first byte of the buffer MUST be the leading length byte, else the RX 
  *   packet handler will not be able to deduce the correct packet length.
  * - At, TXmax will do double TX with 15ms sleep/IDLE mode between.
+ * - TXquiet and TXmin lower the TX power below that configured for the
+ *   channel; see RFM23BTXPowerReg().
  * 
  * @param   buf: Buffer to hold the packet to send. The first byte MUST be the
  *          leading length byte.
@@ -212,18 +236,72 @@ bool OTRFM23BLinkBase::_TXFIFO()
  */
 bool OTRFM23BLinkBase::sendRaw(const uint8_t *const buf, const uint8_t buflen, const int8_t channel, const TXpower power, const bool /*listenAfter*/)
     {
-    // FIXME: currently ignores all hints.
+    // Refuse rather than overlap another high-current load such as a motor run.
+    const OTV0P2BASE::CurrentBudgetClaim supplyClaim(OTV0P2BASE::CurrentLoad::RADIO_TX);
+    if(!supplyClaim.isGranted()) { return(false); }
+
+    // Listen first if set up to, but send anyway if the channel stays busy.
+    _waitForClearChannel(channel);
+    const bool result = _sendRawNoListen(buf, buflen, channel, power, false);
+    // TODO: listen-after-send if requested.
+
+    // Revert to RX mode if listening, else go to standby to save energy.
+    _dolisten();
+
+    return(result);
+    }
+
+// If listen-before-talk is enabled for the channel
+// then wait (with randomised backoff) for it to be clear, up to the configured retries.
+// Leaves the radio in standby.
+bool OTRFM23BLinkBase::_waitForClearChannel(const int8_t channel)
+    {
+    if(!lbt.isEnabledFor(channel)) { return(true); }
+    for(uint8_t attempt = 0; ; ++attempt)
+        {
+        _modeStandbyAndClearState_();
+        _setChannel(channel);
+        _modeRX_();
+        // Allow the AGC and RSSI to settle.
+        OTV0P2BASE_busy_spin_delay(500);
+        const bool neededEnable = _upSPI_();
+        const uint8_t rssi = _readReg8Bit_(REG_RSSI);
+        if(neededEnable) { _downSPI_(); }
+        _modeStandbyAndClearState_();
+        if(lbtNoiseFloor.isClear(rssi, lbt.marginRSSI)) { return(true); }
+        if(attempt >= lbt.maxRetries) { return(false); }
+        for(uint8_t n = lbt.backoffSlots(OTV0P2BASE::randRNG8()); n > 0; --n)
+            {
+#ifndef OTV0P2BASE_IDLE_NOT_RECOMMENDED
+            ::OTV0P2BASE::_idleCPU(WDTO_15MS, false);
+#else
+            ::OTV0P2BASE::nap(WDTO_15MS);
+#endif
+            }
+        }
+    }
+
+// Send/TX a raw frame as for sendRaw() but leave the radio in standby afterwards.
+// If backToBack is true then the radio is assumed to be already
+// in standby on the given channel from a previous call to this,
+// so the mode switch and channel setup are skipped.
+bool OTRFM23BLinkBase::_sendRawNoListen(const uint8_t *const buf, const uint8_t buflen, const int8_t channel, const TXpower power, const bool backToBack)
+    {
+    _statsTXAttempt(channel);
 
     // Should not need to lock out interrupts while sending
     // as no poll()/ISR should start until this completes,
     // but will need to stop any RX in process,
     // eg to avoid TX FIFO buffer being zapped during RX handling.
 
-    // Disable all interrupts (eg to avoid invoking the RX handler).
-    _modeStandbyAndClearState_();
+    if(!backToBack)
+        {
+        // Disable all interrupts (eg to avoid invoking the RX handler).
+        _modeStandbyAndClearState_();
 
-    // Transmit on the channel specified.
-    _setChannel(channel);
+        // Transmit on the channel specified.
+        _setChannel(channel);
+        }
 
 //    // Disable all interrupts (eg to avoid invoking the RX handler).
 //    _modeStandbyAndClearState_();
@@ -236,10 +314,15 @@ bool OTRFM23BLinkBase::sendRaw(const uint8_t *const buf, const uint8_t buflen, c
     // Check if packet handling in RFM23B is enabled and set packet length
     if(_readReg8Bit_(REG_30_DATA_ACCESS_CONTROL) & RFM23B_ENPACTX)
        { _writeReg8Bit_(REG_3E_PACKET_LENGTH, buflen); }
+    // Turn the power down for quieter hints, restoring the configured power after.
+    const uint8_t txPowerConfigured = _readReg8Bit_(REG_TX_POWER);
+    const uint8_t txPowerReg = RFM23BTXPowerReg(txPowerConfigured, power);
+    if(txPowerReg != txPowerConfigured) { _writeReg8Bit_(REG_TX_POWER, txPowerReg); }
     if(neededEnable) { _downSPI_(); }
 
     // Send the frame once.
     bool result = _TXFIFO();
+    _recordTX(channel, buflen);
     // For maximum 'power' attempt to resend the frame again after a short delay.
     if(power >= TXmax)
         {
@@ -253,11 +336,15 @@ bool OTRFM23BLinkBase::sendRaw(const uint8_t *const buf, const uint8_t buflen, c
 
         // Resend the frame.
         if(!_TXFIFO()) { result = false; }
+        _recordTX(channel, buflen);
         }
-    // TODO: listen-after-send if requested.
 
-    // Revert to RX mode if listening, else go to standby to save energy.
-    _dolisten();
+    if(txPowerReg != txPowerConfigured)
+        {
+        const bool neededEnableRestore = _upSPI_();
+        _writeReg8Bit_(REG_TX_POWER, txPowerConfigured);
+        if(neededEnableRestore) { _downSPI_(); }
+        }
 
     return(result);
     }
@@ -302,8 +389,9 @@ void OTRFM23BLinkBase::_dolisten()
         // Enable requested RX-related interrupts.
         // Do this regardless of hardware interrupt support on the board.
         // Check if packet handling in RFM23B is enabled and enable interrupts accordingly.
-        if ( _readReg8Bit_(REG_30_DATA_ACCESS_CONTROL) & RFM23B_ENPACRX )  {
-           _writeReg8Bit_(REG_INT_ENABLE1, RFM23B_ENPKVALID);
+        const uint8_t dac = _readReg8Bit_(REG_30_DATA_ACCESS_CONTROL);
+        if ( dac & RFM23B_ENPACRX )  {
+           _writeReg8Bit_(REG_INT_ENABLE1, RFM23BPacketIRQEnable1(dac));
            _writeReg8Bit_(REG_INT_ENABLE2, 0);
            if ((_readReg8Bit_(REG_33_HEADER_CONTROL2) & RFM23B_FIXPKLEN ) == RFM23B_FIXPKLEN )
               _writeReg8Bit_(REG_3E_PACKET_LENGTH, maxTypicalFrameBytes);
@@ -818,6 +906,122 @@ const uint8_t StandardRegSettingsGFSK57600[][2] PROGMEM =
    { 0xff, 0xff } // End of settings.
   };
 
+// Full register settings for 868.5MHz (EU band 48) GFSK 57.6kbps.
+// Full config including all default values, so safe for dynamic switching.
+// As StandardRegSettingsGFSK57600 but with the hardware CRC-16 (IBM) on,
+// so frames that fail it are dropped by the radio before any FIFO read.
+// The CRC is not compatible with receivers using StandardRegSettingsGFSK57600.
+const uint8_t StandardRegSettingsGFSK57600CRC[][2] PROGMEM =
+  {
+//   Reg ,  Val       Default R/W   Function/Desc                       Comment
+//
+//   0x00,  N/A        0x08    R  - Device Type
+//   0x01,  N/A        0x06    R  - Device Version
+//   0x02,  N/A         --     R  - Device Status
+//   0x03,  N/A         --     R  - Interrupt Status 1
+//   0x04,  N/A         --     R  - Interrupt Status 2
+   { 0x05,    0 }, //  0x00   R/W - Interrupt Enable 1:                  Interrupts are enabled in FW later on
+   { 0x06,    0 }, //  0x03   R/W - Interrupt Enable 2
+   { 0x07,    1 }, //  0x01   R/W - Operating &Function Control 1:       XTON
+   { 0x08,    0 }, //  0x00   R/W - Operating &Function Control 2:
+   { 0x09, 0x7f }, //  0x7F   R/W - Crystal Oscillator Load Capacitance:
+   { 0x0a,    6 }, //  0x06   R/W - Microcontroller Output Clock:        4MHz on DIO2
+   { 0x0b, 0x15 }, //  0x00   R/W - GPIO0 Configuration:                 GPIO0=RX State
+   { 0x0c, 0x12 }, //  0x00   R/W - GPIO1 Configuration:                 GPIO1=TX State
+   { 0x0d,    0 }, //  0x00   R/W - GPIO2 Configuration:
+   { 0x0e,    0 }, //  0x00   R/W - I/O Port Configuration:
+   { 0x0f,    0 }, //  0x00   R/W - ADC Configuration:
+   { 0x10,    0 }, //  0x00   R/W - ADC Sensor Amplifier:
+//   0x11,  N/A         --     R  - ADC Value:
+   { 0x12, 0x20 }, //  0x20   R/W - Temperature Sensor Control:
+   { 0x13,    0 }, //  0x00   R/W - Temperature Value Offset:
+   { 0x14,    3 }, //  0x03   R/W - Wake-Up Timer Period 1:
+   { 0x15,    0 }, //  0x00   R/W - Wake-Up Timer Period 2:
+   { 0x16,    1 }, //  0x01   R/W - Wake-Up Timer Period 3:
+//   0x17,  N/A         --     R  -  Wake-Up Timer Value 1:
+//   0x18,  N/A         --     R  -  Wake-Up Timer Value 2:
+   { 0x19,    1 }, //  0x01   R/W - Low-Duty Cycle Mode Duration:
+   { 0x1a, 0x14 }, //  0x14   R/W - Low Battery Detector Thr0xesold:
+//   0x1b,  N/A         --     R  - Battery Voltage Level:
+   { 0x1c,    6 }, //  0x01   R/W - IF Filter Bandwidth:                 BW=127,9 kHz
+   { 0x1d, 0x44 }, //  0x44   R/W - AFC Loop Gea0xrsift Override:
+   { 0x1e, 0x0a }, //  0x0a   R/W - AFC Timing Control:
+   { 0x1f,    3 }, //  0x03   R/W - Clock Recovery Gearshift Override:
+   { 0x20, 0x45 }, //  0x64   R/W - Clock Recovery Oversampling Ratio:
+   { 0x21,    1 }, //  0x01   R/W - Clock Recovery Offset 2:
+   { 0x22, 0xd7 }, //  0x47   R/W - Clock Recovery Offset 1:
+   { 0x23, 0xdc }, //  0xae   R/W - Clock Recovery Offset 0:
+   { 0x24, 0x07 }, //  0x02   R/W - Clock Recovery Timing Loop Gain 1:
+   { 0x25, 0x6e }, //  0x8f   R/W - Clock Recovery Timing Loop Gain 0:
+//   0x26,  N/A         --     R  - Received Signal Strength Indicator:
+   { 0x27, 0x1e }, //  0x1e   R/W - RSSI Threshold for Clear Channel Indicator:
+//   0x28,  N/A         --     R  - Antenna Diversity Register 1:
+//   0x29,  N/A         --     R  - Antenna Diversity Register 2:
+   { 0x2a, 0x28 }, //  0x00   R/W - AFC Limiter:
+//   0x2b,  N/A         --     R  - AFC Correction Read:
+   { 0x2c, 0x40 }, //  0x18   R/W - OOK Counter Value 1:
+   { 0x2d, 0x0a }, //  0xbc   R/W - OOK Counter Value 2:
+   { 0x2e, 0x2d }, //  0x26   R/W - Slicer Peak Hold Reserved:
+//   0x2f,  N/A         --          RESERVED
+   { 0x30, 0x8d }, //  0x8d   R/W - Data Access Control:                 Packet mode enabled Rx & Tx, CRC-16 (IBM)
+//   0x31,  N/A         --     R  - EzMAC status:
+   { 0x32, 0x00 }, //  0x0c   R/W - Header Control 1:                    No header = 0x00
+   { 0x33,    2 }, //  0x22   R/W - Header Control 2:                    2 bytes syn, no header
+   { 0x34, 0x0a }, //  0x08   R/W - Preamble Length:                    40 bit preamble preamble
+   { 0x35, 0x2a }, //  0x2a   R/W - Preamble Detection Control:         20 bit preamble detection
+   { 0x36, 0x2d }, //  0x2d   R/W - Sync Word 3:
+   { 0x37, 0xd4 }, //  0xd4   R/W - Sync Word 2:
+   { 0x38,    0 }, //  0x00   R/W - Sync Word 1:
+   { 0x39,    0 }, //  0x00   R/W - Sync Word 0:
+   { 0x3a,    0 }, //  0x00   R/W - Transmit Header 3:
+   { 0x3b,    0 }, //  0x00   R/W - Transmit Header 2:
+   { 0x3c,    0 }, //  0x00   R/W - Transmit Header 1:
+   { 0x3d,    0 }, //  0x00   R/W - Transmit Header 0:
+   { 0x3e,    0 }, //  0x00   R/W - Transmit Packet Length:
+   { 0x3f,    0 }, //  0x00   R/W - Check Header 3:
+   { 0x40,    0 }, //  0x00   R/W - Check Header 2:
+   { 0x41,    0 }, //  0x00   R/W - Check Header 1:
+   { 0x42,    0 }, //  0x00   R/W - Check Header 0:
+   { 0x43, 0xff }, //  0xff   R/W - Header Enable 3:
+   { 0x44, 0xff }, //  0xff   R/W - Header Enable 2:
+   { 0x45, 0xff }, //  0xff   R/W - Header Enable 1:
+   { 0x46, 0xff }, //  0xff   R/W - Header Enable 0:
+//   0x47,  N/A         --     R  - Received Header 3:
+//   0x48,  N/A         --     R  - Received Header 2:
+//   0x49,  N/A         --     R  - Received Header 1:
+//   0x4a,  N/A         --     R  - Received Header 0:
+//   0x4b,  N/A         --     R  - Received Packet Length:
+//   0x4c-0x4E                      RESERVED
+   { 0x4f, 0x10 }, //  0x10   R/W - ADC8 Control:
+//   0x50-0x5f                      RESERVED
+   { 0x60, 0xa0 }, //  0xa0   R/W - Channel Filter Coefficient Address:
+//   0x61,  N/A                     RESERVED
+   { 0x62, 0x24 }, //  0x24   R/W - Crystal Oscillator/Power-on-Reset Control
+//   0x63-0x68                      RESERVED
+   { 0x69, 0x60 }, //  0x20   R/W - AGC Override:                         SGIN=1, AGCEN=1
+//   0x6a-0x6c                      RESERVED
+   { 0x6d, 0x0b }, //  0x18   R/W - TX Power:                             LNA=1 for direct tie, TxPwr=3
+   { 0x6e, 0x0e }, //  0x0A   R/W - TX Data Rate 1:                       57602 Hz
+   { 0x6f, 0xbf }, //  0x3D   R/W - TX Data Rate 0:
+   { 0x70, 0x0c }, //  0x0c   R/W - Modulation Mode Control 1:            Manchester Pream Polarity = 1
+   { 0x71, 0x23 }, //  0x00   R/W - Modulation Mode Control 2:            Source=FIFO, Modulation=GFSK
+   { 0x72, 0x2e }, //  0x20   R/W - Frequency Deviation:                  Fdev=28750Hz
+   { 0x73,    0 }, //  0x00   R/W - Frequency Offset 1:
+   { 0x74,    0 }, //  0x00   R/W - Frequency Offset 2:
+   { 0x75, 0x73 }, //  0x75   R/W - Frequency Band Select:
+   { 0x76, 0x6a }, //  0xbb   R/W - Nominal Carrier Frequency 1:
+   { 0x77, 0x40 }, //  0x80   R/W - Nominal Carrier Frequency 0:          868,5MHz
+//   0x78,  N/A                     RESERVED
+   { 0x79,    0 }, //  0x00   R/W - Frequency Hopping Channel Select:
+   { 0x7a,    0 }, //  0x00   R/W - Frequency Hopping Step Size:
+//   0x7b,  N/A                     RESERVED
+   { 0x7c, 0x37 }, //  0x37   R/W - TX FIFO Control 1:
+   { 0x7d,    4 }, //  0x04   R/W - TX FIFO Control 2:
+   { 0x7e, 0x37 }, //  0x37   R/W - RX FIFO Control:
+//   0x7F   N/A               R/W - FIFO Access
+   { 0xff, 0xff } // End of settings.
+  };
+
 // Full register settings for JeeLabsi/OEM compatible communications:
 // with following parameters:
 // 868.0MHz (EU band 48) FSK 49.261kHz
@@ -41,6 +41,11 @@ Author(s) / Copyright (s): Damon Hart-Davis 2013--2017
 #include <OTV0p2Base.h>
 #include <OTRadioLink.h>
 #include "OTRadioLink_ISRRXQueue.h"
+#include "OTV0P2BASE_Trace.h"
+#include "OTV0P2BASE_ISRLatency.h"
+#include "OTV0P2BASE_PowerAccounting.h"
+#include "OTV0P2BASE_CurrentBudget.h"
+#include "OTRadioLink_TXQueue.h"
 
 namespace OTRFM23BLink
     {
@@ -55,6 +60,175 @@ namespace OTRFM23BLink
     // All foreground RFM23B access should be protected from interrupts
     // but this code's ISR that may interfere with (eg) register access.
 
+    // RFM23B wake-up timer and low-duty-cycle (LDC) RX register settings,
+    // for duty-cycled 'wake-on-radio' listening.
+    // The radio sleeps on its 32kHz RC oscillator and every period
+    // enters RX for the LDC on time to sniff for preamble;
+    // the RFM23B stays in RX while a valid preamble and frame are being received.
+    // The wake-up timer period is 4 * M * 2^R / 32.768 ms
+    // and the LDC on time is 4 * LDC * 2^R / 32.768 ms (ie both in 2^R * ~122us ticks),
+    // with R in [0,20], M 16 bits and LDC 8 bits.
+    // The RC oscillator is accurate only to a few percent.
+    // A sender must use a preamble at least minPreambleBits() long
+    // (or repeat the frame back-to-back for that long) to be sure of being heard.
+    // Portable, so that settings can be checked off target.
+    struct RFM23BLowDutyCycleConfig final
+        {
+        // Wake-up timer exponent R (register 0x14), mantissa M (0x15 and 0x16) and LDC duration (0x19).
+        // LDC of 0 means duty-cycled RX is disabled.
+        uint8_t wtr;
+        uint16_t wtm;
+        uint8_t ldc;
+
+        constexpr RFM23BLowDutyCycleConfig() : wtr(0), wtm(0), ldc(0) { }
+
+        // True if this is a valid duty-cycled RX configuration.
+        bool isEnabled() const { return(0 != ldc); }
+
+        // Compute the finest-resolution settings for periodMs between sniffs
+        // and at least onUs of RX each time.
+        // Returns false (leaving out disabled) if they cannot be represented,
+        // eg if the on time is zero or not less than the period.
+        static bool compute(const uint16_t periodMs, const uint16_t onUs, RFM23BLowDutyCycleConfig &out)
+            {
+            out = RFM23BLowDutyCycleConfig();
+            if((0 == onUs) || ((uint32_t)onUs >= 1000UL * periodMs)) { return(false); }
+            // Durations in units of 1/8192 ms (1/8.192 us), exactly 2^-R ticks.
+            const uint32_t period = (uint32_t)periodMs * 8192;
+            // On time in ticks at R=0, rounded up.
+            const uint32_t on0 = ((uint32_t)onUs * 8192 + 999999) / 1000000;
+            for(uint8_t r = 0; r <= 20; ++r)
+                {
+                const uint32_t m = ((period >> r) + 500) / 1000;
+                const uint32_t ldc = (on0 + (1UL << r) - 1) >> r;
+                if((m > 0xffff) || (ldc > 0xff)) { continue; }
+                if(ldc >= m) { return(false); }
+                out.wtr = r;
+                out.wtm = (uint16_t)m;
+                out.ldc = (uint8_t)ldc;
+                return(true);
+                }
+            return(false);
+            }
+
+        // Actual period between sniffs in ms, rounded down.
+        uint32_t getPeriodMs() const { return((((uint32_t)wtm << wtr) * 125) / 1024); }
+        // Actual RX on time in us, rounded down.
+        uint32_t getOnUs() const { return((((uint32_t)ldc << wtr) * 15625) / 128); }
+        // RX duty cycle in parts per million, ignoring any extension when a frame arrives.
+        uint32_t getDutyPPM() const { return((0 == wtm) ? 0 : ((uint32_t)ldc * 1000000) / wtm); }
+
+        // Minimum preamble (bits) for a sender at bitrate bits/s so that a receiver
+        // sniffing every periodMs for onUs sees it, assuming the receiver
+        // needs to see the final preambleDetectBits of it to recognise it.
+        static constexpr uint32_t minPreambleBits(const uint16_t periodMs, const uint16_t onUs,
+                                                  const uint32_t bitrate, const uint8_t preambleDetectBits = 20)
+            { return((uint32_t)((((uint64_t)periodMs * 1000 + onUs) * bitrate + 999999) / 1000000) + preambleDetectBits); }
+        };
+
+    // RFM23B TX power register (REG_TX_POWER) value for a TX power hint,
+    // given the value configured for the channel, which is taken as the (eg legal) maximum.
+    // TXnormal and above use the configured power (TXmax also sends twice);
+    // TXquiet is one TXPOW step (~3dB) lower and TXmin three steps lower,
+    // but no lower than the minimum TXPOW.
+    // Other bits (eg LNA_SW) are kept.
+    // Portable, so that settings can be checked off target.
+    static constexpr uint8_t RFM23B_TXPOW_MASK = 0x07;
+    constexpr uint8_t RFM23BTXPowerDrop(const uint8_t power)
+        { return((power >= OTRadioLink::OTRadioLink::TXnormal) ? 0 : ((OTRadioLink::OTRadioLink::TXmin == power) ? 3 : 1)); }
+    constexpr uint8_t RFM23BTXPowerReg(const uint8_t configured, const uint8_t power)
+        {
+        return(uint8_t((configured & ~RFM23B_TXPOW_MASK) |
+            (((configured & RFM23B_TXPOW_MASK) > RFM23BTXPowerDrop(power)) ?
+                ((configured & RFM23B_TXPOW_MASK) - RFM23BTXPowerDrop(power)) : 0)));
+        }
+
+    // Listen-before-talk (clear channel assessment) settings for sendRaw().
+    // Before a TX on a channel enabled in channelMask the radio briefly listens
+    // and samples RSSI against an adaptive noise floor (RFM23BNoiseFloor).
+    // While the channel is busy the sender backs off a random 1 to maxBackoffSlots
+    // slots of ~15ms and tries again, up to maxRetries times,
+    // then sends anyway so that a mislearnt floor or a jammer cannot silence the node.
+    // Portable, so that settings can be checked off target.
+    struct RFM23BListenBeforeTalkConfig final
+        {
+        // Bit n set enables listen-before-talk on channel n [0,7]; 0 disables it.
+        uint8_t channelMask;
+        // RSSI (~0.5dB steps) above the noise floor taken as a busy channel.
+        uint8_t marginRSSI;
+        // Reassessments after the first before sending anyway.
+        uint8_t maxRetries;
+        // Upper bound of the random backoff in ~15ms slots; 0 is treated as 1.
+        uint8_t maxBackoffSlots;
+
+        constexpr RFM23BListenBeforeTalkConfig(const uint8_t _channelMask = 0, const uint8_t _marginRSSI = 12,
+                                               const uint8_t _maxRetries = 3, const uint8_t _maxBackoffSlots = 4)
+          : channelMask(_channelMask), marginRSSI(_marginRSSI),
+            maxRetries(_maxRetries), maxBackoffSlots(_maxBackoffSlots) { }
+
+        // True if listen-before-talk is enabled for the given channel.
+        bool isEnabledFor(const int8_t channel) const
+            { return((channel >= 0) && (channel < 8) && (0 != (channelMask & (1U << channel)))); }
+
+        // Random backoff in slots [1,maxBackoffSlots] from a random byte, eg OTV0P2BASE::randRNG8().
+        uint8_t backoffSlots(const uint8_t rand8) const
+            { return((maxBackoffSlots <= 1) ? 1 : uint8_t(1 + (rand8 % maxBackoffSlots))); }
+        };
+
+    // Adaptive RSSI noise floor for listen-before-talk.
+    // Falls quickly (halfway) to a quieter sample
+    // and rises slowly (1/16) towards a louder one still judged clear,
+    // so a slowly changing background is followed but traffic is not learnt as noise;
+    // each busy verdict also nudges the floor up by one
+    // so that a lasting rise in the background is eventually accepted.
+    // Portable.
+    class RFM23BNoiseFloor final
+        {
+        private:
+            // Current floor; 0 until the first sample.
+            uint8_t floorRSSI = 0;
+
+        public:
+            // Assess one RSSI sample and update the floor; true if the channel is clear.
+            // The first sample seeds the floor and is taken as clear.
+            bool isClear(const uint8_t rssi, const uint8_t marginRSSI)
+                {
+                if(0 == floorRSSI) { floorRSSI = (0 == rssi) ? 1 : rssi; return(true); }
+                if(rssi <= floorRSSI)
+                    {
+                    floorRSSI = uint8_t(floorRSSI - ((floorRSSI - rssi + 1) / 2));
+                    if(0 == floorRSSI) { floorRSSI = 1; }
+                    return(true);
+                    }
+                if((rssi - floorRSSI) <= marginRSSI)
+                    {
+                    floorRSSI = uint8_t(floorRSSI + ((rssi - floorRSSI + 15) / 16));
+                    return(true);
+                    }
+                if(floorRSSI < 0xff) { ++floorRSSI; }
+                return(false);
+                }
+
+            // Current floor; 0 if not yet sampled.
+            uint8_t getFloor() const { return(floorRSSI); }
+        };
+
+    // RFM23B packet-handler RX support.
+    // With the packet handler on (ENPACRX in Data Access Control, register 0x30)
+    // the radio delivers each frame's length (register 0x4b, or 0x3e if fixed-length),
+    // and with hardware CRC on (ENCRC in register 0x30) drops frames that fail the CRC
+    // so they never reach the FIFO reader, nor need a software 0xff terminator scan.
+    // Portable, so that settings can be checked off target.
+    static constexpr uint8_t RFM23B_DAC_ENCRC = 0x04;
+    // Interrupt Enable 1 (register 5) value in packet-handler mode for Data Access Control dac:
+    // valid packet, plus CRC error if hardware CRC is on so the radio can be re-armed at once.
+    constexpr uint8_t RFM23BPacketIRQEnable1(const uint8_t dac)
+        { return(uint8_t(0x02 | ((dac & RFM23B_DAC_ENCRC) ? 0x01 : 0))); }
+    // Bytes to read from the RX FIFO for a frame whose length the packet handler reported,
+    // or 0 if the frame should be dropped unread, ie if empty or longer than maxRXMsgLen.
+    constexpr uint8_t RFM23BPacketRXBytes(const uint8_t reported, const uint8_t maxRXMsgLen)
+        { return(((0 == reported) || (reported > maxRXMsgLen)) ? 0 : reported); }
+
     // See end for library of common configurations.
 #ifdef ARDUINO_ARCH_AVR
     // Base class for RFM23B radio link hardware driver.
@@ -176,7 +350,13 @@ namespace OTRFM23BLink
             static constexpr uint8_t REG_INT_ENABLE2 = 6; // Interrupt enable register 2.
             static constexpr uint8_t REG_OP_CTRL1 = 7; // Operation and control register 1.
             static constexpr uint8_t REG_OP_CTRL1_SWRES = 0x80u; // Software reset (at write) in OP_CTRL1.
+            static constexpr uint8_t REG_OP_CTRL1_ENWT = 0x20u; // Enable wake-up timer in OP_CTRL1.
             static constexpr uint8_t REG_OP_CTRL2 = 8; // Operation and control register 2.
+            static constexpr uint8_t REG_OP_CTRL2_ENLDM = 0x04u; // Enable low-duty-cycle mode in OP_CTRL2.
+            static constexpr uint8_t REG_WUT_PERIOD1 = 0x14; // Wake-up timer exponent R.
+            static constexpr uint8_t REG_WUT_PERIOD2 = 0x15; // Wake-up timer mantissa M MSB.
+            static constexpr uint8_t REG_WUT_PERIOD3 = 0x16; // Wake-up timer mantissa M LSB.
+            static constexpr uint8_t REG_LDC_DURATION = 0x19; // Low-duty-cycle mode duration.
             static constexpr uint8_t REG_RSSI = 0x26; // RSSI.
             static constexpr uint8_t REG_RSSI1 = 0x28; // Antenna 1 diversity / RSSI.
             static constexpr uint8_t REG_RSSI2 = 0x29; // Antenna 2 diversity / RSSI.
@@ -207,6 +387,13 @@ namespace OTRFM23BLink
             // If true (the default) then allow RX operations.
             const bool allowRXOps = true;
 
+            // Duty-cycled RX settings used when listening; disabled (continuous RX) by default.
+            RFM23BLowDutyCycleConfig rxDutyCycle;
+
+            // Listen-before-talk settings, disabled by default, and the noise floor shared by all channels.
+            RFM23BListenBeforeTalkConfig lbt;
+            RFM23BNoiseFloor lbtNoiseFloor;
+
             // Constructor only available to deriving class.
             constexpr OTRFM23BLinkBase(bool _allowRX = true) : allowRXOps(_allowRX) { }
 
@@ -224,6 +411,37 @@ namespace OTRFM23BLink
             // TODO: convert from busy-wait to sleep, at least in a standby mode, if likely longer than 10s of uS.
             // At lowest SPI clock prescale (x2) this is likely to spin for ~16 CPU cycles (8 bits each taking 2 cycles).
             inline void _wr(const uint8_t data) __attribute__((always_inline)) { SPDR = data; while (!(SPSR & _BV(SPIF))) { } }
+            // Read n bytes into buf, sending 0s, eg as the body of a burst read.
+            // SPI must already be configured and running, and the RFM23B selected and addressed.
+            // Arranged to minimise delays between bytes read by better scheduling.
+            inline void _rdn(uint8_t *buf, const uint8_t n) const __attribute__((always_inline))
+                {
+                // This loop has the effect of:
+                //     for(uint8_t j = n; j-- != 0; ) { *buf++ = _rd(); }
+                if(0 == n) { return; }
+                uint8_t j = n;
+                do  {
+                    // Start (a write of 0 and) a read of the next byte.
+                    SPDR = 0U;
+                    // Decide while waiting if this is the final byte or not.
+                    // If not, after waiting for the read, continue.
+                    --j;
+                    if(BRANCH_HINT_likely(0 != j))
+                        {
+                        while(!(SPSR & _BV(SPIF))) {}
+                        *buf++ = SPDR;
+                        continue;
+                        }
+                    // Reading the final byte now.
+                    while(!(SPSR & _BV(SPIF))) {}
+                    *buf++ = SPDR;
+                    break;
+                    } while(true);
+                }
+            // Write n bytes from buf (ignoring the values read back), eg as the body of a burst write.
+            // SPI must already be configured and running, and the RFM23B selected and addressed.
+            inline void _wrn(const uint8_t *buf, uint8_t n) __attribute__((always_inline))
+                { while(n-- > 0) { _wr(*buf++); } }
 
             // Internal routines to enable/disable RFM23B on the the SPI bus.
             // Versions accessible to the base class...
@@ -282,6 +500,20 @@ namespace OTRFM23BLink
             // Configure radio for transmission via specified channel < nChannels; non-negative.
             void _setChannel(uint8_t channel);
 
+            // If listen-before-talk is enabled for the channel
+            // then wait (with randomised backoff) for it to be clear, up to the configured retries.
+            // Leaves the radio in standby; the channel must then be set up again to send.
+            // Returns false only if the channel was still busy after all retries.
+            bool _waitForClearChannel(int8_t channel);
+
+            // Send/TX a raw frame as for sendRaw() but leave the radio in standby afterwards.
+            // If backToBack is true then the radio is assumed to be already
+            // in standby on the given channel from a previous call to this,
+            // so the mode switch and channel setup are skipped.
+            // Caller must call _dolisten() after the last frame
+            // to revert to RX or low-power standby as appropriate.
+            bool _sendRawNoListen(const uint8_t *buf, uint8_t buflen, int8_t channel, TXpower power, bool backToBack);
+
 #if 1 && defined(MILENKO_DEBUG)
             // Compact register dump
             void readRegs(uint8_t from, uint8_t to, uint8_t noHeader = 0);
@@ -289,6 +521,23 @@ namespace OTRFM23BLink
 #endif
 
         public:
+            // Set duty-cycled (wake-on-radio) RX for listening, or continuous RX if config is NULL or disabled.
+            // In duty-cycled RX the radio sniffs for preamble as config directs,
+            // and asserts nIRQ only on sync detect and on receiving a frame (or RX FIFO almost full),
+            // so the MCU can sleep between frames at a small fraction of the continuous RX current.
+            // Applies immediately if listening.
+            // NOT INTERRUPT SAFE and should not be called concurrently with any other RFM23B/SPI operation.
+            void setRXDutyCycle(const RFM23BLowDutyCycleConfig *config);
+            // True if duty-cycled RX is set.
+            bool isRXDutyCycled() const { return(rxDutyCycle.isEnabled()); }
+
+            // Set listen-before-talk for sendRaw() and queued TX, or disable it if config is NULL.
+            // Not thread-/ISR- safe.
+            void setListenBeforeTalk(const RFM23BListenBeforeTalkConfig *const config)
+                { lbt = (NULL == config) ? RFM23BListenBeforeTalkConfig() : *config; }
+            // Current adaptive noise floor (raw RSSI) for listen-before-talk; 0 if not yet sampled.
+            uint8_t getLBTNoiseFloor() const { return(lbtNoiseFloor.getFloor()); }
+
             // Set typical maximum frame length in bytes [1,63] to optimise radio behaviour.
             // Too long may allow overruns, too short may make long-frame reception hard.
             void setMaxTypicalFrameBytes(uint8_t maxTypicalFrameBytes);
@@ -318,6 +567,10 @@ namespace OTRFM23BLink
              *   byte of the buffer MUST be the leading length byte, else the RX packet
              *   handler will not be able to deduce the correct packet length.
              * - At, TXmax will do double TX with 15ms sleep/IDLE mode between.
+             * - TXquiet and TXmin lower the TX power below that configured for the
+             *   channel; see RFM23BTXPowerReg().
+             * - With setListenBeforeTalk() this may first listen and back off
+             *   while the channel is busy.
              * 
              * @param   buf: Buffer to hold the packet to send. The first byte MUST be the
              *          leading length byte.
@@ -331,7 +584,8 @@ namespace OTRFM23BLink
              *          allow a remote turn-around and TX. If false, powers down the radio.
              *          May be ignored if RX is not enabled, or the radio will revert to 
              *          receive mode anyway.
-             * @retval  True if the TX was made.
+             * @retval  True if the TX was made; false also if refused by
+             *          OTV0P2BASE::supplyCurrentBudget, eg during a motor run.
              */
             virtual bool sendRaw(const uint8_t *buf, uint8_t buflen, int8_t channel = 0, TXpower power = TXnormal, bool listenAfter = false) override;
 
@@ -368,9 +622,17 @@ namespace OTRFM23BLink
     //         - PCMSK0 interrupts may be enabled during a call to poll().
     // Set the targetISRRXMinQueueCapacity to at least 2, or 3 if RAM space permits, for busy RF channels.
     // With allowRX == false as much as possible of the receive side is disabled.
+    // With lockFreeRXQueue == true the RX queue is the lock-free ISRRXQueueSPSC,
+    // so the main loop need not mask interrupts to peek/remove frames,
+    // at the cost of slightly less guaranteed capacity for the same buffer size.
+    // With TXQueueDepth > 0 queueToSend() copies up to that many frames
+    // into a TX queue which poll() then sends back-to-back,
+    // without reverting to RX between frames;
+    // each queued frame costs about MaxTXMsgLen+3 bytes of RAM.
+    // With TXQueueDepth == 0 (the default) queueToSend() simply calls sendRaw().
 #define OTRFM23BLink_DEFINED
     static constexpr uint8_t DEFAULT_RFM23B_RX_QUEUE_CAPACITY = 3;
-    template <uint8_t SPI_nSS_DigitalPin, int8_t RFM_nIRQ_DigitalPin = -1, uint8_t targetISRRXMinQueueCapacity = 3, bool allowRX = true>
+    template <uint8_t SPI_nSS_DigitalPin, int8_t RFM_nIRQ_DigitalPin = -1, uint8_t targetISRRXMinQueueCapacity = 3, bool allowRX = true, bool lockFreeRXQueue = false, uint8_t TXQueueDepth = 0>
     class OTRFM23BLink final : public OTRFM23BLinkBase
         {
         private:
@@ -383,7 +645,50 @@ namespace OTRFM23BLink
               struct typeIf<true, TypeTrue, TypeFalse> { typedef TypeTrue t; };
             template <typename TypeTrue, typename TypeFalse>
               struct typeIf<false, TypeTrue, TypeFalse> { typedef TypeFalse t; };
-            typename typeIf<allowRX, ::OTRadioLink::ISRRXQueueVarLenMsg<MaxRXMsgLen, targetISRRXMinQueueCapacity>, ::OTRadioLink::ISRRXQueueNULL>::t queueRX;
+            typedef typename typeIf<lockFreeRXQueue,
+                ::OTRadioLink::ISRRXQueueSPSC<MaxRXMsgLen, targetISRRXMinQueueCapacity>,
+                ::OTRadioLink::ISRRXQueueVarLenMsg<MaxRXMsgLen, targetISRRXMinQueueCapacity> >::t queueRX_t;
+            typename typeIf<allowRX, queueRX_t, ::OTRadioLink::ISRRXQueueNULL>::t queueRX;
+            // Get a buffer from the RX queue for an inbound frame of lengthRX bytes; NULL if no space.
+            // The lock-free queue claims only the space needed for the frame,
+            // other queues reserve a maximum-size frame regardless.
+            template <class Q>
+              static inline volatile uint8_t *_getRXBufForInbound(Q &q, uint8_t /*lengthRX*/)
+                { return(q._getRXBufForInbound()); }
+            template <uint8_t maxRXBytes, uint8_t minQueueCapacity>
+              static inline volatile uint8_t *_getRXBufForInbound(::OTRadioLink::ISRRXQueueSPSC<maxRXBytes, minQueueCapacity> &q, const uint8_t lengthRX)
+                { return(q.claim(lengthRX)); }
+
+            // Frames waiting to be sent by poll(); a zero-size stub if TXQueueDepth is 0.
+            ::OTRadioLink::TXQueue<TXQueueDepth, MaxTXMsgLen> queueTX;
+
+            // RX activity (preamble/sync) and frames seen by _poll() since the last poll(),
+            // for any listen plan.
+            volatile bool _listenPlanActivity = false;
+            volatile bool _listenPlanFrame = false;
+
+            // Send all frames in the TX queue back-to-back, then revert to RX/standby.
+            // Does nothing if the queue is empty,
+            // or leaves the frames for a later poll while another high-current load is running.
+            // Not to be called from an ISR.
+            void _sendQueuedTX()
+                {
+                if(queueTX.isEmpty()) { return; }
+                const ::OTV0P2BASE::CurrentBudgetClaim supplyClaim(::OTV0P2BASE::CurrentLoad::RADIO_TX);
+                if(!supplyClaim.isGranted()) { return; }
+                int8_t prevChannel = -1;
+                uint8_t len; int8_t channel; uint8_t power;
+                const uint8_t *bp;
+                while(NULL != (bp = queueTX.peek(len, channel, power)))
+                    {
+                    // Only skip the standby/channel setup when staying on the same channel.
+                    if(channel != prevChannel) { _waitForClearChannel(channel); }
+                    _sendRawNoListen(bp, len, channel, (TXpower)power, (channel == prevChannel));
+                    prevChannel = channel;
+                    queueTX.pop();
+                    }
+                _dolisten();
+                }
 
             // Internal routines to enable/disable RFM23B on the the SPI bus.
             // These depend only on the (constant) SPI_nSS_DigitalPin template parameter
@@ -445,6 +750,29 @@ namespace OTRFM23BLink
             // Version accessible to the base class...
             virtual uint8_t _readReg8Bit_(const uint8_t addr) const override { return(_readReg8Bit(addr)); }
 
+            // Burst write of n bytes to consecutive registers starting at addr, in one select cycle.
+            // For REG_FIFO all the bytes go to the FIFO, as its address does not auto-increment.
+            // SPI must already be configured and running.
+            void _writeRegBurst(const uint8_t addr, const uint8_t *const buf, const uint8_t n)
+                {
+                _SELECT();
+                _wr(addr | 0x80); // Force to write.
+                _wrn(buf, n);
+                _DESELECT();
+                }
+
+            // Burst read of n bytes from consecutive registers starting at addr, in one select cycle.
+            // For REG_FIFO all the bytes come from the FIFO, as its address does not auto-increment.
+            // SPI must already be configured and running.
+            // Treat as if this does not alter state, though in some cases it will.
+            void _readRegBurst(const uint8_t addr, uint8_t *const buf, const uint8_t n) const
+                {
+                _SELECT();
+                _io(addr & 0x7f); // Force to read.
+                _rdn(buf, n);
+                _DESELECT();
+                }
+
             // Read from 16-bit big-endian register pair.
             // The result has the first (lower-numbered) register in the most significant byte.
             // Treat as if this does not alter state, though in some cases it will.
@@ -463,6 +791,8 @@ namespace OTRFM23BLink
             inline void _modeStandby()
                 {
                 _writeReg8Bit(REG_OP_CTRL1, 0);
+                OT_POWER_OFF(OTV0P2BASE::PowerDomain::RADIO_RX);
+                OT_POWER_OFF(OTV0P2BASE::PowerDomain::RADIO_TX);
 #if 0 && defined(V0P2BASE_DEBUG)
 V0P2BASE_DEBUG_SERIAL_PRINT_FLASHSTRING("Sb");
 #endif
@@ -475,6 +805,8 @@ V0P2BASE_DEBUG_SERIAL_PRINT_FLASHSTRING("Sb");
             inline void _modeTX()
                 {
                 _writeReg8Bit(REG_OP_CTRL1, 9); // TXON | XTON
+                OT_POWER_OFF(OTV0P2BASE::PowerDomain::RADIO_RX);
+                OT_POWER_ON(OTV0P2BASE::PowerDomain::RADIO_TX);
 #if 0 && defined(V0P2BASE_DEBUG)
 V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("Tx");
 #endif
@@ -487,6 +819,8 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("Tx");
             inline void _modeRX()
                 {
                 _writeReg8Bit(REG_OP_CTRL1, 5); // RXON | XTON
+                OT_POWER_OFF(OTV0P2BASE::PowerDomain::RADIO_TX);
+                OT_POWER_ON(OTV0P2BASE::PowerDomain::RADIO_RX);
 #if 0 && defined(V0P2BASE_DEBUG)
 V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("Rx");
 #endif
@@ -518,6 +852,7 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("Rx");
                 // Lock out interrupts while fiddling with interrupts.
                 ATOMIC_BLOCK (ATOMIC_RESTORESTATE)
                     {
+                    OTV0P2BASE_IRQ_MASKED_SECTION(::OTV0P2BASE::ISRLatencyPath::RFM23B_CTRL);
                     const bool neededEnable = _upSPI();
                     _modeStandby();
                     // Clear RX and TX FIFOs simultaneously.
@@ -572,14 +907,19 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("RFM23 reset...");
                     // Enable requested RX-related interrupts.
                     // Do this regardless of hardware interrupt support on the board.
                     // Check if packet handling in RFM23B is enabled and enable interrupts accordingly.
-                    if ( _readReg8Bit(REG_30_DATA_ACCESS_CONTROL) & RFM23B_ENPACRX )  {
-                       _writeReg8Bit(REG_INT_ENABLE1, RFM23B_ENPKVALID);
-                       _writeReg8Bit(REG_INT_ENABLE2, 0);
+                    // With a listen plan also wake on preamble or sync detect to hold the channel.
+                    // When duty-cycled also wake on sync so that the MCU stays up for the frame.
+                    const uint8_t planIRQs = ((NULL == listenPlan) ? 0 : (RFM23B_ENPREAVAL | RFM23B_ENSWDET)) |
+                        (rxDutyCycle.isEnabled() ? RFM23B_ENSWDET : 0);
+                    const uint8_t dac = _readReg8Bit(REG_30_DATA_ACCESS_CONTROL);
+                    if ( dac & RFM23B_ENPACRX )  {
+                       _writeReg8Bit(REG_INT_ENABLE1, RFM23BPacketIRQEnable1(dac));
+                       _writeReg8Bit(REG_INT_ENABLE2, planIRQs);
                        if ((_readReg8Bit(REG_33_HEADER_CONTROL2) & RFM23B_FIXPKLEN ) == RFM23B_FIXPKLEN )
                           _writeReg8Bit(REG_3E_PACKET_LENGTH, maxTypicalFrameBytes);
                     } else {
                        _writeReg8Bit(REG_INT_ENABLE1, 0x10); // enrxffafull: Enable RX FIFO Almost Full.
-                       _writeReg8Bit(REG_INT_ENABLE2, WAKE_ON_SYNC_RX ? 0x80 : 0); // enswdet: Enable Sync Word Detected.
+                       _writeReg8Bit(REG_INT_ENABLE2, (WAKE_ON_SYNC_RX ? 0x80 : 0) | planIRQs); // enswdet: Enable Sync Word Detected.
                     }
                 }
 #ifdef RFM23B_IRQ_CONTROL
@@ -653,43 +993,16 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("RFM23 reset...");
                 // Lock out interrupts.
                 ATOMIC_BLOCK (ATOMIC_RESTORESTATE)
                     {
+                    OTV0P2BASE_IRQ_MASKED_SECTION(::OTV0P2BASE::ISRLatencyPath::RFM23B_RXFIFO);
                     const bool neededEnable = _upSPI();
                     _modeStandby();
                     // Do burst read from RX FIFO.
-                    _SELECT();
-                    _io(REG_FIFO & 0x7F);
-                    // This loop has the effect of:
-                    //     for(uint8_t j = bufSize; j-- != 0; ) { *buf++ = _rd(); }
-                    // but rearranged to minimise delays between bytes read
-                    // by better scheduling.
-                    if(0 != bufSize)
-                        {
-                        uint8_t j = bufSize;
-                        do  {
-                            // Start (a write of 0 and) a read of the next byte.
-                            SPDR = 0U;
-                            // Decide while waiting if this is the final byte or not.
-                            // If not, after waiting for the read, continue.
-                            --j;
-                            if(BRANCH_HINT_likely(0 != j))
-                                {
-                                while(!(SPSR & _BV(SPIF))) {}
-                                *buf++ = SPDR;
-                                continue;
-                                }
-                            // Reading the final byte now.
-                            while(!(SPSR & _BV(SPIF))) {}
-                            *buf++ = SPDR;
-                            break;
-                            } while(true);
-                        }
-                    _DESELECT();
+                    _readRegBurst(REG_FIFO, buf, bufSize);
                     // Clear RX and TX FIFOs simultaneously.
                     _writeReg8Bit(REG_OP_CTRL2, 3); // FFCLRRX | FFCLRTX
                     _writeReg8Bit(REG_OP_CTRL2, 0); // Needs both writes to clear.
-                    // Disable all interrupts.
-                    _writeReg8Bit(REG_INT_ENABLE1, 0);
-                    _writeReg8Bit(REG_INT_ENABLE2, 0); // TODO: possibly combine in burst write with previous...
+                    // Disable all interrupts (REG_INT_ENABLE1 and REG_INT_ENABLE2) in one burst write.
+                    _writeReg16Bit0(REG_INT_ENABLE1);
                     // Clear any interrupts already/still pending...
                     _clearInterrupts();
                     if(neededEnable) { _downSPI(); }
@@ -715,6 +1028,7 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("RFM23 reset...");
                 // Disable interrupts while enabling them at RFM23B and entering RX mode.
                 ATOMIC_BLOCK (ATOMIC_RESTORESTATE)
                     {
+                    OTV0P2BASE_IRQ_MASKED_SECTION(::OTV0P2BASE::ISRLatencyPath::RFM23B_CTRL);
                     const bool neededEnable = _upSPI_();
                     // Clear RX and TX FIFOs.
                     _writeReg8Bit(REG_OP_CTRL2, 3); // FFCLRRX | FFCLRTX
@@ -724,8 +1038,18 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("RFM23 reset...");
                     _enableIRQLine();
                     // Clear any current interrupt/status.
                     _clearInterrupts();
-                    // Start listening.
-                    _modeRX();
+                    // Start listening, continuously or duty-cycled.
+                    if(rxDutyCycle.isEnabled())
+                        {
+                        _writeReg8Bit(REG_WUT_PERIOD1, rxDutyCycle.wtr);
+                        _writeReg8Bit(REG_WUT_PERIOD2, (uint8_t)(rxDutyCycle.wtm >> 8));
+                        _writeReg8Bit(REG_WUT_PERIOD3, (uint8_t)rxDutyCycle.wtm);
+                        _writeReg8Bit(REG_LDC_DURATION, rxDutyCycle.ldc);
+                        _writeReg8Bit(REG_OP_CTRL2, REG_OP_CTRL2_ENLDM);
+                        // Wake-up timer on, everything else off until it fires.
+                        _writeReg8Bit(REG_OP_CTRL1, REG_OP_CTRL1_ENWT);
+                        }
+                    else { _modeRX(); }
                     if(neededEnable) { _downSPI(); }
                     }
                 }
@@ -750,44 +1074,57 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("RFM23 reset...");
                 if(!allowRX) { return; }
 
                 // Nothing to do if not listening at the moment.
-                if(-1 == getListenChannel()) { return; }
+                const int8_t lc = getListenChannel();
+                if(-1 == lc) { return; }
 
                 const bool neededEnable = _upSPI();
                 // See what has arrived, if anything.
                 const uint16_t status = _readStatusBoth();
+                OT_TRACE(OTV0P2BASE::TraceId::RADIO_ISR, status);
+                // Only sample RSSI for the stats if they are being collected.
+                const uint8_t rssi = (NULL == _getStats(lc)) ? 0 : _readReg8Bit(REG_RSSI);
                 // Need to check if RFM23B is in packet mode and based on that
                 // select the interrupt handling path.
                 const uint8_t rxMode = _readReg8Bit(REG_30_DATA_ACCESS_CONTROL);
                 if(neededEnable) { _downSPI(); }
+                // Note activity for any listen plan.
+                if(status & (RFM23B_IPREAVAL | RFM23B_ISWDET)) { _listenPlanActivity = true; }
                 if(rxMode & RFM23B_ENPACRX)
                     {
                     // Packet-handling mode...
+                    if(status & RFM23B_ICRCERROR)
+                        {
+                        // Rejected by the hardware CRC: nothing worth reading,
+                        // so just count it and re-arm RX.
+                        _statsRXCRCError(lc);
+                        if(!(status & RFM23B_IPKVALID)) { _dolistenNonVirtual(); return; }
+                        }
                     if(status & RFM23B_IPKVALID) // Packet received OK
                         {
                         const bool neededEnable = _upSPI();
                         // Extract packet/frame length...
-                        uint8_t lengthRX;
                         // Number of bytes to read depends whether fixed
                         // or variable packet length
-                        if((_readReg8Bit(REG_33_HEADER_CONTROL2) & RFM23B_FIXPKLEN) == RFM23B_FIXPKLEN)
-                           lengthRX = _readReg8Bit(REG_3E_PACKET_LENGTH);
-                        else
-                           lengthRX = _readReg8Bit(REG_4B_RECEIVED_PACKET_LENGTH);
+                        uint8_t lengthRX = RFM23BPacketRXBytes(
+                            ((_readReg8Bit(REG_33_HEADER_CONTROL2) & RFM23B_FIXPKLEN) == RFM23B_FIXPKLEN) ?
+                                _readReg8Bit(REG_3E_PACKET_LENGTH) : _readReg8Bit(REG_4B_RECEIVED_PACKET_LENGTH),
+                            MaxRXMsgLen);
                         // Received frame.
                         // If there is space in the queue then read in the frame,
                         // else discard it.
-                        volatile uint8_t *const bufferRX = (lengthRX > MaxRXMsgLen) ? NULL :
-                            queueRX._getRXBufForInbound();
+                        volatile uint8_t *const bufferRX = (0 == lengthRX) ? NULL :
+                            _getRXBufForInbound(queueRX, lengthRX);
                         if(NULL != bufferRX)
                             {
-                            // Attempt to read the entire frame.
-                            _RXFIFO((uint8_t *)bufferRX, MaxRXMsgLen);
+                            // Read exactly the frame as delimited by the packet handler.
+                            _RXFIFO((uint8_t *)bufferRX, lengthRX);
                             // If an RX filter is present then apply it.
                             quickFrameFilter_t *const f = filterRXISR;
                             if((NULL != f) && !f(bufferRX, lengthRX))
                                 {
                                 // Drop the frame: filter didn't like it.
                                 ++filteredRXedMessageCountRecent;
+                                _statsRXFiltered(lc);
                                 // Don't queue frame...
                                 queueRX._loadedBuf(0);
                                 }
@@ -795,6 +1132,9 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("RFM23 reset...");
                                 {
                                 // Queue message.
                                 queueRX._loadedBuf(lengthRX);
+                                _statsRXQueued(lc, rssi);
+                                _stampRXQueued();
+                                OT_TRACE(OTV0P2BASE::TraceId::RADIO_RX_QUEUED, lengthRX);
                                 }
                             }
                         else
@@ -803,8 +1143,12 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("RFM23 reset...");
                             uint8_t tmpbuf[1];
                             _RXFIFO(tmpbuf, sizeof(tmpbuf));
                             ++droppedRXedMessageCountRecent;
+                            _statsRXDropped(lc);
+                            OT_TRACE(OTV0P2BASE::TraceId::RADIO_RX_DROPPED, lc);
                             lastRXErr = RXErr_DroppedFrame;
                             }
+                        // Frame seen, queued or not, for any listen plan.
+                        _listenPlanFrame = true;
                         // Clear up and force back to listening...
                         _dolistenNonVirtual();
                         // XXX Moved to reduce cost of 2 _SPI() and _downSPI()
@@ -856,11 +1200,15 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("RFM23 reset...");
                             if((NULL != f) && !f(bufferRX, lengthRX))
                                 {
                                 ++filteredRXedMessageCountRecent; // Drop the frame: filter didn't like it.
+                                _statsRXFiltered(lc);
                                 queueRX._loadedBuf(0); // Don't queue this frame...
                                 }
                             else
                                 {
                                 queueRX._loadedBuf(lengthRX); // Queue message.
+                                _statsRXQueued(lc, rssi);
+                                _stampRXQueued();
+                                OT_TRACE(OTV0P2BASE::TraceId::RADIO_RX_QUEUED, lengthRX);
                                 }
                             }
                         else
@@ -869,8 +1217,12 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("RFM23 reset...");
                             uint8_t tmpbuf[1];
                             _RXFIFO(tmpbuf, sizeof(tmpbuf));
                             ++droppedRXedMessageCountRecent;
+                            _statsRXDropped(lc);
+                            OT_TRACE(OTV0P2BASE::TraceId::RADIO_RX_DROPPED, lc);
                             lastRXErr = RXErr_DroppedFrame;
                             }
+                        // Frame seen, queued or not, for any listen plan.
+                        _listenPlanFrame = true;
                         // Clear up and force back to listening...
                         _dolistenNonVirtual();
                         return;
@@ -913,11 +1265,51 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("RFM23 reset...");
             // May also be used for output processing,
             // eg to run a transmit state machine.
             // May be called very frequently and should not take more than a few 100ms per call.
+            // Sends any frames in the TX queue.
+            // Follows any listen plan (see setListenPlan()), hopping channels as it directs.
             virtual void poll() override
             {
-                if(!interruptLineIsEnabledAndInactive()) { ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { _poll(); } }
+                if(!interruptLineIsEnabledAndInactive()) { ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { OTV0P2BASE_IRQ_MASKED_SECTION(::OTV0P2BASE::ISRLatencyPath::RFM23B_POLL); _poll(); } }
+                if(TXQueueDepth > 0) { _sendQueuedTX(); }
+                if(allowRX && (NULL != listenPlan))
+                    {
+                    bool activity = false, frame = false;
+                    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+                        {
+                        activity = _listenPlanActivity; _listenPlanActivity = false;
+                        frame = _listenPlanFrame; _listenPlanFrame = false;
+                        }
+                    _pollListenPlan(millis(), activity, frame);
+                    }
             }
 
+            // Add raw frame to send queue, to be sent by poll(); returns false if it could not be queued.
+            // The frame is copied so the caller's buffer may be reused immediately.
+            // With TXQueueDepth == 0 this sends the frame immediately via sendRaw().
+            // Refuses the frame if it would exceed the duty-cycle limit (see canSendNow()).
+            // Does not block unless calling sendRaw().
+            virtual bool queueToSend(const uint8_t *buf, uint8_t buflen, int8_t channel = 0, TXpower power = TXnormal) override
+            {
+                if(!canSendNow(channel, buflen, power)) { return(false); }
+                if(0 == TXQueueDepth) { return(sendRaw(buf, buflen, channel, power)); }
+                return(queueTX.push(buf, buflen, channel, power));
+            }
+
+            // Reserve the next TX queue slot to build a frame in place; NULL if none free or TXQueueDepth == 0.
+            virtual uint8_t *reserveToSend(uint8_t &bufsize) override
+            {
+                uint8_t *const b = queueTX.reserve();
+                bufsize = (NULL == b) ? 0 : uint8_t(MaxTXMsgLen);
+                return(b);
+            }
+            // Queue the frame built in the reserved slot, to be sent by poll().
+            // Refuses the frame if it would exceed the duty-cycle limit (see canSendNow()).
+            virtual bool commitToSend(const uint8_t buflen, const int8_t channel = 0, const TXpower power = TXnormal) override
+                { return(canSendNow(channel, buflen, power) && queueTX.commit(buflen, channel, power)); }
+
+            // Number of frames waiting in the TX queue.
+            uint8_t getTXMsgsQueued() const { return(queueTX.size()); }
+
 #ifdef RFM23B_IRQ_CONTROL
             /**
              * @brief   Temporarily suspend radio interrupt line until reenabled or radio is polled.
@@ -947,6 +1339,9 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("RFM23 reset...");
             bool _handleInterruptNonVirtual()
             {
                 if(!allowRX) { return(false); }
+                OTV0P2BASE_ISR_SECTION(::OTV0P2BASE::ISRLatencyPath::RFM23B_ISR);
+                // ISRs run with interrupts disabled.
+                OTV0P2BASE_IRQ_MASKED_SECTION(::OTV0P2BASE::ISRLatencyPath::RFM23B_ISR);
                 if(interruptLineIsEnabledAndInactive()) { return(false); }
                 _poll();
                 return(true);
@@ -1018,7 +1413,7 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("RFM23 reset...");
             // Typically used after peekRXMessage().
             // Does nothing if the queue is empty.
             // Not intended to be called from an ISR.
-            virtual void removeRXMsg() override { queueRX.removeRXMsg(); }
+            virtual void removeRXMsg() override { queueRX.removeRXMsg(); _stampRXRemoved(); }
 
 #if 0 // Defining the virtual destructor uses ~800+ bytes of Flash by forcing use of malloc()/free().
             // Ensure safe instance destruction when derived from.
@@ -1030,6 +1425,14 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("RFM23 reset...");
 #endif
         };
 
+    // OTRFM23BLink configured from a board descriptor (see OTV0P2BASE_BoardConfig.h),
+    // with the receive side compiled out where the board never listens
+    // and a minimal RX queue where the board trims memory.
+    template <class boardConfig_t, uint8_t SPI_nSS_DigitalPin, int8_t RFM_nIRQ_DigitalPin = -1>
+    using OTRFM23BLinkForBoard = OTRFM23BLink<SPI_nSS_DigitalPin, RFM_nIRQ_DigitalPin,
+        (boardConfig_t::trimmedMemory ? 2 : DEFAULT_RFM23B_RX_QUEUE_CAPACITY),
+        boardConfig_t::radioRX>;
+
 
     // Library of common RFM23B configurations.
     // Only link in (refer to) those required at run-time.
@@ -1045,6 +1448,10 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("RFM23 reset...");
     // Full config including all default values, so safe for dynamic switching.
     extern const OTRFM23BLinkBase::RFM23_Reg_Values_t StandardRegSettingsGFSK57600;
 
+    // As StandardRegSettingsGFSK57600 with hardware CRC-16 checking of received frames.
+    // Full config including all default values, so safe for dynamic switching.
+    extern const OTRFM23BLinkBase::RFM23_Reg_Values_t StandardRegSettingsGFSK57600CRC;
+
     // Full register settings for FS20 (FHT8B) 868.35MHz (EU band 48) OOK 5kbps carrier, no packet handler.
     // Full config including all default values, so safe for dynamic switching.
     extern const OTRFM23BLinkBase::RFM23_Reg_Values_t StandardRegSettingsOOK5000;
@@ -0,0 +1,228 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Compile-time RFM23B register tables for FSK/GFSK packet channels,
+ * computed from a human-level channel description
+ * rather than hand-transcribed from the Si443x register calculator.
+ *
+ * The result has the same form as the StandardRegSettingsXXX tables,
+ * ie (reg#,value) pairs in Flash terminated with 0xff,
+ * for use as OTRadioChannelConfig::config,
+ * and is in ascending register order so that
+ * OTRFM23BLinkBase::_registerBlockSetup() writes it in few bursts.
+ *
+ * Formulae are from the Si4430/31/32 datasheet and AN440.
+ */
+
+#ifndef ARDUINO_LIB_OTRFM23BLINK_REGCONFIG_H
+#define ARDUINO_LIB_OTRFM23BLINK_REGCONFIG_H
+
+#include <stdint.h>
+
+#ifdef ARDUINO_ARCH_AVR
+#include <avr/pgmspace.h>
+#define OTRFM23BLINK_REGCONFIG_PROGMEM PROGMEM
+#else
+#define OTRFM23BLINK_REGCONFIG_PROGMEM
+#endif
+
+namespace OTRFM23BLink
+    {
+    // FSK/GFSK packet-handler channel, as for StandardRegSettingsGFSK57600.
+    // All fields must be set, eg with aggregate initialisation.
+    struct RFM23BChannelDesc final
+        {
+        // Carrier frequency, Hz, [240MHz,960MHz).
+        uint32_t carrierHz;
+        // Data rate, bits/s, [1000,128000].
+        uint32_t bitrate;
+        // Peak frequency deviation, Hz, [625,320000).
+        uint32_t deviationHz;
+        // True for GFSK, else FSK.
+        bool gaussian;
+        // Preamble sent, bits, a multiple of 4 in [4,2044].
+        uint16_t preambleBits;
+        // Preamble needed to detect, bits, a multiple of 4 in [4,124].
+        uint8_t preambleDetectBits;
+        // Length of sync word, bytes, [1,4].
+        uint8_t syncBytes;
+        // Sync word, sent most significant byte first, left-aligned, eg 0x2dd40000.
+        uint32_t syncWord;
+        // True for hardware CRC-16 (IBM) on TX and RX, as StandardRegSettingsGFSK57600CRC.
+        bool hwCRC;
+        // True for fixed length packets, else the length is sent as a header byte.
+        bool fixedLength;
+        // Maximum AFC correction, Hz.
+        uint32_t afcLimitHz;
+        // TX power register (0x6d) value, eg 0x0b.
+        uint8_t txPowerReg;
+        };
+
+    // High band (480MHz and up), with frequencies in 20MHz rather than 10MHz steps.
+    constexpr bool RFM23BHighBand(const RFM23BChannelDesc &d) { return(d.carrierHz >= 480000000UL); }
+    constexpr uint32_t RFM23BBandStepHz(const RFM23BChannelDesc &d) { return(RFM23BHighBand(d) ? 20000000UL : 10000000UL); }
+    // Frequency Band Select (0x75): sbsel, hbsel and fb.
+    constexpr uint8_t RFM23BBandSelectReg(const RFM23BChannelDesc &d)
+        { return(uint8_t(0x40 | (RFM23BHighBand(d) ? 0x20 : 0) | ((d.carrierHz / RFM23BBandStepHz(d)) - 24))); }
+    // Nominal Carrier Frequency (0x76, 0x77): fractional part of the band step in 1/64000ths.
+    constexpr uint16_t RFM23BCarrierReg(const RFM23BChannelDesc &d)
+        { return(uint16_t(((uint64_t)(d.carrierHz % RFM23BBandStepHz(d)) * 64000 + RFM23BBandStepHz(d) / 2) / RFM23BBandStepHz(d))); }
+
+    // Data rate scaling (txdtrtscale in 0x70) is needed below 30kbps.
+    constexpr bool RFM23BDataRateScaled(const RFM23BChannelDesc &d) { return(d.bitrate < 30000); }
+    // TX Data Rate (0x6e, 0x6f).
+    constexpr uint16_t RFM23BDataRateReg(const RFM23BChannelDesc &d)
+        { return(uint16_t((((uint64_t)d.bitrate << (RFM23BDataRateScaled(d) ? 21 : 16)) + 500000) / 1000000)); }
+    // Frequency deviation in 625Hz units (9 bits, top bit in 0x71).
+    constexpr uint16_t RFM23BDeviationReg(const RFM23BChannelDesc &d)
+        { return(uint16_t((d.deviationHz + 312) / 625)); }
+
+    // Approximate occupied bandwidth to be passed by the IF filter (Carson's rule), Hz.
+    constexpr uint32_t RFM23BRequiredBandwidthHz(const RFM23BChannelDesc &d)
+        { return((2 * d.deviationHz) + d.bitrate); }
+    // IF filter settings from the datasheet table, narrowest first,
+    // as bandwidth in 100Hz units and the IF Filter Bandwidth (0x1c) value (ndec_exp and filset).
+    // Only the dwn3_bypass = 0 settings are included, so the widest is 137.9kHz.
+    struct RFM23BIFFilter_t final { uint16_t bw100Hz; uint8_t reg; };
+    static constexpr uint8_t RFM23B_IF_FILTERS = 42;
+    static constexpr RFM23BIFFilter_t RFM23B_IF_FILTER_TABLE[RFM23B_IF_FILTERS] =
+        {
+        {   26, 0x51 }, {   28, 0x52 }, {   31, 0x53 }, {   32, 0x54 }, {   37, 0x55 }, {   42, 0x56 }, {   45, 0x57 },
+        {   49, 0x41 }, {   54, 0x42 }, {   59, 0x43 }, {   61, 0x44 }, {   72, 0x45 }, {   82, 0x46 }, {   88, 0x47 },
+        {   95, 0x31 }, {  106, 0x32 }, {  115, 0x33 }, {  121, 0x34 }, {  142, 0x35 }, {  162, 0x36 }, {  175, 0x37 },
+        {  189, 0x21 }, {  210, 0x22 }, {  227, 0x23 }, {  240, 0x24 }, {  282, 0x25 }, {  322, 0x26 }, {  347, 0x27 },
+        {  377, 0x11 }, {  417, 0x12 }, {  452, 0x13 }, {  479, 0x14 }, {  562, 0x15 }, {  641, 0x16 }, {  692, 0x17 },
+        {  752, 0x01 }, {  832, 0x02 }, {  900, 0x03 }, {  953, 0x04 }, { 1121, 0x05 }, { 1279, 0x06 }, { 1379, 0x07 },
+        };
+    // Index of the narrowest IF filter passing bwHz, or RFM23B_IF_FILTERS if none.
+    constexpr uint8_t RFM23BIFFilterIndex(const uint32_t bwHz, const uint8_t i = 0)
+        {
+        return(((i >= RFM23B_IF_FILTERS) || (100UL * RFM23B_IF_FILTER_TABLE[i].bw100Hz >= bwHz)) ? i :
+            RFM23BIFFilterIndex(bwHz, uint8_t(i + 1)));
+        }
+    constexpr bool RFM23BIFFilterOK(const RFM23BChannelDesc &d)
+        { return(RFM23BIFFilterIndex(RFM23BRequiredBandwidthHz(d)) < RFM23B_IF_FILTERS); }
+    // IF Filter Bandwidth (0x1c); only valid if RFM23BIFFilterOK().
+    constexpr uint8_t RFM23BIFFilterReg(const RFM23BChannelDesc &d)
+        { return(RFM23B_IF_FILTER_TABLE[RFM23BIFFilterIndex(RFM23BRequiredBandwidthHz(d)) % RFM23B_IF_FILTERS].reg); }
+    constexpr uint8_t RFM23BNDecExp(const RFM23BChannelDesc &d) { return(uint8_t((RFM23BIFFilterReg(d) >> 4) & 7)); }
+
+    // Clock recovery oversampling ratio (11 bits, 0x20 and top of 0x21) in 1/8ths.
+    constexpr uint16_t RFM23BRXOSR(const RFM23BChannelDesc &d)
+        { return(uint16_t(((4000000UL >> RFM23BNDecExp(d)) + d.bitrate / 2) / d.bitrate)); }
+    // Clock recovery offset (20 bits, 0x21 to 0x23).
+    constexpr uint32_t RFM23BNCOff(const RFM23BChannelDesc &d)
+        { return(uint32_t((((uint64_t)d.bitrate << (20 + RFM23BNDecExp(d))) + 250000) / 500000)); }
+    // Clock recovery timing loop gain (11 bits, 0x24 and 0x25).
+    constexpr uint16_t RFM23BCRGain(const RFM23BChannelDesc &d)
+        { return(uint16_t(2 + (((uint64_t)d.bitrate << 16) / ((uint64_t)RFM23BRXOSR(d) * (625UL * RFM23BDeviationReg(d)))))); }
+    // AFC Limiter (0x2a), in 625Hz steps in the low band and 1250Hz in the high band.
+    constexpr uint8_t RFM23BAFCLimitReg(const RFM23BChannelDesc &d)
+        { return(uint8_t(d.afcLimitHz / (RFM23BHighBand(d) ? 1250 : 625))); }
+
+    constexpr uint8_t RFM23BSyncByte(const RFM23BChannelDesc &d, const uint8_t n)
+        { return((n < d.syncBytes) ? uint8_t(d.syncWord >> (24 - 8 * n)) : 0); }
+
+    // True if the description can be represented.
+    constexpr bool RFM23BChannelDescOK(const RFM23BChannelDesc &d)
+        {
+        return((d.carrierHz >= 240000000UL) && (d.carrierHz < 960000000UL) &&
+               (d.bitrate >= 1000) && (d.bitrate <= 128000) &&
+               (RFM23BDeviationReg(d) >= 1) && (RFM23BDeviationReg(d) <= 511) &&
+               (0 == (d.preambleBits % 4)) && (d.preambleBits >= 4) && (d.preambleBits <= 2044) &&
+               (0 == (d.preambleDetectBits % 4)) && (d.preambleDetectBits >= 4) && (d.preambleDetectBits <= 124) &&
+               (d.syncBytes >= 1) && (d.syncBytes <= 4) &&
+               RFM23BIFFilterOK(d) && (RFM23BRXOSR(d) <= 0x7ff) && (RFM23BCRGain(d) <= 0x7ff) &&
+               ((d.afcLimitHz / (RFM23BHighBand(d) ? 1250 : 625)) <= 0xff));
+        }
+
+    // Number of bursts _registerBlockSetup() needs for a 0xff-terminated table,
+    // ie runs of consecutive registers, or 0 if the registers are not in ascending order.
+    constexpr uint8_t RFM23BRegRuns(const uint8_t (*const t)[2], const uint8_t runs = 0, const int16_t prev = -2)
+        {
+        return((0xff == t[0][0]) ? runs :
+            ((int16_t(t[0][0]) <= prev) ? 0 :
+                RFM23BRegRuns(t + 1, uint8_t(runs + ((int16_t(t[0][0]) == prev + 1) ? 0 : 1)), t[0][0])));
+        }
+
+    // Full register table for the channel described by d,
+    // with the same registers and fixed values as StandardRegSettingsGFSK57600
+    // so safe for dynamic switching.
+    // Usage, with desc a constexpr RFM23BChannelDesc at namespace scope:
+    //     OTRadioLink::OTRadioChannelConfig(OTRFM23BLink::RFM23BRegConfig<desc>::values, true)
+    template<const RFM23BChannelDesc &d>
+    struct RFM23BRegConfig final
+        {
+        static_assert(RFM23BChannelDescOK(d), "channel cannot be represented with these settings");
+        // Number of rows including the terminator.
+        static constexpr uint8_t ROWS = 77;
+        static constexpr uint8_t values[ROWS][2] OTRFM23BLINK_REGCONFIG_PROGMEM =
+            {
+            { 0x05, 0 }, { 0x06, 0 }, // Interrupts are enabled by the driver.
+            { 0x07, 1 }, // XTON.
+            { 0x08, 0 }, { 0x09, 0x7f }, { 0x0a, 6 }, { 0x0b, 0x15 }, { 0x0c, 0x12 },
+            { 0x0d, 0 }, { 0x0e, 0 }, { 0x0f, 0 }, { 0x10, 0 },
+            { 0x12, 0x20 }, { 0x13, 0 }, { 0x14, 3 }, { 0x15, 0 }, { 0x16, 1 },
+            { 0x19, 1 }, { 0x1a, 0x14 },
+            { 0x1c, RFM23BIFFilterReg(d) },
+            { 0x1d, 0x44 }, { 0x1e, 0x0a }, { 0x1f, 3 },
+            { 0x20, uint8_t(RFM23BRXOSR(d)) },
+            { 0x21, uint8_t(((RFM23BRXOSR(d) >> 3) & 0xe0) | ((RFM23BNCOff(d) >> 16) & 0x0f)) },
+            { 0x22, uint8_t(RFM23BNCOff(d) >> 8) },
+            { 0x23, uint8_t(RFM23BNCOff(d)) },
+            { 0x24, uint8_t((RFM23BCRGain(d) >> 8) & 7) },
+            { 0x25, uint8_t(RFM23BCRGain(d)) },
+            { 0x27, 0x1e },
+            { 0x2a, RFM23BAFCLimitReg(d) },
+            { 0x2c, 0x40 }, { 0x2d, 0x0a }, { 0x2e, 0x2d },
+            { 0x30, uint8_t(0x88 | (d.hwCRC ? 0x05 : 0)) },
+            { 0x32, 0 },
+            { 0x33, uint8_t((d.fixedLength ? 0x08 : 0) | ((d.syncBytes - 1) << 1) | (((d.preambleBits / 4) >> 8) & 1)) },
+            { 0x34, uint8_t(d.preambleBits / 4) },
+            { 0x35, uint8_t(((d.preambleDetectBits / 4) << 3) | 2) },
+            { 0x36, RFM23BSyncByte(d, 0) }, { 0x37, RFM23BSyncByte(d, 1) },
+            { 0x38, RFM23BSyncByte(d, 2) }, { 0x39, RFM23BSyncByte(d, 3) },
+            { 0x3a, 0 }, { 0x3b, 0 }, { 0x3c, 0 }, { 0x3d, 0 }, { 0x3e, 0 },
+            { 0x3f, 0 }, { 0x40, 0 }, { 0x41, 0 }, { 0x42, 0 },
+            { 0x43, 0xff }, { 0x44, 0xff }, { 0x45, 0xff }, { 0x46, 0xff },
+            { 0x4f, 0x10 },
+            { 0x60, 0xa0 },
+            { 0x62, 0x24 },
+            { 0x69, 0x60 },
+            { 0x6d, d.txPowerReg },
+            { 0x6e, uint8_t(RFM23BDataRateReg(d) >> 8) },
+            { 0x6f, uint8_t(RFM23BDataRateReg(d)) },
+            { 0x70, uint8_t(0x0c | (RFM23BDataRateScaled(d) ? 0x20 : 0)) },
+            { 0x71, uint8_t(0x20 | ((RFM23BDeviationReg(d) >> 6) & 0x04) | (d.gaussian ? 3 : 2)) },
+            { 0x72, uint8_t(RFM23BDeviationReg(d)) },
+            { 0x73, 0 }, { 0x74, 0 },
+            { 0x75, RFM23BBandSelectReg(d) },
+            { 0x76, uint8_t(RFM23BCarrierReg(d) >> 8) },
+            { 0x77, uint8_t(RFM23BCarrierReg(d)) },
+            { 0x79, 0 }, { 0x7a, 0 },
+            { 0x7c, 0x37 }, { 0x7d, 4 }, { 0x7e, 0x37 },
+            { 0xff, 0xff } // End of settings.
+            };
+        };
+    template<const RFM23BChannelDesc &d>
+    constexpr uint8_t RFM23BRegConfig<d>::values[RFM23BRegConfig<d>::ROWS][2] OTRFM23BLINK_REGCONFIG_PROGMEM;
+
+    }
+
+#endif
@@ -0,0 +1,152 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ EFR32 USART + LDMA SPI transport for the RFM23B.
+ */
+
+#include "OTRFM23BLink_SPITransport.h"
+
+#ifdef EFR32FG1P133F256GM48
+
+extern "C" {
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_usart.h"
+}
+
+#include "OTV0P2BASE_Serial_IO.h"
+
+namespace OTRFM23BLink
+{
+
+
+// Instance with a DMA burst in progress, for the ISR; NULL if none.
+static EFR32USARTLDMASPI *volatile activeDMA = NULL;
+// Source of 0s to send, and sink for bytes to discard, without address increment.
+static const uint8_t dmaZero = 0;
+static uint8_t dmaSink;
+
+bool EFR32USARTLDMASPI::begin()
+    {
+    CMU_ClockEnable(cmuClock_HFPER, true);
+    CMU_ClockEnable(cmuClock_GPIO, true);
+    CMU_ClockEnable((USART0 == c.usart) ? cmuClock_USART0 : cmuClock_USART1, true);
+    // Share the LDMA if already set up, eg by the serial output.
+    const bool ldmaUp = (0 != (CMU->HFBUSCLKEN0 & CMU_HFBUSCLKEN0_LDMA));
+    CMU_ClockEnable(cmuClock_LDMA, true);
+
+    USART_InitSync_TypeDef init = USART_INITSYNC_DEFAULT;
+    init.baudrate = c.baud;
+    init.msbf = true;
+    USART_InitSync(c.usart, &init);
+    c.usart->ROUTELOC0 = c.routeLoc0;
+    c.usart->ROUTEPEN = USART_ROUTEPEN_TXPEN | USART_ROUTEPEN_RXPEN | USART_ROUTEPEN_CLKPEN;
+
+    GPIO_PinModeSet(c.mosiPort, c.mosiPin, gpioModePushPull, 0);
+    GPIO_PinModeSet(c.misoPort, c.misoPin, gpioModeInput, 0);
+    GPIO_PinModeSet(c.clkPort, c.clkPin, gpioModePushPull, 0);
+    GPIO_PinModeSet(c.csPort, c.csPin, gpioModePushPull, 1); // Deselected.
+
+    if(!ldmaUp)
+        {
+        LDMA_Init_t ldmaInit = LDMA_INIT_DEFAULT;
+        LDMA_Init(&ldmaInit);
+        }
+    return(true);
+    }
+
+uint8_t EFR32USARTLDMASPI::io(const uint8_t data)
+    { return(USART_SpiTransfer(c.usart, data)); }
+
+// Start the RX then the TX channel, so that no byte read can be missed.
+// Only the RX channel interrupts: when it is done the last byte has been clocked in.
+void EFR32USARTLDMASPI::startDMA(const uint8_t *const tx, uint8_t *const rx, const uint8_t n)
+    {
+    const bool u0 = (USART0 == c.usart);
+    const LDMA_TransferCfg_t rxCfg = LDMA_TRANSFER_CFG_PERIPHERAL(
+        u0 ? ldmaPeripheralSignal_USART0_RXDATAV : ldmaPeripheralSignal_USART1_RXDATAV);
+    const LDMA_TransferCfg_t txCfg = LDMA_TRANSFER_CFG_PERIPHERAL(
+        u0 ? ldmaPeripheralSignal_USART0_TXBL : ldmaPeripheralSignal_USART1_TXBL);
+    const LDMA_Descriptor_t r = LDMA_DESCRIPTOR_SINGLE_P2M_BYTE(&c.usart->RXDATA, ((NULL == rx) ? &dmaSink : rx), n);
+    rxDesc = r;
+    if(NULL == rx) { rxDesc.xfer.dstInc = ldmaCtrlDstIncNone; }
+    const LDMA_Descriptor_t t = LDMA_DESCRIPTOR_SINGLE_M2P_BYTE(((NULL == tx) ? &dmaZero : tx), &c.usart->TXDATA, n);
+    txDesc = t;
+    if(NULL == tx) { txDesc.xfer.srcInc = ldmaCtrlSrcIncNone; }
+    txDesc.xfer.doneIfs = 0;
+    busy = true;
+    activeDMA = this;
+    c.usart->CMD = USART_CMD_CLEARRX;
+    LDMA_StartTransfer(c.rxCh, &rxCfg, &rxDesc);
+    LDMA_StartTransfer(c.txCh, &txCfg, &txDesc);
+    }
+
+// Short bursts are polled.
+// Longer ones sleep in EM1 until the LDMA ISR clears busy;
+// interrupts are masked around the test so that the wake-up cannot be missed,
+// as a pending interrupt still ends the WFI.
+void EFR32USARTLDMASPI::burst(const uint8_t *const tx, uint8_t *const rx, const uint8_t n)
+    {
+    if(n < DMA_MIN_BYTES) { RFM23BSPITransport::burst(tx, rx, n); return; }
+    while(busy) { }
+    async = false;
+    startDMA(tx, rx, n);
+    __disable_irq();
+    while(busy) { EMU_EnterEM1(); __enable_irq(); __disable_irq(); }
+    __enable_irq();
+    }
+
+bool EFR32USARTLDMASPI::startBurst(const uint8_t *const tx, uint8_t *const rx, const uint8_t n,
+                                   burstDone_fn_t *const done, void *const ctx)
+    {
+    if(busy) { return(false); }
+    if(n < DMA_MIN_BYTES) { return(RFM23BSPITransport::startBurst(tx, rx, n, done, ctx)); }
+    async = true;
+    doneFn = done;
+    doneCtx = ctx;
+    startDMA(tx, rx, n);
+    return(true);
+    }
+
+void EFR32USARTLDMASPI::onLDMAIRQ()
+    {
+    EFR32USARTLDMASPI *const t = activeDMA;
+    if(NULL == t) { return; }
+    const uint32_t mask = 1UL << t->c.rxCh;
+    if(0 == (LDMA_IntGet() & mask)) { return; }
+    LDMA_IntClear(mask);
+    activeDMA = NULL;
+    if(t->async) { t->deselect(); }
+    t->busy = false;
+    if(t->async && (NULL != t->doneFn)) { t->doneFn(t->doneCtx); }
+    }
+
+
+}
+
+#ifndef OTRFM23BLINK_NO_LDMA_IRQ_HANDLER
+// Also services the DMA-driven serial output.
+extern "C" void LDMA_IRQHandler()
+    {
+    OTRFM23BLink::EFR32USARTLDMASPI::onLDMAIRQ();
+    OTV0P2BASE::PrintEFR32::onLDMAIRQ();
+    }
+#endif
+
+#endif // EFR32FG1P133F256GM48
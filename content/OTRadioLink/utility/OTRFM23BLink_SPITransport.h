@@ -0,0 +1,226 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * SPI transport abstraction for the RFM23B register protocol,
+ * so that it is not tied to the AVR SPDR-style byte-at-a-time SPI
+ * and can use DMA where available (eg EFR32 USART + LDMA).
+ *
+ * The AVR OTRFM23BLink driver keeps its inline SPDR access for speed;
+ * on targets with DMA, FIFO bursts of up to 64 bytes can run
+ * with the CPU asleep, and an async burst signals completion from the ISR.
+ */
+
+#ifndef ARDUINO_LIB_OTRFM23BLINK_SPITRANSPORT_H
+#define ARDUINO_LIB_OTRFM23BLINK_SPITRANSPORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef EFR32FG1P133F256GM48
+extern "C" {
+#include "em_device.h"
+#include "em_gpio.h"
+#include "em_ldma.h"
+}
+#endif // EFR32FG1P133F256GM48
+
+namespace OTRFM23BLink
+    {
+    // Full-duplex SPI link to one device, with its own select line.
+    // Not thread-/ISR- safe except where stated.
+    class RFM23BSPITransport
+        {
+        public:
+            // Called when an async burst has finished and the device has been deselected,
+            // typically from the transport's (eg DMA) ISR, so should be brief.
+            typedef void (burstDone_fn_t)(void *ctx);
+
+            // Select/deselect the device (nSS low/high).
+            virtual void select() = 0;
+            virtual void deselect() = 0;
+            // Exchange one byte; device must be selected.
+            virtual uint8_t io(uint8_t data) = 0;
+
+            // Exchange n bytes; device must be selected.
+            // Sends 0s if tx is NULL, and discards the bytes read if rx is NULL.
+            // Blocks until complete, though may sleep (eg with DMA running).
+            // By default a byte at a time via io().
+            virtual void burst(const uint8_t *const tx, uint8_t *const rx, const uint8_t n)
+                {
+                for(uint8_t i = 0; i < n; ++i)
+                    {
+                    const uint8_t r = io((NULL == tx) ? 0 : tx[i]);
+                    if(NULL != rx) { rx[i] = r; }
+                    }
+                }
+
+            // Start exchanging n bytes as for burst(), then deselect and call done(ctx) if not NULL.
+            // The buffers must remain valid until then.
+            // Returns false without starting if a burst is already in progress.
+            // By default completes synchronously via burst() before returning.
+            virtual bool startBurst(const uint8_t *const tx, uint8_t *const rx, const uint8_t n,
+                                    burstDone_fn_t *const done, void *const ctx)
+                {
+                if(isBusy()) { return(false); }
+                burst(tx, rx, n);
+                deselect();
+                if(NULL != done) { done(ctx); }
+                return(true);
+                }
+
+            // True while an async burst is in progress; ISR-safe.
+            virtual bool isBusy() const { return(false); }
+        };
+
+    // RFM23B register access over an RFM23BSPITransport.
+    // Each access is one select cycle: a 7-bit register address,
+    // with the top bit set for a write, then the data.
+    // Bursts auto-increment the address, except for REG_FIFO.
+    // No access may be started while an async FIFO burst is in progress.
+    // Not thread-/ISR- safe.
+    class RFM23BRegisters final
+        {
+        private:
+            RFM23BSPITransport &spi;
+
+        public:
+            static constexpr uint8_t REG_FIFO = 0x7f; // TX FIFO on write, RX FIFO on read.
+
+            constexpr RFM23BRegisters(RFM23BSPITransport &t) : spi(t) { }
+
+            uint8_t read8(const uint8_t addr)
+                {
+                spi.select();
+                spi.io(addr & 0x7f); // Force to read.
+                const uint8_t v = spi.io(0);
+                spi.deselect();
+                return(v);
+                }
+            void write8(const uint8_t addr, const uint8_t val)
+                {
+                spi.select();
+                spi.io(addr | 0x80); // Force to write.
+                spi.io(val);
+                spi.deselect();
+                }
+            // Read a 16-bit big-endian register pair, as OTRFM23BLink::_readReg16Bit().
+            uint16_t read16(const uint8_t addr)
+                {
+                uint8_t b[2];
+                readBurst(addr, b, 2);
+                return(uint16_t((uint16_t(b[0]) << 8) | b[1]));
+                }
+
+            // Blocking burst read/write of n bytes starting at addr.
+            void readBurst(const uint8_t addr, uint8_t *const buf, const uint8_t n)
+                {
+                spi.select();
+                spi.io(addr & 0x7f);
+                spi.burst(NULL, buf, n);
+                spi.deselect();
+                }
+            void writeBurst(const uint8_t addr, const uint8_t *const buf, const uint8_t n)
+                {
+                spi.select();
+                spi.io(addr | 0x80);
+                spi.burst(buf, NULL, n);
+                spi.deselect();
+                }
+
+            // Start reading n bytes of the RX FIFO into buf, or writing n bytes of buf to the TX FIFO,
+            // calling done(ctx) (if not NULL, typically from an ISR) when complete.
+            // Returns false without starting if a burst is already in progress.
+            bool startReadFIFO(uint8_t *const buf, const uint8_t n,
+                               RFM23BSPITransport::burstDone_fn_t *const done, void *const ctx)
+                { return(startFIFO(REG_FIFO, NULL, buf, n, done, ctx)); }
+            bool startWriteFIFO(const uint8_t *const buf, const uint8_t n,
+                                RFM23BSPITransport::burstDone_fn_t *const done, void *const ctx)
+                { return(startFIFO(REG_FIFO | 0x80, buf, NULL, n, done, ctx)); }
+
+            // True while an async FIFO burst is in progress.
+            bool isBusy() const { return(spi.isBusy()); }
+
+        private:
+            bool startFIFO(const uint8_t cmd, const uint8_t *const tx, uint8_t *const rx, const uint8_t n,
+                           RFM23BSPITransport::burstDone_fn_t *const done, void *const ctx)
+                {
+                if(spi.isBusy()) { return(false); }
+                spi.select();
+                spi.io(cmd);
+                return(spi.startBurst(tx, rx, n, done, ctx));
+                }
+        };
+
+#ifdef EFR32FG1P133F256GM48
+    // RFM23B SPI on an EFR32 USART in synchronous master mode (mode 0, MSB first).
+    // Bursts of at least DMA_MIN_BYTES are moved by a pair of LDMA channels
+    // (RX and TX) with the CPU in EM1; shorter transfers, eg register access,
+    // are polled, as DMA set-up would cost more than it saves.
+    // The LDMA_IRQHandler here calls onLDMAIRQ() and PrintEFR32::onLDMAIRQ();
+    // define OTRFM23BLINK_NO_LDMA_IRQ_HANDLER to supply your own and call both from it.
+    // Only one instance may have a DMA burst in progress at any one time.
+    class EFR32USARTLDMASPI final : public RFM23BSPITransport
+        {
+        public:
+            // Shortest burst worth DMA.
+            static constexpr uint8_t DMA_MIN_BYTES = 4;
+
+            struct Config_t
+                {
+                USART_TypeDef *usart; // USART0 or USART1.
+                uint32_t routeLoc0; // USART ROUTELOC0 value for the TX, RX and CLK locations.
+                GPIO_Port_TypeDef mosiPort, misoPort, clkPort, csPort;
+                uint8_t mosiPin, misoPin, clkPin, csPin;
+                uint32_t baud;
+                uint8_t txCh, rxCh; // Distinct free LDMA channels.
+                };
+
+            EFR32USARTLDMASPI(const Config_t &config) : c(config) { }
+
+            // Set up clocks, the USART, pins (deselected) and the LDMA; call once.
+            bool begin();
+
+            virtual void select() override { GPIO_PinOutClear(c.csPort, c.csPin); }
+            virtual void deselect() override { GPIO_PinOutSet(c.csPort, c.csPin); }
+            virtual uint8_t io(uint8_t data) override;
+            virtual void burst(const uint8_t *tx, uint8_t *rx, uint8_t n) override;
+            virtual bool startBurst(const uint8_t *tx, uint8_t *rx, uint8_t n,
+                                    burstDone_fn_t *done, void *ctx) override;
+            virtual bool isBusy() const override { return(busy); }
+
+            // Service LDMA interrupts for the burst in progress; call from LDMA_IRQHandler.
+            static void onLDMAIRQ();
+
+        private:
+            const Config_t c;
+            volatile bool busy = false;
+            // If true then deselect and call doneFn at the end of the burst.
+            bool async = false;
+            burstDone_fn_t *doneFn = NULL;
+            void *doneCtx = NULL;
+            // Descriptors must stay valid while the LDMA runs.
+            LDMA_Descriptor_t rxDesc, txDesc;
+
+            void startDMA(const uint8_t *tx, uint8_t *rx, uint8_t n);
+        };
+#endif // EFR32FG1P133F256GM48
+
+    }
+
+#endif
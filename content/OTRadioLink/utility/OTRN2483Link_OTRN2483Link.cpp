@@ -29,16 +29,198 @@ namespace OTRN2483Link
 {
 
 
+// Prefixes of lines carrying received frames.
+static const char RX_PREFIX_RADIO[] = "radio_rx";
+static const char RX_PREFIX_MAC[] = "mac_rx";
+
+// Returns nibble value of an upper- or lower- case hex digit, or 0xff if not hex.
+static inline uint8_t hexNibble(const uint8_t c)
+{
+    if((c >= '0') && (c <= '9')) { return(c - '0'); }
+    if((c >= 'A') && (c <= 'F')) { return(c - ('A' - 10)); }
+    if((c >= 'a') && (c <= 'f')) { return(c - ('a' - 10)); }
+    return(0xff);
+}
+
+void OTRN2483RXParser::reset()
+{
+    if(NULL != buf) { queue._loadedBuf(0); }
+    state = PREFIX;
+    pos = 0;
+    candidates = 3;
+    isMAC = false;
+    buf = NULL;
+    len = 0;
+    haveHi = false;
+}
+
+void OTRN2483RXParser::abandon(const bool countDrop)
+{
+    if(NULL != buf) { queue._loadedBuf(0); buf = NULL; }
+    if(countDrop && (0xff != dropped)) { ++dropped; }
+    state = DISCARD;
+}
+
+bool OTRN2483RXParser::handleByte(const uint8_t c)
+{
+    const bool eol = ('\r' == c) || ('\n' == c);
+    switch(state)
+        {
+        case PREFIX:
+            {
+            if(eol) { reset(); return(false); }
+            // Knock out prefixes that no longer match.
+            if((candidates & 1) && (c != (uint8_t)RX_PREFIX_RADIO[pos])) { candidates &= ~1; }
+            if((candidates & 2) && (c != (uint8_t)RX_PREFIX_MAC[pos])) { candidates &= ~2; }
+            if(0 == candidates) { state = DISCARD; return(false); }
+            ++pos;
+            if((candidates & 1) && ('\0' == RX_PREFIX_RADIO[pos])) { isMAC = false; state = SEP; }
+            else if((candidates & 2) && ('\0' == RX_PREFIX_MAC[pos])) { isMAC = true; state = SEP; }
+            return(false);
+            }
+        case SEP:
+            {
+            if(' ' == c) { return(false); }
+            if(isMAC)
+                {
+                if((c >= '0') && (c <= '9')) { state = PORT; return(false); }
+                state = eol ? PREFIX : DISCARD;
+                if(eol) { reset(); }
+                return(false);
+                }
+            // Start of data for radio_rx:
+            state = DATA;
+            break; // Process c as data below.
+            }
+        case PORT:
+            {
+            if((c >= '0') && (c <= '9')) { return(false); }
+            if(' ' == c) { state = PORTSEP; return(false); }
+            // Port with no data (or junk).
+            if(eol) { reset(); } else { state = DISCARD; }
+            return(false);
+            }
+        case PORTSEP:
+            {
+            if(' ' == c) { return(false); }
+            state = DATA;
+            break; // Process c as data below.
+            }
+        case DATA:
+            break;
+        case DISCARD:
+        default:
+            {
+            if(eol) { reset(); }
+            return(false);
+            }
+        }
+
+    // DATA state handling: decode hex pairs into the queue.
+    if(eol)
+        {
+        // Complete frame only if at least one whole byte and no dangling nibble.
+        bool queued = false;
+        if(NULL != buf)
+            {
+            if((len > 0) && !haveHi) { queue._loadedBuf(len); queued = true; }
+            else { queue._loadedBuf(0); }
+            buf = NULL;
+            }
+        reset();
+        return(queued);
+        }
+    const uint8_t n = hexNibble(c);
+    if(0xff == n) { abandon(false); return(false); }
+    if(NULL == buf)
+        {
+        buf = queue._getRXBufForInbound();
+        // No space to receive this frame.
+        if(NULL == buf) { abandon(true); return(false); }
+        }
+    if(!haveHi) { hi = n; haveHi = true; return(false); }
+    haveHi = false;
+    // Frame too long to queue.
+    if(len >= maxLen) { abandon(true); return(false); }
+    buf[len++] = (uint8_t)((hi << 4) | n);
+    return(false);
+}
+
+
+namespace OTRN2483Response
+{
+
+// Length of the first line of resp.
+static uint8_t lineLength(const char *const resp, const uint8_t len)
+{
+    uint8_t n = 0;
+    while((n < len) && ('\0' != resp[n]) && ('\r' != resp[n]) && ('\n' != resp[n])) { ++n; }
+    return(n);
+}
+
+bool matches(const char *const resp, const uint8_t len, const char *const expected)
+{
+    if(NULL == resp) { return(false); }
+    const uint8_t n = lineLength(resp, len);
+    for(uint8_t i = 0; i < n; ++i)
+        {
+        const char e = expected[i];
+        if('\0' == e) { return(false); }
+        char c = resp[i];
+        if((c >= 'a') && (c <= 'z')) { c = (char)(c - ('a' - 'A')); }
+        const char eu = ((e >= 'a') && (e <= 'z')) ? (char)(e - ('a' - 'A')) : e;
+        if(c != eu) { return(false); }
+        }
+    return('\0' == expected[n]);
+}
+
+bool parseU32(const char *const resp, const uint8_t len, uint32_t &out)
+{
+    if(NULL == resp) { return(false); }
+    const uint8_t n = lineLength(resp, len);
+    if(0 == n) { return(false); }
+    uint32_t v = 0;
+    for(uint8_t i = 0; i < n; ++i)
+        {
+        const char c = resp[i];
+        if((c < '0') || (c > '9')) { return(false); }
+        const uint8_t d = (uint8_t)(c - '0');
+        if(v > ((0xffffffffUL - d) / 10)) { return(false); }
+        v = (v * 10) + d;
+        }
+    out = v;
+    return(true);
+}
+
+char *formatU32(char *buf, uint32_t v)
+{
+    // Digits in reverse, then copied out.
+    char tmp[10];
+    uint8_t n = 0;
+    do { tmp[n++] = (char)('0' + (v % 10)); v /= 10; } while(0 != v);
+    while(n > 0) { *buf++ = tmp[--n]; }
+    *buf = '\0';
+    return(buf);
+}
+
+}
+
+
 #ifdef OTRN2483Link_DEFINED
 
 // TODO proper constructor
 
-OTRN2483Link::OTRN2483Link(uint8_t _nRstPin, uint8_t rxPin, uint8_t txPin) : config(NULL), ser(rxPin, txPin), nRstPin(_nRstPin) {
+template<uint16_t baud>
+OTRN2483LinkT<baud>::OTRN2483LinkT(uint8_t _nRstPin, uint8_t _rxPin, uint8_t txPin)
+  : config(NULL), ser(_rxPin, txPin), nRstPin(_nRstPin), rxPin(_rxPin), rxActivity(0), rxParser(queueRX, maxRXFrameLen) {
 	bAvailable = false;
+	bJoined = false;
+	txSinceSave = 0;
 	// Init OTSoftSerial
 }
 
-bool OTRN2483Link::begin() {
+template<uint16_t baud>
+bool OTRN2483LinkT<baud>::begin() {
 	char buffer[5];
 	memset(buffer, 0, 5);
 
@@ -58,13 +240,47 @@ bool OTRN2483Link::begin() {
 	setBaud();
 	// todo check RN2483 is present and communicative here
 
+	// Only set up for TTN (many slow commands) if not already done and saved;
+	// else just make sure that the frame counter cannot repeat.
+	if(isProvisioned()) { restoreFrameCounter(); }
+	else { provision(); }
+
+	// Join at the first send.
+	bJoined = false;
+	txSinceSave = 0;
+	return true;
+}
+
+/**
+ * @brief   Checks whether the module already holds this link's settings,
+ *          as saved by provision(), with one round-trip.
+ * @retval  True if the device address matches.
+ */
+template<uint16_t baud>
+bool OTRN2483LinkT<baud>::isProvisioned()
+{
+    char buf[12];
+    print(MAC_START);
+    print(RN2483_GET);
+    print(MAC_GET_DEVADDR);
+    print(RN2483_END);
+    const uint8_t n = timedBlockingRead(buf, sizeof(buf));
+    return(OTRN2483Response::matches(buf, n, DEVADDR));
+}
+
+/**
+ * @brief   Sets up the module for TTN and saves the settings in its EEPROM.
+ */
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::provision()
+{
 	// Set up for TTN
 //#ifndef RN2483_CONFIG_IN_EEPROM
 //	// Set Device Address
-    setDevAddr(NULL); // TODO not needed if saved to EEPROM
+    setDevAddr(NULL);
 //
 //	// Set keys
-    setKeys(NULL, NULL); // TODO not needed if saved to EEPROM
+    setKeys(NULL, NULL);
 //#endif
 
     // Set data rate
@@ -76,20 +292,56 @@ bool OTRN2483Link::begin() {
     // set power level
 //    setTxPower(1);
 
+    // Keep the settings (and frame counter) over module resets.
+    save();
+}
+
+/**
+ * @brief   Steps the restored uplink frame counter past any frames sent
+ *          since it was last saved, and saves it again.
+ * @note    Leaves the counter alone if it cannot be read.
+ */
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::restoreFrameCounter()
+{
+    char buf[12];
+    print(MAC_START);
+    print(RN2483_GET);
+    print(MAC_UPCTR);
+    print(RN2483_END);
+    const uint8_t n = timedBlockingRead(buf, sizeof(buf));
+    uint32_t upctr;
+    if(!OTRN2483Response::parseU32(buf, n, upctr)) { return; }
+    char num[11];
+    OTRN2483Response::formatU32(num, upctr + frameCounterSaveInterval);
+    print(MAC_START);
+    print(RN2483_SET);
+    print(MAC_UPCTR);
+    print(' ');
+    print(num);
+    print(RN2483_END);
+    save();
+}
+
+/**
+ * @brief   Joins the network if not already joined since begin().
+ */
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::ensureJoined()
+{
+    if(bJoined) { return; }
     // join network
     joinABP();
-
 	// get status (returns 0001 when connected and not Txing)
     getStatus();
-
-	// Send
-	return true;
+    bJoined = true;
 }
 
 /**
  * @brief	End LoRaWAN connection
  */
-bool OTRN2483Link::end()
+template<uint16_t baud>
+bool OTRN2483LinkT<baud>::end()
 {
 	return true;
 }
@@ -99,8 +351,9 @@ bool OTRN2483Link::end()
  * @brief   Sends a raw frame
  * @param   buf	Send buffer.
  */
-bool OTRN2483Link::sendRaw(const uint8_t* buf, uint8_t buflen,
-		int8_t /*channel*/, TXpower /*power*/, bool /*listenAfter*/)
+template<uint16_t baud>
+bool OTRN2483LinkT<baud>::sendRaw(const uint8_t* buf, uint8_t buflen,
+		int8_t channel, TXpower /*power*/, bool /*listenAfter*/)
 {
 	char dataBuf[16];
 	memset(dataBuf, 0, sizeof(dataBuf));
@@ -108,6 +361,7 @@ bool OTRN2483Link::sendRaw(const uint8_t* buf, uint8_t buflen,
 	setBaud();
 	OTV0P2BASE::nap(WDTO_15MS, true);
 #endif // RN2483_ALLOW_SLEEP
+	ensureJoined();
 #if 0
 	print(MAC_START);
 	print(RN2483_GET);
@@ -116,18 +370,22 @@ bool OTRN2483Link::sendRaw(const uint8_t* buf, uint8_t buflen,
     timedBlockingRead(dataBuf, sizeof(dataBuf));
     OTV0P2BASE::serialPrintAndFlush(dataBuf);
 #endif // 1
-	uint8_t outputBuf[buflen * 2];
-	getHex(buf, outputBuf, sizeof(outputBuf));
 	print(MAC_START);
 	print(MAC_SEND);
-	write((const char *)outputBuf, sizeof(outputBuf));
+	printHex(buf, buflen);
 	print(RN2483_END);
+	// Airtime is only approximated from the channel bitrate (ie the LoRa data rate).
+	_recordTX(channel, buflen);
 #if 1
-	timedBlockingRead(dataBuf, sizeof(dataBuf));
+	const uint8_t rlen = timedBlockingRead(dataBuf, sizeof(dataBuf));
+	// Pass the response on in case it contains a downlink.
+	for(uint8_t i = 0; i < rlen; ++i) { rxParser.handleByte((uint8_t)dataBuf[i]); }
 	OTV0P2BASE::serialPrintAndFlush(dataBuf);
-	OTV0P2BASE::serialPrintAndFlush(sizeof(outputBuf));
+	OTV0P2BASE::serialPrintAndFlush(buflen);
     OTV0P2BASE::serialPrintlnAndFlush();
 #endif
+	// Periodically save the frame counter.
+	if(++txSinceSave >= frameCounterSaveInterval) { save(); txSinceSave = 0; }
 #ifdef RN2483_ALLOW_SLEEP
 	OTV0P2BASE::nap(WDTO_120MS, true);
 	print(SYS_START);
@@ -140,12 +398,48 @@ bool OTRN2483Link::sendRaw(const uint8_t* buf, uint8_t buflen,
 }
 
 
-void OTRN2483Link::poll()
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::poll()
 {
+    // Clear the flag first so that activity during the read is seen next time.
+    const bool seen = (0 != rxActivity.load());
+    rxActivity.store(0);
+    if(!seen && fastDigitalRead(rxPin)) { return; }
+    readIntoRXQueue();
+}
+
+template<uint16_t baud>
+bool OTRN2483LinkT<baud>::handleInterruptSimple()
+{
+    if(fastDigitalRead(rxPin)) { return(false); }
+    rxActivity.store(1);
+    return(true);
+}
 
+/**
+ * @brief   Reads bytes from the RN2483 into the RX parser while they are arriving.
+ * @retval  True if any bytes were read.
+ * @note    Reads until the line has been idle for the serial timeout,
+ *          so blocks for at least that long; call from poll(), never from an ISR.
+ *          Bytes sent before the read starts are lost,
+ *          and the parser drops any frame so truncated.
+ */
+template<uint16_t baud>
+bool OTRN2483LinkT<baud>::readIntoRXQueue()
+{
+    bool any = false;
+    for( ; ; )
+        {
+        const uint8_t c = ser.read();
+        if(0 == c) { break; } // Timed out: line idle.
+        rxParser.handleByte(c);
+        any = true;
+        }
+    return(any);
 }
 
-uint8_t OTRN2483Link::timedBlockingRead(char *data, uint8_t length)
+template<uint16_t baud>
+uint8_t OTRN2483LinkT<baud>::timedBlockingRead(char *data, uint8_t length)
 {
 
 	  // clear buffer, get time and init i to 0
@@ -167,7 +461,8 @@ uint8_t OTRN2483Link::timedBlockingRead(char *data, uint8_t length)
  * @param   data    Buffer to write
  * @param   length  Length of data buffer
  */
-void OTRN2483Link::write(const char *data, uint8_t length)
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::write(const char *data, uint8_t length)
 {
 	ser.write(data, length);
 }
@@ -176,7 +471,8 @@ void OTRN2483Link::write(const char *data, uint8_t length)
  * @brief   Prints a single character to RN2483
  * @param   data character to print
  */
-void OTRN2483Link::print(const char data)
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::print(const char data)
 {
 	ser.print(data);
 }
@@ -184,7 +480,8 @@ void OTRN2483Link::print(const char data)
  * @brief   Prints a string to the RN2483
  * @param   pointer to a \0 terminated char string
  */
-void OTRN2483Link::print(const char *string)
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::print(const char *string)
 {
 	ser.print(string);
 }
@@ -192,7 +489,8 @@ void OTRN2483Link::print(const char *string)
 /**
  * @brief   Sends a 5 ms break
  */
-void OTRN2483Link::setBaud()
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::setBaud()
 {
 	ser.sendBreak();
 	print('U'); // send syncro character
@@ -214,7 +512,8 @@ void OTRN2483Link::setBaud()
  * @brief   reset device
  * @note    Currently using software reset as there is a short on my REV14
  */
-void OTRN2483Link::reset()
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::reset()
 {
 	print(SYS_START);
 	print(SYS_RESET);
@@ -232,12 +531,13 @@ void OTRN2483Link::reset()
  *          and is using addresses 00-04 (as of 2016-01-29)
  * @todo    Confirm this is in hex
  */
-void OTRN2483Link::setDevAddr(const uint8_t */*address*/)
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::setDevAddr(const uint8_t */*address*/)
 {
 	print(MAC_START);
 	print(RN2483_SET);
 	print(MAC_DEVADDR);
-	print("02011123"); // TODO this will be stored as number in config
+	print(DEVADDR); // TODO this will be stored as number in config
 //	print(address);
 	print(RN2483_END);
 }
@@ -250,7 +550,8 @@ void OTRN2483Link::setDevAddr(const uint8_t */*address*/)
  *                      The key is: 2B7E151628AED2A6ABF7158809CF4F3C
  * @note    The RN2483 takes numbers as HEX values.
  */
-void OTRN2483Link::setKeys(const uint8_t */*appKey*/, const uint8_t */*networkKey*/)
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::setKeys(const uint8_t */*appKey*/, const uint8_t */*networkKey*/)
 {
 	print(MAC_START);
 	print(RN2483_SET);
@@ -268,7 +569,8 @@ void OTRN2483Link::setKeys(const uint8_t */*appKey*/, const uint8_t */*networkKe
  * @brief   Sets adaptive data rate depending on config and activates connection by personalisation
  * @todo    Move adaptive data rate out.
  */
-void OTRN2483Link::joinABP()
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::joinABP()
 {
 	print(MAC_START);
 	print(MAC_JOINABP); // Join by ABP (activation by personalisation)
@@ -280,7 +582,8 @@ void OTRN2483Link::joinABP()
  * @todo    Find out what status messages mean and document.
  *          Implement check
  */
-bool OTRN2483Link::getStatus()
+template<uint16_t baud>
+bool OTRN2483LinkT<baud>::getStatus()
 {
 	print(MAC_START);
 	print(RN2483_GET);
@@ -291,7 +594,8 @@ bool OTRN2483Link::getStatus()
 /**
  * @brief   Saves current mac state
  */
-void OTRN2483Link::save()
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::save()
 {
 	print(MAC_START);
 	print(MAC_SAVE);
@@ -314,7 +618,8 @@ void OTRN2483Link::save()
  * @note    Command reference says it sets the data rate of the next send but
  *          I think it sets data rate for ALL subsequent sends on ALL channels.
  */
-void OTRN2483Link::setDataRate(uint8_t dataRate)
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::setDataRate(uint8_t dataRate)
 {
     print(MAC_START);
     print(RN2483_SET);
@@ -341,7 +646,8 @@ void OTRN2483Link::setDataRate(uint8_t dataRate)
  *          AND channel data rate ranges must be set.
  * @todo    Test if this works on 2016/3/8
  */
-void OTRN2483Link::setAdaptiveDataRate(uint8_t minRate, uint8_t maxRate)
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::setAdaptiveDataRate(uint8_t minRate, uint8_t maxRate)
 {
 	// convert data rates to ascii
 	char min = '0' + minRate;
@@ -378,7 +684,8 @@ void OTRN2483Link::setAdaptiveDataRate(uint8_t minRate, uint8_t maxRate)
  * @note    RN2483 defaults to setting 1 (14 dBm)
  * @note    The output levels on page 7 of the datasheet are for point to point levels.
  */
-void OTRN2483Link::setTxPower(uint8_t power)
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::setTxPower(uint8_t power)
 {
     print(MAC_START);
     print(RN2483_SET);
@@ -388,84 +695,87 @@ void OTRN2483Link::setTxPower(uint8_t power)
 }
 
 /**
- * @brief   converts a string to hex representation
- * @param   string  String to convert. Will terminate if passed a null pointer.
- * @param   output  Buffer to hold output. This should be twice the length of string
- *                  Will terminate if passed a null pointer.
- * @param   outputLen   Length of output
- * @retval  returns true if output success
- * @note    This function only checks output bounds. If input string is too short
- *          it will overrun.
- * @todo    Possibly better to make part of send function and send as byte is converted
+ * @brief   Sends a buffer to the RN2483 as upper-case hex.
+ * @param   buf     Bytes to send; must not be NULL.
+ * @param   len     Number of bytes to send; 2*len digits are written.
+ * @note    Streams each digit straight to the serial port, so needs no
+ *          output buffer of twice the frame length on the stack.
  */
-bool OTRN2483Link::getHex(const uint8_t *input, uint8_t *output, uint8_t outputLen)
-{
-	  if((input == NULL) || (output == NULL)) return false; // check for null pointer
-	    uint8_t counter = outputLen;
-	    // convert to hex
-	  while(counter) {
-	    uint8_t highValue = *input >> 4;
-	    uint8_t lowValue  = *input & 0x0f;
-	    uint8_t temp;
-
-	    temp = highValue;
-	    if(temp <= 9) temp += '0';
-	    else temp += ('A' - 10);
-	    *output++ = temp;
-
-	    temp = lowValue;
-	    if(temp <= 9) temp += '0';
-	    else temp += ('A'-10);
-	    *output++ = temp;
-
-	    input++;
-	    counter -= 2;
-	  }
-#if 0
-	  OTV0P2BASE::serialPrintAndFlush("hex out: ");
-	  OTV0P2BASE::serialPrintAndFlush((const char *)output);
-	  OTV0P2BASE::serialPrintlnAndFlush();
-#endif
-	  return true;
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::printHex(const uint8_t *buf, uint8_t len)
+{
+    static const char HEX_DIGITS[17] = "0123456789ABCDEF";
+    while(len-- > 0) {
+        const uint8_t b = *buf++;
+        ser.print(HEX_DIGITS[b >> 4]);
+        ser.print(HEX_DIGITS[b & 0xf]);
+    }
 }
 
-/****************************** Unused Virtual methods ***************************/
-void OTRN2483Link::getCapacity(uint8_t& queueRXMsgsMin,
+/****************************** RX queue ***************************/
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::getCapacity(uint8_t& queueRXMsgsMin,
 		uint8_t& maxRXMsgLen, uint8_t& maxTXMsgLen) const {
-    queueRXMsgsMin = 0;
-    maxRXMsgLen = 0;
+    queueRX.getRXCapacity(queueRXMsgsMin, maxRXMsgLen);
     maxTXMsgLen = 0;
 }
-uint8_t OTRN2483Link::getRXMsgsQueued() const {
-    return 0;
+template<uint16_t baud>
+uint8_t OTRN2483LinkT<baud>::getRXMsgsQueued() const {
+    return queueRX.getRXMsgsQueued();
+}
+template<uint16_t baud>
+const volatile uint8_t* OTRN2483LinkT<baud>::peekRXMsg() const {
+    return queueRX.peekRXMsg();
 }
-const volatile uint8_t* OTRN2483Link::peekRXMsg() const {
-    return NULL;
+template<uint16_t baud>
+void OTRN2483LinkT<baud>::removeRXMsg() {
+    queueRX.removeRXMsg();
 }
 
-const char OTRN2483Link::SYS_START[5] = "sys ";
-const char OTRN2483Link::SYS_SLEEP[7] = "sleep ";
-const char OTRN2483Link::SYS_RESET[6] = "reset"; // FIXME this can be removed on board with working reset line
+template<uint16_t baud> const char OTRN2483LinkT<baud>::SYS_START[5] = "sys ";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::SYS_SLEEP[7] = "sleep ";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::SYS_RESET[6] = "reset"; // FIXME this can be removed on board with working reset line
 
-const char OTRN2483Link::MAC_START[5] = "mac ";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::MAC_START[5] = "mac ";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::MAC_DEVADDR[9] = "devaddr ";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::MAC_GET_DEVADDR[8] = "devaddr";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::DEVADDR[9] = "02011123";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::MAC_UPCTR[6] = "upctr";
 #ifndef RN2483_CONFIG_IN_EEPROM
-const char OTRN2483Link::MAC_DEVADDR[9] = "devaddr ";
-const char OTRN2483Link::MAC_APPSKEY[9] = "appskey ";
-const char OTRN2483Link::MAC_NWKSKEY[9] = "nwkskey ";
-const char OTRN2483Link::MAC_ADR[7] = "adr on";
-const char OTRN2483Link::MAC_SET_DR[4] = "dr ";
-const char OTRN2483Link::MAC_SET_CH[4] = "ch ";
-const char OTRN2483Link::MAC_SET_DRRANGE[9] = "drrange ";
-const char OTRN2483Link::MAC_POWER[9] = "pwridx ";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::MAC_APPSKEY[9] = "appskey ";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::MAC_NWKSKEY[9] = "nwkskey ";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::MAC_ADR[7] = "adr on";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::MAC_SET_DR[4] = "dr ";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::MAC_SET_CH[4] = "ch ";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::MAC_SET_DRRANGE[9] = "drrange ";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::MAC_POWER[9] = "pwridx ";
 #endif // RN2483_CONFIG_IN_EEPROM
-const char OTRN2483Link::MAC_JOINABP[9] = "join abp";
-const char OTRN2483Link::MAC_STATUS[7] = "status";
-const char OTRN2483Link::MAC_SEND[12] = "tx uncnf 1 ";		// Sends an unconfirmed packet on channel 1
-const char OTRN2483Link::MAC_SAVE[5] = "save";
-
-const char OTRN2483Link::RN2483_SET[5] = "set ";
-const char OTRN2483Link::RN2483_GET[5] = "get ";
-const char OTRN2483Link::RN2483_END[3] = "\r\n";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::MAC_JOINABP[9] = "join abp";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::MAC_STATUS[7] = "status";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::MAC_SEND[12] = "tx uncnf 1 ";		// Sends an unconfirmed packet on channel 1
+template<uint16_t baud> const char OTRN2483LinkT<baud>::MAC_SAVE[5] = "save";
+
+template<uint16_t baud> const char OTRN2483LinkT<baud>::RN2483_SET[5] = "set ";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::RN2483_GET[5] = "get ";
+template<uint16_t baud> const char OTRN2483LinkT<baud>::RN2483_END[3] = "\r\n";
+
+
+// Explicit instances, keeping the implementation out of the header;
+// only rates OTSoftSerial can time at this F_CPU (cf isBaudSupported()).
+#define OTRN2483_BAUD_USABLE(b) (((((F_CPU/4)/(b))/2) > 22) && (((F_CPU/4)/(b)) <= 255))
+#if OTRN2483_BAUD_USABLE(2400)
+template class OTRN2483LinkT<2400>;
+#endif
+#if OTRN2483_BAUD_USABLE(4800)
+template class OTRN2483LinkT<4800>;
+#endif
+#if OTRN2483_BAUD_USABLE(9600)
+template class OTRN2483LinkT<9600>;
+#endif
+#if OTRN2483_BAUD_USABLE(19200)
+template class OTRN2483LinkT<19200>;
+#endif
+#undef OTRN2483_BAUD_USABLE
 
 #endif // OTRN2483Link_DEFINED
 
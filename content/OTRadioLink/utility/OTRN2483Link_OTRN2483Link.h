@@ -38,7 +38,6 @@ Author(s) / Copyright (s): Deniz Erbilgin 2016
  *          Set adaptive data rate by uncommmenting #define RN2483_ENABLE_ADR below and setting limits on line 55 of #define RN2483_ENABLE_ADR
  * @todo    - Add config functionality
  *          - Move commands to progmem
- *          - Add intelligent way of utilising device eeprom (w/ mac save)
  *          - Is there any special low power mode?
  *          - Save stuff into EEPROM
  */
@@ -64,6 +63,7 @@ Author(s) / Copyright (s): Deniz Erbilgin 2016
 
 #include <OTRadioLink.h>
 #include <OTV0p2Base.h>
+#include "OTRadioLink_ISRRXQueue.h"
 #include <string.h>
 #include <stdint.h>
 
@@ -71,6 +71,106 @@ namespace OTRN2483Link
 {
 
 
+/**
+ * @brief   Incremental parser for RN2483 received-frame responses.
+ *          Bytes from the module are fed in one at a time, eg from a serial RX ISR,
+ *          and complete downlink frames are hex-decoded straight into an RX queue.
+ *          Recognises (terminated by CR and/or LF):
+ *            - "radio_rx  <hexdata>"       (raw radio mode)
+ *            - "mac_rx <port> <hexdata>"   (LoRaWAN downlink; port is discarded)
+ *          All other lines (eg "ok", "mac_tx_ok") are ignored.
+ *          All operations are fixed (low) cost and ISR-safe
+ *          so long as the parser is only fed from one context.
+ * @note    Frames too long for the queue, with bad hex, or with no room in the queue are dropped.
+ */
+class OTRN2483RXParser final
+{
+public:
+    /**
+     * @param   q   Queue to deliver decoded frames into.
+     * @param   maxFrameLen Maximum decoded frame length that q can accept, non-zero.
+     */
+    OTRN2483RXParser(::OTRadioLink::ISRRXQueue &q, uint8_t maxFrameLen)
+      : queue(q), maxLen(maxFrameLen), buf(NULL), hi(0), dropped(0) { reset(); }
+
+    /**
+     * @brief   Feed one byte received from the RN2483.
+     * @retval  True iff this byte completed a frame that was queued.
+     */
+    bool handleByte(uint8_t c);
+
+    /**
+     * @brief   Abandon any partial line/frame and wait for the start of a new line.
+     */
+    void reset();
+
+    /**
+     * @brief   Number of otherwise-valid frames dropped for lack of space or length; saturates at 255.
+     */
+    uint8_t getDroppedCount() const { return(dropped); }
+
+private:
+    enum state_t : uint8_t
+        {
+        PREFIX,     // Matching start of line against known prefixes.
+        SEP,        // Spaces after the prefix.
+        PORT,       // mac_rx port digits.
+        PORTSEP,    // Spaces after the port.
+        DATA,       // Hex data.
+        DISCARD     // Ignoring the rest of the line.
+        };
+    ::OTRadioLink::ISRRXQueue &queue;
+    const uint8_t maxLen;
+    state_t state;
+    // Position in the prefixes while in PREFIX state.
+    uint8_t pos;
+    // Bitmask of prefixes still matching: 1 for radio_rx, 2 for mac_rx.
+    uint8_t candidates;
+    // True if the matched prefix is mac_rx (and is followed by a port).
+    bool isMAC;
+    // Frame being decoded in place in the queue, or NULL.
+    volatile uint8_t *buf;
+    // Count of complete bytes decoded.
+    uint8_t len;
+    // True if the high nibble of the next byte is pending in hi.
+    bool haveHi;
+    uint8_t hi;
+    uint8_t dropped;
+
+    // Abandon any frame in progress and ignore the rest of the line.
+    void abandon(bool countDrop);
+};
+
+
+/**
+ * @brief   Helpers for checking single-line RN2483 command responses, eg to "mac get ...".
+ *          Portable so that they can be unit tested off-target.
+ */
+namespace OTRN2483Response
+{
+    /**
+     * @brief   True iff the first line of resp is expected, ignoring case.
+     * @param   resp    Response bytes, ending at the first CR, LF or '\0' or after len bytes.
+     * @param   len     Length of resp.
+     * @param   expected    '\0'-terminated expected line, not NULL.
+     */
+    bool matches(const char *resp, uint8_t len, const char *expected);
+    /**
+     * @brief   Parses the first line of resp as an unsigned decimal number, eg from "mac get upctr".
+     * @param   resp    Response bytes, ending at the first CR, LF or '\0' or after len bytes.
+     * @param   len     Length of resp.
+     * @param   out     Set to the value iff successful.
+     * @retval  False if the line is empty, has non-digits, or overflows 32 bits.
+     */
+    bool parseU32(const char *resp, uint8_t len, uint32_t &out);
+    /**
+     * @brief   Formats v in decimal into buf, which must have room for 11 chars; '\0'-terminated.
+     * @retval  Pointer to the terminating '\0'.
+     */
+    char *formatU32(char *buf, uint32_t v);
+}
+
+
 #ifdef ARDUINO_ARCH_AVR
 /**
  * @struct  OTRN2483LinkConfig
@@ -114,13 +214,26 @@ typedef struct OTRN2483LinkConfig {
 /**
  * @brief   This is a class that extends OTRadioLink to communicate via LoRaWAN
  *          using the RN2483 radio module.
+ * @note    begin() skips the full "mac set ..." provisioning when the module
+ *          already holds this link's settings from an earlier "mac save"
+ *          (checked with one "mac get devaddr" round-trip),
+ *          and the ABP join is deferred to the first send.
+ *          The module's uplink frame counter is saved every
+ *          frameCounterSaveInterval sends and stepped on by that much at each
+ *          restore, so it never repeats after a module reset.
  */
 #define OTRN2483Link_DEFINED
-class OTRN2483Link final : public OTRadioLink::OTRadioLink
+//   * baud  OTSoftSerial rate to the RN2483, auto-bauded in setBaud();
+//     must be timeable by OTSoftSerial at F_CPU (2400 and 4800 at 1MHz).
+//     Instances for 2400, 4800, 9600 and 19200 are compiled where usable.
+template<uint16_t baud = 2400>
+class OTRN2483LinkT final : public OTRadioLink::OTRadioLink
 {
+    static_assert(OTV0P2BASE::OTSoftSerial::isBaudSupported(baud), "baud too high for OTSoftSerial at F_CPU");
+
 public:
 	// Public interface
-    OTRN2483Link(uint8_t _nRstPin, uint8_t rxPin, uint8_t txPin);
+    OTRN2483LinkT(uint8_t _nRstPin, uint8_t rxPin, uint8_t txPin);
 
     void preinit(const void */*preconfig*/) {};
     bool begin();
@@ -129,16 +242,31 @@ public:
     bool sendRaw(const uint8_t *buf, uint8_t buflen, int8_t channel = 0, TXpower power = TXnormal, bool listenAfter = false);
 //    bool queueToSend(const uint8_t *buf, uint8_t buflen, int8_t channel = 0, TXpower power = TXnormal);
     inline bool isAvailable(){ return bAvailable; };     // checks radio is there independant of power state
-    bool handleInterruptSimple() { return true;};
+    /**
+     * @brief   Call from the RX pin-change interrupt when the RN2483 may have started sending.
+     *          Only notes the activity for poll() to receive; does not read from the serial line.
+     *          ISR-safe.
+     * @retval  True if the RX line is active (low).
+     */
+    bool handleInterruptSimple();
 
     /**
-     * @brief   Unused. For compatibility with OTRadioLink.
+     * @brief   Receives any bytes being sent by the RN2483 into the RX queue,
+     *          if the RX interrupt has seen activity since the last poll or the line is active now.
+     *          Returns at once otherwise.
      */
     void poll();
+    /**
+     * @brief   Feed one byte received from the RN2483 to the RX frame parser.
+     *          For use from an interrupt-driven serial RX, eg OTSoftSerialAsync.
+     *          ISR-safe.
+     * @retval  True iff a frame was completed and queued.
+     */
+    inline bool handleRXByte(uint8_t c) { return(rxParser.handleByte(c)); }
     void getCapacity(uint8_t &queueRXMsgsMin, uint8_t &maxRXMsgLen, uint8_t &maxTXMsgLen) const;
     uint8_t getRXMsgsQueued() const;
     const volatile uint8_t *peekRXMsg() const;
-    void removeRXMsg() {};
+    void removeRXMsg();
 
 
 private:
@@ -152,6 +280,12 @@ private:
     void print(const char *string);
     void print(const void *src);
 
+    // Session
+    bool isProvisioned();
+    void provision();
+    void restoreFrameCounter();
+    void ensureJoined();
+
     // Commands
     void factoryReset();
     void reset();
@@ -169,14 +303,33 @@ private:
     bool _doconfig() { return true; };
 
     // misc
-    bool getHex(const uint8_t *string, uint8_t *output, uint8_t outputLen);
+    // Send buf as upper-case hex, two digits per byte, with no intermediate buffer.
+    void printHex(const uint8_t *buf, uint8_t len);
+    // Read bytes from the RN2483 into the RX parser until the line goes idle.
+    // Not for use from an ISR.
+    bool readIntoRXQueue();
 
 // Private consts and variables
     const OTRN2483LinkConfig *config;  // Pointer to radio config
     OTV0P2BASE::OTSoftSerial ser;
-    static const uint16_t baud = 2400;	 // OTSoftSer baud rate. todo switch to template to allow higher speed
     bool bAvailable;
+    // True once joined since begin().
+    bool bJoined;
+    // Sends since the MAC state (ie frame counter) was last saved to module EEPROM.
+    uint8_t txSinceSave;
+    // Sends between saves of the frame counter, limiting module EEPROM wear;
+    // also the counter step on restore, so must be no less than the save interval.
+    static constexpr uint8_t frameCounterSaveInterval = 32;
     const uint8_t nRstPin;
+    const uint8_t rxPin;
+    // Non-zero when the RX interrupt has seen the RN2483 start sending; cleared by poll().
+    volatile OTV0P2BASE::Atomic_UInt8T rxActivity;
+
+    // Maximum downlink frame size queued; larger frames are dropped.
+    static constexpr uint8_t maxRXFrameLen = 32;
+    // Queue for decoded downlink frames, fed by rxParser.
+    ::OTRadioLink::ISRRXQueueVarLenMsg<maxRXFrameLen, 2> queueRX;
+    OTRN2483RXParser rxParser;
 
 
     static const char SYS_START[5];	  // Beginning of "sys" command set
@@ -184,8 +337,11 @@ private:
     static const char SYS_RESET[6]; // todo this can be removed on board with working reset line
 
     static const char MAC_START[5];   // Beginning of "mac" command set
-#ifndef RN2483_CONFIG_IN_EEPROM
     static const char MAC_DEVADDR[9]; // device address (required for ABP)
+    static const char MAC_GET_DEVADDR[8]; // device address, as the last word of a get
+    static const char DEVADDR[9];     // This node's device address, in hex.
+    static const char MAC_UPCTR[6];   // Uplink frame counter
+#ifndef RN2483_CONFIG_IN_EEPROM
     static const char MAC_APPSKEY[9]; // Application session key (required for ABP)
     static const char MAC_NWKSKEY[9]; // Network session key (required for ABP)
     static const char MAC_ADR[7];     // Set Adaptive Datarate "on"
@@ -208,6 +364,8 @@ private:
      */
     void _dolisten() {};
 };
+// The original fixed-rate link.
+typedef OTRN2483LinkT<> OTRN2483Link;
 #endif // ARDUINO_ARCH_AVR
 
 
@@ -183,16 +183,16 @@ uint8_t ModeButtonAndPotActuatorPhysicalUI::read()
                || valveController->isCallingForHeat()
                || valveMode->inBakeMode()) && !ambLight->isRoomDark()))
           {
+          OTV0P2BASE::LEDPattern p;
           // First flash to indicate WARM mode (or pot being twiddled).
-          LEDon();
           // LED on stepwise proportional to temp pot setting.
           // Small number of steps (3) should help make positioning more obvious.
           const uint8_t wt = tempControl->getWARMTargetC();
           // Makes vtiny|tiny|medium flash for cool|OK|warm temperature target.
           // Stick to minimum length flashes to save energy unless just touched.
-          if(minimiseOnTime || tempControl->isEcoTemperature(wt)) { veryTinyPause(); }
-          else if(!tempControl->isComfortTemperature(wt)) { tinyPause(); }
-          else { mediumPause(); }
+          if(minimiseOnTime || tempControl->isEcoTemperature(wt)) { p.add(VERYTINY_PAUSE_MS); }
+          else if(!tempControl->isComfortTemperature(wt)) { p.add(TINY_PAUSE_MS); }
+          else { p.add(MEDIUM_PAUSE_MS); }
 
           // Second flash to indicate actually calling for heat,
           // or likely to be calling for heat while interacting with the controls, to give fast user feedback (TODO-695).
@@ -200,27 +200,25 @@ uint8_t ModeButtonAndPotActuatorPhysicalUI::read()
               valveController->isCallingForHeat() ||
               valveMode->inBakeMode())
             {
-            LEDoff();
-            offPause(); // V0.09 was mediumPause().
-            LEDon(); // flash
+            p.add(OFF_PAUSE_MS); // V0.09 was mediumPause().
+            // Flash.
             // Stick to minimum length flashes to save energy unless just touched.
-            if(minimiseOnTime || tempControl->isEcoTemperature(wt)) { veryTinyPause(); }
-            else if(!tempControl->isComfortTemperature(wt)) { veryTinyPause(); veryTinyPause(); }
-            else { tinyPause(); }
+            if(minimiseOnTime || tempControl->isEcoTemperature(wt)) { p.add(VERYTINY_PAUSE_MS); }
+            else if(!tempControl->isComfortTemperature(wt)) { p.add(uint8_t(2*VERYTINY_PAUSE_MS)); }
+            else { p.add(TINY_PAUSE_MS); }
 
             if(valveMode->inBakeMode())
               {
               // Third (lengthened) flash to indicate BAKE mode.
-              LEDoff();
-              mediumPause(); // Note different flash off time to try to distinguish this last flash.
-              LEDon();
+              p.add(MEDIUM_PAUSE_MS); // Note different flash off time to try to distinguish this last flash.
               // Makes tiny|small|medium flash for eco|OK|comfort temperature target.
               // Stick to minimum length flashes to save energy unless just touched.
-              if(minimiseOnTime || tempControl->isEcoTemperature(wt)) { veryTinyPause(); }
-              else if(!tempControl->isComfortTemperature(wt)) { smallPause(); }
-              else { mediumPause(); }
+              if(minimiseOnTime || tempControl->isEcoTemperature(wt)) { p.add(VERYTINY_PAUSE_MS); }
+              else if(!tempControl->isComfortTemperature(wt)) { p.add(SMALL_PAUSE_MS); }
+              else { p.add(MEDIUM_PAUSE_MS); }
               }
             }
+          showLEDPattern(p);
           }
         }
 
@@ -235,17 +233,17 @@ uint8_t ModeButtonAndPotActuatorPhysicalUI::read()
               NominalRadValve.isControlledValveReallyOpen() */ )
         {
         // Double flash every 4th tick indicates call for heat while in FROST MODE (matches call for heat in WARM mode).
-        LEDon(); // flash
-        veryTinyPause();
-        LEDoff();
-        offPause();
-        LEDon(); // flash
-        veryTinyPause();
+        OTV0P2BASE::LEDPattern p;
+        p.add(VERYTINY_PAUSE_MS); // flash
+        p.add(OFF_PAUSE_MS);
+        p.add(VERYTINY_PAUSE_MS); // flash
+        showLEDPattern(p);
         }
       }
 
-    // Ensure that the main UI LED is forced off unconditionally at least once each cycle.
-    LEDoff();
+    // Ensure that the main UI LED is forced off unconditionally at least once each cycle,
+    // unless a non-blocking pattern is still showing (which ends with the LED off).
+    if((NULL == ledPlayerOpt) || !ledPlayerOpt->isActive()) { LEDoff(); }
 
     // Handle LEARN buttons (etc) in derived classes.
     // Also can be used to handle any simple user schedules.
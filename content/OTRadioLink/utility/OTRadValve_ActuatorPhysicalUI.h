@@ -34,6 +34,9 @@ Author(s) / Copyright (s): Damon Hart-Davis 2016--2018
 #include <stdint.h>
 #include <OTV0p2Base.h>
 #include "OTV0P2BASE_Actuator.h"
+#include "OTV0P2BASE_ButtonEvents.h"
+#include "OTV0P2BASE_CurrentBudget.h"
+#include "OTV0P2BASE_LEDPattern.h"
 #include "OTV0P2BASE_SensorAmbientLight.h"
 #include "OTV0P2BASE_SensorTemperaturePot.h"
 #include "OTV0P2BASE_SensorOccupancy.h"
@@ -144,6 +147,43 @@ class ModeButtonAndPotActuatorPhysicalUI : public ActuatorPhysicalUIBase
       bigPause(); // 120ms, was V0.09 144ms mediumPause() for PICAXE V0.09 impl.
       //  pollIO(); // Slip in an I/O poll.
       }
+    static const uint8_t OFF_PAUSE_MS = BIG_PAUSE_MS;
+
+    // Low-power pause for ms as a sequence of the xxxPause() routines above,
+    // eg 10ms as two veryTinyPause()s.
+    static void pauseMs(uint8_t ms)
+      {
+      while(ms >= BIG_PAUSE_MS) { bigPause(); ms -= BIG_PAUSE_MS; }
+      while(ms >= MEDIUM_PAUSE_MS) { mediumPause(); ms -= MEDIUM_PAUSE_MS; }
+      while(ms >= SMALL_PAUSE_MS) { smallPause(); ms -= SMALL_PAUSE_MS; }
+      while(ms >= TINY_PAUSE_MS) { tinyPause(); ms -= TINY_PAUSE_MS; }
+      while(ms >= VERYTINY_PAUSE_MS) { veryTinyPause(); ms -= VERYTINY_PAUSE_MS; }
+      }
+
+    // Optional non-blocking LED pattern player; if NULL then patterns are shown blocking.
+    OTV0P2BASE::LEDPatternPlayer *ledPlayerOpt = NULL;
+
+    // Show an LED flash pattern.
+    // With an LED pattern player this returns at once leaving the LED lit,
+    // and the player finishes the pattern from its tick();
+    // else this blocks in low-power pauses and leaves the LED on at the end of a lit last step.
+    // Skipped (it is only status) if the supply current budget cannot take the LED now.
+    void showLEDPattern(const OTV0P2BASE::LEDPattern &p)
+      {
+      if(!OTV0P2BASE::supplyCurrentBudget.wouldGrant(OTV0P2BASE::CurrentLoad::LED)) { return; }
+      if(NULL != ledPlayerOpt) { ledPlayerOpt->start(p); return; }
+      for(uint8_t i = 0; i < p.size(); ++i)
+        {
+        if(OTV0P2BASE::LEDPattern::isLitStep(i)) { LEDon(); } else { LEDoff(); }
+        pauseMs(p.getStepMs(i));
+        }
+      }
+
+    // Optional debounced button state, eg from an interrupt-driven ButtonEventCapture; may be NULL.
+    // If not NULL then the MODE button is read from this rather than polled directly.
+    const OTV0P2BASE::ButtonState *buttonStateOpt = NULL;
+    // Port bit number of the MODE button in buttonStateOpt.
+    uint8_t modeButtonBit = 0;
 
   protected:
     // Marked true if the physical UI controls are being used.
@@ -177,13 +217,21 @@ class ModeButtonAndPotActuatorPhysicalUI : public ActuatorPhysicalUIBase
     // Not thread-/ISR- safe.
     void userOpFeedback(const bool includeVisual = true)
       {
-      if(includeVisual) { LEDon(); }
+      // With a non-blocking LED player show a medium flash alongside any wiggle.
+      const bool nonBlockingVisual = includeVisual && (NULL != ledPlayerOpt);
+      if(nonBlockingVisual)
+        {
+        OTV0P2BASE::LEDPattern p;
+        p.add(MEDIUM_PAUSE_MS);
+        ledPlayerOpt->start(p);
+        }
+      else if(includeVisual) { LEDon(); }
       markUIControlUsed();
       // Sound and tactile feedback with local valve, like mobile phone vibrate mode.
       if(valveController->isInNormalRunState()) { valveController->wiggle(); }
       // Where wiggle cannot be used then instead pause briefly to let LED be seen on.
-      else { if(includeVisual) { mediumPause(); } }
-      if(includeVisual) { LEDoff(); }
+      else { if(includeVisual && !nonBlockingVisual) { mediumPause(); } }
+      if(includeVisual && !nonBlockingVisual) { LEDoff(); }
       // Note that feedback for significant UI action has been given.
       significantUIOp = false;
       }
@@ -284,6 +332,16 @@ class ModeButtonAndPotActuatorPhysicalUI : public ActuatorPhysicalUIBase
       uiTimeoutM.store(0);
       }
 
+    // Show LED flashes through player without blocking; NULL (the default) to block.
+    // The player must be ticked frequently, eg each time the main loop wakes,
+    // and use the same LED callbacks as this.
+    void setLEDPatternPlayer(OTV0P2BASE::LEDPatternPlayer *const player) { ledPlayerOpt = player; }
+
+    // Read the MODE button as port bit number bit of debounced state,
+    // eg from an interrupt-driven ButtonEventCapture; NULL (the default) to poll the pin.
+    void setModeButtonState(const OTV0P2BASE::ButtonState *const state, const uint8_t bit)
+      { buttonStateOpt = state; modeButtonBit = bit; }
+
     // Record local manual operation of a physical UI control, eg not remote or via CLI.
     // Marks room as occupied amongst other things.
     // To be thread-/ISR- safe, everything that this touches or calls must be.
@@ -428,9 +486,10 @@ class CycleModeAndLearnButtonsAndPotActuatorPhysicalUI final : public ModeButton
       //     showing 1/2/3 flashes as appropriate
       //   * switch to selected mode on button release
 #ifdef ARDUINO
-      const bool modeButtonIsPressed = (LOW == fastDigitalRead(BUTTON_MODE_L_pin));
+      const bool modeButtonIsPressed = (NULL != buttonStateOpt) ? buttonStateOpt->isPressed(modeButtonBit) :
+          (LOW == fastDigitalRead(BUTTON_MODE_L_pin));
 #else
-      const bool modeButtonIsPressed = false; // FIXME
+      const bool modeButtonIsPressed = (NULL != buttonStateOpt) && buttonStateOpt->isPressed(modeButtonBit);
 #endif
       if(modeButtonIsPressed)
         {
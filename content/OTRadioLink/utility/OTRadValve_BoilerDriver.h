@@ -317,6 +317,322 @@ public:
     }
 };
 
+/**
+ * @brief   Boiler driver coordinating demand across many valves (zones).
+ *
+ * Keeps each valve's last reported percent open in a compact table,
+ * and fires the boiler on the aggregate demand with hysteresis,
+ * minimum on and off times, and a demand stage for staged/modulating plant.
+ * This is intended to reduce short-cycling on shared systems
+ * where many valves each report small demands at different times.
+ *
+ * The table is open-addressed by ID (linear probing).
+ * Each report is also accounted to a demand bucket for the minute it arrived,
+ * and the aggregates are kept over the buckets,
+ * so each RX and each processCallsForHeat() costs O(1) expected time
+ * regardless of the number of valves:
+ * once a minute the oldest bucket is dropped from the aggregates wholesale
+ * and the entries left behind in it go stale,
+ * to be reused by new IDs or swept out a few slots per call.
+ *
+ * Demand is time-weighted: reports older than FRESH_M count for half,
+ * and only fresh reports can start the boiler on a single valve,
+ * so a marginal call from one valve that has since gone quiet
+ * does not flip the boiler.
+ *
+ * Same interface as OnOffBoilerDriverLogic so that either can be used by a hub.
+ *
+ * @param   maxValves: table size; a power of two in range [2,128].
+ *          Keep at least ~25% spare so that probes stay short.
+ * @note    Not ISR-/thread- safe; do not call from ISR RX.
+ */
+template<typename hm_t, hm_t &hm,
+         uint8_t outHeatCallPin, uint8_t maxValves = 32>
+class ZonedBoilerDriverLogic
+{
+    static_assert((maxValves >= 2) && (maxValves <= 128) && (0 == (maxValves & (maxValves - 1))),
+                  "maxValves must be a power of two in [2,128]");
+
+public:
+    // Minutes after its last report that a valve's demand is forgotten.
+    // Several times the nominal 4-minute valve TX interval to ride out lost frames.
+    static constexpr uint8_t VALVE_TIMEOUT_M = 15;
+    // Minutes after its last report that a valve's demand counts in full;
+    // two nominal valve TX intervals.
+    static constexpr uint8_t FRESH_M = 8;
+    // Aggregate percent open (summed over valves) to start the boiler,
+    // eg two valves half open, even if no one valve is open enough alone.
+    static constexpr uint8_t AGGREGATE_START_PC = 100;
+    // Aggregate percent open below which the boiler may stop, if no single valve holds it on.
+    static constexpr uint8_t AGGREGATE_HOLD_PC = 50;
+    // Aggregate percent open per demand stage above the first.
+    static constexpr uint8_t STAGE_STEP_PC = 200;
+    // Maximum demand stage.
+    static constexpr uint8_t MAX_STAGES = 4;
+
+    // Per-valve demand.
+    struct Entry final
+    {
+        // ID of the valve; an empty slot is marked with badID.
+        uint16_t id;
+        // Last percent open reported [0,100].
+        uint8_t percentOpen;
+        // Demand bucket of the last report, and that bucket's generation then;
+        // the entry is stale once the bucket has been recycled.
+        uint8_t bucket;
+        uint8_t gen;
+    };
+    // 'Bad' (never valid as housecode or OpenTRV code) ID.
+    static constexpr uint16_t badID = 0xffffU;
+
+private:
+    static_assert((FRESH_M > 0) && (FRESH_M < VALVE_TIMEOUT_M), "FRESH_M must be in [1,VALVE_TIMEOUT_M[");
+    static constexpr uint8_t mask = maxValves - 1;
+    // Slots checked for stale entries per call to processCallsForHeat().
+    static constexpr uint8_t sweepPerCall = (maxValves >= 32) ? (maxValves / 16) : 1;
+
+    Entry table[maxValves];
+    // Slots holding an entry, live or stale.
+    uint8_t occupied = 0;
+    // Next slot to sweep.
+    uint8_t sweepPos = 0;
+
+    // Demand from the reports in one minute, or over several.
+    struct Demand final
+    {
+        // Sum of percent open.
+        uint16_t sumPC;
+        // Number of entries.
+        uint8_t live;
+        // Number of entries open enough alone to start the boiler.
+        uint8_t countStart;
+        // Number of entries open enough alone to keep the boiler running.
+        uint8_t countHold;
+        void add(const Demand &d) { sumPC += d.sumPC; live += d.live; countStart += d.countStart; countHold += d.countHold; }
+        void sub(const Demand &d) { sumPC -= d.sumPC; live -= d.live; countStart -= d.countStart; countHold -= d.countHold; }
+        void clear() { sumPC = 0; live = 0; countStart = 0; countHold = 0; }
+    };
+    // Per-minute buckets, current at cur; bucket age in minutes is (cur - b) mod VALVE_TIMEOUT_M.
+    Demand buckets[VALVE_TIMEOUT_M];
+    // Generation of each bucket, bumped as it is recycled.
+    uint8_t gens[VALVE_TIMEOUT_M];
+    uint8_t cur = 0;
+    // Aggregates over the fresh (age < FRESH_M) and older buckets.
+    Demand fresh;
+    Demand old;
+
+    // True if the boiler should be on.
+    bool boilerOn = false;
+    // Minutes in the current boiler state; does not roll.
+    // DHD20160124: starting at zero forces at least the off time after power-up (good after power-cut).
+    uint8_t boilerStateM = 0;
+
+    // Single-valve percentage open to keep the boiler running.
+    static constexpr uint8_t holdPC = OTRadValve::DEFAULT_VALVE_PC_SAFER_OPEN;
+    // Single-valve percentage open to start the boiler.
+    // Slightly tolerant of rounding to/from percentages over the air (TODO-593).
+    static constexpr uint8_t startPC = OTV0P2BASE::fnmax(OTRadValve::DEFAULT_VALVE_PC_SAFER_OPEN, (uint8_t)(OTRadValve::DEFAULT_VALVE_PC_MODERATELY_OPEN - 1));
+
+    // Home slot for an ID: multiplicative (Fibonacci) hash.
+    static uint8_t home(const uint16_t id) { return((uint8_t)(((uint16_t)(id * 40503U)) >> 8) & mask); }
+
+    uint8_t ageOf(const uint8_t b) const { return((uint8_t)((cur + VALVE_TIMEOUT_M - b) % VALVE_TIMEOUT_M)); }
+    bool isLive(const Entry &e) const { return((badID != e.id) && (e.gen == gens[e.bucket])); }
+
+    // Add/remove a live entry's contribution to its bucket and the aggregates.
+    void account(const Entry &e, const bool add)
+    {
+        Demand d;
+        d.sumPC = e.percentOpen;
+        d.live = 1;
+        d.countStart = (e.percentOpen >= startPC) ? 1 : 0;
+        d.countHold = (e.percentOpen >= holdPC) ? 1 : 0;
+        Demand &agg = (ageOf(e.bucket) < FRESH_M) ? fresh : old;
+        if(add) { buckets[e.bucket].add(d); agg.add(d); }
+        else { buckets[e.bucket].sub(d); agg.sub(d); }
+    }
+
+    // Remove the (stale) entry at slot i, shifting back any later entries in its probe run.
+    void removeAt(uint8_t i)
+    {
+        for(uint8_t j = i; ; ) {
+            j = (j + 1) & mask;
+            if(badID == table[j].id) { break; }
+            const uint8_t k = home(table[j].id);
+            // Leave entry j where it is if its home lies cyclically in (i,j].
+            if((i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j))) { continue; }
+            table[i] = table[j];
+            i = j;
+        }
+        table[i].id = badID;
+        --occupied;
+    }
+
+    // Advance one minute: drop the oldest bucket and age one bucket out of fresh.
+    void advanceMinute()
+    {
+        cur = (uint8_t)((cur + 1) % VALVE_TIMEOUT_M);
+        // The new current bucket was the oldest; its entries are now stale.
+        old.sub(buckets[cur]);
+        buckets[cur].clear();
+        ++gens[cur];
+        const uint8_t b = (uint8_t)((cur + VALVE_TIMEOUT_M - FRESH_M) % VALVE_TIMEOUT_M);
+        fresh.sub(buckets[b]);
+        old.add(buckets[b]);
+    }
+
+    // Remove a few stale entries so that the table does not fill with them
+    // and no entry outlives 256 recyclings of its bucket.
+    void sweep()
+    {
+        for(uint8_t n = sweepPerCall; n-- > 0; ) {
+            const uint8_t i = sweepPos;
+            if((badID != table[i].id) && !isLive(table[i])) { removeAt(i); }
+            // Removal may shift a later entry into slot i, so recheck i next time.
+            else { sweepPos = (i + 1) & mask; }
+        }
+    }
+
+    // True if current demand should start, or keep running, the boiler.
+    bool wantHeat() const
+    {
+        const uint16_t weighted = getWeightedDemandPC();
+        if(boilerOn) { return((fresh.countHold + old.countHold > 0) || (weighted >= AGGREGATE_HOLD_PC)); }
+        return((fresh.countStart > 0) || (weighted >= AGGREGATE_START_PC));
+    }
+
+public:
+    ZonedBoilerDriverLogic() { reset(); }
+
+    // Clears reset internal boiler state to initial values.
+    // Primarily for testing.
+    void reset()
+    {
+        for(uint8_t i = 0; i < maxValves; ++i) { table[i].id = badID; }
+        occupied = 0; sweepPos = 0;
+        for(uint8_t b = 0; b < VALVE_TIMEOUT_M; ++b) { buckets[b].clear(); gens[b] = 0; }
+        cur = 0; fresh.clear(); old.clear();
+        boilerOn = false; boilerStateM = 0;
+    }
+
+    // True if boiler should be on.
+    inline bool isBoilerOn() const { return(boilerOn); }
+
+    // Get the aggregate percent open over all live valves.
+    uint16_t getDemandPC() const { return(fresh.sumPC + old.sumPC); }
+    // Get the time-weighted aggregate percent open, with older reports counting for half.
+    uint16_t getWeightedDemandPC() const { return(fresh.sumPC + (old.sumPC / 2)); }
+    // Get the number of valves currently tracked.
+    uint8_t getLiveValves() const { return(fresh.live + old.live); }
+    // Get the time-weighted mean percent open over live valves, [0,100]; 0 if none.
+    // Eg for a modulating flow temperature target (see OTRadValve_FlowTemperature.h).
+    uint8_t getMeanDemandPC() const
+    {
+        const uint16_t n = (uint16_t)(2 * fresh.live + old.live);
+        if(0 == n) { return(0); }
+        return((uint8_t)(((uint32_t)2 * fresh.sumPC + old.sumPC) / n));
+    }
+    // Get the demand stage: 0 when the boiler is off, else in range [1,MAX_STAGES].
+    // Staged or modulating plant can use this to choose firing rate.
+    uint8_t getDemandStage() const
+    {
+        if(!boilerOn) { return(0); }
+        return((uint8_t)OTV0P2BASE::fnmin((uint16_t)MAX_STAGES, (uint16_t)(1 + (getWeightedDemandPC() / STAGE_STEP_PC))));
+    }
+
+    // Get the entry for id; NULL if not tracked.
+    const Entry *find(const uint16_t id) const
+    {
+        if(badID == id) { return(NULL); }
+        for(uint8_t i = home(id), n = maxValves; n-- > 0; i = (i + 1) & mask) {
+            if(id == table[i].id) { return(isLive(table[i]) ? &table[i] : NULL); }
+            if(badID == table[i].id) { break; }
+        }
+        return(NULL);
+    }
+
+    // Raw notification of received call for heat from remote (eg FHT8V) unit.
+    // This form has a 16-bit ID (eg FHT8V housecode) and percent-open value [0,100].
+    // A 0 percent value explicitly confirms that the valve is not calling for heat.
+    // If the table is full a new ID is ignored until some other valve expires.
+    // Returns false if the report was ignored.
+    bool remoteCallForHeatRX(const uint16_t id, const uint8_t percentOpen, const uint8_t /*minuteCount*/ = 0)
+    {
+        if((badID == id) || (percentOpen > 100)) { return(false); } // FAIL
+        // First stale slot in the probe run, reusable for a new ID.
+        uint8_t reuse = 0xff;
+        for(uint8_t i = home(id), n = maxValves; n-- > 0; i = (i + 1) & mask) {
+            Entry &e = table[i];
+            if(id == e.id) {
+                if(isLive(e)) { account(e, false); }
+                e.percentOpen = percentOpen;
+                e.bucket = cur;
+                e.gen = gens[cur];
+                account(e, true);
+                return(true);
+            }
+            if(badID == e.id) {
+                if(0xff == reuse) {
+                    // Keep some slack so that probe runs terminate quickly.
+                    if(occupied >= maxValves - 1) { return(false); } // FAIL
+                    reuse = i;
+                    ++occupied;
+                }
+                break;
+            }
+            if((0xff == reuse) && !isLive(e)) { reuse = i; }
+        }
+        if(0xff == reuse) { return(false); } // FAIL
+        Entry &e = table[reuse];
+        e.id = id;
+        e.percentOpen = percentOpen;
+        e.bucket = cur;
+        e.gen = gens[cur];
+        account(e, true);
+        return(true);
+    }
+
+    /**
+     * @brief   Process calls for heat, ie turn boiler on and off as appropriate.
+     *          Should be called every tick (typically 2s); drives timing.
+     * @param   second0: If true, advances the internal model of time by one minute.
+     * @param   hubMode: If true, internal state is updated and the boiler is operated.
+     *                   If false, internal state is ignored and BOILER IS FORCED OFF.
+     */
+    void processCallsForHeat(const bool second0, const bool hubMode)
+    {
+        if(!hubMode) {
+#ifdef ARDUINO_ARCH_AVR
+            // Force boiler off when not in hub mode.
+            fastDigitalWrite(outHeatCallPin, LOW);
+#endif // ARDUINO_ARCH_AVR
+            return;
+        }
+
+        if(second0) {
+            advanceMinute();
+            if(boilerStateM < 255) { ++boilerStateM; }
+        }
+        sweep();
+
+        // Change state only once the minimum time in the current state has passed,
+        // regardless of when second0 happens to be.
+        // (The min(254, ...) is to ensure that the boiler can come on even if minOnMins == 255.)
+        // The minimum is only fetched (eg from EEPROM) when a change is wanted.
+        if((wantHeat() != boilerOn) &&
+           (boilerStateM > OTV0P2BASE::fnmin((uint8_t)254, hm.getMinBoilerOnMinutes()))) {
+            boilerOn = !boilerOn;
+            boilerStateM = 0;
+            if(boilerOn) { OTV0P2BASE::serialPrintlnAndFlush(F("RCfH1")); } // Remote call for heat on.
+            else { OTV0P2BASE::serialPrintlnAndFlush(F("RCfH0")); } // Remote call for heat off.
+        }
+
+#ifdef ARDUINO_ARCH_AVR
+        fastDigitalWrite(outHeatCallPin, (boilerOn ? HIGH : LOW));
+#endif // ARDUINO_ARCH_AVR
+    }
+};
+
 //// Smarter logic for simple on/off boiler output, fully testable.
 //class OnOffBoilerDriverLogic
 //  {
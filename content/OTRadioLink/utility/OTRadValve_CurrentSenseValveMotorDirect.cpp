@@ -78,6 +78,11 @@ bool CurrentSenseValveMotorDirect::CalibrationParameters::updateAndCompute(
   ticksFromClosedToOpen = _ticksFromClosedToOpen;
   tfotcSmall = 0;
   tfctoSmall = 0;
+  // For x < T, x * ceil((100 << 24) / T) is within T / 2^24 of (x * 100 / T) << 24,
+  // which cannot carry it past the next whole percent while T * T < 2^24.
+  // The product stays below 100 << 24 so fits 32 bits.
+  pcPerTickQ24 = ((0 != _ticksFromOpenToClosed) && (_ticksFromOpenToClosed < reciprocal_max_ticks)) ?
+      (((100UL << 24) + _ticksFromOpenToClosed - 1) / _ticksFromOpenToClosed) : 0;
 
   // Bad argument; should not be passed.
   if(0 == minMotorDRTicks) { return(false); }
@@ -147,9 +152,10 @@ uint8_t CurrentSenseValveMotorDirect::CalibrationParameters::computePosition(
   if(0 == ticksFromOpen) { return(100); }
   if(ticksFromOpen >= ticksFromOpenToClosed) { return(0); }
   // Compute percentage open for intermediate position, based on dead-reckoning.
-  // TODO: optimise
-  return((uint8_t) (((ticksFromOpenToClosed - ticksFromOpen) * 100UL) /
-      ticksFromOpenToClosed));
+  // Avoid a long division on the usual path.
+  const uint16_t ticksFromClosed = ticksFromOpenToClosed - ticksFromOpen;
+  if(0 != pcPerTickQ24) { return((uint8_t) ((ticksFromClosed * pcPerTickQ24) >> 24)); }
+  return((uint8_t) ((ticksFromClosed * 100UL) / ticksFromOpenToClosed));
   }
 
 // Get estimated minimum percentage open for significant flow for this device; strictly positive in range [1,99].
@@ -209,6 +215,8 @@ bool CurrentSenseValveMotorDirectBinaryOnly::runTowardsEndStop(const bool toOpen
   {
   // Clear the end-stop detection flag ready.
   endStopDetected = false;
+  // Note the run for battery-cost estimates.
+  if(motorRuns < 0xffff) { ++motorRuns; }
   // Run motor for fixed time.
   hw->motorRun(minMotorDRTicks, toOpen ?
       OTRadValve::HardwareMotorDriverInterface::motorDriveOpening
@@ -256,6 +264,14 @@ OTV0P2BASE::serialPrintlnAndFlush();
   // If too late in the system cycle then exit immediately.
   if(getSubCycleTimeFn() >= sctAbsLimit) { return; }
 
+  // Defer to a later poll while another high-current load, eg radio TX,
+  // would sag the supply too far if run alongside the motor.
+  const OTV0P2BASE::CurrentBudgetClaim supplyClaim(OTV0P2BASE::CurrentLoad::MOTOR);
+  if(!supplyClaim.isGranted()) { return; }
+
+  // Act on any coalesced target change that is now due.
+  applyPendingTarget();
+
   // Run the state machine based on the major state.
   switch(state)
     {
@@ -532,6 +548,9 @@ V0P2BASE_DEBUG_SERIAL_PRINTLN_FLASHSTRING("+calibrating");
           else if(++perState.valveCalibrating.endStopHitCount >= maxEndStopHitsToBeConfidentWhenCalibrating)
             {
             const uint16_t tfotc = ticksFromOpen;
+            // On a warm restart a recent cached calibration consistent
+            // with this run can be used, skipping the run back to open.
+            if(useCalibrationCache(tfotc)) { return(true); }
             perState.valveCalibrating.ticksFromOpenToClosed = tfotc;
             perState.valveCalibrating.wallclock2sTicks = 0;
             perState.valveCalibrating.endStopHitCount = 0;
@@ -601,6 +620,11 @@ OTV0P2BASE::serialPrintlnAndFlush();
           { OTV0P2BASE::ErrorReporter.set(OTV0P2BASE::ErrorReport::WARN_VALVE_LOW_PRECISION); }
 #endif
 
+        // Cache good calibration for the next warm restart, else invalidate any cached.
+        if(cp.cannotRunProportional()) { writeCalibrationCache(0, 0, 0); }
+        else { writeCalibrationCache(cp.getTicksFromOpenToClosed(), cp.getTicksFromClosedToOpen(), 0); }
+        calCacheTried = true;
+
         // Move to normal valve running state, even if calibration calculation failed.
         needsRecalibrating = false;
         hitEndstop(true); // Valve is currently fully open.
@@ -615,6 +639,62 @@ OTV0P2BASE::serialPrintlnAndFlush();
   return(true);
   }
 
+// Read the cached calibration; returns false if none or invalid.
+// The record is both tick counts (little-endian), the warm-restart use count,
+// and a non-zero CRC-7 over those.
+bool CurrentSenseValveMotorDirect::readCalibrationCache(uint16_t &tfotc, uint16_t &tfcto, uint8_t &uses) const
+    {
+    if(NULL == calStoreOpt) { return(false); }
+    uint8_t buf[ValveCalibrationStoreBase::recordBytes];
+    calStoreOpt->read(buf);
+    const uint8_t crc = OTV0P2BASE::crc7_5B_update_nz_final(OTV0P2BASE::crc7_5B_buf(0, buf, 4), buf[4]);
+    if(crc != buf[5]) { return(false); } // FAIL
+    tfotc = buf[0] | (uint16_t(buf[1]) << 8);
+    tfcto = buf[2] | (uint16_t(buf[3]) << 8);
+    uses = buf[4];
+    return((0 != tfotc) && (0 != tfcto));
+    }
+
+// Write (or with both ticks zero, invalidate) the cached calibration.
+void CurrentSenseValveMotorDirect::writeCalibrationCache(const uint16_t tfotc, const uint16_t tfcto, const uint8_t uses)
+    {
+    if(NULL == calStoreOpt) { return; }
+    uint8_t buf[ValveCalibrationStoreBase::recordBytes];
+    if((0 == tfotc) && (0 == tfcto)) { memset(buf, 0xff, sizeof(buf)); }
+    else
+        {
+        buf[0] = uint8_t(tfotc);
+        buf[1] = uint8_t(tfotc >> 8);
+        buf[2] = uint8_t(tfcto);
+        buf[3] = uint8_t(tfcto >> 8);
+        buf[4] = uses;
+        buf[5] = OTV0P2BASE::crc7_5B_update_nz_final(OTV0P2BASE::crc7_5B_buf(0, buf, 4), buf[4]);
+        }
+    calStoreOpt->write(buf);
+    }
+
+// Try to complete calibration from the cache after the open-to-closed run.
+// The cache is used only for the first calibration since power-up,
+// if it has not been reused too often,
+// and if the open-to-closed run just measured is close to the cached one.
+// Returns true and moves to the valveNormal state if successful.
+bool CurrentSenseValveMotorDirect::useCalibrationCache(const uint16_t tfotc)
+    {
+    if(calCacheTried) { return(false); }
+    calCacheTried = true;
+    uint16_t cTfotc, cTfcto;
+    uint8_t uses;
+    if(!readCalibrationCache(cTfotc, cTfcto, uses)) { return(false); }
+    if(uses >= maxCalibrationCacheUses) { return(false); }
+    if(OTV0P2BASE::fnabsdiff(tfotc, cTfotc) > (cTfotc / calibrationCacheToleranceDivisor)) { return(false); }
+    if(!cp.updateAndCompute(cTfotc, cTfcto, minMotorDRTicks) || cp.cannotRunProportional()) { return(false); }
+    writeCalibrationCache(cTfotc, cTfcto, uint8_t(uses + 1));
+    needsRecalibrating = false;
+    hitEndstop(false); // Valve is currently fully closed.
+    changeState(valveNormal);
+    return(true);
+    }
+
 // Do valveNormal start for proportional drive; returns true to return from poll() immediately.
 // Falls through to do drive to end stops, or when in run-time binary-only mode.
 // Calls changeState() directly if it needs to change state.
@@ -669,9 +749,11 @@ bool CurrentSenseValveMotorDirect::do_valveNormal_prop()
     // then leave valve as is and leave poll().
     // This must provide hysteresis
     // to prevent flapping back at forth at the boundaries on 1% target changes.
+    // The deadband may be set wider than eps to save motor runs.
     // Carefully avoid overflow/underflow in comparison.
-    if(((targetPC >= currentPC) && (targetPC <= currentPC + eps)) ||
-       ((currentPC >= targetPC) && (currentPC <= targetPC + eps)))
+    const uint8_t deps = OTV0P2BASE::fnmax(eps, getDeadbandPC());
+    if(((targetPC >= currentPC) && (targetPC <= currentPC + deps)) ||
+       ((currentPC >= targetPC) && (currentPC <= targetPC + deps)))
         {
         // Close enough to target, so resting and can reset end stop hit count!
         perState.valveNormal.endStopHitCount = 0;
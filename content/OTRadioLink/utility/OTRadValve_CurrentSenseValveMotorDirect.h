@@ -28,7 +28,9 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015--2018
 #include <stdint.h>
 #include "OTRadValve_AbstractRadValve.h"
 
+#include "OTV0P2BASE_CurrentBudget.h"
 #include "OTV0P2BASE_ErrorReport.h"
+#include "OTV0P2BASE_Trace.h"
 
 
 namespace OTRadValve
@@ -47,6 +49,57 @@ namespace OTRadValve
 // Note that when the battery is low attempts to close the valve may be ignored,
 // as this attempts to fail safe with the valve open (eg to prevent frost).
 
+// Non-volatile store for one motor calibration record,
+// so that a warm restart can skip most of a full recalibration.
+// The record content is opaque to the store,
+// and an erased/unset store should read back as all 0xff.
+class ValveCalibrationStoreBase
+  {
+  public:
+    // Size of the record in bytes.
+    static constexpr uint8_t recordBytes = 6;
+    // Read the record into buf[recordBytes].
+    virtual void read(uint8_t *buf) const = 0;
+    // Write the record from buf[recordBytes].
+    // May be slow and wear the backing store, so use sparingly.
+    virtual void write(const uint8_t *buf) = 0;
+  };
+
+// In-memory calibration store, eg for unit tests; starts erased.
+class ValveCalibrationStoreMock final : public ValveCalibrationStoreBase
+  {
+  private:
+    uint8_t record[recordBytes];
+  public:
+    ValveCalibrationStoreMock() { erase(); }
+    // Erase the record.
+    void erase() { memset(record, 0xff, sizeof(record)); }
+    virtual void read(uint8_t *buf) const override { memcpy(buf, record, sizeof(record)); }
+    virtual void write(const uint8_t *buf) override { memcpy(record, buf, sizeof(record)); }
+    // Direct access to the raw record, eg to corrupt it in tests.
+    uint8_t *_getRecord() { return(record); }
+  };
+
+#ifdef ARDUINO_ARCH_AVR
+// Calibration store in EEPROM at V0P2BASE_EE_START_VALVE_CALIBRATION.
+// Not for use from ISRs.
+class EEPROMValveCalibrationStore final : public ValveCalibrationStoreBase
+  {
+  static_assert(recordBytes <= OTV0P2BASE::V0P2BASE_EE_LEN_VALVE_CALIBRATION, "record too large");
+  public:
+    virtual void read(uint8_t *buf) const override
+        {
+        for(uint8_t i = 0; i < recordBytes; ++i)
+            { buf[i] = eeprom_read_byte((uint8_t *)(OTV0P2BASE::V0P2BASE_EE_START_VALVE_CALIBRATION + i)); }
+        }
+    virtual void write(const uint8_t *buf) override
+        {
+        for(uint8_t i = 0; i < recordBytes; ++i)
+            { OTV0P2BASE::eeprom_smart_update_byte((uint8_t *)(OTV0P2BASE::V0P2BASE_EE_START_VALVE_CALIBRATION + i), buf[i]); }
+        }
+  };
+#endif // ARDUINO_ARCH_AVR
+
 // Generic motor driver with end-stop detection only, aims only for full/closed.
 // Unit testable.
 // Designed to be embedded in a motor controller instance.
@@ -172,6 +225,9 @@ class CurrentSenseValveMotorDirectBinaryOnly : public OTRadValve::HardwareMotorD
     // Allows monitoring of supply voltage to avoid some activities with low batteries; can be NULL.
     // Non-const to allow call to read() to force re-measurement of supply.
     OTV0P2BASE::SupplyVoltageLow *const lowBattOpt = NULL;
+    // Non-volatile store for calibration to allow faster warm restarts; can be NULL.
+    // Ignored in this binary-only implementation.
+    ValveCalibrationStoreBase *const calStoreOpt = NULL;
 
     // Major state of driver.
     // On power-up (or full reset) should be 0/init.
@@ -184,7 +240,7 @@ class CurrentSenseValveMotorDirectBinaryOnly : public OTRadValve::HardwareMotorD
     volatile driverState state = init;
     // Change state and perform some book-keeping.
     inline void changeState(const driverState newState)
-        { state = newState; clearPerState(); }
+        { state = newState; clearPerState(); OT_TRACE(OTV0P2BASE::TraceId::VALVE_STATE, newState); }
 
     // Data used only within one major state and not to be saved between states.
     // Thus it can be shared in a union to save space.
@@ -244,6 +300,30 @@ class CurrentSenseValveMotorDirectBinaryOnly : public OTRadValve::HardwareMotorD
     // Target just below call-for-heat threshold for passive frost protection.
     uint8_t targetPC = DEFAULT_VALVE_PC_SAFER_OPEN - 1;
 
+    // Movement planner state.
+    // Each motor run is the biggest single drain on the battery,
+    // so target changes can be coalesced over a few polls
+    // to avoid chasing a target that is still moving.
+    //
+    // Most recently requested target % open in range [0,100];
+    // not yet acted upon if different from targetPC.
+    uint8_t pendingTargetPC = targetPC;
+    // Polls to wait after a target change before acting on it; 0 to act immediately.
+    uint8_t coalescePolls = 0;
+    // Polls waited so far with pendingTargetPC not yet applied.
+    uint8_t pendingPolls = 0;
+    // Apply any pending target once the coalescing window has elapsed.
+    void applyPendingTarget()
+        {
+        if(pendingTargetPC == targetPC) { pendingPolls = 0; return; }
+        if(++pendingPolls < coalescePolls) { return; }
+        targetPC = pendingTargetPC;
+        pendingPolls = 0;
+        }
+
+    // Count of motor runs, for battery-cost estimates; saturates.
+    uint16_t motorRuns = 0;
+
 //    // Run fast towards/to end stop as far as possible in this call.
 //    // Terminates significantly before the end of the sub-cycle.
 //    // Possibly allows partial recalibration, or at least re-homing.
@@ -320,6 +400,8 @@ class CurrentSenseValveMotorDirectBinaryOnly : public OTRadValve::HardwareMotorD
     //     to avoid disturbing occupants,
     //     eg when room dark and occupants may be sleeping;
     //     can be NULL
+    //   * calStoreOpt  non-volatile store for calibration data
+    //     to allow faster warm restarts; can be NULL
     // Keep all the potentially slow calculations in-line here
     // to allow them to be done at compile-time .
     CurrentSenseValveMotorDirectBinaryOnly(
@@ -328,7 +410,8 @@ class CurrentSenseValveMotorDirectBinaryOnly : public OTRadValve::HardwareMotorD
         const uint8_t _minMotorDRTicks,
         const uint8_t _sctAbsLimit,
         OTV0P2BASE::SupplyVoltageLow *_lowBattOpt = NULL,
-        bool (*const _minimiseActivityOpt)() = ((bool(*)())NULL))
+        bool (*const _minimiseActivityOpt)() = ((bool(*)())NULL),
+        ValveCalibrationStoreBase *const _calStoreOpt = NULL)
 //                                 uint8_t _minOpenPC = OTRadValve::DEFAULT_VALVE_PC_MIN_REALLY_OPEN,
 //                                 uint8_t _fairlyOpenPC = OTRadValve::DEFAULT_VALVE_PC_MODERATELY_OPEN)
       : hw(hwDriver),
@@ -336,7 +419,8 @@ class CurrentSenseValveMotorDirectBinaryOnly : public OTRadValve::HardwareMotorD
 //        minOpenPC(_minOpenPC), fairlyOpenPC(_fairlyOpenPC),
         sctAbsLimit(_sctAbsLimit),
         minMotorDRTicks(_minMotorDRTicks),
-        minimiseActivityOpt(_minimiseActivityOpt), lowBattOpt(_lowBattOpt)
+        minimiseActivityOpt(_minimiseActivityOpt), lowBattOpt(_lowBattOpt),
+        calStoreOpt(_calStoreOpt)
         { changeState(init); }
 
     // Poll.
@@ -356,8 +440,32 @@ class CurrentSenseValveMotorDirectBinaryOnly : public OTRadValve::HardwareMotorD
 
     // Set current target % open in range [0,100].
     // Coerced into range.
+    // Acted upon once the coalescing window (if any) has elapsed,
+    // though a target at either end-stop is always taken immediately,
+    // eg so that fully opening for frost protection is never delayed.
     void setTargetPC(uint8_t newPC)
-        { targetPC = OTV0P2BASE::fnmin(newPC, (uint8_t)100); }
+        {
+        pendingTargetPC = OTV0P2BASE::fnmin(newPC, (uint8_t)100);
+        if((0 == coalescePolls) || isAtEndstop(pendingTargetPC))
+            { targetPC = pendingTargetPC; pendingPolls = 0; }
+        }
+
+    // Get most recently requested target % open in range [0,100].
+    // May differ from getTargetPC() while a change is being coalesced.
+    uint8_t getPendingTargetPC() const { return(pendingTargetPC); }
+
+    // Set the number of polls over which target changes are coalesced; 0 (default) to act immediately.
+    // At a poll every 2s, 30 coalesces changes over about a minute.
+    void setCoalescePolls(const uint8_t polls) { coalescePolls = polls; }
+
+    // Get the count of motor runs since power-up; saturates at 0xffff.
+    // Includes runs during calibration and (re)initialisation.
+    uint16_t getMotorRuns() const { return(motorRuns); }
+    // Get an estimate of sub-cycle ticks that the motor has been driven for since power-up.
+    // This is an upper bound since a run may be cut short by an end-stop.
+    // Multiply by the tick length and motor current to estimate battery charge used.
+    uint32_t getMotorRunTicksEstimate() const
+        { return((uint32_t)motorRuns * minMotorDRTicks); }
 
     // Get estimated minimum percentage open for significant flow for this device; strictly positive in range [1,99].
     virtual uint8_t getMinPercentOpen() const
@@ -490,6 +598,12 @@ class CurrentSenseValveMotorDirect final : public CurrentSenseValveMotorDirectBi
           uint8_t approxPrecisionPC = bad_precision;
           // A reduced ticks open/closed in ratio to allow small conversions.
           uint8_t tfotcSmall = 0, tfctoSmall = 0;
+          // Percent per tick from closed, as a 8.24 fixed-point reciprocal
+          // of ticksFromOpenToClosed rounded up, so that computePosition()
+          // needs only a multiply and shift; the result is exact
+          // while ticksFromOpenToClosed < reciprocal_max_ticks.
+          // Zero if not usable, whereupon computePosition() divides.
+          uint32_t pcPerTickQ24 = 0;
 
         public:
           // (Re)populate structure and compute derived parameters.
@@ -532,6 +646,9 @@ class CurrentSenseValveMotorDirect final : public CurrentSenseValveMotorDirectBi
           static constexpr uint8_t max_usuable_precision = 15;
           // Precision % used to indicate an error condition (legal but clearly no good).
           static constexpr uint8_t bad_precision = 100;
+          // ticksFromOpenToClosed must be below this (ie its square below 2^24)
+          // for computePosition() to use the exact reciprocal multiply.
+          static constexpr uint16_t reciprocal_max_ticks = 4096;
           // If true, device cannot be run in proportional mode.
           bool cannotRunProportional() const
               { return(approxPrecisionPC > max_usuable_precision); }
@@ -549,6 +666,24 @@ class CurrentSenseValveMotorDirect final : public CurrentSenseValveMotorDirectBi
     // May simply switch to 'binary' on/off mode if the calibration is off.
     bool needsRecalibrating = true;
 
+    // True once the calibration cache has been considered since power-up.
+    // The cache is only used for the first calibration after a restart;
+    // recalibration forced by a tracking error is always done in full.
+    bool calCacheTried = false;
+    // Read the cached calibration; returns false if none or invalid.
+    bool readCalibrationCache(uint16_t &tfotc, uint16_t &tfcto, uint8_t &uses) const;
+    // Write (or with both ticks zero, invalidate) the cached calibration.
+    void writeCalibrationCache(uint16_t tfotc, uint16_t tfcto, uint8_t uses);
+    // Try to complete calibration from the cache after the open-to-closed run,
+    // given the ticks measured on that run.
+    // Returns true and moves to the valveNormal state if successful.
+    bool useCalibrationCache(uint16_t tfotc);
+
+    // Proportional-mode deadband as a multiple of the approximate precision, in range [1,maxDeadbandPrecisions].
+    // Moves to targets within this deadband of the current position are suppressed,
+    // though the deadband is never wider than absTolerancePC.
+    uint8_t deadbandPrecisions = 1;
+
     // Report an apparent serious tracking error that will force recalibration.
     // Such a recalibration may not happen immediately.
     void reportTrackingError()
@@ -650,6 +785,28 @@ class CurrentSenseValveMotorDirect final : public CurrentSenseValveMotorDirectBi
     bool inNonProportionalMode() const
         { return(needsRecalibrating || cp.cannotRunProportional()); }
 
+    // Warm restarts allowed from one cached calibration before a full recalibration is forced,
+    // to allow for slow drift such as battery droop.
+    static constexpr uint8_t maxCalibrationCacheUses = 8;
+    // Maximum difference of the measured open-to-closed run from the cached one,
+    // as a fraction 1/N of the cached value, for the cache to remain usable.
+    static constexpr uint8_t calibrationCacheToleranceDivisor = 8;
+
+    // Maximum deadband as a multiple of the approximate precision.
+    static constexpr uint8_t maxDeadbandPrecisions = 8;
+    // Set the proportional-mode movement deadband as a multiple of the approximate precision.
+    // Coerced into range [1,maxDeadbandPrecisions]; the default of 1 moves as closely as possible.
+    // Adapts to the valve as calibrated,
+    // so that coarse-precision valves do not make many tiny moves.
+    void setDeadbandPrecisions(const uint8_t n)
+        { deadbandPrecisions = OTV0P2BASE::fnconstrain(n, uint8_t(1), uint8_t(maxDeadbandPrecisions)); }
+    // Get the current proportional-mode deadband in %, in range [0,absTolerancePC].
+    uint8_t getDeadbandPC() const
+        {
+        constexpr uint8_t aeps = absTolerancePC;
+        return(OTV0P2BASE::fnmin(aeps, uint8_t(deadbandPrecisions * OTV0P2BASE::fnmin(cp.getApproxPrecisionPC(), aeps))));
+        }
+
     // Get (read-only) calibration parameters, primarily for testing.
     CalibrationParameters const &_getCP() const { return(cp); }
   };
@@ -0,0 +1,380 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Control of many FHT8V valves, each with its own house code, from one radio.
+ *
+ * FHT8VRadValve drives a single valve and owns the half-second TX timeline;
+ * with several instances they would contend for the radio unaware of each other.
+ * Here one scheduler keeps every valve's sync and valve-setting TX times
+ * on a single timeline of half-second slots,
+ * sending at most maxTXPerSlot frames in any slot,
+ * timing-critical frames (valve-setting and sync-final) first, most overdue first,
+ * and the redundant sync countdown frames in whatever room remains.
+ *
+ * A valve that loses sync, eg because its frames could not be sent
+ * while the hub was busy or after a house code change, is resynced automatically.
+ * New syncs are staggered so that valves sharing a TX period (same HC2 & 7)
+ * do not share TX slots forever.
+ *
+ * Portable: the scheduler is pure logic driven once per half second,
+ * and the controller sends through any OTRadioLink.
+ */
+
+#ifndef ARDUINO_LIB_OTRADVALVE_FHT8VMULTIVALVE_H
+#define ARDUINO_LIB_OTRADVALVE_FHT8VMULTIVALVE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include <OTRadioLink.h>
+#include "OTRadValve_FHT8VRadValve.h"
+
+namespace OTRadValve
+    {
+
+
+// Interleaves sync and valve-setting TX for up to maxValves FHT8V house codes.
+// Call nextSlot() at the start of every half-second slot
+// and transmit the commands it returns in order, straight away;
+// if the caller could not run for some slots, report them with skipSlots() first.
+// Valve indexes are stable from addValve() until removeValve().
+// Not thread-safe.
+//   * maxValves  maximum number of house codes managed; in [1,127]
+//   * maxTXPerSlot  maximum frames sent in one half second,
+//     eg 3 single ~80ms FS20 TXes leave time for RX polling
+template<uint8_t maxValves, uint8_t maxTXPerSlot = 3>
+class FHT8VMultiValveScheduler final
+  {
+  static_assert((maxValves > 0) && (maxValves < 128), "maxValves out of range");
+  static_assert(maxTXPerSlot > 0, "must be able to send at least one frame per slot");
+
+  public:
+    // One command to transmit in the current slot.
+    struct TX final
+      {
+      // Index of the valve addressed.
+      uint8_t valve;
+      // True for sync (countdown or final) commands, which are best sent with maximum effort.
+      bool sync;
+      FHT8VRadValveUtil::fht8v_msg_t command;
+      };
+
+    // Slots that a valve-setting or sync-final command may be sent late and still be heard.
+    static constexpr uint8_t MAX_LATE_HS = 1;
+    // Consecutive valve-setting commands missed after which a valve is assumed to have lost sync.
+    static constexpr uint8_t MAX_MISSED_TX = 2;
+    // First sync countdown value, as for FHT8VRadValveBase: 120 frames 1s apart.
+    static constexpr uint8_t SYNC_COUNTDOWN_START = 241;
+
+    // Interval (in half seconds) between valve-setting TXes given house code 2; [230,237].
+    static constexpr uint8_t txGapHalfSeconds(const uint8_t hc2) { return(uint8_t((hc2 & 7) + 230)); }
+
+  private:
+    enum state_t : uint8_t
+      {
+      UNUSED,
+      // Waiting to start sync at due.
+      SYNC_WAIT,
+      // Sending countdown until due, when the countdown value reaches 1.
+      SYNC_COUNTDOWN,
+      // Sync final command due at due.
+      SYNC_FINAL,
+      // In sync; next valve-setting command due at due.
+      SYNCED
+      };
+    struct Valve final
+      {
+      uint8_t hc1, hc2;
+      uint8_t valvePC;
+      state_t state;
+      uint8_t missed;
+      uint32_t due;
+      };
+    Valve valves[maxValves];
+
+    // Start of the current slot, in half seconds.
+    uint32_t now = 0;
+    // First valve considered for spare countdown slots, rotated for fairness.
+    uint8_t rrStart = 0;
+    // Number of times any valve has been found to lose sync.
+    uint16_t lostSyncCount = 0;
+
+    // Delay from sync start to the sync final command.
+    static uint16_t syncToFinalHalfSeconds(const uint8_t hc2)
+      { return(uint16_t((SYNC_COUNTDOWN_START - 2) + (hc2 & 7) + 8)); }
+
+    // Predicted phase (mod the TX gap) of the valve-setting slots of valve v.
+    uint8_t predictedPhase(const Valve &v) const
+      {
+      uint32_t t = v.due;
+      if(SYNC_WAIT == v.state) { t += syncToFinalHalfSeconds(v.hc2); }
+      else if(SYNC_COUNTDOWN == v.state) { t += (v.hc2 & 7) + 8; }
+      return(uint8_t(t % txGapHalfSeconds(v.hc2)));
+      }
+
+    // Schedule a (re)sync of valve i starting at or soon after now,
+    // on the earliest delay whose predicted TX slots share a phase with fewest valves of the same period.
+    void startSyncWait(const uint8_t i)
+      {
+      Valve &v = valves[i];
+      v.state = SYNC_WAIT;
+      v.missed = 0;
+      const uint8_t gap = txGapHalfSeconds(v.hc2);
+      uint8_t bestDelay = 0;
+      uint8_t bestClashes = 0xff;
+      for(uint8_t d = 0; d <= 2 * maxValves; ++d)
+        {
+        const uint8_t phase = uint8_t((now + d + syncToFinalHalfSeconds(v.hc2)) % gap);
+        uint8_t clashes = 0;
+        for(uint8_t j = 0; j < maxValves; ++j)
+          {
+          const Valve &o = valves[j];
+          if((j == i) || (UNUSED == o.state) || (txGapHalfSeconds(o.hc2) != gap)) { continue; }
+          if(predictedPhase(o) == phase) { ++clashes; }
+          }
+        if(clashes < bestClashes) { bestClashes = clashes; bestDelay = d; }
+        if(0 == clashes) { break; }
+        }
+      v.due = now + bestDelay;
+      }
+
+    // Valve i has lost sync.
+    void lostSync(const uint8_t i) { ++lostSyncCount; startSyncWait(i); }
+
+    // Advance valve i's state to now, dropping anything missed.
+    void update(const uint8_t i)
+      {
+      Valve &v = valves[i];
+      switch(v.state)
+        {
+        case SYNC_WAIT:
+          if(v.due <= now) { v.state = SYNC_COUNTDOWN; v.due = now + (SYNC_COUNTDOWN_START - 2); update(i); }
+          break;
+        case SYNC_COUNTDOWN:
+          if(v.due <= now) { v.state = SYNC_FINAL; v.due += (v.hc2 & 7) + 8; update(i); }
+          break;
+        case SYNC_FINAL:
+          // The valve stops waiting for the final command.
+          if((v.due < now) && (now - v.due > MAX_LATE_HS)) { lostSync(i); update(i); }
+          break;
+        case SYNCED:
+          // Count each valve-setting slot missed entirely.
+          while((v.due < now) && (now - v.due > MAX_LATE_HS))
+            {
+            v.due += txGapHalfSeconds(v.hc2);
+            if(++v.missed >= MAX_MISSED_TX) { lostSync(i); update(i); return; }
+            }
+          break;
+        default: break;
+        }
+      }
+
+    // True if valve v has a timing-critical command due now.
+    bool isCriticalDue(const Valve &v) const
+      { return(((SYNC_FINAL == v.state) || (SYNCED == v.state)) && (v.due <= now)); }
+
+    void fillCommand(TX &tx, const uint8_t i, const uint8_t command, const uint8_t extension) const
+      {
+      const Valve &v = valves[i];
+      tx.valve = i;
+      tx.command.hc1 = v.hc1;
+      tx.command.hc2 = v.hc2;
+#ifdef OTV0P2BASE_FHT8V_ADR_USED
+      tx.command.address = 0;
+#endif
+      tx.command.command = command;
+      tx.command.extension = extension;
+      }
+
+  public:
+    FHT8VMultiValveScheduler() { for(Valve &v : valves) { v.state = UNUSED; } }
+
+    // Add a valve with the given house code and initial position; returns its index, or -1 on failure.
+    // Fails if the house code is invalid or already present, or if there is no room.
+    // The valve is synced starting at or soon after the current slot.
+    int8_t addValve(const uint8_t hc1, const uint8_t hc2, const uint8_t valvePC = 0)
+      {
+      if(!FHT8VRadValveUtil::isValidFHTV8HouseCode(hc1) || !FHT8VRadValveUtil::isValidFHTV8HouseCode(hc2)) { return(-1); }
+      if(valvePC > 100) { return(-1); }
+      int8_t slot = -1;
+      for(uint8_t i = 0; i < maxValves; ++i)
+        {
+        const Valve &v = valves[i];
+        if(UNUSED == v.state) { if(slot < 0) { slot = int8_t(i); } continue; }
+        if((hc1 == v.hc1) && (hc2 == v.hc2)) { return(-1); }
+        }
+      if(slot < 0) { return(-1); }
+      Valve &v = valves[slot];
+      v.hc1 = hc1;
+      v.hc2 = hc2;
+      v.valvePC = valvePC;
+      startSyncWait(uint8_t(slot));
+      return(slot);
+      }
+    // Stop controlling valve i; returns false if not in use.
+    bool removeValve(const uint8_t i)
+      {
+      if(!isInUse(i)) { return(false); }
+      valves[i].state = UNUSED;
+      return(true);
+      }
+    bool isInUse(const uint8_t i) const { return((i < maxValves) && (UNUSED != valves[i].state)); }
+
+    // Set the target position [0,100] of valve i, sent at its next valve-setting slot.
+    // Returns false if the value or valve is invalid.
+    bool set(const uint8_t i, const uint8_t valvePC)
+      {
+      if(!isInUse(i) || (valvePC > 100)) { return(false); }
+      valves[i].valvePC = valvePC;
+      return(true);
+      }
+    // Target position of valve i; 0 if not in use.
+    uint8_t get(const uint8_t i) const { return(isInUse(i) ? valves[i].valvePC : 0); }
+
+    // Force valve i to resync, eg after a valve was re-paired by hand; does nothing if not in use.
+    void resync(const uint8_t i) { if(isInUse(i)) { startSyncWait(i); } }
+    // True while valve i is in sync and being sent valve-setting commands.
+    bool isSynced(const uint8_t i) const { return(isInUse(i) && (SYNCED == valves[i].state)); }
+    // Consecutive valve-setting commands missed by valve i.
+    uint8_t getMissedTX(const uint8_t i) const { return(isInUse(i) ? valves[i].missed : 0); }
+    // Number of times any valve has lost sync and been resynced.
+    uint16_t getLostSyncCount() const { return(lostSyncCount); }
+    // Start of the current slot, in half seconds since construction.
+    uint32_t getNow() const { return(now); }
+
+    // Record that n slots passed without nextSlot() being called, eg while the hub was busy.
+    // Anything due in them is missed; frames late by more than MAX_LATE_HS are dropped
+    // and valves that miss too many are resynced.
+    void skipSlots(const uint8_t n) { now += n; }
+
+    // Commands to send in the current slot, in order, into out; returns how many.
+    // Then moves on to the next slot.
+    uint8_t nextSlot(TX (&out)[maxTXPerSlot])
+      {
+      for(uint8_t i = 0; i < maxValves; ++i) { update(i); }
+      uint8_t n = 0;
+      // Timing-critical commands, most overdue first;
+      // any that do not fit are sent in the next slot if still in time.
+      bool taken[maxValves] = {};
+      while(n < maxTXPerSlot)
+        {
+        int8_t best = -1;
+        for(uint8_t i = 0; i < maxValves; ++i)
+          {
+          if(taken[i] || !isCriticalDue(valves[i])) { continue; }
+          if((best < 0) || (valves[i].due < valves[best].due)) { best = int8_t(i); }
+          }
+        if(best < 0) { break; }
+        Valve &v = valves[best];
+        taken[best] = true;
+        if(SYNC_FINAL == v.state)
+          {
+          // Command 0, extension byte present.
+          fillCommand(out[n], uint8_t(best), 0x20, 0);
+          out[n].sync = true;
+          v.state = SYNCED;
+          }
+        else
+          {
+          // Command 0x26: set valve position.
+          fillCommand(out[n], uint8_t(best), 0x26, FHT8VRadValveUtil::convertPercentTo255Scale(v.valvePC));
+          out[n].sync = false;
+          }
+        // Next slot from the valve's own timeline, so lateness does not accumulate.
+        v.due += txGapHalfSeconds(v.hc2);
+        v.missed = 0;
+        ++n;
+        }
+      // Sync countdown (command 12) frames in the remaining room;
+      // these are redundant and simply skipped if there is none.
+      for(uint8_t k = 0; (k < maxValves) && (n < maxTXPerSlot); ++k)
+        {
+        const uint8_t i = uint8_t((rrStart + k) % maxValves);
+        const Valve &v = valves[i];
+        if((SYNC_COUNTDOWN != v.state) || (v.due <= now)) { continue; }
+        // Countdown value in half seconds to the final state: sent when odd, ie once per second.
+        const uint32_t countdown = v.due - now + 2;
+        if((0 == (countdown & 1)) || (countdown > SYNC_COUNTDOWN_START)) { continue; }
+        fillCommand(out[n], i, 0x2c, uint8_t(countdown));
+        out[n].sync = true;
+        ++n;
+        }
+      rrStart = uint8_t((rrStart + 1) % maxValves);
+      ++now;
+      return(n);
+      }
+  };
+
+
+// Drives up to maxValves FHT8V valves through one radio with FHT8VMultiValveScheduler.
+// Call poll() at the start of every half second (eg from the 0.5s tick)
+// which sends that slot's frames immediately, back to back.
+//   * preambleBytes, preambleByte  optional RFM23-friendly preamble before each frame
+//     so that OpenTRV hubs can hear the frames too (see FHT8VRadValve); none by default
+template<uint8_t maxValves, uint8_t maxTXPerSlot = 3, uint8_t preambleBytes = 0, uint8_t preambleByte = 0xaa>
+class FHT8VMultiValveController final
+  {
+  public:
+    typedef FHT8VMultiValveScheduler<maxValves, maxTXPerSlot> scheduler_t;
+
+  private:
+    OTRadioLink::OTRadioLink *radio = NULL;
+    int8_t channelTX = 0;
+    scheduler_t s;
+    // One encoded frame, 0xff-terminated.
+    uint8_t buf[preambleBytes + FHT8VRadValveUtil::MIN_FHT8V_200US_BIT_STREAM_BUF_SIZE];
+
+  public:
+    // Set radio to use (if non-NULL) or clear access to radio (if NULL).
+    void setRadio(OTRadioLink::OTRadioLink *const r) { radio = r; }
+    // Set radio channel to use for TX to the valves; defaults to 0.
+    void setChannelTX(const int8_t channel) { channelTX = channel; }
+
+    // The valves and their schedule, eg to add valves and set their positions.
+    scheduler_t &valves() { return(s); }
+    const scheduler_t &valves() const { return(s); }
+
+    // Send this half second's frames; returns the number sent.
+    // Sync frames are always double TX, as for FHT8VRadValve;
+    // valve-setting frames only if allowDoubleTX, and maxTXPerSlot should allow for that.
+    // With no radio the schedule still advances so valves fall out of sync as they would.
+    uint8_t poll(const bool allowDoubleTX = false)
+      {
+      typename scheduler_t::TX tx[maxTXPerSlot];
+      const uint8_t n = s.nextSlot(tx);
+      OTRadioLink::OTRadioLink *const r = radio;
+      if(NULL == r) { return(0); }
+      uint8_t sent = 0;
+      for(uint8_t i = 0; i < n; ++i)
+        {
+        memset(buf, preambleByte, preambleBytes);
+        FHT8VRadValveUtil::FHT8VCreate200usBitStreamBptr(buf + preambleBytes, &tx[i].command);
+        const bool doubleTX = tx[i].sync || allowDoubleTX;
+        if(r->sendRaw(buf, OTRadioLink::frameLenFFTerminated(buf), channelTX,
+            doubleTX ? OTRadioLink::OTRadioLink::TXmax : OTRadioLink::OTRadioLink::TXnormal))
+          { ++sent; }
+        }
+      return(sent);
+      }
+  };
+
+
+    }
+
+#endif
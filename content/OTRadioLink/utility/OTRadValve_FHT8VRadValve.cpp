@@ -26,6 +26,7 @@ Author(s) / Copyright (s): Damon Hart-Davis 2013--2016
 
 #ifdef ARDUINO_ARCH_AVR
 #include <util/parity.h>
+#include <avr/pgmspace.h>
 #endif
 
 #include <OTV0p2Base.h>
@@ -117,6 +118,14 @@ static uint8_t *_FHT8VCreate200usAppendByteEP(uint8_t *bptr, const uint8_t b)
 // Note that a buffer space of at least 46 bytes is needed to accommodate the longest-possible encoded message and terminator.
 // Returns pointer to the terminating 0xff on exit.
 uint8_t *FHT8VRadValveUtil::FHT8VCreate200usBitStreamBptr(uint8_t *bptr, const FHT8VRadValveUtil::fht8v_msg_t *command)
+  {
+  bptr = FHT8VCreate200usBitStreamPrefixBptr(bptr, command);
+  return(FHT8VAppend200usBitStreamExtensionBptr(bptr, command));
+  }
+
+// Encode the preamble, house code, address and command bytes;
+// returns a pointer to the final partially-filled byte.
+uint8_t *FHT8VRadValveUtil::FHT8VCreate200usBitStreamPrefixBptr(uint8_t *bptr, const FHT8VRadValveUtil::fht8v_msg_t *command)
   {
   // Generate FHT8V preamble.
   // First 12 x 0 bits of preamble, pre-encoded as 6 x 0xcc bytes.
@@ -130,7 +139,7 @@ uint8_t *FHT8VRadValveUtil::FHT8VCreate200usBitStreamBptr(uint8_t *bptr, const F
   // Push remaining 1 of preamble.
   bptr = _FHT8VCreate200usAppendEncBit(bptr, true); // Encode 1.
 
-  // Generate body.
+  // Generate body up to the extension.
   bptr = _FHT8VCreate200usAppendByteEP(bptr, command->hc1);
   bptr = _FHT8VCreate200usAppendByteEP(bptr, command->hc2);
 #ifdef OTV0P2BASE_FHT8V_ADR_USED
@@ -138,7 +147,13 @@ uint8_t *FHT8VRadValveUtil::FHT8VCreate200usBitStreamBptr(uint8_t *bptr, const F
 #else
   bptr = _FHT8VCreate200usAppendByteEP(bptr, 0); // Default/broadcast.  TODO: could possibly be further optimised to send 0 value more efficiently.
 #endif
-  bptr = _FHT8VCreate200usAppendByteEP(bptr, command->command);
+  return(_FHT8VCreate200usAppendByteEP(bptr, command->command));
+  }
+
+// Append the extension byte, checksum and trailer to a prefix from FHT8VCreate200usBitStreamPrefixBptr();
+// returns pointer to the terminating 0xff.
+uint8_t *FHT8VRadValveUtil::FHT8VAppend200usBitStreamExtensionBptr(uint8_t *bptr, const FHT8VRadValveUtil::fht8v_msg_t *command)
+  {
   bptr = _FHT8VCreate200usAppendByteEP(bptr, command->extension);
   // Generate checksum.
 #ifdef OTV0P2BASE_FHT8V_ADR_USED
@@ -362,6 +377,104 @@ uint8_t const * FHT8VRadValveUtil::FHT8VDecodeBitStream(uint8_t const *bitStream
   return(state.bitStream + 1);
   }
 
+// Nibble transition table for FHT8VDecodeBitStreamLUT().
+// Decoding is a three-state machine over bit pairs:
+// state 0 expects 11, state 1 then takes 00 (a 0) or 10, and state 2 then takes 00 (a 1).
+// Indexed by (state << 4) | nibble where the nibble is two pairs, MSB first; each entry holds:
+//   * bits 0--1: next state, 3 if either pair is invalid
+//   * bit 2: a bit was decoded
+//   * bit 3: the decoded bit's value
+//   * bit 4: the bit was decoded by the first pair (so the second pair is not part of it)
+// 48 bytes rather than 768 for a whole-byte table.
+static const uint8_t FHT8VDecodeNibbleTable[3*16]
+#ifdef ARDUINO_ARCH_AVR
+    PROGMEM
+#endif // ARDUINO_ARCH_AVR
+    = {
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x04, 0x03, 0x02, 0x03,
+    0x17, 0x17, 0x17, 0x15, 0x03, 0x03, 0x03, 0x03, 0x0c, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x1f, 0x1f, 0x1f, 0x1d, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    };
+static constexpr uint8_t FHT8V_DNT_STATE_MASK = 3;
+static constexpr uint8_t FHT8V_DNT_INVALID = 3;
+static constexpr uint8_t FHT8V_DNT_BIT = 4;
+static constexpr uint8_t FHT8V_DNT_ONE = 8;
+static constexpr uint8_t FHT8V_DNT_FIRST_PAIR = 0x10;
+
+// As FHT8VDecodeBitStream() but decoding a nibble (two bit pairs) per table lookup.
+// Accepts and rejects exactly the same streams, returning the same pointer and command.
+// Rejects at the first invalid pair, bad parity bit or misplaced trailer.
+uint8_t const * FHT8VRadValveUtil::FHT8VDecodeBitStreamLUT(uint8_t const *bitStream, uint8_t const *lastByte, FHT8VRadValveUtil::fht8v_msg_t *command)
+  {
+  // Decoded bytes: hc1, hc2, address, command, extension, checksum.
+  uint8_t bytes[6];
+  // Index of byte being decoded; 0xff until the leading 1 is found, 6 when the trailing 0 is due.
+  uint8_t byteIndex = 0xff;
+  // Bits of the current byte so far (8 for the parity bit), their value and parity.
+  uint8_t bitCount = 0;
+  uint8_t value = 0;
+  uint8_t parity = 0;
+  uint8_t state = 0;
+  for(uint8_t const *p = bitStream; p <= lastByte; ++p)
+    {
+    const uint8_t b = *p;
+    for(uint8_t lowNibble = 0; lowNibble < 2; ++lowNibble)
+      {
+      const uint8_t i = uint8_t((state << 4) | (lowNibble ? (b & 0xf) : (b >> 4)));
+#ifdef ARDUINO_ARCH_AVR
+      const uint8_t e = pgm_read_byte(FHT8VDecodeNibbleTable + i);
+#else
+      const uint8_t e = FHT8VDecodeNibbleTable[i];
+#endif // ARDUINO_ARCH_AVR
+      if(0 != (e & FHT8V_DNT_BIT))
+        {
+        const uint8_t bit = (e / FHT8V_DNT_ONE) & 1;
+        if(byteIndex < 6)
+          {
+          if(bitCount < 8)
+            {
+            value = uint8_t((value << 1) | bit);
+            parity ^= bit;
+            ++bitCount;
+            }
+          else
+            {
+            // Even parity over the byte and parity bit.
+            if(parity != bit) { return(NULL); }
+            bytes[byteIndex++] = value;
+            bitCount = 0; value = 0; parity = 0;
+            }
+          }
+        else if(0xff == byteIndex)
+          {
+          // Absorb leading 0s up to and including the leading 1.
+          if(0 != bit) { byteIndex = 0; }
+          }
+        else
+          {
+          // Trailing 0 ends the frame.
+          if(0 != bit) { return(NULL); }
+          const uint8_t checksum = 0xc + bytes[0] + bytes[1] + bytes[2] + bytes[3] + bytes[4];
+          if(checksum != bytes[5]) { return(NULL); }
+          command->hc1 = bytes[0];
+          command->hc2 = bytes[1];
+#ifdef OTV0P2BASE_FHT8V_ADR_USED
+          command->address = bytes[2];
+#endif
+          command->command = bytes[3];
+          command->extension = bytes[4];
+          // Next byte after the one holding the trailer's last pair.
+          return(p + ((lowNibble && (0 == (e & FHT8V_DNT_FIRST_PAIR))) ? 2 : 1));
+          }
+        }
+      state = e & FHT8V_DNT_STATE_MASK;
+      if(FHT8V_DNT_INVALID == state) { return(NULL); }
+      }
+    }
+  // Ran off the end of the buffer before the trailer.
+  return(NULL);
+  }
+
 #endif // FHT8VRadValveUtil_DEFINED
 
 
@@ -512,6 +625,7 @@ bool FHT8VRadValveBase::doSync(const bool allowDoubleTX)
       command.hc2 = getHC2();
       command.command = 0x2c; // Command 12, extension byte present.
       command.extension = syncStateFHT8V;
+      invalidateValveSetPrefix(); // buf no longer holds a valve-setting command.
       FHT8VRadValveBase::FHT8VCreate200usBitStreamBptr(buf, &command);
       if(halfSecondCount > 0)
         { sleepUntilSubCycleTimeOptionalRX((OTV0P2BASE::SUB_CYCLE_TICKS_PER_S/2) * halfSecondCount); }
@@ -549,6 +663,7 @@ bool FHT8VRadValveBase::doSync(const bool allowDoubleTX)
       command.command = 0x20; // Command 0, extension byte present.
       command.extension = 0; // DHD20130324: could set to TRVPercentOpen, but anything other than zero seems to lock up FHT8V-3 units.
       FHT8V_isValveOpen = false; // Note that valve will be closed (0%) upon receipt.
+      invalidateValveSetPrefix(); // buf no longer holds a valve-setting command.
       FHT8VRadValveBase::FHT8VCreate200usBitStreamBptr(buf, &command);
       if(halfSecondCount > 0) { sleepUntilSubCycleTimeOptionalRX((OTV0P2BASE::SUB_CYCLE_TICKS_PER_S/2) * halfSecondCount); }
       FHT8VTXFHTQueueAndSendCmd(buf, allowDoubleTX); // SEND SYNC FINAL
@@ -769,6 +884,7 @@ uint8_t FHT8VRadValveBase::nvGetHC2()
 // Load EEPROM house codes into primary FHT8V instance at start-up or once cleared in FHT8V instance.
 void FHT8VRadValveBase::nvLoadHC()
   {
+  invalidateValveSetPrefix();
   // Uses side-effect to cache/save in FHT8V instance.
   nvGetHC1();
   nvGetHC2();
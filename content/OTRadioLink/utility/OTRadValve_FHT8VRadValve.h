@@ -110,11 +110,30 @@ class FHT8VRadValveUtil
     // Returns pointer to the terminating 0xff on exit.
     static uint8_t *FHT8VCreate200usBitStreamBptr(uint8_t *bptr, const fht8v_msg_t *command);
 
+    // The two halves of FHT8VCreate200usBitStreamBptr(), so that the encoded form of the parts
+    // that do not change between commands to one valve can be reused.
+    // FHT8VCreate200usBitStreamPrefixBptr() encodes the preamble, house code, address and command bytes,
+    // returning a pointer to the final partially-filled byte (not terminated);
+    // that byte's value on return, with the bytes before it, holds the complete encoder state.
+    // FHT8VAppend200usBitStreamExtensionBptr() then appends the extension byte (from command),
+    // checksum and trailer starting from that partial byte (with its value restored if overwritten since),
+    // returning a pointer to the terminating 0xff.
+    // Re-encoding only the extension is 21 encoded bits rather than 58 for the whole command.
+    // The encoded prefix is at most MAX_FHT8V_200US_BIT_STREAM_PREFIX_BYTES long including the partial byte.
+    static const uint8_t MAX_FHT8V_200US_BIT_STREAM_PREFIX_BYTES = 6 + (((1 + 4*9) * 6) + 7) / 8;
+    static uint8_t *FHT8VCreate200usBitStreamPrefixBptr(uint8_t *bptr, const fht8v_msg_t *command);
+    static uint8_t *FHT8VAppend200usBitStreamExtensionBptr(uint8_t *bptr, const fht8v_msg_t *command);
+
     // Decode raw bitstream into non-null command structure passed in; returns true if successful.
     // Will return non-null if OK, else NULL if anything obviously invalid is detected such as failing parity or checksum.
     // Finds and discards leading encoded 1 and trailing 0.
     // Returns NULL on failure, else pointer to next full byte after last decoded.
     static uint8_t const *FHT8VDecodeBitStream(uint8_t const *bitStream, uint8_t const *lastByte, fht8v_msg_t *command);
+    // As FHT8VDecodeBitStream(), with identical results, but table-driven:
+    // decodes two encoded bit pairs per lookup in a 48-byte table
+    // and rejects at the first invalid pair or parity bit.
+    // For hubs sniffing FS20/FHT8V traffic where decoding is a hot path.
+    static uint8_t const *FHT8VDecodeBitStreamLUT(uint8_t const *bitStream, uint8_t const *lastByte, fht8v_msg_t *command);
 
     // Approximate maximum transmission (TX) time for bare FHT8V command frame in ms; strictly positive.
     // This ignores any prefix needed for particular radios such as the RFM23B.
@@ -316,14 +335,27 @@ class FHT8VRadValveBase : public OTRadValve::AbstractRadValve, public FHT8VRadVa
     // Marked volatile to allow thread-/ISR- safe lock-free access for read.
     volatile uint8_t hc1, hc2;
 
+    // Encoded valve-setting command prefix left in buf by the last FHT8VCreateValveSetCmdFrame(),
+    // ie preamble, house code, address and command (see FHT8VCreate200usBitStreamPrefixBptr()),
+    // so that a new valve position only needs its extension and checksum re-encoded.
+    // The prefix starts at buf + valveSetPrefixOffset and is valveSetPrefixLen bytes
+    // before its partial final byte, whose original value is valveSetPrefixPartial.
+    // valveSetPrefixLen is 0 if there is no valid prefix in buf,
+    // eg after a house code change or once buf has been used for another command.
+    uint8_t valveSetPrefixOffset;
+    uint8_t valveSetPrefixLen;
+    uint8_t valveSetPrefixPartial;
+    // Forget any encoded valve-setting command prefix in buf.
+    void invalidateValveSetPrefix() { valveSetPrefixLen = 0; }
+
   public:
      // Clear both housecode parts (and thus disable use of FHT8V valve).
-    void clearHC() { hc1 = ~0, hc2 = ~0; resyncWithValve(); }
+    void clearHC() { hc1 = ~0, hc2 = ~0; invalidateValveSetPrefix(); resyncWithValve(); }
     // Set (non-volatile) HC1 and HC2 for single/primary FHT8V wireless valve under control.
     // Both parts must be <= 99 for the house code to be valid and the valve used.
     // Forces resync with remote valve if house code changed.
-    void setHC1(uint8_t hc) { if(hc != hc1) { hc1 = hc; resyncWithValve(); } }
-    void setHC2(uint8_t hc) { if(hc != hc2) { hc2 = hc; resyncWithValve(); } }
+    void setHC1(uint8_t hc) { if(hc != hc1) { hc1 = hc; invalidateValveSetPrefix(); resyncWithValve(); } }
+    void setHC2(uint8_t hc) { if(hc != hc2) { hc2 = hc; invalidateValveSetPrefix(); resyncWithValve(); } }
     // Get (non-volatile) HC1 and HC2 for single/primary FHT8V wireless valve under control (will be 0xff until set).
     // Both parts must be <= 99 for the house code to be valid and the valve used.
     // Thread-/ISR- safe, eg for use in radio RX filter IRQ routine.
@@ -536,18 +568,34 @@ class FHT8VRadValve final : public FHT8VRadValveBase
 
       uint8_t * const bptrInitial = FHT8VTXCommandArea;
       const uint8_t bufSize = sizeof(FHT8VTXCommandArea);
-      uint8_t *bptr = bptrInitial;
+      const uint8_t offset = doHeader ? preambleBytes : 0;
+      uint8_t *bptr = bptrInitial + offset;
 
-      // Start with RFM23-friendly preamble if requested.
-      if(doHeader)
+      // Reuse the encoded preamble/house code/command from the previous frame if still in the buffer,
+      // moving it if the RFM23-friendly preamble has been added or removed,
+      // else encode it afresh.
+      // ASSUMES sufficient buffer space.
+      if(0 != valveSetPrefixLen)
         {
-        memset(bptr, preambleByte, preambleBytes);
-        bptr += preambleBytes;
+        if(offset != valveSetPrefixOffset)
+          { memmove(bptr, bptrInitial + valveSetPrefixOffset, valveSetPrefixLen); }
+        bptr += valveSetPrefixLen;
+        *bptr = valveSetPrefixPartial;
         }
+      else
+        {
+        uint8_t * const prefix = bptr;
+        bptr = FHT8VRadValveBase::FHT8VCreate200usBitStreamPrefixBptr(prefix, &command);
+        valveSetPrefixLen = uint8_t(bptr - prefix);
+        valveSetPrefixPartial = *bptr;
+        }
+      valveSetPrefixOffset = offset;
 
-      // Encode and append FHT8V FS20 command.
-      // ASSUMES sufficient buffer space.
-      bptr = FHT8VRadValveBase::FHT8VCreate200usBitStreamBptr(bptr, &command);
+      // Start with RFM23-friendly preamble if requested.
+      if(doHeader) { memset(bptrInitial, preambleByte, preambleBytes); }
+
+      // Encode and append the FHT8V FS20 command extension (valve position) and checksum.
+      bptr = FHT8VRadValveBase::FHT8VAppend200usBitStreamExtensionBptr(bptr, &command);
 
       // Append trailer if allowed/possible.
       if(doTrailer)
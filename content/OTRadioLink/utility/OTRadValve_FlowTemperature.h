@@ -0,0 +1,141 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Weather-compensated flow temperature target for a modulating boiler,
+ * eg driven via an OpenTherm-style controller, from the hub.
+ *
+ * A condensing boiler is most efficient with the lowest flow temperature
+ * that still heats the building, so rather than just switching the boiler
+ * the hub can ask for a flow temperature:
+ *   * from the outside temperature if known, with a simple heating curve
+ *       flow = room + slope * (room - outside)
+ *   * trimmed down towards the minimum flow temperature when the valves
+ *     are on average only a little open (heat to spare),
+ *     and left at the curve value when they are wide open (rooms struggling);
+ *     with no outside temperature the curve value is the maximum flow temperature.
+ *
+ * The target moves by at most a degree per update,
+ * eg once a minute, so that boiler and valves do not hunt against each other.
+ *
+ * Portable.
+ */
+
+#ifndef ARDUINO_LIB_OTRADVALVE_FLOWTEMPERATURE_H
+#define ARDUINO_LIB_OTRADVALVE_FLOWTEMPERATURE_H
+
+#include <stdint.h>
+#include <OTV0p2Base.h>
+
+// Use namespaces to help avoid collisions.
+namespace OTRadValve
+    {
+
+// Flow temperature target and matching modulation demand for the boiler.
+// Temperatures are C*16 (C16) as for the temperature sensors.
+// Not thread-/ISR- safe.
+class FlowTemperatureTarget final
+    {
+    public:
+        // Outside temperature not known.
+        static constexpr int16_t NO_OUTSIDE_TEMP = INT16_MIN;
+        // Mean valve opening at or below which the flow target is the minimum.
+        static constexpr uint8_t LOW_DEMAND_PC = 25;
+        // Mean valve opening at or above which the flow target is the curve value.
+        static constexpr uint8_t HIGH_DEMAND_PC = 75;
+        // Largest change of target per update.
+        static constexpr int16_t MAX_STEP_C16 = 16;
+
+        // Defaults suit radiators on a condensing boiler.
+        static constexpr uint8_t DEFAULT_MIN_FLOW_C = 30;
+        static constexpr uint8_t DEFAULT_MAX_FLOW_C = 70;
+        static constexpr uint8_t DEFAULT_ROOM_C = 20;
+        // Heating curve slope in tenths; ~1.5 for radiators, ~0.5 for underfloor.
+        static constexpr uint8_t DEFAULT_SLOPE_TENTHS = 15;
+
+    private:
+        const int16_t minFlowC16;
+        const int16_t maxFlowC16;
+        const int16_t roomC16;
+        const uint8_t slopeTenths;
+        // Current target; 0 when there is no demand.
+        int16_t flowC16 = 0;
+
+        // Unrate-limited target for the given inputs.
+        int16_t computeTarget(const int16_t outsideC16, const uint8_t meanOpenPC) const
+            {
+            int16_t curve = maxFlowC16;
+            if(NO_OUTSIDE_TEMP != outsideC16)
+                {
+                const int32_t c = roomC16 + (((int32_t)(roomC16 - outsideC16) * slopeTenths) / 10);
+                curve = (int16_t)OTV0P2BASE::fnconstrain(c, (int32_t)minFlowC16, (int32_t)maxFlowC16);
+                }
+            if(meanOpenPC <= LOW_DEMAND_PC) { return(minFlowC16); }
+            if(meanOpenPC >= HIGH_DEMAND_PC) { return(curve); }
+            return((int16_t)(minFlowC16 + (((int32_t)(curve - minFlowC16) * (meanOpenPC - LOW_DEMAND_PC)) / (HIGH_DEMAND_PC - LOW_DEMAND_PC))));
+            }
+
+    public:
+        // minFlowC must be below maxFlowC; otherwise the defaults are used.
+        FlowTemperatureTarget(const uint8_t minFlowC = DEFAULT_MIN_FLOW_C,
+                              const uint8_t maxFlowC = DEFAULT_MAX_FLOW_C,
+                              const uint8_t roomC = DEFAULT_ROOM_C,
+                              const uint8_t slopeTenths_ = DEFAULT_SLOPE_TENTHS)
+          : minFlowC16((int16_t)(16 * ((minFlowC < maxFlowC) ? minFlowC : uint8_t(DEFAULT_MIN_FLOW_C)))),
+            maxFlowC16((int16_t)(16 * ((minFlowC < maxFlowC) ? maxFlowC : uint8_t(DEFAULT_MAX_FLOW_C)))),
+            roomC16((int16_t)(16 * roomC)),
+            slopeTenths(slopeTenths_) { }
+
+        // Update the target, eg once a minute.
+        //   * boilerOn  false if there is no demand, which sets the target to 0
+        //   * meanOpenPC  mean opening of the valves calling, [0,100]
+        //   * outsideC16  outside temperature or NO_OUTSIDE_TEMP
+        void update(const bool boilerOn, const uint8_t meanOpenPC, const int16_t outsideC16 = NO_OUTSIDE_TEMP)
+            {
+            if(!boilerOn) { flowC16 = 0; return; }
+            const int16_t target = computeTarget(outsideC16, meanOpenPC);
+            // Start straight at the target, then move gently.
+            if(0 == flowC16) { flowC16 = target; return; }
+            flowC16 = OTV0P2BASE::fnconstrain(target, (int16_t)(flowC16 - MAX_STEP_C16), (int16_t)(flowC16 + MAX_STEP_C16));
+            }
+        // Update from a boiler driver with isBoilerOn() and getMeanDemandPC(), eg ZonedBoilerDriverLogic.
+        template<class boilerDriver_t>
+        void updateFrom(const boilerDriver_t &bd, const int16_t outsideC16 = NO_OUTSIDE_TEMP)
+            { update(bd.isBoilerOn(), bd.getMeanDemandPC(), outsideC16); }
+
+        // Flow temperature target in C16; 0 if no demand.
+        int16_t getFlowC16() const { return(flowC16); }
+        // Flow temperature target in whole C, rounded; 0 if no demand.
+        uint8_t getFlowC() const { return((uint8_t)((flowC16 + 8) >> 4)); }
+        // Demand as a percentage of the flow temperature range, [0,100]; 0 if no demand,
+        // eg as a maximum relative modulation level.
+        uint8_t getModulationPC() const
+            {
+            if(0 == flowC16) { return(0); }
+            const int16_t range = maxFlowC16 - minFlowC16;
+            const int16_t above = flowC16 - minFlowC16;
+            // Any demand at all asks for a little.
+            return((uint8_t)OTV0P2BASE::fnconstrain((int16_t)(((int32_t)above * 100) / range), (int16_t)1, (int16_t)100));
+            }
+        // Flow target as an OpenTherm control setpoint (data ID 1, f8.8 C); 0 if no demand.
+        uint16_t getOpenThermControlSetpoint() const { return((uint16_t)(flowC16 << 4)); }
+    };
+
+    }
+
+#endif
@@ -136,6 +136,22 @@ namespace OTRadValve
 
 #endif // ModelledRadValve_DEFINED
 
+// Recompute the plan from the by-hour stats and the lockout state.
+// Ranks the smoothed occupancy exactly as the prediction cache does.
+void SetbackPlan::rebuild(const OTV0P2BASE::NVByHourByteStatsBase &stats, const bool setbackLockedOut)
+    {
+    OTV0P2BASE::ByHourOccupancyPredictionCache occ;
+    occ.rebuild(stats);
+    for(uint8_t hh = 0; hh < 24; ++hh)
+        {
+        const bool vacant = (0 == stats.getByHourStatSimple(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR, hh));
+        hourPlan[hh] = uint8_t(occ.getHoursLessOccupiedThan(hh) | (vacant ? HOUR_VACANT_LAST : 0));
+        }
+    setHours = occ.getHoursLessOccupiedThan(0xff);
+    lockedOut = setbackLockedOut;
+    valid = true;
+    }
+
 
     }
 
@@ -155,6 +155,77 @@ class ModelledRadValveComputeTargetTempBase
   };
 
 namespace CTTBasicLogic {
+// Inputs to one target computation, each read on first use and then memoised,
+// so that (possibly slow, eg EEPROM- or RTC-backed) inputs not needed
+// by the current mode and branch are never read,
+// and those needed more than once are read only once per tick.
+// Lives only for one computation; not thread-/ISR- safe.
+template<
+    class TempControlBase,
+    class PseudoSensorOccupancyTracker,
+    class SimpleValveScheduleBase,
+    class NVByHourByteStatsBase
+>
+class LazyInputs final
+{
+private:
+    const TempControlBase &tempControl;
+    const PseudoSensorOccupancyTracker &occupancy;
+    const SimpleValveScheduleBase &schedule;
+    const NVByHourByteStatsBase &byHourStats;
+
+    // Set bits mark memoised values.
+    static constexpr uint8_t HAVE_WARM = 1;
+    static constexpr uint8_t HAVE_FROST = 2;
+    static constexpr uint8_t HAVE_MSM = 4;
+    static constexpr uint8_t HAVE_LV = 8;
+    static constexpr uint8_t HAVE_HLOT = 16;
+    static constexpr uint8_t HAVE_HLON = 32;
+    uint8_t have = 0;
+    uint8_t warmC = 0;
+    uint8_t frostC = 0;
+    uint_least16_t msm = 0;
+    bool lv = false;
+    uint8_t hlot = 0;
+    uint8_t hlon = 0;
+
+    // True (and marks the value as memoised) if it is yet to be read.
+    bool need(const uint8_t bit) { if(0 != (have & bit)) { return(false); } have |= bit; return(true); }
+
+    // Count of hours less occupied than the given (special) hour.
+    uint8_t hoursLessOccupiedThan(const uint8_t hh) const
+    {
+        return(byHourStats.countStatSamplesBelow(
+            OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED,
+            byHourStats.getByHourStatRTC(
+                OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED, hh)));
+    }
+
+public:
+    LazyInputs(const TempControlBase &tc, const PseudoSensorOccupancyTracker &occ,
+               const SimpleValveScheduleBase &sch, const NVByHourByteStatsBase &bhs)
+      : tempControl(tc), occupancy(occ), schedule(sch), byHourStats(bhs) { }
+
+    uint8_t getWARMTargetC() { if(need(HAVE_WARM)) { warmC = tempControl.getWARMTargetC(); } return(warmC); }
+    uint8_t getFROSTTargetC() { if(need(HAVE_FROST)) { frostC = tempControl.getFROSTTargetC(); } return(frostC); }
+    uint_least16_t getMinutesSinceMidnightLT() { if(need(HAVE_MSM)) { msm = OTV0P2BASE::getMinutesSinceMidnightLT(); } return(msm); }
+    bool longVacant() { if(need(HAVE_LV)) { lv = occupancy.longVacant(); } return(lv); }
+    bool isAnyScheduleOnWARMSoon() { return(schedule.isAnyScheduleOnWARMSoon(getMinutesSinceMidnightLT())); }
+    bool isAnyScheduleOnWARMNow() { return(schedule.isAnyScheduleOnWARMNow(getMinutesSinceMidnightLT())); }
+    // Count of hours less occupied than this hour, from the smoothed stats.
+    uint8_t hoursLessOccupiedThanThis()
+    {
+        if(need(HAVE_HLOT)) { hlot = hoursLessOccupiedThan(OTV0P2BASE::NVByHourByteStatsBase::SPECIAL_HOUR_CURRENT_HOUR); }
+        return(hlot);
+    }
+    // Count of hours less occupied than the next hour, from the smoothed stats.
+    uint8_t hoursLessOccupiedThanNext()
+    {
+        if(need(HAVE_HLON)) { hlon = hoursLessOccupiedThan(OTV0P2BASE::NVByHourByteStatsBase::SPECIAL_HOUR_NEXT_HOUR); }
+        return(hlon);
+    }
+};
+
 template<
     class valveControlParameters,
     class TempControlBase,
@@ -174,9 +245,14 @@ uint8_t computeTargetTemp(
     const NVByHourByteStatsBase&  byHourStats,
     bool (*const setbackLockout)() = ((bool(*)())nullptr))
 {
+    // Read inputs only as this mode and branch need them.
+    LazyInputs<TempControlBase, PseudoSensorOccupancyTracker,
+               SimpleValveScheduleBase, NVByHourByteStatsBase>
+        in(tempControl, occupancy, schedule, byHourStats);
+
     // In FROST mode.
     if(!valveMode.inWarmMode()) {
-        const uint8_t frostC = tempControl.getFROSTTargetC();
+        const uint8_t frostC = in.getFROSTTargetC();
 
         // If a scheduled WARM is due soon then ensure
         // that room is at least at a smallish setback temperature
@@ -197,10 +273,10 @@ uint8_t computeTargetTemp(
         //     http://www.earth.org.uk/img/20160110-vat-b.png
         // (A very long pre-warm time may confuse or distress users,
         // eg waking them in the morning.)
-        if(!occupancy.longVacant()
-                && schedule.isAnyScheduleOnWARMSoon(OTV0P2BASE::getMinutesSinceMidnightLT())
+        if(!in.longVacant()
+                && in.isAnyScheduleOnWARMSoon()
                 && !physicalUI.recentUIControlUse()) {
-            const uint8_t warmTarget = tempControl.getWARMTargetC();
+            const uint8_t warmTarget = in.getWARMTargetC();
             // Compute putative pre-warm temperature, usually just below WARM.
             const uint8_t preWarmTempC = OTV0P2BASE::fnmax(frostC,
             uint8_t(warmTarget -
@@ -215,18 +291,18 @@ uint8_t computeTargetTemp(
     } else if(valveMode.inBakeMode()) {
         // If in BAKE mode then use elevated target, with no setbacks.
         return(OTV0P2BASE::fnmin(
-            (uint8_t)(tempControl.getWARMTargetC() + valveControlParameters::BAKE_UPLIFT),
+            (uint8_t)(in.getWARMTargetC() + valveControlParameters::BAKE_UPLIFT),
             OTRadValve::MAX_TARGET_C));
     } else {
         // In 'WARM' mode with possible setback.
-        const uint8_t wt = tempControl.getWARMTargetC();
+        const uint8_t wt = in.getWARMTargetC();
 
         // If smart setbacks are locked out then return WARM temperature as-is.  (TODO-786, TODO-906)
         if((NULL != setbackLockout) && (setbackLockout)())
             { return(wt); }
 
         //          const bool longLongVacant = occupancy.longLongVacant();
-        const bool longVacant = /*longLongVacant || */ occupancy.longVacant();
+        const bool longVacant = /*longLongVacant || */ in.longVacant();
         const bool confidentlyVacant = longVacant || occupancy.confidentlyVacant();
         const bool likelyVacantNow = confidentlyVacant || occupancy.isLikelyUnoccupied();
 
@@ -236,7 +312,7 @@ uint8_t computeTargetTemp(
         const bool allowSetback =
             likelyVacantNow
             && (/*long*/longVacant 
-                || !schedule.isAnyScheduleOnWARMNow(OTV0P2BASE::getMinutesSinceMidnightLT()));
+                || !in.isAnyScheduleOnWARMNow());
 
         if(allowSetback) {
             // Use DEFAULT setback unless confident that more is OK.
@@ -251,38 +327,30 @@ uint8_t computeTargetTemp(
             const uint16_t dm = ambLight.getDarkMinutes();
             static constexpr uint16_t longDarkM = 7*60U; // 7h
 
-            // Any imminent scheduled on may inhibit all but min setback.
-            const bool scheduleOnSoon = schedule.isAnyScheduleOnWARMSoon(OTV0P2BASE::getMinutesSinceMidnightLT());
-            // High likelihood of occupancy now inhibits ECO setback.
-            const uint8_t hoursLessOccupiedThanThis =
-                byHourStats.countStatSamplesBelow(
-                        OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED,
-                        byHourStats.getByHourStatRTC(
-                            OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED,
-                            OTV0P2BASE::NVByHourByteStatsBase::SPECIAL_HOUR_CURRENT_HOUR));
-
             static constexpr uint8_t maxThr = 17;
             static constexpr uint8_t minThr = 14;
             static_assert(maxThr >= minThr, "sensitivity must not decrease with temp");
             const uint8_t thisHourNLOThreshold =
                 tempControl.hasEcoBias() ? maxThr : minThr;
-            const bool relativelyActive =
-                (hoursLessOccupiedThanThis > thisHourNLOThreshold);
             // Inhibit ECO (or more) setback
-            // for scheduled-on (unless long vacant, eg a day or more)
-            // or where this hour is typically relatively busy
+            // for any imminent scheduled on (unless long vacant, eg a day or more)
+            // or where this hour is typically relatively busy,
+            // ie high likelihood of occupancy now
             // (unless 'vacant' for the equivalent of a decent night's sleep).
             // Avoid inhibiting warm-up before return from work/school.
+            // The schedule and stats are only read if they can matter.
             const bool inhibitECOSetback = !longVacant
-                && (scheduleOnSoon || ((dm < longDarkM) && (relativelyActive)));
+                && (in.isAnyScheduleOnWARMSoon()
+                    || ((dm < longDarkM)
+                        && (in.hoursLessOccupiedThanThis() > thisHourNLOThreshold)));
 
             // ECO setback is possible: bulk of energy saving opportunities.
             // Go for ECO if dark or likely vacant now,
             // and not usually relatively occupied now or in next hour.
             if(!inhibitECOSetback
                     && (confidentlyVacant
-                        || (likelyVacantNow && (hoursLessOccupiedThanThis <= 1))
-                        || (0 != dm))) {
+                        || (0 != dm)
+                        || (likelyVacantNow && (in.hoursLessOccupiedThanThis() <= 1)))) {
                 setback = valveControlParameters::SETBACK_ECO;
 
                 // High likelihood of occupancy soon inhibits FULL setback,
@@ -290,15 +358,7 @@ uint8_t computeTargetTemp(
                 // to allow getting warm ready for return from work/school.
                 // TODO: other signals such as manual control use and
                 // typical temperature at this time could inhibit FULL setback.
-                const uint8_t hoursLessOccupiedThanNext =
-                    byHourStats.countStatSamplesBelow(
-                        OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED,
-                        byHourStats.getByHourStatRTC(
-                            OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED,
-                            OTV0P2BASE::NVByHourByteStatsBase::SPECIAL_HOUR_NEXT_HOUR));
-                const bool relativelyActiveSoon =
-                    (hoursLessOccupiedThanNext > 2 + thisHourNLOThreshold);
-
+                //
                 // Set a lower occupancy threshold to prevent FULL setback.
                 // Much lower if not dark for too long.
                 static constexpr uint8_t linReduction = 4;
@@ -307,14 +367,14 @@ uint8_t computeTargetTemp(
                 const uint8_t thisHourNLOThresholdF = OTV0P2BASE::fnmin(
                         thisHourNLOThreshold - linReduction,
                         (thisHourNLOThreshold >> 2) + uint8_t(dm>>5));
-                const bool notInactive =
-                    (hoursLessOccupiedThanThis > thisHourNLOThresholdF);
 
-                // Inhibit FULL setback if at top end of comfort range.
+                // Inhibit FULL setback if at top end of comfort range,
+                // or not inactive now or relatively active soon.
                 const bool comfortTemperature = tempControl.isComfortTemperature(wt);
                 const bool inhibitFULLSetback = comfortTemperature
-                    || ((dm < longDarkM) 
-                        && (notInactive || relativelyActiveSoon));
+                    || ((dm < longDarkM)
+                        && ((in.hoursLessOccupiedThanThis() > thisHourNLOThresholdF)
+                            || (in.hoursLessOccupiedThanNext() > 2 + thisHourNLOThreshold)));
 
                 // FULL setback possible; saving energy/noise for night/holiday.
                 // If long vacant (no sign of activity for around a day)
@@ -324,17 +384,18 @@ uint8_t computeTargetTemp(
                 // are rarely occupied (ie anticipatory turn down);
                 // also help avoid revving up heating for brief lights-on
                 // in the middle of the night.  (TODO-1092)
-                const bool veryQuiet = (hoursLessOccupiedThanThis <= 1)
-                    || (hoursLessOccupiedThanNext <= 1);
                 if(!inhibitFULLSetback
-                        && (longVacant 
-                            || (dm >= (veryQuiet ? 2 : 10)))) {
+                        && (longVacant
+                            || (dm >= 10)
+                            || ((dm >= 2)
+                                && ((in.hoursLessOccupiedThanThis() <= 1)
+                                    || (in.hoursLessOccupiedThanNext() <= 1))))) {
                     setback = valveControlParameters::SETBACK_FULL;
                 }
             }
 
             // Target must never be set low enough to create a frost/freeze hazard.
-            const uint8_t newTarget = OTV0P2BASE::fnmax((uint8_t)(wt - setback), tempControl.getFROSTTargetC());
+            const uint8_t newTarget = OTV0P2BASE::fnmax((uint8_t)(wt - setback), in.getFROSTTargetC());
 
             return(newTarget);
         }
@@ -495,8 +556,73 @@ public:
     }
 };
 
-// Pre-2017 stateless implementation of computation of target temperature.
+// Hour-granular part of the WARM-mode setback decision of ModelledRadValveComputeTargetTemp2016,
+// precomputed once an hour, eg just after each full stats sample,
+// so that the per-minute computation only combines it with live occupancy,
+// light and controls, and reads neither the (EEPROM-backed) stats nor the lockout.
+// Holds for each hour of the day how many hours are less occupied
+// (as countStatSamplesBelow() of the smoothed occupancy would give),
+// and whether the room was unoccupied throughout that hour when last sampled,
+// and, for the whole day, whether smart setbacks are locked out.
+// The plan for each hour can also be inspected, eg for diagnostics.
+// Invalid (and ignored by the computation) until first rebuilt.
+// Memory footprint is 27 bytes.
+class SetbackPlan final
+  {
+  public:
+    // Flag in getHourPlan() for an hour not occupied at all when last sampled.
+    static constexpr uint8_t HOUR_VACANT_LAST = 0x20;
+    // Mask in getHourPlan() for the count of hours less occupied.
+    static constexpr uint8_t HOURS_LESS_OCCUPIED_MASK = 0x1f;
+
+  private:
+    // Per hour: hours less occupied than it, and flags.
+    uint8_t hourPlan[24];
+    // Hours less occupied than an unset or invalid hour.
+    uint8_t setHours = 0;
+    bool lockedOut = false;
+    bool valid = false;
+
+  public:
+    SetbackPlan() : hourPlan() { }
+
+    // Recompute the plan from the by-hour stats and the lockout state (eg from getSetbackLockout()).
+    void rebuild(const OTV0P2BASE::NVByHourByteStatsBase &stats, bool setbackLockedOut);
+    // Update just the lockout state, eg immediately after it is changed from the CLI.
+    void setLockedOut(const bool setbackLockedOut) { lockedOut = setbackLockedOut; }
+    // Mark as needing a rebuild, eg after zapStats().
+    void invalidate() { valid = false; }
+    // True if rebuilt since construction or invalidate().
+    bool isValid() const { return(valid); }
+
+    // True if smart setbacks are locked out.
+    bool isLockedOut() const { return(lockedOut); }
+    // Count of hours less occupied than hour hh [0,23]; other values are taken as an unset hour.
+    uint8_t getHoursLessOccupiedThan(const uint8_t hh) const
+        { return((hh > 23) ? setHours : uint8_t(hourPlan[hh] & HOURS_LESS_OCCUPIED_MASK)); }
+    // True if hour hh [0,23] was not occupied at all when last sampled.
+    bool wasVacantLast(const uint8_t hh) const
+        { return((hh <= 23) && (0 != (hourPlan[hh] & HOUR_VACANT_LAST))); }
+    // Packed plan for hour hh [0,23]; 0 for other hh.
+    uint8_t getHourPlan(const uint8_t hh) const { return((hh > 23) ? 0 : hourPlan[hh]); }
+  };
+
+// Pre-2017 implementation of computation of target temperature.
 // Templated with all the input instances for maximum speed and minimum code size.
+//
+// Stateless unless subscribed to the occupancy tracker with
+// occupancy.addStateListener(&thisInstance),
+// in which case the coarse occupancy state is taken from the notifications
+// rather than re-evaluated on each computation.
+// Only subscribe if the tracker's read() is run before the target is computed on each tick.
+//
+// If occPredictionOpt is supplied (and rebuilt hourly, eg by the stats updater)
+// then the smoothed by-hour occupancy lookups are answered from it
+// rather than by rescanning byHourStats on each computation.
+//
+// If setbackPlanOpt is supplied and has been built (and is rebuilt hourly)
+// then it replaces occPredictionOpt, setbackLockout
+// and the by-hour stats reads in WARM mode.
 template<
   class valveControlParameters,
   const ValveMode *const valveMode,
@@ -508,11 +634,84 @@ template<
   class SimpleValveScheduleBase,                const SimpleValveScheduleBase *const schedule,
   class NVByHourByteStatsBase,                  const NVByHourByteStatsBase *const byHourStats,
   class rh_t = OTV0P2BASE::HumiditySensorBase,  const rh_t *const relHumidityOpt = static_cast<const rh_t *>(NULL),
-  bool (*const setbackLockout)() = ((bool(*)())NULL)
+  bool (*const setbackLockout)() = ((bool(*)())NULL),
+  bool (*const preWarmDue)() = ((bool(*)())NULL),
+  const OTV0P2BASE::ByHourOccupancyPredictionCache *const occPredictionOpt = static_cast<const OTV0P2BASE::ByHourOccupancyPredictionCache *>(NULL),
+  const SetbackPlan *const setbackPlanOpt = static_cast<const SetbackPlan *>(NULL)
   >
-class ModelledRadValveComputeTargetTemp2016 final : public ModelledRadValveComputeTargetTempBase
+class ModelledRadValveComputeTargetTemp2016 final : public ModelledRadValveComputeTargetTempBase,
+                                                      public OTV0P2BASE::OccupancyStateListener
   {
+  private:
+    // True if a pre-warm predictor is supplied and says that heating should start now,
+    // earlier than the schedule's own fixed pre-warm.
+    static bool isPreWarmDue() { return((NULL != preWarmDue) && (preWarmDue)()); }
+
+    // Null-safe access to the optional inputs (see OTV0P2BASE::OptionalTag).
+    // The setback plan if supplied and built, else NULL.
+    static const SetbackPlan *plan(OTV0P2BASE::OptionalTag<false>) { return(NULL); }
+    static const SetbackPlan *plan(OTV0P2BASE::OptionalTag<true>) { return(setbackPlanOpt->isValid() ? setbackPlanOpt : NULL); }
+    static const SetbackPlan *plan() { return(plan(OTV0P2BASE::OptionalTag<(NULL != setbackPlanOpt)>())); }
+    // The occupancy prediction cache if supplied and built, else NULL.
+    static const OTV0P2BASE::ByHourOccupancyPredictionCache *occPrediction(OTV0P2BASE::OptionalTag<false>) { return(NULL); }
+    static const OTV0P2BASE::ByHourOccupancyPredictionCache *occPrediction(OTV0P2BASE::OptionalTag<true>)
+        { return(occPredictionOpt->isValid() ? occPredictionOpt : NULL); }
+    static const OTV0P2BASE::ByHourOccupancyPredictionCache *occPrediction()
+        { return(occPrediction(OTV0P2BASE::OptionalTag<(NULL != occPredictionOpt)>())); }
+    // True if relative humidity is available and high (with hysteresis).
+    static bool isRHHigh(OTV0P2BASE::OptionalTag<false>) { return(false); }
+    static bool isRHHigh(OTV0P2BASE::OptionalTag<true>) { return(relHumidityOpt->isAvailable() && relHumidityOpt->isRHHighWithHyst()); }
+    static bool isRHHigh() { return(isRHHigh(OTV0P2BASE::OptionalTag<(NULL != relHumidityOpt)>())); }
+
+    // Count of hours less occupied than the current hour, or the next if next is true,
+    // from the setback plan or else the prediction cache if supplied and built,
+    // else from the smoothed occupancy stats.
+    static uint8_t hoursLessOccupiedThan(const bool next)
+        {
+        const SetbackPlan *const sp = plan();
+        const OTV0P2BASE::ByHourOccupancyPredictionCache *const op = (NULL != sp) ? NULL : occPrediction();
+        if((NULL == sp) && (NULL == op))
+            {
+            return(byHourStats->countStatSamplesBelow(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED,
+                byHourStats->getByHourStatRTC(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED,
+                    next ? OTV0P2BASE::NVByHourByteStatsBase::SPECIAL_HOUR_NEXT_HOUR : OTV0P2BASE::NVByHourByteStatsBase::SPECIAL_HOUR_CURRENT_HOUR)));
+            }
+        const uint8_t hh = byHourStats->getHour();
+        // As for SPECIAL_HOUR_NEXT_HOUR.
+        const uint8_t h = !next ? hh : ((hh >= 23) ? 0 : uint8_t(hh + 1));
+        return((NULL != sp) ? sp->getHoursLessOccupiedThan(h) : op->getHoursLessOccupiedThan(h));
+        }
+
+    // True if smart setbacks are locked out.
+    static bool isSetbackLockedOut()
+        {
+        const SetbackPlan *const sp = plan();
+        return((NULL != sp) ? sp->isLockedOut() : ((NULL != setbackLockout) && (setbackLockout)()));
+        }
+    // True if the room was not occupied at all in this hour when last sampled.
+    static bool wasVacantLastThisHour()
+        {
+        const SetbackPlan *const sp = plan();
+        if(NULL != sp) { return(sp->wasVacantLast(byHourStats->getHour())); }
+        return(0 == byHourStats->getByHourStatRTC(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR, OTV0P2BASE::NVByHourByteStatsBase::SPECIAL_HOUR_CURRENT_HOUR));
+        }
+
+    // Coarse occupancy state from the last notification; OCC_STATE_UNKNOWN if not subscribed.
+    uint8_t occStateNotified = OTV0P2BASE::OCC_STATE_UNKNOWN;
+    bool subscribed() const { return(OTV0P2BASE::OCC_STATE_UNKNOWN != occStateNotified); }
+
+    // Occupancy views, notified if subscribed else polled.
+    bool isLongLongVacant() const
+        { return(subscribed() ? (OTV0P2BASE::OCC_STATE_LONG_LONG_VACANT == occStateNotified) : occupancy->longLongVacant()); }
+    bool isLongVacant() const
+        { return(subscribed() ? (OTV0P2BASE::OCC_STATE_LONG_VACANT <= occStateNotified) : occupancy->longVacant()); }
+    bool isLikelyOccupied() const
+        { return(subscribed() ? (OTV0P2BASE::OCC_STATE_OCCUPIED == occStateNotified) : occupancy->isLikelyOccupied()); }
+
   public:
+    // Note the new coarse occupancy state from the tracker.
+    virtual void occupancyStateChanged(const OTV0P2BASE::occState newState) override { occStateNotified = newState; }
+
     virtual uint8_t computeTargetTemp() const override
         {
         // In FROST mode.
@@ -530,7 +729,8 @@ class ModelledRadValveComputeTargetTemp2016 final : public ModelledRadValveCompu
           // this is assuming that the room temperature can be raised by ~1C/h.
           // See the effect of going from 2C to 1C setback: http://www.earth.org.uk/img/20160110-vat-b.png
           // (A very long pre-warm time may confuse or distress users, eg waking them in the morning.)
-          if(!occupancy->longVacant() && schedule->isAnyScheduleOnWARMSoon() && !physicalUI->recentUIControlUse())
+          // A predictor (eg WarmupRateEstimator) may start this earlier for a slow-to-warm room.
+          if(!isLongVacant() && (schedule->isAnyScheduleOnWARMSoon(OTV0P2BASE::getMinutesSinceMidnightLT()) || isPreWarmDue()) && !physicalUI->recentUIControlUse())
             {
             const uint8_t warmTarget = tempControl->getWARMTargetC();
             // Compute putative pre-warm temperature, usually only just below WARM target.
@@ -553,7 +753,7 @@ class ModelledRadValveComputeTargetTemp2016 final : public ModelledRadValveCompu
           const uint8_t wt = tempControl->getWARMTargetC();
 
           // If smart setbacks are locked out then return WARM temperature as-is.  (TODO-786, TODO-906)
-          if((NULL != setbackLockout) && (setbackLockout)())
+          if(isSetbackLockedOut())
             { return(wt); }
 
           // Set back target the temperature a little if the room seems to have been vacant for a long time (TODO-107)
@@ -571,9 +771,10 @@ class ModelledRadValveComputeTargetTemp2016 final : public ModelledRadValveCompu
           // Look ahead to next time period (as well as current) to determine notLikelyOccupiedSoon
           // but suppress lookahead of occupancy when its been dark for many hours (eg overnight) to avoid disturbing/waking.  (TODO-792)
           // Note that deeper setbacks likely offer more savings than faster (but shallower) setbacks.
-          const bool longLongVacant = occupancy->longLongVacant();
-          const bool longVacant = longLongVacant || occupancy->longVacant();
-          const bool likelyVacantNow = longVacant || occupancy->isLikelyUnoccupied();
+          const bool longLongVacant = isLongLongVacant();
+          const bool longVacant = longLongVacant || isLongVacant();
+          const bool likelyOccupied = isLikelyOccupied();
+          const bool likelyVacantNow = longVacant || !likelyOccupied;
           const bool ecoBias = tempControl->hasEcoBias();
           // True if the room has been dark long enough to indicate night. (TODO-792)
           const bool isDark = ambLight->isRoomDark();
@@ -582,8 +783,11 @@ class ModelledRadValveComputeTargetTemp2016 final : public ModelledRadValveCompu
           // Be more ready to decide room not likely occupied soon if eco-biased.
           // Note that this value is likely to be used +/- 1 so must be in range [1,23].
           const uint8_t thisHourNLOThreshold = ecoBias ? 15 : 12;
-          const uint8_t hoursLessOccupiedThanThis = byHourStats->countStatSamplesBelow(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED, byHourStats->getByHourStatRTC(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED, OTV0P2BASE::NVByHourByteStatsBase::SPECIAL_HOUR_CURRENT_HOUR));
-          const uint8_t hoursLessOccupiedThanNext = byHourStats->countStatSamplesBelow(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED, byHourStats->getByHourStatRTC(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED, OTV0P2BASE::NVByHourByteStatsBase::SPECIAL_HOUR_NEXT_HOUR));
+          // When occupied now (and not long vacant) the default setback applies
+          // whatever the stats say, so skip the stats scans.
+          const bool statsNeeded = likelyVacantNow;
+          const uint8_t hoursLessOccupiedThanThis = !statsNeeded ? 0 : hoursLessOccupiedThan(false);
+          const uint8_t hoursLessOccupiedThanNext = !statsNeeded ? 0 : hoursLessOccupiedThan(true);
           const bool notLikelyOccupiedSoon = longLongVacant ||
               (likelyVacantNow &&
               // No more than about half the hours to be less occupied than this hour to be considered unlikely to be occupied.
@@ -593,8 +797,8 @@ class ModelledRadValveComputeTargetTemp2016 final : public ModelledRadValveCompu
               (darkForHours || (hoursLessOccupiedThanNext < (thisHourNLOThreshold+1))));
           const uint8_t minLightsOffForSetbackMins = ecoBias ? 10 : 20;
           if(longVacant ||
-             ((notLikelyOccupiedSoon || (dm > minLightsOffForSetbackMins) || (ecoBias && (occupancy->getVacancyH() > 0) && (0 == byHourStats->getByHourStatRTC(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR, OTV0P2BASE::NVByHourByteStatsBase::SPECIAL_HOUR_CURRENT_HOUR)))) &&
-                 !schedule->isAnyScheduleOnWARMNow() && !physicalUI->recentUIControlUse()))
+             ((notLikelyOccupiedSoon || (dm > minLightsOffForSetbackMins) || (ecoBias && (occupancy->getVacancyH() > 0) && wasVacantLastThisHour())) &&
+                 !schedule->isAnyScheduleOnWARMNow(OTV0P2BASE::getMinutesSinceMidnightLT()) && !physicalUI->recentUIControlUse()))
             {
             // Restrict to a DEFAULT/minimal non-annoying setback if:
             //   in upper part of comfort range (and the room isn't very dark, eg in the dead of night TODO-1027)
@@ -620,11 +824,11 @@ class ModelledRadValveComputeTargetTemp2016 final : public ModelledRadValveCompu
             constexpr uint8_t minVacantAndDarkForFULLSetbackH = 2; // Hours; strictly positive, typically 1--4.
             const bool comfortTemperature = tempControl->isComfortTemperature(wt);
             const uint8_t setback = ((comfortTemperature && !ambLight->isRoomVeryDark()) ||
-                                     occupancy->isLikelyOccupied() ||
-                                     (!longVacant && !isDark && !tempControl->isEcoTemperature(wt) && (NULL != relHumidityOpt) && relHumidityOpt->isAvailable() && relHumidityOpt->isRHHighWithHyst()) ||
+                                     likelyOccupied ||
+                                     (!longVacant && !isDark && !tempControl->isEcoTemperature(wt) && isRHHigh()) ||
                                      (!longVacant && !isDark && (hoursLessOccupiedThanThis > 4)) ||
                                      (!longVacant && !isDark && !darkForHours && (hoursLessOccupiedThanNext >= thisHourNLOThreshold-1)) ||
-                                     (!longVacant && schedule->isAnyScheduleOnWARMSoon())) ?
+                                     (!longVacant && (schedule->isAnyScheduleOnWARMSoon(OTV0P2BASE::getMinutesSinceMidnightLT()) || isPreWarmDue()))) ?
                     valveControlParameters::SETBACK_DEFAULT :
                 ((!comfortTemperature && (longLongVacant ||
                     (notLikelyOccupiedSoon && (tempControl->isEcoTemperature(wt) ||
@@ -660,7 +864,7 @@ class ModelledRadValveComputeTargetTemp2016 final : public ModelledRadValveCompu
         // or there is a very recent (and reasonably strong) occupancy signal such as lights on (TODO-1069).
         // This may provide enough feedback to have the user resist adjusting things prematurely!
         const bool fastResponseRequired =
-            physicalUI->veryRecentUIControlUse() || (occupancy->reportedRecently() && occupancy->isLikelyOccupied());
+            physicalUI->veryRecentUIControlUse() || (occupancy->reportedNewOccupancyRecently() && occupancy->isLikelyOccupied());
         inputState.fastResponseRequired = fastResponseRequired;
         // Widen the allowed deadband significantly in a dark room (TODO-383, TODO-1037)
         // (or if temperature is jittery eg changing fast and filtering has been engaged,
@@ -717,10 +921,32 @@ class ModelledRadValvePlugglableState final : public AbstractRadValve
     // Usually 100, but special circumstances may require otherwise.
     const uint8_t maxPCOpen = 100;
 
+    // Input state and valve position as of the last full tick of retainedState.
+    struct ModelledRadValveInputState lastTickInputState;
+    uint8_t lastTickValvePC = 0;
+    // Consecutive minutes for which the full tick has been skipped as steady.
+    uint8_t steadySkipM = 0;
+    // If true then skip the full tick when in a steady state.
+    bool steadySkipEnabled = true;
+    // Minutes of humidity boost remaining; zero if none.
+    uint8_t humidityBoostM = 0;
+
+    // True if the full tick can be skipped this minute since it would change nothing.
+    // Any change of input (temperature, target, mode, occupancy, etc)
+    // or of the physical valve position forces a full tick immediately.
+    bool canSkipTick() const
+    {
+        if(!steadySkipEnabled || (steadySkipM >= MAX_STEADY_SKIP_M)) { return(false); }
+        if((value != lastTickValvePC) || (inputState != lastTickInputState)) { return(false); }
+        if((NULL != physicalDeviceOpt) && (physicalDeviceOpt->get() != retainedState.prevValvePC)) { return(false); }
+        return(retainedState.isSteady(inputState));
+    }
+
     // Compute target temperature and set heat demand for TRV and boiler; update state.
     // CALL REGULARLY APPROXIMATELY ONCE PER MINUTE TO ALLOW SIMPLE TIME-BASED CONTROLS.
     //
-    // This routine may take significant CPU time.
+    // This routine may take significant CPU time,
+    // though much less when the room is in a steady state.
     //
     // Internal state is updated, and the target updated on any attached physical valve.
     //
@@ -728,13 +954,19 @@ class ModelledRadValvePlugglableState final : public AbstractRadValve
     void computeCallForHeat()
     {
         valveModeRW->read();
+        if(0 != humidityBoostM) { --humidityBoostM; }
         // Compute target temperature,
         // ensure that input state is set for computeRequiredTRVPercentOpen().
         computeTargetTemperature();
+        // Skip the rest if it would leave everything as it is.
+        if(canSkipTick()) { ++steadySkipM; return; }
+        steadySkipM = 0;
         // Invoke computeRequiredTRVPercentOpen()
         // and convey new target to the backing valve if any,
         // while tracking any cumulative movement.
         retainedState.tick(value, inputState, physicalDeviceOpt);
+        lastTickInputState = inputState;
+        lastTickValvePC = value;
     }
 
 
@@ -745,6 +977,10 @@ class ModelledRadValvePlugglableState final : public AbstractRadValve
     AbstractRadValve *const physicalDeviceOpt;
 
   public:
+    // Maximum consecutive minutes to skip the full tick in a steady state;
+    // a full tick is done at least this often regardless.
+    static constexpr uint8_t MAX_STEADY_SKIP_M = 15;
+
     // Create an instance.
     ModelledRadValvePlugglableState(
         const ModelledRadValveComputeTargetTempBase *const _ctt,
@@ -837,6 +1073,26 @@ class ModelledRadValvePlugglableState final : public AbstractRadValve
     // Returns true if this valve control is in glacial mode.
     bool inGlacialMode() const { return(glacial); }
 
+    // Minutes for which a humidity boost lasts.
+    static constexpr uint8_t HUMIDITY_BOOST_M = 15;
+
+    // Hint that relative humidity is rising rapidly, eg from a shower or cooking,
+    // so the room is in use now: for the next HUMIDITY_BOOST_M minutes
+    // any setback in WARM mode is removed and a fast valve response is requested.
+    // The target is recomputed at once, and used by the next read().
+    // Suitable for HumiditySensorBase::setRapidRiseCallback(); not ISR-safe.
+    void humidityBoost() { humidityBoostM = HUMIDITY_BOOST_M; computeTargetTemperature(); }
+
+    // True while a humidity boost is in effect.
+    bool isHumidityBoosted() const { return(0 != humidityBoostM); }
+
+    // Enable/disable skipping the full per-minute computation in a steady state (default true/on).
+    // The results are the same either way; skipping saves CPU time and thus energy.
+    void setSteadyStateSkipping(const bool on) { steadySkipEnabled = on; if(!on) { steadySkipM = 0; } }
+
+    // True if the last read() found a steady state and skipped the full computation.
+    bool isSteadyState() const { return(0 != steadySkipM); }
+
     // True if the computed valve position was changed by read().
     // Can be used to trigger rebuild of messages, force updates to actuators, etc.
     bool isValveMoved() const { return(retainedState.valveMoved); }
@@ -949,22 +1205,27 @@ class ModelledRadValvePlugglableState final : public AbstractRadValve
     void computeTargetTemperature()
     {
         // Compute basic target temperature statelessly.
-        const uint8_t newTargetTemp = ctt->computeTargetTemp();
+        const uint8_t computedTargetTemp = ctt->computeTargetTemp();
+        // WARM target, read at most once here and only if in WARM mode.
+        const bool inWarmMode = valveModeRW->inWarmMode();
+        const uint8_t wt = inWarmMode ? tempControl->getWARMTargetC() : 0;
+        // Lift any WARM-mode setback during a humidity boost.
+        const bool boosted = (0 != humidityBoostM) && inWarmMode && !valveModeRW->inBakeMode();
+        const uint8_t newTargetTemp = boosted ?
+            OTV0P2BASE::fnmax(computedTargetTemp, wt) : computedTargetTemp;
 
         // Set up state for computeRequiredTRVPercentOpen().
         ctt->setupInputState(inputState,
             retainedState.isFiltering,
             newTargetTemp, getMinPercentOpen(), getMaxPercentageOpenAllowed(), glacial);
+        // Respond quickly during a humidity boost.
+        if(boosted) { inputState.fastResponseRequired = true; inputState.widenDeadband = false; }
 
         // Explicitly compute the actual setback when in WARM mode for monitoring purposes.
         // TODO: also consider showing full setback to FROST when a schedule is set but not on.
         // By default, the setback is regarded as zero/off.
         setbackC = 0;
-        if(valveModeRW->inWarmMode())
-            {
-            const uint8_t wt = tempControl->getWARMTargetC();
-            if(newTargetTemp < wt) { setbackC = wt - newTargetTemp; }
-            }
+        if(inWarmMode && (newTargetTemp < wt)) { setbackC = wt - newTargetTemp; }
 
         // True if the target temperature has been reached or exceeded.
         const bool targetReached = (newTargetTemp <= (inputState.refTempC16 >> 4));
@@ -0,0 +1,234 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Several radiator valves in one room driven from one board.
+ *
+ * One shared target computation and input state
+ * (temperature, occupancy, schedule, etc)
+ * feeds one ModelledRadValveState per valve,
+ * each with its own calibration and physical motor driver.
+ *
+ * Portable.
+ */
+
+#ifndef ARDUINO_LIB_OTRADVALVE_MODELLEDRADVALVEMULTI_H
+#define ARDUINO_LIB_OTRADVALVE_MODELLEDRADVALVEMULTI_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <OTV0p2Base.h>
+#include "OTRadValve_ModelledRadValve.h"
+
+namespace OTRadValve
+    {
+
+// Multi-actuator counterpart of ModelledRadValvePlugglableState.
+// The target temperature and input state are computed once per read()
+// and every valve's model is ticked from them,
+// with its own maximum % open and glacial setting applied.
+//
+// The logical value (get()) is that of the most open valve,
+// and this calls for heat only when under target
+// with all valves really open.
+//
+// To limit peak current, pollMotors() should be called
+// in place of each physical valve's own frequent poll/read():
+// it polls one physical valve per call in turn,
+// so no two motors are run from the same call.
+// Call it nValves times as often as a single valve would be polled.
+//
+// Humidity boost and steady-state skipping
+// are only offered by the single-valve class.
+//
+// Not thread-/ISR- safe except as noted.
+template<uint8_t nValves, class ModelledRadValveState_t = ModelledRadValveState<>>
+class ModelledRadValveMulti final : public AbstractRadValve
+  {
+  static_assert(nValves > 0, "must drive at least one valve");
+
+  public:
+    // Per-valve calibration.
+    struct Calibration final
+      {
+      // Maximum percentage open allowed for this valve [1,100],
+      // eg to balance an over-sized radiator.
+      uint8_t maxPCOpen = 100;
+      // True to force glacial mode for this valve only.
+      bool glacial = false;
+      };
+
+  private:
+    // Target temperature computation; never NULL.
+    const ModelledRadValveComputeTargetTempBase *const ctt;
+    // Read/write access to valve mode; never NULL.
+    ValveMode *const valveModeRW;
+    // Read-only access to temperature control; never NULL.
+    const TempControlBase *const tempControl;
+
+    // Input state shared by all valves.
+    struct ModelledRadValveInputState inputState;
+
+    // Per-valve model, logical position, calibration and device (NULL if none).
+    ModelledRadValveState_t retainedState[nValves];
+    volatile uint8_t valvePC[nValves] = { };
+    Calibration calibration[nValves];
+    AbstractRadValve *physicalDeviceOpt[nValves] = { };
+
+    // Next valve for pollMotors().
+    uint8_t nextMotor = 0;
+
+    // Marked volatile for thread-safe lock-free access.
+    volatile bool callingForHeat = false;
+    volatile bool underTarget = false;
+
+    // The current automated setback in C; non-negative.
+    uint8_t setbackC = 0;
+
+  public:
+    // Create an instance; attach valves with setValve().
+    ModelledRadValveMulti(
+        const ModelledRadValveComputeTargetTempBase *const _ctt,
+        ValveMode *const _valveMode,
+        const TempControlBase *const _tempControl)
+      : ctt(_ctt), valveModeRW(_valveMode), tempControl(_tempControl)
+      { }
+
+    // Attach the physical device (NULL for none) and calibration for valve i.
+    // Ignored if i is out of range.
+    void setValve(const uint8_t i, AbstractRadValve *const device, const Calibration &cal = Calibration())
+      {
+      if(i >= nValves) { return; }
+      physicalDeviceOpt[i] = device;
+      calibration[i] = cal;
+      if(calibration[i].maxPCOpen > 100) { calibration[i].maxPCOpen = 100; }
+      }
+
+    // Number of valves driven.
+    static constexpr uint8_t getValveCount() { return(nValves); }
+
+    // Recompute the target and each valve's position, and set physical devices.
+    // Call at a fixed rate (1/60s).
+    // Will clear any BAKE mode if the target temperature is already exceeded.
+    virtual uint8_t read() override
+      {
+      valveModeRW->read();
+      const uint8_t newTargetTemp = ctt->computeTargetTemp();
+      // All valves see the same temperatures, so filter together.
+      bool isFiltering = false;
+      for(uint8_t i = 0; i < nValves; ++i) { if(retainedState[i].isFiltering) { isFiltering = true; } }
+      ctt->setupInputState(inputState, isFiltering, newTargetTemp, getMinPercentOpen(), 100, false);
+
+      setbackC = 0;
+      if(valveModeRW->inWarmMode())
+        {
+        const uint8_t wt = tempControl->getWARMTargetC();
+        if(newTargetTemp < wt) { setbackC = wt - newTargetTemp; }
+        }
+
+      uint8_t maxPC = 0;
+      for(uint8_t i = 0; i < nValves; ++i)
+        {
+        ModelledRadValveInputState vis = inputState;
+        const Calibration &c = calibration[i];
+        vis.maxPCOpen = OTV0P2BASE::fnmin(vis.maxPCOpen, c.maxPCOpen);
+        vis.glacial = vis.glacial || c.glacial || (c.maxPCOpen < DEFAULT_VALVE_PC_SAFER_OPEN);
+        retainedState[i].tick(valvePC[i], vis, physicalDeviceOpt[i]);
+        maxPC = OTV0P2BASE::fnmax(maxPC, (uint8_t)valvePC[i]);
+        }
+      value = maxPC;
+
+      const bool targetReached = (newTargetTemp <= (inputState.refTempC16 >> 4));
+      underTarget = !targetReached;
+      if(targetReached) { valveModeRW->cancelBakeDebounced(); }
+      callingForHeat = !targetReached &&
+          (value >= DEFAULT_VALVE_PC_SAFER_OPEN) &&
+          isControlledValveReallyOpen();
+      return(value);
+      }
+
+    // Returns preferred poll interval (in seconds); non-zero.
+    virtual uint8_t preferredPollInterval_s() const override { return(60); }
+
+    // Poll the next physical valve (if any) in turn; see class notes.
+    void pollMotors()
+      {
+      AbstractRadValve *const d = physicalDeviceOpt[nextMotor];
+      if(NULL != d) { d->read(); }
+      if(++nextMotor >= nValves) { nextMotor = 0; }
+      }
+
+    // True if all physical valves are in their normal run state.
+    virtual bool isInNormalRunState() const override
+      {
+      for(uint8_t i = 0; i < nValves; ++i)
+        { if((NULL != physicalDeviceOpt[i]) && !physicalDeviceOpt[i]->isInNormalRunState()) { return(false); } }
+      return(true);
+      }
+
+    // True if any physical valve is in an error state.
+    virtual bool isInErrorState() const override
+      {
+      for(uint8_t i = 0; i < nValves; ++i)
+        { if((NULL != physicalDeviceOpt[i]) && physicalDeviceOpt[i]->isInErrorState()) { return(true); } }
+      return(false);
+      }
+
+    // True only if all the valves are really open.
+    virtual bool isControlledValveReallyOpen() const override
+      {
+      const uint8_t minPC = getMinPercentOpen();
+      for(uint8_t i = 0; i < nValves; ++i)
+        {
+        if(valvePC[i] < minPC) { return(false); }
+        if((NULL != physicalDeviceOpt[i]) && !physicalDeviceOpt[i]->isControlledValveReallyOpen()) { return(false); }
+        }
+      return(true);
+      }
+
+    // Get estimated minimum percentage open for significant flow [1,99].
+    virtual uint8_t getMinPercentOpen() const override { return(DEFAULT_VALVE_PC_MIN_REALLY_OPEN); }
+
+    // Thread-safe and ISR safe.
+    virtual bool isCallingForHeat() const override { return(callingForHeat); }
+    virtual bool isUnderTarget() const override { return(underTarget); }
+
+    // Pass through a wiggle request to all the physical valves.
+    virtual void wiggle() const override
+      { for(uint8_t i = 0; i < nValves; ++i) { if(NULL != physicalDeviceOpt[i]) { physicalDeviceOpt[i]->wiggle(); } } }
+
+    // Get the target temperature in C as computed by read().
+    uint8_t getTargetTempC() const { return(inputState.targetTempC); }
+    // Get the current automated setback (if any) in C; non-negative.
+    uint8_t getSetbackC() const { return(setbackC); }
+
+    // Logical % open of valve i; 0 if i is out of range.
+    uint8_t getValvePC(const uint8_t i) const { return((i < nValves) ? valvePC[i] : 0); }
+    // True if valve i moved on the last read().
+    bool isValveMoved(const uint8_t i) const { return((i < nValves) && retainedState[i].valveMoved); }
+    // Cumulative movement % of valve i; rolls at 1024.
+    uint16_t getCumulativeMovementPC(const uint8_t i) const { return((i < nValves) ? retainedState[i].cumulativeMovementPC : 0); }
+
+    // Read-only access to retained state of valve i for testing purposes only; i must be in range.
+    // NOT PART OF OFFICIAL API and so may go away without notice.
+    const ModelledRadValveState_t &_getRetainedState(const uint8_t i) const { return(retainedState[i]); }
+  };
+
+    }
+
+#endif
@@ -6,6 +6,9 @@
 namespace OTRadValve
 {
 
+// Storage for the PI gain schedule.
+constexpr ModelledRadValvePIController::Gains_t ModelledRadValvePIController::GAIN_SCHEDULE[];
+
 
 //  // Proportional implementation, circa 2013--2016.
 //
@@ -117,11 +117,113 @@ struct ModelledRadValveInputState final
     // (refTempC16>>4) == targetTempC.
     // This is signed and at least 16 bits.
     int_fast16_t refTempC16;
+
+    // True if all inputs are the same, eg to detect a steady state.
+    bool operator==(const ModelledRadValveInputState &o) const
+        {
+        return((targetTempC == o.targetTempC) && (maxTargetTempC == o.maxTargetTempC) &&
+               (maxPCOpen == o.maxPCOpen) && (widenDeadband == o.widenDeadband) &&
+               (glacial == o.glacial) && (hasEcoBias == o.hasEcoBias) &&
+               (inBakeMode == o.inBakeMode) && (fastResponseRequired == o.fastResponseRequired) &&
+               (refTempC16 == o.refTempC16));
+        }
+    bool operator!=(const ModelledRadValveInputState &o) const { return(!(*this == o)); }
 };
 
 // Nominal base for ModelledRadValveState.
 struct ModelledRadValveStateBase { };
 
+// Fixed-point incremental (velocity-form) PI valve controller.
+// Used by ModelledRadValveState when PI_CONTROL is selected,
+// inside the band where the rule-based algorithm would be proportional.
+// Integer-only to suit 8-bit MCUs.
+//
+// Each step moves the output by
+//     -Kp * (change in temperature) + Ki * (error)
+// so the proportional term acts on the measurement only,
+// avoiding a kick when the target changes (eg at the end of a setback).
+// The output is held as valve % * 256 and clamped to [0,maxPCOpen];
+// as only the (clamped) output is accumulated
+// there is no separate integral to wind up when saturated.
+// Output changes smaller than minStepPC are held back
+// (except on reaching an end stop) to limit motor movements.
+struct ModelledRadValvePIController final
+{
+    // Gains for one error band, in (valve % / 256) per C16 (per minute for Ki).
+    struct Gains_t final { uint8_t kpQ8; uint8_t kiQ8; };
+    // Number of bands in the gain schedule, each 1 << bandShift in C16 (0.5C) wide.
+    static constexpr uint8_t bands = 4;
+    static constexpr uint8_t bandShift = 3;
+    // Gains by |error| band, growing further from the target
+    // to recover quickly without seeking around the sweet-spot.
+    static constexpr Gains_t GAIN_SCHEDULE[bands] =
+        { { 64, 2 }, { 96, 4 }, { 128, 6 }, { 160, 8 } };
+    // Minimum valve movement (%) except to an end stop.
+    static constexpr uint8_t minStepPC = 3;
+    // Maximum output change per step (valve % * 256) when glacial: 1%/min.
+    static constexpr int16_t glacialStepQ8 = 256;
+
+    // Output, valve % * 256.
+    uint16_t outQ8 = 0;
+    // Temperature (C16) used at the previous step.
+    int16_t prevTempC16 = 0;
+    // Valve position returned by the previous step.
+    uint8_t lastPC = 0;
+    // True once the fields above hold real values.
+    bool started = false;
+
+    // Forget history, eg while other logic sets the valve;
+    // the next step() starts afresh from the valve position and temperature it is given.
+    void reset() { started = false; }
+
+    // Reset for bumpless transfer from a valve position set by other logic.
+    void track(const uint8_t valvePCOpen, const int_fast16_t tempC16)
+        {
+        outQ8 = uint16_t(valvePCOpen) << 8;
+        prevTempC16 = int16_t(tempC16);
+        lastPC = valvePCOpen;
+        started = true;
+        }
+
+    // Compute the new valve position.
+    //   * valvePCOpen  current valve position [0,maxPCOpen]
+    //   * tempC16  (possibly smoothed) temperature
+    //   * errorC16  amount below target (C16); -ve when above
+    //   * maxPCOpen  maximum valve position
+    //   * gentle  if true, halve the gains, eg when filtering or with a wide deadband
+    //   * glacial  if true, limit the rate of change to glacialStepQ8 per step
+    uint8_t step(const uint8_t valvePCOpen, const int_fast16_t tempC16,
+                 const int_fast16_t errorC16, const uint8_t maxPCOpen,
+                 const bool gentle, const bool glacial)
+        {
+        // Follow any movement made by other logic.
+        if(!started || (lastPC != valvePCOpen)) { track(valvePCOpen, tempC16); }
+        const uint8_t band = uint8_t(OTV0P2BASE::fnmin(
+            OTV0P2BASE::fnabs(errorC16) >> bandShift, int_fast16_t(bands - 1)));
+        const uint8_t shift = gentle ? 1 : 0;
+        const int_fast32_t kp = GAIN_SCHEDULE[band].kpQ8 >> shift;
+        const int_fast32_t ki = GAIN_SCHEDULE[band].kiQ8 >> shift;
+        int_fast32_t d = (ki * errorC16) - (kp * (tempC16 - prevTempC16));
+        prevTempC16 = int16_t(tempC16);
+        if(glacial) { d = OTV0P2BASE::fnconstrain(d, int_fast32_t(-glacialStepQ8), int_fast32_t(glacialStepQ8)); }
+        outQ8 = uint16_t(OTV0P2BASE::fnconstrain(int_fast32_t(outQ8) + d,
+            int_fast32_t(0), int_fast32_t(maxPCOpen) << 8));
+        const uint8_t want = uint8_t((outQ8 + 128) >> 8);
+        if((0 == want) || (want >= maxPCOpen) ||
+           (OTV0P2BASE::fnabsdiff(want, valvePCOpen) >= minStepPC))
+            { lastPC = want; }
+        return(lastPC);
+        }
+};
+
+// Stand-in for ModelledRadValvePIController when PI control is not selected.
+struct ModelledRadValvePIControllerNULL final
+{
+    void reset() { }
+    uint8_t step(const uint8_t valvePCOpen, int_fast16_t, int_fast16_t, uint8_t, bool, bool)
+        { return(valvePCOpen); }
+};
+
 // All retained state for computing valve movement, eg time-based state.
 // Exposed to allow easier unit testing.
 // All initial values set by the constructor are sane.
@@ -133,9 +235,13 @@ struct ModelledRadValveStateBase { };
 // Template parameters:
 //     MINIMAL_BINARY_IMPL  if true, then minimal/binary valve impl
 //     AGGRESSIVE_ON  if true, then very aggressive open always to full
-template <bool MINIMAL_BINARY_IMPL = false, bool AGGRESSIVE_ON = false>
+//     PI_CONTROL  if true, then use ModelledRadValvePIController
+//         in place of the rule-based proportional response
+template <bool MINIMAL_BINARY_IMPL = false, bool AGGRESSIVE_ON = false, bool PI_CONTROL = false>
 struct ModelledRadValveState final : public ModelledRadValveStateBase
 {
+    static_assert(!(PI_CONTROL && MINIMAL_BINARY_IMPL), "PI control needs proportional support");
+
     // FEATURE SUPPORT
     // If true then support proportional response in target 1C range.
     static constexpr bool SUPPORT_PROPORTIONAL = !MINIMAL_BINARY_IMPL;
@@ -165,6 +271,9 @@ struct ModelledRadValveState final : public ModelledRadValveStateBase
     // implies a delta T >= 60/16C ~ 4C per hour.
     static constexpr uint8_t _proportionalRange = 7;
 
+    // Offset (C16) of the centre of the sweet-spot above the target whole degree.
+    static constexpr int8_t centreOffsetC16 = 12;
+
     // Max jump between adjacent readings before forcing filtering; strictly +ve.
     // Too small a value may cap room rate rise to this per minute.
     // Too large a value may fail to damp oscillations/overshoot.
@@ -239,8 +348,7 @@ struct ModelledRadValveState final : public ModelledRadValveStateBase
         }
 
         // Shift in the latest (raw) temperature.
-        for(int_fast8_t i = filterLength; --i > 0; ) { prevRawTempC16[i] = prevRawTempC16[i-1]; }
-        prevRawTempC16[0] = rawTempC16;
+        pushPrevRawTempC16(rawTempC16);
 
         // Disable/enable filtering.
         static constexpr uint8_t filter_minimum_ON =
@@ -282,8 +390,8 @@ struct ModelledRadValveState final : public ModelledRadValveStateBase
             // Slow/expensive test if temperature readings are jittery.
             // It is not clear how often this will be the case
             // with good sensors.
-            for(size_t i = 1; i < filterLength; ++i)
-              { if(OTV0P2BASE::fnabsdiff(prevRawTempC16[i], prevRawTempC16[i-1]) > MAX_TEMP_JUMP_C16) { isFiltering = filter_minimum_ON; break; } }
+            // The count is maintained as samples are shifted in.
+            if(0 != prevRawTempJumps) { isFiltering = filter_minimum_ON; }
         }
 
         // Count down timers.
@@ -294,7 +402,8 @@ struct ModelledRadValveState final : public ModelledRadValveStateBase
         // passed by reference.
         const uint8_t oldValvePC = prevValvePC;
         const uint8_t oldModelledValvePC = valvePCOpenRef;
-        const uint8_t newModelledValvePC =
+        const uint8_t newModelledValvePC = PI_CONTROL ?
+          computePITRVPercentOpen(valvePCOpenRef, inputState) :
           computeRequiredTRVPercentOpen(valvePCOpenRef, inputState);
         const bool modelledValveChanged =
             (newModelledValvePC != oldModelledValvePC);
@@ -451,35 +560,94 @@ public:
     // Previous valve position (%), used to compute cumulativeMovementPC.
     uint8_t prevValvePC = 0;
 
+    // PI controller state; empty unless PI_CONTROL.
+    template<bool Condition, typename TypeTrue, typename TypeFalse>
+      struct typeIf;
+    template<typename TypeTrue, typename TypeFalse>
+      struct typeIf<true, TypeTrue, TypeFalse> { typedef TypeTrue t; };
+    template<typename TypeTrue, typename TypeFalse>
+      struct typeIf<false, TypeTrue, TypeFalse> { typedef TypeFalse t; };
+    typename typeIf<PI_CONTROL, ModelledRadValvePIController, ModelledRadValvePIControllerNULL>::t pi;
+
     // Length of filter memory in ticks; strictly positive.
     // Must be at least 4, and may be more efficient at a power of 2.
     static constexpr size_t filterLength = 16;
 
-    // Previous unadjusted temperatures, 0 being the newest.
-    // Later (higher-index) entries successively older.
+    // If true, detect jitter between adjacent samples to turn filter on.
+    // Whether or not true, other detection mechanisms may be used.
+    static constexpr bool FILTER_DETECT_JITTER = false;
+
+private:
+    // Previous unadjusted temperatures, as a ring buffer.
+    // The newest is at prevRawTempHead, and successively older ones follow
+    // (wrapping), so shifting in a new sample is O(1) rather than O(filterLength).
     // These values have any target bias removed.
     // Half the filter size times the tick() interval
     // gives an approximate time constant.
     // Note that full response time of a typical mechanical wax-based
     // TRV is ~20mins.
     int_fast16_t prevRawTempC16[filterLength];
+    // Physical index in prevRawTempC16 of the newest sample; [0,filterLength-1].
+    uint8_t prevRawTempHead = 0;
+    // Running sum of all of prevRawTempC16 for getSmoothedRecent().
+    // Assume values and sum will be nowhere near the limits.
+    int_fast16_t prevRawTempSum = 0;
+    // Number of adjacent samples in prevRawTempC16 differing by more than MAX_TEMP_JUMP_C16.
+    // Only maintained if FILTER_DETECT_JITTER.
+    uint8_t prevRawTempJumps = 0;
+
+    // Physical index in prevRawTempC16 of the sample n ticks ago; n in [0,filterLength-1].
+    static uint8_t prevRawTempIndex(const uint8_t head, const uint8_t n)
+        { return((uint8_t)((head + n) % filterLength)); }
+    // True if the adjacent samples a and b are a jitter jump.
+    static bool isJump(const int_fast16_t a, const int_fast16_t b)
+        { return(OTV0P2BASE::fnabsdiff(a, b) > MAX_TEMP_JUMP_C16); }
+
+    // Shift in a new sample, overwriting the oldest, and update the running sum/count.
+    void pushPrevRawTempC16(const int_fast16_t rawTempC16)
+        {
+        const uint8_t oldest = prevRawTempIndex(prevRawTempHead, filterLength - 1);
+        if(FILTER_DETECT_JITTER)
+            {
+            // The pair of the two oldest samples is lost and a new newest pair made.
+            if(isJump(prevRawTempC16[oldest], prevRawTempC16[prevRawTempIndex(prevRawTempHead, filterLength - 2)])) { --prevRawTempJumps; }
+            if(isJump(rawTempC16, prevRawTempC16[prevRawTempHead])) { ++prevRawTempJumps; }
+            }
+        prevRawTempSum += rawTempC16 - prevRawTempC16[oldest];
+        prevRawTempC16[oldest] = rawTempC16;
+        prevRawTempHead = oldest;
+        }
 
-    // If true, detect jitter between adjacent samples to turn filter on.
-    // Whether or not true, other detection mechanisms may be used.
-    static constexpr bool FILTER_DETECT_JITTER = false;
+    // Recompute the running sum and jump count from scratch.
+    void recomputePrevRawTempStats()
+        {
+        prevRawTempSum = 0;
+        prevRawTempJumps = 0;
+        for(uint8_t i = 0; i < filterLength; ++i)
+            {
+            prevRawTempSum += prevRawTempC16[i];
+            if(FILTER_DETECT_JITTER && (i > 0) && isJump(getPrevRawTempC16(i), getPrevRawTempC16(i-1))) { ++prevRawTempJumps; }
+            }
+        }
+
+public:
+    // Get the unadjusted temperature from n ticks ago, 0 being the newest; n in [0,filterLength-1].
+    int_fast16_t getPrevRawTempC16(const uint8_t n) const
+        { return(prevRawTempC16[prevRawTempIndex(prevRawTempHead, n)]); }
 
     // Get smoothed raw/unadjusted temperature from the most recent samples.
+    // Rounded as smallIntMean() would be.
     int_fast16_t getSmoothedRecent() const
-        { return(smallIntMean<filterLength>(prevRawTempC16)); }
+        { return((prevRawTempSum + (int_fast16_t)(filterLength/2)) / (int_fast16_t)filterLength); }
 
     // Get last change in temperature (C*16, signed); +ve means rising.
-    int_fast16_t getRawDelta() const { return(prevRawTempC16[0] - prevRawTempC16[1]); }
+    int_fast16_t getRawDelta() const { return(getPrevRawTempC16(0) - getPrevRawTempC16(1)); }
 
     // Get last change in temperature (C*16, signed) from n ticks ago capped to filter length; +ve means rising.
-    int_fast16_t getRawDelta(uint8_t n) const { return(prevRawTempC16[0] - prevRawTempC16[OTV0P2BASE::fnmin((size_t)n, filterLength-1)]); }
+    int_fast16_t getRawDelta(uint8_t n) const { return(getPrevRawTempC16(0) - getPrevRawTempC16((uint8_t)OTV0P2BASE::fnmin((size_t)n, filterLength-1))); }
 
     // Get previous change in temperature (C*16, signed); +ve means was rising.
-    int_fast16_t getPrevRawDelta() const { return(prevRawTempC16[1] - prevRawTempC16[2]); }
+    int_fast16_t getPrevRawDelta() const { return(getPrevRawTempC16(1) - getPrevRawTempC16(2)); }
 
     //  // Compute an estimate of rate/velocity of temperature change in C/16 per minute/tick.
     //  // A positive value indicates that temperature is rising.
@@ -556,10 +724,53 @@ public:
 //
 uint8_t computeRequiredTRVPercentOpen(uint8_t valvePCOpen,
         const ModelledRadValveInputState &inputState) const
+    { return(computeRequiredTRVPercentOpen(*this, valvePCOpen, inputState)); }
+
+// Compute the new valve position with PI control (if PI_CONTROL).
+// Outside the proportional band, and in BAKE mode,
+// this defers to computeRequiredTRVPercentOpen()
+// and the PI controller is reset for bumpless transfer back.
+// Within the band the PI controller runs from the same
+// (possibly-smoothed) temperature, aiming at the sweet-spot centre;
+// the anti-seek delays are not applied as the controller
+// has its own minimum step.
+uint8_t computePITRVPercentOpen(const uint8_t valvePCOpen,
+        const ModelledRadValveInputState &inputState)
+    {
+    const int_fast16_t adjustedTempC16 = isFiltering ?
+        (getSmoothedRecent() + ModelledRadValveInputState::refTempOffsetC16) :
+        inputState.refTempC16;
+    const int_fast8_t adjustedTempC = (int_fast8_t) (adjustedTempC16 >> 4);
+    const uint8_t tTC = inputState.targetTempC;
+    const uint8_t higherTargetC =
+        OTV0P2BASE::fnmax(tTC, inputState.maxTargetTempC);
+    if(inputState.inBakeMode ||
+       (adjustedTempC < OTV0P2BASE::fnmax(int(tTC) - int(_proportionalRange),
+                                          int(OTRadValve::MIN_TARGET_C))) ||
+       (adjustedTempC > OTV0P2BASE::fnmin(uint8_t(higherTargetC + _proportionalRange),
+                                          OTRadValve::MAX_TARGET_C)))
+        {
+        pi.reset();
+        return(computeRequiredTRVPercentOpen(valvePCOpen, inputState));
+        }
+    const int_fast16_t errorC16 =
+        (int_fast16_t(tTC) << 4) + centreOffsetC16 - adjustedTempC16;
+    return(pi.step(valvePCOpen, adjustedTempC16, errorC16, inputState.maxPCOpen,
+                   inputState.widenDeadband || (0 != isFiltering),
+                   alwaysGlacial || inputState.glacial));
+    }
+
+// As computeRequiredTRVPercentOpen() but with the filter and anti-seek state
+// taken from s, so that the same logic can be applied to other layouts of state.
+// S must provide isFiltering, alwaysGlacial, getSmoothedRecent(), getRawDelta(),
+// dontTurnup(), dontTurndown() and setEvent() as this class does.
+template <class S>
+static uint8_t computeRequiredTRVPercentOpen(const S &s, uint8_t valvePCOpen,
+        const ModelledRadValveInputState &inputState)
 {
   // Possibly-adjusted and/or smoothed temperature to use for targeting.
-  const int_fast16_t adjustedTempC16 = isFiltering ?
-      (getSmoothedRecent() + ModelledRadValveInputState::refTempOffsetC16) :
+  const int_fast16_t adjustedTempC16 = s.isFiltering ?
+      (s.getSmoothedRecent() + ModelledRadValveInputState::refTempOffsetC16) :
       inputState.refTempC16;
   // When reduced to whole Celsius then fewer bits are needed
   // to cover the expected temperature range
@@ -567,12 +778,12 @@ uint8_t computeRequiredTRVPercentOpen(uint8_t valvePCOpen,
   const int_fast8_t adjustedTempC = (int_fast8_t) (adjustedTempC16 >> 4);
 
   // Be glacial if always so or temporarily requested to be so.
-  const bool beGlacial = alwaysGlacial || inputState.glacial;
+  const bool beGlacial = s.alwaysGlacial || inputState.glacial;
 
   // Heavily used fields broken out to potentially save read costs.
   const uint8_t tTC = inputState.targetTempC;
   const bool wide = inputState.widenDeadband;
-  const bool worf = (wide || isFiltering);
+  const bool worf = (wide || s.isFiltering);
 
   // Typical valve slew rate (percent/minute) when close to target temperature.
   // Keeping the slew small reduces noise and overshoot and surges of water
@@ -619,14 +830,14 @@ uint8_t computeRequiredTRVPercentOpen(uint8_t valvePCOpen,
                                            int(OTRadValve::MIN_TARGET_C))))
         {
         // Don't open if recently turned down, unless in BAKE mode.
-        if(dontTurnup() && !inputState.inBakeMode) { return(valvePCOpen); }
+        if(s.dontTurnup() && !inputState.inBakeMode) { return(valvePCOpen); }
         if(!MINIMAL_BINARY_IMPL)
             {
             // Honour glacial restriction for opening if not binary.
             if(beGlacial) { if(valvePCOpen < inputState.maxPCOpen) { return(valvePCOpen + 1); } }
             }
         // Fully open immediately.
-        setEvent(MRVE_OPENFAST);
+        s.setEvent(MRVE_OPENFAST);
         return(inputState.maxPCOpen);
         }
     // (Well) over temperature target: close valve down.
@@ -642,7 +853,7 @@ uint8_t computeRequiredTRVPercentOpen(uint8_t valvePCOpen,
                                            OTRadValve::MAX_TARGET_C)))
         {
         // Don't close if recently turned up.
-        if(dontTurndown()) { return(valvePCOpen); }
+        if(s.dontTurndown()) { return(valvePCOpen); }
         // Fully close immediately.
         return(0);
         }
@@ -665,7 +876,6 @@ uint8_t computeRequiredTRVPercentOpen(uint8_t valvePCOpen,
         if(BRANCH_HINT_unlikely(inputState.inBakeMode)) { return(inputState.maxPCOpen); }
 
         // Raw temperature error: amount ambient is above target (1/16C).
-        static constexpr int8_t centreOffsetC16 = 12;
         const int_fast16_t errorC16 =
             adjustedTempC16 - (int_fast16_t(tTC) << 4) - centreOffsetC16;
         // True when below target, ie the error is negative.
@@ -673,9 +883,9 @@ uint8_t computeRequiredTRVPercentOpen(uint8_t valvePCOpen,
 
         // Leave valve as-is if blocked from moving in appropriate direction.
         if(belowTarget)
-            { if(dontTurnup()) { return(valvePCOpen); } }
+            { if(s.dontTurnup()) { return(valvePCOpen); } }
         else
-            { if(dontTurndown()) { return(valvePCOpen); } }
+            { if(s.dontTurndown()) { return(valvePCOpen); } }
 
         // Leave valve as-is if already at limit in appropriate direction.
         if(belowTarget)
@@ -709,7 +919,7 @@ uint8_t computeRequiredTRVPercentOpen(uint8_t valvePCOpen,
         // Filtering pushes limit up well above the target for all-in-1 TRVs,
         // though if sufficiently set back the non-set-back value prevails.
         // Keeps general wide deadband downwards-only to save some energy.
-        const uint8_t wOTC16highSide = isFiltering ? wATC16 : halfNormalBand;
+        const uint8_t wOTC16highSide = s.isFiltering ? wATC16 : halfNormalBand;
         const bool wellAboveTarget = errorC16 > wOTC16highSide;
         const bool wellBelowTarget = errorC16 < -wOTC16basic;
         // Same calc for herrorC16 as errorC16 but possibly not set back.
@@ -798,7 +1008,7 @@ uint8_t computeRequiredTRVPercentOpen(uint8_t valvePCOpen,
             (valvePCOpen >= OTRadValve::DEFAULT_VALVE_PC_SAFER_OPEN);
 
         // Check direction of latest raw temperature movement, if any.
-        const int_fast16_t rise = getRawDelta();
+        const int_fast16_t rise = s.getRawDelta();
 
         // Avoid movement to save valve energy and noise if ALL of:
         //   * not calling for heat (also saves boiler energy/noise)
@@ -932,13 +1142,46 @@ uint8_t computeRequiredTRVPercentOpen(uint8_t valvePCOpen,
     return(valvePCOpen);
     }
 
+    // True if a tick() with this input state would change nothing
+    // but the (flat) temperature history, given that the last tick()
+    // had the same input state and valve position.
+    // That is: initialised, not filtering, no anti-seek delay running,
+    // the valve not moved by the last tick(),
+    // and the whole filter memory equal to the new temperature.
+    // Never true with PI_CONTROL, as the integral term keeps acting
+    // on a steady error even when the valve has not (yet) moved.
+    bool isSteady(const ModelledRadValveInputState &inputState) const
+        {
+        if(PI_CONTROL) { return(false); }
+        if(!initialised || (0 != isFiltering) || valveMoved ||
+           (0 != valveTurndownCountdownM) || (0 != valveTurnupCountdownM)) { return(false); }
+        const int_fast16_t rawTempC16 = computeRawTemp16(inputState);
+        for(uint8_t i = 0; i < filterLength; ++i)
+            { if(rawTempC16 != prevRawTempC16[i]) { return(false); } }
+        return(true);
+        }
+
     // Fill the filter memory with the current room temperature.
     // Store temp in its internal form, as during initialisation.
     // Not intended for general use.
     // Can be used when testing to avoid filtering being triggered
     // with rapid simulated temperature swings.
     inline void _backfillTemperatures(const int_fast16_t rawTempC16)
-        { for(int_fast8_t i = filterLength; --i >= 0; ) { prevRawTempC16[i] = rawTempC16; } }
+        {
+        for(int_fast8_t i = filterLength; --i >= 0; ) { prevRawTempC16[i] = rawTempC16; }
+        prevRawTempHead = 0;
+        prevRawTempSum = (int_fast16_t)(rawTempC16 * (int_fast16_t)filterLength);
+        prevRawTempJumps = 0;
+        }
+
+    // Adjust the unadjusted temperature from n ticks ago by delta; n in [0,filterLength-1].
+    // Not intended for general use.
+    // Can be used when testing to inject glitches into the filter memory.
+    void _adjustPrevRawTempC16(const uint8_t n, const int_fast16_t delta)
+        {
+        prevRawTempC16[prevRawTempIndex(prevRawTempHead, n)] += delta;
+        recomputePrevRawTempStats();
+        }
 
     // Compute the adjusted temperature as used within the class calculation, filter, etc.
     static int_fast16_t computeRawTemp16(const ModelledRadValveInputState& inputState)
@@ -0,0 +1,214 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Many ModelledRadValveState instances held structure-of-arrays
+ * and advanced together, eg for host-side simulation of a fleet
+ * or hub-side "virtual valve" modelling.
+ */
+
+#ifndef UTILITY_OTRADVALVE_MODELLEDRADVALVESTATEBATCH_H_
+#define UTILITY_OTRADVALVE_MODELLEDRADVALVESTATEBATCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "OTRadValve_ModelledRadValve.h"
+
+namespace OTRadValve
+{
+
+// Holds the state of N modelled valves as structure-of-arrays
+// and advances all of them with one tick() call.
+// Lane i behaves exactly as an individual ModelledRadValveState
+// ticked with the same inputs and no physical device,
+// which all start (uninitialised) together.
+//
+// The temperature history and filter and anti-seek counters
+// are updated lane-wise in simple loops over contiguous arrays
+// (with one ring-buffer position shared by all lanes)
+// for the compiler to vectorise;
+// the valve position is then computed per lane with the same logic
+// as ModelledRadValveState::computeRequiredTRVPercentOpen().
+//
+// Template parameters:
+//     N  number of valves; strictly positive
+//     MINIMAL_BINARY_IMPL, AGGRESSIVE_ON  as for ModelledRadValveState
+template <size_t N, bool MINIMAL_BINARY_IMPL = false, bool AGGRESSIVE_ON = false>
+class ModelledRadValveStateBatch final
+{
+    static_assert(N > 0, "must hold at least one valve");
+
+public:
+    // Scalar equivalent of each lane.
+    typedef ModelledRadValveState<MINIMAL_BINARY_IMPL, AGGRESSIVE_ON> scalar_t;
+    static constexpr size_t filterLength = scalar_t::filterLength;
+
+    // All lanes glacial if true, as for ModelledRadValveState::alwaysGlacial.
+    const bool alwaysGlacial = false;
+
+    // True once the first tick() has backfilled the histories.
+    bool initialised = false;
+
+    // Per-lane state as for the same-named ModelledRadValveState members.
+    uint8_t isFiltering[N] = { };
+    bool valveMoved[N] = { };
+    uint8_t valveTurndownCountdownM[N] = { };
+    uint8_t valveTurnupCountdownM[N] = { };
+    uint16_t cumulativeMovementPC[N] = { };
+    uint8_t prevValvePC[N] = { };
+
+private:
+    // Unadjusted temperature history, one row per sample, lanes contiguous.
+    int_fast16_t prevRawTempC16[filterLength][N];
+    // Row of the newest sample, shared by all lanes.
+    uint8_t prevRawTempHead = 0;
+    // Running sum of each lane's history.
+    int_fast16_t prevRawTempSum[N] = { };
+    // Count of adjacent samples jumping by more than MAX_TEMP_JUMP_C16 per lane.
+    // Only maintained if FILTER_DETECT_JITTER.
+    uint8_t prevRawTempJumps[N] = { };
+
+    // Row holding the sample n ticks ago; n in [0,filterLength-1].
+    uint8_t row(const uint8_t n) const
+        { return((uint8_t)((prevRawTempHead + n) % filterLength)); }
+
+    // Read-only view of one lane for computeRequiredTRVPercentOpen().
+    struct Lane final
+    {
+        const ModelledRadValveStateBatch &b;
+        const size_t i;
+        const uint8_t isFiltering;
+        const bool alwaysGlacial;
+        Lane(const ModelledRadValveStateBatch &_b, const size_t _i)
+          : b(_b), i(_i), isFiltering(_b.isFiltering[_i]), alwaysGlacial(_b.alwaysGlacial) { }
+        int_fast16_t getSmoothedRecent() const { return(b.getSmoothedRecent(i)); }
+        int_fast16_t getRawDelta() const { return(b.getRawDelta(i, 1)); }
+        bool dontTurnup() const { return(0 != b.valveTurndownCountdownM[i]); }
+        bool dontTurndown() const { return(0 != b.valveTurnupCountdownM[i]); }
+        void setEvent(typename scalar_t::event_t) const { }
+    };
+
+public:
+    ModelledRadValveStateBatch() { }
+    explicit ModelledRadValveStateBatch(const bool _alwaysGlacial) : alwaysGlacial(_alwaysGlacial) { }
+
+    // Get the number of valves.
+    static constexpr size_t size() { return(N); }
+
+    // Get lane i's unadjusted temperature from n ticks ago, 0 being the newest.
+    int_fast16_t getPrevRawTempC16(const size_t i, const uint8_t n) const
+        { return(prevRawTempC16[row(n)][i]); }
+
+    // Get lane i's smoothed raw/unadjusted temperature, as ModelledRadValveState does.
+    int_fast16_t getSmoothedRecent(const size_t i) const
+        { return((prevRawTempSum[i] + (int_fast16_t)(filterLength/2)) / (int_fast16_t)filterLength); }
+
+    // Get lane i's change in temperature over the last n ticks (capped to the filter length).
+    int_fast16_t getRawDelta(const size_t i, const uint8_t n) const
+        { return(getPrevRawTempC16(i, 0) - getPrevRawTempC16(i, (uint8_t)OTV0P2BASE::fnmin((size_t)n, filterLength-1))); }
+
+    // Perform per-minute tasks for all lanes and recompute valve positions,
+    // as ModelledRadValveState::tick() without a physical device.
+    //   * valvePCOpen  current valve positions of all N lanes UPDATED BY THIS CALL;
+    //         each in range [0,100]
+    //   * inputState  input states of all N lanes
+    void tick(uint8_t valvePCOpen[N], const ModelledRadValveInputState inputState[N])
+    {
+        int_fast16_t raw[N];
+        for(size_t i = 0; i < N; ++i) { raw[i] = scalar_t::computeRawTemp16(inputState[i]); }
+
+        // One-off work on first tick.
+        if(!initialised) {
+            for(size_t r = 0; r < filterLength; ++r)
+                { for(size_t i = 0; i < N; ++i) { prevRawTempC16[r][i] = raw[i]; } }
+            for(size_t i = 0; i < N; ++i) {
+                prevRawTempSum[i] = (int_fast16_t)(raw[i] * (int_fast16_t)filterLength);
+                prevRawTempJumps[i] = 0;
+                prevValvePC[i] = valvePCOpen[i];
+            }
+            prevRawTempHead = 0;
+            initialised = true;
+        }
+
+        // Shift in the latest temperatures over the oldest.
+        const uint8_t oldest = row(filterLength - 1);
+        if(scalar_t::FILTER_DETECT_JITTER) {
+            const uint8_t older = row(filterLength - 2);
+            for(size_t i = 0; i < N; ++i) {
+                prevRawTempJumps[i] = (uint8_t)(prevRawTempJumps[i]
+                    - (OTV0P2BASE::fnabsdiff(prevRawTempC16[oldest][i], prevRawTempC16[older][i]) > scalar_t::MAX_TEMP_JUMP_C16)
+                    + (OTV0P2BASE::fnabsdiff(raw[i], prevRawTempC16[prevRawTempHead][i]) > scalar_t::MAX_TEMP_JUMP_C16));
+            }
+        }
+        for(size_t i = 0; i < N; ++i) {
+            prevRawTempSum[i] += raw[i] - prevRawTempC16[oldest][i];
+            prevRawTempC16[oldest][i] = raw[i];
+        }
+        prevRawTempHead = oldest;
+
+        // Disable/enable filtering, as ModelledRadValveState::tick().
+        static constexpr uint8_t filter_minimum_ON =
+          scalar_t::SUPPORT_LONG_FILTER ? (4 * filterLength) : 1;
+        const uint8_t deltaRow = row(scalar_t::MIN_TICKS_0p5C_DELTA);
+        for(size_t i = 0; i < N; ++i) {
+            uint8_t f = isFiltering[i];
+            if(0 != f) {
+                const bool exit = OTV0P2BASE::fnabsdiff(getSmoothedRecent(i), raw[i]) <= scalar_t::MAX_TEMP_JUMP_C16;
+                f = (scalar_t::SUPPORT_LONG_FILTER && (f > 1)) ? (uint8_t)(f - 1) : (exit ? 0 : f);
+            }
+            if(0 == f) {
+                const bool bigDelta = OTV0P2BASE::fnabs(raw[i] - prevRawTempC16[deltaRow][i]) > 8;
+                const bool jitter = scalar_t::FILTER_DETECT_JITTER && (0 != prevRawTempJumps[i]);
+                f = (bigDelta || jitter) ? filter_minimum_ON : 0;
+            }
+            isFiltering[i] = f;
+        }
+
+        // Count down timers.
+        for(size_t i = 0; i < N; ++i) {
+            valveTurndownCountdownM[i] -= (valveTurndownCountdownM[i] > 0);
+            valveTurnupCountdownM[i] -= (valveTurnupCountdownM[i] > 0);
+        }
+
+        // Compute new valve positions and track movement.
+        for(size_t i = 0; i < N; ++i) {
+            const uint8_t oldValvePC = prevValvePC[i];
+            const uint8_t oldModelledValvePC = valvePCOpen[i];
+            const uint8_t newModelledValvePC =
+              scalar_t::computeRequiredTRVPercentOpen(Lane(*this, i), oldModelledValvePC, inputState[i]);
+            const bool modelledValveChanged = (newModelledValvePC != oldModelledValvePC);
+            if(modelledValveChanged) {
+                if(newModelledValvePC > oldModelledValvePC)
+                    { valveTurnupCountdownM[i] = DEFAULT_ANTISEEK_VALVE_RECLOSE_DELAY_M; }
+                else
+                    { valveTurndownCountdownM[i] = DEFAULT_ANTISEEK_VALVE_REOPEN_DELAY_M; }
+                valvePCOpen[i] = newModelledValvePC;
+            }
+            cumulativeMovementPC[i] =
+              (cumulativeMovementPC[i] + OTV0P2BASE::fnabsdiff(oldValvePC, newModelledValvePC))
+              & scalar_t::MAX_CUMULATIVE_MOVEMENT_VALUE;
+            prevValvePC[i] = newModelledValvePC;
+            valveMoved[i] = modelledValveChanged;
+        }
+    }
+};
+
+}
+
+#endif
@@ -77,6 +77,27 @@ void SimpleValveScheduleBase::applyUserSchedule(
         }
     }
 
+// True iff any schedule is 'on'/'WARM' now or comes on within leadM minutes.
+//   * mm  minutes from midnight (usually local time);
+//     must be less than OTV0P2BASE::MINS_PER_DAY
+//   * leadM  look-ahead in minutes; less than OTV0P2BASE::MINS_PER_DAY
+bool SimpleValveScheduleBase::isAnyScheduleOnWARMWithin(
+        const uint_least16_t mm,
+        const uint_least16_t leadM) const
+    {
+    if(mm >= OTV0P2BASE::MINS_PER_DAY) { return(false); } // Invalid time.
+    if(isAnyScheduleOnWARMNow(mm)) { return(true); }
+    const uint8_t maxSc = maxSchedules();
+    for(uint8_t which = 0; which < maxSc; ++which)
+        {
+        const uint_least16_t s = getSimpleScheduleOn(which);
+        if(s >= OTV0P2BASE::MINS_PER_DAY) { continue; } // Not set.
+        // Minutes until this schedule comes on, allowing for wrap-around at midnight.
+        const uint_least16_t untilM = (s >= mm) ? (s - mm) : (s + OTV0P2BASE::MINS_PER_DAY - mm);
+        if(untilM <= leadM) { return(true); }
+        }
+    return(false);
+    }
 
 // Get the simple/primary schedule off time, as minutes after midnight [0,1439]; invalid (eg ~0) if none set.
 // This is based on specified start time and some element of the current eco/comfort bias.
@@ -91,8 +112,58 @@ uint_least16_t SimpleValveScheduleParams::getSimpleScheduleOff(const uint8_t whi
   return(endTime);
   }
 
+// Make sure that the transition cache is valid, rebuilding it if need be.
+// Returns false if there are too many schedules to cache.
+bool SimpleValveScheduleParams::refreshTransitionCache() const
+  {
+  const uint8_t maxS = maxSchedules();
+  if(maxS > MAX_CACHED_SCHEDULES) { return(false); }
+  const uint8_t ot = onTime();
+  if(ot == cachedOnTime) { return(true); }
+
+  // Collect each WARM period [s,e) as up to two pieces within the day,
+  // splitting any that wrap around midnight, sorted by start.
+  uint_least16_t ps[2*MAX_CACHED_SCHEDULES];
+  uint_least16_t pe[2*MAX_CACHED_SCHEDULES];
+  uint8_t np = 0;
+  for(uint8_t which = 0; which < maxS; ++which)
+    {
+    const uint_least16_t s = getSimpleScheduleOn(which);
+    if(uint_least16_t(~0) == s) { continue; } // Not set.
+    const uint_least16_t e = getSimpleScheduleOff(which);
+    uint_least16_t pieceS[2], pieceE[2];
+    uint8_t n = 0;
+    if(s < e) { pieceS[n] = s; pieceE[n++] = e; }
+    else
+      {
+      pieceS[n] = s; pieceE[n++] = OTV0P2BASE::MINS_PER_DAY;
+      if(0 != e) { pieceS[n] = 0; pieceE[n++] = e; }
+      }
+    for(uint8_t k = 0; k < n; ++k)
+      {
+      uint8_t i = np++;
+      for( ; (i > 0) && (ps[i-1] > pieceS[k]); --i) { ps[i] = ps[i-1]; pe[i] = pe[i-1]; }
+      ps[i] = pieceS[k]; pe[i] = pieceE[k];
+      }
+    }
+
+  // Merge overlapping/adjacent pieces and note where each merged period
+  // starts and ends, other than at midnight.
+  nTransitions = 0;
+  warmAtMidnight = (np > 0) && (0 == ps[0]);
+  for(uint8_t i = 0; i < np; )
+    {
+    const uint_least16_t s = ps[i];
+    uint_least16_t e = pe[i];
+    for(++i; (i < np) && (ps[i] <= e); ++i) { e = OTV0P2BASE::fnmax(e, pe[i]); }
+    if(0 != s) { transitions[nTransitions++] = s; }
+    if(OTV0P2BASE::MINS_PER_DAY != e) { transitions[nTransitions++] = e; }
+    }
+  cachedOnTime = ot;
+  return(true);
+  }
+
 // True iff any schedule is currently 'on'/'WARM' even when schedules overlap.
-// May be relatively slow/expensive.
 // Can be used to suppress all 'off' activity except for the final one.
 // Can be used to suppress set-backs during on times.
 // Scheduled times near the midnight wrap-around are tricky.
@@ -100,6 +171,15 @@ bool SimpleValveScheduleParams::isAnyScheduleOnWARMNow(const uint_least16_t mm)
   {
   if(mm >= OTV0P2BASE::MINS_PER_DAY) { return(false); } // Invalid time.
 
+  if(refreshTransitionCache())
+    {
+    // Each transition passed flips the state from that at midnight.
+    bool warm = warmAtMidnight;
+    for(uint8_t i = 0; (i < nTransitions) && (transitions[i] <= mm); ++i) { warm = !warm; }
+    return(warm);
+    }
+
+  // Too many schedules to cache: decode each one.
   const uint8_t maxS = maxSchedules();
   for(uint8_t which = 0; which < maxS; ++which)
     {
@@ -128,6 +208,32 @@ bool SimpleValveScheduleParams::isAnyScheduleOnWARMNow(const uint_least16_t mm)
   return(false);
   }
 
+// True iff any schedule is 'on'/'WARM' now or comes on within leadM minutes.
+//   * mm  minutes from midnight (usually local time);
+//     must be less than OTV0P2BASE::MINS_PER_DAY
+//   * leadM  look-ahead in minutes; less than OTV0P2BASE::MINS_PER_DAY
+bool SimpleValveScheduleParams::isAnyScheduleOnWARMWithin(
+        const uint_least16_t mm,
+        const uint_least16_t leadM) const
+  {
+  if(mm >= OTV0P2BASE::MINS_PER_DAY) { return(false); } // Invalid time.
+  if(!refreshTransitionCache())
+    { return(SimpleValveScheduleBase::isAnyScheduleOnWARMWithin(mm, leadM)); }
+
+  // If not WARM now then the next transition is the next WARM start,
+  // else (with none left today) the first one tomorrow.
+  bool warm = warmAtMidnight;
+  uint8_t i = 0;
+  for( ; (i < nTransitions) && (transitions[i] <= mm); ++i) { warm = !warm; }
+  if(warm) { return(true); }
+  uint_least16_t nextOn;
+  if(i < nTransitions) { nextOn = transitions[i]; }
+  else if(warmAtMidnight) { nextOn = OTV0P2BASE::MINS_PER_DAY; }
+  else if(0 != nTransitions) { nextOn = transitions[0] + OTV0P2BASE::MINS_PER_DAY; }
+  else { return(false); } // No schedules set.
+  return((nextOn - mm) <= leadM);
+  }
+
 // True iff any schedule is due 'on'/'WARM' soon even when schedules overlap.
 // May be relatively slow/expensive.
 // Can be used to allow room to be brought up to at least a set-back temperature
@@ -174,6 +280,7 @@ bool SimpleValveScheduleEEPROM::setSimpleSchedule(const uint_least16_t startMinu
   const uint8_t startMM = computeProgrammeByteFromTime(startMinutesSinceMidnightLT);
   ATOMIC_BLOCK (ATOMIC_RESTORESTATE)
     { OTV0P2BASE::eeprom_smart_update_byte((uint8_t*)(V0P2BASE_EE_START_SIMPLE_SCHEDULE0_ON + which), startMM); }
+  invalidateTransitionCache();
   return(true); // Assume EEPROM programmed OK...
   }
 
@@ -186,6 +293,7 @@ void SimpleValveScheduleEEPROM::clearSimpleSchedule(const uint8_t which)
   // Clear the schedule back to 'unprogrammed' values, minimising wear.
   ATOMIC_BLOCK (ATOMIC_RESTORESTATE)
     { OTV0P2BASE::eeprom_smart_erase_byte((uint8_t*)(V0P2BASE_EE_START_SIMPLE_SCHEDULE0_ON + which)); }
+  invalidateTransitionCache();
   }
 
 // Returns true if any simple schedule is set, false otherwise.
@@ -91,6 +91,15 @@ class SimpleValveScheduleBase
         //     must be less than OTV0P2BASE::MINS_PER_DAY
         virtual bool isAnyScheduleOnWARMSoon(uint_least16_t mm) const = 0;
 
+        // True iff any schedule is 'on'/'WARM' now or comes on within leadM minutes.
+        // Like isAnyScheduleOnWARMSoon() but with a caller-chosen look-ahead,
+        // eg from a learned room warm-up rate;
+        // the whole interval is checked, not just its end.
+        //   * mm  minutes from midnight (usually local time);
+        //     must be less than OTV0P2BASE::MINS_PER_DAY
+        //   * leadM  look-ahead in minutes; less than OTV0P2BASE::MINS_PER_DAY
+        virtual bool isAnyScheduleOnWARMWithin(uint_least16_t mm, uint_least16_t leadM) const;
+
         // True iff any schedule is currently 'on'/'WARM' even when schedules overlap.
         // May be relatively slow/expensive.
         // Can be used to suppress all 'off' activity except for the final one.
@@ -113,8 +122,41 @@ class SimpleValveScheduleBase
 // Some basic properties and implementation of a simple scheduler.
 // These will hold for the EEPROM-backed AVR version for example,
 // as well as a more testable RAM-based version.
+//
+// The WARM periods of all schedules are merged into a RAM-cached sorted list
+// of the minutes at which the on/off state changes during the day,
+// so that the per-tick queries need not decode every programme byte.
+// The list is the same every day, and is rebuilt only when a schedule
+// is set or cleared (derived classes call invalidateTransitionCache())
+// or the on time changes, eg with the comfort level.
 class SimpleValveScheduleParams : public SimpleValveScheduleBase
     {
+    public:
+        // Maximum number of schedules whose transitions are cached; strictly positive.
+        // Beyond this the queries fall back to decoding each schedule every call.
+        static constexpr uint8_t MAX_CACHED_SCHEDULES = 4;
+
+    private:
+        // Sorted minutes [1,1439] at which WARM turns on or off, alternately.
+        // Each schedule's WARM period is shorter than a day,
+        // so there can be no more than two of these per schedule.
+        mutable uint_least16_t transitions[2*MAX_CACHED_SCHEDULES];
+        // Number of valid entries in transitions[].
+        mutable uint8_t nTransitions = 0;
+        // True if WARM at midnight, ie at the start of transitions[].
+        mutable bool warmAtMidnight = false;
+        // onTime() that the cache was built with; 0 if the cache is invalid.
+        mutable uint8_t cachedOnTime = 0;
+
+        // Make sure that the transition cache is valid, rebuilding it if need be.
+        // Returns false if there are too many schedules to cache.
+        bool refreshTransitionCache() const;
+
+    protected:
+        // Force the transition cache to be rebuilt before its next use.
+        // Must be called whenever any schedule is altered.
+        void invalidateTransitionCache() { cachedOnTime = 0; }
+
     public:
         // Granularity of simple schedule in minutes (values may be rounded/truncated to nearest); strictly positive.
         static constexpr uint8_t SIMPLE_SCHEDULE_GRANULARITY_MINS = 6;
@@ -163,6 +205,12 @@ class SimpleValveScheduleParams : public SimpleValveScheduleBase
         //     must be less than OTV0P2BASE::MINS_PER_DAY
         virtual bool isAnyScheduleOnWARMSoon(uint_least16_t mm) const override;
 
+        // True iff any schedule is 'on'/'WARM' now or comes on within leadM minutes.
+        //   * mm  minutes from midnight (usually local time);
+        //     must be less than OTV0P2BASE::MINS_PER_DAY
+        //   * leadM  look-ahead in minutes; less than OTV0P2BASE::MINS_PER_DAY
+        virtual bool isAnyScheduleOnWARMWithin(uint_least16_t mm, uint_least16_t leadM) const override;
+
         // Maximum mins-after-midnight compacted value in one byte.
         // Exposed to facilitate unit testing.
         static constexpr uint8_t MAX_COMPRESSED_MINS_AFTER_MIDNIGHT = ((OTV0P2BASE::MINS_PER_DAY / SIMPLE_SCHEDULE_GRANULARITY_MINS) - 1);
@@ -249,6 +297,7 @@ class SimpleValveScheduleMock final : public SimpleValveScheduleParams
             if(startMinutesSinceMidnightLT >= OTV0P2BASE::MINS_PER_DAY) { return(false); } // Invalid time.
             const uint8_t startMM = computeProgrammeByteFromTime(startMinutesSinceMidnightLT);
             programmes[which] = startMM;
+            invalidateTransitionCache();
             return(true);
             }
 
@@ -260,6 +309,7 @@ class SimpleValveScheduleMock final : public SimpleValveScheduleParams
             if(which >= maxSchedules()) { return; } // Invalid schedule number.
             // Clear the schedule back to 'unprogrammed' values.
             programmes[which] = 0xff;
+            invalidateTransitionCache();
             }
 
         // True iff any schedule is currently 'on'/'WARM' even when schedules overlap.
@@ -162,15 +162,34 @@ class TempControlSimpleVCPMock : public TempControlSimpleVCP<valveControlParams>
 #ifdef ARDUINO_ARCH_AVR
 // Non-volatile (EEPROM) stored WARM threshold for some devices without physical controls, eg REV1.
 // Typically selected if defined(ENABLE_SETTABLE_TARGET_TEMPERATURES)
+// The stored values are read from EEPROM once, on first use, and cached,
+// so the getters are RAM reads; the setters write through.
 #define TempControlSimpleEEPROMBacked_DEFINED
 template <class valveControlParams>
 class TempControlSimpleEEPROMBacked final : public TempControlSimpleVCP<valveControlParams>, TempControlSettableInterface
   {
+  private:
+    // Cached raw EEPROM values, valid once loaded is true.
+    mutable uint8_t storedWARM = 0;
+    mutable uint8_t storedFROST = 0;
+    mutable bool loaded = false;
+    void load() const
+      {
+      if(loaded) { return; }
+      storedWARM = eeprom_read_byte((uint8_t *)V0P2BASE_EE_START_WARM_C);
+      storedFROST = eeprom_read_byte((uint8_t *)V0P2BASE_EE_START_FROST_C);
+      loaded = true;
+      }
+
   public:
+    // Force a re-read from EEPROM on next use, eg after the EEPROM has been changed directly.
+    void reloadFromEEPROM() { loaded = false; }
+
     virtual uint8_t getWARMTargetC() const override
       {
       // Get persisted value, if any.
-      const uint8_t stored = eeprom_read_byte((uint8_t *)V0P2BASE_EE_START_WARM_C);
+      load();
+      const uint8_t stored = storedWARM;
       // If out of bounds or no stored value then use default (or frost value if set and higher).
       if((stored < valveControlParams::TEMP_SCALE_MIN) || (stored > valveControlParams::TEMP_SCALE_MAX)) { return(OTV0P2BASE::fnmax(valveControlParams::WARM, getFROSTTargetC())); }
       // Return valid persisted value (or frost value if set and higher).
@@ -180,7 +199,8 @@ class TempControlSimpleEEPROMBacked final : public TempControlSimpleVCP<valveCon
     virtual uint8_t getFROSTTargetC() const override
       {
       // Get persisted value, if any.
-      const uint8_t stored = eeprom_read_byte((uint8_t *)V0P2BASE_EE_START_FROST_C);
+      load();
+      const uint8_t stored = storedFROST;
       // If out of bounds or no stored value then use default.
       if((stored < valveControlParams::TEMP_SCALE_MIN) || (stored > valveControlParams::TEMP_SCALE_MAX)) { return(valveControlParams::FROST); }
       // Return valid persisted value.
@@ -195,6 +215,7 @@ class TempControlSimpleEEPROMBacked final : public TempControlSimpleVCP<valveCon
       if((tempC < valveControlParams::TEMP_SCALE_MIN) || (tempC > valveControlParams::TEMP_SCALE_MAX)) { return(false); } // Invalid temperature.
       if(tempC > getWARMTargetC()) { return(false); } // Cannot set above WARM target.
       OTV0P2BASE::eeprom_smart_update_byte((uint8_t *)V0P2BASE_EE_START_FROST_C, tempC); // Update in EEPROM if necessary.
+      storedFROST = tempC;
       return(true); // Assume value correctly written.
       }
 
@@ -205,6 +226,7 @@ class TempControlSimpleEEPROMBacked final : public TempControlSimpleVCP<valveCon
       if((tempC < valveControlParams::TEMP_SCALE_MIN) || (tempC > valveControlParams::TEMP_SCALE_MAX)) { return(false); } // Invalid temperature.
       if(tempC < getFROSTTargetC()) { return(false); } // Cannot set below FROST target.
       OTV0P2BASE::eeprom_smart_update_byte((uint8_t *)V0P2BASE_EE_START_WARM_C, tempC); // Update in EEPROM if necessary.
+      storedWARM = tempC;
       return(true); // Assume value correctly written.
       }
   };
@@ -279,12 +301,32 @@ class TempControlTempPot final : public TempControlSimpleVCP<valveControlParams>
     // Cached input and result values for getWARMTargetC(); initially zero.
     mutable uint8_t potLast = 0;
     mutable uint8_t resultLast = 0;
+    // Cached result for getFROSTTargetC(), zero when it must be recomputed,
+    // and the humidity state it was computed with.
+    // Invalidated whenever the WARM target is recomputed, ie the pot reading changes.
+    mutable uint8_t frostLast = 0;
+    mutable bool rhHighLast = false;
+
+    // True if humidity is available and high, or rising rapidly (eg a shower),
+    // with null-safe access to the optional sensor (see OTV0P2BASE::OptionalTag).
+    static bool isRHHigh(OTV0P2BASE::OptionalTag<false>) { return(false); }
+    static bool isRHHigh(OTV0P2BASE::OptionalTag<true>)
+      { return(rhOpt->isAvailable() && (rhOpt->isRHHighWithHyst() || rhOpt->isRHRisingRapidly())); }
 
   public:
     virtual uint8_t getFROSTTargetC() const override
       {
+      // A rapid RH% rise (eg a shower) counts as high before the level itself is high.
+      const bool rhHigh = isRHHigh(OTV0P2BASE::OptionalTag<(NULL != rhOpt)>());
+      // Bring the WARM target (and so eco bias) up to date first,
+      // which clears the cached FROST result if the pot has moved.
+      const uint8_t warm = getWARMTargetC();
+      if((0 != frostLast) && (rhHigh == rhHighLast)) { return(frostLast); }
       // Prevent falling to lowest frost temperature if relative humidity is high (eg to avoid mould).
-      const uint8_t result = (!this->hasEcoBias() || ((NULL != rhOpt) && rhOpt->isAvailable() && rhOpt->isRHHighWithHyst())) ? valveControlParams::FROST_COM : valveControlParams::FROST_ECO;
+      const bool ecoBias = (warm <= valveControlParams::TEMP_SCALE_MID);
+      const uint8_t result = (!ecoBias || rhHigh) ? valveControlParams::FROST_COM : valveControlParams::FROST_ECO;
+      frostLast = result;
+      rhHighLast = rhHigh;
       return(result);
       }
 
@@ -299,6 +341,7 @@ class TempControlTempPot final : public TempControlSimpleVCP<valveControlParams>
         // Cache input/result.
         resultLast = result;
         potLast = pot;
+        frostLast = 0;
         return(result);
         }
       // Return cached result.
@@ -0,0 +1,335 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Hub-pushed valve commands: WARM/FROST targets and mode.
+ *
+ * The hub keeps the latest desired state for each valve in a ValveCommandQueue,
+ * merging each new command into any not yet confirmed,
+ * and appends it to the body of the secure beacon
+ * it sends in the valve's RX window after hearing from it,
+ * eg after the ack body (see OTRadioLink_SecureAck.h).
+ * So one small frame per valve updates it however many times the
+ * desired state changed since the valve was last heard from.
+ *
+ * The valve decodes the command with decodeValveCommand()
+ * and applies it with ValveCommandApplier,
+ * which ignores repeats of the command it last applied
+ * so that the hub can resend until it sees the valve report the sequence number.
+ *
+ * Command (plaintext in the secure beacon body):
+ *   [0] VALVE_COMMAND_FORMAT
+ *   [1] fields present: VC_HAS_WARM | VC_HAS_FROST | VC_HAS_MODE; nonzero
+ *   [2] WARM target C, [MIN_TARGET_C,MAX_TARGET_C] if present, else 0
+ *   [3] FROST target C, [MIN_TARGET_C,MAX_TARGET_C] if present, else 0
+ *   [4] ValveMode::mode_t if present, else 0
+ *   [5] sequence number, changed by the hub each time the desired state changes
+ *
+ * Portable.
+ */
+
+#ifndef ARDUINO_LIB_OTRADVALVE_VALVECOMMAND_H
+#define ARDUINO_LIB_OTRADVALVE_VALVECOMMAND_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "OTV0P2BASE_QuickPRNG.h"
+#include "OTV0P2BASE_Security.h"
+#include "OTRadValve_Parameters.h"
+#include "OTRadValve_TempControl.h"
+#include "OTRadValve_ValveMode.h"
+
+// Use namespaces to help avoid collisions.
+namespace OTRadValve
+    {
+
+// First byte of a valve command, to distinguish it from other beacon body content.
+static constexpr uint8_t VALVE_COMMAND_FORMAT = 0x43; // 'C'
+static constexpr uint8_t VALVE_COMMAND_BODY_BYTES = 6;
+
+// Field present flags.
+static constexpr uint8_t VC_HAS_WARM = 1;
+static constexpr uint8_t VC_HAS_FROST = 2;
+static constexpr uint8_t VC_HAS_MODE = 4;
+static constexpr uint8_t VC_ALL_FIELDS = VC_HAS_WARM | VC_HAS_FROST | VC_HAS_MODE;
+
+// Desired valve state; only the fields flagged are to be changed.
+struct ValveCommand final
+    {
+    uint8_t fields = 0;
+    uint8_t warmC = 0;
+    uint8_t frostC = 0;
+    uint8_t mode = 0;
+    uint8_t seq = 0;
+
+    void setWARMTargetC(const uint8_t c) { warmC = c; fields |= VC_HAS_WARM; }
+    void setFROSTTargetC(const uint8_t c) { frostC = c; fields |= VC_HAS_FROST; }
+    void setMode(const ValveMode::mode_t m) { mode = m; fields |= VC_HAS_MODE; }
+
+    // True if all fields present are in range.
+    bool isValid() const
+        {
+        if((0 == fields) || (0 != (fields & ~VC_ALL_FIELDS))) { return(false); }
+        if((0 != (fields & VC_HAS_WARM)) && ((warmC < MIN_TARGET_C) || (warmC > MAX_TARGET_C))) { return(false); }
+        if((0 != (fields & VC_HAS_FROST)) && ((frostC < MIN_TARGET_C) || (frostC > MAX_TARGET_C))) { return(false); }
+        if((0 != (fields & VC_HAS_MODE)) && (mode > ValveMode::VMODE_BAKE)) { return(false); }
+        return(true);
+        }
+
+    // Overlay the fields present in newer, keeping the others; does not change seq.
+    // Returns true if anything changed.
+    bool mergeFrom(const ValveCommand &newer)
+        {
+        const ValveCommand old = *this;
+        if(0 != (newer.fields & VC_HAS_WARM)) { setWARMTargetC(newer.warmC); }
+        if(0 != (newer.fields & VC_HAS_FROST)) { setFROSTTargetC(newer.frostC); }
+        if(0 != (newer.fields & VC_HAS_MODE)) { mode = newer.mode; fields |= VC_HAS_MODE; }
+        return(!old.sameState(*this));
+        }
+
+    // True if the same fields and values, ignoring seq.
+    bool sameState(const ValveCommand &other) const
+        {
+        return((fields == other.fields) &&
+               (warmC == other.warmC) && (frostC == other.frostC) && (mode == other.mode));
+        }
+    };
+
+// Write command c to buf; returns the body length, or 0 if buf is too small or c is invalid.
+inline uint8_t encodeValveCommand(uint8_t *const buf, const uint8_t buflen, const ValveCommand &c)
+    {
+    if((NULL == buf) || (buflen < VALVE_COMMAND_BODY_BYTES) || !c.isValid()) { return(0); }
+    buf[0] = VALVE_COMMAND_FORMAT;
+    buf[1] = c.fields;
+    buf[2] = (0 != (c.fields & VC_HAS_WARM)) ? c.warmC : 0;
+    buf[3] = (0 != (c.fields & VC_HAS_FROST)) ? c.frostC : 0;
+    buf[4] = (0 != (c.fields & VC_HAS_MODE)) ? c.mode : 0;
+    buf[5] = c.seq;
+    return(VALVE_COMMAND_BODY_BYTES);
+    }
+// Decode a command from the start of body, eg the bytes of a beacon body after any ack;
+// anything after the command is ignored.
+// Returns false if body does not start with a valid command.
+inline bool decodeValveCommand(const uint8_t *const body, const uint8_t len, ValveCommand &c)
+    {
+    if((NULL == body) || (len < VALVE_COMMAND_BODY_BYTES) || (VALVE_COMMAND_FORMAT != body[0])) { return(false); }
+    ValveCommand d;
+    d.fields = body[1];
+    d.warmC = body[2];
+    d.frostC = body[3];
+    d.mode = body[4];
+    d.seq = body[5];
+    if(!d.isValid()) { return(false); }
+    c = d;
+    return(true);
+    }
+
+// Hub-side latest desired state for up to maxValves valves, by full node ID.
+// A new command for a valve with one outstanding is merged into it
+// (so eg only the latest WARM target is ever sent)
+// and gets a new sequence number.
+// A command stays pending until confirm()ed with its sequence number,
+// eg from the valve's stats, or until it has been offered maxDeliveries times.
+// Template parameters:
+//   * maxValves  valves with commands outstanding at once
+//   * maxDeliveries  times each command is offered before being dropped; strictly positive
+// Not thread-/ISR- safe.
+template<uint8_t maxValves = 8, uint8_t maxDeliveries = 8>
+class ValveCommandQueue final
+    {
+    static_assert(maxValves > 0, "must allow at least one valve");
+    static_assert(maxDeliveries > 0, "must allow at least one delivery");
+
+    public:
+        static constexpr uint8_t ID_BYTES = OTV0P2BASE::OpenTRV_Node_ID_Bytes;
+
+    private:
+        struct Entry final
+            {
+            uint8_t id[ID_BYTES];
+            ValveCommand cmd;
+            // Times offered so far.
+            uint8_t deliveries;
+            bool pending;
+            };
+        Entry entries[maxValves];
+
+        // Saturating statistics.
+        uint16_t coalesced = 0;
+        uint16_t delivered = 0;
+        uint16_t dropped = 0;
+        static void inc(uint16_t &c) { if(c < 0xffff) { ++c; } }
+
+        // Pending entry whose ID starts with the il bytes of id, or NULL.
+        Entry *find(const uint8_t *const id, const uint8_t il)
+            {
+            if((NULL == id) || (0 == il) || (il > ID_BYTES)) { return(NULL); }
+            for(uint8_t i = 0; i < maxValves; ++i)
+                {
+                Entry &e = entries[i];
+                if(e.pending && (0 == memcmp(e.id, id, il))) { return(&e); }
+                }
+            return(NULL);
+            }
+
+    public:
+        ValveCommandQueue() : entries() { }
+
+        // Set the desired state for the valve with full node ID id,
+        // merging into any command still pending for it.
+        // Returns false if c is invalid or no entry is free.
+        bool set(const uint8_t *const id, const ValveCommand &c)
+            {
+            if((NULL == id) || !c.isValid()) { return(false); }
+            Entry *e = find(id, ID_BYTES);
+            if(NULL != e)
+                {
+                if(!e->cmd.mergeFrom(c)) { return(true); }
+                inc(coalesced);
+                ++e->cmd.seq;
+                e->deliveries = 0;
+                return(true);
+                }
+            for(uint8_t i = 0; i < maxValves; ++i)
+                {
+                Entry &f = entries[i];
+                if(f.pending) { continue; }
+                memcpy(f.id, id, ID_BYTES);
+                f.cmd = c;
+                // Random start so that a restarted hub is unlikely to reuse a sequence number.
+                f.cmd.seq = OTV0P2BASE::randRNG8();
+                f.deliveries = 0;
+                f.pending = true;
+                return(true);
+                }
+            return(false);
+            }
+
+        // Append the pending command, if any, for the valve whose ID starts with the il bytes of id
+        // to buf, eg after the ack in the beacon body for that valve.
+        // Returns the number of bytes written, 0 if nothing is pending or buf is too small.
+        uint8_t appendFor(const uint8_t *const id, const uint8_t il, uint8_t *const buf, const uint8_t buflen)
+            {
+            Entry *const e = find(id, il);
+            if(NULL == e) { return(0); }
+            const uint8_t n = encodeValveCommand(buf, buflen, e->cmd);
+            if(0 == n) { return(0); }
+            inc(delivered);
+            if(++e->deliveries >= maxDeliveries) { e->pending = false; inc(dropped); }
+            return(n);
+            }
+
+        // The valve whose ID starts with the il bytes of id has applied command seq.
+        // Returns true if that was the pending command, which is then cleared.
+        bool confirm(const uint8_t *const id, const uint8_t il, const uint8_t seq)
+            {
+            Entry *const e = find(id, il);
+            if((NULL == e) || (seq != e->cmd.seq)) { return(false); }
+            e->pending = false;
+            return(true);
+            }
+
+        // Drop any pending command for the valve with full node ID id.
+        void cancel(const uint8_t *const id)
+            {
+            Entry *const e = find(id, ID_BYTES);
+            if(NULL != e) { e->pending = false; }
+            }
+
+        // Get a copy of the pending command for the valve whose ID starts with the il bytes of id.
+        // Returns false if none.
+        bool getPending(const uint8_t *const id, const uint8_t il, ValveCommand &c)
+            {
+            const Entry *const e = find(id, il);
+            if(NULL == e) { return(false); }
+            c = e->cmd;
+            return(true);
+            }
+        // Number of valves with commands pending.
+        uint8_t getPendingCount() const
+            {
+            uint8_t n = 0;
+            for(uint8_t i = 0; i < maxValves; ++i) { if(entries[i].pending) { ++n; } }
+            return(n);
+            }
+        // Commands merged into one still pending.
+        uint16_t getCoalesced() const { return(coalesced); }
+        // Commands offered for sending, including repeats.
+        uint16_t getDelivered() const { return(delivered); }
+        // Commands dropped unconfirmed after maxDeliveries.
+        uint16_t getDropped() const { return(dropped); }
+    };
+
+// Valve-side application of hub commands to the valve mode and (if settable) targets.
+// Not thread-/ISR- safe.
+class ValveCommandApplier final
+    {
+    private:
+        ValveMode &valveMode;
+        // May be NULL if targets are not settable.
+        TempControlSettableInterface *const tempControl;
+        // Last command applied, to ignore repeats.
+        ValveCommand last;
+        bool haveLast = false;
+
+    public:
+        ValveCommandApplier(ValveMode &valveMode_, TempControlSettableInterface *const tempControl_)
+          : valveMode(valveMode_), tempControl(tempControl_) { }
+
+        // Apply c unless it repeats the last command applied.
+        // Targets are applied in whichever order keeps FROST at or below WARM throughout;
+        // targets are ignored if not settable, and any out of range are rejected by the setter.
+        // Returns true if c was new (even if some parts could not be applied).
+        bool apply(const ValveCommand &c)
+            {
+            if(!c.isValid()) { return(false); }
+            if(haveLast && (c.seq == last.seq) && c.sameState(last)) { return(false); }
+            last = c;
+            haveLast = true;
+            if(NULL != tempControl)
+                {
+                const bool hasWarm = (0 != (c.fields & VC_HAS_WARM));
+                const bool hasFrost = (0 != (c.fields & VC_HAS_FROST));
+                // Try FROST first (lowering), then WARM, then FROST again (raising).
+                const bool frostDone = hasFrost && tempControl->setFROSTTargetC(c.frostC);
+                if(hasWarm) { tempControl->setWARMTargetC(c.warmC); }
+                if(hasFrost && !frostDone) { tempControl->setFROSTTargetC(c.frostC); }
+                }
+            if(0 != (c.fields & VC_HAS_MODE)) { valveMode.set(c.mode); }
+            return(true);
+            }
+        // Decode and apply a command from the start of body; false if not a new valid command.
+        bool applyBody(const uint8_t *const body, const uint8_t len)
+            {
+            ValveCommand c;
+            return(decodeValveCommand(body, len, c) && apply(c));
+            }
+
+        // Sequence number of the last command applied, eg to report to the hub; false if none yet.
+        bool getLastSeq(uint8_t &seq) const
+            {
+            if(!haveLast) { return(false); }
+            seq = last.seq;
+            return(true);
+            }
+    };
+
+    }
+
+#endif
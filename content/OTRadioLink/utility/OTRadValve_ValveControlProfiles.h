@@ -0,0 +1,220 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Table of many run-time valve control parameter sets ("profiles"),
+ * eg one per room for hub-side virtual valves or the fleet simulator,
+ * held structure-of-arrays and looked up by profile ID.
+ *
+ * The table is filled once (from defaults, a packed image, or EEPROM)
+ * and thereafter all reads are from RAM.
+ */
+
+#ifndef UTILITY_OTRADVALVE_VALVECONTROLPROFILES_H_
+#define UTILITY_OTRADVALVE_VALVECONTROLPROFILES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ARDUINO_ARCH_AVR
+#include <avr/eeprom.h>
+#endif
+
+#include "OTRadValve_Parameters.h"
+#include "OTRadValve_TempControl.h"
+
+namespace OTRadValve
+{
+
+// One profile as packed in an image or EEPROM: id, FROST, WARM, BAKE uplift, ECO and FULL setbacks.
+static constexpr uint8_t VALVE_CONTROL_PROFILE_RECORD_BYTES = 6;
+
+// Up to maxProfiles parameter sets keyed by a one-byte profile ID.
+// Each field is a contiguous array indexed by slot,
+// with the IDs kept sorted so that lookup is a binary search.
+// Profiles are validated on entry so that the getters need no checks:
+// FROST and WARM within [MIN_TARGET_C,MAX_TARGET_C] with FROST < WARM,
+// BAKE uplift strictly positive, and setbacks with 1 < ECO < FULL
+// (the same constraints as ValveControlParameters).
+// Not thread-safe.
+//
+// Template parameters:
+//     maxProfiles  capacity; in [1,254]
+template <uint8_t maxProfiles>
+class ValveControlProfileTable final
+{
+    static_assert((maxProfiles > 0) && (maxProfiles < 255), "capacity must be in [1,254]");
+
+public:
+    // Returned by indexOf() for an unknown ID.
+    static constexpr uint8_t NOT_FOUND = 0xff;
+
+private:
+    // Profiles in use, in slots [0,count).
+    uint8_t count = 0;
+    // IDs, ascending.
+    uint8_t id[maxProfiles];
+    uint8_t frostC[maxProfiles];
+    uint8_t warmC[maxProfiles];
+    uint8_t bakeUpliftC[maxProfiles];
+    uint8_t setbackECOC[maxProfiles];
+    uint8_t setbackFULLC[maxProfiles];
+
+public:
+    // True if the values are a usable profile.
+    static constexpr bool isValid(const uint8_t frost, const uint8_t warm,
+                                  const uint8_t bakeUplift, const uint8_t setbackECO, const uint8_t setbackFULL)
+        {
+        return((frost >= MIN_TARGET_C) && (warm <= MAX_TARGET_C) && (frost < warm) &&
+               (0 != bakeUplift) && (setbackECO > 1) && (setbackECO < setbackFULL));
+        }
+
+    // Number of profiles held.
+    uint8_t size() const { return(count); }
+    static constexpr uint8_t capacity() { return(maxProfiles); }
+    // Remove all profiles.
+    void clear() { count = 0; }
+
+    // Slot holding profileID, or NOT_FOUND.
+    uint8_t indexOf(const uint8_t profileID) const
+        {
+        uint8_t lo = 0, hi = count;
+        while(lo < hi)
+            {
+            const uint8_t mid = uint8_t((lo + hi) >> 1);
+            if(id[mid] < profileID) { lo = uint8_t(mid + 1); } else { hi = mid; }
+            }
+        return(((lo < count) && (id[lo] == profileID)) ? lo : NOT_FOUND);
+        }
+
+    // Add or replace profileID; returns false if the values are invalid or the table is full.
+    bool set(const uint8_t profileID, const uint8_t frost, const uint8_t warm,
+             const uint8_t bakeUplift, const uint8_t setbackECO, const uint8_t setbackFULL)
+        {
+        if(!isValid(frost, warm, bakeUplift, setbackECO, setbackFULL)) { return(false); }
+        uint8_t i = indexOf(profileID);
+        if(NOT_FOUND == i)
+            {
+            if(count >= maxProfiles) { return(false); }
+            // Shift larger IDs up one slot to keep the order.
+            i = count++;
+            while((i > 0) && (id[i-1] > profileID))
+                {
+                id[i] = id[i-1];
+                frostC[i] = frostC[i-1];
+                warmC[i] = warmC[i-1];
+                bakeUpliftC[i] = bakeUpliftC[i-1];
+                setbackECOC[i] = setbackECOC[i-1];
+                setbackFULLC[i] = setbackFULLC[i-1];
+                --i;
+                }
+            id[i] = profileID;
+            }
+        frostC[i] = frost;
+        warmC[i] = warm;
+        bakeUpliftC[i] = bakeUplift;
+        setbackECOC[i] = setbackECO;
+        setbackFULLC[i] = setbackFULL;
+        return(true);
+        }
+
+    // Add or replace profileID with the values of a ValveControlParameters type.
+    template <class valveControlParams>
+    bool setFrom(const uint8_t profileID)
+        {
+        return(set(profileID, valveControlParams::FROST, valveControlParams::WARM,
+                   valveControlParams::BAKE_UPLIFT, valveControlParams::SETBACK_ECO, valveControlParams::SETBACK_FULL));
+        }
+
+    // Add or replace profiles from packed VALVE_CONTROL_PROFILE_RECORD_BYTES records;
+    // invalid records are skipped and any trailing partial record ignored.
+    // Returns the number of profiles accepted.
+    uint8_t load(const uint8_t *const image, const size_t len)
+        {
+        if(NULL == image) { return(0); }
+        uint8_t accepted = 0;
+        for(size_t o = 0; o + VALVE_CONTROL_PROFILE_RECORD_BYTES <= len; o += VALVE_CONTROL_PROFILE_RECORD_BYTES)
+            {
+            const uint8_t *const r = image + o;
+            if(set(r[0], r[1], r[2], r[3], r[4], r[5])) { ++accepted; }
+            }
+        return(accepted);
+        }
+
+#ifdef ARDUINO_ARCH_AVR
+    // As load() but from nRecords packed records in EEPROM starting at eeAddr;
+    // call once at start-up.
+    uint8_t loadFromEEPROM(const uint8_t *const eeAddr, const uint8_t nRecords)
+        {
+        uint8_t accepted = 0;
+        uint8_t r[VALVE_CONTROL_PROFILE_RECORD_BYTES];
+        for(uint8_t i = 0; i < nRecords; ++i)
+            {
+            eeprom_read_block(r, eeAddr + (i * VALVE_CONTROL_PROFILE_RECORD_BYTES), sizeof(r));
+            if(set(r[0], r[1], r[2], r[3], r[4], r[5])) { ++accepted; }
+            }
+        return(accepted);
+        }
+#endif // ARDUINO_ARCH_AVR
+
+    // Per-slot values; slot must be in [0,size()).
+    uint8_t getID(const uint8_t slot) const { return(id[slot]); }
+    uint8_t getFROSTTargetC(const uint8_t slot) const { return(frostC[slot]); }
+    uint8_t getWARMTargetC(const uint8_t slot) const { return(warmC[slot]); }
+    uint8_t getBakeUpliftC(const uint8_t slot) const { return(bakeUpliftC[slot]); }
+    uint8_t getSetbackECOC(const uint8_t slot) const { return(setbackECOC[slot]); }
+    uint8_t getSetbackFULLC(const uint8_t slot) const { return(setbackFULLC[slot]); }
+
+    // Run-time parameters of a slot, eg for the modelled valve.
+    ValveControlParametersRTBase getRT(const uint8_t slot) const
+        {
+        // SETBACK_DEFAULT is fixed, as in ValveControlParameters.
+        return(ValveControlParametersRTBase(bakeUpliftC[slot], 1, setbackECOC[slot], setbackFULLC[slot]));
+        }
+};
+
+// Temperature control for one profile of a table, eg one hub-side virtual valve;
+// the targets are plain RAM reads.
+// The eco/comfort scale is taken from valveControlParams as for TempControlSimpleVCP.
+// If the profile is not in the table then the valveControlParams defaults are used.
+// The table must outlive this and should not be changed underneath it
+// other than by replacing the values of existing profiles.
+template <uint8_t maxProfiles, class valveControlParams = DEFAULT_ValveControlParameters>
+class TempControlProfile final : public TempControlSimpleVCP<valveControlParams>
+{
+private:
+    const ValveControlProfileTable<maxProfiles> &table;
+    // Slot of the profile, looked up once, or NOT_FOUND.
+    const uint8_t slot;
+
+public:
+    TempControlProfile(const ValveControlProfileTable<maxProfiles> &t, const uint8_t profileID)
+      : table(t), slot(t.indexOf(profileID)) { }
+
+    // True if the profile was found.
+    bool isValid() const { return(ValveControlProfileTable<maxProfiles>::NOT_FOUND != slot); }
+
+    virtual uint8_t getFROSTTargetC() const override
+        { return(isValid() ? table.getFROSTTargetC(slot) : valveControlParams::FROST); }
+    virtual uint8_t getWARMTargetC() const override
+        { return(isValid() ? table.getWARMTargetC(slot) : valveControlParams::WARM); }
+};
+
+}
+
+#endif
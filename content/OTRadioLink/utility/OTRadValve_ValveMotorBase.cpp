@@ -44,6 +44,7 @@ bool ValveMotorDirectV1HardwareDriverBase::spinSCTTicks(const uint8_t maxRunTick
   static const constexpr uint8_t sctAbsLimit = CurrentSenseValveMotorDirectBase::computeSctAbsLimit(
           OTV0P2BASE::SUBCYCLE_TICK_MS_RD, OTV0P2BASE::GSCT_MAX, minMotorRunupTicks);
 
+  lastSpinCurrentHigh = false;
   // Sub-cycle time now.
   const uint8_t sctStart = OTV0P2BASE::getSubCycleTime();
   // Only run up to ~90% point of the minor cycle to leave time for other processing.
@@ -69,6 +70,8 @@ bool ValveMotorDirectV1HardwareDriverBase::spinSCTTicks(const uint8_t maxRunTick
       if(!stopped) { callback.signalRunSCTTick(isOpening); }
       if(sct >= sctMinRunTime) { break; }
       }
+    // Optionally wait at low power rather than spin until the next tick.
+    else if(lowPowerSpin) { OTV0P2BASE::sleepLowPowerLessThanMs(1); }
     // TODO: shaft encoder
     }
 
@@ -77,10 +80,12 @@ bool ValveMotorDirectV1HardwareDriverBase::spinSCTTicks(const uint8_t maxRunTick
   // (else avoid the current sampling entirely).
   if(sctMaxRunTime > sctMinRunTime)
     {
+    // Watch the current from the ADC interrupt if possible.
+    const bool watch = !stopped && interruptCurrentSense && startCurrentWatch(dir);
     for( ; ; )
       {
       // Check for high current and abort if detected.
-      if(isCurrentHigh(dir)) { currentHigh = true; break; }
+      if(watch ? OTV0P2BASE::analogueThresholdWatchTriggered() : isCurrentHigh(dir)) { currentHigh = true; break; }
       // Poll shaft encoder output and update tick counter.
       const uint8_t newSct = OTV0P2BASE::getSubCycleTime();
       if(newSct != sct)
@@ -89,10 +94,20 @@ bool ValveMotorDirectV1HardwareDriverBase::spinSCTTicks(const uint8_t maxRunTick
         if(!stopped) { callback.signalRunSCTTick(isOpening); }
         if(sct >= sctMaxRunTime) { break; }
         }
+      // Optionally wait at low power before the next current sample.
+      // The ADC read itself already sleeps until its conversion interrupt,
+      // and the watch can sleep until the next conversion.
+      else if(lowPowerSpin)
+        {
+        if(watch) { set_sleep_mode(SLEEP_MODE_ADC); sleep_mode(); }
+        else { OTV0P2BASE::sleepLowPowerLessThanMs(1); }
+        }
       }
+    if(watch) { OTV0P2BASE::analogueThresholdWatchStop(); }
     }
 
   // Call back and return true if current high / end-stop seen.
+  lastSpinCurrentHigh = currentHigh;
   if(currentHigh)
     {
     callback.signalHittingEndStop(isOpening);
@@ -100,6 +115,60 @@ bool ValveMotorDirectV1HardwareDriverBase::spinSCTTicks(const uint8_t maxRunTick
     }
   return(false);
   }
+
+// Ramp the drive duty cycle linearly from fromDuty16 to toDuty16 (in 16ths)
+// over rampTicks sub-cycle ticks, via setDriveGate(), without sampling current.
+// The PWM period is 16 passes of the polling loop,
+// which should be well under a millisecond;
+// lowPowerSpin is ignored as sleeping would stretch the period.
+void ValveMotorDirectV1HardwareDriverBase::rampDrive(const uint8_t rampTicks, const uint8_t fromDuty16, const uint8_t toDuty16, const OTRadValve::HardwareMotorDriverInterface::motor_drive dir, OTRadValve::HardwareMotorDriverInterfaceCallbackHandler &callback)
+  {
+  static const constexpr uint8_t sctAbsLimit = CurrentSenseValveMotorDirectBase::computeSctAbsLimit(
+          OTV0P2BASE::SUBCYCLE_TICK_MS_RD, OTV0P2BASE::GSCT_MAX, minMotorRunupTicks);
+  const bool isOpening = (HardwareMotorDriverInterface::motorDriveOpening == dir);
+  uint8_t sct = OTV0P2BASE::getSubCycleTime();
+  uint8_t elapsed = 0;
+  uint8_t duty = fromDuty16;
+  uint8_t phase = 0;
+  while((elapsed < rampTicks) && (sct < sctAbsLimit))
+    {
+    const uint8_t newSct = OTV0P2BASE::getSubCycleTime();
+    if(newSct != sct)
+      {
+      sct = newSct; // Assumes no intermediate values missed.
+      callback.signalRunSCTTick(isOpening);
+      ++elapsed;
+      // Recompute the duty only once per tick to keep the PWM loop fast.
+      duty = (uint8_t)(fromDuty16 + (((int16_t)toDuty16 - (int16_t)fromDuty16) * elapsed) / rampTicks);
+      }
+    setDriveGate(phase < duty, dir);
+    phase = (phase + 1) & 15;
+    }
+  setDriveGate(0 != toDuty16, dir);
+  }
+
+// Turn on the drive for dir, with the soft-start ramp if starting from stopped and one is set.
+// Returns the part of maxRunTicks left after any ramp.
+uint8_t ValveMotorDirectV1HardwareDriverBase::startDrive(const uint8_t maxRunTicks, const uint8_t prevDir, const OTRadValve::HardwareMotorDriverInterface::motor_drive dir, OTRadValve::HardwareMotorDriverInterfaceCallbackHandler &callback)
+  {
+  const uint8_t ramp = softStart.startRampTicks;
+  if((HardwareMotorDriverInterface::motorOff != prevDir) || (0 == ramp))
+    {
+    setDriveGate(true, dir);
+    return(maxRunTicks);
+    }
+  rampDrive(ramp, softStart.startDuty16, 16, dir, callback);
+  return((maxRunTicks > ramp) ? (uint8_t)(maxRunTicks - ramp) : 0);
+  }
+
+// Ramp the drive down before stopping from running in prevDir, if a soft-stop is set.
+// Skipped if the motor was stopped by high current, eg at an end-stop,
+// as there is no movement to ease and the stall current would be wasted.
+void ValveMotorDirectV1HardwareDriverBase::stopDrive(const uint8_t prevDir, OTRadValve::HardwareMotorDriverInterfaceCallbackHandler &callback)
+  {
+  if((HardwareMotorDriverInterface::motorOff == prevDir) || (0 == softStart.stopRampTicks) || lastSpinCurrentHigh) { return; }
+  rampDrive(softStart.stopRampTicks, 16, 0, (OTRadValve::HardwareMotorDriverInterface::motor_drive)prevDir, callback);
+  }
 #endif // ValveMotorDirectV1HardwareDriverBase_DEFINED
 
 
@@ -44,7 +44,79 @@ class ValveMotorDirectV1HardwareDriverBase : public OTRadValve::HardwareMotorDri
     // Min sub-cycle ticks to run up.
     static const uint8_t minMotorRunupTicks = max(1, minMotorRunupMS / OTV0P2BASE::SUBCYCLE_TICK_MS_RD);
 
+    // If true, idle the CPU at low power between sub-cycle tick checks
+    // and current samples while the motor runs, rather than spinning flat out.
+    // Samples current roughly once per millisecond rather than back-to-back,
+    // which still gives several samples per sub-cycle tick.
+    // Defaults to false.
+    void setLowPowerSpin(const bool lowPower) { lowPowerSpin = lowPower; }
+    bool isLowPowerSpin() const { return(lowPowerSpin); }
+
+    // If true, and supported by the driver, detect high motor current
+    // with a free-running ADC watch (OTV0P2BASE::analogueThresholdWatchStart())
+    // flagged from its interrupt, rather than a full ADC read per poll.
+    // The end-stop is then seen within one conversion,
+    // and with lowPowerSpin the CPU sleeps between conversions.
+    // Defaults to false.
+    void setInterruptCurrentSense(const bool interrupt) { interruptCurrentSense = interrupt; }
+    bool isInterruptCurrentSense() const { return(interruptCurrentSense); }
+
+    // Soft-start/-stop profile for the motor drive,
+    // to limit the inrush current that can look like an end-stop
+    // and sag a weak battery.
+    // The drive is pulse-width modulated in software
+    // by gating one side of the H-bridge while the CPU spins,
+    // so needs no timer or PWM-capable pins.
+    // No current samples are taken during a ramp.
+    //   * startRampTicks  sub-cycle ticks to ramp up to full drive
+    //     when starting from stopped; zero for none (the default)
+    //   * stopRampTicks  sub-cycle ticks to ramp down to no drive
+    //     before stopping, unless stopped by high current; zero for none (the default)
+    //   * startDuty16  initial duty cycle in 16ths at the start of a soft-start, in [1,16]
+    struct SoftStartProfile final
+      {
+      uint8_t startRampTicks;
+      uint8_t stopRampTicks;
+      uint8_t startDuty16;
+      };
+    void setSoftStart(const SoftStartProfile &profile) { softStart = profile; }
+    const SoftStartProfile &getSoftStart() const { return(softStart); }
+
   protected:
+    // If true, idle at low power between samples in spinSCTTicks().
+    bool lowPowerSpin = false;
+    // If true, use startCurrentWatch() where supported in spinSCTTicks().
+    bool interruptCurrentSense = false;
+
+    // Start an OTV0P2BASE::analogueThresholdWatchStart() of motor current
+    // at the isCurrentHigh() level for dir, returning true if done.
+    // The default does nothing and returns false, ie not supported.
+    virtual bool startCurrentWatch(OTRadValve::HardwareMotorDriverInterface::motor_drive /*dir*/) { return(false); }
+    // Soft-start/-stop profile; defaults to none.
+    SoftStartProfile softStart = { 0, 0, 16 };
+    // True if the last spinSCTTicks() aborted on high current.
+    bool lastSpinCurrentHigh = false;
+
+    // Turn the drive to the motor on or off while set up to run in dir,
+    // without changing direction, for software PWM; must be fast.
+    // Must never put the H-bridge in an unsafe state.
+    virtual void setDriveGate(bool on, OTRadValve::HardwareMotorDriverInterface::motor_drive dir) = 0;
+
+    // Ramp the drive duty cycle linearly from fromDuty16 to toDuty16 (in 16ths)
+    // over rampTicks sub-cycle ticks, via setDriveGate(), without sampling current.
+    // Ticks are signalled to the callback as the motor is assumed to be moving in dir.
+    // Stops early near the end of the sub-cycle, as spinSCTTicks() would.
+    // Leaves the drive fully on if toDuty16 is non-zero, else off.
+    void rampDrive(uint8_t rampTicks, uint8_t fromDuty16, uint8_t toDuty16, OTRadValve::HardwareMotorDriverInterface::motor_drive dir, OTRadValve::HardwareMotorDriverInterfaceCallbackHandler &callback);
+
+    // Turn on the drive for dir once the H-bridge is set up,
+    // with the soft-start ramp if starting from stopped (prevDir off) and one is set.
+    // Returns the part of maxRunTicks left after any ramp.
+    uint8_t startDrive(uint8_t maxRunTicks, uint8_t prevDir, OTRadValve::HardwareMotorDriverInterface::motor_drive dir, OTRadValve::HardwareMotorDriverInterfaceCallbackHandler &callback);
+    // Ramp the drive down before stopping from running in prevDir,
+    // if a soft-stop is set and the last run did not end on high current.
+    void stopDrive(uint8_t prevDir, OTRadValve::HardwareMotorDriverInterfaceCallbackHandler &callback);
+
     // Spin for up to the specified number of SCT ticks, monitoring current and position encoding.
     //   * maxRunTicks  maximum sub-cycle ticks to attempt to run/spin for); strictly positive
     //   * minTicksBeforeAbort  minimum ticks before abort for end-stop / high-current,
@@ -114,6 +114,9 @@ OTV0P2BASE::serialPrintlnAndFlush();
     // This may help to correctly allow for (eg) position encoding inputs while a motor is slowing.
     const uint8_t prev_dir = last_dir;
 
+    if(motorOff != dir) { OT_POWER_ON(OTV0P2BASE::PowerDomain::MOTOR); }
+    else { OT_POWER_OFF(OTV0P2BASE::PowerDomain::MOTOR); }
+
     // Impossible to short the DRV8850 due to internal protection circuits.
     switch(dir)
       {
@@ -127,10 +130,11 @@ OTV0P2BASE::serialPrintlnAndFlush();
 		// Let H-bridge respond and settle, and motor slow down if changing direction.
 		// Otherwise there is a risk of browning out the device with a big current surge.
 		if(prev_dir != dir) { OTV0P2BASE::nap(WDTO_120MS); } // Enforced low-power sleep on change of direction....
-		fastDigitalWrite(MOTOR_DRIVE_MR_DigitalPin, HIGH); // Run motor
+		// Run motor, possibly ramping up.
+		const uint8_t runTicks = startDrive(maxRunTicks, prev_dir, dir, callback);
 
 		// Let H-bridge respond and settle and let motor run up.
-		spinSCTTicks(max(maxRunTicks, minMotorRunupTicks), minMotorRunupTicks, dir, callback);
+		spinSCTTicks(max(runTicks, minMotorRunupTicks), minMotorRunupTicks, dir, callback);
 		break; // Fall through to common case.
         }
 
@@ -144,16 +148,19 @@ OTV0P2BASE::serialPrintlnAndFlush();
 		// Let H-bridge respond and settle, and motor slow down if changing direction.
 		// Otherwise there is a risk of browning out the device with a big current surge.
 		if(prev_dir != dir) { OTV0P2BASE::nap(WDTO_120MS); } // Enforced low-power sleep on change of direction....
-		fastDigitalWrite(MOTOR_DRIVE_ML_DigitalPin, HIGH); // Run motor
+		// Run motor, possibly ramping up.
+		const uint8_t runTicks = startDrive(maxRunTicks, prev_dir, dir, callback);
 
 		// Let H-bridge respond and settle and let motor run up.
-		spinSCTTicks(max(maxRunTicks, minMotorRunupTicks), minMotorRunupTicks, dir, callback);
+		spinSCTTicks(max(runTicks, minMotorRunupTicks), minMotorRunupTicks, dir, callback);
         break; // Fall through to common case.
         }
 
     case motorOff: default: // Explicit off, and default for safety.
     {
         // Everything off, unconditionally.
+        // Ease the motor down first if a soft-stop is set.
+        stopDrive(prev_dir, callback);
         // Motor is automatically stopped in sleep mode.
 		fastDigitalWrite(nSLEEP, LOW);
 		// Pull motor lines low to minimise current consumption (DRV8850 inputs are pulled low).
@@ -178,6 +185,25 @@ OTV0P2BASE::serialPrintlnAndFlush();
     // Record new direction.
     last_dir = dir;
     }
+
+protected:
+  // Watch motor current from the ADC interrupt at the isCurrentHigh() threshold.
+  virtual bool startCurrentWatch(const OTRadValve::HardwareMotorDriverInterface::motor_drive mdir)
+    {
+    const uint16_t miHigh = (OTRadValve::HardwareMotorDriverInterface::motorDriveClosing == mdir) ?
+        maxCurrentReadingClosing : maxCurrentReadingOpening;
+    OTV0P2BASE::analogueThresholdWatchStart((uint8_t)((INTERNAL << 6) | (MOTOR_DRIVE_MI_AIN_DigitalPin & 7)), miHigh);
+    return(true);
+    }
+
+  // Gate the driven input for soft-start PWM; both inputs LOW lets the motor coast.
+  virtual void setDriveGate(const bool on, const OTRadValve::HardwareMotorDriverInterface::motor_drive dir)
+    {
+    if(motorDriveClosing == dir)
+      { if(on) { fastDigitalWrite(MOTOR_DRIVE_MR_DigitalPin, HIGH); } else { fastDigitalWrite(MOTOR_DRIVE_MR_DigitalPin, LOW); } }
+    else if(motorDriveOpening == dir)
+      { if(on) { fastDigitalWrite(MOTOR_DRIVE_ML_DigitalPin, HIGH); } else { fastDigitalWrite(MOTOR_DRIVE_ML_DigitalPin, LOW); } }
+    }
 };
 
 // Actuator/driver for direct local (radiator) valve motor control.
@@ -228,6 +254,14 @@ class DRV8850Driver final : public OTRadValve::AbstractRadValve
     // Returns true if in an error state,
     virtual bool isInErrorState() const { return(logic.isInErrorState()); }
 
+    // If true, idle at low power between current samples while the motor runs.
+    // See ValveMotorDirectV1HardwareDriverBase::setLowPowerSpin().
+    void setLowPowerSpin(const bool lowPower) { driver.setLowPowerSpin(lowPower); }
+
+    // Set the motor soft-start/-stop profile.
+    // See ValveMotorDirectV1HardwareDriverBase::setSoftStart().
+    void setSoftStart(const ValveMotorDirectV1HardwareDriverBase::SoftStartProfile &profile) { driver.setSoftStart(profile); }
+
     // Minimally wiggles the motor to give tactile feedback and/or show to be working.
     // May take a significant fraction of a second.
     // Finishes with the motor turned off, and a bias to closing the valve.
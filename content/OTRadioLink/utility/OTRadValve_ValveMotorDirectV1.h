@@ -126,6 +126,9 @@ OTV0P2BASE::serialPrintlnAndFlush();
       // This may help to correctly allow for (eg) position encoding inputs while a motor is slowing.
       const uint8_t prev_dir = last_dir;
 
+      if(motorOff != dir) { OT_POWER_ON(OTV0P2BASE::PowerDomain::MOTOR); }
+      else { OT_POWER_OFF(OTV0P2BASE::PowerDomain::MOTOR); }
+
       // *** MUST NEVER HAVE L AND R LOW AT THE SAME TIME else board may be destroyed at worst. ***
       // Operates as quickly as reasonably possible,
       // eg to move to stall detection quickly...
@@ -145,9 +148,10 @@ OTV0P2BASE::serialPrintlnAndFlush();
           // Otherwise there is a risk of browning out the device with a big current surge.
           if(prev_dir != dir) { OTV0P2BASE::nap(WDTO_120MS); } // Enforced low-power sleep on change of direction....
           pinMode(MOTOR_DRIVE_MR_DigitalPin, OUTPUT); // Ensure that the LOW side is an output.
-          fastDigitalWrite(MOTOR_DRIVE_MR_DigitalPin, LOW); // Pull LOW last.
+          // Pull LOW last, possibly ramping up.
+          const uint8_t runTicks = startDrive(maxRunTicks, prev_dir, dir, callback);
           // Let H-bridge respond and settle and let motor run up.
-          spinSCTTicks(max(maxRunTicks, minMotorRunupTicks), minMotorRunupTicks, dir, callback);
+          spinSCTTicks(max(runTicks, minMotorRunupTicks), minMotorRunupTicks, dir, callback);
           break; // Fall through to common case.
           }
 
@@ -162,9 +166,10 @@ OTV0P2BASE::serialPrintlnAndFlush();
           // Otherwise there is a risk of browning out the device with a big current surge.
           if(prev_dir != dir) { OTV0P2BASE::nap(WDTO_120MS); } // Enforced low-power sleep on change of direction....
           pinMode(MOTOR_DRIVE_ML_DigitalPin, OUTPUT); // Ensure that the LOW side is an output.
-          fastDigitalWrite(MOTOR_DRIVE_ML_DigitalPin, LOW); // Pull LOW last.
+          // Pull LOW last, possibly ramping up.
+          const uint8_t runTicks = startDrive(maxRunTicks, prev_dir, dir, callback);
           // Let H-bridge respond and settle and let motor run up.
-          spinSCTTicks(max(maxRunTicks, minMotorRunupTicks), minMotorRunupTicks, dir, callback);
+          spinSCTTicks(max(runTicks, minMotorRunupTicks), minMotorRunupTicks, dir, callback);
           break; // Fall through to common case.
           }
 
@@ -172,6 +177,8 @@ OTV0P2BASE::serialPrintlnAndFlush();
           {
           // Everything off, unconditionally.
           //
+          // Ease the motor down first if a soft-stop is set.
+          stopDrive(prev_dir, callback);
           // Turn one side of bridge off ASAP.
           fastDigitalWrite(MOTOR_DRIVE_MR_DigitalPin, HIGH); // Belt and braces force pin logical output state high.
           pinMode(MOTOR_DRIVE_MR_DigitalPin, INPUT_PULLUP); // Switch to weak pull-up; slow but possibly marginally safer.
@@ -194,6 +201,26 @@ OTV0P2BASE::serialPrintlnAndFlush();
       // Record new direction.
       last_dir = dir;
       }
+
+  protected:
+    // Watch motor current from the ADC interrupt at the isCurrentHigh() threshold.
+    virtual bool startCurrentWatch(const OTRadValve::HardwareMotorDriverInterface::motor_drive mdir)
+      {
+      const uint16_t miHigh = (OTRadValve::HardwareMotorDriverInterface::motorDriveClosing == mdir) ?
+          maxCurrentReadingClosing : maxCurrentReadingOpening;
+      OTV0P2BASE::analogueThresholdWatchStart((uint8_t)((INTERNAL << 6) | (MOTOR_DRIVE_MI_AIN_DigitalPin & 7)), miHigh);
+      return(true);
+      }
+
+    // Gate the LOW side of the bridge for soft-start PWM;
+    // the HIGH side stays HIGH so L and R are never both LOW.
+    virtual void setDriveGate(const bool on, const OTRadValve::HardwareMotorDriverInterface::motor_drive dir)
+      {
+      if(motorDriveClosing == dir)
+        { if(on) { fastDigitalWrite(MOTOR_DRIVE_MR_DigitalPin, LOW); } else { fastDigitalWrite(MOTOR_DRIVE_MR_DigitalPin, HIGH); } }
+      else if(motorDriveOpening == dir)
+        { if(on) { fastDigitalWrite(MOTOR_DRIVE_ML_DigitalPin, LOW); } else { fastDigitalWrite(MOTOR_DRIVE_ML_DigitalPin, HIGH); } }
+      }
   };
 
 // Actuator/driver for direct local (radiator) valve motor control.
@@ -206,13 +233,17 @@ OTV0P2BASE::serialPrintlnAndFlush();
 //     can be NULL
 //   * binaryOnly  if true, use simplified valve control logic
 //     that only aims for fully open or closed
+//   * calStoreOpt  non-volatile store for calibration data
+//     to allow faster warm restarts, eg an EEPROMValveCalibrationStore;
+//     can be NULL
 #define ValveMotorDirectV1_DEFINED
 template
     <
     template<uint8_t, uint8_t, uint8_t, uint8_t, uint8_t> class ValveMotorDirectV1HardwareDriver_t,
     uint8_t MOTOR_DRIVE_ML_DigitalPin, uint8_t MOTOR_DRIVE_MR_DigitalPin, uint8_t MOTOR_DRIVE_MI_AIN_DigitalPin, uint8_t MOTOR_DRIVE_MC_AIN_DigitalPin, uint8_t MOTOR_DRIVE_NSLEEP_DigitalPin = MOTOR_DRIVE_NSLEEP_UNUSED,
     class LowBatt_t = OTV0P2BASE::SupplyVoltageLow, LowBatt_t *lowBattOpt = NULL,
-    bool binaryOnly = false
+    bool binaryOnly = false,
+    class CalStore_t = ValveCalibrationStoreBase, CalStore_t *calStoreOpt = NULL
     >
 class ValveMotorDirectV1 : public OTRadValve::AbstractRadValve
   {
@@ -240,7 +271,7 @@ class ValveMotorDirectV1 : public OTRadValve::AbstractRadValve
          OTRadValve::CurrentSenseValveMotorDirect::computeSctAbsLimit(OTV0P2BASE::SUBCYCLE_TICK_MS_RD,
                                                                       OTV0P2BASE::GSCT_MAX,
                                                                       ValveMotorDirectV1HardwareDriverBase::minMotorRunupTicks),
-        lowBattOpt, minimiseActivityOpt)
+        lowBattOpt, minimiseActivityOpt, calStoreOpt)
 //        minOpenPC, fairlyOpenPC)
       { }
 
@@ -286,6 +317,16 @@ class ValveMotorDirectV1 : public OTRadValve::AbstractRadValve
     virtual bool isControlledValveReallyOpen() const override
       { return(logic.isControlledValveReallyOpen()); }
 
+    // If true, idle at low power between current samples while the motor runs.
+    // See ValveMotorDirectV1HardwareDriverBase::setLowPowerSpin().
+    void setLowPowerSpin(const bool lowPower)
+      { driver.setLowPowerSpin(lowPower); }
+
+    // Set the motor soft-start/-stop profile.
+    // See ValveMotorDirectV1HardwareDriverBase::setSoftStart().
+    void setSoftStart(const ValveMotorDirectV1HardwareDriverBase::SoftStartProfile &profile)
+      { driver.setSoftStart(profile); }
+
     // Minimally wiggles the motor to give tactile feedback and/or show to be working.
     // May take a significant fraction of a second.
     // Finishes with the motor turned off,
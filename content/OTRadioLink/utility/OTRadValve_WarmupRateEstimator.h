@@ -0,0 +1,137 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Learned room warm-up rate, to start pre-warming ahead of WARM periods
+ just early enough to reach the target on time.
+ */
+
+#ifndef ARDUINO_LIB_OTRADVALVE_WARMUPRATEESTIMATOR_H
+#define ARDUINO_LIB_OTRADVALVE_WARMUPRATEESTIMATOR_H
+
+#include <stdint.h>
+
+#include "OTV0P2BASE_Stats.h"
+#include "OTV0P2BASE_Util.h"
+#include "OTRadValve_Parameters.h"
+#include "OTRadValve_SimpleValveSchedule.h"
+
+namespace OTRadValve
+{
+
+// Learns how fast the room warms with the valve open,
+// from the hourly temperature samples in the by-hour stats,
+// and from that how long before a WARM period heating should start.
+//
+// Call tickMinute() once per minute with the current valve position,
+// and endOfHour() just after each hourly stats sample has been taken.
+// An hour in which the valve was open at least DEFAULT_VALVE_PC_SAFER_OPEN
+// for most of the hour counts as a warm-up sample.
+// The learned rate is a slow-moving average so that one odd hour
+// (eg a window left open) does not dominate.
+//
+// Memory footprint is 2 bytes; not persisted, so relearns after a restart.
+class WarmupRateEstimator final
+    {
+    public:
+        // Minimum minutes open in an hour for it to count as warming.
+        static constexpr uint8_t MIN_OPEN_MINS = 45;
+        // Maximum pre-warm lead time in minutes.
+        // While the rate is not yet known no lead time is predicted,
+        // leaving only the schedule's own fixed pre-warm.
+        static constexpr uint8_t MAX_LEAD_MINS = 240;
+        // Slowest rate learned (C*16 per hour); an open valve with no rise counts as this.
+        static constexpr uint8_t MIN_RATE_C16_PER_H = 2;
+
+    private:
+        // Learned warm-up rate in C*16 per hour; 0 if not yet known.
+        uint8_t rateC16PerH = 0;
+        // Minutes in the current hour with the valve significantly open.
+        uint8_t openMins = 0;
+
+    public:
+        // Note the valve position for this minute.
+        void tickMinute(const uint8_t valvePCOpen)
+            { if((valvePCOpen >= DEFAULT_VALVE_PC_SAFER_OPEN) && (openMins < 255)) { ++openMins; } }
+
+        // Learn from the hour just ended, hh, given the by-hour stats
+        // with the temperature for hh freshly sampled.
+        // Hours without valid samples for hh and the hour before are ignored.
+        void endOfHour(const OTV0P2BASE::NVByHourByteStatsBase &stats, const uint8_t hh)
+            {
+            const bool warming = (openMins >= MIN_OPEN_MINS);
+            openMins = 0;
+            if(!warming || (hh >= 24)) { return; }
+            const uint8_t prevHH = (0 == hh) ? 23 : (hh - 1);
+            const uint8_t t0 = stats.getByHourStatSimple(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_TEMP_BY_HOUR, prevHH);
+            const uint8_t t1 = stats.getByHourStatSimple(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_TEMP_BY_HOUR, hh);
+            if((OTV0P2BASE::NVByHourByteStatsBase::UNSET_BYTE == t0) ||
+               (OTV0P2BASE::NVByHourByteStatsBase::UNSET_BYTE == t1)) { return; }
+            const int16_t rise = OTV0P2BASE::expandTempC16(t1) - OTV0P2BASE::expandTempC16(t0);
+            const uint8_t sample = (uint8_t)OTV0P2BASE::fnconstrain(rise, (int16_t)MIN_RATE_C16_PER_H, (int16_t)255);
+            // First sample is taken as-is, then moves 1/4 of the way each time.
+            rateC16PerH = (0 == rateC16PerH) ? sample :
+                (uint8_t)((3U * rateC16PerH + sample + 2) / 4);
+            }
+
+        // Get the learned warm-up rate in C*16 per hour; 0 if not yet known.
+        uint8_t getRateC16PerH() const { return(rateC16PerH); }
+        // Forget the learned rate, eg if the valve is moved to another room.
+        void reset() { rateC16PerH = 0; openMins = 0; }
+
+        // Minutes needed to warm from roomTempC16 to targetC at the learned rate,
+        // capped at MAX_LEAD_MINS; 0 if already warm enough or the rate is not yet known.
+        uint8_t getLeadMins(const int16_t roomTempC16, const uint8_t targetC) const
+            {
+            const int16_t shortfallC16 = (int16_t)(targetC << 4) - roomTempC16;
+            if((0 == rateC16PerH) || (shortfallC16 <= 0)) { return(0); }
+            const uint32_t mins = (60U * (uint32_t)shortfallC16 + rateC16PerH - 1) / rateC16PerH;
+            return((uint8_t)OTV0P2BASE::fnmin(mins, (uint32_t)MAX_LEAD_MINS));
+            }
+
+        // True if heating should start now to reach targetC by the next scheduled WARM period,
+        // ie a schedule comes on within the predicted lead time,
+        // and that is earlier than the schedule's own fixed pre-pre-warm.
+        //   * mm  minutes from midnight (usually local time)
+        bool isPreWarmDue(const SimpleValveScheduleBase &schedule, const uint_least16_t mm,
+                          const int16_t roomTempC16, const uint8_t targetC) const
+            {
+            const uint8_t lead = getLeadMins(roomTempC16, targetC);
+            if(lead <= SimpleValveScheduleParams::PREPREWARM_MINS) { return(false); }
+            return(schedule.isAnyScheduleOnWARMWithin(mm, lead));
+            }
+
+        // True if heating should start now to reach targetC by the start of the next hour
+        // when that hour is usually occupied (smoothed occupancy at least 50%).
+        //   * hh  current hour [0,23]
+        //   * minsLeft  minutes left until the next hour [1,60]
+        bool isOccupancyPreWarmDue(const OTV0P2BASE::NVByHourByteStatsBase &stats,
+                                   const uint8_t hh, const uint8_t minsLeft,
+                                   const int16_t roomTempC16, const uint8_t targetC) const
+            {
+            if(hh >= 24) { return(false); }
+            const uint8_t nextHH = (23 == hh) ? 0 : (hh + 1);
+            const uint8_t occ = stats.getByHourStatSimple(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED, nextHH);
+            if((OTV0P2BASE::NVByHourByteStatsBase::UNSET_BYTE == occ) || (occ < 50)) { return(false); }
+            return(getLeadMins(roomTempC16, targetC) >= minsLeft);
+            }
+    };
+
+}
+
+#endif
@@ -0,0 +1,185 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * Compile-time composable quick RX frame filters for use in the radio RX ISR.
+ *
+ * Each filter stage is a type with a static apply() routine
+ * with the same signature and semantics as quickFrameFilter_t;
+ * FrameFilterChain<...>::filter runs the stages in order
+ * and can be passed to OTRadioLink::setFilterRXISR().
+ *
+ * For example, to accept only secureable 'O' frames from associated nodes:
+ *     static NodeIDPrefixCache<4> ids;
+ *     typedef FrameFilterChain<
+ *         FrameFilterMinLength<4>,
+ *         FrameFilterSecureableType<FTS_BasicSensorOrValve>,
+ *         FrameFilterSecureableIDPrefix<NodeIDPrefixCache<4>, ids> > myFilter;
+ *     radio.setFilterRXISR(myFilter::filter);
+ *
+ * Keywords: C++ embedded Arduino radio RX filter ISR template
+ */
+
+#ifndef ARDUINO_LIB_OTRADIOLINK_FRAMEFILTER_H
+#define ARDUINO_LIB_OTRADIOLINK_FRAMEFILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "OTV0P2BASE_Concurrency.h"
+#include "OTV0P2BASE_Security.h"
+#include "OTRadioLink_OTRadioLink.h"
+
+// Use namespaces to help avoid collisions.
+namespace OTRadioLink
+    {
+    // Run a sequence of filter stages in order, rejecting the frame as soon as any stage does.
+    // Each stage sees the (possibly reduced) frame length from the previous stage.
+    // The chain as a whole should inline down to a single small routine.
+    template<class... Stages> struct FrameFilterChain;
+    // Empty chain accepts everything.
+    template<> struct FrameFilterChain<>
+        {
+        static inline bool apply(const volatile uint8_t *, volatile uint8_t &) { return(true); }
+        static bool filter(const volatile uint8_t *, volatile uint8_t &) { return(true); }
+        };
+    template<class First, class... Rest> struct FrameFilterChain<First, Rest...>
+        {
+        // Allows chains to be nested as stages of other chains.
+        static inline bool apply(const volatile uint8_t *const buf, volatile uint8_t &buflen)
+            { return(First::apply(buf, buflen) && FrameFilterChain<Rest...>::apply(buf, buflen)); }
+        // Entry point of type quickFrameFilter_t to pass to setFilterRXISR().
+        static bool filter(const volatile uint8_t *const buf, volatile uint8_t &buflen)
+            { return(apply(buf, buflen)); }
+        };
+
+    // Reject frames shorter than minLen bytes.
+    template<uint8_t minLen> struct FrameFilterMinLength
+        {
+        static inline bool apply(const volatile uint8_t *, volatile uint8_t &buflen)
+            { return(buflen >= minLen); }
+        };
+
+    // Compile-time test for membership of a list of byte values.
+    template<uint8_t... values> struct FrameFilterByteIn;
+    template<> struct FrameFilterByteIn<>
+        { static constexpr bool match(const uint8_t) { return(false); } };
+    template<uint8_t first, uint8_t... rest> struct FrameFilterByteIn<first, rest...>
+        { static constexpr bool match(const uint8_t b) { return((b == first) || FrameFilterByteIn<rest...>::match(b)); } };
+
+    // Accept only frames with one of the listed leading bytes,
+    // eg FrameType_V0p2_FS20 values for non-secureable V0p2 frames.
+    template<uint8_t... types> struct FrameFilterLeadingByte
+        {
+        static inline bool apply(const volatile uint8_t *const buf, volatile uint8_t &buflen)
+            { return((0 != buflen) && FrameFilterByteIn<types...>::match(buf[0])); }
+        };
+
+    // Accept only secureable frames of one of the listed types (secure bit ignored),
+    // eg FrameType_Secureable values.
+    // The frame type is in the byte after the leading frame-length byte.
+    template<uint8_t... types> struct FrameFilterSecureableType
+        {
+        static inline bool apply(const volatile uint8_t *const buf, volatile uint8_t &buflen)
+            { return((buflen >= 2) && FrameFilterByteIn<types...>::match(buf[1] & 0x7f)); }
+        };
+
+    // Trim all but the first trailing zero; never rejects a frame.
+    struct FrameFilterTrimTrailingZeros
+        {
+        static inline bool apply(const volatile uint8_t *const buf, volatile uint8_t &buflen)
+            { return(frameFilterTrailingZeros(buf, buflen)); }
+        };
+
+    // Adapt an existing quickFrameFilter_t routine for use as a stage.
+    template<quickFrameFilter_t *f> struct FrameFilterFn
+        {
+        static inline bool apply(const volatile uint8_t *const buf, volatile uint8_t &buflen)
+            { return(f(buf, buflen)); }
+        };
+
+    // ISR-safe RAM copy of leading ID bytes of associated nodes for fast RX filtering.
+    // The node association table itself is (eg) in EEPROM so cannot be read from an ISR;
+    // load() must be called from the main loop at start-up and after any change to the table.
+    // Held as a sorted OTV0P2BASE::NodeIDPrefixIndex, as for secure RX lookup,
+    // so matching is a binary search;
+    // the ISR sees no entries while load() is rebuilding it.
+    //   * maxIDs  maximum number of IDs held
+    //   * prefixLen  number of leading ID bytes held/matched [1,8]
+    template<uint8_t maxIDs, uint8_t prefixLen = 2>
+    class NodeIDPrefixCache final
+        {
+        private:
+            OTV0P2BASE::NodeIDPrefixIndex<uint8_t, maxIDs, prefixLen> index;
+            // Number of IDs visible to matches(); 0 while (re)loading.
+            OTV0P2BASE::Atomic_UInt8T nIDs;
+
+        public:
+            static_assert((prefixLen >= 1) && (prefixLen <= 8), "bad prefixLen");
+            constexpr NodeIDPrefixCache() : index(), nIDs(0) { }
+
+            // Number of IDs held.
+            inline uint8_t size() const { return(nIDs.load()); }
+
+            // Remove all IDs; no frame with an ID will then match.
+            void clear() { nIDs.store(0); }
+
+            // Copy the leading bytes of up to n IDs from the association table.
+            // Stops at the first empty (0xff-leading, ie erased) entry,
+            // since all valid associations are contiguous at the start of the table.
+            // Returns the number of IDs loaded.
+            uint8_t load(const OTV0P2BASE::NodeAssociationTableBase &table, const uint8_t n)
+                {
+                // Hide the update from the ISR while in progress.
+                nIDs.store(0);
+                const uint8_t i = index.build(table, n);
+                nIDs.store(i);
+                return(i);
+                }
+
+            // True if the given ID (or its first il bytes if shorter) matches a held prefix.
+            // Anonymous (zero-length) IDs never match.
+            // ISR-safe.
+            bool matches(const volatile uint8_t *const id, const uint8_t il) const
+                {
+                if((0 == il) || (0 == nIDs.load())) { return(false); }
+                const uint8_t len = (il < prefixLen) ? il : prefixLen;
+                uint8_t key[prefixLen];
+                for(uint8_t j = 0; j < len; ++j) { key[j] = id[j]; }
+                return(index.hasKeyPrefix(key, len));
+                }
+        };
+
+    // Accept only secureable frames whose (leading) header ID matches an entry in the given cache,
+    // eg a NodeIDPrefixCache loaded from the node association table.
+    // The cache must have static storage duration.
+    template<class Cache, const Cache &cache> struct FrameFilterSecureableIDPrefix
+        {
+        static inline bool apply(const volatile uint8_t *const buf, volatile uint8_t &buflen)
+            {
+            // Need fl, type and seq/il bytes.
+            if(buflen < 3) { return(false); }
+            const uint8_t il = buf[2] & 0xf;
+            // The whole ID must be within the received frame.
+            if(buflen < 3 + il) { return(false); }
+            return(cache.matches(buf + 3, il));
+            }
+        };
+    }
+
+#endif
@@ -0,0 +1,139 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Compact framed binary hub-to-gateway serial output,
+ * an alternative to the text of outputJSONStats(), outputCoreStats()
+ * and printRXMsg() when a gateway is attached to the hub UART.
+ *
+ * Each record is:
+ *     SYNC len type idLen id[idLen] rssi body[] crcLo crcHi
+ * where
+ *   * SYNC is HUB_BINARY_SYNC, to resynchronise after loss
+ *   * len is the number of bytes from type to the end of body
+ *   * type is a HubBinaryType
+ *   * idLen is the node ID bytes that follow [0,8]; 0 if the ID is in the body
+ *   * rssi is the raw RX signal strength, or HUB_BINARY_RSSI_UNKNOWN
+ *   * crc is CRC-16/MODBUS (crc16_A001_update() from 0xffff) over len to the end of body.
+ *
+ * A relayed 64-byte frame costs 70 bytes rather than ~135 characters as text,
+ * and a decoded stats record roughly half its JSON line,
+ * with no parsing of text at the gateway.
+ * The matching decoder is OTGW::HubBinaryDecoder in portableGateway/Gateway.h.
+ *
+ * Portable.
+ */
+
+#ifndef ARDUINO_LIB_OTRADIOLINK_HUBBINARYOUTPUT_H
+#define ARDUINO_LIB_OTRADIOLINK_HUBBINARYOUTPUT_H
+
+#include <stdint.h>
+#include <OTV0p2Base.h>
+
+#include "OTRadioLink_SecureableFrameType.h"
+
+// Use namespaces to help avoid collisions.
+namespace OTRadioLink
+    {
+    // Start-of-record marker.
+    static constexpr uint8_t HUB_BINARY_SYNC = 0xa5;
+    // RSSI value when not known.
+    static constexpr int8_t HUB_BINARY_RSSI_UNKNOWN = -128;
+    // Largest len field: type, idLen, a full ID, rssi and a 64-byte body.
+    static constexpr uint8_t HUB_BINARY_MAX_LEN = 3 + OTV0P2BASE::OpenTRV_Node_ID_Bytes + 64;
+
+    // Record types.
+    enum HubBinaryType : uint8_t
+        {
+        // Raw RX frame as queued, eg for a gateway to authenticate and decrypt; idLen is 0.
+        HBT_RAW_FRAME = 'R',
+        // Decoded secure 'O' frame: body is the sequence number then the plaintext body,
+        // as passed to serialFrameOperation(); the full node ID is given.
+        HBT_DECODED_O = 'O',
+        // JSON stats text as from outputJSONStats(), without the line ending.
+        HBT_JSON = 'J'
+        };
+
+    // Write one record to p; returns false (writing nothing) if an argument is out of range.
+    // The body may be split in two parts (body2 may be NULL when body2Len is 0)
+    // to avoid copying, eg a sequence number and a plaintext body.
+    inline bool outputHubBinary(Print &p, const uint8_t type,
+                                const uint8_t *const id, const uint8_t idLen, const int8_t rssi,
+                                const uint8_t *const body, const uint8_t bodyLen,
+                                const uint8_t *const body2 = NULL, const uint8_t body2Len = 0)
+        {
+        const uint16_t len = 3U + idLen + bodyLen + body2Len;
+        if((idLen > OTV0P2BASE::OpenTRV_Node_ID_Bytes) || (len > HUB_BINARY_MAX_LEN) ||
+           ((NULL == id) && (0 != idLen)) || ((NULL == body) && (0 != bodyLen)) || ((NULL == body2) && (0 != body2Len)))
+            { return(false); }
+        const uint8_t hdr[] = { HUB_BINARY_SYNC, uint8_t(len), type, idLen };
+        uint16_t crc = OTV0P2BASE::crc16_A001_buf(0xffff, hdr + 1, sizeof(hdr) - 1);
+        crc = OTV0P2BASE::crc16_A001_buf(crc, id, idLen);
+        crc = OTV0P2BASE::crc16_A001_update(crc, uint8_t(rssi));
+        crc = OTV0P2BASE::crc16_A001_buf(crc, body, bodyLen);
+        crc = OTV0P2BASE::crc16_A001_buf(crc, body2, body2Len);
+        p.write(hdr, sizeof(hdr));
+        if(0 != idLen) { p.write(id, idLen); }
+        p.write(uint8_t(rssi));
+        if(0 != bodyLen) { p.write(body, bodyLen); }
+        if(0 != body2Len) { p.write(body2, body2Len); }
+        p.write(uint8_t(crc));
+        p.write(uint8_t(crc >> 8));
+        return(true);
+        }
+
+    // Write a raw RXed frame (len bytes, without its length byte), in place of printRXMsg().
+    inline bool outputHubBinaryRawRX(Print &p, const uint8_t *const frame, const uint8_t len,
+                                     const int8_t rssi = HUB_BINARY_RSSI_UNKNOWN)
+        { return((0 != len) && outputHubBinary(p, HBT_RAW_FRAME, NULL, 0, rssi, frame, len)); }
+
+    // Write nul- or '}'|0x80- terminated JSON stats from a buffer of bufsize,
+    // as outputJSONStats() would print them.
+    inline bool outputHubBinaryJSON(Print &p, const uint8_t *const json, const uint8_t bufsize,
+                                    const int8_t rssi = HUB_BINARY_RSSI_UNKNOWN)
+        {
+        for(uint8_t i = 0; i < bufsize; ++i)
+            {
+            if(('}' | 0x80) == json[i]) { const uint8_t e = '}'; return(outputHubBinary(p, HBT_JSON, NULL, 0, rssi, json, i, &e, 1)); }
+            if(('}' == json[i]) && (i + 1 < bufsize) && ('\0' == json[i + 1])) { return(outputHubBinary(p, HBT_JSON, NULL, 0, rssi, json, uint8_t(i + 1))); }
+            }
+        return(false);
+        }
+
+    /**
+     * @brief   As serialFrameOperation, but writing an HBT_DECODED_O record.
+     * @param   p_t: Type of printable object.
+     * @param   p: Reference to printable object, eg Serial; must be the concrete instance.
+     * @param   fd: Decoded frame data.
+     * @retval  False if decryptedBody fails basic validation, else true.
+     */
+    template <typename p_t, p_t &p>
+    bool serialBinaryFrameOperation(const OTDecodeData_T &fd)
+        {
+        const uint8_t * const db = fd.ptext;
+        const uint8_t dbLen = fd.ptextLen;
+        // Same check as serialFrameOperation so that the gateway sees the same frames.
+        if(!((0 != (db[1] & 0x10)) && (dbLen > 3) && ('{' == db[2]))) { return(false); }
+        const uint8_t seq = fd.sfh.getSeq();
+        outputHubBinary(p, HBT_DECODED_O, fd.id, OTV0P2BASE::OpenTRV_Node_ID_Bytes,
+                        HUB_BINARY_RSSI_UNKNOWN, &seq, 1, db, dbLen);
+        return(true);
+        }
+    }
+
+#endif
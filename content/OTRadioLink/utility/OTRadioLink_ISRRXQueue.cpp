@@ -52,6 +52,7 @@ void ISRRXQueueVarLenMsgBase::removeRXMsg()
         oldest = newIndex(o, b[o]);
         --queuedRXedMessageCount;
         }
+    OT_TRACE(OTV0P2BASE::TraceId::RXQ_REMOVED, !isEmpty());
     }
 #else
 // Remove the first (oldest) queued RX message.
@@ -74,10 +75,53 @@ void ISRRXQueueVarLenMsgBase::removeRXMsg()
         oldest = newIndex(o, b[o]);
         --queuedRXedMessageCount;
     }
+    OT_TRACE(OTV0P2BASE::TraceId::RXQ_REMOVED, !isEmpty());
 }
 #endif // ARDUINO_ARCH_AVR
 
 
+// Set (or clear with NULL) storage for occupancy stats, clearing them.
+void ISRRXQueueVarLenMsgBase::setStats(ISRRXQueueStats *const s)
+    {
+    if(NULL != s) { s->clear(); }
+    // Lock out interrupts to ensure that the ISR sees a consistent pointer.
+    OTV0P2BASE::RAII_AtomicBlock lock;
+    stats = s;
+    }
+
+// Sample occupancy for the time-at-full estimate.
+void ISRRXQueueVarLenMsgBase::sampleOccupancy()
+    {
+    // Lock out interrupts so that the queue and stats are consistent.
+    OTV0P2BASE::RAII_AtomicBlock lock;
+    ISRRXQueueStats *const s = stats;
+    if(NULL == s) { return; }
+    ISRRXQueueStats::inc(s->samples);
+    if(_isFull()) { ISRRXQueueStats::inc(s->fullSamples); }
+    const uint_fast16_t used = _bytesUsed();
+    if(used > s->highWaterBytes) { s->highWaterBytes = (uint8_t)OTV0P2BASE::fnmin(used, (uint_fast16_t)255); }
+    }
+
+// Cheap self-check of queue structure.
+bool ISRRXQueueVarLenMsgBase::selfCheck() const
+    {
+    // Lock out interrupts so that the ISR cannot change the queue mid-walk.
+    OTV0P2BASE::RAII_AtomicBlock lock;
+    const uint8_t n = next;
+    uint8_t o = oldest;
+    if((n > lui) || (o > lui)) { return(false); }
+    const uint8_t c = queuedRXedMessageCount;
+    for(uint8_t i = 0; i < c; ++i)
+        {
+        const uint8_t l = b[o];
+        if((0 == l) || (l > mf)) { return(false); }
+        o = newIndex(o, l);
+        // Arriving back at next before the last frame means a bad count.
+        if((o == n) && (i + 1 != c)) { return(false); }
+        }
+    return(o == n);
+    }
+
 #ifdef ISRRXQueueVarLenMsg_VALIDATE
 // Validate state, dumping diagnostics to Print stream and returning false if problems found.
 // Intended for use in debugging only.
@@ -27,12 +27,15 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #ifdef ARDUINO
 #include <Arduino.h>
 #endif
 
 #include "OTV0P2BASE_Util.h"
+#include "OTV0P2BASE_Concurrency.h"
+#include "OTV0P2BASE_Trace.h"
 
 // Use namespaces to help avoid collisions.
 namespace OTRadioLink
@@ -222,6 +225,36 @@ namespace OTRadioLink
                 }
         };
 
+    // Occupancy metrics for an RX queue, for tuning maxRXBytes and targetISRRXMinQueueCapacity per site.
+    // Updated cheaply as frames are queued and removed, and on sampleOccupancy().
+    // The 16-bit counters (and histogram bins) saturate at 0xffff.
+    // Storage is supplied by the application via ISRRXQueueVarLenMsgBase::setStats().
+    struct ISRRXQueueStats final
+        {
+        // Number of frame length histogram bins.
+        static constexpr uint8_t LENGTH_HISTOGRAM_BINS = 8;
+        // Most frames queued at once.
+        uint8_t highWaterMsgs;
+        // Most buffer bytes (including length bytes) in use at any sampleOccupancy().
+        uint8_t highWaterBytes;
+        // Times a queued frame left the queue full, ie with no space for a max-size frame.
+        uint16_t fullEvents;
+        // Occupancy samples taken, and those that found the queue full;
+        // the ratio estimates the fraction of time spent full.
+        uint16_t samples;
+        uint16_t fullSamples;
+        // Counts of frames queued by length, in bins 8 bytes wide, the last also holding all longer frames.
+        uint16_t lengthHistogram[LENGTH_HISTOGRAM_BINS];
+
+        // Map a frame length to a histogram bin index.
+        static constexpr uint8_t lengthBin(const uint8_t len)
+            { return(((len >> 3) >= LENGTH_HISTOGRAM_BINS) ? (LENGTH_HISTOGRAM_BINS - 1) : (len >> 3)); }
+        // Saturating increment for 16-bit counters.
+        static inline void inc(uint16_t &c) { if(0xffff != c) { ++c; } }
+        // Reset all counters to zero.
+        void clear() { memset(this, 0, sizeof(*this)); }
+        };
+
     // N-deep queue that can efficiently store variable-length messages.
     // Total size limited to 256 bytes for efficiency of representation on 8-bit MCU.
     // A frame to be queued can be up to maxRXBytes bytes long.
@@ -243,10 +276,33 @@ namespace OTRadioLink
             // Offsets to the start of the oldest and next entries in buf.
             // When oldest == next then isEmpty(), ie the queue is empty.
             volatile uint8_t oldest, next;
+            // Optional occupancy stats; NULL if not being collected.
+            ISRRXQueueStats *stats;
             // Construct an instance.
             ISRRXQueueVarLenMsgBase(uint8_t maxFrame, volatile uint8_t *bp, uint8_t bsm)
-                : b(bp), mf(maxFrame), bsm1(bsm), lui(bsm - maxFrame), oldest(0), next(0)
+                : b(bp), mf(maxFrame), bsm1(bsm), lui(bsm - maxFrame), oldest(0), next(0), stats(NULL)
                 { }
+            // Bytes in use including length bytes, excluding any space skipped at the wrap.
+            // Walks the queued frames, so not for use in the ISR.
+            // Must be protected against re-entrance, eg by interrupts being blocked before calling.
+            uint_fast16_t _bytesUsed() const
+                {
+                uint_fast16_t used = 0;
+                uint8_t o = oldest;
+                for(uint8_t c = queuedRXedMessageCount; c > 0; --c)
+                    { const uint8_t l = b[o]; used += 1U + l; o = newIndex(o, l); }
+                return(used);
+                }
+            // Update stats (if any) for a newly-queued frame; inline for speed in the ISR.
+            inline void _noteLoaded(const uint8_t frameLen)
+                {
+                ISRRXQueueStats *const s = stats;
+                if(NULL == s) { return; }
+                const uint8_t c = queuedRXedMessageCount;
+                if(c > s->highWaterMsgs) { s->highWaterMsgs = c; }
+                ISRRXQueueStats::inc(s->lengthHistogram[ISRRXQueueStats::lengthBin(frameLen)]);
+                if(_isFull()) { ISRRXQueueStats::inc(s->fullEvents); }
+                }
             // True if the queue is full.
             // True iff _getRXBufForInbound() would return NULL.
             // Must be protected against re-entrance, eg by interrupts being blocked before calling.
@@ -311,6 +367,8 @@ namespace OTRadioLink
                 b[n] = frameLen;
                 next = newIndex(n, frameLen);
                 ++queuedRXedMessageCount;
+                _noteLoaded(frameLen);
+                OT_TRACE(OTV0P2BASE::TraceId::RXQ_LOADED, frameLen);
                 return;
                 }
 
@@ -338,6 +396,21 @@ namespace OTRadioLink
             // Does nothing if the queue is empty.
             // Not intended to be called from an ISR.
             virtual void removeRXMsg() override;
+
+            // Set (or clear with NULL) storage for occupancy stats, clearing them.
+            // Not intended to be called from an ISR.
+            void setStats(ISRRXQueueStats *s);
+
+            // Sample occupancy for the time-at-full estimate, eg once per poll or sub-cycle tick.
+            // Not intended to be called from an ISR.
+            void sampleOccupancy();
+
+            // Cheap self-check of queue structure, eg for periodic use in the field.
+            // Returns false if indices are out of range,
+            // or walking the queued frames from oldest does not arrive at next
+            // with each length in [1,maxRXBytes] and the expected count.
+            // Not intended to be called from an ISR.
+            bool selfCheck() const;
 #undef ISRRXQueueVarLenMsg_VALIDATE
 #ifdef ISRRXQueueVarLenMsg_VALIDATE
             // Validate state, dumping diagnostics to Print stream and returning false if problems found.
@@ -366,6 +439,192 @@ namespace OTRadioLink
             virtual void getRXCapacity(uint8_t &queueRXMsgsMin, uint8_t &maxRXMsgLen) const override
                 { queueRXMsgsMin = MinQueueCapacityMsgs; maxRXMsgLen = maxRXBytes; }
         };
+
+    // Lock-free single-producer/single-consumer N-deep variable-length message queue.
+    // The producer (typically the radio RX ISR) only ever writes 'head'
+    // and the consumer (typically the main loop) only ever writes 'tail',
+    // so neither side needs to mask interrupts or take a lock.
+    // Unlike ISRRXQueueVarLenMsg, space is claimed for the actual frame length
+    // where that is known in advance, rather than always for maxRXBytes.
+    //
+    // Producer (ISR) side:
+    //     volatile uint8_t *bp = q.claim(len); // NULL if no space.
+    //     if(NULL != bp) { /* fill up to len bytes */ q.commit(actualLen); }
+    // Consumer (main loop) side:
+    //     uint8_t len; const volatile uint8_t *bp = q.peek(len);
+    //     if(NULL != bp) { /* use len bytes */ q.release(); }
+    //
+    // Also provides the same method names as ISRRXQueue
+    // (_getRXBufForInbound(), _loadedBuf(), peekRXMsg(), removeRXMsg(), etc)
+    // so it can be used as a drop-in (non-virtual) replacement for the queue
+    // held directly by a radio driver.
+    // It does not derive from ISRRXQueue because the base count
+    // would have to be written by both sides.
+    //
+    // The buffer holds a circular sequence of (len,data+) segments;
+    // a len==0 segment or reaching the end exactly means wrap to the start.
+    //   * maxRXBytes  a frame to be queued can be up to maxRXBytes bytes long; in the range [1,254]
+    //   * targetISRRXMinQueueCapacity  target number of max-sized frames queueable [1,255], usually [2,4]
+    template<uint8_t maxRXBytes, uint8_t targetISRRXMinQueueCapacity = 2>
+    class ISRRXQueueSPSC final
+        {
+        private:
+            // Actual buffer size (bytes); at most 255 so that indices fit a uint8_t.
+            // One extra max-size slot allows for space lost at the wrap point.
+            static constexpr int ISRRX_BUFSIZ = OTV0P2BASE::fnmin(255, (1 + maxRXBytes) * (1 + (int)targetISRRXMinQueueCapacity));
+            static constexpr uint8_t bufSize = (uint8_t)ISRRX_BUFSIZ;
+            // Buffer holding the circular queue.
+            // Marked volatile as written by the ISR and read by the main loop.
+            volatile uint8_t buf[ISRRX_BUFSIZ];
+            // Offset of the length byte of the next entry to write, in [0,bufSize].
+            // Only written by the producer.
+            OTV0P2BASE::Atomic_UInt8T head;
+            // Offset of the length byte of the oldest entry, in [0,bufSize].
+            // Only written by the consumer.
+            OTV0P2BASE::Atomic_UInt8T tail;
+            // Count of frames ever committed and released, wrapping;
+            // the difference is the number queued.
+            // Each is only written by one side.
+            OTV0P2BASE::Atomic_UInt8T committed;
+            OTV0P2BASE::Atomic_UInt8T released;
+            // Producer-private state for the outstanding claim, if any.
+            // Offset of the claimed length byte, and the offset to write a wrap marker at
+            // (bufSize if none is needed).
+            uint8_t claimAt;
+            uint8_t wrapAt;
+            // Maximum frame length allowed by the outstanding claim; 0 if none.
+            uint8_t claimLen;
+
+            // Compute the effective offset of the oldest entry given the raw tail,
+            // skipping any wrap marker or exact end-of-buffer.
+            // Only valid for use by the consumer when the queue is not empty.
+            inline uint8_t _effectiveTail(const uint8_t t) const
+                { return(((t >= bufSize) || (0 == buf[t])) ? 0 : t); }
+
+        public:
+            constexpr ISRRXQueueSPSC()
+              : head(0), tail(0), committed(0), released(0),
+                claimAt(0), wrapAt(bufSize), claimLen(0)
+                { }
+
+            // Guaranteed minimum number of (full-length) messages that can be queued
+            // wherever the head and tail currently are.
+            static constexpr uint8_t MinQueueCapacityMsgs = (ISRRX_BUFSIZ / (maxRXBytes + 1)) - 1;
+
+            // Fetches the current inbound RX minimum queue capacity and maximum RX raw message size.
+            void getRXCapacity(uint8_t &queueRXMsgsMin, uint8_t &maxRXMsgLen) const
+                { queueRXMsgsMin = MinQueueCapacityMsgs; maxRXMsgLen = maxRXBytes; }
+
+            // Fetches the current count of queued messages for RX.
+            // ISR-/thread- safe.
+            inline uint8_t getRXMsgsQueued() const { return((uint8_t)(committed.load() - released.load())); }
+
+            // True if the queue is empty.
+            // ISR-/thread- safe.
+            inline bool isEmpty() const { return(head.load() == tail.load()); }
+
+            // Claim space for an inbound frame of up to len bytes [1,maxRXBytes]; NULL if no space.
+            // Returns a pointer to load the frame into;
+            // follow with commit() to queue the frame, or commit(0) to abandon it.
+            // Producer (ISR) side only; at most one claim may be outstanding.
+            // Does not alter any state visible to the consumer.
+            volatile uint8_t *claim(const uint8_t len)
+#if defined(__GNUC__)
+                __attribute__((hot))
+#endif // defined(__GNUC__)
+                {
+                claimLen = 0;
+                if((0 == len) || (len > maxRXBytes)) { return(NULL); }
+                const uint8_t h = head.load();
+                const uint8_t t = tail.load();
+                const uint_fast16_t need = 1U + len;
+                if(h >= t)
+                    {
+                    // Free space is from h to end, and from start to just before t.
+                    if(h + need <= bufSize) { claimAt = h; wrapAt = bufSize; }
+                    // Wrap, leaving at least one byte gap so head never catches tail.
+                    else if(need < t) { claimAt = 0; wrapAt = h; }
+                    else { return(NULL); }
+                    }
+                else
+                    {
+                    // Free space is from h to just before t.
+                    if(h + need < t) { claimAt = h; wrapAt = bufSize; }
+                    else { return(NULL); }
+                    }
+                claimLen = len;
+                return(buf + claimAt + 1);
+                }
+
+            // Queue the frame loaded into the space returned by the last claim().
+            // The argument is the actual frame length, no more than the claimed length;
+            // 0 abandons the claim.
+            // Must be in the scope of the same (ISR) call as claim().
+            void commit(uint8_t frameLen)
+#if defined(__GNUC__)
+                __attribute__((hot))
+#endif // defined(__GNUC__)
+                {
+                const uint8_t cl = claimLen;
+                claimLen = 0;
+                if((0 == frameLen) || (0 == cl)) { return; }
+                if(frameLen > cl) { frameLen = cl; } // Be safe...
+                const uint8_t c = claimAt;
+                // Mark a wrap before publishing the entry at the start.
+                if(wrapAt < bufSize) { buf[wrapAt] = 0; }
+                buf[c] = frameLen;
+                // Publish: the consumer may now see the new entry.
+                head.store((uint8_t)(c + 1 + frameLen));
+                committed.store((uint8_t)(committed.load() + 1));
+                }
+
+            // Peek at the oldest queued frame, returning a pointer or NULL if none.
+            // The frame length is returned in len (and is also in the byte before the frame).
+            // The returned pointer and length are valid until the next release().
+            // The buffer pointed to MUST NOT be altered.
+            // Consumer (main loop) side only; no interrupt masking is needed.
+            const volatile uint8_t *peek(uint8_t &len) const
+                {
+                const uint8_t t = tail.load();
+                if(head.load() == t) { len = 0; return(NULL); }
+                const uint8_t et = _effectiveTail(t);
+                len = buf[et];
+                return(buf + et + 1);
+                }
+
+            // Release (dequeue) the oldest queued frame, typically after peek().
+            // Does nothing if the queue is empty.
+            // Consumer (main loop) side only; no interrupt masking is needed.
+            void release()
+                {
+                const uint8_t t = tail.load();
+                if(head.load() == t) { return; }
+                const uint8_t et = _effectiveTail(t);
+                tail.store((uint8_t)(et + 1 + buf[et]));
+                released.store((uint8_t)(released.load() + 1));
+                }
+
+            // ISRRXQueue-compatible API.
+
+            // True if the queue is full, ie if a maximum-size frame could not be claimed.
+            // Consumer side only.
+            uint8_t isFull() const
+                {
+                const uint8_t h = head.load();
+                const uint8_t t = tail.load();
+                const uint_fast16_t need = 1U + maxRXBytes;
+                if(h >= t) { return(!((h + need <= bufSize) || (need < t))); }
+                return(!(h + need < t));
+                }
+            // As claim(maxRXBytes).
+            volatile uint8_t *_getRXBufForInbound() { return(claim(maxRXBytes)); }
+            // As commit().
+            void _loadedBuf(const uint8_t frameLen) { commit(frameLen); OT_TRACE(OTV0P2BASE::TraceId::RXQ_LOADED, frameLen); }
+            // As peek() with the length in the byte before the frame.
+            const volatile uint8_t *peekRXMsg() const { uint8_t len; return(peek(len)); }
+            // As release().
+            void removeRXMsg() { release(); OT_TRACE(OTV0P2BASE::TraceId::RXQ_REMOVED, !isEmpty()); }
+        };
     }
 
 
@@ -48,9 +48,7 @@ Author(s) / Copyright (s): Milenko Alcin 2016
 
 #include "OTRadioLink_JeelabsOemPacket.h"
 
-#ifdef ARDUINO_ARCH_AVR
-#include <util/crc16.h>
-#endif
+#include "OTV0P2BASE_CRC.h"
 
 
 namespace OTRadioLink
@@ -135,19 +133,12 @@ uint8_t JeelabsOemPacket::decode(uint8_t * const buf, uint8_t &buflen,  uint8_t
 
 /*
  * Filter for the interrupt route, to avoid consuming buffer space with broken frames.
- * Checks if payload length is reasonable and if CRC is OK.
+ * Checks that the frame fits within buflen (trimming buflen to it) and that its CRC is OK;
+ * see also the FrameFilterJeelabs* stages to filter by group and node first.
  */
 bool JeelabsOemPacket::filter( const volatile uint8_t *buf, volatile uint8_t &buflen)
     {
-       buflen  = buf[2]+5;
-       if (buflen > 64 ) return false;
-
-       uint16_t crc = ~0;
-       for (uint8_t i=0; i<buflen ; i++ ) crc = _crc16_update( crc, buf[i]);
-      
-       if ( crc )  return false; 
-    
-       return true;
+       return FrameFilterChain<FrameFilterJeelabsLength, FrameFilterJeelabsCRC>::apply(buf, buflen);
     }
 
 /*
@@ -167,15 +158,11 @@ bool JeelabsOemPacket::filter( const volatile uint8_t *buf, volatile uint8_t &bu
 
 /**Calculate CRC.
  * Used both in send and receive.
- * Uses default CRC routine from AVR standard clib.
+ * Same CRC as _crc16_update() from AVR standard clib, computed in bulk.
  */
 uint16_t JeelabsOemPacket::calcCrc(const uint8_t* buf, uint8_t len) 
     {
-       uint16_t crc = ~0;
-       while (len--) 
-         crc = _crc16_update( crc, *buf++);
-
-       return crc;
+       return OTV0P2BASE::crc16_A001_buf(0xffff, buf, len);
     }
 
 #endif // JeelabsOemPacket_DEFINED
@@ -40,7 +40,7 @@ Author(s) / Copyright (s): Milenko Alcin 2016
  * 
  * Preamble and first syn byte are added by packet handler in OTRFM23BLink.
  * 
- * Currently AVR only.
+ * Portable.
  */
 
 #ifndef ARDUINO_LIB_OTRADIOLINK_JEELABSOEMPACKET_H
@@ -49,16 +49,27 @@ Author(s) / Copyright (s): Milenko Alcin 2016
 #include <stdint.h>
 #include <OTV0p2Base.h>
 #include <OTRadioLink.h>
+#include "OTV0P2BASE_CRC.h"
 
 
 namespace OTRadioLink
     {
 
 
-#ifdef ARDUINO_ARCH_AVR
 #define JeelabsOemPacket_DEFINED
     class JeelabsOemPacket
         {
+        public:
+        // Group, header and length bytes before the payload.
+        static constexpr uint8_t HEADER_BYTES = 3;
+        // CRC16 bytes after the payload.
+        static constexpr uint8_t CRC_BYTES = 2;
+        // Header byte flags; the bottom 5 bits are the node ID.
+        static constexpr uint8_t HDR_ACK_CONF = 0x80;
+        static constexpr uint8_t HDR_DEST = 0x40;
+        static constexpr uint8_t HDR_ACK_REQ = 0x20;
+        static constexpr uint8_t HDR_NODE_ID_MASK = 0x1f;
+
         private:
         uint8_t _nodeID;
         uint8_t _groupID;
@@ -80,7 +91,62 @@ namespace OTRadioLink
         uint8_t decode(uint8_t * const buf, uint8_t &buflen,  uint8_t &nodeID,  bool &dest,  bool &ackReq,  bool &ackConf);
         static bool filter( const volatile uint8_t *buf, volatile uint8_t &buflen);
         };
-#endif // ARDUINO_ARCH_AVR
+
+    // Quick RX filter stages for JeeLabs/OEM frames (see OTRadioLink_FrameFilter.h),
+    // cheapest first, so that frames from other groups and for other nodes
+    // are rejected from the first two bytes before any CRC is computed,
+    // eg when a hub shares the channel with emonTx/JeeNode networks.
+    // For example, for group 100 as node 5:
+    //     typedef FrameFilterChain<
+    //         FrameFilterJeelabsGroup<100>,
+    //         FrameFilterJeelabsNode<5>,
+    //         FrameFilterJeelabsCRC> myFilter;
+    //     radio.setFilterRXISR(myFilter::filter);
+    // All are ISR-safe.
+
+    // Accept only frames whose length byte puts the whole frame within buflen,
+    // trimming buflen to the frame.
+    // Must come before the other stages.
+    struct FrameFilterJeelabsLength
+        {
+        static inline bool apply(const volatile uint8_t *const buf, volatile uint8_t &buflen)
+            {
+            static constexpr uint8_t overhead = JeelabsOemPacket::HEADER_BYTES + JeelabsOemPacket::CRC_BYTES;
+            const uint8_t available = buflen;
+            if(available < overhead) { return(false); }
+            const uint8_t payload = buf[2];
+            if(payload > available - overhead) { return(false); }
+            buflen = payload + overhead;
+            return(true);
+            }
+        };
+
+    // Accept only frames for groupID, trimming buflen as FrameFilterJeelabsLength.
+    template<uint8_t groupID> struct FrameFilterJeelabsGroup
+        {
+        static inline bool apply(const volatile uint8_t *const buf, volatile uint8_t &buflen)
+            { return((0 != buflen) && (groupID == buf[0]) && FrameFilterJeelabsLength::apply(buf, buflen)); }
+        };
+
+    // Reject frames addressed to a node other than nodeID; broadcasts are accepted.
+    // The header byte must be within buflen, eg after FrameFilterJeelabsGroup.
+    template<uint8_t nodeID> struct FrameFilterJeelabsNode
+        {
+        static inline bool apply(const volatile uint8_t *const buf, volatile uint8_t &)
+            {
+            const uint8_t hdr = buf[1];
+            return((0 == (hdr & JeelabsOemPacket::HDR_DEST)) ||
+                   ((nodeID & JeelabsOemPacket::HDR_NODE_ID_MASK) == (hdr & JeelabsOemPacket::HDR_NODE_ID_MASK)));
+            }
+        };
+
+    // Accept only frames whose CRC16 (over the frame including the CRC) is zero.
+    // buflen must already be trimmed to the frame, eg by FrameFilterJeelabsGroup.
+    struct FrameFilterJeelabsCRC
+        {
+        static inline bool apply(const volatile uint8_t *const buf, volatile uint8_t &buflen)
+            { return(0 == OTV0P2BASE::crc16_A001_buf(0xffff, buf, buflen)); }
+        };
 
 
     }
@@ -28,6 +28,8 @@ Author(s) / Copyright (s): Deniz Erbilgin 2017
 #include "OTRadValve_BoilerDriver.h"
 #include "OTRadioLink_OTRadioLink.h"
 #include "OTRadioLink_MessagingFS20.h"
+#include "OTRadioLink_RelayDedup.h"
+#include "OTRadioLink_NodeLastSeen.h"
 
 namespace OTRadioLink
 {
@@ -65,9 +67,15 @@ frameOperator_fn_t serialFrameOperation;
 // decrypted frame passed.
 frameOperator_fn_t relayFrameOperation;
 
+// As relayFrameOperation, but dropping frames relayed recently.
+frameOperator_fn_t relayDedupFrameOperation;
+
 // Trigger a boiler call for heat.
 frameOperator_fn_t boilerFrameOperation;
 
+// Record the sender in a hub last-seen table.
+frameOperator_fn_t nodeLastSeenFrameOperation;
+
 // Dummy frame decoder and handler.
 frameDecodeHandler_fn_t decodeAndHandleDummyFrame;
 
@@ -116,11 +124,8 @@ bool serialFrameOperation(const OTDecodeData_T &fd)
         p.write(db + 3, dbLen - 3);
         p.println('}');
         // OTV0P2BASE::outputJSONStats(&Serial, secure, msg, msglen);
-        // Attempt to ensure that trailing characters are pushed out fully.
-        // FIXME DHD is dubious about this setup.
-#ifdef ARDUINO_ARCH_AVR
-        OTV0P2BASE::flushSerialProductive();
-#endif // ARDUINO_ARCH_AVR
+        // Do not wait for the UART to drain here, so as not to hold up the RX pipeline:
+        // trailing characters are pushed out by OTV0P2BASE::flushBeforeSleep().
         return true;
     }
     return false;
@@ -152,6 +157,63 @@ bool relayFrameOperation(const OTDecodeData_T &fd)
     return false;
 }
 
+/**
+ * @brief   As relayFrameOperation, but drops a frame that was relayed recently,
+ *          eg bounced back by another relay in range.
+ * @param   rt_t: Type of rt. Should be an implementation of OTRadioLink.
+ * @param   rt: Radio to relay frame over. NOTE! must be the concrete instance.
+ * @param   dedup_t: Type of dedup, eg OTRelayDedupCache<8, 2>.
+ * @param   dedup: Cache of frames relayed recently. NOTE! must be the
+ *          concrete instance. Should be ticked regularly, eg once per minute.
+ * @param   fd: Decoded frame data.
+ * retval   True if frame successfully added to send queue on rt, else false,
+ *          including if relayed recently.
+ */
+template <typename rt_t, rt_t &rt, typename dedup_t, dedup_t &dedup>
+bool relayDedupFrameOperation(const OTDecodeData_T &fd)
+{
+    // Check msg exists.
+    if(nullptr == fd.ctext) return false;
+
+    const uint8_t * const db = fd.ptext;
+    const uint8_t dbLen = fd.ptextLen;
+
+    // Perform the same validation as relayFrameOperation, then drop recent duplicates.
+    if((0 != (db[1] & 0x10)) && (dbLen > 3) && ('{' == db[2])) {
+        if(dedup.seen(fd.ctext + 1, fd.ctextLen)) { return false; }
+        // Only remember frames queued, so that a later copy may yet get through.
+        if(!rt.queueToSend(fd.ctext + 1, fd.ctextLen)) { return false; }
+        dedup.add(fd.ctext + 1, fd.ctextLen);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief   Add raw RXed frame to an uplink batch (see OTUplinkBatch), if basic
+ *          validity check of decrypted frame passed. As relayFrameOperation
+ *          but combining frames from several nodes into fewer uplink messages.
+ * @param   batch_t: Type of batch, eg OTUplinkBatch<64, 4, 15>.
+ * @param   batch: Batch to add frame to. NOTE! must be the concrete instance.
+ * @param   fd: Decoded frame data.
+ * retval   True if frame successfully added to the batch, else false.
+ */
+template <typename batch_t, batch_t &batch>
+bool batchFrameOperation(const OTDecodeData_T &fd)
+{
+    // Check msg exists.
+    if(nullptr == fd.ctext) return false;
+
+    const uint8_t * const db = fd.ptext;
+    const uint8_t dbLen = fd.ptextLen;
+
+    // Perform some basic validation of the plain text (is it worth sending) and add to the batch.
+    if((0 != (db[1] & 0x10)) && (dbLen > 3) && ('{' == db[2])) {
+        return batch.add(fd.id, fd.ctext + 1, fd.ctextLen);
+    }
+    return false;
+}
+
 /**
  * @brief   Operator for triggering a boiler call for heat.
  * @param   bh_t: Type of bh
@@ -177,6 +239,163 @@ bool boilerFrameOperation(const OTDecodeData_T &fd)
     return (false);
 }
 
+/**
+ * @brief   Operator recording the sender of a secure frame in a last-seen table.
+ * @param   table_t: Type of table, eg OTNodeLastSeenTable<>.
+ * @param   table: Last-seen table, indexed by association slot.
+ *          NOTE! must be the concrete instance.
+ * @param   nowM: Reference to the current time in minutes, eg a free-running
+ *          minute counter.
+ * @param   rssi: Reference to the RSSI of the frame being handled, eg set by
+ *          the RX path from the radio, else held at 0.
+ * @param   fd: Decoded frame data.
+ * @retval  True if recorded. False if the sender's association slot is not known.
+ */
+template <typename table_t, table_t &table, const uint16_t &nowM, const uint8_t &rssi>
+bool nodeLastSeenFrameOperation(const OTDecodeData_T &fd)
+{
+    if((nullptr == fd.ctext) || (fd.assocIndex < 0)) { return (false); }
+    // Last byte of the 6-byte message counter at the start of the trailer.
+    const uint8_t ctrLSB = fd.ctext[fd.sfh.getTrailerOffset() + SimpleSecureFrame32or0BodyBase::fullMsgCtrBytes - 1];
+    const uint8_t valvePC = (fd.ptextLen > 0) ? fd.ptext[0] : table_t::VALVE_PC_UNKNOWN;
+    return (table.update(fd.assocIndex, nowM, rssi, ctrLSB, valvePC));
+}
+
+
+/**
+ * @brief   Fixed-capacity queue of frame operations deferred until after RX
+ *          handling, eg serial output or relay TX.
+ *
+ * A slow UART or radio TX run inside the RX pipeline holds up every later
+ * frame; queueing the operation lets the RX queue be decoded and released
+ * first, with the side effects run later in the cycle by
+ * OTMessageQueueHandler (see its runDeferred parameter).
+ *
+ * Each entry holds its own copy of the raw frame, decoded body and sender ID,
+ * since the RX queue slot and the decode buffer are reused as soon as the
+ * handler returns; operators see an OTDecodeData_T rebuilt over the copy.
+ * If the queue is full the operation is run immediately instead,
+ * as without the queue, so nothing is lost.
+ *
+ * Not ISR-safe: use from the main loop only.
+ *
+ * @param   capacity: Maximum number of operations pending; strictly positive.
+ *          Each entry uses just over 100 bytes of RAM.
+ */
+template<uint8_t capacity>
+class OTDeferredFrameOpQueue final
+{
+    static_assert(capacity > 0, "capacity must be positive");
+private:
+    struct entry_t
+    {
+        frameOperator_fn_t *op;
+        // Raw frame including leading length byte.
+        uint8_t raw[SecurableFrameHeader::maxSmallFrameSize + 1];
+        uint8_t ptext[ENC_BODY_SMALL_FIXED_CTEXT_SIZE];
+        uint8_t ptextLen;
+        uint8_t id[OTV0P2BASE::OpenTRV_Node_ID_Bytes];
+        int8_t assocIndex;
+    };
+    entry_t entries[capacity];
+    // Index of oldest entry, and number of entries pending.
+    uint8_t head = 0;
+    uint8_t count = 0;
+
+public:
+    // Number of operations pending.
+    uint8_t pending() const { return(count); }
+
+    /**
+     * @brief   Queue op to be run later on a copy of fd.
+     * @retval  True if queued, false if run immediately
+     *          (because the queue was full or fd could not be copied).
+     */
+    bool defer(frameOperator_fn_t &op, const OTDecodeData_T &fd)
+    {
+        const uint8_t rawLen = (nullptr == fd.ctext) ? 0 : uint8_t(fd.ctextLen + 1);
+        if((count >= capacity) || (0 == rawLen) || (rawLen > sizeof(entries[0].raw)) ||
+           (fd.ptextLen > sizeof(entries[0].ptext)))
+            { op(fd); return(false); }
+        entry_t &e = entries[(head + count) % capacity];
+        e.op = &op;
+        memcpy(e.raw, fd.ctext, rawLen);
+        memcpy(e.ptext, fd.ptext, fd.ptextLen);
+        e.ptextLen = fd.ptextLen;
+        memcpy(e.id, fd.id, sizeof(e.id));
+        e.assocIndex = fd.assocIndex;
+        ++count;
+        return(true);
+    }
+
+    /**
+     * @brief   Run pending operations, oldest first.
+     * @param   maxOps: Maximum number of operations to run.
+     * @param   deadlineSubCycle: Stop at or after this sub-cycle time
+     *          (AVR only; ignored elsewhere), leaving the rest queued.
+     * @retval  Number of operations run.
+     */
+    uint8_t run(const uint8_t maxOps = 255, const uint8_t deadlineSubCycle = 255)
+    {
+#ifdef ARDUINO_ARCH_AVR
+        const uint8_t sctStart = OTV0P2BASE::getSubCycleTime();
+#else
+        (void) deadlineSubCycle; // Sub-cycle time not available.
+#endif // ARDUINO_ARCH_AVR
+        uint8_t n = 0;
+        while((n < maxOps) && (0 != count))
+        {
+#ifdef ARDUINO_ARCH_AVR
+            // Stop if at/past the deadline or if the cycle has wrapped.
+            const uint8_t sct = OTV0P2BASE::getSubCycleTime();
+            if((sct >= deadlineSubCycle) || (sct < sctStart)) { break; }
+#endif // ARDUINO_ARCH_AVR
+            entry_t &e = entries[head];
+            // Dequeue first so that the operator may itself defer more work.
+            head = uint8_t((head + 1) % capacity);
+            --count;
+            OTDecodeData_T fd(e.raw, e.ptext);
+            fd.sfh.decodeHeader(e.raw, uint8_t(e.raw[0] + 1));
+            memcpy(fd.id, e.id, sizeof(fd.id));
+            fd.assocIndex = e.assocIndex;
+            fd.ptextLen = e.ptextLen;
+            e.op(fd);
+            ++n;
+        }
+        return(n);
+    }
+};
+
+/**
+ * @brief   Operator that queues op on q to run after RX handling,
+ *          eg deferredFrameOperation<decltype(q), q, serialFrameOperation<decltype(Serial), Serial> >.
+ * @param   q_t: Type of q, an OTDeferredFrameOpQueue.
+ * @param   q: Queue instance. NOTE! must be the concrete instance.
+ * @retval  True (the operation is queued, or run immediately if the queue is full).
+ */
+template <typename q_t, q_t &q, frameOperator_fn_t &op>
+bool deferredFrameOperation(const OTDecodeData_T &fd)
+{
+    q.defer(op, fd);
+    return(true);
+}
+
+/**
+ * @brief   Static access to deferred operations on q, for OTMessageQueueHandler's deferred_t parameter.
+ */
+template <typename q_t, q_t &q>
+struct OTDeferredFrameOps final
+{
+    static uint8_t pending() { return(q.pending()); }
+    static uint8_t run(const uint8_t deadlineSubCycle) { return(q.run(255, deadlineSubCycle)); }
+};
+// No deferred operations: the default for OTMessageQueueHandler.
+struct OTNoDeferredFrameOps final
+{
+    static constexpr uint8_t pending() { return(0); }
+    static constexpr uint8_t run(const uint8_t /*deadlineSubCycle*/) { return(0); }
+};
+
 
 /**
  * @brief   Authenticate and decrypt secure frames. Expects syntax checking and
@@ -256,6 +475,43 @@ OTV0P2BASE::serialPrintlnAndFlush();
     return(isOK); // Return if successfully decoded, authenticated, etc.
 }
 
+/**
+ * @brief   Authenticate and decrypt a batch of secure frames, eg a burst
+ *          drained from the RX queue, fetching the key only once.
+ *          Expects syntax checking and validation of each header to already
+ *          have been done.
+ * @param   fds: n pointers to OTDecodeData_T objects containing messages to decrypt.
+ * @param   n: Number of frames.
+ * @param   sW: Scratch space; as for authAndDecodeOTSecurableFrame() but
+ *          sized for sfrx_t::decodeBatch().
+ * @param   results: If non-NULL, n bytes receiving the result for each frame,
+ *          non-zero if successfully authenticated and decoded.
+ * @retval  Number of frames successfully authenticated and decoded.
+ */
+template <typename sfrx_t,
+          SimpleSecureFrame32or0BodyRXBase::fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &decrypt,
+          OTV0P2BASE::GetPrimary16ByteSecretKey_t &getKey>
+inline uint8_t authAndDecodeOTSecurableFrameBatch(OTDecodeData_T *const *fds, uint8_t n,
+                                                  OTV0P2BASE::ScratchSpaceL &sW, uint8_t *results = NULL)
+{
+    constexpr size_t scratchSpaceNeededHere = authAndDecodeOTSecurableFrameWithWorkspace_scratch_usage;
+    if(sW.bufsize < scratchSpaceNeededHere) { return(0); } // ERROR
+    if(0 == n) { return(0); }
+
+    // Use scratch space for 16-byte key, fetched once for the whole batch.
+    uint8_t *key = sW.buf;
+    if(!getKey(key)) {
+        OTV0P2BASE::serialPrintlnAndFlush(F("!RX key"));
+        return(0);
+    }
+
+    // Create sub-space for callee.
+    OTV0P2BASE::ScratchSpaceL subScratch(sW, scratchSpaceNeededHere);
+    const uint8_t decoded = sfrx_t::getInstance().decodeBatch(fds, n, decrypt, subScratch, key, results);
+    if(decoded != n) { OTV0P2BASE::serialPrintlnAndFlush(F("?RX auth")); }
+    return(decoded);
+}
+
 
 /**
  * @brief   Stub version of a frameOperator_fn_t type function.
@@ -321,8 +577,11 @@ bool decodeAndHandleOTSecureOFrame(volatile const uint8_t * const _msg, OTV0P2BA
     // FIXME: Should this be passed in by scratch space?
     // TODO: Consider moving this out by one layer and passing it in, to avoid
     // needing to re-decode header in second handler.
-    uint8_t decryptedBodyOut[OTDecodeData_T::ptextLenMax];
-    OTDecodeData_T fd(msg, decryptedBodyOut);
+    // The frame is parsed and authenticated in place in the RX queue,
+    // and sized for a whole encrypted block so that the body is decrypted
+    // straight into it, without an intermediate scratch copy.
+    uint8_t decryptedBodyOut[ENC_BODY_SMALL_FIXED_CTEXT_SIZE];
+    OTDecodeData_T fd(msg, decryptedBodyOut, OTDecodeData_T::PTEXT_IN_PLACE);
 
     // Validate structure of header/frame first.
     // This is quick and checks for insane/dangerous values throughout.
@@ -393,6 +652,146 @@ void decodeAndHandleRawRXedMessage(volatile const uint8_t * const msg)
     return;
 }
 
+// Try frame handlers in order until the first successful one.
+template<frameDecodeHandler_fn_t &... hs> struct FrameHandlerChain;
+template<> struct FrameHandlerChain<>
+    { static bool handle(volatile const uint8_t * const /*msg*/) { return(false); } };
+template<frameDecodeHandler_fn_t &h, frameDecodeHandler_fn_t &... rest>
+struct FrameHandlerChain<h, rest...>
+    {
+    static bool handle(volatile const uint8_t * const msg)
+        { return(h(msg) || FrameHandlerChain<rest...>::handle(msg)); }
+    };
+
+/**
+ * @brief   Handlers for frames of a single frame type, for FrameTypeDispatcher.
+ *
+ * Handlers are tried in order until the first successful one,
+ * as for decodeAndHandleRawRXedMessage().
+ *
+ * @param   frameType: First frame byte (type, including any secure bit)
+ *          that these handlers are for, eg 'O' | 0x80 for secure O frames.
+ * @param   hs: One or more frame handlers.
+ */
+template<uint8_t frameType, frameDecodeHandler_fn_t &... hs>
+struct FrameTypeHandlers final
+    {
+    static_assert(sizeof...(hs) > 0, "no handlers for frame type");
+    static constexpr uint8_t type = frameType;
+    static bool handle(volatile const uint8_t * const msg) { return(FrameHandlerChain<hs...>::handle(msg)); }
+    };
+
+/**
+ * @brief   Dispatch RXed frames to handlers by frame type.
+ *
+ * Replaces trying every decoder in turn on every frame
+ * (as with decodeAndHandleRawRXedMessage<h1, h2>):
+ * the first frame byte is matched against the compile-time list of types
+ * (a short chain of byte compares, no decoder calls)
+ * and only the handlers registered for that type are called.
+ * Frames of unregistered types are dropped without any decode attempt.
+ *
+ * dispatch() has the frameDecodeHandler_fn_t signature,
+ * so can be passed as a handler to OTMessageQueueHandler, eg:
+ *     typedef FrameTypeDispatcher<
+ *         FrameTypeHandlers<'O' | 0x80, decodeSecureOFrame>,
+ *         FrameTypeHandlers<FTS_ALIVE | 0x80, handleBeacon> > dispatcher_t;
+ *     OTMessageQueueHandler<pollIO, baud, dispatcher_t::dispatch> mh;
+ *
+ * @param   entries: FrameTypeHandlers, each for a different frame type.
+ */
+template<typename... entries> struct FrameTypeDispatcher;
+template<> struct FrameTypeDispatcher<>
+    {
+    static constexpr bool hasType(const uint8_t /*t*/) { return(false); }
+    static bool dispatchByType(const uint8_t /*t*/, volatile const uint8_t * const /*msg*/) { return(false); }
+    };
+template<typename e, typename... rest>
+struct FrameTypeDispatcher<e, rest...>
+    {
+    static_assert(!FrameTypeDispatcher<rest...>::hasType(e::type), "frame type registered twice");
+    // True if a handler is registered for frame type t.
+    static constexpr bool hasType(const uint8_t t) { return((e::type == t) || FrameTypeDispatcher<rest...>::hasType(t)); }
+    // Call the handlers for frame type t; false if none or none succeeded.
+    static bool dispatchByType(const uint8_t t, volatile const uint8_t * const msg)
+        { return((e::type == t) ? e::handle(msg) : FrameTypeDispatcher<rest...>::dispatchByType(t, msg)); }
+    /**
+     * @param   msg: Raw RXed message. msgLen should be stored in the byte before
+     *          and can be accessed with msg[-1]. This routine is NOT allowed to
+     *          alter content of the buffer passed.
+     * @retval  True if frame was handled by a handler for its type.
+     */
+    static bool dispatch(volatile const uint8_t * const msg)
+        {
+        const uint8_t msglen = msg[-1];
+        if(msglen < 2) { return(false); } // Too short to be useful, so ignore.
+        return(dispatchByType(msg[0], msg));
+        }
+    };
+
+/**
+ * @brief   Timing of RX handling by OTMessageQueueHandler, in sub-cycle ticks.
+ *
+ * Used to find whether RX handling is what is overrunning the minor cycle
+ * (see V0P2BASE_EE_START_OVERRUN_COUNTER).
+ * Only collected where the sub-cycle time is available (ie on AVR).
+ * All counters saturate rather than wrap.
+ */
+struct OTMessageQueueTimingStats final
+    {
+    // Number of ticks-per-frame histogram bins.
+    static constexpr uint8_t TICKS_HISTOGRAM_BINS = 4;
+    // Frames handled.
+    uint16_t frames;
+    // Most ticks spent handling any one frame.
+    uint8_t maxTicksPerFrame;
+    // Calls to handle() that spent longer than the budget.
+    uint16_t budgetOverruns;
+    // Counts of frames by ticks spent, in bins [0,15], [16,31], [32,63], [64,255].
+    // A secure 'O' frame decoded and printed on AVR takes ~60 ticks.
+    uint16_t ticksHistogram[TICKS_HISTOGRAM_BINS];
+
+    // Map ticks spent on a frame into a histogram bin index.
+    static constexpr uint8_t ticksBin(const uint8_t ticks)
+        { return((ticks < 16) ? 0 : ((ticks < 32) ? 1 : ((ticks < 64) ? 2 : 3))); }
+    // Saturating increment for 16-bit counters.
+    static inline void inc(uint16_t &c) { if(0xffff != c) { ++c; } }
+    // Record one frame that took the given number of ticks to handle.
+    void recordFrame(const uint8_t ticks)
+        {
+        inc(frames);
+        if(ticks > maxTicksPerFrame) { maxTicksPerFrame = ticks; }
+        inc(ticksHistogram[ticksBin(ticks)]);
+        }
+    // Record one call to handle() that took the given number of ticks, against its budget.
+    void recordCall(const uint8_t ticks, const uint8_t budget)
+        { if(ticks > budget) { inc(budgetOverruns); } }
+    // Reset all counters to zero.
+    void clear() { memset(this, 0, sizeof(*this)); }
+    };
+
+/**
+ * @brief   Put RX handling timing stats into a stats rotation, as low-priority stats.
+ *
+ * With a JSONStatsHolder, reserve the keys with placeholders
+ * and put to its ss member, eg:
+ *     auto sh = makeJSONStatsHolder(tempSensor,
+ *         V0p2_SENSOR_TAG_F("rxT"), V0p2_SENSOR_TAG_F("rxB"));
+ *     sh.putOrRemoveAll();
+ *     putMessageQueueTimingStats(sh.ss, timingStats);
+ *
+ * Puts:
+ *   - rxT: most ticks spent handling any one frame.
+ *   - rxB: number of calls to handle() over budget.
+ */
+inline bool putMessageQueueTimingStats(OTV0P2BASE::SimpleStatsRotationBase &ss, const OTMessageQueueTimingStats &s)
+    {
+    bool ok = true;
+    ok &= ss.put(V0p2_SENSOR_TAG_F("rxT"), (int16_t)s.maxTicksPerFrame, true);
+    ok &= ss.put(V0p2_SENSOR_TAG_F("rxB"), (int16_t)OTV0P2BASE::fnmin(s.budgetOverruns, (uint16_t)0x7fff), true);
+    return(ok);
+    }
+
 /**
  * @brief   Abstract interface for handling message queues.
  *          Provided as V0p2 is still spaghetti (20170608).
@@ -430,13 +829,44 @@ public:
  * @param   h1: First frame handler to attempt.
  * @param   h2: Second frame handler to attempt. Defaults to a dummy handler.
  *          See `handle` for details on how handlers are called.
+ * @param   maxFramesPerHandle: Maximum number of queued frames to process in
+ *          each call to `handle`. Defaults to 1. A busy hub may set this
+ *          higher to clear a burst of frames in one minor cycle, subject to
+ *          the same late-in-cycle cut-off.
+ * @param   deferred_t: Operations deferred (eg by deferredFrameOperation)
+ *          while handling RXed frames, run once the RX queue has been
+ *          cleared, subject to the same late-in-cycle cut-off;
+ *          see OTDeferredFrameOps. Defaults to none.
+ * @param   budgetTicks: Sub-cycle ticks that each call to `handle` may spend
+ *          before it stops starting new frames or deferred operations,
+ *          in addition to the late-in-cycle cut-off.
+ *          Defaults to 255, ie no limit beyond the cut-off.
+ *          Only enforced where the sub-cycle time is available (ie on AVR).
  */
 template<bool (*pollIO) (bool), uint16_t baud,
          frameDecodeHandler_fn_t &h1,
-         frameDecodeHandler_fn_t &h2 = decodeAndHandleDummyFrame>
+         frameDecodeHandler_fn_t &h2 = decodeAndHandleDummyFrame,
+         uint8_t maxFramesPerHandle = 1,
+         typename deferred_t = OTNoDeferredFrameOps,
+         uint8_t budgetTicks = 255>
 class OTMessageQueueHandler final: public OTMessageQueueHandlerBase
 {
+private:
+    // Timing stats, or nullptr if not being collected.
+    OTMessageQueueTimingStats *timingStats = nullptr;
+
 public:
+    /**
+     * @brief   Set (or clear with nullptr) storage for timing stats.
+     *          The stats are cleared when set.
+     *          Only collected where the sub-cycle time is available (ie on AVR).
+     */
+    void setTimingStats(OTMessageQueueTimingStats *const stats)
+        {
+        if(nullptr != stats) { stats->clear(); }
+        timingStats = stats;
+        }
+
     /**
      * @brief   Poll radio and incrementally process any queued messages.
      * 
@@ -468,7 +898,8 @@ public:
      * @param   wakeSerialIfNeeded: If true, makes sure the serial port is 
      *          enabled on entry and returns it to how it found it on exit.
      * @param   rl: Radio to check for new RXed frames.
-     * @retval  Returns true if a message was RXed and processed, or if pollIO
+     * @retval  Returns true if a message was RXed and processed, or deferred
+     *          operations were pending, or if pollIO
      *          returns true. NOTE that this is independant of whether the
      *          message was successfully handled.
      */
@@ -500,18 +931,37 @@ public:
         // Check for activity on the radio link.
         rl.poll();
 
-        // Pointer to RX message buffer of radio.
-        const volatile uint8_t *pb = rl.peekRXMsg();
-        // If pb is a nullptr at this stage, no message has been RXed.
-        if(nullptr != pb) {
+        // If there is no message at this stage, no message has been RXed.
+        const bool haveRX = (nullptr != rl.peekRXMsg());
+        if(haveRX || (0 != deferred_t::pending())) {
 #ifdef ARDUINO_ARCH_AVR
             bool neededWaking = false; // Set true once this routine wakes Serial.
             if(!neededWaking && wakeSerialIfNeeded && OTV0P2BASE::powerUpSerialIfDisabled<baud>()) { neededWaking = true; } // FIXME
-#endif // ARDUINO_ARCH_AVR
+            // Stop at the earlier of the late-in-cycle cut-off and the end of the budget.
+            constexpr uint8_t cutoff = (OTV0P2BASE::GSCT_MAX/4)*3;
+            const uint8_t deadline = ((cutoff - sctStart) > budgetTicks) ? (uint8_t)(sctStart + budgetTicks) : cutoff;
+            // Handle up to maxFramesPerHandle frames in place in the queue,
+            // one at a time so that each can be timed.
+            for(uint8_t i = 0; haveRX && (i < maxFramesPerHandle); ++i) {
+                const uint8_t sctFrame = OTV0P2BASE::getSubCycleTime();
+                if(sctFrame < sctStart) { break; } // Minor cycle has ended.
+                if(0 == rl.drainRX(decodeAndHandleRawRXedMessage<h1, h2>, 1, deadline)) { break; }
+                if(nullptr != timingStats) { timingStats->recordFrame((uint8_t)(OTV0P2BASE::getSubCycleTime() - sctFrame)); }
+            }
+#else
+            constexpr uint8_t deadline = 255;
             // Don't currently regard anything arriving over the air as 'secure'.
-            // FIXME: shouldn't have to cast away volatile to process the message content.
-            decodeAndHandleRawRXedMessage<h1, h2> (pb);
-            rl.removeRXMsg();
+            // Handle up to maxFramesPerHandle frames in place in the queue,
+            // stopping early if getting too late in the minor cycle.
+            if(haveRX) { rl.drainRX(decodeAndHandleRawRXedMessage<h1, h2>, maxFramesPerHandle, deadline); }
+#endif // ARDUINO_ARCH_AVR
+            // Now the RX queue has been cleared, run any side effects
+            // (eg serial output, relay TX) deferred while handling it,
+            // including any left over from a previous call.
+            deferred_t::run(deadline);
+#ifdef ARDUINO_ARCH_AVR
+            if(nullptr != timingStats) { timingStats->recordCall((uint8_t)(OTV0P2BASE::getSubCycleTime() - sctStart), budgetTicks); }
+#endif // ARDUINO_ARCH_AVR
             // Note that some work has been done.
             workDone = true;
             // Turn off serial at end, if this routine woke it.
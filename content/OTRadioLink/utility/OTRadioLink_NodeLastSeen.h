@@ -0,0 +1,154 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Hub-side table of when each associated node was last heard,
+ * for cheap fleet health checks without parsing every stats line.
+ */
+
+#ifndef ARDUINO_LIB_OTRADIOLINK_NODELASTSEEN_H
+#define ARDUINO_LIB_OTRADIOLINK_NODELASTSEEN_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "OTV0P2BASE_EEPROM.h"
+
+// Use namespaces to help avoid collisions.
+namespace OTRadioLink
+    {
+    // Last-seen state of each node, indexed by association table slot
+    // (see OTDecodeData_T::assocIndex), so each update from the RX path is O(1).
+    // Times are in minutes from any free-running counter supplied by the caller;
+    // ages are computed modulo 2^16, so are good for about 45 days.
+    // Template parameters:
+    //   * maxSlots  number of association slots tracked; [1,32]
+    // Uses 6 bytes of RAM per slot plus 4.
+    // Not thread-/ISR- safe.
+    template<uint8_t maxSlots = OTV0P2BASE::V0P2BASE_EE_NODE_ASSOCIATIONS_MAX_SETS>
+    class OTNodeLastSeenTable final
+        {
+        static_assert((maxSlots > 0) && (maxSlots <= 32), "slots out of range");
+
+        public:
+            // Value of valvePC when not known.
+            static constexpr uint8_t VALVE_PC_UNKNOWN = 0xff;
+            // Age returned for a slot never heard from.
+            static constexpr uint16_t NEVER = 0xffff;
+
+            struct Entry_t
+                {
+                // Time last heard, in minutes.
+                uint16_t lastSeenM;
+                // RSSI of the last frame, as for OTRadioChannelStats, or 0 if not known.
+                uint8_t rssi;
+                // Least significant byte of the last message counter,
+                // eg to spot missed frames or a counter reset.
+                uint8_t ctrLSB;
+                // Last reported valve % open [0,100], else VALVE_PC_UNKNOWN.
+                uint8_t valvePC;
+                // Frames heard, saturating at 255.
+                uint8_t frames;
+                };
+
+        private:
+            Entry_t entries[maxSlots];
+            // Bit i set if slot i has been heard from.
+            uint32_t seenMask = 0;
+
+            bool validSlot(const int8_t slot) const { return((slot >= 0) && (slot < int8_t(maxSlots))); }
+
+        public:
+            // Forget all nodes, eg after the association table is cleared.
+            void clear() { seenMask = 0; }
+            // Forget one node, eg when its association is replaced.
+            void forget(const int8_t slot) { if(validSlot(slot)) { seenMask &= ~(uint32_t(1) << slot); } }
+
+            // Record a frame from the node at slot; false if slot is out of range (eg -1).
+            bool update(const int8_t slot, const uint16_t nowM, const uint8_t rssi,
+                        const uint8_t ctrLSB, const uint8_t valvePC = VALVE_PC_UNKNOWN)
+                {
+                if(!validSlot(slot)) { return(false); }
+                const uint32_t bit = uint32_t(1) << slot;
+                Entry_t &e = entries[slot];
+                if(0 == (seenMask & bit)) { e.frames = 0; seenMask |= bit; }
+                e.lastSeenM = nowM;
+                e.rssi = rssi;
+                e.ctrLSB = ctrLSB;
+                e.valvePC = (valvePC <= 100) ? valvePC : VALVE_PC_UNKNOWN;
+                if(e.frames < 255) { ++e.frames; }
+                return(true);
+                }
+
+            // True if slot has been heard from.
+            bool isSeen(const int8_t slot) const
+                { return(validSlot(slot) && (0 != (seenMask & (uint32_t(1) << slot)))); }
+            // Entry for slot, or NULL if never heard from.
+            const Entry_t *get(const int8_t slot) const { return(isSeen(slot) ? (entries + slot) : NULL); }
+            // Minutes since slot was last heard, else NEVER.
+            uint16_t ageM(const int8_t slot, const uint16_t nowM) const
+                { return(isSeen(slot) ? uint16_t(nowM - entries[slot].lastSeenM) : NEVER); }
+
+            // Bitmap of the first nSlots slots (eg the number of associations)
+            // not heard from within staleM minutes, including those never heard.
+            uint32_t missingMask(const uint16_t nowM, const uint16_t staleM, const uint8_t nSlots = maxSlots) const
+                {
+                uint32_t m = 0;
+                const uint8_t n = (nSlots < maxSlots) ? nSlots : maxSlots;
+                for(uint8_t i = 0; i < n; ++i) { if(ageM(int8_t(i), nowM) > staleM) { m |= uint32_t(1) << i; } }
+                return(m);
+                }
+            // Number of slots in missingMask().
+            uint8_t missingCount(const uint16_t nowM, const uint16_t staleM, const uint8_t nSlots = maxSlots) const
+                {
+                uint8_t c = 0;
+                for(uint32_t m = missingMask(nowM, staleM, nSlots); 0 != m; m &= m - 1) { ++c; }
+                return(c);
+                }
+
+            // Write a compact missing-nodes summary as JSON, eg {"miss":2,"mm":"5"}
+            // with the count and missingMask() in hex, for the hub's stats line.
+            // Returns the length written (excluding the terminating '\0'), or 0 if buf is too small.
+            // A buffer of 28 bytes is always large enough.
+            uint8_t writeMissingJSON(char *const buf, const uint8_t bufLen,
+                                     const uint16_t nowM, const uint16_t staleM, const uint8_t nSlots = maxSlots) const
+                {
+                static const char hex[] = "0123456789abcdef";
+                const uint32_t m = missingMask(nowM, staleM, nSlots);
+                const uint8_t c = missingCount(nowM, staleM, nSlots);
+                char out[28];
+                uint8_t n = 0;
+                memcpy(out, "{\"miss\":", 8); n = 8;
+                if(c >= 10) { out[n++] = char('0' + (c / 10)); }
+                out[n++] = char('0' + (c % 10));
+                memcpy(out + n, ",\"mm\":\"", 7); n += 7;
+                int8_t shift = 28;
+                while((shift > 0) && (0 == ((m >> shift) & 0xf))) { shift -= 4; }
+                for( ; shift >= 0; shift -= 4) { out[n++] = hex[(m >> shift) & 0xf]; }
+                out[n++] = '"';
+                out[n++] = '}';
+                if((NULL == buf) || (bufLen <= n)) { return(0); }
+                memcpy(buf, out, n);
+                buf[n] = '\0';
+                return(n);
+                }
+        };
+
+    }
+
+#endif
@@ -17,6 +17,8 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015
 */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "OTRadioLink_OTRadioLink.h"
 
@@ -107,6 +109,167 @@ namespace OTRadioLink
         return(true);
         }
 
+    // Process queued RX frames in place in a single pass, oldest first.
+    // Calls the handler with each frame in turn then removes it from the queue,
+    // stopping when the queue is empty or maxFrames have been processed,
+    // or (where the sub-cycle time is available) if the sub-cycle time
+    // reaches deadlineSubCycle or the minor cycle ends, before starting a frame.
+    // The default deadline of GSCT_MAX is never reached,
+    // so then only the end of the minor cycle stops the pass early.
+    // Returns the number of frames processed.
+    uint8_t OTRadioLink::drainRX(RXFrameDrainHandler_fn_t *const handler, const uint8_t maxFrames, const uint8_t deadlineSubCycle)
+        {
+        if(NULL == handler) { return(0); }
+#ifdef ARDUINO_ARCH_AVR
+        const uint8_t sctStart = OTV0P2BASE::getSubCycleTime();
+#else
+        (void) deadlineSubCycle; // Sub-cycle time not available.
+#endif // ARDUINO_ARCH_AVR
+        uint8_t n = 0;
+        while(n < maxFrames)
+            {
+#ifdef ARDUINO_ARCH_AVR
+            // Stop if at/past the deadline or if the cycle has wrapped;
+            // a deadline of GSCT_MAX is never reached.
+            const uint8_t sct = OTV0P2BASE::getSubCycleTime();
+            if(((OTV0P2BASE::GSCT_MAX != deadlineSubCycle) && (sct >= deadlineSubCycle)) || (sct < sctStart)) { break; }
+#endif // ARDUINO_ARCH_AVR
+            const volatile uint8_t *const pb = peekRXMsg();
+            if(NULL == pb) { break; }
+            // Note the arrival stamp (if any) before the handler runs.
+            uint16_t stamp;
+            OTRXArrivalStamps *const rs = rxStamps;
+            const bool stamped = (NULL != rs) && (NULL != rxLatency) && rs->peekOldest(stamp);
+            const uint8_t frameType = pb[0];
+            handler(pb);
+            if(stamped) { rxLatency->record(frameType, uint16_t(rs->now() - stamp)); }
+            removeRXMsg();
+            ++n;
+            }
+        return(n);
+        }
+
+    // Print channel stats in human-readable form on one line, eg to the CLI.
+    void printChannelStats(Print *const p, const OTRadioChannelStats &s)
+        {
+        p->print(F("rx ")); p->print((unsigned long)s.rxFrames);
+        p->print(F(" drop ")); p->print(s.rxDropped);
+        p->print(F(" filt ")); p->print(s.rxFiltered);
+        p->print(F(" crc ")); p->print(s.rxCRCErrors);
+        p->print(F(" tx ")); p->print(s.txAttempts);
+        p->print(F(" rssi"));
+        for(uint8_t i = 0; i < OTRadioChannelStats::RSSI_HISTOGRAM_BINS; ++i)
+            { p->print(' '); p->print(s.rssiHistogram[i]); }
+        p->println();
+        }
+
+    // Put a subset of channel stats into a stats rotation, as low-priority stats.
+    bool putChannelStats(OTV0P2BASE::SimpleStatsRotationBase &ss, const OTRadioChannelStats &s)
+        {
+        constexpr uint16_t cap = 0x7fff;
+        bool ok = true;
+        ok &= ss.put(V0p2_SENSOR_TAG_F("rx"), (int16_t)((s.rxFrames > cap) ? cap : s.rxFrames), true);
+        ok &= ss.put(V0p2_SENSOR_TAG_F("rxD"), (int16_t)OTV0P2BASE::fnmin(s.rxDropped, cap), true);
+        ok &= ss.put(V0p2_SENSOR_TAG_F("rxF"), (int16_t)OTV0P2BASE::fnmin(s.rxFiltered, cap), true);
+        ok &= ss.put(V0p2_SENSOR_TAG_F("rxC"), (int16_t)OTV0P2BASE::fnmin(s.rxCRCErrors, cap), true);
+        ok &= ss.put(V0p2_SENSOR_TAG_F("tx"), (int16_t)OTV0P2BASE::fnmin(s.txAttempts, cap), true);
+        return(ok);
+        }
+
+    // Print RX queue stats in human-readable form on one line, eg to the CLI.
+    void printRXQueueStats(Print *const p, const ISRRXQueueStats &s)
+        {
+        p->print(F("hwm ")); p->print(s.highWaterMsgs);
+        p->print(' '); p->print(s.highWaterBytes);
+        p->print(F("B full ")); p->print(s.fullEvents);
+        p->print(F(" time ")); p->print(s.fullSamples);
+        p->print('/'); p->print(s.samples);
+        p->print(F(" len"));
+        for(uint8_t i = 0; i < ISRRXQueueStats::LENGTH_HISTOGRAM_BINS; ++i)
+            { p->print(' '); p->print(s.lengthHistogram[i]); }
+        p->println();
+        }
+
+    // Print RX latency stats in human-readable form on one line, eg to the CLI.
+    void printRXLatencyStats(Print *const p, const OTRXLatencyStats &s)
+        {
+        static const char classTag[OTRXLatencyStats::FRAME_CLASSES] = { 'O', '!', '*' };
+        p->print(F("lat"));
+        for(uint8_t c = 0; c < OTRXLatencyStats::FRAME_CLASSES; ++c)
+            {
+            p->print(' '); p->print(classTag[c]);
+            p->print(' '); p->print((unsigned long)s.getCount(c));
+            p->print(' '); p->print(s.getPercentileTicks(c, 50));
+            p->print(' '); p->print(s.getPercentileTicks(c, 99));
+            }
+        p->println();
+        }
+
+    // Put a subset of RX queue stats into a stats rotation, as low-priority stats.
+    bool putRXQueueStats(OTV0P2BASE::SimpleStatsRotationBase &ss, const ISRRXQueueStats &s)
+        {
+        constexpr uint16_t cap = 0x7fff;
+        bool ok = true;
+        ok &= ss.put(V0p2_SENSOR_TAG_F("rxqH"), (int16_t)s.highWaterMsgs, true);
+        ok &= ss.put(V0p2_SENSOR_TAG_F("rxqF"), (int16_t)OTV0P2BASE::fnmin(s.fullEvents, cap), true);
+        if(0 != s.samples)
+            { ok &= ss.put(V0p2_SENSOR_TAG_F("rxqT"), (int16_t)((1000UL * s.fullSamples) / s.samples), true); }
+        return(ok);
+        }
+
+    // Set (or clear with NULL) storage for per-channel stats, for channels [0,n-1].
+    void OTRadioLink::setChannelStats(OTRadioChannelStats *const stats, const uint8_t n)
+        {
+        if(NULL != stats) { for(uint8_t i = 0; i < n; ++i) { stats[i].clear(); } }
+        // Lock out interrupts to ensure that the ISR sees a consistent pointer and count.
+        OTV0P2BASE::RAII_AtomicBlock lock;
+        channelStats = stats;
+        nChannelStats = (NULL == stats) ? 0 : n;
+        }
+
+    // Set (or clear with NULL) storage for RX arrival stamps and the latency stats fed from them.
+    void OTRadioLink::setRXLatency(OTRXArrivalStamps *const stamps, OTRXLatencyStats *const stats)
+        {
+        if(NULL != stamps) { stamps->clear(); }
+        if(NULL != stats) { stats->clear(); }
+        // Lock out interrupts to ensure that the ISR sees a consistent pointer.
+        OTV0P2BASE::RAII_AtomicBlock lock;
+        rxStamps = stamps;
+        rxLatency = stats;
+        }
+
+    // Take a consistent copy of the stats for the given channel.
+    bool OTRadioLink::getChannelStats(const int8_t channel, OTRadioChannelStats &out) const
+        {
+        // Lock out interrupts so that no multi-byte counter is seen half-updated.
+        OTV0P2BASE::RAII_AtomicBlock lock;
+        const OTRadioChannelStats *const s = _getStats(channel);
+        if(NULL == s) { return(false); }
+        out = *s;
+        return(true);
+        }
+
+#ifdef ARDUINO
+    // Dump per-channel radio stats for one radio to Serial (eg "R [N]").
+    bool RadioStatsCLI::doCommand(char *const buf, const uint8_t buflen)
+        {
+        int8_t first = 0, last = 127;
+        char *lastTok; // Used by strtok_r().
+        char *tok1;
+        // Minimum 3 character sequence makes sense and is safe to tokenise, eg "R 0".
+        if((buflen >= 3) && (NULL != (tok1 = strtok_r(buf+2, " ", &lastTok))))
+            { first = last = (int8_t) atoi(tok1); }
+        OTRadioChannelStats s;
+        for(int8_t c = first; (c >= 0) && (c <= last) && rl.getChannelStats(c, s); ++c)
+            {
+            Serial.print(c);
+            Serial.print(' ');
+            printChannelStats(&Serial, s);
+            }
+        return(false);
+        }
+#endif // ARDUINO
+
 #ifdef ARDUINO_ARCH_AVR
     // Set (or clear) the optional fast filter for RX ISR/poll; NULL to clear.
     // The routine should return false to drop an inbound frame early in processing,
@@ -27,12 +27,14 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015--2016
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #ifdef ARDUINO
 #include <Print.h>
 #endif
 
 #include <OTV0p2Base.h>
+#include "OTRadioLink_ISRRXQueue.h"
 
 
 // Use namespaces to help avoid collisions.
@@ -41,6 +43,8 @@ namespace OTRadioLink
     // Helper routine to compute the length of an 0xff-terminated frame,
     // excluding the trailing 0xff.
     // Returns 0 if NULL or unterminated (within 255 bytes).
+    // Not needed for frames from a radio that delimits them itself,
+    // eg the RFM23B in packet-handler mode.
     uint8_t frameLenFFTerminated(const uint8_t *buf);
 
 #ifdef ARDUINO
@@ -76,8 +80,8 @@ namespace OTRadioLink
     typedef class OTRadioChannelConfig
         {
         public:
-            OTRadioChannelConfig(const void *_config, bool _isFull, bool _isRX = true, bool _isTX = true, bool _isAuth = false, bool _isEnc = false, bool _isUnframed = false) :
-                config(_config), isFull(_isFull), isRX(_isRX), isTX(_isTX), isAuth(_isAuth), isEnc(_isEnc), isUnframed(_isUnframed) { }
+            OTRadioChannelConfig(const void *_config, bool _isFull, bool _isRX = true, bool _isTX = true, bool _isAuth = false, bool _isEnc = false, bool _isUnframed = false, uint32_t _bitrate = 0) :
+                config(_config), isFull(_isFull), isRX(_isRX), isTX(_isTX), isAuth(_isAuth), isEnc(_isEnc), isUnframed(_isUnframed), bitrate(_bitrate) { }
             // Opaque configuration dependent on radio type.
             // Nothing other than the radio module should attempt to access/use this.
             const void *config;
@@ -93,8 +97,363 @@ namespace OTRadioLink
             const bool isEnc:1;
             // True if this bearer does not provide framing including explicit (leading) frame length.
             const bool isUnframed:1;
+            // Over-the-air bit rate (bits per second) for airtime accounting; 0 if unknown or not applicable.
+            const uint32_t bitrate;
         } OTRadioChannelConfig_t;
 
+    // Sliding-window radio time-on-air accountant, eg to stay within regulatory duty-cycle limits.
+    // The window is divided into BUCKETS equal periods;
+    // the application calls advance() at the end of each period (eg every 10 minutes for a 1h window)
+    // which forgets the airtime of the oldest period.
+    // Storage is supplied by the application via OTRadioLink::setDutyCycle(),
+    // and may be shared by several radios using the same band.
+    // Airtime is in milliseconds and saturates rather than wrapping.
+    // NOT ISR-safe: updated by sendRaw() and queried from the main loop.
+    class OTRadioDutyCycle final
+        {
+        public:
+            // Number of periods in the window.
+            static constexpr uint8_t BUCKETS = 6;
+            // Default per-frame overhead in bytes not in the frame buffer, eg preamble, sync and CRC.
+            static constexpr uint8_t DEFAULT_OVERHEAD_BYTES = 8;
+
+        private:
+            // Airtime recorded in each period; index current is the period in progress.
+            uint32_t airtimeMs[BUCKETS];
+            uint8_t current;
+            // Maximum airtime allowed within the window.
+            const uint32_t limitMs;
+
+        public:
+            // Window of BUCKETS periods of periodS seconds each, allowing permille/1000 of it as airtime,
+            // eg OTRadioDutyCycle(600, 10) for 1% in any hour (as for 868.0--868.6MHz in EN 300 220).
+            constexpr OTRadioDutyCycle(const uint16_t periodS, const uint16_t permille)
+              : airtimeMs(), current(0), limitMs((uint32_t)periodS * BUCKETS * permille) { }
+
+            // Airtime in ms (rounded up) for a frame of frameBytes plus overheadBytes at bitrate bits/s.
+            // Returns 0 if the bitrate is 0 (unknown).
+            static constexpr uint32_t frameAirtimeMs(const uint8_t frameBytes, const uint32_t bitrate,
+                                                     const uint8_t overheadBytes = DEFAULT_OVERHEAD_BYTES)
+                { return((0 == bitrate) ? 0 : (((uint32_t)frameBytes + overheadBytes) * 8000UL + bitrate - 1) / bitrate); }
+
+            // Total airtime recorded within the window.
+            uint32_t getAirtimeMs() const
+                {
+                uint32_t t = 0;
+                for(uint8_t i = 0; i < BUCKETS; ++i) { t += airtimeMs[i]; if(t < airtimeMs[i]) { return(0xffffffffUL); } }
+                return(t);
+                }
+            // Maximum airtime allowed within the window.
+            uint32_t getLimitMs() const { return(limitMs); }
+            // True if a further ms of airtime would stay within the limit.
+            bool canSend(const uint32_t ms) const
+                { const uint32_t t = getAirtimeMs(); return((t <= limitMs) && (ms <= limitMs - t)); }
+            // Record ms of airtime in the current period.
+            void record(const uint32_t ms)
+                { uint32_t &a = airtimeMs[current]; a = ((a + ms) < a) ? 0xffffffffUL : (a + ms); }
+            // End the current period, forgetting the oldest.
+            void advance() { if(++current >= BUCKETS) { current = 0; } airtimeMs[current] = 0; }
+            // Forget all recorded airtime.
+            void clear() { memset(airtimeMs, 0, sizeof(airtimeMs)); }
+        };
+
+    // Per-channel radio traffic statistics, for capacity planning.
+    // Wider than the 8-bit 'recent' counters in OTRadioLink and separated by channel.
+    // The 16-bit counters (and histogram bins) saturate at 0xffff;
+    // the 32-bit received-frame count wraps.
+    // Updated by the radio driver, typically in the RX ISR.
+    // Storage is supplied by the application via OTRadioLink::setChannelStats().
+    struct OTRadioChannelStats final
+        {
+        // Number of (coarse) RSSI histogram bins.
+        static constexpr uint8_t RSSI_HISTOGRAM_BINS = 8;
+        // Frames received and queued.
+        uint32_t rxFrames;
+        // Frames dropped for lack of queue space (or being too long).
+        uint16_t rxDropped;
+        // Frames rejected by the quick RX filter.
+        uint16_t rxFiltered;
+        // Frames rejected by radio hardware for bad CRC, where detectable.
+        uint16_t rxCRCErrors;
+        // TX attempts (each frame sent counts once, however many times it is actually transmitted).
+        uint16_t txAttempts;
+        // Counts of frames received by raw RSSI reading, in equal-width bins over [0,255].
+        // Units depend on the radio, eg for the RFM23B about [-120,20]dB in 0.5dB steps.
+        uint16_t rssiHistogram[RSSI_HISTOGRAM_BINS];
+
+        // Map a raw 8-bit RSSI value into a histogram bin index.
+        static constexpr uint8_t rssiBin(const uint8_t rssi) { return(rssi >> 5); }
+        // Saturating increment for 16-bit counters.
+        static inline void inc(uint16_t &c) { if(0xffff != c) { ++c; } }
+        // Reset all counters to zero.
+        void clear() { memset(this, 0, sizeof(*this)); }
+        };
+
+    // Print channel stats in human-readable form on one line, eg to the CLI.
+    // Prints:
+    //     rx N drop N filt N crc N tx N rssi N N N N N N N N
+    void printChannelStats(Print *p, const OTRadioChannelStats &s);
+
+    // Print RX queue stats in human-readable form on one line, eg to the CLI.
+    // Prints:
+    //     hwm N NB full N time N/N len N N N N N N N N
+    void printRXQueueStats(Print *p, const ISRRXQueueStats &s);
+
+    // Arrival stamps for queued RX frames, to measure queueing latency (see OTRXLatencyStats).
+    // A small FIFO kept alongside the driver's RX queue,
+    // stamped as each frame is queued (from the RX ISR) and popped as each is removed,
+    // so the oldest stamp is that of the frame from peekRXMsg().
+    // Only the oldest MAX_STAMPS queued frames can be stamped,
+    // and a frame queued behind an unstamped one is not stamped either.
+    // Stamps are 16-bit ticks from the ISR-safe time source supplied,
+    // eg the low bits of OTV0P2BASE::getMonotonicTicks() (~7.8ms, wrapping after ~8.5 minutes).
+    // Storage is supplied by the application via OTRadioLink::setRXLatency().
+    struct OTRXArrivalStamps final
+        {
+        // Maximum number of queued frames stamped.
+        static constexpr uint8_t MAX_STAMPS = 8;
+        typedef uint16_t now_fn_t();
+        // Time source; never NULL.
+        now_fn_t *const now;
+        // Stamps of the oldest 'stamped' frames, from index 'oldest'.
+        volatile uint16_t stamp[MAX_STAMPS];
+        volatile uint8_t oldest;
+        volatile uint8_t stamped;
+        // Frames queued, stamped or not.
+        volatile uint8_t queued;
+
+        explicit OTRXArrivalStamps(now_fn_t *const _now) : now(_now), stamp(), oldest(0), stamped(0), queued(0) { }
+
+        // Note a frame queued.
+        // Use only from the ISR or with interrupts locked out.
+        void noteQueued()
+            {
+            const uint8_t s = stamped;
+            if((s == queued) && (s < MAX_STAMPS))
+                {
+                const uint8_t i = oldest + s;
+                stamp[(i >= MAX_STAMPS) ? (i - MAX_STAMPS) : i] = now();
+                stamped = s + 1;
+                }
+            if(0xff != queued) { ++queued; }
+            }
+        // Note the oldest frame removed.
+        // Use only with interrupts locked out.
+        void noteRemoved()
+            {
+            if(0 == queued) { return; }
+            --queued;
+            if(0 == stamped) { return; }
+            --stamped;
+            if(++oldest >= MAX_STAMPS) { oldest = 0; }
+            }
+        // Get the stamp of the oldest queued frame; false if it has none.
+        bool peekOldest(uint16_t &t) const
+            {
+            if(0 == stamped) { return(false); }
+            t = stamp[oldest];
+            return(true);
+            }
+        // Forget all frames, eg if the RX queue is flushed.
+        void clear() { oldest = 0; stamped = 0; queued = 0; }
+        };
+
+    // Histograms of RX queueing latency, from frame queued to handler completion,
+    // split by frame type, for p50/p99 figures, eg to see whether a hub keeps up.
+    // Fed by OTRadioLink::drainRX() for frames stamped by OTRXArrivalStamps,
+    // in the same ticks as the stamps.
+    // The 16-bit bins saturate at 0xffff.
+    struct OTRXLatencyStats final
+        {
+        // Frame type classes: secure or insecure 'O' valve/sensor frames, '!' beacons, and all others.
+        enum FrameClass : uint8_t { FC_VALVE, FC_BEACON, FC_OTHER, FRAME_CLASSES };
+        // Number of latency bins: bin 0 is 0 ticks, bin i in [1,LATENCY_BINS-2] is [2^(i-1),2^i-1] ticks,
+        // and the last is everything longer.
+        static constexpr uint8_t LATENCY_BINS = 12;
+        uint16_t latencyHistogram[FRAME_CLASSES][LATENCY_BINS];
+
+        // Frame class from the first (type) byte of a frame.
+        static constexpr uint8_t frameClass(const uint8_t frameType)
+            { return(('O' == (frameType & 0x7f)) ? FC_VALVE : (('!' == (frameType & 0x7f)) ? FC_BEACON : FC_OTHER)); }
+        // Map a latency into a bin index.
+        static uint8_t latencyBin(uint16_t ticks)
+            {
+            uint8_t b = 0;
+            while((0 != ticks) && (b < LATENCY_BINS - 1)) { ticks >>= 1; ++b; }
+            return(b);
+            }
+        // Largest latency in bin b; 0xffff for the last.
+        static constexpr uint16_t binMaxTicks(const uint8_t b)
+            { return((b >= LATENCY_BINS - 1) ? 0xffff : uint16_t((1U << b) - 1)); }
+        // Saturating increment for 16-bit counters.
+        static inline void inc(uint16_t &c) { if(0xffff != c) { ++c; } }
+        // Record a frame of the given type handled the given ticks after being queued.
+        void record(const uint8_t frameType, const uint16_t ticks)
+            { inc(latencyHistogram[frameClass(frameType)][latencyBin(ticks)]); }
+        // Frames recorded for a class.
+        uint32_t getCount(const uint8_t fc) const
+            {
+            uint32_t n = 0;
+            if(fc < FRAME_CLASSES) { for(uint8_t b = 0; b < LATENCY_BINS; ++b) { n += latencyHistogram[fc][b]; } }
+            return(n);
+            }
+        // Upper bound (bin maximum) of the pc percentile [1,100] latency for a class; 0 if no frames.
+        uint16_t getPercentileTicks(const uint8_t fc, const uint8_t pc) const
+            {
+            const uint32_t n = getCount(fc);
+            if(0 == n) { return(0); }
+            // Smallest count at or beyond the percentile, rounded up.
+            const uint32_t target = ((n * pc) + 99) / 100;
+            uint32_t c = 0;
+            for(uint8_t b = 0; b < LATENCY_BINS; ++b)
+                {
+                c += latencyHistogram[fc][b];
+                if((c >= target) && (0 != c)) { return(binMaxTicks(b)); }
+                }
+            return(binMaxTicks(LATENCY_BINS - 1));
+            }
+        // Reset all counters to zero.
+        void clear() { memset(this, 0, sizeof(*this)); }
+        };
+
+    // Print RX latency stats in human-readable form on one line, eg to the CLI,
+    // as frame count and p50 and p99 latency (ticks, bin upper bounds) per class.
+    // Prints:
+    //     lat O N N N ! N N N * N N N
+    void printRXLatencyStats(Print *p, const OTRXLatencyStats &s);
+
+    // One step of an OTRadioListenPlan: listen on channel for dwellMs (strictly positive).
+    struct OTRadioListenSlot final
+        {
+        int8_t channel;
+        uint16_t dwellMs;
+        };
+
+    // Per-slot OTRadioListenPlan statistics.
+    // The 16-bit counters saturate at 0xffff; listenMs wraps.
+    struct OTRadioListenSlotStats final
+        {
+        // Total time spent listening in this slot.
+        uint32_t listenMs;
+        // Times this slot has been entered.
+        uint16_t visits;
+        // Times RX activity (eg preamble or sync detect) started a hold.
+        uint16_t holds;
+        // Holds that ended without a frame.
+        uint16_t holdTimeouts;
+        // Frames received (or dropped or filtered) in this slot.
+        uint16_t frames;
+        // Reset all counters to zero.
+        void clear() { memset(this, 0, sizeof(*this)); }
+        };
+
+    // Plan for one radio to listen on several channels in turn,
+    // eg FS20/FHT8V OOK and OpenTRV GFSK at a hub.
+    // Each slot is listened to for its dwell time and then the next, wrapping round.
+    // When RX activity such as a valid preamble is seen within a slot's dwell
+    // the radio holds on that channel for up to holdMs for the rest of the frame;
+    // a received frame ends the hold and restarts the slot's dwell
+    // so that follow-up frames (eg repeats) are caught.
+    // The hold is not extended by further activity, so noise cannot capture the radio.
+    // Slot and stats storage is supplied by the application
+    // and must outlive the plan; the slot list is read-only.
+    // Attach to a radio with OTRadioLink::setListenPlan(); the radio's per-channel
+    // stats still count frames against whichever channel they arrived on.
+    // Times are in ms from any free-running clock, eg millis(), and may wrap.
+    // NOT ISR-safe: driven from the radio's poll().
+    class OTRadioListenPlan final
+        {
+        public:
+            // Default maximum hold on a channel once activity is seen,
+            // long enough for a ~80ms FHT8V frame and its preamble.
+            static constexpr uint16_t DEFAULT_HOLD_MS = 250;
+
+        private:
+            const OTRadioListenSlot *const slots;
+            const uint8_t nSlots;
+            OTRadioListenSlotStats *const stats;
+            const uint16_t holdMs;
+            // Current slot and when it was entered.
+            uint8_t current;
+            uint32_t slotStartMs;
+            // True while holding for a frame, since holdStartMs.
+            bool holding;
+            uint32_t holdStartMs;
+
+            void _leave(const uint32_t nowMs)
+                { if(NULL != stats) { stats[current].listenMs += nowMs - slotStartMs; } }
+            void _enter(const uint8_t slot, const uint32_t nowMs)
+                {
+                current = slot;
+                slotStartMs = nowMs;
+                holding = false;
+                if(NULL != stats) { OTRadioChannelStats::inc(stats[slot].visits); }
+                }
+
+        public:
+            //   * slots  nSlots slots in listening order; never NULL
+            //   * nSlots  number of slots; strictly positive
+            //   * stats  nSlots entries for per-slot stats, or NULL
+            //   * holdMs  maximum hold on activity; 0 to never hold
+            constexpr OTRadioListenPlan(const OTRadioListenSlot *const _slots, const uint8_t _nSlots,
+                                        OTRadioListenSlotStats *const _stats = NULL,
+                                        const uint16_t _holdMs = DEFAULT_HOLD_MS)
+              : slots(_slots), nSlots(_nSlots), stats(_stats), holdMs(_holdMs),
+                current(0), slotStartMs(0), holding(false), holdStartMs(0) { }
+
+            // Start again from the first slot at nowMs, clearing any stats; returns its channel.
+            int8_t restart(const uint32_t nowMs)
+                {
+                if(NULL != stats) { for(uint8_t i = 0; i < nSlots; ++i) { stats[i].clear(); } }
+                _enter(0, nowMs);
+                return(getChannel());
+                }
+
+            // Advance the plan to nowMs given what was seen since the last call;
+            // returns the channel to listen on.
+            //   * activity  true if RX activity (eg preamble or sync detect) was seen
+            //   * frame  true if a frame arrived
+            int8_t update(const uint32_t nowMs, const bool activity, const bool frame)
+                {
+                if(frame)
+                    {
+                    if(NULL != stats) { OTRadioChannelStats::inc(stats[current].frames); }
+                    holding = false;
+                    _leave(nowMs);
+                    slotStartMs = nowMs;
+                    return(getChannel());
+                    }
+                if(activity && !holding && (0 != holdMs))
+                    {
+                    holding = true;
+                    holdStartMs = nowMs;
+                    if(NULL != stats) { OTRadioChannelStats::inc(stats[current].holds); }
+                    }
+                if(holding)
+                    {
+                    if((uint32_t)(nowMs - holdStartMs) < holdMs) { return(getChannel()); }
+                    if(NULL != stats) { OTRadioChannelStats::inc(stats[current].holdTimeouts); }
+                    }
+                else if((uint32_t)(nowMs - slotStartMs) < slots[current].dwellMs) { return(getChannel()); }
+                // Hop.
+                _leave(nowMs);
+                _enter((current + 1 >= nSlots) ? 0 : uint8_t(current + 1), nowMs);
+                return(getChannel());
+                }
+
+            // Channel of the current slot.
+            int8_t getChannel() const { return(slots[current].channel); }
+            // Index of the current slot.
+            uint8_t getSlot() const { return(current); }
+            // True if holding on the current channel for a frame.
+            bool isHolding() const { return(holding); }
+            // Number of slots.
+            uint8_t getSlots() const { return(nSlots); }
+            // Stats for slot, or NULL if none are being collected.
+            const OTRadioListenSlotStats *getStats(const uint8_t slot) const
+                { return(((NULL == stats) || (slot >= nSlots)) ? NULL : (stats + slot)); }
+        };
+
     // Type of a fast ISR-safe filter routine to quickly reject uninteresting RX frames.
     // Return false if the frame is uninteresting and should be dropped.
     // The aim of this is to drop such uninteresting frames quickly and reduce queueing pressure.
@@ -117,6 +476,12 @@ namespace OTRadioLink
     // Always returns true, ie never rejects a frame outright.
     quickFrameFilter_t frameFilterTrailingZeros;
 
+    // Type of a handler for each frame visited by OTRadioLink::drainRX().
+    // The frame is passed in place in the RX queue,
+    // with its length in the byte before the start of the frame, ie msg[-1].
+    // The buffer content may not be altered, and is not valid after return.
+    typedef void (RXFrameDrainHandler_fn_t)(volatile const uint8_t *msg);
+
     // Base class for radio link hardware driver.
     // Radios can support multiple channels and can be (for example) TX-only for leaf nodes.
     // Implementation cannot be assume to either re-entrant or ISR-safe except where stated.
@@ -154,6 +519,63 @@ namespace OTRadioLink
             // Marked volatile for ISR-/thread- safe access without a lock.
             volatile uint8_t filteredRXedMessageCountRecent;
 
+            // Optional per-channel stats, one per channel from 0; NULL if not being collected.
+            // Pointer and count must be updated only with interrupts locked out.
+            OTRadioChannelStats *channelStats;
+            uint8_t nChannelStats;
+
+            // Get the stats for the specified channel, or NULL if none.
+            // Use only from the ISR or with interrupts locked out.
+            inline OTRadioChannelStats *_getStats(const int8_t channel) const
+                { return(((channel < 0) || (channel >= (int8_t)nChannelStats)) ? NULL : (channelStats + channel)); }
+            // Helpers for drivers to record events against the given channel.
+            // Do nothing if stats are not being collected for that channel.
+            // Use only from the ISR or with interrupts locked out.
+            inline void _statsRXQueued(const int8_t channel, const uint8_t rssi)
+                {
+                OTRadioChannelStats *const s = _getStats(channel);
+                if(NULL == s) { return; }
+                ++(s->rxFrames);
+                OTRadioChannelStats::inc(s->rssiHistogram[OTRadioChannelStats::rssiBin(rssi)]);
+                }
+            inline void _statsRXDropped(const int8_t channel)
+                { OTRadioChannelStats *const s = _getStats(channel); if(NULL != s) { OTRadioChannelStats::inc(s->rxDropped); } }
+            inline void _statsRXFiltered(const int8_t channel)
+                { OTRadioChannelStats *const s = _getStats(channel); if(NULL != s) { OTRadioChannelStats::inc(s->rxFiltered); } }
+            inline void _statsRXCRCError(const int8_t channel)
+                { OTRadioChannelStats *const s = _getStats(channel); if(NULL != s) { OTRadioChannelStats::inc(s->rxCRCErrors); } }
+            inline void _statsTXAttempt(const int8_t channel)
+                { OTRadioChannelStats *const s = _getStats(channel); if(NULL != s) { OTRadioChannelStats::inc(s->txAttempts); } }
+
+            // Optional RX arrival stamps and latency stats fed from them; NULL if not being collected.
+            // Pointers must be updated only with interrupts locked out.
+            OTRXArrivalStamps *rxStamps;
+            OTRXLatencyStats *rxLatency;
+            // Helpers for drivers to keep any arrival stamps in step with the RX queue:
+            // call _stampRXQueued() whenever a frame is queued (from the ISR)
+            // and _stampRXRemoved() from removeRXMsg().
+            inline void _stampRXQueued() { OTRXArrivalStamps *const s = rxStamps; if(NULL != s) { s->noteQueued(); } }
+            void _stampRXRemoved() { OTV0P2BASE::RAII_AtomicBlock lock; OTRXArrivalStamps *const s = rxStamps; if(NULL != s) { s->noteRemoved(); } }
+
+            // Optional airtime accountant; NULL if none.
+            OTRadioDutyCycle *dutyCycle;
+            // Record one actual transmission of a frame of buflen bytes on the given channel.
+            // Drivers should call this for each time a frame goes on air, eg twice for a double TX.
+            // Does nothing if there is no accountant or the channel bitrate is unknown.
+            void _recordTX(const int8_t channel, const uint8_t buflen)
+                { if(NULL != dutyCycle) { dutyCycle->record(getFrameAirtimeMs(channel, buflen)); } }
+
+            // Optional listen plan; NULL if listening on one channel only.
+            OTRadioListenPlan *listenPlan;
+            // Advance any listen plan and follow it, if listening at all.
+            // Drivers call this from poll() (not the ISR) with RX activity seen since the last call;
+            // safe to call with no plan set.
+            void _pollListenPlan(const uint32_t nowMs, const bool activity, const bool frame)
+                {
+                if((NULL == listenPlan) || (-1 == listenChannel)) { return; }
+                listen(true, listenPlan->update(nowMs, activity, frame));
+                }
+
             // Optional fast filter for RX ISR/poll; NULL if not present.
             // The routine should return false to drop an inbound frame early in processing,
             // to save queue space and CPU, and cope better with a busy channel.
@@ -176,9 +598,67 @@ namespace OTRadioLink
             constexpr OTRadioLink()
               : listenChannel(-1), nChannels(0), channelConfig(NULL),
                 droppedRXedMessageCountRecent(0), filteredRXedMessageCountRecent(0),
+                channelStats(NULL), nChannelStats(0),
+                rxStamps(NULL), rxLatency(NULL),
+                dutyCycle(NULL),
+                listenPlan(NULL),
                 filterRXISR(NULL)
                 { }
 
+            // Set (or clear with NULL) storage for per-channel stats, for channels [0,n-1].
+            // The stats are cleared.
+            // The storage lifetime must be at least that of this OTRadioLink instance
+            // (or until cleared) as the pointer will be retained internally.
+            void setChannelStats(OTRadioChannelStats *stats, uint8_t n);
+
+            // Set (or clear with NULL) the airtime accountant fed by sendRaw() and checked by canSendNow().
+            // The accountant lifetime must be at least that of this OTRadioLink instance
+            // (or until cleared) as the pointer will be retained internally.
+            void setDutyCycle(OTRadioDutyCycle *const dc) { dutyCycle = dc; }
+
+            // Set (or clear with NULL) a plan for hopping between listen channels, starting it at nowMs.
+            // While a plan is set and listening is on (see listen()) the driver follows the plan
+            // from its poll(), overriding the channel passed to listen();
+            // listen(false) still stops listening.
+            // If already listening, switches at once to the plan's first channel
+            // (or stays on the current one if the plan is cleared).
+            // The plan lifetime must be at least that of this OTRadioLink instance
+            // (or until cleared) as the pointer will be retained internally.
+            // Not all drivers support listen plans: see the driver's poll().
+            void setListenPlan(OTRadioListenPlan *const plan, const uint32_t nowMs)
+                {
+                listenPlan = plan;
+                const int8_t oldListenChannel = listenChannel;
+                if(-1 == oldListenChannel) { if(NULL != plan) { plan->restart(nowMs); } return; }
+                listen(true, (NULL == plan) ? oldListenChannel : plan->restart(nowMs));
+                // Reapply if unchanged, eg so that the driver can set up activity detection for the plan.
+                if(oldListenChannel == listenChannel) { _dolisten(); }
+                }
+            // Current listen plan, or NULL if none.
+            const OTRadioListenPlan *getListenPlan() const { return(listenPlan); }
+
+            // Airtime in ms of one transmission of a frame of buflen bytes on the given channel.
+            // Returns 0 if the channel or its bitrate is unknown.
+            uint32_t getFrameAirtimeMs(const int8_t channel, const uint8_t buflen) const
+                {
+                if(channel < 0) { return(0); }
+                const OTRadioChannelConfig_t *const c = getChannelConfig((uint8_t)channel);
+                return((NULL == c) ? 0 : OTRadioDutyCycle::frameAirtimeMs(buflen, c->bitrate));
+                }
+
+            // Take a consistent copy of the stats for the given channel.
+            // Returns false (and leaves out unchanged) if stats are not being collected for that channel.
+            // Safe to call from the main loop while the ISR is updating stats.
+            bool getChannelStats(int8_t channel, OTRadioChannelStats &out) const;
+
+            // Set (or clear with NULL) storage for RX arrival stamps and the latency stats fed from them.
+            // Stamps are taken only by drivers that support them (see _stampRXQueued()),
+            // and latency is recorded as drainRX() completes each stamped frame.
+            // Both are cleared; set while the RX queue is empty so that stamps match frames.
+            // The storage lifetime must be at least that of this OTRadioLink instance
+            // (or until cleared) as the pointers will be retained internally.
+            void setRXLatency(OTRXArrivalStamps *stamps, OTRXLatencyStats *stats);
+
             // Set (or clear) the optional fast filter for RX ISR/poll; NULL to clear.
             // The routine should return false to drop an inbound frame early in processing,
             // to save queue space and CPU, and cope better with a busy channel.
@@ -308,6 +788,18 @@ namespace OTRadioLink
             // Not intended to be called from an ISR.
             virtual void removeRXMsg() = 0;
 
+            // Process queued RX frames in place in a single pass, oldest first.
+            // Calls the handler with each frame in turn then removes it from the queue,
+            // recording its queueing latency if set up to (see setRXLatency()),
+            // stopping when the queue is empty or maxFrames have been processed,
+            // or (where the sub-cycle time is available) if the sub-cycle time
+            // reaches deadlineSubCycle or the minor cycle ends, before starting a frame.
+            // The default deadline of GSCT_MAX is never reached,
+            // so then only the end of the minor cycle stops the pass early.
+            // Returns the number of frames processed.
+            // Not intended to be called from an ISR.
+            uint8_t drainRX(RXFrameDrainHandler_fn_t *handler, uint8_t maxFrames = 255, uint8_t deadlineSubCycle = 255);
+
             // Basic RX error numbers in range 0--127 as returned by getRXRerr() (cast to uint8_t).
             // Implementations can provide more specific errors in range 128--255.
             // 0 (zero) means no error.
@@ -333,6 +825,17 @@ namespace OTRadioLink
             //   * TXmin may for example be used to minimise the chance of being overheard during pairing.
             enum TXpower : uint8_t { TXmin, TXquiet, TXnormal, TXloud, TXmax };
 
+            // True if a frame of buflen bytes can be sent now on the given channel within the duty-cycle limit.
+            // Conservatively assumes that TXmax may send the frame twice.
+            // Always true if there is no accountant or the channel bitrate is unknown.
+            // Checked by queueToSend(); sendRaw() does not refuse frames over the limit.
+            bool canSendNow(const int8_t channel, const uint8_t buflen, const TXpower power = TXnormal) const
+                {
+                if(NULL == dutyCycle) { return(true); }
+                const uint32_t ms = getFrameAirtimeMs(channel, buflen);
+                return(dutyCycle->canSend((power >= TXmax) ? (2 * ms) : ms));
+                }
+
             /**
              * @brief   Send/TX a raw frame on the specified (default first/0) channel.
              * 
@@ -364,7 +867,22 @@ namespace OTRadioLink
             //     this hint may be ignored.
             // Defaults to redirect to sendRaw(), in which case see sendRaw() comments.
             // Should not block unless in a call to sendRaw().
-            virtual bool queueToSend(const uint8_t *buf, uint8_t buflen, int8_t channel = 0, TXpower power = TXnormal) { return sendRaw(buf, buflen, channel, power); };
+            // Refuses (returns false) if the frame would exceed the duty-cycle limit; see canSendNow().
+            virtual bool queueToSend(const uint8_t *buf, uint8_t buflen, int8_t channel = 0, TXpower power = TXnormal) { return canSendNow(channel, buflen, power) && sendRaw(buf, buflen, channel, power); };
+
+            // Zero-copy alternative to queueToSend() for drivers with a TX queue:
+            // reserve a driver-owned TX buffer, build the frame straight into it
+            // (eg as the outbuf of an OTEncodeData_T), then queue it with commitToSend().
+            // Returns NULL (always, by default) if the driver has no such buffer or none is free,
+            // in which case build the frame locally and use queueToSend() as before.
+            //   * bufsize  set to the size of the buffer returned, else 0
+            // Only one reservation may be outstanding,
+            // and any other frame queued before the commit may overwrite it.
+            virtual uint8_t *reserveToSend(uint8_t &bufsize) { bufsize = 0; return(NULL); }
+            // Queue the frame of buflen bytes built in the buffer from reserveToSend();
+            // otherwise as queueToSend(), including the duty-cycle check.
+            // Returns false (always, by default) if it could not be queued.
+            virtual bool commitToSend(uint8_t /*buflen*/, int8_t /*channel*/ = 0, TXpower /*power*/ = TXnormal) { return(false); }
 
             // Poll for incoming messages (eg where interrupts are not available) and other processing.
             // Can be used safely in addition to handling inbound/outbound interrupts.
@@ -406,6 +924,31 @@ namespace OTRadioLink
         };
 
 
+    // Put a subset of channel stats into a stats rotation, as low-priority stats.
+    // Keys are: "rx" frames received, "rxD" dropped, "rxF" filtered, "rxC" CRC errors, "tx" TX attempts.
+    // Values are capped at 0x7fff to fit the signed 16-bit stats values.
+    // Returns false if any stat could not be added.
+    bool putChannelStats(OTV0P2BASE::SimpleStatsRotationBase &ss, const OTRadioChannelStats &s);
+
+    // Put a subset of RX queue stats into a stats rotation, as low-priority stats.
+    // Keys are: "rxqH" high-water frames, "rxqF" full events,
+    // "rxqT" time at full in parts per thousand of samples (omitted until sampled).
+    // Returns false if any stat could not be added.
+    bool putRXQueueStats(OTV0P2BASE::SimpleStatsRotationBase &ss, const ISRRXQueueStats &s);
+
+#ifdef ARDUINO
+    // Dump per-channel radio stats for one radio to Serial (eg "R [N]").
+    // With no argument dumps all channels for which stats are collected,
+    // else just channel N; one line per channel preceded by the channel number.
+    class RadioStatsCLI final : public OTV0P2BASE::CLIEntryBase
+        {
+        const OTRadioLink &rl;
+        public:
+            RadioStatsCLI(const OTRadioLink &radio) : rl(radio) { }
+            virtual bool doCommand(char *buf, uint8_t buflen) override;
+        };
+#endif // ARDUINO
+
     // Forward some CRC definitions that were in OTRadioLink for compatibility (DHD20160117).
     inline uint8_t crc7_5B_update(uint8_t crc, uint8_t datum) { return(OTV0P2BASE::crc7_5B_update(crc, datum)); }
     static const uint8_t crc7_5B_update_nz_ALT = OTV0P2BASE::crc7_5B_update_nz_ALT;
@@ -0,0 +1,121 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Small cache of recently-relayed frames,
+ * so that relays in range of one another do not keep re-relaying the same frame.
+ */
+
+#ifndef ARDUINO_LIB_OTRADIOLINK_RELAYDEDUP_H
+#define ARDUINO_LIB_OTRADIOLINK_RELAYDEDUP_H
+
+#include <stdint.h>
+
+#include "OTV0P2BASE_CRC.h"
+
+// Use namespaces to help avoid collisions.
+namespace OTRadioLink
+    {
+    // Remembers a short hash of each frame relayed recently.
+    // A relay should drop a frame whose hash is still held
+    // (see relayDedupFrameOperation()).
+    // The hash is a 16-bit CRC over the frame length and bytes,
+    // ie over the raw frame as relayed, so this works for any frame type,
+    // and secure frames from one node always differ by their message counter.
+    // An entry is forgotten once maxAgeTicks tick() calls pass without that frame
+    // being seen again; a new frame displaces the oldest entry if all are in use.
+    // Template parameters:
+    //   * entries  number of frames remembered; strictly positive
+    //   * maxAgeTicks  ticks before an entry is forgotten, eg as minutes; [1,254]
+    // Uses 3 bytes of RAM per entry.
+    // Not thread-/ISR- safe.
+    template<uint8_t entries, uint8_t maxAgeTicks>
+    class OTRelayDedupCache final
+        {
+        static_assert(entries > 0, "must hold at least one entry");
+        static_assert((maxAgeTicks > 0) && (maxAgeTicks < 255), "maximum age out of range");
+
+        private:
+            // Frame hashes.
+            uint16_t keys[entries];
+            // Ticks since each frame was last seen; maxAgeTicks means free.
+            uint8_t ages[entries];
+
+            // Index of the entry holding key, else entries if none.
+            uint8_t find(const uint16_t key) const
+                {
+                for(uint8_t i = 0; i < entries; ++i)
+                    { if((ages[i] < maxAgeTicks) && (key == keys[i])) { return(i); } }
+                return(entries);
+                }
+
+        public:
+            OTRelayDedupCache() { clear(); }
+
+            // Forget all frames.
+            void clear() { for(uint8_t i = 0; i < entries; ++i) { ages[i] = maxAgeTicks; } }
+
+            // Hash of len bytes of frame (non-NULL if len > 0).
+            static uint16_t keyOf(const uint8_t *const frame, const uint8_t len)
+                {
+                uint16_t crc = OTV0P2BASE::crc16_A001_update(0xffff, len);
+                for(uint8_t i = 0; i < len; ++i) { crc = OTV0P2BASE::crc16_A001_update(crc, frame[i]); }
+                return(crc);
+                }
+
+            // Number of frames remembered.
+            uint8_t size() const
+                {
+                uint8_t n = 0;
+                for(uint8_t i = 0; i < entries; ++i) { if(ages[i] < maxAgeTicks) { ++n; } }
+                return(n);
+                }
+
+            // True if the frame was relayed recently.
+            // A hit restarts its age, so a frame bouncing around stays suppressed.
+            bool seen(const uint8_t *const frame, const uint8_t len)
+                {
+                const uint8_t i = find(keyOf(frame, len));
+                if(entries == i) { return(false); }
+                ages[i] = 0;
+                return(true);
+                }
+
+            // Remember the frame as just relayed.
+            void add(const uint8_t *const frame, const uint8_t len)
+                {
+                const uint16_t key = keyOf(frame, len);
+                uint8_t slot = find(key);
+                if(entries == slot)
+                    {
+                    // Use a free else the oldest entry.
+                    slot = 0;
+                    for(uint8_t i = 1; i < entries; ++i) { if(ages[i] > ages[slot]) { slot = i; } }
+                    keys[slot] = key;
+                    }
+                ages[slot] = 0;
+                }
+
+            // Call regularly, eg once per minute, to age entries out.
+            void tick()
+                { for(uint8_t i = 0; i < entries; ++i) { if(ages[i] < maxAgeTicks) { ++ages[i]; } } }
+        };
+
+    }
+
+#endif
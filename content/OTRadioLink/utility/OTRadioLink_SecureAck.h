@@ -0,0 +1,369 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Optional acknowledged delivery for secure frames,
+ * retransmitting only when no ack arrives rather than always sending twice.
+ *
+ * The sender hands each encoded secure frame to OTSecureAckTracker,
+ * which sends it and keeps a copy until acked,
+ * retransmitting with exponential backoff from a small timer wheel
+ * driven by the sub-cycle clock.
+ * The receiver acks with a secure beacon
+ * (SimpleSecureFrame32or0BodyTXBase::generateSecureBeacon() with a body)
+ * naming the message counter of the frame received,
+ * so acks are authenticated and cannot be forged to suppress retries.
+ *
+ * Ack beacon body (plaintext in the secure frame):
+ *   [0] SECURE_ACK_FORMAT
+ *   [1..6] full (6-byte) message counter of the frame being acked
+ *
+ * Portable.
+ */
+
+#ifndef ARDUINO_LIB_OTRADIOLINK_SECUREACK_H
+#define ARDUINO_LIB_OTRADIOLINK_SECUREACK_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "OTV0P2BASE_QuickPRNG.h"
+#include "OTV0P2BASE_RTC.h"
+#include "OTRadioLink_SecureableFrameType.h"
+#include "OTRadioLink_OTRadioLink.h"
+
+// Use namespaces to help avoid collisions.
+namespace OTRadioLink
+    {
+    // First byte of an ack beacon body, to distinguish it from any other beacon body.
+    static constexpr uint8_t SECURE_ACK_FORMAT = 0x4b; // 'K'
+    static constexpr uint8_t SECURE_ACK_BODY_BYTES = 1 + SimpleSecureFrame32or0BodyBase::fullMsgCtrBytes;
+
+    // Copy the message counter from an encoded secure frame,
+    // with its length byte first (frame[0]) as returned by encode().
+    // Returns false if frame does not look like a complete secure frame.
+    inline bool getSecureFrameMsgCtr(const uint8_t *const frame, const uint8_t buflen, uint8_t *const counter)
+        {
+        // Length, type, seq/il, bl and header plus the 23-byte trailer.
+        if((NULL == frame) || (NULL == counter) || (buflen < 27)) { return(false); }
+        const uint8_t fl = frame[0];
+        if((fl + 1 != buflen) || (0 == (0x80 & frame[1]))) { return(false); }
+        // The counter is the first 6 bytes of the trailer (see encodeRaw()).
+        memcpy(counter, frame + fl - 22, SimpleSecureFrame32or0BodyBase::fullMsgCtrBytes);
+        return(true);
+        }
+
+    // Write an ack beacon body for counter to buf; returns the body length, or 0 if buf is too small.
+    inline uint8_t encodeSecureAck(uint8_t *const buf, const uint8_t buflen, const uint8_t *const counter)
+        {
+        if((NULL == buf) || (NULL == counter) || (buflen < SECURE_ACK_BODY_BYTES)) { return(0); }
+        buf[0] = SECURE_ACK_FORMAT;
+        memcpy(buf + 1, counter, SimpleSecureFrame32or0BodyBase::fullMsgCtrBytes);
+        return(SECURE_ACK_BODY_BYTES);
+        }
+    // Find the acked message counter in an ack beacon body; returns NULL if body is not one.
+    inline const uint8_t *decodeSecureAck(const uint8_t *const body, const uint8_t len)
+        {
+        if((NULL == body) || (SECURE_ACK_BODY_BYTES != len) || (SECURE_ACK_FORMAT != body[0])) { return(NULL); }
+        return(body + 1);
+        }
+
+    // Timer wheel for up to maxTimers one-shot timers, identified by index.
+    // Each tick looks at just one bucket, and the ticks run over with nothing pending
+    // cost little more than the loop, so advancing is cheap enough to do often from the main loop.
+    // Delays longer than one turn of the wheel count down whole turns in the timer.
+    // Template parameters:
+    //   * buckets  ticks per turn of the wheel; in [1,255]
+    //   * maxTimers  number of timers; in [1,8]
+    // Not thread-/ISR- safe.
+    template<uint8_t buckets, uint8_t maxTimers>
+    class OTTimerWheel final
+        {
+        static_assert(buckets > 0, "must have at least one bucket");
+        static_assert((maxTimers > 0) && (maxTimers <= 8), "maxTimers must be in [1,8]");
+
+        public:
+            // Longest delay that can be scheduled, in ticks.
+            static constexpr uint16_t MAX_DELAY = uint16_t(buckets) * 256U;
+
+        private:
+            // Bitmap of the timers due in each bucket.
+            uint8_t wheel[buckets];
+            // Whole turns left for each timer when its bucket next comes round.
+            uint8_t turns[maxTimers];
+            // Bucket for the current tick.
+            uint8_t pos = 0;
+            // Sub-cycle time at the last advanceTo().
+            uint8_t lastSCT = 0;
+            bool haveSCT = false;
+            // Monotonic ticks at the last advanceToTicks().
+            uint32_t lastTicks = 0;
+            bool haveTicks = false;
+            // Bitmap of all timers pending.
+            uint8_t pending = 0;
+
+        public:
+            constexpr OTTimerWheel() : wheel(), turns() { }
+
+            // Start (or restart) timer id to expire delay ticks from now; 0 counts as 1.
+            // Returns false if id is out of range.
+            bool schedule(const uint8_t id, uint16_t delay)
+                {
+                if(id >= maxTimers) { return(false); }
+                cancel(id);
+                if(0 == delay) { delay = 1; }
+                else if(delay > MAX_DELAY) { delay = MAX_DELAY; }
+                const uint8_t b = uint8_t((pos + delay) % buckets);
+                turns[id] = uint8_t((delay - 1) / buckets);
+                wheel[b] |= uint8_t(1U << id);
+                pending |= uint8_t(1U << id);
+                return(true);
+                }
+            // Stop timer id if pending.
+            void cancel(const uint8_t id)
+                {
+                if(id >= maxTimers) { return; }
+                const uint8_t m = uint8_t(1U << id);
+                if(0 == (pending & m)) { return; }
+                for(uint8_t b = 0; b < buckets; ++b) { wheel[b] &= uint8_t(~m); }
+                pending &= uint8_t(~m);
+                }
+            bool isPending(const uint8_t id) const { return((id < maxTimers) && (0 != (pending & (1U << id)))); }
+            // Bitmap of pending timers.
+            uint8_t getPending() const { return(pending); }
+
+            // Advance by ticks; returns the bitmap of timers that expired.
+            uint8_t advance(uint16_t ticks)
+                {
+                uint8_t expired = 0;
+                while(ticks-- > 0)
+                    {
+                    if(++pos >= buckets) { pos = 0; }
+                    if(0 == pending) { pos = uint8_t((pos + ticks) % buckets); break; }
+                    const uint8_t due = wheel[pos];
+                    if(0 == due) { continue; }
+                    for(uint8_t i = 0; i < maxTimers; ++i)
+                        {
+                        const uint8_t m = uint8_t(1U << i);
+                        if(0 == (due & m)) { continue; }
+                        if(0 != turns[i]) { --turns[i]; continue; }
+                        wheel[pos] &= uint8_t(~m);
+                        pending &= uint8_t(~m);
+                        expired |= m;
+                        }
+                    }
+                return(expired);
+                }
+            // Advance to sub-cycle time sct (see OTV0P2BASE::getSubCycleTime());
+            // returns the bitmap of timers that expired.
+            // Calls must be less than one whole basic cycle apart,
+            // eg from two CycleTaskRunner tasks in different halves of the cycle,
+            // else whole cycles are missed; otherwise use advance() directly.
+            // The first call only notes the time.
+            uint8_t advanceTo(const uint8_t sct)
+                {
+                const uint8_t elapsed = uint8_t(sct - lastSCT);
+                lastSCT = sct;
+                if(!haveSCT) { haveSCT = true; return(0); }
+                return(advance(elapsed));
+                }
+            // Advance to monotonic sub-cycle ticks (see OTV0P2BASE::getMonotonicTicks());
+            // returns the bitmap of timers that expired.
+            // Calls may be any distance apart: after a gap of MAX_DELAY or more everything pending expires.
+            // The first call only notes the time.
+            uint8_t advanceToTicks(const uint32_t monotonicTicks)
+                {
+                const uint32_t elapsed = OTV0P2BASE::monotonicElapsed(lastTicks, monotonicTicks);
+                lastTicks = monotonicTicks;
+                if(!haveTicks) { haveTicks = true; return(0); }
+                return(advance((elapsed > MAX_DELAY) ? MAX_DELAY : uint16_t(elapsed)));
+                }
+        };
+
+    // Sends secure frames and retransmits each until acked,
+    // up to maxTX transmissions in all.
+    // Retransmissions are firstRetryTicks after the first transmission then doubling each time,
+    // each delay stretched by up to a quarter at random so that senders whose frames
+    // collided do not retry in step.
+    // Frames that run out of retries are dropped and counted;
+    // the caller may treat that as a lost link, eg OTTXPowerController::reportMissed().
+    // At most maxInFlight frames are tracked at once: send() refuses more,
+    // so the caller falls back to unacked sending or waits.
+    // Frames are keyed by their message counter, which is unique for each frame sent.
+    // Ticks are sub-cycle clock ticks (8ms with 256 per 2s basic cycle).
+    // Template parameters:
+    //   * maxInFlight  frames tracked at once; in [1,8]
+    //   * maxFrameBytes  largest frame, including its length byte
+    //   * wheelBuckets  size of the timer wheel; longer delays take more than one turn
+    // Not thread-/ISR- safe.
+    template<uint8_t maxInFlight = 2, uint8_t maxFrameBytes = 64, uint8_t wheelBuckets = 32>
+    class OTSecureAckTracker final
+        {
+        static_assert(maxFrameBytes >= 27, "maxFrameBytes too small for a secure frame");
+
+        public:
+            typedef OTRadioLink::TXpower TXpower;
+            // Time for the receiver to decode, encode an ack and turn round, with margin.
+            static constexpr uint8_t DEFAULT_FIRST_RETRY_TICKS = 64;
+            static constexpr uint8_t DEFAULT_MAX_TX = 4;
+
+        private:
+            struct Entry final
+                {
+                uint8_t frame[maxFrameBytes];
+                uint8_t len;
+                uint8_t counter[SimpleSecureFrame32or0BodyBase::fullMsgCtrBytes];
+                // Transmissions so far; 0 if the entry is free.
+                uint8_t tx;
+                TXpower power;
+                };
+            Entry entries[maxInFlight];
+            OTTimerWheel<wheelBuckets, maxInFlight> wheel;
+
+            OTRadioLink &radio;
+            const int8_t channel;
+            const uint8_t firstRetryTicks;
+            const uint8_t maxTX;
+
+            // Saturating statistics.
+            uint16_t acked = 0;
+            uint16_t retransmits = 0;
+            uint16_t failed = 0;
+            static void inc(uint16_t &c) { if(c < 0xffff) { ++c; } }
+
+            // Delay before the next transmission of an entry sent tx times so far.
+            uint16_t retryDelay(const uint8_t tx) const
+                {
+                const uint16_t limit = OTTimerWheel<wheelBuckets, maxInFlight>::MAX_DELAY;
+                uint16_t d = firstRetryTicks;
+                for(uint8_t i = 1; (i < tx) && (d < limit / 2); ++i) { d = uint16_t(d * 2); }
+                return(uint16_t(d + (OTV0P2BASE::randRNG8() % ((d / 4) + 1))));
+                }
+            void transmit(const uint8_t i)
+                {
+                Entry &e = entries[i];
+                // A refused send (eg over duty cycle) still uses up a try.
+                radio.queueToSend(e.frame, e.len, channel, e.power);
+                ++e.tx;
+                wheel.schedule(i, retryDelay(e.tx));
+                }
+
+        public:
+            //  * radio_  radio to send on
+            //  * firstRetryTicks_  wait before the first retransmission; strictly positive
+            //  * maxTX_  maximum transmissions of each frame, including the first; strictly positive
+            //  * channel_  radio channel to send on
+            OTSecureAckTracker(OTRadioLink &radio_,
+                               const uint8_t firstRetryTicks_ = DEFAULT_FIRST_RETRY_TICKS,
+                               const uint8_t maxTX_ = DEFAULT_MAX_TX,
+                               const int8_t channel_ = 0)
+              : entries(), wheel(), radio(radio_), channel(channel_),
+                firstRetryTicks((0 == firstRetryTicks_) ? 1 : firstRetryTicks_),
+                maxTX((0 == maxTX_) ? 1 : maxTX_) { }
+
+            // Send an encoded secure frame, with its length byte first as from encode(),
+            // and track it until acked.
+            // Returns false, without sending, if the frame is not a secure frame,
+            // is too long, or maxInFlight frames are already awaiting acks.
+            bool send(const uint8_t *const frame, const uint8_t buflen, const TXpower power = OTRadioLink::TXnormal)
+                {
+                if(buflen > maxFrameBytes) { return(false); }
+                uint8_t i = 0;
+                while((i < maxInFlight) && (0 != entries[i].tx)) { ++i; }
+                if(i >= maxInFlight) { return(false); }
+                Entry &e = entries[i];
+                if(!getSecureFrameMsgCtr(frame, buflen, e.counter)) { return(false); }
+                memcpy(e.frame, frame, buflen);
+                e.len = buflen;
+                e.power = power;
+                transmit(i);
+                return(true);
+                }
+
+            // Match an ack for the frame with the given message counter, eg from decodeSecureAck();
+            // returns true if that frame was awaiting an ack.
+            // The ack must have been authenticated as from the frame's recipient.
+            bool onAck(const uint8_t *const counter)
+                {
+                if(NULL == counter) { return(false); }
+                for(uint8_t i = 0; i < maxInFlight; ++i)
+                    {
+                    Entry &e = entries[i];
+                    if((0 == e.tx) || (0 != memcmp(e.counter, counter, sizeof(e.counter)))) { continue; }
+                    wheel.cancel(i);
+                    e.tx = 0;
+                    inc(acked);
+                    return(true);
+                    }
+                return(false);
+                }
+            // Match an ack beacon body; returns true if it acked a frame awaiting one.
+            bool onAckBody(const uint8_t *const body, const uint8_t len)
+                { return(onAck(decodeSecureAck(body, len))); }
+
+            // Retransmit or drop expired frames after ticks.
+            void advance(const uint16_t ticks) { expire(wheel.advance(ticks)); }
+            // Retransmit or drop expired frames at sub-cycle time sct; see OTTimerWheel::advanceTo().
+            void advanceTo(const uint8_t sct) { expire(wheel.advanceTo(sct)); }
+            // Retransmit or drop expired frames at monotonic ticks; see OTTimerWheel::advanceToTicks().
+            void advanceToTicks(const uint32_t monotonicTicks) { expire(wheel.advanceToTicks(monotonicTicks)); }
+
+            // Number of frames awaiting acks.
+            uint8_t getInFlight() const
+                {
+                uint8_t n = 0;
+                for(uint8_t i = 0; i < maxInFlight; ++i) { if(0 != entries[i].tx) { ++n; } }
+                return(n);
+                }
+            // True if the frame with message counter is awaiting an ack.
+            bool isInFlight(const uint8_t *const counter) const
+                {
+                for(uint8_t i = 0; i < maxInFlight; ++i)
+                    {
+                    const Entry &e = entries[i];
+                    if((0 != e.tx) && (0 == memcmp(e.counter, counter, sizeof(e.counter)))) { return(true); }
+                    }
+                return(false);
+                }
+            uint16_t getAcked() const { return(acked); }
+            uint16_t getRetransmits() const { return(retransmits); }
+            uint16_t getFailed() const { return(failed); }
+
+            // Drop all frames in flight without counting them as failed, eg on rekeying.
+            void clear()
+                {
+                for(uint8_t i = 0; i < maxInFlight; ++i) { wheel.cancel(i); entries[i].tx = 0; }
+                }
+
+        private:
+            void expire(const uint8_t expired)
+                {
+                if(0 == expired) { return; }
+                for(uint8_t i = 0; i < maxInFlight; ++i)
+                    {
+                    if(0 == (expired & (1U << i))) { continue; }
+                    Entry &e = entries[i];
+                    if(e.tx >= maxTX) { e.tx = 0; inc(failed); continue; }
+                    inc(retransmits);
+                    transmit(i);
+                    }
+                }
+        };
+    }
+
+#endif
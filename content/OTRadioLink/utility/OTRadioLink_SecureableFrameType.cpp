@@ -31,13 +31,21 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015--2016
 
 #include "OTRadioLink_SecureableFrameType.h"
 
+#include "OTV0P2BASE_CPUClockPolicy.h"
 #include "OTV0P2BASE_CRC.h"
 #include "OTV0P2BASE_EEPROM.h"
+#include "OTV0P2BASE_Trace.h"
 
 
 namespace OTRadioLink
     { 
 
+#if defined(OTV0P2BASE_SCRATCH_PROFILING)
+OTV0P2BASE::ScratchSpaceUsage scratchUsage_encode;
+OTV0P2BASE::ScratchSpaceUsage scratchUsage_encodeValveFrame;
+OTV0P2BASE::ScratchSpaceUsage scratchUsage_decode;
+#endif
+
 /**
  * @brief   Validate parameters and encode a header for a small frame.
  * 
@@ -273,9 +281,8 @@ uint8_t SecurableFrameHeader::computeNonSecureCRC(const uint8_t *const buf, uint
     if(buflen < fl) { return(0); } // ERROR
     // Initialise CRC with 0x7f;
     uint8_t crc = 0x7f;
-    const uint8_t *p = buf;
     // Include in calc all bytes up to but not including the trailer/CRC byte.
-    for(uint8_t i = fl; i > 0; --i) { crc = OTV0P2BASE::crc7_5B_update(crc, *p++); }
+    crc = OTV0P2BASE::crc7_5B_buf(crc, buf, fl);
     // Ensure 0x00 result is converted to avoid forbidden value.
     if(0 == crc) { crc = 0x80; }
     return(crc);
@@ -382,7 +389,8 @@ uint8_t decodeNonsecure(OTDecodeData_T &fd)
 
 // Add specified small unsigned value to supplied counter value in place; false if failed.
 // This will fail (returning false) if the counter would overflow, leaving it unchanged.
-bool SimpleSecureFrame32or0BodyRXBase::msgcounteradd(uint8_t *const counter, const uint8_t delta)
+// Reference byte-at-a-time version.
+bool SimpleSecureFrame32or0BodyRXBase::msgcounteraddBytewise(uint8_t *const counter, const uint8_t delta)
     {
     if(0 == delta) { return(true); } // Optimisation: nothing to do.
     // Add to last byte, if it overflows ripple up the increment as needed,
@@ -397,7 +405,7 @@ bool SimpleSecureFrame32or0BodyRXBase::msgcounteradd(uint8_t *const counter, con
     if(allFF) { return(false); }
     // Safe from overflow, set lsbyte and ripple up the carry as necessary.
     counter[fullMsgCtrBytes-1] = bumped;
-    for(int8_t i = fullMsgCtrBytes-1; --i > 0; ) { if(0 != ++counter[i]) { break; } }
+    for(int8_t i = fullMsgCtrBytes-1; --i >= 0; ) { if(0 != ++counter[i]) { break; } }
     // Success!
     return(true);
     }
@@ -474,6 +482,9 @@ uint8_t SimpleSecureFrame32or0BodyTXBase::encodeRaw(
     {
     if(NULL == key) { return(0); } // ERROR
 
+    // Finish the crypto burst quickly and get back to sleep.
+    OTV0P2BASE::RAII_CPUFullSpeed fullSpeed;
+
     // buffer local variables/consts
     uint8_t * const buffer = fd.outbuf;
     const uint8_t bodylen = fd.ptextLen;
@@ -579,14 +590,20 @@ uint8_t SimpleSecureFrame32or0BodyRXBase::decodeRaw(
             const uint8_t *const iv)
     {
     // Scratch space for this function call alone (not called fns).
-    constexpr uint8_t scratchSpaceNeededHere =
-        decodeRaw_scratch_usage;
+    // None is needed when decrypting directly into the caller's buffer.
+    const bool inPlace = fd.ptextInPlace && (NULL != fd.ptext);
+    const uint8_t scratchSpaceNeededHere = inPlace ?
+        decodeRaw_inPlace_scratch_usage : decodeRaw_scratch_usage;
     if(scratchSpaceNeededHere > scratch.bufsize) { return(0); }
-    // Create a new sub scratch space for callee.
-    OTV0P2BASE::ScratchSpaceL subScratch(scratch, scratchSpaceNeededHere);
+
+    // Capture possible (near) peak of stack usage, eg when called from ISR.
+    OTV0P2BASE::MemoryChecks::recordIfMinSP();
 
     if((NULL == fd.ctext) || (NULL == key) || (NULL == iv)) { return(0); } // ERROR
 
+    // Finish the crypto burst quickly and get back to sleep.
+    OTV0P2BASE::RAII_CPUFullSpeed fullSpeed;
+
     const uint8_t *const buf = fd.ctext;
     const uint8_t buflen = buf[0] + 1;
     const SecurableFrameHeader &sfh = fd.sfh;
@@ -605,19 +622,30 @@ uint8_t SimpleSecureFrame32or0BodyRXBase::decodeRaw(
     // Note if plaintext is actually wanted/expected.
     const bool plaintextWanted = (NULL != fd.ptext);
     // Attempt to authenticate and decrypt.
-    uint8_t * const decryptBuf = scratch.buf;
+    uint8_t * const decryptBuf = inPlace ? fd.ptext : scratch.buf;
     //uint8_t decryptBuf[ENC_BODY_SMALL_FIXED_CTEXT_SIZE];
-    if(!d(scratch.buf+scratchSpaceNeededHere, scratch.bufsize-scratchSpaceNeededHere,
+    OT_TRACE(OTV0P2BASE::TraceId::SECURE_DECODE_START, buflen);
+    const bool authenticated = d(scratch.buf+scratchSpaceNeededHere, scratch.bufsize-scratchSpaceNeededHere,
                 key, iv, buf, sfh.getHl(),
                 (0 == bl) ? NULL : buf + sfh.getBodyOffset(), buf + fl - 16,
-                decryptBuf)) { return(0); } // ERROR
+                decryptBuf);
+    OT_TRACE(OTV0P2BASE::TraceId::SECURE_DECODE_END, authenticated);
+    if(!authenticated)
+        {
+        // Never leave unauthenticated text in the caller's buffer.
+        if(inPlace) { memset(fd.ptext, 0, ENC_BODY_SMALL_FIXED_CTEXT_SIZE); }
+        return(0); // ERROR
+        }
     if(plaintextWanted && (0 != bl))
         {
         // Unpad the decrypted text in place.
         const uint8_t upbl = unpad32BBuffer(decryptBuf);
-        if(upbl > ENC_BODY_SMALL_FIXED_PTEXT_MAX_SIZE) { return(0); } // ERROR
-        if(upbl > fd.ptextLenMax) { return(0); } // ERROR
-        memcpy(fd.ptext, decryptBuf, upbl);
+        if((upbl > ENC_BODY_SMALL_FIXED_PTEXT_MAX_SIZE) || (upbl > fd.ptextLenMax))
+            {
+            if(inPlace) { memset(fd.ptext, 0, ENC_BODY_SMALL_FIXED_CTEXT_SIZE); }
+            return(0); // ERROR
+            }
+        if(!inPlace) { memcpy(fd.ptext, decryptBuf, upbl); }
         fd.ptextLen = upbl;
         // TODO: optimise later if plaintext not required but ciphertext present.
         }
@@ -668,7 +696,8 @@ uint8_t SimpleSecureFrame32or0BodyRXBase::unpad32BBuffer(const uint8_t *const bu
 
 // Check message counter for given ID, ie that it is high enough to be eligible for authenticating/processing.
 // ID is full (8-byte) node ID; counter is full (6-byte) counter.
-// Returns false if this counter value is not higher than the last received authenticated value.
+// Returns false if this counter value is not higher than the last received authenticated value,
+// unless it is a not-yet-seen value within the replay window (see isRXMsgCtrInReplayWindow()).
 bool SimpleSecureFrame32or0BodyRXBase::validateRXMsgCtr(const uint8_t *ID, const uint8_t *counter) const
     {
     // Validate args (rely on getLastRXMessageCounter() to validate ID).
@@ -676,8 +705,10 @@ bool SimpleSecureFrame32or0BodyRXBase::validateRXMsgCtr(const uint8_t *ID, const
     // Fetch the current counter; instant fail if not possible.
     uint8_t currentCounter[fullMsgCtrBytes];
     if(!getLastRXMsgCtr(ID, currentCounter)) { return(false); } // FAIL
-    // New counter must be larger to be acceptable.
-    return(msgcountercmp(counter, currentCounter) > 0);
+    // New counter must be larger to be acceptable...
+    if(msgcountercmp(counter, currentCounter) > 0) { return(true); }
+    // ... or a late arrival not yet seen.
+    return(isRXMsgCtrInReplayWindow(ID, counter));
     }
 
 /**
@@ -705,6 +736,8 @@ bool fixed32BTextSize12BNonce16BTagSimpleEnc_NULL_IMPL(
         const uint8_t *const plaintext,
         uint8_t *const ciphertextOut, uint8_t *const tagOut)
     {
+    // Capture stack usage at the bottom of the (NULL) crypto, eg for benchmarks.
+    OTV0P2BASE::MemoryChecks::recordIfMinSP();
     // Does not use state, but checks that all other pointers are non-NULL.
     if((nullptr == workspace) || (nullptr == key) || (nullptr == iv) ||
        (nullptr == authtext) || (nullptr == ciphertextOut) || (nullptr == tagOut)) { return(false); } // ERROR
@@ -741,6 +774,8 @@ bool fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL(
         const uint8_t *const ciphertext, const uint8_t *const tag,
         uint8_t *const plaintextOut)
     {
+    // Capture stack usage at the bottom of the (NULL) crypto, eg for benchmarks.
+    OTV0P2BASE::MemoryChecks::recordIfMinSP();
     // Does not use state, but checks that all other pointers are non-NULL.
     if((nullptr == workspace) || (nullptr == key) || (nullptr == iv) ||
        (nullptr == authtext) || (nullptr == tag) || (nullptr == plaintextOut)) { return(false); } // ERROR
@@ -752,6 +787,50 @@ bool fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL(
     return(true);
     }
 
+/**
+ * @brief   NULL AES-128 key 'expansion'. DOES NOT EXPAND THE KEY
+ *          SO DO NOT USE IN PRODUCTION SYSTEMS.
+ */
+bool aes128KeyExpand_NULL_IMPL(uint8_t *const schedule, const uint8_t *const key)
+    {
+    if((nullptr == schedule) || (nullptr == key)) { return(false); } // ERROR
+    memcpy(schedule, key, 16);
+    for(uint8_t i = 16; i < SimpleSecureFrame32or0BodyBase::keySchedule_size_AES128; ++i)
+        { schedule[i] = (uint8_t)(schedule[i - 16] + i); }
+    return(true);
+    }
+
+// Ensure that the cache holds the schedule for the given key.
+bool SimpleSecureKeyCache::setKey(const uint8_t *const key, SimpleSecureFrame32or0BodyBase::aes128KeyExpand_fn_t &expand)
+    {
+    if((NULL == schedule) || (NULL == key)) { invalidate(); return(false); } // ERROR
+    // The first round key of the schedule is the key itself.
+    if(valid && (0 == memcmp(schedule, key, 16))) { return(true); }
+    valid = false;
+    if(!expand(schedule, key)) { invalidate(); return(false); } // ERROR
+    valid = true;
+    return(true);
+    }
+
+// Ensure that the cache holds the schedule for the current key.
+bool SimpleSecureKeyCache::refresh(OTV0P2BASE::GetPrimary16ByteSecretKey_t &getKey,
+                                   SimpleSecureFrame32or0BodyBase::aes128KeyExpand_fn_t &expand)
+    {
+    uint8_t key[16];
+    const bool result = getKey(key) && setKey(key, expand);
+    if(!result) { invalidate(); }
+    // Don't leave a copy of the key on the stack.
+    memset(key, 0, sizeof(key));
+    return(result);
+    }
+
+// Wipe the schedule.
+void SimpleSecureKeyCache::invalidate()
+    {
+    valid = false;
+    if(NULL != schedule) { memset(schedule, 0, SimpleSecureFrame32or0BodyBase::keySchedule_size_AES128); }
+    }
+
 
 // CONVENIENCE/BOILERPLATE METHODS
 
@@ -828,6 +907,7 @@ uint8_t SimpleSecureFrame32or0BodyTXBase::encode(
     static_assert(encode_scratch_usage == IV_size + OTV0P2BASE::OpenTRV_Node_ID_Bytes, "self-use scratch size wrong");
     static_assert(encode_scratch_usage < encode_total_scratch_usage_OTAESGCM_2p0, "scratch size calc wrong");
     if(scratch.bufsize < encode_total_scratch_usage_OTAESGCM_2p0) { return(0); } // ERROR
+    OTV0P2BASE_SCRATCH_PROBE(scratch, scratchUsage_encode);
 
     if((fd.fType >= FTS_INVALID_HIGH) || (fd.fType == FTS_NONE)) { return(0); } // FAIL
     // // iv at start of scratch space
@@ -896,6 +976,7 @@ uint8_t SimpleSecureFrame32or0BodyTXBase::encodeValveFrame(
     static_assert(encodeValveFrame_scratch_usage == IV_size, "self-use scratch size wrong");
     static_assert(encodeValveFrame_scratch_usage < encodeValveFrame_total_scratch_usage_OTAESGCM_2p0, "scratch size calc wrong");
     if(scratch.bufsize < encodeValveFrame_total_scratch_usage_OTAESGCM_2p0) { return(0); } // ERROR
+    OTV0P2BASE_SCRATCH_PROBE(scratch, scratchUsage_encodeValveFrame);
 
     // buffer args and consts
     uint8_t * const ptext = fd.ptext;
@@ -926,6 +1007,54 @@ uint8_t SimpleSecureFrame32or0BodyTXBase::encodeValveFrame(
     return(encodeRaw(fd, iv, il_, iv, e, subscratch, key));
 }
 
+bool SimpleSecureBeaconTemplate::prepare(const SimpleSecureFrame32or0BodyTXBase &tx, const uint8_t il_)
+    {
+    invalidate();
+    uint8_t id[OTV0P2BASE::OpenTRV_Node_ID_Bytes];
+    if(!tx.getTXID(id)) { return(false); } // ERROR
+    SecurableFrameHeader sfh;
+    OTBuf_t hbuf(header, sizeof(header));
+    const uint8_t hl_ = sfh.encodeHeader(hbuf, true, FTS_ALIVE, 0, id, il_, 0, 23);
+    if(0 == hl_) { return(false); } // ERROR
+    hl = hl_;
+    il = il_;
+    fl = sfh.fl;
+    return(true);
+    }
+
+uint8_t SimpleSecureBeaconTemplate::generate(
+            SimpleSecureFrame32or0BodyTXBase &tx,
+            OTBuf_t &buf,
+            SimpleSecureFrame32or0BodyTXBase::fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t &e,
+            OTV0P2BASE::ScratchSpaceL &scratch,
+            const uint8_t *const key)
+    {
+    if((NULL == key) || !isValid()) { return(0); } // ERROR
+    if(scratch.bufsize < generate_total_scratch_usage_OTAESGCM_2p0) { return(0); } // ERROR
+    uint8_t *const buffer = buf.buf;
+    if((NULL == buffer) || (fl >= buf.bufsize)) { return(0); } // ERROR
+
+    // Finish the crypto burst quickly and get back to sleep.
+    OTV0P2BASE::RAII_CPUFullSpeed fullSpeed;
+
+    // iv at start of scratch space; this consumes a message count.
+    uint8_t *const iv = scratch.buf;
+    if(!tx.computeIVForTX12B(iv)) { return(0); } // ERROR
+    // Rebuild if the ID has changed under the template, eg after re-provisioning.
+    // Only the first 6 bytes of ID are in the IV so a longer ID is not fully checked.
+    const uint8_t idCheck = (il > 6) ? 6 : il;
+    if((0 != memcmp(header + 3, iv, idCheck)) && !prepare(tx, il)) { return(0); } // ERROR
+
+    memcpy(buffer, header, hl);
+    buffer[2] = uint8_t(il | ((iv[11] & 0xf) << 4));
+    OTV0P2BASE::ScratchSpaceL subscratch(scratch, generate_scratch_usage);
+    // No body, so GCM authenticates the header as AAD only; tag goes straight into the trailer.
+    if(!e(subscratch.buf, subscratch.bufsize, key, iv, buffer, hl, NULL, buffer + hl, buffer + fl - 16)) { return(0); } // ERROR
+    memcpy(buffer + fl - 22, iv + 6, 6);
+    buffer[fl] = 0x80;
+    return(fl + 1);
+    }
+
 /**
  * @brief   Decode a frame from a given ID. NOT A PUBLIC ENTRY POINT!
  * 
@@ -1045,8 +1174,7 @@ uint8_t SimpleSecureFrame32or0BodyRXBase::decode(
     constexpr uint8_t scratchSpaceNeededHere =
         decode_scratch_usage;
     if(scratchSpaceNeededHere > scratch.bufsize) { return(0); }
-    // Create a new sub scratch space for callee.
-    OTV0P2BASE::ScratchSpaceL subScratch(scratch, scratchSpaceNeededHere);
+    OTV0P2BASE_SCRATCH_PROBE(scratch, scratchUsage_decode);
 
     // Rely on _decodeSecureSmallFrameFromID() for validation of items
     // not directly needed here.
@@ -1061,9 +1189,28 @@ uint8_t SimpleSecureFrame32or0BodyRXBase::decode(
     // Use start of scratch space. This buffer should not be visible
     // outside the decode stack (e.g. should not be part of fd).
     uint8_t *const nodeID = scratch.buf;
-    const OTBuf_t senderNodeID(nodeID, OTV0P2BASE::OpenTRV_Node_ID_Bytes);
     const int8_t index = _getNextMatchingNodeID(0, &fd.sfh, nodeID);
     if(index < 0) { return(0); } // ERROR
+    return(_decodeFromNodeID(fd, d, scratch, key, index));
+    }
+
+// Common tail of decode() and decodeBatch() once the sender is known.
+// The full sender node ID must be at the start of scratch.
+uint8_t SimpleSecureFrame32or0BodyRXBase::_decodeFromNodeID(
+            OTDecodeData_T &fd,
+            fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &d,
+            OTV0P2BASE::ScratchSpaceL &scratch,
+            const uint8_t *const key,
+            const int8_t index)
+    {
+    // Scratch space for this function call alone (not called fns),
+    // shared with decode().
+    constexpr uint8_t scratchSpaceNeededHere =
+        decode_scratch_usage;
+    if(scratchSpaceNeededHere > scratch.bufsize) { return(0); }
+    // Create a new sub scratch space for callee.
+    OTV0P2BASE::ScratchSpaceL subScratch(scratch, scratchSpaceNeededHere);
+    const OTBuf_t senderNodeID(scratch.buf, OTV0P2BASE::OpenTRV_Node_ID_Bytes);
     // Extract the message counter and validate it
     // (that it is higher than previously seen)...
     // Append to scratch space, after node id.
@@ -1084,7 +1231,68 @@ uint8_t SimpleSecureFrame32or0BodyRXBase::decode(
     if(!authAndUpdateRXMsgCtr(senderNodeID.getBuf(), messageCounter)) { return(0); } // ERROR
     // Success: copy sender ID to output buffer (if non-NULL) as last action.
     memcpy(fd.id, senderNodeID.getBuf(), OTV0P2BASE::OpenTRV_Node_ID_Bytes);
+    fd.assocIndex = index;
     return(decodeResult);
     }
 
+// Decode several frames with one key and scratch space.
+// The association lookup is reused for consecutive frames with identical header IDs,
+// eg a burst from one node, including negative results.
+uint8_t SimpleSecureFrame32or0BodyRXBase::decodeBatch(
+            OTDecodeData_T *const *const fds,
+            const uint8_t n,
+            fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &d,
+            OTV0P2BASE::ScratchSpaceL &scratch,
+            const uint8_t *const key,
+            uint8_t *const results)
+    {
+    if(NULL != results) { memset(results, 0, n); }
+    if(NULL == fds) { return(0); } // ERROR
+    // Scratch space for this function call alone (not called fns).
+    constexpr uint8_t scratchSpaceNeededHere =
+        decodeBatch_scratch_usage;
+    if(scratchSpaceNeededHere > scratch.bufsize) { return(0); } // ERROR
+    // Last header ID looked up: [0] is its length, or 0xff if none,
+    // [1] is the matching association slot, or -1 if none was found,
+    // then the header ID bytes.
+    uint8_t *const lastIl = scratch.buf;
+    int8_t *const lastIndex = reinterpret_cast<int8_t *>(scratch.buf + 1);
+    uint8_t *const lastID = scratch.buf + 2;
+    *lastIl = 0xff;
+    // The rest is laid out as for decode(), with the sender node ID first.
+    OTV0P2BASE::ScratchSpaceL subScratch(scratch, scratchSpaceNeededHere);
+    if(decode_scratch_usage > subScratch.bufsize) { return(0); } // ERROR
+    uint8_t *const nodeID = subScratch.buf;
+
+    uint8_t decoded = 0;
+    for(uint8_t i = 0; i < n; ++i)
+        {
+        OTDecodeData_T *const fd = fds[i];
+        // Same checks as decode().
+        if(NULL == fd) { continue; } // ERROR
+        if(nullptr == fd->ctext) { continue; } // ERROR
+        if(fd->sfh.isInvalid()) { continue; } // ERROR
+        if(23 != fd->sfh.getTl()) { continue; } // ERROR
+        // Only look up the sender if the header ID differs from the last one.
+        const uint8_t il = fd->sfh.getIl();
+        if((il != *lastIl) || (0 != memcmp(lastID, fd->sfh.id, il)))
+            {
+            *lastIl = il;
+            memcpy(lastID, fd->sfh.id, il);
+            *lastIndex = _getNextMatchingNodeID(0, &fd->sfh, nodeID);
+            }
+        if(*lastIndex < 0) { continue; } // ERROR
+        const uint8_t r = _decodeFromNodeID(*fd, d, subScratch, key, *lastIndex);
+        if(0 == r)
+            {
+            // The node ID may have been overwritten; force a fresh lookup.
+            *lastIl = 0xff;
+            continue; // ERROR
+            }
+        if(NULL != results) { results[i] = r; }
+        ++decoded;
+        }
+    return(decoded);
+    }
+
 }
@@ -37,6 +37,14 @@ namespace OTRadioLink
     // Alias ScratchSpace for passing around arrays of known length.
     using OTBuf_t = OTV0P2BASE::ScratchSpace;
 
+#if defined(OTV0P2BASE_SCRATCH_PROFILING)
+    // Scratch high-water marks of the secure frame entry points,
+    // to size application scratch buffers (or a shared arena) from measurement.
+    extern OTV0P2BASE::ScratchSpaceUsage scratchUsage_encode;
+    extern OTV0P2BASE::ScratchSpaceUsage scratchUsage_encodeValveFrame;
+    extern OTV0P2BASE::ScratchSpaceUsage scratchUsage_decode;
+#endif
+
     // Secureable (V0p2) messages.
     //
     // Based on 2015Q4 spec and successors:
@@ -354,6 +362,8 @@ namespace OTRadioLink
         uint8_t ptextLen = 0;
 
         // The output buffer, into which the encoded frame is written. Must never be NULL.
+        // May be a radio driver's TX buffer from OTRadioLink::reserveToSend()
+        // so that the frame is encrypted straight into it and sent without another copy.
         uint8_t *const outbuf = nullptr;
         // The size of the output buffer in bytes. Must be at least 64.
         const uint8_t outbufSize = 0;
@@ -384,6 +394,15 @@ namespace OTRadioLink
     {
         OTDecodeData_T(const uint8_t * const _inbuf, uint8_t * const _ptext)
             : ctext(_inbuf), ptext(_ptext) {}
+        // Zero-copy form: _inbuf may be a (non-volatile) view of the frame still
+        // in the RX queue, and the body is decrypted and unpadded directly in
+        // _ptext, which must hold a whole encrypted block.
+        // This avoids a body-sized scratch buffer and copy in decodeRaw().
+        // On failure _ptext is cleared, so never holds unauthenticated text.
+        // Selected with the PTEXT_IN_PLACE tag.
+        enum ptextInPlace_t { PTEXT_IN_PLACE };
+        OTDecodeData_T(const uint8_t * const _inbuf, uint8_t (&_ptext)[ENC_BODY_SMALL_FIXED_CTEXT_SIZE], ptextInPlace_t)
+            : ctext(_inbuf), ptext(_ptext), ptextInPlace(true) {}
 
         SecurableFrameHeader sfh;
         uint8_t id[OTV0P2BASE::OpenTRV_Node_ID_Bytes] = {};  // Holds up to full node ID.
@@ -402,6 +421,11 @@ namespace OTRadioLink
         static constexpr uint8_t ptextLenMax = ENC_BODY_SMALL_FIXED_PTEXT_MAX_SIZE;
         // Actual size of plain text held within decryptedBody. Set when ptext is populated.
         uint8_t ptextLen = 0;  // 1 byte: 1/4 words
+        // True if ptext is ENC_BODY_SMALL_FIXED_CTEXT_SIZE bytes and may be decrypted into directly.
+        const bool ptextInPlace = false;
+        // Association table slot of the sender, set with id on successful
+        // secure decode, else -1; eg to index per-node state in O(1).
+        int8_t assocIndex = -1;
     };
 
     /**
@@ -470,6 +494,64 @@ namespace OTRadioLink
         public:
             // Size of full message counter for type-0x80 AES-GCM security frames.
             static constexpr uint8_t fullMsgCtrBytes = 6;
+
+            // Size of an expanded AES-128 key schedule (11 16-byte round keys),
+            // as used by OTAESGCM; the first round key is the key itself.
+            static constexpr size_t keySchedule_size_AES128 = 176;
+            // Expand a 16-byte key into a key schedule of keySchedule_size_AES128 bytes.
+            // Returns true on success, false on failure.
+            typedef bool (aes128KeyExpand_fn_t)(uint8_t *schedule, const uint8_t *key);
+        };
+
+    /**
+     * @brief   Cache of an expanded AES-128 key schedule, to avoid re-expanding
+     *          the key for every frame encoded or decoded, eg in a busy hub.
+     *
+     * The schedule is held in the start of a caller-provided scratch space,
+     * which must stay reserved for (and not be passed on from) the cache's lifetime.
+     * The schedule is recomputed only when the key supplied differs from the cached one.
+     *
+     * Use with the encodeRaw()/decodeRaw() overloads that take a key cache,
+     * and crypto routines that accept a pre-expanded key schedule in place of the key,
+     * for which workspaceRequred_GCM32B16B_KS_OTAESGCM_2p0 bytes of workspace suffice.
+     *
+     * The schedule contains the key, so this must be invalidate()d
+     * (which also wipes it) as soon as it is no longer needed.
+     * NOT ISR-/thread- safe.
+     */
+    class SimpleSecureKeyCache final
+        {
+        private:
+            // Schedule storage; NULL if the space supplied was too small.
+            uint8_t *const schedule;
+            // True if schedule holds a valid expansion.
+            bool valid = false;
+
+        public:
+            explicit SimpleSecureKeyCache(const OTV0P2BASE::ScratchSpaceL &space)
+              : schedule((space.bufsize < SimpleSecureFrame32or0BodyBase::keySchedule_size_AES128) ? NULL : space.buf) { }
+
+            /**
+             * @brief   Ensure that the cache holds the schedule for the given key.
+             * @param   key: 16-byte secret key. Never NULL.
+             * @param   expand: key expansion routine; called only if the key has changed.
+             * @retval  True if the cache is now valid for the key, else false (and the cache is invalid).
+             */
+            bool setKey(const uint8_t *key, SimpleSecureFrame32or0BodyBase::aes128KeyExpand_fn_t &expand);
+
+            /**
+             * @brief   Ensure that the cache holds the schedule for the current key, eg primary building key.
+             *          The key is fetched into a temporary copy that is wiped before return.
+             * @retval  True if the cache is now valid for the current key, else false (and the cache is invalid).
+             */
+            bool refresh(OTV0P2BASE::GetPrimary16ByteSecretKey_t &getKey,
+                         SimpleSecureFrame32or0BodyBase::aes128KeyExpand_fn_t &expand);
+
+            // Wipe the schedule; the next setKey()/refresh() will re-expand.
+            void invalidate();
+
+            // The cached schedule if valid, else NULL.
+            const uint8_t *getSchedule() const { return(valid ? schedule : NULL); }
         };
 
     // TX Base class for simple implementations that supports 0 or 32 byte encrypted body sections.
@@ -521,6 +603,9 @@ namespace OTRadioLink
             static constexpr size_t workspaceRequred_GCM32B16B_OTAESGCM_2p0 =
                 176 /* AES element */ +
                 96 /* GCM element as at 20170707 */ ;
+            // Workspace needed when the AES key schedule is supplied pre-expanded (see SimpleSecureKeyCache).
+            static constexpr size_t workspaceRequred_GCM32B16B_KS_OTAESGCM_2p0 =
+                96 /* GCM element as at 20170707 */ ;
             // Returns true on success, false on failure.
             typedef bool (fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t)(
                     uint8_t *workspace, size_t workspaceSize,
@@ -601,6 +686,22 @@ namespace OTRadioLink
                                 fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t &e,
                                 OTV0P2BASE::ScratchSpaceL &scratch,
                                 const uint8_t *key);
+            // As encodeRaw() above, but using a cached pre-expanded key schedule.
+            // The encryption function must accept the schedule in place of the key.
+            // Fails if the cache is not valid.
+            static uint8_t encodeRaw(
+                                OTEncodeData_T &fd,
+                                const uint8_t *id,
+                                const uint8_t il,
+                                const uint8_t *iv,
+                                fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t &eKS,
+                                OTV0P2BASE::ScratchSpaceL &scratch,
+                                const SimpleSecureKeyCache &keyCache)
+                {
+                const uint8_t *const ks = keyCache.getSchedule();
+                if(NULL == ks) { return(0); } // ERROR
+                return(encodeRaw(fd, id, il, iv, eKS, scratch, ks));
+                }
 
             // Get the 3 bytes of persistent reboot/restart message counter, ie 3 MSBs of message counter; returns false on failure.
             // Combines results from primary and secondary as appropriate.
@@ -733,7 +834,31 @@ namespace OTRadioLink
                         OTV0P2BASE::ScratchSpaceL &scratch,
                         const uint8_t *key)
             {
-                OTEncodeData_T fd(buf.buf, buf.bufsize, NULL, 0);
+                OTEncodeData_T fd(NULL, 0, buf.buf, buf.bufsize);
+                fd.fType = OTRadioLink::FTS_ALIVE;
+                return(encode(fd, il_, e, scratch, key));
+            }
+
+            static const uint8_t generateSecureBeaconWithBodyMaxBufSize = SecurableFrameHeader::maxSmallFrameSize;
+            // Create secure Alive / beacon (FTS_ALIVE) frame with a body for transmission,
+            // eg TX slot assignments (see OTRadioLink_TXSlots.h).
+            // As for the empty-body beacon, but the frame will be 59 + ID-length bytes,
+            // so the ID length can be at most 4 to fit in a small frame.
+            //  * body  buffer with the body at its start; padded in place
+            //      so at least ENC_BODY_SMALL_FIXED_CTEXT_SIZE bytes long
+            //  * bodyLen  body length; at most ENC_BODY_SMALL_FIXED_PTEXT_MAX_SIZE
+            // NOTE: THIS API IS LIABLE TO CHANGE
+            uint8_t generateSecureBeacon(
+                        OTBuf_t &buf,
+                        uint8_t il_,
+                        OTBuf_t &body,
+                        uint8_t bodyLen,
+                        fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t  &e,
+                        OTV0P2BASE::ScratchSpaceL &scratch,
+                        const uint8_t *key)
+            {
+                OTEncodeData_T fd(body.buf, body.bufsize, buf.buf, buf.bufsize);
+                fd.ptextLen = bodyLen;
                 fd.fType = OTRadioLink::FTS_ALIVE;
                 return(encode(fd, il_, e, scratch, key));
             }
@@ -787,6 +912,77 @@ namespace OTRadioLink
                         const uint8_t *key);
         };
 
+    /**
+     * @brief   Prebuilt secure beacon (FTS_ALIVE, empty body) for frequent TX.
+     *
+     * Holds the constant header bytes (including ID) of the beacon frame
+     * so that each generate() only fills in the sequence number and
+     * message counter and runs the zero-length-plaintext (AAD-only) GCM.
+     * The output is byte-for-byte what generateSecureBeacon() would produce
+     * for the same message counter.
+     *
+     * Each generate() still takes a fresh IV (incrementing the TX counter)
+     * via computeIVForTX12B(), and if the ID in the IV no longer matches
+     * the template (eg after re-provisioning) the template is rebuilt.
+     * NOT ISR-/thread- safe.
+     */
+    class SimpleSecureBeaconTemplate final
+        {
+        private:
+            // Frame header (leading length byte to end of ID) with sequence number 0.
+            uint8_t header[4 + SecurableFrameHeader::maxIDLength];
+            // Header length as passed as AAD, and frame length; 0 if not prepared.
+            uint8_t hl = 0;
+            uint8_t fl = 0;
+            // ID length.
+            uint8_t il = 0;
+
+        public:
+            // Scratch space needed by generate() beyond that of the encryption function.
+            static constexpr uint8_t generate_scratch_usage = 12;
+            static constexpr size_t generate_total_scratch_usage_OTAESGCM_2p0 =
+                    SimpleSecureFrame32or0BodyTXBase::encodeRaw_total_scratch_usage_OTAESGCM_2p0
+                    + generate_scratch_usage;
+
+            /**
+             * @brief   Build the template for tx's current ID.
+             * @param   il_: ID length for the header, [0,8].
+             * @retval  True on success, else false (and the template is invalid).
+             */
+            bool prepare(const SimpleSecureFrame32or0BodyTXBase &tx, uint8_t il_);
+            // Discard the template.
+            void invalidate() { fl = 0; }
+            bool isValid() const { return(0 != fl); }
+
+            /**
+             * @brief   Generate a beacon from the template, as generateSecureBeacon().
+             * @param   buf: buffer for the entire frame including trailer;
+             *              at least generateSecureBeaconMaxBufSize is always enough.
+             * @param   scratch: at least generate_total_scratch_usage_OTAESGCM_2p0
+             *              bytes AND the scratch space required by `e`.
+             * @retval  Number of bytes written to buf, or 0 in case of error
+             *          (including if not prepared).
+             */
+            uint8_t generate(SimpleSecureFrame32or0BodyTXBase &tx,
+                             OTBuf_t &buf,
+                             SimpleSecureFrame32or0BodyTXBase::fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t &e,
+                             OTV0P2BASE::ScratchSpaceL &scratch,
+                             const uint8_t *key);
+            // As generate() above, but using a cached pre-expanded key schedule.
+            // The encryption function must accept the schedule in place of the key.
+            // Fails if the cache is not valid.
+            uint8_t generate(SimpleSecureFrame32or0BodyTXBase &tx,
+                             OTBuf_t &buf,
+                             SimpleSecureFrame32or0BodyTXBase::fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t &eKS,
+                             OTV0P2BASE::ScratchSpaceL &scratch,
+                             const SimpleSecureKeyCache &keyCache)
+                {
+                const uint8_t *const ks = keyCache.getSchedule();
+                if(NULL == ks) { return(0); } // ERROR
+                return(generate(tx, buf, eKS, scratch, ks));
+                }
+        };
+
     // RX Base class for simple implementations that supports 0 or 32 byte encrypted body sections.
     // This wraps up any necessary state, persistent and ephemeral, such as message counters.
     // Some implementations make sense only as singletons,
@@ -806,15 +1002,65 @@ namespace OTRadioLink
             virtual int8_t _getNextMatchingNodeID(const uint8_t index, const SecurableFrameHeader *const sfh, uint8_t *nodeID) const = 0;
 
         public:
+            // Largest (6-byte) message counter value, as from msgcounterload().
+            static constexpr uint64_t msgcountermax = 0xffffffffffffULL;
+            // Load a (6-byte, big-endian) message counter as a 48-bit value.
+            // Written as shifts so that compilers can fuse it into word loads where the target allows,
+            // without alignment or endianness assumptions.
+            static inline uint64_t msgcounterload(const uint8_t *const counter)
+                {
+                const uint32_t hi = (uint32_t(counter[0]) << 24) | (uint32_t(counter[1]) << 16) |
+                                    (uint32_t(counter[2]) << 8) | uint32_t(counter[3]);
+                const uint16_t lo = uint16_t((uint16_t(counter[4]) << 8) | counter[5]);
+                return((uint64_t(hi) << 16) | lo);
+                }
+            // Store a 48-bit value as a (6-byte, big-endian) message counter.
+            static inline void msgcounterstore(uint8_t *const counter, const uint64_t value)
+                {
+                const uint32_t hi = uint32_t(value >> 16);
+                counter[0] = uint8_t(hi >> 24); counter[1] = uint8_t(hi >> 16);
+                counter[2] = uint8_t(hi >> 8); counter[3] = uint8_t(hi);
+                counter[4] = uint8_t(value >> 8); counter[5] = uint8_t(value);
+                }
+
+            // Reference byte-at-a-time versions of msgcountercmp() and msgcounteradd();
+            // used directly on 8-bit targets (eg AVR) where wider arithmetic gains nothing.
+            // msgcountercmpBytewise() is not constant-time.
+            static int16_t msgcountercmpBytewise(const uint8_t *counter1, const uint8_t *counter2)
+                { return(int16_t(memcmp(counter1, counter2, fullMsgCtrBytes))); }
+            static bool msgcounteraddBytewise(uint8_t *counter, uint8_t delta);
+
             // Check one (6-byte) message counter against another for magnitude.
             // Returns 0 if they are identical, +ve if the first counter is greater, -ve otherwise.
             // Logically like getting the sign of counter1 - counter2.
-            static int16_t msgcountercmp(const uint8_t *counter1, const uint8_t *counter2)
-                { return(int16_t(memcmp(counter1, counter2, fullMsgCtrBytes))); }
+            // Other than on AVR works on whole words and is branch-free (constant-time),
+            // returning exactly -1, 0 or +1.
+            static inline int16_t msgcountercmp(const uint8_t *counter1, const uint8_t *counter2)
+                {
+#if defined(ARDUINO_ARCH_AVR)
+                return(msgcountercmpBytewise(counter1, counter2));
+#else
+                // Both values are < 2^48 so the difference cannot overflow.
+                const int64_t d = int64_t(msgcounterload(counter1)) - int64_t(msgcounterload(counter2));
+                // Sign bits of -d and d give +1/-1 respectively; both 0 iff d is 0.
+                return(int16_t(int16_t(uint64_t(-d) >> 63) - int16_t(uint64_t(d) >> 63)));
+#endif
+                }
 
             // Add specified small unsigned value to supplied counter value in place; false if failed.
             // This will fail (returning false) if the counter would overflow, leaving it unchanged.
-            static bool msgcounteradd(uint8_t *counter, uint8_t delta);
+            // Other than on AVR works on whole words.
+            static inline bool msgcounteradd(uint8_t *counter, uint8_t delta)
+                {
+#if defined(ARDUINO_ARCH_AVR)
+                return(msgcounteraddBytewise(counter, delta));
+#else
+                const uint64_t v = msgcounterload(counter) + delta;
+                if(v > msgcountermax) { return(false); } // FAIL: would overflow.
+                msgcounterstore(counter, v);
+                return(true);
+#endif
+                }
 
 
             // Unpads plain-text in place prior to encryption with 32-byte fixed length padded output.
@@ -910,9 +1156,13 @@ namespace OTRadioLink
              *          - Returns 1 and sets ptextLen to 0 if ptext is NULL but auth passes.
              *
              * @note    Uses a scratch space, allowing the stack usage to be more tightly controlled.
+             * @note    If fd was constructed in zero-copy form (fd.ptextInPlace)
+             *          the body is decrypted directly into fd.ptext and only
+             *          decodeRaw_inPlace_scratch_usage bytes of scratch are used here.
              */
             static constexpr uint8_t decodeRaw_scratch_usage =
                 ENC_BODY_SMALL_FIXED_CTEXT_SIZE;
+            static constexpr uint8_t decodeRaw_inPlace_scratch_usage = 0;
             static constexpr size_t decodeRaw_total_scratch_usage_OTAESGCM_3p0 =
                 0 /* Any additional callee space would be for d(). */ +
                 decodeRaw_scratch_usage;
@@ -922,6 +1172,20 @@ namespace OTRadioLink
                                 OTV0P2BASE::ScratchSpaceL &scratch,
                                 const uint8_t *key,
                                 const uint8_t *iv);
+            // As decodeRaw() above, but using a cached pre-expanded key schedule.
+            // The decryption function must accept the schedule in place of the key.
+            // Fails if the cache is not valid.
+            static uint8_t decodeRaw(
+                                OTDecodeData_T &fd,
+                                fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &dKS,
+                                OTV0P2BASE::ScratchSpaceL &scratch,
+                                const SimpleSecureKeyCache &keyCache,
+                                const uint8_t *iv)
+                {
+                const uint8_t *const ks = keyCache.getSchedule();
+                if(NULL == ks) { return(0); } // ERROR
+                return(decodeRaw(fd, dKS, scratch, ks, iv));
+                }
 
             // Design notes on use of message counters vs non-volatile storage life, eg for ATMega328P.
             //
@@ -944,8 +1208,16 @@ namespace OTRadioLink
             virtual bool getLastRXMsgCtr(const uint8_t * const ID, uint8_t *counter) const = 0;
             // Check message counter for given ID, ie that it is high enough to be eligible for authenticating/processing.
             // ID is full (8-byte) node ID; counter is full (6-byte) counter.
-            // Returns false if this counter value is not higher than the last received authenticated value.
+            // Returns false if this counter value is not higher than the last received authenticated value,
+            // unless it is a not-yet-seen value within the replay window (see isRXMsgCtrInReplayWindow()).
             bool validateRXMsgCtr(const uint8_t *ID, const uint8_t *counter) const;
+            // True if counter, though not higher than the last authenticated value for ID,
+            // is within an anti-replay window and not yet accepted, so may be accepted (once)
+            // as a late out-of-order frame, eg one relayed after a later direct one.
+            // By default there is no window and this is always false.
+            // An implementation allowing this must also accept such a counter in authAndUpdateRXMsgCtr()
+            // exactly once, without lowering the stored last value.
+            virtual bool isRXMsgCtrInReplayWindow(const uint8_t * /*ID*/, const uint8_t * /*counter*/) const { return(false); }
             // Update persistent message counter for received frame AFTER successful authentication.
             // ID is full (8-byte) node ID; counter is full (6-byte) counter.
             // Returns false on failure, eg if message counter is not higher than the previous value for this node.
@@ -1062,6 +1334,233 @@ namespace OTRadioLink
                         const uint8_t *key,
                         bool firstIDMatchOnly = true);
 
+            /**
+             * @brief   Decode several structurally correct secure small frames
+             *          with one key and one scratch space, eg a burst drained
+             *          from the RX queue.
+             *
+             * Each frame is handled exactly as by decode(), including
+             * message counter checking and update, but the node association
+             * lookup is done once for each run of frames with the same header ID.
+             *
+             * @param   fds: Array of n pointers to decode data, each with a
+             *              validated header as for decode(). Never NULL.
+             * @param   n: Number of frames.
+             * @param   d: Decryption function.
+             * @param   scratch: Scratch space. Size must be large enough to contain
+             *              decodeBatch_total_scratch_usage_OTAESGCM_3p0 bytes AND the
+             *              scratch space required by the decryption function `d`.
+             * @param   key, INPUT: 16-byte secret key. Never NULL.
+             * @param   results, OUTPUT: If non-NULL, n bytes receiving the
+             *              decode() result for each frame, 0 for failure.
+             * @retval  Number of frames successfully authenticated and decoded.
+             */
+            static constexpr uint8_t decodeBatch_scratch_usage =
+                2 + SecurableFrameHeader::maxIDLength; // Last header ID and result.
+            static constexpr size_t decodeBatch_total_scratch_usage_OTAESGCM_3p0 =
+                decode_total_scratch_usage_OTAESGCM_3p0 +
+                decodeBatch_scratch_usage;
+            uint8_t decodeBatch(
+                        OTDecodeData_T *const *fds,
+                        uint8_t n,
+                        fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &d,
+                        OTV0P2BASE::ScratchSpaceL &scratch,
+                        const uint8_t *key,
+                        uint8_t *results = NULL);
+
+        private:
+            // Common tail of decode() and decodeBatch() once the sender is known.
+            // The full sender node ID must be at the start of scratch,
+            // which is laid out as for decode().
+            // index is the sender's association slot, copied to fd on success.
+            uint8_t _decodeFromNodeID(
+                        OTDecodeData_T &fd,
+                        fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &d,
+                        OTV0P2BASE::ScratchSpaceL &scratch,
+                        const uint8_t *key,
+                        int8_t index);
+        };
+
+    // Smallest unsigned type holding a replay window bitmap of n bits; see SimpleSecureRXMsgCtrCache.
+    template<uint8_t n> struct SimpleSecureRXReplayBitmap
+        {
+        static_assert(n <= 32, "replay window too large");
+        typedef typename SimpleSecureRXReplayBitmap<(n > 16) ? 32 : ((n > 8) ? 16 : 8)>::type type;
+        };
+    template<> struct SimpleSecureRXReplayBitmap<8> { typedef uint8_t type; };
+    template<> struct SimpleSecureRXReplayBitmap<16> { typedef uint16_t type; };
+    template<> struct SimpleSecureRXReplayBitmap<32> { typedef uint32_t type; };
+
+    /**
+     * @brief   RAM cache of RX message counters, one per association slot,
+     *          allowing most counter checks and updates to avoid EEPROM.
+     *
+     * Replay safety across resets is kept by persisting a reservation:
+     * when the counter has to go to non-volatile store, the value written is
+     * some way (up to writeBackInterval) AHEAD of the counter actually accepted.
+     * Later counters up to the reservation are then accepted by updating RAM only.
+     * After a reset the persisted (reserved) value is reloaded as the last counter,
+     * which is never lower than any counter accepted before the reset,
+     * at the cost of possibly ignoring up to writeBackInterval frames from each
+     * node until it moves past the reservation, eg on its own restart.
+     *
+     * Optionally (replayWindow > 0) each slot also keeps an anti-replay
+     * sliding window bitmap, as for IPsec (RFC 4303 3.4.3),
+     * so that a frame arriving late, eg via a relay after a later direct one,
+     * is still accepted exactly once if within replayWindow of the highest counter seen.
+     * Bit k-1 is set if the counter k below the highest has been accepted,
+     * OR if its state is unknown, eg after a reset or when the slot is first loaded,
+     * so nothing below the persisted value is ever accepted after a reset.
+     * The window is RAM only: counters within it are below the highest,
+     * so below the persisted reservation.
+     *
+     * Not ISR-safe.
+     */
+    template<uint8_t maxSets, uint8_t writeBackInterval = 16, uint8_t replayWindow = 0>
+    class SimpleSecureRXMsgCtrCache final
+        {
+        public:
+            static constexpr uint8_t interval = writeBackInterval;
+            static_assert(writeBackInterval > 0, "writeBackInterval must be positive");
+            static constexpr uint8_t window = replayWindow;
+
+        private:
+            typedef typename SimpleSecureRXReplayBitmap<replayWindow>::type bitmap_t;
+            // All window bits set: everything below the highest counter is (treated as) seen.
+            static constexpr bitmap_t allSeen = (bitmap_t)~(bitmap_t)0;
+            struct entry_t
+                {
+                // Last accepted (highest) counter.
+                uint8_t counter[SimpleSecureFrame32or0BodyBase::fullMsgCtrBytes];
+                // How far the persisted counter is ahead of counter.
+                uint8_t ahead;
+                bool valid;
+                // Counters below the highest already accepted (or unknown); unused if replayWindow is 0.
+                bitmap_t seen;
+                };
+            entry_t entries[maxSets];
+
+            // Slide the window of e forward by d (> 0) as the highest counter moves up,
+            // the old highest becoming seen and skipped counters unseen.
+            static void slide(entry_t &e, const uint64_t d)
+                {
+                if(0 == replayWindow) { return; }
+                if(d > replayWindow) { e.seen = 0; return; }
+                const uint8_t k = uint8_t(d);
+                // Shift in two steps to stay defined when k is the bitmap width.
+                e.seen = (bitmap_t)((bitmap_t)(e.seen << (k - 1)) << 1) | (bitmap_t)((bitmap_t)1 << (k - 1));
+                }
+
+            // Window bit for counter below the highest in e, or 0 if outside the window.
+            static bitmap_t windowBit(const entry_t &e, const uint8_t *const counter)
+                {
+                if(0 == replayWindow) { return(0); }
+                const uint64_t top = SimpleSecureFrame32or0BodyRXBase::msgcounterload(e.counter);
+                const uint64_t c = SimpleSecureFrame32or0BodyRXBase::msgcounterload(counter);
+                if((c >= top) || ((top - c) > replayWindow)) { return(0); }
+                return((bitmap_t)((bitmap_t)1 << (uint8_t(top - c) - 1)));
+                }
+
+        public:
+            constexpr SimpleSecureRXMsgCtrCache() : entries() { }
+
+            // Forget all entries, eg when associations change.
+            void clear() { for(uint8_t i = 0; i < maxSets; ++i) { entries[i].valid = false; } }
+            // Forget one entry.
+            void invalidate(const uint8_t slot) { if(slot < maxSets) { entries[slot].valid = false; } }
+
+            // Copy out the last accepted counter for the slot; false if not cached.
+            bool get(const uint8_t slot, uint8_t *const counter) const
+                {
+                if((slot >= maxSets) || !entries[slot].valid) { return(false); }
+                memcpy(counter, entries[slot].counter, sizeof(entries[slot].counter));
+                return(true);
+                }
+
+            // Set the last accepted counter for the slot and how far ahead of it
+            // the persisted value is; zero ahead if it is exactly what is persisted.
+            // If the slot held a lower counter, the replay window slides up from it,
+            // else (eg on first load) everything below counter is treated as seen.
+            void set(const uint8_t slot, const uint8_t *const counter, const uint8_t ahead)
+                {
+                if(slot >= maxSets) { return; }
+                entry_t &e = entries[slot];
+                const uint64_t oldTop = SimpleSecureFrame32or0BodyRXBase::msgcounterload(e.counter);
+                const uint64_t newTop = SimpleSecureFrame32or0BodyRXBase::msgcounterload(counter);
+                if(e.valid && (newTop > oldTop)) { slide(e, newTop - oldTop); }
+                else { e.seen = allSeen; }
+                memcpy(e.counter, counter, sizeof(e.counter));
+                e.ahead = ahead;
+                e.valid = true;
+                }
+
+            // Accept newCounter for the slot in RAM only if it is above the last accepted value
+            // and no further ahead than the persisted reservation; returns true if so.
+            // Otherwise leaves the entry unchanged and returns false,
+            // and the caller must persist (a reservation beyond) the new value.
+            bool advanceInRAM(const uint8_t slot, const uint8_t *const newCounter)
+                {
+                if((slot >= maxSets) || !entries[slot].valid) { return(false); }
+                entry_t &e = entries[slot];
+                // Usually the new counter is just one above the last.
+                for(uint8_t k = 1; k <= e.ahead; ++k)
+                    {
+                    uint8_t putative[sizeof(e.counter)];
+                    memcpy(putative, e.counter, sizeof(putative));
+                    if(!SimpleSecureFrame32or0BodyRXBase::msgcounteradd(putative, k)) { return(false); }
+                    if(0 == SimpleSecureFrame32or0BodyRXBase::msgcountercmp(putative, newCounter))
+                        {
+                        slide(e, k);
+                        memcpy(e.counter, newCounter, sizeof(e.counter));
+                        e.ahead -= k;
+                        return(true);
+                        }
+                    }
+                return(false);
+                }
+
+            // True if counter is below the slot's highest, within the replay window, and not yet accepted.
+            bool inReplayWindow(const uint8_t slot, const uint8_t *const counter) const
+                {
+                if((slot >= maxSets) || !entries[slot].valid) { return(false); }
+                const bitmap_t bit = windowBit(entries[slot], counter);
+                return((0 != bit) && (0 == (entries[slot].seen & bit)));
+                }
+
+            // Accept counter (below the slot's highest) exactly once if in the replay window;
+            // returns false, leaving the entry unchanged, if not.
+            bool acceptInReplayWindow(const uint8_t slot, const uint8_t *const counter)
+                {
+                if(!inReplayWindow(slot, counter)) { return(false); }
+                entry_t &e = entries[slot];
+                e.seen |= windowBit(e, counter);
+                return(true);
+                }
+
+            // Persists a reservation counter for the slot to non-volatile store; false on failure.
+            typedef bool persist_fn_t(uint8_t slot, const uint8_t *counter);
+            // Accept an authenticated newCounter for the (already loaded) slot, or reject it.
+            // A counter in the replay window is accepted once, in RAM only.
+            // Else it must be above the last accepted value;
+            // it is accepted in RAM only if within the persisted reservation,
+            // else a reservation up to writeBackInterval ahead of it is persisted first.
+            // The entry (and its replay window) is kept across a successful persist,
+            // but is dropped if the persist fails, so that it is reloaded from non-volatile store.
+            bool acceptAndPersist(const uint8_t slot, const uint8_t *const newCounter, persist_fn_t &persist)
+                {
+                if(acceptInReplayWindow(slot, newCounter)) { return(true); }
+                uint8_t last[SimpleSecureFrame32or0BodyBase::fullMsgCtrBytes];
+                if(!get(slot, last) ||
+                   (SimpleSecureFrame32or0BodyRXBase::msgcountercmp(newCounter, last) <= 0)) { return(false); }
+                if(advanceInRAM(slot, newCounter)) { return(true); }
+                // Just the new value if too near the maximum (msgcounteradd() leaves it unchanged).
+                uint8_t reserved[sizeof(last)];
+                memcpy(reserved, newCounter, sizeof(reserved));
+                const uint8_t ahead = SimpleSecureFrame32or0BodyRXBase::msgcounteradd(reserved, writeBackInterval) ? writeBackInterval : 0;
+                if(!persist(slot, reserved)) { invalidate(slot); return(false); }
+                set(slot, newCounter, ahead);
+                return(true);
+                }
         };
 
 
@@ -1105,6 +1604,19 @@ namespace OTRadioLink
      */
     SimpleSecureFrame32or0BodyRXBase::fixed32BTextSize12BNonce16BTagSimpleDec_fn_t fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL;
 
+    /**
+     * @brief   NULL AES-128 key 'expansion'. DOES NOT EXPAND THE KEY
+     *          SO DO NOT USE IN PRODUCTION SYSTEMS.
+     *
+     * - Copies the key to the first round key, as real expansion does.
+     * - Fills the rest of the schedule with a simple function of the key,
+     *   so that different keys give different schedules.
+     *
+     * Can be used with the NULL encryption/decryption functions above,
+     * which ignore the key (or schedule).
+     */
+    SimpleSecureFrame32or0BodyBase::aes128KeyExpand_fn_t aes128KeyExpand_NULL_IMPL;
+
 
     // CONVENIENCE/BOILERPLATE METHODS
 
@@ -1217,6 +1729,54 @@ namespace OTRadioLink
         }
     };
 
+    // Secure frame RX with associations and their RX message counters in a pluggable store,
+    // eg an OTV0P2BASE::NodeAssociationStoreExtended in external flash for a hub
+    // with many more nodes than the V0p2 EEPROM layout allows.
+    // Lookups go via a RAM index of up to maxSlots associations,
+    // which is rebuilt lazily from the store after invalidateIndex().
+    // The store must hold RX message counters.
+    // Not thread-/ISR- safe.
+    template<uint16_t maxSlots>
+    class SimpleSecureFrame32or0BodyRXStore final : public SimpleSecureFrame32or0BodyRXBase
+    {
+    private:
+        OTV0P2BASE::NodeAssociationStoreBase &store;
+        mutable OTV0P2BASE::NodeAssociationStoreIndex<maxSlots> index;
+
+        // Returns index if there is an index-th (from 0) association matching the frame ID, else -1.
+        virtual int8_t _getNextMatchingNodeID(const uint8_t index_, const SecurableFrameHeader *const sfh, uint8_t *nodeID) const override
+        {
+            const uint8_t il = sfh->getIl();
+            // Anonymous frames cannot be attributed.
+            if((0 == il) || (index_ > 127)) { return(-1); }
+            if(index.getNextMatch(store, index_, sfh->id, il, nodeID) < 0) { return(-1); }
+            return(int8_t(index_));
+        }
+
+    public:
+        explicit SimpleSecureFrame32or0BodyRXStore(OTV0P2BASE::NodeAssociationStoreBase &store_) : store(store_) { }
+
+        // Add an association with a zero RX message counter; false if there is no space.
+        bool addNode(const uint8_t *const ID) { return(index.add(store, ID) >= 0); }
+        // Call after altering the store other than via addNode().
+        void invalidateIndex() { index.invalidate(); }
+
+        virtual bool getLastRXMsgCtr(const uint8_t *const ID, uint8_t *counter) const override
+        {
+            if((NULL == ID) || (NULL == counter)) { return(false); }
+            const int16_t slot = index.find(store, ID);
+            if(slot < 0) { return(false); }
+            return(store.getRXCounter(uint16_t(slot), counter));
+        }
+        virtual bool authAndUpdateRXMsgCtr(const uint8_t *ID, const uint8_t *newCounterValue) override
+        {
+            if(!validateRXMsgCtr(ID, newCounterValue)) { return(false); }
+            const int16_t slot = index.find(store, ID);
+            if(slot < 0) { return(false); }
+            return(store.setRXCounter(uint16_t(slot), newCounterValue));
+        }
+    };
+
 
     }
 
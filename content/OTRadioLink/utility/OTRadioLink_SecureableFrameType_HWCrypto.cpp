@@ -0,0 +1,182 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * Pluggable (eg hardware) crypto backends for secure frames.
+ *
+ * GCM as per NIST SP 800-38D, restricted to a 96-bit IV,
+ * 0 or 32 bytes of text and a full 128-bit tag.
+ */
+
+#include <string.h>
+
+#include "OTRadioLink_SecureableFrameType_HWCrypto.h"
+
+#ifdef OTRADIOLINK_SECUREFRAME_HW_CRYPTO
+extern "C" {
+#include "em_device.h"
+#include "em_cmu.h"
+#include "em_crypto.h"
+}
+#endif
+
+namespace OTRadioLink
+    {
+
+// Workspace layout, 16 bytes each.
+static constexpr uint8_t wsH = 0;   // Hash subkey H = E(K, 0^128).
+static constexpr uint8_t wsY = 16;  // GHASH accumulator.
+static constexpr uint8_t wsJ = 32;  // Counter block.
+static constexpr uint8_t wsS = 48;  // Block cipher output (keystream).
+static constexpr uint8_t wsZ = 64;  // GF(2^128) multiply product.
+static constexpr uint8_t wsV = 80;  // GF(2^128) multiply shifted operand.
+static_assert(wsV + 16 == workspaceRequired_GCM32B16B_BLOCK, "workspace layout");
+
+// Y = (Y ^ block[0..len)) * H in GF(2^128), with block zero-padded to 16 bytes.
+// Constant time with respect to the data: no data-dependent branches or indexing.
+static void ghashBlock(uint8_t *const ws, const uint8_t *const block, const uint8_t len)
+    {
+    uint8_t *const Y = ws + wsY;
+    uint8_t *const Z = ws + wsZ;
+    uint8_t *const V = ws + wsV;
+    for(uint8_t i = 0; i < len; ++i) { Y[i] ^= block[i]; }
+    memset(Z, 0, 16);
+    memcpy(V, ws + wsH, 16);
+    for(uint8_t i = 0; i < 128; ++i)
+        {
+        // Z ^= V if bit i (MSB first) of Y is set.
+        const uint8_t zmask = (uint8_t)-(uint8_t)((Y[i >> 3] >> (7 - (i & 7))) & 1);
+        for(uint8_t j = 0; j < 16; ++j) { Z[j] ^= V[j] & zmask; }
+        // V = V >> 1, reduced by R = 0xe1 || 0^120 if a bit is shifted out.
+        const uint8_t rmask = (uint8_t)-(uint8_t)(V[15] & 1);
+        for(uint8_t j = 15; j > 0; --j) { V[j] = (uint8_t)((V[j] >> 1) | (V[j-1] << 7)); }
+        V[0] = (uint8_t)((V[0] >> 1) ^ (0xe1 & rmask));
+        }
+    memcpy(Y, Z, 16);
+    }
+
+// Set up H and J0 and compute the GHASH over the authtext, the ciphertext (if any) and the lengths.
+// On return S holds E(K, J0) and Y the GHASH, so the tag is S ^ Y.
+static bool gcmHashAndTagMask(aes128BlockEnc_fn_t &blockEnc,
+        uint8_t *const ws, const uint8_t *const key, const uint8_t *const iv,
+        const uint8_t *const authtext, const uint8_t authtextSize,
+        const uint8_t *const ciphertext)
+    {
+    memset(ws, 0, workspaceRequired_GCM32B16B_BLOCK);
+    if(!blockEnc(key, ws + wsS, ws + wsH)) { return(false); } // ERROR
+    for(uint8_t i = 0; i < authtextSize; i += 16)
+        { ghashBlock(ws, authtext + i, (uint8_t)OTV0P2BASE::fnmin(16, authtextSize - i)); }
+    const uint8_t textSize = (nullptr == ciphertext) ? 0 : 32;
+    for(uint8_t i = 0; i < textSize; i += 16) { ghashBlock(ws, ciphertext + i, 16); }
+    // Lengths block: 64-bit big-endian bit counts of authtext and text, both well under 2^16.
+    uint8_t *const L = ws + wsS;
+    memset(L, 0, 16);
+    L[6] = (uint8_t)(authtextSize >> 5); L[7] = (uint8_t)(authtextSize << 3);
+    L[14] = (uint8_t)(textSize >> 5); L[15] = (uint8_t)(textSize << 3);
+    ghashBlock(ws, L, 16);
+    // J0 = IV || 0^31 || 1.
+    uint8_t *const J = ws + wsJ;
+    memcpy(J, iv, 12);
+    J[12] = 0; J[13] = 0; J[14] = 0; J[15] = 1;
+    return(blockEnc(key, J, ws + wsS));
+    }
+
+// out = in ^ E(K, inc32(J0)) || E(K, inc32(inc32(J0))), for 32 bytes.
+// Safe for out == in.
+static bool gcmCTR32(aes128BlockEnc_fn_t &blockEnc,
+        uint8_t *const ws, const uint8_t *const key, const uint8_t *const iv,
+        const uint8_t *const in, uint8_t *const out)
+    {
+    uint8_t *const J = ws + wsJ;
+    uint8_t *const S = ws + wsS;
+    memcpy(J, iv, 12);
+    J[12] = 0; J[13] = 0; J[14] = 0;
+    for(uint8_t b = 0; b < 2; ++b)
+        {
+        J[15] = (uint8_t)(2 + b);
+        if(!blockEnc(key, J, S)) { return(false); } // ERROR
+        for(uint8_t i = 0; i < 16; ++i) { out[16*b + i] = in[16*b + i] ^ S[i]; }
+        }
+    return(true);
+    }
+
+bool fixed32BTextSize12BNonce16BTagSimpleEnc_via_block(
+        aes128BlockEnc_fn_t &blockEnc,
+        uint8_t *const workspace, const size_t workspaceSize,
+        const uint8_t *const key, const uint8_t *const iv,
+        const uint8_t *const authtext, const uint8_t authtextSize,
+        const uint8_t *const plaintext,
+        uint8_t *const ciphertextOut, uint8_t *const tagOut)
+    {
+    if((nullptr == workspace) || (workspaceSize < workspaceRequired_GCM32B16B_BLOCK)) { return(false); } // ERROR
+    if((nullptr == key) || (nullptr == iv) || (nullptr == authtext) ||
+       (nullptr == ciphertextOut) || (nullptr == tagOut)) { return(false); } // ERROR
+    bool ok = true;
+    if(nullptr != plaintext) { ok = gcmCTR32(blockEnc, workspace, key, iv, plaintext, ciphertextOut); }
+    ok = ok && gcmHashAndTagMask(blockEnc, workspace, key, iv, authtext, authtextSize,
+                                 (nullptr == plaintext) ? nullptr : ciphertextOut);
+    if(ok) { for(uint8_t i = 0; i < 16; ++i) { tagOut[i] = workspace[wsS + i] ^ workspace[wsY + i]; } }
+    // Security: leave nothing of the key stream or hash state behind.
+    memset(workspace, 0, workspaceRequired_GCM32B16B_BLOCK);
+    return(ok);
+    }
+
+bool fixed32BTextSize12BNonce16BTagSimpleDec_via_block(
+        aes128BlockEnc_fn_t &blockEnc,
+        uint8_t *const workspace, const size_t workspaceSize,
+        const uint8_t *const key, const uint8_t *const iv,
+        const uint8_t *const authtext, const uint8_t authtextSize,
+        const uint8_t *const ciphertext, const uint8_t *const tag,
+        uint8_t *const plaintextOut)
+    {
+    if((nullptr == workspace) || (workspaceSize < workspaceRequired_GCM32B16B_BLOCK)) { return(false); } // ERROR
+    if((nullptr == key) || (nullptr == iv) || (nullptr == authtext) ||
+       (nullptr == tag) || (nullptr == plaintextOut)) { return(false); } // ERROR
+    bool ok = gcmHashAndTagMask(blockEnc, workspace, key, iv, authtext, authtextSize, ciphertext);
+    if(ok)
+        {
+        // Constant-time tag comparison.
+        uint8_t diff = 0;
+        for(uint8_t i = 0; i < 16; ++i) { diff |= (uint8_t)(tag[i] ^ workspace[wsS + i] ^ workspace[wsY + i]); }
+        ok = (0 == diff);
+        }
+    if(ok && (nullptr != ciphertext)) { ok = gcmCTR32(blockEnc, workspace, key, iv, ciphertext, plaintextOut); }
+    // Security: leave nothing of the key stream or hash state behind.
+    memset(workspace, 0, workspaceRequired_GCM32B16B_BLOCK);
+    return(ok);
+    }
+
+#ifdef OTRADIOLINK_SECUREFRAME_HW_CRYPTO
+bool aes128BlockEnc_EFR32_CRYPTO(const uint8_t *const key, const uint8_t *const in, uint8_t *const out)
+    {
+    if((nullptr == key) || (nullptr == in) || (nullptr == out)) { return(false); } // ERROR
+    // emlib loads key and data as 32-bit words so needs them word-aligned.
+    uint32_t k[4], b[4];
+    memcpy(k, key, 16);
+    memcpy(b, in, 16);
+    CMU_ClockEnable(cmuClock_CRYPTO, true);
+    CRYPTO_AES_ECB128(CRYPTO, (uint8_t *)b, (const uint8_t *)b, 16, (const uint8_t *)k, true);
+    memcpy(out, b, 16);
+    // Security: do not leave the key or block on the stack.
+    memset(k, 0, sizeof(k));
+    memset(b, 0, sizeof(b));
+    return(true);
+    }
+#endif // OTRADIOLINK_SECUREFRAME_HW_CRYPTO
+
+    }
@@ -0,0 +1,186 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * Pluggable (eg hardware) crypto backends for secure frames.
+ *
+ * Implements the fixed-size AES-128-GCM encrypt/decrypt function signatures
+ * used by the secure frame code
+ * (SimpleSecureFrame32or0BodyTXBase::fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t
+ * and SimpleSecureFrame32or0BodyRXBase::fixed32BTextSize12BNonce16BTagSimpleDec_fn_t)
+ * on top of a single-block AES-128 encryption primitive,
+ * such as the EFR32 CRYPTO peripheral.
+ *
+ * The hardware backend is selected at build time:
+ * OTRADIOLINK_SECUREFRAME_HW_CRYPTO is defined where one is available
+ * (currently EFR32 only) unless OTRADIOLINK_SECUREFRAME_NO_HW_CRYPTO is defined.
+ * The _HW_OR_SW wrappers use it when available,
+ * else fall back to the software implementation supplied by the application
+ * (eg from OTAESGCM).
+ */
+
+#ifndef ARDUINO_LIB_OTRADIOLINK_SECUREABLEFRAMETYPE_HWCRYPTO_H
+#define ARDUINO_LIB_OTRADIOLINK_SECUREABLEFRAMETYPE_HWCRYPTO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "OTRadioLink_SecureableFrameType.h"
+
+#if defined(EFR32FG1P133F256GM48) && !defined(OTRADIOLINK_SECUREFRAME_NO_HW_CRYPTO)
+#define OTRADIOLINK_SECUREFRAME_HW_CRYPTO
+#endif
+
+namespace OTRadioLink
+    {
+
+    /**
+     * @brief   Single-block AES-128 encryption primitive.
+     *
+     * @param   key: 16-byte secret key; never NULL.
+     * @param   in: 16-byte plaintext block; never NULL.
+     * @param   out: 16-byte ciphertext block; never NULL, may be the same as in.
+     * @retval  true on success, false on failure.
+     */
+    typedef bool (aes128BlockEnc_fn_t)(const uint8_t *key, const uint8_t *in, uint8_t *out);
+
+    // Workspace required by the GCM-over-block-primitive routines, in bytes.
+    // Much smaller than workspaceRequred_GCM32B16B_OTAESGCM_2p0,
+    // so any workspace sized for the software implementation is also big enough here.
+    static constexpr size_t workspaceRequired_GCM32B16B_BLOCK = 6 * 16;
+
+    /**
+     * @brief   AES-128-GCM encryption of 32 or 0 bytes with a 12-byte nonce
+     *          and 16-byte tag, over the supplied block encryption primitive.
+     *
+     * Parameters as for fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t,
+     * with plaintext NULL for authentication only.
+     * Fails if workspace is NULL or smaller than workspaceRequired_GCM32B16B_BLOCK,
+     * and always clears the workspace before returning.
+     */
+    bool fixed32BTextSize12BNonce16BTagSimpleEnc_via_block(
+            aes128BlockEnc_fn_t &blockEnc,
+            uint8_t *workspace, size_t workspaceSize,
+            const uint8_t *key, const uint8_t *iv,
+            const uint8_t *authtext, uint8_t authtextSize,
+            const uint8_t *plaintext,
+            uint8_t *ciphertextOut, uint8_t *tagOut);
+
+    /**
+     * @brief   AES-128-GCM authentication and decryption of 32 or 0 bytes
+     *          with a 12-byte nonce and 16-byte tag, over the supplied block
+     *          encryption primitive.
+     *
+     * Parameters as for fixed32BTextSize12BNonce16BTagSimpleDec_fn_t,
+     * with ciphertext NULL for authentication only.
+     * The tag is checked in constant time before any plaintext is written,
+     * so plaintextOut is untouched on authentication failure.
+     * Fails if workspace is NULL or smaller than workspaceRequired_GCM32B16B_BLOCK,
+     * and always clears the workspace before returning.
+     */
+    bool fixed32BTextSize12BNonce16BTagSimpleDec_via_block(
+            aes128BlockEnc_fn_t &blockEnc,
+            uint8_t *workspace, size_t workspaceSize,
+            const uint8_t *key, const uint8_t *iv,
+            const uint8_t *authtext, uint8_t authtextSize,
+            const uint8_t *ciphertext, const uint8_t *tag,
+            uint8_t *plaintextOut);
+
+    // Adapters with exactly the secure frame enc/dec signatures for a given block primitive.
+    template<aes128BlockEnc_fn_t &blockEnc>
+    bool fixed32BTextSize12BNonce16BTagSimpleEnc_BLOCK(
+            uint8_t *const workspace, const size_t workspaceSize,
+            const uint8_t *const key, const uint8_t *const iv,
+            const uint8_t *const authtext, const uint8_t authtextSize,
+            const uint8_t *const plaintext,
+            uint8_t *const ciphertextOut, uint8_t *const tagOut)
+        {
+        return(fixed32BTextSize12BNonce16BTagSimpleEnc_via_block(blockEnc,
+            workspace, workspaceSize, key, iv, authtext, authtextSize,
+            plaintext, ciphertextOut, tagOut));
+        }
+    template<aes128BlockEnc_fn_t &blockEnc>
+    bool fixed32BTextSize12BNonce16BTagSimpleDec_BLOCK(
+            uint8_t *const workspace, const size_t workspaceSize,
+            const uint8_t *const key, const uint8_t *const iv,
+            const uint8_t *const authtext, const uint8_t authtextSize,
+            const uint8_t *const ciphertext, const uint8_t *const tag,
+            uint8_t *const plaintextOut)
+        {
+        return(fixed32BTextSize12BNonce16BTagSimpleDec_via_block(blockEnc,
+            workspace, workspaceSize, key, iv, authtext, authtextSize,
+            ciphertext, tag, plaintextOut));
+        }
+
+#ifdef OTRADIOLINK_SECUREFRAME_HW_CRYPTO
+    // AES-128 block encryption on the EFR32 CRYPTO peripheral.
+    // Enables the peripheral clock as needed; not reentrant (eg from ISRs).
+    aes128BlockEnc_fn_t aes128BlockEnc_EFR32_CRYPTO;
+
+    // Hardware-backed secure frame enc/dec.
+    constexpr SimpleSecureFrame32or0BodyTXBase::fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t &fixed32BTextSize12BNonce16BTagSimpleEnc_HW =
+        fixed32BTextSize12BNonce16BTagSimpleEnc_BLOCK<aes128BlockEnc_EFR32_CRYPTO>;
+    constexpr SimpleSecureFrame32or0BodyRXBase::fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &fixed32BTextSize12BNonce16BTagSimpleDec_HW =
+        fixed32BTextSize12BNonce16BTagSimpleDec_BLOCK<aes128BlockEnc_EFR32_CRYPTO>;
+#endif // OTRADIOLINK_SECUREFRAME_HW_CRYPTO
+
+    /**
+     * @brief   Secure frame enc/dec using the hardware backend if built in,
+     *          else the supplied software implementation.
+     *
+     * Usage, eg: fixed32BTextSize12BNonce16BTagSimpleEnc_HW_OR_SW<OTAESGCM::fixed32BTextSize12BNonce16BTagSimpleEnc_DEFAULT_WITH_LWORKSPACE>
+     *
+     * The workspace should be sized for the software implementation,
+     * which is at least as large as that needed by the hardware one.
+     */
+    template<SimpleSecureFrame32or0BodyTXBase::fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t &swEnc>
+    bool fixed32BTextSize12BNonce16BTagSimpleEnc_HW_OR_SW(
+            uint8_t *const workspace, const size_t workspaceSize,
+            const uint8_t *const key, const uint8_t *const iv,
+            const uint8_t *const authtext, const uint8_t authtextSize,
+            const uint8_t *const plaintext,
+            uint8_t *const ciphertextOut, uint8_t *const tagOut)
+        {
+#ifdef OTRADIOLINK_SECUREFRAME_HW_CRYPTO
+        return(fixed32BTextSize12BNonce16BTagSimpleEnc_HW(
+#else
+        return(swEnc(
+#endif
+            workspace, workspaceSize, key, iv, authtext, authtextSize,
+            plaintext, ciphertextOut, tagOut));
+        }
+    template<SimpleSecureFrame32or0BodyRXBase::fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &swDec>
+    bool fixed32BTextSize12BNonce16BTagSimpleDec_HW_OR_SW(
+            uint8_t *const workspace, const size_t workspaceSize,
+            const uint8_t *const key, const uint8_t *const iv,
+            const uint8_t *const authtext, const uint8_t authtextSize,
+            const uint8_t *const ciphertext, const uint8_t *const tag,
+            uint8_t *const plaintextOut)
+        {
+#ifdef OTRADIOLINK_SECUREFRAME_HW_CRYPTO
+        return(fixed32BTextSize12BNonce16BTagSimpleDec_HW(
+#else
+        return(swDec(
+#endif
+            workspace, workspaceSize, key, iv, authtext, authtextSize,
+            ciphertext, tag, plaintextOut));
+        }
+
+    }
+
+#endif // ARDUINO_LIB_OTRADIOLINK_SECUREABLEFRAMETYPE_HWCRYPTO_H
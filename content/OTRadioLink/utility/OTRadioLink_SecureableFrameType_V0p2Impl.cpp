@@ -59,6 +59,16 @@ SimpleSecureFrame32or0BodyRXV0p2 &SimpleSecureFrame32or0BodyRXV0p2::getInstance(
     return(instance);
     }
 
+// RAM copies of the TX node ID and persistent reboot/restart counter prefix from EEPROM,
+// shared by all TX instances, so that IVs can be built without EEPROM reads on each secure TX.
+// The prefix copy is dropped/refreshed whenever this code rewrites the prefix in EEPROM.
+// The ID copy is dropped on prefix reset, and refreshed if OTV0P2BASE::nodeIDGeneration changes.
+static uint8_t txNVCtrPrefixCache[SimpleSecureFrame32or0BodyTXBase::txNVCtrPrefixBytes];
+static bool txNVCtrPrefixCacheValid;
+static uint8_t txIDCache[OTV0P2BASE::OpenTRV_Node_ID_Bytes];
+static bool txIDCacheValid;
+static uint8_t txIDCacheGeneration;
+
 // Load the raw form of the persistent reboot/restart message counter from EEPROM into the supplied array.
 // Deals with inversion, but does not interpret the data or check CRCs etc.
 // Separates the EEPROM access from the data interpretation to simplify unit testing.
@@ -116,6 +126,10 @@ bool SimpleSecureFrame32or0BodyTXV0p2::resetRaw3BytePersistentTXRestartCounterIn
      *          devices to delete their keys.
      */
 //    if(!OTV0P2BASE::setPrimaryBuilding16ByteSecretKey(NULL)) { return(false); } ///@note commented as part of TODO-907 fix
+    // Drop the RAM copies; they are reloaded on next use.
+    // The ID is dropped too since a reset usually accompanies a change of ID or key.
+    txNVCtrPrefixCacheValid = false;
+    txIDCacheValid = false;
     // Reset the counter.
     if(allZeros)
         {
@@ -193,11 +207,18 @@ bool SimpleSecureFrame32or0BodyTXV0p2::read3BytePersistentTXRestartCounter(const
 // Combines results from primary and secondary as appropriate.
 // Deals with inversion and checksum checking.
 // Output buffer (buf) must be 3 bytes long.
+// Served from the RAM copy when valid, else loaded from EEPROM (and cached on success).
 bool SimpleSecureFrame32or0BodyTXV0p2::getTXNVCtrPrefix(uint8_t *const buf) const
     {
-    uint8_t loadBuf[OTV0P2BASE::VOP2BASE_EE_LEN_PERSISTENT_MSG_RESTART_CTR];
-    loadRaw3BytePersistentTXRestartCounterFromEEPROM(loadBuf);
-    return(read3BytePersistentTXRestartCounter(loadBuf, buf));
+    if(!txNVCtrPrefixCacheValid)
+        {
+        uint8_t loadBuf[OTV0P2BASE::VOP2BASE_EE_LEN_PERSISTENT_MSG_RESTART_CTR];
+        loadRaw3BytePersistentTXRestartCounterFromEEPROM(loadBuf);
+        if(!read3BytePersistentTXRestartCounter(loadBuf, txNVCtrPrefixCache)) { return(false); }
+        txNVCtrPrefixCacheValid = true;
+        }
+    memcpy(buf, txNVCtrPrefixCache, sizeof(txNVCtrPrefixCache));
+    return(true);
     }
 
 // Increment RAM copy of persistent reboot/restart message counter; returns false on failure.
@@ -232,10 +253,14 @@ bool SimpleSecureFrame32or0BodyTXV0p2::incrementTXNVCtrPrefix(uint8_t *const loa
 bool SimpleSecureFrame32or0BodyTXV0p2::incrementTXNVCtrPrefix()
     {
     // Increment the persistent part; fail entirely if not usable/incrementable (eg all 0xff).
+    // The RAM copy is dropped first in case of failure part way through.
+    txNVCtrPrefixCacheValid = false;
     uint8_t loadBuf[OTV0P2BASE::VOP2BASE_EE_LEN_PERSISTENT_MSG_RESTART_CTR];
     loadRaw3BytePersistentTXRestartCounterFromEEPROM(loadBuf);
     if(!incrementTXNVCtrPrefix(loadBuf)) { return(false); }
     if(!saveRaw3BytePersistentTXRestartCounterToEEPROM(loadBuf)) { return(false); }
+    // Refresh the RAM copy from what was written, avoiding a further EEPROM read.
+    txNVCtrPrefixCacheValid = read3BytePersistentTXRestartCounter(loadBuf, txNVCtrPrefixCache);
     return(true);
     }
 
@@ -371,8 +396,10 @@ bool SimpleSecureFrame32or0BodyRXV0p2::getLastRXMsgCtr(const uint8_t * const ID,
     // Rely on getNextMatchingNodeID() to reject a NULL ID with a non-zero length.
     if(NULL == counter) { return(false); } // FAIL
     // First look up the node association; fail if not present.
-    const int8_t index = OTV0P2BASE::getNextMatchingNodeID(0, ID, OTV0P2BASE::OpenTRV_Node_ID_Bytes, NULL);
+    const int8_t index = _getAssociationIndex(ID);
     if(index < 0) { return(false); } // FAIL
+    // Answer from RAM where possible.
+    if(ctrCache.get(uint8_t(index), counter)) { return(true); }
     // Note: nominal risk of race if associations table can be altered concurrently.
     // Compute base location in EEPROM of association table entry/row.
     uint8_t * const rawPtr = (uint8_t *)(OTV0P2BASE::V0P2BASE_EE_START_NODE_ASSOCIATIONS + index*(uint16_t)OTV0P2BASE::V0P2BASE_EE_NODE_ASSOCIATIONS_SET_SIZE);
@@ -389,7 +416,10 @@ bool SimpleSecureFrame32or0BodyRXV0p2::getLastRXMsgCtr(const uint8_t * const ID,
     if(!getLastRXMsgCtrFromTable(rawPtr + OTV0P2BASE::V0P2BASE_EE_NODE_ASSOCIATIONS_MSG_CNT_0_OFFSET, counter) &&
        !getLastRXMsgCtrFromTable(rawPtr + OTV0P2BASE::V0P2BASE_EE_NODE_ASSOCIATIONS_MSG_CNT_1_OFFSET, counter))
        { return(false); } // FAIL: both counters borked.
-    return(use_unary_counter ? SimpleSecureFrame32or0BodyRXBase::msgcounteradd(counter, incr) : true);
+    if(use_unary_counter && !SimpleSecureFrame32or0BodyRXBase::msgcounteradd(counter, incr)) { return(false); } // FAIL
+    // Cache exactly what is persisted, ie with nothing reserved ahead.
+    ctrCache.set(uint8_t(index), counter, 0);
+    return(true);
     }
 
 // Carefully update specified counter (primary or secondary) and CRCs as appropriate; returns false on failure.
@@ -420,21 +450,12 @@ static bool updateRXMessageCount(uint8_t * const eepromLoc, const uint8_t * cons
     return(true);
     }
 
-// Update persistent message counter for received frame AFTER successful authentication.
-// ID is full (8-byte) node ID; counter is full (6-byte) counter.
-// Returns false on failure, eg if message counter is not higher than the previous value for this node.
-// The implementation should allow several years of life typical message rates (see above).
-// The implementation should be robust in the face of power failures / reboots, accidental or malicious,
-// not allowing replays nor other cryptographic attacks, nor forcing node dissociation.
-// Must only be called once the RXed message has passed authentication.
-// Use a unary count as proxy for LSBs to reduce wear; clear unary value after main count increment so as to never have too low a total value.
-bool SimpleSecureFrame32or0BodyRXV0p2::authAndUpdateRXMsgCtr(const uint8_t *ID, const uint8_t *newCounterValue)
+// Write counter value for association index to EEPROM; returns false on failure.
+// The value must be higher than that currently persisted.
+// Uses a unary count as proxy for LSBs to reduce wear; clear unary value after main count increment so as to never have too low a total value.
+static bool persistRXMsgCtr(const uint8_t index, const uint8_t *const newCounterValue)
     {
-    // Validate node ID and new count.
-    if(!validateRXMsgCtr(ID, newCounterValue)) { return(false); } // Putative new counter value not valid; reject.
-    // Look up the node association; fail if not present.
-    const int8_t index = OTV0P2BASE::getNextMatchingNodeID(0, ID, OTV0P2BASE::OpenTRV_Node_ID_Bytes, NULL);
-    if(index < 0) { return(false); } // FAIL (shouldn't be possible after previous validation).
+    constexpr uint8_t fullMsgCtrBytes = SimpleSecureFrame32or0BodyBase::fullMsgCtrBytes;
     // Note: nominal risk of race if associations table can be altered concurrently.
     // Compute base location in EEPROM of association table entry/row.
     uint8_t * const rawPtr = (uint8_t *)(OTV0P2BASE::V0P2BASE_EE_START_NODE_ASSOCIATIONS + index*(uint16_t)OTV0P2BASE::V0P2BASE_EE_NODE_ASSOCIATIONS_SET_SIZE);
@@ -507,13 +528,45 @@ bool SimpleSecureFrame32or0BodyRXV0p2::authAndUpdateRXMsgCtr(const uint8_t *ID,
     return(true);
     }
 
+// Update persistent message counter for received frame AFTER successful authentication.
+// ID is full (8-byte) node ID; counter is full (6-byte) counter.
+// Returns false on failure, eg if message counter is not higher than the previous value for this node.
+// The implementation should allow several years of life typical message rates (see above).
+// The implementation should be robust in the face of power failures / reboots, accidental or malicious,
+// not allowing replays nor other cryptographic attacks, nor forcing node dissociation.
+// Must only be called once the RXed message has passed authentication.
+//
+// The counter is held in RAM, and only written to EEPROM
+// when it moves beyond the value last persisted, which is written
+// with a reservation of up to SimpleSecureRXMsgCtrCache::interval ahead
+// so that the next few frames need no EEPROM update at all.
+// A late frame within the replay window is marked as seen in RAM only,
+// the highest counter (and so the persisted value) being unchanged.
+bool SimpleSecureFrame32or0BodyRXV0p2::authAndUpdateRXMsgCtr(const uint8_t *ID, const uint8_t *newCounterValue)
+    {
+    // Validate node ID and new count.
+    if(!validateRXMsgCtr(ID, newCounterValue)) { return(false); } // Putative new counter value not valid; reject.
+    // Look up the node association; fail if not present.
+    const int8_t index = _getAssociationIndex(ID);
+    if(index < 0) { return(false); } // FAIL (shouldn't be possible after previous validation).
+    // Accept in RAM where possible, else persist a reservation ahead of the new value.
+    return(ctrCache.acceptAndPersist(uint8_t(index), newCounterValue, persistRXMsgCtr));
+    }
+
 // Get TX ID that will be used for transmission; returns false on failure.
 // Argument must be buffer of (at least) OTV0P2BASE::OpenTRV_Node_ID_Bytes bytes.
 bool SimpleSecureFrame32or0BodyTXV0p2::getTXID(uint8_t *const idOut) const
     {
     if(NULL == idOut) { return(false); }
-    // Copy ID from EEPROM.
-    eeprom_read_block(idOut, (uint8_t *)V0P2BASE_EE_START_ID, OTV0P2BASE::OpenTRV_Node_ID_Bytes);
+    // Refresh the RAM copy from EEPROM if absent or if the ID may have been changed.
+    const uint8_t generation = OTV0P2BASE::nodeIDGeneration;
+    if(!txIDCacheValid || (generation != txIDCacheGeneration))
+        {
+        eeprom_read_block(txIDCache, (uint8_t *)V0P2BASE_EE_START_ID, OTV0P2BASE::OpenTRV_Node_ID_Bytes);
+        txIDCacheGeneration = generation;
+        txIDCacheValid = true;
+        }
+    memcpy(idOut, txIDCache, sizeof(txIDCache));
     return(true);
     }
 
@@ -528,6 +581,26 @@ bool SimpleSecureFrame32or0BodyTXV0p2SuppliedID::getTXID(uint8_t *const idOut) c
     return(getID(idOut));
     }
 
+// True if counter is a not-yet-accepted value within OTRADIOLINK_RX_REPLAY_WINDOW below the last.
+// Relies on the caller (validateRXMsgCtr()) having just loaded the cache via getLastRXMsgCtr().
+bool SimpleSecureFrame32or0BodyRXV0p2::isRXMsgCtrInReplayWindow(const uint8_t *const ID, const uint8_t *const counter) const
+    {
+    if((0 == ctrCache.window) || (NULL == counter)) { return(false); }
+    const int8_t index = _getAssociationIndex(ID);
+    if(index < 0) { return(false); } // FAIL
+    return(ctrCache.inReplayWindow(uint8_t(index), counter));
+    }
+
+// Look up the association index for ID, dropping the counter cache if the associations have changed.
+int8_t SimpleSecureFrame32or0BodyRXV0p2::_getAssociationIndex(const uint8_t *const ID) const
+    {
+    const int8_t index = OTV0P2BASE::getNextMatchingNodeID(0, ID, OTV0P2BASE::OpenTRV_Node_ID_Bytes, NULL);
+    // The lookup (re)builds the index as needed, so the generation is now current.
+    const uint8_t generation = OTV0P2BASE::V0p2_NodeIndex.getGeneration();
+    if(generation != ctrCacheGeneration) { ctrCache.clear(); ctrCacheGeneration = generation; }
+    return(index);
+    }
+
 int8_t SimpleSecureFrame32or0BodyRXV0p2::_getNextMatchingNodeID(const uint8_t /*index*/, const SecurableFrameHeader *const sfh, uint8_t *nodeID) const
 {
         return (OTV0P2BASE::getNextMatchingNodeID(0, sfh->id, sfh->getIl(), nodeID));
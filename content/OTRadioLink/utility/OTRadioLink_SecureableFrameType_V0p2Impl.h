@@ -209,6 +209,7 @@ class SimpleSecureFrame32or0BodyTXV0p2Null : public SimpleSecureFrame32or0BodyTX
 
             // Get TX ID that will be used for transmission; returns false on failure.
             // Argument must be buffer of (at least) OTV0P2BASE::OpenTRV_Node_ID_Bytes bytes.
+            // Served from a RAM copy of the EEPROM ID, refreshed when OTV0P2BASE::nodeIDGeneration changes.
             virtual bool getTXID(uint8_t *id) const override;
 
             // Design notes on use of message counters vs non-volatile storage life, eg for ATMega328P.
@@ -268,6 +269,8 @@ class SimpleSecureFrame32or0BodyTXV0p2Null : public SimpleSecureFrame32or0BodyTX
             // Combines results from primary and secondary as appropriate.
             // Deals with inversion and checksum checking.
             // Output buffer (buf) must be 3 bytes long.
+            // Served from a RAM copy after the first read, kept in step with reset/increment,
+            // so that building an IV for TX does not normally touch EEPROM.
             virtual bool getTXNVCtrPrefix(uint8_t *buf) const override;
             // Reset the persistent reboot/restart message counter in EEPROM; returns false on failure.
             // TO BE USED WITH EXTREME CAUTION: reusing the message counts and resulting IVs
@@ -396,11 +399,25 @@ class SimpleSecureFrame32or0BodyTXV0p2Null : public SimpleSecureFrame32or0BodyTX
     //  2b) A 7-bit CRC of the message counter bytes, stored inverted,
     //      so that the all-1s erased state of counter and CRC is valid (counter value 0).
 // #define SimpleSecureFrame32or0BodyRXV0p2_DEFINED
+// Anti-replay window size in frames (0 to 32) for late out-of-order RX, eg via relays;
+// 0 (the default) accepts only strictly increasing counters.
+#ifndef OTRADIOLINK_RX_REPLAY_WINDOW
+#define OTRADIOLINK_RX_REPLAY_WINDOW 0
+#endif
     class SimpleSecureFrame32or0BodyRXV0p2 final : public SimpleSecureFrame32or0BodyRXBase
         {
         private:
             // Constructor is private to force use of factory method to return singleton.
-            constexpr SimpleSecureFrame32or0BodyRXV0p2() { }
+            constexpr SimpleSecureFrame32or0BodyRXV0p2() : ctrCache(), ctrCacheGeneration(0) { }
+
+            // RAM write-back cache of RX counters by association index; see SimpleSecureRXMsgCtrCache.
+            // Mutable as filled by the (logically const) getLastRXMsgCtr().
+            // Also holds the anti-replay window, if any.
+            mutable SimpleSecureRXMsgCtrCache<OTV0P2BASE::V0P2BASE_EE_NODE_ASSOCIATIONS_MAX_SETS, 16, OTRADIOLINK_RX_REPLAY_WINDOW> ctrCache;
+            // Association index generation that the cache contents relate to.
+            mutable uint8_t ctrCacheGeneration;
+            // Look up the association index for ID, dropping the counter cache if the associations have changed.
+            int8_t _getAssociationIndex(const uint8_t *ID) const;
 
             virtual int8_t _getNextMatchingNodeID(const uint8_t index, const SecurableFrameHeader *const sfh, uint8_t *nodeID) const override;
 
@@ -412,6 +429,8 @@ class SimpleSecureFrame32or0BodyTXV0p2Null : public SimpleSecureFrame32or0BodyTX
             // Will fail for invalid node ID or for unrecoverable memory corruption.
             // Both args must be non-NULL, with counter pointing to enough space to copy the message counter value to.
             virtual bool getLastRXMsgCtr(const uint8_t * const ID, uint8_t *counter) const;
+            // True if counter is a not-yet-accepted value within OTRADIOLINK_RX_REPLAY_WINDOW below the last.
+            virtual bool isRXMsgCtrInReplayWindow(const uint8_t *ID, const uint8_t *counter) const override;
             // Update persistent message counter for received frame AFTER successful authentication.
             // ID is full (8-byte) node ID; counter is full (6-byte) counter.
             // Returns false on failure, eg if message counter is not higher than the previous value for this node.
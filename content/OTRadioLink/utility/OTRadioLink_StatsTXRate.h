@@ -0,0 +1,189 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Capacity-aware stats TX interval:
+ * the hub derives a backpressure level from its RX losses and channel occupancy
+ * and carries it in the body of its secure beacon,
+ * and each node stretches its stats interval by that level
+ * and by how little its values are changing.
+ *
+ * Backpressure beacon body (plaintext in the secure frame, so authenticated):
+ *   [0] BACKPRESSURE_BEACON_FORMAT
+ *   [1] level: 0 (idle) to 255 (saturated)
+ *
+ * Portable.
+ */
+
+#ifndef ARDUINO_LIB_OTRADIOLINK_STATSTXRATE_H
+#define ARDUINO_LIB_OTRADIOLINK_STATSTXRATE_H
+
+#include <stdint.h>
+
+#include "OTRadioLink_OTRadioLink.h"
+
+// Use namespaces to help avoid collisions.
+namespace OTRadioLink
+    {
+    // First byte of a backpressure beacon body, to distinguish it from any other beacon body.
+    static constexpr uint8_t BACKPRESSURE_BEACON_FORMAT = 0x50; // 'P'
+    static constexpr uint8_t BACKPRESSURE_BEACON_BODY_BYTES = 2;
+
+    // Write a backpressure beacon body for level to buf; returns the body length, or 0 if buf is too small.
+    inline uint8_t encodeBackpressureBeacon(uint8_t *const buf, const uint8_t buflen, const uint8_t level)
+        {
+        if((NULL == buf) || (buflen < BACKPRESSURE_BEACON_BODY_BYTES)) { return(0); }
+        buf[0] = BACKPRESSURE_BEACON_FORMAT;
+        buf[1] = level;
+        return(BACKPRESSURE_BEACON_BODY_BYTES);
+        }
+    // Extract the level from a backpressure beacon body; returns false if body is not one.
+    inline bool decodeBackpressureBeacon(const uint8_t *const body, const uint8_t len, uint8_t &level)
+        {
+        if((NULL == body) || (BACKPRESSURE_BEACON_BODY_BYTES != len) || (BACKPRESSURE_BEACON_FORMAT != body[0])) { return(false); }
+        level = body[1];
+        return(true);
+        }
+
+    // Hub side: backpressure level from RX losses and channel occupancy over successive windows.
+    // Either is enough to saturate the level:
+    //   * losses (queue drops and CRC errors, eg from collisions)
+    //     as a fraction of frames heard, saturating at SATURATED_LOSS_PC percent;
+    //   * received airtime as a fraction of the window, saturating at SATURATED_BUSY_PC percent,
+    //     well below the ~18% at which unslotted random access stops gaining throughput.
+    // The level rises at once and decays by half the difference each window,
+    // so nodes back off quickly and come back gradually.
+    // Not thread-/ISR- safe.
+    class OTHubBackpressure final
+        {
+        public:
+            static constexpr uint8_t SATURATED_LOSS_PC = 10;
+            static constexpr uint8_t SATURATED_BUSY_PC = 10;
+
+        private:
+            uint8_t level = 0;
+            // Counts from the previous stats snapshot, for deltas.
+            bool haveSnapshot = false;
+            uint32_t lastFrames = 0;
+            uint16_t lastLost = 0;
+
+            static uint8_t scale(const uint32_t num, const uint32_t den, const uint8_t saturatedPC)
+                {
+                if((0 == num) || (0 == den)) { return(0); }
+                // Value of num at which the level saturates.
+                const uint32_t sat = (den / 100) * saturatedPC + ((den % 100) * saturatedPC) / 100;
+                if(num >= sat) { return(255); }
+                return(uint8_t((num * 255) / sat));
+                }
+
+        public:
+            // Current level, 0 to 255, eg for encodeBackpressureBeacon().
+            uint8_t getLevel() const { return(level); }
+
+            // End a window of windowMs with framesOK frames queued, framesLost lost,
+            // and busyMs of received airtime; returns the new level.
+            uint8_t update(const uint32_t framesOK, const uint32_t framesLost, const uint32_t busyMs, const uint32_t windowMs)
+                {
+                const uint8_t l = scale(framesLost, framesOK + framesLost, SATURATED_LOSS_PC);
+                const uint8_t b = scale(busyMs, windowMs, SATURATED_BUSY_PC);
+                const uint8_t target = (l > b) ? l : b;
+                if(target >= level) { level = target; }
+                else { level = uint8_t(target + ((level - target) / 2)); }
+                return(level);
+                }
+            // End a window from a channel stats snapshot (see OTRadioLink::getChannelStats()),
+            // estimating airtime as frameAirtimeMs per frame heard
+            // (see OTRadioLink::getFrameAirtimeMs()).
+            // The first call only takes the snapshot, and returns the current level.
+            uint8_t update(const OTRadioChannelStats &s, const uint16_t frameAirtimeMs, const uint32_t windowMs)
+                {
+                const uint16_t lost = uint16_t(s.rxDropped + s.rxCRCErrors);
+                if(!haveSnapshot) { haveSnapshot = true; lastFrames = s.rxFrames; lastLost = lost; return(level); }
+                const uint32_t frames = s.rxFrames - lastFrames;
+                const uint16_t lostNow = uint16_t(lost - lastLost);
+                lastFrames = s.rxFrames;
+                lastLost = lost;
+                return(update(frames, lostNow, (frames + lostNow) * (uint32_t)frameAirtimeMs, windowMs));
+                }
+            void reset() { level = 0; haveSnapshot = false; }
+        };
+
+    // Node side: chooses when to send stats.
+    // The interval starts at minInterval and, while successive sends have nothing changed,
+    // doubles each send up to maxInterval; any changed value brings it back to minInterval.
+    // Hub backpressure then stretches it by up to (1 + 255/64) times, ie ~5x when saturated,
+    // but never beyond maxInterval, which thus bounds how long the hub may go
+    // without hearing from the node.
+    // Each backpressure hint is halved at each send after it, so that a node
+    // that stops hearing beacons recovers its normal rate.
+    // Time is in any unit (eg seconds or minutes) from a free-running clock.
+    // The caller may add its usual random jitter around the due time.
+    // Not thread-/ISR- safe.
+    class StatsTXRateController final
+        {
+        private:
+            const uint16_t minInterval;
+            const uint16_t maxInterval;
+            // Doublings of minInterval from unchanged sends.
+            uint8_t quietShift = 0;
+            uint8_t backpressure = 0;
+            // Doublings of the interval to save energy.
+            uint8_t powerSaveShift = 0;
+            bool haveSent = false;
+            uint32_t lastSent = 0;
+
+        public:
+            //  * minInterval_  shortest interval; strictly positive
+            //  * maxInterval_  longest interval; at least minInterval_
+            StatsTXRateController(const uint16_t minInterval_, const uint16_t maxInterval_)
+              : minInterval((0 == minInterval_) ? 1 : minInterval_),
+                maxInterval((maxInterval_ < minInterval_) ? minInterval_ : maxInterval_) { }
+
+            // Set the hub's backpressure hint, eg from decodeBackpressureBeacon().
+            void setBackpressure(const uint8_t level) { backpressure = level; }
+            uint8_t getBackpressure() const { return(backpressure); }
+
+            // Double the interval shift times (up to 4) to save energy, still within maxInterval,
+            // eg from OTV0P2BASE::BatteryStateEstimator::getStatsIntervalShift() on a tired battery.
+            void setPowerSaveShift(const uint8_t shift) { powerSaveShift = (shift > 4) ? 4 : shift; }
+
+            // Interval to wait since the last send, given whether any value has changed.
+            uint16_t getInterval(const bool changed) const
+                {
+                uint32_t i = changed ? minInterval : ((uint32_t)minInterval << quietShift);
+                i = (i * (64U + backpressure)) / 64U;
+                i <<= powerSaveShift;
+                return((i > maxInterval) ? maxInterval : uint16_t(i));
+                }
+            // True if stats should be sent at now, eg given SimpleStatsRotationBase::changedValue().
+            // Always true before the first send.
+            bool isDue(const uint32_t now, const bool changed) const
+                { return(!haveSent || ((now - lastSent) >= getInterval(changed))); }
+            // Record a send at now, and whether it carried any changed value.
+            void sent(const uint32_t now, const bool changed)
+                {
+                haveSent = true;
+                lastSent = now;
+                if(changed) { quietShift = 0; }
+                else if(((uint32_t)minInterval << quietShift) < maxInterval) { ++quietShift; }
+                backpressure /= 2;
+                }
+        };
+    }
+
+#endif
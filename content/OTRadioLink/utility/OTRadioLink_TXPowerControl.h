@@ -0,0 +1,135 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Per-destination adaptive TX power from link-quality feedback,
+ * to save energy and reduce interference on strong links.
+ */
+
+#ifndef ARDUINO_LIB_OTRADIOLINK_TXPOWERCONTROL_H
+#define ARDUINO_LIB_OTRADIOLINK_TXPOWERCONTROL_H
+
+#include <stdint.h>
+
+#include "OTRadioLink_OTRadioLink.h"
+
+// Use namespaces to help avoid collisions.
+namespace OTRadioLink
+    {
+    // Chooses the TXpower hint to pass to sendRaw() / queueToSend() for each destination.
+    // Each destination starts at TXnormal.
+    // Feedback is raw RSSI as from OTRFM23BLink getRSSI() (higher is stronger), either:
+    //   * of a frame just received from the destination, eg an ack,
+    //     taking the link as roughly symmetric; or
+    //   * reported back by the destination for a frame it received from here, eg by a hub.
+    // Power steps down one level after stepDownAfter consecutive strong reports,
+    // and up one level on any weak report or missed frame (eg no ack, or a gap in the
+    // hub-reported sequence), so recovery is quicker than backing off.
+    // Reports between the thresholds hold the level but restart the strong run,
+    // so the strong threshold should be above the weak
+    // by more than one power step (~3dB on the RFM23B) to avoid hunting.
+    // Template parameters:
+    //   * destinations  number of destinations tracked, indexed from 0,
+    //       eg by node association index; strictly positive
+    // Not thread-/ISR- safe.
+    template<uint8_t destinations>
+    class OTTXPowerController final
+        {
+        static_assert(destinations > 0, "must allow at least one destination");
+
+        public:
+            typedef OTRadioLink::TXpower TXpower;
+            // Default raw RSSI thresholds for the RFM23B (~0.5dB steps),
+            // strong leaving ~25dB margin after a step down and weak ~10dB above sensitivity.
+            static constexpr uint8_t DEFAULT_STRONG_RSSI = 140;
+            static constexpr uint8_t DEFAULT_WEAK_RSSI = 60;
+            static constexpr uint8_t DEFAULT_STEP_DOWN_AFTER = 4;
+
+        private:
+            struct Link final
+                {
+                uint8_t level;
+                // Consecutive strong reports at this level.
+                uint8_t strong;
+                };
+            Link links[destinations];
+            const uint8_t strongRSSI;
+            const uint8_t weakRSSI;
+            const uint8_t stepDownAfter;
+            const TXpower minLevel;
+            const TXpower maxLevel;
+            // Steps below maxLevel to cap the power at to save energy.
+            uint8_t powerSaveSteps = 0;
+
+            void up(Link &l) { l.strong = 0; if(l.level < maxLevel) { ++l.level; } }
+
+        public:
+            //  * strongRSSI_  reports at or above this are strong
+            //  * weakRSSI_  reports below this are weak; less than strongRSSI_
+            //  * stepDownAfter_  consecutive strong reports before stepping down; strictly positive
+            //  * minLevel_, maxLevel_  range of levels used; minLevel_ <= TXnormal <= maxLevel_,
+            //      eg maxLevel_ TXloud to avoid double TX from TXmax,
+            //      or minLevel_ TXquiet to leave TXmin for pairing
+            OTTXPowerController(const uint8_t strongRSSI_ = DEFAULT_STRONG_RSSI,
+                                const uint8_t weakRSSI_ = DEFAULT_WEAK_RSSI,
+                                const uint8_t stepDownAfter_ = DEFAULT_STEP_DOWN_AFTER,
+                                const TXpower minLevel_ = OTRadioLink::TXmin,
+                                const TXpower maxLevel_ = OTRadioLink::TXmax)
+              : strongRSSI(strongRSSI_), weakRSSI(weakRSSI_),
+                stepDownAfter((0 == stepDownAfter_) ? 1 : stepDownAfter_),
+                minLevel(minLevel_), maxLevel(maxLevel_)
+                { resetAll(); }
+
+            // Power to use for dest; TXnormal if dest is out of range.
+            // Capped by any power-save steps.
+            TXpower getPower(const uint8_t dest) const
+                {
+                const uint8_t l = (dest < destinations) ? links[dest].level : uint8_t(OTRadioLink::TXnormal);
+                const uint8_t cap = (maxLevel - minLevel > powerSaveSteps) ? uint8_t(maxLevel - powerSaveSteps) : uint8_t(minLevel);
+                return(TXpower((l > cap) ? cap : l));
+                }
+
+            // Cap the power at steps below maxLevel (but not below minLevel),
+            // eg from OTV0P2BASE::BatteryStateEstimator::getTXPowerStepsDown() on a tired battery;
+            // 0 (the default) for no cap.
+            // What is learnt about each link is kept, so removing the cap restores it.
+            void setPowerSaveSteps(const uint8_t steps) { powerSaveSteps = steps; }
+
+            // Link-quality report for dest, which also shows the frame got through.
+            void reportRSSI(const uint8_t dest, const uint8_t rssi)
+                {
+                if(dest >= destinations) { return; }
+                Link &l = links[dest];
+                if(rssi < weakRSSI) { up(l); return; }
+                if(rssi < strongRSSI) { l.strong = 0; return; }
+                if(++l.strong < stepDownAfter) { return; }
+                l.strong = 0;
+                if(l.level > minLevel) { --l.level; }
+                }
+            // A frame to dest was apparently not received.
+            void reportMissed(const uint8_t dest)
+                { if(dest < destinations) { up(links[dest]); } }
+
+            // Forget what was learnt about dest, eg when it is re-paired.
+            void reset(const uint8_t dest)
+                { if(dest < destinations) { links[dest].level = OTRadioLink::TXnormal; links[dest].strong = 0; } }
+            void resetAll() { for(uint8_t i = 0; i < destinations; ++i) { reset(i); } }
+        };
+    }
+
+#endif
@@ -0,0 +1,159 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * OpenTRV Radio Link fixed-size TX frame queue.
+ *
+ * Keywords: C++ embedded Arduino radio TX transmit queue ring buffer
+ */
+
+#ifndef ARDUINO_LIB_OTRADIOLINK_TXQUEUE_H
+#define ARDUINO_LIB_OTRADIOLINK_TXQUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Use namespaces to help avoid collisions.
+namespace OTRadioLink
+    {
+    // Small fixed-capacity FIFO of frames (with TX channel and power hint)
+    // waiting to be sent by a radio driver, eg from queueToSend() for poll() to drain.
+    // All operations are fixed (low) cost, with no dynamic allocation.
+    // NOT ISR-/thread- safe: intended to be filled and drained from the main loop.
+    //   * depth  maximum number of frames queued; 0 for a stub that never holds a frame
+    //   * maxFrameLen  maximum length of each frame in bytes [1,255]
+    template<uint8_t depth, uint8_t maxFrameLen>
+    class TXQueue final
+        {
+        private:
+            struct entry
+                {
+                uint8_t len;
+                int8_t channel;
+                uint8_t power;
+                uint8_t buf[maxFrameLen];
+                };
+            // Circular buffer of queued frames.
+            entry q[depth];
+            // Index of oldest entry, and count of entries queued.
+            uint8_t oldest;
+            uint8_t count;
+
+            // Index of next free slot (only meaningful if not full), avoiding uint8_t overflow.
+            uint8_t nextFree() const
+                {
+                const uint8_t toEnd = depth - oldest;
+                return((count < toEnd) ? (oldest + count) : (count - toEnd));
+                }
+
+        public:
+            constexpr TXQueue() : q(), oldest(0), count(0) { }
+
+            // Maximum number of frames that can be queued.
+            static constexpr uint8_t capacity = depth;
+            // Maximum frame length.
+            static constexpr uint8_t maxLen = maxFrameLen;
+
+            // Number of frames queued.
+            inline uint8_t size() const { return(count); }
+            inline bool isEmpty() const { return(0 == count); }
+            inline bool isFull() const { return(count >= depth); }
+
+            // Discard all queued frames.
+            inline void clear() { oldest = 0; count = 0; }
+
+            // Copy a frame into the queue; returns false if full or the frame is too long or empty.
+            // The power hint is stored opaquely, eg as an OTRadioLink::TXpower.
+            bool push(const uint8_t *const buf, const uint8_t buflen, const int8_t channel = 0, const uint8_t power = 0)
+                {
+                if((NULL == buf) || (0 == buflen) || (buflen > maxFrameLen) || isFull()) { return(false); }
+                memcpy(q[nextFree()].buf, buf, buflen);
+                return(commit(buflen, channel, power));
+                }
+
+            // Get the buffer (maxFrameLen bytes) of the next free slot
+            // so that a frame can be built in place, avoiding a copy; NULL if full.
+            // The frame is not queued until commit(),
+            // and a push() or commit() of another frame first overwrites it.
+            uint8_t *reserve()
+                {
+                if(isFull()) { return(NULL); }
+                return(q[nextFree()].buf);
+                }
+            // Queue the frame built in the buffer from reserve();
+            // returns false if full or the frame is too long or empty.
+            bool commit(const uint8_t buflen, const int8_t channel = 0, const uint8_t power = 0)
+                {
+                if((0 == buflen) || (buflen > maxFrameLen) || isFull()) { return(false); }
+                entry &e = q[nextFree()];
+                e.len = buflen;
+                e.channel = channel;
+                e.power = power;
+                ++count;
+                return(true);
+                }
+
+            // Peek at the oldest queued frame; returns NULL if none.
+            // Retrieves the frame length, channel and power hint.
+            // The pointer is valid until the next pop() or clear().
+            const uint8_t *peek(uint8_t &buflen, int8_t &channel, uint8_t &power) const
+                {
+                if(isEmpty()) { return(NULL); }
+                const entry &e = q[oldest];
+                buflen = e.len;
+                channel = e.channel;
+                power = e.power;
+                return(e.buf);
+                }
+
+            // Remove the oldest queued frame; does nothing if empty.
+            void pop()
+                {
+                if(isEmpty()) { return; }
+                if(++oldest >= depth) { oldest = 0; }
+                --count;
+                }
+        };
+
+    // Stub zero-depth queue that never holds a frame and uses no space for frames.
+    template<uint8_t maxFrameLen>
+    class TXQueue<0, maxFrameLen> final
+        {
+        public:
+            static constexpr uint8_t capacity = 0;
+            static constexpr uint8_t maxLen = maxFrameLen;
+            inline uint8_t size() const { return(0); }
+            inline bool isEmpty() const { return(true); }
+            inline bool isFull() const { return(true); }
+            inline void clear() { }
+            bool push(const uint8_t *, uint8_t, int8_t = 0, uint8_t = 0) { return(false); }
+            uint8_t *reserve() { return(NULL); }
+            bool commit(uint8_t, int8_t = 0, uint8_t = 0) { return(false); }
+            const uint8_t *peek(uint8_t &, int8_t &, uint8_t &) const { return(NULL); }
+            void pop() { }
+        };
+
+    // Out-of-line definitions of the static constants (needed by C++11 if ODR-used).
+    template<uint8_t depth, uint8_t maxFrameLen> constexpr uint8_t TXQueue<depth, maxFrameLen>::capacity;
+    template<uint8_t depth, uint8_t maxFrameLen> constexpr uint8_t TXQueue<depth, maxFrameLen>::maxLen;
+    template<uint8_t maxFrameLen> constexpr uint8_t TXQueue<0, maxFrameLen>::capacity;
+    template<uint8_t maxFrameLen> constexpr uint8_t TXQueue<0, maxFrameLen>::maxLen;
+    }
+
+#endif
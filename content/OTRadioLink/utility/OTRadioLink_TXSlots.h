@@ -0,0 +1,294 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Optional hub-coordinated TX time slots (TDMA-lite) for node stats.
+ *
+ * Nodes (eg valves) otherwise send stats at randomised times,
+ * so collisions at a hub grow with the number of nodes.
+ * Here the hub carries slot assignments in the body of its secure beacon
+ * (SimpleSecureFrame32or0BodyTXBase::generateSecureBeacon() with a body),
+ * and each node sends once per superframe in its own slot, timed from its RTC,
+ * so that nodes' transmissions do not overlap
+ * and a node need listen only briefly around the hub's beacon.
+ *
+ * The superframe is (nSlots + 1) slots of slotS seconds each:
+ * the first is reserved for the hub's beacon,
+ * and the node at association index i is assigned the slot starting at (i + 1) * slotS.
+ *
+ * Beacon body (all plaintext in the secure frame, so authenticated):
+ *   [0] TXSLOT_BEACON_FORMAT
+ *   [1] slotS: slot length, seconds; strictly positive
+ *   [2] nSlots: number of node slots; strictly positive
+ *   [3,4] phaseS: hub's seconds into the superframe when sent, big-endian;
+ *       less than the superframe length
+ *   [5] firstIndex: association index of the first entry
+ *   [6...] up to TXSLOT_BEACON_MAX_ENTRIES entries,
+ *       each the first TXSLOT_ID_PREFIX_BYTES bytes of the node ID
+ *       at association index firstIndex, firstIndex + 1, ...
+ * so with more nodes than fit in one beacon, successive beacons page through them.
+ *
+ * Portable; no dependency on the RTC, which supplies the caller's seconds clock.
+ */
+
+#ifndef ARDUINO_LIB_OTRADIOLINK_TXSLOTS_H
+#define ARDUINO_LIB_OTRADIOLINK_TXSLOTS_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "OTV0P2BASE_Security.h"
+#include "OTRadioLink_SecureableFrameType.h"
+
+// Use namespaces to help avoid collisions.
+namespace OTRadioLink
+    {
+    // First byte of a TX slot beacon body, to distinguish it from any other beacon body.
+    static constexpr uint8_t TXSLOT_BEACON_FORMAT = 0x54; // 'T'
+    // Bytes of header before the entries.
+    static constexpr uint8_t TXSLOT_BEACON_HEADER_BYTES = 6;
+    // Bytes of node ID prefix identifying each entry.
+    static constexpr uint8_t TXSLOT_ID_PREFIX_BYTES = 3;
+    // Maximum entries in one beacon.
+    static constexpr uint8_t TXSLOT_BEACON_MAX_ENTRIES = 8;
+    // Largest body, which must fit unpadded in a small secure frame.
+    static constexpr uint8_t TXSLOT_BEACON_MAX_BODY_BYTES =
+        TXSLOT_BEACON_HEADER_BYTES + (TXSLOT_BEACON_MAX_ENTRIES * TXSLOT_ID_PREFIX_BYTES);
+    static_assert(TXSLOT_BEACON_MAX_BODY_BYTES <= ENC_BODY_SMALL_FIXED_PTEXT_MAX_SIZE, "beacon body too large");
+
+    // Decoded (and validated) TX slot beacon body.
+    // The entries point into the body passed to decode(), so are only valid while it is.
+    struct TXSlotBeacon final
+        {
+        uint8_t slotS = 0;
+        uint8_t nSlots = 0;
+        uint16_t phaseS = 0;
+        uint8_t firstIndex = 0;
+        uint8_t nEntries = 0;
+        const uint8_t *entries = NULL;
+
+        // Superframe length, seconds, including the hub's beacon slot.
+        uint16_t getSuperframeS() const { return(uint16_t(slotS * (nSlots + 1U))); }
+
+        // Decode body of len bytes; returns false if not a valid TX slot beacon body.
+        bool decode(const uint8_t *const body, const uint8_t len)
+            {
+            if((NULL == body) || (len < TXSLOT_BEACON_HEADER_BYTES) || (len > TXSLOT_BEACON_MAX_BODY_BYTES)) { return(false); }
+            if(TXSLOT_BEACON_FORMAT != body[0]) { return(false); }
+            const uint8_t entryBytes = len - TXSLOT_BEACON_HEADER_BYTES;
+            if(0 != (entryBytes % TXSLOT_ID_PREFIX_BYTES)) { return(false); }
+            slotS = body[1];
+            nSlots = body[2];
+            phaseS = uint16_t((body[3] << 8) | body[4]);
+            firstIndex = body[5];
+            nEntries = entryBytes / TXSLOT_ID_PREFIX_BYTES;
+            entries = body + TXSLOT_BEACON_HEADER_BYTES;
+            if((0 == slotS) || (0 == nSlots)) { return(false); }
+            if(phaseS >= getSuperframeS()) { return(false); }
+            if(uint16_t(firstIndex + nEntries) > nSlots) { return(false); }
+            return(true);
+            }
+        };
+
+    // Hub side: builds successive TX slot beacon bodies from the node associations,
+    // paging through them TXSLOT_BEACON_MAX_ENTRIES at a time.
+    // One node slot is assigned per association, by index,
+    // so adding associations lengthens the superframe.
+    // The hub should send each beacon in its beacon slot
+    // (phase less than slotS, see isBeaconSlot()), where nodes listen for it.
+    // Not thread-/ISR- safe.
+    class TXSlotBeaconPager final
+        {
+        private:
+            const OTV0P2BASE::NodeAssociationTableBase &table;
+            const uint8_t slotS;
+            // Association index of the start of the next page.
+            uint8_t nextIndex = 0;
+
+        public:
+            //  * slotS  slot length, seconds; strictly positive, and long enough
+            //      for a node to notice and send in, eg 4 for nodes on a 2s cycle
+            TXSlotBeaconPager(const OTV0P2BASE::NodeAssociationTableBase &t, const uint8_t slotS_)
+              : table(t), slotS(slotS_) { }
+
+            // Superframe length, seconds, for nAssociations nodes; 0 if none.
+            uint16_t getSuperframeS(const uint8_t nAssociations) const
+                { return((0 == nAssociations) ? 0 : uint16_t(slotS * (nAssociations + 1U))); }
+            // Hub's seconds into the superframe at nowS; 0 if no nodes.
+            uint16_t getPhaseS(const uint8_t nAssociations, const uint32_t nowS) const
+                {
+                const uint16_t sf = getSuperframeS(nAssociations);
+                return((0 == sf) ? 0 : uint16_t(nowS % sf));
+                }
+            // True if nowS is in the hub's beacon slot.
+            bool isBeaconSlot(const uint8_t nAssociations, const uint32_t nowS) const
+                { return((0 != nAssociations) && (getPhaseS(nAssociations, nowS) < slotS)); }
+            // Association index whose slot contains nowS, or -1 if in the beacon slot or no nodes.
+            int16_t getSlotAt(const uint8_t nAssociations, const uint32_t nowS) const
+                {
+                if((0 == nAssociations) || (0 == slotS)) { return(-1); }
+                return(int16_t(getPhaseS(nAssociations, nowS) / slotS) - 1);
+                }
+
+            // Writes the next page of assignments for associations [0, nAssociations) to buf,
+            // stamped with the hub's superframe phase at nowS.
+            // Returns the body length, or 0 on error (no associations, buf too small).
+            //  * buflen  at least TXSLOT_BEACON_MAX_BODY_BYTES
+            uint8_t nextPage(uint8_t *const buf, const uint8_t buflen, const uint8_t nAssociations, const uint32_t nowS)
+                {
+                if((NULL == buf) || (buflen < TXSLOT_BEACON_MAX_BODY_BYTES) || (0 == nAssociations) || (0 == slotS)) { return(0); }
+                if(nextIndex >= nAssociations) { nextIndex = 0; }
+                const uint16_t phase = getPhaseS(nAssociations, nowS);
+                buf[0] = TXSLOT_BEACON_FORMAT;
+                buf[1] = slotS;
+                buf[2] = nAssociations;
+                buf[3] = uint8_t(phase >> 8);
+                buf[4] = uint8_t(phase);
+                buf[5] = nextIndex;
+                uint8_t n = nAssociations - nextIndex;
+                if(n > TXSLOT_BEACON_MAX_ENTRIES) { n = TXSLOT_BEACON_MAX_ENTRIES; }
+                uint8_t id[OTV0P2BASE::OpenTRV_Node_ID_Bytes];
+                for(uint8_t i = 0; i < n; ++i)
+                    {
+                    table.get(nextIndex + i, id);
+                    memcpy(buf + TXSLOT_BEACON_HEADER_BYTES + (i * TXSLOT_ID_PREFIX_BYTES), id, TXSLOT_ID_PREFIX_BYTES);
+                    }
+                nextIndex += n;
+                return(TXSLOT_BEACON_HEADER_BYTES + (n * TXSLOT_ID_PREFIX_BYTES));
+                }
+        };
+
+    // Node side: learns this node's slot and the hub's superframe timing from beacons,
+    // then says when to send, once per superframe, in that slot.
+    // Time is any free-running seconds clock, eg from the RTC:
+    // days * 86400 + minutes * 60 + seconds.
+    // Until a beacon assigns a slot, or after a few superframes with no beacon
+    // (so clock drift may have taken the node out of its slot),
+    // isSynced() is false and the caller should fall back to its randomised TX timing.
+    // Not thread-/ISR- safe.
+    class TXSlotClient final
+        {
+        public:
+            // Superframes without a beacon before the timing is abandoned.
+            static constexpr uint8_t MAX_MISSED_SUPERFRAMES = 4;
+
+        private:
+            // Timing from the last beacon; slotS is 0 if none.
+            uint8_t slotS = 0;
+            uint8_t nSlots = 0;
+            // Local time at which a superframe started.
+            uint32_t anchorS = 0;
+            // Local time of the last beacon.
+            uint32_t lastBeaconS = 0;
+            // This node's slot, if haveSlot.
+            bool haveSlot = false;
+            uint8_t mySlot = 0;
+            // Local time of the last send, if haveSent.
+            bool haveSent = false;
+            uint32_t lastSentS = 0;
+
+            uint16_t superframeS() const { return(uint16_t(slotS * (nSlots + 1U))); }
+            // Guard each end of the slot against clock drift and beacon jitter.
+            uint8_t guardS() const { return((slotS >= 4) ? 1 : 0); }
+            bool haveTiming(const uint32_t nowS) const
+                { return((0 != slotS) && ((nowS - lastBeaconS) <= uint32_t(MAX_MISSED_SUPERFRAMES) * superframeS())); }
+
+        public:
+            // Forget all timing and the slot.
+            void reset() { slotS = 0; nSlots = 0; haveSlot = false; haveSent = false; }
+
+            // Process the body of an authenticated beacon from this node's hub received at nowS.
+            // Returns false if the body is not a valid TX slot beacon, else true.
+            //  * id  this node's ID, at least TXSLOT_ID_PREFIX_BYTES bytes; never NULL
+            bool onBeacon(const uint8_t *const body, const uint8_t len, const uint8_t *const id, const uint32_t nowS)
+                {
+                TXSlotBeacon b;
+                if(!b.decode(body, len)) { return(false); }
+                // A change of shape invalidates any slot.
+                if((b.slotS != slotS) || (b.nSlots != nSlots)) { haveSlot = false; }
+                slotS = b.slotS;
+                nSlots = b.nSlots;
+                anchorS = nowS - b.phaseS;
+                lastBeaconS = nowS;
+                // Find this node in the page, or learn its old slot has been reassigned.
+                for(uint8_t i = 0; i < b.nEntries; ++i)
+                    {
+                    const uint8_t slot = b.firstIndex + i;
+                    const bool isMe = (0 == memcmp(b.entries + (i * TXSLOT_ID_PREFIX_BYTES), id, TXSLOT_ID_PREFIX_BYTES));
+                    if(isMe) { haveSlot = true; mySlot = slot; }
+                    else if(haveSlot && (slot == mySlot)) { haveSlot = false; }
+                    }
+                return(true);
+                }
+
+            // True if this node has a slot and recent timing, so should use txDue().
+            bool isSynced(const uint32_t nowS) const { return(haveSlot && haveTiming(nowS)); }
+            // This node's slot (association index) if it has one, else -1.
+            int16_t getSlot() const { return(haveSlot ? int16_t(mySlot) : -1); }
+
+            // Seconds from nowS into the current superframe; 0 if no timing.
+            uint16_t getPhaseS(const uint32_t nowS) const
+                { return((0 == slotS) ? 0 : uint16_t((nowS - anchorS) % superframeS())); }
+            // True if nowS is in the hub's beacon slot given recent timing,
+            // so that the node can keep its receiver on only then.
+            bool isBeaconSlot(const uint32_t nowS) const
+                { return(haveTiming(nowS) && (getPhaseS(nowS) < slotS)); }
+            // Seconds from nowS to the start of the next beacon slot (0 if in one),
+            // eg to wake the receiver just in time; 0xffff if no timing.
+            uint16_t secondsUntilBeaconSlot(const uint32_t nowS) const
+                {
+                if(!haveTiming(nowS)) { return(0xffff); }
+                const uint16_t phase = getPhaseS(nowS);
+                return((phase < slotS) ? 0 : uint16_t(superframeS() - phase));
+                }
+            // True if nowS is in the usable part of this node's slot.
+            bool isInSlot(const uint32_t nowS) const
+                {
+                if(!isSynced(nowS)) { return(false); }
+                const uint16_t start = uint16_t((mySlot + 1U) * slotS) + guardS();
+                const uint16_t phase = getPhaseS(nowS);
+                return((phase >= start) && (phase < start + slotS - (2 * guardS())));
+                }
+            // Seconds from nowS to the usable part of this node's next slot (0 if in it);
+            // 0xffff if not synced.
+            uint16_t secondsUntilSlot(const uint32_t nowS) const
+                {
+                if(!isSynced(nowS)) { return(0xffff); }
+                if(isInSlot(nowS)) { return(0); }
+                const uint16_t start = uint16_t((mySlot + 1U) * slotS) + guardS();
+                const uint16_t phase = getPhaseS(nowS);
+                return((phase < start) ? uint16_t(start - phase) : uint16_t(superframeS() - phase + start));
+                }
+
+            // True at most once per superframe, when nowS is in this node's slot:
+            // the caller should send its stats now.
+            // Always false if not synced, when the caller should use its own timing instead.
+            // The caller must poll at least once per (slotS - 2) seconds to see each slot.
+            bool txDue(const uint32_t nowS)
+                {
+                if(!isInSlot(nowS)) { return(false); }
+                // Still in the slot sent in, even if re-anchored since.
+                if(haveSent && ((nowS - lastSentS) < slotS)) { return(false); }
+                haveSent = true;
+                lastSentS = nowS;
+                return(true);
+                }
+        };
+    }
+
+#endif
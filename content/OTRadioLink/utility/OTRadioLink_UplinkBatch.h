@@ -0,0 +1,152 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2018
+*/
+
+/*
+ * Hub-side batching of frames from several nodes into one uplink message,
+ * eg for cellular (SIM900) or LoRa (RN2483) links priced or rate-limited per message.
+ */
+
+#ifndef ARDUINO_LIB_OTRADIOLINK_UPLINKBATCH_H
+#define ARDUINO_LIB_OTRADIOLINK_UPLINKBATCH_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "OTV0P2BASE_Security.h"
+#include "OTRadioLink_OTRadioLink.h"
+
+// Use namespaces to help avoid collisions.
+namespace OTRadioLink
+    {
+    // Collects recent frames from several nodes and sends them as one uplink message.
+    // The message is the frames concatenated, oldest first, each preceded by its length byte,
+    // ie each record is a length byte then the frame as it would otherwise be relayed,
+    // so the records are self-delimiting.
+    // At most one frame is kept per node: a newer frame from the same node replaces the older,
+    // since only the latest stats from each are of interest.
+    // The batch is sent:
+    //   * when a new frame would not fit (by bytes or by number of nodes), before adding it;
+    //   * from tick() once the oldest frame held is maxAgeTicks old.
+    // Template parameters:
+    //   * capacity  maximum uplink message size in bytes,
+    //       no more than the uplink's maximum TX message length
+    //   * maxNodes  maximum number of frames (nodes) in one message; strictly positive
+    //   * maxAgeTicks  number of tick() calls after the first frame is added
+    //       before the batch is sent anyway; strictly positive
+    // Not thread-/ISR- safe.
+    template<uint8_t capacity, uint8_t maxNodes, uint8_t maxAgeTicks>
+    class OTUplinkBatch final
+        {
+        static_assert(capacity >= 2, "capacity too small");
+        static_assert(maxNodes > 0, "must allow at least one node");
+        static_assert(maxAgeTicks > 0, "maximum age must be strictly positive");
+
+        public:
+            // Bytes of node ID used to match frames from the same node.
+            static constexpr uint8_t idBytes = OTV0P2BASE::OpenTRV_Node_ID_Bytes;
+
+        private:
+            // Uplink to send batches on.
+            OTRadioLink &uplink;
+            // Records, oldest first.
+            uint8_t buf[capacity];
+            // Bytes of buf used.
+            uint8_t used = 0;
+            // Node IDs of the records in buf, in the same order.
+            uint8_t ids[maxNodes][idBytes];
+            // Number of records in buf.
+            uint8_t nNodes = 0;
+            // Ticks since the oldest record was added.
+            uint8_t age = 0;
+
+            // Offset in buf of record i.
+            uint8_t offsetOf(const uint8_t i) const
+                {
+                uint8_t off = 0;
+                for(uint8_t j = 0; j < i; ++j) { off += 1 + buf[off]; }
+                return(off);
+                }
+            // Remove record i, closing up the gap.
+            void removeRecord(const uint8_t i)
+                {
+                const uint8_t off = offsetOf(i);
+                const uint8_t rl = 1 + buf[off];
+                memmove(buf + off, buf + off + rl, used - off - rl);
+                used -= rl;
+                memmove(ids[i], ids[i+1], (nNodes - i - 1) * idBytes);
+                --nNodes;
+                }
+
+        public:
+            explicit OTUplinkBatch(OTRadioLink &_uplink) : uplink(_uplink) { }
+
+            // Number of frames (nodes) held.
+            uint8_t size() const { return(nNodes); }
+            // Bytes in the message that would be sent now.
+            uint8_t bytes() const { return(used); }
+            // True if nothing is held.
+            bool isEmpty() const { return(0 == nNodes); }
+
+            // Get the pending message (size bytes()); valid until the next change.
+            const uint8_t *getMessage() const { return(buf); }
+
+            // Add a frame from the given node (idBytes of ID, eg OTDecodeData_T::id),
+            // as len bytes from frame, replacing any held from the same node.
+            // Sends the batch first if the frame would not otherwise fit.
+            // Returns false if the frame could never fit (or any argument is invalid).
+            bool add(const uint8_t *const id, const uint8_t *const frame, const uint8_t len)
+                {
+                if((NULL == id) || (NULL == frame) || (0 == len) || (len >= capacity)) { return(false); } // FAIL
+                // Drop any older frame from this node.
+                for(uint8_t i = 0; i < nNodes; ++i)
+                    { if(0 == memcmp(ids[i], id, idBytes)) { removeRecord(i); break; } }
+                if((nNodes >= maxNodes) || ((uint16_t)used + 1 + len > capacity)) { flush(); }
+                if(0 == nNodes) { age = 0; }
+                buf[used] = len;
+                memcpy(buf + used + 1, frame, len);
+                used += 1 + len;
+                memcpy(ids[nNodes++], id, idBytes);
+                return(true);
+                }
+
+            // Send whatever is held, if anything, and clear it.
+            // Returns true if there was nothing to send or it was queued to send.
+            bool flush()
+                {
+                if(0 == nNodes) { return(true); }
+                const bool ok = uplink.queueToSend(buf, used);
+                used = 0;
+                nNodes = 0;
+                age = 0;
+                return(ok);
+                }
+
+            // Call regularly, eg once per minute or major cycle, to send batches once old enough.
+            // Returns true if a batch was sent.
+            bool tick()
+                {
+                if(0 == nNodes) { return(false); }
+                if(++age < maxAgeTicks) { return(false); }
+                flush();
+                return(true);
+                }
+        };
+
+    }
+
+#endif
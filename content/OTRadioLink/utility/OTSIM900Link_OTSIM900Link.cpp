@@ -46,6 +46,7 @@ V0p2_SIM900_AT_DEFN(AT_SEND_UDP, "+CIPSEND");
 V0p2_SIM900_AT_DEFN(AT_CLOSE_UDP, "+CIPCLOSE");
 V0p2_SIM900_AT_DEFN(AT_SHUT_GPRS, "+CIPSHUT");
 V0p2_SIM900_AT_DEFN(AT_VERBOSE_ERRORS, "+CMEE");
+V0p2_SIM900_AT_DEFN(AT_SLEEP_MODE, "+CSCLK"); // Low-power sleep control.
 
 
 } // OTSIM900Link
@@ -44,13 +44,6 @@
 // If DEFINED: Prints debug information to serial.
 //             !!! WARNING! THIS WILL CAUSE BLOCKING OF OVER 300 MS!!!
 #undef OTSIM900LINK_DEBUG
-// IF DEFINED:  Splits the send routine into two steps, rather than polling for a prompt.
-//              Should be avoided if possible, but may be necessary e.g. with the REV10 as
-//              the blocking poll may overrun a sub-cycle, triggering a WDT reset.
-//              This behaviour depends on the fact that the V0p2 cycle takes long enough
-//              between polls for the SIM900 to be ready to receive a packet, but not
-//              long enough to time out the send routine. // XXX
-#define OTSIM900LINK_SPLIT_SEND_TEST
 // IF DEFINED:  Flush until a fixed point in the sub-cycle. Note that this requires
 //              OTV0P2BASE::getSubCycleTime or equivalent to be passed in as a template param.
 //              May perform poorer/send junk in some circumstances (untested)
@@ -171,7 +164,188 @@ namespace OTSIM900Link
         INIT_SEND,
         WRITE_PACKET,
         RESET,
-        PANIC
+        PANIC,
+        // Connected-sleep only.
+        ENABLE_SLEEP,
+        WAKE
+        };
+
+    /**
+     * @brief   Tokens watched for in every SIM900 response, as bits of a mask.
+     *          Tokens ending in ':' introduce numeric fields, eg "+CREG: 0,5".
+     */
+    namespace SIM900Token
+        {
+        static constexpr uint8_t OK = 1;
+        static constexpr uint8_t ERROR = 2;
+        static constexpr uint8_t PROMPT = 4; // '>' when ready for a CIPSEND payload.
+        static constexpr uint8_t SEND_OK = 8;
+        static constexpr uint8_t SHUT_OK = 16;
+        static constexpr uint8_t CONNECT_OK = 32;
+        static constexpr uint8_t CREG = 64;
+        static constexpr uint8_t CSQ = 128;
+        static constexpr uint8_t count = 8;
+        // Text of token number i (bit 1<<i).
+        inline const char *text(const uint8_t i)
+            {
+            switch(i)
+                {
+                case 0: return("OK");
+                case 1: return("ERROR");
+                case 2: return(">");
+                case 3: return("SEND OK");
+                case 4: return("SHUT OK");
+                case 5: return("CONNECT OK");
+                case 6: return("+CREG:");
+                default: return("+CSQ:");
+                }
+            }
+        /**
+         * @brief   One step of a KMP-style match of pattern, given m chars already matched.
+         *          Falls back to the longest matched suffix that is also a prefix,
+         *          so overlapping partial matches are not lost.
+         *          Patterns are short so the fallback is computed directly rather than tabulated.
+         * @retval  Number of chars matched including c; strlen(pattern) on a full match.
+         */
+        inline uint8_t step(const char *const pattern, uint8_t m, const char c)
+            {
+            for( ; ; )
+                {
+                if(c == pattern[m]) { return(uint8_t(m + 1)); }
+                if(0 == m) { return(0); }
+                // Longest proper border of pattern[0..m).
+                uint8_t k = uint8_t(m - 1);
+                while((k > 0) && (0 != memcmp(pattern, pattern + (m - k), k))) { --k; }
+                m = k;
+                }
+            }
+        }
+
+    /**
+     * @brief   Incremental matcher for SIM900 AT command responses.
+     *          Characters are fed in as they arrive, possibly over several calls to poll(),
+     *          and the first bufSize of them are kept (zero-padded) for parsing;
+     *          the rest are discarded.
+     *          All the SIM900Token tokens are matched in parallel as chars arrive,
+     *          and up to maxFields comma-separated numbers after a field token
+     *          (the last such in the response) are parsed on the fly,
+     *          so the response need not be rescanned.
+     *          The caller regards the response as complete when the expected terminator
+     *          or one of the expected tokens is seen,
+     *          or when the line goes quiet after some data has arrived.
+     */
+    template<uint8_t bufSize>
+    class SIM900ResponseMatcher final
+        {
+        public:
+            // Maximum numeric fields parsed after a field token.
+            static constexpr uint8_t maxFields = 3;
+
+        private:
+            char buf[bufSize] = {};
+            // Number of chars stored in buf.
+            uint8_t len = 0;
+            // Terminator to look for; NULL if none.
+            const char *terminator = NULL;
+            // Number of leading chars of terminator currently matched.
+            uint8_t matched = 0;
+            // Tokens whose sighting completes the response.
+            uint8_t doneTokens = 0;
+            // True once terminator or a done token has been seen.
+            bool found = false;
+            // Tokens seen, and number of leading chars of each currently matched.
+            uint8_t seen = 0;
+            uint8_t tokMatched[SIM900Token::count] = {};
+            // Numeric fields after the last field token, and how many have started.
+            uint8_t fields[maxFields] = {};
+            uint8_t nFields = 0;
+            // True while parsing fields; fieldPending when a ',' (or the token) awaits the next.
+            bool inFields = false;
+            bool fieldPending = false;
+
+            void feedFields(const char c)
+                {
+                if(!inFields) { return; }
+                if((c >= '0') && (c <= '9'))
+                    {
+                    if(fieldPending)
+                        {
+                        if(nFields >= maxFields) { inFields = false; return; }
+                        fields[nFields++] = 0;
+                        fieldPending = false;
+                        }
+                    uint8_t &v = fields[nFields - 1];
+                    const uint16_t nv = uint16_t(v * 10U + uint8_t(c - '0'));
+                    v = (nv > 255) ? 255 : uint8_t(nv);
+                    }
+                else if(',' == c) { if(fieldPending) { inFields = false; } else { fieldPending = true; } }
+                else if((' ' == c) && fieldPending && (0 == nFields)) { } // Space after the token.
+                else { inFields = false; }
+                }
+
+        public:
+            /**
+             * @brief   Start collecting a new response.
+             * @param   expect: \0-terminated terminator to look for, or NULL to match nothing.
+             * @param   done: mask of SIM900Token tokens that also complete the response.
+             */
+            void start(const char *const expect, const uint8_t done = 0)
+                {
+                memset(buf, 0, sizeof(buf));
+                len = 0;
+                terminator = expect;
+                matched = 0;
+                doneTokens = done;
+                found = false;
+                seen = 0;
+                memset(tokMatched, 0, sizeof(tokMatched));
+                nFields = 0;
+                inFields = false;
+                fieldPending = false;
+                }
+            /**
+             * @brief   Add a received character.
+             * @retval  True once the terminator or a done token has been seen (including with this char).
+             */
+            bool feed(const char c)
+                {
+                if(len < bufSize) { buf[len++] = c; }
+                feedFields(c);
+                for(uint8_t i = 0; i < SIM900Token::count; ++i)
+                    {
+                    const char *const t = SIM900Token::text(i);
+                    tokMatched[i] = SIM900Token::step(t, tokMatched[i], c);
+                    if('\0' != t[tokMatched[i]]) { continue; }
+                    tokMatched[i] = 0;
+                    const uint8_t bit = uint8_t(1U << i);
+                    seen |= bit;
+                    if(0 != (doneTokens & bit)) { found = true; }
+                    if(':' == c)
+                        {
+                        // Field token: parse the numbers that follow.
+                        nFields = 0;
+                        inFields = true;
+                        fieldPending = true;
+                        }
+                    }
+                if(found || (NULL == terminator)) { return(found); }
+                matched = SIM900Token::step(terminator, matched, c);
+                if('\0' == terminator[matched]) { found = true; }
+                return(found);
+                }
+            // True if the terminator or a done token has been seen.
+            bool isFound() const { return(found); }
+            // True if any of the given SIM900Token tokens has been seen.
+            bool hasSeen(const uint8_t tokens) const { return(0 != (seen & tokens)); }
+            // Number of numeric fields parsed after the last field token, and field i of them.
+            uint8_t fieldCount() const { return(nFields); }
+            uint8_t field(const uint8_t i) const { return((i < nFields) ? fields[i] : 0); }
+            // Response chars stored, zero-padded to bufSize.
+            const char *data() const { return(buf); }
+            // Number of chars stored.
+            uint8_t size() const { return(len); }
+            // Size of the buffer returned by data().
+            static constexpr uint8_t capacity() { return(bufSize); }
         };
 
     // Includes string constants.
@@ -209,6 +383,7 @@ typedef const char *AT_t;
             static AT_t AT_CLOSE_UDP;
             static AT_t AT_SHUT_GPRS;
             static AT_t AT_VERBOSE_ERRORS;
+            static AT_t AT_SLEEP_MODE;
 
             // Single characters.
             static constexpr char ATc_GET_MODULE = 'I';
@@ -222,9 +397,15 @@ typedef const char *AT_t;
 
     /**
      * @note    To enable serial debug define 'OTSIM900LINK_DEBUG'
-     * @todo    SIM900 has a low power state which stays connected to network
-     *             - Not sure how much power reduced
-     *             - If not sending often may be more efficient to power up and wait for connect each time
+     * @note    With setConnectedSleep(true) the SIM900 is put in its serial-idle sleep mode
+     *          (AT+CSCLK=2) once the UDP socket is open, keeping the network registration,
+     *          PDP context and socket, so each send needs only a wake and AT+CIPSEND.
+     *          The connection is checked every connectedSleepKeepAliveMinutes while idle
+     *          and, if the socket or GPRS context has been dropped, reopened without re-registering.
+     *          If not sending often it may still be more efficient to power down between sends.
+     * @param   txQueueDepth  maximum number of frames held for sending, eg while GPRS is coming up [1,255];
+     *                        when full the oldest frame is dropped to make room, so the freshest are kept.
+     *                        Each extra entry costs 67 bytes of RAM.
      */
 #define OTSIM900Link_DEFINED
     template<uint8_t rxPin, uint8_t txPin, uint8_t PWR_PIN,
@@ -233,6 +414,7 @@ typedef const char *AT_t;
 #ifdef OTSoftSerial2_DEFINED
         = OTV0P2BASE::OTSoftSerial2<rxPin, txPin, OTSIM900LinkBase::SIM900_MAX_baud>
 #endif // OTSoftSerial2_DEFINED
+    , uint8_t txQueueDepth = 1
     >
     class OTSIM900Link final : public OTSIM900LinkBase
         {
@@ -276,11 +458,12 @@ typedef const char *AT_t;
              * Cannot do anything with side-effects,
              * as may be called before run-time is fully initialised.
              */
-            constexpr OTSIM900Link() : oldState(INIT) { /* memset(txQueue, 0, sizeof(txQueue)); */ }
+            constexpr OTSIM900Link() : oldState(INIT) { }
 
             /************************* Public Methods *****************************/
             /**
              * @brief    Starts software serial, checks for module and inits state machine.
+             *           Discards any queued frames; they are otherwise kept across a RESET.
              */
             virtual bool begin() override
                 {
@@ -289,6 +472,8 @@ typedef const char *AT_t;
 #endif
                 setPwrPinHigh(false);
                 ser.begin(0);
+                buildATCache();
+                txQueue.clear();
                 state = INIT;
                 return true;
                 }
@@ -335,6 +520,9 @@ typedef const char *AT_t;
 
             /**
              * @brief   Puts message in queue to send on wakeup.
+             *          Frames are accepted in any state, eg while still registering or starting GPRS,
+             *          and are all sent (oldest first) once the UDP connection is up.
+             *          If the queue is full the oldest frame is dropped, ensuring the freshest are sent.
              * @param   buf     pointer to buffer to send.
              * @param   buflen  length of buffer to send.
              * @param   channel ignored.
@@ -345,18 +533,25 @@ typedef const char *AT_t;
             virtual bool queueToSend(const uint8_t *buf, uint8_t buflen, int8_t /*channel*/ = 0,
                     TXpower = TXnormal) override
                 {
-                if ((buf == NULL) || (buflen > sizeof(txQueue)))
-                    return false;    //
-//        if ((buf == NULL) || (buflen > sizeof(txQueue)) || (txMessageQueue >= maxTxQueueLength)) return false;    //
-//        // Increment message queue
-//        txMessageQueue++; //
-                    // copy into queue here?
-                txMessageQueue = 1;
-                memcpy(txQueue, buf, buflen); // Last message queued is copied to buffer, ensuring freshest message is sent.
-                txMsgLen = buflen;
-                return true;
+                if ((buf == NULL) || (0 == buflen) || (buflen > maxTxMsgLen))
+                    return false;
+                if (txQueue.isFull()) txQueue.pop();
+                return(txQueue.push(buf, buflen));
                 }
 
+            // Number of frames waiting to be sent.
+            uint8_t getTXMsgsQueued() const { return(txQueue.size()); }
+
+            /**
+             * @brief   Select connected-sleep (rather than always-awake) idling.
+             *          Takes effect when the UDP socket is next opened.
+             *          Disabling takes effect immediately,
+             *          though a module already asleep stays so until next sent to.
+             */
+            void setConnectedSleep(const bool enable) { connectedSleepWanted = enable; if(!enable) { sleepEnabled = false; } }
+            // True if the SIM900 has been put in connected-sleep mode and is idling in it.
+            bool isInConnectedSleep() const { return(sleepEnabled); }
+
             // Returns true if radio is present, independent of its power state.
             virtual bool isAvailable() const override { return(bAvailable); }
 
@@ -380,16 +575,17 @@ typedef const char *AT_t;
                     switch (state) {
                     case INIT:
                         OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING("*INIT")
-                        memset(txQueue, 0, sizeof(txQueue));
                         messageCounter = 0;
                         retryTimer = -1;
-                        txMsgLen = 0;
-                        txMessageQueue = 0;
                         bAvailable = false;
+                        atPending = ATC_NONE;
+                        startGPRSNext = false;
+                        sleepEnabled = false;
                         state = GET_STATE;
                         break;
-                    case GET_STATE: // Check SIM900 is present and can be talked to. Takes up to 220 ticks?
+                    case GET_STATE: // Check SIM900 is present and can be talked to.
                         OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING("*GET_STATE")
+                        if (!atStep(ATC_PING)) break;  // Still collecting the reply.
                         if (isSIM900Replying()) {
                             bAvailable = true;
                         }
@@ -408,32 +604,36 @@ typedef const char *AT_t;
                         OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING("*WAIT_PWR_LOW")
                         if (waitedLongEnough(powerTimer, powerLockOutDuration)) state = START_UP;
                         break;
-                    case START_UP: // takes up to 150 ticks
+                    case START_UP:
                         OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING("*WAIT_FOR_REPLY")
+                        if (!atStep(ATC_PING)) break;
                         if (isSIM900Replying()) {
                             state = CHECK_PIN;
                         } else {
                             state = GET_STATE;
                         }
                         break;
-                    case CHECK_PIN: // Set pin if required. Takes ~100 ticks to exit.
+                    case CHECK_PIN: // Set pin if required.
                         OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING("*CHECK_PIN")
+                        if (!atStep(ATC_PIN_QUERY)) break;
                         if (isPINRequired()) {
                             state = WAIT_FOR_REGISTRATION;
                         }
                         setRetryLock();
                         //                if(setPIN()) state = PANIC;// TODO make sure setPin returns true or false
                         break;
-                    case WAIT_FOR_REGISTRATION: // Wait for registration to GSM network. Stuck in this state until success. Takes ~150 ticks to exit.
+                    case WAIT_FOR_REGISTRATION: // Wait for registration to GSM network. Stuck in this state until success.
                         OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING("*WAIT_FOR_REG")
+                        if (!atStep(ATC_REGISTRATION)) break;
                         if (isRegistered()) {
                             state = SET_APN;
                         }
                         setRetryLock();
                         break;
-                    case SET_APN: // Attempt to set the APN. Stuck in this state until success. Takes up to 200 ticks to exit.
+                    case SET_APN: // Attempt to set the APN. Stuck in this state until success.
                         OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING("*SET_APN")
-                        if (setAPN()) {
+                        if (!atStep(ATC_SET_APN)) break;
+                        if (isAPNSet()) {
                             messageCounter = 0;
                             state = START_GPRS;
                         }
@@ -441,46 +641,84 @@ typedef const char *AT_t;
                         break;
                     case START_GPRS:  // Start GPRS context.
                         OTSIM900LINK_DEBUG_SERIAL_PRINTLN("*START_GPRS")
+                        // Check the status, and if GPRS is shut start it on the next poll.
+                        if (startGPRSNext) {
+                            if (!atStep(ATC_START_GPRS)) break;
+                            startGPRSNext = false;
+                            setRetryLock();
+                            break;
+                        }
+                        if (!atStep(ATC_STATUS)) break;
                         {
                             uint8_t udpState = checkUDPStatus();
                             if (3 == udpState) {  // GPRS active, UDP shut.
                                 state = GET_IP;
+                                setRetryLock();
                             } else if(0 == udpState) {  // GPRS shut.
-                                startGPRS();
+                                startGPRSNext = true;
+                            } else {
+                                setRetryLock();
                             }
-                            setRetryLock();
                         }
 //                          if(!startGPRS()) state = GET_IP;  // TODO: Add retries, Option to shut GPRS here (probably needs a new state)
                         // FIXME 20160505: Need to work out how to handle this. If signal is marginal this will fail.
                         break;
-                    case GET_IP: // Takes up to 200 ticks to exit.
+                    case GET_IP:
                         // For some reason, AT+CIFSR must done to be able to do any networking.
                         // It is the way recommended in SIM900_Appication_Note.pdf section 3: Single Connections.
                         // This was not necessary when opening and shutting GPRS as in OTSIM900Link v1.0
                         OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING("*GET IP")
-                        getIP();
+                        if (!atStep(ATC_GET_IP)) break;
                         state = OPEN_UDP;
                         break;
-                    case OPEN_UDP: // Open a udp socket. Takes ~200 ticks to exit.
+                    case OPEN_UDP: // Open a udp socket.
                         OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING("*OPEN UDP")
-                        if (openUDPSocket()) {
-                            state = IDLE;
+                        if (!atStep(ATC_START_UDP)) break;
+                        if (isUDPSocketOpen()) {
+                            state = connectedSleepWanted ? ENABLE_SLEEP : IDLE;
                         }
                         setRetryLock();
                         break;
+                    case ENABLE_SLEEP: // Let the SIM900 sleep while the serial line is idle.
+                        OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING("*ENABLE_SLEEP")
+                        if (!atStep(ATC_SLEEP)) break;
+                        // If refused, carry on without sleeping.
+                        sleepEnabled = response.hasSeen(SIM900Token::OK);
+                        idleMinutes = 0;
+                        idleLastSeconds = getCurrentSeconds();
+                        state = IDLE;
+                        break;
                     case IDLE:  // Waiting for outbound message.
-                        if (txMessageQueue > 0) { // If message is queued, go to WAIT_FOR_UDP
-                            state = WAIT_FOR_UDP;
+                        if (!txQueue.isEmpty()) { // If message is queued, go to WAIT_FOR_UDP
+                            state = sleepEnabled ? WAKE : WAIT_FOR_UDP;
+                        } else if (sleepEnabled) {
+                            // Count whole minutes idle from the seconds wrapping,
+                            // and periodically check that the connection is still up.
+                            const uint8_t s = getCurrentSeconds();
+                            if (s < idleLastSeconds) { ++idleMinutes; }
+                            idleLastSeconds = s;
+                            if (idleMinutes >= connectedSleepKeepAliveMinutes) { state = WAKE; }
                         }
                         break;
-                    case WAIT_FOR_UDP: // Make sure UDP context is open. Takes up to 200 ticks to exit.
+                    case WAKE: // Wake the SIM900, which drops what it is sent while asleep.
+                        OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING("*WAKE")
+                        if (!atStep(ATC_PING)) break;
+                        idleMinutes = 0;
+                        idleLastSeconds = getCurrentSeconds();
+                        state = WAIT_FOR_UDP;
+                        break;
+                    case WAIT_FOR_UDP: // Make sure UDP context is open.
                         OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING("*WAIT_FOR_UDP")
+                        if (!atStep(ATC_STATUS)) break;
                         {
                             uint8_t udpState = checkUDPStatus();
                             if (udpState == 1) {  // UDP connected
                                 state = INIT_SEND;
                             }
-//                            else if (udpState == 0) state = GET_STATE; // START_GPRS; // TODO needed for optional wake GPRS to send.
+                            // After a long connected sleep the network may have dropped the socket or context:
+                            // reopen them without re-registering.
+                            else if (sleepEnabled && (udpState == 3)) { sleepEnabled = false; state = GET_IP; }
+                            else if (sleepEnabled && (udpState == 0)) { sleepEnabled = false; state = START_GPRS; }
                             else if (udpState == 2) {  // Dead end. SIM900 needs resetting.
                                 state = RESET;
                             } else {
@@ -488,32 +726,27 @@ typedef const char *AT_t;
                             }
                         }
                         break;
-#if !defined(OTSIM900LINK_SPLIT_SEND_TEST)  // FIXME DE20170825: test this branch still works
-                    case INIT_SEND: // Attempt to send a message. Takes ~100 ticks to exit.
-                        OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING("*SENDING")
-                        if (0 < txMessageQueue) { // Check to make sure it is near the start of the subcycle to avoid overrunning.
-                            // TODO logic to check if send attempt successful
-                            sendRaw(txQueue, txMsgLen); /// @note can't use strlen with encrypted/binary packets
-                            --txMessageQueue;
-                        }
-                        if (0 == txMessageQueue) state = IDLE;
-                        break;
-#else // OTSIM900LINK_SPLIT_SEND_TEST
-                    case INIT_SEND: // Attempt to send a message. Takes ~100 ticks to exit.
+                    case INIT_SEND: // Attempt to send the oldest queued message; repeats until all are sent.
                         OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING("*SENDING")
-                        if(!isSIM900Replying()) state = RESET;
-                        if (0 < txMessageQueue) { // Check that we have a message queued
-                            // TODO logic to check if send attempt successful
-                            initUDPSend(txMsgLen); /// @note can't use strlen with encrypted/binary packets
+                        if (txQueue.isEmpty()) { state = IDLE; break; }
+                        // Request a send and wait (over as many polls as needed) for the '>' prompt.
+                        if (!atStep(ATC_SEND_UDP)) break;
+                        if (response.hasSeen(SIM900Token::PROMPT)) {
                             state = WRITE_PACKET;
-                        } else { state = IDLE; }
+                        } else {
+                            setRetryLock();
+                        }
                         break;
                     case WRITE_PACKET:
-                        --txMessageQueue;
-                        UDPSend((const char *) txQueue, txMsgLen);
+                        {
+                            uint8_t len, power;
+                            int8_t channel;
+                            const uint8_t *const frame = txQueue.peek(len, channel, power);
+                            if (NULL != frame) UDPSend((const char *) frame, len);
+                            txQueue.pop();
+                        }
                         state = INIT_SEND;
                         break;
-#endif // OTSIM900LINK_SPLIT_SEND_TEST
 
                     case RESET:
                         OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING("*RESET")
@@ -557,9 +790,65 @@ typedef const char *AT_t;
             uint8_t retriesRemaining = 0;   // Count the number of retries attempted
             int8_t retryTimer = -1;     // Store the retry lockout time. This takes a value in range [0,60] and is set to (-1) when no lockout is desired.
             static constexpr uint8_t maxRetriesDefault = 10;  // Default number of retries.
-            volatile uint8_t txMessageQueue = 0; // Number of frames currently queued for TX.
             const OTSIM900LinkConfig_t *config = NULL;
             OTSIM900LinkState oldState;
+
+            // AT commands issued one at a time from poll().
+            enum ATCommand_t : uint8_t
+                {
+                ATC_NONE,           // No command in flight.
+                ATC_PING,           // AT
+                ATC_PIN_QUERY,      // AT+CPIN?
+                ATC_REGISTRATION,   // AT+CREG?
+                ATC_SET_APN,        // AT+CSTT=<apn>
+                ATC_START_GPRS,     // AT+CIICR
+                ATC_GET_IP,         // AT+CIFSR
+                ATC_STATUS,         // AT+CIPSTATUS
+                ATC_START_UDP,      // AT+CIPSTART="UDP",<address>,<port>
+                ATC_SEND_UDP,       // AT+CIPSEND=<len>
+                ATC_SLEEP           // AT+CSCLK=2
+                };
+            // Command sent and awaiting (the rest of) its response, else ATC_NONE.
+            ATCommand_t atPending = ATC_NONE;
+            // Time (seconds) that atPending was sent.
+            uint8_t atSentTime = 0;
+            // Response to the most recent command, collected incrementally.
+            SIM900ResponseMatcher<MAX_SIM900_RESPONSE_CHARS> response;
+            // Maximum chars read from the SIM900 in one poll(), to bound its duration off-target.
+            static constexpr uint8_t maxATCharsPerPoll = 2 * MAX_SIM900_RESPONSE_CHARS;
+#ifdef ARDUINO_ARCH_AVR
+            // Maximum sub-cycle ticks (~8ms each) spent reading the SIM900 in one poll(),
+            // enough for ~60 chars at 9600 baud.
+            static constexpr uint8_t maxATTicksPerPoll = 8;
+            // True while there is still time in this poll() to read from the SIM900.
+            inline bool atTimeLeft(const uint8_t sctStart) const
+                { return(uint8_t(OTV0P2BASE::getSubCycleTime() - sctStart) < maxATTicksPerPoll); }
+#else
+            // Reads do not block when not running embedded, so only the char budget applies.
+            inline bool atTimeLeft(uint8_t) const { return(true); }
+#endif
+            // Maximum time in seconds to wait for the start of a response before giving up.
+            static constexpr uint8_t atResponseTimeOut = 2;
+            // Set in START_GPRS when GPRS is found shut and should be started on the next poll.
+            bool startGPRSNext = false;
+            // Connected sleep: requested, and currently in use.
+            bool connectedSleepWanted = false;
+            bool sleepEnabled = false;
+            // Whole minutes spent in connected-sleep IDLE, and the seconds value last seen there.
+            uint8_t idleMinutes = 0;
+            uint8_t idleLastSeconds = 0;
+            // Minutes idle in connected sleep between checks that the connection is still up.
+            static constexpr uint8_t connectedSleepKeepAliveMinutes = 10;
+            // The SET_APN and START_UDP command lines (without line ending),
+            // built in RAM by begin() so that each is written in one burst
+            // rather than fetched from Flash/EEPROM and printed a char at a time.
+            // The APN line starts at 0 and the UDP line follows it;
+            // a length of 0 means that line is not cached (too long, or no config)
+            // and is streamed from the config as before.
+            static constexpr uint8_t atCacheSize = 80;
+            char atCache[atCacheSize] = { };
+            uint8_t atCacheAPNLen = 0;
+            uint8_t atCacheUDPLen = 0;
             /************************* Private Methods *******************************/
 
         private:
@@ -601,32 +890,217 @@ typedef const char *AT_t;
                 OTSIM900LINK_DEBUG_SERIAL_PRINTLN_FLASHSTRING(" tries left.")
             }
 
-            // Serial functions
+            // Non-blocking AT command handling
             /**
-             * @brief   Fills a buffer with characters from ser.read(). Exits when array filled, or if ser.read() times out.
-             * @note    Safe for buffer passed in to be no larger than length.
-             * @param   data:   Data buffer to write to.
-             * @param   length: Length of data buffer.
-             * @retval  Number of characters received before time out.
+             * @brief   Send an AT command, without waiting for any response.
              */
-            uint8_t readMany(char * const data, const uint8_t length)
+            void writeATCommand(const ATCommand_t cmd)
                 {
-                // Pointer to write data to.
-                char *dp = data;
-                // Init array to all zeros.
-                memset(data, 0, length);
-                // Loop through filling array until full,
-                // or until ser.read() returns -1 on timeout.
-                while ((dp-data) < length) {
+                if(ATC_NONE == cmd) { return; }
+                if(ATC_PING == cmd) { ser.println(AT_START); return; }
+                if((ATC_SET_APN == cmd) && (0 != atCacheAPNLen))
+                    { writeATCache(0, atCacheAPNLen); return; }
+                if((ATC_START_UDP == cmd) && (0 != atCacheUDPLen))
+                    { writeATCache(atCacheAPNLen, atCacheUDPLen); return; }
+                ser.print(AT_START);
+                switch(cmd)
+                    {
+                    case ATC_PIN_QUERY:
+                        ser.print(AT_PIN);
+                        ser.println(ATc_QUERY);
+                        break;
+                    case ATC_REGISTRATION:
+                        ser.print(AT_REGISTRATION);
+                        ser.println(ATc_QUERY);
+                        break;
+                    case ATC_SET_APN:
+                        ser.print(AT_SET_APN);
+                        ser.print(ATc_SET);
+                        printConfig(config->APN);
+                        ser.println();
+                        break;
+                    case ATC_START_GPRS: ser.println(AT_START_GPRS); break;
+                    case ATC_GET_IP: ser.println(AT_GET_IP); break;
+                    case ATC_STATUS: ser.println(AT_STATUS); break;
+                    case ATC_SLEEP:
+                        ser.print(AT_SLEEP_MODE);
+                        ser.print(ATc_SET);
+                        ser.println('2');
+                        break;
+                    case ATC_START_UDP:
+                        ser.print(AT_START_UDP);
+                        ser.print("=\"UDP\",");
+                        ser.print('\"');
+                        printConfig(config->UDP_Address);
+                        ser.print("\",\"");
+                        printConfig(config->UDP_Port);
+                        ser.println('\"');
+                        break;
+                    case ATC_SEND_UDP:
+                        {
+                            // Length of the oldest queued frame.
+                            uint8_t len = 0, power;
+                            int8_t channel;
+                            txQueue.peek(len, channel, power);
+                            messageCounter++; // increment counter
+                            ser.print(AT_SEND_UDP);
+                            ser.print('=');
+                            ser.println(len); /// @note can't use strlen with encrypted/binary packets
+                        }
+                        break;
+                    default: break;
+                    }
+                }
+            /**
+             * @brief   SIM900Token tokens that mark the end of the useful part of the response to cmd.
+             * @retval  0 if the response is only complete when the SIM900 goes quiet.
+             */
+            static uint8_t atDoneTokens(const ATCommand_t cmd)
+                {
+                switch(cmd)
+                    {
+                    case ATC_SEND_UDP: return(SIM900Token::PROMPT | SIM900Token::ERROR);
+                    // The useful part of these responses follows any OK.
+                    case ATC_GET_IP: case ATC_STATUS: return(0);
+                    case ATC_START_UDP: return(SIM900Token::CONNECT_OK | SIM900Token::ERROR);
+                    default: return(SIM900Token::OK | SIM900Token::ERROR);
+                    }
+                }
+            /**
+             * @brief   Advance the AT command engine by one bounded step.
+             *          If cmd is not already in flight, discards any stale input and sends it.
+             *          Then reads whatever part of the response has arrived,
+             *          stopping once maxATTicksPerPoll sub-cycle ticks have passed
+             *          (so overrunning by at most one serial read timeout)
+             *          or maxATCharsPerPoll chars have been read.
+             *          The response is complete when one of its done tokens is seen,
+             *          when the SIM900 goes quiet after replying,
+             *          or when nothing has arrived within atResponseTimeOut.
+             *          The AT ping does not wait at all, as a silent module is the reply.
+             * @param   cmd: command to send/continue; must not be ATC_NONE.
+             * @retval  True when the response is complete and held in 'response', else false to retry on the next poll.
+             */
+            bool atStep(const ATCommand_t cmd)
+                {
+#ifdef ARDUINO_ARCH_AVR
+                const uint8_t sctStart = OTV0P2BASE::getSubCycleTime();
+#else
+                const uint8_t sctStart = 0;
+#endif
+                uint8_t budget = maxATCharsPerPoll;
+                if(cmd != atPending)
+                    {
+                    while(-1 != ser.read())
+                        { if((0 == --budget) || !atTimeLeft(sctStart)) { return(false); } }
+                    writeATCommand(cmd);
+                    response.start(NULL, atDoneTokens(cmd));
+                    atPending = cmd;
+                    atSentTime = getCurrentSeconds();
+                    }
+                while(0 != budget--)
+                    {
+                    if(!atTimeLeft(sctStart)) { return(false); }
                     const int ic = ser.read();
-                    if (ic == -1) {
-                        return(uint8_t(data-dp)); // Return length of data.
+                    if(-1 == ic)
+                        {
+                        if((0 == response.size()) && (ATC_PING != cmd) &&
+                           !waitedLongEnough(atSentTime, atResponseTimeOut))
+                            { return(false); }
+                        break;
+                        }
+                    if(response.feed(char(ic))) { break; }
                     }
-                    *dp++ = char(ic);
+                // Out of budget with the response still arriving.
+                if(0xff == budget) { return(false); }
+                atPending = ATC_NONE;
+                return(true);
                 }
+
+            // Serial functions
+            /**
+             * @brief   Blocking read of a whole response into 'response'.
+             *          Exits when a done token is seen, or if ser.read() times out;
+             *          any remainder is left for the next command to discard.
+             * @param   doneTokens: mask of SIM900Token tokens that complete the response.
+             * @retval  True if a done token was seen.
+             */
+            bool readResponse(const uint8_t doneTokens)
+                {
+                response.start(NULL, doneTokens);
                 // Should not block forever: read should timeout and return -1.
-                while (-1 != ser.read()) {}
-                return(length); // Data is maximum length.
+                for( ; ; )
+                    {
+                    const int ic = ser.read();
+                    if(-1 == ic) { return(false); }
+                    if(response.feed(char(ic))) { return(true); }
+                    }
+                }
+            /**
+             * @brief   Write a cached command line in one burst, then the line ending.
+             */
+            void writeATCache(const uint8_t start, const uint8_t len)
+                {
+                // Via Print so as not to be hidden by a single-char write() in ser_t.
+                Print &p = ser;
+                p.write(reinterpret_cast<const uint8_t *>(atCache + start), len);
+                ser.println();
+                }
+            /**
+             * @brief   Append to the command cache at pos.
+             * @retval  false if it does not fit, leaving pos in an unspecified state.
+             */
+            bool cacheChar(uint8_t &pos, const char c)
+                {
+                if(pos >= atCacheSize) { return(false); }
+                atCache[pos++] = c;
+                return(true);
+                }
+            bool cacheRAM(uint8_t &pos, const char *s)
+                {
+                for( ; '\0' != *s; ++s) { if(!cacheChar(pos, *s)) { return(false); } }
+                return(true);
+                }
+            bool cacheAT(uint8_t &pos, AT_t s)
+                {
+#ifdef V0p2_SIM900_AT_FlashStringHelper
+                for(const char *p = reinterpret_cast<const char *>(s); ; ++p)
+                    {
+                    const char c = char(pgm_read_byte(p));
+                    if('\0' == c) { return(true); }
+                    if(!cacheChar(pos, c)) { return(false); }
+                    }
+#else
+                return(cacheRAM(pos, s));
+#endif
+                }
+            bool cacheConfig(uint8_t &pos, const void *src)
+                {
+                for(const uint8_t *ptr = (const uint8_t *) src; ; ++ptr)
+                    {
+                    const char c = config->get(ptr);
+                    if('\0' == c) { return(true); }
+                    if(!cacheChar(pos, c)) { return(false); }
+                    }
+                }
+            /**
+             * @brief   Build the SET_APN and START_UDP command lines from config.
+             *          Any line that does not fit is left uncached.
+             */
+            void buildATCache()
+                {
+                atCacheAPNLen = 0;
+                atCacheUDPLen = 0;
+                if(NULL == config) { return; }
+                uint8_t pos = 0;
+                if(cacheAT(pos, AT_START) && cacheAT(pos, AT_SET_APN) &&
+                   cacheChar(pos, ATc_SET) && cacheConfig(pos, config->APN))
+                    { atCacheAPNLen = pos; }
+                pos = atCacheAPNLen;
+                if(cacheAT(pos, AT_START) && cacheAT(pos, AT_START_UDP) &&
+                   cacheRAM(pos, "=\"UDP\",\"") && cacheConfig(pos, config->UDP_Address) &&
+                   cacheRAM(pos, "\",\"") && cacheConfig(pos, config->UDP_Port) &&
+                   cacheChar(pos, '\"'))
+                    { atCacheUDPLen = uint8_t(pos - atCacheAPNLen); }
                 }
             /**
              * @brief   Utility function for printing from config structure.
@@ -657,11 +1131,10 @@ typedef const char *AT_t;
              */
             bool isModulePresent()
                 {
-                char data[OTV0P2BASE::fnmin(32, MAX_SIM900_RESPONSE_CHARS)];
                 ser.print(AT_START);
                 ser.println(ATc_GET_MODULE);
-                readMany(data, sizeof(data));
-                OTSIM900LINK_DEBUG_SERIAL_PRINT(data)
+                readResponse(SIM900Token::OK | SIM900Token::ERROR);
+                OTSIM900LINK_DEBUG_SERIAL_PRINT(response.data())
                 OTSIM900LINK_DEBUG_SERIAL_PRINTLN()
                 return true;
                 }
@@ -675,11 +1148,10 @@ typedef const char *AT_t;
              */
             bool isNetworkCorrect()
                 {
-                char data[MAX_SIM900_RESPONSE_CHARS];
                 ser.print(AT_START);
                 ser.print(AT_NETWORK);
                 ser.println(ATc_QUERY);
-                readMany(data, sizeof(data));
+                readResponse(SIM900Token::OK | SIM900Token::ERROR);
                 return true;
                 }
             /**
@@ -691,54 +1163,22 @@ typedef const char *AT_t;
                 {
                 //  Check the GSM registration via AT commands ( "AT+CREG?" returns "+CREG:x,1" or "+CREG:x,5"; where "x" is 0, 1 or 2).
                 //  Check the GPRS registration via AT commands ("AT+CGATT?" returns "+CGATT:1" and "AT+CGREG?" returns "+CGREG:x,1" or "+CGREG:x,5"; where "x" is 0, 1 or 2).
-                char data[MAX_SIM900_RESPONSE_CHARS];
-                ser.print(AT_START);
-                ser.print(AT_REGISTRATION);
-                ser.println(ATc_QUERY);
-                readMany(data, sizeof(data));
-                // response stuff
-                const char *dataCut = getResponse(data, sizeof(data), ' '); // first ' ' appears right before useful part of message
-                if(NULL == dataCut) { return(false); }
-                // Expected response '1' or '5'.
-                return((dataCut[2] == '1') || (dataCut[2] == '5'));
+                // Response to ATC_REGISTRATION, with the status as the second field.
+                if(!response.hasSeen(SIM900Token::CREG) || (response.fieldCount() < 2)) { return(false); }
+                // Expected response '1' (home) or '5' (roaming).
+                const uint8_t stat = response.field(1);
+                return((1 == stat) || (5 == stat));
                 }
 
             /**
-             * @brief   Set Access Point Name and start task.
+             * @brief   Check that the Access Point Name was set (and task started).
              * @retval  True if APN set.
              * @note    reply: b'AT+CSTT="mobiledata"\r\n\r\nOK\r\n'
              */
-            bool setAPN()
-                {
-                char data[MAX_SIM900_RESPONSE_CHARS];
-                ser.print(AT_START);
-                ser.print(AT_SET_APN);
-                ser.print(ATc_SET);
-                printConfig(config->APN);
-                ser.println();
-                readMany(data, sizeof(data));
-                // response stuff
-                const char *dataCut = getResponse(data, sizeof(data), 0x0A);
-                if(NULL == dataCut) { return(-1); }
-                return(dataCut[2] == 'O'); // Expected response 'OK'.
-                }
-            /**
-             * @brief   Start GPRS connection.
-             * @retval  True if connected.
-             * @note    check power, check registered, check gprs active.
-             * @note    reply: b'AT+CIICR\r\n\r\nOK\r\nAT+CIICR\r\n\r\nERROR\r\n' (not sure why OK then ERROR happens.)
-             */
-            bool startGPRS()
+            bool isAPNSet()
                 {
-                char data[OTV0P2BASE::fnmin(16, MAX_SIM900_RESPONSE_CHARS)];
-                ser.print(AT_START);
-                ser.println(AT_START_GPRS);
-                readMany(data, sizeof(data));
-
-                // response stuff
-                const char *dataCut = getResponse(data, sizeof(data), 0x0A); // unreliable
-                if(NULL == dataCut) { return(-1); }
-                return ((dataCut[0] == 'O') & (dataCut[1] == 'K'));
+                // Response to ATC_SET_APN.
+                return(response.hasSeen(SIM900Token::OK) && !response.hasSeen(SIM900Token::ERROR));
                 }
             /**
              * @brief   Shut GPRS connection.
@@ -746,37 +1186,11 @@ typedef const char *AT_t;
              */
             bool shutGPRS()
                 {
-                char data[MAX_SIM900_RESPONSE_CHARS]; // Was 96: that's a LOT of stack!
                 ser.print(AT_START);
                 ser.println(AT_SHUT_GPRS);
-                readMany(data, sizeof(data));
-
-                // response stuff
-                const char *dataCut = getResponse(data, sizeof(data), 0x0A);
-                if(NULL == dataCut) { return(false); }
                 // Expected response 'SHUT OK'.
-                return (*dataCut == 'S');
-                }
-            /**
-             * @brief   Get IP address from SIM900. Note that the function just returns a bool
-             *          as we currently have no need to know our IP address.
-             * @retval  True if no errors.
-             * @note    reply: b'AT+CIFSR\r\n\r\n172.16.101.199\r\n'
-             */
-            bool getIP()
-                {
-                char data[MAX_SIM900_RESPONSE_CHARS];
-                ser.print(AT_START);
-                ser.println(AT_GET_IP);
-                readMany(data, sizeof(data));
-                // response stuff
-                const char *dataCut = getResponse(data, sizeof(data), 0x0A);
-                if(NULL == dataCut) { return(false); }
-                // All error messages will start with a '+'.
-                if (*dataCut == '+')
-                    { return(false); }
-                else
-                    { return(true); }
+                return(readResponse(SIM900Token::SHUT_OK | SIM900Token::ERROR) &&
+                       response.hasSeen(SIM900Token::SHUT_OK));
                 }
             /**
              * @brief   Check if UDP open.
@@ -804,13 +1218,9 @@ typedef const char *AT_t;
              */
             uint8_t checkUDPStatus()
                 {
-                char data[MAX_SIM900_RESPONSE_CHARS];
-                ser.print(AT_START);
-                ser.println(AT_STATUS);
-                readMany(data, sizeof(data));
-
+                // Response to ATC_STATUS.
                 // First ' ' appears right before useful part of message.
-                const char *dataCut = getResponse(data, sizeof(data), ' ');
+                const char *dataCut = getResponse(response.data(), response.capacity(), ' ');
                 if(NULL == dataCut) { return(0); }
                 if (*dataCut == 'C')
                     return 1; // expected string is 'CONNECT OK'. no other possible string begins with C
@@ -823,18 +1233,16 @@ typedef const char *AT_t;
                 }
             /**
              * @brief   Get signal strength.
-             * @todo    Return /print something?
+             * @retval  RSSI code from "+CSQ: <rssi>,<ber>": [0,31], or 99 if unknown or not read.
              */
             uint8_t getSignalStrength()
                 {
-                char data[OTV0P2BASE::fnmin(32, MAX_SIM900_RESPONSE_CHARS)];
                 ser.print(AT_START);
                 ser.println(AT_SIGNAL);
-                readMany(data, sizeof(data));
-                OTSIM900LINK_DEBUG_SERIAL_PRINTLN(data)
-                // response stuff
-                getResponse(data, sizeof(data), ' '); // first ' ' appears right before useful part of message
-                return 0;
+                readResponse(SIM900Token::OK | SIM900Token::ERROR);
+                OTSIM900LINK_DEBUG_SERIAL_PRINTLN(response.data())
+                if(!response.hasSeen(SIM900Token::CSQ) || (0 == response.fieldCount())) { return(99); }
+                return(response.field(0));
                 }
 
             /**
@@ -843,13 +1251,12 @@ typedef const char *AT_t;
              */
             void verbose(uint8_t level)
                 {
-                char data[MAX_SIM900_RESPONSE_CHARS];
                 ser.print(AT_START);
                 ser.print(AT_VERBOSE_ERRORS);
                 ser.print(ATc_SET);
                 ser.println((char) (level + '0'));
-                readMany(data, sizeof(data));
-            OTSIM900LINK_DEBUG_SERIAL_PRINTLN(data)
+                readResponse(SIM900Token::OK | SIM900Token::ERROR);
+            OTSIM900LINK_DEBUG_SERIAL_PRINTLN(response.data())
             }
         /**
          * @brief   Enter PIN code
@@ -862,13 +1269,12 @@ typedef const char *AT_t;
                 {
                 return 0;
                 } // do not attempt to set PIN if NULL pointer.
-            char data[MAX_SIM900_RESPONSE_CHARS];
             ser.print(AT_START);
             ser.print(AT_PIN);
             ser.print(ATc_SET);
             printConfig(config->PIN);
             ser.println();
-//        readMany(data, sizeof(data));  // todo redundant until function properly implemented.
+//        readResponse(SIM900Token::OK | SIM900Token::ERROR);  // todo redundant until function properly implemented.
 //            OTSIM900LINK_DEBUG_SERIAL_PRINTLN(data)
             return true;
             }
@@ -879,15 +1285,9 @@ typedef const char *AT_t;
          */
         bool isPINRequired()
             {
-            char data[OTV0P2BASE::fnmin(40, MAX_SIM900_RESPONSE_CHARS)];
-            ser.print(AT_START);
-            ser.print(AT_PIN);
-            ser.println(ATc_QUERY);
-            readMany(data, sizeof(data));
-
-            // response stuff
+            // Response to ATC_PIN_QUERY.
             // First ' ' appears right before useful part of message
-            const char *dataCut = getResponse(data, sizeof(data), ' ');
+            const char *dataCut = getResponse(response.data(), response.capacity(), ' ');
             if(NULL == dataCut) { return(false); }
             return('R' == *dataCut);  // Expected string is 'READY'. no other possible string begins with R.
             }
@@ -947,30 +1347,16 @@ typedef const char *AT_t;
         }
 
         /**
-         * @brief   Open UDP socket.
-         * @param   array containing server IP
+         * @brief   Check that the UDP socket was opened.
          * @retval  True if UDP opened
          * @note    reply: b'AT+CIPSTART="UDP","0.0.0.0","9999"\r\n\r\nOK\r\n\r\nCONNECT OK\r\n'
          */
-        bool openUDPSocket()
+        bool isUDPSocketOpen()
             {
-            char data[MAX_SIM900_RESPONSE_CHARS];
-            memset(data, 0, sizeof(data));
-            ser.print(AT_START);
-            ser.print(AT_START_UDP);
-            ser.print("=\"UDP\",");
-            ser.print('\"');
-            printConfig(config->UDP_Address);
-            ser.print("\",\"");
-            printConfig(config->UDP_Port);
-            ser.println('\"');
-            // Implement check here
-            readMany(data, sizeof(data));
-            // response stuff
-            const char *dataCut = getResponse(data, sizeof(data), 0x0A);
-            if(NULL == dataCut) { return(false); }
-            OTSIM900LINK_DEBUG_SERIAL_PRINTLN(dataCut)
-            return !('E' == *dataCut);  // Returns ERROR on fail, else successfully opened UDP.
+            // Response to ATC_START_UDP.
+            if(0 == response.size()) { return(false); }
+            OTSIM900LINK_DEBUG_SERIAL_PRINTLN(response.data())
+            return(!response.hasSeen(SIM900Token::ERROR));  // Returns ERROR on fail, else successfully opened UDP.
             }
         /**
          * @brief   Close UDP connection.
@@ -1011,10 +1397,8 @@ typedef const char *AT_t;
          */
         bool isSIM900Replying()
             {
-            char data[OTV0P2BASE::fnmin(16, MAX_SIM900_RESPONSE_CHARS)];
-            ser.println(AT_START);
-            readMany(data, sizeof(data));
-            return ('A' == *data);
+            // Response to ATC_PING.
+            return ('A' == *response.data());
             }
 
         /**
@@ -1027,6 +1411,9 @@ typedef const char *AT_t;
                 return false;
             else {
                 config = (const OTSIM900LinkConfig_t *) channelConfig->config;
+                // Any cached command lines are stale until begin() rebuilds them.
+                atCacheAPNLen = 0;
+                atCacheUDPLen = 0;
                 // config->get((const uint8_t *) config->...) returns a CHAR from flash or EEPROM, not a pointer!
                 // PIN not checked as it is not always necessary.
                 if ('\0' == config->get((const uint8_t *) config->APN)) return false;
@@ -1037,11 +1424,13 @@ typedef const char *AT_t;
         }
 
         volatile OTSIM900LinkState state = INIT;
-        uint8_t txMsgLen = 0; // This stores the length of the tx message. will have to be redone for multiple txQueue
-        static constexpr uint8_t maxTxQueueLength = 1;
+        // Maximum length of a frame to send.
+        static constexpr uint8_t maxTxMsgLen = 64; // 64 is maxTxMsgLen (from OTRadioLink)
+        static_assert(txQueueDepth >= 1, "txQueueDepth must be at least 1");
 
+        // Frames waiting to be sent, oldest first.
         // Putting this last in the structure.
-        uint8_t txQueue[64]; // 64 is maxTxMsgLen (from OTRadioLink)
+        ::OTRadioLink::TXQueue<txQueueDepth, maxTxMsgLen> txQueue;
 
     public:
         // define abstract methods here
@@ -1054,7 +1443,7 @@ typedef const char *AT_t;
             {
             queueRXMsgsMin = 0;
             maxRXMsgLen = 0;
-            maxTXMsgLen = 64;
+            maxTXMsgLen = maxTxMsgLen;
             }
         ;
         virtual uint8_t getRXMsgsQueued() const override
@@ -53,8 +53,26 @@ namespace OTV0P2BASE
 
 
 #ifdef ARDUINO_ARCH_AVR
+// State for analogueThresholdWatchStart(), shared with the ADC ISR.
+// The threshold is only written while the ADC interrupt is disabled.
+static volatile bool _thresholdWatchActive;
+static volatile bool _thresholdWatchHit;
+static volatile uint8_t _thresholdWatchSkip;
+static uint16_t _thresholdWatchLevel;
+static bool _thresholdWatchNeededEnable;
+
 // Allow wake from (lower-power) sleep while ADC is running.
-ISR(ADC_vect) { ADC_complete = true; }
+// Also checks results against the threshold while a watch is running.
+ISR(ADC_vect)
+  {
+  ADC_complete = true;
+  if(_thresholdWatchActive)
+    {
+    const uint16_t v = ADC; // Reads ADCL then ADCH.
+    if(0 != _thresholdWatchSkip) { --_thresholdWatchSkip; }
+    else if(v > _thresholdWatchLevel) { _thresholdWatchHit = true; }
+    }
+  }
 
 // Nominally accumulate mainly the bottom bits from normal ADC conversions for entropy,
 // especially from earlier unsettled conversions when taking multiple samples.
@@ -209,6 +227,84 @@ bool analogueVsBandgapRead(const uint8_t aiNumber, const bool napToSettle)
   }
 
 
+// Read several ADC channels in one go, each averaged over its oversample count.
+// Powers up the ADC (if need be) once for the whole batch,
+// and sleeps in ADC noise-reduction mode during every conversion.
+// Sets sleep mode to SLEEP_MODE_ADC.
+uint8_t analogueBatchRead(ADCBatchChannel_t *const channels, const uint8_t n)
+  {
+  for(uint8_t c = 0; c < n; ++c) { channels[c].result = 1024; }
+  const bool neededEnable = powerUpADCIfDisabled();
+  ACSR |= _BV(ACD); // Disable the analogue comparator.
+  set_sleep_mode(SLEEP_MODE_ADC);
+  ADCSRB = 0;
+  bitClear(ADCSRA, ADATE); // One conversion per start so that the mux can be changed in between.
+  bitSet(ADCSRA, ADIE); // Turn on ADC interrupt.
+  uint8_t prevRef = 0xff; // Force an extra settling conversion for the first channel.
+  uint8_t done = 0;
+  for( ; done < n; ++done)
+      {
+      ADCBatchChannel_t &ch = channels[done];
+      const uint8_t ref = ch.admux & 0xc0;
+      ADMUX = ch.admux;
+      // Discard the first conversion(s) after a mux/reference change.
+      const uint8_t discard = (ref != prevRef) ? 2 : 1;
+      prevRef = ref;
+      const uint8_t samples = (0 == ch.oversample) ? 1 : ch.oversample;
+      const uint16_t total = discard + samples;
+      uint32_t sum = 0;
+      uint16_t i = 0;
+      for( ; i < total; ++i)
+          {
+          // An ADC conversion should never take more than 1 tick (~8ms).
+          if(getSubCycleTime() > 254) { break; }
+          ADC_complete = false;
+          bitSet(ADCSRA, ADSC); // Start conversion.
+          while(!ADC_complete) { sleep_mode(); }
+          const uint8_t l = ADCL; // Capture the low byte and latch the high byte.
+          const uint8_t h = ADCH; // Capture the high byte.
+          if(i < discard) { _adcNoise = (_adcNoise >> 1) + (l ^ h) + (__TIME__[7] & 0xf); } // Capture a little entropy.
+          else { sum += (((uint16_t)h) << 8) | l; }
+          }
+      if(i < total) { break; } // Timed out.
+      ch.result = (uint16_t)((sum + (samples / 2)) / samples);
+      }
+  bitClear(ADCSRA, ADIE); // Turn off ADC interrupt.
+  if(neededEnable) { powerDownADC(); }
+  return(done);
+  }
+
+
+// Start a free-running watch of one analogue input against a threshold.
+void analogueThresholdWatchStart(const uint8_t admux, const uint16_t threshold)
+  {
+  _thresholdWatchNeededEnable = powerUpADCIfDisabled();
+  ACSR |= _BV(ACD); // Disable the analogue comparator.
+  bitClear(ADCSRA, ADIE); // Keep the ISR out while setting up.
+  ADMUX = admux;
+  _thresholdWatchLevel = threshold;
+  _thresholdWatchSkip = 2;
+  _thresholdWatchHit = false;
+  _thresholdWatchActive = true;
+  ADCSRB = 0; // Enable free-running mode.
+  bitSet(ADCSRA, ADATE); // Enable ADC auto-trigger.
+  bitSet(ADCSRA, ADIE); // Turn on ADC interrupt.
+  bitSet(ADCSRA, ADSC); // Start conversions.
+  }
+
+// True if a conversion has exceeded the threshold since the watch started.
+bool analogueThresholdWatchTriggered() { return(_thresholdWatchHit); }
+
+// Stop the watch.
+void analogueThresholdWatchStop()
+  {
+  bitClear(ADCSRA, ADIE); // Turn off ADC interrupt.
+  bitClear(ADCSRA, ADATE); // Turn off ADC auto-trigger.
+  _thresholdWatchActive = false;
+  if(_thresholdWatchNeededEnable) { powerDownADC(); }
+  }
+
+
 //// Default low-battery threshold suitable for 2xAA NiMH, with AVR BOD at 1.8V.
 //#define BATTERY_LOW_MV 2000
 //
@@ -342,10 +438,8 @@ int readInternalTemperatureC16()
 #endif // ARDUINO_ARCH_AVR
 
 #ifdef EFR32FG1P133F256GM48
-// void ADC0_IRQHandler(void)
-// {
-//   ADC_IntClear(ADC0, ADC_IF_SINGLE);
-// }
+// Set by ADC0_IRQHandler() from the window compare during a threshold watch.
+volatile bool _thresholdWatchHit;
 
 
 void setupADC()
@@ -418,6 +512,42 @@ uint8_t noisyADCRead(bool) {}
 // Only accurate to +/- 10C uncalibrated.
 // May set sleep mode to SLEEP_MODE_ADC, and disables sleep on exit.
 int readInternalTemperatureC16() {}
+
+// Start a free-running watch of the configured input against a threshold:
+// repeated single conversions with the window compare set to
+// interrupt on results in [threshold+1, max].
+void analogueThresholdWatchStart(const uint8_t, const uint16_t threshold)
+{
+    _thresholdWatchHit = false;
+    ADC0->CMPTHR = ((uint32_t)(threshold + 1) << _ADC_CMPTHR_ADGT_SHIFT) | _ADC_CMPTHR_ADLT_MASK;
+    ADC0->SINGLECTRL |= ADC_SINGLECTRL_CMPEN | ADC_SINGLECTRL_REP;
+    ADC_IntClear(ADC0, ADC_IF_SINGLECMP);
+    ADC_IntEnable(ADC0, ADC_IF_SINGLECMP);
+    NVIC_ClearPendingIRQ(ADC0_IRQn);
+    NVIC_EnableIRQ(ADC0_IRQn);
+    ADC_Start(ADC0, adcStartSingle);
+}
+
+// True if a conversion has exceeded the threshold since the watch started.
+bool analogueThresholdWatchTriggered() { return(_thresholdWatchHit); }
+
+// Stop the watch.
+void analogueThresholdWatchStop()
+{
+    ADC_IntDisable(ADC0, ADC_IF_SINGLECMP);
+    NVIC_DisableIRQ(ADC0_IRQn);
+    ADC0->SINGLECTRL &= ~(ADC_SINGLECTRL_CMPEN | ADC_SINGLECTRL_REP);
+    ADC0->CMD = ADC_CMD_SINGLESTOP;
+}
 #endif  // EFR32FG1P133F256GM48
 
 }
+
+#ifdef EFR32FG1P133F256GM48
+// Window compare hit during OTV0P2BASE::analogueThresholdWatchStart().
+extern "C" void ADC0_IRQHandler(void)
+{
+    ADC_IntClear(ADC0, ADC_IF_SINGLECMP);
+    OTV0P2BASE::_thresholdWatchHit = true;
+}
+#endif  // EFR32FG1P133F256GM48
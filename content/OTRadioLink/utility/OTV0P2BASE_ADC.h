@@ -61,6 +61,47 @@ uint16_t analogueNoiseReducedRead(uint8_t aiNumber, uint8_t mode);
 // DE201512: takes 50-60 microseconds to execute @ 1MHZ CPU when napToSettle is false (tested with an oscilloscope by strobing pin).
 bool analogueVsBandgapRead(uint8_t aiNumber, bool napToSettle = false);
 
+// One channel to read with analogueBatchRead().
+struct ADCBatchChannel_t
+  {
+  // Value to set ADMUX to, ie (reference << 6) | input, as for _analogueNoiseReducedReadM().
+  uint8_t admux;
+  // Number of conversions to average; strictly positive.
+  uint8_t oversample;
+  // Set by analogueBatchRead() to the rounded mean in range [0,1023],
+  // or 1024 (range + 1) if not read due to timeout.
+  uint16_t result;
+  };
+
+// Read several ADC channels in one go, each averaged over its oversample count.
+// Powers up the ADC (if need be) once for the whole batch,
+// and sleeps in ADC noise-reduction mode during every conversion.
+// After each mux change one conversion is discarded to let the input settle,
+// and one more if the reference changes,
+// so order channels sharing a reference together.
+//   * channels  the channels to read in order; results are written back
+//   * n  number of channels
+// Sets sleep mode to SLEEP_MODE_ADC.
+// Returns the number of channels completely read,
+// fewer than n if too close to the end of the minor cycle.
+uint8_t analogueBatchRead(ADCBatchChannel_t *channels, uint8_t n);
+
+// Free-running watch of one analogue input against a threshold,
+// eg motor current against the end-stop level.
+// The ADC converts continuously and the conversion-complete interrupt
+// flags the first result above the threshold,
+// so the caller need only poll a flag and may sleep in SLEEP_MODE_ADC between polls.
+// The first two conversions are ignored to let the input and reference settle.
+// No other ADC reads may be made until analogueThresholdWatchStop().
+//   * admux  is the value to set ADMUX to, as for _analogueNoiseReducedReadM()
+//   * threshold  level in range [0,1023]; results above this set the flag
+// Powers up the ADC if need be.
+void analogueThresholdWatchStart(uint8_t admux, uint16_t threshold);
+// True if a conversion has exceeded the threshold since analogueThresholdWatchStart().
+bool analogueThresholdWatchTriggered();
+// Stop the watch, powering the ADC down again if analogueThresholdWatchStart() powered it up.
+void analogueThresholdWatchStop();
+
 // Attempt to capture maybe one bit of noise/entropy with an ADC read, possibly more likely in the lsbits if at all.
 // If requested (and needed) powers up extra I/O during the reads.
 //   powerUpIO if true then power up I/O (and power down after if so)
@@ -110,6 +151,14 @@ bool analogueVsBandgapRead(uint8_t aiNumber, bool napToSettle = false);  // XXX
 // DE201512: takes ~2300 microseconds to execute @ 1MHZ CPU (tested with an oscilloscope by strobing pin).
 uint8_t noisyADCRead(bool powerUpIO = true);  // XXX Stub
 
+// Free-running watch of the configured input against a threshold,
+// using the ADC window compare and its interrupt.
+// As for the AVR version, though admux is ignored
+// and the threshold is in the units returned by _analogueNoiseReducedReadM().
+void analogueThresholdWatchStart(uint8_t admux, uint16_t threshold);
+bool analogueThresholdWatchTriggered();
+void analogueThresholdWatchStop();
+
 
 // Get approximate internal temperature in nominal C/16.
 // Only accurate to +/- 10C uncalibrated.
@@ -0,0 +1,155 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Battery state estimate and the energy policy level derived from it.
+
+ A tired battery shows itself first as sag under load,
+ well before its resting voltage looks low,
+ so the estimate tracks both the resting supply voltage
+ and how far it drops while the valve motor runs.
+ The policy level then steps energy use down across the firmware,
+ each part consulting the level through the helpers here:
+   * stats TX interval: StatsTXRateController::setPowerSaveShift(getStatsIntervalShift())
+   * radio power: OTTXPowerController::setPowerSaveSteps(getTXPowerStepsDown())
+   * motor deadband: CurrentSenseValveMotorDirect::setDeadbandPrecisions(getMotorDeadbandPrecisions())
+   * CLI listen window: promptAndReadCommandLine(getCLIListenMaxSCT(...), ...)
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_BATTERYPOLICY_H
+#define OTV0P2BASE_BATTERYPOLICY_H
+
+#include <stdint.h>
+
+#include "OTV0P2BASE_CurrentBudget.h"
+#include "OTV0P2BASE_PowerManagement.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+// Tracks resting supply voltage and sag under motor load (both cV),
+// smoothed, and derives a policy level with hysteresis.
+// Mains power (resting at or above SupplyVoltageCentiVolts::MAINS_MIN_cV) is always NORMAL.
+// Not thread-/ISR- safe.
+class BatteryStateEstimator final
+    {
+    public:
+        // Energy policy levels, in increasing order of thrift.
+        enum Level : uint8_t
+            {
+            // Normal operation.
+            NORMAL = 0,
+            // Battery getting tired: trim non-essential energy use.
+            CONSERVE,
+            // Battery near end of life: keep only the essentials going.
+            SURVIVE
+            };
+
+        // Voltage under motor load below which to conserve.
+        static constexpr uint16_t CONSERVE_LOADED_cV = SupplyVoltageCentiVolts::BATTERY_LOW_cV + 15;
+        // Voltage under motor load below which to survive.
+        static constexpr uint16_t SURVIVE_LOADED_cV = SupplyVoltageCentiVolts::BATTERY_LOW_cV;
+        // Recovery margin above a threshold before relaxing the level.
+        static constexpr uint8_t HYSTERESIS_cV = 5;
+
+    private:
+        // Smoothed resting voltage; 0 until the first sample.
+        uint16_t restCV = 0;
+        // Smoothed sag under load.
+        uint16_t sagCV = 0;
+        bool haveSag = false;
+        Level level = NORMAL;
+
+        // Exponential smoothing by 1/2^shift with rounding.
+        static uint16_t smooth(const uint16_t old, const uint16_t v, const uint8_t shift)
+            { return(uint16_t((((uint32_t)old << shift) - old + v + (1U << (shift - 1))) >> shift)); }
+
+        void updateLevel()
+            {
+            if((0 == restCV) || (restCV >= SupplyVoltageCentiVolts::MAINS_MIN_cV)) { level = NORMAL; return; }
+            const uint16_t v = getLoadedCV();
+            const Level t = (v < SURVIVE_LOADED_cV) ? SURVIVE : ((v < CONSERVE_LOADED_cV) ? CONSERVE : NORMAL);
+            // Worsen at once; relax only once clear of the current level's threshold by the hysteresis.
+            if(t >= level) { level = t; return; }
+            const uint16_t threshold = (SURVIVE == level) ? SURVIVE_LOADED_cV : CONSERVE_LOADED_cV;
+            if(v >= threshold + HYSTERESIS_cV) { level = t; }
+            }
+
+    public:
+        // Note a resting supply voltage, eg from SupplyVoltageCentiVolts::read() at the start of a cycle.
+        void sampleRest(const uint16_t cV)
+            {
+            restCV = (0 == restCV) ? cV : smooth(restCV, cV, 3);
+            updateLevel();
+            }
+        // Note the supply voltage while the motor runs.
+        // Ignored before the first resting sample.
+        void sampleUnderLoad(const uint16_t cV)
+            {
+            if(0 == restCV) { return; }
+            const uint16_t sag = (cV >= restCV) ? 0 : uint16_t(restCV - cV);
+            sagCV = haveSag ? smooth(sagCV, sag, 2) : sag;
+            haveSag = true;
+            updateLevel();
+            }
+        // Note a supply voltage, as under load if the motor has claimed supplyCurrentBudget,
+        // eg from a motor run callback, else at rest.
+        void sample(const uint16_t cV)
+            {
+            if(supplyCurrentBudget.getInUse() >= CurrentLoad::MOTOR) { sampleUnderLoad(cV); }
+            else { sampleRest(cV); }
+            }
+
+        // Smoothed resting voltage; 0 before any sample.
+        uint16_t getRestCV() const { return(restCV); }
+        // Smoothed sag under motor load; 0 if not yet seen.
+        uint16_t getSagCV() const { return(sagCV); }
+        // Expected voltage under motor load.
+        uint16_t getLoadedCV() const { return((restCV > sagCV) ? uint16_t(restCV - sagCV) : 0); }
+
+        // Current policy level.
+        Level getLevel() const { return(level); }
+
+        // Policy helpers.
+        // Doublings of the stats TX interval.
+        uint8_t getStatsIntervalShift() const { return(uint8_t(level)); }
+        // Steps below the highest configured TX power to cap the radio at.
+        uint8_t getTXPowerStepsDown() const { return(uint8_t(level)); }
+        // Motor deadband in precisions, to save motor runs.
+        uint8_t getMotorDeadbandPrecisions() const { return((NORMAL == level) ? 1 : ((CONSERVE == level) ? 3 : 6)); }
+        // Last sub-cycle time for a CLI listen window from nowSCT that may run to maxSCT:
+        // the full window normally, half when conserving and a quarter when surviving,
+        // leaving the CLI usable for recovery.
+        uint8_t getCLIListenMaxSCT(const uint8_t nowSCT, const uint8_t maxSCT) const
+            {
+            if(maxSCT <= nowSCT) { return(maxSCT); }
+            return(uint8_t(nowSCT + ((maxSCT - nowSCT) >> uint8_t(level))));
+            }
+
+        // Forget all samples, eg after a battery change.
+        void reset() { restCV = 0; sagCV = 0; haveSag = false; level = NORMAL; }
+    };
+
+
+}
+
+#endif
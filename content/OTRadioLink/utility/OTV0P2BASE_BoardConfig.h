@@ -0,0 +1,195 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Compile-time board/feature descriptors.
+
+ Typed counterparts of the ENABLE_XXX macro sets in
+   OTV0p2_valve_ENABLE_defaults.h, OTV0p2_CONFIG_REVn.h and OTV0p2_valve_ENABLE_fixups.h,
+ so that a board is one type whose constexpr members can be
+ passed to templates (eg OTRFM23BLinkForBoard, the enableTrailingJSONStats
+ argument of SystemStatsLine, or the optional arguments of the
+ ModelledRadValveComputeTargetTemp... classes) and features
+ not used on that board are dropped by type rather than #ifdef.
+
+ A board is described in three layers as for the macros:
+   struct MyBoardSpec : BoardConfigDefaults { ...overrides... };
+   typedef BoardConfig<MyBoardSpec> MyBoard;
+ where BoardConfig applies the fixups (implied features).
+
+ Only the main configuration of each board is described here,
+ covering the features that library templates can use;
+ the macro headers remain the reference for the full sets.
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_BOARDCONFIG_H
+#define OTV0P2BASE_BOARDCONFIG_H
+
+#include <stdint.h>
+
+
+namespace OTV0P2BASE
+{
+
+
+// Defaults for V0p2 boards, as OTV0p2_valve_ENABLE_defaults.h.
+// Derive from this and hide members to override them.
+struct BoardConfigDefaults
+    {
+    // Board revision (V0p2_REV); 0 for none.
+    static constexpr uint8_t rev = 0;
+
+    // ENABLE_LOCAL_TRV: act as a thermostat controlling a local TRV.
+    static constexpr bool localTRV = true;
+    // ENABLE_PROPORTIONAL_VALVE_CONTROL: proportional rather than on/off valve control.
+    static constexpr bool proportionalValveControl = true;
+    // ENABLE_V1_DIRECT_MOTOR_DRIVE: direct local motor drive.
+    static constexpr bool directMotorDrive = false;
+    // ENABLE_BOILER_HUB: can act as a boiler hub listening to remote valves.
+    static constexpr bool boilerHub = true;
+
+    // ENABLE_STATS_TX / ENABLE_STATS_RX: send / receive stats frames.
+    static constexpr bool statsTX = true;
+    static constexpr bool statsRX = true;
+    // ENABLE_RADIO_RX: allow radio listen/RX.
+    static constexpr bool radioRX = true;
+    // ENABLE_DEFAULT_ALWAYS_RX: radio listens continuously without being set up to.
+    static constexpr bool defaultAlwaysRX = false;
+    // ENABLE_JSON_OUTPUT / ENABLE_BINARY_STATS_TX: stats formats.
+    static constexpr bool jsonOutput = true;
+    static constexpr bool binaryStatsTX = true;
+    // ENABLE_FHT8VSIMPLE: FS20 carrier and encoding, eg for FHT8V valves.
+    static constexpr bool fs20 = true;
+    // ENABLE_OTSECUREFRAME_ENCODING_SUPPORT: secure frames.
+    static constexpr bool secureFrames = false;
+
+    // ENABLE_CLI / ENABLE_FULL_OT_CLI / ENABLE_FULL_OT_UI.
+    static constexpr bool cli = true;
+    static constexpr bool fullOTCLI = true;
+    static constexpr bool fullOTUI = true;
+    // ENABLE_SETTABLE_TARGET_TEMPERATURES: FROST/WARM settable and kept in EEPROM.
+    static constexpr bool settableTargetTemperatures = true;
+    // ENABLE_SINGLETON_SCHEDULE / ENABLE_LEARN_BUTTON.
+    static constexpr bool singletonSchedule = true;
+    static constexpr bool learnButton = true;
+    // ENABLE_SIMPLIFIED_MODE_BAKE: tapping the button invokes BAKE.
+    static constexpr bool simplifiedModeBake = false;
+    // ENABLE_SETBACK_LOCKOUT_COUNTDOWN: CLI-settable lockout before setbacks engage.
+    static constexpr bool setbackLockoutCountdown = false;
+
+    // ENABLE_OCCUPANCY_DETECTION_FROM_RH.
+    static constexpr bool occupancyFromRH = true;
+    // ENABLE_PRIMARY_TEMP_SENSOR_SHT21: SHT21 in lieu of TMP112.
+    static constexpr bool primaryTempSensorSHT21 = false;
+
+    // ENABLE_TRIMMED_MEMORY: trim RAM (and code) where possible.
+    static constexpr bool trimmedMemory = false;
+    };
+
+// Applies the implied features of OTV0p2_valve_ENABLE_fixups.h to a board spec.
+template<class spec_t>
+struct BoardConfig final : spec_t
+    {
+    // A learn button needs a schedule to set.
+    static constexpr bool singletonSchedule = spec_t::singletonSchedule || spec_t::learnButton;
+    // Stats TX forces JSON stats.
+    static constexpr bool jsonOutput = spec_t::jsonOutput || spec_t::statsTX;
+    // ENABLE_HUB_LISTEN: a boiler or stats hub listens, forcing RX on.
+    static constexpr bool hubListen = spec_t::boilerHub || spec_t::statsRX;
+    static constexpr bool radioRX = spec_t::radioRX || hubListen;
+    // ENABLE_CONTINUOUS_RX: may need continuous RX.
+    static constexpr bool continuousRX = hubListen || spec_t::defaultAlwaysRX;
+    };
+
+
+// REV7 / DORM1 / TRV1: secure all-in-one valve with local motor drive (CONFIG_DORM1).
+struct BoardConfigREV7Spec : BoardConfigDefaults
+    {
+    static constexpr uint8_t rev = 7;
+    static constexpr bool directMotorDrive = true;
+    static constexpr bool boilerHub = false;
+    static constexpr bool statsRX = false;
+    static constexpr bool radioRX = false;
+    static constexpr bool binaryStatsTX = false;
+    static constexpr bool fs20 = false;
+    static constexpr bool secureFrames = true;
+    static constexpr bool settableTargetTemperatures = false;
+    static constexpr bool singletonSchedule = false;
+    static constexpr bool learnButton = false;
+    static constexpr bool simplifiedModeBake = true;
+    static constexpr bool setbackLockoutCountdown = true;
+    static constexpr bool occupancyFromRH = false;
+    static constexpr bool primaryTempSensorSHT21 = true;
+    static constexpr bool trimmedMemory = true;
+    };
+typedef BoardConfig<BoardConfigREV7Spec> BoardConfigREV7;
+
+// REV8: boiler controller counterpart to REV7 (CONFIG_DORM1_BOILER).
+struct BoardConfigREV8Spec : BoardConfigDefaults
+    {
+    static constexpr uint8_t rev = 8;
+    static constexpr bool localTRV = false;
+    static constexpr bool statsRX = false;
+    static constexpr bool primaryTempSensorSHT21 = true;
+    };
+typedef BoardConfig<BoardConfigREV8Spec> BoardConfigREV8;
+
+// REV10: always-listening secure stats relay with secondary radio (CONFIG_REV10).
+struct BoardConfigREV10Spec : BoardConfigDefaults
+    {
+    static constexpr uint8_t rev = 10;
+    static constexpr bool localTRV = false;
+    static constexpr bool boilerHub = false;
+    static constexpr bool defaultAlwaysRX = true;
+    static constexpr bool binaryStatsTX = false;
+    static constexpr bool fs20 = false;
+    static constexpr bool fullOTUI = false;
+    static constexpr bool settableTargetTemperatures = false;
+    static constexpr bool singletonSchedule = false;
+    static constexpr bool learnButton = false;
+    static constexpr bool trimmedMemory = true;
+    };
+typedef BoardConfig<BoardConfigREV10Spec> BoardConfigREV10;
+
+// REV11: secure TX-only sensor leaf (CONFIG_REV11_SECURE_SENSOR).
+struct BoardConfigREV11Spec : BoardConfigDefaults
+    {
+    static constexpr uint8_t rev = 11;
+    static constexpr bool localTRV = false;
+    static constexpr bool boilerHub = false;
+    static constexpr bool statsRX = false;
+    static constexpr bool radioRX = false;
+    static constexpr bool binaryStatsTX = false;
+    static constexpr bool fs20 = false;
+    static constexpr bool secureFrames = true;
+    static constexpr bool fullOTUI = false;
+    static constexpr bool settableTargetTemperatures = false;
+    static constexpr bool singletonSchedule = false;
+    static constexpr bool learnButton = false;
+    static constexpr bool occupancyFromRH = false;
+    static constexpr bool primaryTempSensorSHT21 = true;
+    static constexpr bool trimmedMemory = true;
+    };
+typedef BoardConfig<BoardConfigREV11Spec> BoardConfigREV11;
+
+
+}
+
+#endif
@@ -0,0 +1,187 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2018
+*/
+
+/*
+ Staged boot: initialisation steps with dependencies and urgency,
+ so that the steps needed for the first control action run at once after reset
+ and slow diagnostic and entropy steps run later in idle time.
+
+ Typical use (with steps returning true when done):
+
+    static BootSequencer<> boot;
+    const int8_t power = boot.add(powerSetupStep, NULL, BOOT_CRITICAL);
+    const int8_t rtc = boot.add(restoreRTCStep, NULL, BOOT_CRITICAL, bootDep(power));
+    const int8_t osc = boot.add(checkOscStep, NULL, BOOT_DEFERRED, bootDep(power));
+    const int8_t seed = boot.add(seedPRNGsStep, NULL, BOOT_DEFERRED, bootDep(osc));
+    boot.add(radioBeginStep, NULL, BOOT_CRITICAL, bootDep(power));
+    boot.add(valveRestoreStep, NULL, BOOT_CRITICAL, bootDep(rtc));
+    boot.add(valveCalibrateStep, NULL, BOOT_DEFERRED, bootDep(rtc) | bootDep(seed));
+    boot.runCritical();
+    ...
+    // In the main loop, when there is time to spare in the cycle:
+    boot.runIdle();
+
+ A deferred step that a critical step depends on is run with the critical steps.
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_BOOTSEQUENCER_H
+#define OTV0P2BASE_BOOTSEQUENCER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+namespace OTV0P2BASE
+{
+
+
+// How soon a boot step must run.
+enum BootUrgency : uint8_t
+    {
+    // Run by runCritical(), before the first control action.
+    BOOT_CRITICAL,
+    // Run one at a time by runIdle() once nothing critical is outstanding.
+    BOOT_DEFERRED
+    };
+
+// Dependency mask bit for the step with the id returned by BootSequencer::add().
+constexpr uint16_t bootDep(const int8_t id) { return(((id >= 0) && (id < 16)) ? uint16_t(1U << id) : 0); }
+
+// Runs boot steps in dependency order, critical ones first.
+// Steps can only depend on steps added before them, so there can be no cycles.
+// A step that returns false has not finished (eg failed or needs another go)
+// and is retried on the next run, after other ready steps, as are its dependents.
+// Not thread-/ISR- safe.
+//   * maxSteps  capacity; in [1,16]
+template<uint8_t maxSteps = 16>
+class BootSequencer final
+    {
+    static_assert((maxSteps > 0) && (maxSteps <= 16), "maxSteps must be in [1,16]");
+
+    public:
+        // Step body, with the context given at registration; true when done.
+        typedef bool (*step_fn_t)(void *context);
+
+    private:
+        struct Step
+            {
+            step_fn_t fn;
+            void *context;
+            uint16_t deps;
+            BootUrgency urgency;
+            // Unfinished runs; saturates at 255.
+            uint8_t retries;
+            };
+        Step steps[maxSteps];
+        uint8_t count = 0;
+        // Bit i set when step i is done.
+        uint16_t done = 0;
+
+        static constexpr uint16_t bit(const uint8_t i) { return(uint16_t(1U << i)); }
+        bool ready(const uint8_t i) const { return(!(done & bit(i)) && ((steps[i].deps & done) == steps[i].deps)); }
+        // Run step i; true if it finished.
+        bool run(const uint8_t i)
+            {
+            Step &s = steps[i];
+            if(s.fn(s.context)) { done |= bit(i); return(true); }
+            if(s.retries < 255) { ++s.retries; }
+            return(false);
+            }
+        // Mask of the critical steps and (transitively) all they depend on.
+        uint16_t criticalClosure() const
+            {
+            uint16_t m = 0;
+            // Dependencies are always earlier, so one backwards pass suffices.
+            for(int8_t i = int8_t(count - 1); i >= 0; --i)
+                {
+                if((BOOT_CRITICAL == steps[i].urgency) || (m & bit(uint8_t(i)))) { m |= bit(uint8_t(i)) | steps[i].deps; }
+                }
+            return(m);
+            }
+
+    public:
+        BootSequencer() : steps() { }
+
+        // Register a step; deps is an OR of bootDep() of earlier steps.
+        // Returns the step's id, or -1 if full, fn is NULL, or deps names a step not yet added.
+        int8_t add(const step_fn_t fn, void *const context, const BootUrgency urgency, const uint16_t deps = 0)
+            {
+            if((NULL == fn) || (count >= maxSteps) || (0 != (deps & ~uint16_t(bit(count) - 1)))) { return(-1); }
+            Step &s = steps[count];
+            s.fn = fn;
+            s.context = context;
+            s.deps = deps;
+            s.urgency = urgency;
+            s.retries = 0;
+            return(int8_t(count++));
+            }
+
+        // Run each outstanding critical step, and the steps it needs, once in dependency order.
+        // Returns true if all critical steps are done;
+        // if not, may be called again, eg after a short wait.
+        bool runCritical()
+            {
+            const uint16_t needed = criticalClosure();
+            for(uint8_t i = 0; i < count; ++i)
+                { if((needed & bit(i)) && ready(i)) { run(i); } }
+            return(isCriticalDone());
+            }
+
+        // Run one ready step, critical ones first, else the earliest deferred one
+        // (preferring one not yet retried, so that a failing step does not starve the rest).
+        // Returns true if a step was run.
+        bool runIdle()
+            {
+            const uint16_t needed = criticalClosure();
+            uint8_t best = count;
+            for(uint8_t i = 0; i < count; ++i)
+                {
+                if(!ready(i)) { continue; }
+                if(needed & bit(i)) { best = i; break; }
+                if((best == count) || (steps[i].retries < steps[best].retries)) { best = i; }
+                }
+            if(best == count) { return(false); }
+            run(best);
+            return(true);
+            }
+
+        // True if the step with the given id has finished.
+        bool isDone(const int8_t id) const { return((id >= 0) && (id < count) && (0 != (done & bit(uint8_t(id))))); }
+        // True if all critical steps, and what they need, have finished.
+        bool isCriticalDone() const { const uint16_t m = criticalClosure(); return((done & m) == m); }
+        // True if every step has finished.
+        bool isComplete() const { return(done == uint16_t(bit(count) - 1)); }
+        // Number of steps not yet finished.
+        uint8_t pending() const
+            {
+            uint8_t n = 0;
+            for(uint8_t i = 0; i < count; ++i) { if(!(done & bit(i))) { ++n; } }
+            return(n);
+            }
+        // Unfinished runs of the step with the given id, saturating at 255; 0 if out of range.
+        uint8_t getRetries(const int8_t id) const { return(((id >= 0) && (id < count)) ? steps[id].retries : 0); }
+        // Number of steps registered.
+        uint8_t size() const { return(count); }
+    };
+
+
+}
+
+#endif
@@ -0,0 +1,171 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Debounced push-button press/release capture from a pin-change interrupt,
+ so that buttons (eg MODE, LEARN) are seen instantly while the CPU sleeps
+ rather than by polling on each tick.
+
+ The application's pin-change ISR for the port passes the port input register
+ and getMonotonicTicks() to captureFromISR(), eg:
+
+    static OTV0P2BASE::ButtonEventCapture<> buttons(_BV(PD5) | _BV(PD6));
+    ISR(PCINT2_vect)
+        {
+        if(0 != (buttons.captureFromISR(PIND, OTV0P2BASE::getMonotonicTicks()) & _BV(PD5)))
+            { ui.handleInterruptSimple(); } // Instant response to MODE.
+        }
+
+ Debouncing is by timestamp: the first edge on a button is accepted at once,
+ then further edges on it are ignored for debounceTicks.
+ A release that happens entirely within that lock-out is picked up
+ by the next capture call after it, so the main loop should also call
+ captureFromISR() (with interrupts blocked) now and again, eg each tick.
+
+ Portable; the ISR wiring is the application's, as for PinChangeCapture.
+ */
+
+#ifndef OTV0P2BASE_BUTTONEVENTS_H
+#define OTV0P2BASE_BUTTONEVENTS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "OTV0P2BASE_Concurrency.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+// One debounced button transition.
+struct ButtonEvent final
+    {
+    // Monotonic ticks when accepted.
+    uint32_t ticks;
+    // Port bit number of the button [0,7].
+    uint8_t button;
+    // True for a press, false for a release.
+    bool pressed;
+    };
+
+// Debounced button state, readable without knowing the queue size,
+// eg by a UI that polls whether a button is held down.
+class ButtonState
+    {
+    protected:
+        // Debounced pressed buttons, as a port bit mask; only written by capture.
+        volatile uint8_t pressedMask = 0;
+
+    public:
+        // True if the button on port bit number [0,7] is (debounced) pressed.
+        // Fast and ISR-safe.
+        bool isPressed(const uint8_t button) const { return(0 != (pressedMask & (1U << (button & 7)))); }
+        // All (debounced) pressed buttons as a port bit mask.
+        uint8_t getPressedMask() const { return(pressedMask); }
+    };
+
+// Buttons on one 8-bit port, debounced into a lock-free ring of press/release events.
+// Only the capture side (the ISR, or the main loop with interrupts blocked) updates the state
+// and pushes, so no locking is needed between it and the consumer.
+// When full new events are dropped and counted, so that the oldest are kept;
+// the debounced state stays correct regardless.
+//   * queueSize  capacity in events; a power of two in [2,128]
+template<uint8_t queueSize = 8>
+class ButtonEventCapture final : public ButtonState
+    {
+    static_assert((queueSize >= 2) && (queueSize <= 128) && (0 == (queueSize & (queueSize - 1))),
+        "queueSize must be a power of two in [2,128]");
+
+    public:
+        // Default lock-out after an accepted edge, in monotonic ticks (~31ms).
+        static constexpr uint8_t DEFAULT_DEBOUNCE_TICKS = 4;
+
+    private:
+        // Watched button pins on the port.
+        const uint8_t watchMask;
+        // Watched pins that are pressed when high; the rest are pressed when low (eg with pull-ups).
+        const uint8_t activeHighMask;
+        // Lock-out after an accepted edge.
+        const uint8_t debounceTicks;
+
+        // Buttons with an accepted edge recorded in lastAccepted.
+        uint8_t seenMask = 0;
+        // Ticks of the last accepted edge per port bit.
+        uint32_t lastAccepted[8];
+
+        // Queued events; counts those dropped because it was full.
+        SPSCQueue<ButtonEvent, queueSize> ring;
+
+    public:
+        // Watch the buttons in watchMask, all initially released.
+        ButtonEventCapture(const uint8_t watchMask_, const uint8_t activeHighMask_ = 0,
+                           const uint8_t debounceTicks_ = DEFAULT_DEBOUNCE_TICKS)
+          : watchMask(watchMask_), activeHighMask(activeHighMask_), debounceTicks(debounceTicks_), lastAccepted() { }
+
+        // Accept any button changes outside their debounce lock-out, given the current port input, eg PIND,
+        // and the monotonic ticks, eg getMonotonicTicks().
+        // Call from the pin-change ISR for the port,
+        // and occasionally from the main loop with interrupts blocked.
+        // Returns the buttons newly pressed by this call, as a port bit mask,
+        // so that the ISR can respond at once.
+        // Fast and ISR-safe; not to be called concurrently with itself.
+        uint8_t captureFromISR(const uint8_t portPins, const uint32_t nowTicks)
+            {
+            const uint8_t pressedNow = uint8_t(~(portPins ^ activeHighMask)) & watchMask;
+            const uint8_t changed = pressedNow ^ pressedMask;
+            if(0 == changed) { return(0); }
+            uint8_t accepted = 0;
+            for(uint8_t b = 0; b < 8; ++b)
+                {
+                const uint8_t bit = uint8_t(1U << b);
+                if(0 == (changed & bit)) { continue; }
+                // Still bouncing from the last accepted edge.
+                if((0 != (seenMask & bit)) && ((nowTicks - lastAccepted[b]) < debounceTicks)) { continue; }
+                seenMask |= bit;
+                lastAccepted[b] = nowTicks;
+                accepted |= bit;
+                ButtonEvent *const e = ring.reserve();
+                if(NULL == e) { continue; }
+                e->ticks = nowTicks;
+                e->button = b;
+                e->pressed = (0 != (pressedNow & bit));
+                // Publish only once the entry is complete.
+                ring.commit();
+                }
+            pressedMask = uint8_t(pressedMask ^ accepted);
+            return(uint8_t(accepted & pressedNow));
+            }
+
+        // Number of events queued.
+        uint8_t available() const { return(ring.size()); }
+
+        // Remove the oldest event into e; returns false if none.
+        // Not ISR-safe, and only for a single consumer.
+        bool pop(ButtonEvent &e) { return(ring.pop(e)); }
+
+        // Number of events dropped because the queue was full; saturates at 255.
+        uint8_t getDropped() const { return(ring.getDropped()); }
+        // Clear the count of dropped events.
+        void clearDropped() { ring.clearDropped(); }
+    };
+
+
+}
+
+#endif
@@ -27,12 +27,17 @@ Author(s) / Copyright (s): Deniz Erbilgin 2016
 
 #include "OTV0P2BASE_CLI.h"
 
+#include "OTV0P2BASE_Concurrency.h"
 #include "OTV0P2BASE_EEPROM.h"
 #include "OTV0P2BASE_Entropy.h"
+#include "OTV0P2BASE_EventLog.h"
+#include "OTV0P2BASE_PowerAccounting.h"
+#include "OTV0P2BASE_Provisioning.h"
 #include "OTV0P2BASE_RTC.h"
 #include "OTV0P2BASE_Serial_IO.h"
 #include "OTV0P2BASE_Security.h"
 #include "OTV0P2BASE_Sleep.h"
+#include "OTV0P2BASE_Trace.h"
 #include "OTV0P2BASE_Util.h"
 
 
@@ -373,6 +378,99 @@ bool DumpStats::doCommand(char *const buf, const uint8_t buflen)
     return(false);
     }
 
+// Dump the OT_TRACE() ring oldest first (eg "Y"); "Y Z" then clears it.
+// Avoid showing status afterwards as may already be rather a lot of output.
+bool DumpTrace::doCommand(char *const buf, const uint8_t buflen)
+    {
+#ifdef OTV0P2BASE_TRACE
+    traceRing.pause(true);
+    Serial.print(F("trace "));
+    Serial.print(traceRing.size());
+    Serial.print(F(" lost "));
+    Serial.println(traceRing.getOverwritten());
+    TraceEntry e;
+    for(uint8_t i = 0; traceRing.get(i, e); ++i)
+        {
+        Serial.print(e.cycle);
+        Serial.print(' ');
+        Serial.print(e.sct);
+        Serial.print(' ');
+        Serial.print(e.id);
+        Serial.print(' ');
+        Serial.println(e.value);
+        }
+    if((buflen >= 3) && ('Z' == buf[2])) { traceRing.clear(); }
+    traceRing.pause(false);
+#else
+    (void) buf; (void) buflen;
+    Serial.println(F("trace off"));
+#endif
+    return(false);
+    }
+
+#ifdef OTV0P2BASE_POWER_ACCOUNTING
+// Print one DumpPower line.
+static void printPowerLine(const __FlashStringHelper *const name, const uint32_t ticks, const uint32_t now)
+    {
+    Serial.print(name);
+    Serial.print(' ');
+    Serial.print(ticks);
+    Serial.print(' ');
+    Serial.println(powerMeter.perMille(ticks, now));
+    }
+#endif
+
+// Dump power accounting (eg "W"); "W Z" then resets it.
+bool DumpPower::doCommand(char *const buf, const uint8_t buflen)
+    {
+#ifdef OTV0P2BASE_POWER_ACCOUNTING
+    const uint32_t now = powerMeterNow();
+    Serial.print(F("power "));
+    Serial.println(powerMeter.getElapsedTicks(now));
+    printPowerLine(F("active"), powerMeter.getCPUTicks(CPUPowerState::ACTIVE, now), now);
+    printPowerLine(F("idle"), powerMeter.getCPUTicks(CPUPowerState::IDLE, now), now);
+    printPowerLine(F("psave"), powerMeter.getCPUTicks(CPUPowerState::POWER_SAVE, now), now);
+    printPowerLine(F("spi"), powerMeter.getOnTicks(PowerDomain::SPI_BUS, now), now);
+    printPowerLine(F("adc"), powerMeter.getOnTicks(PowerDomain::ANALOGUE, now), now);
+    printPowerLine(F("uart"), powerMeter.getOnTicks(PowerDomain::UART, now), now);
+    printPowerLine(F("twi"), powerMeter.getOnTicks(PowerDomain::TWI, now), now);
+    printPowerLine(F("rx"), powerMeter.getOnTicks(PowerDomain::RADIO_RX, now), now);
+    printPowerLine(F("tx"), powerMeter.getOnTicks(PowerDomain::RADIO_TX, now), now);
+    printPowerLine(F("motor"), powerMeter.getOnTicks(PowerDomain::MOTOR, now), now);
+    if((buflen >= 3) && ('Z' == buf[2])) { RAII_AtomicBlock atomic; powerMeter.reset(now); }
+#else
+    (void) buf; (void) buflen;
+    Serial.println(F("power off"));
+#endif
+    return(false);
+    }
+
+// Dump the persistent event log oldest first (eg "J"); "J Z" then erases it.
+bool DumpEvents::doCommand(char *const buf, const uint8_t buflen)
+    {
+#if defined(OTV0P2BASE_EVENT_LOG) && defined(ARDUINO_ARCH_AVR)
+    eventLogFlush();
+    Serial.print(F("events "));
+    Serial.print(eventLog.size());
+    Serial.print(F(" lost "));
+    Serial.println(eventLog.getDropped());
+    EventRecord r;
+    for(uint8_t i = 0; eventLog.get(i, r); ++i)
+        {
+        Serial.print(r.time);
+        Serial.print(' ');
+        Serial.print(r.code);
+        Serial.print(' ');
+        Serial.println(r.arg);
+        }
+    if((buflen >= 3) && ('Z' == buf[2])) { eventLog.clear(); }
+#else
+    (void) buf; (void) buflen;
+    Serial.println(F("events off"));
+#endif
+    return(false);
+    }
+
 // Show/set generic parameter values (eg "G N [M]").
 bool GenericParam::doCommand(char *const buf, const uint8_t buflen)
     {
@@ -447,6 +545,7 @@ bool NodeIDWithSet::doCommand(char *const buf, const uint8_t buflen)
         // Try to write the ID directly to EEPROM.
         for(uint8_t i = 0; i < V0P2BASE_EE_LEN_ID; ++i)
             { eeprom_smart_update_byte((uint8_t *)(V0P2BASE_EE_START_ID + i), nodeID[i]); }
+        ++nodeIDGeneration;
         Serial.println();
         return(true);
         }
@@ -533,6 +632,44 @@ bool SetSecretKey::doCommand(char *const buf, const uint8_t buflen)
     return(false);
     }
 
+// Bulk binary provisioning ("P NN").
+// Reads NN raw bytes, then validates and applies them as one transaction.
+// Any byte not arriving within PROVISION_RX_TIMEOUT_TICKS of the previous one abandons the transfer.
+bool BulkProvision::doCommand(char *const buf, const uint8_t buflen)
+    {
+    static constexpr uint8_t PROVISION_RX_TIMEOUT_TICKS = OTV0P2BASE::SUB_CYCLE_TICKS_PER_S / 2;
+    char *last; // Used by strtok_r().
+    char *tok1;
+    // Minimum 3 character sequence makes sense and is safe to tokenise, eg "P 4".
+    if((buflen < 3) || (NULL == (tok1 = strtok_r(buf + 2, " ", &last)))) { InvalidIgnored(); return(false); }
+    const int n = atoi(tok1);
+    if((n < 4) || (n > OTV0P2BASE::PROVISION_MAX_BYTES)) { InvalidIgnored(); return(false); }
+    uint8_t tx[OTV0P2BASE::PROVISION_MAX_BYTES];
+    uint8_t got = 0;
+    uint8_t lastSCT = OTV0P2BASE::getSubCycleTime();
+    while(got < n)
+        {
+        const int c = Serial.read();
+        const uint8_t sct = OTV0P2BASE::getSubCycleTime();
+        if(-1 != c) { tx[got++] = (uint8_t)c; lastSCT = sct; continue; }
+        if((uint8_t)(sct - lastSCT) > PROVISION_RX_TIMEOUT_TICKS) { break; }
+        }
+    OTV0P2BASE::EEPROMSmartStore store;
+    OTV0P2BASE::ProvisioningSummary summary;
+    const OTV0P2BASE::ProvisioningResult r = (got < n) ? OTV0P2BASE::PROVISION_BAD_FORMAT :
+        OTV0P2BASE::applyProvisioning(store, tx, got, &summary);
+    // After a failed verify anything may have changed, so refresh everything,
+    // including treating the key as cleared to reset TX message counters.
+    if(OTV0P2BASE::PROVISION_VERIFY_FAILED == r)
+        { summary.idSet = true; summary.associations = 0; summary.keyCleared = true; }
+    if(summary.idSet) { ++nodeIDGeneration; }
+    if(summary.associations >= 0) { OTV0P2BASE::V0p2_NodeIndex.invalidate(); }
+    if(summary.keyCleared && (NULL != keysClearedFn)) { keysClearedFn(); }
+    if(OTV0P2BASE::PROVISION_OK == r) { Serial.println(F("P OK")); }
+    else { Serial.print(F("!P ")); Serial.println((uint8_t)r); }
+    return(false);
+    }
+
 // Set local time (eg "T HH MM").
 bool SetTime::doCommand(char *const buf, const uint8_t buflen)
     {
@@ -80,6 +80,149 @@ namespace CLI {
     inline uint8_t promptAndReadCommandLine(uint8_t maxSCT, char *buf, uint8_t bufsize, void (*idlefn)() = NULL)
         { ScratchSpace s((uint8_t*)(buf), bufsize); return(promptAndReadCommandLine(maxSCT, s, idlefn)); }
 
+    // Assembles CLI input lines a character at a time as they arrive,
+    // so that the MCU can sleep between characters rather than polling in a listen window,
+    // and dispatches each complete line to a CLIEntryBase::doCommand() at the caller's convenience.
+    // Applies the same filtering as promptAndReadCommandLine():
+    // lines end at CR or LF, non-printable characters are dropped,
+    // and a line can only start with a letter (forced to upper case), '?' or '+'.
+    // A line that fills the buffer is completed and the rest of it up to CR/LF discarded.
+    // While a completed line awaits dispatch, further input is dropped and counted (bar line ends).
+    //
+    // Characters can be fed either:
+    //   * by captureFromISR() from an application-owned UART RX ISR, or
+    //   * by pump() from the main loop at each wake,
+    //     draining a UART driver's own interrupt-filled buffer (eg Arduino Serial),
+    //     for which the UART must stay powered with the CPU in a sleep mode it can wake from.
+    // Do not use both on the same instance.
+    //
+    // Typical use:
+    //     static CLI::CLILineAssembler<> cliLine;
+    //     ...each wake:
+    //     cliLine.pump(Serial, &Serial);
+    //     cliLine.dispatch(selectCommand); // selectCommand('T') returns eg &setTime.
+    //   * maxLineLen  longest line (excluding terminating '\0') in [2,254]
+    template<uint8_t maxLineLen = MAX_TYPICAL_CLI_BUFFER>
+    class CLILineAssembler final
+        {
+        static_assert((maxLineLen >= 2) && (maxLineLen <= 254), "maxLineLen must be in [2,254]");
+
+        public:
+            // Maps a command letter to its handler, or NULL if unknown.
+            typedef CLIEntryBase *(*select_fn_t)(char command);
+
+            // Result of offering one character.
+            enum accept_t : uint8_t { DROPPED, STORED, LINE_COMPLETE };
+
+        private:
+            // Line being assembled, then the completed line.
+            // Owned by the producer while !ready and by the consumer while ready.
+            volatile char line[maxLineLen + 1];
+            // Characters in line; producer only, except when reset by release().
+            volatile uint8_t n;
+            // True if the rest of an over-long line is being discarded; producer only.
+            volatile bool skipToEOL;
+            // True when a complete line awaits dispatch; set by producer, cleared by consumer.
+            volatile OTV0P2BASE::OTAtomic_t<bool> ready;
+            // Characters dropped while a line was awaiting dispatch, saturating; producer only.
+            volatile uint8_t dropped;
+
+            accept_t accept(char c)
+                {
+                const bool eol = ('\r' == c) || ('\n' == c);
+                if(ready.load())
+                    {
+                    // Line ends carry nothing, eg the LF of CRLF, so are not counted.
+                    if(!eol && (dropped < 255)) { ++dropped; }
+                    return(DROPPED);
+                    }
+                if(eol)
+                    {
+                    skipToEOL = false;
+                    if(0 == n) { return(DROPPED); } // Ignore empty lines, eg LF of CRLF.
+                    line[n] = '\0';
+                    ready.store(true);
+                    return(LINE_COMPLETE);
+                    }
+                if(skipToEOL || (c < 32) || (c > 126)) { return(DROPPED); }
+                if(0 == n)
+                    {
+                    if((c >= 'a') && (c <= 'z')) { c = char(c - ('a' - 'A')); }
+                    if(('+' != c) && ('?' != c) && ((c < 'A') || (c > 'Z'))) { return(DROPPED); }
+                    }
+                line[n++] = c;
+                if(n < maxLineLen) { return(STORED); }
+                line[n] = '\0';
+                skipToEOL = true;
+                ready.store(true);
+                return(LINE_COMPLETE);
+                }
+
+        public:
+            CLILineAssembler() : line(), n(0), skipToEOL(false), ready(false), dropped(0) { }
+
+            // Offer one received character; for use from a UART RX ISR.
+            // Quick and does no I/O.
+            // Returns true if this completed a line, eg to note that the main loop should run.
+            bool captureFromISR(const char c) { return(LINE_COMPLETE == accept(c)); }
+
+            // Drain all characters available from in; not for use from an ISR.
+            // If echo is non-NULL then stored characters are echoed to it at once,
+            // followed by a line end when a line completes.
+            // Returns true if a complete line is ready.
+            bool pump(Stream &in, Print *const echo = NULL)
+                {
+                while(in.available() > 0)
+                    {
+                    const int ic = in.read();
+                    if(ic < 0) { break; }
+                    const accept_t a = accept(char(ic));
+                    if(NULL == echo) { continue; }
+                    if(STORED == a) { echo->print(char(line[n-1])); }
+                    else if(LINE_COMPLETE == a) { if(('\r' != ic) && ('\n' != ic)) { echo->print(char(ic)); } echo->println(); }
+                    }
+                return(ready.load());
+                }
+
+            // True if a complete line awaits dispatch.
+            // ISR-/thread- safe.
+            bool isLineReady() const { return(ready.load()); }
+            // Characters dropped while a line awaited dispatch, saturating at 255.
+            uint8_t getDropped() const { return(dropped); }
+
+            // If a complete line is ready, look up its handler by the leading command character
+            // and run its doCommand() on the line in place, then accept new input.
+            // Not for use from an ISR.
+            //   * select  maps the command character to a handler; NULL means unknown
+            //   * statusWanted  if non-NULL, set to the doCommand() result,
+            //       ie true for the default status response, false to print "OK" instead;
+            //       left unchanged if no handler was run
+            // Returns true if a line was taken, whether or not a handler was found.
+            bool dispatch(const select_fn_t select, bool *const statusWanted = NULL)
+                {
+                if(!ready.load()) { return(false); }
+                // The producer does not touch line while ready is set.
+                char *const buf = const_cast<char *>(line);
+                CLIEntryBase *const e = (NULL == select) ? NULL : select(buf[0]);
+                if(NULL != e)
+                    {
+                    const bool r = e->doCommand(buf, n);
+                    if(NULL != statusWanted) { *statusWanted = r; }
+                    }
+                release();
+                return(true);
+                }
+
+            // Discard any completed line and accept new input.
+            // Does nothing while a line is still being assembled.
+            void release()
+                {
+                if(!ready.load()) { return; }
+                n = 0;
+                ready.store(false);
+                }
+        };
+
     // Prints warning to serial (that must be up and running) that invalid (CLI) input has been ignored.
     // Probably should not be inlined, to avoid creating duplicate strings in Flash.
     void InvalidIgnored();
@@ -109,6 +252,20 @@ namespace CLI {
     // Dump (human-friendly) stats (eg "D N").
     class DumpStats final : public CLIEntryBase { public: virtual bool doCommand(char *buf, uint8_t buflen); };
 
+    // Dump the OT_TRACE() ring oldest first as "cycle sct id value" lines (eg "Y"); "Y Z" then clears it.
+    // Recording is paused while dumping; reports "trace off" if built without OTV0P2BASE_TRACE.
+    class DumpTrace final : public CLIEntryBase { public: virtual bool doCommand(char *buf, uint8_t buflen); };
+
+    // Dump power accounting (eg "W") as "name ticks permille" lines, in monotonic sub-cycle ticks
+    // and parts per thousand of the elapsed time; "W Z" then resets it.
+    // Reports "power off" if built without OTV0P2BASE_POWER_ACCOUNTING.
+    class DumpPower final : public CLIEntryBase { public: virtual bool doCommand(char *buf, uint8_t buflen); };
+
+    // Dump the persistent event log (eg "J") oldest first as "time code arg" lines,
+    // after flushing any pending events; "J Z" then erases it.
+    // Reports "events off" if built without OTV0P2BASE_EVENT_LOG.
+    class DumpEvents final : public CLIEntryBase { public: virtual bool doCommand(char *buf, uint8_t buflen); };
+
     // Show/set generic parameter values (eg "G N [M]").
     class GenericParam final : public CLIEntryBase { public: virtual bool doCommand(char *buf, uint8_t buflen); };
 
@@ -169,6 +326,19 @@ namespace CLI {
             virtual bool doCommand(char *buf, uint8_t buflen);
         };
 
+    // Bulk binary provisioning (eg "P NN"): reads NN raw bytes of a transaction
+    // as for applyProvisioning() from the serial line and applies it,
+    // printing "P OK" or "!P" and the ProvisioningResult code.
+    // Each byte must arrive within about 0.5s of the previous one.
+    // As for SetSecretKey, keysCleared() is called if the transaction clears the key.
+    class BulkProvision final : public CLIEntryBase
+        {
+        bool (*const keysClearedFn)();
+        public:
+            BulkProvision(bool (*keysCleared)()) : keysClearedFn(keysCleared) { }
+            virtual bool doCommand(char *buf, uint8_t buflen);
+        };
+
     // Set local time (eg "T HH MM").
     class SetTime final : public CLIEntryBase { public: virtual bool doCommand(char *buf, uint8_t buflen); };
 
@@ -0,0 +1,83 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ CPU clock prescaling policy for compute bursts.
+ */
+
+#ifdef ARDUINO_ARCH_AVR
+#include <util/atomic.h>
+#include <avr/power.h>
+#endif
+
+#include "OTV0P2BASE_CPUClockPolicy.h"
+
+#include "OTV0P2BASE_PowerManagement.h"
+#include "OTV0P2BASE_Sleep.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+#ifdef ARDUINO_ARCH_AVR
+// Global instance.
+CPUClockPolicy _cpuClockPolicy;
+
+// Shift to the reduced clock: as slow as possible while still safe for timer 2.
+static constexpr uint8_t REDUCED_CPU_SHIFT =
+    reducedCPUShift(F_CPU, uint8_t(int(MAX_CPU_PRESCALE) - DEFAULT_CPU_PRESCALE), MIN_CPU_HZ_FOR_RTC);
+
+// Current shift below full speed; 0 at full speed.
+volatile uint8_t _cpuClockShift;
+
+void applyCPUClockPolicy()
+    {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+        // UART baud, SPI and TWI bus clocks and the ADC clock are derived from the CPU clock,
+        // so only reduce while all are powered down.
+        const uint8_t clocked = _BV(PRUSART0) | _BV(PRSPI) | _BV(PRADC) | _BV(PRTWI);
+        const bool canReduce = (clocked == (PRR & clocked));
+        const uint8_t shift = _cpuClockPolicy.wantedShift(REDUCED_CPU_SHIFT, canReduce);
+        if(shift == _cpuClockShift) { return; }
+        clock_prescale_set(clock_div_t(DEFAULT_CPU_PRESCALE + shift));
+        _cpuClockShift = shift;
+        }
+    }
+
+void enterCPUReducedClock()
+    {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { _cpuClockPolicy.enterReduced(); applyCPUClockPolicy(); }
+    }
+void exitCPUReducedClock()
+    {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { _cpuClockPolicy.exitReduced(); applyCPUClockPolicy(); }
+    }
+void enterCPUFullSpeed()
+    {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { _cpuClockPolicy.enterFull(); applyCPUClockPolicy(); }
+    }
+void exitCPUFullSpeed()
+    {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { _cpuClockPolicy.exitFull(); applyCPUClockPolicy(); }
+    }
+#endif // ARDUINO_ARCH_AVR
+
+
+}
@@ -0,0 +1,138 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ CPU clock prescaling policy for compute bursts.
+
+ Work that is not timing-critical (eg stats and JSON formatting, schedule computation)
+ can be wrapped in an RAII_CPUReducedClock to run with the CPU clock prescaled down,
+ lowering the average active current, eg:
+
+    {
+    OTV0P2BASE::RAII_CPUReducedClock slow;
+    const uint8_t n = statsLine.formatStatusReport(line, sizeof(line));
+    }
+
+ Code whose timing depends on the CPU clock
+ (soft serial bit timing, crypto bursts that should finish quickly)
+ holds an RAII_CPUFullSpeed, which restores full speed for its scope even inside a reduced section.
+ The clock is also kept at full speed whenever the hardware UART, SPI, TWI or ADC is powered,
+ as their baud rate and clocks are derived from the CPU clock;
+ the peripheral power routines re-apply the policy as they switch.
+
+ The reduced clock is the slowest at which timer 2 (the RTC)
+ can still be accessed safely, ie at least 4x its 32768Hz crystal;
+ 250kHz, 4x slower, for the usual 1MHz V0p2 CPU.
+ delay_ms() is scaled to the current clock;
+ OTV0P2BASE_delay_us() and _delay_x4cycles() are not, so should run at full speed.
+
+ Real on AVR; elsewhere the guards do nothing.
+ */
+
+#ifndef OTV0P2BASE_CPUCLOCKPOLICY_H
+#define OTV0P2BASE_CPUCLOCKPOLICY_H
+
+#include <stdint.h>
+
+
+namespace OTV0P2BASE
+{
+
+
+// Largest right shift in [0,maxShift] of cpuHz that leaves it at least minHz;
+// 0 if cpuHz is already below minHz.
+inline constexpr uint8_t reducedCPUShift(const uint32_t cpuHz, const uint8_t maxShift, const uint32_t minHz)
+    { return(((maxShift > 0) && ((cpuHz >> 1) >= minHz)) ? uint8_t(1 + reducedCPUShift(cpuHz >> 1, uint8_t(maxShift - 1), minHz)) : 0); }
+
+// Lowest CPU clock at which timer 2 registers can be safely accessed (4x 32768Hz).
+static constexpr uint32_t MIN_CPU_HZ_FOR_RTC = 4 * 32768UL;
+
+// Nesting state of the reduced-clock and full-speed sections.
+// Reduced clock is wanted inside at least one reduced section
+// with no full-speed section open and nothing else needing full speed.
+// Not thread-/ISR- safe; the global instance is only updated with interrupts locked out.
+class CPUClockPolicy final
+    {
+    private:
+        uint8_t reducedDepth = 0;
+        uint8_t fullDepth = 0;
+
+    public:
+        void enterReduced() { if(reducedDepth < 255) { ++reducedDepth; } }
+        void exitReduced() { if(reducedDepth > 0) { --reducedDepth; } }
+        void enterFull() { if(fullDepth < 255) { ++fullDepth; } }
+        void exitFull() { if(fullDepth > 0) { --fullDepth; } }
+
+        bool inReduced() const { return(0 != reducedDepth); }
+        bool inFull() const { return(0 != fullDepth); }
+
+        // Clock shift wanted now: reducedShift if reduced clock is wanted, else 0.
+        //   * canReduce  false if something else needs full speed now, eg the UART is powered
+        uint8_t wantedShift(const uint8_t reducedShift, const bool canReduce) const
+            { return((inReduced() && !inFull() && canReduce) ? reducedShift : 0); }
+    };
+
+#ifdef ARDUINO_ARCH_AVR
+// The global policy; NOT FOR DIRECT ACCESS OUTSIDE THE CLOCK POLICY ROUTINES.
+extern CPUClockPolicy _cpuClockPolicy;
+// Set the CPU clock prescale from the policy and the peripheral power state.
+// Cheap when nothing changes.
+// ISR-safe.
+void applyCPUClockPolicy();
+// Open/close sections; use via the RAII guards.
+// ISR-safe.
+void enterCPUReducedClock();
+void exitCPUReducedClock();
+void enterCPUFullSpeed();
+void exitCPUFullSpeed();
+
+// Run the enclosing scope at reduced CPU clock where possible.
+class RAII_CPUReducedClock final
+    {
+    public:
+        RAII_CPUReducedClock() { enterCPUReducedClock(); }
+        ~RAII_CPUReducedClock() { exitCPUReducedClock(); }
+    };
+// Run the enclosing scope at full CPU clock.
+class RAII_CPUFullSpeed final
+    {
+    public:
+        RAII_CPUFullSpeed() { enterCPUFullSpeed(); }
+        ~RAII_CPUFullSpeed() { exitCPUFullSpeed(); }
+    };
+#else
+// Stubs for unit testing and other platforms.
+inline void applyCPUClockPolicy() { }
+class RAII_CPUReducedClock final
+    {
+    public:
+        RAII_CPUReducedClock() { }
+        ~RAII_CPUReducedClock() { }
+    };
+class RAII_CPUFullSpeed final
+    {
+    public:
+        RAII_CPUFullSpeed() { }
+        ~RAII_CPUFullSpeed() { }
+    };
+#endif // ARDUINO_ARCH_AVR
+
+
+}
+
+#endif
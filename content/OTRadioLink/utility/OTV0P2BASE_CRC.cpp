@@ -16,6 +16,11 @@ under the Licence.
 Author(s) / Copyright (s): Damon Hart-Davis 2015--2016
 */
 
+#ifdef ARDUINO_ARCH_AVR
+#include <avr/pgmspace.h>
+#include <util/crc16.h>
+#endif
+
 #include "OTV0P2BASE_CRC.h"
 
 
@@ -37,9 +42,45 @@ namespace OTV0P2BASE
      * <p>
      * For 2 or 3 byte payloads this should have a Hamming distance of 4 and be within a factor of 2 of optimal error detection.
      * <p>
-     * TODO: provide table-driven optimised alternative,
+     * With OTV0P2BASE_CRC7_5B_TABLE defined this is one table lookup per byte,
      *     eg see http://www.tty1.net/pycrc/index_en.html
      */
+#ifdef OTV0P2BASE_CRC7_5B_TABLE
+    // Next CRC indexed by ((crc << 1) ^ datum) (dropping the top bit of crc):
+    // the CRC is linear, and the top 7 bits of the index stand for the CRC
+    // and the bottom bit for the (otherwise zero) datum.
+    static const uint8_t crc7_5B_table[256]
+#ifdef ARDUINO_ARCH_AVR
+        PROGMEM
+#endif // ARDUINO_ARCH_AVR
+        = {
+    0x00, 0x37, 0x6e, 0x59, 0x6b, 0x5c, 0x05, 0x32, 0x61, 0x56, 0x0f, 0x38, 0x0a, 0x3d, 0x64, 0x53,
+    0x75, 0x42, 0x1b, 0x2c, 0x1e, 0x29, 0x70, 0x47, 0x14, 0x23, 0x7a, 0x4d, 0x7f, 0x48, 0x11, 0x26,
+    0x5d, 0x6a, 0x33, 0x04, 0x36, 0x01, 0x58, 0x6f, 0x3c, 0x0b, 0x52, 0x65, 0x57, 0x60, 0x39, 0x0e,
+    0x28, 0x1f, 0x46, 0x71, 0x43, 0x74, 0x2d, 0x1a, 0x49, 0x7e, 0x27, 0x10, 0x22, 0x15, 0x4c, 0x7b,
+    0x0d, 0x3a, 0x63, 0x54, 0x66, 0x51, 0x08, 0x3f, 0x6c, 0x5b, 0x02, 0x35, 0x07, 0x30, 0x69, 0x5e,
+    0x78, 0x4f, 0x16, 0x21, 0x13, 0x24, 0x7d, 0x4a, 0x19, 0x2e, 0x77, 0x40, 0x72, 0x45, 0x1c, 0x2b,
+    0x50, 0x67, 0x3e, 0x09, 0x3b, 0x0c, 0x55, 0x62, 0x31, 0x06, 0x5f, 0x68, 0x5a, 0x6d, 0x34, 0x03,
+    0x25, 0x12, 0x4b, 0x7c, 0x4e, 0x79, 0x20, 0x17, 0x44, 0x73, 0x2a, 0x1d, 0x2f, 0x18, 0x41, 0x76,
+    0x1a, 0x2d, 0x74, 0x43, 0x71, 0x46, 0x1f, 0x28, 0x7b, 0x4c, 0x15, 0x22, 0x10, 0x27, 0x7e, 0x49,
+    0x6f, 0x58, 0x01, 0x36, 0x04, 0x33, 0x6a, 0x5d, 0x0e, 0x39, 0x60, 0x57, 0x65, 0x52, 0x0b, 0x3c,
+    0x47, 0x70, 0x29, 0x1e, 0x2c, 0x1b, 0x42, 0x75, 0x26, 0x11, 0x48, 0x7f, 0x4d, 0x7a, 0x23, 0x14,
+    0x32, 0x05, 0x5c, 0x6b, 0x59, 0x6e, 0x37, 0x00, 0x53, 0x64, 0x3d, 0x0a, 0x38, 0x0f, 0x56, 0x61,
+    0x17, 0x20, 0x79, 0x4e, 0x7c, 0x4b, 0x12, 0x25, 0x76, 0x41, 0x18, 0x2f, 0x1d, 0x2a, 0x73, 0x44,
+    0x62, 0x55, 0x0c, 0x3b, 0x09, 0x3e, 0x67, 0x50, 0x03, 0x34, 0x6d, 0x5a, 0x68, 0x5f, 0x06, 0x31,
+    0x4a, 0x7d, 0x24, 0x13, 0x21, 0x16, 0x4f, 0x78, 0x2b, 0x1c, 0x45, 0x72, 0x40, 0x77, 0x2e, 0x19,
+    0x3f, 0x08, 0x51, 0x66, 0x54, 0x63, 0x3a, 0x0d, 0x5e, 0x69, 0x30, 0x07, 0x35, 0x02, 0x5b, 0x6c
+        };
+    uint8_t crc7_5B_update(const uint8_t crc, const uint8_t datum)
+        {
+        const uint8_t i = (uint8_t)((uint8_t)(crc << 1) ^ datum);
+#ifdef ARDUINO_ARCH_AVR
+        return(pgm_read_byte(crc7_5B_table + i));
+#else
+        return(crc7_5B_table[i]);
+#endif // ARDUINO_ARCH_AVR
+        }
+#else
     uint8_t crc7_5B_update(uint8_t crc, const uint8_t datum)
         {
         for(uint8_t i = 0x80; i != 0; i >>= 1)
@@ -51,6 +92,14 @@ namespace OTV0P2BASE
             }
         return(crc & 0x7f);
         }
+#endif // OTV0P2BASE_CRC7_5B_TABLE
+
+    // Update 7-bit CRC with len bytes from buf, as repeated crc7_5B_update().
+    uint8_t crc7_5B_buf(uint8_t crc, const uint8_t *buf, uint8_t len)
+        {
+        while(len-- > 0) { crc = crc7_5B_update(crc, *buf++); }
+        return(crc);
+        }
 
     /**As crc7_5B_update() but if the output would be 0, this returns 0x80 instead.
      * This allows use where 0x00 (and 0xff) is not allowed or preferred,
@@ -64,6 +113,71 @@ namespace OTV0P2BASE
         return(crc7_5B_update_nz_ALT);
         }
 
+    // Update 16-bit CRC (polynomial 0xA001 reflected) with next byte.
+    uint16_t crc16_A001_update(uint16_t crc, const uint8_t datum)
+        {
+#ifdef ARDUINO_ARCH_AVR
+        return(_crc16_update(crc, datum));
+#else
+        crc ^= datum;
+        for(uint8_t i = 0; i < 8; ++i)
+            { crc = (crc & 1) ? ((crc >> 1) ^ 0xA001) : (crc >> 1); }
+        return(crc);
+#endif // ARDUINO_ARCH_AVR
+        }
+
+#ifndef ARDUINO_ARCH_AVR
+    // CRC of each 4-bit value, for two lookups per byte.
+    static const uint16_t crc16_A001_nibble_table[16] = {
+    0x0000, 0xcc01, 0xd801, 0x1400, 0xf001, 0x3c00, 0x2800, 0xe401,
+    0xa001, 0x6c00, 0x7800, 0xb401, 0x5000, 0x9c01, 0x8801, 0x4400
+        };
+#endif // ARDUINO_ARCH_AVR
+    template<typename P>
+    static inline uint16_t crc16_A001_buf_T(uint16_t crc, P buf, uint8_t len)
+        {
+        while(len-- > 0)
+            {
+#ifdef ARDUINO_ARCH_AVR
+            crc = _crc16_update(crc, *buf++);
+#else
+            crc ^= *buf++;
+            crc = (crc >> 4) ^ crc16_A001_nibble_table[crc & 0xf];
+            crc = (crc >> 4) ^ crc16_A001_nibble_table[crc & 0xf];
+#endif // ARDUINO_ARCH_AVR
+            }
+        return(crc);
+        }
+    uint16_t crc16_A001_buf(const uint16_t crc, const uint8_t *const buf, const uint8_t len)
+        { return(crc16_A001_buf_T(crc, buf, len)); }
+    uint16_t crc16_A001_buf(const uint16_t crc, const volatile uint8_t *const buf, const uint8_t len)
+        { return(crc16_A001_buf_T(crc, buf, len)); }
+
+#ifndef ARDUINO_ARCH_AVR
+    // CRC of each 4-bit value, for two lookups per byte.
+    static const uint16_t crc_ccitt_8408_nibble_table[16] = {
+    0x0000, 0x1081, 0x2102, 0x3183, 0x4204, 0x5285, 0x6306, 0x7387,
+    0x8408, 0x9489, 0xa50a, 0xb58b, 0xc60c, 0xd68d, 0xe70e, 0xf78f
+        };
+#endif // ARDUINO_ARCH_AVR
+    // Update 16-bit CRC (polynomial 0x8408 reflected) with next byte.
+    uint16_t crc_ccitt_8408_update(uint16_t crc, const uint8_t datum)
+        {
+#ifdef ARDUINO_ARCH_AVR
+        return(_crc_ccitt_update(crc, datum));
+#else
+        crc ^= datum;
+        crc = (crc >> 4) ^ crc_ccitt_8408_nibble_table[crc & 0xf];
+        crc = (crc >> 4) ^ crc_ccitt_8408_nibble_table[crc & 0xf];
+        return(crc);
+#endif // ARDUINO_ARCH_AVR
+        }
+    uint16_t crc_ccitt_8408_buf(uint16_t crc, const uint8_t *buf, uint8_t len)
+        {
+        while(len-- > 0) { crc = crc_ccitt_8408_update(crc, *buf++); }
+        return(crc);
+        }
+
 
 //// Update 'C2' 8-bit CRC with next byte.
 //// Usually initialised with 0xff.
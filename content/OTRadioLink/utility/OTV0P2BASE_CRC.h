@@ -25,6 +25,12 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015--2016
 
 #include <stdint.h>
 
+// Use a 256-byte table for crc7_5B_update() rather than computing bit by bit.
+// On AVR the table is in Flash, and is off by default to save space.
+#if !defined(ARDUINO_ARCH_AVR) && !defined(OTV0P2BASE_CRC7_5B_NO_TABLE) && !defined(OTV0P2BASE_CRC7_5B_TABLE)
+#define OTV0P2BASE_CRC7_5B_TABLE
+#endif
+
 // Use namespaces to help avoid collisions.
 namespace OTV0P2BASE
     {
@@ -46,6 +52,10 @@ namespace OTV0P2BASE
      */
     extern uint8_t crc7_5B_update(uint8_t crc, uint8_t datum);
 
+    // Update 7-bit CRC with len bytes from buf (non-NULL if len > 0), as repeated crc7_5B_update().
+    // Result always has top bit zero if len > 0.
+    extern uint8_t crc7_5B_buf(uint8_t crc, const uint8_t *buf, uint8_t len);
+
     // Value to use in place of 0 for final CRC value, eg for crc7_5B_update_nz_final();
     static const uint8_t crc7_5B_update_nz_ALT = 0x80;
 
@@ -56,6 +66,31 @@ namespace OTV0P2BASE
      */
     extern uint8_t crc7_5B_update_nz_final(uint8_t crc, uint8_t datum);
 
+    /**Update 16-bit CRC with next byte.
+     * Polynomial x^16 + x^15 + x^2 + 1 (0xA001 reflected), as AVR libc _crc16_update(),
+     * eg for JeeLabs/OEM RF12 frames; usually initialised with 0xffff (aka CRC-16/MODBUS).
+     * <p>
+     * Uses _crc16_update() on AVR, else is bit by bit.
+     */
+    extern uint16_t crc16_A001_update(uint16_t crc, uint8_t datum);
+
+    // Update 16-bit CRC with len bytes from buf (non-NULL if len > 0), as repeated crc16_A001_update().
+    // Off AVR this takes 4 bits at a time from a small table.
+    // The volatile version is for buffers shared with an ISR, eg the RX filter.
+    extern uint16_t crc16_A001_buf(uint16_t crc, const uint8_t *buf, uint8_t len);
+    extern uint16_t crc16_A001_buf(uint16_t crc, const volatile uint8_t *buf, uint8_t len);
+
+    /**Update 16-bit CRC with next byte.
+     * Polynomial x^16 + x^12 + x^5 + 1 (0x8408 reflected), as AVR libc _crc_ccitt_update(),
+     * eg for hashing memory for entropy; usually initialised with 0xffff (aka CRC-16/MCRF4XX).
+     * <p>
+     * Uses _crc_ccitt_update() on AVR (faster there than a table in Flash), else takes 4 bits at a time from a small table.
+     */
+    extern uint16_t crc_ccitt_8408_update(uint16_t crc, uint8_t datum);
+
+    // Update 16-bit CRC with len bytes from buf (non-NULL if len > 0), as repeated crc_ccitt_8408_update().
+    extern uint16_t crc_ccitt_8408_buf(uint16_t crc, const uint8_t *buf, uint8_t len);
+
 
     }
 
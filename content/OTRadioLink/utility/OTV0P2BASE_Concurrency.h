@@ -37,6 +37,7 @@ Author(s) / Copyright (s): Damon Hart-Davis 2016--2017
 #ifndef OTV0P2BASE_CONCURRENCY_H
 #define OTV0P2BASE_CONCURRENCY_H
 
+#include <stddef.h>
 #include <stdint.h>
 //#include "OTV0P2BASE_Util.h"
 
@@ -229,6 +230,181 @@ namespace OTV0P2BASE
       }
 
 
+#if defined(OTV0P2BASE_PLATFORM_HAS_atomic) || defined(ARDUINO_ARCH_AVR)
+    // Index for one side of a single-producer single-consumer queue,
+    // written by only one side and read by both.
+    // Loads acquire and stores release, so that entries written before a store
+    // are seen by the other side once it loads the new index.
+    // On AVR a single byte is read/written atomically
+    // and a compiler barrier keeps entry accesses on the right side of the index update.
+    class SPSCIndex final
+    {
+    private:
+#ifdef OTV0P2BASE_PLATFORM_HAS_atomic
+        std::atomic<uint8_t> v;
+#else
+        volatile uint8_t v;
+#endif
+
+    public:
+        constexpr SPSCIndex() : v(0) { }
+#ifdef OTV0P2BASE_PLATFORM_HAS_atomic
+        uint8_t load() const { return(v.load(std::memory_order_acquire)); }
+        void store(const uint8_t x) { v.store(x, std::memory_order_release); }
+#else
+        uint8_t load() const { const uint8_t x = v; __asm__ __volatile__("" ::: "memory"); return(x); }
+        void store(const uint8_t x) { __asm__ __volatile__("" ::: "memory"); v = x; }
+#endif
+    };
+
+    // Lock-free single-producer single-consumer queue of fixed-size records,
+    // eg ISR to main loop or main loop to ISR, without masking interrupts.
+    // Only the producer calls push()/reserve()/commit(),
+    // and only the consumer pop()/front()/release();
+    // size() and the like may be called from either side.
+    // When full, pushes are refused and counted so that the oldest records are kept.
+    // Records are copied with plain assignment, so T should be a small POD struct.
+    // Template parameters:
+    //   * T  record type
+    //   * capacity  records held; a power of two in [2,128]
+    template<typename T, uint8_t capacity>
+    class SPSCQueue final
+    {
+        static_assert((capacity >= 2) && (capacity <= 128) && (0 == (capacity & (capacity - 1))),
+            "capacity must be a power of two in [2,128]");
+
+    private:
+        static constexpr uint8_t mask = capacity - 1;
+        T q[capacity];
+        // Free-running indexes; records [tail, head) are queued.
+        SPSCIndex head;
+        SPSCIndex tail;
+        // Records refused for lack of space; saturates at 255.
+        // Written only by the producer.
+        volatile uint8_t dropped = 0;
+
+        void noteDropped() { if(dropped < 255) { dropped = dropped + 1; } }
+
+    public:
+        constexpr SPSCQueue() : q() { }
+
+        // Records queued.
+        uint8_t size() const { return(uint8_t(head.load() - tail.load())); }
+        bool isEmpty() const { return(0 == size()); }
+        bool isFull() const { return(size() >= capacity); }
+        // Records that can be pushed now.
+        uint8_t space() const { return(uint8_t(capacity - size())); }
+        static constexpr uint8_t getCapacity() { return(capacity); }
+        // Pushes refused for lack of space since the last clearDropped(); saturates at 255.
+        uint8_t getDropped() const { return(dropped); }
+        // Producer side only, or while the producer cannot run.
+        void clearDropped() { dropped = 0; }
+
+        // Queue r; returns false (and counts a drop) if full.
+        // Producer side only.
+        bool push(const T &r)
+            {
+            const uint8_t h = head.load();
+            if(uint8_t(h - tail.load()) >= capacity) { noteDropped(); return(false); }
+            q[h & mask] = r;
+            head.store(uint8_t(h + 1));
+            return(true);
+            }
+        // Queue all n records from rs, or none if there is not room
+        // (counting one drop), eg so that a partial line is never sent.
+        // Producer side only.
+        bool push(const T *const rs, const uint8_t n)
+            {
+            if(NULL == rs) { return(false); }
+            uint8_t h = head.load();
+            if(n > uint8_t(capacity - uint8_t(h - tail.load()))) { noteDropped(); return(false); }
+            for(uint8_t i = 0; i < n; ++i) { q[h++ & mask] = rs[i]; }
+            head.store(h);
+            return(true);
+            }
+        // Get space to build the next record in place, or NULL (counting a drop) if full;
+        // it is queued only when commit() is called.
+        // Producer side only.
+        T *reserve()
+            {
+            const uint8_t h = head.load();
+            if(uint8_t(h - tail.load()) >= capacity) { noteDropped(); return(NULL); }
+            return(q + (h & mask));
+            }
+        // Queue the record obtained from reserve().
+        // Producer side only.
+        void commit() { head.store(uint8_t(head.load() + 1)); }
+
+        // Take the oldest record into r; returns false if empty.
+        // Consumer side only.
+        bool pop(T &r)
+            {
+            const uint8_t t = tail.load();
+            if(t == head.load()) { return(false); }
+            r = q[t & mask];
+            tail.store(uint8_t(t + 1));
+            return(true);
+            }
+        // Get the oldest record in place, or NULL if empty;
+        // it stays queued until release() is called.
+        // Consumer side only.
+        const T *front() const
+            {
+            const uint8_t t = tail.load();
+            if(t == head.load()) { return(NULL); }
+            return(q + (t & mask));
+            }
+        // Remove the record obtained from front().
+        // Consumer side only.
+        void release() { tail.store(uint8_t(tail.load() + 1)); }
+    };
+
+    // Lock-free single-producer single-consumer byte ring, eg for serial TX/RX.
+    template<uint8_t capacity>
+    using SPSCByteRing = SPSCQueue<uint8_t, capacity>;
+
+    // Set of up to 8 event flags, eg raised by ISRs and handled by the main loop.
+    // Each operation is atomic, so any side may set or clear any flag.
+    // On AVR compound updates briefly mask interrupts (very cheap when already in an ISR).
+    class EventFlags final
+    {
+    private:
+#ifdef OTV0P2BASE_PLATFORM_HAS_atomic
+        std::atomic<uint8_t> flags;
+#else
+        volatile uint8_t flags;
+#endif
+
+    public:
+        constexpr EventFlags() : flags(0) { }
+
+#ifdef OTV0P2BASE_PLATFORM_HAS_atomic
+        // Raise the flags in mask.
+        void set(const uint8_t mask) { flags.fetch_or(mask); }
+        // Lower the flags in mask.
+        void clear(const uint8_t mask) { flags.fetch_and(uint8_t(~mask)); }
+        // Lower the flags in mask, returning those of them that were raised.
+        uint8_t take(const uint8_t mask = 0xff) { return(uint8_t(flags.fetch_and(uint8_t(~mask)) & mask)); }
+        // All raised flags.
+        uint8_t get() const { return(flags.load()); }
+#else
+        void set(const uint8_t mask) { RAII_AtomicBlock lock; flags = uint8_t(flags | mask); }
+        void clear(const uint8_t mask) { RAII_AtomicBlock lock; flags = uint8_t(flags & ~mask); }
+        uint8_t take(const uint8_t mask = 0xff)
+            {
+            RAII_AtomicBlock lock;
+            const uint8_t f = flags;
+            flags = uint8_t(f & ~mask);
+            return(uint8_t(f & mask));
+            }
+        uint8_t get() const { return(flags); }
+#endif
+        // True if any of the flags in mask is raised.
+        bool test(const uint8_t mask) const { return(0 != (get() & mask)); }
+    };
+#endif // defined(OTV0P2BASE_PLATFORM_HAS_atomic) || defined(ARDUINO_ARCH_AVR)
+
+
 }
 
 #endif
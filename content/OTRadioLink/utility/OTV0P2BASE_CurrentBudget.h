@@ -0,0 +1,140 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Supply current budget shared by the high-current loads of a unit,
+ ie the valve motor, radio TX and UI LED.
+
+ On weak batteries two such loads at once can sag the supply enough
+ to trip SupplyVoltageLow or even brown out,
+ where either alone would be fine.
+ Each load claims its share of the global supplyCurrentBudget
+ before starting and releases it when done;
+ a refused claim defers the operation:
+   * the valve motor driver skips that poll and resumes at the next,
+   * the radio keeps queued frames for a later poll (or fails a direct sendRaw()),
+   * the UI skips that status flash.
+
+ The default limit admits every combination, ie no governing;
+ set a lower limit, eg LIMIT_ONE_BIG_LOAD, for weak supplies.
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_CURRENTBUDGET_H
+#define OTV0P2BASE_CURRENTBUDGET_H
+
+#include <stdint.h>
+
+#include "OTV0P2BASE_Concurrency.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+// Loads in units of roughly 10mA.
+namespace CurrentLoad
+    {
+    static constexpr uint8_t MOTOR = 15;
+    static constexpr uint8_t RADIO_TX = 8;
+    static constexpr uint8_t LED = 1;
+    }
+
+// Claims against a supply current limit.
+// A claim is always granted when nothing else is claimed,
+// so a single load larger than the limit can still run alone.
+// ISR-safe.
+class CurrentBudget final
+    {
+    public:
+        // No governing.
+        static constexpr uint8_t LIMIT_NONE = 255;
+        // Motor or radio TX, each with the LED, but not both together.
+        static constexpr uint8_t LIMIT_ONE_BIG_LOAD = CurrentLoad::MOTOR + CurrentLoad::LED;
+
+    private:
+        // Total of the loads currently claimed.
+        OTAtomic_t<uint8_t> inUse;
+        volatile uint8_t limit;
+
+    public:
+        explicit CurrentBudget(const uint8_t limit_ = LIMIT_NONE) : inUse(0), limit(limit_) { }
+
+        // Set the limit; existing claims are unaffected.
+        void setLimit(const uint8_t l) { limit = l; }
+        uint8_t getLimit() const { return(limit); }
+        // Total currently claimed.
+        uint8_t getInUse() const { return(inUse.load()); }
+
+        // True if a claim for load would be granted now.
+        bool wouldGrant(const uint8_t load) const
+            {
+            const uint8_t u = inUse.load();
+            return((0 == u) || (uint16_t(u) + load <= limit));
+            }
+
+        // Claim load; if this returns true then release(load) must follow.
+        bool tryClaim(const uint8_t load)
+            {
+            for( ; ; )
+                {
+                uint8_t u = inUse.load();
+                if((0 != u) && (uint16_t(u) + load > limit)) { return(false); }
+                const uint16_t n = uint16_t(u) + load;
+                if(inUse.compare_exchange_strong(u, uint8_t((n > 255) ? 255 : n))) { return(true); }
+                }
+            }
+        // Release a granted claim.
+        void release(const uint8_t load)
+            {
+            for( ; ; )
+                {
+                uint8_t u = inUse.load();
+                if(inUse.compare_exchange_strong(u, uint8_t((u > load) ? (u - load) : 0))) { return; }
+                }
+            }
+    };
+
+// The budget consulted by the valve motor driver, radio and UI.
+extern CurrentBudget supplyCurrentBudget;
+
+// Scoped claim against supplyCurrentBudget (or another budget),
+// released at the end of the scope if granted.
+class CurrentBudgetClaim final
+    {
+    private:
+        CurrentBudget &budget;
+        const uint8_t load;
+        const bool granted;
+
+    public:
+        explicit CurrentBudgetClaim(const uint8_t load_, CurrentBudget &b = supplyCurrentBudget)
+          : budget(b), load(load_), granted(b.tryClaim(load_)) { }
+        ~CurrentBudgetClaim() { if(granted) { budget.release(load); } }
+        CurrentBudgetClaim(const CurrentBudgetClaim &) = delete;
+        CurrentBudgetClaim &operator=(const CurrentBudgetClaim &) = delete;
+
+        // True if the load may go ahead.
+        bool isGranted() const { return(granted); }
+    };
+
+
+}
+
+#endif
@@ -0,0 +1,226 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Cooperative task runner scheduled by sub-cycle time.
+
+ Replaces hand-rolled main loops around getSubCycleTime(),
+ sleepUntilSubCycleTime() and the various poll() routines
+ with a static table of tasks, each with a period in cycles,
+ a phase (sub-cycle tick) within the basic cycle, and a worst-case budget.
+ Typical use:
+
+    CycleTaskRunner<> tasks(getSubCycleTime);
+    tasks.add(pollRadio, &radio, 0, 4);          // Every cycle at tick 0.
+    tasks.add(pollMotor, &motor, 64, 16);        // Every cycle at tick 64.
+    tasks.add(sendStats, NULL, 128, 40, 30);     // Once a minute with 2s cycles.
+    for( ; ; )
+        {
+        TIME_LSD = sleepUntilNewCycle(TIME_LSD);
+        tasks.newCycle();
+        for( ; ; )
+            {
+            tasks.runDue();
+            const uint16_t next = tasks.nextDue();
+            if(next > GSCT_MAX) { break; }
+            sleepUntilSubCycleTime(uint8_t(next));
+            }
+        }
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_CYCLETASKRUNNER_H
+#define OTV0P2BASE_CYCLETASKRUNNER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+namespace OTV0P2BASE
+{
+
+
+// Runs registered tasks once per period at (or as soon as possible after) their phase.
+// Tasks are run one at a time to completion (no pre-emption), earliest phase first,
+// ties in order of registration.
+// Budgets are enforced by not starting a task that could not finish
+// within its budget before the end of the cycle (lastFinishSCT);
+// such a task is skipped until its next period and counted as deferred.
+// A task that takes longer than its budget is counted as overrun.
+// Not thread-safe nor usable from ISRs.
+//   * maxTasks  capacity; in [1,16]
+template<uint8_t maxTasks = 8>
+class CycleTaskRunner final
+    {
+    static_assert((maxTasks > 0) && (maxTasks <= 16), "maxTasks must be in [1,16]");
+
+    public:
+        // Task body, with the context given at registration.
+        typedef void (*task_fn_t)(void *context);
+        // Source of the current sub-cycle time, eg getSubCycleTime().
+        typedef uint8_t (*now_fn_t)();
+        // Value of nextDue() when no task is registered.
+        static constexpr uint16_t NONE_DUE = 0xffff;
+
+        // Run-time statistics for one task.
+        struct TaskStats
+            {
+            // Longest run seen, in sub-cycle ticks.
+            uint8_t worstTicks;
+            // Runs that exceeded the budget; saturates at 255.
+            uint8_t overruns;
+            // Runs skipped for lack of time this cycle; saturates at 255.
+            uint8_t deferred;
+            };
+
+    private:
+        struct Task
+            {
+            task_fn_t fn;
+            void *context;
+            uint8_t phase;
+            uint8_t budgetTicks;
+            uint8_t periodCycles;
+            // Cycle starts until next due.
+            uint8_t cyclesToGo;
+            // True if due this cycle and not yet run.
+            bool pending;
+            TaskStats stats;
+            };
+        Task tasks[maxTasks];
+        uint8_t count = 0;
+
+        const now_fn_t nowFn;
+        // Latest sub-cycle time by which a task must be able to finish.
+        const uint8_t lastFinishSCT;
+
+        static void inc(uint8_t &c) { if(c < 255) { ++c; } }
+
+        // Pending task with the earliest phase at or before now, or count if none.
+        uint8_t findDue(const uint8_t now) const
+            {
+            uint8_t best = count;
+            for(uint8_t i = 0; i < count; ++i)
+                {
+                const Task &t = tasks[i];
+                if(!t.pending || (t.phase > now)) { continue; }
+                if((best == count) || (t.phase < tasks[best].phase)) { best = i; }
+                }
+            return(best);
+            }
+
+    public:
+        //   * nowFn_  sub-cycle time source, eg getSubCycleTime
+        //   * lastFinishSCT_  tasks must be able to finish by this sub-cycle time,
+        //       eg a little before GSCT_MAX to leave time to get to sleep
+        explicit CycleTaskRunner(const now_fn_t nowFn_, const uint8_t lastFinishSCT_ = 250)
+          : tasks(), nowFn(nowFn_), lastFinishSCT(lastFinishSCT_) { }
+
+        // Register a task, first due in the current cycle.
+        //   * phase  sub-cycle tick at which to run
+        //   * budgetTicks  worst-case run time in sub-cycle ticks
+        //   * periodCycles  run every this many basic cycles; strictly positive
+        // Returns false if full or the period is 0.
+        bool add(const task_fn_t fn, void *const context, const uint8_t phase,
+                 const uint8_t budgetTicks, const uint8_t periodCycles = 1)
+            {
+            if((NULL == fn) || (0 == periodCycles) || (count >= maxTasks)) { return(false); }
+            Task &t = tasks[count++];
+            t.fn = fn;
+            t.context = context;
+            t.phase = phase;
+            t.budgetTicks = budgetTicks;
+            t.periodCycles = periodCycles;
+            t.cyclesToGo = periodCycles;
+            t.pending = true;
+            t.stats = TaskStats();
+            return(true);
+            }
+
+        // Number of tasks registered.
+        uint8_t size() const { return(count); }
+
+        // Call once at the start of each basic cycle.
+        // Any tasks still pending from the previous cycle are dropped and counted as deferred.
+        void newCycle()
+            {
+            for(uint8_t i = 0; i < count; ++i)
+                {
+                Task &t = tasks[i];
+                if(t.pending) { inc(t.stats.deferred); t.pending = false; }
+                if(0 == --t.cyclesToGo) { t.pending = true; t.cyclesToGo = t.periodCycles; }
+                }
+            }
+
+        // Run all tasks now due, in phase order, re-checking the time after each.
+        // Returns the number of tasks run.
+        uint8_t runDue()
+            {
+            uint8_t n = 0;
+            for( ; ; )
+                {
+                const uint8_t start = nowFn();
+                const uint8_t i = findDue(start);
+                if(i >= count) { break; }
+                Task &t = tasks[i];
+                t.pending = false;
+                if(uint16_t(start) + t.budgetTicks > lastFinishSCT) { inc(t.stats.deferred); continue; }
+                t.fn(t.context);
+                ++n;
+                const uint8_t took = uint8_t(nowFn() - start);
+                if(took > t.stats.worstTicks) { t.stats.worstTicks = took; }
+                if(took > t.budgetTicks) { inc(t.stats.overruns); }
+                }
+            return(n);
+            }
+
+        // Sub-cycle time, from the start of this cycle, at which the next task is due:
+        // a value above GSCT_MAX is in a later cycle (256 per cycle),
+        // and a value at or before now means due now; NONE_DUE if no tasks.
+        // Suitable for WakeDeadlines::setAt().
+        uint16_t nextDue() const
+            {
+            uint16_t next = NONE_DUE;
+            for(uint8_t i = 0; i < count; ++i)
+                {
+                const Task &t = tasks[i];
+                // Not pending: next due after cyclesToGo more cycle starts.
+                const uint16_t due = t.pending ? t.phase : uint16_t((uint16_t(t.cyclesToGo) << 8) + t.phase);
+                if(due < next) { next = due; }
+                }
+            return(next);
+            }
+
+        // Statistics for the task registered i-th (from 0); all zeros if out of range.
+        TaskStats getStats(const uint8_t i) const { return((i < count) ? tasks[i].stats : TaskStats()); }
+        // Total overruns over all tasks, saturating at 255.
+        uint8_t getTotalOverruns() const
+            {
+            uint16_t n = 0;
+            for(uint8_t i = 0; i < count; ++i) { n += tasks[i].stats.overruns; }
+            return((n > 255) ? 255 : uint8_t(n));
+            }
+        // Clear all statistics.
+        void clearStats() { for(uint8_t i = 0; i < count; ++i) { tasks[i].stats = TaskStats(); } }
+    };
+
+
+}
+
+#endif
@@ -160,6 +160,19 @@ static const intptr_t V0P2BASE_EE_END_RAW_INSPECTABLE = V0P2BASE_EE_START_RAW_IN
 static const intptr_t V0P2BASE_EE_START_SETBACK_LOCKOUT_COUNTDOWN_D_INV = 0 + V0P2BASE_EE_START_RAW_INSPECTABLE;
 
 
+// Cached valve motor calibration, so that a warm restart can skip most of a full recalibration.
+// Holds an opaque CRC-protected record, erased (0xff) if none.
+// Rewritten only on each (re)calibration or warm restart.
+static const intptr_t V0P2BASE_EE_START_VALVE_CALIBRATION = 64;
+static const uint8_t V0P2BASE_EE_LEN_VALVE_CALIBRATION = 8;
+
+// Reserved area for wear-levelled hot records, eg WearLevelledEEPROMByte in OTV0P2BASE_EEPROMJournal.h.
+// Each record of n slots takes 2n bytes; callers partition the area between records.
+// Erased (0xff) when unused.
+static const intptr_t V0P2BASE_EE_START_WEAR_LEVELLED = 72;
+static const uint8_t V0P2BASE_EE_LEN_WEAR_LEVELLED = 32;
+
+
 // TX message counter (most-significant) persistent reboot/restart 3 bytes.  (TODO-728)
 // Nominally the counter associated with the primary TX key,
 // which may be the primary building key for simple configurations,
@@ -184,7 +197,10 @@ static const uint8_t V0P2BASE_EE_LEN_RADIO  = 128; // SIZE OF RADIO CONFIG AREA
 static const intptr_t V0P2BASE_EE_END_RADIO = 255;
 
 
+#endif // ARDUINO_ARCH_AVR
+
 // Bulk data storage: should fit within 1kB EEPROM of ATmega328P or 512B of ATmega164P.
+// Portable so that host EEPROM images (see OTV0P2BASE_EEPROMImage.h) share the layout.
 #define V0P2BASE_EE_START_STATS 256 // INCLUSIVE START OF BULK STATS AREA.
 #define V0P2BASE_EE_STATS_SET_SIZE 24 // Size in entries/bytes of one normal EEPROM-resident hour-of-day stats set.
 
@@ -199,8 +215,10 @@ static const intptr_t V0P2BASE_EE_END_RADIO = 255;
 //#error EEPROM allocation problem: filter overlaps with stats
 //#endif
 
-
-#endif // ARDUINO_ARCH_AVR
+// Persistent event log ring (see OTV0P2BASE_EventLog.h), after the bulk stats area.
+// 16 slots of EVENT_RECORD_BYTES, so holding up to 15 events.
+static constexpr intptr_t V0P2BASE_EE_START_EVENT_LOG = 640;
+static constexpr uint8_t V0P2BASE_EE_EVENT_LOG_SLOTS = 16;
 
 // Node security association storage.
 // (ID plus permanent message counter for RX.)
@@ -242,6 +260,7 @@ static constexpr intptr_t V0P2BASE_EE_END_NODE_ASSOCIATIONS = ((V0P2BASE_EE_NODE
 // Wrapper for simple byte-wide non-volatile time-based (by hour) stats implementation in EEPROM.
 // Multiple instances can access the same EEPROM backing store.
 // Implements the 'standard' stats sets.
+// Front with ByHourByteStatsRAMCache to keep frequently-scanned sets in RAM.
 // Not thread-/ISR- safe.
 class EEPROMByHourByteStats final : public NVByHourByteStatsBase
 {
@@ -0,0 +1,98 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Memory-mapped host EEPROM images.
+ */
+
+#include "OTV0P2BASE_EEPROMImage.h"
+
+#ifdef OTV0P2BASE_EEPROM_IMAGE_AVAILABLE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace OTV0P2BASE
+{
+
+
+bool MappedEEPROMImage::open(const char *const path, const size_t size)
+    {
+    close();
+    if((NULL == path) || (0 == size)) { errno = EINVAL; return(false); }
+    const int fd = ::open(path, O_RDWR | O_CREAT, 0644);
+    if(fd < 0) { return(false); }
+    struct stat st;
+    if(0 != fstat(fd, &st)) { const int e = errno; ::close(fd); errno = e; return(false); }
+    const size_t oldSize = (st.st_size > 0) ? size_t(st.st_size) : 0;
+    if((oldSize < size) && (0 != ftruncate(fd, off_t(size))))
+        { const int e = errno; ::close(fd); errno = e; return(false); }
+    void *const m = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    // The mapping keeps the file open.
+    const int e = errno;
+    ::close(fd);
+    if(MAP_FAILED == m) { errno = e; return(false); }
+    mem = static_cast<uint8_t *>(m);
+    len = size;
+    writes = 0;
+    // Erase any new bytes, which ftruncate() zeroed.
+    if(oldSize < size) { memset(mem + oldSize, 0xff, size - oldSize); }
+    return(true);
+    }
+
+void MappedEEPROMImage::close()
+    {
+    if(NULL == mem) { return; }
+    munmap(mem, len);
+    mem = NULL;
+    len = 0;
+    }
+
+void MappedEEPROMImage::readBlock(void *const dest, const uintptr_t addr, const size_t n) const
+    {
+    uint8_t *const d = static_cast<uint8_t *>(dest);
+    for(size_t i = 0; i < n; ++i) { d[i] = read(addr + i); }
+    }
+
+size_t MappedEEPROMImage::updateBlock(const uintptr_t addr, const void *const src, const size_t n)
+    {
+    const uint8_t *const s = static_cast<const uint8_t *>(src);
+    size_t changed = 0;
+    for(size_t i = 0; i < n; ++i) { if(update(addr + i, s[i])) { ++changed; } }
+    return(changed);
+    }
+
+void MappedEEPROMImage::erase()
+    {
+    for(size_t i = 0; i < len; ++i) { update(i, 0xff); }
+    }
+
+bool MappedEEPROMImage::sync()
+    {
+    if(NULL == mem) { return(false); }
+    return(0 == msync(mem, len, MS_SYNC));
+    }
+
+
+}
+
+#endif // OTV0P2BASE_EEPROM_IMAGE_AVAILABLE
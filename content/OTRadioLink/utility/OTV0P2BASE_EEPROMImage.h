@@ -0,0 +1,204 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ EEPROM images for host builds and simulators.
+
+ MappedEEPROMImage is a byte store (as for EEPROMWriteJournal)
+ backed by a file mapped into memory,
+ so that simulators and the gateway runtime keep node state across runs,
+ and can share it between processes, at memory speed.
+ Each simulated node should have its own image file.
+
+ NodeAssociationTableStore and ByHourByteStatsStore use the V0p2 EEPROM layout
+ over any such store, in place of the AVR-only
+ NodeAssociationTableV0p2 and EEPROMByHourByteStats.
+ They are portable, eg with EEPROMSmartStore on AVR,
+ or with EEPROMJournalMockStore in unit tests.
+
+ MappedEEPROMImage is only available on POSIX hosts,
+ when OTV0P2BASE_EEPROM_IMAGE_AVAILABLE is defined.
+ */
+
+#ifndef OTV0P2BASE_EEPROMIMAGE_H
+#define OTV0P2BASE_EEPROMIMAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "OTV0P2BASE_EEPROMJournal.h"
+#include "OTV0P2BASE_Security.h"
+#include "OTV0P2BASE_Stats.h"
+
+#if !defined(ARDUINO_ARCH_AVR) && (defined(__unix__) || defined(__APPLE__))
+#define OTV0P2BASE_EEPROM_IMAGE_AVAILABLE
+#endif
+
+
+namespace OTV0P2BASE
+{
+
+
+// Node associations in the V0p2 layout from V0P2BASE_EE_START_NODE_ASSOCIATIONS in store.
+// Unlike NodeAssociationTableV0p2 does not invalidate V0p2_NodeIndex;
+// rebuild any NodeAssociationIndex over this after set().
+// Not thread-/ISR- safe.
+//   * store_t  eg MappedEEPROMImage
+template<class store_t>
+class NodeAssociationTableStore final : public NodeAssociationTableBase
+    {
+    private:
+        static constexpr uint8_t setSize {V0P2BASE_EE_NODE_ASSOCIATIONS_SET_SIZE};
+        static constexpr uintptr_t startAddr {V0P2BASE_EE_START_NODE_ASSOCIATIONS};
+
+        store_t &store;
+
+    public:
+        static constexpr uint8_t maxSets {V0P2BASE_EE_NODE_ASSOCIATIONS_MAX_SETS};
+        static constexpr uint8_t idLength {V0P2BASE_EE_NODE_ASSOCIATIONS_8B_ID_LENGTH};
+
+        explicit NodeAssociationTableStore(store_t &store_) : store(store_) { }
+
+        // Set the ID at index in [0,maxSets); returns false if out of range or src is NULL.
+        virtual bool set(const uint8_t index, const uint8_t *const src) override
+            {
+            if((index >= maxSets) || (NULL == src)) { return(false); }
+            const uintptr_t a = startAddr + (uintptr_t(index) * setSize);
+            for(uint8_t i = 0; i < idLength; ++i) { store.update(a + i, src[i]); }
+            return(true);
+            }
+        // Get the ID at index in [0,maxSets) into dest; does nothing if out of range or dest is NULL.
+        virtual void get(const uint8_t index, uint8_t *const dest) const override
+            {
+            if((index >= maxSets) || (NULL == dest)) { return; }
+            const uintptr_t a = startAddr + (uintptr_t(index) * setSize);
+            for(uint8_t i = 0; i < idLength; ++i) { dest[i] = store.read(a + i); }
+            }
+    };
+
+// Standard by-hour stats sets in the V0p2 layout from V0P2BASE_EE_START_STATS in store,
+// as EEPROMByHourByteStats, with the current hour set by the caller (eg a simulator clock).
+// Front with ByHourByteStatsRAMCache to keep frequently-scanned sets in RAM.
+// Not thread-/ISR- safe.
+//   * store_t  eg MappedEEPROMImage
+template<class store_t>
+class ByHourByteStatsStore final : public NVByHourByteStatsBase
+    {
+    private:
+        static constexpr uint8_t setSlots = V0P2BASE_EE_STATS_SET_SIZE;
+
+        store_t &store;
+
+        // Current hour of day, for getByHourStatRTC().
+        uint8_t currentHour = 0;
+
+        static constexpr uintptr_t addr(const uint8_t statsSet, const uint8_t hh)
+            { return(uintptr_t(V0P2BASE_EE_START_STATS) + (uintptr_t(statsSet) * setSlots) + hh); }
+
+    public:
+        explicit ByHourByteStatsStore(store_t &store_) : store(store_) { }
+
+        // Set the current hour of day [0,23]; invalid values are ignored.
+        void setHour(const uint8_t hourNow) { if(hourNow < 24) { currentHour = hourNow; } }
+
+        // Erase all the standard sets, stopping after maxBytesToErase actually need erasing.
+        // Returns true if finished with all bytes erased.
+        virtual bool zapStats(uint16_t maxBytesToErase = 0) override
+            {
+            for(uintptr_t a = addr(0, 0); a < addr(STATS_SETS_COUNT, 0); ++a)
+                { if(store.update(a, UNSET_BYTE)) { if(--maxBytesToErase == 0) { return(false); } } }
+            return(true);
+            }
+
+        // Raw value for hour hh [0,23] of statsSet, or UNSET_BYTE if unset or out of range.
+        virtual uint8_t getByHourStatSimple(const uint8_t statsSet, const uint8_t hh) const override
+            { return(((statsSet >= STATS_SETS_COUNT) || (hh >= 24)) ? UNSET_BYTE : store.read(addr(statsSet, hh))); }
+
+        // Set raw value for hour hh [0,23] of statsSet; out of range is ignored.
+        virtual void setByHourStatSimple(const uint8_t statsSet, const uint8_t hh, const uint8_t v = UNSET_BYTE) override
+            { if((statsSet < STATS_SETS_COUNT) && (hh < 24)) { store.update(addr(statsSet, hh), v); } }
+
+        // Current hour of day (as set by setHour()).
+        virtual uint8_t getHour() const override { return(currentHour); }
+    };
+
+
+#ifdef OTV0P2BASE_EEPROM_IMAGE_AVAILABLE
+// EEPROM image in a file shared-mapped into memory, as a journal store.
+// A new or short file is extended with erased (0xff) bytes.
+// Writes reach the file when the OS writes back the pages, or at sync();
+// other processes mapping the same file see them at once.
+// Reads beyond the image are 0xff and writes there are ignored.
+// Not thread-safe: give each simulated node (or thread) its own image,
+// or lock around access.
+class MappedEEPROMImage final
+    {
+    private:
+        uint8_t *mem = NULL;
+        size_t len = 0;
+        // Bytes actually changed by update(), eg as a wear estimate.
+        uint32_t writes = 0;
+
+    public:
+        // Size of an ATmega328P EEPROM.
+        static constexpr size_t DEFAULT_SIZE = 1024;
+
+        MappedEEPROMImage() { }
+        // Opens path as open(); check isOpen().
+        explicit MappedEEPROMImage(const char *path, size_t size = DEFAULT_SIZE) { open(path, size); }
+        ~MappedEEPROMImage() { close(); }
+        MappedEEPROMImage(const MappedEEPROMImage &) = delete;
+        MappedEEPROMImage &operator=(const MappedEEPROMImage &) = delete;
+
+        // Map the first size bytes of the file at path, creating or extending it as needed.
+        // Closes any image already open.
+        // Returns false (with errno set) on failure.
+        bool open(const char *path, size_t size = DEFAULT_SIZE);
+        // Unmap the image; its contents stay in the file.
+        void close();
+
+        bool isOpen() const { return(NULL != mem); }
+        // Image size in bytes, 0 if not open.
+        size_t size() const { return(len); }
+        uint32_t getWrites() const { return(writes); }
+
+        uint8_t read(const uintptr_t addr) const { return((addr < len) ? mem[addr] : 0xff); }
+        // Returns true if the byte changed.
+        bool update(const uintptr_t addr, const uint8_t value)
+            {
+            if((addr >= len) || (value == mem[addr])) { return(false); }
+            mem[addr] = value;
+            ++writes;
+            return(true);
+            }
+        // Block access, as eeprom_read_block()/eeprom_update_block().
+        void readBlock(void *dest, uintptr_t addr, size_t n) const;
+        // Returns the number of bytes changed.
+        size_t updateBlock(uintptr_t addr, const void *src, size_t n);
+        // Erase the whole image to 0xff.
+        void erase();
+
+        // Write the image back to the file now; returns false on failure.
+        bool sync();
+    };
+#endif // OTV0P2BASE_EEPROM_IMAGE_AVAILABLE
+
+
+}
+
+#endif
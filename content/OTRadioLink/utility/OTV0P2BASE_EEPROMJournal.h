@@ -0,0 +1,234 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Batched EEPROM updates and wear-levelled hot records.
+
+ Each EEPROM byte write costs ~3.4ms on AVR with the MCU awake.
+ EEPROMWriteJournal holds pending byte updates in RAM,
+ coalescing repeated writes to the same location,
+ and writes them in one batch from flush() at a quiet point of the cycle.
+ WearLevelledEEPROMByte spreads a frequently-written byte over
+ several slots in a reserved area (AVR101 style) to extend its life,
+ and may itself write through a journal.
+
+ A store is anything with:
+    uint8_t read(uintptr_t addr) const;
+    bool update(uintptr_t addr, uint8_t value); // True iff EEPROM was written.
+ EEPROMSmartStore is the AVR EEPROM via eeprom_smart_update_byte();
+ EEPROMJournalMockStore is a RAM store for unit tests.
+
+ As for other EEPROM access, not for use from or concurrently with ISRs.
+ */
+
+#ifndef OTV0P2BASE_EEPROMJOURNAL_H
+#define OTV0P2BASE_EEPROMJOURNAL_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "OTV0P2BASE_EEPROM.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+#ifdef ARDUINO_ARCH_AVR
+// AVR EEPROM as a journal store, with minimal-wear updates.
+struct EEPROMSmartStore final
+    {
+    uint8_t read(const uintptr_t addr) const { return(eeprom_read_byte((const uint8_t *)addr)); }
+    bool update(const uintptr_t addr, const uint8_t value) { return(eeprom_smart_update_byte((uint8_t *)addr, value)); }
+    };
+#endif // ARDUINO_ARCH_AVR
+
+// RAM-backed store for unit tests, initially erased (0xff), counting real writes.
+template<uint16_t size = 1024>
+class EEPROMJournalMockStore final
+    {
+    private:
+        uint8_t mem[size];
+    public:
+        // Number of update()s that changed a byte.
+        uint16_t writes = 0;
+        EEPROMJournalMockStore() { memset(mem, 0xff, sizeof(mem)); }
+        uint8_t read(const uintptr_t addr) const { return((addr < size) ? mem[addr] : 0xff); }
+        bool update(const uintptr_t addr, const uint8_t value)
+            {
+            if((addr >= size) || (mem[addr] == value)) { return(false); }
+            mem[addr] = value;
+            ++writes;
+            return(true);
+            }
+    };
+
+// Batches byte updates to a store until flush().
+// read() sees pending updates, so callers may use the journal in place of the store.
+// Pending updates are lost on reset, so only route through this
+// values for which losing the last few minutes of updates is acceptable
+// (eg stats, counters for diagnostics), not keys or message counters.
+// When full, the oldest pending update is written at once to make room.
+//   * store_t  backing store, see above
+//   * maxPending  distinct locations held; in [1,32]
+template<class store_t, uint8_t maxPending = 8>
+class EEPROMWriteJournal final
+    {
+    static_assert((maxPending > 0) && (maxPending <= 32), "maxPending must be in [1,32]");
+
+    private:
+        struct Pending
+            {
+            uintptr_t addr;
+            uint8_t value;
+            };
+        store_t &store;
+        // Pending updates in order of first write, oldest first.
+        Pending pending[maxPending];
+        uint8_t count = 0;
+
+        // Index of the pending entry for addr, or count if none.
+        uint8_t find(const uintptr_t addr) const
+            {
+            uint8_t i = 0;
+            while((i < count) && (pending[i].addr != addr)) { ++i; }
+            return(i);
+            }
+
+        // Write and remove the oldest pending entry; true iff the store was written.
+        bool writeOldest()
+            {
+            const bool written = store.update(pending[0].addr, pending[0].value);
+            --count;
+            memmove(pending, pending + 1, count * sizeof(Pending));
+            return(written);
+            }
+
+    public:
+        explicit EEPROMWriteJournal(store_t &store_) : store(store_), pending() { }
+
+        // Current value at addr, including any pending update.
+        uint8_t read(const uintptr_t addr) const
+            {
+            const uint8_t i = find(addr);
+            return((i < count) ? pending[i].value : store.read(addr));
+            }
+
+        // Queue an update of addr to value, replacing any pending update to it.
+        // Returns true iff the store was written now (ie the journal was full).
+        bool update(const uintptr_t addr, const uint8_t value)
+            {
+            const uint8_t i = find(addr);
+            if(i < count) { pending[i].value = value; return(false); }
+            // No need to queue what is already stored.
+            if(store.read(addr) == value) { return(false); }
+            bool written = false;
+            if(count >= maxPending) { written = writeOldest(); }
+            pending[count].addr = addr;
+            pending[count].value = value;
+            ++count;
+            return(written);
+            }
+
+        // Queue clearing to 0 of the bits of addr that are 0 in mask, as eeprom_smart_clear_bits().
+        // Returns true iff the store was written now.
+        bool clearBits(const uintptr_t addr, const uint8_t mask) { return(update(addr, uint8_t(read(addr) & mask))); }
+
+        // Number of locations with updates pending.
+        uint8_t pendingCount() const { return(count); }
+
+        // Write pending updates, oldest first.
+        //   * maxWrites  stop after this many; 0 for all
+        // Returns the number of bytes actually written.
+        uint8_t flush(const uint8_t maxWrites = 0)
+            {
+            uint8_t n = 0;
+            for(uint8_t done = 0; (count > 0) && ((0 == maxWrites) || (done < maxWrites)); ++done)
+                { if(writeOldest()) { ++n; } }
+            return(n);
+            }
+
+        // Drop all pending updates unwritten.
+        void discard() { count = 0; }
+    };
+
+// One byte value spread over nSlots value/sequence slot pairs in a reserved area, AVR101 style.
+// Each set() writes the next slot in turn, so each EEPROM cell sees 1/nSlots of the writes.
+// The value is written before its sequence byte so a reset mid-update leaves the old value.
+// An erased area reads as 0xff.
+// Uses 2*nSlots bytes from start: values then sequence bytes.
+//   * store_t  EEPROMSmartStore, or a journal for batched writes
+//   * nSlots  in [2,128]
+template<class store_t, uint8_t nSlots>
+class WearLevelledEEPROMByte final
+    {
+    static_assert((nSlots >= 2) && (nSlots <= 128), "nSlots must be in [2,128]");
+
+    private:
+        store_t &store;
+        const uintptr_t start;
+        // Slot holding the current value, or nSlots until found.
+        uint8_t current = nSlots;
+
+        uintptr_t valueAddr(const uint8_t slot) const { return(start + slot); }
+        uintptr_t seqAddr(const uint8_t slot) const { return(start + nSlots + slot); }
+
+        // The current slot is the last one continuing the sequence from slot 0.
+        uint8_t findCurrent()
+            {
+            if(current < nSlots) { return(current); }
+            uint8_t i = 0;
+            uint8_t seq = store.read(seqAddr(0));
+            for( ; i < nSlots - 1; ++i)
+                {
+                const uint8_t next = store.read(seqAddr(uint8_t(i + 1)));
+                if(uint8_t(seq + 1) != next) { break; }
+                seq = next;
+                }
+            current = i;
+            return(current);
+            }
+
+    public:
+        //   * start_  first of the 2*nSlots bytes reserved, eg within V0P2BASE_EE_START_WEAR_LEVELLED
+        WearLevelledEEPROMByte(store_t &store_, const uintptr_t start_) : store(store_), start(start_) { }
+
+        // Current value.
+        uint8_t get() { return(store.read(valueAddr(findCurrent()))); }
+
+        // Set the value; does nothing if unchanged.
+        // Returns true iff set.
+        bool set(const uint8_t value)
+            {
+            const uint8_t c = findCurrent();
+            if(store.read(valueAddr(c)) == value) { return(false); }
+            const uint8_t n = uint8_t((c + 1) % nSlots);
+            store.update(valueAddr(n), value);
+            store.update(seqAddr(n), uint8_t(store.read(seqAddr(c)) + 1));
+            current = n;
+            return(true);
+            }
+
+        // Forget the cached slot, eg if the area was rewritten elsewhere.
+        void resync() { current = nSlots; }
+    };
+
+
+}
+
+#endif
@@ -30,9 +30,16 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015--2016
 #include <Arduino.h>
 #endif
 
+#if defined(EFR32FG1P133F256GM48)
+#include "em_device.h"
+#include "em_cmu.h"
+#endif
+
 #include "OTV0P2BASE_Entropy.h"
+#include "OTV0P2BASE_EntropyPool.h"
 
 #include "OTV0P2BASE_ADC.h"
+#include "OTV0P2BASE_CRC.h"
 #include "OTV0P2BASE_QuickPRNG.h"
 #include "OTV0P2BASE_Sleep.h"
 
@@ -63,14 +70,14 @@ uint_fast8_t clockJitterRTC()
 // Counter to help whiten getSecureRandomByte() output.
 static uint8_t count8;
 
-// Generate 'secure' new random byte.
+// Generate 'secure' new random byte directly from hardware noise sources.
 // This should be essentially all entropy and unguessable.
 // Likely to be slow and may force some peripheral I/O.
 // Runtime details are likely to be intimately dependent on hardware implementation.
 // Not thread-/ISR- safe.
 //  * whiten  if true whiten the output a little more, but little or no extra entropy is added;
 //      if false then it is easier to test if the underlying source provides new entropy reliably
-uint8_t getSecureRandomByte(const bool whiten)
+static uint8_t jitterSecureRandomByte(const bool whiten)
   {
 //#ifdef WAKEUP_32768HZ_XTAL
   // Use various real noise sources and whiten with PRNG and other counters.
@@ -108,13 +115,31 @@ uint8_t getSecureRandomByte(const bool whiten)
   return(w1);
   }
 
+// Unwhitened jitter byte to seed the pool with, credited conservatively at 4 bits.
+static uint8_t poolSourceByte() { return(jitterSecureRandomByte(false)); }
+// Secure random bytes made ready in idle time.
+static SecureRandomPool<> securePool(poolSourceByte, 4);
+
+// Generate 'secure' new random byte.
+// Taken from the pool when whitened bytes are wanted and some are ready,
+// else generated directly (slowly) from hardware noise.
+uint8_t getSecureRandomByte(const bool whiten)
+  {
+  uint8_t b;
+  if(whiten && securePool.get(b)) { return(b); }
+  return(jitterSecureRandomByte(whiten));
+  }
+
+// Top up the pool of ready secure random bytes; call from otherwise idle time.
+uint8_t refillSecureRandomPool() { return(securePool.refill()); }
+
 // Add entropy to the pool, if any, along with an estimate of how many bits of real entropy are present.
 //   * data   byte containing 'random' bits.
 //   * estBits estimated number of truly securely random bits in range [0,8].
 // Not thread-/ISR- safe.
-void addEntropyToPool(const uint8_t data, const uint8_t /*estBits*/)
+void addEntropyToPool(const uint8_t data, const uint8_t estBits)
   {
-  // TODO: no real entropy pool yet.
+  securePool.addEntropy(data, estBits);
   seedRNG8(data ^ ++count8, getCPUCycleCount(), getSubCycleTime());
   }
 
@@ -131,22 +156,32 @@ void captureEntropy1()
 #if !defined(RAMSTART)
 #define RAMSTART (0x100)
 #endif
-uint16_t sramCRC()
+uint16_t sramCRC(const uint8_t stride)
   {
+  const uint8_t step = (0 == stride) ? 1 : stride;
   uint16_t result = ~0U;
-  for(uint8_t *p = (uint8_t *)RAMSTART; p <= (uint8_t *)RAMEND; ++p)
-    { result = _crc_ccitt_update(result, *p); }
+  for(const uint8_t *p = (const uint8_t *)RAMSTART; p <= (const uint8_t *)RAMEND; p += step)
+    { result = crc_ccitt_8408_update(result, *p); }
   return(result);
   }
 
 // Compute a CRC of all of EEPROM as a hash that may contain some entropy, particularly across restarts.
-uint16_t eeCRC()
+uint16_t eeCRC(const uint8_t stride)
   {
   uint16_t result = ~0U;
-  for(uint8_t *p = (uint8_t *)0; p <= (uint8_t *)E2END; ++p)
+  if(stride > 1)
+    {
+    for(uintptr_t a = 0; a <= E2END; a += stride)
+      { result = crc_ccitt_8408_update(result, eeprom_read_byte((const uint8_t *)a)); }
+    return(result);
+    }
+  // Read a block at a time to save the per-byte call and EEPROM set-up overheads.
+  uint8_t buf[32];
+  static_assert(0 == ((E2END + 1) % sizeof(buf)), "EEPROM size must be a multiple of the block size");
+  for(uintptr_t a = 0; a <= E2END; a += sizeof(buf))
     {
-    const uint8_t v = eeprom_read_byte(p);
-    result = _crc_ccitt_update(result, v);
+    eeprom_read_block(buf, (const void *)a, sizeof(buf));
+    result = crc_ccitt_8408_buf(result, buf, sizeof(buf));
     }
   return(result);
   }
@@ -161,8 +196,8 @@ void seedPRNGs()
   // Also sweeps over SRAM and EEPROM (see RAMEND and E2END), especially for non-volatile state and uninitialised areas of SRAM.
   // TODO: add better PRNG with entropy pool (eg for crypto).
   // TODO: add RFM22B WUT clock jitter, RSSI, temperature and battery voltage measures.
-  const uint16_t srseed = OTV0P2BASE::sramCRC();
-  const uint16_t eeseed = OTV0P2BASE::eeCRC();
+  const uint16_t srseed = OTV0P2BASE::sramCRC(V0P2BASE_SEED_SRAM_CRC_STRIDE);
+  const uint16_t eeseed = OTV0P2BASE::eeCRC(V0P2BASE_SEED_EE_CRC_STRIDE);
 //  // DHD20130430: maybe as much as 16 bits of entropy on each reset in seed1, when all sensor inputs used, concentrated in the least-significant bits.
 //  const uint16_t s16 = (__DATE__[5]) ^
 ////                       Vcc ^
@@ -235,12 +270,56 @@ void seedPRNGs()
   DEBUG_SERIAL_PRINTLN();
 #endif
   }
+#elif defined(EFR32FG1P133F256GM48) && defined(TRNG_PRESENT)
+
+// Read one byte from the hardware TRNG, starting it on first use.
+// Blocks only while the TRNG FIFO is empty, typically briefly after start-up.
+static uint8_t trngByte()
+  {
+  static uint32_t word;
+  static uint8_t bytesLeft;
+  if(0 == bytesLeft)
+    {
+    if(0 == (TRNG0->CONTROL & TRNG_CONTROL_ENABLE))
+      {
+      CMU_ClockEnable(cmuClock_TRNG0, true);
+      TRNG0->CONTROL |= TRNG_CONTROL_ENABLE;
+      }
+    while(0 == TRNG0->FIFOLEVEL) { }
+    word = TRNG0->FIFO;
+    bytesLeft = 4;
+    }
+  const uint8_t b = uint8_t(word);
+  word >>= 8;
+  --bytesLeft;
+  return(b);
+  }
+
+// Secure random bytes made ready in idle time, seeded from the TRNG.
+static SecureRandomPool<> securePool(trngByte, 8);
+
+// Generate 'secure' new random byte, from the pool if any are ready, else from the TRNG.
+uint8_t getSecureRandomByte(const bool whiten)
+  {
+  uint8_t b;
+  if(whiten && securePool.get(b)) { return(b); }
+  return(trngByte());
+  }
+
+// Top up the pool of ready secure random bytes; call from otherwise idle time.
+uint8_t refillSecureRandomPool() { return(securePool.refill()); }
+
+// Add entropy to the pool along with an estimate of how many bits of real entropy are present.
+void addEntropyToPool(const uint8_t data, const uint8_t estBits) { securePool.addEntropy(data, estBits); }
+
 #else
 // Stub for integration tests
 uint8_t getSecureRandomByte(const bool)
 {
     return (0);
 }
+// No pool on this platform.
+uint8_t refillSecureRandomPool() { return(0); }
 #endif // ARDUINO_ARCH_AVR
 
 
@@ -49,12 +49,22 @@ uint_fast8_t clockJitterEntropyByte();
 
 // Generate 'secure' new random byte.
 // This should be essentially all entropy and unguessable.
-// Likely to be slow and may force some I/O.
+// Returned at once from the pool kept topped up by refillSecureRandomPool() when bytes are ready,
+// else likely to be slow and may force some I/O.
 // Not thread-/ISR- safe.
 //  * whiten  if true whiten the output a little more, but little or no extra entropy is added;
 //      if false then it is easier to test if the underlying source provides new entropy reliably
+//      and the pool is bypassed
 uint8_t getSecureRandomByte(bool whiten = true);
 
+// Top up the pool of ready secure random bytes (see SecureRandomPool); call from otherwise idle time.
+// The first call(s) may be slow (eg tens of ms at 1MHz) while the pool is seeded from clock jitter;
+// after that each call costs about one jitter byte and one ChaCha20 block.
+// Uses the hardware TRNG as the source where available.
+// Returns the number of bytes now ready, 0 if there is no pool on this platform.
+// Not thread-/ISR- safe.
+uint8_t refillSecureRandomPool();
+
 // Add entropy to the pool, if any, along with an estimate of how many bits of real entropy are present.
 //   * data   byte containing 'random' bits.
 //   * estBits estimated number of truly securely random bits in range [0,8].
@@ -68,9 +78,21 @@ void addEntropyToPool(uint8_t data, uint8_t estBits);
 void captureEntropy1();
 
 // Compute a CRC of all of SRAM as a hash that should contain some entropy, especially after power-up.
-uint16_t sramCRC();
+// With stride > 1 only every stride-th byte is hashed, to save time at boot.
+uint16_t sramCRC(uint8_t stride = 1);
 // Compute a CRC of all of EEPROM as a hash that may contain some entropy, particularly across restarts.
-uint16_t eeCRC();
+// With stride > 1 only every stride-th byte is hashed, to save time at boot.
+uint16_t eeCRC(uint8_t stride = 1);
+
+// Strides used by seedPRNGs(); a board may define larger values to shorten boot,
+// eg from a brown-out reset, at the cost of sampling less of memory.
+// The designated seed bytes in EEPROM are always added to the pool in full.
+#ifndef V0P2BASE_SEED_SRAM_CRC_STRIDE
+#define V0P2BASE_SEED_SRAM_CRC_STRIDE 1
+#endif
+#ifndef V0P2BASE_SEED_EE_CRC_STRIDE
+#define V0P2BASE_SEED_EE_CRC_STRIDE 1
+#endif
 
 // Seed PRNGs and entropy pool.
 // Scrapes entropy from SRAM and EEPROM and some I/O (safely).
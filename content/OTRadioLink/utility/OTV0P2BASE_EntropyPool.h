@@ -0,0 +1,205 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Pooled secure random bytes.
+
+ Gathering entropy from clock jitter (see clockJitterEntropyByte())
+ can take many milliseconds per byte, which is painful when
+ an ID or a nonce is wanted right now.
+
+ SecureRandomPool instead seeds a DRBG (ChaCha20 with fast key erasure)
+ from a slow true-random source, such as clock jitter or a hardware TRNG,
+ and keeps a small buffer of output bytes topped up during idle time,
+ so that callers can usually take bytes at once.
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_ENTROPYPOOL_H
+#define OTV0P2BASE_ENTROPYPOOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+namespace OTV0P2BASE
+{
+
+
+// ChaCha20 block function (RFC 8439 section 2.3).
+// Writes 64 bytes of keystream for the given key, block counter and nonce.
+//   * key  32 bytes
+//   * nonce  12 bytes
+//   * out  64 bytes
+inline void chacha20Block(const uint8_t *const key, const uint32_t counter, const uint8_t *const nonce, uint8_t *const out)
+    {
+    struct Local
+        {
+        static uint32_t le32(const uint8_t *const p)
+            { return(uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24)); }
+        static uint32_t rotl(const uint32_t v, const uint8_t n) { return((v << n) | (v >> (32 - n))); }
+        static void qr(uint32_t *const x, const uint8_t a, const uint8_t b, const uint8_t c, const uint8_t d)
+            {
+            x[a] += x[b]; x[d] = rotl(x[d] ^ x[a], 16);
+            x[c] += x[d]; x[b] = rotl(x[b] ^ x[c], 12);
+            x[a] += x[b]; x[d] = rotl(x[d] ^ x[a], 8);
+            x[c] += x[d]; x[b] = rotl(x[b] ^ x[c], 7);
+            }
+        // Word i of the initial state.
+        static uint32_t in(const uint8_t i, const uint8_t *const k, const uint32_t ctr, const uint8_t *const n)
+            {
+            static const uint32_t sigma[4] = { 0x61707865, 0x3320646e, 0x79622d32, 0x6b206574 };
+            if(i < 4) { return(sigma[i]); }
+            if(i < 12) { return(le32(k + 4*(i-4))); }
+            if(12 == i) { return(ctr); }
+            return(le32(n + 4*(i-13)));
+            }
+        };
+    uint32_t x[16];
+    for(uint8_t i = 0; i < 16; ++i) { x[i] = Local::in(i, key, counter, nonce); }
+    for(uint8_t r = 0; r < 10; ++r)
+        {
+        Local::qr(x, 0, 4, 8, 12); Local::qr(x, 1, 5, 9, 13); Local::qr(x, 2, 6, 10, 14); Local::qr(x, 3, 7, 11, 15);
+        Local::qr(x, 0, 5, 10, 15); Local::qr(x, 1, 6, 11, 12); Local::qr(x, 2, 7, 8, 13); Local::qr(x, 3, 4, 9, 14);
+        }
+    for(uint8_t i = 0; i < 16; ++i)
+        {
+        const uint32_t v = x[i] + Local::in(i, key, counter, nonce);
+        out[4*i] = uint8_t(v); out[4*i+1] = uint8_t(v >> 8); out[4*i+2] = uint8_t(v >> 16); out[4*i+3] = uint8_t(v >> 24);
+        x[i] = 0; // Leave no key material on the stack.
+        }
+    }
+
+// Buffer of secure random bytes from a DRBG seeded from a slow true-random source.
+// The DRBG key absorbs all entropy offered via addEntropy() and from the source;
+// each refill() draws one further source byte, generates one ChaCha20 block,
+// replaces the key with the first half and buffers (up to) the second half,
+// so that earlier output cannot be recovered from a later state.
+// No bytes are handed out until at least SEED_BITS of estimated entropy have been absorbed.
+// Not thread-safe nor usable from ISRs.
+//   * bufSize  bytes buffered for instant use; in [1,32]
+template<uint8_t bufSize = 16>
+class SecureRandomPool final
+    {
+    static_assert((bufSize > 0) && (bufSize <= 32), "bufSize must be in [1,32]");
+
+    public:
+        // Source of (true) random bytes, eg from clock jitter or a hardware TRNG.
+        typedef uint8_t (*source_fn_t)();
+        // Estimated entropy in bits needed before any output is released.
+        static constexpr uint8_t SEED_BITS = 128;
+
+    private:
+        static constexpr uint8_t KEY_BYTES = 32;
+
+        // Current DRBG key; entropy is XORed in as it arrives.
+        uint8_t key[KEY_BYTES];
+        // Next key byte to XOR entropy into.
+        uint8_t mixPos = 0;
+        // Estimated entropy absorbed, saturating at SEED_BITS.
+        uint8_t entropyBits = 0;
+        // Block counter, to separate blocks between key changes.
+        uint32_t blocks = 0;
+
+        // Bytes available; buf[0,avail) unused output.
+        uint8_t buf[bufSize];
+        uint8_t avail = 0;
+
+        const source_fn_t source;
+        // Estimated entropy per source byte, in [0,8].
+        const uint8_t sourceBits;
+
+        void mix(const uint8_t data)
+            {
+            key[mixPos] ^= data;
+            if(++mixPos >= KEY_BYTES) { mixPos = 0; }
+            }
+
+    public:
+        //   * source_  slow true-random source, or NULL to rely on addEntropy() alone
+        //   * sourceBits_  conservative estimate of entropy per source byte in [0,8]
+        explicit SecureRandomPool(const source_fn_t source_ = NULL, const uint8_t sourceBits_ = 4)
+          : key(), buf(), source(source_), sourceBits((sourceBits_ > 8) ? 8 : sourceBits_) { }
+
+        // Mix in a byte along with an estimate of its real entropy in bits, in [0,8].
+        void addEntropy(const uint8_t data, const uint8_t estBits)
+            {
+            mix(data);
+            const uint16_t b = uint16_t(entropyBits) + ((estBits > 8) ? 8 : estBits);
+            entropyBits = (b > SEED_BITS) ? SEED_BITS : uint8_t(b);
+            }
+
+        // True once enough entropy has been absorbed to release output.
+        bool isSeeded() const { return(entropyBits >= SEED_BITS); }
+        // Bytes buffered and available at once.
+        uint8_t available() const { return(avail); }
+
+        // Top up the buffer; call from otherwise idle time.
+        // If not yet seeded, first draws from the source until seeded
+        // (which may be slow, eg ~32 jitter bytes);
+        // otherwise draws one fresh source byte per call.
+        // Does nothing if the buffer is already full.
+        // Returns the number of bytes now available.
+        uint8_t refill()
+            {
+            if(avail >= bufSize) { return(avail); }
+            if(NULL != source)
+                {
+                if(0 == sourceBits) { mix(source()); }
+                else { do { addEntropy(source(), sourceBits); } while(!isSeeded()); }
+                }
+            if(!isSeeded()) { return(avail); }
+            static const uint8_t nonce[12] = { };
+            uint8_t block[64];
+            chacha20Block(key, blocks++, nonce, block);
+            for(uint8_t i = 0; i < KEY_BYTES; ++i) { key[i] = block[i]; }
+            while(avail < bufSize) { buf[avail] = block[KEY_BYTES + avail]; ++avail; }
+            for(uint8_t i = 0; i < sizeof(block); ++i) { block[i] = 0; }
+            return(avail);
+            }
+
+        // Take one byte from the buffer; returns false if none is available.
+        bool get(uint8_t &out)
+            {
+            if(0 == avail) { return(false); }
+            out = buf[--avail];
+            buf[avail] = 0; // Never hand out the same byte twice.
+            return(true);
+            }
+
+        // Fill out[0,len) with secure random bytes, refilling from the DRBG as needed.
+        // Returns false, leaving out unspecified, if the pool could not be seeded.
+        bool get(uint8_t *const out, const uint8_t len)
+            {
+            for(uint8_t i = 0; i < len; ++i)
+                {
+                if((0 == avail) && (0 == refill())) { return(false); }
+                get(out[i]);
+                }
+            return(true);
+            }
+
+        // Discard buffered output, eg after restoring state that might have been copied.
+        void discard() { while(0 != avail) { buf[--avail] = 0; } }
+    };
+
+
+}
+
+#endif
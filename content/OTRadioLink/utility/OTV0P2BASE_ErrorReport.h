@@ -33,6 +33,12 @@ Author(s) / Copyright (s): Damon Hart-Davis 2017--2018
 namespace OTV0P2BASE
 {
 
+#if defined(OTV0P2BASE_EVENT_LOG) && defined(ARDUINO_ARCH_AVR)
+// OT_EVENT() hook from OTV0P2BASE_EventLog.h,
+// declared here to avoid an include cycle through OTV0P2BASE_EEPROM.h.
+void eventLogRecord(int8_t code, uint8_t arg);
+#endif
+
 /*
  Simple low-frequency error reporting.
 
@@ -57,6 +63,9 @@ namespace OTV0P2BASE
 
  Error values are aged with read().
 
+ Each change of value is also logged as an event (see OTV0P2BASE_EventLog.h)
+ so that intermittent errors leave a history.
+
  When an error has aged the 'Actuator' marks itself as unavailable
  to automatically disappear from stats reports for example.
 
@@ -170,6 +179,10 @@ class ErrorReport final : public OTV0P2BASE::Actuator<int8_t>
           {
           if((newValue > 0) || isAged())
               {
+#if defined(OTV0P2BASE_EVENT_LOG) && defined(ARDUINO_ARCH_AVR)
+              // Keep a history of changes in the event log.
+              if(newValue != value) { eventLogRecord(newValue, 0); }
+#endif
               value = newValue;
               timeoutTicks.store(DEFAULT_TIMEOUT);
               return(true);
@@ -0,0 +1,63 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Persistent binary error/event log.
+ */
+
+#include "OTV0P2BASE_EventLog.h"
+
+#include "OTV0P2BASE_Concurrency.h"
+#include "OTV0P2BASE_RTC.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+#if defined(OTV0P2BASE_EVENT_LOG) && defined(ARDUINO_ARCH_AVR)
+static EEPROMSmartStore eventLogStore;
+// Global instance.
+EventLog<EEPROMSmartStore> eventLog(eventLogStore, V0P2BASE_EE_START_EVENT_LOG, V0P2BASE_EE_EVENT_LOG_SLOTS);
+
+uint16_t eventLogNow()
+    {
+    return(uint16_t(((getDaysSince1999LT() % 45) * 1440U) + getMinutesSinceMidnightLT()));
+    }
+
+void eventLogRecord(const int8_t code, const uint8_t arg)
+    {
+    const uint16_t now = eventLogNow();
+    RAII_AtomicBlock atomic;
+    eventLog.log(code, arg, now);
+    }
+
+void eventLogFlush()
+    {
+    EventRecord buf[decltype(eventLog)::RAM_RECORDS];
+    uint8_t n;
+        {
+        RAII_AtomicBlock atomic;
+        n = eventLog.takePending(buf);
+        }
+    eventLog.append(buf, n);
+    }
+#endif // defined(OTV0P2BASE_EVENT_LOG) && defined(ARDUINO_ARCH_AVR)
+
+
+}
@@ -0,0 +1,296 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Persistent binary error/event log.
+
+ ErrorReport only holds the latest error/warning,
+ so intermittent faults (eg overruns, motor errors) leave no history.
+ OT_EVENT(code, arg) records a fixed 4-byte (time, code, arg) event into a small RAM ring;
+ flush() then appends any pending events to a ring in EEPROM in one batch,
+ each slot being written in turn so that wear is spread over the whole area.
+ The log can be read with the CLI::DumpEvents command
+ and summarised in stats with putEventLogStats().
+
+ Codes are normally ErrorReport::errorCatalogue values;
+ ErrorReport logs each change of its error/warning value.
+ Code 0 (ERR_NONE) is reserved and never logged.
+
+ Logging is enabled by defining OTV0P2BASE_EVENT_LOG for the whole (AVR) build;
+ otherwise OT_EVENT() compiles to nothing and its arguments are not evaluated.
+
+ Portable, with the store supplied as for EEPROMWriteJournal.
+ */
+
+#ifndef OTV0P2BASE_EVENTLOG_H
+#define OTV0P2BASE_EVENTLOG_H
+
+#include <stdint.h>
+
+#include "OTV0P2BASE_EEPROMJournal.h"
+#include "OTV0P2BASE_Sensor.h"
+
+#if defined(OTV0P2BASE_EVENT_LOG) && defined(ARDUINO_ARCH_AVR)
+// Log event code (eg an ErrorReport::errorCatalogue value) with an 8-bit argument.
+// ISR-safe.
+#define OT_EVENT(code, arg) ::OTV0P2BASE::eventLogRecord(int8_t(code), uint8_t(arg))
+#else
+#define OT_EVENT(code, arg) do { } while(false)
+#endif
+
+
+namespace OTV0P2BASE
+{
+
+
+// One logged event, packed as 4 bytes in EEPROM: time (LSB first), code, arg.
+struct EventRecord final
+    {
+    // Caller-supplied timestamp, eg minutes modulo ~45 days (see eventLogNow()).
+    uint16_t time;
+    // Event code, never 0.
+    int8_t code;
+    // Code-specific argument.
+    uint8_t arg;
+    };
+static constexpr uint8_t EVENT_RECORD_BYTES = 4;
+
+// Events in a RAM ring of ramRecords awaiting flush() into an EEPROM ring of nSlots records.
+// When the RAM ring is full the oldest pending event is dropped and counted.
+//
+// The EEPROM ring always has one 'hole' slot (code byte 0) just after the newest record,
+// so holds up to nSlots-1 records; the hole marks where to append after a restart.
+// A flush writes its records and only then moves the hole,
+// so that on a reset part-way through some records may be out of order but none are lost.
+// Never-written (all 0xff) slots are empty.
+// Not thread-/ISR- safe; the global hooks lock out interrupts around log() and takePending().
+//
+//   * store_t  EEPROMSmartStore, or a mock for testing
+//   * ramRecords  in [1,32]
+template<class store_t, uint8_t ramRecords = 8>
+class EventLog final
+    {
+    static_assert((ramRecords >= 1) && (ramRecords <= 32), "ramRecords must be in [1,32]");
+
+    public:
+        // Capacity of the RAM ring, eg to size a takePending() buffer.
+        static constexpr uint8_t RAM_RECORDS = ramRecords;
+
+    private:
+        store_t &store;
+        const uintptr_t start;
+        const uint8_t nSlots;
+
+        // Pending events; the oldest at ramTail.
+        EventRecord ram[ramRecords];
+        uint8_t ramTail = 0;
+        uint8_t ramCount = 0;
+        // Events dropped before being flushed; saturates at 255.
+        uint8_t dropped = 0;
+        // Events logged since start-up; saturates at 65535.
+        uint16_t total = 0;
+        // Code of the most recent event, 0 if none.
+        int8_t lastCode = 0;
+
+        // Hole slot, or nSlots until found.
+        uint8_t hole;
+
+        uintptr_t slotAddr(const uint8_t slot) const { return(start + (uintptr_t(slot) * EVENT_RECORD_BYTES)); }
+        uint8_t codeByte(const uint8_t slot) const { return(store.read(slotAddr(slot) + 2)); }
+        bool isErased(const uint8_t slot) const
+            {
+            const uintptr_t a = slotAddr(slot);
+            for(uint8_t i = 0; i < EVENT_RECORD_BYTES; ++i) { if(0xff != store.read(a + i)) { return(false); } }
+            return(true);
+            }
+        // True if the slot holds a record.
+        bool isRecord(const uint8_t slot) const { return((0 != codeByte(slot)) && !isErased(slot)); }
+
+        // The hole, else (once after a reset mid-flush, or on a fresh area) the first erased slot, else 0.
+        uint8_t findHole()
+            {
+            if(hole < nSlots) { return(hole); }
+            uint8_t firstErased = nSlots;
+            for(uint8_t i = 0; i < nSlots; ++i)
+                {
+                if(0 == codeByte(i)) { hole = i; return(hole); }
+                if((nSlots == firstErased) && isErased(i)) { firstErased = i; }
+                }
+            hole = (nSlots == firstErased) ? 0 : firstErased;
+            return(hole);
+            }
+
+        void write(const uint8_t slot, const EventRecord &r)
+            {
+            const uintptr_t a = slotAddr(slot);
+            store.update(a, uint8_t(r.time));
+            store.update(a + 1, uint8_t(r.time >> 8));
+            store.update(a + 3, r.arg);
+            // Code last, as it may be overwriting the hole marker.
+            store.update(a + 2, uint8_t(r.code));
+            }
+
+    public:
+        //   * start_  first of the nSlots_*EVENT_RECORD_BYTES bytes reserved, eg V0P2BASE_EE_START_EVENT_LOG
+        //   * nSlots_  in [2,255]
+        EventLog(store_t &store_, const uintptr_t start_, const uint8_t nSlots_)
+          : store(store_), start(start_), nSlots((nSlots_ < 2) ? 2 : nSlots_), ram(), hole(nSlots) { }
+
+        // Log an event at time; code 0 is ignored.
+        void log(const int8_t code, const uint8_t arg, const uint16_t time)
+            {
+            if(0 == code) { return; }
+            if(ramCount >= ramRecords)
+                {
+                // Drop the oldest pending.
+                ramTail = uint8_t((ramTail + 1) % ramRecords);
+                --ramCount;
+                if(dropped < 255) { ++dropped; }
+                }
+            EventRecord &r = ram[(ramTail + ramCount) % ramRecords];
+            r.time = time;
+            r.code = code;
+            r.arg = arg;
+            ++ramCount;
+            if(total < 65535U) { ++total; }
+            lastCode = code;
+            }
+
+        // Events logged but not yet flushed.
+        uint8_t pending() const { return(ramCount); }
+        // Events lost before being flushed, from RAM overflow or a flush larger than the EEPROM ring.
+        uint8_t getDropped() const { return(dropped); }
+        // Events logged since start-up, saturating.
+        uint16_t getTotal() const { return(total); }
+        // Code of the most recent event since start-up, or 0 if none.
+        int8_t getLastCode() const { return(lastCode); }
+        // Maximum records held in EEPROM.
+        uint8_t capacity() const { return(uint8_t(nSlots - 1)); }
+
+        // Move all pending events, oldest first, into buf of at least RAM_RECORDS; returns the number moved.
+        // Quick, so can be done with interrupts locked out.
+        uint8_t takePending(EventRecord *const buf)
+            {
+            const uint8_t n = ramCount;
+            for(uint8_t i = 0; i < n; ++i) { buf[i] = ram[(ramTail + i) % ramRecords]; }
+            ramTail = 0;
+            ramCount = 0;
+            return(n);
+            }
+
+        // Append n events, oldest first, to EEPROM in one batch.
+        // If more than capacity() only the newest are kept and the rest counted as dropped.
+        // Returns the number written.
+        uint8_t append(const EventRecord *buf, uint8_t n)
+            {
+            if(n > capacity())
+                {
+                const uint8_t skip = uint8_t(n - capacity());
+                dropped = uint8_t(((dropped + skip) > 255) ? 255 : (dropped + skip));
+                buf += skip;
+                n = capacity();
+                }
+            if(0 == n) { return(0); }
+            uint8_t h = findHole();
+            for(uint8_t i = 0; i < n; ++i)
+                {
+                write(h, buf[i]);
+                h = uint8_t((h + 1) % nSlots);
+                }
+            store.update(slotAddr(h) + 2, 0);
+            hole = h;
+            return(n);
+            }
+
+        // Append all pending events to EEPROM in one batch, eg at a quiet point in the minor cycle.
+        // Returns the number written.
+        uint8_t flush()
+            {
+            EventRecord buf[RAM_RECORDS];
+            return(append(buf, takePending(buf)));
+            }
+
+        // Number of records in EEPROM.
+        uint8_t size()
+            {
+            uint8_t n = 0;
+            for(uint8_t i = 0; i < nSlots; ++i) { if(isRecord(i)) { ++n; } }
+            return(n);
+            }
+
+        // Get the i-th oldest record in EEPROM into r; returns false if i >= size().
+        // Does not include pending events.
+        bool get(const uint8_t i, EventRecord &r)
+            {
+            const uint8_t h = findHole();
+            uint8_t n = 0;
+            for(uint8_t k = 1; k <= nSlots; ++k)
+                {
+                const uint8_t s = uint8_t((h + k) % nSlots);
+                if(!isRecord(s)) { continue; }
+                if(n++ != i) { continue; }
+                const uintptr_t a = slotAddr(s);
+                r.time = uint16_t(store.read(a) | (uint16_t(store.read(a + 1)) << 8));
+                r.code = int8_t(store.read(a + 2));
+                r.arg = store.read(a + 3);
+                return(true);
+                }
+            return(false);
+            }
+
+        // Erase the EEPROM ring and discard pending events and counts.
+        void clear()
+            {
+            for(uintptr_t a = slotAddr(0); a < slotAddr(0) + (uintptr_t(nSlots) * EVENT_RECORD_BYTES); ++a)
+                { store.update(a, 0xff); }
+            hole = nSlots;
+            ramTail = 0;
+            ramCount = 0;
+            dropped = 0;
+            total = 0;
+            lastCode = 0;
+            }
+    };
+
+// Add an event log summary to stats as low priority:
+// events since start-up "ev" and the most recent code "evL" (sent only if any).
+//   * ss  stats, eg a SimpleStatsRotation
+template<class stats_t, class eventLog_t>
+void putEventLogStats(stats_t &ss, const eventLog_t &l)
+    {
+    ss.put(V0p2_SENSOR_TAG_F("ev"), int16_t(l.getTotal() & 0x7fff), true);
+    if(0 != l.getLastCode()) { ss.put(V0p2_SENSOR_TAG_F("evL"), int16_t(l.getLastCode()), true); }
+    }
+
+#if defined(OTV0P2BASE_EVENT_LOG) && defined(ARDUINO_ARCH_AVR)
+// The global log in V0P2BASE_EE_START_EVENT_LOG, fed by OT_EVENT().
+extern EventLog<EEPROMSmartStore> eventLog;
+// Current event time: local minutes modulo 45 days (64800 minutes).
+uint16_t eventLogNow();
+// Hook; use via the macro.
+// ISR-safe.
+void eventLogRecord(int8_t code, uint8_t arg);
+// Flush pending events to EEPROM, eg once per minor cycle at a quiet point.
+// Not ISR-safe.
+void eventLogFlush();
+#endif
+
+
+}
+
+#endif
@@ -19,18 +19,126 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015
 /*
   Fast GPIO with minimal run-time look-up for V0p2 boards.
   Also accurate micro delays for bit-banging time-sensitive protocols.
+
+  Pin to port/bit mapping is constexpr for:
+    * ATmega328P (all V0p2 boards), using Arduino pin numbers;
+    * EFR32, using pin numbers made with efr32Pin(port, bit), eg efr32Pin(gpioPortA, 5).
+  FastPinGroup updates several pins on one port in one atomic write,
+  eg for SPI select and clock lines.
   */
 
 #ifndef OTV0P2BASE_FASTDIGITALIO_H
 #define OTV0P2BASE_FASTDIGITALIO_H
 
+#include <stdint.h>
+
 #ifdef ARDUINO
 #include <Arduino.h>
 #endif
+#ifdef ARDUINO_ARCH_AVR
+#include <util/atomic.h>
+#endif
+#ifdef EFR32FG1P133F256GM48
+extern "C" {
+#include "em_device.h"
+#include "em_gpio.h"
+}
+#endif
 
 namespace OTV0P2BASE
 {
 
+// Pin to port/bit mapping for ATmega328P Arduino pin numbers.
+// Ports are numbered 0 for D (pins 0--7), 1 for B (8--13), 2 for C (14--19 ADC/AI).
+// Portable so that it can be checked off target.
+struct FastPinMapATmega328P final
+    {
+    static constexpr uint8_t invalidPort = 0xff;
+    static constexpr uint8_t port(const uint8_t pin)
+        { return((pin < 8) ? 0 : ((pin < 14) ? 1 : ((pin < 20) ? 2 : invalidPort))); }
+    static constexpr uint8_t bit(const uint8_t pin)
+        { return((pin < 8) ? pin : ((pin < 14) ? uint8_t(pin - 8) : ((pin < 20) ? uint8_t(pin - 14) : 0))); }
+    static constexpr uint16_t mask(const uint8_t pin)
+        { return((port(pin) == invalidPort) ? 0 : uint16_t(1U << bit(pin))); }
+    };
+
+// Pin to port/bit mapping for EFR32 GPIO, with pins numbered by efr32Pin().
+// Portable so that it can be checked off target.
+struct FastPinMapEFR32 final
+    {
+    static constexpr uint8_t invalidPort = 0xff;
+    // Largest port number; EFR32 series 1 has ports A to L.
+    static constexpr uint8_t maxPort = 11;
+    static constexpr uint8_t port(const uint8_t pin)
+        { return(((pin >> 4) <= maxPort) ? uint8_t(pin >> 4) : invalidPort); }
+    static constexpr uint8_t bit(const uint8_t pin) { return(pin & 0xf); }
+    static constexpr uint16_t mask(const uint8_t pin)
+        { return((port(pin) == invalidPort) ? 0 : uint16_t(1U << bit(pin))); }
+    };
+// Pin number for bit [0,15] of EFR32 GPIO port (eg gpioPortA).
+constexpr uint8_t efr32Pin(const uint8_t port, const uint8_t bit) { return(uint8_t((port << 4) | (bit & 0xf))); }
+
+// Mapping for the target, or ATmega328P (V0p2) off target.
+#ifdef EFR32FG1P133F256GM48
+typedef FastPinMapEFR32 FastPinMap;
+#else
+typedef FastPinMapATmega328P FastPinMap;
+#endif
+
+// Several pins on one port, written together in one atomic update,
+// eg to drive SPI nSS and SCK together without an intervening ISR.
+// All pins must be constant, valid, and on the same port, else compilation fails.
+// Pins set high are given by a mask of bitOf() values.
+//   * map_t  FastPinMapATmega328P or FastPinMapEFR32
+template<class map_t, uint8_t pin0, uint8_t... pins>
+class FastPinGroupT final
+    {
+    private:
+        static constexpr bool onPort(const uint8_t /*p*/) { return(true); }
+        template<typename... Ts>
+        static constexpr bool onPort(const uint8_t p, const uint8_t first, const Ts... rest)
+            { return((map_t::port(first) == p) && onPort(p, rest...)); }
+        static constexpr uint16_t maskOf() { return(0); }
+        template<typename... Ts>
+        static constexpr uint16_t maskOf(const uint8_t first, const Ts... rest)
+            { return(uint16_t(map_t::mask(first) | maskOf(rest...))); }
+
+    public:
+        // Port number as from map_t.
+        static constexpr uint8_t port = map_t::port(pin0);
+        // Bits of the port in the group.
+        static constexpr uint16_t mask = maskOf(pin0, pins...);
+        // Bit of the port for pin, to combine into values for write().
+        static constexpr uint16_t bitOf(const uint8_t pin) { return(map_t::mask(pin)); }
+
+        static_assert(port != map_t::invalidPort, "invalid pin");
+        static_assert(onPort(port, pins...), "all pins must be on the same port");
+
+#if defined(ARDUINO_ARCH_AVR) && defined(__AVR_ATmega328P__)
+        // Drive pins whose bits are set in values HIGH and the rest of the group LOW, atomically.
+        static void write(const uint16_t values)
+            {
+            static_assert(sizeof(map_t) && (port <= 2), "ATmega328P ports only");
+            volatile uint8_t &r = (0 == port) ? PORTD : ((1 == port) ? PORTB : PORTC);
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { r = uint8_t((r & ~mask) | (values & mask)); }
+            }
+#define OTV0P2BASE_FASTPINGROUP_WRITE_AVAILABLE
+#elif defined(EFR32FG1P133F256GM48)
+        // Drive pins whose bits are set in values HIGH and the rest of the group LOW, atomically.
+        static void write(const uint16_t values)
+            {
+            const uint32_t primask = __get_PRIMASK();
+            __disable_irq();
+            GPIO_PortOutSetVal(GPIO_Port_TypeDef(port), values, mask);
+            __set_PRIMASK(primask);
+            }
+#define OTV0P2BASE_FASTPINGROUP_WRITE_AVAILABLE
+#endif
+    };
+// FastPinGroupT for the target's pin numbering.
+template<uint8_t pin0, uint8_t... pins>
+using FastPinGroup = FastPinGroupT<FastPinMap, pin0, pins...>;
+
 // Fast read of digital pins where pin number is constant.
 // Avoids lots of logic (many 10s of CPU cycles) in normal digitalRead()/digitalWrite() calls,
 // and this saves time and energy on (critical) paths polling I/O.
@@ -84,6 +192,13 @@ namespace OTV0P2BASE
 #define fastDigitalRead(pin) digitalRead((pin)) // Don't know about other AVRs.
 #define fastDigitalWrite(pin, value) digitalWrite((pin), (value)) // Don't know about other AVRs.
 #endif // __AVR_ATmega328P__
+#elif defined(EFR32FG1P133F256GM48)
+// Pins are numbered with efr32Pin(); DIN and the DOUT set/clear are single accesses.
+#define fastDigitalRead(pin) \
+    ((int) ((GPIO->P[OTV0P2BASE::FastPinMapEFR32::port((pin))].DIN >> OTV0P2BASE::FastPinMapEFR32::bit((pin))) & 1))
+#define fastDigitalWrite(pin, value) do { \
+    if(value) { GPIO_PinOutSet(GPIO_Port_TypeDef(OTV0P2BASE::FastPinMapEFR32::port((pin))), OTV0P2BASE::FastPinMapEFR32::bit((pin))); } \
+    else { GPIO_PinOutClear(GPIO_Port_TypeDef(OTV0P2BASE::FastPinMapEFR32::port((pin))), OTV0P2BASE::FastPinMapEFR32::bit((pin))); } } while(false)
 #endif // ARDUINO_ARCH_AVR
 
 }
@@ -0,0 +1,129 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Fast integer to ASCII formatting for stats and status output.
+ */
+
+#ifdef ARDUINO_ARCH_AVR
+#include <avr/pgmspace.h>
+#endif
+
+#include "OTV0P2BASE_ArduinoCompat.h"
+#include "OTV0P2BASE_FastFormat.h"
+
+namespace OTV0P2BASE
+{
+
+
+// "00" to "99" in order, so digits for n in [0,99] are at 2*n.
+static const char digitPairs[201]
+#ifdef ARDUINO_ARCH_AVR
+    PROGMEM
+#endif
+    =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Write the two digits of v in [0,99], including any leading zero.
+static inline char *pair(char *const p, const uint8_t v)
+    {
+    const char *const s = digitPairs + 2*v;
+    p[0] = char(pgm_read_byte(s));
+    p[1] = char(pgm_read_byte(s + 1));
+    return(p + 2);
+    }
+
+// Write v in [0,999] without leading zeros.
+// (v * 41) >> 12 is v / 100 throughout that range.
+static char *upTo999(char *p, const uint16_t v)
+    {
+    if(v < 10) { *p++ = char('0' + v); return(p); }
+    if(v < 100) { return(pair(p, uint8_t(v))); }
+    const uint8_t h = uint8_t((v * 41U) >> 12);
+    *p++ = char('0' + h);
+    return(pair(p, uint8_t(v - (h * 100U))));
+    }
+
+char *formatU8(char *const buf, const uint8_t v)
+    {
+    char *const p = upTo999(buf, v);
+    *p = '\0';
+    return(p);
+    }
+
+char *formatU16(char *const buf, const uint16_t v)
+    {
+    char *p;
+    if(v < 1000) { p = upTo999(buf, v); }
+    else
+        {
+        // (v * 83887) >> 23 is v / 100 for all 16-bit v.
+        const uint16_t top = uint16_t((uint32_t(v) * 83887UL) >> 23);
+        p = pair(upTo999(buf, top), uint8_t(v - (top * 100U)));
+        }
+    *p = '\0';
+    return(p);
+    }
+
+char *formatI16(char *buf, const int16_t v)
+    {
+    if(v >= 0) { return(formatU16(buf, uint16_t(v))); }
+    *buf++ = '-';
+    // Negate as unsigned so that INT16_MIN is safe.
+    return(formatU16(buf, uint16_t(0U - uint16_t(v))));
+    }
+
+char *formatHex16(char *buf, const uint16_t v)
+    {
+    bool started = false;
+    for(int8_t shift = 12; shift >= 0; shift -= 4)
+        {
+        const uint8_t d = uint8_t((v >> shift) & 0xf);
+        if(!started && (0 == d) && (0 != shift)) { continue; }
+        started = true;
+        *buf++ = char((d < 10) ? ('0' + d) : ('A' + d - 10));
+        }
+    *buf = '\0';
+    return(buf);
+    }
+
+char *formatC16(char *buf, const int16_t c16)
+    {
+    if(c16 < 0) { *buf++ = '-'; }
+    const uint16_t mag = (c16 < 0) ? uint16_t(0U - uint16_t(c16)) : uint16_t(c16);
+    const uint16_t whole = mag >> 4;
+    // Tenths from the 16ths, rounded; 15/16 rounds to 0.9 so never carries.
+    const uint8_t tenths = uint8_t((((mag & 0xf) * 10U) + 8U) >> 4);
+    char *p = formatU16(buf, whole);
+    *p++ = '.';
+    *p++ = char('0' + tenths);
+    *p = '\0';
+    return(p);
+    }
+
+
+}
@@ -0,0 +1,66 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Fast integer to ASCII formatting for stats and status output.
+
+ Print::print(int) and friends convert with a generic divide-by-base loop,
+ which on the AVR (no hardware divide) costs a library division per digit.
+ These emit two digits at a time from a 200-byte digit-pair table (in Flash on AVR)
+ and divide by 100 with a multiply and shift,
+ so a 5-digit value costs two multiplies rather than five divisions.
+
+ Each routine writes to buf, '\0'-terminates, and returns a pointer to the '\0'
+ so that calls can be chained to build a line,
+ and formats exactly as Print::print() would in base 10
+ (no leading zeros, '-' for negative values).
+ buf must have room for the matching FORMAT_*_CHARS, including the '\0'.
+ */
+
+#ifndef OTV0P2BASE_FASTFORMAT_H
+#define OTV0P2BASE_FASTFORMAT_H
+
+#include <stdint.h>
+
+
+namespace OTV0P2BASE
+{
+
+
+// Worst-case buffer sizes including the trailing '\0'.
+static constexpr uint8_t FORMAT_U8_CHARS = 4;   // "255"
+static constexpr uint8_t FORMAT_U16_CHARS = 6;  // "65535"
+static constexpr uint8_t FORMAT_I16_CHARS = 7;  // "-32768"
+static constexpr uint8_t FORMAT_HEX16_CHARS = 5; // "FFFF"
+static constexpr uint8_t FORMAT_C16_CHARS = 8;  // "-2048.0"
+
+// Decimal, as Print::print(v).
+char *formatU8(char *buf, uint8_t v);
+char *formatU16(char *buf, uint16_t v);
+char *formatI16(char *buf, int16_t v);
+
+// Upper-case hex without leading zeros, as Print::print(v, 16).
+char *formatHex16(char *buf, uint16_t v);
+
+// C16 (16ths of a degree C) fixed-point temperature in decimal with one place,
+// rounded to the nearest tenth (halves away from zero), eg 296 (18.5C) as "18.5".
+char *formatC16(char *buf, int16_t c16);
+
+
+}
+#endif
@@ -0,0 +1,67 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ EFR32 flash pages for EEPROM emulation.
+ */
+
+#include "OTV0P2BASE_FlashEEPROM.h"
+
+#ifdef EFR32FG1P133F256GM48
+
+extern "C" {
+#include "em_device.h"
+#include "em_msc.h"
+}
+
+// Default to the last two pages of main flash, clear of the program image.
+#ifndef OTV0P2BASE_FLASH_EEPROM_BASE
+#define OTV0P2BASE_FLASH_EEPROM_BASE (FLASH_BASE + FLASH_SIZE - (2 * FLASH_PAGE_SIZE))
+#endif
+
+namespace OTV0P2BASE
+{
+
+
+static_assert(EFR32FlashPages::PAGE_BYTES == FLASH_PAGE_SIZE, "EFR32FlashPages::PAGE_BYTES must match the flash page size");
+
+static inline uint32_t *flashEEPROMWord(const uint8_t page, const uint16_t word)
+    { return(reinterpret_cast<uint32_t *>(OTV0P2BASE_FLASH_EEPROM_BASE + (uint32_t(page) * FLASH_PAGE_SIZE) + (uint32_t(word) * 4))); }
+
+uint32_t EFR32FlashPages::read(const uint8_t page, const uint16_t word) const
+    { return(*static_cast<volatile uint32_t *>(flashEEPROMWord(page, word))); }
+
+bool EFR32FlashPages::program(const uint8_t page, const uint16_t word, const uint32_t value)
+    { return(mscReturnOk == MSC_WriteWord(flashEEPROMWord(page, word), &value, 4)); }
+
+bool EFR32FlashPages::erase(const uint8_t page)
+    { return(mscReturnOk == MSC_ErasePage(flashEEPROMWord(page, 0))); }
+
+static EFR32FlashPages flashEEPROMPages;
+FlashEEPROM<EFR32FlashPages> flashEEPROM(flashEEPROMPages);
+
+bool flashEEPROMBegin()
+    {
+    MSC_Init();
+    return(flashEEPROM.begin());
+    }
+
+
+}
+
+#endif // EFR32FG1P133F256GM48
@@ -0,0 +1,343 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ EEPROM emulation in flash, eg for EFR32 builds which have no EEPROM.
+
+ Flash can only be erased a whole page at a time (~20ms on EFR32),
+ so emulating eeprom_smart_update_byte() with an erase per byte
+ would be slow and soon wear the flash out.
+ Instead FlashEEPROM keeps the whole emulated EEPROM in RAM,
+ so reads are at memory speed,
+ and marks updated bytes dirty in a RAM page buffer.
+ flush() appends one 32-bit (address, value) record per dirty byte
+ to a log in the active flash page, each a single word program.
+ When the log fills, compaction writes a snapshot of the RAM image
+ to the other (spare) page and then switches to it:
+ one page erase per ~250 flushed bytes rather than one per byte.
+ Compaction can be done a few words at a time from poll()
+ at quiet points of the cycle, before the log is full.
+
+ The address map is the same as for AVR EEPROM (V0P2BASE_EE_*),
+ and FlashEEPROM is a store (as for EEPROMWriteJournal),
+ so EventLog, ByHourByteStatsStore, etc, work over it unchanged.
+
+ Portable, with the flash supplied as a template parameter:
+ EFR32FlashPages on EFR32, FlashEEPROMMockFlash for unit tests.
+
+ Not thread-/ISR- safe.
+ */
+
+#ifndef OTV0P2BASE_FLASHEEPROM_H
+#define OTV0P2BASE_FLASHEEPROM_H
+
+#include <stdint.h>
+#include <string.h>
+
+
+namespace OTV0P2BASE
+{
+
+
+// Two pages of flash for FlashEEPROM, erased to all 1s and each word programmed at most once.
+// Implementations provide:
+//    static constexpr uint16_t PAGE_BYTES;
+//    uint32_t read(uint8_t page, uint16_t word) const;
+//    bool program(uint8_t page, uint16_t word, uint32_t value); // Can only clear bits.
+//    bool erase(uint8_t page); // Sets the whole page to 0xff.
+// with page in [0,1] and word in [0,PAGE_BYTES/4).
+
+// RAM flash for unit tests, with NOR flash rules and optional simulated power failure.
+template<uint16_t pageBytes = 2048>
+class FlashEEPROMMockFlash final
+    {
+    private:
+        uint32_t mem[2][pageBytes / 4];
+
+    public:
+        static constexpr uint16_t PAGE_BYTES = pageBytes;
+        // Page erases and word programs done.
+        uint16_t erases = 0;
+        uint32_t programs = 0;
+        // Writes (erases or programs) left before a simulated power failure,
+        // after which all writes are silently lost; negative for none.
+        int32_t writesUntilFailure = -1;
+
+        FlashEEPROMMockFlash() { memset(mem, 0xff, sizeof(mem)); }
+
+        uint32_t read(const uint8_t page, const uint16_t word) const { return(mem[page][word]); }
+        bool program(const uint8_t page, const uint16_t word, const uint32_t value)
+            {
+            if(failed()) { return(true); }
+            ++programs;
+            mem[page][word] &= value;
+            return(mem[page][word] == value);
+            }
+        bool erase(const uint8_t page)
+            {
+            if(failed()) { return(true); }
+            ++erases;
+            memset(mem[page], 0xff, sizeof(mem[page]));
+            return(true);
+            }
+
+    private:
+        bool failed()
+            {
+            if(writesUntilFailure < 0) { return(false); }
+            if(0 == writesUntilFailure) { return(true); }
+            --writesUntilFailure;
+            return(false);
+            }
+    };
+
+// Emulated EEPROM of eepromSize bytes (initially all 0xff) in two pages of flash.
+// Each page holds a header word (with a sequence number to find the newer page),
+// a snapshot of the whole image, then the log of records written since the snapshot.
+// A snapshot only counts once its header is written, after the rest of it,
+// so a reset part-way through compaction leaves the old page in use.
+// Updates since the last flush() are lost on reset.
+//   * flash_t  eg EFR32FlashPages
+//   * eepromSize  multiple of 4 up to 1024, eg V0P2BASE_EEPROM_SIZE on AVR
+//   * flushThreshold  dirty bytes at which update() itself flushes, to bound RAM-only state
+template<class flash_t, uint16_t eepromSize = 1024, uint16_t flushThreshold = 16>
+class FlashEEPROM final
+    {
+    static_assert((0 == (eepromSize % 4)) && (eepromSize <= 1024), "eepromSize must be a multiple of 4 up to 1024");
+    static_assert((flushThreshold >= 1) && (flushThreshold <= eepromSize), "flushThreshold out of range");
+
+    public:
+        static constexpr uint16_t PAGE_WORDS = flash_t::PAGE_BYTES / 4;
+        // First log word within a page.
+        static constexpr uint16_t LOG_START = 1 + (eepromSize / 4);
+        static_assert(PAGE_WORDS >= LOG_START + 16, "flash page too small for eepromSize");
+        // Records held by a page's log.
+        static constexpr uint16_t LOG_RECORDS = PAGE_WORDS - LOG_START;
+        // Log length at which poll() starts compaction.
+        static constexpr uint16_t COMPACT_AT = LOG_START + ((LOG_RECORDS * 3) / 4);
+
+    private:
+        // Valid headers have this in the top 16 bits and the sequence number in the bottom 16.
+        static constexpr uint32_t HEADER_MAGIC = 0xe5e50000UL;
+
+        flash_t &flash;
+
+        uint8_t image[eepromSize];
+        // Bit per byte awaiting flush().
+        uint8_t dirty[eepromSize / 8];
+        uint16_t nDirty = 0;
+
+        // Page in use and its sequence number.
+        uint8_t active = 0;
+        uint16_t seq = 0;
+        // Next free log word in the active page.
+        uint16_t logNext = LOG_START;
+
+        // True while the spare page is being filled; compactNext is the next snapshot word.
+        bool compacting = false;
+        bool spareErased = false;
+        uint16_t compactNext = 0;
+
+        // Compactions completed since begin().
+        uint16_t compactions = 0;
+
+        bool isDirty(const uint16_t a) const { return(0 != (dirty[a >> 3] & (1U << (a & 7)))); }
+        void setDirty(const uint16_t a) { if(!isDirty(a)) { dirty[a >> 3] |= uint8_t(1U << (a & 7)); ++nDirty; } }
+        void clearDirty(const uint16_t a) { if(isDirty(a)) { dirty[a >> 3] &= uint8_t(~(1U << (a & 7))); --nDirty; } }
+
+        // Record check byte; with addresses below 1024 no record is all 1s.
+        static constexpr uint8_t check(const uint16_t a, const uint8_t v)
+            { return(uint8_t(a ^ (a >> 8) ^ v ^ 0xa5)); }
+        static constexpr uint32_t record(const uint16_t a, const uint8_t v)
+            { return(uint32_t(a) | (uint32_t(v) << 16) | (uint32_t(check(a, v)) << 24)); }
+
+        // True if page has a valid header, with its sequence number in s.
+        bool validPage(const uint8_t page, uint16_t &s) const
+            {
+            const uint32_t h = flash.read(page, 0);
+            if(HEADER_MAGIC != (h & 0xffff0000UL)) { return(false); }
+            s = uint16_t(h);
+            return(true);
+            }
+
+        // Image word i, as for a snapshot.
+        uint32_t imageWord(const uint16_t i) const
+            {
+            const uint16_t a = uint16_t(i * 4);
+            return(uint32_t(image[a]) | (uint32_t(image[a+1]) << 8) | (uint32_t(image[a+2]) << 16) | (uint32_t(image[a+3]) << 24));
+            }
+
+        void startCompaction()
+            {
+            compacting = true;
+            spareErased = false;
+            compactNext = 0;
+            }
+
+        // Do up to maxWords of compaction, or the spare page erase; returns true when complete.
+        bool compactSome(uint16_t maxWords)
+            {
+            const uint8_t spare = uint8_t(1 - active);
+            if(!spareErased) { flash.erase(spare); spareErased = true; return(false); }
+            while((compactNext < (eepromSize / 4)) && (maxWords-- > 0))
+                {
+                const uint16_t i = compactNext++;
+                // These bytes are now in the snapshot,
+                // and are dirtied again if updated before the switch.
+                for(uint8_t k = 0; k < 4; ++k) { clearDirty(uint16_t((i * 4) + k)); }
+                const uint32_t w = imageWord(i);
+                // Erased words need no programming.
+                if(0xffffffffUL != w) { flash.program(spare, uint16_t(1 + i), w); }
+                }
+            if(compactNext < (eepromSize / 4)) { return(false); }
+            // Commit.
+            const uint16_t s = uint16_t(seq + 1);
+            flash.program(spare, 0, HEADER_MAGIC | s);
+            active = spare;
+            seq = s;
+            logNext = LOG_START;
+            compacting = false;
+            ++compactions;
+            return(true);
+            }
+
+    public:
+        explicit FlashEEPROM(flash_t &flash_) : flash(flash_) { memset(image, 0xff, sizeof(image)); memset(dirty, 0, sizeof(dirty)); }
+
+        // Load the image from flash, formatting it if neither page is valid.
+        // Call once at start-up before other use.
+        // Returns true if a valid image was found.
+        bool begin()
+            {
+            memset(image, 0xff, sizeof(image));
+            memset(dirty, 0, sizeof(dirty));
+            nDirty = 0;
+            compacting = false;
+            uint16_t s0 = 0, s1 = 0;
+            const bool v0 = validPage(0, s0);
+            const bool v1 = validPage(1, s1);
+            if(!v0 && !v1)
+                {
+                flash.erase(0);
+                flash.program(0, 0, HEADER_MAGIC);
+                active = 0;
+                seq = 0;
+                logNext = LOG_START;
+                return(false);
+                }
+            // After a reset just after compaction both are valid: use the newer.
+            active = (v1 && (!v0 || (int16_t(s1 - s0) > 0))) ? 1 : 0;
+            seq = active ? s1 : s0;
+            for(uint16_t i = 0; i < (eepromSize / 4); ++i)
+                {
+                const uint32_t w = flash.read(active, uint16_t(1 + i));
+                for(uint8_t k = 0; k < 4; ++k) { image[(i * 4) + k] = uint8_t(w >> (8 * k)); }
+                }
+            // Replay the log to its first unwritten word,
+            // skipping any record damaged by a reset while being written.
+            logNext = LOG_START;
+            while(logNext < PAGE_WORDS)
+                {
+                const uint32_t w = flash.read(active, logNext);
+                if(0xffffffffUL == w) { break; }
+                ++logNext;
+                const uint16_t a = uint16_t(w);
+                const uint8_t v = uint8_t(w >> 16);
+                if((a < eepromSize) && (uint8_t(w >> 24) == check(a, v))) { image[a] = v; }
+                }
+            return(true);
+            }
+
+        uint8_t read(const uintptr_t addr) const { return((addr < eepromSize) ? image[addr] : 0xff); }
+        // Returns true if the byte changed; flash is written by flush().
+        bool update(const uintptr_t addr, const uint8_t value)
+            {
+            if((addr >= eepromSize) || (value == image[addr])) { return(false); }
+            image[addr] = value;
+            setDirty(uint16_t(addr));
+            if(nDirty >= flushThreshold) { flush(); }
+            return(true);
+            }
+
+        // Persist all updated bytes to flash, completing any compaction.
+        // Returns the number of log records written.
+        uint16_t flush()
+            {
+            if(compacting) { while(!compactSome(PAGE_WORDS)) { } }
+            uint16_t n = 0;
+            for(uint16_t a = 0; (a < eepromSize) && (nDirty > 0); ++a)
+                {
+                if(!isDirty(a)) { continue; }
+                if(logNext >= PAGE_WORDS)
+                    {
+                    // Log full: the snapshot takes everything still dirty.
+                    startCompaction();
+                    while(!compactSome(PAGE_WORDS)) { }
+                    break;
+                    }
+                flash.program(active, logNext++, record(a, image[a]));
+                clearDirty(a);
+                ++n;
+                }
+            return(n);
+            }
+
+        // Background compaction: once the log is 3/4 full,
+        // do one page erase or up to maxWords snapshot words per call,
+        // eg once per minor cycle at a quiet point.
+        // Returns true while compaction is in progress.
+        bool poll(const uint16_t maxWords = 32)
+            {
+            if(!compacting)
+                {
+                if(logNext < COMPACT_AT) { return(false); }
+                startCompaction();
+                }
+            return(!compactSome(maxWords));
+            }
+
+        // Bytes updated but not yet flushed.
+        uint16_t pending() const { return(nDirty); }
+        // Log records left in the active page before compaction is forced.
+        uint16_t logFree() const { return(uint16_t(PAGE_WORDS - logNext)); }
+        uint16_t getCompactions() const { return(compactions); }
+        static constexpr uint16_t size() { return(eepromSize); }
+    };
+
+#ifdef EFR32FG1P133F256GM48
+// The last two 2kB pages of EFR32 main flash, via the MSC.
+// Override OTV0P2BASE_FLASH_EEPROM_BASE to move them.
+class EFR32FlashPages final
+    {
+    public:
+        static constexpr uint16_t PAGE_BYTES = 2048;
+        uint32_t read(uint8_t page, uint16_t word) const;
+        bool program(uint8_t page, uint16_t word, uint32_t value);
+        bool erase(uint8_t page);
+    };
+
+// The emulated EEPROM for the V0P2BASE_EE_* address map.
+extern FlashEEPROM<EFR32FlashPages> flashEEPROM;
+// Initialise the MSC and load flashEEPROM; call once at start-up.
+bool flashEEPROMBegin();
+#endif // EFR32FG1P133F256GM48
+
+
+}
+
+#endif
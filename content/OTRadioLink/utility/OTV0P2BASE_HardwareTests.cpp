@@ -177,76 +177,53 @@ bool check32768HzOscExtended()
             96
             92
  */
+uint8_t measureInternalOscWithExtOsc()
+{
+    // Give up waiting for an edge after several ticks' worth of tight spinning.
+    constexpr uint16_t maxSpins = 8000;
+    uint8_t count = 0;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        // Wait for edge on xtal counter edge.
+        const uint8_t t0 = TCNT2;
+        const uint8_t t1 = t0 + 1;
+        uint16_t spins = 0;
+        while(t0 == TCNT2) { if(++spins > maxSpins) { return(0); } }
+        // Start counting cycles.
+        do {
+            if(0 == ++count) { return(0); } // 2 cycles?
+            // 8*4 = 32 cycles per count.
+            _delay_x4cycles(8);
+        // Repeat loop until TCNT2 increments.
+        } while (TCNT2 == t1); // 2 cycles?
+    }
+    return(count);
+}
+
 bool calibrateInternalOscWithExtOsc()
 {
     // todo these should probably go somewhere else but not sure where.
-	constexpr uint8_t maxTries = 128;  // Maximum number of values to attempt.
-//	constexpr uint8_t initOscCal = 0;  // Initial oscillator calibration value to start from.
-	// TCNT2 overflows every 2 seconds. One tick is 2000/256 = 7.815 ms, or 7815 clock cycles at 1 MHz.
-	// Minimum number of cycles we want per count is (7815*1.1)/255 = 34, to give some play in case the clock is too fast.
-	constexpr uint16_t cyclesPerTick = 7815;
-	constexpr uint8_t innerLoopTime = 39;  // the number of cycles the inner loop takes to execute.
-	constexpr uint8_t targetCount = cyclesPerTick/innerLoopTime;  // The number of counts we are aiming for.
+    constexpr uint8_t maxTries = 128;  // Maximum number of values to attempt.
 
     // Check that the slow clock appears to be running.
     if(!check32768HzOsc()) { return(false); }
 
-    // Set initial calibration value and wait to settle.
-//    OSCCAL = initOscCal;
+    // Wait for the oscillator to settle.
     _delay_x4cycles(2); // > 8 us. max oscillator settling time is 5 us.
 
     // Calibration routine
     for(uint8_t i = 0; i < maxTries; i++)
-	{
-    	uint8_t count = 0;
-#if 0
-        OTV0P2BASE::serialPrintAndFlush("OSCCAL: "); // 10000001 on my test version
-        OTV0P2BASE::serialPrintAndFlush(OSCCAL, HEX);
-#endif // 1
-        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
-		{
-			// Wait for edge on xtal counter edge.
-			const uint8_t t0 = TCNT2;
-			const uint8_t t1 = TCNT2 + 1;
-			while(t0 == TCNT2) {}
-			// Start counting cycles.
-			do {
-				count++; // 2 cycles?
-				// 8*4 = 32 cycles per count.
-				_delay_x4cycles(8);
-            // Repeat loop until TCNT2 increments.
-			} while (TCNT2 == t1); // 2 cycles?
-		}
-#if 0
-        OTV0P2BASE::serialPrintAndFlush("\t count: ");
-        OTV0P2BASE::serialPrintAndFlush(count);
-        OTV0P2BASE::serialPrintAndFlush("\t mismatch: ");
-        OTV0P2BASE::serialPrintAndFlush(count - targetCount);
-        OTV0P2BASE::serialPrintAndFlush(F("\tUUUUU"));
-        OTV0P2BASE::serialPrintlnAndFlush();
-//        delay(1000);
-#endif // 1
+    {
+        const uint8_t count = measureInternalOscWithExtOsc();
+        if(0 == count) { return(false); }
         // Set new calibration value.
         if ((OSCCAL == 0x80) || (OSCCAL == 0xFF)) return false;  // Return false if OSCCAL is at limits.
-        if(count > targetCount) OSCCAL--;
-        else if(count < targetCount) OSCCAL++;
-        else {
-            return true;
-#if 0
-            while (true) {
-                OTV0P2BASE::serialPrintAndFlush("\t count: ");
-                OTV0P2BASE::serialPrintAndFlush(count);
-                OTV0P2BASE::serialPrintAndFlush("\t OSCCAL: ");
-                OTV0P2BASE::serialPrintAndFlush(OSCCAL, HEX);
-                OTV0P2BASE::serialPrintAndFlush(F("\tUUUUU"));
-                OTV0P2BASE::serialPrintlnAndFlush();
-                delay(1000);
-            }
-#endif // 0
-        }
+        if(count > INTERNAL_OSC_TARGET_COUNT) OSCCAL--;
+        else if(count < INTERNAL_OSC_TARGET_COUNT) OSCCAL++;
+        else { return true; }
         // Wait for oscillator to settle.
         _delay_x4cycles(2);
-	}
+    }
     return false;
 }
 #endif // ARDUINO_ARCH_AVR
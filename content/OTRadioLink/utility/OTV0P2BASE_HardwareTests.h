@@ -63,6 +63,18 @@ bool check32768HzOsc();
 bool check32768HzOscExtended();
 #endif
 
+#ifdef ARDUINO_ARCH_AVR
+// Target for measureInternalOscWithExtOsc() with a 1MHz CPU clock.
+// TCNT2 ticks every 2000/256 = 7.8125 ms, ie 7812 clock cycles at 1 MHz,
+// and each count of the measuring loop takes 39 cycles.
+static constexpr uint8_t INTERNAL_OSC_TARGET_COUNT = 7812 / 39;
+// Count the (39-cycle) loops the CPU (RC) clock makes in one tick of the 32768Hz crystal-driven Timer 2.
+// Higher than INTERNAL_OSC_TARGET_COUNT means the RC clock is fast.
+// Blocks interrupts for up to two Timer 2 ticks (~16ms).
+// Returns 0 if Timer 2 does not appear to be running or the count overflows.
+uint8_t measureInternalOscWithExtOsc();
+#endif
+
 #ifdef ARDUINO_ARCH_AVR
 /**
  * @brief   Calibrate the internal RC oscillator against and external 32786 Hz crystal oscillator or resonator. The target frequency is 1 MHz.
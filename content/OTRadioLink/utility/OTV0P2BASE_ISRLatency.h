@@ -0,0 +1,232 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Interrupt-masking and ISR entry latency measurement.
+
+ Code that runs with interrupts disabled marks itself with
+ OTV0P2BASE_IRQ_MASKED_SECTION(path) as the first statement of the masked scope,
+ and ISRs with OTV0P2BASE_ISR_SECTION(path), path being an ISRLatencyPath value.
+
+ On AVR builds with OTV0P2BASE_ISR_LATENCY_PROFILING defined,
+ a masked section drives the digital pin OTV0P2BASE_ISR_LATENCY_MASK_PIN high
+ for its duration (outermost section only, when nested),
+ and an ISR section does the same with OTV0P2BASE_ISR_LATENCY_ISR_PIN;
+ each costs one sbi/cbi pair.
+ Only paths whose bit is set in OTV0P2BASE_ISR_LATENCY_PATHS (default all)
+ drive the pins, so one code path at a time can be put on a scope
+ or logic analyser: the mask pin's longest high pulse is the max
+ interrupt-disabled time, and the time from the radio's nIRQ falling
+ to the ISR pin rising is the ISR entry latency.
+ Otherwise the marks compile to nothing.
+
+ ISRLatencyMonitor computes the same figures from timestamped events,
+ eg from a mock timer on the host, and checks them against bounds
+ such as rxFIFOHeadroomUs() for the RFM23B.
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_ISRLATENCY_H
+#define OTV0P2BASE_ISRLATENCY_H
+
+#include <stdint.h>
+
+#if defined(OTV0P2BASE_ISR_LATENCY_PROFILING) && defined(ARDUINO_ARCH_AVR)
+#include "OTV0P2BASE_FastDigitalIO.h"
+#ifndef OTV0P2BASE_ISR_LATENCY_PATHS
+#define OTV0P2BASE_ISR_LATENCY_PATHS 0xffffffffUL
+#endif
+#define OTV0P2BASE_IRQ_MASKED_SECTION(path) \
+    const ::OTV0P2BASE::ISRLatencyPinMark<OTV0P2BASE_ISR_LATENCY_MASK_PIN, (path)> _otIRQMaskedMark
+#define OTV0P2BASE_ISR_SECTION(path) \
+    const ::OTV0P2BASE::ISRLatencyPinMark<OTV0P2BASE_ISR_LATENCY_ISR_PIN, (path)> _otISRMark
+#else
+#define OTV0P2BASE_IRQ_MASKED_SECTION(path) do { } while(false)
+#define OTV0P2BASE_ISR_SECTION(path) do { } while(false)
+#endif
+
+
+namespace OTV0P2BASE
+{
+
+
+// Code paths for OTV0P2BASE_IRQ_MASKED_SECTION() and OTV0P2BASE_ISR_SECTION().
+// Applications may use values from APP upwards (below 32) for their own paths.
+namespace ISRLatencyPath
+    {
+    // No section, eg an IRQ that arrived with interrupts enabled.
+    static constexpr uint8_t NONE = 0;
+    // OTRFM23BLink::poll() draining the radio with interrupts masked.
+    static constexpr uint8_t RFM23B_POLL = 1;
+    // OTRFM23BLink::_handleInterruptNonVirtual() from the radio's nIRQ ISR.
+    static constexpr uint8_t RFM23B_ISR = 2;
+    // OTRFM23BLink burst read of the RX FIFO.
+    static constexpr uint8_t RFM23B_RXFIFO = 3;
+    // OTRFM23BLink mode and interrupt reconfiguration.
+    static constexpr uint8_t RFM23B_CTRL = 4;
+    // Bit-banged soft serial writing a byte.
+    static constexpr uint8_t SOFTSERIAL_TX = 5;
+    // Bit-banged soft serial reading a byte (or more).
+    static constexpr uint8_t SOFTSERIAL_RX = 6;
+    // First application-defined path.
+    static constexpr uint8_t APP = 16;
+    }
+
+#if defined(OTV0P2BASE_ISR_LATENCY_PROFILING) && defined(ARDUINO_ARCH_AVR)
+// Nesting depth of the sections driving pin, so only the outermost moves it.
+template<uint8_t pin>
+struct ISRLatencyPinDepth final { static uint8_t depth; };
+template<uint8_t pin> uint8_t ISRLatencyPinDepth<pin>::depth;
+
+// Holds pin high for its lifetime if path is selected by OTV0P2BASE_ISR_LATENCY_PATHS.
+// Use via OTV0P2BASE_IRQ_MASKED_SECTION() and OTV0P2BASE_ISR_SECTION(),
+// only where interrupts are already disabled.
+template<uint8_t pin, uint8_t path>
+class ISRLatencyPinMark final
+    {
+    static constexpr bool enabled = (0 != ((OTV0P2BASE_ISR_LATENCY_PATHS) & (1UL << path)));
+    public:
+        ISRLatencyPinMark()
+            { if(enabled && (0 == ISRLatencyPinDepth<pin>::depth++)) { fastDigitalWrite(pin, HIGH); } }
+        ~ISRLatencyPinMark()
+            { if(enabled && (0 == --ISRLatencyPinDepth<pin>::depth)) { fastDigitalWrite(pin, LOW); } }
+    };
+#endif
+
+// Time (us) before a receiver FIFO overruns once its almost-full interrupt is raised,
+// ie the worst ISR entry latency that the radio can tolerate.
+//   * fifoBytes  FIFO size, eg 64 for the RFM23B
+//   * thresholdBytes  almost-full threshold, eg the RFM23B default of 55
+//   * bitsPerSecond  over-the-air data rate, eg 57600
+constexpr uint32_t rxFIFOHeadroomUs(const uint8_t fifoBytes, const uint8_t thresholdBytes, const uint32_t bitsPerSecond)
+    { return((fifoBytes <= thresholdBytes) ? 0 : uint32_t((uint64_t(fifoBytes - thresholdBytes) * 8 * 1000000) / bitsPerSecond)); }
+
+// Worst acceptable figures for one path, in monitor ticks; 0 means unchecked.
+struct ISRLatencyBound final
+    {
+    uint8_t path;
+    uint32_t maxMaskedTicks;
+    uint32_t maxEntryLatencyTicks;
+    };
+
+// Max interrupt-disabled time and ISR entry latency per path from timestamped events.
+// Nested masked sections are counted against the outermost.
+// An IRQ raised while interrupts are masked is entered when the outermost section ends,
+// and its entry latency is counted against that section's path;
+// one raised with interrupts enabled is entered at once (path NONE)
+// unless isrEntered() is used to give the actual entry time.
+// Ticks are in any unit, eg us from a mock timer; time is assumed not to wrap.
+// Not thread-safe.
+//   * paths  number of distinct paths counted; in [2,255];
+//     path numbers at or above paths are all counted in the last slot
+template<uint8_t paths = 32>
+class ISRLatencyMonitor final
+    {
+    static_assert(paths >= 2, "need at least 2 paths");
+
+    private:
+        uint32_t maxMasked[paths];
+        uint32_t maxLatency[paths];
+        uint32_t maskedCount[paths];
+        // Current masked section, if depth > 0.
+        uint8_t depth = 0;
+        uint8_t maskPath = ISRLatencyPath::NONE;
+        uint32_t maskStart = 0;
+        // IRQ raised but not yet entered.
+        bool pending = false;
+        uint32_t raisedAt = 0;
+        uint8_t raisedPath = ISRLatencyPath::NONE;
+
+        static uint8_t slot(const uint8_t path) { return((path < paths) ? path : uint8_t(paths - 1)); }
+        void recordLatency(const uint8_t path, const uint32_t ticks)
+            { if(ticks > maxLatency[slot(path)]) { maxLatency[slot(path)] = ticks; } }
+
+    public:
+        ISRLatencyMonitor() : maxMasked(), maxLatency(), maskedCount() { }
+
+        // Interrupts are disabled at now by path.
+        void maskBegin(const uint8_t path, const uint32_t now)
+            {
+            if(0 == depth++) { maskPath = path; maskStart = now; }
+            }
+        // Interrupts are restored at now; any pending IRQ is entered.
+        void maskEnd(const uint32_t now)
+            {
+            if(0 == depth) { return; }
+            if(0 != --depth) { return; }
+            const uint8_t s = slot(maskPath);
+            const uint32_t d = now - maskStart;
+            if(d > maxMasked[s]) { maxMasked[s] = d; }
+            ++maskedCount[s];
+            if(pending) { recordLatency(maskPath, now - raisedAt); pending = false; }
+            maskPath = ISRLatencyPath::NONE;
+            }
+        // The IRQ line is asserted at now.
+        // Entered at once if interrupts are enabled and autoEnter is true.
+        void irqRaised(const uint32_t now, const bool autoEnter = true)
+            {
+            if(pending) { return; }
+            if((0 == depth) && autoEnter) { recordLatency(ISRLatencyPath::NONE, 0); return; }
+            pending = true;
+            raisedAt = now;
+            raisedPath = (0 != depth) ? maskPath : ISRLatencyPath::NONE;
+            }
+        // The ISR for a pending IRQ starts at now, eg after the CPU's own entry overhead.
+        // The latency is counted against the section masking when the IRQ was raised, else NONE.
+        void isrEntered(const uint32_t now)
+            {
+            if(!pending) { return; }
+            recordLatency(raisedPath, now - raisedAt);
+            pending = false;
+            }
+
+        bool isMasked() const { return(0 != depth); }
+        bool isPending() const { return(pending); }
+        // Longest masked section for path; 0 if none.
+        uint32_t getMaxMaskedTicks(const uint8_t path) const { return(maxMasked[slot(path)]); }
+        // Number of completed masked sections for path.
+        uint32_t getMaskedCount(const uint8_t path) const { return(maskedCount[slot(path)]); }
+        // Worst ISR entry latency attributed to path; 0 if none.
+        uint32_t getMaxEntryLatencyTicks(const uint8_t path) const { return(maxLatency[slot(path)]); }
+        // Worst ISR entry latency over all paths.
+        uint32_t getWorstEntryLatencyTicks() const
+            {
+            uint32_t w = 0;
+            for(uint8_t i = 0; i < paths; ++i) { if(maxLatency[i] > w) { w = maxLatency[i]; } }
+            return(w);
+            }
+
+        // True if every bounded figure is within its bound.
+        // Else returns false with the first (in bounds order) failing path in failedPath.
+        bool withinBounds(const ISRLatencyBound *const bounds, const uint8_t n, uint8_t &failedPath) const
+            {
+            for(uint8_t i = 0; i < n; ++i)
+                {
+                const ISRLatencyBound &b = bounds[i];
+                if(((0 != b.maxMaskedTicks) && (getMaxMaskedTicks(b.path) > b.maxMaskedTicks)) ||
+                   ((0 != b.maxEntryLatencyTicks) && (getMaxEntryLatencyTicks(b.path) > b.maxEntryLatencyTicks)))
+                    { failedPath = b.path; return(false); }
+                }
+            return(true);
+            }
+    };
+
+
+}
+#endif
@@ -24,6 +24,7 @@ Author(s) / Copyright (s): Damon Hart-Davis 2014--2016
 #include <string.h>
 
 #include "OTV0P2BASE_ArduinoCompat.h"
+#include "OTV0P2BASE_CPUClockPolicy.h"
 #include "OTV0P2BASE_JSONStats.h"
 #include "OTV0P2BASE_CRC.h"
 #include "OTV0P2BASE_EEPROM.h"
@@ -70,24 +71,12 @@ uint8_t adjustJSONMsgForTXAndComputeCRC(char * const bptr)
   // Do initial quick validation before computing CRC, etc,
   if(!quickValidateRawSimpleJSONMessage(bptr)) { return(adjustJSONMsgForTXAndComputeCRC_ERR); }
 //  if('{' != *bptr) { return(adjustJSONMsgForTXAndComputeCRC_ERR); }
-  bool seenTrailingClosingBrace = false;
-  uint8_t crc = '{';
-  for(char *p = bptr; *++p; ) // Skip first char ('{'); loop until '\0'.
-    {
-    const char c = *p;
-//    if(c & 0x80) { return(adjustJSONMsgForTXAndComputeCRC_ERR); } // No high-bits should be set!
-    if(('}' == c) && ('\0' == *(p+1)))
-      {
-      seenTrailingClosingBrace = true;
-      const char newC = c | 0x80;
-      *p = newC; // Set high bit.
-      crc = crc7_5B_update(crc, (uint8_t)newC); // Update CRC.
-      return(crc);
-      }
-    crc = crc7_5B_update(crc, (uint8_t)c); // Update CRC.
-    }
-  if(!seenTrailingClosingBrace) { return(adjustJSONMsgForTXAndComputeCRC_ERR); } // Missing ending '}'.
-  return(crc);
+  // Find the trailing '}' and set its high bit to make it unique.
+  const size_t len = strlen(bptr);
+  if((len < 2) || ('}' != bptr[len-1])) { return(adjustJSONMsgForTXAndComputeCRC_ERR); } // Missing ending '}'.
+  bptr[len-1] = (char)('}' | 0x80);
+  // CRC over all but the first char ('{'), including the adjusted '}'.
+  return(crc7_5B_buf('{', (const uint8_t *)bptr + 1, (uint8_t)(len - 1)));
   }
 
 
@@ -119,18 +108,19 @@ void outputJSONStats(Print *p, bool /*secure*/, const uint8_t * const json, cons
 //#define checkJSONMsgRXCRC_ERR -1
 int8_t checkJSONMsgRXCRC(const uint8_t * const bptr, const uint8_t bufLen)
   {
-  if('{' != *bptr) { return(checkJSONMsgRXCRC_ERR); }
+  if((0 == bufLen) || ('{' != *bptr)) { return(checkJSONMsgRXCRC_ERR); }
 #if 0 && defined(DEBUG)
   DEBUG_SERIAL_PRINT_FLASHSTRING("checkJSONMsgRXCRC_ERR()... {");
 #endif
-  uint8_t crc = '{';
-  // Scan up to maximum length for terminating '}'-with-high-bit.
+  // Scan up to maximum length for terminating '}'-with-high-bit,
+  // only then computing the CRC in one pass over the message.
   const uint8_t ml = OTV0P2BASE::fnmin(MSG_JSON_ABS_MAX_LENGTH, bufLen);
   const uint8_t *p = bptr + 1;
   for(int8_t i = 1; i < ml; ++i)
     {
     const char c = char(*p++);
-    crc = crc7_5B_update(crc, (uint8_t)c); // Update CRC.
+    // A terminator needs the following '\0' or CRC byte within the buffer too.
+    if(i + 1 >= bufLen) { break; }
 //#ifdef ALLOW_RAW_JSON_RX
     if(('}' == c) && ('\0' == *p))
       {
@@ -142,12 +132,16 @@ int8_t checkJSONMsgRXCRC(const uint8_t * const bptr, const uint8_t bufLen)
       }
 //#endif
     // With a terminating '}' (followed by '\0') the message is superficially valid.
-    if((((char)('}' | 0x80)) == c) && ((crc == *p) || ((0 == crc) && (0x80 == *p))))
+    if(((char)('}' | 0x80)) == c)
       {
+      const uint8_t crc = crc7_5B_buf('{', bptr + 1, (uint8_t)i);
+      if((crc == *p) || ((0 == crc) && (0x80 == *p)))
+        {
 #if 0 && defined(DEBUG)
-      DEBUG_SERIAL_PRINTLN_FLASHSTRING("} OK with CRC");
+        DEBUG_SERIAL_PRINTLN_FLASHSTRING("} OK with CRC");
 #endif
-      return(i+1);
+        return(i+1);
+        }
       }
     // Non-printable/control character makes the message invalid.
     if((c < 32) || (c > 126))
@@ -193,47 +187,99 @@ bool isValidSimpleStatsKey(const MSG_JSON_SimpleStatsKey_t key)
   return(true);
   }
 
-// Returns read/write pointer to stats tuple with given (non-NULL) key if present, else NULL.
-// Does a simple linear search.
-SimpleStatsRotationBase::DescValueTuple * SimpleStatsRotationBase::findByKey(const MSG_JSON_SimpleStatsKey_t key) const
+// True iff the two (non-NULL) keys are the same string.
+bool simpleStatsKeysEqual(const MSG_JSON_SimpleStatsKey_t a, const MSG_JSON_SimpleStatsKey_t b)
   {
-  for(int i = 0; i < nStats; ++i)
-    {
-    DescValueTuple * const p = stats + i;
+  if(a == b) { return(true); }
 #ifdef V0p2_SENSOR_TAG_NOT_SIMPLECHARPTR
     #if defined(V0p2_SENSOR_TAG_IS_FlashStringHelper)
     // Inline equivalent to strcmp() but between two Flash strings.
-    const char *p1 = reinterpret_cast<const char *>(p->descriptor.key);
-    const char *p2 = reinterpret_cast<const char *>(key);
+    const char *p1 = reinterpret_cast<const char *>(a);
+    const char *p2 = reinterpret_cast<const char *>(b);
     for( ; ; ++p1, ++p2)
       {
       const char c1 = pgm_read_byte(p1);
       const char c2 = pgm_read_byte(p2);
       const bool end1 = ('\0' == c1);
       const bool end2 = ('\0' == c2);
-      if(end1 && end2) { return(p); } // Keys match.
-      if(c1 != c2) { break; } // Keys don't match, fall through to fail.
+      if(end1 && end2) { return(true); } // Keys match.
+      if(c1 != c2) { return(false); } // Keys don't match.
       }
     #else
         #error "Needs specific implementation for MCU."
     #endif
 #else // Simple const char * case.
-    if(0 == strcmp(p->descriptor.key, key)) { return(p); }
+  return(0 == strcmp(a, b));
 #endif
+  }
+
+// Returns read/write pointer to stats tuple with given (non-NULL) key if present, else NULL.
+// Keys almost always come from the same static string each time (eg a Sensor tag()),
+// and are usually put in the same order every cycle (eg by JSONStatsHolder),
+// so first look for the same key pointer starting just after the last stat found,
+// which usually hits on the first compare, making a full set of puts O(n).
+// Falls back to a linear search comparing key strings.
+SimpleStatsRotationBase::DescValueTuple * SimpleStatsRotationBase::findByKey(const MSG_JSON_SimpleStatsKey_t key) const
+  {
+  uint8_t next = lastFound;
+  for(int i = nStats; --i >= 0; )
+    {
+    // Wrap around the end of the stats.
+    if(++next >= nStats) { next = 0; }
+    if(key == stats[next].descriptor.key) { lastFound = next; return(stats + next); }
+    }
+  for(int i = 0; i < nStats; ++i)
+    {
+    if(simpleStatsKeysEqual(stats[i].descriptor.key, key)) { lastFound = (uint8_t)i; return(stats + i); }
     }
   return(NULL); // Not found.
   }
 
+// Returns read/write pointer to stats tuple for the given registered key if present, else NULL.
+// Matches by key ID, ie a byte compare per stat.
+// A stat first put by text is found by it (once) and then tagged with the ID.
+SimpleStatsRotationBase::DescValueTuple * SimpleStatsRotationBase::findByKey(const SimpleStatsKey &k) const
+  {
+  uint8_t next = lastFound;
+  for(int i = nStats; --i >= 0; )
+    {
+    // Wrap around the end of the stats.
+    if(++next >= nStats) { next = 0; }
+    if(k.id == stats[next].keyID) { lastFound = next; return(stats + next); }
+    }
+  DescValueTuple *const p = findByKey(k.key());
+  if(NULL != p) { p->keyID = k.id; }
+  return(p);
+  }
+
+// Set the target maximum age of an existing stat; true iff the stat exists.
+bool SimpleStatsRotationBase::setMaxAge(const MSG_JSON_SimpleStatsKey_t key, const uint8_t maxAge)
+  {
+  DescValueTuple *const p = findByKey(key);
+  if(NULL == p) { return(false); }
+  p->descriptor.maxAge = maxAge;
+  return(true);
+  }
+
 // Remove given stat and properties.
 // True iff the item existed and was removed.
 bool SimpleStatsRotationBase::remove(const MSG_JSON_SimpleStatsKey_t key)
+  { return(removeTuple(findByKey(key))); }
+bool SimpleStatsRotationBase::remove(const SimpleStatsKey &k)
+  { return(removeTuple(findByKey(k))); }
+
+// Remove the given stat tuple if not NULL; true iff it was removed.
+bool SimpleStatsRotationBase::removeTuple(DescValueTuple *const p)
   {
-  DescValueTuple *p = findByKey(key);
   if(NULL == p) { return(false); }
   // If it needs to be removed and is not the last item
   // then move the last item down into its slot.
   const bool lastItem = ((p - stats) == (nStats - 1));
-  if(!lastItem) { *p = stats[nStats-1]; }
+  if(!lastItem)
+    {
+    *p = stats[nStats-1];
+    if(NULL != rendered) { rendered[p - stats] = rendered[nStats-1]; }
+    }
   // We got rid of one!
   // TODO: possibly explicitly destroy/overwrite the removed one at the end.
   --nStats;
@@ -276,16 +322,38 @@ DEBUG_SERIAL_PRINTLN();
 #endif
     return(false);
     }
+  return(putTuple(findByKey(key), key, newValue, statLowPriority));
+  }
+
+// Create/update value for the given registered key, matched by key ID.
+// The key text was validated at compile time by the registry.
+bool SimpleStatsRotationBase::put(const SimpleStatsKey &k, const int16_t newValue)
+  {
+  DescValueTuple *const p = findByKey(k);
+  if(!putTuple(p, k.key(), newValue, k.lowPriority)) { return(false); }
+  // Tag a newly-added stat (the last) with its ID.
+  if(NULL == p) { stats[nStats-1].keyID = k.id; }
+  return(true);
+  }
 
-  DescValueTuple *p = findByKey(key);
+// Update the found stat p, or if NULL add key with the given value and priority.
+bool SimpleStatsRotationBase::putTuple(DescValueTuple *p, const MSG_JSON_SimpleStatsKey_t key,
+                                       const int16_t newValue, const bool statLowPriority)
+  {
   // If item already exists, update it.
   if(NULL != p)
     {
-    // Update the value and mark as changed if changed.
+    // Update the value and mark as changed if changed beyond the deadband.
     if(p->value != newValue)
       {
       p->value = newValue;
-      p->flags.changed = true;
+      p->flags.rendered = false;
+      const int32_t delta = (int32_t)newValue - p->deadbandRef;
+      if((delta > p->descriptor.deadband) || (-delta > p->descriptor.deadband))
+        {
+        p->flags.changed = true;
+        p->deadbandRef = newValue;
+        }
       }
     // Update done!
     return(true);
@@ -298,6 +366,7 @@ DEBUG_SERIAL_PRINTLN();
     p = stats + (nStats++);
     *p = DescValueTuple();
     p->value = newValue;
+    p->deadbandRef = newValue;
     p->flags.changed = true;
     // Copy descriptor .
     p->descriptor = GenericStatsDescriptor(key, statLowPriority);
@@ -314,7 +383,8 @@ DEBUG_SERIAL_PRINTLN();
   }
 
 // Print an object field "name":value to the given buffer.
-size_t SimpleStatsRotationBase::print(BufPrint &bp, const SimpleStatsRotationBase::DescValueTuple &s, bool &commaPending) const
+// Uses and refreshes the render cache if present.
+size_t SimpleStatsRotationBase::print(BufPrint &bp, SimpleStatsRotationBase::DescValueTuple &s, bool &commaPending)
   {
   size_t w = 0;
   if(commaPending) { w += bp.print(','); }
@@ -324,7 +394,19 @@ size_t SimpleStatsRotationBase::print(BufPrint &bp, const SimpleStatsRotationBas
   w += bp.print(':');
   const int16_t v = s.value;
   // Optimisation here for common small non-negative values, eg zero.
-  w += ((v >= 0) && (v <= 9)) ? bp.print((char)('0' + v)) : bp.print(v);
+  if((v >= 0) && (v <= 9)) { w += bp.print((char)('0' + v)); }
+  else if(NULL == rendered) { char text[FORMAT_I16_CHARS]; formatI16(text, v); w += bp.print(text); }
+  else
+    {
+    // Convert the value afresh only if it has changed since it was last rendered.
+    char *const text = rendered[&s - stats].text;
+    if(!s.flags.rendered)
+      {
+      formatI16(text, v);
+      s.flags.rendered = true;
+      }
+    w += bp.print(text);
+    }
   commaPending = true;
   return(w);
   }
@@ -372,6 +454,9 @@ uint8_t SimpleStatsRotationBase::writeJSON(uint8_t *const buf, const uint8_t buf
 // Minimum size is for {"@":""} plus null plus extra padding char/byte to check for overrun.
   if(bufSize < 10) { return(0); } // Failed.
 
+  // Pure formatting: no need for full CPU speed.
+  RAII_CPUReducedClock slow;
+
   // Write/print to buffer passed in.
   BufPrint bp((char *)buf, bufSize);
   // Maximum size that can be taken up before final "}\0".
@@ -379,46 +464,7 @@ uint8_t SimpleStatsRotationBase::writeJSON(uint8_t *const buf, const uint8_t buf
 
   // True if field has been written and will need a ',' if another field is written.
   bool commaPending = false;
-
-  // Start object.
-  bp.print('{');
-
-  // Write ID first unless disabled entirely by being set to an empty string.
-  if((NULL == id) ||
-#ifdef V0p2_SENSOR_TAG_IS_FlashStringHelper
-     ('\0' != pgm_read_byte(id))
-#else
-     ('\0' != *id)
-#endif
-    )
-    {
-    // If an explicit ID is supplied then use it
-    // else use the first two bytes of the node ID if accessible.
-    bp.print(F("\"@\":\""));
-    if(NULL != id) { bp.print(id); } // Value has to be 'safe' (eg no " nor \ in it).
-#ifdef V0P2BASE_EE_START_ID // TODO: improve logic/portability
-    else
-      {
-      const uint8_t id1 = eeprom_read_byte(0 + (uint8_t *)V0P2BASE_EE_START_ID);
-      const uint8_t id2 = eeprom_read_byte(1 + (uint8_t *)V0P2BASE_EE_START_ID);
-      bp.print(hexDigit(id1 >> 4));
-      bp.print(hexDigit(id1));
-      bp.print(hexDigit(id2 >> 4));
-      bp.print(hexDigit(id2));
-      }
-#endif
-    bp.print('"');
-    commaPending = true;
-    }
-
-  // Write count next iff enabled.
-  if(c.enabled)
-    {
-    if(commaPending) { bp.print(','); commaPending = false; }
-    bp.print(F("\"+\":"));
-    bp.print(c.count);
-    commaPending = true;
-    }
+  printHead(bp, commaPending);
 
   // Be prepared to rewind back to logical start of buffer.
   bp.setMark();
@@ -536,6 +582,138 @@ uint8_t SimpleStatsRotationBase::writeJSON(uint8_t *const buf, const uint8_t buf
       }
     }
 
+  return(printTail(bp, buf));
+  }
+
+// Write stats in JSON format as for writeJSON(), but scheduled by priority and staleness.
+uint8_t SimpleStatsRotationBase::writeJSONScheduled(uint8_t *const buf, const uint8_t bufSize, const uint8_t /*sensitivity*/,
+                                                    const bool suppressClearChanged)
+  {
+  if(NULL == buf) { return(0); } // Should never happen, but be graceful if given a NULL buffer.
+  if(bufSize < 10) { return(0); } // Failed.
+
+  // Pure formatting: no need for full CPU speed.
+  RAII_CPUReducedClock slow;
+
+  BufPrint bp((char *)buf, bufSize);
+  const uint8_t maxLengthBeforeClose = bufSize - 3;
+  bool commaPending = false;
+  printHead(bp, commaPending);
+  bp.setMark();
+
+  // Every stat ages by one frame; those sent are reset below.
+  for(uint8_t i = 0; i < nStats; ++i)
+    {
+    DescValueTuple &s = stats[i];
+    if(s.age < 255) { ++s.age; }
+    s.flags.thisRun = false;
+    }
+
+  // Changed normal-priority stats first, skipping any that do not fit.
+    {
+    uint8_t next = lastTXed;
+    for(int i = nStats; --i >= 0; )
+      {
+      if(++next >= nStats) { next = 0; }
+      DescValueTuple &s = stats[next];
+      if(!s.flags.changed || s.descriptor.lowPriority) { continue; }
+      s.flags.thisRun = true;
+      print(bp, s, commaPending);
+      if(bp.getSize() > maxLengthBeforeClose) { bp.rewind(); continue; }
+      bp.setMark();
+      s.age = 0;
+      if(!suppressClearChanged) { s.flags.changed = false; }
+      }
+    }
+
+  // Fill the remaining space with the most stale of the rest.
+  // Smallest possible entry is 6 chars, eg ',"L":0', plus 3 needed at end.
+  while(bp.getSize() <= bufSize - (6 + 3))
+    {
+    uint8_t best = 0;
+    int16_t bestScore = -1;
+    uint8_t next = lastTXed;
+    for(int i = nStats; --i >= 0; )
+      {
+      if(++next >= nStats) { next = 0; }
+      const DescValueTuple &s = stats[next];
+      if(s.flags.thisRun) { continue; }
+      const uint8_t score = staleness(s);
+      if(score > bestScore) { best = next; bestScore = score; }
+      }
+    if(bestScore < 0) { break; } // All considered.
+    DescValueTuple &s = stats[best];
+    s.flags.thisRun = true;
+    print(bp, s, commaPending);
+    if(bp.getSize() > maxLengthBeforeClose) { bp.rewind(); continue; }
+    bp.setMark();
+    s.age = 0;
+    if(!suppressClearChanged) { s.flags.changed = false; }
+    lastTXed = best;
+    }
+
+  return(printTail(bp, buf));
+  }
+
+// Staleness of a stat for writeJSONScheduled(); higher is more urgent.
+uint8_t SimpleStatsRotationBase::staleness(const DescValueTuple &s)
+  {
+  const uint8_t maxAge = (0 != s.descriptor.maxAge) ? s.descriptor.maxAge :
+      (s.descriptor.lowPriority ? SIMPLE_STATS_DEFAULT_MAX_AGE_LOW_PRIORITY : SIMPLE_STATS_DEFAULT_MAX_AGE);
+  // A changed value is treated as overdue by one more target age.
+  const uint16_t score = ((uint16_t)s.age * 64U) / maxAge + (s.flags.changed ? 64U : 0U);
+  return((score > 255) ? 255 : (uint8_t)score);
+  }
+
+// Print the opening '{' and the ID and count fields (where enabled).
+void SimpleStatsRotationBase::printHead(BufPrint &bp, bool &commaPending)
+  {
+  // Start object.
+  bp.print('{');
+
+  // Write ID first unless disabled entirely by being set to an empty string.
+  if((NULL == id) ||
+#ifdef V0p2_SENSOR_TAG_IS_FlashStringHelper
+     ('\0' != pgm_read_byte(id))
+#else
+     ('\0' != *id)
+#endif
+    )
+    {
+    // If an explicit ID is supplied then use it
+    // else use the first two bytes of the node ID if accessible.
+    bp.print(F("\"@\":\""));
+    if(NULL != id) { bp.print(id); } // Value has to be 'safe' (eg no " nor \ in it).
+#ifdef V0P2BASE_EE_START_ID // TODO: improve logic/portability
+    else
+      {
+      const uint8_t id1 = eeprom_read_byte(0 + (uint8_t *)V0P2BASE_EE_START_ID);
+      const uint8_t id2 = eeprom_read_byte(1 + (uint8_t *)V0P2BASE_EE_START_ID);
+      bp.print(hexDigit(id1 >> 4));
+      bp.print(hexDigit(id1));
+      bp.print(hexDigit(id2 >> 4));
+      bp.print(hexDigit(id2));
+      }
+#endif
+    bp.print('"');
+    commaPending = true;
+    }
+
+  // Write count next iff enabled.
+  if(c.enabled)
+    {
+    if(commaPending) { bp.print(','); commaPending = false; }
+    bp.print(F("\"+\":"));
+    // Count is 3 bits, so a single digit.
+    bp.print(char('0' + c.count));
+    commaPending = true;
+    }
+
+  }
+
+// Print the closing '}' and return the JSON length, or 0 (and clear buf) on overrun.
+uint8_t SimpleStatsRotationBase::printTail(BufPrint &bp, uint8_t *const buf)
+  {
   // Terminate object.
   bp.print('}');
 #if 0
@@ -558,5 +736,188 @@ uint8_t SimpleStatsRotationBase::writeJSON(uint8_t *const buf, const uint8_t buf
   return(bp.getSize()); // Success!
   }
 
+// Get the next field; false at the end of the message or if it is malformed.
+bool SimpleJSONStatsReader::next(SimpleJSONStatsField &f)
+  {
+  // Body is [1,end).
+  const uint8_t end = len - 1;
+  if(bad || (pos >= end)) { return(false); }
+  uint8_t p = pos;
+  // Fields after the first are preceded by a comma.
+  if((1 != p) && (',' != buf[p++])) { bad = true; return(false); } // FAIL
+  // Quoted key then colon.
+  if((p >= end) || ('"' != buf[p++])) { bad = true; return(false); } // FAIL
+  f.key = buf + p;
+  while((p < end) && ('"' != buf[p]))
+    {
+    const char c = buf[p++];
+    if((c < 32) || (c > 126) || ('\\' == c)) { bad = true; return(false); } // FAIL
+    }
+  f.keyLen = (uint8_t)((buf + p) - f.key);
+  if((p + 1 >= end) || (':' != buf[p+1])) { bad = true; return(false); } // FAIL
+  p += 2;
+  if(p >= end) { bad = true; return(false); } // FAIL
+  if('"' == buf[p])
+    {
+    // Simple string value.
+    f.isString = true;
+    f.str = buf + ++p;
+    while((p < end) && ('"' != buf[p]))
+      {
+      const char c = buf[p++];
+      if((c < 32) || (c > 126) || ('\\' == c)) { bad = true; return(false); } // FAIL
+      }
+    if(p >= end) { bad = true; return(false); } // FAIL: unterminated.
+    f.strLen = (uint8_t)((buf + p) - f.str);
+    ++p;
+    }
+  else
+    {
+    // Integer value.
+    f.isString = false;
+    const bool neg = ('-' == buf[p]);
+    if(neg) { ++p; }
+    int32_t v = 0;
+    const uint8_t digitsStart = p;
+    while((p < end) && (buf[p] >= '0') && (buf[p] <= '9'))
+      {
+      v = (v * 10) + (buf[p++] - '0');
+      if(v > 32768) { bad = true; return(false); } // FAIL: out of range.
+      }
+    if(digitsStart == p) { bad = true; return(false); } // FAIL: no digits.
+    if(neg) { v = -v; }
+    if(v > 32767) { bad = true; return(false); } // FAIL: out of range.
+    f.value = (int16_t)v;
+    }
+  // Must be followed by another field or the end.
+  if((p < end) && (',' != buf[p])) { bad = true; return(false); } // FAIL
+  pos = p;
+  return(true);
+  }
+
+// Get the ID of the given key, or -1 if not in the table.
+int16_t SimpleStatsKeyTable::idOf(const MSG_JSON_SimpleStatsKey_t key) const
+  {
+  // Try the cheap pointer compare over the whole table first.
+  for(uint8_t i = 0; i < nKeys; ++i) { if(key == keyOf(i)) { return(i); } }
+  for(uint8_t i = 0; i < nKeys; ++i) { if(simpleStatsKeysEqual(key, keyOf(i))) { return(i); } }
+  return(-1); // Not found.
+  }
+
+// Encode value as zig-zag varint into buf if it fits in space bytes; returns bytes used, or 0 if no fit.
+static uint8_t putZigZagVarint(uint8_t *const buf, const uint8_t space, const int16_t value)
+  {
+  uint16_t z = (uint16_t)(((uint16_t)value << 1) ^ (uint16_t)(value >> 15));
+  uint8_t n = 0;
+  do
+    {
+    if(n >= space) { return(0); }
+    const uint8_t b = (uint8_t)(z & 0x7f);
+    z >>= 7;
+    buf[n++] = (0 != z) ? (b | 0x80) : b;
+    } while(0 != z);
+  return(n);
+  }
+
+// Get the next field; false at the end of the message or if it is malformed.
+bool SimpleBinaryStatsReader::next(uint8_t &keyID, int16_t &value)
+  {
+  if(bad || (pos >= len)) { return(false); }
+  uint8_t p = pos;
+  const uint8_t k = buf[p++];
+  uint16_t z = 0;
+  for(uint8_t shift = 0; ; shift += 7)
+    {
+    // Truncated, or too long for 16 bits.
+    if((p >= len) || (shift > 14)) { bad = true; return(false); } // FAIL
+    const uint8_t b = buf[p++];
+    // Only 2 bits left for the third byte.
+    if((14 == shift) && (0 != (b & 0xfc))) { bad = true; return(false); } // FAIL
+    z |= (uint16_t)((uint16_t)(b & 0x7f) << shift);
+    if(0 == (b & 0x80)) { break; }
+    }
+  keyID = k;
+  value = (int16_t)((z >> 1) ^ (uint16_t)-(int16_t)(z & 1));
+  pos = p;
+  return(true);
+  }
+
+// Expand a binary stats message into JSON, eg on a hub or in host tools.
+uint8_t expandSimpleBinaryStatsToJSON(const uint8_t *const buf, const uint8_t len, const SimpleStatsKeyTable &keys,
+                                      char *const out, const uint8_t outSize)
+  {
+  // Minimum is "{}" plus null plus a spare char to detect overrun.
+  if((NULL == out) || (outSize < 4)) { return(0); } // FAIL
+  BufPrint bp(out, outSize);
+  SimpleBinaryStatsReader r(buf, len);
+  bp.print('{');
+  bool commaPending = false;
+  uint8_t id;
+  int16_t value;
+  while(r.next(id, value))
+    {
+    const MSG_JSON_SimpleStatsKey_t key = keys.keyOf(id);
+    if(NULL == key) { *out = '\0'; return(0); } // FAIL: unknown key.
+    if(commaPending) { bp.print(','); }
+    bp.print('"');
+    bp.print(key); // Assumed not to need escaping in any way.
+    bp.print(F("\":"));
+    char text[FORMAT_I16_CHARS];
+    formatI16(text, value);
+    bp.print(text);
+    commaPending = true;
+    }
+  bp.print('}');
+  if(!r.isComplete() || bp.isFull()) { *out = '\0'; return(0); } // FAIL
+  return(bp.getSize());
+  }
+
+// Write stats in compact binary format to provided buffer; returns the non-zero length if successful.
+uint8_t SimpleStatsRotationBase::writeBinary(uint8_t *const buf, const uint8_t bufSize, const SimpleStatsKeyTable &keys,
+                                             const bool suppressClearChanged)
+  {
+  if((NULL == buf) || (0 == bufSize)) { return(0); } // FAIL
+  buf[0] = MSG_BINARY_STATS_LEADING_BYTE;
+  uint8_t size = 1;
+  // Indexes of stats included so far, so that none is sent twice.
+  uint8_t included[MSG_BINARY_STATS_MAX_FIELDS];
+  uint8_t nIncluded = 0;
+  // Changed values first, then the rest in rotation.
+  for(uint8_t pass = 0; pass < 2; ++pass)
+    {
+    const bool changedPass = (0 == pass);
+    uint8_t next = lastTXed;
+    for(int i = nStats; --i >= 0; )
+      {
+      if(nIncluded >= MSG_BINARY_STATS_MAX_FIELDS) { break; }
+      // Wrap around the end of the stats.
+      if(++next >= nStats) { next = 0; }
+      const DescValueTuple &s = stats[next];
+      if(changedPass && !s.flags.changed) { continue; }
+      bool done = false;
+      for(uint8_t j = 0; j < nIncluded; ++j) { if(next == included[j]) { done = true; break; } }
+      if(done) { continue; }
+      // Stats put by registered key carry their ID, if the table is that registry.
+      const int16_t id = ((NULL != keys.registry) && (s.keyID < keys.nKeys)) ?
+          s.keyID : keys.idOf(s.descriptor.key);
+      if(id < 0) { continue; } // Not sendable in this format.
+      // Add the field if it fits.
+      // If not, try the next changed value to pack the buffer,
+      // but stop the rotation of others to preserve its order.
+      const uint8_t n = (size + 1 >= bufSize) ? 0 :
+          putZigZagVarint(buf + size + 1, bufSize - size - 1, s.value);
+      if(0 == n) { if(changedPass) { continue; } else { break; } }
+      buf[size] = (uint8_t)id;
+      size += 1 + n;
+      included[nIncluded++] = next;
+      // Advance the rotation of unchanged values.
+      if(!changedPass) { lastTXed = next; }
+      }
+    }
+  if(!suppressClearChanged)
+    { for(uint8_t j = 0; j < nIncluded; ++j) { stats[included[j]].flags.changed = false; } }
+  return(size);
+  }
+
 
 } // OTV0P2BASE
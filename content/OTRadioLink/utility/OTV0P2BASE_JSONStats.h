@@ -23,12 +23,15 @@ Author(s) / Copyright (s): Damon Hart-Davis 2014--2016
 #ifndef OTV0P2BASE_JSONSTATS_H
 #define OTV0P2BASE_JSONSTATS_H
 
+#include <string.h>
+
 #ifdef ARDUINO
 #include <Arduino.h>
 #else
 #include "OTV0P2BASE_ArduinoCompat.h"
 #endif
 
+#include "OTV0P2BASE_FastFormat.h"
 #include "OTV0P2BASE_Sensor.h"
 #include "OTV0P2BASE_Util.h"
 
@@ -46,6 +49,8 @@ Author(s) / Copyright (s): Damon Hart-Davis 2014--2016
 //    template<typename T> T&& forward(typename identity<T>::type&& param) noexcept { return(static_cast<typename identity<T>::type&&>(param)); }
 //    }
 #else
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #endif // ARDUINO
 
@@ -87,6 +92,135 @@ typedef Sensor_tag_t MSG_JSON_SimpleStatsKey_t;
 // to avoid having to escape anything.
 bool isValidSimpleStatsKey(MSG_JSON_SimpleStatsKey_t key);
 
+// True iff the two (non-NULL) keys are the same string.
+bool simpleStatsKeysEqual(MSG_JSON_SimpleStatsKey_t a, MSG_JSON_SimpleStatsKey_t b);
+
+// Registered stats keys.
+// Each key is declared once, in a product-wide constexpr registry array,
+// with its JSON text, its ID for the binary format (its index in the registry)
+// and its default priority, eg:
+//     V0p2_SIMPLE_STATS_KEY_TEXT(keyTextT, "T|C16");
+//     V0p2_SIMPLE_STATS_KEY_TEXT(keyTextB, "B|cV");
+//     constexpr SimpleStatsKey statsKeys[] = { { keyTextT, 0 }, { keyTextB, 1, true } };
+//     static_assert(isWellFormedSimpleStatsKeyRegistry(statsKeys), "bad stats keys");
+// then ss.put(statsKeys[1], value) is matched by ID with no string compares,
+// and SimpleStatsKeyTable(statsKeys, 2) encodes/decodes binary stats with the same IDs.
+// Key text must be in Flash on AVR, as for Sensor tags, hence the declaration macro.
+#if defined(V0p2_SENSOR_TAG_IS_FlashStringHelper)
+#define V0p2_SIMPLE_STATS_KEY_TEXT(name, literal) constexpr char name[] PROGMEM = literal
+#else
+#define V0p2_SIMPLE_STATS_KEY_TEXT(name, literal) constexpr char name[] = literal
+#endif
+
+// Key ID meaning 'not a registered key'; registries thus hold at most 255 keys.
+static constexpr uint8_t SIMPLE_STATS_NO_KEY_ID = 0xff;
+
+// One registered stats key.
+struct SimpleStatsKey final
+  {
+  // Key text, eg from V0p2_SIMPLE_STATS_KEY_TEXT(); in Flash on AVR.
+  const char *const text;
+  // Key ID, which must be the index of this entry in its registry.
+  const uint8_t id;
+  // Default priority of the stat.
+  const bool lowPriority;
+  constexpr SimpleStatsKey(const char *const _text, const uint8_t _id, const bool _lowPriority = false)
+    : text(_text), id(_id), lowPriority(_lowPriority) { }
+  // The text as a key for the non-registry interfaces.
+#if defined(V0p2_SENSOR_TAG_IS_FlashStringHelper)
+  MSG_JSON_SimpleStatsKey_t key() const { return(reinterpret_cast<MSG_JSON_SimpleStatsKey_t>(text)); }
+#else
+  MSG_JSON_SimpleStatsKey_t key() const { return(text); }
+#endif
+  };
+
+// Compile-time equivalent of isValidSimpleStatsKey() for (non-NULL) key text.
+constexpr bool isValidSimpleStatsKeyText(const char *const s)
+  { return(('\0' == *s) || ((*s >= 32) && (*s <= 126) && ('"' != *s) && ('\\' != *s) && isValidSimpleStatsKeyText(s + 1))); }
+// Compile-time key text comparison.
+constexpr bool simpleStatsKeyTextsEqual(const char *const a, const char *const b)
+  { return((*a == *b) && (('\0' == *a) || simpleStatsKeyTextsEqual(a + 1, b + 1))); }
+// True iff no entry in r[j,n) has the same text as r[i].
+constexpr bool simpleStatsKeyIsUniqueFrom(const SimpleStatsKey *const r, const size_t n, const size_t i, const size_t j)
+  { return((j >= n) || (!simpleStatsKeyTextsEqual(r[i].text, r[j].text) && simpleStatsKeyIsUniqueFrom(r, n, i, j + 1))); }
+// True iff the n-entry registry r is usable, checking entries from i on:
+// each ID is its index, each text is non-empty and valid, and no text appears twice.
+// Intended for use in a static_assert().
+constexpr bool isWellFormedSimpleStatsKeyRegistry(const SimpleStatsKey *const r, const size_t n, const size_t i = 0)
+  {
+  return((n < SIMPLE_STATS_NO_KEY_ID) &&
+         ((i >= n) || ((r[i].id == i) && ('\0' != *r[i].text) && isValidSimpleStatsKeyText(r[i].text) &&
+                       simpleStatsKeyIsUniqueFrom(r, n, i, i + 1) && isWellFormedSimpleStatsKeyRegistry(r, n, i + 1))));
+  }
+template<size_t N> constexpr bool isWellFormedSimpleStatsKeyRegistry(const SimpleStatsKey (&r)[N])
+  { return(isWellFormedSimpleStatsKeyRegistry(r, N)); }
+
+// Compact binary stats, an alternative to JSON (eg in a 32-byte secure frame body).
+// Keys are replaced by small numeric IDs, each the index of the key
+// in a table shared by sender and receiver, eg fixed per product family.
+// Values are zig-zag varints: 1 byte for [-64,63], 2 for [-8192,8191], else 3.
+// Format:
+//   byte 0 : MSG_BINARY_STATS_LEADING_BYTE
+//   then zero or more fields each of:
+//     key ID (1 byte)
+//     value as zig-zag varint, 7 bits per byte least significant first,
+//       msb set on all but the last byte
+// A typical field takes 2 or 3 bytes, against ~8--12 as JSON.
+static const uint8_t MSG_BINARY_STATS_LEADING_BYTE = 0xb5;
+// Maximum number of fields written into one binary stats message.
+static const uint8_t MSG_BINARY_STATS_MAX_FIELDS = 16;
+
+// Table of stats keys by binary key ID, ie index; at most 255 entries.
+// The table and the keys must outlive any use of this.
+// May instead be made from a (well-formed) registry of SimpleStatsKey,
+// in which case stats put by SimpleStatsKey are encoded without key lookup.
+struct SimpleStatsKeyTable final
+  {
+  const MSG_JSON_SimpleStatsKey_t *const keys;
+  const SimpleStatsKey *const registry;
+  const uint8_t nKeys;
+  constexpr SimpleStatsKeyTable(const MSG_JSON_SimpleStatsKey_t *const _keys, const uint8_t _nKeys)
+    : keys(_keys), registry(NULL), nKeys(_nKeys) { }
+  constexpr SimpleStatsKeyTable(const SimpleStatsKey *const _registry, const uint8_t _nKeys)
+    : keys(NULL), registry(_registry), nKeys(_nKeys) { }
+  // Get the ID of the given key, or -1 if not in the table.
+  int16_t idOf(MSG_JSON_SimpleStatsKey_t key) const;
+  // Get the key with the given ID, or NULL if none.
+  MSG_JSON_SimpleStatsKey_t keyOf(const uint8_t id) const
+    { return((id >= nKeys) ? NULL : ((NULL != registry) ? registry[id].key() : keys[id])); }
+  };
+
+// Reads fields in turn from a binary stats message.
+class SimpleBinaryStatsReader final
+  {
+  private:
+    const uint8_t *const buf;
+    const uint8_t len;
+    uint8_t pos;
+    bool bad;
+  public:
+    // Wrap a message buf of len bytes; buf may be NULL only if len is 0.
+    SimpleBinaryStatsReader(const uint8_t *const _buf, const uint8_t _len)
+      : buf(_buf), len(_len), pos(1),
+        bad((NULL == _buf) || (0 == _len) || (MSG_BINARY_STATS_LEADING_BYTE != _buf[0])) { }
+    // Get the next field; false at the end of the message or if it is malformed.
+    bool next(uint8_t &keyID, int16_t &value);
+    // True if the message was read to its end without error.
+    bool isComplete() const { return(!bad && (pos == len)); }
+  };
+
+// Expand a binary stats message into JSON, eg on a hub or in host tools.
+// Writes {"key":value,...}, with keys from the table, and a trailing '\0'.
+// Returns the non-zero JSON length, or 0 if the message is malformed,
+// has a key ID not in the table, or does not fit in outSize (including '\0').
+uint8_t expandSimpleBinaryStatsToJSON(const uint8_t *buf, uint8_t len, const SimpleStatsKeyTable &keys,
+                                      char *out, uint8_t outSize);
+
+// Default target maximum ages of stats, in frames, for SimpleStatsRotationBase::writeJSONScheduled().
+// A stat is overdue once it has not been sent for this many frames.
+static constexpr uint8_t SIMPLE_STATS_DEFAULT_MAX_AGE = 4;
+static constexpr uint8_t SIMPLE_STATS_DEFAULT_MAX_AGE_LOW_PRIORITY = 16;
+
 // Generic stats descriptor.
 struct GenericStatsDescriptor final
   {
@@ -95,11 +229,15 @@ struct GenericStatsDescriptor final
     // and the pointer too it must remain valid until this instance
     // and all copies have been disposed of (so is probably best a static string).
     // By default the statistic is normal priority.
+    // By default any change in value is significant.
+    // By default the target maximum age is set by the priority.
     // Sensitivity by default does not allow TX unless at minimal privacy level.
     constexpr GenericStatsDescriptor(const MSG_JSON_SimpleStatsKey_t statKey,
-                           const bool statLowPriority = false)
+                           const bool statLowPriority = false,
+                           const uint8_t statDeadband = 0,
+                           const uint8_t statMaxAge = 0)
                            // const uint8_t statSensitivity = 1)
-      : key(statKey), lowPriority(statLowPriority) // , sensitivity(statSensitivity)
+      : key(statKey), lowPriority(statLowPriority), deadband(statDeadband), maxAge(statMaxAge) // , sensitivity(statSensitivity)
     { }
 
     // Null-terminated short stat/key name.
@@ -122,6 +260,19 @@ struct GenericStatsDescriptor final
     // and hours vacancy (can be deduced from hours since last occupancy).
     bool lowPriority;
 
+    // Changes in value of no more than this from the value when the stat
+    // was last marked as changed are not treated as changes,
+    // so that noise in (say) light or humidity does not keep jumping the rotation.
+    // The latest value is still recorded and sent in normal rotation.
+    // Zero (the default) means that any change is significant.
+    uint8_t deadband;
+
+    // Target maximum number of frames between sends of this stat
+    // by writeJSONScheduled(), which sends the most overdue first.
+    // Zero (the default) means SIMPLE_STATS_DEFAULT_MAX_AGE,
+    // or SIMPLE_STATS_DEFAULT_MAX_AGE_LOW_PRIORITY if lowPriority.
+    uint8_t maxAge;
+
 //    // Device sensitivity threshold has to be at or below this for stat to be sent.
 //    // The default is to allow the stat to be sent
 //    // unless device is in default maximum privacy mode.
@@ -185,19 +336,43 @@ class SimpleStatsRotationBase
     template <class T> bool put(const OTV0P2BASE::SensorCore<T> &s, bool statLowPriority = false)
         { return(put(s.tag(), s.get(), statLowPriority)); }
 
+    // Create/update value for the given static-dispatch sensor.
+    template <class D, class T> bool put(const OTV0P2BASE::SensorStatic<D, T> &s, bool statLowPriority = false)
+        { return(put(s.derived().tag(), s.derived().get(), statLowPriority)); }
+
+    // Create/update value for the given registered key, matched by key ID.
+    // The registry should be the same for all registered keys put here.
+    // Cheaper than put() by text, as the key was validated at compile time.
+    // True if successful, false otherwise (eg capacity already reached).
+    bool put(const SimpleStatsKey &k, int16_t newValue);
+
     // Create/update stat/key with specified descriptor/properties.
     // The name is taken from the descriptor.
     bool putDescriptor(const GenericStatsDescriptor &descriptor);
 
+    // Set the target maximum age (see GenericStatsDescriptor) of an existing stat.
+    // True iff the stat exists.
+    bool setMaxAge(MSG_JSON_SimpleStatsKey_t key, uint8_t maxAge);
+
     // Remove given stat and properties.
     // True iff the item existed and was removed.
     bool remove(MSG_JSON_SimpleStatsKey_t key);
+    bool remove(const SimpleStatsKey &k);
 
     // Create/update value for the given sensor if isAvailable(); remove otherwise.
     // True if put() succeeds or a remove() was requested; false if a put() was request and failed.
     template <class T> bool putOrRemove(const OTV0P2BASE::SensorCore<T> &s)
         { if(s.isAvailable()) { return(put(s.tag(), s.get(), false)); } remove(s.tag()); return(true); }
 
+    // Create/update value for the given static-dispatch sensor if isAvailable(); remove otherwise.
+    template <class D, class T> bool putOrRemove(const OTV0P2BASE::SensorStatic<D, T> &s)
+        {
+        const D &d = s.derived();
+        if(d.isAvailable()) { return(put(d.tag(), d.get(), false)); }
+        remove(d.tag());
+        return(true);
+        }
+
     // Create/update value for the given sub-sensor if isAvailable(); remove otherwise.
     // True if put() succeeds or a remove() was requested; false if a put() was request and failed.
     // As a sub-sensor this is treated as low priority by default.
@@ -259,6 +434,33 @@ class SimpleStatsRotationBase
     uint8_t writeJSON(uint8_t * const buf, const uint8_t bufSize, const uint8_t sensitivity,
                       const bool maximise = false, const bool suppressClearChanged = false);
 
+    // Write stats in JSON format as for writeJSON(), but scheduled by priority and staleness.
+    // Every changed normal-priority stat that fits is included in every frame.
+    // The remaining space is filled greedily with the other stats,
+    // the most stale first, ie with the highest age relative to its
+    // target maximum age (see GenericStatsDescriptor), changed stats counting as overdue;
+    // ties go in rotation order.
+    // The ages are maintained only by this routine, so do not mix this with writeJSON().
+    // Takes time quadratic in the number of stats, so is best with a modest number.
+    uint8_t writeJSONScheduled(uint8_t * const buf, const uint8_t bufSize, const uint8_t sensitivity,
+                               const bool suppressClearChanged = false);
+
+    // Write stats in compact binary format to provided buffer; returns the non-zero length if successful.
+    // See MSG_BINARY_STATS_LEADING_BYTE for the format.
+    // Only stats whose keys are in the key table (sender and receiver must agree)
+    // are included; there is no ID or count field.
+    // Changed stats are written first, then as many others as fit
+    // (up to MSG_BINARY_STATS_MAX_FIELDS in all), rotating through them over successive calls.
+    //
+    //   * buf  is the byte buffer to write to; never NULL
+    //   * bufSize is the capacity of the buffer starting at buf in bytes,
+    //       eg 32 for a secure frame body
+    //   * keys  maps stats keys to binary key IDs
+    //   * suppressClearChanged  if true then 'changed' flag for included fields
+    //       is not cleared by this
+    uint8_t writeBinary(uint8_t * const buf, const uint8_t bufSize, const SimpleStatsKeyTable &keys,
+                        const bool suppressClearChanged = false);
+
     // Returns true if a stat with the specified key is currently in the stats set.
     // Mainly for unit testing.
     bool containsKey(const MSG_JSON_SimpleStatsKey_t key) const
@@ -276,46 +478,79 @@ class SimpleStatsRotationBase
   protected:
     struct DescValueTuple final
       {
-      constexpr DescValueTuple() : descriptor(NULL), value(0) { }
+      constexpr DescValueTuple() : descriptor(NULL), keyID(SIMPLE_STATS_NO_KEY_ID), age(0), value(0), deadbandRef(0) { }
 
       // Descriptor of this stat.
       GenericStatsDescriptor descriptor;
 
+      // Registry key ID if put by SimpleStatsKey, else SIMPLE_STATS_NO_KEY_ID.
+      uint8_t keyID;
+
+      // Frames written by writeJSONScheduled() since this was last sent; saturates.
+      uint8_t age;
+
       // Value.
       int16_t value;
 
+      // Value when last marked as changed, or first put; for the deadband.
+      int16_t deadbandRef;
+
       // Various run-time flags.
       struct Flags final
         {
-        constexpr Flags() : changed(false) { }
+        constexpr Flags() : changed(false), rendered(false), thisRun(false) { }
 
         // Set true when the value is changed.
         // Set false when the value written out,
         // ie nominally transmitted to a remote listener,
         // to allow priority to be given to sending changed values.
         bool changed /* : 1 */; // Note: bitfields are expensive in code size.
-//
-//        // True if included in the current putative JSON output.
-//        // Initial state unimportant.
-//        bool thisRun : 1;
+
+        // True if the value's text in the render cache (if any) is current.
+        // Set false when the value is changed.
+        bool rendered /* : 1 */;
+
+        // True if already considered for the frame being scheduled.
+        // Only meaningful within writeJSONScheduled().
+        bool thisRun /* : 1 */;
         } flags;
       };
 
+    // Cached decimal text of one stat value, eg "-32768", null-terminated.
+    struct RenderedValue final
+      {
+      char text[FORMAT_I16_CHARS];
+      };
+
     // Maximum capacity including overheads.
     const uint8_t capacity;
 
     // Returns read/write pointer to stat tuple with given key if present, else NULL.
     DescValueTuple *findByKey(MSG_JSON_SimpleStatsKey_t key) const;
+    // Returns read/write pointer to stat tuple for the given registered key if present, else NULL.
+    DescValueTuple *findByKey(const SimpleStatsKey &k) const;
+
+    // Update the found stat p, or if NULL add key with the given value and priority.
+    bool putTuple(DescValueTuple *p, MSG_JSON_SimpleStatsKey_t key, int16_t newValue, bool statLowPriority);
+    // Remove the given stat tuple if not NULL; true iff it was removed.
+    bool removeTuple(DescValueTuple *p);
 
-    // Initialise base with appropriate storage (non-NULL) and capacity knowledge.
-    constexpr SimpleStatsRotationBase(DescValueTuple *_stats, uint8_t _capacity)
-      : capacity(_capacity), stats(_stats) { }
+    // Initialise base with appropriate storage (non-NULL) and capacity knowledge,
+    // and optionally (non-NULL) one render cache entry per stat.
+    constexpr SimpleStatsRotationBase(DescValueTuple *_stats, uint8_t _capacity,
+                                      RenderedValue *_rendered = NULL)
+      : capacity(_capacity), stats(_stats), rendered(_rendered) { }
 
   private:
     // Stats to be tracked and sent; never NULL.
     // The initial nStats slots are used.
     DescValueTuple * const stats;
 
+    // Render cache, parallel to stats[], or NULL if values are always rendered afresh.
+    // Most stats do not change between one write and the next,
+    // so this saves re-doing the (slow on AVR) integer to decimal conversion.
+    RenderedValue * const rendered;
+
     // Number of stats being managed (packed at the start of the stats[] array).
     uint8_t nStats = 0;
 
@@ -327,6 +562,10 @@ class SimpleStatsRotationBase
     // Coerced into range if necessary.
     uint8_t lastTXed = uint8_t(~0);
 
+    // Index of the stat last found by findByKey(); a hint for the next search.
+    // Coerced into range if necessary.
+    mutable uint8_t lastFound = uint8_t(~0);
+
     // ID as null terminated string, or NULL to use first 2 bytes of system ID.
     // Used as string value of compulsory leading "@" key/field.
     // If ID is non-NULL but points to an empty string then no ID is inserted at all.
@@ -348,10 +587,36 @@ class SimpleStatsRotationBase
       } c;
 
     // Print an object field "name":value to the given buffer.
-    size_t print(BufPrint &bp, const DescValueTuple &dvt, bool &commaPending) const;
+    // Uses and refreshes the render cache if present.
+    size_t print(BufPrint &bp, DescValueTuple &dvt, bool &commaPending);
+
+    // Print the opening '{' and the ID and count fields (where enabled).
+    void printHead(BufPrint &bp, bool &commaPending);
+    // Print the closing '}' and return the JSON length, or 0 (and clear buf) on overrun.
+    uint8_t printTail(BufPrint &bp, uint8_t *buf);
+
+    // Staleness of a stat for writeJSONScheduled(); higher is more urgent.
+    // 64 when a stat reaches its target maximum age, saturating at 255.
+    static uint8_t staleness(const DescValueTuple &s);
+
+  protected:
+    // Storage for the optional render cache.
+    template<uint8_t n, bool enabled> struct RenderCache final
+      {
+      RenderedValue r[n];
+      static constexpr RenderedValue *get(RenderCache *const c) { return(c->r); }
+      };
+    template<uint8_t n> struct RenderCache<n, false> final
+      {
+      static constexpr RenderedValue *get(RenderCache *const /*c*/) { return(NULL); }
+      };
   };
 
-template<uint8_t MaxStats>
+// If cacheRendered is true then each stat value is kept as rendered text
+// (costing 7 bytes of RAM per stat)
+// and only converted again after it changes,
+// so that each writeJSON() mainly concatenates cached fragments.
+template<uint8_t MaxStats, bool cacheRendered = false>
 class SimpleStatsRotation final : public SimpleStatsRotationBase
   {
   private:
@@ -359,8 +624,11 @@ class SimpleStatsRotation final : public SimpleStatsRotationBase
     // A copy is taken of the user-supplied set of descriptions, preserving order.
     DescValueTuple stats[MaxStats];
 
+    // Render cache, if enabled.
+    RenderCache<MaxStats, cacheRendered> cache;
+
   public:
-    constexpr SimpleStatsRotation() : SimpleStatsRotationBase(stats, MaxStats) { }
+    constexpr SimpleStatsRotation() : SimpleStatsRotationBase(stats, MaxStats, RenderCache<MaxStats, cacheRendered>::get(&cache)) { }
 
     // Get capacity.
     uint8_t getCapacity() const { return(MaxStats); }
@@ -368,13 +636,40 @@ class SimpleStatsRotation final : public SimpleStatsRotationBase
 
 
 #if !defined(ARDUINO)
+// Shared resource, eg bus or ADC, that a sensor needs powered up to read().
+// A sensor type declares one (usually a PowerDomain value) with a member:
+//     static constexpr uint8_t sensorResource = OTV0P2BASE::PowerDomain::TWI;
+// A sensor without one (and a placeholder) has SENSOR_NO_RESOURCE.
+static constexpr uint8_t SENSOR_NO_RESOURCE = 0xff;
+template <class T> struct SensorResourceOf final
+  {
+  private:
+    template <class U> static constexpr uint8_t r(decltype(&U::sensorResource)) { return(U::sensorResource); }
+    template <class U> static constexpr uint8_t r(...) { return(SENSOR_NO_RESOURCE); }
+  public:
+    static constexpr uint8_t value = r<typename std::remove_cv<typename std::remove_reference<T>::type>::type>(nullptr);
+  };
+
+// Resource power hooks for JSONStatsHolder::readAll() that do nothing,
+// eg where the sensors power their own resources up and down as they read().
+// Replacement hooks power the given resource up and down, eg via
+// powerUpTWIIfDisabled() and powerDownTWI() if it was not already on.
+struct NullSensorResourcePower final
+  {
+  void powerUp(uint8_t /*resource*/) { }
+  void powerDown(uint8_t /*resource*/) { }
+  };
+
 // Helper class used to size the stats generator and easily extract sensor values for it.
 // At least one sensor must be provided.
+// Sensors sharing a resource (see SensorResourceOf) are grouped at compile time
+// so that readAll() powers each resource up once for all of its sensors.
 template<typename T1, typename ... Ts>
 class JSONStatsHolder final
   {
   private:
-    std::tuple<T1, Ts...> args;
+    typedef std::tuple<T1, Ts...> args_t;
+    args_t args;
 
   public:
     // Number of arguments/stats.
@@ -405,16 +700,52 @@ class JSONStatsHolder final
     template<size_t I, typename ... Args> bool putOrRemove(Int2Type<I>, std::tuple<Args...>& tup)
         { return(putOrRemove(Int2Type<I-1>(), tup) && _putOrRemove(std::get<I>(tup))); }
     // Read...
-    template<typename ... Args> void read(Int2Type<0>, std::tuple<Args...>& tup)
-        { return((std::get<0>(tup)).read()); }
-    template<size_t I, typename ... Args> void read(Int2Type<I>, std::tuple<Args...>& tup)
-        { read(Int2Type<I-1>(), tup); (std::get<I>(tup)).read(); }
+    // Call read() on anything that has one; ignore placeholders and SubSensors.
+    template <class T> static auto _read(T &s, int) -> decltype(s.read(), void()) { s.read(); }
+    template <class T> static void _read(T &, long) { }
+    // Resource of the entry at index I.
+    template<size_t I> struct ResourceAt final
+      { static constexpr uint8_t value = SensorResourceOf<typename std::tuple_element<I, args_t>::type>::value; };
+    // True if an entry before index J has the same resource as the entry at I.
+    template<size_t I, size_t J = I> struct SharedEarlier final
+      { static constexpr bool value = (ResourceAt<J-1>::value == ResourceAt<I>::value) || SharedEarlier<I, J-1>::value; };
+    template<size_t I> struct SharedEarlier<I, 0> final { static constexpr bool value = false; };
+    template<size_t I> using More = std::integral_constant<bool, (I < argCount)>;
+    // Read all entries from index I on that use resource R.
+    template<uint8_t R, size_t I> void readUsing(std::false_type) { }
+    template<uint8_t R, size_t I> void readUsing(std::true_type)
+      {
+      if(R == ResourceAt<I>::value) { _read(std::get<I>(args), 0); }
+      readUsing<R, I+1>(More<I+1>());
+      }
+    // Read entries from index I on, each resource's group when its first entry is reached.
+    template<class P, size_t I> void readGrouped(P &, std::false_type) { }
+    template<class P, size_t I> void readGrouped(P &power, std::true_type)
+      {
+      const uint8_t r = ResourceAt<I>::value;
+      if(SENSOR_NO_RESOURCE == r) { _read(std::get<I>(args), 0); }
+      else if(!SharedEarlier<I>::value)
+        {
+        power.powerUp(r);
+        readUsing<ResourceAt<I>::value, I>(std::true_type());
+        power.powerDown(r);
+        }
+      readGrouped<P, I+1>(power, More<I+1>());
+      }
 
   public:
-    // Call read() on all sensors; usually done once, at initialisation.
-    void readAll() { read(args); }
+    // Call read() on all sensors, eg at initialisation or before putOrRemoveAll().
+    // Each group of sensors sharing a resource is read within one
+    // power.powerUp(resource) ... power.powerDown(resource) window,
+    // at the position of the group's first sensor;
+    // other sensors are read in argument order.
+    template <class P> void readAll(P &power) { readGrouped<P, 0>(power, std::true_type()); }
+    void readAll() { NullSensorResourcePower p; readAll(p); }
     // Put all the attached isAvailable() sensor values into the stats object; remove those !isAvailable().
     bool putOrRemoveAll() { return(putOrRemove(Int2Type<argCount-1>(), args)); }
+    // Read all sensors as for readAll() then put/remove all their values in one pass.
+    template <class P> bool readAndPutOrRemoveAll(P &power) { readAll(power); return(putOrRemoveAll()); }
+    bool readAndPutOrRemoveAll() { readAll(); return(putOrRemoveAll()); }
   };
 
 // Helper function to avoid having to spell out the types explicitly.
@@ -422,7 +753,8 @@ class JSONStatsHolder final
 // (Key names of type MSG_JSON_SimpleStatsKey_t, or ints such as 0, can be used instead as placeholders,
 // and will leave free space in the stats object, eg to manually put values of that name.)
 // Use putOrRemoveAll() to put current values for all stats into the stats holder.
-// Use readAll() to force a read() of all sensors, eg at start-up.
+// Use readAll() to force a read() of all sensors, eg at start-up,
+// or readAndPutOrRemoveAll() to read then put all in one pass.
 template <typename... Args>
 constexpr JSONStatsHolder<Args...> makeJSONStatsHolder(Args&&... args)
     { return(JSONStatsHolder<Args...>(std::forward<Args>(args)...)); }
@@ -459,6 +791,52 @@ int8_t checkJSONMsgRXCRC(const uint8_t * const bptr, const uint8_t bufLen);
 void outputJSONStats(Print *p, bool secure, const uint8_t *json, uint8_t bufsize = 1+OTV0P2BASE::MSG_JSON_ABS_MAX_LENGTH);
 
 
+// One key/value pair from SimpleJSONStatsReader.
+// Key and string values point into the message and are NOT null-terminated.
+struct SimpleJSONStatsField final
+  {
+  // Key, without quotes.
+  const char *key;
+  uint8_t keyLen;
+  // True if the value is a string, eg the "@" ID, else an integer.
+  bool isString;
+  // String value, without quotes, if isString.
+  const char *str;
+  uint8_t strLen;
+  // Integer value, if !isString.
+  int16_t value;
+  // True if the key is the given (null-terminated) string.
+  bool keyIs(const char *k) const { return((0 == strncmp(key, k, keyLen)) && ('\0' == k[keyLen])); }
+  };
+
+// Zero-copy streaming tokeniser over one received JSON stats message,
+// as produced by SimpleStatsRotation, eg to aggregate, filter or re-encode
+// (for example in binary) on a hub without copying the message.
+// Handles the same subset of JSON as is generated:
+// a flat object of keys with integer (int16_t) or simple string values,
+// with no whitespace or escapes, terminated with '}' or '}'|0x80.
+// Not thread-/ISR- safe.
+class SimpleJSONStatsReader final
+  {
+  private:
+    const char *const buf;
+    const uint8_t len;
+    uint8_t pos;
+    bool bad;
+  public:
+    // Wrap a message buf of len bytes from its leading '{' to its final '}'
+    // inclusive, eg as returned by checkJSONMsgRXCRC().
+    // buf may be NULL only if len is 0.
+    SimpleJSONStatsReader(const uint8_t *const _buf, const uint8_t _len)
+      : buf((const char *)_buf), len(_len), pos(1),
+        bad((NULL == _buf) || (_len < 2) || ('{' != _buf[0]) || ('}' != (0x7f & _buf[_len-1]))) { }
+    // Get the next field; false at the end of the message or if it is malformed.
+    bool next(SimpleJSONStatsField &f);
+    // True if the message was read to its end without error.
+    bool isComplete() const { return(!bad && (pos == len - 1)); }
+  };
+
+
 } // OTV0P2BASE
 
 #endif // OTV0P2BASE_JSONSTATS_H
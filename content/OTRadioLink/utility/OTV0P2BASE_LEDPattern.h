@@ -0,0 +1,154 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Non-blocking LED flash patterns.
+
+ A pattern is a short list of step lengths in milliseconds,
+ alternately lit and dark starting lit (eg 5ms flash, 120ms gap, 15ms flash).
+ An LEDPatternPlayer shows it by switching the LED at monotonic tick boundaries
+ from tick(), called from the main loop each time it wakes or from the RTC tick,
+ so the CPU sleeps between steps instead of busy-waiting or napping through them.
+
+ Step timing is at monotonic tick resolution (~7.8ms), each step at least one tick.
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_LEDPATTERN_H
+#define OTV0P2BASE_LEDPATTERN_H
+
+#include <stdint.h>
+
+
+namespace OTV0P2BASE
+{
+
+
+// Sequence of alternately lit and dark steps, starting lit.
+class LEDPattern final
+    {
+    public:
+        // Maximum steps, eg three flashes and the gaps between them.
+        static constexpr uint8_t MAX_STEPS = 8;
+
+    private:
+        uint8_t stepMs[MAX_STEPS];
+        uint8_t n = 0;
+
+    public:
+        // Append a lit (even index) or dark (odd index) step of ms [1,255];
+        // returns false if full or ms is 0.
+        bool add(const uint8_t ms)
+            {
+            if((0 == ms) || (n >= MAX_STEPS)) { return(false); }
+            stepMs[n++] = ms;
+            return(true);
+            }
+        // Extend the last step by ms, eg for two back-to-back pauses; adds a step if empty.
+        // Saturates at 255ms.
+        void extend(const uint8_t ms)
+            {
+            if(0 == n) { add(ms); return; }
+            const uint16_t t = uint16_t(stepMs[n-1] + ms);
+            stepMs[n-1] = (t > 255) ? 255 : uint8_t(t);
+            }
+
+        uint8_t size() const { return(n); }
+        bool isEmpty() const { return(0 == n); }
+        void clear() { n = 0; }
+        // Length of step i in [0,size()).
+        uint8_t getStepMs(const uint8_t i) const { return(stepMs[i]); }
+        // True if step i is lit.
+        static constexpr bool isLitStep(const uint8_t i) { return(0 == (i & 1)); }
+
+        // Monotonic ticks (128/s) for ms, rounded up to at least one.
+        static constexpr uint8_t ticksFromMs(const uint8_t ms)
+            { return((0 == ms) ? 1 : uint8_t(((ms * 32U) + 249U) / 250U)); }
+    };
+
+// Shows one LEDPattern at a time without blocking.
+// Not thread-/ISR- safe: use from one context, eg only the main loop.
+class LEDPatternPlayer final
+    {
+    private:
+        // LED on/off output; never NULL.
+        void (*const LEDon)();
+        void (*const LEDoff)();
+
+        LEDPattern pattern;
+        // Current step, valid while active.
+        uint8_t step = 0;
+        bool active = false;
+        // True once stepEnd is set for the current step.
+        bool timed = false;
+        // Monotonic ticks at which the current step ends.
+        uint32_t stepEnd = 0;
+
+        // Apply step's LED level.
+        void show() { if(LEDPattern::isLitStep(step)) { LEDon(); } else { LEDoff(); } }
+
+    public:
+        LEDPatternPlayer(void (*const LEDon_)(), void (*const LEDoff_)())
+          : LEDon(LEDon_), LEDoff(LEDoff_) { }
+
+        // Show p, replacing any pattern in progress.
+        // Lights the LED at once; the first step is timed from the next tick().
+        // An empty pattern just stops.
+        void start(const LEDPattern &p)
+            {
+            if(p.isEmpty()) { stop(); return; }
+            pattern = p;
+            step = 0;
+            active = true;
+            timed = false;
+            show();
+            }
+
+        // Abandon any pattern and turn the LED off.
+        void stop() { active = false; LEDoff(); }
+
+        // True while a pattern is being shown.
+        bool isActive() const { return(active); }
+
+        // Advance to the monotonic tick nowTicks, eg getMonotonicTicks(),
+        // switching the LED as steps end; the LED is off once the pattern is done.
+        // Returns true while still active.
+        bool tick(const uint32_t nowTicks)
+            {
+            if(!active) { return(false); }
+            if(!timed)
+                {
+                stepEnd = nowTicks + LEDPattern::ticksFromMs(pattern.getStepMs(step));
+                timed = true;
+                }
+            // Allow for more than one step having passed, eg after a long sleep.
+            while((nowTicks - stepEnd) < 0x80000000UL)
+                {
+                if(++step >= pattern.size()) { stop(); return(false); }
+                stepEnd += LEDPattern::ticksFromMs(pattern.getStepMs(step));
+                show();
+                }
+            return(true);
+            }
+    };
+
+
+}
+
+#endif
@@ -238,6 +238,55 @@ void MinimalOneWireBase::skip()
   write(0xCC); // Skip ROM
   }
 
+// Find the ROM addresses of all devices on the bus, in search order.
+// Returns the number of addresses stored.
+uint8_t MinimalOneWireBase::scan(uint8_t roms[][8], const uint8_t maxDevices, const uint8_t family)
+  {
+  uint8_t n = 0;
+  uint8_t address[8];
+  reset_search();
+  while((n < maxDevices) && search(address))
+    {
+    if((0 != family) && (family != address[0])) { continue; }
+    for(uint8_t i = 0; i < 8; ++i) { roms[n][i] = address[i]; }
+    ++n;
+    }
+  reset_search(); // Be kind to any other OW search user.
+  return(n);
+  }
+
+// Send one command to all devices on the bus at once (SKIP ROM).
+// Returns false if no device is present.
+bool MinimalOneWireBase::broadcast(const uint8_t cmd)
+  {
+  if(!reset()) { return(false); }
+  skip();
+  write(cmd);
+  return(true);
+  }
+
+// Send a command to one device and read len bytes of its response into buf.
+// Returns false if no device is present.
+bool MinimalOneWireBase::readFrom(const uint8_t rom[8], const uint8_t cmd, uint8_t *const buf, const uint8_t len)
+  {
+  if(!reset()) { return(false); }
+  select(rom);
+  write(cmd);
+  for(uint8_t i = 0; i < len; ++i) { buf[i] = read(); }
+  // Terminate the read early if not all of the response is wanted.
+  reset();
+  return(true);
+  }
+
+// Send a command to each of n devices in turn and read len bytes of each response.
+// Returns the number of devices read.
+uint8_t MinimalOneWireBase::readAll(const uint8_t roms[][8], const uint8_t n, const uint8_t cmd, uint8_t *const buf, const uint8_t len)
+  {
+  for(uint8_t d = 0; d < n; ++d)
+    { if(!readFrom(roms[d], cmd, buf + (d * len), len)) { return(d); } }
+  return(n);
+  }
+
 
 }
 
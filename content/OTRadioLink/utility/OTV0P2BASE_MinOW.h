@@ -76,18 +76,23 @@ class MinimalOneWireBase
     uint8_t addr[8];
 
     // Standardised delays; must be inlined and usually have interrupts turned off around them.
-    // These are all reduced by enough time to allow two instructions, eg maximally-fast port operations.
-    static const uint8_t stdDelayReduction = 5; // 5 suggested by COHEAT in the field 2015/09, originally 2;
-    inline void delayA() const { OTV0P2BASE_delay_us(  6 - stdDelayReduction); }
-    inline void delayB() const { OTV0P2BASE_delay_us( 64 - stdDelayReduction); }
-    inline void delayC() const { OTV0P2BASE_delay_us( 60 - stdDelayReduction); }
-    inline void delayD() const { OTV0P2BASE_delay_us( 10 - stdDelayReduction); }
-    inline void delayE() const { OTV0P2BASE_delay_us(  9 - stdDelayReduction); }
-    inline void delayF() const { OTV0P2BASE_delay_us( 55 - stdDelayReduction); }
-    inline void delayG() const { OTV0P2BASE_delay_us(  0 - stdDelayReduction); }
-    inline void delayH() const { OTV0P2BASE_delay_us(480 - stdDelayReduction); }
-    inline void delayI() const { OTV0P2BASE_delay_us( 70 - stdDelayReduction); }
-    inline void delayJ() const { OTV0P2BASE_delay_us(410 - stdDelayReduction); }
+    // These are all reduced by enough time to allow a few instructions, eg maximally-fast port operations.
+    // 5 cycles (5us at 1MHz) suggested by COHEAT in the field 2015/09, originally 2;
+    // scaled (rounding up) for the CPU clock so that faster CPUs keep closer to nominal timings.
+    static constexpr uint8_t stdDelayReduction = (uint8_t)((5UL * 1000000UL + (F_CPU) - 1) / (F_CPU));
+    // Nominal delay us less the reduction, not less than zero.
+    static constexpr uint16_t reducedDelay(const uint16_t us)
+      { return((us > stdDelayReduction) ? (us - stdDelayReduction) : 0); }
+    inline void delayA() const { OTV0P2BASE_delay_us(reducedDelay(  6)); }
+    inline void delayB() const { OTV0P2BASE_delay_us(reducedDelay( 64)); }
+    inline void delayC() const { OTV0P2BASE_delay_us(reducedDelay( 60)); }
+    inline void delayD() const { OTV0P2BASE_delay_us(reducedDelay( 10)); }
+    inline void delayE() const { OTV0P2BASE_delay_us(reducedDelay(  9)); }
+    inline void delayF() const { OTV0P2BASE_delay_us(reducedDelay( 55)); }
+    inline void delayG() const { OTV0P2BASE_delay_us(reducedDelay(  0)); }
+    inline void delayH() const { OTV0P2BASE_delay_us(reducedDelay(480)); }
+    inline void delayI() const { OTV0P2BASE_delay_us(reducedDelay( 70)); }
+    inline void delayJ() const { OTV0P2BASE_delay_us(reducedDelay(410)); }
 
     // Fast direct GPIO operations.
     // Will be fastest (eg often single instructions) if their arguments are compile-time constants.
@@ -149,6 +154,27 @@ class MinimalOneWireBase
 
     // Select all devices on the bus
     void skip(void);
+
+    // Find the ROM addresses of all devices on the bus, in search order.
+    // Stores up to maxDevices addresses in roms;
+    // if family is non-zero then only devices with that family code (first ROM byte) are kept.
+    // Returns the number of addresses stored.
+    // Leaves the search state reset for any other user.
+    uint8_t scan(uint8_t roms[][8], uint8_t maxDevices, uint8_t family = 0);
+
+    // Send one command to all devices on the bus at once (SKIP ROM),
+    // eg to start a conversion on every sensor in parallel.
+    // Returns false if no device is present.
+    bool broadcast(uint8_t cmd);
+
+    // Send a command to one device and read len bytes of its response into buf.
+    // Returns false if no device is present.
+    bool readFrom(const uint8_t rom[8], uint8_t cmd, uint8_t *buf, uint8_t len);
+
+    // Send a command to each of n devices in turn and read len bytes of each response,
+    // stored consecutively in buf (which must hold n * len bytes).
+    // Returns the number of devices read, stopping early if the bus goes quiet.
+    uint8_t readAll(const uint8_t roms[][8], uint8_t n, uint8_t cmd, uint8_t *buf, uint8_t len);
 };
 
 // Not intended to be thread-/ISR- safe.
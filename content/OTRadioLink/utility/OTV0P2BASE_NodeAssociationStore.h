@@ -0,0 +1,245 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2018
+*/
+
+/*
+ Pluggable node association stores, eg for a hub with more secure nodes
+ than the V0P2BASE_EE_NODE_ASSOCIATIONS_MAX_SETS slots of the V0p2 EEPROM layout.
+
+ NodeAssociationStoreBase has 16-bit slot numbers, with implementations:
+   * NodeAssociationStoreTable over an existing 8-slot NodeAssociationTableBase
+     (eg NodeAssociationTableV0p2 or NodeAssociationTableStore),
+     whose RX message counters stay with the V0p2 secure frame RX code;
+   * NodeAssociationStoreExtended, IDs and their RX message counters
+     over any byte store (as for EEPROMWriteJournal) from a given address,
+     eg EEPROMSmartStore, or external flash via FlashEEPROM, for hundreds of nodes.
+ NodeAssociationStoreIndex is a RAM index over a store, sharing NodeIDPrefixIndex with NodeAssociationIndex,
+ so that finding a node is a binary search rather than a read of every slot.
+ OTRadioLink::SimpleSecureFrame32or0BodyRXStore puts these behind secure frame RX.
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_NODEASSOCIATIONSTORE_H
+#define OTV0P2BASE_NODEASSOCIATIONSTORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "OTV0P2BASE_EEPROM.h"
+#include "OTV0P2BASE_Security.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+// Node association store with 16-bit slot numbers.
+// Associations are contiguous from slot 0; an ID with leading byte 0xff is an empty slot.
+class NodeAssociationStoreBase
+    {
+    public:
+        static constexpr uint8_t idLength {V0P2BASE_EE_NODE_ASSOCIATIONS_8B_ID_LENGTH};
+        // Bytes of RX message counter per association, where held.
+        static constexpr uint8_t counterLength {6};
+
+        // Number of slots.
+        virtual uint16_t capacity() const = 0;
+        // Get the ID in slot into dest; false if out of range or dest is NULL.
+        virtual bool get(uint16_t slot, uint8_t *dest) const = 0;
+        // Set the ID in slot; false if out of range or src is NULL.
+        virtual bool set(uint16_t slot, const uint8_t *src) = 0;
+        // Get/set the last authenticated RX message counter of the association in slot;
+        // false if out of range, an argument is NULL, or this store holds no counters.
+        virtual bool getRXCounter(uint16_t /*slot*/, uint8_t * /*dest*/) const { return(false); }
+        virtual bool setRXCounter(uint16_t /*slot*/, const uint8_t * /*src*/) { return(false); }
+    };
+
+// The existing 8-slot association layout, via a NodeAssociationTableBase.
+// Holds no RX message counters.
+// Not thread-/ISR- safe.
+//   * table_t  eg NodeAssociationTableV0p2 or NodeAssociationTableStore
+template<class table_t>
+class NodeAssociationStoreTable final : public NodeAssociationStoreBase
+    {
+    private:
+        table_t &table;
+
+    public:
+        explicit NodeAssociationStoreTable(table_t &table_) : table(table_) { }
+
+        virtual uint16_t capacity() const override { return(table_t::maxSets); }
+        virtual bool get(const uint16_t slot, uint8_t *const dest) const override
+            {
+            if((slot >= table_t::maxSets) || (NULL == dest)) { return(false); }
+            table.get(uint8_t(slot), dest);
+            return(true);
+            }
+        virtual bool set(const uint16_t slot, const uint8_t *const src) override
+            {
+            if(slot >= table_t::maxSets) { return(false); }
+            return(table.set(uint8_t(slot), src));
+            }
+    };
+
+// Extended association layout in store from startAddr for nSlots associations,
+// each an ID then its RX message counter (most significant byte first),
+// all erased (0xff) when unused.
+// Counters must be written through at once, ie not via an EEPROMWriteJournal,
+// else a reset could allow replays.
+// Not thread-/ISR- safe.
+//   * store_t  byte store, eg EEPROMSmartStore, FlashEEPROM or MappedEEPROMImage
+template<class store_t, uint16_t nSlots, uintptr_t startAddr = 0>
+class NodeAssociationStoreExtended final : public NodeAssociationStoreBase
+    {
+    public:
+        static constexpr uint8_t recordSize = idLength + counterLength;
+        // First address beyond the layout.
+        static constexpr uintptr_t endAddr = startAddr + (uintptr_t(nSlots) * recordSize);
+
+    private:
+        store_t &store;
+
+        static constexpr uintptr_t addrOf(const uint16_t slot) { return(startAddr + (uintptr_t(slot) * recordSize)); }
+        bool read(const uint16_t slot, const uint8_t offset, uint8_t *const dest, const uint8_t len) const
+            {
+            if((slot >= nSlots) || (NULL == dest)) { return(false); }
+            const uintptr_t a = addrOf(slot) + offset;
+            for(uint8_t i = 0; i < len; ++i) { dest[i] = store.read(a + i); }
+            return(true);
+            }
+        bool write(const uint16_t slot, const uint8_t offset, const uint8_t *const src, const uint8_t len)
+            {
+            if((slot >= nSlots) || (NULL == src)) { return(false); }
+            const uintptr_t a = addrOf(slot) + offset;
+            for(uint8_t i = 0; i < len; ++i) { store.update(a + i, src[i]); }
+            return(true);
+            }
+
+    public:
+        explicit NodeAssociationStoreExtended(store_t &store_) : store(store_) { }
+
+        virtual uint16_t capacity() const override { return(nSlots); }
+        virtual bool get(const uint16_t slot, uint8_t *const dest) const override
+            { return(read(slot, 0, dest, idLength)); }
+        virtual bool set(const uint16_t slot, const uint8_t *const src) override
+            { return(write(slot, 0, src, idLength)); }
+        virtual bool getRXCounter(const uint16_t slot, uint8_t *const dest) const override
+            { return(read(slot, idLength, dest, counterLength)); }
+        virtual bool setRXCounter(const uint16_t slot, const uint8_t *const src) override
+            { return(write(slot, idLength, src, counterLength)); }
+
+        // Erase every slot, IDs and counters.
+        // Rebuild or invalidate any index over this afterwards.
+        void clear() { for(uintptr_t a = startAddr; a < endAddr; ++a) { store.update(a, 0xff); } }
+    };
+
+// Read the ID in slot i of store into id, as readNodeID() for NodeAssociationTableBase;
+// false if the slot is empty (0xff-leading) or unreadable.
+inline bool readNodeID(const NodeAssociationStoreBase &store, const uint16_t i, uint8_t *const id)
+    { return(store.get(i, id) && (0xff != id[0])); }
+
+// RAM index of the leading ID bytes of the associations in a store, sorted (then by slot):
+// a NodeIDPrefixIndex, as in NodeAssociationIndex, but for up to maxSlots associations
+// in any NodeAssociationStoreBase.
+// Finding a node is a binary search plus a read of the (usually one) candidate,
+// so the cost grows only slowly with the number of associations.
+// Costs 4 bytes of RAM per slot.
+// Built lazily from the store on first lookup;
+// must be invalidated whenever the store is altered other than via add().
+// Not thread-/ISR- safe.
+template<uint16_t maxSlots>
+class NodeAssociationStoreIndex final
+    {
+    static_assert(maxSlots <= 32767, "slots must fit in int16_t");
+
+    public:
+        static constexpr uint8_t idLength {NodeAssociationStoreBase::idLength};
+        // Number of leading ID bytes held in RAM for each entry.
+        static constexpr uint8_t keyLength {2};
+
+    private:
+        NodeIDPrefixIndex<uint16_t, maxSlots, keyLength> index;
+
+        // Usable slots of the store.
+        static uint16_t limit(const NodeAssociationStoreBase &store)
+            { const uint16_t c = store.capacity(); return((c < maxSlots) ? c : maxSlots); }
+
+    public:
+        // Forget the index contents; the next lookup rebuilds from the store.
+        void invalidate() { index.invalidate(); }
+        // True if the index has been built since last invalidated.
+        bool isValid() const { return(index.isValid()); }
+        // Number of associations indexed; only meaningful if isValid().
+        uint16_t size() const { return(index.size()); }
+        // Changes each time the index is rebuilt, as for NodeAssociationIndex.
+        uint8_t getGeneration() const { return(index.getGeneration()); }
+
+        // (Re)build the index from the store, stopping at the first empty slot;
+        // returns the number of associations indexed.
+        uint16_t build(const NodeAssociationStoreBase &store) { return(index.build(store, limit(store))); }
+
+        // Get the n-th (from 0) association, ordered by leading ID bytes then slot, whose ID starts with
+        // the prefixLen [1,8] bytes of prefix, and its full ID into nodeID if not NULL.
+        // Builds the index first if not valid.
+        // Returns the association's slot, or -1 if there is none.
+        int16_t getNextMatch(const NodeAssociationStoreBase &store, uint16_t n,
+                             const uint8_t *const prefix, const uint8_t prefixLen, uint8_t *const nodeID)
+            {
+            if((NULL == prefix) || (0 == prefixLen) || (prefixLen > idLength)) { return(-1); }
+            if(!index.isValid()) { build(store); }
+            const uint8_t kl = (prefixLen < keyLength) ? prefixLen : keyLength;
+            uint8_t temp[idLength];
+            for(uint16_t i = index.lowerBound(prefix, kl); index.keyMatches(i, prefix, kl); ++i)
+                {
+                const uint16_t slot = index.slotAt(i);
+                const bool needID = (prefixLen > keyLength) || (NULL != nodeID);
+                if(needID && !store.get(slot, temp)) { continue; }
+                if((prefixLen > keyLength) && (0 != memcmp(temp, prefix, prefixLen))) { continue; }
+                if(0 != n) { --n; continue; }
+                if(NULL != nodeID) { memcpy(nodeID, temp, idLength); }
+                return(int16_t(slot));
+                }
+            return(-1);
+            }
+
+        // Slot of the association with exactly the given (full) ID, or -1 if none.
+        int16_t find(const NodeAssociationStoreBase &store, const uint8_t *const id)
+            { return(getNextMatch(store, 0, id, idLength, NULL)); }
+
+        // Add an association in the next free slot, with its RX message counter
+        // (where held) zeroed, keeping the index valid.
+        // Returns the new slot, or the existing slot if id is already associated,
+        // or -1 if there is no space or id is NULL or starts with 0xff.
+        int16_t add(NodeAssociationStoreBase &store, const uint8_t *const id)
+            {
+            if((NULL == id) || (0xff == id[0])) { return(-1); }
+            const int16_t existing = find(store, id);
+            if(existing >= 0) { return(existing); }
+            const uint16_t slot = index.size();
+            if(slot >= limit(store)) { return(-1); }
+            if(!store.set(slot, id)) { return(-1); }
+            static const uint8_t zeros[NodeAssociationStoreBase::counterLength] = { };
+            store.setRXCounter(slot, zeros);
+            index.insert(id, slot);
+            return(int16_t(slot));
+            }
+    };
+
+}
+#endif
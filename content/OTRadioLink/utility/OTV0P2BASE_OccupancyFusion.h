@@ -0,0 +1,158 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Weighted fusion of occupancy evidence from several sources.
+
+ Rather than each source (UI, PIR, ambient light, voice, RH%)
+ poking PseudoSensorOccupancyTracker directly,
+ each reports its events here with noteEvent(),
+ and the tracker is marked only as strongly as the combined,
+ decaying evidence from all sources justifies.
+ So for example a single flicker of light or burst of noise
+ no longer holds a room warm as occupied on its own,
+ while a button press or PIR hit still counts at once.
+
+ Each source holds a score that halves every half-life,
+ decayed lazily only when that source has a new event;
+ tick() just advances a minute count.
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_OCCUPANCYFUSION_H
+#define OTV0P2BASE_OCCUPANCYFUSION_H
+
+#include <stdint.h>
+
+#include "OTV0P2BASE_SensorOccupancy.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+// Fuses occupancy events into calls on a PseudoSensorOccupancyTracker.
+// Integer-only.
+// Not thread-/ISR- safe: feed ISR-captured events
+// from the main loop, eg as feedOccupancy() does.
+class OccupancyFusion final
+    {
+    public:
+        // Evidence sources.
+        enum Source : uint8_t
+            {
+            SRC_UI = 0, // Local controls operated.
+            SRC_PIR, // PIR motion.
+            SRC_LIGHT, // Ambient light, eg from SensorAmbientLightAdaptive's occupancy callback.
+            SRC_VOICE, // Voice, eg VoiceDetectionQM1.
+            SRC_RH, // Rising relative humidity.
+            SRC_COUNT
+            };
+
+        // Fused score thresholds for markAsOccupied(),
+        // markAsPossiblyOccupied() and markAsJustPossiblyOccupied().
+        static constexpr uint8_t OCCUPIED_SCORE = 100;
+        static constexpr uint8_t POSSIBLE_SCORE = 50;
+        static constexpr uint8_t WEAK_SCORE = 25;
+
+        // Scores are taken as zero after this many half-lives.
+        static constexpr uint8_t MAX_HALF_LIVES = 8;
+
+    private:
+        PseudoSensorOccupancyTracker &occupancy;
+
+        // Per-source score added for a strong event, and half-life in minutes (non-zero).
+        uint8_t weight[SRC_COUNT];
+        uint8_t halfLifeM[SRC_COUNT];
+        // Per-source score as of stampM.
+        uint8_t score[SRC_COUNT] = { };
+        uint16_t stampM[SRC_COUNT] = { };
+
+        // Minutes since start; scores are cleared when it wraps.
+        uint16_t nowM = 0;
+
+        // Score of source s decayed to now.
+        uint8_t decayedScore(const uint8_t s) const
+            {
+            const uint16_t halvings = uint16_t(nowM - stampM[s]) / halfLifeM[s];
+            return((halvings >= MAX_HALF_LIVES) ? 0 : uint8_t(score[s] >> halvings));
+            }
+
+    public:
+        // Default weights let UI and PIR events alone mark the room occupied,
+        // light and voice alone only possibly occupied,
+        // and RH alone only just possibly occupied.
+        explicit OccupancyFusion(PseudoSensorOccupancyTracker &occupancy_)
+          : occupancy(occupancy_),
+            weight{ OCCUPIED_SCORE, OCCUPIED_SCORE, 60, 50, 30 },
+            halfLifeM{ 30, 8, 16, 16, 32 }
+            { }
+
+        // Set the weight and half-life (minutes, non-zero) for a source.
+        // Ignored for a bad source or zero half-life.
+        void setSource(const Source s, const uint8_t w, const uint8_t halfLife)
+            {
+            if((s >= SRC_COUNT) || (0 == halfLife)) { return; }
+            weight[s] = w;
+            halfLifeM[s] = halfLife;
+            }
+
+        // Call once per minute, eg next to the tracker's read().
+        void tick()
+            {
+            if(0 != ++nowM) { return; }
+            // Old stamps would alias after the wrap: forget everything.
+            for(uint8_t s = 0; s < SRC_COUNT; ++s) { score[s] = 0; stampM[s] = 0; }
+            }
+
+        // Note an event from a source; a weak event counts half weight.
+        // Marks the tracker as the fused score of all sources warrants.
+        // Returns the fused score [0,255].
+        uint8_t noteEvent(const Source s, const bool strong = true)
+            {
+            if(s >= SRC_COUNT) { return(0); }
+            const uint8_t add = strong ? weight[s] : uint8_t(weight[s] >> 1);
+            const uint16_t ns = uint16_t(decayedScore(s)) + add;
+            score[s] = (ns > 255) ? 255 : uint8_t(ns);
+            stampM[s] = nowM;
+            const uint8_t fused = getScore();
+            if(fused >= OCCUPIED_SCORE) { occupancy.markAsOccupied(); }
+            else if(fused >= POSSIBLE_SCORE) { occupancy.markAsPossiblyOccupied(); }
+            else if(fused >= WEAK_SCORE) { occupancy.markAsJustPossiblyOccupied(); }
+            return(fused);
+            }
+
+        // Fused score of all sources now, saturating at 255.
+        uint8_t getScore() const
+            {
+            uint16_t sum = 0;
+            for(uint8_t s = 0; s < SRC_COUNT; ++s) { sum += decayedScore(s); }
+            return((sum > 255) ? 255 : uint8_t(sum));
+            }
+        // Score of one source now; 0 for a bad source.
+        uint8_t getSourceScore(const Source s) const { return((s < SRC_COUNT) ? decayedScore(s) : 0); }
+
+        // Forget all evidence; weights are kept.
+        void reset() { nowM = 0; for(uint8_t s = 0; s < SRC_COUNT; ++s) { score[s] = 0; stampM[s] = 0; } }
+    };
+
+
+}
+
+#endif
@@ -0,0 +1,49 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2018
+*/
+
+/*
+ Continuous calibration of the internal RC oscillator against the 32768Hz crystal.
+ */
+
+#ifdef ARDUINO_ARCH_AVR
+#include <avr/io.h>
+#endif
+
+#include "OTV0P2BASE_OscCalibration.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+#ifdef ARDUINO_ARCH_AVR
+bool stepInternalOscCalibration(RCOscCalibrator &c)
+    {
+    const uint8_t count = HWTEST::measureInternalOscWithExtOsc();
+    const int8_t step = c.update(count);
+    if(0 == count) { return(false); }
+    const uint8_t cal = OSCCAL;
+    if(((step > 0) && (0x7f == (cal & 0x7f))) || ((step < 0) && (0 == (cal & 0x7f))))
+        { c.stepRefused(step); return(false); }
+    if(0 != step) { OSCCAL = uint8_t(cal + step); }
+    return(true);
+    }
+#endif
+
+
+}
@@ -0,0 +1,125 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2018
+*/
+
+/*
+ Continuous calibration of the internal RC oscillator (CPU clock)
+ against the 32768Hz crystal that drives the RTC.
+
+ calibrateInternalOscWithExtOsc() (see OTV0P2BASE_HardwareTests.h) trims OSCCAL once,
+ but the RC oscillator drifts with temperature and supply voltage,
+ which upsets soft-serial bit timing and busy delays.
+ Calling stepInternalOscCalibration() periodically, eg once a minute when idle,
+ keeps it trimmed by at most one OSCCAL step per call,
+ and the RCOscCalibrator records drift stats.
+
+ The decision logic is portable; the measurement and OSCCAL access are AVR only.
+ */
+
+#ifndef OTV0P2BASE_OSCCALIBRATION_H
+#define OTV0P2BASE_OSCCALIBRATION_H
+
+#include <stdint.h>
+
+#include "OTV0P2BASE_HardwareTests.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+// Decides small OSCCAL steps from successive measurements of the RC clock against the crystal,
+// eg from HWTEST::measureInternalOscWithExtOsc(), and keeps drift stats.
+// Measurement noise of a count or so is smoothed by averaging successive errors,
+// and no step is made while the averaged error is within the deadband.
+// Not thread-/ISR- safe.
+class RCOscCalibrator final
+    {
+    private:
+        // Target count.
+        const uint8_t target;
+        // Averaged error is within +/- this many counts when locked.
+        const uint8_t deadband;
+
+        // Averaged error in 1/4 counts.
+        int16_t filteredX4 = 0;
+        // True when the next measurement should seed filteredX4, eg after a step.
+        bool reseed = true;
+
+        uint16_t measurements = 0;
+        uint16_t failures = 0;
+        int8_t lastError = 0;
+        uint8_t maxAbsError = 0;
+        // Net OSCCAL steps made, ie drift since the first measurement.
+        int16_t netSteps = 0;
+
+    public:
+        constexpr RCOscCalibrator(const uint8_t targetCount, const uint8_t deadband_ = 1)
+          : target(targetCount), deadband(deadband_) { }
+
+        // Record one measured count (0 if the measurement failed, which is ignored),
+        // and return the OSCCAL step the caller should make: -1 (RC clock fast), 0 or +1 (slow).
+        int8_t update(const uint8_t count)
+            {
+            if(0 == count) { ++failures; return(0); }
+            ++measurements;
+            const int16_t e = int16_t(count) - int16_t(target);
+            lastError = int8_t((e > 127) ? 127 : ((e < -127) ? -127 : e));
+            const uint8_t ae = uint8_t((lastError < 0) ? -lastError : lastError);
+            if(ae > maxAbsError) { maxAbsError = ae; }
+            if(reseed) { filteredX4 = int16_t(4 * lastError); reseed = false; }
+            else { filteredX4 = int16_t((filteredX4 + (4 * lastError)) / 2); }
+            if(isLocked()) { return(0); }
+            // Wait for fresh measurements at the new setting before stepping again.
+            reseed = true;
+            const int8_t step = (filteredX4 > 0) ? -1 : +1;
+            netSteps += step;
+            return(step);
+            }
+        // Undo the accounting for a step returned by update() that could not be made,
+        // eg at the end of the OSCCAL range.
+        void stepRefused(const int8_t step) { netSteps -= step; }
+
+        // True if the averaged error is within the deadband.
+        bool isLocked() const
+            { return((filteredX4 <= 4 * int16_t(deadband)) && (filteredX4 >= -4 * int16_t(deadband))); }
+        // Averaged error in 1/4 counts; positive means the RC clock is fast.
+        int16_t getFilteredErrorX4() const { return(filteredX4); }
+        // Error of the last good measurement, in counts.
+        int8_t getLastError() const { return(lastError); }
+        // Largest absolute error seen since the stats were reset.
+        uint8_t getMaxAbsError() const { return(maxAbsError); }
+        // Net OSCCAL steps made since the stats were reset.
+        int16_t getNetSteps() const { return(netSteps); }
+        uint16_t getMeasurements() const { return(measurements); }
+        // Measurements that failed, eg with the crystal not running.
+        uint16_t getFailures() const { return(failures); }
+        // Reset the stats, but not the averaged error.
+        void resetStats() { measurements = 0; failures = 0; maxAbsError = 0; netSteps = 0; }
+    };
+
+#ifdef ARDUINO_ARCH_AVR
+// Measure the RC clock against the crystal once and make at most one OSCCAL step.
+// Blocks interrupts for up to ~16ms, so call when idle and not receiving soft serial.
+// Does not cross between the two (overlapping) halves of the ATmega328P OSCCAL range.
+// Returns false if the measurement failed or a needed step was not possible.
+bool stepInternalOscCalibration(RCOscCalibrator &c);
+#endif
+
+
+}
+#endif
@@ -0,0 +1,146 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Pin-change edge capture for short activity pulses (eg PIR, QM1 voice),
+ so that they are neither missed between polls nor need fast polling.
+
+ The application's pin-change ISR, eg ISR(PCINT2_vect), passes the port
+ input register and the sub-cycle time to captureFromISR(),
+ which queues any edges on the watched pins in a small lock-free ring.
+ The main loop then drains the ring at its leisure, eg with feedOccupancy().
+
+ Portable; the ISR wiring is the application's, as for other handlers.
+ */
+
+#ifndef OTV0P2BASE_PINCHANGECAPTURE_H
+#define OTV0P2BASE_PINCHANGECAPTURE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "OTV0P2BASE_Concurrency.h"
+#include "OTV0P2BASE_SensorOccupancy.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+// One captured pin-change event.
+struct PinChangeEdge final
+    {
+    // getSubCycleTime() when captured.
+    uint8_t subCycleTime;
+    // Watched pins that changed, as a port bit mask; non-zero.
+    uint8_t changed;
+    // Port input level after the change, masked to the watched pins.
+    uint8_t pins;
+
+    // True if any of the pins in mask went to the level given by activeHighMask (1 for high).
+    bool anyBecameActive(const uint8_t mask, const uint8_t activeHighMask = 0xff) const
+        { return(0 != (changed & mask & ~(pins ^ activeHighMask))); }
+    };
+
+// Lock-free single-producer (ISR) single-consumer (main loop) ring of edges on one 8-bit port.
+// Only the ISR writes lastPins and pushes to the SPSCQueue, so no locking is needed.
+// When full new edges are dropped and counted, so that the oldest are kept.
+// A pulse so short that the port reads unchanged by the time the ISR runs is not recorded.
+//   * queueSize  capacity in edges; a power of two in [2,128]
+template<uint8_t queueSize = 8>
+class PinChangeCapture final
+    {
+    static_assert((queueSize >= 2) && (queueSize <= 128) && (0 == (queueSize & (queueSize - 1))),
+        "queueSize must be a power of two in [2,128]");
+
+    private:
+        // Watched pins on the port.
+        const uint8_t watchMask;
+
+        // Queued edges; counts those dropped because it was full.
+        SPSCQueue<PinChangeEdge, queueSize> ring;
+
+        // Watched pin levels as last seen by the ISR.
+        volatile uint8_t lastPins;
+
+    public:
+        // Watch the pins in watchMask, with their initial levels initialPins.
+        PinChangeCapture(const uint8_t watchMask_, const uint8_t initialPins = 0)
+          : watchMask(watchMask_), lastPins(initialPins & watchMask_) { }
+
+        // Record any edges on the watched pins, given the current port input, eg PIND.
+        // Call from the pin-change ISR for the port, with getSubCycleTime().
+        // Returns true if any watched pin changed,
+        // else another handler in the chain should be tried.
+        // Fast and ISR-safe; not to be called concurrently with itself.
+        bool captureFromISR(const uint8_t portPins, const uint8_t subCycleTime)
+            {
+            const uint8_t pins = portPins & watchMask;
+            const uint8_t changed = pins ^ lastPins;
+            if(0 == changed) { return(false); }
+            lastPins = pins;
+            PinChangeEdge *const e = ring.reserve();
+            if(NULL == e) { return(true); }
+            e->subCycleTime = subCycleTime;
+            e->changed = changed;
+            e->pins = pins;
+            // Publish only once the entry is complete.
+            ring.commit();
+            return(true);
+            }
+
+        // Number of edges queued.
+        uint8_t available() const { return(ring.size()); }
+
+        // Remove the oldest edge into e; returns false if none.
+        // Not ISR-safe, and only for a single consumer.
+        bool pop(PinChangeEdge &e) { return(ring.pop(e)); }
+
+        // Number of edges dropped because the queue was full; saturates at 255.
+        uint8_t getDropped() const { return(ring.getDropped()); }
+        // Clear the count of dropped edges.
+        void clearDropped() { ring.clearDropped(); }
+    };
+
+// Drain all captured edges into the occupancy tracker.
+// An edge to the active level on markOccupiedMask pins (eg PIR)
+// calls markAsOccupied(), and on markPossiblyOccupiedMask pins (eg QM1)
+// calls markAsPossiblyOccupied().
+// Returns the number of edges consumed.
+// Not ISR-safe; call from the main loop, ideally before the tracker's read().
+//   * activeHighMask  watched pins active high (1) or low (0)
+template<class capture_t>
+uint8_t feedOccupancy(capture_t &capture, PseudoSensorOccupancyTracker &occupancy,
+                      const uint8_t markOccupiedMask, const uint8_t markPossiblyOccupiedMask,
+                      const uint8_t activeHighMask = 0xff)
+    {
+    uint8_t n = 0;
+    PinChangeEdge e;
+    while(capture.pop(e))
+        {
+        ++n;
+        if(e.anyBecameActive(markOccupiedMask, activeHighMask)) { occupancy.markAsOccupied(); }
+        else if(e.anyBecameActive(markPossiblyOccupiedMask, activeHighMask)) { occupancy.markAsPossiblyOccupied(); }
+        }
+    return(n);
+    }
+
+
+}
+
+#endif
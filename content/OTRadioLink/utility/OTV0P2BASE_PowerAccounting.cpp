@@ -0,0 +1,65 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Power-state accounting.
+ */
+
+#include "OTV0P2BASE_PowerAccounting.h"
+
+#include "OTV0P2BASE_Concurrency.h"
+#include "OTV0P2BASE_RTC.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+#ifdef OTV0P2BASE_POWER_ACCOUNTING
+// Global instance.
+PowerStateMeter powerMeter;
+
+uint32_t powerMeterNow()
+    {
+#if defined(ARDUINO_ARCH_AVR) || defined(V0P2BASE_EFR32_SUBCYCLE)
+    return(getMonotonicTicks());
+#else
+    // No sub-cycle clock on this platform.
+    return(0);
+#endif
+    }
+
+void powerMeterOn(const uint8_t domain)
+    {
+    RAII_AtomicBlock atomic;
+    powerMeter.on(domain, powerMeterNow());
+    }
+void powerMeterOff(const uint8_t domain)
+    {
+    RAII_AtomicBlock atomic;
+    powerMeter.off(domain, powerMeterNow());
+    }
+void powerMeterCPU(const uint8_t state)
+    {
+    RAII_AtomicBlock atomic;
+    powerMeter.setCPUState(state, powerMeterNow());
+    }
+#endif // OTV0P2BASE_POWER_ACCOUNTING
+
+
+}
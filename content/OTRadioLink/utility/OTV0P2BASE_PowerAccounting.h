@@ -0,0 +1,214 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Power-state accounting: how long each power-hungry peripheral is on,
+ and how long the CPU spends active, idle and in power-save,
+ so that the mAh of a field unit can be attributed.
+
+ The peripheral power routines (OTV0P2BASE_PowerManagement.h),
+ the sleep routines, the radio driver and the valve motor drivers
+ report transitions with OT_POWER_ON(), OT_POWER_OFF() and OT_CPU_STATE()
+ into a global PowerStateMeter timed by the monotonic sub-cycle clock.
+ Totals can be read with the CLI::DumpPower command and added to stats with putPowerStats().
+
+ Accounting is enabled by defining OTV0P2BASE_POWER_ACCOUNTING for the whole build;
+ otherwise the hooks compile to nothing and their arguments are not evaluated.
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_POWERACCOUNTING_H
+#define OTV0P2BASE_POWERACCOUNTING_H
+
+#include <stdint.h>
+
+#include "OTV0P2BASE_Sensor.h"
+
+#ifdef OTV0P2BASE_POWER_ACCOUNTING
+// Note that peripheral domain (a PowerDomain value) has been powered up.
+#define OT_POWER_ON(domain) ::OTV0P2BASE::powerMeterOn(uint8_t(domain))
+// Note that peripheral domain has been powered down.
+#define OT_POWER_OFF(domain) ::OTV0P2BASE::powerMeterOff(uint8_t(domain))
+// Note that the CPU is entering state (a CPUPowerState value).
+#define OT_CPU_STATE(state) ::OTV0P2BASE::powerMeterCPU(uint8_t(state))
+#else
+#define OT_POWER_ON(domain) do { } while(false)
+#define OT_POWER_OFF(domain) do { } while(false)
+#define OT_CPU_STATE(state) do { } while(false)
+#endif
+
+
+namespace OTV0P2BASE
+{
+
+
+// Peripherals whose on-time is accounted.
+namespace PowerDomain
+    {
+    // (Names avoid the Arduino/AVR SPI, ADC and SERIAL symbols.)
+    static constexpr uint8_t SPI_BUS = 0;
+    static constexpr uint8_t ANALOGUE = 1;
+    // Hardware UART.
+    static constexpr uint8_t UART = 2;
+    // I2C.
+    static constexpr uint8_t TWI = 3;
+    // Radio receiving (or listening).
+    static constexpr uint8_t RADIO_RX = 4;
+    // Radio transmitting.
+    static constexpr uint8_t RADIO_TX = 5;
+    // Valve motor driven.
+    static constexpr uint8_t MOTOR = 6;
+    // Number of domains.
+    static constexpr uint8_t COUNT = 7;
+    }
+
+// CPU states whose time is accounted; exactly one is current.
+namespace CPUPowerState
+    {
+    // Running, including ISRs that run while otherwise active.
+    static constexpr uint8_t ACTIVE = 0;
+    // Idle sleep, with peripheral clocks running.
+    static constexpr uint8_t IDLE = 1;
+    // Power-save sleep, with only the RTC and watchdog running.
+    static constexpr uint8_t POWER_SAVE = 2;
+    // Number of states.
+    static constexpr uint8_t COUNT = 3;
+    }
+
+// Accumulates on-time per peripheral domain and time per CPU state
+// in monotonic sub-cycle ticks (see getMonotonicTicks()).
+// Periods shorter than one tick are credited a whole tick or none
+// depending on whether a tick boundary falls inside them,
+// so short frequent periods (eg SPI bursts) average out correctly over many.
+// Repeated on() or off() for a domain are ignored, so that nested power-ups count once.
+// Not thread-/ISR- safe; the global hooks lock out interrupts around it.
+class PowerStateMeter final
+    {
+    private:
+        // Completed on-time per domain.
+        uint32_t onTicks[PowerDomain::COUNT];
+        // When each domain currently on was turned on.
+        uint32_t onSince[PowerDomain::COUNT];
+        // Completed time per CPU state.
+        uint32_t cpuTicks[CPUPowerState::COUNT];
+        // When the current CPU state was entered.
+        uint32_t cpuSince;
+        // When accounting (re)started.
+        uint32_t start;
+        // Bitmap of domains currently on.
+        uint8_t onMask = 0;
+        uint8_t cpuState = CPUPowerState::ACTIVE;
+
+    public:
+        //   * now  monotonic ticks at the start of accounting
+        explicit PowerStateMeter(const uint32_t now = 0) : onTicks(), onSince(), cpuTicks(), cpuSince(now), start(now) { }
+
+        // Domain turned on at now; ignored if already on or out of range.
+        void on(const uint8_t domain, const uint32_t now)
+            {
+            if((domain >= PowerDomain::COUNT) || isOn(domain)) { return; }
+            onSince[domain] = now;
+            onMask |= uint8_t(1U << domain);
+            }
+        // Domain turned off at now; ignored if already off or out of range.
+        void off(const uint8_t domain, const uint32_t now)
+            {
+            if((domain >= PowerDomain::COUNT) || !isOn(domain)) { return; }
+            onTicks[domain] += now - onSince[domain];
+            onMask &= uint8_t(~(1U << domain));
+            }
+        // CPU enters state at now; ignored if out of range.
+        void setCPUState(const uint8_t state, const uint32_t now)
+            {
+            if(state >= CPUPowerState::COUNT) { return; }
+            cpuTicks[cpuState] += now - cpuSince;
+            cpuSince = now;
+            cpuState = state;
+            }
+
+        bool isOn(const uint8_t domain) const { return((domain < PowerDomain::COUNT) && (0 != (onMask & (1U << domain)))); }
+        uint8_t getCPUState() const { return(cpuState); }
+
+        // On-time for domain up to now, including any current period.
+        uint32_t getOnTicks(const uint8_t domain, const uint32_t now) const
+            {
+            if(domain >= PowerDomain::COUNT) { return(0); }
+            return(onTicks[domain] + (isOn(domain) ? (now - onSince[domain]) : 0));
+            }
+        // Time in CPU state up to now, including any current period.
+        uint32_t getCPUTicks(const uint8_t state, const uint32_t now) const
+            {
+            if(state >= CPUPowerState::COUNT) { return(0); }
+            return(cpuTicks[state] + ((state == cpuState) ? (now - cpuSince) : 0));
+            }
+        // Time since accounting (re)started.
+        uint32_t getElapsedTicks(const uint32_t now) const { return(now - start); }
+
+        // Fraction of the elapsed time to now that ticks represents, in parts per thousand [0,1000];
+        // 0 if no time has elapsed.
+        uint16_t perMille(uint32_t ticks, const uint32_t now) const
+            {
+            uint32_t e = getElapsedTicks(now);
+            if(0 == e) { return(0); }
+            if(ticks > e) { ticks = e; }
+            // Scale both down until ticks * 1000 cannot overflow.
+            while(e > 0x3fffffUL) { e >>= 1; ticks >>= 1; }
+            return(uint16_t((ticks * 1000U) / e));
+            }
+
+        // Clear all totals and restart accounting at now,
+        // keeping the domains that are on and the CPU state.
+        void reset(const uint32_t now)
+            {
+            for(uint8_t i = 0; i < PowerDomain::COUNT; ++i) { onTicks[i] = 0; onSince[i] = now; }
+            for(uint8_t i = 0; i < CPUPowerState::COUNT; ++i) { cpuTicks[i] = 0; }
+            cpuSince = now;
+            start = now;
+            }
+    };
+
+// Add the power accounting to stats as low-priority parts-per-thousand of the elapsed time:
+// CPU active "pwA" and idle "pwI", radio RX "pwR" and TX "pwT", and motor "pwM".
+//   * ss  stats, eg a SimpleStatsRotation
+template<class stats_t>
+void putPowerStats(stats_t &ss, const PowerStateMeter &m, const uint32_t now)
+    {
+    ss.put(V0p2_SENSOR_TAG_F("pwA"), int16_t(m.perMille(m.getCPUTicks(CPUPowerState::ACTIVE, now), now)), true);
+    ss.put(V0p2_SENSOR_TAG_F("pwI"), int16_t(m.perMille(m.getCPUTicks(CPUPowerState::IDLE, now), now)), true);
+    ss.put(V0p2_SENSOR_TAG_F("pwR"), int16_t(m.perMille(m.getOnTicks(PowerDomain::RADIO_RX, now), now)), true);
+    ss.put(V0p2_SENSOR_TAG_F("pwT"), int16_t(m.perMille(m.getOnTicks(PowerDomain::RADIO_TX, now), now)), true);
+    ss.put(V0p2_SENSOR_TAG_F("pwM"), int16_t(m.perMille(m.getOnTicks(PowerDomain::MOTOR, now), now)), true);
+    }
+
+#ifdef OTV0P2BASE_POWER_ACCOUNTING
+// The global meter fed by the OT_POWER_*() and OT_CPU_STATE() hooks.
+extern PowerStateMeter powerMeter;
+// Current monotonic ticks for powerMeter, or 0 where there is no sub-cycle clock.
+uint32_t powerMeterNow();
+// Hooks; use via the macros.
+// ISR-safe.
+void powerMeterOn(uint8_t domain);
+void powerMeterOff(uint8_t domain);
+void powerMeterCPU(uint8_t state);
+#endif
+
+
+}
+
+#endif
@@ -54,7 +54,9 @@ namespace OTV0P2BASE
       {
       if(!(PRR & _BV(PRADC))) { return(false); }
       PRR &= ~_BV(PRADC); // Enable the ADC.
+      applyCPUClockPolicy(); // ADC clock is derived from the CPU clock.
       ADCSRA |= _BV(ADEN);
+      OT_POWER_ON(PowerDomain::ANALOGUE);
       return(true);
       }
 
@@ -142,6 +144,8 @@ void powerDownSerial()
   pinMode(V0p2_PIN_SERIAL_RX, INPUT_PULLUP);
   pinMode(V0p2_PIN_SERIAL_TX, INPUT_PULLUP);
   PRR |= _BV(PRUSART0); // Disable the UART module.
+  applyCPUClockPolicy();
+  OT_POWER_OFF(PowerDomain::UART);
   }
 #endif // ARDUINO_ARCH_AVR
 
@@ -155,8 +159,10 @@ void powerDownSerial()
       if(!(PRR & _BV(PRTWI))) { return(false); }
 
       PRR &= ~_BV(PRTWI); // Enable TWI power.
+      applyCPUClockPolicy(); // TWI clock is derived from the CPU clock.
       TWCR |= _BV(TWEN); // Enable TWI.
       Wire.begin(); // Set it going.
+      OT_POWER_ON(PowerDomain::TWI);
       // TODO: reset TWBR and prescaler for our low CPU frequency     (TWBR = ((F_CPU / TWI_FREQ) - 16) / 2 gives -3!)
     #if F_CPU <= 1000000
       TWBR = 0; // Implies SCL freq of F_CPU / (16 + 2 * TBWR * PRESC) = 62.5kHz @ F_CPU==1MHz and PRESC==1 (from Wire/TWI code).
@@ -169,6 +175,8 @@ void powerDownSerial()
       {
       TWCR &= ~_BV(TWEN); // Disable TWI.
       PRR |= _BV(PRTWI); // Disable TWI power.
+      applyCPUClockPolicy();
+      OT_POWER_OFF(PowerDomain::TWI);
 
       // De-activate internal pullups for TWI especially if powering down all TWI devices.
       //digitalWrite(SDA, 0);
@@ -383,6 +391,7 @@ void minimisePowerWithoutSleep()
     //    ;
   DIDR1 = (1<<AIN1D)|(1<<AIN0D); // Disable digital input buffer on AIN1/0.
   power_adc_disable();
+  OT_POWER_OFF(PowerDomain::ANALOGUE);
 
   // Ensure that SPI is powered down.
   OTV0P2BASE::powerDownSPI();
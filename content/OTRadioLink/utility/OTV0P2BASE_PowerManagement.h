@@ -40,7 +40,9 @@ Author(s) / Copyright (s): Damon Hart-Davis 2013--2018
 #endif
 
 #include "OTV0P2BASE_BasicPinAssignments.h"
+#include "OTV0P2BASE_CPUClockPolicy.h"
 #include "OTV0P2BASE_FastDigitalIO.h"
+#include "OTV0P2BASE_PowerAccounting.h"
 #include "OTV0P2BASE_Sensor.h"
 
 
@@ -87,6 +89,8 @@ void power_intermittent_peripherals_disable();
       {
       ADCSRA &= ~_BV(ADEN); // Do before power_[adc|all]_disable() to avoid freezing the ADC in an active state!
       PRR |= _BV(PRADC); // Disable the ADC.
+      applyCPUClockPolicy();
+      OT_POWER_OFF(PowerDomain::ANALOGUE);
       }
 #elif defined(EFR32FG1P133F256GM48)
     // If ADC was disabled, power it up, and return true.
@@ -129,6 +133,7 @@ void power_intermittent_peripherals_disable();
             pinMode(SPI_nSS, OUTPUT);
 
             PRR &= ~_BV(PRSPI); // Enable SPI power.
+            applyCPUClockPolicy(); // SPI clock is derived from the CPU clock.
 
             // Configure raw SPI to match better how it was used in PICAXE V0.09 code.
             // CPOL = 0, CPHA = 0
@@ -144,6 +149,7 @@ void power_intermittent_peripherals_disable();
             SPCR = _BV(SPR0) | ENABLE_MASTER; // 8x clock prescale for ~2MHz SPI clock from nominal ~16MHz CPU clock.
             SPSR = _BV(SPI2X);
 #endif
+            OT_POWER_ON(PowerDomain::SPI_BUS);
             }
         return(true);
         }
@@ -159,6 +165,8 @@ void power_intermittent_peripherals_disable();
 
             SPCR &= ~_BV(SPE); // Disable SPI.
             PRR |= _BV(PRSPI); // Power down...
+            applyCPUClockPolicy();
+            OT_POWER_OFF(PowerDomain::SPI_BUS);
 
             // Ensure that nSS is an output to avoid forcing SPI to slave mode by accident.
             pinMode(SPI_nSS, OUTPUT);
@@ -226,7 +234,9 @@ void power_intermittent_peripherals_disable();
 	  {
 	  if(_serialIsPoweredUp()) { return(false); }
 	  PRR &= ~_BV(PRUSART0); // Enable the UART.
+	  applyCPUClockPolicy(); // Baud rate is derived from the CPU clock.
 	  Serial.begin(baud); // Set it going.
+	  OT_POWER_ON(PowerDomain::UART);
 	  return(true);
 	  }
 	// Flush any pending serial (UART/USART0) output and power it down.
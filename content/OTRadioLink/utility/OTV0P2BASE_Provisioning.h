@@ -0,0 +1,319 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Bulk binary provisioning of key, node ID and node associations.
+
+ One transaction is a sequence of records, each:
+    type (1 byte), payload length (1 byte), payload
+ with record types:
+    'K'  16-byte primary building key, or empty to clear the key
+    'I'  8-byte node ID
+    'A'  n x 8-byte node IDs, n in [0,V0P2BASE_EE_NODE_ASSOCIATIONS_MAX_SETS],
+         replacing all existing associations
+    'E'  2-byte CRC16 (crc16_A001_buf() from 0xffff, LSB first)
+         over all preceding bytes; must be last
+ Each of K/I/A may appear at most once; all are optional.
+
+ The whole transaction is checked before anything is written,
+ so a corrupted or truncated transfer changes nothing.
+ Writes are batched through an EEPROMWriteJournal flushed before returning,
+ then every written byte is read back and checked.
+
+ An association whose ID is already in the same slot keeps its RX counters;
+ any other new association has the rest of its set erased as for addNodeAssociation().
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_PROVISIONING_H
+#define OTV0P2BASE_PROVISIONING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "OTV0P2BASE_CRC.h"
+#include "OTV0P2BASE_EEPROM.h"
+#include "OTV0P2BASE_EEPROMJournal.h"
+#include "OTV0P2BASE_Security.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+// Key and ID locations in the V0p2 layout,
+// usable off AVR where V0P2BASE_EE_START_ID etc are not defined.
+static constexpr uintptr_t PROVISION_EE_START_KEY = 112;
+static constexpr uint8_t PROVISION_KEY_LENGTH = 16;
+static constexpr uintptr_t PROVISION_EE_START_ID = 20;
+static constexpr uint8_t PROVISION_ID_LENGTH = OpenTRV_Node_ID_Bytes;
+#ifdef ARDUINO_ARCH_AVR
+static_assert(PROVISION_EE_START_KEY == VOP2BASE_EE_START_16BYTE_PRIMARY_BUILDING_KEY, "key layout mismatch");
+static_assert(PROVISION_KEY_LENGTH == VOP2BASE_EE_LEN_16BYTE_PRIMARY_BUILDING_KEY, "key layout mismatch");
+static_assert(PROVISION_EE_START_ID == V0P2BASE_EE_START_ID, "ID layout mismatch");
+static_assert(PROVISION_ID_LENGTH == V0P2BASE_EE_LEN_ID, "ID layout mismatch");
+#endif
+
+// Provisioning record types.
+static constexpr uint8_t PROVISION_REC_KEY = 'K';
+static constexpr uint8_t PROVISION_REC_ID = 'I';
+static constexpr uint8_t PROVISION_REC_ASSOCIATIONS = 'A';
+static constexpr uint8_t PROVISION_REC_END = 'E';
+// Largest valid transaction in bytes, with every record present and full.
+static constexpr uint8_t PROVISION_MAX_BYTES =
+    (2 + PROVISION_KEY_LENGTH) +
+    (2 + PROVISION_ID_LENGTH) +
+    (2 + (V0P2BASE_EE_NODE_ASSOCIATIONS_MAX_SETS * V0P2BASE_EE_NODE_ASSOCIATIONS_8B_ID_LENGTH)) +
+    (2 + 2);
+
+enum ProvisioningResult : uint8_t
+    {
+    PROVISION_OK = 0,
+    PROVISION_BAD_FORMAT,   // Truncated, unknown or repeated record, or bad length; nothing written.
+    PROVISION_BAD_CRC,      // Missing or wrong end CRC; nothing written.
+    PROVISION_BAD_VALUE,    // Invalid ID byte or all-1s key; nothing written.
+    PROVISION_VERIFY_FAILED // Written but did not read back correctly, eg worn EEPROM.
+    };
+
+// What a successful transaction changed, for the caller to refresh RAM state.
+struct ProvisioningSummary final
+    {
+    bool keySet = false;
+    bool keyCleared = false;
+    bool idSet = false;
+    // Associations written, or -1 if not in the transaction.
+    int8_t associations = -1;
+    };
+
+// Builds a transaction in a caller-supplied buffer, eg for tools and tests.
+// Each add*() returns false (and adds nothing) if out of space or arguments are bad.
+class ProvisioningBuilder final
+    {
+    private:
+        uint8_t *const buf;
+        const uint8_t bufLen;
+        uint8_t used = 0;
+
+        bool addRecord(const uint8_t type, const uint8_t *const payload, const uint8_t payloadLen)
+            {
+            if((NULL == buf) || (bufLen - used < 2 + payloadLen)) { return(false); }
+            buf[used++] = type;
+            buf[used++] = payloadLen;
+            if(0 != payloadLen) { memcpy(buf + used, payload, payloadLen); used += payloadLen; }
+            return(true);
+            }
+
+    public:
+        ProvisioningBuilder(uint8_t *const buf_, const uint8_t bufLen_) : buf(buf_), bufLen(bufLen_) { }
+
+        // Set the key, or clear it if key is NULL.
+        bool addKey(const uint8_t *const key)
+            { return(addRecord(PROVISION_REC_KEY, key, (NULL == key) ? 0 : PROVISION_KEY_LENGTH)); }
+        bool addID(const uint8_t *const id)
+            { return((NULL != id) && addRecord(PROVISION_REC_ID, id, PROVISION_ID_LENGTH)); }
+        // Replace all associations with n 8-byte IDs packed in ids.
+        bool addAssociations(const uint8_t *const ids, const uint8_t n)
+            {
+            if((n > V0P2BASE_EE_NODE_ASSOCIATIONS_MAX_SETS) || ((NULL == ids) && (0 != n))) { return(false); }
+            return(addRecord(PROVISION_REC_ASSOCIATIONS, ids, n * V0P2BASE_EE_NODE_ASSOCIATIONS_8B_ID_LENGTH));
+            }
+        // Append the end CRC; returns the total length, or 0 if out of space.
+        uint8_t finish()
+            {
+            if((NULL == buf) || (bufLen - used < 4)) { return(0); }
+            buf[used] = PROVISION_REC_END;
+            buf[used + 1] = 2;
+            const uint16_t crc = crc16_A001_buf(0xffff, buf, uint8_t(used + 2));
+            buf[used + 2] = uint8_t(crc);
+            buf[used + 3] = uint8_t(crc >> 8);
+            used += 4;
+            return(used);
+            }
+    };
+
+namespace provisioning_detail
+{
+// Returns true if len bytes from p are all valid node ID bytes.
+inline bool validIDBytes(const uint8_t *const p, const uint8_t len)
+    {
+    for(uint8_t i = 0; i < len; ++i) { if(!validIDByte(p[i])) { return(false); } }
+    return(true);
+    }
+
+// Locates the K/I/A payloads (NULL if absent) and checks format, values and CRC.
+struct Parsed final
+    {
+    const uint8_t *key = NULL; uint8_t keyLen = 0;
+    const uint8_t *id = NULL;
+    const uint8_t *assoc = NULL; uint8_t nAssoc = 0;
+    };
+inline ProvisioningResult parse(const uint8_t *const buf, const uint8_t len, Parsed &p)
+    {
+    if(NULL == buf) { return(PROVISION_BAD_FORMAT); }
+    bool seenK = false, seenI = false, seenA = false;
+    uint8_t pos = 0;
+    while(pos < len)
+        {
+        if(len - pos < 2) { return(PROVISION_BAD_FORMAT); }
+        const uint8_t type = buf[pos];
+        const uint8_t plen = buf[pos + 1];
+        const uint8_t *const payload = buf + pos + 2;
+        if(len - pos - 2 < plen) { return(PROVISION_BAD_FORMAT); }
+        switch(type)
+            {
+            case PROVISION_REC_KEY:
+                {
+                if(seenK || ((0 != plen) && (PROVISION_KEY_LENGTH != plen))) { return(PROVISION_BAD_FORMAT); }
+                seenK = true;
+                p.key = payload; p.keyLen = plen;
+                break;
+                }
+            case PROVISION_REC_ID:
+                {
+                if(seenI || (PROVISION_ID_LENGTH != plen)) { return(PROVISION_BAD_FORMAT); }
+                seenI = true;
+                p.id = payload;
+                break;
+                }
+            case PROVISION_REC_ASSOCIATIONS:
+                {
+                if(seenA || (0 != (plen % V0P2BASE_EE_NODE_ASSOCIATIONS_8B_ID_LENGTH)) ||
+                   (plen > V0P2BASE_EE_NODE_ASSOCIATIONS_MAX_SETS * V0P2BASE_EE_NODE_ASSOCIATIONS_8B_ID_LENGTH))
+                    { return(PROVISION_BAD_FORMAT); }
+                seenA = true;
+                p.assoc = payload; p.nAssoc = plen / V0P2BASE_EE_NODE_ASSOCIATIONS_8B_ID_LENGTH;
+                break;
+                }
+            case PROVISION_REC_END:
+                {
+                if((2 != plen) || (pos + 4 != len)) { return(PROVISION_BAD_FORMAT); }
+                const uint16_t crc = crc16_A001_buf(0xffff, buf, uint8_t(pos + 2));
+                if((uint8_t(crc) != payload[0]) || (uint8_t(crc >> 8) != payload[1])) { return(PROVISION_BAD_CRC); }
+                // Values are only checked once the data is known to be intact.
+                if(0 != p.keyLen)
+                    {
+                    bool allOnes = true;
+                    for(uint8_t i = 0; i < p.keyLen; ++i) { if(0xff != p.key[i]) { allOnes = false; break; } }
+                    if(allOnes) { return(PROVISION_BAD_VALUE); }
+                    }
+                if((NULL != p.id) && !validIDBytes(p.id, PROVISION_ID_LENGTH)) { return(PROVISION_BAD_VALUE); }
+                if((NULL != p.assoc) && !validIDBytes(p.assoc, p.nAssoc * V0P2BASE_EE_NODE_ASSOCIATIONS_8B_ID_LENGTH)) { return(PROVISION_BAD_VALUE); }
+                return(PROVISION_OK);
+                }
+            default: { return(PROVISION_BAD_FORMAT); }
+            }
+        pos += 2 + plen;
+        }
+    // No end record.
+    return(PROVISION_BAD_CRC);
+    }
+}
+
+// Applies a complete provisioning transaction to the V0p2 EEPROM layout in store.
+// Nothing is written unless the whole transaction is well formed with a good CRC.
+// The caller should then refresh any RAM state, see ProvisioningSummary,
+// eg invalidate V0p2_NodeIndex and bump nodeIDGeneration on the live device.
+// Not thread-/ISR- safe.
+//   * store_t  eg EEPROMSmartStore, or EEPROMJournalMockStore in tests
+//   * summary  if not NULL, set on success
+template<class store_t>
+ProvisioningResult applyProvisioning(store_t &store, const uint8_t *const buf, const uint8_t len,
+                                     ProvisioningSummary *const summary = NULL)
+    {
+    provisioning_detail::Parsed p;
+    const ProvisioningResult r = provisioning_detail::parse(buf, len, p);
+    if(PROVISION_OK != r) { return(r); }
+
+    constexpr uint8_t setSize = V0P2BASE_EE_NODE_ASSOCIATIONS_SET_SIZE;
+    constexpr uint8_t idLen = V0P2BASE_EE_NODE_ASSOCIATIONS_8B_ID_LENGTH;
+    // Slots whose existing ID matches and so keep their counters.
+    uint8_t keepCounters = 0;
+    for(uint8_t s = 0; s < p.nAssoc; ++s)
+        {
+        const uintptr_t a = uintptr_t(V0P2BASE_EE_START_NODE_ASSOCIATIONS) + (uintptr_t(s) * setSize);
+        bool same = true;
+        for(uint8_t i = 0; i < idLen; ++i) { if(store.read(a + i) != p.assoc[(s * idLen) + i]) { same = false; break; } }
+        if(same) { keepCounters |= uint8_t(1U << s); }
+        }
+
+    // Batch the writes; the journal is flushed before the checks below.
+    EEPROMWriteJournal<store_t, 32> j(store);
+    if(NULL != p.key)
+        {
+        for(uint8_t i = 0; i < PROVISION_KEY_LENGTH; ++i)
+            { j.update(PROVISION_EE_START_KEY + i, (0 == p.keyLen) ? 0xff : p.key[i]); }
+        }
+    if(NULL != p.id)
+        {
+        for(uint8_t i = 0; i < PROVISION_ID_LENGTH; ++i) { j.update(PROVISION_EE_START_ID + i, p.id[i]); }
+        }
+    if(NULL != p.assoc)
+        {
+        for(uint8_t s = 0; s < V0P2BASE_EE_NODE_ASSOCIATIONS_MAX_SETS; ++s)
+            {
+            const uintptr_t a = uintptr_t(V0P2BASE_EE_START_NODE_ASSOCIATIONS) + (uintptr_t(s) * setSize);
+            if(s >= p.nAssoc) { j.update(a, 0xff); continue; } // Unused as for clearAllNodeAssociations().
+            for(uint8_t i = 0; i < idLen; ++i) { j.update(a + i, p.assoc[(s * idLen) + i]); }
+            if(0 == (keepCounters & (1U << s))) { for(uint8_t i = idLen; i < setSize; ++i) { j.update(a + i, 0xff); } }
+            }
+        }
+    j.flush();
+
+    // Verify everything that was meant to be written.
+    if(NULL != p.key)
+        {
+        // As checkPrimaryBuilding16ByteSecretKey(), no early exit on a mismatch.
+        uint8_t diff = 0;
+        for(uint8_t i = 0; i < PROVISION_KEY_LENGTH; ++i)
+            { diff |= store.read(PROVISION_EE_START_KEY + i) ^ ((0 == p.keyLen) ? 0xff : p.key[i]); }
+        if(0 != diff) { return(PROVISION_VERIFY_FAILED); }
+        }
+    if(NULL != p.id)
+        {
+        for(uint8_t i = 0; i < PROVISION_ID_LENGTH; ++i)
+            { if(store.read(PROVISION_EE_START_ID + i) != p.id[i]) { return(PROVISION_VERIFY_FAILED); } }
+        }
+    if(NULL != p.assoc)
+        {
+        for(uint8_t s = 0; s < V0P2BASE_EE_NODE_ASSOCIATIONS_MAX_SETS; ++s)
+            {
+            const uintptr_t a = uintptr_t(V0P2BASE_EE_START_NODE_ASSOCIATIONS) + (uintptr_t(s) * setSize);
+            if(s >= p.nAssoc) { if(0xff != store.read(a)) { return(PROVISION_VERIFY_FAILED); } continue; }
+            for(uint8_t i = 0; i < idLen; ++i)
+                { if(store.read(a + i) != p.assoc[(s * idLen) + i]) { return(PROVISION_VERIFY_FAILED); } }
+            if(0 == (keepCounters & (1U << s)))
+                { for(uint8_t i = idLen; i < setSize; ++i) { if(0xff != store.read(a + i)) { return(PROVISION_VERIFY_FAILED); } } }
+            }
+        }
+
+    if(NULL != summary)
+        {
+        summary->keySet = (NULL != p.key) && (0 != p.keyLen);
+        summary->keyCleared = (NULL != p.key) && (0 == p.keyLen);
+        summary->idSet = (NULL != p.id);
+        summary->associations = (NULL != p.assoc) ? int8_t(p.nAssoc) : -1;
+        }
+    return(PROVISION_OK);
+    }
+
+
+}
+
+#endif
@@ -26,6 +26,7 @@ Author(s) / Copyright (s): Damon Hart-Davis 2013--2015
 #define OTV0P2BASE_QUICKPRNG_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 namespace OTV0P2BASE
 {
@@ -45,6 +46,94 @@ extern void _resetRNG8();
 // Avoids suspect low-order bit(s).
 inline bool randRNG8NextBoolean() { return(0 != (0x8 & randRNG8())); }
 
+// PCG32 (PCG-XSH-RR 64/32) PRNG with explicit state, c/o https://www.pcg-random.org/
+// NOT in any way suitable for crypto.
+// Much longer period (2^64 per stream) and better statistics than RNG8,
+// with 2^63 independent streams and O(log n) jump-ahead,
+// so that eg simulators can run many reproducible parallel Monte-Carlo streams.
+// Uses 64-bit multiplies so is relatively slow and big on 8-bit MCUs: prefer randRNG8() there.
+// Same output as the reference pcg32_srandom_r()/pcg32_random_r().
+class PCG32 final
+    {
+    private:
+        static constexpr uint64_t MULT = 6364136223846793005ULL;
+        uint64_t state;
+        // Stream selector; always odd.
+        uint64_t inc;
+
+    public:
+        //   * initState  starting state (seed)
+        //   * stream  stream selector; streams with the same seed are independent
+        explicit PCG32(const uint64_t initState = 0x853c49e6748fea9bULL, const uint64_t stream = 0xda3e39cb94b95bdbULL >> 1)
+          { seed(initState, stream); }
+
+        // Reseed, as for construction.
+        void seed(const uint64_t initState, const uint64_t stream)
+            {
+            state = 0;
+            inc = (stream << 1) | 1;
+            next32();
+            state += initState;
+            next32();
+            }
+
+        // Get 32 bits of uniformly-distributed unsigned values.
+        uint32_t next32()
+            {
+            const uint64_t old = state;
+            state = (old * MULT) + inc;
+            const uint32_t xorshifted = uint32_t(((old >> 18) ^ old) >> 27);
+            const uint8_t rot = uint8_t(old >> 59);
+            return((xorshifted >> rot) | (xorshifted << ((32 - rot) & 31)));
+            }
+        // Get 1 byte of uniformly-distributed unsigned values; uses the best (top) bits.
+        uint8_t next8() { return(uint8_t(next32() >> 24)); }
+        // Get a boolean.
+        bool nextBoolean() { return(0 != (0x80000000UL & next32())); }
+
+        // Get a value uniformly distributed in [0,bound) without modulo bias; 0 if bound is 0.
+        uint32_t nextBounded(const uint32_t bound)
+            {
+            if(0 == bound) { return(0); }
+            const uint32_t threshold = uint32_t(-bound) % bound;
+            for( ; ; )
+                {
+                const uint32_t r = next32();
+                if(r >= threshold) { return(r % bound); }
+                }
+            }
+
+        // Fill buf[0,len) with random bytes, 4 per step.
+        void fill(uint8_t *const buf, const size_t len)
+            {
+            size_t i = 0;
+            while(i < len)
+                {
+                uint32_t r = next32();
+                for(uint8_t j = 0; (j < 4) && (i < len); ++j, r >>= 8) { buf[i++] = uint8_t(r); }
+                }
+            }
+
+        // Jump ahead (or back, with a negative delta modulo 2^64) by delta steps in O(log delta),
+        // eg to give each of N parallel workers a disjoint section of one stream.
+        void advance(uint64_t delta)
+            {
+            uint64_t curMult = MULT, curPlus = inc;
+            uint64_t accMult = 1, accPlus = 0;
+            while(delta > 0)
+                {
+                if(delta & 1) { accMult *= curMult; accPlus = (accPlus * curMult) + curPlus; }
+                curPlus = (curMult + 1) * curPlus;
+                curMult *= curMult;
+                delta >>= 1;
+                }
+            state = (accMult * state) + accPlus;
+            }
+
+        bool operator==(const PCG32 &o) const { return((state == o.state) && (inc == o.inc)); }
+        bool operator!=(const PCG32 &o) const { return(!(*this == o)); }
+    };
+
 }
 
 #endif
@@ -66,6 +66,11 @@ volatile uint_least16_t _minutesSinceMidnightLT;
 // NOT FOR DIRECT ACCESS OUTSIDE RTC ROUTINES.
 volatile uint_least16_t _daysSince1999LT;
 
+// Basic cycles (main ticks) since start-up, for the monotonic timebase.
+// Must be accessed with interrupts disabled and as if volatile.
+// NOT FOR DIRECT ACCESS OUTSIDE RTC ROUTINES.
+volatile uint32_t _monotonicCycles;
+
 
 #ifdef ARDUINO_ARCH_AVR
 // The encoding for the persisted HH:MM value is as follows.
@@ -195,6 +200,47 @@ uint_least16_t getMinutesSinceMidnightLT()  // XXX
   }
 #endif
 
+#if defined(ARDUINO_ARCH_AVR) || defined(V0P2BASE_EFR32_SUBCYCLE)
+// Take a consistent snapshot of the cycle count and sub-cycle time.
+static void readMonotonic(uint32_t &cycles, uint8_t &sct)
+  {
+#ifdef ARDUINO_ARCH_AVR
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+    cycles = _monotonicCycles;
+    sct = getSubCycleTime();
+    // If timer 2 has overflowed but its ISR has not yet run
+    // (interrupts were already off, or it overflowed just now)
+    // then the cycle has rolled: re-read the (now post-roll) sub-cycle time.
+    if(0 != (TIFR2 & _BV(TOV2))) { sct = getSubCycleTime(); ++cycles; }
+    }
+#else
+  // The sub-cycle ISR updates both together, so retry if it ran in between.
+  uint32_t c;
+  do { c = _monotonicCycles; sct = uint8_t(getSubCycleTime()); } while(c != _monotonicCycles);
+  cycles = c;
+#endif
+  }
+
+// Get monotonic sub-cycle ticks since start-up.
+uint32_t getMonotonicTicks()
+  {
+  uint32_t cycles;
+  uint8_t sct;
+  readMonotonic(cycles, sct);
+  return(monotonicTicksFrom(cycles, sct));
+  }
+
+// Get monotonic milliseconds since start-up.
+uint32_t getMonotonicMs()
+  {
+  uint32_t cycles;
+  uint8_t sct;
+  readMonotonic(cycles, sct);
+  return(monotonicMsFrom(cycles, sct));
+  }
+#endif
+
 #if defined(ARDUINO_ARCH_AVR) || defined(__arm__)
 // Get local time minutes from RTC [0,59].
 // Relatively slow.
@@ -351,6 +397,7 @@ ISR(TIMER2_OVF_vect)
     _minutesSinceMidnightLT = mTemp;
     }
   _secondsLT = sTemp;
+  ++_monotonicCycles;
   // Deal with watchdog, if enabled.
   if(_RTCWatchdogEnabled)
     {
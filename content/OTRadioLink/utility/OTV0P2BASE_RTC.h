@@ -45,6 +45,20 @@ namespace OTV0P2BASE
 // V0p2 boards have traditionally been on 0.5Hz (2s main loop time) cadence.
 #define V0P2BASE_TWO_S_TICK_RTC_SUPPORT // Wake up every 2 seconds.
 
+// Sub-cycle clock source on EFR32.
+// IF DEFINED: drive the sub-cycle clock from the RTCC on the 32768Hz LFXO,
+// which keeps running in EM2 so that the CPU can sleep there between wakes.
+#define V0P2BASE_RTCC_SUBCYCLE
+#ifndef V0P2BASE_RTCC_SUBCYCLE
+// IF DEFINED: Enable emulated subcycle
+// (SysTick, which stops below EM1 so keeps the CPU out of deep sleep).
+#define V0P2BASE_SYSTICK_EMULATED_SUBCYCLE
+#endif
+// Defined where an EFR32 sub-cycle clock of either sort is available.
+#if defined(EFR32FG1P133F256GM48) && (defined(V0P2BASE_RTCC_SUBCYCLE) || defined(V0P2BASE_SYSTICK_EMULATED_SUBCYCLE))
+#define V0P2BASE_EFR32_SUBCYCLE
+#endif
+
 
 // Number of minutes per day.
 static constexpr uint16_t MINS_PER_DAY = 1440;
@@ -68,6 +82,12 @@ extern volatile uint_least16_t _minutesSinceMidnightLT;
 // NOT FOR DIRECT ACCESS OUTSIDE RTC ROUTINES.
 extern volatile uint_least16_t _daysSince1999LT;
 
+// Basic cycles (main ticks) since start-up, for the monotonic timebase.
+// Unlike the wall-clock time this is never set, so only ever counts up (and wraps).
+// Must be accessed with interrupts disabled and as if volatile.
+// NOT FOR DIRECT ACCESS OUTSIDE RTC ROUTINES.
+extern volatile uint32_t _monotonicCycles;
+
 
 
 
@@ -161,6 +181,48 @@ static const uint_fast8_t MAIN_TICK_S = 1;
 #endif
 
 
+// Monotonic timebase.
+// Counts from start-up and is unaffected by setting the wall-clock time,
+// so suits timeouts, retry timers, sleep deadlines and trace timestamps.
+// Values are 32-bit and wrap (ticks after ~97 days, ms after ~49 days),
+// so compare them only with the helpers below, which are correct across a wrap
+// for intervals up to half the range.
+
+// Sub-cycle ticks per basic cycle in the monotonic timebase; see getSubCycleTime().
+static constexpr uint16_t MONOTONIC_TICKS_PER_CYCLE = 256;
+// Milliseconds per basic cycle.
+static constexpr uint16_t MONOTONIC_MS_PER_CYCLE = uint16_t(MAIN_TICK_S) * 1000U;
+
+// Monotonic sub-cycle ticks from whole cycles and the sub-cycle time [0,255].
+inline constexpr uint32_t monotonicTicksFrom(const uint32_t cycles, const uint8_t subCycleTime)
+  { return((cycles << 8) | subCycleTime); }
+// Monotonic milliseconds from whole cycles and the sub-cycle time [0,255], rounded down.
+inline constexpr uint32_t monotonicMsFrom(const uint32_t cycles, const uint8_t subCycleTime)
+  { return((cycles * MONOTONIC_MS_PER_CYCLE) + ((subCycleTime * uint32_t(MONOTONIC_MS_PER_CYCLE)) >> 8)); }
+
+// Time from start to now, both from the same monotonic clock; correct across a wrap.
+inline constexpr uint32_t monotonicElapsed(const uint32_t start, const uint32_t now)
+  { return(now - start); }
+// True if now is at or after deadline (within half the range), correct across a wrap.
+inline constexpr bool monotonicReached(const uint32_t now, const uint32_t deadline)
+  { return((now - deadline) < 0x80000000UL); }
+// True if a is strictly after b (within half the range), correct across a wrap.
+inline constexpr bool monotonicIsAfter(const uint32_t a, const uint32_t b)
+  { return((a != b) && monotonicReached(a, b)); }
+
+#if defined(ARDUINO_ARCH_AVR) || defined(V0P2BASE_EFR32_SUBCYCLE)
+// Get monotonic sub-cycle ticks since start-up (256 per basic cycle, ~7.8ms with a 2s cycle).
+// Combines the cycle count with getSubCycleTime(),
+// allowing for a cycle roll not yet seen by the RTC ISR.
+// Fast: one short interrupt lock-out.
+// Thread-safe and ISR-safe.
+uint32_t getMonotonicTicks();
+// Get monotonic milliseconds since start-up, at sub-cycle tick resolution.
+// Thread-safe and ISR-safe.
+uint32_t getMonotonicMs();
+#endif
+
+
 // RTC-based watchdog, if enabled with enableRTCWatchdog(true),
 // will force a reset if the resetRTCWatchDog() is not called
 // between one RTC tick interrupt and the next.
@@ -0,0 +1,134 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Resumable (protothread-style) tasks for non-blocking driver sequences.
+
+ Link drivers such as OTSIM900Link are otherwise written as a large
+ switch(state) in poll(), with retry counts and timers set up
+ in the state before the one that uses them.
+ With these macros a sequence can instead be written linearly
+ in a member function called from poll(),
+ which returns at each await point and resumes there on the next call:
+
+    OTV0P2BASE::ResumableTask rt;
+    OTV0P2BASE::ResumableTask::Status step()
+        {
+        OT_RT_BEGIN(rt);
+        for(retries = 0; retries < 10; ++retries)
+            {
+            OT_RT_AWAIT_OR_POLLS(rt, atStep(ATC_REGISTRATION), 5);
+            if(rt.isTimedOut()) { continue; }
+            if(isRegistered()) { break; }
+            OT_RT_YIELD(rt);
+            }
+        OT_RT_AWAIT(rt, atStep(ATC_SET_APN));
+        ...
+        OT_RT_END(rt);
+        }
+
+ Each await costs one resumption point (the source line),
+ and the whole task state is a few bytes, so is usable on AVR.
+ Caveats (as for all switch-based protothreads):
+   * local variables do not survive an await or yield, so keep state in members;
+   * at most one await or yield per source line;
+   * no await or yield inside a switch statement within the task body.
+
+ Other tasks are awaited by awaiting their Status, eg
+ OT_RT_AWAIT(rt, ResumableTask::DONE == child());.
+
+ Only macros are provided, as the library is built as C++11;
+ they work equally on host/EFR32 builds.
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_RESUMABLETASK_H
+#define OTV0P2BASE_RESUMABLETASK_H
+
+#include <stdint.h>
+
+
+namespace OTV0P2BASE
+{
+
+
+// State of one resumable task: where to resume, and the await-timeout bookkeeping.
+// Zero-initialised it starts from the top.
+// Not thread-/ISR- safe.
+class ResumableTask final
+    {
+    public:
+        // Result of running a task step.
+        enum Status : uint8_t { WAITING, DONE };
+
+        // Resumption point; 0 means the start.
+        // Managed by the OT_RT_* macros.
+        uint16_t resumePoint = 0;
+        // Resumptions so far in the current timed await.
+        uint8_t polls = 0;
+        // True if the last timed await finished by timing out.
+        bool timedOut = false;
+
+        // Make the task start again from the top when next run.
+        void restart() { resumePoint = 0; polls = 0; timedOut = false; }
+        // True if the task is part way through (ie neither finished nor started).
+        bool isRunning() const { return(0 != resumePoint); }
+        // True if the last OT_RT_AWAIT_OR_POLLS() gave up rather than seeing its condition.
+        bool isTimedOut() const { return(timedOut); }
+    };
+
+
+}
+
+// Mark a deliberate fall through into a resumption point, where the compiler supports it.
+#if defined(__has_cpp_attribute)
+#if __has_cpp_attribute(gnu::fallthrough)
+#define OT_RT_FALLTHROUGH_ [[gnu::fallthrough]]
+#endif
+#endif
+#ifndef OT_RT_FALLTHROUGH_
+#define OT_RT_FALLTHROUGH_
+#endif
+
+// Start the body of a task whose state is rt; must be matched by OT_RT_END(rt).
+#define OT_RT_BEGIN(rt) switch((rt).resumePoint) { case 0:
+
+// Wait (returning WAITING) until cond is true; cond is re-evaluated on each resumption.
+#define OT_RT_AWAIT(rt, cond) \
+    do { (rt).resumePoint = __LINE__; OT_RT_FALLTHROUGH_; case __LINE__: \
+         if(!(cond)) { return(::OTV0P2BASE::ResumableTask::WAITING); } } while(0)
+
+// Wait until cond is true or it has been evaluated maxPolls times [1,255];
+// afterwards rt.isTimedOut() is true iff cond was never seen true.
+#define OT_RT_AWAIT_OR_POLLS(rt, cond, maxPolls) \
+    do { (rt).polls = 0; (rt).timedOut = false; (rt).resumePoint = __LINE__; OT_RT_FALLTHROUGH_; case __LINE__: \
+         if(!(cond)) { if(++(rt).polls < (maxPolls)) { return(::OTV0P2BASE::ResumableTask::WAITING); } \
+                       (rt).timedOut = true; } } while(0)
+
+// Return WAITING once, resuming after this point on the next call.
+#define OT_RT_YIELD(rt) \
+    do { (rt).resumePoint = __LINE__; return(::OTV0P2BASE::ResumableTask::WAITING); case __LINE__: ; } while(0)
+
+// Finish now, returning DONE; the next run starts from the top.
+#define OT_RT_EXIT(rt) do { (rt).restart(); return(::OTV0P2BASE::ResumableTask::DONE); } while(0)
+
+// End the body of a task: returns DONE, and the next run starts from the top.
+#define OT_RT_END(rt) } (rt).restart(); return(::OTV0P2BASE::ResumableTask::DONE)
+
+#endif
@@ -0,0 +1,461 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Append-only time-series log on external SPI NOR flash,
+ eg weeks of per-minute valve history for offline analysis,
+ well beyond the by-hour stats sets that fit in internal EEPROM.
+
+ Records are a 32-bit timestamp (eg minutes since some epoch,
+ never decreasing) and a fixed-size payload.
+ Records are batched in a RAM buffer and programmed
+ a page (occasionally two part-pages) at a time.
+ Erase sectors are filled in turn as a ring, the oldest being erased for reuse;
+ each starts with a small header holding a sequence number
+ and the time of its first record, which serves as a block-level index:
+ finding a day (or any time) is a binary search over sector headers
+ then over the records of one sector.
+ The Reader streams records, eg to frame for bulk upload over the radio or SIM900,
+ a few at a time so as not to hog the CPU or the link.
+
+ After a reset begin() finds the newest sector and the end of its log;
+ records not yet flushed are lost.
+
+ Portable, with the flash supplied as a template parameter:
+ SPINORFlashAVR on AVR, SPINORFlashMock for unit tests.
+
+ Not thread-/ISR- safe.
+ */
+
+#ifndef OTV0P2BASE_SPIFLASHTIMESERIES_H
+#define OTV0P2BASE_SPIFLASHTIMESERIES_H
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef ARDUINO_ARCH_AVR
+#include <Arduino.h>
+#include "OTV0P2BASE_BasicPinAssignments.h"
+#include "OTV0P2BASE_FastDigitalIO.h"
+#include "OTV0P2BASE_PowerManagement.h"
+#endif // ARDUINO_ARCH_AVR
+
+
+namespace OTV0P2BASE
+{
+
+
+// SPI NOR flash for SPIFlashTimeSeries, erased to all 1s, where programming can only clear bits.
+// Implementations provide:
+//    static constexpr uint32_t SIZE_BYTES; // Multiple of SECTOR_BYTES.
+//    static constexpr uint16_t PAGE_BYTES; // Program page, eg 256.
+//    static constexpr uint16_t SECTOR_BYTES; // Erase sector, eg 4096.
+//    bool read(uint32_t addr, uint8_t *buf, uint16_t n) const;
+//    bool program(uint32_t addr, const uint8_t *buf, uint16_t n); // Within one page.
+//    bool eraseSector(uint32_t addr); // Sector containing addr.
+
+// RAM flash for unit tests, with NOR flash rules.
+template<uint32_t sizeBytes = 16384, uint16_t pageBytes = 256, uint16_t sectorBytes = 4096>
+class SPINORFlashMock final
+    {
+    private:
+        uint8_t mem[sizeBytes];
+
+    public:
+        static constexpr uint32_t SIZE_BYTES = sizeBytes;
+        static constexpr uint16_t PAGE_BYTES = pageBytes;
+        static constexpr uint16_t SECTOR_BYTES = sectorBytes;
+        // Sector erases and page programs done.
+        uint16_t erases = 0;
+        uint32_t programs = 0;
+
+        SPINORFlashMock() { memset(mem, 0xff, sizeof(mem)); }
+
+        bool read(const uint32_t addr, uint8_t *const buf, const uint16_t n) const
+            {
+            if(addr + n > sizeBytes) { return(false); }
+            memcpy(buf, mem + addr, n);
+            return(true);
+            }
+        bool program(const uint32_t addr, const uint8_t *const buf, const uint16_t n)
+            {
+            if((addr + n > sizeBytes) || ((addr % pageBytes) + n > pageBytes)) { return(false); }
+            ++programs;
+            for(uint16_t i = 0; i < n; ++i) { mem[addr + i] &= buf[i]; }
+            return(0 == memcmp(mem + addr, buf, n));
+            }
+        bool eraseSector(const uint32_t addr)
+            {
+            if(addr >= sizeBytes) { return(false); }
+            ++erases;
+            memset(mem + (addr - (addr % sectorBytes)), 0xff, sectorBytes);
+            return(true);
+            }
+    };
+
+// Time-series log of records of a 32-bit time and payloadBytes of payload.
+//   * flash_t  eg SPINORFlashAVR
+//   * payloadBytes  fixed payload size per record
+//   * bufferBytes  RAM batch buffer, at least one record and at most one flash page
+template<class flash_t, uint8_t payloadBytes, uint16_t bufferBytes = flash_t::PAGE_BYTES>
+class SPIFlashTimeSeries final
+    {
+    public:
+        static constexpr uint8_t RECORD_BYTES = uint8_t(4 + payloadBytes);
+        static constexpr uint8_t HEADER_BYTES = 16;
+        static constexpr uint16_t SECTOR_BYTES = flash_t::SECTOR_BYTES;
+        static constexpr uint16_t PAGE_BYTES = flash_t::PAGE_BYTES;
+        static constexpr uint16_t RECORDS_PER_SECTOR = uint16_t((SECTOR_BYTES - HEADER_BYTES) / RECORD_BYTES);
+        static constexpr uint16_t SECTORS = uint16_t(flash_t::SIZE_BYTES / SECTOR_BYTES);
+        // Reserved time value, for erased records.
+        static constexpr uint32_t NO_TIME = 0xffffffffUL;
+        static_assert(payloadBytes <= 251, "payload too large");
+        static_assert((bufferBytes >= RECORD_BYTES) && (bufferBytes <= PAGE_BYTES), "bufferBytes out of range");
+        static_assert(SECTORS >= 2, "need at least two sectors");
+        static_assert(RECORDS_PER_SECTOR >= 1, "sector too small for one record");
+
+    private:
+        // Header: magic (2), payloadBytes, format (0), sequence number (4), first record time (4), then 0xff.
+        static constexpr uint8_t MAGIC0 = 'T', MAGIC1 = 'S';
+
+        flash_t &flash;
+
+        // Valid sectors are a run of count consecutive (mod SECTORS) from oldest,
+        // with consecutive sequence numbers ending with seq in active.
+        uint16_t oldest = 0, count = 0, active = 0;
+        uint32_t seq = 0;
+        // Next record slot in the active sector, including those buffered.
+        uint16_t nextSlot = 0;
+        // Time of the newest record appended.
+        uint32_t lastTime = 0;
+
+        // Buffered records, from slot bufSlot0 in the active sector.
+        uint8_t buf[bufferBytes];
+        uint8_t bufRecords = 0;
+        uint16_t bufSlot0 = 0;
+
+        static uint32_t get32(const uint8_t *const p)
+            { return(uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24)); }
+        static void put32(uint8_t *const p, const uint32_t v)
+            { p[0] = uint8_t(v); p[1] = uint8_t(v >> 8); p[2] = uint8_t(v >> 16); p[3] = uint8_t(v >> 24); }
+
+        static uint32_t sectorAddr(const uint16_t sector) { return(uint32_t(sector) * SECTOR_BYTES); }
+        static uint32_t slotAddr(const uint16_t sector, const uint16_t slot)
+            { return(sectorAddr(sector) + HEADER_BYTES + (uint32_t(slot) * RECORD_BYTES)); }
+        // Physical sector of logical sector k, 0 being the oldest.
+        uint16_t physical(const uint16_t k) const { return(uint16_t((oldest + k) % SECTORS)); }
+
+        // True if sector has a valid header, with its sequence number and first time.
+        bool readHeader(const uint16_t sector, uint32_t &s, uint32_t &firstTime) const
+            {
+            uint8_t h[12];
+            if(!flash.read(sectorAddr(sector), h, sizeof(h))) { return(false); }
+            if((MAGIC0 != h[0]) || (MAGIC1 != h[1]) || (payloadBytes != h[2]) || (0 != h[3])) { return(false); }
+            s = get32(h + 4);
+            firstTime = get32(h + 8);
+            return(NO_TIME != s);
+            }
+        uint32_t sectorFirstTime(const uint16_t sector) const
+            { uint32_t s, t; return(readHeader(sector, s, t) ? t : NO_TIME); }
+
+        // Time of the record in the given slot; NO_TIME if erased or unreadable.
+        uint32_t slotTime(const uint16_t sector, const uint16_t slot) const
+            {
+            uint8_t t[4];
+            return(flash.read(slotAddr(sector, slot), t, 4) ? get32(t) : NO_TIME);
+            }
+        // First slot in [0,limit) of sector whose time is at least t, else limit;
+        // times are non-decreasing, and erased slots count as latest.
+        uint16_t firstSlotFrom(const uint16_t sector, const uint32_t t, const uint16_t limit) const
+            {
+            uint16_t lo = 0, hi = limit;
+            while(lo < hi)
+                {
+                const uint16_t mid = uint16_t(lo + ((hi - lo) >> 1));
+                if(slotTime(sector, mid) < t) { lo = uint16_t(mid + 1); } else { hi = mid; }
+                }
+            return(lo);
+            }
+
+        // Erase the next sector in the ring and start it with a record at time t.
+        bool openSector(const uint32_t t)
+            {
+            const uint16_t next = (0 == count) ? 0 : uint16_t((active + 1) % SECTORS);
+            // Reuse of the oldest sector drops it.
+            if((count > 0) && (next == oldest)) { oldest = uint16_t((oldest + 1) % SECTORS); --count; }
+            if(0 == count) { oldest = next; }
+            if(!flash.eraseSector(sectorAddr(next))) { return(false); }
+            const uint32_t s = (0 == count) ? seq : uint32_t(seq + 1);
+            uint8_t h[HEADER_BYTES];
+            memset(h, 0xff, sizeof(h));
+            h[0] = MAGIC0; h[1] = MAGIC1; h[2] = payloadBytes; h[3] = 0;
+            put32(h + 4, s);
+            put32(h + 8, t);
+            if(!flash.program(sectorAddr(next), h, sizeof(h))) { return(false); }
+            active = next;
+            seq = s;
+            ++count;
+            nextSlot = 0;
+            return(true);
+            }
+
+    public:
+        explicit SPIFlashTimeSeries(flash_t &flash_) : flash(flash_), buf() { }
+
+        // Find the log in flash; call once at start-up before other use.
+        // Returns true if any records (or at least a started sector) were found.
+        bool begin()
+            {
+            count = 0;
+            bufRecords = 0;
+            nextSlot = 0;
+            lastTime = 0;
+            // Newest valid sector.
+            bool found = false;
+            for(uint16_t i = 0; i < SECTORS; ++i)
+                {
+                uint32_t s, t;
+                if(!readHeader(i, s, t)) { continue; }
+                if(!found || (int32_t(s - seq) > 0)) { found = true; seq = s; active = i; }
+                }
+            if(!found) { seq = 0; return(false); }
+            // Walk back over consecutively-numbered predecessors.
+            count = 1;
+            oldest = active;
+            while(count < SECTORS)
+                {
+                const uint16_t prev = uint16_t((oldest + SECTORS - 1) % SECTORS);
+                uint32_t s, t;
+                if(!readHeader(prev, s, t) || (s != uint32_t(seq - count))) { break; }
+                oldest = prev;
+                ++count;
+                }
+            nextSlot = firstSlotFrom(active, NO_TIME, RECORDS_PER_SECTOR);
+            lastTime = (0 == nextSlot) ? sectorFirstTime(active) : slotTime(active, uint16_t(nextSlot - 1));
+            return(true);
+            }
+
+        // Append a record, flushing whenever a page's worth is buffered.
+        // Returns false if time is NO_TIME or earlier than the last record's, or on flash error.
+        bool append(const uint32_t time, const uint8_t *const payload)
+            {
+            if((NO_TIME == time) || ((count > 0) && (time < lastTime))) { return(false); }
+            if((0 == count) || (nextSlot >= RECORDS_PER_SECTOR))
+                {
+                if(!flush() || !openSector(time)) { return(false); }
+                }
+            if(0 == bufRecords) { bufSlot0 = nextSlot; }
+            uint8_t *const r = buf + (bufRecords * RECORD_BYTES);
+            put32(r, time);
+            memcpy(r + 4, payload, payloadBytes);
+            ++bufRecords;
+            ++nextSlot;
+            lastTime = time;
+            // Flush if the buffer is full or has reached the end of the page it started in.
+            const uint32_t start = slotAddr(active, bufSlot0) - sectorAddr(active);
+            const uint32_t end = start + (uint32_t(bufRecords) * RECORD_BYTES);
+            if((end + RECORD_BYTES > (start + bufferBytes)) || (end >= ((start / PAGE_BYTES) + 1) * uint32_t(PAGE_BYTES)))
+                { return(flush()); }
+            return(true);
+            }
+
+        // Program any buffered records, splitting at page boundaries.
+        bool flush()
+            {
+            if(0 == bufRecords) { return(true); }
+            uint32_t addr = slotAddr(active, bufSlot0);
+            uint16_t n = uint16_t(bufRecords * RECORD_BYTES);
+            const uint8_t *p = buf;
+            bufRecords = 0;
+            while(n > 0)
+                {
+                const uint16_t room = uint16_t(PAGE_BYTES - (addr % PAGE_BYTES));
+                const uint16_t chunk = (n < room) ? n : room;
+                if(!flash.program(addr, p, chunk)) { return(false); }
+                addr += chunk;
+                p += chunk;
+                n = uint16_t(n - chunk);
+                }
+            return(true);
+            }
+
+        // Erase the whole log; slow (one erase per sector used).
+        bool clear()
+            {
+            bufRecords = 0;
+            bool ok = true;
+            for(uint16_t k = 0; k < count; ++k) { ok &= flash.eraseSector(sectorAddr(physical(k))); }
+            count = 0;
+            nextSlot = 0;
+            lastTime = 0;
+            return(ok);
+            }
+
+        bool isEmpty() const { return(0 == count); }
+        // Time of the newest record; only meaningful if not empty.
+        uint32_t getLastTime() const { return(lastTime); }
+        // Time of the oldest record still held; NO_TIME if none.
+        uint32_t getFirstTime() const { return((0 == count) ? NO_TIME : sectorFirstTime(oldest)); }
+        uint16_t getSectorsUsed() const { return(count); }
+        uint8_t getBuffered() const { return(bufRecords); }
+
+        // Streaming reader of flushed records, oldest first;
+        // at the end, next() returns records flushed since.
+        // Appends that reuse the sector being read invalidate it.
+        class Reader final
+            {
+            private:
+                const SPIFlashTimeSeries &ts;
+                // Logical sector and slot of the next record.
+                uint16_t k = 0, slot = 0;
+            public:
+                explicit Reader(const SPIFlashTimeSeries &ts_) : ts(ts_) { }
+
+                // Position at the first record at or after time t, eg a day start.
+                void seek(const uint32_t t)
+                    {
+                    // Last sector starting no later than t.
+                    uint16_t lo = 0, hi = ts.count;
+                    while(lo < hi)
+                        {
+                        const uint16_t mid = uint16_t(lo + ((hi - lo) >> 1));
+                        if(ts.sectorFirstTime(ts.physical(mid)) <= t) { lo = uint16_t(mid + 1); } else { hi = mid; }
+                        }
+                    k = (0 == lo) ? 0 : uint16_t(lo - 1);
+                    slot = (k < ts.count) ? ts.firstSlotFrom(ts.physical(k), t, limit(k)) : 0;
+                    }
+                // Position at the first record of the day (of minutesPerDay, eg 1440) given.
+                void seekDay(const uint32_t day, const uint16_t minutesPerDay = 1440) { seek(day * minutesPerDay); }
+
+                // Get the next record; false when there are no more.
+                bool next(uint32_t &time, uint8_t *const payload)
+                    {
+                    while(k < ts.count)
+                        {
+                        if(slot >= limit(k))
+                            {
+                            // Stay at the end of the newest sector so as to pick up later flushes.
+                            if(k + 1 >= ts.count) { return(false); }
+                            ++k; slot = 0; continue;
+                            }
+                        uint8_t r[RECORD_BYTES];
+                        if(!ts.flash.read(slotAddr(ts.physical(k), slot), r, RECORD_BYTES)) { return(false); }
+                        const uint32_t t = get32(r);
+                        // End of a sector left part-filled, eg by a reset.
+                        if(NO_TIME == t) { ++k; slot = 0; continue; }
+                        ++slot;
+                        time = t;
+                        memcpy(payload, r + 4, payloadBytes);
+                        return(true);
+                        }
+                    return(false);
+                    }
+
+            private:
+                // Flushed slots in logical sector i.
+                uint16_t limit(const uint16_t i) const
+                    {
+                    if(ts.physical(i) != ts.active) { return(RECORDS_PER_SECTOR); }
+                    return(uint16_t(ts.nextSlot - ts.bufRecords));
+                    }
+            };
+    };
+
+#ifdef ARDUINO_ARCH_AVR
+// JEDEC-standard SPI NOR flash (eg W25Qxx, AT25SF, MX25R) on the AVR hardware SPI,
+// with its own chip select, 256-byte pages and 4kB sectors.
+// SPI is powered up only for each operation.
+// Program and erase wait for completion (up to ~0.4s for an erase).
+//   * SPI_nSS  chip select pin
+//   * sizeBytes  device size, eg 1048576 for 8Mbit
+template<uint8_t SPI_nSS, uint32_t sizeBytes>
+class SPINORFlashAVR final
+    {
+    private:
+        static constexpr uint8_t CMD_READ = 0x03, CMD_PROGRAM = 0x02, CMD_ERASE_4K = 0x20;
+        static constexpr uint8_t CMD_WRITE_ENABLE = 0x06, CMD_READ_STATUS = 0x05;
+        static constexpr uint8_t STATUS_BUSY = 0x01;
+
+        static uint8_t io(const uint8_t data) { SPDR = data; while (!(SPSR & _BV(SPIF))) { } return(SPDR); }
+        static bool up() { return(t_powerUpSPIIfDisabled<SPI_nSS, false>()); }
+        static void down(const bool neededEnable)
+            { if(neededEnable) { t_powerDownSPI<SPI_nSS, V0p2_PIN_SPI_SCK, V0p2_PIN_SPI_MOSI, V0p2_PIN_SPI_MISO, false>(); } }
+        static void select() { fastDigitalWrite(SPI_nSS, LOW); }
+        static void deselect() { fastDigitalWrite(SPI_nSS, HIGH); }
+        static void cmdAddr(const uint8_t cmd, const uint32_t addr)
+            { io(cmd); io(uint8_t(addr >> 16)); io(uint8_t(addr >> 8)); io(uint8_t(addr)); }
+        static void writeEnable() { select(); io(CMD_WRITE_ENABLE); deselect(); }
+        // Wait for a program/erase to finish; false on timeout.
+        static bool waitReady()
+            {
+            select();
+            io(CMD_READ_STATUS);
+            uint16_t polls = 0;
+            while(0 != (io(0) & STATUS_BUSY)) { if(0 == ++polls) { deselect(); return(false); } }
+            deselect();
+            return(true);
+            }
+
+    public:
+        static constexpr uint32_t SIZE_BYTES = sizeBytes;
+        static constexpr uint16_t PAGE_BYTES = 256;
+        static constexpr uint16_t SECTOR_BYTES = 4096;
+
+        bool read(const uint32_t addr, uint8_t *const buf, const uint16_t n) const
+            {
+            if(addr + n > sizeBytes) { return(false); }
+            const bool neededEnable = up();
+            select();
+            cmdAddr(CMD_READ, addr);
+            for(uint16_t i = 0; i < n; ++i) { buf[i] = io(0); }
+            deselect();
+            down(neededEnable);
+            return(true);
+            }
+        bool program(const uint32_t addr, const uint8_t *const buf, const uint16_t n)
+            {
+            if((addr + n > sizeBytes) || ((addr % PAGE_BYTES) + n > PAGE_BYTES)) { return(false); }
+            const bool neededEnable = up();
+            writeEnable();
+            select();
+            cmdAddr(CMD_PROGRAM, addr);
+            for(uint16_t i = 0; i < n; ++i) { io(buf[i]); }
+            deselect();
+            const bool ok = waitReady();
+            down(neededEnable);
+            return(ok);
+            }
+        bool eraseSector(const uint32_t addr)
+            {
+            if(addr >= sizeBytes) { return(false); }
+            const bool neededEnable = up();
+            writeEnable();
+            select();
+            cmdAddr(CMD_ERASE_4K, addr);
+            deselect();
+            const bool ok = waitReady();
+            down(neededEnable);
+            return(ok);
+            }
+    };
+#endif // ARDUINO_ARCH_AVR
+
+
+}
+
+#endif
@@ -46,6 +46,9 @@ stats_TX_level getStatsTXLevel() { return((stats_TX_level)eeprom_read_byte((uint
 #endif
 
 
+// Incremented (wrapping) each time this library may have altered the EEPROM node ID.
+uint8_t nodeIDGeneration;
+
 #ifdef ARDUINO_ARCH_AVR
 
 // Coerce any EEPROM-based node OpenTRV ID bytes to valid values if unset (0xff) or if forced,
@@ -72,6 +75,7 @@ bool ensureIDCreated(const bool force)
           const uint8_t newValue = 0x80 | OTV0P2BASE::getSecureRandomByte();
           if(0xff == newValue) { continue; } // Reject unusable value.
           OTV0P2BASE::eeprom_smart_update_byte(loc, newValue);
+          ++nodeIDGeneration;
 //          OTV0P2BASE::serialPrintAndFlush(newValue, HEX);
           break;
           }
@@ -159,6 +163,7 @@ bool getPrimaryBuilding16ByteSecretKey(uint8_t *key)
  */
 void clearAllNodeAssociations()
 {
+    V0p2_NodeIndex.invalidate();
     uint8_t *nodeIDPtr = (uint8_t *)V0P2BASE_EE_START_NODE_ASSOCIATIONS;
 ////     It would be sufficient to ensure that the first byte of the first entry is erased (0xff)
 ////     IF we erase the first byte of the following entry each time we add any except the last.
@@ -207,6 +212,7 @@ bool getNodeAssociation(const uint8_t index, uint8_t *const nodeID)
 // TODO: optionally allow setting (persistent) MSBs of counter to current+1 and force counterparty restart to eliminate replay attack.
 int8_t addNodeAssociation(const uint8_t *nodeID)
 {
+    V0p2_NodeIndex.invalidate();
     uint8_t *eepromPtr = (uint8_t *)V0P2BASE_EE_START_NODE_ASSOCIATIONS;
     // Loop through node ID locations checking for empty slot marked by invalid byte (0xff).
     for(uint8_t i = 0; i < V0P2BASE_EE_NODE_ASSOCIATIONS_MAX_SETS; i ++) {
@@ -257,11 +263,50 @@ void NodeAssociationTableMock::get(const uint8_t index, uint8_t* dest) const
     memcpy(dest, start, idLength);
 }
 
+int8_t NodeAssociationIndex::getNextMatchingNodeID(
+    const NodeAssociationTableBase &table,
+    const uint8_t _index, const uint8_t *const prefix, const uint8_t prefixLen, uint8_t *const nodeID)
+{
+    // Validate inputs.
+    if (_index >= maxSets) { return (-1); }
+    if (prefixLen > idLength) { return (-1); }
+    if ((NULL == prefix) && (0 != prefixLen)) { return (-1); }
+    if (!index.isValid()) { build(table); }
+
+    uint8_t temp[idLength];
+    // Valid associations are contiguous from slot 0, so with no prefix
+    // the next entry is simply the one at _index, if any.
+    if (0 == prefixLen) {
+        if (_index >= index.size()) { return (-1); }
+        if (nullptr != nodeID) { table.get(_index, nodeID); }
+        return (static_cast<int8_t>(_index));
+    }
+
+    // Of the entries sharing the key, find the lowest slot at or after _index
+    // that matches the whole prefix; usually there is only one candidate.
+    const uint8_t kl = (prefixLen < keyLength) ? prefixLen : keyLength;
+    int8_t best = -1;
+    for (uint8_t i = index.lowerBound(prefix, kl); index.keyMatches(i, prefix, kl); ++i) {
+        const uint8_t slot = index.slotAt(i);
+        if ((slot < _index) || ((best >= 0) && (slot >= best))) { continue; }
+        if (prefixLen > keyLength) {
+            table.get(slot, temp);
+            if (0 != memcmp(temp, prefix, prefixLen)) { continue; }
+        }
+        best = static_cast<int8_t>(slot);
+    }
+    if ((best >= 0) && (nullptr != nodeID)) { table.get(static_cast<uint8_t>(best), nodeID); }
+    return (best);
+}
+
 #ifdef OTV0P2BASE_NODE_ASSOCIATION_TABLE_V0P2
+NodeAssociationIndex V0p2_NodeIndex;
+
 bool NodeAssociationTableV0p2::set(const uint8_t index, const uint8_t* const src)
 {
     if ((index >= maxSets) || (src == nullptr)) { return (false); }
 
+    V0p2_NodeIndex.invalidate();
     uint8_t* const start = reinterpret_cast<uint8_t* const>(startAddr + (index * setSize));
 
     eeprom_update_block(src, start, idLength);
@@ -25,6 +25,7 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015--2016
 #define OTV0P2BASE_SECURITY_H
 
 #include <stdint.h>
+#include <string.h>
 // #include <iostream>
 
 #include "OTV0P2BASE_EEPROM.h"
@@ -71,6 +72,11 @@ inline bool validIDByte(const uint8_t v) { return((0 != (0x80 & v)) && (0xff !=
 // Returns true if all values good.
 bool ensureIDCreated(const bool force = false);
 
+// Incremented (wrapping) each time this library may have altered the EEPROM node ID,
+// eg by ensureIDCreated() or the CLI, so that RAM copies of the ID can be refreshed.
+// Not thread-/ISR- safe.
+extern uint8_t nodeIDGeneration;
+
 // Functions for setting a 16 byte primary building secret key which must not be all-1s.
 /**
  * @brief   Sets the primary building 16 byte secret key in EEPROM.
@@ -200,6 +206,166 @@ int8_t getNextMatchingNodeIDGeneric(uint8_t _index, const uint8_t *prefix, uint8
     return(-1);
 }
 
+/**
+ * @brief   Read the ID of the association in slot i of table into id (8 bytes).
+ * @retval  false if the slot is empty (0xff-leading) or unreadable.
+ *
+ * One of these is needed for each kind of table over which a NodeIDPrefixIndex is built.
+ */
+inline bool readNodeID(const NodeAssociationTableBase &table, const uint16_t i, uint8_t *const id)
+{
+    id[0] = 0xff; // Treat an unreadable entry as empty.
+    table.get(static_cast<uint8_t>(i), id);
+    return (0xff != id[0]);
+}
+
+/**
+ * @brief   Sorted RAM index of the leading ID bytes of node associations, with their slots.
+ *
+ * Holds the first keyLength bytes of each association sorted (then by slot),
+ * so that finding the candidates for an ID prefix is a binary search
+ * rather than a read and compare of every slot.
+ * The common core of NodeAssociationIndex, NodeAssociationStoreIndex
+ * and OTRadioLink::NodeIDPrefixCache.
+ * Not thread-/ISR- safe.
+ *
+ *   * slot_t  unsigned type for slot numbers and counts, eg uint8_t or uint16_t
+ *   * maxSlots  maximum number of associations held
+ *   * keyLength  number of leading ID bytes held for each entry, [1,8]
+ */
+template<typename slot_t, slot_t maxSlots, uint8_t keyLength = 2>
+class NodeIDPrefixIndex final {
+    static_assert(maxSlots > 0, "must allow at least one association");
+    static_assert((keyLength >= 1) && (keyLength <= V0P2BASE_EE_NODE_ASSOCIATIONS_8B_ID_LENGTH), "bad keyLength");
+
+public:
+    static constexpr uint8_t idLength {V0P2BASE_EE_NODE_ASSOCIATIONS_8B_ID_LENGTH};
+
+    constexpr NodeIDPrefixIndex() : keys(), slots(), nIDs(0), generation(0), valid(false) { }
+
+    // Forget the index contents; the owner rebuilds it before the next lookup.
+    void invalidate() { valid = false; }
+    // True if the index has been built since last invalidated.
+    bool isValid() const { return(valid); }
+    // Number of associations indexed; only meaningful if isValid().
+    slot_t size() const { return(nIDs); }
+    // Changes each time the index is rebuilt, ie after any invalidation,
+    // so that dependent per-slot caches can tell when to drop their contents.
+    uint8_t getGeneration() const { return(generation); }
+
+    /**
+     * @brief   (Re)build the index from the first n slots of table,
+     *          stopping at the first empty (0xff-leading) entry.
+     *          There must be a readNodeID() for table_t.
+     * @retval  number of associations indexed.
+     */
+    template<class table_t>
+    slot_t build(const table_t &table, slot_t n)
+    {
+        nIDs = 0;
+        if (n > maxSlots) { n = maxSlots; }
+        for (slot_t i = 0; i < n; ++i) {
+            uint8_t id[idLength];
+            if (!readNodeID(table, i, id)) { break; }
+            insert(id, i);
+        }
+        ++generation;
+        valid = true;
+        return (nIDs);
+    }
+
+    /**
+     * @brief   Insert the key of id for slot, after any equal keys (of lower slots).
+     * @retval  false if the index is full.
+     */
+    bool insert(const uint8_t *const id, const slot_t slot)
+    {
+        if (nIDs >= maxSlots) { return (false); }
+        slot_t pos = lowerBound(id, keyLength);
+        while ((pos < nIDs) && (0 == memcmp(keys[pos], id, keyLength))) { ++pos; }
+        memmove(keys[pos+1], keys[pos], size_t(nIDs - pos) * keyLength);
+        memmove(slots + pos + 1, slots + pos, size_t(nIDs - pos) * sizeof(slots[0]));
+        memcpy(keys[pos], id, keyLength);
+        slots[pos] = slot;
+        ++nIDs;
+        return (true);
+    }
+
+    // Position of the first entry whose key is not less than the first kl [1,keyLength] bytes of prefix.
+    slot_t lowerBound(const uint8_t *const prefix, const uint8_t kl) const
+    {
+        slot_t lo = 0;
+        slot_t hi = nIDs;
+        while (lo < hi) {
+            const slot_t mid = static_cast<slot_t>((lo + hi) / 2);
+            if (memcmp(keys[mid], prefix, kl) < 0) { lo = static_cast<slot_t>(mid + 1); } else { hi = mid; }
+        }
+        return (lo);
+    }
+    // True if entry i exists and its key starts with the first kl [1,keyLength] bytes of prefix.
+    bool keyMatches(const slot_t i, const uint8_t *const prefix, const uint8_t kl) const
+        { return((i < nIDs) && (0 == memcmp(keys[i], prefix, kl))); }
+    // True if any entry's key starts with the first kl [1,keyLength] bytes of prefix.
+    bool hasKeyPrefix(const uint8_t *const prefix, const uint8_t kl) const
+        { return(keyMatches(lowerBound(prefix, kl), prefix, kl)); }
+    // Table slot of entry i; i < size().
+    slot_t slotAt(const slot_t i) const { return(slots[i]); }
+
+private:
+    // Leading ID bytes, sorted ascending, with matching table slots.
+    uint8_t keys[maxSlots][keyLength];
+    slot_t slots[maxSlots];
+    slot_t nIDs;
+    uint8_t generation;
+    bool valid;
+};
+
+/**
+ * @brief   RAM-resident index of node association ID prefixes to table slots.
+ *
+ * A NodeIDPrefixIndex over the V0p2 association table layout,
+ * so that a lookup is a binary search plus at most a read of the
+ * few candidate entries, rather than a read and compare of every slot.
+ * Built lazily from the table on first lookup; must be invalidated
+ * whenever the table is altered.
+ */
+class NodeAssociationIndex final {
+public:
+    static constexpr uint8_t maxSets {V0P2BASE_EE_NODE_ASSOCIATIONS_MAX_SETS};
+    static constexpr uint8_t idLength {V0P2BASE_EE_NODE_ASSOCIATIONS_8B_ID_LENGTH};
+    // Number of leading ID bytes held in RAM for each entry.
+    static constexpr uint8_t keyLength {2};
+
+    // Forget the index contents; the next lookup rebuilds from the table.
+    void invalidate() { index.invalidate(); }
+    // True if the index has been built since last invalidated.
+    bool isValid() const { return(index.isValid()); }
+    // Number of associations indexed; only meaningful if isValid().
+    uint8_t size() const { return(index.size()); }
+    // Changes each time the index is rebuilt, ie after any invalidation,
+    // so that dependent per-slot caches can tell when to drop their contents.
+    uint8_t getGeneration() const { return(index.getGeneration()); }
+
+    /**
+     * @brief   (Re)build the index from the table.
+     *          Stops at the first empty (0xff-leading) entry.
+     * @retval  number of associations indexed.
+     */
+    uint8_t build(const NodeAssociationTableBase &table) { return(index.build(table, maxSets)); }
+
+    /**
+     * @brief   As getNextMatchingNodeIDGeneric(), but using the index.
+     *          Builds the index first if not valid.
+     * @param   table   Table the index describes; used to build and to check candidates.
+     * @retval  returns index or -1 if no matching node ID found
+     */
+    int8_t getNextMatchingNodeID(const NodeAssociationTableBase &table,
+                                 uint8_t _index, const uint8_t *prefix, uint8_t prefixLen, uint8_t *nodeID);
+
+private:
+    NodeIDPrefixIndex<uint8_t, maxSets, keyLength> index;
+};
+
 #ifdef ARDUINO_ARCH_AVR
 #define OTV0P2BASE_NODE_ASSOCIATION_TABLE_V0P2
 /**
@@ -232,6 +398,8 @@ public:
 
 // Static instance of V0p2_Nodes for backwards compatibility.
 static constexpr NodeAssociationTableV0p2 V0p2_Nodes;
+// Index over V0p2_Nodes; invalidated by addNodeAssociation() etc.
+extern NodeAssociationIndex V0p2_NodeIndex;
 
 inline int8_t getNextMatchingNodeID(
     uint8_t _index, 
@@ -239,34 +407,7 @@ inline int8_t getNextMatchingNodeID(
     uint8_t prefixLen, 
     uint8_t *nodeID)
 {
-    // return (getNextMatchingNodeIDGeneric<decltype(V0p2_Nodes), V0p2_Nodes>(index, prefix, prefixLen, nodeID));
-        // // Validate inputs.
-    if(_index >= V0P2BASE_EE_NODE_ASSOCIATIONS_MAX_SETS) { return(-1); }
-    if(prefixLen > V0P2BASE_EE_NODE_ASSOCIATIONS_8B_ID_LENGTH) { return(-1); }
-    if((NULL == prefix) && (0 != prefixLen)) { return(-1); }
-
-    // Loop through node IDs until match or last entry tested.
-    //   - if a match is found, return index and fill nodeID
-    //   - if no match, exit loop.
-    for (uint8_t index = _index; index != V0p2_Nodes.maxSets; ++index) {
-        uint8_t temp[V0p2_Nodes.idLength] = {};
-        V0p2_Nodes.get(index, temp);
-
-        if (0xff == temp[0]) { return (-1); } 
-
-        // If no prefix is passed in, we match automatically and let the caller
-        // deal with scanning values.
-        const bool isMatch = (prefixLen == 0) || (memcmp(temp, prefix, prefixLen) == 0);
-
-        if (isMatch) {
-            if (nullptr != nodeID) { memcpy(nodeID, temp, V0p2_Nodes.idLength); }
-
-            return (index);
-        }
-    }
-
-    // No match has been found.
-    return(-1);
+    return(V0p2_NodeIndex.getNextMatchingNodeID(V0p2_Nodes, _index, prefix, prefixLen, nodeID));
 }
 #endif // ARDUINO_ARCH_AVR
 
@@ -162,6 +162,75 @@ class SimpleTSUint8Sensor : public Sensor<uint8_t>
   };
 
 
+// Static-dispatch (CRTP) counterpart of Sensor<T>, with no vtable.
+// For sensors only ever used as concrete types, eg as template parameters
+// to ModelledRadValve or SystemStatsLine, so that get()/read() calls
+// can be inlined rather than made indirectly.
+// D derives as: class MySensor final : public SensorStatic<MySensor, uint8_t>,
+// and must provide non-virtual T get() const and T read();
+// it may hide any of the defaults below with its own versions.
+// Wrap in SensorVirtualAdapter<D> where the virtual Sensor<T> interface is needed.
+template <class D, class T>
+class SensorStatic
+  {
+  protected:
+    // Not for direct (non-derived) use nor deletion via this base.
+    SensorStatic() = default;
+    ~SensorStatic() = default;
+
+  public:
+    // Type of sensed data.
+    typedef T data_t;
+
+    // The concrete sensor.
+    D &derived() { return(*static_cast<D *>(this)); }
+    const D &derived() const { return(*static_cast<const D *>(this)); }
+
+    // Defaults as for Sensor<T>.
+    bool isAvailable() const { return(true); }
+    Sensor_tag_t tag() const { return(NULL); }
+    bool isValid(T /*value*/) const { return(true); }
+    uint8_t preferredPollInterval_s() const { return(0); }
+    bool handleInterruptSimple() { return(false); }
+  };
+
+// Static-dispatch counterpart of SimpleTSUint8Sensor;
+// D provides read(), which should set value.
+template <class D>
+class SimpleTSUint8SensorStatic : public SensorStatic<D, uint8_t>
+  {
+  protected:
+    // The current sensor value, as fetched/computed by read().
+    volatile uint8_t value;
+
+    constexpr SimpleTSUint8SensorStatic(const uint8_t v = 0) : value(v) { }
+
+  public:
+    // Return last value fetched by read(); undefined before first read().
+    uint8_t get() const { return(value); }
+  };
+
+// Exposes a SensorStatic-derived sensor through the virtual Sensor<T> interface,
+// for code (eg stats or display loops over Sensor pointers) that needs one.
+// Only this adapter carries a vtable.
+template <class D>
+class SensorVirtualAdapter final : public Sensor<typename D::data_t>
+  {
+  private:
+    typedef typename D::data_t T;
+    D &s;
+  public:
+    constexpr explicit SensorVirtualAdapter(D &sensor) : s(sensor) { }
+    virtual T get() const override { return(s.get()); }
+    virtual T read() override { return(s.read()); }
+    virtual bool isAvailable() const override { return(s.isAvailable()); }
+    virtual Sensor_tag_t tag() const override { return(s.tag()); }
+    virtual bool isValid(const T value) const override { return(s.isValid(value)); }
+    virtual uint8_t preferredPollInterval_s() const override { return(s.preferredPollInterval_s()); }
+    virtual bool handleInterruptSimple() override { return(s.handleInterruptSimple()); }
+  };
+
+
 // Sub-sensor / facade.
 // This sub-sensor's value is derived from another sensor value,
 // and so can be considered low priority by default.
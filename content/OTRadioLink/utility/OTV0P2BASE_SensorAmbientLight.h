@@ -169,6 +169,39 @@ class SensorAmbientLightAdaptiveTBase : public SensorAmbientLightBase
     uint8_t darkThreshold =
         SensorAmbientLightBase::DEFAULT_LIGHT_THRESHOLD-DEFAULT_upDelta;
 
+    // Adaptive sampling state, in read() calls (polls) between samples.
+    // While the value is stable (within epsilon) or dark
+    // the interval doubles at each sample up to a cap,
+    // and any change or wakeSampling() drops it back to 1.
+    bool adaptiveSampling = false;
+    uint8_t sampleInterval = 1;
+    // Polls to skip before the next sample.
+    uint8_t sampleSkip = 0;
+
+    // Call once per poll before sampling the sensor;
+    // true if the sensor should be sampled this time,
+    // else value should be left as it is.
+    bool _pollSampleDue()
+      {
+      if(0 == sampleSkip) { return(true); }
+      --sampleSkip;
+      return(false);
+      }
+    // Note a fresh sample before storing it in value.
+    void _noteSample(const uint8_t newValue)
+      {
+      if(!adaptiveSampling) { return; }
+      const bool dark = (newValue <= darkThreshold) && (value <= darkThreshold);
+      const uint8_t d = (newValue > value) ? (newValue - value) : (value - newValue);
+      if(dark || (d <= epsilon))
+        {
+        const uint8_t cap = dark ? MAX_SAMPLE_INTERVAL_DARK : MAX_SAMPLE_INTERVAL_STABLE;
+        sampleInterval = OTV0P2BASE::fnmin(cap, uint8_t(sampleInterval << 1));
+        }
+      else { sampleInterval = 1; }
+      sampleSkip = sampleInterval - 1;
+      }
+
     // Recomputes thresholds and 'rangeTooNarrow' based on current state.
     //   * meanNowOrFF  typical/mean light level around this time
     //     each 24h; 0xff if not known.
@@ -244,6 +277,11 @@ class SensorAmbientLightAdaptiveTBase : public SensorAmbientLightBase
       }
 
   public:
+    // Longest sampling intervals in polls (usually minutes)
+    // while the value is stable but lit, and while dark.
+    static constexpr uint8_t MAX_SAMPLE_INTERVAL_STABLE = 4;
+    static constexpr uint8_t MAX_SAMPLE_INTERVAL_DARK = 8;
+
     // This is constexpr!
     constexpr SensorAmbientLightAdaptiveTBase() { }
 
@@ -251,7 +289,7 @@ class SensorAmbientLightAdaptiveTBase : public SensorAmbientLightBase
     // DHD20190506: resetAdaptive() should always have been reset()
     //     else insufficiently cleared (the plug-in occupancy detector)
     //     but will be left for benefit of explicit callers.
-    void resetAdaptive() { SensorAmbientLightBase::reset(); occCallbackOpt = NULL; setTypMinMax(0xff, 0xff, 0xff, false); occupancyDetector.reset(); }
+    void resetAdaptive() { SensorAmbientLightBase::reset(); occCallbackOpt = NULL; setTypMinMax(0xff, 0xff, 0xff, false); occupancyDetector.reset(); adaptiveSampling = false; wakeSampling(); }
     virtual void reset() override { resetAdaptive(); }
 
     // Get light threshold, above which the room is considered light enough for activity [1,254].
@@ -266,12 +304,26 @@ class SensorAmbientLightAdaptiveTBase : public SensorAmbientLightBase
     // Set 'possible'/weak occupancy callback function; NULL for no callback.
     void setOccCallbackOpt(void (*occCallbackOpt_)(bool)) { occCallbackOpt = occCallbackOpt_; }
 
+    // Enable/disable adaptive sampling (off by default).
+    // When enabled the sensor is sampled less often while its value is
+    // stable or dark, saving ADC and sensor power wakes;
+    // read() must still be called at the usual rate, as skipped polls
+    // hold the last value so that darkTicks and the occupancy detector
+    // still see one value per poll.
+    void setAdaptiveSampling(const bool enable) { adaptiveSampling = enable; wakeSampling(); }
+    // Return to sampling on every poll, eg on a PIR or other occupancy event.
+    void wakeSampling() { sampleInterval = 1; sampleSkip = 0; }
+    // Current sampling interval in polls; 1 when sampling on every poll.
+    uint8_t getSampleInterval() const { return(sampleInterval); }
+
     // Set recent min and max ambient light levels from stats, to allow auto adjustment to dark; ~0/0xff means no min/max available.
     // Longer term typically over the last week or so
     // (eg rolling exponential decay).
     //
     // Call typically hourly with updated stats,
     // to set other internal time-dependent adaptation.
+    // ByHourSimpleStatsUpdaterSampleStats::getAmbLightTyp*() supply
+    // the smoothed stats values from RAM, so may be used as often as needed.
     //   * meanNowOrFF  typical/mean light level around this time ea 24h;
     //         0xff if not known.
     //   * sensitive  if true be more sensitive to occupancy changes,
@@ -346,6 +398,16 @@ class SensorAmbientLightAdaptiveMock : public SensorAmbientLightAdaptive
     // Set new non-dependent values immediately.
     virtual bool set(const uint8_t newValue, const uint16_t newDarkTicks, const bool isRangeTooNarrow = false)
         { value = newValue; rangeTooNarrow = isRangeTooNarrow; darkTicks = newDarkTicks; return(true); }
+    // Offer a new value as if from the sensor hardware,
+    // taken only if adaptive sampling would sample on this poll;
+    // returns true if taken.
+    bool sample(const uint8_t newValue)
+        {
+        if(!_pollSampleDue()) { return(false); }
+        _noteSample(newValue);
+        value = newValue;
+        return(true);
+        }
 
     // Expose the occupancy detector read-only for tests.
     const SensorAmbientLightOccupancyDetectorSimple &_occDet = occupancyDetector;
@@ -388,6 +450,10 @@ public:
     // If possible turn off all heavy current drains on supply before calling.
     uint8_t read()
         {
+        // With adaptive sampling, hold the last value when no sample is due.
+        if(!this->_pollSampleDue())
+            { return(SensorAmbientLightAdaptiveTBase<occupancyDetector_t>::read()); }
+
         // Power on to top of LDR/phototransistor, directly connected to IO_POWER_UP.
         OTV0P2BASE::power_intermittent_peripherals_enable(false);
         // Give supply a moment to settle, eg from heavy current draw elsewhere.
@@ -406,6 +472,7 @@ public:
         if(newValue != this->value) { addEntropyToPool((uint8_t)al, 0); }
 
         // Store new value.
+        this->_noteSample(newValue);
         this->value = newValue;
 
         // Have base class update other/derived values.
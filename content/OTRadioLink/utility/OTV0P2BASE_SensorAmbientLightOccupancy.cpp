@@ -47,16 +47,20 @@ namespace OTV0P2BASE
 //   * significantly above long term minimum and below long term maximum (and not saturated/dark)
 //     thus reflecting a deliberately-maintained light level other than max or dark,
 //     and in particular not dark, saturated daylight nor completely constant lighting.
-SensorAmbientLightOccupancyDetectorInterface::occType SensorAmbientLightOccupancyDetectorSimple::update(const uint8_t newLightLevel)
+//
+// Parameters are as for SensorAmbientLightOccupancyDetectorSimple,
+// and are compile-time constants in that case.
+template <class params_t>
+SensorAmbientLightOccupancyDetectorInterface::occType SensorAmbientLightOccupancyDetectorCore::_update(const params_t &p, const uint8_t newLightLevel)
     {
+    // Minimum delta (rise) for probable occupancy to be detected.
+    const uint8_t epsilon = p.epsilon;
+    // Min steady/grace time after lights on to confirm occupancy.
+    const uint8_t steadyTicksMinWithLightOn = p.steadyTicksMinWithLightOn;
     // Minimum steady time for detecting artificial light (ticks/minutes).
-    static constexpr uint8_t steadyTicksMinForArtificialLight = SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinForArtificialLight;
+    const uint8_t steadyTicksMinForArtificialLight = p.steadyTicksMinForArtificialLight;
     // Minimum steady time for detecting light on (ticks/minutes).
-    // Should be short enough to notice someone going to make a cuppa.
-    // Note that an interval <= TX interval may make it harder to validate
-    // algorithms from routinely collected data,
-    // eg <= 4 minutes with typical secure frame rate of 1 per ~4 minutes.
-    static constexpr uint8_t steadyTicksMinBeforeLightOn = SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinBeforeLightOn;
+    const uint8_t steadyTicksMinBeforeLightOn = p.steadyTicksMinBeforeLightOn;
 //
 //    // True if detection of PROBABLE events is responds to 'sensitive'.
 //    static constexpr bool sensitiveProbable = false;
@@ -234,4 +238,10 @@ SensorAmbientLightOccupancyDetectorInterface::occType SensorAmbientLightOccupanc
 	prevLightLevel = newLightLevel;
     return(occLevel);
 	}
+
+SensorAmbientLightOccupancyDetectorInterface::occType SensorAmbientLightOccupancyDetectorSimple::update(const uint8_t newLightLevel)
+    { return(_update(*this, newLightLevel)); }
+
+SensorAmbientLightOccupancyDetectorInterface::occType SensorAmbientLightOccupancyDetectorParameterised::update(const uint8_t newLightLevel)
+    { return(_update(params, newLightLevel)); }
 }
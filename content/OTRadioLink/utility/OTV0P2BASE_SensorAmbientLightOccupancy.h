@@ -119,31 +119,16 @@ class SensorAmbientLightOccupancyDetectorInterface
   };
 
 
-// Simple reference implementation.
-#define SensorAmbientLightOccupancyDetectorSimple_DEFINED
-class SensorAmbientLightOccupancyDetectorSimple final : public SensorAmbientLightOccupancyDetectorInterface
+// State and update logic shared by the implementations below.
+// The update logic is parameterised by a type providing
+// epsilon, steadyTicksMinWithLightOn, steadyTicksMinForArtificialLight
+// and steadyTicksMinBeforeLightOn,
+// as static constexpr members for the embedded build,
+// or as run-time values for host-side tuning.
+// Not part of the official API.
+class SensorAmbientLightOccupancyDetectorCore : public SensorAmbientLightOccupancyDetectorInterface
   {
-  public:
-      // Minimum delta (rise) for probable occupancy to be detected.
-      // A simple noise floor.
-      // This value cannot be greater than 127.
-      static constexpr uint8_t epsilon = SENSORAMBIENTLIGHTOCCUPANCY_EPSILON;
-      static_assert(epsilon <= 127, "epsilon must be less than or equal to 127.");
-
-      // Min steady/grace time after lights on to confirm occupancy.
-      // Intended to prevent a brief flash of light,
-      // or quickly turning on lights in the night to find something,
-      // from firing up the entire heating system.
-      // This threshold may be applied conditionally,
-      // eg when previously v dark.
-      // Not so long as to fail to respond to genuine occupancy.
-      //
-      // This threshold may be useful elsewhere
-      // to suppress over-hasty response
-      // to a very brief lights-on, eg in the middle of the night.
-      static constexpr uint8_t steadyTicksMinWithLightOn = SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinWithLightOn;
-
-  private:
+  protected:
       // Previous ambient light level [0,254]; 0 means dark.
       // Starts at max so that no initial light level
       // can imply occupancy.
@@ -167,19 +152,16 @@ class SensorAmbientLightOccupancyDetectorSimple final : public SensorAmbientLigh
       // as long as light levels stay up/steady long enough.
       bool probablePending = false;
 
-  public:
-      constexpr SensorAmbientLightOccupancyDetectorSimple() { }
+      constexpr SensorAmbientLightOccupancyDetectorCore() { }
 
+      // Implementation of update() with the given parameters.
+      template <class params_t>
+      occType _update(const params_t &p, uint8_t newLightLevel);
+
+  public:
       // Reset to starting state; primarily for unit tests.
       void reset() { setTypMinMax(0xff, 0xff, 0xff, false); prevLightLevel = startingLL; steadyTicks = 0; probablePending = false; }
 
-      // Call regularly (~1min) with current ambient light level [0,254].
-      // Returns value > 0 if occupancy is detected.
-      // Does not block.
-      //   * newLightLevel in range [0,254]
-      // Not thread-/ISR- safe.
-      virtual occType update(uint8_t newLightLevel) override;
-
       // Set mean, min and max ambient light levels from recent stats.
       // To allow auto adjustment to room; ~0/0xff means not known.
       // Mean value is for the current time of day.
@@ -209,5 +191,105 @@ class SensorAmbientLightOccupancyDetectorSimple final : public SensorAmbientLigh
   };
 
 
+// Simple reference implementation.
+#define SensorAmbientLightOccupancyDetectorSimple_DEFINED
+class SensorAmbientLightOccupancyDetectorSimple final : public SensorAmbientLightOccupancyDetectorCore
+  {
+  public:
+      // Minimum delta (rise) for probable occupancy to be detected.
+      // A simple noise floor.
+      // This value cannot be greater than 127.
+      static constexpr uint8_t epsilon = SENSORAMBIENTLIGHTOCCUPANCY_EPSILON;
+      static_assert(epsilon <= 127, "epsilon must be less than or equal to 127.");
+
+      // Min steady/grace time after lights on to confirm occupancy.
+      // Intended to prevent a brief flash of light,
+      // or quickly turning on lights in the night to find something,
+      // from firing up the entire heating system.
+      // This threshold may be applied conditionally,
+      // eg when previously v dark.
+      // Not so long as to fail to respond to genuine occupancy.
+      //
+      // This threshold may be useful elsewhere
+      // to suppress over-hasty response
+      // to a very brief lights-on, eg in the middle of the night.
+      static constexpr uint8_t steadyTicksMinWithLightOn = SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinWithLightOn;
+
+      // Minimum steady time for detecting artificial light (ticks/minutes).
+      static constexpr uint8_t steadyTicksMinForArtificialLight = SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinForArtificialLight;
+
+      // Minimum steady time for detecting light on (ticks/minutes).
+      // Should be short enough to notice someone going to make a cuppa.
+      // Note that an interval <= TX interval may make it harder to validate
+      // algorithms from routinely collected data,
+      // eg <= 4 minutes with typical secure frame rate of 1 per ~4 minutes.
+      static constexpr uint8_t steadyTicksMinBeforeLightOn = SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinBeforeLightOn;
+
+      constexpr SensorAmbientLightOccupancyDetectorSimple() { }
+
+      // Call regularly (~1min) with current ambient light level [0,254].
+      // Returns value > 0 if occupancy is detected.
+      // Does not block.
+      //   * newLightLevel in range [0,254]
+      // Not thread-/ISR- safe.
+      virtual occType update(uint8_t newLightLevel) override;
+  };
+
+
+// Run-time copy of the tuneable detection parameters,
+// defaulting to the compiled-in values used by
+// SensorAmbientLightOccupancyDetectorSimple.
+// Mainly for host-side parameter searches.
+struct SensorAmbientLightOccupancyParameters final
+  {
+  // As for SensorAmbientLightOccupancyDetectorSimple; epsilon in range [1,127].
+  uint8_t epsilon;
+  uint8_t steadyTicksMinWithLightOn;
+  uint8_t steadyTicksMinForArtificialLight;
+  uint8_t steadyTicksMinBeforeLightOn;
+
+  constexpr SensorAmbientLightOccupancyParameters(
+      uint8_t epsilon_ = SENSORAMBIENTLIGHTOCCUPANCY_EPSILON,
+      uint8_t steadyTicksMinWithLightOn_ = SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinWithLightOn,
+      uint8_t steadyTicksMinForArtificialLight_ = SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinForArtificialLight,
+      uint8_t steadyTicksMinBeforeLightOn_ = SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinBeforeLightOn)
+    : epsilon(epsilon_),
+      steadyTicksMinWithLightOn(steadyTicksMinWithLightOn_),
+      steadyTicksMinForArtificialLight(steadyTicksMinForArtificialLight_),
+      steadyTicksMinBeforeLightOn(steadyTicksMinBeforeLightOn_)
+    { }
+
+  // True if all values are usable.
+  constexpr bool isValid() const { return((epsilon >= 1) && (epsilon <= 127)); }
+
+  bool operator==(const SensorAmbientLightOccupancyParameters &o) const
+    {
+    return((epsilon == o.epsilon) &&
+           (steadyTicksMinWithLightOn == o.steadyTicksMinWithLightOn) &&
+           (steadyTicksMinForArtificialLight == o.steadyTicksMinForArtificialLight) &&
+           (steadyTicksMinBeforeLightOn == o.steadyTicksMinBeforeLightOn));
+    }
+  bool operator!=(const SensorAmbientLightOccupancyParameters &o) const { return(!(*this == o)); }
+  };
+
+// As SensorAmbientLightOccupancyDetectorSimple but with run-time parameters;
+// with default parameters behaves identically.
+// Slightly larger and slower, so intended for host-side tuning
+// rather than embedded use.
+class SensorAmbientLightOccupancyDetectorParameterised final : public SensorAmbientLightOccupancyDetectorCore
+  {
+  public:
+      // Parameters in use; must be valid.
+      const SensorAmbientLightOccupancyParameters params;
+
+      constexpr SensorAmbientLightOccupancyDetectorParameterised(
+          const SensorAmbientLightOccupancyParameters &params_ = SensorAmbientLightOccupancyParameters())
+        : params(params_) { }
+
+      // As for SensorAmbientLightOccupancyDetectorSimple::update().
+      virtual occType update(uint8_t newLightLevel) override;
+  };
+
+
 }
 #endif
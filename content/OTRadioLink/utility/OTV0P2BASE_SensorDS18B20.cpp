@@ -102,6 +102,7 @@ bool TemperatureC16_DS18B20::init()
 
     // Found one and configured it!
     found = true;
+    if(count < MAX_CACHED_SENSORS) { for(uint8_t i = 0; i < 8; ++i) { roms[count][i] = address[i]; } }
     count++;
 
 #if 0 && defined(DEBUG)
@@ -151,17 +152,85 @@ int16_t TemperatureC16_DS18B20::read()
 // At sub-maximum precision lsbits will be zero or undefined.
 // Expensive/slow.
 // Not thread-safe nor usable within ISRs (Interrupt Service Routines).
-uint8_t TemperatureC16_DS18B20::readMultiple(int16_t *const values, const uint8_t count, uint8_t index)
+uint8_t TemperatureC16_DS18B20::readMultiple(int16_t *const values, const uint8_t count, const uint8_t index)
+  {
+  if(!startConversion()) { return(0); }
+
+  // Poll for conversion complete (bus released)...
+  // Don't allow indefinite blocking;
+  // give up after a second of so.
+  uint8_t i = 67; // Allow for ~1s as ~15ms per loop.
+  while(!isConversionReady())
+    {
+    if(--i == 0) { conversionPending = false; return(0); }
+    OTV0P2BASE::nap(WDTO_15MS);
+    }
+
+  conversionPending = false;
+  return(readScratchpads(values, count, index));
+  }
+
+// Start a temperature conversion on all DS18B20s on the bus at once; does not wait.
+// Returns false if no DS18B20 is present.
+bool TemperatureC16_DS18B20::startConversion()
   {
   if(!initialised) { init(); }
-  if(0 == sensorCount) { return(0); }
+  if(0 == sensorCount) { return(false); }
 
-  uint8_t sensor = 0;
+  // Broadcast the start of a temperature reading.
+  // Start conversion without parasite power.
+  if(!minOW.broadcast(CMD_START_CONVO)) { return(false); }
+  conversionPending = true;
+  return(true);
+  }
 
-  // Start a temperature reading.
+// True if no DS18B20 on the bus is still converting; does not wait.
+// Any device still converting holds the bus low during a read slot.
+bool TemperatureC16_DS18B20::isConversionReady()
+  {
+  if(!conversionPending) { return(false); }
   minOW.reset();
   minOW.skip();
-  minOW.write(CMD_START_CONVO); // Start conversion without parasite power.
+  return(minOW.read_bit());
+  }
+
+// If a started conversion has completed then read the 'first' sensor's value
+// and return true, else return false without waiting.
+bool TemperatureC16_DS18B20::readIfReady()
+  {
+  if(!isConversionReady()) { return(false); }
+  conversionPending = false;
+  if(1 != readScratchpads(&value, 1, 0)) { value = DEFAULT_INVALID_TEMP; }
+  return(true);
+  }
+
+// As readMultiple() but for a conversion already started with startConversion().
+// Returns 0 without waiting if no conversion was started or it is not yet complete.
+uint8_t TemperatureC16_DS18B20::readMultipleIfReady(int16_t *const values, const uint8_t count, const uint8_t index)
+  {
+  if(!isConversionReady()) { return(0); }
+  conversionPending = false;
+  return(readScratchpads(values, count, index));
+  }
+
+// Read the results of a completed conversion from the scratchpads; returns number of values read.
+uint8_t TemperatureC16_DS18B20::readScratchpads(int16_t *const values, const uint8_t count, uint8_t index)
+  {
+  uint8_t sensor = 0;
+  if(0 == count) { return(0); }
+
+  // Read directly from the ROM addresses found by init() if they cover the whole bus.
+  if(sensorCount <= MAX_CACHED_SENSORS)
+    {
+    for(uint8_t i = index; (i < sensorCount) && (sensor < count); ++i)
+      {
+      // Read first two bytes of 9 available.  (No CRC config or check.)
+      uint8_t d[2];
+      if(!minOW.readFrom(roms[i], CMD_READ_SCRATCH, d, sizeof(d))) { break; }
+      values[sensor++] = (int16_t)((d[1] << 8) | d[0]);
+      }
+    return(sensor);
+    }
 
   // Ensure no bad search state.
   minOW.reset_search();
@@ -185,19 +254,6 @@ uint8_t TemperatureC16_DS18B20::readMultiple(int16_t *const values, const uint8_
       continue;
       }
 
-    minOW.reset();
-    minOW.select(address);
-
-    // Poll for conversion complete (bus released)...
-    // Don't allow indefinite blocking;
-    // give up after a second of so returning count of values read before this.
-    uint8_t i = 67; // Allow for ~1s as ~15ms per loop.
-    while(minOW.read_bit() == 0)
-      {
-      if(--i == 0) { return(sensor); }
-      OTV0P2BASE::nap(WDTO_15MS);
-      }
-
     // Fetch temperature (scratchpad read).
     minOW.reset();
     minOW.select(address);
@@ -219,6 +275,7 @@ uint8_t TemperatureC16_DS18B20::readMultiple(int16_t *const values, const uint8_
     if(sensor >= count) { break; }
     }
 
+  minOW.reset_search(); // Be kind to any other OW search user.
   return(sensor);
   }
 
@@ -65,6 +65,24 @@ class TemperatureC16_DS18B20 final : public TemperatureC16Base
     // The number of sensors found on the bus
     uint8_t sensorCount = 0;
 
+  public:
+    // Maximum number of sensors whose ROM addresses are remembered from init(),
+    // enough for (eg) flow and return pipe sensors.
+    // With no more sensors than this on the bus
+    // the results are read without searching the bus again each time.
+    static constexpr uint8_t MAX_CACHED_SENSORS = 2;
+
+  private:
+    // ROM addresses of the first sensors found on the bus by init().
+    uint8_t roms[MAX_CACHED_SENSORS][8] = { };
+
+    // True from startConversion() until the results are read.
+    bool conversionPending = false;
+
+    // Read the results of a completed conversion from the scratchpads; returns number of values read.
+    // Does not wait for the conversion; arguments as for readMultiple().
+    uint8_t readScratchpads(int16_t *values, uint8_t count, uint8_t index);
+
     // Initialise the device (if any) before first use.
     // Returns true iff successful.
     // Uses specified order DS18B20 found on bus.
@@ -101,6 +119,39 @@ class TemperatureC16_DS18B20 final : public TemperatureC16Base
     // return the number of DS18B20 sensors on the bus
     uint8_t getSensorCount();
 
+    // Nominal maximum conversion time in milliseconds at the current precision,
+    // from 94 at 9 bits to 750 at 12 bits (rounded up).
+    // Can be used to schedule the readIfReady() call for a later sub-cycle.
+    uint16_t getConversionTimeMs() const
+      {
+      const uint8_t shift = MAX_PRECISION - precision;
+      return((750U + ((1U << shift) - 1)) >> shift);
+      }
+
+    // Start a temperature conversion on all DS18B20s on the bus at once; does not wait.
+    // Returns false if no DS18B20 is present.
+    // The MCU can then sleep or do other work (eg radio)
+    // and collect the results with readIfReady() or readMultipleIfReady().
+    // Not thread-safe nor usable within ISRs (Interrupt Service Routines).
+    bool startConversion();
+
+    // True if a conversion has been started and its results not yet read.
+    bool isConversionPending() const { return(conversionPending); }
+
+    // True if no DS18B20 on the bus is still converting; does not wait.
+    // Not thread-safe nor usable within ISRs (Interrupt Service Routines).
+    bool isConversionReady();
+
+    // If a started conversion has completed then read the 'first' sensor's value
+    // (available from get()) and return true, else return false without waiting.
+    // Not thread-safe nor usable within ISRs (Interrupt Service Routines).
+    bool readIfReady();
+
+    // As readMultiple() but for a conversion already started with startConversion().
+    // Returns 0 without waiting if no conversion was started or it is not yet complete.
+    // Not thread-safe nor usable within ISRs (Interrupt Service Routines).
+    uint8_t readMultipleIfReady(int16_t *values, uint8_t count, uint8_t index = 0);
+
     // Force a read/poll of temperature and return the value sensed in nominal units of 1/16 C.
     // At sub-maximum precision lsbits will be zero or undefined.
     // Expensive/slow.
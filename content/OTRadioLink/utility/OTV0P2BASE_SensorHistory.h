@@ -0,0 +1,231 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Compact in-RAM history of recent per-minute sensor readings.
+
+ The by-hour stats (NVByHourByteStatsBase) keep one value per hour,
+ so adaptive code (eg warm-up learning, occupancy prediction)
+ and on-demand dumps that want finer detail would otherwise
+ have to keep their own copies or re-read the sensors.
+
+ Each minute's sample is stored as deltas from the previous one:
+ a header byte giving which fields changed,
+ then a zigzag varint (7 bits per byte, LSB first) per changed field,
+ so a typical minute takes 1 or 2 bytes;
+ a run of up to 16 unchanged minutes shares a single header byte.
+ The oldest records are dropped to make room.
+ */
+
+#ifndef OTV0P2BASE_SENSORHISTORY_H
+#define OTV0P2BASE_SENSORHISTORY_H
+
+#include <stdint.h>
+
+
+namespace OTV0P2BASE
+{
+
+
+// One minute's readings.
+struct SensorHistorySample final
+    {
+    int16_t tempC16; // Temperature in C*16.
+    uint8_t ambLight; // Ambient light [0,255].
+    uint8_t valvePC; // Valve open % [0,100].
+    uint8_t occpc; // Occupancy % [0,100].
+    };
+
+// Delta/varint encoding for SensorHistoryRing.
+namespace SensorHistoryCodec
+    {
+    // Header byte: low nibble is the mask of fields changed, in this order.
+    static constexpr uint8_t F_TEMP = 1, F_LIGHT = 2, F_VALVE = 4, F_OCC = 8;
+    // With no fields changed the high nibble is the count of extra unchanged minutes.
+    static constexpr uint8_t MAX_RUN = 16;
+    // Maximum encoded record size: header, 3 bytes for a 17-bit zigzag temperature delta, 2 each for the others.
+    static constexpr uint8_t MAX_RECORD_BYTES = 1 + 3 + (3 * 2);
+    inline uint32_t zigzag(const int32_t d) { return((d < 0) ? ((uint32_t(-(d + 1)) << 1) | 1U) : (uint32_t(d) << 1)); }
+    inline int32_t unzigzag(const uint32_t z) { return((0 != (z & 1)) ? -int32_t(z >> 1) - 1 : int32_t(z >> 1)); }
+    }
+
+// Ring of per-minute samples in ringBytes bytes of RAM.
+// With slowly-changing readings 256 bytes typically holds several hours.
+// Call add() once per minute.
+// Not thread-/ISR- safe.
+//   * ringBytes  encoded history size; at least 16, at most 4000 so that the minute count fits 16 bits
+template<uint16_t ringBytes = 256>
+class SensorHistoryRing final
+    {
+    static_assert(ringBytes >= 16, "ring too small for worst-case records");
+    static_assert(ringBytes <= 4000, "ring too large");
+
+    private:
+        uint8_t buf[ringBytes];
+        // Offset of the oldest record, bytes in use, and offset of the newest record.
+        uint16_t head = 0, used = 0, last = 0;
+        // Minutes held.
+        uint16_t minutes = 0;
+        // Sample just before the oldest record, and the newest sample.
+        SensorHistorySample base = { 0, 0, 0, 0 };
+        SensorHistorySample latest = { 0, 0, 0, 0 };
+
+        static uint16_t wrap(const uint16_t i) { return((i >= ringBytes) ? uint16_t(i - ringBytes) : i); }
+
+        // Append one byte; there must be room.
+        void put(const uint8_t b) { buf[wrap(uint16_t(head + used))] = b; ++used; }
+        void putVarint(uint32_t z)
+            {
+            while(z >= 0x80) { put(uint8_t(z | 0x80)); z >>= 7; }
+            put(uint8_t(z));
+            }
+
+        // Decode the record at offset i into s, returning its length in bytes and setting run to its minutes.
+        uint8_t decode(uint16_t i, SensorHistorySample &s, uint8_t &run) const
+            {
+            using namespace SensorHistoryCodec;
+            const uint8_t h = buf[i];
+            uint8_t len = 1;
+            const uint8_t mask = h & 0xf;
+            run = (0 == mask) ? uint8_t((h >> 4) + 1) : 1;
+            for(uint8_t f = 1; f <= F_OCC; f = uint8_t(f << 1))
+                {
+                if(0 == (mask & f)) { continue; }
+                uint32_t z = 0;
+                for(uint8_t shift = 0; ; shift = uint8_t(shift + 7))
+                    {
+                    i = wrap(uint16_t(i + 1));
+                    const uint8_t b = buf[i];
+                    ++len;
+                    z |= uint32_t(b & 0x7f) << shift;
+                    if(0 == (b & 0x80)) { break; }
+                    }
+                const int32_t d = unzigzag(z);
+                switch(f)
+                    {
+                    case F_TEMP: s.tempC16 = int16_t(s.tempC16 + d); break;
+                    case F_LIGHT: s.ambLight = uint8_t(s.ambLight + d); break;
+                    case F_VALVE: s.valvePC = uint8_t(s.valvePC + d); break;
+                    default: s.occpc = uint8_t(s.occpc + d); break;
+                    }
+                }
+            return(len);
+            }
+
+        // Drop the oldest record, folding it into base.
+        void dropOldest()
+            {
+            uint8_t run;
+            const uint8_t len = decode(head, base, run);
+            head = wrap(uint16_t(head + len));
+            used = uint16_t(used - len);
+            minutes = uint16_t(minutes - run);
+            }
+
+    public:
+        // Sequential reader, oldest minute first;
+        // invalidated by add() or clear().
+        class Reader final
+            {
+            private:
+                const SensorHistoryRing &r;
+                uint16_t i, remaining;
+                uint8_t run = 0;
+                SensorHistorySample s;
+            public:
+                explicit Reader(const SensorHistoryRing &ring) : r(ring), i(ring.head), remaining(ring.used), s(ring.base) { }
+                // Get the next minute's sample; false when there are no more.
+                bool next(SensorHistorySample &out)
+                    {
+                    if(0 == run)
+                        {
+                        if(0 == remaining) { return(false); }
+                        const uint8_t len = r.decode(i, s, run);
+                        i = wrap(uint16_t(i + len));
+                        remaining = uint16_t(remaining - len);
+                        }
+                    --run;
+                    out = s;
+                    return(true);
+                    }
+            };
+
+        SensorHistoryRing() : buf() { }
+
+        // Discard all history.
+        void clear() { head = 0; used = 0; minutes = 0; }
+
+        // Number of minutes of history held, and encoded bytes used.
+        uint16_t getMinutes() const { return(minutes); }
+        uint16_t getBytesUsed() const { return(used); }
+        bool isEmpty() const { return(0 == minutes); }
+
+        // Newest sample; only meaningful if not empty.
+        const SensorHistorySample &getLatest() const { return(latest); }
+
+        // Fetch the sample from minutesAgo minutes before the newest (0 being the newest).
+        // Returns false if not held.
+        bool getMinutesAgo(const uint16_t minutesAgo, SensorHistorySample &out) const
+            {
+            if(minutesAgo >= minutes) { return(false); }
+            Reader rd(*this);
+            for(uint16_t n = uint16_t(minutes - minutesAgo); n > 0; --n) { rd.next(out); }
+            return(true);
+            }
+
+        // Append this minute's sample, dropping the oldest records as needed.
+        void add(const SensorHistorySample &s)
+            {
+            using namespace SensorHistoryCodec;
+            if(0 == minutes)
+                {
+                // Start afresh with an unchanged-run record from s.
+                head = 0; used = 0; last = 0;
+                base = s;
+                latest = s;
+                put(0);
+                minutes = 1;
+                return;
+                }
+            const uint8_t mask = uint8_t(((s.tempC16 != latest.tempC16) ? F_TEMP : 0) |
+                                         ((s.ambLight != latest.ambLight) ? F_LIGHT : 0) |
+                                         ((s.valvePC != latest.valvePC) ? F_VALVE : 0) |
+                                         ((s.occpc != latest.occpc) ? F_OCC : 0));
+            // Extend a run of unchanged minutes if possible.
+            if((0 == mask) && (0 == (buf[last] & 0xf)) && ((buf[last] >> 4) < (MAX_RUN - 1)))
+                {
+                buf[last] = uint8_t(buf[last] + 0x10);
+                ++minutes;
+                return;
+                }
+            while(used > (ringBytes - MAX_RECORD_BYTES)) { dropOldest(); }
+            last = wrap(uint16_t(head + used));
+            put(mask);
+            if(0 != (mask & F_TEMP)) { putVarint(zigzag(int32_t(s.tempC16) - latest.tempC16)); }
+            if(0 != (mask & F_LIGHT)) { putVarint(zigzag(int32_t(s.ambLight) - latest.ambLight)); }
+            if(0 != (mask & F_VALVE)) { putVarint(zigzag(int32_t(s.valvePC) - latest.valvePC)); }
+            if(0 != (mask & F_OCC)) { putVarint(zigzag(int32_t(s.occpc) - latest.occpc)); }
+            latest = s;
+            ++minutes;
+            }
+    };
+
+
+}
+
+#endif
@@ -63,9 +63,47 @@ uint8_t PseudoSensorOccupancyTracker::read()
     const uint8_t newValue = (0 == ocM) ? 0 : OTV0P2BASE::fnmin(100U,
         100U - uint8_t((OCCUPATION_TIMEOUT_M - ocM) << OCCCP_SHIFT));
     value = newValue;
+    updateState();
     return(newValue);
   }
 
+// Recompute the coarse state and notify the listeners if it has changed.
+void PseudoSensorOccupancyTracker::updateState()
+  {
+  const uint8_t newState = isLikelyOccupied() ? OCC_STATE_OCCUPIED :
+      (longLongVacant() ? OCC_STATE_LONG_LONG_VACANT :
+      (longVacant() ? OCC_STATE_LONG_VACANT : OCC_STATE_VACANT));
+  if(newState == state) { return; }
+  state = newState;
+  for(OccupancyStateListener *const l : stateListeners)
+    { if(NULL != l) { l->occupancyStateChanged(occState(newState)); } }
+  }
+
+// Add a listener to be told of changes of coarse state.
+// The listener is told the current state at once.
+// Returns true if added (or already present), false if NULL or no free slot.
+bool PseudoSensorOccupancyTracker::addStateListener(OccupancyStateListener *const listener)
+  {
+  if(NULL == listener) { return(false); }
+  OccupancyStateListener **freeSlot = NULL;
+  for(OccupancyStateListener *&l : stateListeners)
+    {
+    if(listener == l) { return(true); }
+    if((NULL == l) && (NULL == freeSlot)) { freeSlot = &l; }
+    }
+  if(NULL == freeSlot) { return(false); }
+  *freeSlot = listener;
+  listener->occupancyStateChanged(occState(state));
+  return(true);
+  }
+
+// Remove a listener if present.
+void PseudoSensorOccupancyTracker::removeStateListener(const OccupancyStateListener *const listener)
+  {
+  for(OccupancyStateListener *&l : stateListeners)
+    { if(listener == l) { l = NULL; } }
+  }
+
 // Call when very strong evidence of active room occupation has occurred.
 // Do not call based on internal/synthetic events.
 // Such evidence may include operation of buttons (etc) on the unit
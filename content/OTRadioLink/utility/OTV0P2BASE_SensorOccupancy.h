@@ -32,6 +32,27 @@ namespace OTV0P2BASE
 {
 
 
+// Coarse occupancy state as reported to OccupancyStateListener.
+// Ordered so that 'long vacant' is any value >= OCC_STATE_LONG_VACANT.
+enum occState : uint8_t
+  {
+  OCC_STATE_OCCUPIED = 0, // Likely occupied.
+  OCC_STATE_VACANT, // Likely unoccupied.
+  OCC_STATE_LONG_VACANT, // Vacant for more than longVacantHThrH.
+  OCC_STATE_LONG_LONG_VACANT, // Vacant for more than longLongVacantHThrH.
+  OCC_STATE_UNKNOWN = 0xff // Not (yet) known; never reported.
+  };
+
+// Handler for changes of coarse occupancy state.
+class OccupancyStateListener
+  {
+  public:
+    // Called on each change of state, and with the current state when first added.
+    // Called from PseudoSensorOccupancyTracker::read() (not from an ISR);
+    // must return quickly and not re-enter the tracker.
+    virtual void occupancyStateChanged(occState newState) = 0;
+  };
+
 // Pseudo-sensor collating inputs from other primary sensors to estimate active room occupancy by humans.
 // This measure of occupancy is not intended to include people asleep
 // (or pets, for example).
@@ -104,6 +125,20 @@ class PseudoSensorOccupancyTracker final : public OTV0P2BASE::SimpleTSUint8Senso
     uint8_t vacancyH = 0;
     uint8_t vacancyM = 0;
 
+  public:
+    // Maximum number of state listeners.
+    static constexpr uint8_t MAX_STATE_LISTENERS = 2;
+
+  private:
+    // Registered state listeners; unused slots are NULL.
+    OccupancyStateListener *stateListeners[MAX_STATE_LISTENERS] = { };
+
+    // Coarse state as of the last read(), as an occState.
+    uint8_t state = OCC_STATE_VACANT;
+
+    // Recompute the coarse state and notify the listeners if it has changed.
+    void updateState();
+
   public:
     PseudoSensorOccupancyTracker()
       : occupationCountdownM(0), newOccupancyCountdownM(0),
@@ -116,7 +151,22 @@ class PseudoSensorOccupancyTracker final : public OTV0P2BASE::SimpleTSUint8Senso
 
     // Clears current occupancy and activity measures.
     // Primarily for testing.
-    void reset() { value = 0; occupationCountdownM.store(0); newOccupancyCountdownM.store(0); vacancyH = 0; vacancyM = 0; }
+    // Listeners are kept, and told of any change of state.
+    void reset() { value = 0; occupationCountdownM.store(0); newOccupancyCountdownM.store(0); vacancyH = 0; vacancyM = 0; updateState(); }
+
+    // Add a listener to be told of changes of coarse state (occupied, vacant, long vacant, etc),
+    // so as to avoid polling for them every tick.
+    // The listener is told the current state at once.
+    // Returns true if added (or already present), false if NULL or no free slot.
+    // Not thread-safe nor callable from Interrupt Service Routines.
+    bool addStateListener(OccupancyStateListener *listener);
+    // Remove a listener if present.
+    // Not thread-safe nor callable from Interrupt Service Routines.
+    void removeStateListener(const OccupancyStateListener *listener);
+
+    // Coarse state as of the last read(); never OCC_STATE_UNKNOWN.
+    // Changes made since the last read() (eg by markAsOccupied()) are not yet reflected.
+    occState getState() const { return(occState(state)); }
 
     // Force a read/poll of the occupancy and return the % likely occupied [0,100].
     // Full consistency of all views/actuators, especially short-term,
@@ -124,6 +174,7 @@ class PseudoSensorOccupancyTracker final : public OTV0P2BASE::SimpleTSUint8Senso
     // Potentially expensive/slow.
     // Not thread-safe nor callable from Interrupt Service Routines.
     // Poll at a fixed rate.
+    // Notifies any state listeners of a change of coarse state.
     virtual uint8_t read() override;
 
     // Returns true if this sensor reading value passed is potentially valid, eg in-range.
@@ -91,6 +91,74 @@ static void SHT21_init()
     }
   SHT21_initialised = true;
   }
+
+// Trigger the next measurement needed after (not including) s, or go IDLE if none.
+void SHT21Measurement::triggerAfter(const state_t s)
+  {
+  uint8_t cmd;
+  if((IDLE == s) && (NULL != tempOpt)) { state = MEASURING_TEMP; cmd = SHT21_I2C_CMD_TEMP_NOHOLD; }
+  else if((MEASURING_RH != s) && (NULL != rhOpt)) { state = MEASURING_RH; cmd = SHT21_I2C_CMD_RH_NOHOLD; }
+  else { abort(); return; }
+  Wire.beginTransmission(SHT21_I2C_ADDR);
+  Wire.write((byte) cmd);
+  Wire.endTransmission();
+  }
+
+// Start the measurement(s) and return immediately.
+// Returns false if already in progress.
+bool SHT21Measurement::start()
+  {
+  if(IDLE != state) { return(false); }
+  neededPowerUp = OTV0P2BASE::powerUpTWIIfDisabled();
+  // Initialise/config if necessary.
+  if(!SHT21_initialised) { SHT21_init(); }
+  triggerAfter(IDLE);
+  return(true);
+  }
+
+// Collect any completed measurement and trigger the next; never waits for a conversion.
+// Returns true when all requested measurements have been collected.
+bool SHT21Measurement::poll()
+  {
+  if(IDLE == state) { return(true); }
+  // In no-hold mode the SHT21 does not acknowledge its address until the conversion is done.
+  if(Wire.requestFrom(SHT21_I2C_ADDR, 3U) < 3) { return(false); }
+  const uint8_t msb = Wire.read();
+  const uint8_t lsb = Wire.read();
+  Wire.read(); // Discard the CRC.
+  const uint16_t raw = (((uint16_t)msb) << 8) | lsb;
+  const state_t s = state;
+  if(MEASURING_TEMP == s) { tempOpt->setFromRaw(raw); }
+  else { rhOpt->setFromRaw(raw); }
+  triggerAfter(s);
+  return(IDLE == state);
+  }
+
+// Abandon any measurement in progress.
+void SHT21Measurement::abort()
+  {
+  state = IDLE;
+  // Power down TWI ASAP.
+  if(neededPowerUp) { OTV0P2BASE::powerDownTWI(); neededPowerUp = false; }
+  }
+
+// Start and complete the measurement(s), napping while the SHT21 converts.
+// Returns true if all requested measurements were collected.
+bool SHT21Measurement::measure()
+  {
+  if(!start()) { return(false); }
+  // Max measurement times:
+  //   * temperature 14-bit: 85ms, 12-bit: 22ms
+  //   * RH% 12-bit: 29ms, 8-bit: 4ms
+  while(!poll())
+    {
+    // Wait for data, but avoid rolling over the end of a minor cycle...
+    if(OTV0P2BASE::getSubCycleTime() >= OTV0P2BASE::GSCT_MAX - 2) { abort(); return(false); }
+    if(SHT21_USE_REDUCED_PRECISION && (MEASURING_RH == state)) { OTV0P2BASE::sleepLowPowerMs(5); }
+    else { OTV0P2BASE::nap(WDTO_15MS); }
+    }
+  return(true);
+  }
 #elif defined(EFR32FG1P133F256GM48)
 // Initialise/configure SHT21, usually once only.
 // TWI must already be powered up.
@@ -118,61 +186,32 @@ static void SHT21_init()
 
 // Abstracting read function I2C transactions
 #ifdef ARDUINO_ARCH_AVR
-// Measure and return the current ambient temperature in units of 1/16th C.
-// This may contain up to 4 bits of information to RHS of the fixed binary point.
-// This may consume significant power and time.
-// Probably no need to do this more than (say) once per minute.
-// The first read will initialise the device as necessary
-// and leave it in a low-power mode afterwards.
-int16_t RoomTemperatureC16_SHT21::read()
+// Set the value from a raw reading.
+void RoomTemperatureC16_SHT21::setFromRaw(const uint16_t raw)
 {
-    const bool neededPowerUp = OTV0P2BASE::powerUpTWIIfDisabled();
-
-    // Initialise/config if necessary.
-    if(!SHT21_initialised) { SHT21_init(); }
-
-    // Max RH measurement time:
-    //   * 14-bit: 85ms
-    //   * 12-bit: 22ms
-    //   * 11-bit: 11ms
-    // Use blocking data fetch for now.
-    Wire.beginTransmission(SHT21_I2C_ADDR);
-    Wire.write((byte) SHT21_I2C_CMD_TEMP_HOLD); // Select control register.
-    if(SHT21_USE_REDUCED_PRECISION) {
-        // Should cover 12-bit conversion (22ms).
-        OTV0P2BASE::nap(WDTO_30MS);
-    } else {
-        // Should be plenty for slowest (14-bit) conversion (85ms).
-        OTV0P2BASE::sleepLowPowerMs(90);
-    }
-    Wire.endTransmission();
-    Wire.requestFrom(SHT21_I2C_ADDR, 3U);
-    while(Wire.available() < 3) {
-        // Wait for data, but avoid rolling over the end of a minor cycle...
-        if(OTV0P2BASE::getSubCycleTime() >= OTV0P2BASE::GSCT_MAX - 2) {
-            return(DEFAULT_INVALID_TEMP);  // Failure value: may be able to to better.
-        }
-    }
-    uint16_t rawTemp = (Wire.read() << 8);
-    rawTemp |= (Wire.read() & 0xfc); // Clear status ls bits.
-
-    // Power down TWI ASAP.
-    if(neededPowerUp) { OTV0P2BASE::powerDownTWI(); }
-
-    // Nominal formula: C = -46.85 + ((175.72*raw) / (1L << 16));
-    // FIXME: find a good but faster approximation...
-    // FIXME: should the shift/division be rounded to nearest?
-    // FIXME: break out calculation and unit test against example in datasheet.
-    const int_fast16_t c16 = -750 + int_fast16_t((5623 * int_fast32_t(rawTemp)) >> 17);
+    const int16_t c16 = SHT21_rawToC16(raw);
 
     // Capture entropy if (transformed) value has changed.
     // Claim one bit of noise in the raw value if the full value has changed,
     // though it is possible that this might be manipulatable by Eve,
     // and nearly all of the raw info is visible in the result.
-    if(c16 != value) { addEntropyToPool((uint8_t)rawTemp, 1); }
+    if(c16 != value) { addEntropyToPool((uint8_t)raw, 1); }
 
     value = c16;
-    return(c16);
+}
+
+// Measure and return the current ambient temperature in units of 1/16th C.
+// This may contain up to 4 bits of information to RHS of the fixed binary point.
+// This may consume significant power and time.
+// Probably no need to do this more than (say) once per minute.
+// The first read will initialise the device as necessary
+// and leave it in a low-power mode afterwards.
+// Use SHT21Measurement to read temperature and RH% together.
+int16_t RoomTemperatureC16_SHT21::read()
+{
+    SHT21Measurement m(this, NULL);
+    if(!m.measure()) { return(DEFAULT_INVALID_TEMP); } // Failure value: may be able to to better.
+    return(value);
 }
 #elif defined(EFR32FG1P133F256GM48)
 // TODO
@@ -216,11 +255,7 @@ int16_t RoomTemperatureC16_SHT21::read()
     #endif
     uint_fast16_t rawTemp = (rxMsg[0] << 8) | (rxMsg[1] & 0xfc);
 
-    // Nominal formula: C = -46.85 + ((175.72*raw) / (1L << 16));
-    // FIXME: find a good but faster approximation...
-    // FIXME: should the shift/division be rounded to nearest?
-    // FIXME: break out calculation and unit test against example in datasheet.
-    const int_fast16_t c16 = -750 + int_fast16_t((5623 * int_fast32_t(rawTemp)) >> 17);
+    const int_fast16_t c16 = SHT21_rawToC16(rawTemp);
 
     // Capture entropy if (transformed) value has changed.
     // Claim one bit of noise in the raw value if the full value has changed,
@@ -238,61 +273,32 @@ int16_t RoomTemperatureC16_SHT21::read()
 
 // Abstract for different i2c drivers.
 #ifdef ARDUINO_ARCH_AVR
-// Measure and return the current relative humidity in %; range [0,100] and 255 for error.
-// This may consume significant power and time.
-// Probably no need to do this more than (say) once per minute.
-// The first read will initialise the device as necessary and leave it in a low-power mode afterwards.
-// Returns 255 (~0) in case of error.
-uint8_t HumiditySensorSHT21::read()
+// Set the value and flags from a raw reading.
+void HumiditySensorSHT21::setFromRaw(const uint16_t raw)
 {
-    const bool neededPowerUp = OTV0P2BASE::powerUpTWIIfDisabled();
-
-    // Initialise/config if necessary.
-    if(!SHT21_initialised) { SHT21_init(); }
-
-    // Get RH%...
-    // Max RH measurement time:
-    //   * 12-bit: 29ms
-    //   *  8-bit:  4ms
-    // Use blocking data fetch for now.
-    Wire.beginTransmission(SHT21_I2C_ADDR);
-    Wire.write((byte) SHT21_I2C_CMD_RH_HOLD); // Select control register.
-    if(SHT21_USE_REDUCED_PRECISION) {
-    // Should cover 8-bit conversion (4ms).
-        OTV0P2BASE::sleepLowPowerMs(5);
-    } else {
-    // Should cover even 12-bit conversion (29ms).
-        OTV0P2BASE::nap(WDTO_30MS);
-    }
-    Wire.endTransmission();
-    Wire.requestFrom(SHT21_I2C_ADDR, 3U);
-    while(Wire.available() < 3) {
-        // Wait for data, but avoid rolling over the end of a minor cycle...
-        if(OTV0P2BASE::getSubCycleTime() >= OTV0P2BASE::GSCT_MAX - 2) {
-            // DEBUG_SERIAL_PRINTLN_FLASHSTRING("giving up");
-            return(~0);
-        }
-    }
-    const uint8_t rawRH = Wire.read();
-    const uint8_t rawRL = Wire.read();
-
-    // Power down TWI ASAP.
-    if(neededPowerUp) { OTV0P2BASE::powerDownTWI(); }
-
-    // Assemble raw value, clearing status ls bits.
-    const uint16_t raw = (((uint16_t)rawRH) << 8) | (rawRL & 0xfc);
-    // FIXME: should the shift/division be rounded to nearest?
-    // FIXME: break out calculation and unit test against example in datasheet.
-    const uint8_t result = uint8_t(-6 + ((125 * uint_fast32_t(raw)) >> 16));
+    const uint8_t result = SHT21_rawToRHPC(raw);
 
     // Capture entropy from raw status bits iff (transformed) reading has changed.
     // Claim no entropy since only a fraction of a bit is not in the result.
-    if(value != result) { OTV0P2BASE::addEntropyToPool(rawRL ^ rawRH, 0); }
+    if(value != result) { OTV0P2BASE::addEntropyToPool((uint8_t)(raw ^ (raw >> 8)), 0); }
 
     value = result;
     if(result > (HUMIDTY_HIGH_RHPC + HUMIDITY_EPSILON_RHPC)) { highWithHyst = true; }
     else if(result < (HUMIDTY_HIGH_RHPC - HUMIDITY_EPSILON_RHPC)) { highWithHyst = false; }
-    return(result);
+    noteReading(result);
+}
+
+// Measure and return the current relative humidity in %; range [0,100] and 255 for error.
+// This may consume significant power and time.
+// Probably no need to do this more than (say) once per minute.
+// The first read will initialise the device as necessary and leave it in a low-power mode afterwards.
+// Returns 255 (~0) in case of error.
+// Use SHT21Measurement to read temperature and RH% together.
+uint8_t HumiditySensorSHT21::read()
+{
+    SHT21Measurement m(NULL, this);
+    if(!m.measure()) { return(~0); }
+    return(value);
 }
 #elif defined(EFR32FG1P133F256GM48)
 // Measure and return the current relative humidity in %; range [0,100] and 255 for error.
@@ -334,9 +340,7 @@ uint8_t HumiditySensorSHT21::read()
     #endif
     const uint_fast16_t raw = (rxMsg[0] << 8) | (rxMsg[1] & 0xfc);
 
-    // FIXME: should the shift/division be rounded to nearest?
-    // FIXME: break out calculation and unit test against example in datasheet.
-    const uint8_t result = uint8_t(-6 + ((125 * uint_fast32_t(raw)) >> 16));
+    const uint8_t result = SHT21_rawToRHPC(raw);
 
     // Capture entropy from raw status bits iff (transformed) reading has changed.
     // Claim no entropy since only a fraction of a bit is not in the result.
@@ -345,6 +349,7 @@ uint8_t HumiditySensorSHT21::read()
     value = result;
     if(result > (HUMIDTY_HIGH_RHPC + HUMIDITY_EPSILON_RHPC)) { highWithHyst = true; }
     else if(result < (HUMIDTY_HIGH_RHPC - HUMIDITY_EPSILON_RHPC)) { highWithHyst = false; }
+    noteReading(result);
     return(result);
 }
 #endif
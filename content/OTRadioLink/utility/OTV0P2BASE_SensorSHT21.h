@@ -50,11 +50,39 @@ class HumiditySensorBase : public OTV0P2BASE::SimpleTSUint8Sensor
       // Invalid (and initial) reading.
       static constexpr uint8_t INVALID_RH = 255;
 
+      // Smoothed RH% rise per reading (x16) at or above which RH is rising rapidly,
+      // eg from a shower or cooking; with one reading per minute this is 1%/min,
+      // well above the HUMIDITY_OCCUPANCY_PC_MIN_RISE_PER_H drift of simple occupancy.
+      static constexpr int16_t RAPID_RISE_SLOPE_Q4 = 16;
+
     protected:
       // True if RH% is high, with hysteresis.
       // Marked volatile for thread-safe lock-free access.
       volatile bool highWithHyst = true;
 
+      // Exponentially-smoothed change in RH% per reading x16, with a 1/4 weight for each new change.
+      int16_t slopeQ4 = 0;
+      // Last valid reading, else INVALID_RH.
+      uint8_t lastValid = INVALID_RH;
+      // True while the smoothed slope is at least RAPID_RISE_SLOPE_Q4.
+      // Marked volatile for thread-safe lock-free access.
+      volatile bool risingRapidly = false;
+      // Called when a rapid rise starts; NULL if none.
+      void (*rapidRiseCallbackOpt)() = NULL;
+
+      // Update the rise-rate estimate with a new reading newValue; call from read() once value is set.
+      // A few integer operations, so cheap enough for every reading.
+      // Invalid readings are ignored.
+      void noteReading(const uint8_t newValue)
+        {
+        if(newValue > 100) { return; }
+        if(lastValid <= 100) { slopeQ4 = int16_t(slopeQ4 + ((int16_t((int16_t(newValue) - lastValid) * 16) - slopeQ4) / 4)); }
+        lastValid = newValue;
+        const bool wasRising = risingRapidly;
+        risingRapidly = (slopeQ4 >= RAPID_RISE_SLOPE_Q4);
+        if(risingRapidly && !wasRising && (NULL != rapidRiseCallbackOpt)) { rapidRiseCallbackOpt(); }
+        }
+
     public:
       HumiditySensorBase() : SimpleTSUint8Sensor(INVALID_RH) { }
 
@@ -75,6 +103,18 @@ class HumiditySensorBase : public OTV0P2BASE::SimpleTSUint8Sensor
       // True if RH% high with a hysteresis band of 2 * HUMIDITY_EPSILON_RHPC.
       // Thread-safe and usable within ISRs (Interrupt Service Routines).
       bool isRHHighWithHyst() const { return(highWithHyst); }
+
+      // True if RH% is rising rapidly, eg from a shower or cooking.
+      // Thread-safe and usable within ISRs (Interrupt Service Routines).
+      bool isRHRisingRapidly() const { return(risingRapidly); }
+
+      // Smoothed rise in RH% per reading x16; negative when falling.
+      int16_t getRHSlopeQ4() const { return(slopeQ4); }
+
+      // Set a callback made from read() as soon as RH% starts rising rapidly,
+      // eg to pass a boost hint to the valve without waiting for its next tick; NULL for none.
+      // The callback should be quick and must not read this sensor.
+      void setRapidRiseCallback(void (*const callback)()) { rapidRiseCallbackOpt = callback; }
     };
 
 // Simple mock object for testing.
@@ -82,31 +122,114 @@ class HumiditySensorMock final : public HumiditySensorBase
   {
   public:
     // Set new value.
-    bool set(uint8_t newValue) { value = newValue; highWithHyst = (newValue > HUMIDTY_HIGH_RHPC); return(true); }
-    bool set(uint8_t newValue, bool _highWithHyst) { value = newValue; highWithHyst = _highWithHyst; return(true); }
+    bool set(uint8_t newValue) { value = newValue; highWithHyst = (newValue > HUMIDTY_HIGH_RHPC); noteReading(newValue); return(true); }
+    bool set(uint8_t newValue, bool _highWithHyst) { value = newValue; highWithHyst = _highWithHyst; noteReading(newValue); return(true); }
 
     // Returns the existing value: use set() to set a new one.
     // Simplistically updates other flags and outputs based on current value.
     uint8_t read() override { return(get()); }
 
     // Reset to initial state; useful in unit tests.
-    void reset() { value = INVALID_RH; highWithHyst = true; }
+    void reset() { value = INVALID_RH; highWithHyst = true; slopeQ4 = 0; lastValid = INVALID_RH; risingRapidly = false; }
   };
 
 
+// Convert a raw SHT21 temperature reading to C*16; the status bits (2 lsbs) are ignored.
+// Nominal formula: C = -46.85 + ((175.72*raw) / (1L << 16)).
+inline int16_t SHT21_rawToC16(const uint16_t raw)
+    { return((int16_t)(-750 + int_fast16_t((5623 * int_fast32_t(raw & 0xfffcU)) >> 17))); }
+
+// Convert a raw SHT21 relative humidity reading to RH%; the status bits (2 lsbs) are ignored.
+// Nominal formula: RH% = -6 + ((125*raw) / (1L << 16)).
+inline uint8_t SHT21_rawToRHPC(const uint16_t raw)
+    { return(uint8_t(-6 + ((125 * uint_fast32_t(raw & 0xfffcU)) >> 16))); }
+
+
 #if defined(ARDUINO_ARCH_AVR) || defined(__arm__)
 
+#if defined(ARDUINO_ARCH_AVR)
+class SHT21Measurement;
+#endif
+
 // Sensor for relative humidity percentage; 0 is dry, 100 is condensing humid, 255 for error.
 // TODO: detect low supply voltage with user reg, and make isAvailable() return false if too low to be reliable.
 #define HumiditySensorSHT21_DEFINED
 class HumiditySensorSHT21 final : public HumiditySensorBase
-  { public: virtual uint8_t read(); };
+  {
+#if defined(ARDUINO_ARCH_AVR)
+  friend class SHT21Measurement;
+  private:
+    // Set the value and flags from a raw reading.
+    void setFromRaw(uint16_t raw);
+#endif
+  public:
+    virtual uint8_t read();
+  };
 
 // SHT21 sensor for ambient/room temperature in 1/16th of one degree Celsius.
 // TODO: detect low supply voltage with user reg, and make isAvailable() return false if too low to be reliable.
 #define RoomTemperatureC16_SHT21_DEFINED
 class RoomTemperatureC16_SHT21 final : public OTV0P2BASE::TemperatureC16Base
-  { public: virtual int16_t read(); };
+  {
+#if defined(ARDUINO_ARCH_AVR)
+  friend class SHT21Measurement;
+  private:
+    // Set the value from a raw reading.
+    void setFromRaw(uint16_t raw);
+#endif
+  public:
+    virtual int16_t read();
+  };
+
+#if defined(ARDUINO_ARCH_AVR)
+// Non-blocking SHT21 measurement of temperature and/or RH% in one wake window.
+// Uses no-hold-master mode, so the I2C bus is free while the SHT21 converts
+// and the MCU can nap or do other work between calls to poll(),
+// and triggers the RH% measurement as soon as the temperature one is collected
+// rather than in a separate read() with its own wait.
+// Either sensor may be NULL to skip that measurement.
+// Not thread-safe nor usable within ISRs (Interrupt Service Routines).
+#define SHT21Measurement_DEFINED
+class SHT21Measurement final
+  {
+  public:
+    enum state_t : uint8_t { IDLE, MEASURING_TEMP, MEASURING_RH };
+
+  private:
+    RoomTemperatureC16_SHT21 *const tempOpt;
+    HumiditySensorSHT21 *const rhOpt;
+    state_t state = IDLE;
+    // True if TWI was powered up by start() and should be powered down when done.
+    bool neededPowerUp = false;
+
+    // Trigger the next measurement needed after (not including) s, or go IDLE if none.
+    void triggerAfter(state_t s);
+
+  public:
+    constexpr SHT21Measurement(RoomTemperatureC16_SHT21 *const _tempOpt, HumiditySensorSHT21 *const _rhOpt)
+      : tempOpt(_tempOpt), rhOpt(_rhOpt) { }
+
+    // Current state; IDLE when no measurement in progress.
+    state_t getState() const { return(state); }
+
+    // Start the measurement(s) and return immediately.
+    // Returns false if already in progress.
+    bool start();
+
+    // Collect any completed measurement and trigger the next; never waits for a conversion.
+    // Returns true when all requested measurements have been collected
+    // (or if none was in progress), false while still converting.
+    bool poll();
+
+    // Abandon any measurement in progress, eg at the end of the wake window.
+    void abort();
+
+    // Start and complete the measurement(s), napping while the SHT21 converts.
+    // Gives up rather than roll over the end of the minor cycle.
+    // Returns true if all requested measurements were collected.
+    bool measure();
+  };
+#endif // defined(ARDUINO_ARCH_AVR)
 
 #endif // ARDUINO_ARCH_AVR || __arm__
 
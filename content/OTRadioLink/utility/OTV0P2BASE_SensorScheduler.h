@@ -0,0 +1,185 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Central scheduling of Sensor read() calls
+ at each sensor's preferredPollInterval_s().
+ */
+
+#ifndef OTV0P2BASE_SENSORSCHEDULER_H
+#define OTV0P2BASE_SENSORSCHEDULER_H
+
+#include <stdint.h>
+
+#include "OTV0P2BASE_Sensor.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+// Schedules read() of registered sensors at their poll intervals.
+// Call tick() each time the CPU is awake in the main loop (eg each major cycle)
+// with the seconds elapsed since the previous call.
+//
+// Sensors sharing a resource (eg the I2C bus or the ADC) may be put in one group;
+// when any member of a group is read, the others due within coalesceS are read too,
+// so that the resource is powered up once and the CPU wakes fewer times.
+// Reads are only done while the sub-cycle time is in the window set by setWindow(),
+// eg to keep sensor I/O away from radio-critical parts of the cycle;
+// anything due outside the window waits for the next tick() inside it.
+// Low-priority sensors are read after the others and may be held off entirely,
+// eg when energy is short.
+// nextDueInS() tells the caller how long it may sleep.
+//
+// Not thread-safe nor usable from ISRs.
+//   * maxSensors  capacity; in [1,16]
+template<uint8_t maxSensors = 8>
+class SensorScheduler final
+    {
+    static_assert((maxSensors > 0) && (maxSensors <= 16), "maxSensors must be in [1,16]");
+
+    public:
+        // Group for a sensor that shares no resource.
+        static constexpr uint8_t NO_GROUP = 0;
+        // Value of nextDueInS() when nothing is scheduled.
+        static constexpr uint8_t NONE_DUE = 255;
+
+    private:
+        struct Entry
+            {
+            void *sensor;
+            void (*readFn)(void *);
+            uint8_t intervalS;
+            uint8_t dueInS;
+            uint8_t group;
+            bool lowPri;
+            };
+        Entry entries[maxSensors];
+        uint8_t count = 0;
+
+        // Sub-cycle time window in which reads may be done.
+        uint8_t windowMinSCT = 0;
+        uint8_t windowMaxSCT = 255;
+
+        // A group member due within this many seconds is read with the rest of its group.
+        const uint8_t coalesceS;
+
+        template<class T>
+        static void readThunk(void *const s) { static_cast<Sensor<T> *>(s)->read(); }
+
+        bool eligible(const Entry &e, const bool allowLowPri) const { return(allowLowPri || !e.lowPri); }
+
+        // Read entry i, reschedule it, and mark it done.
+        void readEntry(const uint8_t i, uint16_t &done)
+            {
+            Entry &e = entries[i];
+            e.readFn(e.sensor);
+            e.dueInS = e.intervalS;
+            done |= uint16_t(1U << i);
+            }
+
+    public:
+        // Create an empty scheduler.
+        //   * coalesceS_  a group member due within this many seconds is read early with its group
+        explicit SensorScheduler(const uint8_t coalesceS_ = 8) : entries(), coalesceS(coalesceS_) { }
+
+        // Register a sensor, to be read first at the next tick().
+        //   * group  shared resource id, or NO_GROUP
+        //   * lowPri  if true then read after the others and only when allowed
+        //   * intervalS  poll interval in seconds; 0 to use preferredPollInterval_s()
+        // Returns false if full or the sensor has no poll interval.
+        template<class T>
+        bool add(Sensor<T> &s, const uint8_t group = NO_GROUP, const bool lowPri = false, const uint8_t intervalS = 0)
+            {
+            const uint8_t interval = (0 != intervalS) ? intervalS : s.preferredPollInterval_s();
+            if((0 == interval) || (count >= maxSensors)) { return(false); }
+            Entry &e = entries[count++];
+            e.sensor = &s;
+            e.readFn = &readThunk<T>;
+            e.intervalS = interval;
+            e.dueInS = 0;
+            e.group = group;
+            e.lowPri = lowPri;
+            return(true);
+            }
+
+        // Number of sensors registered.
+        uint8_t size() const { return(count); }
+
+        // Only read while the sub-cycle time is in [minSCT, maxSCT].
+        void setWindow(const uint8_t minSCT, const uint8_t maxSCT) { windowMinSCT = minSCT; windowMaxSCT = maxSCT; }
+
+        // Advance time and read any sensors that are due.
+        //   * elapsedS  seconds since the previous call
+        //   * subCycleTime  getSubCycleTime() now
+        //   * allowLowPri  if false, low-priority sensors are not read (and stay due)
+        // Returns the number of sensors read.
+        uint8_t tick(const uint8_t elapsedS, const uint8_t subCycleTime, const bool allowLowPri = true)
+            {
+            for(uint8_t i = 0; i < count; ++i)
+                { Entry &e = entries[i]; e.dueInS = (e.dueInS > elapsedS) ? uint8_t(e.dueInS - elapsedS) : 0; }
+            if((subCycleTime < windowMinSCT) || (subCycleTime > windowMaxSCT)) { return(0); }
+
+            uint16_t done = 0;
+            // Due sensors, normal priority first.
+            for(uint8_t pass = 0; pass < 2; ++pass)
+                {
+                for(uint8_t i = 0; i < count; ++i)
+                    {
+                    const Entry &e = entries[i];
+                    if((e.lowPri != (1 == pass)) || !eligible(e, allowLowPri) || (0 != e.dueInS)) { continue; }
+                    readEntry(i, done);
+                    }
+                }
+            // Group members due soon, while their resource is in use.
+            for(uint8_t i = 0; i < count; ++i)
+                {
+                const Entry &e = entries[i];
+                if((0 != (done & (1U << i))) || (NO_GROUP == e.group) ||
+                   !eligible(e, allowLowPri) || (e.dueInS > coalesceS)) { continue; }
+                for(uint8_t j = 0; j < count; ++j)
+                    {
+                    if((0 != (done & (1U << j))) && (entries[j].group == e.group))
+                        { readEntry(i, done); break; }
+                    }
+                }
+
+            uint8_t n = 0;
+            for( ; 0 != done; done &= uint16_t(done - 1)) { ++n; }
+            return(n);
+            }
+
+        // Seconds until the next read is due, 0 if overdue, NONE_DUE if nothing is scheduled.
+        //   * allowLowPri  if false, ignore low-priority sensors
+        uint8_t nextDueInS(const bool allowLowPri = true) const
+            {
+            uint8_t next = NONE_DUE;
+            for(uint8_t i = 0; i < count; ++i)
+                {
+                const Entry &e = entries[i];
+                if(eligible(e, allowLowPri) && (e.dueInS < next)) { next = e.dueInS; }
+                }
+            return(next);
+            }
+    };
+
+
+}
+
+#endif
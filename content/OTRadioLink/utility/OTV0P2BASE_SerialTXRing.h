@@ -0,0 +1,119 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Serial TX ring buffer drained from an ISR or in non-blocking chunks,
+ so that the CPU can sleep (eg in IDLE) while text goes out on the UART
+ rather than spinning in a flush.
+
+ Typical use with the Arduino HardwareSerial (whose own ISR then does the TX):
+
+    static OTV0P2BASE::SerialTXRing<128> serialTX;
+    ...
+    statsLine.queueStatusReport(serialTX);
+    ...
+    // Each time round the main loop, before sleeping:
+    serialTX.pumpTo(Serial, Serial.availableForWrite());
+
+ or without HardwareSerial TX, calling pumpUSART0() from the USART0 UDRE ISR.
+
+ Keywords: C++ embedded Arduino serial UART TX transmit ring buffer ISR
+ */
+
+#ifndef OTV0P2BASE_SERIALTXRING_H
+#define OTV0P2BASE_SERIALTXRING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ARDUINO_ARCH_AVR
+#include <avr/io.h>
+#endif
+
+#include "OTV0P2BASE_Concurrency.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+// Single-producer single-consumer byte FIFO:
+// the main loop pushes whole lines, and one consumer (an ISR or the main loop) pops.
+// Lock-free; see SPSCByteRing.
+//   * capacity  bytes held; a power of two in [2,128]
+template<uint8_t capacity>
+class SerialTXRing final
+    {
+    private:
+        SPSCByteRing<capacity> ring;
+
+    public:
+        constexpr SerialTXRing() { }
+
+        // Bytes queued.
+        uint8_t queued() const { return(ring.size()); }
+        bool isEmpty() const { return(ring.isEmpty()); }
+        // Bytes that can be pushed now.
+        uint8_t space() const { return(ring.space()); }
+        // Lines refused by push() for lack of space.
+        uint8_t getDropped() const { return(ring.getDropped()); }
+
+        // Queue all of len bytes from b, or none if there is not room
+        // (so that a partial line is never sent); returns false if refused.
+        // Producer side only.
+        bool push(const uint8_t *const b, const uint8_t len) { return(ring.push(b, len)); }
+        bool push(const char *const s, const uint8_t len) { return(push((const uint8_t *)s, len)); }
+
+        // Take the oldest byte into c; returns false if empty.
+        // Consumer side only; safe to call from an ISR.
+        bool pop(uint8_t &c) { return(ring.pop(c)); }
+
+        // Write up to maxBytes queued bytes to p without blocking,
+        // eg maxBytes from HardwareSerial availableForWrite();
+        // returns the number written.
+        // Consumer side only.
+        template<class Print_t>
+        uint8_t pumpTo(Print_t &p, int maxBytes)
+            {
+            uint8_t n = 0;
+            uint8_t c;
+            while((maxBytes-- > 0) && pop(c)) { p.write(c); ++n; }
+            return(n);
+            }
+
+#if defined(__AVR_ATmega328P__)
+        // Feed USART0 while its data register is empty, from its UDRE ISR
+        // (where HardwareSerial TX is not linked in),
+        // disabling that interrupt once drained; call kickUSART0() after pushing.
+        void pumpUSART0()
+            {
+            uint8_t c;
+            while(UCSR0A & _BV(UDRE0))
+                {
+                if(!pop(c)) { UCSR0B &= uint8_t(~_BV(UDRIE0)); return; }
+                UDR0 = c;
+                }
+            }
+        // Enable the USART0 UDRE interrupt so that pumpUSART0() runs.
+        static void kickUSART0() { UCSR0B |= _BV(UDRIE0); }
+#endif
+    };
+
+
+}
+#endif
@@ -31,6 +31,7 @@ Author(s) / Copyright (s): Damon Hart-Davis 2013--2015
 
 #ifdef EFR32FG1P133F256GM48
 #include "em_cmu.h"
+#include "em_emu.h"
 #include "em_gpio.h"
 #include "em_usart.h"
 #endif  // EFR32FG1P133F256GM48
@@ -45,6 +46,8 @@ static const uint16_t V0p2_DEFAULT_UART_BAUD = 4800;
 // Flush to use for all serialPrintXXX() and V0P2BASE_DEBUG_PRINTXXX routines.
 #ifdef ARDUINO
 #define _flush() flushSerialSCTSensitive() // FIXME
+#elif defined(EFR32FG1P133F256GM48)
+#define _flush() Serial.flush()
 #else
 #define _flush() fflush(stdout)
 #endif
@@ -75,21 +78,72 @@ void PrintEFR32::setup(const uint32_t baud)
     /* To avoid false start, configure TX pin as initial high */
     GPIO_PinModeSet((GPIO_Port_TypeDef)AF_USART0_TX_PORT(outputNo), AF_USART0_TX_PIN(outputNo), gpioModePushPull, 1);
     GPIO_PinModeSet((GPIO_Port_TypeDef)AF_USART0_RX_PORT(outputNo), AF_USART0_RX_PIN(outputNo), gpioModeInput, 0);
+
+    // Share the LDMA if already set up, eg by the radio SPI transport.
+    if (0 == (CMU->HFBUSCLKEN0 & CMU_HFBUSCLKEN0_LDMA))
+    {
+        CMU_ClockEnable(cmuClock_LDMA, true);
+        LDMA_Init_t ldmaInit = LDMA_INIT_DEFAULT;
+        LDMA_Init(&ldmaInit);
+    }
     isSetup = true;
 }
+void PrintEFR32::kick()
+{
+    if ((0 != dmaLen) || (head == tail)) return;
+    // Send up to the end of the buffer; any wrapped part follows.
+    const uint8_t t = tail;
+    const uint8_t n = (head > t) ? uint8_t(head - t) : uint8_t(TX_BUF_SIZE - t);
+    const LDMA_TransferCfg_t cfg = LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_USART0_TXBL);
+    const LDMA_Descriptor_t d = LDMA_DESCRIPTOR_SINGLE_M2P_BYTE(buf + t, &dev->TXDATA, n);
+    desc = d;
+    dmaLen = n;
+    LDMA_StartTransfer(LDMA_TX_CH, &cfg, &desc);
+}
+void PrintEFR32::onLDMAIRQ()
+{
+    constexpr uint32_t mask = 1UL << LDMA_TX_CH;
+    if (0 == (LDMA_IntGet() & mask)) return;
+    LDMA_IntClear(mask);
+    Serial.tail = uint8_t((Serial.tail + Serial.dmaLen) & (TX_BUF_SIZE - 1));
+    Serial.dmaLen = 0;
+    Serial.kick();
+}
 size_t PrintEFR32::write(uint8_t c)
 {
     // Prevent blocking if UART has not been set up.
     if (!isSetup) return true;
-    USART_Tx(dev, c);
-    return false;
+    const uint8_t next = uint8_t((head + 1) & (TX_BUF_SIZE - 1));
+    // If full, idle until the DMA frees some space.
+    // Interrupts are masked around the test so that the wake-up cannot be missed,
+    // as a pending interrupt still ends the WFI.
+    __disable_irq();
+    while (next == tail) { kick(); EMU_EnterEM1(); __enable_irq(); __disable_irq(); }
+    buf[head] = c;
+    head = next;
+    kick();
+    __enable_irq();
+    return 1;
 }
 size_t PrintEFR32::write(const uint8_t *buf, size_t len)
 {
     if ((nullptr == buf) || (!isSetup)) return -1;
-    for (auto *ip = buf; ip != buf+len; ++ip) USART_Tx(dev, *ip);
+    for (auto *ip = buf; ip != buf+len; ++ip) write(*ip);
     return len;
 }
+bool PrintEFR32::isTXPending() const
+{
+    return ((head != tail) || (0 != dmaLen) || (0 == (dev->STATUS & USART_STATUS_TXC)));
+}
+void PrintEFR32::flush()
+{
+    if (!isSetup) return;
+    __disable_irq();
+    while ((head != tail) || (0 != dmaLen)) { EMU_EnterEM1(); __enable_irq(); __disable_irq(); }
+    __enable_irq();
+    // Let the last byte leave the shift register.
+    while (0 == (dev->STATUS & USART_STATUS_TXC)) { }
+}
 PrintEFR32 Serial;
 #endif // #ifdef EFR32FG1P133F256GM48
 
@@ -278,6 +332,124 @@ void serialWriteAndFlush(const char* buf, const uint8_t len)
   }
 
 
+// True while non-flushing output may be queued.
+static bool _outputPending;
+#ifdef ARDUINO
+// True if the serial was powered up for non-flushing output, so should be powered down once drained.
+static bool _neededWakingForOutput;
+#endif
+
+// Prepare for non-flushing output, powering up the serial if need be.
+static void _startOutput()
+  {
+#ifdef ARDUINO
+  if(powerUpSerialIfDisabled<V0p2_DEFAULT_UART_BAUD>()) { _neededWakingForOutput = true; }
+#endif
+  _outputPending = true;
+  }
+
+void serialPrint(__FlashStringHelper const * const text)
+  {
+  _startOutput();
+#ifdef ARDUINO
+  Serial.print(text);
+#else
+  fputs((const char *)text, stdout);
+#endif
+  }
+
+void serialPrint(const char * const text)
+  {
+  _startOutput();
+#ifdef ARDUINO
+  Serial.print(text);
+#else
+  fputs(text, stdout);
+#endif
+  }
+
+void serialPrint(const char c)
+  {
+  _startOutput();
+#ifdef ARDUINO
+  Serial.print(c);
+#else
+  putchar(c);
+#endif
+  }
+
+#ifdef ARDUINO
+void serialPrint(const int i, const uint8_t fmt)
+  {
+  _startOutput();
+  Serial.print(i, fmt);
+  }
+#else
+void serialPrint(const int i, const uint8_t /*fmt*/)
+  {
+  _startOutput();
+  printf("%d", i); // FIXME: ignores fmt
+  }
+#endif
+
+void serialPrintln(__FlashStringHelper const * const line)
+  {
+  _startOutput();
+#ifdef ARDUINO
+  Serial.println(line);
+#else
+  puts((const char *)line);
+#endif
+  }
+
+void serialPrintln(const char * const line)
+  {
+  _startOutput();
+#ifdef ARDUINO
+  Serial.println(line);
+#else
+  puts(line);
+#endif
+  }
+
+void serialPrintln()
+  {
+  _startOutput();
+#ifdef ARDUINO
+  Serial.println();
+#else
+  putchar('\n');
+#endif
+  }
+
+void serialWrite(const char * const buf, const uint8_t len)
+  {
+  _startOutput();
+#ifdef ARDUINO
+  Serial.write(buf, len);
+#else
+  fwrite(buf, 1, len, stdout);
+#endif
+  }
+
+bool serialOutputPending() { return(_outputPending); }
+
+void flushBeforeSleep()
+  {
+  if(!_outputPending) { return; }
+#ifdef ARDUINO
+  // Polls rather than idling, as this may be called from within the sleep routines.
+  flushSerialProductive();
+  if(_neededWakingForOutput) { powerDownSerial(); _neededWakingForOutput = false; }
+#elif defined(EFR32FG1P133F256GM48)
+  Serial.flush();
+#else
+  _flush();
+#endif
+  _outputPending = false;
+  }
+
+
 #ifdef V0P2BASE_DEBUG // Don't emit debug-support code unless in V0P2BASE_DEBUG.
 
 // Print timestamp with no newline in format: MinutesSinceMidnight:Seconds:SubCycleTime
@@ -42,6 +42,13 @@ Author(s) / Copyright (s): Damon Hart-Davis 2013--2016
 
 #include "OTV0P2BASE_Serial_LineType_InitChar.h"
 
+#ifdef EFR32FG1P133F256GM48
+extern "C" {
+#include "em_device.h"
+#include "em_ldma.h"
+}
+#endif // EFR32FG1P133F256GM48
+
 namespace OTV0P2BASE
 {
 
@@ -96,10 +103,21 @@ namespace OTV0P2BASE
 
 #ifdef EFR32FG1P133F256GM48
 // Implementation for EFR32
-// Implementation of Print that simply throws output away.
-// Usable in all environments including Arduino, eg also for unit tests.
+// Output is queued in a ring buffer and sent by an LDMA channel,
+// so write() returns at once unless the buffer is full,
+// and the CPU may idle (EM1) while the bytes go out.
+// flush() waits for all queued output to leave the USART,
+// as flushBeforeSleep() does before anything that stops its clock (EM2+).
+// onLDMAIRQ() must be called from LDMA_IRQHandler;
+// the RFM23B SPI transport's default handler does so.
 class PrintEFR32 final : public Print
 {
+public:
+    // TX ring buffer size; a power of two.
+    static constexpr uint8_t TX_BUF_SIZE = 128;
+    // LDMA channel used for TX, kept clear of the SPI transport's usual channels.
+    static constexpr uint8_t LDMA_TX_CH = 7;
+
 private:
     // Flag to prevent UART_Tx locking up when USART not set up first..
     bool isSetup = false;
@@ -110,12 +128,34 @@ private:
 
     // What pins to multiplex the USART to.
     static constexpr uint32_t outputNo = 0;
+
+    // Ring buffer; head is written by write(), tail advanced as DMA completes.
+    uint8_t buf[TX_BUF_SIZE];
+    volatile uint8_t head = 0;
+    volatile uint8_t tail = 0;
+    // Length of the DMA transfer in progress; 0 if none.
+    volatile uint8_t dmaLen = 0;
+    // Descriptor must stay valid while the LDMA runs.
+    LDMA_Descriptor_t desc;
+
+    // Start DMA of the next contiguous run of queued bytes, if idle.
+    // Call with interrupts masked.
+    void kick();
+
 public:
     // Start up serial dev
     void setup(const uint32_t baud);
 
     virtual size_t write(uint8_t c) override;
     virtual size_t write(const uint8_t *buf, size_t len) override;
+
+    // True if any output is queued or still being sent.
+    bool isTXPending() const;
+    // Wait (in EM1) until all queued output has been sent.
+    void flush();
+
+    // Service the TX DMA channel; call from LDMA_IRQHandler.
+    static void onLDMAIRQ();
 };
 extern PrintEFR32 Serial;
 #endif
@@ -162,6 +202,29 @@ void serialPrintlnAndFlush();
 void serialWriteAndFlush(char const *buf, uint8_t len);
 
 
+// Non-flushing output for hot paths, eg forwarding RXed frames on a hub.
+// Text is queued in the UART TX ring buffer (HardwareSerial's, or stdout's buffer when not embedded)
+// and these return as soon as it is queued, only blocking if that buffer is full.
+// This enables the serial if required, and leaves it to flushBeforeSleep() to drain it
+// and shut it down again, so flushBeforeSleep() must be called before anything that stops the UART.
+void serialPrint(__FlashStringHelper const *text);
+void serialPrint(char const *text);
+void serialPrint(char c);
+void serialPrint(int i, uint8_t fmt = 10); // Arduino print.h: #define DEC 10
+void serialPrintln(__FlashStringHelper const *line);
+void serialPrintln(char const *line);
+void serialPrintln();
+void serialWrite(char const *buf, uint8_t len);
+
+// True if output from the non-flushing routines above may still be queued.
+bool serialOutputPending();
+
+// Wait for any queued non-flushing output to be sent, then power the serial down if it was woken for it.
+// Cheap if nothing is pending.
+// Called from the sleep routines that stop the UART clock, eg sleepUntilInt() and nap().
+void flushBeforeSleep();
+
+
 #if defined(ARDUINO)
 // Prints a single space to Serial (which must be up and running).
 // Simple utility function helps reduce code size.
@@ -28,6 +28,7 @@ Author(s) / Copyright (s): Damon Hart-Davis 2014--2016
 #include "OTV0P2BASE_SimpleBinaryStats.h"
 
 #include "OTV0P2BASE_CRC.h"
+#include "OTV0P2BASE_FastFormat.h"
 #include "OTV0P2BASE_Security.h"
 
 
@@ -127,27 +128,33 @@ void outputCoreStats(Print *p, bool /*secure*/, const FullStatsMessageCore_t *st
     // Dump (remote) stats field '@<hexnodeID>;TnnCh[P;]'
     // where the T field shows temperature in C with a hex digit after the binary point indicated by C
     // and the optional P field indicates low power.
-    p->print((char) OTV0P2BASE::SERLINE_START_CHAR_RSTATS);
-    p->print((((uint16_t)stats->id0) << 8) | stats->id1, 16); // HEX
+    // Build the line in one buffer for a single print,
+    // eg "@FFFF;T-2048CF;P;L255;O3" plus CRLF.
+    char line[40];
+    char *l = line;
+    *l++ = (char) OTV0P2BASE::SERLINE_START_CHAR_RSTATS;
+    l = formatHex16(l, (((uint16_t)stats->id0) << 8) | stats->id1);
     if(stats->containsTempAndPower)
       {
-      p->print(F(";T"));
-      p->print(stats->tempAndPower.tempC16 >> 4, 10); // DEC
-      p->print('C');
-      p->print(stats->tempAndPower.tempC16 & 0xf, 16); // HEX
-      if(stats->tempAndPower.powerLow) { p->print(F(";P")); } // Insert power-low field if needed.
+      *l++ = ';'; *l++ = 'T';
+      l = formatI16(l, int16_t(stats->tempAndPower.tempC16 >> 4));
+      *l++ = 'C';
+      *l++ = "0123456789ABCDEF"[stats->tempAndPower.tempC16 & 0xf];
+      if(stats->tempAndPower.powerLow) { *l++ = ';'; *l++ = 'P'; } // Insert power-low field if needed.
       }
     if(stats->containsAmbL)
       {
-      p->print(F(";L"));
-      p->print(stats->ambL);
+      *l++ = ';'; *l++ = 'L';
+      l = formatU8(l, stats->ambL);
       }
     if(0 != stats->occ)
       {
-      p->print(F(";O"));
-      p->print(stats->occ);
+      *l++ = ';'; *l++ = 'O';
+      l = formatU8(l, stats->occ);
       }
-    p->println();
+    *l++ = '\r'; *l++ = '\n';
+    *l = '\0';
+    p->print(line);
     }
   }
 //#endif // ENABLE_FS20_ENCODING_SUPPORT
@@ -263,7 +270,7 @@ uint8_t *encodeFullStatsMessageCore(uint8_t * const buf, const uint8_t buflen, c
   // Finish off message by computing and appending the CRC and then terminating 0xff (and return pointer to 0xff).
   // Assumes that b now points just beyond the end of the payload.
   uint8_t crc = MESSAGING_FULL_STATS_CRC_INIT; // Initialisation.
-  for(const uint8_t *p = buf; p < b; ) { crc = OTV0P2BASE::crc7_5B_update(crc, *p++); }
+  crc = OTV0P2BASE::crc7_5B_buf(crc, buf, (uint8_t)(b - buf));
   *b++ = crc;
   *b = 0xff;
 #if 0 && defined(DEBUG)
@@ -361,7 +368,7 @@ const uint8_t *decodeFullStatsMessageCore(const uint8_t * const buf, const uint8
   // Assumes that b now points just beyond the end of the payload.
   if(b - buf >= buflen) { return(NULL); } // Fail if next byte not available.
   uint8_t crc = MESSAGING_FULL_STATS_CRC_INIT; // Initialisation.
-  for(const uint8_t *p = buf; p < b; ) { crc = OTV0P2BASE::crc7_5B_update(crc, *p++); }
+  crc = OTV0P2BASE::crc7_5B_buf(crc, buf, (uint8_t)(b - buf));
 //DEBUG_SERIAL_PRINTLN_FLASHSTRING(" chk CRC");
   if(crc != *b++) { return(NULL); } // Bad CRC.
 
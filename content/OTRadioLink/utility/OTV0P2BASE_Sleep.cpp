@@ -28,6 +28,7 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015--2016
 #endif
 
 #include "OTV0P2BASE_Sleep.h"
+#include "OTV0P2BASE_Serial_IO.h"
 
 
 namespace OTV0P2BASE
@@ -56,6 +57,9 @@ do { \
 // Sleep with BOD disabled in power-save mode; will wake on any interrupt.
 void sleepPwrSaveWithBODDisabled()
   {
+  // The UART clock stops, so let any queued output go first.
+  flushBeforeSleep();
+  OT_CPU_STATE(CPUPowerState::POWER_SAVE);
   set_sleep_mode(SLEEP_MODE_PWR_SAVE); // Stop all but timer 2 and watchdog when sleeping.
   cli();
   sleep_enable();
@@ -64,6 +68,7 @@ void sleepPwrSaveWithBODDisabled()
   sleep_cpu();
   sleep_disable();
   sei();
+  OT_CPU_STATE(CPUPowerState::ACTIVE);
   }
 
 
@@ -99,7 +104,9 @@ bool _idleCPU(const int_fast8_t watchdogSleep, const bool allowPrematureWakeup)
   for( ; ; )
     {
     set_sleep_mode(SLEEP_MODE_IDLE); // Leave everything running but the CPU...
+    OT_CPU_STATE(CPUPowerState::IDLE);
     sleep_mode();
+    OT_CPU_STATE(CPUPowerState::ACTIVE);
     const bool fired = (0 != _watchdogFired);
     if(fired || allowPrematureWakeup)
       {
@@ -315,10 +322,68 @@ uint_fast8_t clockJitterEntropyByte()
   }
 #else
 // Stubs for integration tests
-void nap(const int_fast8_t) {}
-bool nap(const int_fast8_t, bool) { return(false); }
+void nap(const int_fast8_t) { flushBeforeSleep(); }
+bool nap(const int_fast8_t, bool) { flushBeforeSleep(); return(false); }
 #endif // ARDUINO_ARCH_AVR
 
+#if defined(EFR32FG1P133F256GM48) && defined(V0P2BASE_RTCC_SUBCYCLE)
+// Set up the RTCC from the LFXO as the sub-cycle clock; see OTV0P2BASE_Sleep.h.
+bool setupRTCCSubCycle()
+  {
+  CMU_OscillatorEnable(cmuOsc_LFXO, true, true);
+  CMU_ClockSelectSet(cmuClock_LFE, cmuSelect_LFXO);
+  CMU_ClockEnable(cmuClock_RTCC, true);
+  RTCC_Init_TypeDef init = RTCC_INIT_DEFAULT;
+  init.enable = false;
+  init.presc = rtccCntPresc_256; // 128Hz, ie 256 ticks per 2s cycle.
+  init.cntWrapOnCCV1 = true;
+  RTCC_Init(&init);
+  RTCC_CCChConf_TypeDef compare = RTCC_CH_INIT_COMPARE_DEFAULT;
+  RTCC_ChannelInit(RTCC_CC_CYCLE, &compare);
+  RTCC_ChannelCCVSet(RTCC_CC_CYCLE, 0);
+  RTCC_ChannelInit(RTCC_CC_WRAP, &compare);
+  RTCC_ChannelCCVSet(RTCC_CC_WRAP, GSCT_MAX);
+  RTCC_ChannelInit(RTCC_CC_WAKE, &compare);
+  RTCC_IntClear(_RTCC_IF_MASK);
+  RTCC_IntEnable(RTCC_IEN_CC0);
+  NVIC_ClearPendingIRQ(RTCC_IRQn);
+  NVIC_EnableIRQ(RTCC_IRQn);
+  RTCC_Enable(true);
+  return(false);
+  }
+
+// Sleep in EM2; will wake on any enabled interrupt, eg RTCC, radio IRQ or GPIO edge.
+// The name is kept for compatibility with the AVR implementation.
+void sleepPwrSaveWithBODDisabled()
+  {
+  // The USART clock stops, so let any queued output go first.
+  flushBeforeSleep();
+  OT_CPU_STATE(CPUPowerState::POWER_SAVE);
+  // Restores the HF clocks on wake.
+  EMU_EnterEM2(true);
+  OT_CPU_STATE(CPUPowerState::ACTIVE);
+  }
+
+// Sleep in EM2 until specified target subcycle time, woken by an RTCC match.
+// Returns true if OK, false if specified time already passed or significantly missed (eg by more than one tick).
+// Other interrupts (eg radio) wake the CPU briefly, after which it sleeps again.
+// This is NOT intended to be used to sleep over the end of a minor cycle.
+bool sleepUntilSubCycleTime(const uint8_t sleepUntil)
+  {
+  const uint8_t start = uint8_t(getSubCycleTime());
+  if(start == sleepUntil) { return(true); }
+  if(start > sleepUntil) { return(false); }
+  RTCC_ChannelCCVSet(RTCC_CC_WAKE, sleepUntil);
+  RTCC_IntClear(RTCC_IF_CC2);
+  RTCC_IntEnable(RTCC_IEN_CC2);
+  uint8_t now;
+  // Stop if the cycle rolls under an overlong interrupt.
+  while(((now = uint8_t(getSubCycleTime())) < sleepUntil) && (now >= start)) { sleepPwrSaveWithBODDisabled(); }
+  RTCC_IntDisable(RTCC_IEN_CC2);
+  return((now >= sleepUntil) && (now - sleepUntil <= 1));
+  }
+#endif
+
 #if defined(EFR32FG1P133F256GM48) && defined(V0P2BASE_SYSTICK_EMULATED_SUBCYCLE)
     // /**
     //  * @brief	Calculate the number of ticks between interrupts clock should run for.
@@ -42,6 +42,8 @@ Author(s) / Copyright (s): Damon Hart-Davis 2015--2018
 extern "C" {
 #include "em_device.h"
 #include "em_cmu.h"
+#include "em_emu.h"
+#include "em_rtcc.h"
 }
 #endif  // defined(EFR32FG1P133GM48)
 
@@ -51,9 +53,11 @@ extern "C" {
 
 #include "OTV0P2BASE_PowerManagement.h"
 #include "OTV0P2BASE_RTC.h"
+#include "OTV0P2BASE_WakeDeadlines.h"
+#include "OTV0P2BASE_WakeProfile.h"
+#include "OTV0P2BASE_Trace.h"
 
-// IF DEFINED: Enable emulated subcycle
-#define V0P2BASE_SYSTICK_EMULATED_SUBCYCLE
+// EFR32 sub-cycle clock source (V0P2BASE_RTCC_SUBCYCLE etc) is selected in OTV0P2BASE_RTC.h.
 
 namespace OTV0P2BASE
 {
@@ -124,9 +128,19 @@ constexpr uint32_t F_CPU = 19000000;  // XXX Where should this go?
     #define OTV0P2BASE_delay_us(us) delayMicroseconds(us) // Assume that the built-in routine will behave itself for faster CPU clocks.
     #endif // OTV0P2BASE_busy_spin_delay
 
+    // Current CPU clock shift below full speed set by the clock policy (see OTV0P2BASE_CPUClockPolicy.h); 0 at full speed.
+    // NOT FOR DIRECT ACCESS OUTSIDE THE CLOCK POLICY ROUTINES.
+    extern volatile uint8_t _cpuClockShift;
+
     // Delay (busy wait) the specified number of milliseconds in the range [0,255].
+    // Scaled for any reduced CPU clock.
     // This may be extended by interrupts, etc, so must not be regarded as very precise.
-    inline void delay_ms(uint8_t ms) { while(ms-- > 0) { OTV0P2BASE_delay_us(996); /* Allow for some loop overhead. */ } }
+    inline void delay_ms(uint8_t ms)
+        {
+        const uint8_t shift = _cpuClockShift;
+        if(0 == shift) { while(ms-- > 0) { OTV0P2BASE_delay_us(996); /* Allow for some loop overhead. */ } }
+        else { const uint16_t us = uint16_t(996U >> shift); while(ms-- > 0) { OTV0P2BASE_delay_us(us); } }
+        }
 #elif defined(__arm__)
 
     // Cortex M4 instruction set manual states that NOP is not necessarily
@@ -305,14 +319,15 @@ bool nap(int_fast8_t watchdogSleep, bool allowPrematureWakeup);
     }
 
     /**
-     * @brief   Increment SubCycle time when SysTick handler called.
+     * @brief   Increment SubCycle time (and the monotonic cycle count at each roll)
+     *          when SysTick handler called.
      * 
      * Should be placed in SysTick_Handler()
      */
     inline void tickSubCycle(void)
     {
         subCycleTime += 1;
-        subCycleTime = (256U == subCycleTime) ? 0 : subCycleTime;
+        if(256U == subCycleTime) { subCycleTime = 0; ++_monotonicCycles; }
     }
 
     //// Get fraction of the way through the basic cycle in range [0,255].
@@ -320,6 +335,45 @@ bool nap(int_fast8_t watchdogSleep, bool allowPrematureWakeup);
     //// or to avoid overrunning a cycle with tasks of variable timing.
     inline uint_fast8_t getSubCycleTime() { return (subCycleTime); }
     inline uint_fast8_t _getSubCycleTime() { return (subCycleTime); }
+#elif defined(EFR32FG1P133F256GM48) && defined(V0P2BASE_RTCC_SUBCYCLE)
+    // The RTCC counts LFXO/256 (128Hz) and wraps at 255 on CC channel 1,
+    // so its counter is the sub-cycle time itself,
+    // and it runs on through EM2 (the radio IRQ and other GPIO edges also wake from EM2).
+    //   * CC channel 0 (match at 0) marks each cycle roll
+    //   * CC channel 2 is the timed wake for sleepUntilSubCycleTime()
+    static constexpr uint8_t RTCC_CC_CYCLE = 0;
+    static constexpr uint8_t RTCC_CC_WRAP = 1;
+    static constexpr uint8_t RTCC_CC_WAKE = 2;
+
+    /**
+     * @brief   Sets up the RTCC (and LFXO) as the sub-cycle clock
+     *          and enables its interrupt.
+     * @retval  False on success, else true, as for setupEmulated2sSubCycle().
+     */
+    bool setupRTCCSubCycle();
+
+    /**
+     * @brief   Count cycle rolls and clear wake matches.
+     *
+     * Should be placed in RTCC_IRQHandler(),
+     * which should also run any once-per-cycle RTC work,
+     * ie where tickSubCycle() rolled over with SysTick.
+     * @retval  True if the cycle rolled.
+     */
+    inline bool tickSubCycleRTCC()
+    {
+        const uint32_t flags = RTCC_IntGetEnabled();
+        RTCC_IntClear(flags);
+        if(0 == (flags & RTCC_IF_CC0)) { return(false); }
+        ++_monotonicCycles;
+        return(true);
+    }
+
+    //// Get fraction of the way through the basic cycle in range [0,255].
+    //// This can be used for precision timing during the cycle,
+    //// or to avoid overrunning a cycle with tasks of variable timing.
+    inline uint_fast8_t getSubCycleTime() { return (uint_fast8_t(RTCC_CounterGet())); }
+    inline uint_fast8_t _getSubCycleTime() { return (uint_fast8_t(RTCC_CounterGet())); }
 #endif  // ARDUINO_ARCH_AVR
 #if defined(ARDUINO_ARCH_AVR) || defined(__arm__)
     //// Maximum value for OTV0P2BASE::getSubCycleTime(); full cycle length is this + 1.
@@ -366,7 +420,7 @@ bool nap(int_fast8_t watchdogSleep, bool allowPrematureWakeup);
 #endif // ARDUINO_ARCH_AVR
 
 
-#ifdef ARDUINO_ARCH_AVR   // TODO
+#if defined(ARDUINO_ARCH_AVR) || (defined(EFR32FG1P133F256GM48) && defined(V0P2BASE_RTCC_SUBCYCLE))
     // Sleep in reasonably low-power mode until specified target subcycle time.
     // Returns true if OK, false if specified time already passed or significantly missed (eg by more than one tick).
     // May use a combination of techniques to hit the required time.
@@ -374,7 +428,7 @@ bool nap(int_fast8_t watchdogSleep, bool allowPrematureWakeup);
     // Using this to sleep less then 2 ticks may prove unreliable as the RTC rolls on underneath...
     // This is NOT intended to be used to sleep over the end of a minor cycle.
     bool sleepUntilSubCycleTime(uint8_t sleepUntil);
-#endif // ARDUINO_ARCH_AVR
+#endif // defined(ARDUINO_ARCH_AVR) || ...
 
 
 // Forced MCU reset/restart as near full cold-reset as possible.
@@ -423,6 +477,8 @@ template<bool (*preSleepFn_ptr)()=nullptr>
 uint_fast8_t sleepUntilNewCycle(const uint_fast8_t oldTimeLSD,
                                 const bool preventLongSleep = false)
 {
+    OTV0P2BASE_WAKE_PROFILE_MARK(WakeProfileSubsystem::SLEEP_LOOP);
+    OT_TRACE(TraceId::SLEEP_ENTER, oldTimeLSD);
     // Ensure that serial I/O is off while sleeping.
     powerDownSerial();
     // Power down most stuff (except radio for hub RX).
@@ -448,6 +504,54 @@ uint_fast8_t sleepUntilNewCycle(const uint_fast8_t oldTimeLSD,
             OTV0P2BASE::nap(WDTO_15MS, true);
         }
     }
+    OT_TRACE(TraceId::SLEEP_EXIT, newTLSD);
+    return (newTLSD);
+}
+
+/**
+ * @brief   - Tickless version of sleepUntilNewCycle():
+ *          sleeps in one stretch to the earliest registered deadline
+ *          in this cycle, if any, else until interrupt,
+ *          rather than waking every few ms to poll.
+ *          - Calls preSleepFn_ptr while it returns true before each sleep,
+ *          and after each wake, eg to service whatever was due.
+ * @param   deadlines: Wake deadlines, eg a WakeDeadlines<>.
+ *          Deadlines are one-shot: each is cleared once the CPU has woken
+ *          for it and preSleepFn_ptr has run, so tasks re-register as needed.
+ *          newCycle() is called on it as the cycle rolls.
+ * @retval  current time in seconds, in range [0,59]
+ * @note    Radio listen windows must be registered as deadlines
+ *          where there is no hardware RX interrupt to wake the CPU.
+ */
+template<bool (*preSleepFn_ptr)()=nullptr, class deadlines_t>
+uint_fast8_t sleepUntilNewCycleOrDeadline(const uint_fast8_t oldTimeLSD,
+                                          deadlines_t &deadlines)
+{
+    OTV0P2BASE_WAKE_PROFILE_MARK(WakeProfileSubsystem::SLEEP_LOOP);
+    OT_TRACE(TraceId::SLEEP_ENTER, oldTimeLSD);
+    // Ensure that serial I/O is off while sleeping.
+    powerDownSerial();
+    // Power down most stuff (except radio for hub RX).
+    minimisePowerWithoutSleep();
+    uint_fast8_t newTLSD;
+    while(oldTimeLSD == (newTLSD = getSecondsLT())) {
+        if(nullptr != preSleepFn_ptr) {
+            if(preSleepFn_ptr()) { continue; }
+        }
+        const uint8_t now = getSubCycleTime();
+        deadlines.clearDue(now);
+        const uint16_t next = deadlines.next();
+        // Leave a couple of ticks clear of the cycle end
+        // where sleepUntilSubCycleTime() could overrun.
+        if(next < GSCT_MAX - 2) {
+            sleepUntilSubCycleTime(uint8_t(next));
+        } else {
+            // Nothing due this cycle, so sleep until the cycle rolls or another interrupt.
+            sleepUntilInt();
+        }
+    }
+    deadlines.newCycle();
+    OT_TRACE(TraceId::SLEEP_EXIT, newTLSD);
     return (newTLSD);
 }
 
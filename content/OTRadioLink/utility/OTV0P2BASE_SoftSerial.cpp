@@ -26,6 +26,8 @@ Author(s) / Copyright (s): Deniz Erbilgin 2015
 #ifdef OTSoftSerial_DEFINED
 
 #include "OTV0P2BASE_SoftSerial.h"
+#include "OTV0P2BASE_CPUClockPolicy.h"
+#include "OTV0P2BASE_ISRLatency.h"
 
 #include <stdlib.h>
 
@@ -80,11 +82,13 @@ void OTSoftSerial::end()
  */
 uint8_t OTSoftSerial::read()
 {
+    RAII_CPUFullSpeed fullSpeed; // Bit timing assumes full CPU speed.
     uint8_t val = 0;
     const uint8_t readFullDelay = fullDelay-readTuning;
 
     ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
     {
+        OTV0P2BASE_IRQ_MASKED_SECTION(::OTV0P2BASE::ISRLatencyPath::SOFTSERIAL_RX);
         uint16_t timer = timeOut;
         // wait for line to go low
         while (fastDigitalRead(rxPin)) {
@@ -118,12 +122,14 @@ uint8_t OTSoftSerial::read()
  */
 uint8_t OTSoftSerial::read(uint8_t *buf, uint8_t _len)
 {
+    RAII_CPUFullSpeed fullSpeed; // Bit timing assumes full CPU speed.
     uint8_t len = _len;
     uint8_t count = 0;
     const uint8_t readFullDelay = fullDelay-readTuning;
 
     ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
     {
+        OTV0P2BASE_IRQ_MASKED_SECTION(::OTV0P2BASE::ISRLatencyPath::SOFTSERIAL_RX);
         while (count < len) {
             // wait for line to go low
             uint16_t timer = timeOut;
@@ -163,8 +169,10 @@ uint8_t OTSoftSerial::read(uint8_t *buf, uint8_t _len)
  */
 void OTSoftSerial::print(char _c)
 {
+    RAII_CPUFullSpeed fullSpeed; // Bit timing assumes full CPU speed.
     ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
     {
+        OTV0P2BASE_IRQ_MASKED_SECTION(::OTV0P2BASE::ISRLatencyPath::SOFTSERIAL_TX);
         const uint8_t writeFullDelay = fullDelay-writeTuning;
         uint8_t mask = 0x01;
         uint8_t c = _c;
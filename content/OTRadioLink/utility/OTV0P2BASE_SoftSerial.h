@@ -63,6 +63,11 @@ public:
     void printNum(int8_t number); // FIXME can this be made better?
     void sendBreak();
 
+    // True if baud b can be timed at F_CPU:
+    // the half-bit delay must exceed the read tuning and the full-bit delay fit a byte.
+    static constexpr bool isBaudSupported(uint16_t b)
+        { return(((((F_CPU/4) / b) / 2) > readTuning) && (((F_CPU/4) / b) <= 255)); }
+
 private:
     const uint8_t rxPin;
     const uint8_t txPin;
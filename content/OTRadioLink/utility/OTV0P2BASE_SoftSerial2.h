@@ -34,8 +34,11 @@ Author(s) / Copyright (s): Deniz Erbilgin 2016
 #include "Arduino.h"
 #endif
 
+#include "utility/OTV0P2BASE_CPUClockPolicy.h"
 #include "utility/OTV0P2BASE_FastDigitalIO.h"
+#include "utility/OTV0P2BASE_ISRLatency.h"
 #include "utility/OTV0P2BASE_Sleep.h"
+#include "utility/OTV0P2BASE_SoftSerialTxQueue.h"
 
 namespace OTV0P2BASE
 {
@@ -53,7 +56,7 @@ namespace OTV0P2BASE
  */
 #define OTSoftSerial2_DEFINED
 template <uint8_t rxPin, uint8_t txPin, uint32_t baud>
-class OTSoftSerial2 final : public Stream
+class OTSoftSerial2 : public Stream
 {
 protected:
     // All these are compile time calculations and are automatically substituted as part of program code.
@@ -89,8 +92,10 @@ public:
      */
     size_t write(uint8_t byte)
     {
+        RAII_CPUFullSpeed fullSpeed; // Bit timing assumes full CPU speed.
         ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
         {
+            OTV0P2BASE_IRQ_MASKED_SECTION(::OTV0P2BASE::ISRLatencyPath::SOFTSERIAL_TX);
             uint8_t mask = 0x01;
             uint8_t c = byte;
 
@@ -120,6 +125,7 @@ public:
      * @note    This routine blocks interrupts until it receives a byte or times out.
      */
     int read() {
+        RAII_CPUFullSpeed fullSpeed; // Bit timing assumes full CPU speed.
         // Blocking read:
         uint8_t val = 0;
         volatile uint16_t timer = timeOut;
@@ -132,6 +138,7 @@ public:
         // The bit that actually does the read.
         ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
         {
+            OTV0P2BASE_IRQ_MASKED_SECTION(::OTV0P2BASE::ISRLatencyPath::SOFTSERIAL_RX);
             // Wait for mid point of bit, ie 0.5 bit time,
             // to centre the following reads in bit times.
             _delay_x4cycles(halfDelay);
@@ -199,6 +206,136 @@ public:
 //     */
 //    int availableForWrite() { return 0; }
 };
+
+/**
+ * @class   OTSoftSerial2BufferedTX
+ * @brief   OTSoftSerial2 with queued, interrupt-driven transmit.
+ *          write() queues bytes and returns at once (blocking only while the queue is full);
+ *          Timer1 in CTC mode interrupts once per bit and the ISR sends the next level,
+ *          so interrupts are never blocked for a whole frame
+ *          and a long modem command no longer stalls the radio ISR.
+ *          Receive is as for OTSoftSerial2, and waits for TX to finish first.
+ * @param   rxPin: Receive pin for software UART.
+ * @param   txPin: Transmit pin for software UART.
+ * @param   baud: Speed of UART in baud.
+ * @param   txQueueSize: Bytes queued for TX; a power of two in [2,128].
+ * @note    Takes over Timer1 while sending, so cannot be used with OTSoftSerialTimerRX.
+ *          The application must forward the compare interrupt, eg:
+ *              ISR(TIMER1_COMPA_vect) { ser.handle_interrupt(); }
+ * @note    nap() stops Timer1 (and so would stretch bits),
+ *          so flush() idles the CPU where allowed, else spins.
+ */
+#define OTSoftSerial2BufferedTX_DEFINED
+template <uint8_t rxPin, uint8_t txPin, uint32_t baud, uint8_t txQueueSize = 16>
+class OTSoftSerial2BufferedTX final : public OTSoftSerial2<rxPin, txPin, baud>
+{
+    typedef OTSoftSerial2<rxPin, txPin, baud> base_t;
+    // Timer1 counts per bit, undivided.
+    static constexpr uint32_t bitTicks = F_CPU / baud;
+    static_assert((bitTicks >= 50) && (bitTicks <= 65536), "baud out of range for Timer1 TX at this F_CPU");
+
+    SoftSerialTxQueue<txQueueSize> tx;
+
+    // Start the bit timer if idle; the first interrupt sends the start bit.
+    void kick()
+    {
+        if(!tx.start()) { return; }
+        TCCR1A = 0;
+        TCCR1B = 0;
+        TCNT1 = 0;
+        OCR1A = uint16_t(bitTicks - 1);
+        TIFR1 = _BV(OCF1A);
+        TIMSK1 |= _BV(OCIE1A);
+        TCCR1B = _BV(WGM12) | _BV(CS10); // CTC, clk/1.
+    }
+
+public:
+    /**
+     * @brief   Initialises the pins; any queued TX is sent first.
+     * @param   speed: Not used. Kept for compatibility with Arduino libraries.
+     */
+    void begin(unsigned long, uint8_t) { flush(); base_t::begin(0, 0); }
+    void begin(unsigned long) { begin(0, 0); }
+
+    /**
+     * @brief   Sends any queued TX, then disables serial and releases pins.
+     */
+    void end() { flush(); base_t::end(); }
+
+    /**
+     * @brief   Queue a byte to send, waiting only if the queue is full.
+     * @param   byte: Byte to write.
+     * @retval  Number of bytes written.
+     */
+    virtual size_t write(uint8_t byte) override
+    {
+        while(!tx.put(byte)) { kick(); }
+        kick();
+        return 1;
+    }
+    using Print::write; // write(str) and write(buf, size) from Print
+
+    /**
+     * @brief   Blocking read as for OTSoftSerial2, after waiting for TX to finish.
+     * @retval  Next character in input buffer; -1 on timeout or error.
+     */
+    virtual int read() override { flush(); return(base_t::read()); }
+
+    /**
+     * @brief   Waits for all queued output to be sent.
+     */
+    virtual void flush() override
+    {
+        while(tx.isBusy())
+        {
+#ifndef OTV0P2BASE_IDLE_NOT_RECOMMENDED
+            ::OTV0P2BASE::_idleCPU(WDTO_15MS, true);
+#endif
+        }
+    }
+
+    /**
+     * @brief   Number of bytes that can be written without blocking.
+     */
+    int availableForWrite() { return(tx.space()); }
+
+    /**************************************************************************
+     * -------------------------- Non Standard ------------------------------ *
+     *************************************************************************/
+    /**
+     * @brief   Sends a break condition once queued output is sent.
+     */
+    void sendBreak() { flush(); base_t::sendBreak(); }
+
+    /**
+     * @brief   True while output is queued or being sent.
+     */
+    bool isTXBusy() const { return(tx.isBusy()); }
+
+    /**
+     * @brief   Set (or clear with NULL) a callback made from the ISR
+     *          when the last queued byte has been sent; keep it short.
+     *          Set only while not sending.
+     */
+    void setTXCompletionCallback(typename SoftSerialTxQueue<txQueueSize>::completion_fn_t fn, void *context = NULL)
+        { tx.setCompletionCallback(fn, context); }
+
+    /**
+     * @brief   Sends the next bit; call from ISR(TIMER1_COMPA_vect).
+     *          Stops Timer1 once all is sent.
+     */
+    void handle_interrupt()
+    {
+        const int8_t level = tx.nextLevelFromISR();
+        if(level < 0)
+        {
+            TIMSK1 &= ~_BV(OCIE1A);
+            TCCR1B = 0;
+            return;
+        }
+        fastDigitalWrite(txPin, level);
+    }
+};
 #endif // ARDUINO_ARCH_AVR
 
 
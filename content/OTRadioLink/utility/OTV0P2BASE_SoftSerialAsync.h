@@ -28,7 +28,9 @@ Author(s) / Copyright (s): Deniz Erbilgin 2016
 #include "Arduino.h"
 #include <Stream.h>
 #include "utility/OTV0P2BASE_FastDigitalIO.h"
+#include "utility/OTV0P2BASE_ISRLatency.h"
 #include "utility/OTV0P2BASE_Sleep.h"
+#include "utility/OTV0P2BASE_SoftSerialEdgeDecoder.h"
 
 namespace OTV0P2BASE
 {
@@ -102,6 +104,7 @@ public:
     {
         ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
         {
+            OTV0P2BASE_IRQ_MASKED_SECTION(::OTV0P2BASE::ISRLatencyPath::SOFTSERIAL_TX);
             uint8_t mask = 0x01;
             uint8_t c = byte;
 
@@ -294,6 +297,142 @@ public:
 };
 
 
+/**
+ * @class   OTSoftSerialTimerRX
+ * @brief   Software serial with timer-timestamped RX, for 9600 baud and above.
+ *          Extends Stream.h from the Arduino core libraries.
+ * @param   rxPin: Receive pin for software UART.
+ * @param   txPin: Transmit pin for software UART.
+ * @param   baud: Speed of UART in baud, eg 9600 at an F_CPU of 1 MHz;
+ *          19200 needs the ISR latency to stay under a bit time.
+ * @param   edgeQueueSize: RX edges held between calls to available(); see SoftSerialEdgeDecoder.
+ * @param   byteQueueSize: Decoded RX bytes held.
+ * @note    handle_interrupt() must be called from the pin change ISR for rxPin.
+ *          It only timestamps the edge from Timer1, unlike OTSoftSerialAsync
+ *          which samples the whole byte inside the ISR, so other interrupts
+ *          and back-to-back bytes do not corrupt reception.
+ *          Bytes are decoded in available()/read()/peek(), which should be
+ *          polled at least every edgeQueueSize/10 byte times while receiving.
+ * @note    Takes over Timer1, free-running undivided; not to be used by anything else meanwhile.
+ * @note    TX is bit-banged with interrupts blocked, as for OTSoftSerialAsync,
+ *          so it is half-duplex: RX edges are not captured during write().
+ */
+template <uint8_t rxPin, uint8_t txPin, uint16_t baud, uint8_t edgeQueueSize = 32, uint8_t byteQueueSize = 16>
+class OTSoftSerialTimerRX final : public Stream
+{
+protected:
+    // Timer1 ticks (CPU cycles) per bit.
+    static constexpr uint16_t bitTicks = F_CPU / baud;
+    static_assert((uint32_t(bitTicks) * 10) < 32768, "baud too low for Timer1 undivided");
+    static_assert(bitTicks >= 40, "baud too high for F_CPU");
+    // Number of times _softserial_delay needs to loop for 1 bit.
+    static constexpr uint16_t bitCycles = (F_CPU/4) / baud;
+    static constexpr uint8_t writeDelay = bitCycles - 3;
+
+    SoftSerialEdgeDecoder<edgeQueueSize, byteQueueSize> decoder;
+
+    // Timer1 now, read safely from outside an ISR.
+    static uint16_t timerNow() { uint16_t t; ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { t = TCNT1; } return(t); }
+
+    // Inline delay; as for OTSoftSerialAsync::_softserial_delay().
+    inline void _softserial_delay(uint8_t n) __attribute__((always_inline))
+    {
+        __asm__ volatile
+           (
+            "1: dec  %0" "\n\t"
+            "   breq 2f" "\n\t"
+            "2: brne 1b"
+            : "=r" (n)
+            : "0" (n)
+          );
+    }
+
+public:
+    OTSoftSerialTimerRX() : decoder(bitTicks) { }
+
+    /**
+     * @brief   Sets up pins and starts Timer1 free-running at F_CPU.
+     * @param   speed: Not used. Kept for compatibility with Arduino libraries.
+     */
+    void begin(const unsigned long, const uint8_t)
+    {
+        pinMode(rxPin, INPUT_PULLUP);
+        pinMode(txPin, OUTPUT);
+        fastDigitalWrite(txPin, HIGH);
+        TCCR1A = 0;
+        TCCR1B = _BV(CS10);
+        decoder.clear();
+    }
+    void begin(const unsigned long) { begin(0, 0); }
+
+    /**
+     * @brief   Disables serial, stops Timer1 and releases pins.
+     */
+    void end() { TCCR1B = 0; pinMode(txPin, INPUT_PULLUP); }
+
+    /**
+     * @brief   Write a byte to serial as a binary value.
+     * @retval  Number of bytes written (always 1).
+     */
+    size_t write(const uint8_t byte)
+    {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            OTV0P2BASE_IRQ_MASKED_SECTION(::OTV0P2BASE::ISRLatencyPath::SOFTSERIAL_TX);
+            uint8_t mask = 0x01;
+            fastDigitalWrite(txPin, LOW);
+            _softserial_delay(writeDelay);
+            while(mask != 0) {
+                fastDigitalWrite(txPin, (mask & byte) ? HIGH : LOW);
+                _softserial_delay(writeDelay);
+                mask = mask << 1;
+            }
+            fastDigitalWrite(txPin, HIGH);
+            _softserial_delay(writeDelay);
+        }
+        return 1;
+    }
+
+    int available() { return decoder.available(timerNow()); }
+    int peek() { decoder.available(timerNow()); return decoder.peek(); }
+    int read() { decoder.available(timerNow()); return decoder.read(); }
+    operator bool() { return true; }
+    using Print::write; // write(str) and write(buf, size) from Print
+
+    /**
+     * @brief   Sends a break condition (tx line held low for longer than the
+     *          time it takes to send a character.
+     */
+    void sendBreak()
+    {
+        fastDigitalWrite(txPin, LOW);
+        _delay_x4cycles(writeDelay * 16);
+        fastDigitalWrite(txPin, HIGH);
+    }
+
+    /**
+     * @brief   Discard any received input, eg before sending a command.
+     */
+    void clearRX() { ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { decoder.clear(); } }
+
+    /**
+     * @brief   Interrupt handler: timestamps the RX edge; fast and fixed-length.
+     */
+    inline void handle_interrupt() __attribute__((always_inline))
+        { decoder.captureEdgeFromISR(TCNT1, fastDigitalRead(rxPin)); }
+
+    /**
+     * @brief   RX error counts (saturating at 255), eg for diagnosing overruns.
+     */
+    uint8_t getRXEdgesDropped() const { return decoder.getEdgesDropped(); }
+    uint8_t getRXBytesDropped() const { return decoder.getBytesDropped(); }
+    uint8_t getRXFramingErrors() const { return decoder.getFramingErrors(); }
+
+    virtual void flush() {}
+    int availableForWrite() { return 0; }
+};
+
+
 }
 
 #endif // ARDUINO_ARCH_AVR
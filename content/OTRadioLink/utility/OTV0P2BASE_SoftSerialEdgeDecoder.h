@@ -0,0 +1,179 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Software UART receive by edge timestamps (8N1, idle high).
+
+ The RX pin-change ISR only records a timer timestamp and the new line level,
+ so it is short and fixed-length whatever the baud rate;
+ bytes are decoded from the edge times later, outside the ISR.
+ Trailing bits with no edge (eg a byte ending in 1s) are
+ completed once the timer shows the stop bit to have passed.
+
+ Portable; see OTSoftSerialTimerRX in OTV0P2BASE_SoftSerialAsync.h for the AVR binding.
+ */
+
+#ifndef OTV0P2BASE_SOFTSERIALEDGEDECODER_H
+#define OTV0P2BASE_SOFTSERIALEDGEDECODER_H
+
+#include <stdint.h>
+
+
+namespace OTV0P2BASE
+{
+
+
+// Decodes 8N1 serial from timestamped RX line edges.
+// Timestamps are from a free-running 16-bit timer of bitTicks per bit;
+// the ISR supplies them via captureEdgeFromISR(),
+// and the main loop calls available()/read() with the timer value now.
+// A whole frame (10 bits) must be well under 32768 ticks.
+// The lsb of each timestamp is used to hold the line level,
+// so bitTicks should be at least ~20 for accuracy.
+// Decoded bytes are held until read; if either queue fills, new data is dropped and counted.
+// Only one ISR producer and one main-loop consumer.
+//   * edgeQueueSize  edges held between decodes; a power of two in [2,128],
+//       ideally at least 10 per byte expected between calls to available()
+//   * byteQueueSize  decoded bytes held; a power of two in [2,128]
+template<uint8_t edgeQueueSize = 32, uint8_t byteQueueSize = 16>
+class SoftSerialEdgeDecoder final
+    {
+    static_assert((edgeQueueSize >= 2) && (edgeQueueSize <= 128) && (0 == (edgeQueueSize & (edgeQueueSize - 1))),
+        "edgeQueueSize must be a power of two in [2,128]");
+    static_assert((byteQueueSize >= 2) && (byteQueueSize <= 128) && (0 == (byteQueueSize & (byteQueueSize - 1))),
+        "byteQueueSize must be a power of two in [2,128]");
+
+    private:
+        // Timer ticks per bit; strictly positive.
+        const uint16_t bitTicks;
+        // Ticks from the start edge to the middle of the stop bit.
+        const uint16_t frameEndTicks;
+
+        // Edge timestamps with the new level in the lsb; [eTail, eHead) queued.
+        volatile uint16_t edges[edgeQueueSize];
+        volatile uint8_t eHead = 0;
+        volatile uint8_t eTail = 0;
+        // Edges dropped from a full queue; saturates at 255.
+        volatile uint8_t edgesDropped = 0;
+
+        // Decoded bytes; [bTail, bHead) queued.
+        uint8_t bytes[byteQueueSize];
+        uint8_t bHead = 0;
+        uint8_t bTail = 0;
+
+        // Frame being decoded.
+        bool inFrame = false;
+        uint16_t startT = 0;
+        // Line level since the last edge.
+        uint8_t level = 1;
+        // Data bits decoded so far [0,8], lsb first into shift.
+        uint8_t bitsDone = 0;
+        uint8_t shift = 0;
+
+        // Bytes dropped because the byte queue was full, and frames without a stop bit; saturate at 255.
+        uint8_t bytesDropped = 0;
+        uint8_t framingErrors = 0;
+
+        static void inc(uint8_t &counter) { if(counter < 255) { ++counter; } }
+
+        // Fill in data bits up to (but excluding) bit n with the current level.
+        void fillTo(const uint8_t n)
+            {
+            while((bitsDone < n) && (bitsDone < 8))
+                { shift = uint8_t((shift >> 1) | (level ? 0x80 : 0)); ++bitsDone; }
+            }
+
+        // Complete the frame with the current level through the stop bit.
+        void endFrame()
+            {
+            fillTo(8);
+            inFrame = false;
+            if(!level) { inc(framingErrors); return; }
+            if(uint8_t(bHead - bTail) >= byteQueueSize) { inc(bytesDropped); return; }
+            bytes[bHead & (byteQueueSize - 1)] = shift;
+            ++bHead;
+            }
+
+        // Decode all queued edges, then end any frame whose stop bit has passed by now.
+        void decode(const uint16_t now)
+            {
+            for(uint8_t t = eTail; t != eHead; eTail = ++t)
+                {
+                const uint16_t e = edges[t & (edgeQueueSize - 1)];
+                const uint16_t et = uint16_t(e & ~1U);
+                const uint8_t newLevel = uint8_t(e & 1);
+                if(inFrame)
+                    {
+                    const uint16_t elapsed = uint16_t(et - startT);
+                    if(elapsed < frameEndTicks)
+                        {
+                        // Edge at boundary k ends the bits before it; boundary 1 is the end of the start bit.
+                        const uint8_t k = uint8_t((elapsed + (bitTicks >> 1)) / bitTicks);
+                        if(k > 0) { fillTo(uint8_t(k - 1)); }
+                        level = newLevel;
+                        continue;
+                        }
+                    // This edge is after the stop bit so the frame is done.
+                    endFrame();
+                    }
+                level = newLevel;
+                if(0 == newLevel) { inFrame = true; startT = et; bitsDone = 0; shift = 0; }
+                }
+            // Signed so that a 'now' sampled just before the latest edge is not taken as far in the future.
+            if(inFrame && (int16_t(now - startT) >= int16_t(frameEndTicks))) { endFrame(); }
+            }
+
+    public:
+        //   * bitTicks_  timer ticks per bit, eg F_CPU/baud with an undivided timer
+        explicit SoftSerialEdgeDecoder(const uint16_t bitTicks_)
+          : bitTicks(bitTicks_), frameEndTicks(uint16_t(bitTicks_ * 9U + (bitTicks_ >> 1))), edges(), bytes() { }
+
+        // Record an RX line edge: the timer value and the new line level.
+        // Call from the RX pin-change ISR; fast and ISR-safe.
+        void captureEdgeFromISR(const uint16_t timerNow, const bool high)
+            {
+            const uint8_t h = eHead;
+            if(uint8_t(h - eTail) >= edgeQueueSize) { if(edgesDropped < 255) { edgesDropped = edgesDropped + 1; } return; }
+            edges[h & (edgeQueueSize - 1)] = uint16_t((timerNow & ~1U) | (high ? 1U : 0U));
+            eHead = uint8_t(h + 1);
+            }
+
+        // Decode any captured edges and return the number of bytes ready to read.
+        //   * timerNow  the timer value now
+        // Not ISR-safe.
+        uint8_t available(const uint16_t timerNow) { decode(timerNow); return(uint8_t(bHead - bTail)); }
+
+        // Next decoded byte without removing it, or -1 if none; call available() first.
+        int peek() const { return((bHead == bTail) ? -1 : bytes[bTail & (byteQueueSize - 1)]); }
+        // Remove and return the next decoded byte, or -1 if none; call available() first.
+        int read() { if(bHead == bTail) { return(-1); } return(bytes[bTail++ & (byteQueueSize - 1)]); }
+
+        // Discard all captured edges and decoded bytes, eg before sending a command.
+        // Not ISR-safe: RX edges must not arrive meanwhile.
+        void clear() { eTail = eHead; bTail = bHead; inFrame = false; level = 1; }
+
+        // Error counts, saturating at 255.
+        uint8_t getEdgesDropped() const { return(edgesDropped); }
+        uint8_t getBytesDropped() const { return(bytesDropped); }
+        uint8_t getFramingErrors() const { return(framingErrors); }
+    };
+
+
+}
+
+#endif
@@ -0,0 +1,139 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Software UART transmit queue and bit sequencer (8N1, idle high).
+
+ The main loop queues bytes; a bit-rate timer ISR asks for the next
+ line level at each bit boundary, so the CPU is only busy for one short
+ ISR per bit and interrupts are never blocked for a whole frame.
+
+ Portable; see OTSoftSerial2BufferedTX in OTV0P2BASE_SoftSerial2.h for the AVR binding.
+ */
+
+#ifndef OTV0P2BASE_SOFTSERIALTXQUEUE_H
+#define OTV0P2BASE_SOFTSERIALTXQUEUE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+namespace OTV0P2BASE
+{
+
+
+// Queue of bytes to send, and the frame being sent.
+// Single producer (main loop) and single consumer (the bit timer ISR).
+// With byte-wide indexes and the ISR not interruptible by the producer
+// no locking is needed on AVR.
+//   * queueSize  bytes held; a power of two in [2,128]
+template<uint8_t queueSize = 16>
+class SoftSerialTxQueue final
+    {
+    static_assert((queueSize >= 2) && (queueSize <= 128) && (0 == (queueSize & (queueSize - 1))),
+        "queueSize must be a power of two in [2,128]");
+
+    public:
+        // Callback from the ISR when the last queued byte's stop bit has been sent.
+        typedef void (*completion_fn_t)(void *context);
+
+    private:
+        // Bytes [tail, head) are queued, indexes free-running mod 256.
+        volatile uint8_t ring[queueSize];
+        volatile uint8_t head = 0;
+        volatile uint8_t tail = 0;
+
+        // Frame being sent, lsb next, and levels left in it.
+        uint16_t frame = 0;
+        uint8_t levelsLeft = 0;
+
+        // True from start() until the ISR finds nothing more to send.
+        volatile bool busy = false;
+
+        completion_fn_t completionFn = NULL;
+        void *completionContext = NULL;
+
+    public:
+        SoftSerialTxQueue() : ring() { }
+
+        // Queue a byte; returns false if full.
+        // Not ISR-safe.
+        bool put(const uint8_t b)
+            {
+            const uint8_t h = head;
+            if(uint8_t(h - tail) >= queueSize) { return(false); }
+            ring[h & (queueSize - 1)] = b;
+            head = uint8_t(h + 1);
+            return(true);
+            }
+
+        // Free space in the queue.
+        uint8_t space() const { return(uint8_t(queueSize - uint8_t(head - tail))); }
+
+        // True if anything is queued or being sent.
+        bool isBusy() const { return(busy); }
+
+        // Call after put(); returns true if the bit timer was idle and must now be started.
+        // Once started the timer must call nextLevelFromISR() every bit time until it returns -1.
+        // Not ISR-safe.
+        bool start()
+            {
+            if(busy || (head == tail)) { return(false); }
+            busy = true;
+            return(true);
+            }
+
+        // Set (or clear with NULL) the completion callback, called from the ISR.
+        // Call only while not busy.
+        void setCompletionCallback(const completion_fn_t fn, void *const context = NULL)
+            { completionFn = fn; completionContext = context; }
+
+        // Line level for the bit time starting now: 1 high, 0 low,
+        // or -1 when all is sent (line idle high) and the timer should stop.
+        // Call from the bit timer ISR at each bit boundary.
+        int8_t nextLevelFromISR()
+            {
+            if(0 == levelsLeft)
+                {
+                const uint8_t t = tail;
+                if(t == head)
+                    {
+                    busy = false;
+                    if(NULL != completionFn) { completionFn(completionContext); }
+                    return(-1);
+                    }
+                // Start bit, 8 data bits lsb first, stop bit.
+                frame = uint16_t((uint16_t(ring[t & (queueSize - 1)]) << 1) | 0x200U);
+                tail = uint8_t(t + 1);
+                levelsLeft = 10;
+                }
+            const int8_t level = int8_t(frame & 1);
+            frame >>= 1;
+            --levelsLeft;
+            return(level);
+            }
+
+        // Discard anything not yet started; the frame in progress completes.
+        // Not ISR-safe.
+        void clear() { tail = head; }
+    };
+
+
+}
+
+#endif
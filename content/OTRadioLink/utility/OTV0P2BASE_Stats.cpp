@@ -20,6 +20,10 @@ Author(s) / Copyright (s): Damon Hart-Davis 2013--2016
  Simple rolling stats management.
  */
 
+#ifdef ARDUINO_ARCH_AVR
+#include <avr/pgmspace.h>
+#endif
+
 #include "OTV0P2BASE_Stats.h"
 
 #include "OTV0P2BASE_QuickPRNG.h"
@@ -72,9 +76,13 @@ uint8_t NVByHourByteStatsBase::smoothStatsValue(const uint8_t oldSmoothed, const
   if(oldSmoothed == newValue) { return(oldSmoothed); }
   // Compute and update with new stochastically-rounded exponentially-smoothed ("Brown's simple exponential smoothing") value.
   // Stochastic rounding allows sub-lsb values to have an effect over time.
-  const uint8_t stocAdd = OTV0P2BASE::randRNG8() & ((1 << STATS_SMOOTH_SHIFT) - 1);
-  // Do arithmetic in 16 bits to avoid over-/under- flows.
-  return((uint8_t) (((((uint16_t) oldSmoothed) << STATS_SMOOTH_SHIFT) - ((uint16_t)oldSmoothed) + ((uint16_t)newValue) + stocAdd) >> STATS_SMOOTH_SHIFT));
+  return(smoothStatsKernel(oldSmoothed, newValue, OTV0P2BASE::randRNG8()));
+  }
+
+// Bulk smoothed-stats update of n independent values.
+void NVByHourByteStatsBase::smoothStatsBulk(uint8_t *const smoothed, const uint8_t *const values, const uint8_t *const stocAdds, const size_t n)
+  {
+  for(size_t i = 0; i < n; ++i) { smoothed[i] = smoothStatsUpdate(smoothed[i], values[i], stocAdds[i]); }
   }
 
 // Compute the number of stats samples in specified set less than the specified value; returns 0 for invalid stats set.
@@ -167,6 +175,115 @@ bool NVByHourByteStatsBase::inOutlierQuartile(const bool inTop, const uint8_t st
   return(inBottomQuartile(statsSet, sample));
   }
 
+// Recompute all the cached predictions from the smoothed occupancy stats.
+// Reads each hour's value once, then ranks them in RAM.
+void ByHourOccupancyPredictionCache::rebuild(const NVByHourByteStatsBase &stats)
+  {
+  uint8_t v[24];
+  uint8_t n = 0;
+  for(uint8_t hh = 0; hh < 24; ++hh)
+    {
+    v[hh] = stats.getByHourStatSimple(NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED, hh);
+    if(NVByHourByteStatsBase::UNSET_BYTE != v[hh]) { ++n; }
+    }
+  setHours = n;
+  uint32_t bits = 0;
+  for(uint8_t hh = 0; hh < 24; ++hh)
+    {
+    // Implicitly, since UNSET_BYTE is max uint8_t value, no unset values get counted.
+    uint8_t below = 0;
+    for(uint8_t i = 0; i < 24; ++i) { if(v[i] < v[hh]) { ++below; } }
+    hoursBelow[hh] = below;
+    // An unset or zero hour is never likely occupied.
+    if((NVByHourByteStatsBase::UNSET_BYTE != v[hh]) && (0 != v[hh]) && (below >= LIKELY_OCCUPIED_MIN_HOURS_BELOW))
+      { bits |= uint32_t(1) << hh; }
+    }
+  likelyOccupied = bits;
+  valid = true;
+  }
+
+// First hour likely occupied after hh, wrapping past midnight and ending with hh itself.
+uint8_t ByHourOccupancyPredictionCache::getNextLikelyOccupiedHour(const uint8_t hh) const
+  {
+  if((hh > 23) || (0 == likelyOccupied)) { return(0xff); }
+  for(uint8_t i = 1; i <= 24; ++i)
+    {
+    const uint8_t h = uint8_t((hh + i) % 24);
+    if(0 != (likelyOccupied & (uint32_t(1) << h))) { return(h); }
+    }
+  return(0xff); // Not reached.
+  }
+
+
+// Continue from the given position; false (and no change) if out of range.
+bool ByHourStatsBulkWriter::resumeFrom(const uint8_t fromSet, const uint8_t fromHour)
+  {
+  if((fromSet >= nSets) || (fromHour > 23)) { return(false); }
+  set = fromSet;
+  hour = fromHour;
+  return(true);
+  }
+
+// Write the next chunk to buf, with as many values as fit, and advance past them.
+uint8_t ByHourStatsBulkWriter::writeNextChunk(uint8_t *const buf, const uint8_t bufSize)
+  {
+  if((NULL == buf) || isComplete() || (bufSize <= MSG_BYHOUR_STATS_BULK_HEADER_BYTES)) { return(0); }
+  buf[0] = MSG_BYHOUR_STATS_BULK_LEADING_BYTE;
+  buf[1] = set;
+  buf[2] = hour;
+  uint8_t len = MSG_BYHOUR_STATS_BULK_HEADER_BYTES;
+  uint8_t prev = 0;
+  while(!isComplete())
+    {
+    const uint8_t v = stats.getByHourStatSimple(set, hour);
+    // Zig-zag of the signed difference mod 256.
+    const int8_t d = int8_t(uint8_t(v - prev));
+    const uint8_t zz = uint8_t((uint8_t(d) << 1) ^ uint8_t(d >> 7));
+    const uint8_t n = (zz < 0x80) ? 1 : 2;
+    if(len + n > bufSize) { break; }
+    if(1 == n) { buf[len] = zz; }
+    else { buf[len] = zz | 0x80; buf[len+1] = zz >> 7; }
+    len += n;
+    prev = v;
+    if(++hour > 23) { hour = 0; ++set; prev = 0; }
+    }
+  // Fail if not even one value fitted.
+  return((MSG_BYHOUR_STATS_BULK_HEADER_BYTES == len) ? 0 : len);
+  }
+
+// Apply a received bulk upload chunk to stats; false, having written nothing, if malformed.
+bool applyByHourStatsBulkChunk(const uint8_t *const buf, const uint8_t len, NVByHourByteStatsBase &stats,
+                               uint8_t &nextSet, uint8_t &nextHour, const uint8_t nSets)
+  {
+  if((NULL == buf) || (len <= MSG_BYHOUR_STATS_BULK_HEADER_BYTES) ||
+     (MSG_BYHOUR_STATS_BULK_LEADING_BYTE != buf[0]) || (buf[2] > 23)) { return(false); }
+  // Check the values are well formed before writing any.
+  for(uint8_t pass = 0; pass < 2; ++pass)
+    {
+    const bool write = (1 == pass);
+    uint8_t s = buf[1];
+    uint8_t h = buf[2];
+    uint8_t prev = 0;
+    for(uint8_t i = MSG_BYHOUR_STATS_BULK_HEADER_BYTES; i < len; )
+      {
+      uint8_t zz = buf[i++];
+      if(0 != (zz & 0x80))
+        {
+        // Second byte holds the top bit only.
+        if((i >= len) || (buf[i] > 1)) { return(false); }
+        zz = uint8_t((zz & 0x7f) | (buf[i++] << 7));
+        }
+      if(0xff == s) { return(false); } // Ran beyond the last possible set.
+      const uint8_t v = uint8_t(prev + ((zz >> 1) ^ -(zz & 1)));
+      if(write && (s < nSets)) { stats.setByHourStatSimple(s, h, v); }
+      prev = v;
+      if(++h > 23) { h = 0; ++s; prev = 0; }
+      }
+    nextSet = s;
+    nextHour = h;
+    }
+  return(true);
+  }
 
 // Stats-, EEPROM- (and Flash-) friendly single-byte unary incrementable encoding.
 // A single byte can be used to hold a single value [0,8]
@@ -256,6 +373,42 @@ uint8_t compressTempC16(const int16_t tempC16)
 
 // Reverses range compression done by compressTempC16(); results in range [0,100], with varying precision based on original value.
 // 0xff (or other invalid) input results in STATS_UNSET_INT.
+#ifdef OTV0P2BASE_TEMPC16_EXPAND_TABLE
+// expandTempC16() indexed by compressed value.
+#define U (NVByHourByteStatsBase::UNSET_INT)
+static const int16_t expandTempC16_table[256]
+#ifdef ARDUINO_ARCH_AVR
+    PROGMEM
+#endif // ARDUINO_ARCH_AVR
+    = {
+    0, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 88, 96, 104, 112, 120,
+    128, 136, 144, 152, 160, 168, 176, 184, 192, 200, 208, 216, 224, 232, 240, 248,
+    256, 258, 260, 262, 264, 266, 268, 270, 272, 274, 276, 278, 280, 282, 284, 286,
+    288, 290, 292, 294, 296, 298, 300, 302, 304, 306, 308, 310, 312, 314, 316, 318,
+    320, 322, 324, 326, 328, 330, 332, 334, 336, 338, 340, 342, 344, 346, 348, 350,
+    352, 354, 356, 358, 360, 362, 364, 366, 368, 370, 372, 374, 376, 378, 380, 382,
+    384, 392, 400, 408, 416, 424, 432, 440, 448, 456, 464, 472, 480, 488, 496, 504,
+    512, 520, 528, 536, 544, 552, 560, 568, 576, 584, 592, 600, 608, 616, 624, 632,
+    640, 648, 656, 664, 672, 680, 688, 696, 704, 712, 720, 728, 736, 744, 752, 760,
+    768, 776, 784, 792, 800, 808, 816, 824, 832, 840, 848, 856, 864, 872, 880, 888,
+    896, 904, 912, 920, 928, 936, 944, 952, 960, 968, 976, 984, 992, 1000, 1008, 1016,
+    1024, 1032, 1040, 1048, 1056, 1064, 1072, 1080, 1088, 1096, 1104, 1112, 1120, 1128, 1136, 1144,
+    1152, 1160, 1168, 1176, 1184, 1192, 1200, 1208, 1216, 1224, 1232, 1240, 1248, 1256, 1264, 1272,
+    1280, 1288, 1296, 1304, 1312, 1320, 1328, 1336, 1344, 1352, 1360, 1368, 1376, 1384, 1392, 1400,
+    1408, 1416, 1424, 1432, 1440, 1448, 1456, 1464, 1472, 1480, 1488, 1496, 1504, 1512, 1520, 1528,
+    1536, 1544, 1552, 1560, 1568, 1576, 1584, 1592, 1600, U, U, U, U, U, U, U,
+    };
+#undef U
+static_assert(COMPRESSION_C16_CEIL_VAL_AFTER == 248, "expandTempC16_table must be regenerated");
+int16_t expandTempC16(const uint8_t cTemp)
+  {
+#ifdef ARDUINO_ARCH_AVR
+  return(int16_t(pgm_read_word(expandTempC16_table + cTemp)));
+#else
+  return(expandTempC16_table[cTemp]);
+#endif // ARDUINO_ARCH_AVR
+  }
+#else
 int16_t expandTempC16(const uint8_t cTemp)
   {
   if(cTemp < COMPRESSION_C16_LOW_THR_AFTER) { return(int16_t(cTemp << 3)); }
@@ -265,6 +418,29 @@ int16_t expandTempC16(const uint8_t cTemp)
     { return(int16_t(((cTemp - COMPRESSION_C16_HIGH_THR_AFTER) << 3) + COMPRESSION_C16_HIGH_THRESHOLD)); }
   return(OTV0P2BASE::NVByHourByteStatsBase::UNSET_INT); // Invalid/unset input.
   }
+#endif // OTV0P2BASE_TEMPC16_EXPAND_TABLE
+
+// Branch-free form of compressTempC16() on host, selecting between all three ranges,
+// so that the compiler can vectorise the loop.
+void compressTempC16(const int16_t *const tempC16, uint8_t *const cTemp, const size_t n)
+  {
+  for(size_t i = 0; i < n; ++i)
+    {
+#ifdef ARDUINO_ARCH_AVR
+    cTemp[i] = compressTempC16(tempC16[i]);
+#else
+    const int16_t t = tempC16[i];
+    const int16_t c = (t <= 0) ? int16_t(0) : ((t >= COMPRESSION_C16_CEIL_VAL) ? COMPRESSION_C16_CEIL_VAL : t);
+    const int16_t lo = int16_t(c >> 3);
+    const int16_t mid = int16_t(((c - COMPRESSION_C16_LOW_THRESHOLD) >> 1) + COMPRESSION_C16_LOW_THR_AFTER);
+    const int16_t hi = int16_t(((c - COMPRESSION_C16_HIGH_THRESHOLD) >> 3) + COMPRESSION_C16_HIGH_THR_AFTER);
+    cTemp[i] = uint8_t((c < COMPRESSION_C16_LOW_THRESHOLD) ? lo : ((c < COMPRESSION_C16_HIGH_THRESHOLD) ? mid : hi));
+#endif // ARDUINO_ARCH_AVR
+    }
+  }
+
+void expandTempC16(const uint8_t *const cTemp, int16_t *const tempC16, const size_t n)
+  { for(size_t i = 0; i < n; ++i) { tempC16[i] = expandTempC16(cTemp[i]); } }
 
 
 }
@@ -25,12 +25,19 @@ Author(s) / Copyright (s): Damon Hart-Davis 2013--2016
 #ifndef OTV0P2BASE_STATS_H
 #define OTV0P2BASE_STATS_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
 #include "OTV0P2BASE_Sensor.h"
 #include "OTV0P2BASE_Util.h"
 
+// Use a 256-entry (512-byte) table for expandTempC16() rather than computing by range.
+// On AVR the table is in Flash, and is off by default to save space.
+#if !defined(ARDUINO_ARCH_AVR) && !defined(OTV0P2BASE_TEMPC16_NO_EXPAND_TABLE) && !defined(OTV0P2BASE_TEMPC16_EXPAND_TABLE)
+#define OTV0P2BASE_TEMPC16_EXPAND_TABLE
+#endif
+
 
 namespace OTV0P2BASE
 {
@@ -158,7 +165,30 @@ STATS_SET_USER2_BY_HOUR_SMOOTHED    = 13, // Smoothed hourly user-defined stats
     // Compute new linearly-smoothed value given old smoothed value and new value.
     // Guaranteed not to produce a value higher than the max of the old smoothed value and the new value.
     // Uses stochastic rounding to nearest to allow nominally sub-lsb values to have an effect over time.
+    // Draws a rounding offset from randRNG8() only if the values differ.
     static uint8_t smoothStatsValue(const uint8_t oldSmoothed, const uint8_t newValue);
+
+    // Fixed-point exponential smoothing kernel behind smoothStatsValue(),
+    // with the stochastic rounding offset supplied (only its low STATS_SMOOTH_SHIFT bits are used),
+    // so that host tools replaying stats can match firmware bit for bit given the same offsets.
+    // Returns oldSmoothed whatever the offset if newValue == oldSmoothed.
+    static constexpr uint8_t smoothStatsKernel(const uint8_t oldSmoothed, const uint8_t newValue, const uint8_t stocAdd)
+        {
+        return(uint8_t(((uint16_t(oldSmoothed) << STATS_SMOOTH_SHIFT) - oldSmoothed + newValue +
+            (stocAdd & ((1U << STATS_SMOOTH_SHIFT) - 1))) >> STATS_SMOOTH_SHIFT));
+        }
+    // One smoothed-stats update as made hourly by the stats updater:
+    // an unset smoothed value is replaced by the new value,
+    // and an unset new value (eg a missing sample in a replay) leaves the smoothed value as is.
+    static constexpr uint8_t smoothStatsUpdate(const uint8_t oldSmoothed, const uint8_t newValue, const uint8_t stocAdd)
+        {
+        return((UNSET_BYTE == newValue) ? oldSmoothed :
+            ((UNSET_BYTE == oldSmoothed) ? newValue : smoothStatsKernel(oldSmoothed, newValue, stocAdd)));
+        }
+    // Bulk smoothStatsUpdate() of n independent values, eg many sets, hours or nodes at once,
+    // updating smoothed[i] in place from values[i] with rounding offset stocAdds[i].
+    // Branch-free per value so that host compilers can vectorise it.
+    static void smoothStatsBulk(uint8_t *smoothed, const uint8_t *values, const uint8_t *stocAdds, size_t n);
   };
 
 // Null read-only implementation that holds no stats.
@@ -224,6 +254,165 @@ public:
         { return (currentHour); }
 };
 
+// Read-through RAM cache in front of another stats store, eg EEPROMByHourByteStats,
+// so that code scanning whole sets in loops does not keep hitting EEPROM.
+// Only the sets in cachedSetsMask (bit n for set n) are cached, 24 bytes of RAM each,
+// each loaded on first read; other sets pass straight through.
+// Writes go through to the backing store and update the cache,
+// so all writes to the cached sets must be made via this
+// (else call invalidate()).
+// Small-RAM builds can use the backing store directly instead.
+// Not thread-/ISR- safe.
+//   * cachedSetsMask  bit mask of sets to cache, eg
+//       (1U << STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED) | (1U << STATS_SET_OCCPC_BY_HOUR_SMOOTHED)
+template<uint16_t cachedSetsMask>
+class ByHourByteStatsRAMCache final : public NVByHourByteStatsBase
+{
+private:
+    static constexpr uint8_t setSlots = 24;
+    static_assert(0 == (cachedSetsMask >> STATS_SETS_COUNT), "cachedSetsMask names sets that do not exist");
+
+    // Number of bits set in m.
+    static constexpr uint8_t bitCount(const uint16_t m) { return((0 == m) ? 0 : uint8_t((m & 1) + bitCount(uint16_t(m >> 1)))); }
+    static constexpr uint8_t cachedSets = bitCount(cachedSetsMask);
+
+    NVByHourByteStatsBase &backing;
+
+    // Cached sets in set order, and which have been loaded.
+    mutable uint8_t cache[(0 == cachedSets) ? 1 : cachedSets][setSlots];
+    mutable uint16_t loaded = 0;
+
+    static bool isCached(const uint8_t statsSet)
+        { return((statsSet < STATS_SETS_COUNT) && (0 != (cachedSetsMask & (1U << statsSet)))); }
+    // Index in cache for a cached set.
+    static uint8_t indexOf(const uint8_t statsSet)
+        { return(bitCount(uint16_t(cachedSetsMask & ((1U << statsSet) - 1)))); }
+
+    // Cached copy of a cached set, loading it if need be.
+    uint8_t *row(const uint8_t statsSet) const
+    {
+        uint8_t *const r = cache[indexOf(statsSet)];
+        const uint16_t bit = uint16_t(1U << statsSet);
+        if(0 == (loaded & bit))
+        {
+            for(uint8_t hh = 0; hh < setSlots; ++hh) { r[hh] = backing.getByHourStatSimple(statsSet, hh); }
+            loaded |= bit;
+        }
+        return(r);
+    }
+
+public:
+    explicit ByHourByteStatsRAMCache(NVByHourByteStatsBase &backing_) : backing(backing_), cache() { }
+
+    // Drop all cached copies, eg after writing to the backing store directly.
+    void invalidate() { loaded = 0; }
+
+    // Clears the backing store, and the cache.
+    virtual bool zapStats(uint16_t maxBytesToErase = 0) override
+        { invalidate(); return(backing.zapStats(maxBytesToErase)); }
+
+    // Read from RAM for cached sets.
+    virtual uint8_t getByHourStatSimple(const uint8_t statsSet, const uint8_t hh) const override
+    {
+        if(!isCached(statsSet) || (hh >= setSlots)) { return(backing.getByHourStatSimple(statsSet, hh)); }
+        return(row(statsSet)[hh]);
+    }
+
+    // Write through, keeping any loaded cached copy in step.
+    virtual void setByHourStatSimple(const uint8_t statsSet, const uint8_t hh, const uint8_t v = UNSET_BYTE) override
+    {
+        backing.setByHourStatSimple(statsSet, hh, v);
+        if(isCached(statsSet) && (hh < setSlots) && (0 != (loaded & (1U << statsSet))))
+            { cache[indexOf(statsSet)][hh] = v; }
+    }
+
+    virtual uint8_t getHour() const override { return(backing.getHour()); }
+};
+
+// Write-staging front for another stats store, eg EEPROMByHourByteStats,
+// to spread the burst of byte writes from each hourly full sample
+// (a last and a smoothed value for each stats set updated)
+// over the following minutes instead of one long awake spike.
+// Writes are held in RAM, in order, and commitPending() (eg called once per minute)
+// moves the oldest few to the backing store.
+// Reads via this see the staged values, so all the new values for the hour
+// appear together, as soon as they are written;
+// a reader of the backing store alone sees each value either old or new,
+// with each last value committed before its smoothed value.
+// If full, a write first commits the oldest staged write.
+// Call flush() before reading the backing store directly, or before powering down.
+// Not thread-/ISR- safe.
+//   * maxPending  writes that can be staged at once; 8 covers the four sets
+//       written by ByHourSimpleStatsUpdaterSampleStats; strictly positive
+template<uint8_t maxPending = 8>
+class ByHourByteStatsStagedWriter final : public NVByHourByteStatsBase
+{
+private:
+    static_assert(maxPending > 0, "must be able to stage at least one write");
+
+    NVByHourByteStatsBase &backing;
+
+    // Staged writes, oldest first.
+    struct pending_t { uint8_t statsSet, hh, v; };
+    pending_t pending[maxPending];
+    uint8_t pendingCount = 0;
+
+    // Index of the staged write to statsSet/hh, else -1.
+    int8_t find(const uint8_t statsSet, const uint8_t hh) const
+    {
+        for(uint8_t i = 0; i < pendingCount; ++i)
+            { if((statsSet == pending[i].statsSet) && (hh == pending[i].hh)) { return(int8_t(i)); } }
+        return(-1);
+    }
+
+public:
+    explicit ByHourByteStatsStagedWriter(NVByHourByteStatsBase &backing_) : backing(backing_), pending() { }
+
+    // Number of writes staged and not yet committed.
+    uint8_t getPendingCount() const { return(pendingCount); }
+
+    // Commit up to maxWrites of the oldest staged writes to the backing store.
+    // Returns true if nothing remains staged.
+    bool commitPending(const uint8_t maxWrites = 2)
+    {
+        const uint8_t n = fnmin(maxWrites, pendingCount);
+        for(uint8_t i = 0; i < n; ++i)
+            { backing.setByHourStatSimple(pending[i].statsSet, pending[i].hh, pending[i].v); }
+        pendingCount -= n;
+        for(uint8_t i = 0; i < pendingCount; ++i) { pending[i] = pending[i + n]; }
+        return(0 == pendingCount);
+    }
+    // Commit all staged writes.
+    void flush() { commitPending(maxPending); }
+
+    // Drops all staged writes and clears the backing store.
+    virtual bool zapStats(uint16_t maxBytesToErase = 0) override
+        { pendingCount = 0; return(backing.zapStats(maxBytesToErase)); }
+
+    // Staged value if any, else from the backing store.
+    virtual uint8_t getByHourStatSimple(const uint8_t statsSet, const uint8_t hh) const override
+    {
+        const int8_t i = find(statsSet, hh);
+        return((i >= 0) ? pending[i].v : backing.getByHourStatSimple(statsSet, hh));
+    }
+
+    // Stage the write, replacing any earlier staged write to the same slot.
+    // Invalid sets and hours are passed straight through.
+    virtual void setByHourStatSimple(const uint8_t statsSet, const uint8_t hh, const uint8_t v = UNSET_BYTE) override
+    {
+        if((statsSet >= STATS_SETS_COUNT) || (hh > 23)) { backing.setByHourStatSimple(statsSet, hh, v); return; }
+        const int8_t i = find(statsSet, hh);
+        if(i >= 0) { pending[i].v = v; return; }
+        if(pendingCount >= maxPending) { commitPending(1); }
+        pending[pendingCount].statsSet = statsSet;
+        pending[pendingCount].hh = hh;
+        pending[pendingCount].v = v;
+        ++pendingCount;
+    }
+
+    virtual uint8_t getHour() const override { return(backing.getHour()); }
+};
+
 
 // Range-compress an signed int 16ths-Celsius temperature to a unsigned single-byte value < 0xff.
 // This preserves at least the first bit after the binary point for all values,
@@ -241,12 +430,194 @@ uint8_t compressTempC16(int16_t tempC16);
 // Reverses range compression done by compressTempC16(); results in range [0,100], with varying precision based on original value.
 // 0xff (or other invalid) input results in STATS_UNSET_INT.
 int16_t expandTempC16(uint8_t cTemp);
+// Bulk versions of compressTempC16() and expandTempC16() for n values, eg whole stats sets,
+// with identical results; on host these are written to vectorise.
+// Input and output must not overlap.
+void compressTempC16(const int16_t *tempC16, uint8_t *cTemp, size_t n);
+void expandTempC16(const uint8_t *cTemp, int16_t *tempC16, size_t n);
 
 // Maximum valid encoded/compressed stats values.
 static constexpr uint8_t MAX_STATS_TEMP = COMPRESSION_C16_CEIL_VAL_AFTER; // Maximum valid compressed temperature value in stats.
 static constexpr uint8_t MAX_STATS_AMBLIGHT = 254; // Maximum valid ambient light value in stats (very top of range is compressed).
 
 
+// RAM cache of the aggregates of one by-hour stats set
+// wanted frequently by (eg) the adaptive ambient light sensor:
+// the minimum and maximum over all hours, and the value for one hour.
+// Kept current incrementally by the stats updater as each hourly value is written,
+// so that per-minute callers need not rescan the non-volatile store.
+// The first query after construction or invalidate() does a full scan.
+// Call invalidate() after writing the stats set other than via the updater, eg zapStats().
+// Memory footprint is 5 bytes.
+class ByHourStatsAggregateCache final
+    {
+    private:
+        uint8_t minV = NVByHourByteStatsBase::UNSET_BYTE;
+        uint8_t maxV = NVByHourByteStatsBase::UNSET_BYTE;
+        // Cached value for hour valueHH; valueHH is 0xff if none.
+        uint8_t valueHH = 0xff;
+        uint8_t value = NVByHourByteStatsBase::UNSET_BYTE;
+        // True once minV and maxV are valid.
+        bool valid = false;
+
+        // Recompute the min and max from the backing store if not valid.
+        void ensureValid(const NVByHourByteStatsBase &stats, const uint8_t statsSet)
+            {
+            if(valid) { return; }
+            minV = stats.getMinByHourStat(statsSet);
+            maxV = stats.getMaxByHourStat(statsSet);
+            valid = true;
+            }
+
+    public:
+        // Force a full rescan at the next query.
+        void invalidate() { valid = false; valueHH = 0xff; }
+
+        // Note that the value for hour hh [0,23] has changed from oldV to newV.
+        // Only needs to rescan when an extreme value moves inwards or is erased.
+        void noteWritten(const uint8_t hh, const uint8_t oldV, const uint8_t newV)
+            {
+            if(hh == valueHH) { value = newV; }
+            if(!valid || (oldV == newV)) { return; }
+            const uint8_t unset = NVByHourByteStatsBase::UNSET_BYTE;
+            if((unset != oldV) &&
+               ((unset == newV) || ((oldV == minV) && (newV > oldV)) || ((oldV == maxV) && (newV < oldV))))
+                { valid = false; return; }
+            // Optimisation/cheat: all valid samples are less than UNSET_BYTE.
+            if(newV < minV) { minV = newV; }
+            if((unset == maxV) || (newV > maxV)) { maxV = newV; }
+            }
+
+        // Minimum over all hours ignoring unset values; UNSET_BYTE if none is set.
+        uint8_t getMin(const NVByHourByteStatsBase &stats, const uint8_t statsSet)
+            { ensureValid(stats, statsSet); return(minV); }
+        // Maximum over all hours ignoring unset values; UNSET_BYTE if none is set.
+        uint8_t getMax(const NVByHourByteStatsBase &stats, const uint8_t statsSet)
+            { ensureValid(stats, statsSet); return(maxV); }
+        // Value for hour hh [0,23], reading the backing store only when hh changes.
+        // UNSET_BYTE if unset or hh is invalid.
+        uint8_t getForHour(const NVByHourByteStatsBase &stats, const uint8_t statsSet, const uint8_t hh)
+            {
+            if(hh > 23) { return(NVByHourByteStatsBase::UNSET_BYTE); }
+            if(hh != valueHH) { value = stats.getByHourStatSimple(statsSet, hh); valueHH = hh; }
+            return(value);
+            }
+    };
+
+// RAM cache of occupancy predictions from the smoothed by-hour occupancy stats
+// (STATS_SET_OCCPC_BY_HOUR_SMOOTHED), wanted every minute by the setback logic.
+// Holds for each hour the number of hours less occupied than it,
+// exactly as countStatSamplesBelow() of that hour's value would give,
+// and a bitmap of the hours likely to be occupied.
+// Rebuilt from the stats (24 reads) by the stats updater once per hour
+// as the hourly values are written, so per-minute callers need not rescan
+// the non-volatile store; invalid until first rebuilt.
+// Memory footprint is 30 bytes.
+class ByHourOccupancyPredictionCache final
+    {
+    public:
+        // Minimum number of hours less occupied for an hour to be considered likely occupied,
+        // ie an hour at least as occupied as about half of the day.
+        static constexpr uint8_t LIKELY_OCCUPIED_MIN_HOURS_BELOW = 12;
+
+    private:
+        // Hours less occupied than each hour.
+        uint8_t hoursBelow[24];
+        // Number of hours with set values, ie the count for an unset or invalid hour.
+        uint8_t setHours = 0;
+        // Bit hh is set iff hour hh is likely occupied; the top 8 bits are always clear.
+        uint32_t likelyOccupied = 0;
+        // True once rebuilt.
+        bool valid = false;
+
+    public:
+        ByHourOccupancyPredictionCache() : hoursBelow() { }
+
+        // Mark as needing a rebuild, eg after zapStats().
+        void invalidate() { valid = false; }
+        // True if rebuilt since construction or invalidate().
+        bool isValid() const { return(valid); }
+
+        // Recompute everything from the smoothed occupancy stats.
+        void rebuild(const NVByHourByteStatsBase &stats);
+
+        // As countStatSamplesBelow(STATS_SET_OCCPC_BY_HOUR_SMOOTHED, value for hour hh).
+        //   * hh  hour of day [0,23]; other values are taken as an unset hour
+        uint8_t getHoursLessOccupiedThan(const uint8_t hh) const
+            { return((hh > 23) ? setHours : hoursBelow[hh]); }
+
+        // Bitmap of hours likely occupied, bit hh for hour hh [0,23].
+        uint32_t getLikelyOccupiedBitmap() const { return(likelyOccupied); }
+        // True if hour hh [0,23] is likely occupied; false for other hh.
+        bool isLikelyOccupiedHour(const uint8_t hh) const
+            { return((hh <= 23) && (0 != (likelyOccupied & (uint32_t(1) << hh)))); }
+        // First hour likely occupied after hh [0,23], wrapping past midnight
+        // and ending with hh itself; 0xff if none or hh is invalid.
+        uint8_t getNextLikelyOccupiedHour(uint8_t hh) const;
+    };
+
+// Bulk upload of a full by-hour stats history over the radio, eg to a hub,
+// in chunks small enough for a 32-byte secure frame body.
+// Each chunk carries consecutive values in the order
+// all 24 hours of set 0, then all of set 1, and so on,
+// starting at the (set, hour) in its header, so that the receiver can place
+// every chunk and the sender can resume from any point, eg after a lost chunk.
+// Format:
+//   byte 0 : MSG_BYHOUR_STATS_BULK_LEADING_BYTE
+//   byte 1 : stats set of the first value
+//   byte 2 : hour [0,23] of the first value
+//   then one or more values, each the difference (mod 256) from the previous value
+//     in the same set (from 0 for the first in each set and in each chunk)
+//     as a zig-zag varint: 1 byte for differences in [-64,63], else 2.
+// Unset (0xff) values are sent like any other.
+// A set of smoothly-varying values takes about 26 bytes, against 24 raw bytes
+// plus framing for each of the 14 standard sets sent separately.
+static constexpr uint8_t MSG_BYHOUR_STATS_BULK_LEADING_BYTE = 0xb6;
+static constexpr uint8_t MSG_BYHOUR_STATS_BULK_HEADER_BYTES = 3;
+
+// Writes a node's by-hour stats as a sequence of bulk upload chunks.
+// Call writeNextChunk() whenever airtime allows, eg when no stats frame is due,
+// and send each chunk returned until isComplete().
+// The stats must outlive this.
+class ByHourStatsBulkWriter final
+    {
+    private:
+        const NVByHourByteStatsBase &stats;
+        // Number of sets to send.
+        const uint8_t nSets;
+        // Position of the next value to send.
+        uint8_t set = 0;
+        uint8_t hour = 0;
+
+    public:
+        ByHourStatsBulkWriter(const NVByHourByteStatsBase &_stats,
+                              const uint8_t _nSets = NVByHourByteStatsBase::STATS_SETS_COUNT)
+          : stats(_stats), nSets(_nSets) { }
+
+        // True once every value has been written.
+        bool isComplete() const { return(set >= nSets); }
+        // Position of the next value to be written.
+        uint8_t getNextSet() const { return(set); }
+        uint8_t getNextHour() const { return(hour); }
+
+        // Continue from the given position, eg (0, 0) to start again,
+        // or where the receiver reports a gap; false (and no change) if out of range.
+        bool resumeFrom(uint8_t fromSet, uint8_t fromHour = 0);
+
+        // Write the next chunk to buf, with as many values as fit, and advance past them.
+        // Returns the chunk length, or 0 if complete or buf cannot hold even one value.
+        uint8_t writeNextChunk(uint8_t *buf, uint8_t bufSize);
+    };
+
+// Apply a received bulk upload chunk to stats, eg a hub's copy of a node's stats.
+// Values for sets at or beyond nSets are ignored.
+// On success returns true and sets nextSet and nextHour to the position
+// just after the chunk, against which the next chunk's header can be checked.
+// Returns false, having written nothing, if the chunk is malformed.
+bool applyByHourStatsBulkChunk(const uint8_t *buf, uint8_t len, NVByHourByteStatsBase &stats,
+                               uint8_t &nextSet, uint8_t &nextHour,
+                               uint8_t nSets = NVByHourByteStatsBase::STATS_SETS_COUNT);
+
 class ByHourSimpleStatsUpdaterBase
 {
 public:
@@ -309,24 +680,22 @@ static uint8_t divide_to_u8(
 //   * statsSet for raw/'last' value, with 'smoothed' set one higher
 //   * hh  hour of data; [0,23]
 //   * value  new stats value in range [0,254]
+//   * smoothedCacheOpt  if not NULL, told of the new smoothed value
 template<class Stats>
 void update_stats_pair(
     const uint8_t statsSet, const uint8_t hh, const uint8_t value,
-    Stats& stats)
+    Stats& stats,
+    ByHourStatsAggregateCache *const smoothedCacheOpt = nullptr)
 {
     // Update the last-sample slot using the mean samples value.
     stats.setByHourStatSimple(statsSet, hh, value);
     // If existing smoothed value unset or invalid, use new one as is, else fold in.
     const uint8_t smoothedStatsSet = statsSet + 1;
     const uint8_t smoothed = stats.getByHourStatSimple(smoothedStatsSet, hh);
-    if(OTV0P2BASE::NVByHourByteStatsBase::UNSET_BYTE == smoothed) {
-        stats.setByHourStatSimple(smoothedStatsSet, hh, value);
-    } else {
-        stats.setByHourStatSimple(
-            smoothedStatsSet, 
-            hh, 
-            OTV0P2BASE::NVByHourByteStatsBase::smoothStatsValue(smoothed, value));
-    }
+    const uint8_t newSmoothed = (OTV0P2BASE::NVByHourByteStatsBase::UNSET_BYTE == smoothed) ? value :
+        OTV0P2BASE::NVByHourByteStatsBase::smoothStatsValue(smoothed, value);
+    stats.setByHourStatSimple(smoothedStatsSet, hh, newSmoothed);
+    if(nullptr != smoothedCacheOpt) { smoothedCacheOpt->noteWritten(hh, smoothed, newSmoothed); }
 }
 
 // Sample statistics fully once per hour as background to simple monitoring and adaptive behaviour.
@@ -345,6 +714,8 @@ void update_stats_pair(
 //
 // Call with out-of-range hh to effectively discard any partial samples.
 //
+// If ambLightCacheOpt is not NULL it is kept current for the smoothed ambient light set.
+//
 // TODO: Consider tidying up arguments with a struct or two.
 template<
     class Stats,
@@ -361,7 +732,8 @@ void update_stats_store(
     const Occupancy* occupancyOpt = nullptr,
     const AmbLight* ambLightOpt = nullptr,
     const TempC16* tempC16Opt = nullptr,
-    const Humidity* humidityOpt = nullptr
+    const Humidity* humidityOpt = nullptr,
+    ByHourStatsAggregateCache* ambLightCacheOpt = nullptr
     )
 {
     // (Sub-)sample processing.
@@ -397,7 +769,8 @@ void update_stats_store(
                 OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_AMBLIGHT_BY_HOUR, 
                 hh, 
                 divide_to_u8(internal_state.ambLightTotal, sc, maxSubSamples),
-                stats);
+                stats,
+                ambLightCacheOpt);
         }
     }
 
@@ -459,6 +832,8 @@ void update_stats_store(
 
 
 // Class to handle updating stats periodically, ie 1 or more times per hour.
+// To spread the full sample's EEPROM writes over the following minutes,
+// make stats a ByHourByteStatsStagedWriter and call its commitPending() each minute.
 //   * stats  stats container; never NULL
 //   * ambLightOpt  optional ambient light (uint8_t) sensor; can be NULL
 //   * tempC16Opt  optional ambient temperature (int16_t) sensor; can be NULL
@@ -466,13 +841,16 @@ void update_stats_store(
 //       1 or 2 are especially efficient and avoid overflow,
 //       2 is probably most robust;
 //       strictly positive
+//   * occPredictionOpt  optional occupancy prediction cache, rebuilt after each full sample
+//       (and at any sample until first built); can be NULL
 template <
     class stats_t /* = NVByHourByteStatsBase */, stats_t *stats,
     class occupancy_t = SimpleTSUint8Sensor /*PseudoSensorOccupancyTracker*/, const occupancy_t *occupancyOpt = nullptr,
     class ambLight_t = SimpleTSUint8Sensor /*SensorAmbientLightBase*/, const ambLight_t *ambLightOpt = nullptr,
     class tempC16_t = Sensor<int16_t> /*TemperatureC16Base*/, const tempC16_t *tempC16Opt = nullptr,
     class humidity_t = SimpleTSUint8Sensor /*HumiditySensorBase*/, const humidity_t *humidityOpt = nullptr,
-    uint8_t maxSubSamples = 2
+    uint8_t maxSubSamples = 2,
+    ByHourOccupancyPredictionCache *occPredictionOpt = nullptr
 >
 class ByHourSimpleStatsUpdaterSampleStats final : public ByHourSimpleStatsUpdaterBase
 {
@@ -506,11 +884,41 @@ protected:
 
     StatsUpdaterLogic::StatsUpdaterState<maxSamplesPerHour> internal_state {};
 
+    // Smoothed ambient light aggregates, kept current as hourly stats are written.
+    ByHourStatsAggregateCache ambLightCache;
+
+    // Null-safe operations on the optional occupancy prediction cache.
+    typedef OptionalTag<(nullptr != occPredictionOpt)> occPredictionTag;
+    static void invalidatePrediction(OptionalTag<false>) { }
+    static void invalidatePrediction(OptionalTag<true>) { occPredictionOpt->invalidate(); }
+    // Rebuild after each full sample, and at any sample until first built.
+    static void updatePrediction(OptionalTag<false>, bool) { }
+    static void updatePrediction(OptionalTag<true>, const bool fullSample)
+        { if(fullSample || !occPredictionOpt->isValid()) { occPredictionOpt->rebuild(*stats); } }
+
 public:
     // FIXME: Push to base class?
     // Clear any partial internal state; primarily for unit tests.
-    // Does no write to the backing stats store.
-    void reset() override { sampleStats(false, 0xff); }
+    // Does no write to the backing stats store,
+    // but forces the cached aggregates to be reread, eg after zapStats().
+    void reset() override
+        {
+        sampleStats(false, 0xff);
+        ambLightCache.invalidate();
+        invalidatePrediction(occPredictionTag());
+        }
+
+    // Typical (smoothed) ambient light levels for SensorAmbientLightAdaptive::setTypMinMax(),
+    // read from RAM except after an hourly update moves an extreme inwards,
+    // or on the first call for each hour for getAmbLightTypForHour().
+    // UNSET_BYTE where not known.
+    uint8_t getAmbLightTypMin()
+        { return(ambLightCache.getMin(*stats, NVByHourByteStatsBase::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED)); }
+    uint8_t getAmbLightTypMax()
+        { return(ambLightCache.getMax(*stats, NVByHourByteStatsBase::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED)); }
+    //   * hh  hour of day [0,23], usually the current hour
+    uint8_t getAmbLightTypForHour(const uint8_t hh)
+        { return(ambLightCache.getForHour(*stats, NVByHourByteStatsBase::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED, hh)); }
 
     // Virtual getter method for maxSamplesPerHour.
     uint8_t getMaxSamplesPerHour() override { return(maxSamplesPerHour); }
@@ -540,7 +948,10 @@ public:
             occupancyOpt,
             ambLightOpt,
             tempC16Opt,
-            humidityOpt);
+            humidityOpt,
+            &ambLightCache);
+        // Rebuild the occupancy predictions as the hour's stats are written.
+        updatePrediction(occPredictionTag(), fullSample);
     }
     
   };
@@ -28,6 +28,8 @@ Author(s) / Copyright (s): Damon Hart-Davis 2017
 #include <stdint.h>
 #include <string.h>
 
+#include "OTV0P2BASE_CPUClockPolicy.h"
+#include "OTV0P2BASE_FastFormat.h"
 #include "OTV0P2BASE_JSONStats.h"
 #include "OTV0P2BASE_Sensor.h"
 #include "OTV0P2BASE_Serial_LineType_InitChar.h"
@@ -167,39 +169,52 @@ class SystemStatsLine final
         typedef typename typeIf<noJS, dummySSR, SimpleStatsRotation<ss1Size>>::t ss1_type;
         ss1_type ss1;
 
-    public:
-        void serialStatusReport()
+        // Null-safe formatting of the optional valve and temperature (see OptionalTag).
+        // Valve target percent open as "nn%".
+        static char *formatValvePC(char *const p, OptionalTag<false>) { return(p); }
+        static char *formatValvePC(char *p, OptionalTag<true>)
             {
-            // GCC/clang 4.x sillies prevent validating statically or otherwise...
-//            static_assert(printer, "printer must not be null");
-//            static_assert(valveMode, "valveMode must not be null");
-//            if(NULL == printer) { return; }
-//            if(NULL == valveMode) { return; }
-
-#if defined(ARDUINO_ARCH_AVR)
-            const bool neededWaking = wakeFlushSleepSerial &&
-                OTV0P2BASE::powerUpSerialIfDisabled<>();
-#else
-            static_assert(!wakeFlushSleepSerial, "wakeFlushSleepSerial needs hardware Serial");
-#endif
+            p = formatU8(p, modelledRadValveOpt->get());
+            *p++ = '%';
+            return(p);
+            }
+        // Temperature as '@', whole degrees C, 'C' then 16ths as a hex digit.
+        static char *formatTempC16(char *const p, OptionalTag<false>) { return(p); }
+        static char *formatTempC16(char *p, OptionalTag<true>)
+            {
+            const int16_t temp = tempC16Opt->get();
+            *p++ = '@';
+            p = formatI16(p, int16_t(temp >> 4));
+            *p++ = 'C';
+            *p++ = "0123456789ABCDEF"[temp & 0xf];
+            return(p);
+            }
 
-            // Aim to overlap CPU usage with characters being TXed
-            // for throughput determined primarily by output size and baud
-            // for real Serial or other async output.
+    public:
+        // Buffer size for formatStatusReport(), including the trailing '\0':
+        // up to 15 chars of initial section, ';' and up to 39 chars of JSON, then CRLF.
+        static constexpr uint8_t MAX_STATUS_LINE_CHARS = 64;
+
+        // Format the whole status line, with trailing CRLF and '\0', into buf.
+        // Uses only the fast integer formatting into the buffer, with no Print calls.
+        // Returns the line length excluding the '\0',
+        // or 0 if bufSize is less than MAX_STATUS_LINE_CHARS.
+        uint8_t formatStatusReport(char *const buf, const uint8_t bufSize)
+            {
+            if((NULL == buf) || (bufSize < MAX_STATUS_LINE_CHARS)) { return(0); }
+            // Pure formatting: no need for full CPU speed.
+            RAII_CPUReducedClock slow;
+            char *p = buf;
 
             // Stats line starts with distinguished marker character.
             // Initial '=' section with common essentials.
-            printer->print((char) SERLINE_START_CHAR_STATS);
+            *p++ = (char) SERLINE_START_CHAR_STATS;
             // Valve device mode F/W/B.
-            printer->print(valveMode->inWarmMode() ? (valveMode->inBakeMode() ? 'B' : 'W') : 'F');
+            *p++ = valveMode->inWarmMode() ? (valveMode->inBakeMode() ? 'B' : 'W') : 'F';
 
             // Valve target percent open, if available.
             // Display as nn% where nn is in decimal, eg from "0%" to "100%".
-            if(NULL != modelledRadValveOpt)
-                {
-                printer->print(modelledRadValveOpt->get());
-                printer->print('%');
-                }
+            p = formatValvePC(p, OptionalTag<(NULL != modelledRadValveOpt)>());
 
             // Temperature in C, if available.
             // Display as:
@@ -210,14 +225,7 @@ class SystemStatsLine final
             // eg "23CA" for 23+10/16 C
             //
             // Note that the trailing hex digit was not present originally.
-            if(NULL != tempC16Opt)
-                {
-                const int16_t temp = tempC16Opt->get();
-                printer->print('@');
-                printer->print(int(temp >> 4));
-                printer->print('C');
-                printer->print(int(temp & 0xf), 16);
-                }
+            p = formatTempC16(p, OptionalTag<(NULL != tempC16Opt)>());
 
             //#ifdef ENABLE_FULL_OT_CLI
             //  // *X* section: Xmit security level shown only if some non-essential TX potentially allowed.
@@ -312,15 +320,14 @@ class SystemStatsLine final
 //#endif
 
 
-            // If allowed, print trailing JSON rotation of key values.
+            // If allowed, append trailing JSON rotation of key values.
             if(!noJS)
                 {
                 // Terminate previous section.
-                printer->print(';');
+                *p++ = ';';
 
-                // Buffer for { ... } JSON output.
+                // The { ... } JSON output goes straight into the line.
                 // Keep short to avoid serial overruns.
-                char buf[40];
                 ss1.put(*humidityOpt);
                 ss1.put(*ambLightOpt);
                 ss1.put(*occupancyOpt);
@@ -328,13 +335,37 @@ class SystemStatsLine final
 //                ss1.put(modelledRadValveOpt->tagCMPC(), modelledRadValveOpt->getCumulativeMovementPC()); // EXPERIMENTAL
 // TODO
 //ss1.put(Supply_cV);
-
-                  const uint8_t wrote = ss1.writeJSON((uint8_t *)buf, sizeof(buf), 0, true);
-                  if(0 != wrote) { printer->print(buf); }
-                  }
+                p += ss1.writeJSON((uint8_t *)p, 40, 0, true);
+                }
 
             // Terminate line.
-            printer->println();
+            *p++ = '\r';
+            *p++ = '\n';
+            *p = '\0';
+            return(uint8_t(p - buf));
+            }
+
+        // Sends the status line to the printer in one write.
+        // On AVR with wakeFlushSleepSerial, powers up the UART if need be
+        // and waits for the line to drain before powering it down again;
+        // see queueStatusReport() to avoid that wait.
+        void serialStatusReport()
+            {
+            // GCC/clang 4.x sillies prevent validating statically or otherwise...
+//            static_assert(printer, "printer must not be null");
+//            static_assert(valveMode, "valveMode must not be null");
+//            if(NULL == printer) { return; }
+//            if(NULL == valveMode) { return; }
+
+#if defined(ARDUINO_ARCH_AVR)
+            const bool neededWaking = wakeFlushSleepSerial &&
+                OTV0P2BASE::powerUpSerialIfDisabled<>();
+#else
+            static_assert(!wakeFlushSleepSerial, "wakeFlushSleepSerial needs hardware Serial");
+#endif
+
+            char line[MAX_STATUS_LINE_CHARS];
+            if(0 != formatStatusReport(line, sizeof(line))) { printer->print(line); }
 
 #if defined(ARDUINO_ARCH_AVR)
             // Ensure that all text is sent before this routine returns,
@@ -344,6 +375,19 @@ class SystemStatsLine final
             if(neededWaking) { OTV0P2BASE::powerDownSerial(); }
 #endif
             }
+
+        // Queue the status line whole on a TX ring (eg SerialTXRing)
+        // for an ISR or non-blocking pump to send while the CPU sleeps.
+        // Does not touch the UART or its power,
+        // so the caller must keep it powered until the ring has drained.
+        // Returns false if the ring had no room for the whole line, which is then dropped.
+        template<class ring_t>
+        bool queueStatusReport(ring_t &ring)
+            {
+            char line[MAX_STATUS_LINE_CHARS];
+            const uint8_t len = formatStatusReport(line, sizeof(line));
+            return(ring.push(line, len));
+            }
     };
 
 
@@ -0,0 +1,183 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Host-side playback of recorded sensor time series.
+ */
+
+#include "OTV0P2BASE_TimeSeriesPlayback.h"
+
+#ifdef OTV0P2BASE_TIME_SERIES_PLAYBACK_AVAILABLE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace OTV0P2BASE
+{
+
+
+static const char binaryMagic[4] = { 'O', 'T', 'T', 'S' };
+static constexpr uint8_t binaryVersion = 1;
+
+bool MappedTimeSeries::open(const char *const path)
+    {
+    close();
+    if(NULL == path) { errno = EINVAL; return(false); }
+    const int fd = ::open(path, O_RDONLY);
+    if(fd < 0) { return(false); }
+    struct stat st;
+    if(0 != fstat(fd, &st)) { const int e = errno; ::close(fd); errno = e; return(false); }
+    if(st.st_size <= 0) { ::close(fd); errno = EINVAL; return(false); }
+    const size_t size = size_t(st.st_size);
+    void *const m = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file open.
+    const int e = errno;
+    ::close(fd);
+    if(MAP_FAILED == m) { errno = e; return(false); }
+    mem = static_cast<const uint8_t *>(m);
+    len = size;
+    binary = (len >= BINARY_HEADER_LEN) && (0 == memcmp(mem, binaryMagic, sizeof(binaryMagic)));
+    if(binary)
+        {
+        binColumns = mem[5];
+        if((binaryVersion != mem[4]) || (0 == binColumns) || (binColumns > TimeSeriesSample::MAX_COLUMNS))
+            { close(); errno = EINVAL; return(false); }
+        start = BINARY_HEADER_LEN;
+        }
+    else { start = 0; }
+    pos = start;
+    return(true);
+    }
+
+void MappedTimeSeries::close()
+    {
+    if(NULL == mem) { return; }
+    munmap(const_cast<uint8_t *>(mem), len);
+    mem = NULL;
+    len = 0;
+    binary = false;
+    pos = start = 0;
+    }
+
+// Parse one CSV/space-separated line [p,end) into s; false if not a sample.
+static bool parseLine(const uint8_t *p, const uint8_t *const end, TimeSeriesSample &s)
+    {
+    // Skip leading white space; reject blank and comment lines.
+    while((p < end) && ((' ' == *p) || ('\t' == *p))) { ++p; }
+    if((p == end) || ('#' == *p) || ('\r' == *p)) { return(false); }
+    // Time field: up to 4 colon-separated parts, D:H:M:S with leading parts optional.
+    uint32_t part[4];
+    uint8_t parts = 0;
+    bool digits = false;
+    for(uint32_t v = 0; ; ++p)
+        {
+        const bool atEnd = (p == end) || (' ' == *p) || (',' == *p) || ('\t' == *p) || ('\r' == *p);
+        if(!atEnd && (*p >= '0') && (*p <= '9')) { v = (v * 10) + (*p - '0'); digits = true; continue; }
+        if(!digits || (parts >= 4) || (!atEnd && (':' != *p))) { return(false); }
+        part[parts++] = v;
+        if(atEnd) { break; }
+        v = 0; digits = false;
+        }
+    static const uint8_t radix[4] = { 1, 24, 60, 60 };
+    uint32_t t = 0;
+    for(uint8_t i = 0; i < parts; ++i) { t = (t * radix[4 - parts + i]) + part[i]; }
+    s.t = t;
+    // Value fields.
+    s.columns = 0;
+    while(p < end)
+        {
+        while((p < end) && ((' ' == *p) || (',' == *p) || ('\t' == *p) || ('\r' == *p))) { ++p; }
+        if(p == end) { break; }
+        bool neg = false;
+        if(('-' == *p) || ('+' == *p)) { neg = ('-' == *p); ++p; }
+        int32_t v = 0;
+        bool digits = false;
+        while((p < end) && (*p >= '0') && (*p <= '9')) { v = (v * 10) + (*p++ - '0'); if(v > 0x8000) { return(false); } digits = true; }
+        if(!digits || (s.columns >= TimeSeriesSample::MAX_COLUMNS)) { return(false); }
+        if(neg) { v = -v; }
+        if(v > 0x7fff) { return(false); }
+        s.v[s.columns++] = int16_t(v);
+        }
+    return(0 != s.columns);
+    }
+
+bool MappedTimeSeries::next(TimeSeriesSample &s)
+    {
+    if(NULL == mem) { return(false); }
+    if(binary)
+        {
+        const size_t recLen = 4 + (2 * size_t(binColumns));
+        if(len - pos < recLen) { return(false); }
+        const uint8_t *const r = mem + pos;
+        s.t = uint32_t(r[0]) | (uint32_t(r[1]) << 8) | (uint32_t(r[2]) << 16) | (uint32_t(r[3]) << 24);
+        s.columns = binColumns;
+        for(uint8_t i = 0; i < binColumns; ++i)
+            { s.v[i] = int16_t(uint16_t(r[4 + (2*i)]) | (uint16_t(r[5 + (2*i)]) << 8)); }
+        pos += recLen;
+        return(true);
+        }
+    while(pos < len)
+        {
+        const uint8_t *const lineStart = mem + pos;
+        const uint8_t *const nl = static_cast<const uint8_t *>(memchr(lineStart, '\n', len - pos));
+        const uint8_t *const lineEnd = (NULL == nl) ? (mem + len) : nl;
+        pos = (NULL == nl) ? len : size_t(nl + 1 - mem);
+        if(parseLine(lineStart, lineEnd, s)) { return(true); }
+        }
+    return(false);
+    }
+
+bool writeBinaryTimeSeries(const char *const path, const TimeSeriesSample *const samples, const size_t n, const uint8_t columns)
+    {
+    if((NULL == path) || ((NULL == samples) && (0 != n)) || (0 == columns) || (columns > TimeSeriesSample::MAX_COLUMNS))
+        { errno = EINVAL; return(false); }
+    FILE *const f = fopen(path, "wb");
+    if(NULL == f) { return(false); }
+    uint8_t header[MappedTimeSeries::BINARY_HEADER_LEN];
+    memcpy(header, binaryMagic, sizeof(binaryMagic));
+    header[4] = binaryVersion;
+    header[5] = columns;
+    bool ok = (1 == fwrite(header, sizeof(header), 1, f));
+    for(size_t i = 0; ok && (i < n); ++i)
+        {
+        const TimeSeriesSample &s = samples[i];
+        uint8_t r[4 + (2 * TimeSeriesSample::MAX_COLUMNS)];
+        r[0] = uint8_t(s.t); r[1] = uint8_t(s.t >> 8); r[2] = uint8_t(s.t >> 16); r[3] = uint8_t(s.t >> 24);
+        for(uint8_t c = 0; c < columns; ++c)
+            {
+            // Missing columns are written as 0.
+            const uint16_t v = (c < s.columns) ? uint16_t(s.v[c]) : 0;
+            r[4 + (2*c)] = uint8_t(v); r[5 + (2*c)] = uint8_t(v >> 8);
+            }
+        ok = (1 == fwrite(r, 4 + (2 * size_t(columns)), 1, f));
+        }
+    const int e = errno;
+    if((0 != fclose(f)) && ok) { return(false); }
+    if(!ok) { errno = e; }
+    return(ok);
+    }
+
+
+}
+
+#endif // OTV0P2BASE_TIME_SERIES_PLAYBACK_AVAILABLE
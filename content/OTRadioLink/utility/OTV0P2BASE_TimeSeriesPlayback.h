@@ -0,0 +1,208 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Host-side playback of recorded sensor time series into sensor mocks.
+
+ MappedTimeSeries maps a trace file read-only and steps through its samples,
+ so that simulators, benchmarks and tests can use large real-world datasets
+ without compiling them in.
+ SensorPlayback then drives any mocks with a set() method
+ (eg SensorAmbientLightAdaptiveMock, TemperatureC16Mock)
+ from chosen columns as virtual time advances,
+ holding each value until the next sample.
+
+ Trace files are either CSV text or binary.
+
+ CSV: one sample per line, fields separated by commas and/or spaces:
+    time value0 [value1 ...]
+ where time is whole seconds, or colon-separated as M:S, H:M:S or D:H:M:S
+ (eg from OpenTRV log day/hour/minute columns as D:H:M:0).
+ Values are signed decimal integers (up to MAX_COLUMNS).
+ Blank lines and lines starting with '#' are skipped,
+ as are lines that do not parse.
+ Times should be non-decreasing.
+
+ Binary (much faster to scan for big datasets), all little-endian:
+    "OTTS" magic, version (1), columns (1 byte, [1,MAX_COLUMNS]),
+    then per sample: uint32 time (s), columns x int16 values.
+ writeBinaryTimeSeries() converts to this format.
+
+ Only available on POSIX hosts, when OTV0P2BASE_TIME_SERIES_PLAYBACK_AVAILABLE is defined.
+ */
+
+#ifndef OTV0P2BASE_TIMESERIESPLAYBACK_H
+#define OTV0P2BASE_TIMESERIESPLAYBACK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if !defined(ARDUINO_ARCH_AVR) && (defined(__unix__) || defined(__APPLE__))
+#define OTV0P2BASE_TIME_SERIES_PLAYBACK_AVAILABLE
+#endif
+
+#ifdef OTV0P2BASE_TIME_SERIES_PLAYBACK_AVAILABLE
+
+namespace OTV0P2BASE
+{
+
+
+// One sample from a trace: a time and one or more column values.
+struct TimeSeriesSample final
+    {
+    static constexpr uint8_t MAX_COLUMNS = 8;
+    // Virtual time, seconds.
+    uint32_t t = 0;
+    // Number of valid entries in v.
+    uint8_t columns = 0;
+    int16_t v[MAX_COLUMNS] = { };
+    };
+
+// Trace file mapped read-only into memory, read sequentially.
+// Not thread-safe: give each thread its own instance.
+class MappedTimeSeries final
+    {
+    private:
+        const uint8_t *mem = NULL;
+        size_t len = 0;
+        // True for the binary format.
+        bool binary = false;
+        // Columns per sample for the binary format.
+        uint8_t binColumns = 0;
+        // Offset of the next sample (or line) to read.
+        size_t pos = 0;
+        // Offset of the first sample.
+        size_t start = 0;
+
+    public:
+        static constexpr uint8_t BINARY_HEADER_LEN = 6;
+
+        MappedTimeSeries() { }
+        // Opens path as open(); check isOpen().
+        explicit MappedTimeSeries(const char *path) { open(path); }
+        ~MappedTimeSeries() { close(); }
+        MappedTimeSeries(const MappedTimeSeries &) = delete;
+        MappedTimeSeries &operator=(const MappedTimeSeries &) = delete;
+
+        // Map the trace at path, detecting its format.
+        // Closes any trace already open.
+        // Returns false (with errno set) on failure, eg for an empty file or bad binary header.
+        bool open(const char *path);
+        // Unmap the trace.
+        void close();
+
+        bool isOpen() const { return(NULL != mem); }
+        bool isBinary() const { return(binary); }
+
+        // Fetch the next sample; returns false at the end.
+        bool next(TimeSeriesSample &s);
+        // Start again from the first sample.
+        void rewind() { pos = start; }
+    };
+
+// Write n samples each with the given number of columns [1,MAX_COLUMNS] as a binary trace.
+// Returns false (with errno set) on failure.
+bool writeBinaryTimeSeries(const char *path, const TimeSeriesSample *samples, size_t n, uint8_t columns);
+
+// Plays a MappedTimeSeries into bound sensor mocks by virtual time.
+// Each bound column's value is set() on its mock when a sample at or before the current time is reached;
+// columns missing from a sample leave the mock unchanged.
+// Does not call read() on the mocks: the caller does that as the real system would.
+//   * maxBindings  mocks that can be bound
+template<uint8_t maxBindings = 4>
+class SensorPlayback final
+    {
+    private:
+        struct Binding
+            {
+            uint8_t column;
+            void *mock;
+            void (*set)(void *mock, int16_t v);
+            };
+        MappedTimeSeries &ts;
+        Binding bindings[maxBindings];
+        uint8_t nBindings = 0;
+        // Next sample, not yet applied, if haveNext.
+        TimeSeriesSample pending;
+        bool haveNext = false;
+        bool started = false;
+        // Samples applied so far.
+        uint32_t applied = 0;
+
+        // Values are converted to the set() argument type as for a plain call.
+        template<class mock_t>
+        static void setMock(void *const mock, const int16_t v) { static_cast<mock_t *>(mock)->set(v); }
+
+        void fetch() { haveNext = ts.next(pending); }
+
+    public:
+        explicit SensorPlayback(MappedTimeSeries &ts_) : ts(ts_) { }
+
+        // Drive mock from column; mock must have a one-argument set(), eg set(uint8_t) or set(int16_t).
+        // Returns false if out of bindings or column is out of range.
+        template<class mock_t>
+        bool bind(const uint8_t column, mock_t &mock)
+            {
+            if((nBindings >= maxBindings) || (column >= TimeSeriesSample::MAX_COLUMNS)) { return(false); }
+            bindings[nBindings++] = { column, &mock, &setMock<mock_t> };
+            return(true);
+            }
+
+        // Time of the next sample not yet applied, or false at the end of the trace.
+        bool peekTime(uint32_t &t)
+            {
+            if(!started) { started = true; fetch(); }
+            if(!haveNext) { return(false); }
+            t = pending.t;
+            return(true);
+            }
+
+        // Apply all samples at or before virtual time now (s) in order.
+        // Returns the number of samples applied.
+        uint32_t advanceTo(const uint32_t now)
+            {
+            uint32_t n = 0;
+            uint32_t t;
+            while(peekTime(t) && (t <= now))
+                {
+                for(uint8_t i = 0; i < nBindings; ++i)
+                    {
+                    const Binding &b = bindings[i];
+                    if(b.column < pending.columns) { b.set(b.mock, pending.v[b.column]); }
+                    }
+                ++n;
+                fetch();
+                }
+            applied += n;
+            return(n);
+            }
+
+        // True once every sample has been applied.
+        bool isFinished() { uint32_t t; return(!peekTime(t)); }
+        uint32_t getApplied() const { return(applied); }
+
+        // Start again from the beginning of the trace.
+        void rewind() { ts.rewind(); started = false; haveNext = false; applied = 0; }
+    };
+
+
+}
+
+#endif // OTV0P2BASE_TIME_SERIES_PLAYBACK_AVAILABLE
+
+#endif
@@ -0,0 +1,50 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Low-overhead hot-path tracing.
+ */
+
+#include "OTV0P2BASE_Trace.h"
+
+#include "OTV0P2BASE_RTC.h"
+#include "OTV0P2BASE_Sleep.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+#ifdef OTV0P2BASE_TRACE
+// Global instance.
+TraceRing<OTV0P2BASE_TRACE_ENTRIES> traceRing;
+
+void traceRecord(const uint8_t id, const uint16_t value)
+    {
+#if defined(ARDUINO_ARCH_AVR) || defined(V0P2BASE_EFR32_SUBCYCLE)
+    const uint16_t ticks = uint16_t(getMonotonicTicks());
+#else
+    // No sub-cycle clock on this platform.
+    const uint16_t ticks = 0;
+#endif
+    traceRing.record(ticks, id, value);
+    }
+#endif // OTV0P2BASE_TRACE
+
+
+}
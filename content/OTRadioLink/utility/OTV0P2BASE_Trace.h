@@ -0,0 +1,183 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Low-overhead hot-path tracing.
+
+ OT_TRACE(id, value) records (monotonic time, id, value) into a small
+ static ring buffer, cheap enough to use in ISRs,
+ so that latency timelines can be recovered from field units
+ (eg with the CLI::DumpTrace command).
+
+ Tracing is enabled by defining OTV0P2BASE_TRACE for the whole build
+ (optionally with OTV0P2BASE_TRACE_ENTRIES to size the ring);
+ otherwise OT_TRACE() compiles to nothing and its arguments are not evaluated.
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_TRACE_H
+#define OTV0P2BASE_TRACE_H
+
+#include <stdint.h>
+
+#include "OTV0P2BASE_Concurrency.h"
+
+#ifdef OTV0P2BASE_TRACE
+#ifndef OTV0P2BASE_TRACE_ENTRIES
+#define OTV0P2BASE_TRACE_ENTRIES 32
+#endif
+// Record id (a TraceId value) and a 16-bit value against the current monotonic time.
+// ISR-safe.
+#define OT_TRACE(id, value) ::OTV0P2BASE::traceRecord(uint8_t(id), uint16_t(value))
+#else
+#define OT_TRACE(id, value) do { } while(false)
+#endif
+
+
+namespace OTV0P2BASE
+{
+
+
+// Standard trace point ids for OT_TRACE().
+// Applications may use values from APP upwards for their own trace points.
+namespace TraceId
+    {
+    // Radio ISR/poll entered; value is the interrupt status.
+    static constexpr uint8_t RADIO_ISR = 1;
+    // Radio frame queued; value is its length.
+    static constexpr uint8_t RADIO_RX_QUEUED = 2;
+    // Radio frame dropped for lack of queue space; value is the channel.
+    static constexpr uint8_t RADIO_RX_DROPPED = 3;
+    // Frame committed to an RX queue; value is its length.
+    static constexpr uint8_t RXQ_LOADED = 8;
+    // Frame removed from an RX queue; value is 1 if more frames remain.
+    static constexpr uint8_t RXQ_REMOVED = 9;
+    // Secure frame decode started; value is the frame length.
+    static constexpr uint8_t SECURE_DECODE_START = 16;
+    // Secure frame decode finished; value is non-zero on success.
+    static constexpr uint8_t SECURE_DECODE_END = 17;
+    // Valve motor driver changed state; value is the new state.
+    static constexpr uint8_t VALVE_STATE = 24;
+    // Entering the end-of-cycle sleep; value is the current TIME_LSD.
+    static constexpr uint8_t SLEEP_ENTER = 32;
+    // Left the end-of-cycle sleep; value is the new TIME_LSD.
+    static constexpr uint8_t SLEEP_EXIT = 33;
+    // First application-defined trace point.
+    static constexpr uint8_t APP = 128;
+    }
+
+// One trace record.
+struct TraceEntry final
+    {
+    // Low 8 bits of the monotonic cycle count when recorded,
+    // so that entries from successive cycles can be put in order (over ~8 minutes).
+    uint8_t cycle;
+    // Sub-cycle time when recorded.
+    uint8_t sct;
+    // Trace point, eg from TraceId.
+    uint8_t id;
+    // Trace-point-specific value.
+    uint16_t value;
+    };
+
+// Ring buffer of the most recent trace entries, overwriting the oldest when full.
+// record() is ISR-safe and briefly blocks interrupts;
+// readers should pause() recording while walking the entries with get().
+//   * entries  capacity; in [1,255]
+template<uint8_t entries = 32>
+class TraceRing final
+    {
+    static_assert(entries > 0, "need at least one entry");
+
+    private:
+        TraceEntry ring[entries];
+        // Index of next entry to write.
+        volatile uint8_t head = 0;
+        // Entries held, up to entries.
+        volatile uint8_t count = 0;
+        // Entries overwritten since last clear(), saturating at 255.
+        volatile uint8_t overwritten = 0;
+        // If true then record() does nothing.
+        volatile bool paused = false;
+
+    public:
+        constexpr TraceRing() : ring() { }
+
+        // Record an entry, overwriting the oldest if full.
+        //   * ticks  low 16 bits of the monotonic ticks (see getMonotonicTicks()),
+        //     or just the sub-cycle time
+        // ISR-safe.
+        void record(const uint16_t ticks, const uint8_t id, const uint16_t value)
+            {
+            RAII_AtomicBlock atomic;
+            if(paused) { return; }
+            const uint8_t h = head;
+            TraceEntry &e = ring[h];
+            e.cycle = uint8_t(ticks >> 8);
+            e.sct = uint8_t(ticks);
+            e.id = id;
+            e.value = value;
+            head = (h + 1 >= entries) ? 0 : uint8_t(h + 1);
+            if(count < entries) { count = count + 1; }
+            else if(overwritten < 255) { overwritten = overwritten + 1; }
+            }
+
+        // Suspend (true) or resume (false) recording, eg while dumping.
+        void pause(const bool p) { paused = p; }
+        bool isPaused() const { return(paused); }
+
+        // Number of entries held.
+        uint8_t size() const { return(count); }
+        static constexpr uint8_t capacity() { return(entries); }
+        // Entries lost to overwriting since last clear(), saturating at 255.
+        uint8_t getOverwritten() const { return(overwritten); }
+
+        // Fetch the i-th oldest entry (from 0); returns false if i >= size().
+        // Consistent only while recording is paused.
+        bool get(const uint8_t i, TraceEntry &out) const
+            {
+            const uint8_t c = count;
+            if(i >= c) { return(false); }
+            const uint16_t idx = uint16_t(head) + entries - c + i;
+            out = ring[idx % entries];
+            return(true);
+            }
+
+        // Discard all entries.
+        void clear()
+            {
+            RAII_AtomicBlock atomic;
+            head = 0;
+            count = 0;
+            overwritten = 0;
+            }
+    };
+
+#ifdef OTV0P2BASE_TRACE
+// The global trace ring written by OT_TRACE().
+extern TraceRing<OTV0P2BASE_TRACE_ENTRIES> traceRing;
+// Record into traceRing at the current monotonic time; use via OT_TRACE().
+// ISR-safe.
+void traceRecord(uint8_t id, uint16_t value);
+#endif
+
+
+}
+
+#endif
@@ -81,6 +81,13 @@ template <class T> constexpr const T fnabs(const T& a) { return((a<0)?(-a):(a));
 // Empty struct type as a placeholder.
 struct emptyStruct { };
 
+// Compile-time tag for whether an optional object passed as a pointer template argument is present,
+// eg OptionalTag<(nullptr != p)>(), to choose between a pair of overloads.
+// The overload for an absent object does nothing with the pointer,
+// and the other is never instantiated, so no member call through a null pointer
+// is ever formed (which g++ -Wnonnull rejects even in dead code).
+template<bool present> struct OptionalTag final { };
+
 // Extract ASCII hex digit in range [0-9][a-f] (ie lowercase) from bottom 4 bits of argument.
 // Eg, passing in 0xa (10) returns 'a'.
 // The top 4 bits are ignored.
@@ -211,6 +218,97 @@ class ScratchSpaceTemplate final
 
 using ScratchSpace = ScratchSpaceTemplate<uint8_t>;
 
+// Scratch space usage profiling, to size scratch buffers from measurement.
+// A ScratchSpaceProbe poisons the scratch space on creation
+// and on destruction records into a per-call-site ScratchSpaceUsage
+// the high-water mark, ie how far into the space was written.
+// Bytes written with the poison value itself are not seen,
+// so the mark may be a little low; allow a small margin.
+// Use the OTV0P2BASE_SCRATCH_PROBE() macro at call sites
+// so that probes are compiled in only with OTV0P2BASE_SCRATCH_PROFILING.
+static constexpr uint8_t SCRATCH_SPACE_POISON = 0xa5;
+struct ScratchSpaceUsage final
+  {
+  // Most bytes used from the start of the space in any probed call.
+  size_t highWater = 0;
+  // Smallest space seen at this site; 0 until first probed.
+  size_t minSize = 0;
+  // Probed calls, saturating.
+  uint16_t calls = 0;
+  };
+// Bytes from the start of buf up to and including the last not still poisoned.
+inline size_t scratchSpaceUsed(const uint8_t *const buf, size_t size)
+  {
+  if(NULL == buf) { return(0); }
+  while((size > 0) && (SCRATCH_SPACE_POISON == buf[size - 1])) { --size; }
+  return(size);
+  }
+class ScratchSpaceProbe final
+  {
+  private:
+    const ScratchSpaceL &s;
+    ScratchSpaceUsage &usage;
+  public:
+    ScratchSpaceProbe(const ScratchSpaceL &s_, ScratchSpaceUsage &usage_) : s(s_), usage(usage_)
+      { if(NULL != s.buf) { memset(s.buf, SCRATCH_SPACE_POISON, s.bufsize); } }
+    ~ScratchSpaceProbe()
+      {
+      const size_t used = scratchSpaceUsed(s.buf, s.bufsize);
+      if(used > usage.highWater) { usage.highWater = used; }
+      if((0 == usage.calls) || (s.bufsize < usage.minSize)) { usage.minSize = s.bufsize; }
+      if(usage.calls < 0xffff) { ++usage.calls; }
+      }
+    ScratchSpaceProbe(const ScratchSpaceProbe &) = delete;
+    ScratchSpaceProbe &operator=(const ScratchSpaceProbe &) = delete;
+  };
+#if defined(OTV0P2BASE_SCRATCH_PROFILING)
+// Probe scratch space s for the rest of the enclosing scope, recording into ScratchSpaceUsage u.
+#define OTV0P2BASE_SCRATCH_PROBE(s, u) ::OTV0P2BASE::ScratchSpaceProbe _scratchSpaceProbe((s), (u))
+#else
+#define OTV0P2BASE_SCRATCH_PROBE(s, u) do { } while(false)
+#endif
+
+// One static scratch arena shared between mutually-exclusive operations,
+// eg secure frame TX and RX, rather than each having its own stack buffer.
+// A Lease holds the arena for its lifetime; if the arena is already held
+// the Lease's space is empty (NULL and 0-sized), which callers of
+// scratch-space routines already treat as an error, so misuse fails safe.
+// Not thread-/ISR- safe: use only from one (main-loop) context.
+//   * arenaSize  bytes; size from the high-water marks of the sharing operations
+template<size_t arenaSize>
+class SharedScratchArena final
+  {
+  static_assert(arenaSize > 0, "arenaSize must be strictly positive");
+
+  private:
+    uint8_t buf[arenaSize];
+    bool inUse = false;
+    bool tryAcquire() { if(inUse) { return(false); } inUse = true; return(true); }
+
+  public:
+    SharedScratchArena() : buf() { }
+
+    // True while a Lease holds the arena.
+    bool isInUse() const { return(inUse); }
+
+    class Lease final
+      {
+      private:
+        SharedScratchArena &arena;
+        const bool held;
+      public:
+        // The arena, or empty if not held.
+        ScratchSpaceL space;
+        explicit Lease(SharedScratchArena &a)
+          : arena(a), held(a.tryAcquire()), space(held ? a.buf : NULL, held ? arenaSize : 0) { }
+        ~Lease() { if(held) { arena.inUse = false; } }
+        // True if this holds the arena.
+        bool isHeld() const { return(held); }
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+      };
+  };
+
 // Diagnostic tools for memory problems.
 // Arduino AVR memory layout: DATA, BSS [_end, __bss_end], (HEAP,) [SP] STACK [RAMEND]
 // See: http://web-engineering.info/node/30
@@ -0,0 +1,139 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Registry of wake-up deadlines for tickless sleep.
+
+ Tasks that need the CPU awake at a particular time
+ (eg a radio listen window, a sensor poll, stats TX, a motor move, a CLI timeout)
+ register a one-shot deadline; the sleep layer then sleeps in one stretch
+ to the earliest, rather than waking regularly to check for work.
+ See sleepUntilNewCycleOrDeadline() in OTV0P2BASE_Sleep.h.
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_WAKEDEADLINES_H
+#define OTV0P2BASE_WAKEDEADLINES_H
+
+#include <stdint.h>
+
+#include "OTV0P2BASE_RTC.h"
+
+
+namespace OTV0P2BASE
+{
+
+
+// One-shot wake deadlines, one per slot, in sub-cycle ticks from the start of the current basic cycle.
+// Each task uses its own fixed slot number, eg from an application enum.
+// Deadlines in later cycles are held as ticks beyond this cycle's 256,
+// and brought forward by newCycle() at each cycle roll;
+// the furthest that can be held is ~255 cycles ahead (~8 minutes with 2s cycles).
+// Not thread-safe nor usable from ISRs.
+//   * slots  number of slots; in [1,16]
+template<uint8_t slots = 8>
+class WakeDeadlines final
+    {
+    static_assert((slots > 0) && (slots <= 16), "slots must be in [1,16]");
+
+    public:
+        // Sub-cycle ticks per basic cycle.
+        static constexpr uint16_t TICKS_PER_CYCLE = 256;
+        // No deadline set.
+        static constexpr uint16_t NONE = 0xffff;
+
+    private:
+        // Deadline ticks from the start of this cycle, or NONE.
+        uint16_t deadline[slots];
+        // Ticks per second, for setInSeconds().
+        const uint8_t ticksPerS;
+
+    public:
+        //   * ticksPerS_  sub-cycle ticks per second, eg SUB_CYCLE_TICKS_PER_S
+        explicit WakeDeadlines(const uint8_t ticksPerS_ = 128) : ticksPerS(ticksPerS_)
+            { clearAll(); }
+
+        // Set the deadline for slot to ticks from the start of this cycle, replacing any previous one.
+        // Values at or after NONE are held as NONE-1.
+        void setAt(const uint8_t slot, const uint16_t ticksFromCycleStart)
+            {
+            if(slot >= slots) { return; }
+            deadline[slot] = (ticksFromCycleStart >= NONE) ? uint16_t(NONE - 1) : ticksFromCycleStart;
+            }
+        // Set the deadline for slot to ticks after now.
+        //   * subCycleTime  getSubCycleTime() now
+        void setInTicks(const uint8_t slot, const uint8_t subCycleTime, const uint16_t ticks)
+            {
+            const uint32_t t = uint32_t(subCycleTime) + ticks;
+            setAt(slot, (t >= NONE) ? uint16_t(NONE - 1) : uint16_t(t));
+            }
+        // Set the deadline for slot to seconds after now.
+        void setInSeconds(const uint8_t slot, const uint8_t subCycleTime, const uint8_t seconds)
+            { setInTicks(slot, subCycleTime, uint16_t(uint16_t(seconds) * ticksPerS)); }
+        // Set the deadline for slot at an absolute monotonic time, eg from a stored timeout;
+        // a deadline already reached is due now.
+        //   * nowTicks  getMonotonicTicks() now
+        //   * deadlineTicks  monotonic ticks at which to wake
+        void setAtMonotonic(const uint8_t slot, const uint32_t nowTicks, const uint32_t deadlineTicks)
+            {
+            const uint32_t ahead = monotonicReached(nowTicks, deadlineTicks) ? 0 : (deadlineTicks - nowTicks);
+            setInTicks(slot, uint8_t(nowTicks), (ahead >= NONE) ? uint16_t(NONE - 1) : uint16_t(ahead));
+            }
+        // Set the deadline for slot only if it is sooner than any already set.
+        void setNoLaterThan(const uint8_t slot, const uint16_t ticksFromCycleStart)
+            { if((slot < slots) && (ticksFromCycleStart < deadline[slot])) { setAt(slot, ticksFromCycleStart); } }
+
+        // Remove the deadline for slot.
+        void clear(const uint8_t slot) { if(slot < slots) { deadline[slot] = NONE; } }
+        // Remove all deadlines.
+        void clearAll() { for(uint8_t i = 0; i < slots; ++i) { deadline[i] = NONE; } }
+        // Remove all deadlines at or before subCycleTime in this cycle, ie whose wake has happened.
+        void clearDue(const uint8_t subCycleTime)
+            { for(uint8_t i = 0; i < slots; ++i) { if(deadline[i] <= subCycleTime) { deadline[i] = NONE; } } }
+
+        // Deadline for slot in ticks from the start of this cycle, or NONE.
+        uint16_t get(const uint8_t slot) const { return((slot < slots) ? deadline[slot] : NONE); }
+        // True if slot has a deadline at or before subCycleTime in this cycle.
+        bool isDue(const uint8_t slot, const uint8_t subCycleTime) const { return(get(slot) <= subCycleTime); }
+
+        // Earliest deadline in ticks from the start of this cycle, or NONE.
+        uint16_t next() const
+            {
+            uint16_t n = NONE;
+            for(uint8_t i = 0; i < slots; ++i) { if(deadline[i] < n) { n = deadline[i]; } }
+            return(n);
+            }
+
+        // Call once at the start of each new basic cycle.
+        // Deadlines left from the previous cycle become due at tick 0.
+        void newCycle()
+            {
+            for(uint8_t i = 0; i < slots; ++i)
+                {
+                uint16_t &d = deadline[i];
+                if(NONE == d) { continue; }
+                d = (d > TICKS_PER_CYCLE) ? uint16_t(d - TICKS_PER_CYCLE) : 0;
+                }
+            }
+    };
+
+
+}
+
+#endif
@@ -0,0 +1,158 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ Wake-time profiling support.
+
+ Firmware marks which subsystem is running with OTV0P2BASE_WAKE_PROFILE_MARK();
+ on AVR builds with OTV0P2BASE_WAKE_PROFILING defined this is a single write
+ of the subsystem number to the otherwise unused GPIOR0 register,
+ which a simulator (see dev/avr_energy_sim) can watch at no cost to timing;
+ otherwise it compiles to nothing.
+
+ WakeTimeProfile accumulates awake CPU cycles per subsystem from such marks
+ and from sleep/wake transitions, and scales them to cycles per hour.
+
+ Portable.
+ */
+
+#ifndef OTV0P2BASE_WAKEPROFILE_H
+#define OTV0P2BASE_WAKEPROFILE_H
+
+#include <stdint.h>
+
+#if defined(OTV0P2BASE_WAKE_PROFILING) && defined(ARDUINO_ARCH_AVR)
+#include <avr/io.h>
+// Record that subsystem id (a WakeProfileSubsystem value, or an application value) is now running.
+#define OTV0P2BASE_WAKE_PROFILE_MARK(id) do { GPIOR0 = (uint8_t)(id); } while(false)
+#else
+#define OTV0P2BASE_WAKE_PROFILE_MARK(id) do { } while(false)
+#endif
+
+
+namespace OTV0P2BASE
+{
+
+
+// Standard subsystem numbers for OTV0P2BASE_WAKE_PROFILE_MARK().
+// Applications may use values from APP upwards for their own subsystems.
+namespace WakeProfileSubsystem
+    {
+    // Start-up, before any other mark.
+    static constexpr uint8_t BOOT = 0;
+    // sleepUntilNewCycle() and friends, including ISRs that wake but do not leave it.
+    static constexpr uint8_t SLEEP_LOOP = 1;
+    // Main loop bookkeeping.
+    static constexpr uint8_t MAIN = 2;
+    static constexpr uint8_t SENSORS = 3;
+    static constexpr uint8_t RADIO = 4;
+    static constexpr uint8_t VALVE = 5;
+    static constexpr uint8_t STATS = 6;
+    static constexpr uint8_t CLI = 7;
+    static constexpr uint8_t CRYPTO = 8;
+    // First application-defined subsystem.
+    static constexpr uint8_t APP = 16;
+    }
+
+// Accumulates awake CPU cycles per subsystem over a run, eg of a simulated MCU.
+// Cycles are attributed to the subsystem most recently marked while the CPU is awake.
+// Subsystem numbers at or above subsystems are all counted in the last slot.
+// Not thread-safe.
+//   * subsystems  number of distinct subsystems counted; in [2,255]
+template<uint8_t subsystems = 32>
+class WakeTimeProfile final
+    {
+    static_assert(subsystems >= 2, "need at least 2 subsystems");
+
+    private:
+        uint64_t awake[subsystems];
+        uint64_t asleep = 0;
+        uint64_t wakeups = 0;
+        // Cycle count up to which time has been attributed.
+        uint64_t lastCycle = 0;
+        // Cycle count at the start of the run.
+        uint64_t startCycle = 0;
+        uint8_t current = WakeProfileSubsystem::BOOT;
+        bool sleeping = false;
+
+        static uint8_t slot(const uint8_t id) { return((id < subsystems) ? id : uint8_t(subsystems - 1)); }
+
+    public:
+        //   * start  cycle count at the start of the run
+        explicit WakeTimeProfile(const uint64_t start = 0) : awake(), lastCycle(start), startCycle(start) { }
+
+        // Attribute the time up to cycle to the current state; ignores time going backwards.
+        void advance(const uint64_t cycle)
+            {
+            if(cycle <= lastCycle) { return; }
+            const uint64_t d = cycle - lastCycle;
+            if(sleeping) { asleep += d; } else { awake[slot(current)] += d; }
+            lastCycle = cycle;
+            }
+        // Subsystem id starts running at cycle.
+        void mark(const uint8_t id, const uint64_t cycle) { advance(cycle); current = id; }
+        // CPU goes to sleep at cycle.
+        void sleep(const uint64_t cycle) { advance(cycle); sleeping = true; }
+        // CPU wakes at cycle.
+        void wake(const uint64_t cycle)
+            {
+            advance(cycle);
+            if(sleeping) { ++wakeups; }
+            sleeping = false;
+            }
+
+        // Current (most recently marked) subsystem.
+        uint8_t getCurrent() const { return(current); }
+        bool isSleeping() const { return(sleeping); }
+
+        // Awake cycles attributed to subsystem id.
+        uint64_t getAwakeCycles(const uint8_t id) const { return(awake[slot(id)]); }
+        // Total awake cycles.
+        uint64_t getTotalAwakeCycles() const
+            {
+            uint64_t t = 0;
+            for(uint8_t i = 0; i < subsystems; ++i) { t += awake[i]; }
+            return(t);
+            }
+        uint64_t getSleepCycles() const { return(asleep); }
+        // Cycles accounted for since the start of the run.
+        uint64_t getElapsedCycles() const { return(lastCycle - startCycle); }
+        // Number of wakes from sleep.
+        uint64_t getWakeups() const { return(wakeups); }
+
+        // Scale a count over the run to the equivalent per hour of run time at cpuHz; 0 if no time has passed.
+        double perHour(const uint64_t count, const uint32_t cpuHz) const
+            {
+            const uint64_t e = getElapsedCycles();
+            if(0 == e) { return(0); }
+            return((double(count) * 3600.0 * double(cpuHz)) / double(e));
+            }
+        // Awake cycles per hour for subsystem id.
+        double awakeCyclesPerHour(const uint8_t id, const uint32_t cpuHz) const { return(perHour(getAwakeCycles(id), cpuHz)); }
+        // Fraction of the run spent awake, in [0,1].
+        double dutyCycle() const
+            {
+            const uint64_t e = getElapsedCycles();
+            return((0 == e) ? 0 : (double(getTotalAwakeCycles()) / double(e)));
+            }
+    };
+
+
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Representative TRV main-loop scenario for the simavr wake-time profiler.
+ *
+ * Sleeps with the real OTV0P2BASE sleep/power-management code between 2s cycles,
+ * and each cycle does a cut-down version of the V0p2 valve main loop:
+ * supply voltage and once-a-minute valve model tick,
+ * stats rendering and framing every 4 minutes in place of TX.
+ * Each piece of work is bracketed with OTV0P2BASE_WAKE_PROFILE_MARK().
+ *
+ * Build with OTV0P2BASE_WAKE_PROFILING defined; see ../README.md.
+ */
+
+#include <OTV0p2Base.h>
+#include <OTRadValve.h>
+#include <OTRadioLink.h>
+
+namespace WPS = OTV0P2BASE::WakeProfileSubsystem;
+
+static OTV0P2BASE::SupplyVoltageCentiVolts supply;
+static OTRadValve::ModelledRadValveState<> valveModel;
+static OTRadValve::ModelledRadValveInputState valveInput(18 << 4);
+static uint8_t valvePC = 0;
+static OTV0P2BASE::SimpleStatsRotation<6> stats;
+
+static uint_fast8_t TIME_LSD;
+// Basic 2s cycles since start.
+static uint8_t cycles;
+
+void setup()
+  {
+  OTV0P2BASE::powerSetup();
+  valveInput.targetTempC = 19;
+  stats.setID(V0p2_SENSOR_TAG_F("f9ce"));
+  TIME_LSD = OTV0P2BASE::getSecondsLT();
+  }
+
+void loop()
+  {
+  TIME_LSD = OTV0P2BASE::sleepUntilNewCycle(TIME_LSD);
+  OTV0P2BASE_WAKE_PROFILE_MARK(WPS::MAIN);
+  ++cycles;
+
+  // Once a minute: sensors and valve model.
+  if(0 == (cycles % 30))
+    {
+    OTV0P2BASE_WAKE_PROFILE_MARK(WPS::SENSORS);
+    supply.read();
+    OTV0P2BASE_WAKE_PROFILE_MARK(WPS::VALVE);
+    valveInput.setReferenceTemperatures(int16_t((18 << 4) + (cycles & 0xf)));
+    valveModel.tick(valvePC, valveInput, NULL);
+    }
+
+  // Every 4 minutes: stats and a frame as for TX.
+  if(0 == (cycles % 120))
+    {
+    OTV0P2BASE_WAKE_PROFILE_MARK(WPS::STATS);
+    stats.put(V0p2_SENSOR_TAG_F("B|cV"), int16_t(supply.get()));
+    stats.put(V0p2_SENSOR_TAG_F("v|%"), int16_t(valvePC));
+    uint8_t json[OTV0P2BASE::MSG_JSON_MAX_LENGTH + 2];
+    const uint8_t jsonLen = stats.writeJSON(json, sizeof(json), 0, false);
+    OTV0P2BASE_WAKE_PROFILE_MARK(WPS::RADIO);
+    // Frame the start of the JSON as for TX; there is no radio to send it on.
+    uint8_t frame[OTRadioLink::SecurableFrameHeader::maxSmallFrameSize];
+    static const uint8_t id[] = { 0x88, 0x81, 0x82, 0x83 };
+    OTRadioLink::OTEncodeData_T fd(json, sizeof(json), frame, sizeof(frame));
+    fd.ptextLen = OTV0P2BASE::fnmin(jsonLen, uint8_t(8));
+    fd.fType = OTRadioLink::FTS_BasicSensorOrValve;
+    OTRadioLink::encodeNonsecure(fd, cycles, id, sizeof(id));
+    }
+  }
@@ -0,0 +1,173 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Cycle-accurate wake-time profiler for V0p2 firmware on a simulated ATmega328P.
+ *
+ * Runs a firmware ELF under simavr for a given span of simulated time,
+ * watching GPIOR0 for OTV0P2BASE_WAKE_PROFILE_MARK() subsystem marks
+ * and the simulated CPU sleep state,
+ * then reports awake cycles per hour broken down by subsystem.
+ * See README.md.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_io.h>
+
+#include "OTV0P2BASE_WakeProfile.h"
+
+
+namespace
+{
+
+// GPIOR0 in the ATmega328P data address space (I/O address 0x1e).
+constexpr avr_io_addr_t GPIOR0_ADDR = 0x3e;
+// Subsystems counted; anything higher is lumped into the last.
+constexpr uint8_t SUBSYSTEMS = 32;
+
+OTV0P2BASE::WakeTimeProfile<SUBSYSTEMS> profile;
+
+// Human-readable name for a subsystem number.
+const char *subsystemName(const uint8_t id, char *const buf, const size_t bufSize)
+    {
+    namespace WPS = OTV0P2BASE::WakeProfileSubsystem;
+    switch(id)
+        {
+        case WPS::BOOT: return("boot");
+        case WPS::SLEEP_LOOP: return("sleep_loop");
+        case WPS::MAIN: return("main");
+        case WPS::SENSORS: return("sensors");
+        case WPS::RADIO: return("radio");
+        case WPS::VALVE: return("valve");
+        case WPS::STATS: return("stats");
+        case WPS::CLI: return("cli");
+        case WPS::CRYPTO: return("crypto");
+        default: break;
+        }
+    if(SUBSYSTEMS - 1 == id) { return("other"); }
+    snprintf(buf, bufSize, "%s%u", (id >= WPS::APP) ? "app" : "sys", unsigned((id >= WPS::APP) ? (id - WPS::APP) : id));
+    return(buf);
+    }
+
+void onMark(avr_t *const avr, const avr_io_addr_t /*addr*/, const uint8_t v, void * /*param*/)
+    { profile.mark(v, avr->cycle); }
+
+void usage(const char *const argv0)
+    {
+    fprintf(stderr,
+        "Usage: %s [--hours=H] [--freq=HZ] [--mcu=NAME] [--json] firmware.elf\n"
+        "  --hours=H   simulated hours to run (default 1; fractions allowed)\n"
+        "  --freq=HZ   CPU clock (default 1000000, as V0p2 8MHz RC /8)\n"
+        "  --mcu=NAME  simavr core (default atmega328p)\n"
+        "  --json      machine-readable output\n", argv0);
+    }
+
+}
+
+
+int main(const int argc, char **const argv)
+    {
+    double hours = 1;
+    uint32_t freq = 1000000;
+    const char *mcu = "atmega328p";
+    bool json = false;
+    const char *elf = NULL;
+    for(int i = 1; i < argc; ++i)
+        {
+        const char *const a = argv[i];
+        if(0 == strncmp(a, "--hours=", 8)) { hours = atof(a + 8); }
+        else if(0 == strncmp(a, "--freq=", 7)) { freq = uint32_t(strtoul(a + 7, NULL, 10)); }
+        else if(0 == strncmp(a, "--mcu=", 6)) { mcu = a + 6; }
+        else if(0 == strcmp(a, "--json")) { json = true; }
+        else if('-' == a[0]) { usage(argv[0]); return(2); }
+        else { elf = a; }
+        }
+    if((NULL == elf) || !(hours > 0) || (0 == freq)) { usage(argv[0]); return(2); }
+
+    elf_firmware_t f;
+    memset(&f, 0, sizeof(f));
+    if(0 != elf_read_firmware(elf, &f)) { fprintf(stderr, "cannot read %s\n", elf); return(1); }
+    if('\0' == f.mmcu[0]) { strncpy(f.mmcu, mcu, sizeof(f.mmcu) - 1); }
+    f.frequency = freq;
+    avr_t *const avr = avr_make_mcu_by_name(f.mmcu);
+    if(NULL == avr) { fprintf(stderr, "unknown MCU %s\n", f.mmcu); return(1); }
+    avr_init(avr);
+    avr_load_firmware(avr, &f);
+    avr_register_io_write(avr, GPIOR0_ADDR, onMark, NULL);
+
+    // Step the simulation, noting each sleep/wake transition at the cycle it happens.
+    const uint64_t endCycle = uint64_t(hours * 3600.0 * freq);
+    int state = cpu_Running;
+    while(avr->cycle < endCycle)
+        {
+        state = avr_run(avr);
+        if((cpu_Done == state) || (cpu_Crashed == state)) { break; }
+        const bool nowSleeping = (cpu_Sleeping == state);
+        if(nowSleeping != profile.isSleeping())
+            {
+            if(nowSleeping) { profile.sleep(avr->cycle); }
+            else { profile.wake(avr->cycle); }
+            }
+        }
+    profile.advance(avr->cycle);
+    if(cpu_Crashed == state) { fprintf(stderr, "firmware crashed at cycle %llu\n", (unsigned long long)avr->cycle); }
+
+    // Report.
+    char nameBuf[16];
+    const double simHours = double(profile.getElapsedCycles()) / (3600.0 * freq);
+    const double awakePerHour = profile.perHour(profile.getTotalAwakeCycles(), freq);
+    if(json)
+        {
+        printf("{\n  \"firmware\": \"%s\",\n  \"cpu_hz\": %lu,\n  \"simulated_hours\": %.4f,\n", elf, (unsigned long)freq, simHours);
+        printf("  \"awake_cycles_per_hour\": %.0f,\n  \"wakeups_per_hour\": %.1f,\n  \"duty_cycle\": %.8f,\n",
+            awakePerHour, profile.perHour(profile.getWakeups(), freq), profile.dutyCycle());
+        printf("  \"subsystems\": [");
+        bool first = true;
+        for(uint8_t i = 0; i < SUBSYSTEMS; ++i)
+            {
+            if(0 == profile.getAwakeCycles(i)) { continue; }
+            printf("%s\n    { \"id\": %u, \"name\": \"%s\", \"awake_cycles_per_hour\": %.0f }",
+                first ? "" : ",", unsigned(i), subsystemName(i, nameBuf, sizeof(nameBuf)), profile.awakeCyclesPerHour(i, freq));
+            first = false;
+            }
+        printf("\n  ]\n}\n");
+        }
+    else
+        {
+        printf("Firmware %s on %s at %luHz for %.3f simulated hours\n", elf, f.mmcu, (unsigned long)freq, simHours);
+        printf("Awake %.0f cycles/h (%.1f ms/h), %.1f wakeups/h, duty cycle %.5f%%\n",
+            awakePerHour, (awakePerHour * 1000.0) / freq, profile.perHour(profile.getWakeups(), freq), profile.dutyCycle() * 100);
+        printf("%-12s %16s %12s %8s\n", "subsystem", "cycles/h", "ms/h", "%awake");
+        const uint64_t totalAwake = profile.getTotalAwakeCycles();
+        for(uint8_t i = 0; i < SUBSYSTEMS; ++i)
+            {
+            const uint64_t c = profile.getAwakeCycles(i);
+            if(0 == c) { continue; }
+            const double perH = profile.awakeCyclesPerHour(i, freq);
+            printf("%-12s %16.0f %12.2f %8.2f\n", subsystemName(i, nameBuf, sizeof(nameBuf)),
+                perH, (perH * 1000.0) / freq, (100.0 * double(c)) / double(totalAwake));
+            }
+        }
+    avr_terminate(avr);
+    return((cpu_Crashed == state) ? 1 : 0);
+    }
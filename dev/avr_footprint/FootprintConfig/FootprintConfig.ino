@@ -0,0 +1,150 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Representative REV configuration build for the AVR footprint report.
+ *
+ * Selects one OTV0p2_CONFIG_REV*.h configuration from a CONFIG_XXX macro
+ * given on the command line (default CONFIG_DORM1, ie REV7)
+ * and instantiates the library components that its ENABLE_XXX flags select,
+ * with the same template arguments as the V0p2 main firmware.
+ * Each component is used from setup()/loop() so that the linker keeps it;
+ * the sketch is never meant to be run.
+ *
+ * Built and measured by ../avr_footprint.py; see ../README.md.
+ */
+
+#if !defined(CONFIG_DORM1) && !defined(CONFIG_REV7_AS_SECURE_SENSOR) && \
+    !defined(CONFIG_REV10_SECURE_BHR) && !defined(CONFIG_REV11_SECURE_SENSOR) && \
+    !defined(CONFIG_REV11_SECURE_STATSHUB)
+#define CONFIG_DORM1
+#endif
+
+// Get defaults for valve applications.
+#include <OTV0p2_valve_ENABLE_defaults.h>
+// The selected configuration; each only acts on its own CONFIG_XXX.
+#include <OTV0p2_CONFIG_REV7.h>
+#include <OTV0p2_CONFIG_REV10.h>
+#include <OTV0p2_CONFIG_REV11.h>
+#include <OTV0p2_valve_ENABLE_fixups.h>
+// I/O pin allocation and setup: include ahead of I/O module headers.
+#include <OTV0p2_Board_IO_Config.h>
+
+#include <OTV0p2Base.h>
+#include <OTRadioLink.h>
+#include <OTRadValve.h>
+#if defined(ENABLE_RADIO_PRIMARY_RFM23B)
+#include <OTRFM23BLink.h>
+#endif
+#if defined(ENABLE_OTSECUREFRAME_ENCODING_SUPPORT)
+#include <OTAESGCM.h>
+#endif
+
+static OTV0P2BASE::SupplyVoltageCentiVolts Supply_cV;
+static OTV0P2BASE::SimpleStatsRotation<8> ss1;
+
+#if defined(ENABLE_LOCAL_TRV) || defined(ENABLE_SLAVE_TRV)
+static OTRadValve::ModelledRadValveState<> valveModel;
+static OTRadValve::ModelledRadValveInputState valveInput(18 << 4);
+#endif
+static uint8_t valvePC;
+
+#if defined(ENABLE_V1_DIRECT_MOTOR_DRIVE)
+static OTRadValve::ValveMotorDirectV1<OTRadValve::ValveMotorDirectV1HardwareDriver,
+    MOTOR_DRIVE_ML, MOTOR_DRIVE_MR, MOTOR_DRIVE_MI_AIN, MOTOR_DRIVE_MC_AIN,
+    OTRadValve::MOTOR_DRIVE_NSLEEP_UNUSED, decltype(Supply_cV), &Supply_cV,
+    false, OTRadValve::ValveCalibrationStoreBase, nullptr> ValveDirect;
+#endif
+
+#if defined(ENABLE_RADIO_PRIMARY_RFM23B)
+#if defined(ENABLE_RADIO_RX)
+static constexpr bool RFM23B_allowRX = true;
+#else
+static constexpr bool RFM23B_allowRX = false;
+#endif
+static constexpr uint8_t RFM23B_RX_QUEUE_SIZE = OTRFM23BLink::DEFAULT_RFM23B_RX_QUEUE_CAPACITY;
+OTRFM23BLink::OTRFM23BLink<OTV0P2BASE::V0p2_PIN_SPI_nSS, PIN_RFM_NIRQ, RFM23B_RX_QUEUE_SIZE, RFM23B_allowRX> PrimaryRadio;
+static const OTRadioLink::OTRadioChannelConfig RFM23BConfigs[1] = {
+    OTRadioLink::OTRadioChannelConfig(OTRFM23BLink::StandardRegSettingsGFSK57600, true), };
+#endif
+
+static uint_fast8_t TIME_LSD;
+
+void setup()
+  {
+  OTV0P2BASE::powerSetup();
+  ss1.setID(V0p2_SENSOR_TAG_F("f9ce"));
+#if defined(ENABLE_LOCAL_TRV) || defined(ENABLE_SLAVE_TRV)
+  valveInput.targetTempC = 19;
+#endif
+#if defined(ENABLE_RADIO_PRIMARY_RFM23B)
+  PrimaryRadio.configure(1, RFM23BConfigs);
+  PrimaryRadio.begin();
+#endif
+  TIME_LSD = OTV0P2BASE::getSecondsLT();
+  }
+
+void loop()
+  {
+  TIME_LSD = OTV0P2BASE::sleepUntilNewCycle(TIME_LSD);
+  Supply_cV.read();
+
+#if defined(ENABLE_V1_DIRECT_MOTOR_DRIVE)
+  ValveDirect.read();
+#endif
+#if defined(ENABLE_LOCAL_TRV) || defined(ENABLE_SLAVE_TRV)
+  valveInput.setReferenceTemperatures(int16_t((18 << 4) + (TIME_LSD & 0xf)));
+  valveModel.tick(valvePC, valveInput, NULL);
+#if defined(ENABLE_V1_DIRECT_MOTOR_DRIVE)
+  ValveDirect.set(valvePC);
+#endif
+#endif
+
+  ss1.put(V0p2_SENSOR_TAG_F("B|cV"), int16_t(Supply_cV.get()));
+  uint8_t json[OTV0P2BASE::MSG_JSON_MAX_LENGTH + 2];
+  const uint8_t jsonLen = ss1.writeJSON(json, sizeof(json), 0, false);
+
+#if defined(ENABLE_RADIO_PRIMARY_RFM23B)
+  uint8_t frame[OTRadioLink::SecurableFrameHeader::maxSmallFrameSize];
+#if defined(ENABLE_OTSECUREFRAME_ENCODING_SUPPORT)
+  // A fixed dummy key: keys are never handled by this sketch.
+  static const uint8_t key[16] = { 1 };
+  uint8_t scratch[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encodeValveFrame_total_scratch_usage_OTAESGCM_2p0];
+  OTV0P2BASE::ScratchSpaceL sW(scratch, sizeof(scratch));
+  OTRadioLink::OTEncodeData_T fd(json, sizeof(json), frame, sizeof(frame));
+  OTRadioLink::SimpleSecureFrame32or0BodyTXBase::fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t &e =
+      OTAESGCM::fixed32BTextSize12BNonce16BTagSimpleEnc_DEFAULT_WITH_LWORKSPACE;
+  (void)jsonLen;
+  const uint8_t frameLen = OTRadioLink::SimpleSecureFrame32or0BodyTXV0p2::getInstance().encodeValveFrame(
+      fd, 4, valvePC, e, sW, key);
+#else
+  static const uint8_t id[] = { 0x88, 0x81, 0x82, 0x83 };
+  OTRadioLink::OTEncodeData_T fd(json, sizeof(json), frame, sizeof(frame));
+  fd.ptextLen = OTV0P2BASE::fnmin(jsonLen, uint8_t(8));
+  fd.fType = OTRadioLink::FTS_BasicSensorOrValve;
+  const uint8_t frameLen = OTRadioLink::encodeNonsecure(fd, uint8_t(TIME_LSD), id, sizeof(id));
+#endif
+  if(0 != frameLen) { PrimaryRadio.sendRaw(frame, frameLen); }
+#if defined(ENABLE_RADIO_RX)
+  PrimaryRadio.poll();
+  if(NULL != PrimaryRadio.peekRXMsg()) { PrimaryRadio.removeRXMsg(); }
+#endif
+#else
+  (void)jsonLen;
+#endif
+  }
@@ -0,0 +1,338 @@
+#!/usr/bin/env python3
+# *************************************************************
+#
+# The OpenTRV project licenses this file to you
+# under the Apache Licence, Version 2.0 (the "Licence");
+# you may not use this file except in compliance
+# with the Licence. You may obtain a copy of the Licence at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the Licence is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied. See the Licence for the
+# specific language governing permissions and limitations
+# under the Licence.
+#
+# *************************************************************
+# Author(s) / Copyright (s): Damon Hart-Davis 2019
+
+# avr_footprint.py
+# @brief   Flash and RAM footprint of representative REV configurations,
+#          by module and by template instantiation, against a baseline.
+#
+# Builds FootprintConfig/ for each CONFIG_XXX with arduino-cli
+# (or takes already-built ELF files with --elf),
+# then reads the symbol table with avr-nm and section sizes with avr-size.
+# See README.md for usage.
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+LIBRARY = os.path.normpath(os.path.join(HERE, '..', '..', 'content', 'OTRadioLink'))
+SKETCH = os.path.join(HERE, 'FootprintConfig')
+# Compared against by default when present; regenerate with --save-baseline.
+DEFAULT_BASELINE = os.path.join(HERE, 'baseline.json')
+
+# Representative configurations: REV7 valve, REV7 sensor,
+# REV10 boiler hub and relay, REV11 sensor.
+DEFAULT_CONFIGS = [
+    'CONFIG_DORM1',
+    'CONFIG_REV7_AS_SECURE_SENSOR',
+    'CONFIG_REV10_SECURE_BHR',
+    'CONFIG_REV11_SECURE_SENSOR',
+    ]
+DEFAULT_FQBN = 'arduino:avr:pro:cpu=8MHzatmega328'
+
+# avr-gcc links RAM at 0x800000 upwards in the ELF address space.
+AVR_RAM_BASE = 0x800000
+AVR_RAM_END = 0x810000
+
+SECTIONS = ('text', 'data', 'bss')
+
+
+def build(config, fqbn, outdir, cli):
+    """Compile the sketch for one configuration and return the ELF path."""
+    out = os.path.join(outdir, config)
+    cmd = [cli, 'compile', '-b', fqbn,
+           '--library', LIBRARY,
+           '--build-property', 'compiler.cpp.extra_flags=-D' + config,
+           '--output-dir', out, SKETCH]
+    subprocess.check_call(cmd)
+    return os.path.join(out, 'FootprintConfig.ino.elf')
+
+
+def section_sizes(elf, size_tool):
+    """Total .text/.data/.bss bytes from `size -A`."""
+    totals = dict((s, 0) for s in SECTIONS)
+    output = subprocess.check_output([size_tool, '-A', elf], universal_newlines=True)
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) < 2 or not fields[1].isdigit():
+            continue
+        name = fields[0].lstrip('.')
+        if name in totals:
+            totals[name] += int(fields[1])
+    return totals
+
+
+def classify(address, symtype):
+    """Section for a symbol, from its address on AVR, else from its nm type."""
+    t = symtype.lower()
+    if AVR_RAM_BASE <= address < AVR_RAM_END:
+        return 'bss' if t == 'b' else 'data'
+    if address >= AVR_RAM_END:
+        return None  # EEPROM, fuses, etc.
+    if t == 'b':
+        return 'bss'
+    if t == 'd' and address > 0:
+        # Only reached for non-AVR (host) ELF files, eg when testing this script.
+        return 'data'
+    return 'text'
+
+
+def split_top_level(name, sep='::'):
+    """Split a demangled name on sep outside of <> and ()."""
+    parts, depth, start, i = [], 0, 0, 0
+    while i < len(name):
+        c = name[i]
+        if c in '<(':
+            depth += 1
+        elif c in '>)':
+            depth -= 1
+        elif depth == 0 and name.startswith(sep, i):
+            parts.append(name[start:i])
+            i += len(sep)
+            start = i
+            continue
+        i += 1
+    parts.append(name[start:])
+    return parts
+
+
+def strip_params(name):
+    """Drop a trailing (...) parameter list and qualifiers from a function name."""
+    depth = 0
+    for i in range(len(name) - 1, -1, -1):
+        c = name[i]
+        if c == ')':
+            depth += 1
+        elif c == '(':
+            depth -= 1
+            if depth == 0:
+                return name[:i]
+    return name
+
+
+# Prefixes the demangler puts on compiler-generated symbols.
+SPECIAL_PREFIXES = ('vtable for ', 'VTT for ', 'typeinfo name for ', 'typeinfo for ',
+                    'guard variable for ', 'non-virtual thunk to ', 'virtual thunk to ')
+
+
+def qualified_name(name):
+    """Demangled symbol name without special prefix, return type or parameters.
+
+    Eg 'unsigned char A::f<B>(int) const' gives 'A::f<B>'.
+    """
+    for prefix in SPECIAL_PREFIXES:
+        if name.startswith(prefix):
+            name = name[len(prefix):]
+            break
+    name = strip_params(name)
+    # A function template's return type is separated by a space outside <>.
+    return split_top_level(name, ' ')[-1]
+
+
+def instantiation_of(name):
+    """The template-id a demangled symbol belongs to, or None.
+
+    Eg 'OTRFM23BLink::OTRFM23BLink<10, 9, 8, true>::poll()'
+    gives 'OTRFM23BLink::OTRFM23BLink<10, 9, 8, true>'.
+    """
+    parts = split_top_level(qualified_name(name))
+    for i in range(len(parts) - 1, -1, -1):
+        if parts[i].endswith('>') and not parts[i].startswith('operator'):
+            return '::'.join(parts[:i + 1])
+    return None
+
+
+def module_of(name, location):
+    """Source file if nm -l found one, else the enclosing namespace/class."""
+    if location:
+        path = location.rsplit(':', 1)[0]
+        return os.path.basename(path)
+    parts = split_top_level(qualified_name(name))
+    if len(parts) == 1:
+        return '(global)'
+    return re.sub(r'<.*', '', parts[0])
+
+
+def symbols(elf, nm_tool, lines):
+    """(address, size, type, demangled name, location) for each sized symbol."""
+    cmd = [nm_tool, '-C', '-S', '--size-sort']
+    if lines:
+        cmd.append('-l')
+    output = subprocess.check_output(cmd + [elf], universal_newlines=True)
+    for line in output.splitlines():
+        location = None
+        if '\t' in line:
+            line, location = line.split('\t', 1)
+        fields = line.split(None, 3)
+        if len(fields) < 4:
+            continue
+        try:
+            address, size = int(fields[0], 16), int(fields[1], 16)
+        except ValueError:
+            continue
+        yield address, size, fields[2], fields[3], location
+
+
+def report(elf, nm_tool, size_tool, lines):
+    """Footprint of one ELF as a dict suitable for JSON."""
+    modules = {}
+    instantiations = {}
+    for address, size, symtype, name, location in symbols(elf, nm_tool, lines):
+        section = classify(address, symtype)
+        if section is None:
+            continue
+        m = modules.setdefault(module_of(name, location), dict((s, 0) for s in SECTIONS))
+        m[section] += size
+        inst = instantiation_of(name)
+        if inst is not None:
+            n = instantiations.setdefault(inst, dict((s, 0) for s in SECTIONS))
+            n[section] += size
+    return {
+        'elf': elf,
+        'sections': section_sizes(elf, size_tool),
+        'modules': modules,
+        'instantiations': instantiations,
+        }
+
+
+def row(label, sizes, base=None):
+    cells = []
+    for s in SECTIONS:
+        v = sizes.get(s, 0)
+        if base is None:
+            cells.append('%7d' % v)
+        else:
+            cells.append('%7d%+7d' % (v, v - base.get(s, 0)))
+    return '  '.join(cells) + '  ' + label
+
+
+def by_size(table):
+    return sorted(table.items(), key=lambda kv: (-sum(kv[1].values()), kv[0]))
+
+
+def print_table(title, table, base, top):
+    print('  %s:' % title)
+    shown = 0
+    for label, sizes in by_size(table):
+        b = None if base is None else base.get(label, {})
+        if b is not None and b == sizes:
+            continue  # Only show changes against a baseline.
+        if top and shown >= top:
+            print('    ...')
+            break
+        print('    ' + row(label, sizes, b))
+        shown += 1
+    if base is not None:
+        for label in sorted(set(base) - set(table)):
+            print('    ' + row(label + ' (removed)', {}, base[label]))
+
+
+def print_report(results, baseline, top):
+    header = '  '.join(('%7s' if baseline is None else '%14s') % s for s in SECTIONS)
+    for config in sorted(results):
+        r = results[config]
+        b = None if baseline is None else baseline.get(config)
+        print('%s  (%s)' % (config, r['elf']))
+        print('    ' + header)
+        print('    ' + row('total', r['sections'], None if b is None else b['sections']))
+        print_table('by module', r['modules'], None if b is None else b['modules'], top)
+        print_table('by template instantiation', r['instantiations'],
+                    None if b is None else b['instantiations'], top)
+        print()
+
+
+def growth(results, baseline):
+    """Largest flash and RAM growth in bytes over any configuration."""
+    flash, ram = 0, 0
+    for config, r in results.items():
+        b = baseline.get(config)
+        if b is None:
+            continue
+        s, bs = r['sections'], b['sections']
+        flash = max(flash, (s['text'] + s['data']) - (bs['text'] + bs['data']))
+        ram = max(ram, (s['data'] + s['bss']) - (bs['data'] + bs['bss']))
+    return flash, ram
+
+
+def main():
+    p = argparse.ArgumentParser(
+        description='Flash/RAM footprint of REV configurations by module and template instantiation.')
+    p.add_argument('--config', action='append', dest='configs',
+                   help='CONFIG_XXX to build (repeatable; default: %s)' % ', '.join(DEFAULT_CONFIGS))
+    p.add_argument('--elf', action='append', default=[], metavar='CONFIG=PATH',
+                   help='measure an already-built ELF instead of building')
+    p.add_argument('--fqbn', default=DEFAULT_FQBN)
+    p.add_argument('--arduino-cli', default='arduino-cli')
+    p.add_argument('--build-dir', default='build')
+    p.add_argument('--nm', default='avr-nm')
+    p.add_argument('--size', default='avr-size')
+    p.add_argument('--no-lines', action='store_true',
+                   help='group modules by namespace/class rather than source file')
+    p.add_argument('--top', type=int, default=20, help='rows per table (0 for all)')
+    p.add_argument('--json', action='store_true', help='write the report as JSON')
+    p.add_argument('--baseline',
+                   help='JSON report to compare against (default: baseline.json here if present)')
+    p.add_argument('--save-baseline', help='also write the report as JSON to this file')
+    p.add_argument('--max-growth', type=int,
+                   help='fail if flash or RAM grows by more than this many bytes over the baseline')
+    args = p.parse_args()
+
+    elfs = {}
+    for e in args.elf:
+        if '=' not in e:
+            p.error('--elf needs CONFIG=PATH')
+        config, path = e.split('=', 1)
+        elfs[config] = path
+    if not elfs:
+        for config in (args.configs or DEFAULT_CONFIGS):
+            elfs[config] = build(config, args.fqbn, args.build_dir, args.arduino_cli)
+
+    results = dict((c, report(e, args.nm, args.size, not args.no_lines)) for c, e in elfs.items())
+
+    if args.save_baseline:
+        with open(args.save_baseline, 'w') as f:
+            json.dump(results, f, indent=1, sort_keys=True)
+    baseline = None
+    if args.baseline is None and not args.save_baseline and os.path.exists(DEFAULT_BASELINE):
+        args.baseline = DEFAULT_BASELINE
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+
+    if args.json:
+        json.dump(results, sys.stdout, indent=1, sort_keys=True)
+        print()
+    else:
+        print_report(results, baseline, args.top)
+
+    if baseline is not None and args.max_growth is not None:
+        flash, ram = growth(results, baseline)
+        if flash > args.max_growth or ram > args.max_growth:
+            sys.stderr.write('footprint grew: flash %+d, RAM %+d bytes (limit %d)\n'
+                             % (flash, ram, args.max_growth))
+            return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -242,16 +242,20 @@ void loop()
     if(0 != rxed)
     {
         OTV0P2BASE::LED_HEATCALL_ON();
+        // The whole frame in hex, so that the capture can be replayed
+        // through the RX pipeline, eg with portableBenchmarks/RXLoadTest.cpp.
         DEBUG_SERIAL_PRINT(": ");
-        static constexpr uint8_t len = 20;
-        uint8_t buf[len + 1];
-        memcpy(buf, (const void *)PrimaryRadio.peekRXMsg(), len);
-        buf[len] = '\0';
-        for(auto ptr = &buf[0]; 0 != *ptr; ++ptr) {
-          DEBUG_SERIAL_PRINTFMT(*ptr, HEX);
+        const volatile uint8_t *const msg = PrimaryRadio.peekRXMsg();
+        const uint8_t msglen = msg[-1];
+        for(uint8_t i = 0; i < msglen; ++i) {
+          DEBUG_SERIAL_PRINTFMT(msg[i], HEX);
           DEBUG_SERIAL_PRINT(" ");
         }
         DEBUG_SERIAL_PRINTLN();
+        static constexpr uint8_t len = 20;
+        uint8_t buf[len + 1];
+        memcpy(buf, (const void *)msg, len);
+        buf[len] = '\0';
         DEBUG_SERIAL_PRINT("         ");
         for(auto ptr = &buf[0]; 0 != *ptr; ++ptr) {
           const char c = *ptr;
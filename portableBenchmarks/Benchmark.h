@@ -0,0 +1,151 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Minimal Google-Benchmark-style micro-benchmark harness
+ * for timing library hot paths in an optimised host build,
+ * without any external dependency.
+ *
+ * A benchmark is a function taking a State and looping while keepRunning():
+ *
+ *     static void BM_crc(OTBM::State &state)
+ *         {
+ *         uint8_t crc = 0;
+ *         while(state.keepRunning()) { crc = OTV0P2BASE::crc7_5B_update(crc, 0x55); OTBM::doNotOptimise(crc); }
+ *         }
+ *     OTBENCHMARK(BM_crc);
+ *
+ * The iteration count is doubled until a run lasts at least the minimum time,
+ * and the last run is reported.
+ * Command-line options, named as for Google Benchmark:
+ *   --benchmark_filter=SUBSTRING  only run benchmarks whose name contains SUBSTRING
+ *   --benchmark_format=console|json|csv  output format (default console)
+ *   --benchmark_min_time=SECONDS  minimum measured time per benchmark (default 0.2)
+ * The JSON output follows the Google Benchmark layout
+ * ("context" plus "benchmarks" with name, iterations, real_time, cpu_time, time_unit)
+ * so existing comparison tooling can read it.
+ */
+
+#ifndef PORTABLEBENCHMARKS_BENCHMARK_H
+#define PORTABLEBENCHMARKS_BENCHMARK_H
+
+#include <stdint.h>
+#include <chrono>
+#include <ctime>
+#include <vector>
+
+namespace OTBM
+{
+
+// Keep a value (and anything it depends on) from being optimised away.
+template <class T>
+inline void doNotOptimise(T const &value)
+    {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T *sink; sink = &value;
+#endif
+    }
+// Force pending memory writes to be treated as observable.
+inline void clobberMemory()
+    {
+#if defined(__GNUC__)
+    asm volatile("" : : : "memory");
+#endif
+    }
+
+// Per-run state handed to each benchmark.
+class State final
+    {
+    private:
+        uint64_t remaining;
+        const uint64_t iterations;
+        std::chrono::steady_clock::time_point start;
+        std::clock_t cpuStart;
+        double realNs = 0;
+        double cpuNs = 0;
+        bool started = false;
+        // Time spent with timing paused, to subtract.
+        std::chrono::steady_clock::duration pausedReal = std::chrono::steady_clock::duration::zero();
+        std::chrono::steady_clock::time_point pauseStart;
+        // Bytes processed per iteration if set, for a throughput figure.
+        uint64_t bytesPerIteration = 0;
+
+        void finish()
+            {
+            const auto end = std::chrono::steady_clock::now();
+            const std::clock_t cpuEnd = std::clock();
+            realNs = double(std::chrono::duration_cast<std::chrono::nanoseconds>((end - start) - pausedReal).count());
+            cpuNs = (double(cpuEnd - cpuStart) * 1e9) / CLOCKS_PER_SEC;
+            }
+
+    public:
+        explicit State(const uint64_t iterations_) : remaining(iterations_), iterations(iterations_), cpuStart(0) { }
+
+        // True while more iterations are wanted; starts the clock on first call.
+        bool keepRunning()
+            {
+            if(!started) { started = true; cpuStart = std::clock(); start = std::chrono::steady_clock::now(); }
+            if(0 != remaining) { --remaining; return(true); }
+            finish();
+            return(false);
+            }
+        // Exclude set-up work inside the loop from the (wall-clock) timing.
+        void pauseTiming() { pauseStart = std::chrono::steady_clock::now(); }
+        void resumeTiming() { pausedReal += std::chrono::steady_clock::now() - pauseStart; }
+        // Record bytes processed per iteration, to report throughput.
+        void setBytesPerIteration(const uint64_t n) { bytesPerIteration = n; }
+
+        uint64_t getIterations() const { return(iterations); }
+        double getRealNs() const { return(realNs); }
+        double getCPUNs() const { return(cpuNs); }
+        uint64_t getBytesPerIteration() const { return(bytesPerIteration); }
+    };
+
+typedef void (*benchmark_fn_t)(State &state);
+
+// One registered benchmark.
+struct Case
+    {
+    const char *name;
+    benchmark_fn_t fn;
+    };
+
+// All registered benchmarks, in registration order.
+inline std::vector<Case> &registry()
+    {
+    static std::vector<Case> r;
+    return(r);
+    }
+
+// Registers a benchmark at static initialisation time.
+struct Registrar final
+    {
+    Registrar(const char *const name, const benchmark_fn_t fn) { registry().push_back(Case{ name, fn }); }
+    };
+
+// Runs the registered benchmarks as directed by the command line; returns the process exit status.
+int runAll(int argc, char **argv);
+
+}
+
+// Register fn as a benchmark under its own name.
+#define OTBENCHMARK(fn) static const OTBM::Registrar OTBM_registrar_##fn(#fn, fn)
+
+#endif // PORTABLEBENCHMARKS_BENCHMARK_H
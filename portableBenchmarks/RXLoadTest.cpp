@@ -0,0 +1,502 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Replay-driven load test of the RX pipeline.
+ *
+ * Feeds a stream of frames, synthetic secure 'O' frames from a set of valves
+ * or frames captured with dev/utils/radioSniffer, into an ISRRXQueueVarLenMsg
+ * as the radio ISR would, at a configurable arrival rate,
+ * and drains it as the main loop would through the full
+ * decodeAndHandleRawRXedMessage() / decodeAndHandleOTSecureOFrame() chain.
+ *
+ * Time is simulated: each frame's handling time is the host CPU time
+ * actually spent handling it, multiplied by --cpu-scale
+ * (eg ~100 to approximate an ATmega328P at 1MHz; calibrate against
+ * a real unit), or fixed with --service-us.
+ * Reports frames dropped for lack of queue space and latency percentiles
+ * from arrival to the end of handling, and with --find-max searches for
+ * the highest arrival rate with no more than --max-drop-pct drops,
+ * ie how many valves one hub can serve.
+ *
+ * Usage:
+ *     rxloadtest [--rate=FPS] [--frames=N] [--queue=1..4] [--poll-ms=MS]
+ *                [--cpu-scale=X | --service-us=US] [--arrivals=poisson|uniform]
+ *                [--valves=N] [--capture=FILE] [--seed=N]
+ *                [--find-max [--max-drop-pct=P] [--valve-period-s=S]]
+ *                [--format=console|json]
+ *
+ * A capture file holds one frame per line, as the bytes queued by the radio
+ * (ie excluding the length byte), in hex:
+ * either after a leading ':' as printed by radioSniffer,
+ * or as a line of exactly-two-digit hex bytes; all other lines are ignored.
+ * Captured frames will generally fail authentication here (no keys)
+ * but still exercise queueing and header parsing.
+ */
+
+#include <algorithm>
+#include <deque>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+#include <OTV0p2Base.h>
+#include <OTRadioLink.h>
+
+#include "OTRadioLink_ISRRXQueue.h"
+#include "SecureFrameTestDoubles.h"
+
+
+namespace RXLT
+{
+
+// Maximum queued frame length, as for OTRFM23BLink.
+static constexpr uint8_t maxRXMsgLen = 64;
+
+// Template arguments below need external linkage, so these are not static.
+// Forwards to SFTD::dec.
+bool decrypt(uint8_t *const workspace, const size_t workspaceSize,
+             const uint8_t *const key, const uint8_t *const iv,
+             const uint8_t *const authtext, const uint8_t authtextSize,
+             const uint8_t *const ciphertext, const uint8_t *const tag,
+             uint8_t *const plaintextOut)
+    { return(SFTD::dec(workspace, workspaceSize, key, iv, authtext, authtextSize, ciphertext, tag, plaintextOut)); }
+// All valves share one (all-zeros) building key.
+bool getKey(uint8_t *const key) { memset(key, 0, 16); return(true); }
+// Header ID length and body length of the synthetic valve frames.
+static constexpr uint8_t il = 4;
+static constexpr uint8_t bodyLen = 8;
+
+// Make a distinct node ID for valve n.
+static void valveID(const uint16_t n, uint8_t *const id)
+    {
+    id[0] = 0x88; id[1] = uint8_t(n >> 8); id[2] = uint8_t(n); id[3] = 0x83;
+    for(uint8_t i = 4; i < OTV0P2BASE::OpenTRV_Node_ID_Bytes; ++i) { id[i] = uint8_t(0x80 + i); }
+    }
+
+// One transmitting valve with its own ID and RAM message counter.
+class ValveTX final : public SFTD::RAMCtrTXBase
+    {
+    private:
+        uint8_t id[OTV0P2BASE::OpenTRV_Node_ID_Bytes];
+    public:
+        explicit ValveTX(const uint16_t n) { valveID(n, id); }
+        virtual bool getTXID(uint8_t *buf) const override { memcpy(buf, id, sizeof(id)); return(true); }
+    };
+
+// The hub's RX side, associated with valves [0,valves) and enforcing counters, as a real hub would.
+class HubRX final : public OTRadioLink::SimpleSecureFrame32or0BodyRXBase
+    {
+    private:
+        std::vector<uint8_t> ids;
+        std::vector<uint8_t> ctrs;
+        uint16_t count = 0;
+
+        int16_t find(const uint8_t *const id) const
+            {
+            for(uint16_t i = 0; i < count; ++i)
+                { if(0 == memcmp(&ids[i * OTV0P2BASE::OpenTRV_Node_ID_Bytes], id, OTV0P2BASE::OpenTRV_Node_ID_Bytes)) { return(int16_t(i)); } }
+            return(-1);
+            }
+
+        virtual int8_t _getNextMatchingNodeID(const uint8_t index, const OTRadioLink::SecurableFrameHeader *const sfh, uint8_t *nodeID) const override
+            {
+            const uint16_t limit = std::min<uint16_t>(count, 127);
+            for(uint16_t i = index; i < limit; ++i)
+                {
+                const uint8_t *const id = &ids[i * OTV0P2BASE::OpenTRV_Node_ID_Bytes];
+                if(0 != memcmp(sfh->id, id, sfh->getIl())) { continue; }
+                memcpy(nodeID, id, OTV0P2BASE::OpenTRV_Node_ID_Bytes);
+                return(int8_t(i));
+                }
+            return(-1);
+            }
+
+    public:
+        static HubRX &getInstance() { static HubRX instance; return(instance); }
+
+        // Associate valves [0,n) afresh, with all counters reset.
+        void associate(const uint16_t n)
+            {
+            count = n;
+            ids.assign(size_t(n) * OTV0P2BASE::OpenTRV_Node_ID_Bytes, 0);
+            ctrs.assign(size_t(n) * 6, 0);
+            for(uint16_t i = 0; i < n; ++i) { valveID(i, &ids[i * OTV0P2BASE::OpenTRV_Node_ID_Bytes]); }
+            }
+
+        virtual bool getLastRXMsgCtr(const uint8_t *const ID, uint8_t *counter) const override
+            {
+            const int16_t i = find(ID);
+            if(i < 0) { return(false); }
+            memcpy(counter, &ctrs[size_t(i) * 6], 6);
+            return(true);
+            }
+        virtual bool authAndUpdateRXMsgCtr(const uint8_t *ID, const uint8_t *newCounterValue) override
+            {
+            if(!validateRXMsgCtr(ID, newCounterValue)) { return(false); }
+            memcpy(&ctrs[size_t(find(ID)) * 6], newCounterValue, 6);
+            return(true);
+            }
+    };
+
+// Frames successfully authenticated and handed to the frame operators.
+static uint32_t authenticated;
+bool countFrame(const OTRadioLink::OTDecodeData_T & /*fd*/) { ++authenticated; return(false); }
+
+// Secure 'O' frame handler as a hub would configure it.
+bool decodeSecureFrame(volatile const uint8_t *const msg)
+    {
+    constexpr size_t workspaceRequired =
+        OTRadioLink::SimpleSecureFrame32or0BodyRXBase::decode_total_scratch_usage_OTAESGCM_3p0
+        + SFTD::decWorkspace
+        + OTRadioLink::authAndDecodeOTSecurableFrameWithWorkspace_scratch_usage;
+    uint8_t workspace[workspaceRequired];
+    OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+    return(OTRadioLink::decodeAndHandleOTSecureOFrame<HubRX, decrypt, getKey, countFrame>(msg, sW));
+    }
+
+struct Config
+    {
+    // Mean frame arrival rate, frames per second.
+    double rate = 10;
+    // Frames offered per run.
+    uint32_t frames = 20000;
+    // Minimum full-size frames the RX queue can hold, in [1,4].
+    uint8_t queue = 3;
+    // Main loop poll interval, or 0 to handle frames as soon as they arrive.
+    double pollMs = 0;
+    // Scale factor from host handling time to simulated handling time.
+    double cpuScale = 1;
+    // Fixed simulated handling time per frame, or negative to measure.
+    double serviceUs = -1;
+    bool poisson = true;
+    uint16_t valves = 50;
+    const char *capture = NULL;
+    uint64_t seed = 42;
+    bool findMax = false;
+    // Drops allowed at the max sustainable rate; with random arrivals some are inevitable.
+    double maxDropPct = 0.1;
+    double valvePeriodS = 240;
+    bool json = false;
+    };
+
+struct Results
+    {
+    double rate;
+    uint32_t offered;
+    uint32_t dropped;
+    uint32_t handled;
+    uint32_t authenticated;
+    // Arrival to end of handling, in seconds.
+    std::vector<double> latency;
+    // Mean simulated handling time per frame, in seconds.
+    double meanServiceS;
+
+    double dropPct() const { return((0 == offered) ? 0 : (100.0 * dropped) / offered); }
+    // Nearest-rank percentile of latency, in seconds.
+    double percentile(const double p) const
+        {
+        if(latency.empty()) { return(0); }
+        size_t rank = size_t(ceil((p / 100.0) * latency.size()));
+        if(rank < 1) { rank = 1; }
+        return(latency[rank - 1]);
+        }
+    };
+
+// Source of frames, as queued by the radio (excluding the length byte).
+class FrameSource final
+    {
+    private:
+        std::vector<std::vector<uint8_t> > captured;
+        size_t nextCaptured = 0;
+        std::vector<ValveTX> valves;
+        OTV0P2BASE::PCG32 &prng;
+
+    public:
+        FrameSource(const Config &cfg, OTV0P2BASE::PCG32 &prng_) : prng(prng_)
+            { if(NULL == cfg.capture) { for(uint16_t i = 0; i < cfg.valves; ++i) { valves.emplace_back(i); } } }
+
+        bool loadCapture(const char *const path)
+            {
+            FILE *const f = fopen(path, "r");
+            if(NULL == f) { return(false); }
+            char line[1024];
+            while(NULL != fgets(line, sizeof(line), f))
+                {
+                const char *p = line;
+                while((' ' == *p) || ('\t' == *p)) { ++p; }
+                const bool sniffer = (':' == *p);
+                if(sniffer) { ++p; }
+                std::vector<uint8_t> frame;
+                bool ok = true;
+                for(char *tok = strtok(const_cast<char *>(p), " \t\r\n"); NULL != tok; tok = strtok(NULL, " \t\r\n"))
+                    {
+                    const size_t n = strlen(tok);
+                    char *end;
+                    const unsigned long v = strtoul(tok, &end, 16);
+                    if(('\0' != *end) || (n > 2) || (!sniffer && (2 != n))) { ok = false; break; }
+                    frame.push_back(uint8_t(v));
+                    }
+                if(ok && (frame.size() >= 2) && (frame.size() <= maxRXMsgLen)) { captured.push_back(frame); }
+                }
+            fclose(f);
+            return(!captured.empty());
+            }
+        size_t capturedFrames() const { return(captured.size()); }
+
+        // Next frame into buf; returns its length, or 0 on failure.
+        uint8_t next(uint8_t *const buf)
+            {
+            if(!captured.empty())
+                {
+                const std::vector<uint8_t> &f = captured[nextCaptured];
+                if(++nextCaptured >= captured.size()) { nextCaptured = 0; }
+                memcpy(buf, f.data(), f.size());
+                return(uint8_t(f.size()));
+                }
+            if(valves.empty()) { return(0); }
+            ValveTX &tx = valves[prng.nextBounded(uint32_t(valves.size()))];
+            uint8_t body[OTRadioLink::ENC_BODY_SMALL_FIXED_CTEXT_SIZE];
+            for(uint8_t j = 0; j < bodyLen; ++j) { body[j] = prng.next8(); }
+            uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encode_total_scratch_usage_OTAESGCM_2p0];
+            OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+            uint8_t encoded[OTRadioLink::SecurableFrameHeader::maxSmallFrameSize];
+            OTRadioLink::OTEncodeData_T fd(body, sizeof(body), encoded, sizeof(encoded));
+            fd.ptextLen = bodyLen;
+            fd.fType = OTRadioLink::FTS_BasicSensorOrValve;
+            static const uint8_t key[16] = {};
+            const uint8_t n = tx.encode(fd, il, SFTD::enc, sW, key);
+            // The leading frame length byte becomes the queue's length byte.
+            if(n < 2) { return(0); }
+            memcpy(buf, encoded + 1, n - 1);
+            return(uint8_t(n - 1));
+            }
+    };
+
+// CPU time used by this thread, in seconds.
+// Unlike wall-clock time this excludes pre-emption by the host OS,
+// which would otherwise be magnified by --cpu-scale.
+static double cpuSeconds()
+    {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return(ts.tv_sec + (ts.tv_nsec * 1e-9));
+    }
+
+// Uniform deviate in (0,1].
+static double uniform(OTV0P2BASE::PCG32 &prng) { return((prng.next32() + 1.0) / 4294967296.0); }
+
+// One run at cfg.rate, through a queue holding at least depth full-size frames.
+template<uint8_t depth>
+static Results runAt(const Config &cfg, const double rate)
+    {
+    OTV0P2BASE::PCG32 prng(cfg.seed, 54);
+    FrameSource src(cfg, prng);
+    if(NULL != cfg.capture) { src.loadCapture(cfg.capture); }
+    HubRX::getInstance().associate(cfg.valves);
+    authenticated = 0;
+
+    OTRadioLink::ISRRXQueueVarLenMsg<maxRXMsgLen, depth> q;
+    // Arrival times of queued frames, oldest first.
+    std::deque<double> arrivals;
+    Results r = Results();
+    r.rate = rate;
+    double totalServiceS = 0;
+    // True while the oldest queued frame is being handled, until freeAt.
+    bool inService = false;
+    double freeAt = 0;
+    const double poll = cfg.pollMs / 1000.0;
+
+    // Advance the main loop up to time t.
+    auto serviceUntil = [&](const double t)
+        {
+        for( ; ; )
+            {
+            if(inService)
+                {
+                if(freeAt > t) { return; }
+                r.latency.push_back(freeAt - arrivals.front());
+                arrivals.pop_front();
+                q.removeRXMsg();
+                ++r.handled;
+                inService = false;
+                }
+            if(arrivals.empty()) { return; }
+            // Frames waiting when the last one finished are handled straight away (as drainRX()),
+            // else the next is picked up at the next poll.
+            double start = std::max(freeAt, arrivals.front());
+            if((poll > 0) && (arrivals.front() > freeAt)) { start = ceil(start / poll) * poll; }
+            if(start > t) { return; }
+            const volatile uint8_t *const msg = q.peekRXMsg();
+            const double t0 = cpuSeconds();
+            OTRadioLink::decodeAndHandleRawRXedMessage<decodeSecureFrame>(msg);
+            const double t1 = cpuSeconds();
+            const double s = (cfg.serviceUs >= 0) ? (cfg.serviceUs * 1e-6) : ((t1 - t0) * cfg.cpuScale);
+            totalServiceS += s;
+            freeAt = start + s;
+            inService = true;
+            }
+        };
+
+    double t = 0;
+    uint8_t frame[maxRXMsgLen];
+    for(uint32_t i = 0; i < cfg.frames; ++i)
+        {
+        t += cfg.poisson ? (-log(uniform(prng)) / rate) : (1.0 / rate);
+        const uint8_t len = src.next(frame);
+        if(0 == len) { break; }
+        serviceUntil(t);
+        ++r.offered;
+        // As the radio ISR does.
+        volatile uint8_t *const bp = q._getRXBufForInbound();
+        if(NULL == bp) { ++r.dropped; continue; }
+        for(uint8_t j = 0; j < len; ++j) { bp[j] = frame[j]; }
+        q._loadedBuf(len);
+        arrivals.push_back(t);
+        }
+    serviceUntil(HUGE_VAL);
+    r.authenticated = authenticated;
+    r.meanServiceS = (0 == r.handled) ? 0 : (totalServiceS / r.handled);
+    std::sort(r.latency.begin(), r.latency.end());
+    return(r);
+    }
+
+static Results run(const Config &cfg, const double rate)
+    {
+    switch(cfg.queue)
+        {
+        case 1: return(runAt<1>(cfg, rate));
+        case 2: return(runAt<2>(cfg, rate));
+        default: return(runAt<3>(cfg, rate));
+        case 4: return(runAt<4>(cfg, rate));
+        }
+    }
+
+static void print(const Config &cfg, const Results &r, const bool first)
+    {
+    if(cfg.json)
+        {
+        printf("%s    {\n", first ? "" : ",\n");
+        printf("      \"rate_fps\": %.3f,\n", r.rate);
+        printf("      \"offered\": %u,\n", r.offered);
+        printf("      \"dropped\": %u,\n", r.dropped);
+        printf("      \"handled\": %u,\n", r.handled);
+        printf("      \"authenticated\": %u,\n", r.authenticated);
+        printf("      \"mean_service_us\": %.3f,\n", r.meanServiceS * 1e6);
+        printf("      \"latency_p50_ms\": %.3f,\n", r.percentile(50) * 1e3);
+        printf("      \"latency_p90_ms\": %.3f,\n", r.percentile(90) * 1e3);
+        printf("      \"latency_p99_ms\": %.3f,\n", r.percentile(99) * 1e3);
+        printf("      \"latency_max_ms\": %.3f\n", r.percentile(100) * 1e3);
+        printf("    }");
+        return;
+        }
+    printf("%10.2f fps: offered %u dropped %u (%.3f%%) handled %u authenticated %u; service %.1fus;"
+           " latency ms p50 %.3f p90 %.3f p99 %.3f max %.3f\n",
+        r.rate, r.offered, r.dropped, r.dropPct(), r.handled, r.authenticated, r.meanServiceS * 1e6,
+        r.percentile(50) * 1e3, r.percentile(90) * 1e3, r.percentile(99) * 1e3, r.percentile(100) * 1e3);
+    }
+
+// Highest rate with drops within cfg.maxDropPct, to ~1%.
+static double findMax(const Config &cfg, std::vector<Results> &runs)
+    {
+    double lo = 0, hi = 1;
+    for( ; hi < 1e7; hi *= 2)
+        {
+        runs.push_back(run(cfg, hi));
+        if(runs.back().dropPct() > cfg.maxDropPct) { break; }
+        lo = hi;
+        }
+    while((hi - lo) > (0.01 * hi))
+        {
+        const double mid = (lo + hi) / 2;
+        runs.push_back(run(cfg, mid));
+        if(runs.back().dropPct() > cfg.maxDropPct) { hi = mid; } else { lo = mid; }
+        }
+    return(lo);
+    }
+
+static bool startsWith(const char *const s, const char *const prefix, const char *&value)
+    {
+    const size_t n = strlen(prefix);
+    if(0 != strncmp(s, prefix, n)) { return(false); }
+    value = s + n;
+    return(true);
+    }
+
+}
+
+int main(const int argc, const char *const argv[])
+    {
+    RXLT::Config cfg;
+    for(int i = 1; i < argc; ++i)
+        {
+        const char *v;
+        if(RXLT::startsWith(argv[i], "--rate=", v)) { cfg.rate = atof(v); }
+        else if(RXLT::startsWith(argv[i], "--frames=", v)) { cfg.frames = uint32_t(strtoul(v, NULL, 10)); }
+        else if(RXLT::startsWith(argv[i], "--queue=", v)) { cfg.queue = uint8_t(atoi(v)); }
+        else if(RXLT::startsWith(argv[i], "--poll-ms=", v)) { cfg.pollMs = atof(v); }
+        else if(RXLT::startsWith(argv[i], "--cpu-scale=", v)) { cfg.cpuScale = atof(v); }
+        else if(RXLT::startsWith(argv[i], "--service-us=", v)) { cfg.serviceUs = atof(v); }
+        else if(RXLT::startsWith(argv[i], "--arrivals=", v)) { cfg.poisson = (0 != strcmp(v, "uniform")); }
+        else if(RXLT::startsWith(argv[i], "--valves=", v)) { cfg.valves = uint16_t(atoi(v)); }
+        else if(RXLT::startsWith(argv[i], "--capture=", v)) { cfg.capture = v; }
+        else if(RXLT::startsWith(argv[i], "--seed=", v)) { cfg.seed = strtoull(v, NULL, 10); }
+        else if(0 == strcmp(argv[i], "--find-max")) { cfg.findMax = true; }
+        else if(RXLT::startsWith(argv[i], "--max-drop-pct=", v)) { cfg.maxDropPct = atof(v); }
+        else if(RXLT::startsWith(argv[i], "--valve-period-s=", v)) { cfg.valvePeriodS = atof(v); }
+        else if(RXLT::startsWith(argv[i], "--format=", v)) { cfg.json = (0 == strcmp(v, "json")); }
+        else { fprintf(stderr, "unknown argument: %s\n", argv[i]); return(2); }
+        }
+    if((cfg.rate <= 0) || (0 == cfg.frames) || (cfg.queue < 1) || (cfg.queue > 4) || (0 == cfg.valves))
+        { fprintf(stderr, "bad arguments\n"); return(2); }
+    if(NULL != cfg.capture)
+        {
+        OTV0P2BASE::PCG32 prng;
+        RXLT::FrameSource src(cfg, prng);
+        if(!src.loadCapture(cfg.capture)) { fprintf(stderr, "no frames in capture: %s\n", cfg.capture); return(1); }
+        if(!cfg.json) { printf("capture %s: %u frames\n", cfg.capture, unsigned(src.capturedFrames())); }
+        }
+
+    std::vector<RXLT::Results> runs;
+    double maxRate = 0;
+    if(cfg.findMax) { maxRate = RXLT::findMax(cfg, runs); }
+    else { runs.push_back(RXLT::run(cfg, cfg.rate)); }
+
+    if(cfg.json) { printf("{\n  \"runs\": [\n"); }
+    for(size_t i = 0; i < runs.size(); ++i) { RXLT::print(cfg, runs[i], 0 == i); }
+    if(cfg.json)
+        {
+        printf("\n  ]");
+        if(cfg.findMax)
+            {
+            printf(",\n  \"max_sustainable_fps\": %.3f,\n  \"valves_served\": %.0f",
+                maxRate, floor(maxRate * cfg.valvePeriodS));
+            }
+        printf("\n}\n");
+        }
+    else if(cfg.findMax)
+        {
+        printf("max sustainable %.2f fps (drops <= %.3f%%, queue %u, poll %.1fms):"
+               " ~%.0f valves at one frame per %.0fs\n",
+            maxRate, cfg.maxDropPct, cfg.queue, cfg.pollMs, floor(maxRate * cfg.valvePeriodS), cfg.valvePeriodS);
+        }
+    return(0);
+    }
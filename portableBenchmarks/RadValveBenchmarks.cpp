@@ -0,0 +1,141 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Benchmarks of OTRadValve hot paths: the per-minute valve model tick,
+ * and the multi-zone thermal model that long valve simulations spend their time in.
+ */
+
+#include <OTV0p2Base.h>
+#include <OTRadValve.h>
+
+#include "Benchmark.h"
+#include "OTRadValve/MultiZoneThermalModel.h"
+
+
+// One per-minute ModelledRadValveState::tick() with a slowly wandering room temperature,
+// so that the valve keeps moving and the filters stay busy.
+static void BM_ModelledRadValveState_tick(OTBM::State &state)
+    {
+    OTRadValve::ModelledRadValveState<> rs;
+    OTRadValve::ModelledRadValveInputState is(18 << 4);
+    is.targetTempC = 20;
+    volatile uint8_t valvePC = 50;
+    uint16_t minute = 0;
+    while(state.keepRunning())
+        {
+        // Triangle wave of +/- 2C over about an hour.
+        const int16_t phase = int16_t(minute % 64);
+        const int16_t offsetC16 = int16_t(((phase < 32) ? phase : (64 - phase)) - 16) * 2;
+        is.setReferenceTemperatures(int16_t((20 << 4) + offsetC16));
+        rs.tick(valvePC, is, NULL);
+        OTBM::doNotOptimise(valvePC);
+        ++minute;
+        }
+    }
+OTBENCHMARK(BM_ModelledRadValveState_tick);
+
+// One 10s step of an 8-room house, each room coupled to the next,
+// with valves part open so that every heat flow is live.
+static void BM_MultiZoneThermalModel_step(OTBM::State &state)
+    {
+    namespace MZ = OTRadValve::PortableUnitTest::TMB::MultiZone;
+    const MZ::ZoneParams_t p { OTRadValve::PortableUnitTest::TMB::roomParams_Default, MZ::radiatorParams_Default };
+    MZ::MultiZoneThermalModel<8> m(p, 15.0);
+    m.setOutsideTemp(2.0);
+    for(size_t z = 0; z < 8; ++z)
+        {
+        m.setValvePCOpen(z, uint_fast8_t(10 * z + 20));
+        if(z > 0) { m.setCoupling(z - 1, z, 50.0); }
+        }
+    while(state.keepRunning())
+        {
+        m.step(10.0);
+        volatile double t = m.getAirTemp(7);
+        OTBM::doNotOptimise(t);
+        }
+    }
+OTBENCHMARK(BM_MultiZoneThermalModel_step);
+
+// FHT8V valve-setting command for a new position:
+// encoded from scratch, or patched in place from the saved prefix as FHT8VRadValve does.
+template<bool patch>
+static void FHT8VValveSetCmd(OTBM::State &state)
+    {
+    uint8_t buf[OTRadValve::FHT8VRadValveUtil::MIN_FHT8V_200US_BIT_STREAM_BUF_SIZE];
+    OTRadValve::FHT8VRadValveUtil::fht8v_msg_t command;
+    command.hc1 = 13;
+    command.hc2 = 73;
+#ifdef OTV0P2BASE_FHT8V_ADR_USED
+    command.address = 0;
+#endif
+    command.command = 0x26;
+    command.extension = 0;
+    uint8_t *const partial = OTRadValve::FHT8VRadValveUtil::FHT8VCreate200usBitStreamPrefixBptr(buf, &command);
+    const uint8_t partialValue = *partial;
+    uint8_t pc = 0;
+    while(state.keepRunning())
+        {
+        command.extension = OTRadValve::FHT8VRadValveUtil::convertPercentTo255Scale(pc);
+        if(++pc > 100) { pc = 0; }
+        if(patch)
+            {
+            *partial = partialValue;
+            OTBM::doNotOptimise(OTRadValve::FHT8VRadValveUtil::FHT8VAppend200usBitStreamExtensionBptr(partial, &command));
+            }
+        else { OTBM::doNotOptimise(OTRadValve::FHT8VRadValveUtil::FHT8VCreate200usBitStreamBptr(buf, &command)); }
+        OTBM::clobberMemory();
+        }
+    }
+static void BM_FHT8VValveSetCmd_full(OTBM::State &state) { FHT8VValveSetCmd<false>(state); }
+OTBENCHMARK(BM_FHT8VValveSetCmd_full);
+static void BM_FHT8VValveSetCmd_patched(OTBM::State &state) { FHT8VValveSetCmd<true>(state); }
+OTBENCHMARK(BM_FHT8VValveSetCmd_patched);
+
+// Decoding a sniffed FHT8V frame, valid or corrupted early (in hc1),
+// bit by bit or with the nibble table.
+template<bool lut, bool corrupt>
+static void FHT8VDecode(OTBM::State &state)
+    {
+    uint8_t buf[OTRadValve::FHT8VRadValveUtil::MIN_FHT8V_200US_BIT_STREAM_BUF_SIZE];
+    OTRadValve::FHT8VRadValveUtil::fht8v_msg_t command;
+    command.hc1 = 13;
+    command.hc2 = 73;
+#ifdef OTV0P2BASE_FHT8V_ADR_USED
+    command.address = 0;
+#endif
+    command.command = 0x26;
+    command.extension = 0x80;
+    OTRadValve::FHT8VRadValveUtil::FHT8VCreate200usBitStreamBptr(buf, &command);
+    if(corrupt) { buf[8] ^= 0x10; }
+    OTRadValve::FHT8VRadValveUtil::fht8v_msg_t decoded;
+    while(state.keepRunning())
+        {
+        if(lut) { OTBM::doNotOptimise(OTRadValve::FHT8VRadValveUtil::FHT8VDecodeBitStreamLUT(buf, buf + sizeof(buf) - 1, &decoded)); }
+        else { OTBM::doNotOptimise(OTRadValve::FHT8VRadValveUtil::FHT8VDecodeBitStream(buf, buf + sizeof(buf) - 1, &decoded)); }
+        OTBM::clobberMemory();
+        }
+    }
+static void BM_FHT8VDecode_bitwise(OTBM::State &state) { FHT8VDecode<false, false>(state); }
+OTBENCHMARK(BM_FHT8VDecode_bitwise);
+static void BM_FHT8VDecode_LUT(OTBM::State &state) { FHT8VDecode<true, false>(state); }
+OTBENCHMARK(BM_FHT8VDecode_LUT);
+static void BM_FHT8VDecode_bitwise_corrupt(OTBM::State &state) { FHT8VDecode<false, true>(state); }
+OTBENCHMARK(BM_FHT8VDecode_bitwise_corrupt);
+static void BM_FHT8VDecode_LUT_corrupt(OTBM::State &state) { FHT8VDecode<true, true>(state); }
+OTBENCHMARK(BM_FHT8VDecode_LUT_corrupt);
@@ -0,0 +1,162 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Benchmarks of OTRadioLink hot paths:
+ * RX queue enqueue/dequeue, secure frame encode/decode,
+ * and JeeLabs/OEM RX filtering.
+ *
+ * Uses OTAESGCM where available, else the NULL crypto
+ * (which still exercises all of this library's framing code).
+ */
+
+#include <string.h>
+
+#include <OTV0p2Base.h>
+#include <OTRadioLink.h>
+
+#include "OTRadioLink_ISRRXQueue.h"
+#include "OTRadioLink_JeelabsOemPacket.h"
+
+#include "Benchmark.h"
+#include "SecureFrameTestDoubles.h"
+
+
+// One frame through an ISRRXQueueVarLenMsg, as the RX ISR and main loop would do.
+static void BM_ISRRXQueueVarLenMsg_enqueueDequeue(OTBM::State &state)
+    {
+    static constexpr uint8_t frameLen = 32;
+    OTRadioLink::ISRRXQueueVarLenMsg<64, 2> q;
+    uint8_t seq = 0;
+    while(state.keepRunning())
+        {
+        volatile uint8_t *const bp = q._getRXBufForInbound();
+        if(NULL == bp) { continue; }
+        for(uint8_t i = 0; i < frameLen; ++i) { bp[i] = uint8_t(seq + i); }
+        q._loadedBuf(frameLen);
+        const volatile uint8_t *const rp = q.peekRXMsg();
+        OTBM::doNotOptimise(rp[-1]);
+        q.removeRXMsg();
+        ++seq;
+        }
+    state.setBytesPerIteration(frameLen);
+    }
+OTBENCHMARK(BM_ISRRXQueueVarLenMsg_enqueueDequeue);
+
+namespace RLBM
+{
+static const uint8_t key[16] = {};
+static const uint8_t txID[8] = { 0x88, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87 };
+// Header ID length and body length for the benchmark frame.
+static constexpr uint8_t il = 4;
+static constexpr uint8_t bodyLen = 16;
+
+// Encode the benchmark frame into buf; returns length or 0 on failure.
+static uint8_t encodeFrame(SFTD::FixedIDTX &tx, uint8_t *const buf, const uint8_t bufSize)
+    {
+    uint8_t body[OTRadioLink::ENC_BODY_SMALL_FIXED_CTEXT_SIZE];
+    for(uint8_t j = 0; j < bodyLen; ++j) { body[j] = uint8_t(0x20 + j); }
+    uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encode_total_scratch_usage_OTAESGCM_2p0];
+    OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+    OTRadioLink::OTEncodeData_T fd(body, sizeof(body), buf, bufSize);
+    fd.ptextLen = bodyLen;
+    fd.fType = OTRadioLink::FTS_BasicSensorOrValve;
+    return(tx.encode(fd, il, SFTD::enc, sW, key));
+    }
+}
+
+// Secure encode() of a small sensor frame.
+static void BM_SecureFrame_encode(OTBM::State &state)
+    {
+    SFTD::FixedIDTX tx(RLBM::txID);
+    uint8_t buf[OTRadioLink::SecurableFrameHeader::maxSmallFrameSize];
+    while(state.keepRunning())
+        {
+        const uint8_t n = RLBM::encodeFrame(tx, buf, sizeof(buf));
+        OTBM::doNotOptimise(n);
+        OTBM::clobberMemory();
+        }
+    }
+OTBENCHMARK(BM_SecureFrame_encode);
+
+// Secure decode() of the same frame, including header decode.
+static void BM_SecureFrame_decode(OTBM::State &state)
+    {
+    SFTD::FixedIDTX tx(RLBM::txID);
+    uint8_t encoded[OTRadioLink::SecurableFrameHeader::maxSmallFrameSize];
+    const uint8_t encodedLen = RLBM::encodeFrame(tx, encoded, sizeof(encoded));
+    SFTD::SingleNodeRX rx(RLBM::txID);
+    while(state.keepRunning())
+        {
+        uint8_t ptext[OTRadioLink::OTDecodeData_T::ptextLenMax];
+        OTRadioLink::OTDecodeData_T fd(encoded, ptext);
+        uint8_t n = 0;
+        if(0 != fd.sfh.decodeHeader(encoded, encodedLen))
+            {
+            uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyRXBase::decode_total_scratch_usage_OTAESGCM_3p0 + SFTD::decWorkspace];
+            OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+            n = rx.decode(fd, SFTD::dec, sW, RLBM::key);
+            }
+        OTBM::doNotOptimise(n);
+        OTBM::clobberMemory();
+        }
+    }
+OTBENCHMARK(BM_SecureFrame_decode);
+
+namespace RLBM
+{
+// A 64-byte RX buffer holding a JeeLabs/OEM broadcast with a 40-byte payload from group 210.
+static void jeelabsFrame(uint8_t *const buf)
+    {
+    for(uint8_t i = 0; i < 64; ++i) { buf[i] = uint8_t(i); }
+    OTRadioLink::JeelabsOemPacket p;
+    p.encode(buf, 40);
+    buf[0] = 210;
+    }
+}
+
+// JeeLabs/OEM RX filter on a frame from another group: full-length CRC check...
+static void BM_JeelabsFilter_CRCOnly(OTBM::State &state)
+    {
+    uint8_t buf[64];
+    RLBM::jeelabsFrame(buf);
+    while(state.keepRunning())
+        {
+        volatile uint8_t buflen = 64;
+        OTBM::doNotOptimise(OTRadioLink::JeelabsOemPacket::filter(buf, buflen));
+        OTBM::clobberMemory();
+        }
+    }
+OTBENCHMARK(BM_JeelabsFilter_CRCOnly);
+
+// ...versus rejecting it by group before the CRC.
+static void BM_JeelabsFilter_groupFirst(OTBM::State &state)
+    {
+    typedef OTRadioLink::FrameFilterChain<
+        OTRadioLink::FrameFilterJeelabsGroup<100>,
+        OTRadioLink::FrameFilterJeelabsCRC> filter;
+    uint8_t buf[64];
+    RLBM::jeelabsFrame(buf);
+    while(state.keepRunning())
+        {
+        volatile uint8_t buflen = 64;
+        OTBM::doNotOptimise(filter::filter(buf, buflen));
+        OTBM::clobberMemory();
+        }
+    }
+OTBENCHMARK(BM_JeelabsFilter_groupFirst);
@@ -0,0 +1,94 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Benchmarks of OTV0p2Base hot paths: CRCs and JSON stats rendering.
+ */
+
+#include <OTV0p2Base.h>
+
+#include "Benchmark.h"
+
+
+// 7-bit CRC as used on every FS20/FHT8V and secure frame, one byte at a time.
+static void BM_crc7_5B_update(OTBM::State &state)
+    {
+    uint8_t crc = 0;
+    uint8_t datum = 0;
+    while(state.keepRunning())
+        {
+        crc = OTV0P2BASE::crc7_5B_update(crc, datum++);
+        OTBM::doNotOptimise(crc);
+        }
+    state.setBytesPerIteration(1);
+    }
+OTBENCHMARK(BM_crc7_5B_update);
+
+// Rendering a typical valve stats line with writeJSON(), fresh values each time.
+template<bool cacheRendered>
+static void statsWriteJSON(OTBM::State &state)
+    {
+    OTV0P2BASE::SimpleStatsRotation<8, cacheRendered> ss;
+    ss.setID(V0p2_SENSOR_TAG_F("f9ce"));
+    char buf[OTV0P2BASE::MSG_JSON_MAX_LENGTH + 2];
+    int16_t v = 0;
+    while(state.keepRunning())
+        {
+        ss.put(V0p2_SENSOR_TAG_F("T|C16"), int16_t(290 + (v & 7)));
+        ss.put(V0p2_SENSOR_TAG_F("H|%"), int16_t(60 + (v & 3)));
+        ss.put(V0p2_SENSOR_TAG_F("L"), int16_t(v & 255));
+        ss.put(V0p2_SENSOR_TAG_F("B|cV"), int16_t(250));
+        ss.put(V0p2_SENSOR_TAG_F("O"), int16_t(1));
+        ss.put(V0p2_SENSOR_TAG_F("vac|h"), int16_t(0));
+        const uint8_t n = ss.writeJSON((uint8_t *)buf, sizeof(buf), 0, 0 != (v & 1));
+        OTBM::doNotOptimise(n);
+        OTBM::clobberMemory();
+        ++v;
+        }
+    }
+static void BM_SimpleStatsRotation_writeJSON(OTBM::State &state) { statsWriteJSON<false>(state); }
+OTBENCHMARK(BM_SimpleStatsRotation_writeJSON);
+static void BM_SimpleStatsRotation_writeJSON_cached(OTBM::State &state) { statsWriteJSON<true>(state); }
+OTBENCHMARK(BM_SimpleStatsRotation_writeJSON_cached);
+
+// Decimal formatting of stats values: Print's divide-per-digit loop vs the digit-pair formatter.
+static void BM_Print_int16(OTBM::State &state)
+    {
+    char buf[OTV0P2BASE::FORMAT_I16_CHARS];
+    int16_t v = 0;
+    while(state.keepRunning())
+        {
+        OTV0P2BASE::BufPrint bp(buf, sizeof(buf));
+        bp.print(int(v));
+        OTBM::doNotOptimise(buf);
+        v = int16_t(v + 997);
+        }
+    }
+OTBENCHMARK(BM_Print_int16);
+static void BM_formatI16(OTBM::State &state)
+    {
+    char buf[OTV0P2BASE::FORMAT_I16_CHARS];
+    int16_t v = 0;
+    while(state.keepRunning())
+        {
+        OTV0P2BASE::formatI16(buf, v);
+        OTBM::doNotOptimise(buf);
+        v = int16_t(v + 997);
+        }
+    }
+OTBENCHMARK(BM_formatI16);
@@ -0,0 +1,123 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for the micro-benchmarks; see Benchmark.h.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Benchmark.h"
+
+
+namespace OTBM
+{
+
+// Result of the final, reported run of one benchmark.
+struct Result
+    {
+    const char *name;
+    uint64_t iterations;
+    double realNsPerIter;
+    double cpuNsPerIter;
+    uint64_t bytesPerIteration;
+    };
+
+static void printConsoleHeader()
+    {
+    printf("%-40s %14s %14s %12s %10s\n", "Benchmark", "Time(ns)", "CPU(ns)", "Iterations", "MB/s");
+    }
+static void printConsole(const Result &r)
+    {
+    printf("%-40s %14.2f %14.2f %12llu", r.name, r.realNsPerIter, r.cpuNsPerIter, (unsigned long long)r.iterations);
+    if(0 != r.bytesPerIteration) { printf(" %10.2f", (r.bytesPerIteration * 1e3) / r.realNsPerIter); }
+    printf("\n");
+    }
+static void printCSV(const Result &r)
+    {
+    printf("\"%s\",%llu,%.3f,%.3f,ns,%llu\n", r.name, (unsigned long long)r.iterations,
+        r.realNsPerIter, r.cpuNsPerIter, (unsigned long long)r.bytesPerIteration);
+    }
+static void printJSON(const Result &r, const bool first)
+    {
+    printf("%s    {\n", first ? "" : ",\n");
+    printf("      \"name\": \"%s\",\n", r.name);
+    printf("      \"run_type\": \"iteration\",\n");
+    printf("      \"iterations\": %llu,\n", (unsigned long long)r.iterations);
+    printf("      \"real_time\": %.3f,\n", r.realNsPerIter);
+    printf("      \"cpu_time\": %.3f,\n", r.cpuNsPerIter);
+    if(0 != r.bytesPerIteration) { printf("      \"bytes_per_second\": %.1f,\n", (r.bytesPerIteration * 1e9) / r.realNsPerIter); }
+    printf("      \"time_unit\": \"ns\"\n");
+    printf("    }");
+    }
+
+// Run fn with doubling iteration counts until it takes at least minNs.
+static Result runOne(const Case &c, const double minNs)
+    {
+    for(uint64_t n = 1; ; n *= 2)
+        {
+        State s(n);
+        c.fn(s);
+        if((s.getRealNs() >= minNs) || (n >= (uint64_t(1) << 40)))
+            {
+            const Result r = { c.name, n, s.getRealNs() / n, s.getCPUNs() / n, s.getBytesPerIteration() };
+            return(r);
+            }
+        }
+    }
+
+int runAll(const int argc, char **const argv)
+    {
+    const char *filter = "";
+    const char *format = "console";
+    double minTimeS = 0.2;
+    for(int i = 1; i < argc; ++i)
+        {
+        const char *const a = argv[i];
+        if(0 == strncmp(a, "--benchmark_filter=", 19)) { filter = a + 19; }
+        else if(0 == strncmp(a, "--benchmark_format=", 19)) { format = a + 19; }
+        else if(0 == strncmp(a, "--benchmark_min_time=", 21)) { minTimeS = atof(a + 21); }
+        else { fprintf(stderr, "unknown option %s\n", a); return(2); }
+        }
+    const bool json = (0 == strcmp(format, "json"));
+    const bool csv = (0 == strcmp(format, "csv"));
+    if(!json && !csv && (0 != strcmp(format, "console"))) { fprintf(stderr, "unknown format %s\n", format); return(2); }
+
+    if(json) { printf("{\n  \"context\": {\n    \"executable\": \"%s\",\n    \"library_build_type\": \"release\"\n  },\n  \"benchmarks\": [\n", argv[0]); }
+    else if(csv) { printf("name,iterations,real_time,cpu_time,time_unit,bytes_per_iteration\n"); }
+    else { printConsoleHeader(); }
+    bool first = true;
+    for(const Case &c : registry())
+        {
+        if(NULL == strstr(c.name, filter)) { continue; }
+        const Result r = runOne(c, minTimeS * 1e9);
+        if(json) { printJSON(r, first); }
+        else if(csv) { printCSV(r); }
+        else { printConsole(r); }
+        first = false;
+        fflush(stdout);
+        }
+    if(json) { printf("\n  ]\n}\n"); }
+    return(0);
+    }
+
+}
+
+int main(int argc, char **argv) { return(OTBM::runAll(argc, argv)); }
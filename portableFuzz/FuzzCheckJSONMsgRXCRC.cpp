@@ -0,0 +1,30 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * libFuzzer target: OTV0P2BASE::checkJSONMsgRXCRC() on a raw RX buffer.
+ * See RXValidationFuzz.h.
+ */
+
+#include "RXValidationFuzz.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *const data, const size_t size)
+    {
+    OTFZ::fuzzCheckJSONMsgRXCRC(data, size);
+    return(0);
+    }
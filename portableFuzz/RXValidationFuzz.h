@@ -0,0 +1,269 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Fuzz targets and corpus generation for the RX validation paths
+ * that see every untrusted frame:
+ *   - SecurableFrameHeader::decodeHeader(),
+ *   - OTV0P2BASE::checkJSONMsgRXCRC(),
+ *   - OTV0P2BASE::quickValidateRawSimpleJSONMessage().
+ *
+ * Each target takes arbitrary bytes, calls the routine exactly as RX does,
+ * checks the result for internal consistency, and abort()s if it is not,
+ * so that libFuzzer (or the unit tests) record a crash.
+ * The libFuzzer entry points are in Fuzz*.cpp;
+ * RXValidationThroughput.cpp measures accept and reject rates on a large corpus.
+ *
+ * Inputs are passed in buffers of exactly their own size
+ * so that AddressSanitizer catches any read beyond the frame.
+ */
+
+#ifndef PORTABLEFUZZ_RXVALIDATIONFUZZ_H
+#define PORTABLEFUZZ_RXVALIDATIONFUZZ_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <OTV0p2Base.h>
+#include <OTRadioLink.h>
+
+namespace OTFZ
+{
+
+// Abort (so a fuzzer records a crash) unless condition holds.
+inline void require(const bool condition) { if(!condition) { abort(); } }
+
+// Decode a frame header from data; true if accepted.
+// An accepted header must re-encode to the same bytes.
+inline bool fuzzDecodeHeader(const uint8_t *const data, const size_t size)
+    {
+    const uint8_t buflen = (size > 255) ? 255 : uint8_t(size);
+    OTRadioLink::SecurableFrameHeader sfh;
+    const uint8_t hl = sfh.decodeHeader(data, buflen);
+    if(0 == hl)
+        {
+        require(sfh.isInvalid());
+        return(false);
+        }
+    require(!sfh.isInvalid());
+    require(hl == sfh.getHl());
+    require(hl <= buflen);
+    require(sfh.fl <= OTRadioLink::SecurableFrameHeader::maxSmallFrameSize);
+    require(sfh.getIl() <= OTRadioLink::SecurableFrameHeader::maxIDLength);
+    require(sfh.fl == 3 + sfh.getIl() + sfh.bl + sfh.getTl());
+    uint8_t _re[OTRadioLink::SecurableFrameHeader::maxSmallFrameSize + 1];
+    OTRadioLink::OTBuf_t re(_re, sizeof(_re));
+    OTRadioLink::SecurableFrameHeader sfh2;
+    require(0 != sfh2.encodeHeader(re, sfh.isSecure(), OTRadioLink::FrameType_Secureable(sfh.fType & 0x7f),
+        sfh.getSeq(), sfh.id, sfh.getIl(), sfh.bl, sfh.getTl()));
+    require(0 == memcmp(_re, data, hl));
+    return(true);
+    }
+
+// Check a received JSON frame with trailing CRC; true if accepted.
+// An accepted message must start with '{' and end with '}' (raw) or '}'|0x80.
+inline bool fuzzCheckJSONMsgRXCRC(const uint8_t *const data, const size_t size)
+    {
+    const uint8_t bufLen = (size > 255) ? 255 : uint8_t(size);
+    const int8_t l = OTV0P2BASE::checkJSONMsgRXCRC(data, bufLen);
+    if(OTV0P2BASE::checkJSONMsgRXCRC_ERR == l) { return(false); }
+    require(l >= 2);
+    require(l <= OTV0P2BASE::MSG_JSON_ABS_MAX_LENGTH);
+    require(l < bufLen);
+    require('{' == data[0]);
+    const uint8_t last = data[l - 1];
+    require(('}' == last) || ((uint8_t('}') | 0x80) == last));
+    return(true);
+    }
+
+// Quick-validate a raw JSON message, passed NUL-terminated as RX does; true if accepted.
+// An accepted message must be one printable {...} of at most MSG_JSON_MAX_LENGTH chars.
+inline bool fuzzQuickValidateRawSimpleJSONMessage(const uint8_t *const data, const size_t size)
+    {
+    std::vector<char> s(data, data + size);
+    s.push_back('\0');
+    if(!OTV0P2BASE::quickValidateRawSimpleJSONMessage(s.data())) { return(false); }
+    const size_t len = strlen(s.data());
+    require(len >= 2);
+    require(len <= OTV0P2BASE::MSG_JSON_MAX_LENGTH);
+    require(('{' == s[0]) && ('}' == s[len - 1]));
+    for(size_t i = 0; i < len; ++i) { require((s[i] >= 32) && (s[i] <= 126)); }
+    return(true);
+    }
+
+
+// Corpus of inputs for one target, grouped by kind.
+struct Corpus final
+    {
+    // Inputs that should be accepted.
+    std::vector<std::vector<uint8_t>> valid;
+    // Malformed inputs of each kind; all should be rejected (or may rarely be accepted by chance).
+    std::vector<std::vector<uint8_t>> random;
+    std::vector<std::vector<uint8_t>> mutated;
+    std::vector<std::vector<uint8_t>> truncated;
+    // Inputs built to take the longest possible path before rejection.
+    std::vector<std::vector<uint8_t>> worstCase;
+    };
+
+// Small deterministic PRNG for corpus generation.
+class Rand final
+    {
+    private:
+        uint32_t s;
+    public:
+        explicit Rand(const uint32_t seed) : s(seed | 1) { }
+        uint32_t next() { s ^= s << 13; s ^= s >> 17; s ^= s << 5; return(s); }
+        uint8_t byte() { return(uint8_t(next() >> 24)); }
+        uint32_t below(const uint32_t n) { return(next() % n); }
+    };
+
+// Random bytes, bit flips and truncations of valid inputs.
+inline void addMalformed(Corpus &c, Rand &r, const size_t n, const size_t maxLen)
+    {
+    for(size_t i = 0; i < n; ++i)
+        {
+        std::vector<uint8_t> junk(1 + r.below(uint32_t(maxLen)));
+        for(auto &b : junk) { b = r.byte(); }
+        c.random.push_back(junk);
+        const std::vector<uint8_t> &v = c.valid[r.below(uint32_t(c.valid.size()))];
+        std::vector<uint8_t> m(v);
+        m[r.below(uint32_t(m.size()))] ^= uint8_t(1 << r.below(8));
+        c.mutated.push_back(m);
+        c.truncated.push_back(std::vector<uint8_t>(v.begin(), v.begin() + r.below(uint32_t(v.size()))));
+        }
+    }
+
+// Whole valid small frames (header, body, trailer) of random shape, plus malformed variants.
+inline Corpus makeHeaderCorpus(const size_t n, const uint32_t seed = 1)
+    {
+    Corpus c;
+    Rand r(seed);
+    while(c.valid.size() < n)
+        {
+        const bool secure = (0 != (r.byte() & 1));
+        const OTRadioLink::FrameType_Secureable fType =
+            OTRadioLink::FrameType_Secureable(1 + r.below(OTRadioLink::FTS_INVALID_HIGH - 1));
+        const uint8_t il = uint8_t(r.below(OTRadioLink::SecurableFrameHeader::maxIDLength + 1));
+        const uint8_t tl = secure ? uint8_t(1 + r.below(23)) : 1;
+        const uint8_t maxBl = uint8_t(OTRadioLink::SecurableFrameHeader::maxSmallFrameSize - 3 - il - tl);
+        const uint8_t bl = uint8_t(r.below(maxBl + 1U));
+        uint8_t id[OTRadioLink::SecurableFrameHeader::maxIDLength];
+        for(auto &b : id) { b = r.byte(); }
+        uint8_t _f[OTRadioLink::SecurableFrameHeader::maxSmallFrameSize + 1];
+        OTRadioLink::OTBuf_t f(_f, sizeof(_f));
+        OTRadioLink::SecurableFrameHeader sfh;
+        const uint8_t hl = sfh.encodeHeader(f, secure, fType, r.byte(), id, il, bl, tl);
+        if(0 == hl) { continue; }
+        const uint8_t fl = _f[0];
+        for(uint8_t i = sfh.getHl(); i <= fl; ++i) { _f[i] = r.byte(); }
+        // The final trailer byte is never 0x00 nor 0xff.
+        if((0 == _f[fl]) || (0xff == _f[fl])) { _f[fl] = 0x80; }
+        c.valid.push_back(std::vector<uint8_t>(_f, _f + fl + 1));
+        }
+    addMalformed(c, r, n, 64);
+    // Secure frames with a multi-byte trailer made non-secure:
+    // rejected only at the last check (tl == 1), with the full frame present.
+    for(const auto &v : c.valid)
+        {
+        if((0 == (v[1] & 0x80)) || (v[0] - 3 - (v[2] & 0xf) - v[3 + (v[2] & 0xf)] <= 1)) { continue; }
+        std::vector<uint8_t> w(v);
+        w[1] &= 0x7f;
+        c.worstCase.push_back(w);
+        }
+    return(c);
+    }
+
+// A random valid raw JSON stats message of printable chars, 2 to maxLen chars long.
+inline std::string makeJSON(Rand &r, const size_t maxLen)
+    {
+    static const char *const keys[] = { "\"@\":\"f9ce\"", "\"+\":3", "\"T|C16\":302", "\"H|%\":63",
+        "\"L\":140", "\"O\":1", "\"vac|h\":4", "\"B|cV\":254", "\"v|%\":0", "\"tT|C\":19" };
+    std::string s("{");
+    for( ; ; )
+        {
+        const char *const k = keys[r.below(sizeof(keys) / sizeof(keys[0]))];
+        if(s.size() + strlen(k) + 2 > maxLen) { break; }
+        if(s.size() > 1) { s += ','; }
+        s += k;
+        }
+    s += '}';
+    return(s);
+    }
+
+// Valid JSON frames as received: each message with its '}'|0x80 and CRC,
+// or raw with "}\0", followed by a little trailing junk as from an RX buffer.
+inline Corpus makeJSONRXCorpus(const size_t n, const uint32_t seed = 1)
+    {
+    Corpus c;
+    Rand r(seed);
+    while(c.valid.size() < n)
+        {
+        std::string s = makeJSON(r, 20 + r.below(OTV0P2BASE::MSG_JSON_MAX_LENGTH - 19));
+        std::vector<uint8_t> f(s.begin(), s.end());
+        if(0 != (r.byte() & 1))
+            {
+            std::vector<char> t(s.begin(), s.end());
+            t.push_back('\0');
+            const uint8_t crc = OTV0P2BASE::adjustJSONMsgForTXAndComputeCRC(t.data());
+            f.assign(t.begin(), t.end() - 1);
+            f.push_back((0 == crc) ? 0x80 : crc);
+            }
+        else { f.push_back('\0'); }
+        for(uint32_t i = r.below(4); i > 0; --i) { f.push_back(r.byte()); }
+        c.valid.push_back(f);
+        }
+    addMalformed(c, r, n, 64);
+    // Printable to the full length with no terminator: every byte is scanned.
+    for(size_t i = 0; i < n; ++i)
+        {
+        std::vector<uint8_t> w(1, '{');
+        while(w.size() < 64) { w.push_back(uint8_t(32 + r.below(95))); }
+        for(auto &b : w) { if('}' == b) { b = ']'; } }
+        w[0] = '{';
+        c.worstCase.push_back(w);
+        }
+    return(c);
+    }
+
+// Valid raw JSON messages as passed to quickValidateRawSimpleJSONMessage() (without the NUL).
+inline Corpus makeJSONRawCorpus(const size_t n, const uint32_t seed = 1)
+    {
+    Corpus c;
+    Rand r(seed);
+    while(c.valid.size() < n)
+        {
+        const std::string s = makeJSON(r, 20 + r.below(OTV0P2BASE::MSG_JSON_MAX_LENGTH - 19));
+        c.valid.push_back(std::vector<uint8_t>(s.begin(), s.end()));
+        }
+    addMalformed(c, r, n, 64);
+    // Printable to beyond the maximum length.
+    for(size_t i = 0; i < n; ++i)
+        {
+        std::vector<uint8_t> w(1, '{');
+        while(w.size() < OTV0P2BASE::MSG_JSON_MAX_LENGTH + 2U) { w.push_back(uint8_t('a' + r.below(26))); }
+        c.worstCase.push_back(w);
+        }
+    return(c);
+    }
+
+}
+
+#endif // PORTABLEFUZZ_RXVALIDATIONFUZZ_H
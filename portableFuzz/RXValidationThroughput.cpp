@@ -0,0 +1,249 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+
+/*
+ * Throughput of the RX validation paths on a large corpus:
+ * headers/s through SecurableFrameHeader::decodeHeader(),
+ * and JSON frames/s through checkJSONMsgRXCRC() and quickValidateRawSimpleJSONMessage(),
+ * for valid frames and for each kind of malformed frame
+ * (random, mutated, truncated, and worst-case inputs built to be rejected as late as possible).
+ *
+ * Rejecting junk must never be much slower than accepting a good frame,
+ * else a noisy channel or a hostile sender costs a hub more CPU than real traffic.
+ * The run fails (exit 1) if any malformed class takes longer per frame
+ * than --max-reject-ratio times the valid class of the same target.
+ *
+ * Usage:
+ *     rxvalidationthroughput [--frames=N] [--min-time=SECONDS] [--corpus=DIR]
+ *                            [--max-reject-ratio=R] [--format=console|json]
+ *
+ * --corpus=DIR adds every file in DIR as an extra 'corpus' class for each target,
+ * eg a libFuzzer corpus directory or raw captured frames.
+ */
+
+#include <chrono>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+#include "RXValidationFuzz.h"
+#include "../portableBenchmarks/Benchmark.h"
+
+namespace RXVT
+{
+
+typedef std::vector<std::vector<uint8_t>> Inputs;
+
+struct Config final
+    {
+    size_t frames = 20000;
+    double minTime = 0.1;
+    const char *corpus = NULL;
+    double maxRejectRatio = 2.0;
+    bool json = false;
+    };
+
+// One input class through one target.
+struct Result final
+    {
+    const char *target;
+    const char *kind;
+    size_t inputs;
+    size_t accepted;
+    double nsPerFrame;
+    };
+
+typedef size_t (*Pass)(const Inputs &in);
+
+// The library calls exactly as made on RX, counting acceptances.
+size_t passDecodeHeader(const Inputs &in)
+    {
+    size_t accepted = 0;
+    OTRadioLink::SecurableFrameHeader sfh;
+    for(const auto &v : in)
+        {
+        const uint8_t n = (v.size() > 255) ? 255 : uint8_t(v.size());
+        if(0 != sfh.decodeHeader(v.data(), n)) { ++accepted; }
+        OTBM::doNotOptimise(sfh);
+        }
+    return(accepted);
+    }
+size_t passCheckJSONMsgRXCRC(const Inputs &in)
+    {
+    size_t accepted = 0;
+    for(const auto &v : in)
+        {
+        const uint8_t n = (v.size() > 255) ? 255 : uint8_t(v.size());
+        const int8_t l = OTV0P2BASE::checkJSONMsgRXCRC(v.data(), n);
+        if(OTV0P2BASE::checkJSONMsgRXCRC_ERR != l) { ++accepted; }
+        OTBM::doNotOptimise(l);
+        }
+    return(accepted);
+    }
+// Inputs here already carry their terminating NUL.
+size_t passQuickValidate(const Inputs &in)
+    {
+    size_t accepted = 0;
+    for(const auto &v : in)
+        {
+        const bool ok = OTV0P2BASE::quickValidateRawSimpleJSONMessage(reinterpret_cast<const char *>(v.data()));
+        if(ok) { ++accepted; }
+        OTBM::doNotOptimise(ok);
+        }
+    return(accepted);
+    }
+
+// Time whole passes over in until at least minTime has elapsed.
+Result measure(const Config &cfg, const char *const target, const char *const kind, const Inputs &in, const Pass pass)
+    {
+    Result r = { target, kind, in.size(), pass(in), 0 };
+    if(in.empty()) { return(r); }
+    uint64_t frames = 0;
+    const auto start = std::chrono::steady_clock::now();
+    double elapsed;
+    do  {
+        pass(in);
+        frames += in.size();
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while(elapsed < cfg.minTime);
+    r.nsPerFrame = (elapsed * 1e9) / double(frames);
+    return(r);
+    }
+
+// Each file in dir; empty if none or unreadable.
+Inputs loadDir(const char *const dir)
+    {
+    Inputs in;
+    DIR *const d = opendir(dir);
+    if(NULL == d) { return(in); }
+    for(const struct dirent *e; NULL != (e = readdir(d)); )
+        {
+        const std::string path = std::string(dir) + "/" + e->d_name;
+        struct stat st;
+        if((0 != stat(path.c_str(), &st)) || !S_ISREG(st.st_mode)) { continue; }
+        FILE *const f = fopen(path.c_str(), "rb");
+        if(NULL == f) { continue; }
+        std::vector<uint8_t> v;
+        uint8_t buf[256];
+        size_t n;
+        while((n = fread(buf, 1, sizeof(buf), f)) > 0) { v.insert(v.end(), buf, buf + n); }
+        fclose(f);
+        in.push_back(v);
+        }
+    closedir(d);
+    return(in);
+    }
+
+// With a NUL appended to each input.
+Inputs terminated(Inputs in)
+    {
+    for(auto &v : in) { v.push_back(0); }
+    return(in);
+    }
+
+// Measure every class of c (and any external corpus) for one target.
+void measureAll(const Config &cfg, std::vector<Result> &results, const char *const target,
+                const OTFZ::Corpus &c, const Inputs &external, const Pass pass, const bool addNUL)
+    {
+    const struct { const char *kind; const Inputs *in; } classes[] = {
+        { "valid", &c.valid }, { "random", &c.random }, { "mutated", &c.mutated },
+        { "truncated", &c.truncated }, { "worst_case", &c.worstCase }, { "corpus", &external },
+        };
+    for(const auto &k : classes)
+        {
+        if(k.in->empty()) { continue; }
+        results.push_back(measure(cfg, target, k.kind, addNUL ? terminated(*k.in) : *k.in, pass));
+        }
+    }
+
+bool startsWith(const char *const s, const char *const prefix, const char *&value)
+    {
+    const size_t n = strlen(prefix);
+    if(0 != strncmp(s, prefix, n)) { return(false); }
+    value = s + n;
+    return(true);
+    }
+
+}
+
+int main(const int argc, const char *const argv[])
+    {
+    RXVT::Config cfg;
+    for(int i = 1; i < argc; ++i)
+        {
+        const char *v;
+        if(RXVT::startsWith(argv[i], "--frames=", v)) { cfg.frames = size_t(strtoul(v, NULL, 10)); }
+        else if(RXVT::startsWith(argv[i], "--min-time=", v)) { cfg.minTime = atof(v); }
+        else if(RXVT::startsWith(argv[i], "--corpus=", v)) { cfg.corpus = v; }
+        else if(RXVT::startsWith(argv[i], "--max-reject-ratio=", v)) { cfg.maxRejectRatio = atof(v); }
+        else if(RXVT::startsWith(argv[i], "--format=", v)) { cfg.json = (0 == strcmp(v, "json")); }
+        else { fprintf(stderr, "unknown argument: %s\n", argv[i]); return(2); }
+        }
+    if((0 == cfg.frames) || (cfg.maxRejectRatio <= 0)) { fprintf(stderr, "bad arguments\n"); return(2); }
+    RXVT::Inputs external;
+    if(NULL != cfg.corpus)
+        {
+        external = RXVT::loadDir(cfg.corpus);
+        if(external.empty()) { fprintf(stderr, "no inputs in corpus: %s\n", cfg.corpus); return(1); }
+        }
+
+    std::vector<RXVT::Result> results;
+    RXVT::measureAll(cfg, results, "decodeHeader", OTFZ::makeHeaderCorpus(cfg.frames), external,
+        RXVT::passDecodeHeader, false);
+    RXVT::measureAll(cfg, results, "checkJSONMsgRXCRC", OTFZ::makeJSONRXCorpus(cfg.frames), external,
+        RXVT::passCheckJSONMsgRXCRC, false);
+    RXVT::measureAll(cfg, results, "quickValidateRawSimpleJSONMessage", OTFZ::makeJSONRawCorpus(cfg.frames), external,
+        RXVT::passQuickValidate, true);
+
+    // Each target's valid class comes first.
+    bool ok = true;
+    double validNs = 0;
+    if(cfg.json) { printf("{\n  \"results\": [\n"); }
+    else { printf("%-34s %-10s %8s %8s %10s %14s %7s\n", "target", "class", "inputs", "accepted", "ns/frame", "frames/s", "ratio"); }
+    for(size_t i = 0; i < results.size(); ++i)
+        {
+        const RXVT::Result &r = results[i];
+        if(0 == strcmp(r.kind, "valid")) { validNs = r.nsPerFrame; }
+        const double ratio = (validNs > 0) ? (r.nsPerFrame / validNs) : 0;
+        // Only malformed classes are bounded; the external corpus may be valid or not.
+        const bool bounded = (0 != strcmp(r.kind, "valid")) && (0 != strcmp(r.kind, "corpus"));
+        const bool pass = !bounded || (ratio <= cfg.maxRejectRatio);
+        if(!pass) { ok = false; }
+        const double fps = (r.nsPerFrame > 0) ? (1e9 / r.nsPerFrame) : 0;
+        if(cfg.json)
+            {
+            printf("%s    {\"target\": \"%s\", \"class\": \"%s\", \"inputs\": %zu, \"accepted\": %zu,"
+                   " \"ns_per_frame\": %.2f, \"frames_per_second\": %.0f, \"ratio_to_valid\": %.3f, \"pass\": %s}",
+                (0 == i) ? "" : ",\n", r.target, r.kind, r.inputs, r.accepted, r.nsPerFrame, fps, ratio,
+                pass ? "true" : "false");
+            }
+        else
+            {
+            printf("%-34s %-10s %8zu %8zu %10.2f %14.0f %6.2fx%s\n",
+                r.target, r.kind, r.inputs, r.accepted, r.nsPerFrame, fps, ratio, pass ? "" : "  SLOW REJECT");
+            }
+        }
+    if(cfg.json) { printf("\n  ],\n  \"max_reject_ratio\": %.3f,\n  \"pass\": %s\n}\n", cfg.maxRejectRatio, ok ? "true" : "false"); }
+    else if(!ok) { printf("FAILED: a malformed class is over %.2fx slower than valid frames\n", cfg.maxRejectRatio); }
+    return(ok ? 0 : 1);
+    }
@@ -0,0 +1,85 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+
+/*
+ * Driver for the Fuzz*.cpp targets where libFuzzer is not available (eg gcc):
+ * runs each file named on the command line, or each file in each directory named,
+ * once through LLVMFuzzerTestOneInput().
+ * Useful to reproduce a crash found by libFuzzer or to replay a corpus
+ * under a debugger or valgrind.
+ *
+ * Usage:
+ *     fuzz_xxx FILE_OR_DIR...
+ */
+
+#include <algorithm>
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+namespace {
+// Run one file through the target; false if it cannot be read.
+bool runFile(const std::string &path)
+    {
+    FILE *const f = fopen(path.c_str(), "rb");
+    if(NULL == f) { return(false); }
+    std::vector<uint8_t> data;
+    uint8_t buf[256];
+    size_t n;
+    while((n = fread(buf, 1, sizeof(buf), f)) > 0) { data.insert(data.end(), buf, buf + n); }
+    fclose(f);
+    // Exactly-sized copy so that ASan (if enabled) catches over-reads.
+    uint8_t *const copy = new uint8_t[data.size() + (data.empty() ? 1 : 0)];
+    std::copy(data.begin(), data.end(), copy);
+    LLVMFuzzerTestOneInput(copy, data.size());
+    delete[] copy;
+    return(true);
+    }
+}
+
+int main(const int argc, const char *const argv[])
+    {
+    unsigned runs = 0;
+    for(int i = 1; i < argc; ++i)
+        {
+        struct stat st;
+        if(0 != stat(argv[i], &st)) { fprintf(stderr, "cannot read: %s\n", argv[i]); return(1); }
+        if(!S_ISDIR(st.st_mode))
+            {
+            if(!runFile(argv[i])) { fprintf(stderr, "cannot read: %s\n", argv[i]); return(1); }
+            ++runs;
+            continue;
+            }
+        DIR *const d = opendir(argv[i]);
+        if(NULL == d) { fprintf(stderr, "cannot read: %s\n", argv[i]); return(1); }
+        for(const struct dirent *e; NULL != (e = readdir(d)); )
+            {
+            const std::string path = std::string(argv[i]) + "/" + e->d_name;
+            if((0 == stat(path.c_str(), &st)) && S_ISREG(st.st_mode) && runFile(path)) { ++runs; }
+            }
+        closedir(d);
+        }
+    printf("%u inputs run\n", runs);
+    return(0);
+    }
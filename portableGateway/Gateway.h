@@ -0,0 +1,567 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Host-side (eg Linux / Raspberry Pi) gateway runtime.
+ *
+ * Takes raw secure frames relayed undecoded by a serial-attached hub
+ * and authenticates and decrypts them on the host with the library's
+ * SimpleSecureFrame32or0BodyRXBase logic, as SimpleSecureFrame32or0BodyRXV0p2
+ * would on the hub, publishing the stats as the hub's serialFrameOperation() would.
+ *
+ * Nodes are sharded across a pool of worker threads by the first byte of their ID,
+ * so that each node's RX message counter is owned by exactly one worker
+ * and the counter checks and updates (and so replay protection) need no locking.
+ * Frames are routed to their shard's bounded queue by the (unauthenticated) header ID;
+ * a full queue blocks the reader rather than dropping frames.
+ *
+ * Accepted input lines (see parseHubLine()):
+ *   - printRXMsg() output, eg "|5  a {  81FD" for 0x61 0x7b 0x20 0x81 0xfd;
+ *   - radioSniffer output, a ':' then hex bytes;
+ *   - a line of exactly-two-digit hex bytes;
+ *   - JSON stats already decoded on the hub (eg from outputJSONStats()), published unchanged.
+ * The hub's framed binary output (see OTRadioLink_HubBinaryOutput.h)
+ * is also accepted, through HubBinaryDecoder and submit(const HubBinaryRecord &).
+ *
+ * Host only: needs C++11 threads.
+ */
+
+#ifndef OTGW_GATEWAY_H
+#define OTGW_GATEWAY_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <OTV0p2Base.h>
+#include <OTRadioLink.h>
+#if defined(EXT_AVAILABLE_ARDUINO_LIB_OTAESGCM)
+#include <OTAESGCM.h>
+#endif
+
+
+namespace OTGW
+{
+
+// Maximum raw frame length, as for OTRFM23BLink.
+static constexpr uint8_t maxFrameLen = 64;
+static constexpr uint8_t idBytes = OTV0P2BASE::OpenTRV_Node_ID_Bytes;
+static constexpr uint8_t ctrBytes = OTRadioLink::SimpleSecureFrame32or0BodyBase::fullMsgCtrBytes;
+
+// The decryption used by default, with the workspace it needs.
+struct DefaultDecryption final
+    {
+#if defined(EXT_AVAILABLE_ARDUINO_LIB_OTAESGCM)
+    static OTRadioLink::SimpleSecureFrame32or0BodyRXBase::fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &fn()
+        { return(OTAESGCM::fixed32BTextSize12BNonce16BTagSimpleDec_DEFAULT_WITH_LWORKSPACE); }
+    static constexpr size_t workspace = OTAESGCM::OTAES128GCMGenericWithWorkspace<>::workspaceRequiredDec;
+#else
+    static OTRadioLink::SimpleSecureFrame32or0BodyRXBase::fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &fn()
+        { return(OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL); }
+    // The NULL decryption needs a non-NULL workspace.
+    static constexpr size_t workspace = 1;
+#endif
+    };
+
+// One raw frame, laid out with its length byte first as decodeHeader() expects.
+struct RawFrame final
+    {
+    // buf[0] is the frame length in [1,maxFrameLen], followed by the frame.
+    uint8_t buf[1 + maxFrameLen];
+    uint8_t len() const { return(buf[0]); }
+    // Set from len bytes; returns false if len is out of range.
+    bool set(const uint8_t *const frame, const size_t len)
+        {
+        if((0 == len) || (len > maxFrameLen)) { return(false); }
+        buf[0] = uint8_t(len);
+        memcpy(buf + 1, frame, len);
+        return(true);
+        }
+    };
+
+// Kind of line parsed by parseHubLine().
+enum class HubLine : uint8_t { OTHER, FRAME, JSON };
+
+// Value of hex digit c, or -1.
+inline int hexDigit(const char c)
+    {
+    if((c >= '0') && (c <= '9')) { return(c - '0'); }
+    if((c >= 'a') && (c <= 'f')) { return(c - 'a' + 10); }
+    if((c >= 'A') && (c <= 'F')) { return(c - 'A' + 10); }
+    return(-1);
+    }
+
+// Parse one line of hub serial output.
+// Returns FRAME with f set for a raw frame, JSON with json set (without line ending) for JSON stats,
+// else OTHER, eg for a status line, a prompt or a malformed frame.
+inline HubLine parseHubLine(const char *p, RawFrame &f, std::string &json)
+    {
+    while((' ' == *p) || ('\t' == *p)) { ++p; }
+    size_t n = strlen(p);
+    while((n > 0) && (('\r' == p[n-1]) || ('\n' == p[n-1]))) { --n; }
+    if(0 == n) { return(HubLine::OTHER); }
+    if(('{' == *p) && ('}' == p[n-1])) { json.assign(p, n); return(HubLine::JSON); }
+    uint8_t frame[maxFrameLen];
+    size_t len = 0;
+    if('|' == *p)
+        {
+        // printRXMsg(): length, space, then each byte as two hex digits or a space and the printable char.
+        char *end;
+        const unsigned long expected = strtoul(p + 1, &end, 10);
+        if((end == p + 1) || (' ' != *end) || (expected > maxFrameLen)) { return(HubLine::OTHER); }
+        const char *q = end + 1;
+        const char *const e = p + n;
+        while(q + 1 < e)
+            {
+            if(len >= maxFrameLen) { return(HubLine::OTHER); }
+            if(' ' == q[0]) { frame[len++] = uint8_t(q[1]); }
+            else
+                {
+                const int h = hexDigit(q[0]), l = hexDigit(q[1]);
+                if((h < 0) || (l < 0)) { return(HubLine::OTHER); }
+                frame[len++] = uint8_t((h << 4) | l);
+                }
+            q += 2;
+            }
+        if((q != e) || (len != expected)) { return(HubLine::OTHER); }
+        }
+    else
+        {
+        // radioSniffer ':' then bytes of one or two hex digits, else exactly-two-digit hex bytes.
+        const bool sniffer = (':' == *p);
+        if(sniffer) { ++p; --n; }
+        const char *q = p;
+        const char *const e = p + n;
+        while(q < e)
+            {
+            while((q < e) && ((' ' == *q) || ('\t' == *q))) { ++q; }
+            if(q >= e) { break; }
+            const char *const t = q;
+            while((q < e) && (hexDigit(*q) >= 0)) { ++q; }
+            const size_t digits = size_t(q - t);
+            if((q < e) && (' ' != *q) && ('\t' != *q)) { return(HubLine::OTHER); }
+            if((0 == digits) || (digits > 2) || (!sniffer && (2 != digits))) { return(HubLine::OTHER); }
+            if(len >= maxFrameLen) { return(HubLine::OTHER); }
+            frame[len++] = uint8_t((2 == digits) ? ((hexDigit(t[0]) << 4) | hexDigit(t[1])) : hexDigit(t[0]));
+            }
+        }
+    // Too short to be useful, as for decodeAndHandleRawRXedMessage().
+    if(len < 2) { return(HubLine::OTHER); }
+    f.set(frame, len);
+    return(HubLine::FRAME);
+    }
+
+// Worker shard for a node ID or frame header ID first byte.
+inline uint8_t shardOf(const uint8_t firstIDByte, const uint8_t shards) { return(uint8_t(firstIDByte % shards)); }
+
+// RX node associations and message counters for one shard, in RAM, sorted by ID.
+// Not thread-safe: owned by one worker once the gateway has started.
+class NodeShard final : public OTRadioLink::SimpleSecureFrame32or0BodyRXBase
+    {
+    private:
+        struct Node final
+            {
+            uint8_t id[idBytes];
+            uint8_t ctr[ctrBytes];
+            };
+        std::vector<Node> nodes;
+
+        // First node with ID not less than the il bytes of prefix.
+        std::vector<Node>::const_iterator lowerBound(const uint8_t *const prefix, const uint8_t il) const
+            {
+            return(std::lower_bound(nodes.begin(), nodes.end(), prefix,
+                [il](const Node &n, const uint8_t *const p) { return(memcmp(n.id, p, il) < 0); }));
+            }
+        Node *find(const uint8_t *const id)
+            {
+            const std::vector<Node>::const_iterator i = lowerBound(id, idBytes);
+            if((nodes.end() == i) || (0 != memcmp(i->id, id, idBytes))) { return(NULL); }
+            return(&nodes[size_t(i - nodes.begin())]);
+            }
+        const Node *find(const uint8_t *const id) const { return(const_cast<NodeShard *>(this)->find(id)); }
+
+        // Nodes matching the header ID prefix, in ID order; index counts from the first match.
+        virtual int8_t _getNextMatchingNodeID(const uint8_t index, const OTRadioLink::SecurableFrameHeader *const sfh,
+                                              uint8_t *nodeID) const override
+            {
+            const uint8_t il = sfh->getIl();
+            // Anonymous frames cannot be attributed.
+            if(0 == il) { return(-1); }
+            const std::vector<Node>::const_iterator first = lowerBound(sfh->id, il);
+            if((index > 127) || (size_t(nodes.end() - first) <= index)) { return(-1); }
+            const Node &n = first[index];
+            if(0 != memcmp(n.id, sfh->id, il)) { return(-1); }
+            memcpy(nodeID, n.id, idBytes);
+            return(int8_t(index));
+            }
+
+    public:
+        // Associate a node, replacing any existing entry for it; counter NULL for all zeros.
+        void add(const uint8_t *const id, const uint8_t *const counter = NULL)
+            {
+            Node n;
+            memcpy(n.id, id, idBytes);
+            if(NULL == counter) { memset(n.ctr, 0, ctrBytes); } else { memcpy(n.ctr, counter, ctrBytes); }
+            Node *const existing = find(id);
+            if(NULL != existing) { *existing = n; return; }
+            nodes.insert(nodes.begin() + (lowerBound(id, idBytes) - nodes.begin()), n);
+            }
+        size_t size() const { return(nodes.size()); }
+
+        virtual bool getLastRXMsgCtr(const uint8_t *const ID, uint8_t *counter) const override
+            {
+            const Node *const n = find(ID);
+            if(NULL == n) { return(false); }
+            memcpy(counter, n->ctr, ctrBytes);
+            return(true);
+            }
+        virtual bool authAndUpdateRXMsgCtr(const uint8_t *ID, const uint8_t *newCounterValue) override
+            {
+            if(!validateRXMsgCtr(ID, newCounterValue)) { return(false); }
+            memcpy(find(ID)->ctr, newCounterValue, ctrBytes);
+            return(true);
+            }
+    };
+
+// Format a decoded 'O' frame body (dbLen bytes from db) from node id with sequence number seq
+// as serialFrameOperation() does, ie with synthetic ID '@' and sequence '+';
+// returns false if the body holds no JSON stats.
+inline bool formatStats(const uint8_t *const id, const uint8_t seq, const uint8_t *const db, const uint8_t dbLen, std::string &out)
+    {
+    if(!((dbLen > 3) && (0 != (db[1] & 0x10)) && ('{' == db[2]))) { return(false); }
+    char hdr[64];
+    int o = snprintf(hdr, sizeof(hdr), "{\"@\":\"");
+    for(uint8_t i = 0; i < idBytes; ++i) { o += snprintf(hdr + o, sizeof(hdr) - size_t(o), "%02X", id[i]); }
+    snprintf(hdr + o, sizeof(hdr) - size_t(o), "\",\"+\":%u,", unsigned(seq));
+    out.assign(hdr);
+    out.append(reinterpret_cast<const char *>(db + 3), dbLen - 3U);
+    out.push_back('}');
+    return(true);
+    }
+inline bool formatStats(const OTRadioLink::OTDecodeData_T &fd, std::string &out)
+    { return(formatStats(fd.id, fd.sfh.getSeq(), fd.ptext, fd.ptextLen, out)); }
+
+// One record of the hub's framed binary output (see OTRadioLink_HubBinaryOutput.h).
+struct HubBinaryRecord final
+    {
+    uint8_t type;
+    // Node ID bytes given; 0 if none.
+    uint8_t idLen;
+    uint8_t id[idBytes];
+    int8_t rssi;
+    uint8_t bodyLen;
+    uint8_t body[OTRadioLink::HUB_BINARY_MAX_LEN];
+    };
+
+// Incremental decoder for the hub's framed binary output.
+// Bytes may be fed in as they arrive, in any size of chunk.
+// Records that are malformed or fail their CRC are counted and skipped
+// by hunting for the next sync byte, including within the bad record.
+class HubBinaryDecoder final
+    {
+    private:
+        // Bytes of the record being assembled, from its sync byte.
+        uint8_t buf[2 + OTRadioLink::HUB_BINARY_MAX_LEN + 2];
+        size_t n = 0;
+        // Bad records, and bytes skipped outside records.
+        uint64_t bad = 0;
+        uint64_t skipped = 0;
+
+        // Drop the current sync byte and hunt for the next.
+        void resync()
+            {
+            ++bad;
+            size_t i = 1;
+            while((i < n) && (OTRadioLink::HUB_BINARY_SYNC != buf[i])) { ++i; }
+            skipped += i - 1;
+            memmove(buf, buf + i, n - i);
+            n -= i;
+            }
+
+        // Take one complete record from the start of buf into r if there is one.
+        bool extract(HubBinaryRecord &r)
+            {
+            while(n >= 2)
+                {
+                const uint8_t len = buf[1];
+                if((len < 3) || (len > OTRadioLink::HUB_BINARY_MAX_LEN)) { resync(); continue; }
+                const size_t total = 2U + len + 2U;
+                if(n < total) { return(false); }
+                const uint16_t crc = OTV0P2BASE::crc16_A001_buf(0xffff, buf + 1, uint8_t(len + 1));
+                const uint8_t idLen = buf[3];
+                if((uint16_t(buf[2 + len] | (buf[3 + len] << 8)) != crc) || (idLen > idBytes) || (3U + idLen > len))
+                    { resync(); continue; }
+                r.type = buf[2];
+                r.idLen = idLen;
+                memcpy(r.id, buf + 4, idLen);
+                r.rssi = int8_t(buf[4 + idLen]);
+                r.bodyLen = uint8_t(len - 3 - idLen);
+                memcpy(r.body, buf + 5 + idLen, r.bodyLen);
+                memmove(buf, buf + total, n - total);
+                n -= total;
+                return(true);
+                }
+            return(false);
+            }
+
+    public:
+        // Feed len bytes, calling onRecord(const HubBinaryRecord &) for each complete valid record.
+        template<class F>
+        void feed(const uint8_t *const data, const size_t len, F onRecord)
+            {
+            HubBinaryRecord r;
+            for(size_t i = 0; i < len; ++i)
+                {
+                if((0 == n) && (OTRadioLink::HUB_BINARY_SYNC != data[i])) { ++skipped; continue; }
+                buf[n++] = data[i];
+                while(extract(r)) { onRecord(static_cast<const HubBinaryRecord &>(r)); }
+                }
+            }
+
+        // Records dropped as malformed or failing their CRC.
+        uint64_t badRecords() const { return(bad); }
+        // Bytes skipped while hunting for a sync byte.
+        uint64_t skippedBytes() const { return(skipped); }
+    };
+
+// Counts since the gateway was created.
+struct GatewayStats final
+    {
+    // Frames submitted and routed to a worker.
+    uint64_t frames = 0;
+    // Frames authenticated and decrypted.
+    uint64_t decoded = 0;
+    // Secure 'O' frames failing auth, from an unknown node, or replayed.
+    uint64_t rejected = 0;
+    // Frames that were not well-formed secure 'O' frames with a header ID.
+    uint64_t ignored = 0;
+    // Stats messages published, including JSON passed through.
+    uint64_t published = 0;
+    };
+
+// Multi-threaded secure frame decode service.
+// Configure nodes with addNode(), then start(); submit() and publishJSON()
+// may then be called from one reader thread until stop().
+class Gateway final
+    {
+    public:
+        // Called with each stats message as a line of JSON (without line ending),
+        // from one thread at a time.
+        typedef std::function<void(const std::string &)> Publisher;
+
+    private:
+        struct Worker final
+            {
+            NodeShard rx;
+            std::deque<RawFrame> q;
+            std::mutex m;
+            std::condition_variable notEmpty;
+            std::condition_variable notFull;
+            bool stopping = false;
+            std::thread t;
+            };
+
+        OTRadioLink::SimpleSecureFrame32or0BodyRXBase::fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &dec;
+        const size_t decWorkspace;
+        uint8_t key[16];
+        const size_t queueDepth;
+        std::vector<std::unique_ptr<Worker> > workers;
+        Publisher publisher;
+        std::mutex publishMutex;
+        bool running = false;
+
+        std::atomic<uint64_t> frames, decoded, rejected, ignored, published;
+
+        void publish(const std::string &msg)
+            {
+            std::lock_guard<std::mutex> lock(publishMutex);
+            if(publisher) { publisher(msg); }
+            ++published;
+            }
+
+        void run(Worker &w)
+            {
+            std::vector<uint8_t> workspace(
+                OTRadioLink::SimpleSecureFrame32or0BodyRXBase::decode_total_scratch_usage_OTAESGCM_3p0 + decWorkspace);
+            std::string msg;
+            for( ; ; )
+                {
+                RawFrame f;
+                    {
+                    std::unique_lock<std::mutex> lock(w.m);
+                    w.notEmpty.wait(lock, [&w] { return(w.stopping || !w.q.empty()); });
+                    // Drain fully before stopping.
+                    if(w.q.empty()) { return; }
+                    f = w.q.front();
+                    w.q.pop_front();
+                    }
+                w.notFull.notify_one();
+                uint8_t body[OTRadioLink::ENC_BODY_SMALL_FIXED_CTEXT_SIZE];
+                OTRadioLink::OTDecodeData_T fd(f.buf, body, OTRadioLink::OTDecodeData_T::PTEXT_IN_PLACE);
+                fd.sfh.decodeHeader(f.buf, uint8_t(f.len() + 1));
+                OTV0P2BASE::ScratchSpaceL sW(workspace.data(), workspace.size());
+                if(0 == w.rx.decode(fd, dec, sW, key)) { ++rejected; continue; }
+                ++decoded;
+                if(formatStats(fd, msg)) { publish(msg); }
+                }
+            }
+
+    public:
+        //   * key_  16-byte building (primary) key
+        //   * shards  worker threads, in [1,128]
+        //   * queueDepth_  frames queued per worker before submit() blocks
+        Gateway(const uint8_t *const key_, const uint8_t shards, const size_t queueDepth_ = 256,
+                OTRadioLink::SimpleSecureFrame32or0BodyRXBase::fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &dec_ = DefaultDecryption::fn(),
+                const size_t decWorkspace_ = DefaultDecryption::workspace)
+          : dec(dec_), decWorkspace(decWorkspace_), queueDepth((0 == queueDepth_) ? 1 : queueDepth_),
+            frames(0), decoded(0), rejected(0), ignored(0), published(0)
+            {
+            memcpy(key, key_, sizeof(key));
+            const uint8_t n = std::max<uint8_t>(1, std::min<uint8_t>(shards, 128));
+            for(uint8_t i = 0; i < n; ++i) { workers.emplace_back(new Worker); }
+            }
+        ~Gateway() { stop(); memset(key, 0, sizeof(key)); }
+        Gateway(const Gateway &) = delete;
+        Gateway &operator=(const Gateway &) = delete;
+
+        uint8_t shards() const { return(uint8_t(workers.size())); }
+        // Nodes associated across all shards.
+        size_t nodes() const
+            {
+            size_t n = 0;
+            for(const std::unique_ptr<Worker> &w : workers) { n += w->rx.size(); }
+            return(n);
+            }
+
+        // Associate a node (8-byte ID) with its last authenticated 6-byte counter, or NULL for zeros.
+        // Only before start().
+        bool addNode(const uint8_t *const id, const uint8_t *const counter = NULL)
+            {
+            if(running) { return(false); }
+            workers[shardOf(id[0], shards())]->rx.add(id, counter);
+            return(true);
+            }
+
+        // Start the workers, publishing through p.
+        void start(const Publisher &p)
+            {
+            if(running) { return; }
+            publisher = p;
+            running = true;
+            for(std::unique_ptr<Worker> &w : workers)
+                {
+                w->stopping = false;
+                Worker *const wp = w.get();
+                w->t = std::thread([this, wp] { run(*wp); });
+                }
+            }
+
+        // Queue a frame (without its length byte) for decoding by the worker for its header ID,
+        // blocking while that worker's queue is full.
+        // Returns false if the gateway is not running or the frame is not a secure 'O' frame with an ID.
+        bool submit(const uint8_t *const frame, const uint8_t len)
+            {
+            RawFrame f;
+            if(!running || !f.set(frame, len)) { ++ignored; return(false); }
+            OTRadioLink::SecurableFrameHeader sfh;
+            if((0 == sfh.decodeHeader(f.buf, uint8_t(len + 1))) || !sfh.isSecure() ||
+               ((OTRadioLink::FTS_BasicSensorOrValve | 0x80) != frame[0]) || (0 == sfh.getIl()))
+                { ++ignored; return(false); }
+            Worker &w = *workers[shardOf(sfh.id[0], shards())];
+                {
+                std::unique_lock<std::mutex> lock(w.m);
+                w.notFull.wait(lock, [this, &w] { return(w.q.size() < queueDepth); });
+                w.q.push_back(f);
+                }
+            w.notEmpty.notify_one();
+            ++frames;
+            return(true);
+            }
+        bool submit(const RawFrame &f) { return(submit(f.buf + 1, f.len())); }
+
+        // Publish JSON stats already decoded elsewhere (eg by the hub itself) unchanged.
+        void publishJSON(const std::string &json) { publish(json); }
+
+        // Handle one record of the hub's framed binary output:
+        // raw frames are queued as by submit(), decoded frames are formatted
+        // as the hub's serialFrameOperation() would, and JSON is published unchanged.
+        // Returns false if the record was not used.
+        bool submit(const HubBinaryRecord &r)
+            {
+            switch(r.type)
+                {
+                case OTRadioLink::HBT_RAW_FRAME: return(submit(r.body, r.bodyLen));
+                case OTRadioLink::HBT_JSON:
+                    if((0 == r.bodyLen) || ('{' != r.body[0])) { break; }
+                    publishJSON(std::string(reinterpret_cast<const char *>(r.body), r.bodyLen));
+                    return(true);
+                case OTRadioLink::HBT_DECODED_O:
+                    {
+                    std::string msg;
+                    if((idBytes != r.idLen) || (r.bodyLen < 1) ||
+                       !formatStats(r.id, r.body[0], r.body + 1, uint8_t(r.bodyLen - 1), msg)) { break; }
+                    publish(msg);
+                    return(true);
+                    }
+                default: break;
+                }
+            ++ignored;
+            return(false);
+            }
+
+        // Finish all queued frames and stop the workers.
+        void stop()
+            {
+            if(!running) { return; }
+            for(std::unique_ptr<Worker> &w : workers)
+                {
+                    {
+                    std::lock_guard<std::mutex> lock(w->m);
+                    w->stopping = true;
+                    }
+                w->notEmpty.notify_all();
+                }
+            for(std::unique_ptr<Worker> &w : workers) { w->t.join(); }
+            running = false;
+            }
+
+        GatewayStats stats() const
+            {
+            GatewayStats s;
+            s.frames = frames;
+            s.decoded = decoded;
+            s.rejected = rejected;
+            s.ignored = ignored;
+            s.published = published;
+            return(s);
+            }
+    };
+
+}
+
+#endif
@@ -0,0 +1,258 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Linux gateway: decodes secure frames relayed by a serial-attached hub
+ * on a pool of worker threads and prints the stats, one JSON object per line,
+ * to stdout (see Gateway.h).
+ *
+ * Usage:
+ *     otgateway --key=HEX32 --nodes=FILE [--threads=N] [--queue=N]
+ *               [--binary|--framed] [--baud=B] [INPUT]
+ *
+ * INPUT is a serial device (eg /dev/ttyUSB0, set raw at --baud, default 4800),
+ * a capture file, or stdin if absent or "-".
+ * Text input is hub output as accepted by OTGW::parseHubLine();
+ * with --binary it is a raw feed of frames each preceded by its length byte;
+ * with --framed it is the hub's framed binary output (see OTRadioLink_HubBinaryOutput.h).
+ *
+ * The nodes file has one associated node per line: its 16-hex-digit ID,
+ * optionally followed by its last authenticated 12-hex-digit message counter;
+ * blank lines and lines starting '#' are ignored.
+ *
+ * Counts are printed to stderr at the end of the input.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "Gateway.h"
+
+
+namespace OTGWM
+{
+
+struct Config
+    {
+    uint8_t key[16];
+    bool haveKey = false;
+    const char *nodes = NULL;
+    uint8_t threads = 4;
+    size_t queue = 256;
+    bool binary = false;
+    bool framed = false;
+    unsigned long baud = 4800;
+    const char *input = NULL;
+    };
+
+// Parse exactly n bytes of hex from s into out; returns false if malformed.
+static bool parseHex(const char *s, uint8_t *const out, const size_t n)
+    {
+    for(size_t i = 0; i < n; ++i, s += 2)
+        {
+        const int h = OTGW::hexDigit(s[0]);
+        const int l = (h < 0) ? -1 : OTGW::hexDigit(s[1]);
+        if(l < 0) { return(false); }
+        out[i] = uint8_t((h << 4) | l);
+        }
+    return(true);
+    }
+
+static void usage()
+    {
+    fprintf(stderr, "usage: otgateway --key=HEX32 --nodes=FILE [--threads=N] [--queue=N] [--binary|--framed] [--baud=B] [INPUT]\n");
+    }
+
+static bool parseArgs(const int argc, char **const argv, Config &cfg)
+    {
+    for(int i = 1; i < argc; ++i)
+        {
+        const char *const a = argv[i];
+        if(0 == strncmp(a, "--key=", 6))
+            {
+            if((32 != strlen(a + 6)) || !parseHex(a + 6, cfg.key, sizeof(cfg.key))) { return(false); }
+            cfg.haveKey = true;
+            }
+        else if(0 == strncmp(a, "--nodes=", 8)) { cfg.nodes = a + 8; }
+        else if(0 == strncmp(a, "--threads=", 10))
+            {
+            const long n = strtol(a + 10, NULL, 10);
+            if((n < 1) || (n > 128)) { return(false); }
+            cfg.threads = uint8_t(n);
+            }
+        else if(0 == strncmp(a, "--queue=", 8))
+            {
+            const long n = strtol(a + 8, NULL, 10);
+            if(n < 1) { return(false); }
+            cfg.queue = size_t(n);
+            }
+        else if(0 == strcmp(a, "--binary")) { cfg.binary = true; }
+        else if(0 == strcmp(a, "--framed")) { cfg.framed = true; }
+        else if(0 == strncmp(a, "--baud=", 7)) { cfg.baud = strtoul(a + 7, NULL, 10); }
+        else if(('-' == a[0]) && ('\0' != a[1])) { return(false); }
+        else { cfg.input = a; }
+        }
+    return(cfg.haveKey && (NULL != cfg.nodes) && !(cfg.binary && cfg.framed));
+    }
+
+// Associate the nodes listed in path; returns the number added, or -1 on error.
+static long loadNodes(const char *const path, OTGW::Gateway &gw)
+    {
+    FILE *const f = fopen(path, "r");
+    if(NULL == f) { return(-1); }
+    long added = 0;
+    char line[256];
+    for(unsigned lineNo = 1; NULL != fgets(line, sizeof(line), f); ++lineNo)
+        {
+        const char *p = line;
+        while((' ' == *p) || ('\t' == *p)) { ++p; }
+        if(('#' == *p) || ('\r' == *p) || ('\n' == *p) || ('\0' == *p)) { continue; }
+        uint8_t id[OTGW::idBytes];
+        uint8_t ctr[OTGW::ctrBytes];
+        bool haveCtr = false;
+        bool ok = parseHex(p, id, sizeof(id));
+        p += 2 * sizeof(id);
+        if(ok && ((' ' == *p) || ('\t' == *p)))
+            {
+            while((' ' == *p) || ('\t' == *p)) { ++p; }
+            if(OTGW::hexDigit(*p) >= 0) { ok = parseHex(p, ctr, sizeof(ctr)); haveCtr = true; }
+            }
+        if(!ok) { fprintf(stderr, "%s:%u: bad node\n", path, lineNo); fclose(f); return(-1); }
+        gw.addNode(id, haveCtr ? ctr : NULL);
+        ++added;
+        }
+    fclose(f);
+    return(added);
+    }
+
+// termios speed for baud, or B0 if unsupported.
+static speed_t speedFor(const unsigned long baud)
+    {
+    switch(baud)
+        {
+        case 1200: return(B1200);
+        case 2400: return(B2400);
+        case 4800: return(B4800);
+        case 9600: return(B9600);
+        case 19200: return(B19200);
+        case 38400: return(B38400);
+        case 57600: return(B57600);
+        case 115200: return(B115200);
+        default: return(B0);
+        }
+    }
+
+// Set a serial device raw at baud; does nothing for other inputs.
+static bool setupSerial(const int fd, const unsigned long baud)
+    {
+    if(!isatty(fd)) { return(true); }
+    termios t;
+    if(0 != tcgetattr(fd, &t)) { return(false); }
+    const speed_t s = speedFor(baud);
+    if(B0 == s) { return(false); }
+    cfmakeraw(&t);
+    cfsetispeed(&t, s);
+    cfsetospeed(&t, s);
+    t.c_cflag |= CLOCAL | CREAD;
+    t.c_cc[VMIN] = 1;
+    t.c_cc[VTIME] = 0;
+    return(0 == tcsetattr(fd, TCSANOW, &t));
+    }
+
+// Feed hub output lines to the gateway until EOF.
+static void runText(FILE *const in, OTGW::Gateway &gw)
+    {
+    char line[512];
+    OTGW::RawFrame f;
+    std::string json;
+    while(NULL != fgets(line, sizeof(line), in))
+        {
+        switch(OTGW::parseHubLine(line, f, json))
+            {
+            case OTGW::HubLine::FRAME: gw.submit(f); break;
+            case OTGW::HubLine::JSON: gw.publishJSON(json); break;
+            default: break;
+            }
+        }
+    }
+
+// Feed length-prefixed raw frames to the gateway until EOF.
+static void runBinary(FILE *const in, OTGW::Gateway &gw)
+    {
+    uint8_t buf[OTGW::maxFrameLen];
+    int len;
+    while(EOF != (len = fgetc(in)))
+        {
+        if((0 == len) || (len > OTGW::maxFrameLen)) { continue; } // Resynchronise on the next byte.
+        if(size_t(len) != fread(buf, 1, size_t(len), in)) { break; }
+        gw.submit(buf, uint8_t(len));
+        }
+    }
+
+
+// Feed the hub's framed binary output to the gateway until EOF; returns the records dropped as bad.
+static uint64_t runFramed(FILE *const in, OTGW::Gateway &gw)
+    {
+    OTGW::HubBinaryDecoder d;
+    uint8_t buf[256];
+    size_t n;
+    while(0 != (n = fread(buf, 1, sizeof(buf), in)))
+        { d.feed(buf, n, [&gw](const OTGW::HubBinaryRecord &r) { gw.submit(r); }); }
+    return(d.badRecords());
+    }
+
+}
+
+int main(const int argc, char **const argv)
+    {
+    OTGWM::Config cfg;
+    if(!OTGWM::parseArgs(argc, argv, cfg)) { OTGWM::usage(); return(2); }
+
+    FILE *in = stdin;
+    if((NULL != cfg.input) && (0 != strcmp(cfg.input, "-")))
+        {
+        const int fd = open(cfg.input, O_RDONLY | O_NOCTTY);
+        if((fd < 0) || !OTGWM::setupSerial(fd, cfg.baud) || (NULL == (in = fdopen(fd, (cfg.binary || cfg.framed) ? "rb" : "r"))))
+            { fprintf(stderr, "otgateway: cannot open %s: %s\n", cfg.input, strerror(errno)); return(1); }
+        }
+
+    OTGW::Gateway gw(cfg.key, cfg.threads, cfg.queue);
+    memset(cfg.key, 0, sizeof(cfg.key));
+    const long nodes = OTGWM::loadNodes(cfg.nodes, gw);
+    if(nodes < 0) { fprintf(stderr, "otgateway: cannot load nodes from %s\n", cfg.nodes); return(1); }
+
+    gw.start([](const std::string &msg) { fputs(msg.c_str(), stdout); fputc('\n', stdout); fflush(stdout); });
+    uint64_t badRecords = 0;
+    if(cfg.framed) { badRecords = OTGWM::runFramed(in, gw); }
+    else if(cfg.binary) { OTGWM::runBinary(in, gw); }
+    else { OTGWM::runText(in, gw); }
+    gw.stop();
+
+    const OTGW::GatewayStats s = gw.stats();
+    fprintf(stderr, "nodes %ld shards %u frames %llu decoded %llu rejected %llu ignored %llu published %llu\n",
+        nodes, unsigned(gw.shards()), (unsigned long long)s.frames, (unsigned long long)s.decoded,
+        (unsigned long long)s.rejected, (unsigned long long)s.ignored, (unsigned long long)s.published);
+    if(cfg.framed) { fprintf(stderr, "bad records %llu\n", (unsigned long long)badRecords); }
+    if(stdin != in) { fclose(in); }
+    return(0);
+    }
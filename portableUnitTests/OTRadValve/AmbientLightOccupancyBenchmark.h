@@ -0,0 +1,426 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016--2018
+*/
+
+/*
+ * Streaming harness for measuring throughput and accuracy
+ * of SensorAmbientLightOccupancyDetectorSimple over ambient light traces,
+ * for tuning the OTV0P2BASE_SensorAmbientLightOccupancy_Tuneable.h parameters
+ * against more data than the unit tests carry.
+ *
+ * Traces are either in-memory ALDataSample arrays
+ * or log extracts (eg as in 20161009TestData) of lines of the form:
+ *
+ *     2016-10-08T09:33:12Z 96F0CED3B4E690E8 134
+ *
+ * with a matching xx.O.dat occupancy file for each xx.L.dat light file
+ * as reference, if available.
+ * Files are memory mapped where possible and parsed in place,
+ * so arbitrarily large traces can be streamed.
+ *
+ * Light levels are carried forward to give one update() per minute
+ * as in the unit tests, and the detector output drives
+ * a PseudoSensorOccupancyTracker as it would on a device.
+ * The tracker's view is scored against the reference:
+ *   * false occupancy: tracker likely occupied while reference vacant
+ *   * missed occupancy: tracker not likely occupied while reference occupied
+ *   * onset lag: minutes from the reference going from vacant to occupied
+ *     until the tracker agrees, capped at Runner::MAX_ONSET_LAG_M
+ *
+ * The detector parameters may be varied at run time
+ * (see SensorAmbientLightOccupancyDetectorParameterised)
+ * for parameter searches such as in AmbientLightOccupancySweep.h.
+ *
+ * Host times are wall-clock and noisy (eg unoptimised/debug builds),
+ * so throughput figures are for comparison on one machine only.
+ */
+
+#ifndef PUT_OTRADIOLINK_AMBIENTLIGHTOCCUPANCYBENCHMARK_H
+#define PUT_OTRADIOLINK_AMBIENTLIGHTOCCUPANCYBENCHMARK_H
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ALOBM_HAVE_MMAP
+#endif
+
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_SensorAmbientLightOccupancy.h"
+#include "AmbientLightOccupancyDetectionTest.h"
+
+namespace ALOBM
+{
+
+typedef ::OTV0P2BASE::SensorAmbientLightOccupancyDetectorInterface::occType occType;
+typedef ::OTV0P2BASE::SensorAmbientLightOccupancyParameters Params;
+
+// Accuracy and throughput over one or more traces.
+struct Metrics
+    {
+    // Number of update() calls, ie simulated minutes.
+    unsigned long samples = 0;
+    // Number of update() calls that reported some occupancy.
+    unsigned long detections = 0;
+    // Minutes with reference occupancy known, and the errors in them.
+    unsigned long refMinutes = 0;
+    unsigned long refOccMinutes = 0;
+    unsigned long falseOcc = 0;
+    unsigned long missedOcc = 0;
+    // Reference vacant to occupied transitions, the total lag to detect them,
+    // and how many were not detected within the cap.
+    unsigned long onsets = 0;
+    unsigned long onsetLagM = 0;
+    unsigned long missedOnsets = 0;
+    // Explicit per-sample occupancy expectations (ALDataSample::expectedOcc) and misses.
+    unsigned long expectations = 0;
+    unsigned long expectationErrors = 0;
+    // Wall-clock time spent streaming, including parsing.
+    double seconds = 0;
+
+    Metrics &operator+=(const Metrics &o)
+        {
+        samples += o.samples; detections += o.detections;
+        refMinutes += o.refMinutes; refOccMinutes += o.refOccMinutes;
+        falseOcc += o.falseOcc; missedOcc += o.missedOcc;
+        onsets += o.onsets; onsetLagM += o.onsetLagM; missedOnsets += o.missedOnsets;
+        expectations += o.expectations; expectationErrors += o.expectationErrors;
+        seconds += o.seconds;
+        return(*this);
+        }
+    double samplesPerSecond() const { return((seconds > 0) ? (samples / seconds) : 0); }
+    double falseOccFraction() const { return((0 == refMinutes) ? 0 : (falseOcc / double(refMinutes))); }
+    double missedOccFraction() const { return((0 == refMinutes) ? 0 : (missedOcc / double(refMinutes))); }
+    // F1 score of the tracker against the reference occupancy [0,1]; 0 if no reference.
+    double f1() const
+        {
+        const double tp = double(refOccMinutes - missedOcc);
+        const double d = 2*tp + falseOcc + missedOcc;
+        return((0 == d) ? 0 : ((2*tp) / d));
+        }
+    // Mean onset lag in minutes; 0 if no onsets.
+    double meanOnsetLagM() const { return((0 == onsets) ? 0 : (onsetLagM / double(onsets))); }
+    };
+
+// Read-only view of a whole file, memory mapped if possible.
+class MappedFile final
+    {
+    private:
+        const char *p = NULL;
+        size_t len = 0;
+#ifdef ALOBM_HAVE_MMAP
+        void *mapped = NULL;
+#endif
+        std::vector<char> copy;
+
+    public:
+        MappedFile() { }
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+        ~MappedFile() { close(); }
+
+        // Open the named file; false if it cannot be read.
+        bool open(const char *const path)
+            {
+            close();
+            if(NULL == path) { return(false); }
+#ifdef ALOBM_HAVE_MMAP
+            const int fd = ::open(path, O_RDONLY);
+            if(fd < 0) { return(false); }
+            struct stat st;
+            if((0 == ::fstat(fd, &st)) && (st.st_size > 0))
+                {
+                void *const m = ::mmap(NULL, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if(MAP_FAILED != m)
+                    {
+                    ::close(fd);
+                    mapped = m;
+                    p = static_cast<const char *>(m);
+                    len = size_t(st.st_size);
+                    return(true);
+                    }
+                }
+            ::close(fd);
+#endif
+            // Fall back to reading the file into memory.
+            FILE *const f = std::fopen(path, "rb");
+            if(NULL == f) { return(false); }
+            char buf[4096];
+            size_t n;
+            while((n = std::fread(buf, 1, sizeof(buf), f)) > 0) { copy.insert(copy.end(), buf, buf + n); }
+            std::fclose(f);
+            p = copy.data();
+            len = copy.size();
+            return(true);
+            }
+
+        void close()
+            {
+#ifdef ALOBM_HAVE_MMAP
+            if(NULL != mapped) { ::munmap(mapped, len); mapped = NULL; }
+#endif
+            copy.clear();
+            p = NULL;
+            len = 0;
+            }
+
+        const char *data() const { return(p); }
+        size_t size() const { return(len); }
+    };
+
+// One parsed log line.
+struct Record
+    {
+    // Minutes since 1970-01-01T00:00Z.
+    unsigned long minute;
+    // Value from the third column.
+    unsigned value;
+    };
+
+// Days since 1970-01-01 for the given civil date (proleptic Gregorian).
+inline long daysFromCivil(long y, const unsigned m, const unsigned d)
+    {
+    y -= (m <= 2);
+    const long era = ((y >= 0) ? y : (y - 399)) / 400;
+    const unsigned yoe = unsigned(y - era * 400);
+    const unsigned doy = (153 * (m + ((m > 2) ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe/4 - yoe/100 + doy;
+    return(era * 146097 + long(doe) - 719468);
+    }
+
+// Parse the next valid record from [p,end), advancing p past it.
+// Lines that do not parse (eg blank or comments) are skipped.
+// Returns false when no more records are found.
+inline bool nextRecord(const char *&p, const char *const end, Record &r)
+    {
+    while(p < end)
+        {
+        const char *const line = p;
+        while((p < end) && ('\n' != *p)) { ++p; }
+        const char *const eol = p;
+        if(p < end) { ++p; }
+        // Fixed-format timestamp then two space-separated columns.
+        if((eol - line) < 24) { continue; }
+        const char *q = line;
+        unsigned f[6];
+        static const char seps[] = "--T::Z";
+        bool ok = true;
+        for(int i = 0; ok && (i < 6); ++i)
+            {
+            unsigned v = 0;
+            const char *const start = q;
+            while((q < eol) && (*q >= '0') && (*q <= '9')) { v = v * 10 + unsigned(*q++ - '0'); }
+            ok = (q > start) && (q < eol) && (seps[i] == *q++);
+            f[i] = v;
+            }
+        if(!ok || (f[1] < 1) || (f[1] > 12) || (f[2] < 1) || (f[2] > 31) || (f[3] > 23) || (f[4] > 59)) { continue; }
+        // Skip the ID column.
+        while((q < eol) && (' ' == *q)) { ++q; }
+        while((q < eol) && (' ' != *q)) { ++q; }
+        while((q < eol) && (' ' == *q)) { ++q; }
+        if((q >= eol) || (*q < '0') || (*q > '9')) { continue; }
+        unsigned v = 0;
+        while((q < eol) && (*q >= '0') && (*q <= '9')) { v = v * 10 + unsigned(*q++ - '0'); }
+        const long days = daysFromCivil(long(f[0]), f[1], f[2]);
+        if(days < 0) { continue; }
+        r.minute = ((unsigned long)(days) * 24 + f[3]) * 60 + f[4];
+        r.value = v;
+        return(true);
+        }
+    return(false);
+    }
+
+// Detector plus occupancy tracker, fed one minute at a time.
+class Runner final
+    {
+    public:
+        // Reference O values are taken to hold for this long after they are logged.
+        static constexpr unsigned REF_VALID_M = 30;
+        // Reference unknown; else vacant (0) or occupied (1).
+        static constexpr int8_t REF_UNKNOWN = -1;
+        // Onsets not detected within this many minutes count as missed.
+        static constexpr unsigned MAX_ONSET_LAG_M = 60;
+
+    private:
+        OTV0P2BASE::SensorAmbientLightOccupancyDetectorParameterised detector;
+        OTV0P2BASE::PseudoSensorOccupancyTracker tracker;
+        // Last known reference value.
+        int8_t lastRef = REF_UNKNOWN;
+        // True while waiting for the tracker to notice an onset, and minutes waited.
+        bool onsetPending = false;
+        unsigned onsetWaitM = 0;
+
+    public:
+        Metrics m;
+
+        explicit Runner(const Params &p = Params()) : detector(p) { }
+
+        void reset()
+            {
+            detector.reset(); tracker.reset(); m = Metrics();
+            lastRef = REF_UNKNOWN; onsetPending = false; onsetWaitM = 0;
+            }
+
+        // Run one minute with the given light level; returns the detector output.
+        //   * ref  reference occupancy, or REF_UNKNOWN
+        occType tick(const uint8_t lightLevel, const int8_t ref)
+            {
+            const occType o = detector.update(OTV0P2BASE::fnmin(lightLevel, uint8_t(254)));
+            if(occType::OCC_PROBABLE <= o) { tracker.markAsPossiblyOccupied(); }
+            else if(occType::OCC_WEAK == o) { tracker.markAsJustPossiblyOccupied(); }
+            tracker.read();
+            ++m.samples;
+            if(occType::OCC_NONE != o) { ++m.detections; }
+            const bool likely = tracker.isLikelyOccupied();
+            if(REF_UNKNOWN != ref)
+                {
+                ++m.refMinutes;
+                if(0 != ref) { ++m.refOccMinutes; }
+                if(likely && (0 == ref)) { ++m.falseOcc; }
+                else if(!likely && (0 != ref)) { ++m.missedOcc; }
+                // Start timing a new onset, abandoning any not yet seen.
+                if((0 == lastRef) && (0 != ref))
+                    {
+                    if(onsetPending) { ++m.missedOnsets; m.onsetLagM += MAX_ONSET_LAG_M; }
+                    ++m.onsets; onsetPending = true; onsetWaitM = 0;
+                    }
+                lastRef = ref;
+                }
+            if(onsetPending)
+                {
+                if(likely) { m.onsetLagM += onsetWaitM; onsetPending = false; }
+                else if(++onsetWaitM >= MAX_ONSET_LAG_M) { ++m.missedOnsets; m.onsetLagM += MAX_ONSET_LAG_M; onsetPending = false; }
+                }
+            return(o);
+            }
+    };
+
+// Stream an L trace and optional O reference trace through a fresh runner.
+// Each is the text of a log extract as described above;
+// the O trace may be NULL/empty.
+// O values of 1 are taken as vacant and 2 or more as occupied, 0 unknown.
+inline Metrics runLog(const char *const lText, const size_t lLen,
+                      const char *const oText = NULL, const size_t oLen = 0,
+                      const Params &params = Params())
+    {
+    Runner r(params);
+    r.reset();
+    const auto start = std::chrono::steady_clock::now();
+    const char *lp = lText, *const lEnd = lText + lLen;
+    const char *op = oText, *const oEnd = oText + ((NULL == oText) ? 0 : oLen);
+    Record l;
+    if((NULL != lText) && nextRecord(lp, lEnd, l))
+        {
+        Record nextL;
+        bool haveNextL = nextRecord(lp, lEnd, nextL);
+        Record o = { 0, 0 }, nextO;
+        bool haveO = false;
+        bool haveNextO = (NULL != oText) && nextRecord(op, oEnd, nextO);
+        for(unsigned long minute = l.minute; ; ++minute)
+            {
+            // Advance to the latest records at or before this minute.
+            while(haveNextL && (nextL.minute <= minute)) { l = nextL; haveNextL = nextRecord(lp, lEnd, nextL); }
+            while(haveNextO && (nextO.minute <= minute)) { o = nextO; haveO = true; haveNextO = nextRecord(op, oEnd, nextO); }
+            const bool refValid = haveO && (0 != o.value) && ((minute - o.minute) < Runner::REF_VALID_M);
+            const int8_t ref = !refValid ? Runner::REF_UNKNOWN : ((o.value >= 2) ? 1 : 0);
+            r.tick(uint8_t(OTV0P2BASE::fnmin(l.value, 255U)), ref);
+            if(!haveNextL && (minute >= l.minute)) { break; }
+            }
+        }
+    const auto end = std::chrono::steady_clock::now();
+    r.m.seconds = std::chrono::duration<double>(end - start).count();
+    return(r.m);
+    }
+
+// Stream a terminated in-time-order ALDataSample array through a fresh runner,
+// also scoring any expectedOcc and actOcc annotations.
+inline Metrics runSamples(const OTV0P2BASE::PortableUnitTest::ALDataSample *const data,
+                          const Params &params = Params())
+    {
+    typedef OTV0P2BASE::PortableUnitTest::ALDataSample ALDataSample;
+    Runner r(params);
+    r.reset();
+    const auto start = std::chrono::steady_clock::now();
+    if((NULL != data) && !data->isEnd())
+        {
+        for(const ALDataSample *dp = data; !dp->isEnd(); ++dp)
+            {
+            const ALDataSample *const next = dp + 1;
+            const unsigned long until = next->isEnd() ? (dp->currentMinute() + 1) : next->currentMinute();
+            for(unsigned long minute = dp->currentMinute(); minute < until; ++minute)
+                {
+                // Annotations apply to the real record only.
+                const bool real = (minute == dp->currentMinute());
+                const int8_t ref = (real && (ALDataSample::UNKNOWN_ACT_OCC != dp->actOcc)) ?
+                    int8_t(0 != dp->actOcc) : Runner::REF_UNKNOWN;
+                const occType o = r.tick(dp->L, ref);
+                if(real && (ALDataSample::NO_OCC_EXPECTATION != dp->expectedOcc))
+                    {
+                    ++r.m.expectations;
+                    if(dp->expectedOcc != int8_t(o)) { ++r.m.expectationErrors; }
+                    }
+                }
+            }
+        }
+    const auto end = std::chrono::steady_clock::now();
+    r.m.seconds = std::chrono::duration<double>(end - start).count();
+    return(r.m);
+    }
+
+// Stream an xx.L.dat file, with xx.O.dat alongside as reference if present.
+// Returns false if the L file cannot be read.
+inline bool runLogFile(const char *const lPath, Metrics &out, const Params &params = Params())
+    {
+    MappedFile lf, of;
+    if(!lf.open(lPath)) { return(false); }
+    std::string oPath(lPath);
+    const size_t dot = oPath.rfind(".L.dat");
+    if(std::string::npos != dot) { oPath.replace(dot, 6, ".O.dat"); of.open(oPath.c_str()); }
+    out = runLog(lf.data(), lf.size(), of.data(), of.size(), params);
+    return(true);
+    }
+
+// Print one result in a fixed format, for comparing tuning parameter sets.
+inline void print(const char *const name, const Metrics &m)
+    {
+    std::printf("ALOccBenchmark %-16s samples %8lu det %6lu ref %8lu falseOcc %6lu (%.3f) missedOcc %6lu (%.3f) f1 %.3f lag %.1f (%lu/%lu missed) exp %4lu/%-4lu samples/s %.0f\n",
+        name, m.samples, m.detections,
+        m.refMinutes, m.falseOcc, m.falseOccFraction(), m.missedOcc, m.missedOccFraction(),
+        m.f1(), m.meanOnsetLagM(), m.missedOnsets, m.onsets,
+        m.expectations - m.expectationErrors, m.expectations,
+        m.samplesPerSecond());
+    }
+
+// Print the tuneable parameters in use, so that results can be attributed.
+inline void printParameters()
+    {
+    std::printf("ALOccBenchmark params epsilon %u steadyTicksMinWithLightOn %u steadyTicksMinForArtificialLight %u steadyTicksMinBeforeLightOn %u\n",
+        unsigned(SENSORAMBIENTLIGHTOCCUPANCY_EPSILON),
+        unsigned(SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinWithLightOn),
+        unsigned(SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinForArtificialLight),
+        unsigned(SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinBeforeLightOn));
+    }
+
+}
+
+#endif // PUT_OTRADIOLINK_AMBIENTLIGHTOCCUPANCYBENCHMARK_H
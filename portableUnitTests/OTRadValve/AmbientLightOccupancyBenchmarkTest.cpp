@@ -0,0 +1,166 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016--2018
+*/
+
+/*
+ * Throughput and accuracy benchmark of the ambient light occupancy detector
+ * over the bundled traces and optionally any number of external ones.
+ *
+ * The bundled 20161009TestData directory is found via
+ * the OTRL_ALOCC_DATA_DIR environment variable if set,
+ * else relative to the current directory.
+ * Further xx.L.dat traces (with xx.O.dat alongside for reference)
+ * may be listed, colon-separated, in OTRL_ALOCC_TRACES.
+ *
+ * To compare tuning parameter sets, rebuild with the
+ * SENSORAMBIENTLIGHTOCCUPANCY_* macros overridden and diff the output.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "AmbientLightOccupancyDetectionTestData.h"
+#include "AmbientLightOccupancyBenchmark.h"
+
+namespace ALOBT
+{
+// Bundled log traces, by xx prefix.
+static const char *const logTraces[] = { "2b", "3l", "5s", "6k" };
+
+// Bundled ALDataSample traces, loaded when first used.
+struct NamedSample { const char *name; const char *dataSet; };
+static const NamedSample sampleTraces[] =
+    {
+    { "1gBriefLightOn", "sample1gBriefLightOn" },
+    { "3lSetback", "sample3lSetback" },
+    { "a0", "samplea0" },
+    { "a0b", "samplea0b" },
+    { "a1", "samplea1" },
+    { "a1b", "samplea1b" },
+    { "a2", "samplea2" },
+    { "a2b", "samplea2b" },
+    { "a3", "samplea3" },
+    { "a3b", "samplea3b" },
+    };
+
+// Find the bundled data directory, or empty if not found.
+static std::string findDataDir()
+    {
+    const char *const env = getenv("OTRL_ALOCC_DATA_DIR");
+    if(NULL != env) { return(env); }
+    static const char *const candidates[] = { "portableUnitTests/20161009TestData", "../portableUnitTests/20161009TestData" };
+    for(const char *const c : candidates)
+        {
+        ALOBM::MappedFile f;
+        if(f.open((std::string(c) + "/README.txt").c_str())) { return(c); }
+        }
+    return("");
+    }
+}
+
+// Check log parsing and per-minute streaming on a small in-memory trace.
+TEST(ALOccBenchmark, ParseAndStream)
+{
+    ALOBM::Record r;
+    const char line[] = "2016-10-08T09:33:12Z 96F0CED3B4E690E8 134\n";
+    const char *p = line;
+    ASSERT_TRUE(ALOBM::nextRecord(p, line + strlen(line), r));
+    EXPECT_EQ(((ALOBM::daysFromCivil(2016, 10, 8) * 24UL) + 9) * 60 + 33, r.minute);
+    EXPECT_EQ(134U, r.value);
+    EXPECT_FALSE(ALOBM::nextRecord(p, line + strlen(line), r));
+    EXPECT_EQ(0, ALOBM::daysFromCivil(1970, 1, 1));
+    EXPECT_EQ(2, ALOBM::daysFromCivil(2016, 3, 1) - ALOBM::daysFromCivil(2016, 2, 28)); // Leap year.
+
+    // Dark then lights on, with junk lines skipped and gaps carried forward.
+    const char l[] =
+        "# comment\n"
+        "2016-10-08T18:00:00Z X 2\n"
+        "bad line that is long enough to parse\n"
+        "2016-10-08T18:10:00Z X 2\n"
+        "2016-10-08T18:20:00Z X 150\n"
+        "2016-10-08T18:30:00Z X 150";
+    const char o[] =
+        "2016-10-08T18:00:00Z X 1\n"
+        "2016-10-08T18:20:00Z X 3\n";
+    const ALOBM::Metrics m = ALOBM::runLog(l, strlen(l), o, strlen(o));
+    EXPECT_EQ(31U, m.samples);
+    EXPECT_LE(1U, m.detections);
+    EXPECT_EQ(31U, m.refMinutes);
+    EXPECT_EQ(0U, m.falseOcc);
+    // Occupancy should be picked up within a few minutes of lights on.
+    EXPECT_GE(5U, m.missedOcc);
+    // Without a reference nothing is scored.
+    const ALOBM::Metrics mNoRef = ALOBM::runLog(l, strlen(l));
+    EXPECT_EQ(m.samples, mNoRef.samples);
+    EXPECT_EQ(0U, mNoRef.refMinutes);
+    EXPECT_EQ(0U, ALOBM::runLog(NULL, 0).samples);
+}
+
+// Stream all bundled and any external traces, reporting throughput and accuracy.
+TEST(ALOccBenchmark, Corpus)
+{
+    ALOBM::printParameters();
+    ALOBM::Metrics total;
+
+    for(const ALOBT::NamedSample &s : ALOBT::sampleTraces)
+        {
+        const ALOBM::Metrics m = ALOBM::runSamples(OTV0P2BASE::PortableUnitTest::DATA::getSamples(s.dataSet));
+        EXPECT_LT(0U, m.samples) << s.name;
+        EXPECT_GE(m.refMinutes, m.falseOcc + m.missedOcc) << s.name;
+        ALOBM::print(s.name, m);
+        total += m;
+        }
+
+    const std::string dir = ALOBT::findDataDir();
+    if(dir.empty()) { std::printf("ALOccBenchmark bundled log traces not found; set OTRL_ALOCC_DATA_DIR\n"); }
+    else
+        {
+        for(const char *const t : ALOBT::logTraces)
+            {
+            ALOBM::Metrics m;
+            const std::string path = dir + "/" + t + ".L.dat";
+            ASSERT_TRUE(ALOBM::runLogFile(path.c_str(), m)) << path;
+            EXPECT_LT(0U, m.samples) << t;
+            // Every bundled trace has a reference occupancy file.
+            EXPECT_LT(0U, m.refMinutes) << t;
+            ALOBM::print(t, m);
+            total += m;
+            }
+        }
+
+    const char *const extra = getenv("OTRL_ALOCC_TRACES");
+    if(NULL != extra)
+        {
+        std::string list(extra);
+        for(size_t start = 0; start <= list.size(); )
+            {
+            size_t colon = list.find(':', start);
+            if(std::string::npos == colon) { colon = list.size(); }
+            const std::string path = list.substr(start, colon - start);
+            start = colon + 1;
+            if(path.empty()) { continue; }
+            ALOBM::Metrics m;
+            if(!ALOBM::runLogFile(path.c_str(), m)) { ADD_FAILURE() << "cannot read " << path; continue; }
+            ALOBM::print(path.c_str(), m);
+            total += m;
+            }
+        }
+
+    ALOBM::print("TOTAL", total);
+}
@@ -0,0 +1,159 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016--2019
+*/
+
+/*
+ * Lazy loading of the ambient light occupancy sample data sets.
+ *
+ * The larger ALDataSample sets live as text files
+ * in portableUnitTests/AmbientLightOccupancyData
+ * rather than as arrays compiled into every test build,
+ * and are parsed on first use.
+ *
+ * Each line of a file is one sample of the form:
+ *
+ *     d H M L [expectedOcc [expectedRd [actOcc [expectedSb]]]]
+ *
+ * with '#' starting a comment, and '-' or an omitted trailing field
+ * meaning no expectation (as for the ALDataSample constructor defaults).
+ * expectedOcc is one of OCC_NONE, OCC_WEAK, OCC_PROBABLE or OCC_STRONG,
+ * expectedRd and actOcc are 0 or 1,
+ * and expectedSb is an ALDataSample::expectedSb_t name such as SB_MINMAX.
+ *
+ * The directory is taken from the OTRL_ALOCC_SAMPLES_DIR environment variable if set,
+ * else is the absolute path that the build passes in the OTRL_ALOCC_SAMPLES_DIR macro,
+ * so that the tests can be run from any working directory.
+ */
+
+#ifndef PUT_OTRADIOLINK_AMBIENTLIGHTOCCUPANCYDETECTIONTESTDATA_H
+#define PUT_OTRADIOLINK_AMBIENTLIGHTOCCUPANCYDETECTIONTESTDATA_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "AmbientLightOccupancyDetectionTest.h"
+
+
+namespace OTV0P2BASE {
+namespace PortableUnitTest {
+namespace DATA {
+
+#ifndef OTRL_ALOCC_SAMPLES_DIR
+#error OTRL_ALOCC_SAMPLES_DIR must be defined as the absolute path of portableUnitTests/AmbientLightOccupancyData
+#endif
+
+// Directory holding the sample data set files, with trailing '/'.
+inline std::string samplesDir()
+    {
+    const char *const env = getenv("OTRL_ALOCC_SAMPLES_DIR");
+    if((NULL != env) && ('\0' != *env)) { return(std::string(env) + "/"); }
+    return(std::string(OTRL_ALOCC_SAMPLES_DIR) + "/");
+    }
+
+// Parse one field; returns false if unrecognised.
+inline bool parseSampleField(const char *const t, const uint8_t field, int &out)
+    {
+    static const char *const occNames[] = { "OCC_NONE", "OCC_WEAK", "OCC_PROBABLE", "OCC_STRONG" };
+    static const char *const sbNames[] =
+        { "SB_NONE", "SB_NONEMIN", "SB_MIN", "SB_NONEECO", "SB_MINECO", "SB_ECO", "SB_MINMAX", "SB_ECOMAX", "SB_MAX" };
+    if((field >= 4) && (0 == strcmp(t, "-"))) { out = -1; return(true); }
+    if(4 == field)
+        {
+        for(int i = 0; i < int(sizeof(occNames)/sizeof(occNames[0])); ++i)
+            { if(0 == strcmp(t, occNames[i])) { out = i; return(true); } }
+        }
+    if(7 == field)
+        {
+        for(int i = 0; i < int(sizeof(sbNames)/sizeof(sbNames[0])); ++i)
+            { if(0 == strcmp(t, sbNames[i])) { out = i; return(true); } }
+        return(false);
+        }
+    char *end;
+    const long v = strtol(t, &end, 10);
+    if(('\0' != *end) || (v < 0) || (v > 255)) { return(false); }
+    if(((5 == field) || (6 == field)) && (v > 1)) { return(false); }
+    out = int(v);
+    return(true);
+    }
+
+// Load samples from path into out, followed by a terminating record.
+// Returns false with a message in err on any error.
+inline bool loadSampleFile(const std::string &path, std::vector<ALDataSample> &out, std::string &err)
+    {
+    FILE *const f = fopen(path.c_str(), "r");
+    if(NULL == f) { err = "cannot open " + path; return(false); }
+    char line[512];
+    unsigned lineNo = 0;
+    bool ok = true;
+    while(ok && (NULL != fgets(line, sizeof(line), f)))
+        {
+        ++lineNo;
+        char *const hash = strchr(line, '#');
+        if(NULL != hash) { *hash = '\0'; }
+        int v[8] = { 0, 0, 0, 0, -1, -1, -1, -1 };
+        uint8_t n = 0;
+        for(char *t = strtok(line, " \t\r\n"); NULL != t; t = strtok(NULL, " \t\r\n"))
+            {
+            if((n >= 8) || !parseSampleField(t, n, v[n])) { ok = false; break; }
+            ++n;
+            }
+        if(ok && (0 == n)) { continue; }
+        if(!ok || (n < 4))
+            {
+            ok = false;
+            err = path + ":" + std::to_string(lineNo) + ": bad sample";
+            break;
+            }
+        out.emplace_back(uint8_t(v[0]), uint8_t(v[1]), uint8_t(v[2]), uint8_t(v[3]),
+            int8_t(v[4]), int8_t(v[5]), int8_t(v[6]), ALDataSample::expectedSb_t(v[7]));
+        }
+    fclose(f);
+    out.emplace_back();
+    return(ok);
+    }
+
+// Get the named data set (eg "sample3lSetback"), loading it on first use.
+// The returned array is terminated as for in-source sample arrays
+// and remains valid for the life of the process.
+// On failure adds a (non-fatal) test failure and returns an empty data set.
+inline const ALDataSample *getSamples(const char *const name)
+    {
+    static std::map<std::string, std::vector<ALDataSample>> cache;
+    auto it = cache.find(name);
+    if(cache.end() == it)
+        {
+        std::vector<ALDataSample> samples;
+        std::string err;
+        if(!loadSampleFile(samplesDir() + name + ".txt", samples, err))
+            {
+            ADD_FAILURE() << err << " (check OTRL_ALOCC_SAMPLES_DIR)";
+            samples.clear();
+            samples.emplace_back();
+            }
+        it = cache.emplace(name, std::move(samples)).first;
+        }
+    return(it->second.data());
+    }
+
+} } }
+
+#endif
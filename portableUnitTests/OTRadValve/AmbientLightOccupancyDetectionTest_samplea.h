@@ -1,7252 +0,0 @@
-/*
-The OpenTRV project licenses this file to you
-under the Apache Licence, Version 2.0 (the "Licence");
-you may not use this file except in compliance
-with the Licence. You may obtain a copy of the Licence at
-
-http://www.apache.org/licenses/LICENSE-2.0
-
-Unless required by applicable law or agreed to in writing,
-software distributed under the Licence is distributed on an
-"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
-KIND, either express or implied. See the Licence for the
-specific language governing permissions and limitations
-under the Licence.
-
-Author(s) / Copyright (s): Damon Hart-Davis 2016--2018
-*/
-
-/*
- * Sample data set.  ONLY INCLUDE WHERE SPECIFICALLY NEEDED!
- */
-
-
-#ifndef PUT_OTRADIOLINK_AMBIENTLIGHTOCCUPANCYDETECTIONTEST_samplea_H
-#define PUT_OTRADIOLINK_AMBIENTLIGHTOCCUPANCYDETECTIONTEST_samplea_H
-
-#include "AmbientLightOccupancyDetectionTest.h"
-
-
-namespace OTV0P2BASE {
-namespace PortableUnitTest {
-namespace DATA {
-
-// Several autumn/winter ~2016 UK (north London) data sets.
-
-static const ALDataSample samplea0[] =
-    {
-{14,11,6,182},
-{14,11,22,181},
-{14,11,38,183},
-{14,11,42,183},
-{14,11,50,183},
-{14,11,57,183},
-{14,12,10,182, ALDataSample::NO_OCC_EXPECTATION, false, ALDataSample::UNKNOWN_ACT_OCC},
-{14,12,21,183},
-{14,12,26,183},
-{14,12,38,182},
-{14,12,54,183},
-{14,13,10,183},
-{14,13,21,182},
-{14,13,34,182},
-{14,13,42,183},
-{14,13,47,183},
-{14,13,58,182},
-{14,14,10,180},
-{14,14,18,180},
-{14,14,23,182},
-{14,14,26,182},
-{14,14,42,182},
-{14,14,54,182},
-{14,15,6,182},
-{14,15,26,180},
-{14,15,30,179},
-{14,15,42,180},
-{14,15,54,179},
-{14,16,10,150},
-{14,16,22,116},
-{14,16,29,104},
-{14,16,45,179},
-{14,16,54,183},
-{14,16,58,181},
-{14,17,2,183},
-{14,17,6,182},
-{14,17,14,182},
-{14,17,26,6},
-{14,17,38,4},
-{14,17,42,32},
-{14,17,58,31},
-{14,18,2,30},
-{14,18,14,15},
-{14,18,30,31},
-{14,18,42,33},
-{14,18,58,19},
-{14,19,14,18},
-{14,19,30,18},
-{14,19,33,17},
-{14,19,41,13},
-{14,19,53,19},
-{14,19,58,11},
-{14,20,22,18},
-{14,20,38,19},
-{14,20,50,18},
-{14,21,6,20},
-{14,21,22,21},
-{14,21,34,19},
-{14,21,46,19},
-{14,21,58,19},
-{14,22,14,19},
-{14,22,21,19},
-{14,22,34,19},
-{14,22,38,19},
-{14,22,49,19},
-{14,23,6,18},
-{14,23,10,4},
-{14,23,17,4},
-{14,23,26,4},
-{14,23,34,4},
-{14,23,46,4},
-{15,0,2,4},
-{15,0,18,4},
-{15,0,26,4},
-{15,0,42,4},
-{15,1,2,4},
-{15,1,10,4},
-{15,1,17,4},
-{15,1,26,4},
-{15,1,33,4},
-{15,1,42,4},
-{15,1,58,4},
-{15,2,9,4},
-{15,2,18,4},
-{15,2,30,4},
-{15,2,42,4},
-{15,2,50,4},
-{15,3,13,4},
-{15,3,22,4},
-{15,3,37,4, ALDataSample::NO_OCC_EXPECTATION, true, false, ALDataSample::SB_MAX},
-{15,3,59,26},
-{15,4,9,14},
-{15,4,26,4},
-{15,4,34,4},
-{15,4,45,4},
-{15,4,58,4},
-{15,5,7,4},
-{15,5,21,4},
-{15,5,30,4},
-{15,5,42,4},
-{15,5,58,4},
-{15,6,5,4},
-{15,6,14,5, ALDataSample::NO_OCC_EXPECTATION, true, false, ALDataSample::SB_MINMAX},
-{15,6,21,8},
-{15,6,25,11},
-{15,6,30,16},
-{15,6,38,26},
-{15,6,42,36},
-{15,6,45,39},
-{15,6,50,38},
-{15,7,2,42},
-{15,7,22,136},
-{15,7,26,148},
-{15,7,33,174},
-{15,7,38,176},
-{15,7,42,176},
-{15,7,57,178},
-{15,7,59,178},
-{15,8,10,178},
-{15,8,21,177},
-{15,8,29,176},
-{15,8,41,174},
-{15,8,58,178},
-{15,9,10,181},
-{15,9,13,181},
-{15,9,26,181},
-{15,9,41,182},
-{15,9,50,181},
-{15,9,54,180},
-{15,10,9,176},
-{15,10,21,179},
-{15,10,26,182},
-{15,10,38,182},
-{15,10,50,181},
-{15,11,1,183},
-{15,11,6,184},
-{15,11,8,183},
-{15,11,17,184},
-{15,11,25,182},
-{15,11,30,183},
-{15,11,42,184},
-{15,11,49,182},
-{15,11,50,183},
-{15,12,1,182, ALDataSample::NO_OCC_EXPECTATION, false, ALDataSample::UNKNOWN_ACT_OCC},
-{15,12,10,182},
-{15,12,17,183},
-{15,12,21,184},
-{15,12,34,183},
-{15,12,37,183},
-{15,12,48,181},
-{15,12,57,183},
-{15,13,1,181},
-{15,13,7,181},
-{15,13,17,179},
-{15,13,21,181},
-{15,13,37,184},
-{15,13,41,183},
-{15,13,46,181},
-{15,13,57,183},
-{15,14,9,182},
-{15,14,13,182},
-{15,14,29,181},
-{15,14,37,181},
-{15,14,45,184},
-{15,14,50,181},
-{15,15,6,179},
-{15,15,9,182},
-{15,15,18,181},
-{15,15,26,180},
-{15,15,29,179},
-{15,15,45,125},
-{15,15,57,182},
-{15,16,13,180},
-{15,16,21,183},
-{15,16,33,182},
-{15,16,45,182},
-{15,16,57,181},
-{15,17,9,183},
-{15,17,13,182},
-{15,17,25,182},
-{15,17,33,41},
-{15,17,41,41},
-{15,17,45,40},
-{15,17,53,75},
-{15,18,13,34},
-{15,18,25,33},
-{15,18,33,29},
-{15,18,53,32},
-{15,19,9,32},
-{15,19,29,31},
-{15,19,33,32},
-{15,19,41,31},
-{15,19,58,32},
-{15,20,9,33},
-{15,20,17,34},
-{15,20,25,34},
-{15,20,37,33},
-{15,20,50,32},
-{15,20,57,32},
-{15,21,10,32},
-{15,21,21,31},
-{15,21,29,36},
-{15,21,33,28},
-{15,21,53,32},
-{15,22,5,31},
-{15,22,21,13},
-{15,22,38,13},
-{15,22,53,12},
-{15,23,2,13},
-{15,23,22,4},
-{15,23,30,4},
-{15,23,57,4},
-{16,0,10,4},
-{16,0,25,4},
-{16,0,37,4},
-{16,0,49,4},
-{16,1,1,4},
-{16,1,13,4},
-{16,1,38,4},
-{16,2,1,4},
-{16,2,17,4},
-{16,2,29,4},
-{16,2,45,4},
-{16,3,1,4},
-{16,3,13,4},
-{16,3,19,4},
-{16,3,33,4},
-{16,3,49,4},
-{16,4,25,4},
-{16,4,57,4},
-{16,5,13,4},
-{16,5,25,4},
-{16,5,37,4},
-{16,5,45,4},
-{16,5,57,4},
-{16,6,9,4},
-{16,6,25,181},
-{16,6,38,23},
-{16,6,49,19},
-{16,6,54,15},
-{16,6,57,18},
-{16,7,9,26},
-{16,7,21,33},
-{16,7,26,29},
-{16,7,29,38},
-{16,7,33,43},
-{16,7,42,75},
-{16,7,49,81},
-{16,7,53,87},
-{16,7,57,112},
-{16,8,5,105},
-{16,8,9,67},
-{16,8,21,95},
-{16,8,46,91},
-{16,8,49,74},
-{16,9,1,67},
-{16,9,13,179},
-{16,9,33,180},
-{16,9,37,181},
-{16,9,45,175},
-{16,9,49,179},
-{16,10,5,181},
-{16,10,19,182},
-{16,10,21,181},
-{16,10,33,183},
-{16,10,45,183},
-{16,10,49,183},
-{16,10,57,182},
-{16,11,9,181},
-{16,11,25,179},
-{16,11,29,182},
-{16,11,37,183},
-{16,11,45,182},
-{16,11,49,183},
-{16,12,1,183, ALDataSample::NO_OCC_EXPECTATION, false, ALDataSample::UNKNOWN_ACT_OCC},
-{16,12,13,183},
-{16,12,33,183},
-{16,12,41,183},
-{16,12,53,182},
-{16,12,57,184},
-{16,13,13,182},
-{16,13,21,182},
-{16,13,33,183},
-{16,13,41,184},
-{16,13,53,180},
-{16,13,57,179},
-{16,14,5,180},
-{16,14,17,179},
-{16,14,21,179},
-{16,14,33,178},
-{16,14,37,181},
-{16,14,53,183},
-{16,14,57,180},
-{16,15,1,178},
-{16,15,17,183},
-{16,15,21,182},
-{16,15,29,178},
-{16,15,37,168},
-{16,15,45,177},
-{16,15,57,175},
-{16,16,9,140},
-{16,16,13,170},
-{16,16,17,151},
-{16,16,25,116},
-{16,16,33,132},
-{16,16,37,133},
-{16,16,41,96},
-{16,16,49,64},
-{16,17,1,38},
-{16,17,5,31},
-{16,17,17,28},
-{16,17,21,24},
-{16,17,29,29},
-{16,17,41,35},
-{16,17,45,37},
-{16,17,53,35},
-{16,18,5,55},
-{16,18,7,37},
-{16,18,17,37},
-{16,18,21,36},
-{16,18,29,36},
-{16,18,41,32},
-{16,19,1,27},
-{16,19,17,53},
-{16,19,25,27},
-{16,19,41,27},
-{16,19,53,28},
-{16,20,4,27},
-{16,20,5,28},
-{16,20,13,27},
-{16,20,25,26},
-{16,20,29,27},
-{16,20,37,27},
-{16,20,49,23},
-{16,21,1,4},
-{16,21,17,4},
-{16,21,29,4},
-{16,21,41,4},
-{16,21,53,4},
-{16,22,5,4},
-{16,22,13,4},
-{16,22,25,4},
-{16,22,37,4},
-{16,22,49,4},
-{16,22,53,4},
-{16,23,5,4},
-{16,23,15,4},
-{16,23,33,4},
-{16,23,49,4},
-{16,23,57,4},
-{17,0,9,4},
-{17,0,25,4},
-{17,0,37,4},
-{17,1,41,4},
-{17,1,53,4},
-{17,2,5,4},
-{17,2,17,4},
-{17,2,29,4},
-{17,2,53,4},
-{17,3,5,4},
-{17,3,45,4},
-{17,3,57,4},
-{17,4,9,4},
-{17,4,29,4},
-{17,5,1,4},
-{17,5,9,4},
-{17,5,21,4},
-{17,5,33,4},
-{17,5,49,4},
-{17,6,1,183},
-{17,6,5,183},
-{17,6,13,183},
-{17,6,21,176},
-{17,6,25,181},
-{17,6,41,181},
-{17,6,55,182},
-{17,6,57,181},
-{17,7,9,120},
-{17,7,21,166},
-{17,7,41,172},
-{17,7,53,177},
-{17,7,57,178},
-{17,8,5,178},
-{17,8,21,177},
-{17,8,33,179},
-{17,8,37,180},
-{17,8,53,179},
-{17,8,57,179},
-{17,9,1,178},
-{17,9,13,179},
-{17,9,17,176},
-{17,9,29,177},
-{17,9,45,178},
-{17,9,49,177},
-{17,10,1,179},
-{17,10,9,180},
-{17,10,13,181},
-{17,10,25,180},
-{17,10,33,180},
-{17,10,49,180},
-{17,11,0,183},
-{17,11,1,181},
-{17,11,5,182},
-{17,11,21,182},
-{17,11,29,181},
-{17,11,33,179},
-{17,11,45,181},
-{17,11,53,183},
-{17,11,57,181},
-{17,12,5,182},
-{17,12,9,182},
-{17,12,21,184},
-{17,12,22,184},
-{17,12,37,182},
-{17,12,41,183},
-{17,12,57,183},
-{17,13,1,184},
-{17,13,17,183},
-{17,13,21,181},
-{17,13,33,183},
-{17,13,37,184},
-{17,13,49,182},
-{17,14,1,183},
-{17,14,5,182},
-{17,14,25,183},
-{17,14,41,181},
-{17,14,45,183},
-{17,14,49,182},
-{17,14,57,182},
-{17,15,3,182},
-{17,15,13,180},
-{17,15,17,181},
-{17,15,25,182},
-{17,15,37,178},
-{17,15,41,180},
-{17,15,49,175},
-{17,15,57,123},
-{17,16,5,92},
-{17,16,9,59},
-{17,16,13,77},
-{17,16,29,108},
-{17,16,33,69},
-{17,16,49,60},
-{17,16,53,53},
-{17,17,1,47},
-{17,17,13,183},
-{17,17,21,183},
-{17,17,49,182},
-{17,17,57,181},
-{17,18,1,183},
-{17,18,9,183},
-{17,18,17,181},
-{17,18,21,183},
-{17,18,41,179},
-{17,18,53,178},
-{17,19,9,179},
-{17,19,21,180},
-{17,19,29,177},
-{17,19,33,176},
-{17,19,41,179},
-{17,19,53,181},
-{17,19,57,182},
-{17,20,5,182},
-{17,20,13,15},
-{17,20,25,15},
-{17,20,41,15},
-{17,21,1,13},
-{17,21,13,4},
-{17,21,25,4},
-{17,21,37,4},
-{17,21,53,4},
-{17,22,9,4},
-{17,22,25,4},
-{17,22,41,4},
-{17,22,57,4},
-{17,23,13,4},
-{17,23,29,4},
-{17,23,49,4},
-{18,0,1,4},
-{18,0,9,4},
-{18,0,17,4},
-{18,0,29,4},
-{18,0,45,4},
-{18,0,57,4},
-{18,1,5,4},
-{18,1,17,4},
-{18,1,27,4},
-{18,1,41,4},
-{18,1,57,4},
-{18,2,21,4},
-{18,2,42,4},
-{18,2,53,4},
-{18,3,9,4},
-{18,3,37,4},
-{18,3,49,4},
-{18,4,1,4},
-{18,4,21,4},
-{18,4,29,4},
-{18,4,49,4},
-{18,5,5,183},
-{18,5,21,183},
-{18,5,33,183},
-{18,5,45,181},
-{18,5,57,182},
-{18,6,9,181},
-{18,6,25,178},
-{18,6,41,182},
-{18,6,45,180},
-{18,6,57,181},
-{18,7,5,181},
-{18,7,9,180},
-{18,7,25,99},
-{18,7,37,104},
-{18,8,1,153},
-{18,8,5,124},
-{18,8,17,149},
-{18,8,21,110},
-{18,8,29,118},
-{18,8,37,175},
-{18,8,45,180},
-{18,8,53,179},
-{18,8,57,179},
-{18,9,1,181},
-{18,9,9,181},
-{18,9,21,181},
-{18,9,33,180},
-{18,9,49,180},
-{18,10,1,179},
-{18,10,13,181},
-{18,10,17,182},
-{18,10,33,180},
-{18,10,45,181},
-{18,10,53,178},
-{18,11,5,182},
-{18,11,9,180},
-{18,11,21,182},
-{18,11,33,179},
-{18,11,45,179},
-{18,12,1,181},
-{18,12,13,181},
-{18,12,21,182},
-{18,12,33,182},
-{18,12,49,181},
-{18,12,57,183},
-{18,13,1,181},
-{18,13,13,181},
-{18,13,25,181},
-{18,13,29,182},
-{18,13,33,183},
-{18,13,37,182},
-{18,13,49,181},
-{18,14,1,179},
-{18,14,5,180},
-{18,14,9,180},
-{18,14,17,179},
-{18,14,25,180},
-{18,14,29,182},
-{18,14,41,180},
-{18,14,49,177},
-{18,14,53,175},
-{18,15,5,174},
-{18,15,37,175},
-{18,15,53,179},
-{18,16,13,114},
-{18,16,17,111},
-{18,16,25,80},
-{18,16,33,66},
-{18,16,37,55},
-{18,16,57,25},
-{18,17,5,24},
-{18,17,13,10},
-{18,17,25,5},
-{18,17,37,183},
-{18,17,49,183},
-{18,18,5,180},
-{18,18,9,182},
-{18,18,25,181},
-{18,18,37,181},
-{18,18,47,182},
-{18,18,49,179},
-{18,19,5,179},
-{18,19,9,182},
-{18,19,21,180},
-{18,19,33,22},
-{18,19,37,22},
-{18,19,49,20},
-{18,19,53,21},
-{18,20,13,20},
-{18,20,29,21},
-{18,20,45,21},
-{18,20,53,21},
-{18,21,5,20},
-{18,21,17,22},
-{18,21,29,4},
-{18,21,45,4},
-{18,21,57,4},
-{18,22,5,4},
-{18,22,17,4},
-{18,22,25,4},
-{18,22,37,4},
-{18,22,53,4},
-{18,23,13,4},
-{18,23,45,4},
-{18,23,57,4},
-{19,0,10,4},
-{19,0,19,4},
-{19,0,33,179},
-{19,0,45,4},
-{19,0,53,4},
-{19,1,5,4},
-{19,1,13,4},
-{19,1,29,4},
-{19,1,53,4},
-{19,1,59,4},
-{19,2,17,4},
-{19,2,37,4},
-{19,2,49,4},
-{19,3,29,4},
-{19,3,45,4},
-{19,4,1,4},
-{19,4,9,4},
-{19,4,25,4},
-{19,4,33,4},
-{19,4,45,4},
-{19,5,13,177},
-{19,5,17,183},
-{19,5,25,183},
-{19,5,29,180},
-{19,5,45,21},
-{19,5,57,20},
-{19,6,5,20},
-{19,6,17,20},
-{19,6,21,22},
-{19,6,29,36},
-{19,6,41,47},
-{19,6,53,71},
-{19,6,57,65},
-{19,7,13,109},
-{19,7,17,113},
-{19,7,25,140},
-{19,7,37,164},
-{19,7,41,164},
-{19,8,1,174},
-{19,8,9,173},
-{19,8,21,176},
-{19,8,33,179},
-{19,8,45,180},
-{19,8,49,181},
-{19,9,1,177},
-{19,9,21,182},
-{19,9,33,182},
-{19,9,41,182},
-{19,9,53,182},
-{19,10,1,183},
-{19,10,5,183},
-{19,10,17,183},
-{19,10,25,183},
-{19,10,41,183},
-{19,10,57,183},
-{19,11,13,183},
-{19,11,25,183},
-{19,11,33,184},
-{19,11,37,183},
-{19,11,53,182},
-{19,11,57,181},
-{19,12,1,181},
-{19,12,5,182},
-{19,12,25,181},
-{19,12,29,182},
-{19,12,32,183},
-{19,12,37,183},
-{19,12,49,183},
-{19,13,1,182},
-{19,13,13,182},
-{19,13,17,183},
-{19,13,25,183},
-{19,13,33,183},
-{19,13,34,182},
-{19,13,41,183},
-{19,13,45,182},
-{19,13,49,181},
-{19,13,57,177},
-{19,14,5,180},
-{19,14,21,109},
-{19,14,37,182},
-{19,14,45,183},
-{19,14,53,181},
-{19,14,57,174},
-{19,15,9,177},
-{19,15,17,181},
-{19,15,25,179},
-{19,15,37,175},
-{19,15,41,159},
-{19,15,45,141},
-{19,15,57,80},
-{19,16,9,75},
-{19,16,13,183},
-{19,16,33,108},
-{19,16,45,129},
-{19,16,49,139},
-{19,16,54,107},
-{19,17,6,116},
-{19,17,17,117},
-{19,17,29,75},
-{19,17,33,110},
-{19,17,45,123},
-{19,18,5,147},
-{19,18,13,118},
-{19,18,29,109},
-{19,18,33,113},
-{19,18,45,136},
-{19,18,57,109},
-{19,19,1,108},
-{19,19,17,110},
-{19,19,21,101},
-{19,19,33,10},
-{19,19,45,8},
-{19,19,57,9},
-{19,20,1,10},
-{19,20,17,11},
-{19,20,21,10},
-{19,20,25,7},
-{19,20,37,10},
-{19,20,41,10},
-{19,20,57,9},
-{19,21,9,24},
-{19,21,17,17},
-{19,21,25,16},
-{19,21,37,47},
-{19,21,49,4},
-{19,22,1,4},
-{19,22,5,10},
-{19,22,13,4},
-{19,22,25,4},
-{19,22,45,4},
-{19,23,1,4},
-{19,23,13,4},
-{19,23,29,4},
-{19,23,44,4},
-{19,23,53,4},
-{20,0,5,4},
-{20,0,21,4},
-{20,0,37,4},
-{20,0,49,4},
-{20,1,16,4},
-{20,1,29,4},
-{20,1,49,4},
-{20,1,57,4},
-{20,2,1,4},
-{20,2,17,4},
-{20,2,33,4},
-{20,2,45,4},
-{20,2,53,4},
-{20,3,1,4},
-{20,3,9,4},
-{20,3,25,4},
-{20,3,33,4},
-{20,3,45,4},
-{20,3,57,4},
-{20,4,9,4},
-{20,4,21,4},
-{20,4,37,4},
-{20,4,53,4},
-{20,5,9,4},
-{20,5,21,4},
-{20,5,33,4},
-{20,5,53,183},
-{20,6,5,181},
-{20,6,9,183},
-{20,6,17,182},
-{20,6,29,183},
-{20,6,33,181},
-{20,6,47,180},
-{20,7,1,181},
-{20,7,9,180},
-{20,7,13,183},
-{20,7,29,181},
-{20,7,33,183},
-{20,7,37,183},
-{20,7,53,183},
-{20,8,5,184},
-{20,8,17,178},
-{20,8,45,179},
-{20,8,59,181},
-{20,9,5,182},
-{20,9,17,181},
-{20,9,21,180},
-{20,9,33,183},
-{20,9,49,183},
-{20,9,53,181},
-{20,10,1,183},
-{20,10,5,181},
-{20,10,17,183},
-{20,10,21,179},
-{20,10,37,183},
-{20,10,41,184},
-{20,10,53,183},
-{20,11,5,182},
-{20,11,9,179},
-{20,11,17,180},
-{20,11,21,180},
-{20,11,33,182},
-{20,11,37,179},
-{20,11,49,183},
-{20,11,53,183},
-{20,12,5,183},
-{20,12,13,183},
-{20,12,21,183},
-{20,12,29,184},
-{20,12,37,185},
-{20,12,41,183},
-{20,12,45,182},
-{20,12,53,184},
-{20,13,5,183},
-{20,13,13,183},
-{20,13,17,181},
-{20,13,25,181},
-{20,13,33,182},
-{20,13,37,179},
-{20,13,45,181},
-{20,13,49,180},
-{20,13,53,179},
-{20,13,57,181},
-{20,14,9,183},
-{20,14,17,181},
-{20,14,33,182},
-{20,14,45,182},
-{20,14,49,181},
-{20,14,53,182},
-{20,15,5,182},
-{20,15,13,143},
-{20,15,17,44},
-{20,15,21,79},
-{20,15,33,137},
-{20,15,45,63},
-{20,15,49,82},
-{20,15,57,100},
-{20,16,1,108},
-{20,16,9,85},
-{20,16,17,92},
-{20,16,21,79},
-{20,16,29,88},
-{20,16,37,68},
-{20,16,41,53},
-{20,16,45,41},
-{20,16,49,36},
-{20,17,1,18},
-{20,17,17,179},
-{20,17,28,182},
-{20,17,33,180},
-{20,17,45,182},
-{20,17,49,182},
-{20,18,1,179},
-{20,18,13,182},
-{20,18,25,182},
-{20,18,37,179},
-{20,18,41,181},
-{20,18,53,182},
-{20,18,57,181},
-{20,19,9,182},
-{20,19,21,180},
-{20,19,25,182},
-{20,19,41,183},
-{20,19,57,182},
-{20,20,9,181},
-{20,20,13,182},
-{20,20,29,180},
-{20,20,48,182},
-{20,20,57,182},
-{20,21,9,180},
-{20,21,17,182},
-{20,21,29,183},
-{20,21,33,180},
-{20,21,41,183},
-{20,21,53,4},
-{20,22,5,4},
-{20,22,17,4},
-{20,22,33,4},
-{20,22,45,4},
-{20,22,49,4},
-{20,23,5,4},
-{20,23,17,4},
-{20,23,25,4},
-{20,23,37,4},
-{20,23,53,4},
-{21,0,9,4},
-{21,0,25,4},
-{21,0,33,4},
-{21,0,45,4},
-{21,0,57,4},
-{21,1,13,4},
-{21,1,25,4},
-{21,1,49,4},
-{21,2,5,4},
-{21,2,13,4},
-{21,2,25,4},
-{21,2,37,4},
-{21,2,49,4},
-{21,2,57,4},
-{21,3,9,4},
-{21,3,25,4},
-{21,3,41,4},
-{21,3,53,4},
-{21,4,5,4},
-{21,4,21,4},
-{21,4,37,4},
-{21,4,57,4},
-{21,5,9,4},
-{21,5,25,4},
-{21,5,37,4},
-{21,5,53,4},
-{21,6,5,4},
-{21,6,25,7},
-{21,6,45,16},
-{21,6,49,20},
-{21,6,57,24},
-{21,7,9,50},
-{21,7,13,76},
-{21,7,21,62},
-{21,7,33,77},
-{21,7,45,144},
-{21,7,57,177},
-{21,8,5,177},
-{21,8,13,179},
-{21,8,25,179},
-{21,8,41,180},
-{21,8,57,180},
-{21,9,13,180},
-{21,9,23,181},
-{21,9,25,182},
-{21,9,41,183},
-{21,11,1,183},
-{21,11,9,184},
-{21,11,13,183},
-{21,11,25,183},
-{21,11,37,183},
-{21,11,45,184},
-{21,11,49,184},
-{21,12,5,184},
-{21,12,13,183},
-{21,12,18,183},
-{21,12,21,184},
-{21,12,29,184},
-{21,12,33,184},
-{21,12,49,183},
-{21,12,51,184},
-{21,12,57,184},
-{21,13,5,183},
-{21,13,17,183},
-{21,13,33,183},
-{21,13,57,183},
-{21,14,9,184},
-{21,14,13,184},
-{21,14,21,182},
-{21,14,25,129},
-{21,14,37,172},
-{21,14,41,175},
-{21,14,45,161},
-{21,14,50,152},
-{21,14,51,153},
-{21,14,53,140},
-{21,15,5,156},
-{21,15,9,157},
-{21,15,17,179},
-{21,15,29,181},
-{21,15,41,177},
-{21,15,49,176},
-{21,15,53,175},
-{21,16,9,95},
-{21,16,13,84},
-{21,16,19,60},
-{21,16,29,181},
-{21,16,45,10},
-{21,16,49,9},
-{21,16,57,7},
-{21,17,9,5},
-{21,17,21,183},
-{21,17,33,180},
-{21,17,37,182},
-{21,17,45,178},
-{21,18,1,16},
-{21,18,17,181},
-{21,18,33,18},
-{21,18,41,13},
-{21,18,49,14},
-{21,19,1,14},
-{21,19,5,27},
-{21,19,17,16},
-{21,19,25,17},
-{21,19,36,183},
-{21,19,37,182},
-{21,19,49,17},
-{21,20,1,15},
-{21,20,5,14},
-{21,20,21,21},
-{21,20,37,21},
-{21,20,41,22},
-{21,20,53,21},
-{21,21,9,20},
-{21,21,13,20},
-{21,21,21,20},
-{21,21,22,21},
-{21,21,37,21},
-{21,21,45,20},
-{21,21,57,20},
-{21,22,5,20},
-{21,22,17,29},
-{21,22,25,4},
-{21,22,41,4},
-{21,22,57,4},
-{21,23,9,4},
-{21,23,25,4},
-{21,23,33,4},
-{21,23,49,4},
-{22,0,5,4},
-{22,0,21,4},
-{22,0,29,4},
-{22,0,37,4},
-{22,0,45,4},
-{22,0,57,4},
-{22,1,8,4},
-{22,1,17,4},
-{22,1,29,4},
-{22,1,37,4},
-{22,1,49,4},
-{22,2,1,4},
-{22,2,13,4},
-{22,2,25,4},
-{22,2,41,4},
-{22,2,57,4},
-{22,3,5,4},
-{22,3,12,4},
-{22,3,24,4},
-{22,3,41,4},
-{22,3,57,4},
-{22,4,25,4},
-{22,4,49,4},
-{22,5,21,4},
-{22,5,29,4},
-{22,5,37,4},
-{22,5,49,4},
-{22,6,1,4},
-{22,6,17,4},
-{22,6,29,181},
-{22,6,35,182},
-{22,6,41,181},
-{22,6,49,183},
-{22,7,9,78},
-{22,7,13,86},
-{22,7,21,102},
-{22,7,32,145},
-{22,7,44,164},
-{22,8,0,176},
-{22,8,9,179},
-{22,8,21,179},
-{22,8,33,181},
-{22,8,49,179},
-{22,9,5,180},
-{22,9,17,176},
-{22,9,21,177},
-{22,9,29,181},
-{22,9,41,182},
-{22,9,48,182},
-{22,10,0,183},
-{22,10,17,182},
-{22,10,38,183},
-{22,10,52,182},
-{22,11,4,182},
-{22,11,17,182},
-{22,11,24,181},
-{22,11,29,183},
-{22,11,41,181},
-{22,11,53,182},
-{22,12,5,180},
-{22,12,17,175},
-{22,12,29,183},
-{22,12,37,181},
-{22,12,40,182},
-{22,12,49,182},
-{22,13,1,183},
-{22,13,16,181},
-{22,13,21,182},
-{22,13,29,179},
-{22,13,37,180},
-{22,13,41,181},
-{22,14,8,183},
-{22,14,23,182},
-{22,14,28,183},
-{22,14,45,182},
-{22,14,56,179},
-{22,15,0,174},
-{22,15,13,177},
-{22,15,25,180},
-{22,15,28,181},
-{22,15,37,180},
-{22,15,41,179},
-{22,15,45,176},
-{22,15,56,145},
-{22,16,1,133},
-{22,16,5,124},
-{22,16,9,121},
-{22,16,17,84},
-{22,16,25,59},
-{22,16,29,52},
-{22,16,33,47},
-{22,16,49,182},
-{22,16,53,17},
-{22,16,56,13},
-{22,17,9,182},
-{22,17,17,4},
-{22,17,24,182},
-{22,17,29,36},
-{22,17,36,41},
-{22,17,49,183},
-{22,17,58,179},
-{22,18,1,182},
-{22,18,40,4},
-{22,18,53,182},
-{22,18,57,179},
-{22,19,9,4},
-{22,19,20,4},
-{22,19,32,4},
-{22,19,41,4},
-{22,19,49,4},
-{22,19,56,4},
-{22,20,26,4},
-{22,20,41,4},
-{22,20,50,4},
-{22,21,20,4},
-{22,21,40,4},
-{22,21,53,4},
-{22,22,0,4},
-{22,22,16,4},
-{22,22,32,4},
-{22,22,49,4},
-{22,23,16,4},
-{22,23,29,4},
-{22,23,41,4},
-{22,23,52,4},
-{23,0,5,4},
-{23,0,16,4},
-{23,0,28,4},
-{23,0,41,4},
-{23,0,52,4},
-{23,1,4,4},
-{23,1,12,4},
-{23,1,17,4},
-{23,1,25,4},
-{23,1,44,4},
-{23,1,57,4},
-{23,2,13,4},
-{23,2,28,4},
-{23,2,48,4},
-{23,3,1,4},
-{23,3,16,4},
-{23,3,29,4},
-{23,3,40,4},
-{23,3,56,4},
-{23,4,8,4},
-{23,4,25,4},
-{23,4,52,4},
-{23,4,59,4},
-{23,5,6,4},
-{23,5,21,4},
-{23,5,37,4},
-{23,5,52,4},
-{23,6,4,4},
-{23,6,12,4},
-{23,6,20,5},
-{23,6,24,5},
-{23,6,44,18},
-{23,6,52,26},
-{23,7,0,34},
-{23,7,16,50},
-{23,7,24,73},
-{23,7,53,143},
-{23,8,5,97},
-{23,8,13,101},
-{23,8,17,103},
-{23,8,20,104},
-{23,8,28,116},
-{23,8,33,119},
-{23,8,52,175},
-{23,9,0,178},
-{23,9,8,177},
-{23,9,12,166},
-{23,9,28,176},
-{23,9,53,178},
-{23,10,1,178},
-{23,10,4,178},
-{23,10,16,178},
-{23,10,25,180},
-{23,10,37,181},
-{23,10,48,182},
-{23,11,0,183},
-{23,11,10,181},
-{23,11,16,183},
-{23,11,24,182},
-{23,11,29,183},
-{23,11,40,182},
-{23,12,9,182},
-{23,12,16,182},
-{23,12,20,183},
-{23,12,28,182},
-{23,12,37,183},
-{23,12,44,183},
-{23,12,54,183},
-{23,13,13,183},
-{23,13,16,182},
-{23,13,28,180},
-{23,13,33,181},
-{23,13,44,181},
-{23,13,56,182},
-{23,14,1,181},
-{23,14,12,179},
-{23,14,16,179},
-{23,14,28,182},
-{23,14,36,181},
-{23,14,41,180},
-{23,14,56,182},
-{23,15,0,181},
-{23,15,8,181},
-{23,15,12,179},
-{23,15,16,180},
-{23,15,24,181},
-{23,15,36,178},
-{23,15,40,176},
-{23,15,44,177},
-{23,16,0,137},
-{23,16,4,66},
-{23,16,32,33},
-{23,16,40,25},
-{23,16,56,9},
-{23,17,9,5},
-{23,17,24,4},
-{23,17,44,4},
-{23,17,52,4},
-{23,18,4,4},
-{23,18,16,4},
-{23,18,28,4},
-{23,18,36,4},
-{23,18,49,4},
-{23,18,56,16},
-{23,19,4,20},
-{23,19,8,20},
-{23,19,20,22},
-{23,19,32,22},
-{23,19,52,22},
-{23,20,0,21},
-{23,20,21,20},
-{23,20,28,21},
-{23,20,36,21},
-{23,20,44,21},
-{23,20,53,21},
-{23,21,1,20},
-{23,21,4,21},
-{23,21,20,21},
-{23,21,29,22},
-{23,21,48,22},
-{23,22,0,20},
-{23,22,13,4},
-{23,22,28,4},
-{23,22,40,4},
-{23,22,56,4},
-{23,23,8,4},
-{23,23,20,4},
-{23,23,36,4},
-{23,23,44,4},
-{23,23,56,4},
-{24,0,8,4},
-{24,0,20,4},
-{24,0,32,4},
-{24,0,47,4},
-{24,1,0,4},
-{24,1,16,4},
-{24,1,36,4},
-{24,1,48,4},
-{24,1,56,4},
-{24,2,6,4},
-{24,2,28,4},
-{24,2,40,4},
-{24,2,52,4},
-{24,3,4,4},
-{24,3,37,4},
-{24,3,48,4},
-{24,4,0,4},
-{24,4,13,4},
-{24,4,32,4},
-{24,4,44,4},
-{24,5,0,4},
-{24,5,24,4},
-{24,5,40,4},
-{24,5,44,4},
-{24,5,56,4},
-{24,6,8,4},
-{24,6,24,4},
-{24,6,36,6},
-{24,6,44,7},
-{24,6,52,9},
-{24,6,56,11},
-{24,7,8,24},
-{24,7,12,22},
-{24,7,20,25},
-{24,7,36,64},
-{24,7,44,63},
-{24,7,58,90},
-{24,8,12,108},
-{24,8,20,176},
-{24,8,28,177},
-{24,8,40,175},
-{24,9,12,180},
-{24,9,16,179},
-{24,9,24,180},
-{24,9,28,182},
-{24,9,32,182},
-{24,9,48,182},
-{24,10,20,183},
-{24,10,32,182},
-{24,10,36,182},
-{24,11,0,181},
-{24,11,4,180},
-{24,11,16,177},
-{24,11,24,179},
-{24,11,28,181},
-{24,11,40,181},
-{24,12,16,182},
-{24,12,44,183},
-{24,12,52,182},
-{24,13,7,183},
-{24,13,16,182},
-{24,13,24,183},
-{24,13,32,182},
-{24,13,40,181},
-{24,13,56,182},
-{24,14,8,181},
-{24,14,12,182},
-{24,14,24,182},
-{24,14,36,176},
-{24,14,40,174},
-{24,14,52,167},
-{24,15,0,164},
-{24,15,4,159},
-{24,15,8,161},
-{24,15,16,144},
-{24,15,24,166},
-{24,15,32,168},
-{24,15,44,137},
-{24,15,56,95},
-{24,16,12,58},
-{24,16,24,78},
-{24,16,32,38},
-{24,16,36,67},
-{24,17,12,180},
-{24,17,40,183},
-{24,18,12,183},
-{24,18,24,183},
-{24,18,44,4},
-{24,18,56,4},
-{24,19,8,4},
-{24,19,20,4},
-{24,19,32,4},
-{24,19,48,4},
-{24,20,8,4},
-{24,20,24,4},
-{24,20,36,4},
-{24,20,48,4},
-{24,21,0,4},
-{24,21,16,178},
-{24,21,28,4},
-{24,21,48,4},
-{24,22,4,179},
-{24,22,9,182},
-{24,22,16,168},
-{24,22,24,4},
-{24,23,12,4},
-{24,23,24,4},
-{24,23,36,4},
-{24,23,48,4},
-{25,0,4,4},
-{25,0,20,4},
-{25,0,36,4},
-{25,0,48,4},
-{25,1,4,4},
-{25,1,28,4},
-{25,1,44,4},
-{25,2,16,4},
-{25,2,24,4},
-{25,2,32,4},
-{25,2,40,4},
-{25,2,52,4},
-{25,3,0,4},
-{25,3,24,4},
-{25,3,36,4},
-{25,3,47,4},
-{25,3,52,4},
-{25,4,8,4},
-{25,4,28,4},
-{25,4,44,4},
-{25,4,56,4, ALDataSample::NO_OCC_EXPECTATION, true, false, ALDataSample::SB_ECOMAX},
-{ },
-    };
-static const ALDataSample samplea0b[] =
-    {
-{8,7,10,181},
-{8,7,22,181},
-{8,7,30,181},
-{8,7,59,183},
-{8,8,6,181},
-{8,8,19,183},
-{8,8,30,158},
-{8,8,46,119},
-{8,9,39,177},
-{8,9,54,179},
-{8,10,10,181},
-{8,10,14,182},
-{8,10,18,182},
-{8,10,34,183},
-{8,11,2,183},
-{8,11,14,183},
-{8,11,18,183},
-{8,11,34,183},
-{8,11,42,183},
-{8,11,58,183},
-{8,12,10,183, ALDataSample::NO_OCC_EXPECTATION, false, ALDataSample::UNKNOWN_ACT_OCC},
-{8,12,18,183},
-{8,12,26,183},
-{8,12,38,183},
-{8,12,48,183},
-{8,12,54,183},
-{8,13,6,183},
-{8,13,18,183},
-{8,13,26,182},
-{8,13,38,183},
-{8,13,50,183},
-{8,14,44,178},
-{8,14,54,179},
-{8,15,26,140},
-{8,16,6,24},
-{8,16,14,14},
-{8,16,26,181},
-{8,16,38,180},
-{8,16,58,182},
-{8,17,10,181},
-{8,17,22,183},
-{8,17,30,181},
-{8,17,34,181},
-{8,17,42,183},
-{8,17,58,180},
-{8,18,10,182},
-{8,18,14,15},
-{8,18,22,14},
-{8,18,34,14},
-{8,18,46,182},
-{8,18,58,12},
-{8,19,10,12},
-{8,19,22,14},
-{8,19,38,14},
-{8,19,54,14},
-{8,20,6,13},
-{8,20,18,13},
-{8,20,34,15},
-{8,20,46,13},
-{8,20,58,13},
-{8,20,59,11},
-{8,21,10,13},
-{8,21,22,13},
-{8,21,38,13},
-{8,21,51,13},
-{8,21,58,14},
-{8,22,2,13},
-{8,22,18,13},
-{8,22,26,13},
-{8,22,34,13},
-{8,22,44,13},
-{8,22,54,13},
-{8,23,6,11},
-{8,23,10,4},
-{8,23,38,4},
-{8,23,50,4},
-{9,0,10,4},
-{9,0,18,4},
-{9,0,26,4},
-{9,0,38,4},
-{9,0,54,4},
-{9,1,6,4},
-{9,1,18,4},
-{9,1,30,4},
-{9,1,46,4},
-{9,2,2,4},
-{9,2,10,4},
-{9,2,24,4},
-{9,2,42,4},
-{9,2,54,4},
-{9,3,2,4},
-{9,3,18,4},
-{9,3,26,4},
-{9,3,42,4},
-{9,3,58,4},
-{9,4,6,4},
-{9,4,15,4, occType::OCC_NONE, true, false, ALDataSample::SB_MAX},
-{9,4,26,4},
-{9,4,42,4},
-{9,4,50,4},
-{9,4,58,4},
-{9,5,14,4},
-{9,5,26,4},
-{9,5,42,4},
-{9,5,58,4},
-{9,6,6,4},
-{9,6,18,4},
-{9,6,30,4},
-{9,6,42,183},
-{9,6,54,182},
-{9,6,58,180},
-{9,7,14,181},
-{9,7,26,183},
-{9,7,38,183},
-{9,7,42,183},
-{9,7,58,182},
-{9,8,15,179},
-{9,8,22,180},
-{9,8,26,182},
-{9,8,42,84},
-{9,8,54,86},
-{9,8,58,106},
-{9,9,6,117},
-{9,9,22,168},
-{9,9,30,116},
-{9,9,42,114},
-{9,9,54,171},
-{9,10,14,125},
-{9,10,26,124},
-{9,10,34,173},
-{9,10,38,146},
-{9,10,46,146},
-{9,10,54,175},
-{9,10,58,178},
-{9,11,10,182},
-{9,11,14,183},
-{9,11,23,180},
-{9,11,38,177},
-{9,11,50,131},
-{9,11,54,111},
-{9,12,6,175},
-{9,12,18,180},
-{9,12,22,181},
-{9,12,26,182},
-{9,12,34,183},
-{9,12,46,181},
-{9,12,50,179},
-{9,13,2,183},
-{9,13,6,182},
-{9,13,18,178},
-{9,13,22,181},
-{9,13,38,181},
-{9,13,42,173},
-{9,13,54,181},
-{9,14,6,181},
-{9,14,10,182},
-{9,14,22,181},
-{9,14,26,178},
-{9,14,42,171},
-{9,14,46,158},
-{9,14,58,181},
-{9,15,2,180},
-{9,15,4,180},
-{9,15,6,179},
-{9,15,14,180},
-{9,15,18,179},
-{9,15,30,83},
-{9,15,39,107},
-{9,15,46,68},
-{9,15,50,66},
-{9,15,58,67},
-{9,16,6,54},
-{9,16,10,30},
-{9,16,14,27},
-{9,16,22,17},
-{9,16,30,9},
-{9,16,34,7},
-{9,16,38,6},
-{9,16,58,175},
-{9,17,6,177},
-{9,17,14,183},
-{9,17,26,179},
-{9,17,38,180},
-{9,17,42,180},
-{9,17,54,180},
-{9,18,6,183},
-{9,18,22,4},
-{9,18,42,181},
-{9,18,58,179},
-{9,19,14,182},
-{9,19,22,181},
-{9,19,26,42},
-{9,19,38,180},
-{9,19,46,182},
-{9,19,58,182},
-{9,20,6,179},
-{9,20,10,180},
-{9,20,14,179},
-{9,20,26,182},
-{9,20,30,183},
-{9,20,34,180},
-{9,20,50,181},
-{9,21,22,181},
-{9,21,26,183},
-{9,21,34,27},
-{9,21,46,28},
-{9,21,50,12},
-{9,21,58,29},
-{9,22,6,4},
-{9,22,10,4},
-{9,22,18,4},
-{9,22,26,4},
-{9,22,38,129},
-{9,22,42,4},
-{9,22,50,4},
-{9,23,2,4},
-{9,23,10,4},
-{9,23,26,4},
-{9,23,38,183},
-{9,23,50,4},
-{10,0,2,4},
-{10,0,14,4},
-{10,0,26,4},
-{10,1,6,4},
-{10,1,18,4},
-{10,1,26,4},
-{10,1,38,4},
-{10,1,54,4},
-{10,2,2,4},
-{10,2,10,4},
-{10,2,26,4},
-{10,2,42,4},
-{10,2,58,4},
-{10,3,14,4},
-{10,3,22,4},
-{10,3,38,4},
-{10,3,50,4},
-{10,4,2,4, ALDataSample::NO_OCC_EXPECTATION, true, false, ALDataSample::SB_MAX},
-{10,4,22,4},
-{10,4,34,4},
-{10,4,46,4},
-{10,4,58,4},
-{10,5,10,4},
-{10,5,22,4},
-{10,5,26,4},
-{10,5,42,4},
-{10,5,58,4},
-{10,6,10,4},
-{10,6,20,4},
-{10,6,30,4},
-{10,6,42,183},
-{10,6,58,183},
-{10,7,2,182},
-{10,7,6,182},
-{10,7,14,183},
-{10,7,30,184},
-{10,7,42,182},
-{10,7,50,184},
-{10,8,2,183},
-{10,8,10,184},
-{10,8,22,166},
-{10,8,34,171},
-{10,8,38,179},
-{10,8,50,180},
-{10,8,54,179},
-{10,8,58,180},
-{10,9,14,182},
-{10,9,18,181},
-{10,9,26,177},
-{10,9,38,179},
-{10,9,54,181},
-{10,9,58,179},
-{10,10,6,182},
-{10,10,14,182},
-{10,10,26,182},
-{10,10,34,182},
-{10,10,42,183},
-{10,10,46,183},
-{10,10,58,183},
-{10,11,14,183},
-{10,11,26,183},
-{10,11,38,183},
-{10,11,50,183},
-{10,12,2,183, ALDataSample::NO_OCC_EXPECTATION, false, ALDataSample::UNKNOWN_ACT_OCC},
-{10,12,14,184},
-{10,12,26,182},
-{10,12,34,183},
-{10,12,46,181},
-{10,12,50,183},
-{10,12,54,183},
-{10,13,14,179},
-{10,13,22,179},
-{10,13,30,177},
-{10,13,38,176},
-{10,13,46,143},
-{10,13,54,138},
-{10,14,13,175},
-{10,14,18,179},
-{10,14,30,175},
-{10,14,38,149},
-{10,14,42,130},
-{10,14,46,122},
-{10,14,54,130},
-{10,14,58,122},
-{10,15,2,119},
-{10,15,18,113},
-{10,15,27,145},
-{10,15,30,135},
-{10,15,34,161},
-{10,15,54,69},
-{10,16,2,58},
-{10,16,6,52},
-{10,16,16,32},
-{10,16,18,29},
-{10,16,26,16},
-{10,16,38,181},
-{10,16,50,183},
-{10,16,58,181},
-{10,17,10,20},
-{10,17,14,21},
-{10,17,22,17},
-{10,17,34,19},
-{10,17,38,19},
-{10,17,50,20},
-{10,18,2,180},
-{10,18,6,21},
-{10,18,14,22},
-{10,18,26,22},
-{10,18,34,21},
-{10,18,38,22},
-{10,18,50,182},
-{10,18,58,181},
-{10,19,6,181},
-{10,19,10,182},
-{10,19,22,182},
-{10,19,30,138},
-{10,19,38,80},
-{10,19,50,179},
-{10,19,54,182},
-{10,20,2,182},
-{10,20,14,180},
-{10,20,26,26},
-{10,20,30,25},
-{10,20,38,26},
-{10,20,50,26},
-{10,20,54,13},
-{10,21,10,16},
-{10,21,18,17},
-{10,21,22,16},
-{10,21,34,16},
-{10,21,38,17},
-{10,21,46,16},
-{10,21,54,17},
-{10,22,2,16},
-{10,22,6,16},
-{10,22,14,16},
-{10,22,20,17},
-{10,22,22,16},
-{10,22,38,16},
-{10,22,50,17},
-{10,22,54,17},
-{10,22,58,16},
-{10,23,6,17},
-{10,23,22,16},
-{10,23,30,16},
-{10,23,38,17},
-{10,23,42,16},
-{10,23,46,17},
-{10,23,54,17},
-{11,0,2,16},
-{11,0,6,16},
-{11,0,18,16},
-{11,0,22,16},
-{11,0,30,16},
-{11,0,34,17},
-{11,0,42,17},
-{11,0,46,17},
-{11,1,2,17},
-{11,1,18,17},
-{11,1,22,16},
-{11,1,34,17},
-{11,1,46,16},
-{11,1,54,16},
-{11,1,58,16},
-{11,2,6,16},
-{11,2,22,17},
-{11,2,26,16},
-{11,2,30,16},
-{11,2,42,16},
-{11,2,54,16},
-{11,3,2,17},
-{11,3,14,17},
-{11,3,22,17},
-{11,3,30,16},
-{11,3,42,16},
-{11,3,50,16},
-{11,3,58,16},
-{11,4,2,16},
-{11,4,14,16},
-{11,4,22,16},
-{11,4,26,16},
-{11,4,38,16},
-{11,4,46,17},
-{11,4,54,17},
-{11,5,6,16},
-{11,5,14,16},
-{11,5,26,16},
-{11,5,30,17},
-{11,5,38,17},
-{11,5,46,16},
-{11,5,50,16},
-{11,5,58,16},
-{11,6,5,16},
-{11,6,6,17},
-{11,6,10,17},
-{11,6,22,17},
-{11,6,30,16},
-{11,6,34,16},
-{11,6,46,17},
-{11,6,58,35},
-{11,7,2,27},
-{11,7,14,37},
-{11,7,26,61},
-{11,7,30,68},
-{11,7,42,89},
-{11,7,50,103},
-{11,7,54,109},
-{11,8,6,130},
-{11,8,14,143},
-{11,8,18,151},
-{11,8,30,154},
-{11,8,34,159},
-{11,8,38,151},
-{11,8,50,172},
-{11,8,54,173},
-{11,9,2,176},
-{11,9,14,178},
-{11,9,26,179},
-{11,9,38,179},
-{11,9,50,178},
-{11,9,58,178},
-{11,10,10,178},
-{11,10,18,178},
-{11,10,30,179},
-{11,10,38,179},
-{11,10,50,179},
-{11,10,58,179},
-{11,11,6,179},
-{11,11,22,179},
-{11,11,34,179},
-{11,11,46,179},
-{11,11,58,178},
-{11,12,6,180, ALDataSample::NO_OCC_EXPECTATION, false, ALDataSample::UNKNOWN_ACT_OCC},
-{11,12,18,180},
-{11,12,30,180},
-{11,12,46,180},
-{11,13,2,178},
-{11,13,14,177},
-{11,13,30,178},
-{11,13,34,177},
-{11,13,42,177},
-{11,13,54,176},
-{11,13,58,176},
-{11,14,6,176},
-{11,14,22,175},
-{11,14,34,172},
-{11,14,38,160},
-{11,14,42,159},
-{11,14,46,161},
-{11,14,54,143},
-{11,15,2,135},
-{11,15,10,154},
-{11,15,14,122},
-{11,15,18,104},
-{11,15,26,82},
-{11,15,34,69},
-{11,15,38,62},
-{11,15,39,60},
-{11,15,46,52},
-{11,15,54,44},
-{ },
-    };
-static const ALDataSample samplea1[] =
-    {
-{14,11,1,181, ALDataSample::NO_OCC_EXPECTATION, false, ALDataSample::UNKNOWN_ACT_OCC},
-{14,11,20,178},
-{14,11,32,177},
-{14,11,34,178},
-{14,11,40,177},
-{14,12,0,177},
-{14,12,13,174},
-{14,12,25,176},
-{14,12,33,173},
-{14,12,40,164},
-{14,12,53,151},
-{14,12,56,155},
-{14,13,9,122},
-{14,13,20,123},
-{14,13,24,129},
-{14,13,36,133},
-{14,13,48,102},
-{14,14,0,99},
-{14,14,20,118},
-{14,14,28,117},
-{14,14,33,117},
-{14,14,36,115},
-{14,14,49,119},
-{14,14,56,121},
-{14,14,58,119},
-{14,15,4,108},
-{14,15,12,87},
-{14,15,16,72},
-{14,15,29,58},
-{14,15,32,61},
-{14,15,36,65},
-{14,15,44,68},
-{14,15,57,51},
-{14,16,0,47},
-{14,16,9,38},
-{14,16,13,36},
-{14,16,24,26},
-{14,16,32,24},
-{14,16,40,20},
-{14,16,44,15},
-{14,17,4,12},
-{14,17,13,9},
-{14,17,16,9},
-{14,17,28,8},
-{14,17,40,8},
-{14,17,44,9},
-{14,17,56,8},
-{14,18,12,15},
-{14,18,24,15},
-{14,18,40,9},
-{14,18,57,9},
-{14,19,0,8},
-{14,19,9,9},
-{14,19,20,9},
-{14,19,29,9},
-{14,19,40,9},
-{14,19,44,9},
-{14,20,0,9},
-{14,20,7,9},
-{14,20,16,9},
-{14,20,28,9},
-{14,20,36,9},
-{14,20,53,9},
-{14,21,16,9},
-{14,21,32,9},
-{14,21,48,9},
-{14,22,0,8},
-{14,22,12,8},
-{14,22,21,8},
-{14,22,32,8},
-{14,22,44,8},
-{14,23,0,8},
-{14,23,16,8},
-{14,23,28,8},
-{14,23,32,8},
-{14,23,44,8},
-{14,23,56,8},
-{15,0,13,8},
-{15,0,32,8},
-{15,0,48,8},
-{15,1,4,8},
-{15,1,15,8},
-{15,1,32,8},
-{15,1,44,8},
-{15,1,56,8},
-{15,2,8,8},
-{15,2,20,8},
-{15,2,28,8},
-{15,2,44,8},
-{15,3,4,8},
-{15,3,12,8},
-{15,3,28,8},
-{15,3,36,8},
-{15,3,44,8},
-{15,3,52,8},
-{15,4,12,8, ALDataSample::NO_OCC_EXPECTATION, true, false, ALDataSample::SB_MAX},
-{15,4,24,8},
-{15,4,40,8},
-{15,4,48,8},
-{15,4,58,8},
-{15,5,12,8},
-{15,5,24,8},
-{15,5,36,8},
-{15,5,48,8},
-{15,6,4,8},
-{15,6,12,9},
-{15,6,20,9},
-{15,6,24,10},
-{15,6,32,16},
-{15,6,36,18},
-{15,6,40,29},
-{15,6,48,44},
-{15,7,4,31},
-{15,7,16,59},
-{15,7,20,63},
-{15,7,28,85},
-{15,7,40,157},
-{15,7,52,178},
-{15,7,56,178},
-{15,8,32,182},
-{15,8,44,179},
-{15,8,56,46},
-{15,9,0,49},
-{15,9,12,77},
-{15,9,24,120},
-{15,9,32,79},
-{15,9,44,170},
-{15,9,52,148},
-{15,10,4,74},
-{15,10,20,26},
-{15,10,24,61},
-{15,10,32,98},
-{15,10,44,46},
-{15,10,48,78},
-{15,10,52,118},
-{15,10,56,109},
-{15,11,4,165},
-{15,11,8,179},
-{15,11,20,147},
-{15,11,24,123},
-{15,11,28,141},
-{15,11,32,124},
-{15,11,44,178},
-{15,11,48,179},
-{15,12,0,181},
-{15,12,20,165},
-{15,12,32,183},
-{15,12,44,162},
-{15,12,56,161},
-{15,13,0,177},
-{15,13,8,178},
-{15,13,16,94},
-{15,13,20,89},
-{15,13,24,80},
-{15,13,28,70},
-{15,13,44,166},
-{15,13,48,126},
-{15,13,52,119},
-{15,13,56,96},
-{15,14,12,113},
-{15,14,16,121},
-{15,14,28,88},
-{15,14,32,78},
-{15,14,44,129},
-{15,14,48,93},
-{15,14,56,83},
-{15,15,4,82},
-{15,15,12,74},
-{15,15,24,62},
-{15,15,28,60},
-{15,15,32,38},
-{15,15,40,25},
-{15,15,48,19},
-{15,15,52,17},
-{15,15,56,19},
-{15,16,4,18},
-{15,16,16,14},
-{15,16,20,15},
-{15,16,28,18},
-{15,16,36,11},
-{15,16,40,10},
-{15,16,48,8},
-{15,16,52,8},
-{15,17,8,8},
-{15,17,20,36},
-{15,17,28,36},
-{15,17,32,36},
-{15,17,40,38},
-{15,17,52,36},
-{15,17,56,39},
-{15,18,6,39},
-{15,18,20,38},
-{15,18,32,38},
-{15,18,36,39},
-{15,18,52,38},
-{15,18,56,39},
-{15,19,4,38},
-{15,19,16,39},
-{15,19,28,39},
-{15,19,36,38},
-{15,19,40,34},
-{15,19,56,38},
-{15,20,12,37},
-{15,20,28,38},
-{15,20,40,38},
-{15,20,52,37},
-{15,20,56,37},
-{15,21,8,10},
-{15,21,16,10},
-{15,21,32,10},
-{15,21,44,10},
-{15,21,56,10},
-{15,22,8,10},
-{15,22,24,10},
-{15,22,40,10},
-{15,22,56,10},
-{15,23,4,10},
-{15,23,16,10},
-{15,23,32,10},
-{15,23,40,10},
-{15,23,48,10},
-{15,23,56,10},
-{16,0,8,10},
-{16,0,20,10},
-{16,0,40,10},
-{16,0,56,10},
-{16,1,8,10},
-{16,1,24,10},
-{16,1,40,10},
-{16,1,52,10},
-{16,2,4,10},
-{16,2,16,10},
-{16,2,28,10},
-{16,2,36,10},
-{16,2,48,10},
-{16,3,0,10},
-{16,3,12,10},
-{16,3,28,10},
-{16,3,40,10},
-{16,3,56,10},
-{16,4,4,10},
-{16,4,16,10},
-{16,4,28,10},
-{16,4,48,10},
-{16,5,0,10},
-{16,5,12,10},
-{16,5,28,10},
-{16,5,40,10},
-{16,5,52,10},
-{16,6,24,8},
-{16,6,28,8},
-{16,6,40,8},
-{16,7,8,10},
-{16,7,36,15},
-{16,7,40,16},
-{16,7,44,17},
-{16,7,48,17},
-{16,7,52,18},
-{16,8,4,18},
-{16,8,8,15},
-{16,8,44,18},
-{16,8,48,15},
-{16,8,56,18},
-{16,9,4,15},
-{16,9,8,29},
-{16,9,12,33},
-{16,9,20,38},
-{16,9,28,38},
-{16,9,32,33},
-{16,9,41,37},
-{16,9,44,38},
-{16,9,48,43},
-{16,9,56,74},
-{16,10,8,107},
-{16,10,12,102},
-{16,10,24,177},
-{16,10,36,109},
-{16,10,44,163},
-{16,10,56,182},
-{16,11,0,172},
-{16,11,8,175},
-{16,11,20,181},
-{16,11,24,172},
-{16,11,36,178},
-{16,11,37,173},
-{16,11,44,181},
-{16,11,48,177},
-{16,11,56,180},
-{16,12,0,181},
-{16,12,12,181},
-{16,12,24,181},
-{16,12,28,182},
-{16,12,48,76},
-{16,13,0,177},
-{16,13,4,183},
-{16,13,12,179},
-{16,13,16,176},
-{16,13,28,167},
-{16,13,32,114},
-{16,13,36,142},
-{16,13,42,176},
-{16,13,44,172},
-{16,13,46,168},
-{16,13,52,135},
-{16,13,56,123},
-{16,14,0,116},
-{16,14,8,110},
-{16,14,19,84},
-{16,14,28,80},
-{16,14,36,62},
-{16,14,40,58},
-{16,14,44,63},
-{16,14,48,84},
-{16,15,0,53},
-{16,15,4,59},
-{16,15,12,70},
-{16,15,20,95},
-{16,15,36,37},
-{16,15,39,39},
-{16,15,44,36},
-{16,15,56,34},
-{16,16,0,31},
-{16,16,8,28},
-{16,16,16,27},
-{16,16,20,31},
-{16,16,24,27},
-{16,16,36,21},
-{16,16,40,20},
-{16,16,48,20},
-{16,16,56,16},
-{16,17,0,13},
-{16,17,16,10},
-{16,17,20,9},
-{16,17,28,9},
-{16,17,44,15},
-{16,17,52,16},
-{16,17,56,16},
-{16,18,8,16},
-{16,18,16,17},
-{16,18,20,17},
-{16,18,24,16},
-{16,18,36,15},
-{16,18,44,16},
-{16,19,4,16},
-{16,19,12,17},
-{16,19,16,17},
-{16,19,32,17},
-{16,19,36,16},
-{16,19,48,17},
-{16,20,20,24},
-{16,20,36,22},
-{16,20,40,23},
-{16,20,44,23},
-{16,20,56,9},
-{16,21,0,9},
-{16,21,16,9},
-{16,21,24,9},
-{16,21,32,9},
-{16,21,48,8},
-{16,22,4,8},
-{16,22,20,8},
-{16,22,36,8},
-{16,22,56,8},
-{16,23,12,8},
-{16,23,28,8},
-{16,23,48,8},
-{17,0,8,8},
-{17,0,23,8},
-{17,0,32,8},
-{17,0,52,8},
-{17,1,4,8},
-{17,1,16,8},
-{17,1,28,8},
-{17,1,40,8},
-{17,1,52,8},
-{17,2,4,8},
-{17,2,20,8},
-{17,2,32,8},
-{17,2,41,8},
-{17,2,48,8},
-{17,3,4,8},
-{17,3,16,8},
-{17,3,24,8},
-{17,3,40,8},
-{17,3,52,8},
-{17,4,4,8},
-{17,4,16,8},
-{17,4,28,8},
-{17,4,44,8},
-{17,4,56,8},
-{17,5,12,8},
-{17,5,28,8},
-{17,5,48,8},
-{17,5,56,17},
-{17,6,0,16},
-{17,6,16,18},
-{17,6,28,23},
-{17,6,32,26},
-{17,6,52,56},
-{17,7,8,58},
-{17,7,16,142},
-{17,7,20,122},
-{17,7,36,169},
-{17,7,40,111},
-{17,7,48,105},
-{17,8,0,82},
-{17,8,4,101},
-{17,8,12,80},
-{17,8,21,124},
-{17,8,32,175},
-{17,8,44,186},
-{17,9,0,179},
-{17,9,4,185},
-{17,9,20,185},
-{17,9,32,186},
-{17,9,36,185},
-{17,9,44,185},
-{17,9,56,185},
-{17,10,0,184},
-{17,10,8,185},
-{17,10,12,185},
-{17,10,16,184},
-{17,10,24,184},
-{17,10,40,184},
-{17,10,48,183},
-{17,10,52,184},
-{17,11,4,181},
-{17,11,20,179},
-{17,11,32,181},
-{17,11,44,179},
-{17,11,48,179},
-{17,12,4,180},
-{17,12,8,183},
-{17,12,20,181},
-{17,12,32,179},
-{17,12,36,181},
-{17,12,44,182},
-{17,12,56,181},
-{17,13,0,180},
-{17,13,8,178},
-{17,13,12,178},
-{17,13,16,182},
-{17,13,29,180},
-{17,13,36,172},
-{17,13,40,142},
-{17,13,44,103},
-{17,13,56,175},
-{17,14,0,154},
-{17,14,12,169},
-{17,14,16,171},
-{17,14,28,171},
-{17,14,32,158},
-{17,14,40,113},
-{17,14,41,148},
-{17,14,56,104},
-{17,15,4,149},
-{17,15,16,89},
-{17,15,20,95},
-{17,15,28,83},
-{17,15,32,66},
-{17,15,56,38},
-{17,16,12,15},
-{17,16,24,18},
-{17,16,28,19},
-{17,16,40,15},
-{17,16,44,14},
-{17,16,52,11},
-{17,17,0,9},
-{17,17,6,8},
-{17,17,8,8},
-{17,17,24,8},
-{17,17,32,8},
-{17,17,44,8},
-{17,17,56,8},
-{17,18,8,8},
-{17,18,28,37},
-{17,18,36,35},
-{17,18,52,38},
-{17,18,56,36},
-{17,19,4,36},
-{17,19,16,36},
-{17,19,18,35},
-{17,19,24,34},
-{17,19,36,34},
-{17,19,52,34},
-{17,19,56,37},
-{17,20,4,20},
-{17,20,16,9},
-{17,20,32,9},
-{17,20,36,8},
-{17,20,44,9},
-{17,21,0,9},
-{17,21,8,9},
-{17,21,12,9},
-{17,21,28,9},
-{17,21,40,8},
-{17,21,52,9},
-{17,22,2,9},
-{17,22,16,9},
-{17,22,28,9},
-{17,22,36,8},
-{17,22,44,9},
-{17,22,56,9},
-{17,23,12,9},
-{17,23,24,9},
-{17,23,32,9},
-{17,23,48,9},
-{18,0,4,9},
-{18,0,12,9},
-{18,0,24,9},
-{18,0,36,9},
-{18,0,56,9},
-{18,1,12,9},
-{18,1,24,9},
-{18,1,38,9},
-{18,1,56,8},
-{18,2,4,9},
-{18,2,8,9},
-{18,2,24,9},
-{18,2,36,9},
-{18,2,48,9},
-{18,3,0,9},
-{18,3,12,8},
-{18,3,20,8},
-{18,3,24,9},
-{18,3,32,9},
-{18,3,40,8},
-{18,3,48,8},
-{18,3,56,8},
-{18,4,4,9},
-{18,4,8,9},
-{18,4,12,8},
-{18,4,20,9},
-{18,4,28,9},
-{18,4,40,9},
-{18,4,52,9},
-{18,5,0,9},
-{18,5,12,8},
-{18,5,28,8},
-{18,5,44,15},
-{18,5,56,13},
-{18,6,4,14},
-{18,6,16,17},
-{18,6,28,17},
-{18,6,32,17},
-{18,6,48,18},
-{18,7,4,34},
-{18,7,8,45},
-{18,7,16,49},
-{18,7,28,53},
-{18,7,32,51},
-{18,7,36,40},
-{18,7,52,50},
-{18,8,4,48},
-{18,8,8,41},
-{18,8,12,53},
-{18,8,24,39},
-{18,8,28,41},
-{18,8,40,64},
-{18,8,48,101},
-{18,9,4,138},
-{18,9,16,175},
-{18,9,24,173},
-{18,9,40,101},
-{18,9,56,127},
-{18,10,12,178},
-{18,10,28,178},
-{18,10,36,185},
-{18,10,52,183},
-{18,11,0,180},
-{18,11,8,184},
-{18,11,12,184},
-{18,11,24,183},
-{18,11,40,183},
-{18,11,52,182},
-{18,12,1,181},
-{18,12,12,181},
-{18,12,24,182},
-{18,12,28,183},
-{18,12,32,181},
-{18,12,44,182},
-{18,12,48,175},
-{18,12,52,177},
-{18,13,4,151},
-{18,13,12,185},
-{18,13,24,181},
-{18,13,36,180},
-{18,13,48,177},
-{18,13,52,175},
-{18,14,0,173},
-{18,14,12,161},
-{18,14,16,152},
-{18,14,24,131},
-{18,14,28,151},
-{18,14,40,155},
-{18,14,48,138},
-{18,15,0,85},
-{18,15,4,84},
-{18,15,8,126},
-{18,15,12,137},
-{18,15,17,134},
-{18,15,28,125},
-{18,15,32,118},
-{18,15,40,121},
-{18,15,44,124},
-{18,15,56,117},
-{18,16,4,98},
-{18,16,12,75},
-{18,16,20,45},
-{18,16,28,35},
-{18,16,32,30},
-{18,16,48,19},
-{18,16,52,18},
-{18,17,4,12},
-{18,17,8,11},
-{18,17,16,35},
-{18,17,28,8},
-{18,17,40,8},
-{18,17,48,8},
-{18,18,0,8},
-{18,18,20,36},
-{18,18,36,37},
-{18,18,44,39},
-{18,18,48,39},
-{18,19,0,40},
-{18,19,10,38},
-{18,19,20,38},
-{18,19,24,38},
-{18,19,36,37},
-{18,19,44,38},
-{18,19,48,38},
-{18,20,4,38},
-{18,20,8,9},
-{18,20,12,9},
-{18,20,24,9},
-{18,20,40,9},
-{18,20,52,9},
-{18,21,4,9},
-{18,21,8,10},
-{18,21,10,10},
-{18,21,20,9},
-{18,21,32,9},
-{18,21,40,9},
-{18,21,52,9},
-{18,22,4,10},
-{18,22,8,9},
-{18,22,16,9},
-{18,22,28,9},
-{18,22,36,8},
-{18,22,56,8},
-{18,23,8,8},
-{18,23,16,8},
-{18,23,28,8},
-{18,23,44,8},
-{19,0,0,8},
-{19,0,16,8},
-{19,0,32,8},
-{19,0,44,8},
-{19,0,56,8},
-{19,1,4,8},
-{19,1,16,8},
-{19,1,28,8},
-{19,1,44,8},
-{19,1,56,8},
-{19,2,4,8},
-{19,2,16,8},
-{19,2,28,8},
-{19,2,40,8},
-{19,2,52,8},
-{19,3,8,8},
-{19,3,24,8},
-{19,3,32,8},
-{19,3,44,8},
-{19,3,56,8},
-{19,4,8,8},
-{19,4,28,8},
-{19,4,44,8},
-{19,5,0,8},
-{19,5,16,8},
-{19,5,28,8},
-{19,5,36,12},
-{19,5,40,12},
-{19,5,52,12},
-{19,5,56,38},
-{19,6,4,39},
-{19,6,11,35},
-{19,6,12,34},
-{19,6,20,40},
-{19,6,28,21},
-{19,6,36,20},
-{19,6,48,22},
-{19,7,0,26},
-{19,7,4,40},
-{19,7,8,41},
-{19,7,14,38},
-{19,7,24,42},
-{19,7,28,53},
-{19,7,36,57},
-{19,7,44,50},
-{19,7,56,103},
-{19,8,0,142},
-{19,8,12,159},
-{19,8,20,179},
-{19,8,24,183},
-{19,8,36,176},
-{19,8,48,136},
-{19,8,52,134},
-{19,9,4,154},
-{19,9,8,174},
-{19,9,20,182},
-{19,9,24,178},
-{19,9,36,177},
-{19,9,40,175},
-{19,9,52,179},
-{19,10,4,180},
-{19,10,16,177},
-{19,10,20,178},
-{19,10,28,177},
-{19,10,36,173},
-{19,10,40,175},
-{19,10,52,176},
-{19,10,56,174},
-{19,11,0,175},
-{19,11,4,177},
-{19,11,12,177},
-{19,11,28,179},
-{19,11,36,177},
-{19,11,44,175},
-{19,12,0,101},
-{19,12,6,99},
-{19,12,16,140},
-{19,12,24,118},
-{19,12,32,104},
-{19,12,36,124},
-{19,12,48,176},
-{19,12,56,157},
-{19,13,0,153},
-{19,13,16,91},
-{19,13,26,133},
-{19,13,32,174},
-{19,13,44,116},
-{19,13,56,52},
-{19,14,0,54},
-{19,14,12,54},
-{19,14,20,36},
-{19,14,24,31},
-{19,14,28,37},
-{19,14,40,76},
-{19,14,44,86},
-{19,14,52,82},
-{19,15,8,43},
-{19,15,16,52},
-{19,15,20,61},
-{19,15,24,62},
-{19,15,36,39},
-{19,15,40,34},
-{19,15,56,24},
-{19,16,0,20},
-{19,16,12,15},
-{19,16,24,13},
-{19,16,28,14},
-{19,16,40,15},
-{19,16,48,11},
-{19,16,52,10},
-{19,16,56,9},
-{19,17,0,8},
-{19,17,12,8},
-{19,17,24,8},
-{19,17,36,8},
-{19,17,48,14},
-{19,18,0,16},
-{19,18,24,15},
-{19,18,40,15},
-{19,18,44,16},
-{19,18,45,16},
-{19,19,0,15},
-{19,19,12,15},
-{19,19,24,15},
-{19,19,36,15},
-{19,19,48,15},
-{19,19,56,16},
-{19,20,0,15},
-{19,20,8,20},
-{19,20,20,20},
-{19,20,36,20},
-{19,20,40,21},
-{19,20,48,20},
-{19,20,56,20},
-{19,21,8,20},
-{19,21,12,21},
-{19,21,20,8},
-{19,21,24,8},
-{19,21,40,8},
-{19,21,52,8},
-{19,22,0,9},
-{19,22,12,8},
-{19,22,24,8},
-{19,22,36,8},
-{19,22,48,8},
-{19,23,0,8},
-{19,23,16,8},
-{19,23,28,8},
-{19,23,48,8},
-{20,0,0,8},
-{20,0,20,8},
-{20,0,36,8},
-{20,0,44,8},
-{20,1,0,8},
-{20,1,16,8},
-{20,1,24,8},
-{20,1,40,8},
-{20,1,56,8},
-{20,2,8,8},
-{20,2,20,8},
-{20,2,28,8},
-{20,2,40,8},
-{20,2,52,8},
-{20,3,12,8},
-{20,3,24,8},
-{20,3,36,8},
-{20,3,44,8},
-{20,3,56,8},
-{20,4,8,8},
-{20,4,24,8},
-{20,4,40,8},
-{20,4,56,8},
-{20,5,12,8},
-{20,5,20,8},
-{20,5,28,8},
-{20,5,38,8},
-{20,5,48,8},
-{20,6,0,8},
-{20,6,28,9},
-{20,6,44,11},
-{20,6,52,13},
-{20,7,0,21},
-{20,7,12,25},
-{20,7,24,15},
-{20,7,28,16},
-{20,7,41,35},
-{20,7,44,39},
-{20,7,52,85},
-{20,8,4,115},
-{20,8,20,48},
-{20,8,32,70},
-{20,8,40,108},
-{20,8,44,131},
-{20,9,4,150},
-{20,9,20,182},
-{20,9,36,178},
-{20,9,44,184},
-{20,9,48,135},
-{20,10,4,152},
-{20,10,8,183},
-{20,10,16,142},
-{20,10,24,93},
-{20,10,28,130},
-{20,10,32,150},
-{20,10,40,183},
-{20,10,44,166},
-{20,10,56,181},
-{20,11,0,177},
-{20,11,12,183},
-{20,11,20,183},
-{20,11,32,149},
-{20,11,44,67},
-{20,11,52,112},
-{20,11,56,118},
-{20,12,8,156},
-{20,12,12,155},
-{20,12,20,140},
-{20,12,24,147},
-{20,12,36,181},
-{20,12,44,90},
-{20,12,48,99},
-{20,13,0,102},
-{20,13,4,100},
-{20,13,20,115},
-{20,13,24,66},
-{20,13,28,63},
-{20,13,32,54},
-{20,13,40,36},
-{20,13,44,39},
-{20,13,48,49},
-{20,13,52,62},
-{20,14,4,97},
-{20,14,8,106},
-{20,14,16,67},
-{20,14,20,55},
-{20,14,24,56},
-{20,14,36,61},
-{20,14,40,64},
-{20,14,44,62},
-{20,14,52,68},
-{20,14,56,63},
-{20,15,0,62},
-{20,15,10,42},
-{20,15,12,33},
-{20,15,20,15},
-{20,15,28,25},
-{20,15,32,27},
-{20,15,36,27},
-{20,15,40,22},
-{20,15,48,24},
-{20,15,56,25},
-{20,16,0,23},
-{20,16,12,22},
-{20,16,20,19},
-{20,16,24,18},
-{20,16,28,16},
-{20,16,40,14},
-{20,16,52,11},
-{20,17,0,9},
-{20,17,3,9},
-{20,17,16,8},
-{20,17,24,15},
-{20,17,28,15},
-{20,17,48,16},
-{20,18,4,16},
-{20,18,16,16},
-{20,18,28,16},
-{20,18,40,16},
-{20,18,56,16},
-{20,19,12,15},
-{20,19,16,16},
-{20,19,24,8},
-{20,19,36,8},
-{20,19,52,8},
-{20,20,4,8},
-{20,20,16,8},
-{20,20,20,16},
-{20,20,28,8},
-{20,20,36,8},
-{20,20,48,8},
-{20,21,0,8},
-{20,21,12,8},
-{20,21,24,8},
-{20,21,40,8},
-{20,21,52,8},
-{20,22,8,8},
-{20,22,24,8},
-{20,22,32,8},
-{20,22,56,8},
-{20,23,9,8},
-{20,23,20,8},
-{20,23,36,8},
-{21,0,0,7},
-{21,0,12,7},
-{21,0,28,7},
-{21,0,44,7},
-{21,0,52,7},
-{21,1,4,7},
-{21,1,16,7},
-{21,1,32,7},
-{21,1,48,7},
-{21,1,56,7},
-{21,2,12,7},
-{21,2,24,7},
-{21,2,40,7},
-{21,2,56,7},
-{21,3,4,7},
-{21,3,16,7},
-{21,3,24,7},
-{21,3,40,7},
-{21,3,48,7},
-{21,4,0,7},
-{21,4,16,7},
-{21,4,32,7},
-{21,4,44,7},
-{21,5,0,7},
-{21,5,16,7},
-{21,5,28,7},
-{21,5,40,7},
-{21,5,48,7},
-{21,6,0,7},
-{21,6,16,7},
-{21,6,20,8},
-{21,6,28,8},
-{21,6,36,8},
-{21,6,44,10},
-{21,6,56,12},
-{21,7,12,19},
-{21,7,16,18},
-{21,7,24,18},
-{21,7,28,20},
-{21,7,32,22},
-{21,7,36,26},
-{21,7,44,44},
-{21,7,52,49},
-{21,7,56,53},
-{21,8,14,61},
-{21,8,24,76},
-{21,8,28,85},
-{21,8,32,88},
-{21,8,48,179},
-{21,8,51,176},
-{21,8,56,180},
-{21,9,4,183},
-{21,9,16,185},
-{21,9,28,184},
-{21,9,36,177},
-{21,9,40,181},
-{21,9,52,182},
-{21,9,56,181},
-{21,10,4,182},
-{21,10,8,180},
-{21,10,20,161},
-{21,10,24,172},
-{21,10,32,179},
-{21,10,40,177},
-{21,10,44,179},
-{21,10,56,181},
-{21,11,4,182},
-{21,11,12,179},
-{21,11,20,157},
-{21,11,28,179},
-{21,11,36,183},
-{21,11,40,182},
-{21,11,44,181},
-{21,11,52,180},
-{21,11,56,179},
-{21,12,8,179},
-{21,12,24,180},
-{21,12,32,180},
-{21,12,44,176},
-{21,12,48,177},
-{21,13,0,178},
-{21,13,8,169},
-{21,13,16,176},
-{21,13,24,178},
-{21,13,28,175},
-{21,13,32,178},
-{21,13,40,179},
-{21,13,44,178},
-{21,13,56,144},
-{21,14,0,148},
-{21,14,8,174},
-{21,14,24,92},
-{21,14,28,52},
-{21,14,36,53},
-{21,14,48,46},
-{21,14,56,34},
-{21,15,0,32},
-{21,15,4,36},
-{21,15,8,38},
-{21,15,18,64},
-{21,15,28,75},
-{21,15,32,73},
-{21,15,48,35},
-{21,15,52,33},
-{21,15,56,28},
-{21,16,8,20},
-{21,16,10,19},
-{21,16,16,20},
-{21,16,28,11},
-{21,16,40,9},
-{21,16,48,9},
-{21,16,56,8},
-{21,17,0,9},
-{21,17,4,9},
-{21,17,20,9},
-{21,17,36,8},
-{21,17,44,8},
-{21,17,52,8},
-{21,18,8,8},
-{21,18,20,8},
-{21,18,32,9},
-{21,18,44,8},
-{21,18,48,8},
-{21,19,0,8},
-{21,19,8,13},
-{21,19,12,13},
-{21,19,16,14},
-{21,19,24,13},
-{21,19,28,13},
-{21,19,36,13},
-{21,19,40,14},
-{21,19,44,13},
-{21,19,56,14},
-{21,20,4,13},
-{21,20,16,10},
-{21,20,24,9},
-{21,20,36,9},
-{21,20,48,9},
-{21,21,0,8},
-{21,21,12,13},
-{21,21,20,14},
-{21,21,27,14},
-{21,21,40,14},
-{21,21,52,13},
-{21,21,56,13},
-{21,22,8,14},
-{21,22,12,13},
-{21,22,24,8},
-{21,22,28,8},
-{21,22,44,8},
-{21,22,56,8},
-{21,23,12,8},
-{21,23,28,8},
-{21,23,44,8},
-{22,0,0,8},
-{22,0,20,8},
-{22,0,28,8},
-{22,0,39,8},
-{22,0,56,8},
-{22,1,0,7},
-{22,1,3,8},
-{22,1,20,8},
-{22,1,32,8},
-{22,1,36,8},
-{22,1,47,7},
-{22,1,51,8},
-{22,2,0,8},
-{22,2,12,8},
-{22,2,27,8},
-{22,2,36,8},
-{22,2,44,7},
-{22,2,48,8},
-{22,2,52,8},
-{22,3,8,8},
-{22,3,16,8},
-{22,3,28,8},
-{22,3,40,8},
-{22,3,52,8},
-{22,4,3,8},
-{22,4,12,8},
-{22,4,28,8},
-{22,4,40,7},
-{22,4,44,7},
-{22,4,56,7},
-{22,5,8,8},
-{22,5,20,7},
-{22,5,28,7},
-{22,5,36,8},
-{22,5,44,7},
-{22,5,48,7},
-{22,6,0,7},
-{22,6,8,8},
-{22,6,12,8},
-{22,6,24,8},
-{22,6,36,10},
-{22,6,47,14},
-{22,6,48,15},
-{22,7,0,22},
-{22,7,12,36},
-{22,7,24,22},
-{22,7,28,27},
-{22,7,44,26},
-{22,7,56,26},
-{22,8,3,32},
-{22,8,12,31},
-{22,8,24,39},
-{22,8,28,48},
-{22,8,36,44},
-{22,8,48,173},
-{22,8,51,92},
-{22,9,4,185},
-{22,9,12,179},
-{22,9,15,170},
-{22,9,28,177},
-{22,9,32,178},
-{22,9,39,177},
-{22,9,52,181},
-{22,10,8,179},
-{22,10,12,181},
-{22,10,20,182},
-{22,10,32,181},
-{22,10,36,182},
-{22,10,48,183},
-{22,11,0,183},
-{22,11,3,184},
-{22,11,20,184},
-{22,11,32,183},
-{22,11,44,178},
-{22,12,0,181},
-{22,12,12,177},
-{22,12,28,177},
-{22,12,37,183},
-{22,12,47,174},
-{22,12,56,142},
-{22,13,4,175},
-{22,13,16,176},
-{22,13,20,155},
-{22,13,31,178},
-{22,13,35,177},
-{22,13,47,178},
-{22,13,52,176},
-{22,13,57,177},
-{22,14,4,175},
-{22,14,7,143},
-{22,14,16,128},
-{22,14,20,123},
-{22,14,31,132},
-{22,14,36,138},
-{22,14,40,152},
-{22,14,55,114},
-{22,14,57,108},
-{22,15,3,86},
-{22,15,11,56},
-{22,15,16,56},
-{22,15,35,63},
-{22,15,43,46},
-{22,15,48,40},
-{22,15,59,30},
-{22,16,4,27},
-{22,16,16,22},
-{22,16,20,21},
-{22,16,32,16},
-{22,16,35,15},
-{22,16,44,12},
-{22,16,51,10},
-{22,16,59,8},
-{22,17,4,8},
-{22,17,12,7},
-{22,17,23,7},
-{22,17,39,7},
-{22,17,51,7},
-{22,18,4,7},
-{22,18,19,7},
-{22,18,36,7},
-{22,18,48,7},
-{22,19,3,7},
-{22,19,20,7},
-{22,19,23,8},
-{22,19,28,7},
-{22,19,40,7},
-{22,19,56,7},
-{22,20,11,7},
-{22,20,28,7},
-{22,20,39,7},
-{22,20,59,7},
-{22,21,12,7},
-{22,21,27,7},
-{22,21,40,7},
-{22,21,51,7},
-{22,22,4,7},
-{22,22,19,7},
-{22,22,32,7},
-{22,22,44,7},
-{22,23,3,7},
-{22,23,12,7},
-{22,23,28,7},
-{22,23,36,7},
-{22,23,52,7},
-{23,0,4,7},
-{23,0,19,7},
-{23,0,28,7},
-{23,0,36,7},
-{23,0,51,7},
-{23,1,7,7},
-{23,1,15,7},
-{23,1,31,7},
-{23,1,47,7},
-{23,2,3,7},
-{23,2,20,7},
-{23,2,35,7},
-{23,2,44,7},
-{23,2,57,7},
-{23,3,8,7},
-{23,3,16,7},
-{23,3,31,7},
-{23,3,52,7},
-{23,4,4,7},
-{23,4,19,7},
-{23,4,40,7},
-{23,4,51,7},
-{23,5,3,7},
-{23,5,13,7},
-{23,5,28,7},
-{23,5,47,7},
-{23,5,59,7},
-{23,6,12,8},
-{23,6,23,10},
-{23,6,28,12},
-{23,6,35,17},
-{23,6,39,20},
-{23,6,43,24},
-{23,7,4,64},
-{23,7,12,72},
-{23,7,24,86},
-{23,7,28,123},
-{23,7,32,125},
-{23,7,39,176},
-{23,7,43,175},
-{23,7,52,183},
-{23,7,55,184},
-{23,8,0,186},
-{23,8,12,187},
-{23,8,20,187},
-{23,8,28,187},
-{23,8,35,187},
-{23,8,51,187},
-{23,8,59,187},
-{23,9,3,186},
-{23,9,15,187},
-{23,9,32,187},
-{23,9,35,185},
-{23,9,40,183},
-{23,9,55,186},
-{23,10,7,186},
-{23,10,19,185},
-{23,10,31,185},
-{23,10,43,184},
-{23,10,47,180},
-{23,10,51,181},
-{23,11,3,180},
-{23,11,15,180},
-{23,11,27,184},
-{23,11,31,177},
-{23,11,39,178},
-{23,11,48,180},
-{23,11,52,179},
-{23,11,55,171},
-{23,12,3,179},
-{23,12,15,177},
-{23,12,19,172},
-{23,12,23,179},
-{23,12,35,178},
-{23,12,39,173},
-{23,12,56,175},
-{23,12,59,183},
-{23,13,3,180},
-{23,13,23,178},
-{23,13,31,180},
-{23,13,35,180},
-{23,13,43,171},
-{23,13,52,106},
-{23,13,55,116},
-{23,14,7,88},
-{23,14,11,84},
-{23,14,19,120},
-{23,14,22,118},
-{23,14,31,131},
-{23,14,39,121},
-{23,14,43,101},
-{23,14,55,127},
-{23,14,59,111},
-{23,15,3,132},
-{23,15,15,77},
-{23,15,19,63},
-{23,15,27,60},
-{23,15,35,62},
-{23,15,39,53},
-{23,15,59,33},
-{23,16,7,30},
-{23,16,15,22},
-{23,16,31,12},
-{23,16,43,10},
-{23,16,47,9},
-{23,16,56,8},
-{23,17,11,7},
-{23,17,27,7},
-{23,17,39,7},
-{23,17,55,7},
-{23,18,15,7},
-{23,18,26,7},
-{23,18,39,7},
-{23,18,51,9},
-{23,18,59,8},
-{23,19,3,9},
-{23,19,24,9},
-{23,19,31,9},
-{23,19,43,9},
-{23,19,59,9},
-{23,20,19,9},
-{23,20,35,9},
-{23,20,43,9},
-{23,20,51,9},
-{23,21,3,9},
-{23,21,16,9},
-{23,21,32,9},
-{23,21,39,9},
-{23,21,55,9},
-{23,22,7,9},
-{23,22,23,9},
-{23,22,43,9},
-{23,22,55,9},
-{23,23,31,9},
-{23,23,43,9},
-{23,23,59,7},
-{24,0,7,7},
-{24,0,23,7},
-{24,0,38,7},
-{24,0,43,7},
-{24,0,59,7},
-{24,1,7,7},
-{24,1,23,7},
-{24,1,35,7},
-{24,1,51,7},
-{24,2,4,7},
-{24,2,12,7},
-{24,2,24,7},
-{24,2,35,7},
-{24,2,47,7},
-{24,2,59,7},
-{24,3,11,7},
-{24,3,19,7},
-{24,3,31,7},
-{24,3,43,7},
-{24,3,59,7},
-{24,4,15,7},
-{24,4,31,7},
-{24,4,51,7},
-{24,5,7,7},
-{24,5,19,7},
-{24,5,27,7},
-{24,5,39,7},
-{24,5,51,7},
-{24,6,3,7},
-{24,6,15,7},
-{24,6,31,7},
-{24,6,43,7},
-{24,6,51,8},
-{24,6,55,8},
-{24,7,11,9},
-{24,7,23,9},
-{24,7,27,10},
-{24,7,31,10},
-{24,7,47,11},
-{24,8,7,12},
-{24,8,15,14},
-{24,8,23,16},
-{24,8,35,17},
-{24,8,47,22},
-{24,8,51,24},
-{24,9,11,28},
-{24,9,27,43},
-{24,9,35,33},
-{24,9,39,47},
-{24,9,59,42},
-{24,10,11,45},
-{24,10,15,44},
-{24,10,23,44},
-{24,10,35,29},
-{24,10,39,28},
-{24,10,47,26},
-{24,10,55,25},
-{24,10,59,24},
-{24,11,19,20},
-{24,11,23,22},
-{24,11,31,25},
-{24,11,39,26},
-{24,11,43,26},
-{24,11,55,25},
-{24,12,3,25},
-{24,12,15,24},
-{24,12,19,27},
-{24,12,31,32},
-{24,12,35,36},
-{24,12,37,37},
-{24,12,39,38},
-{24,12,48,38},
-{24,12,51,36},
-{24,12,59,32},
-{24,13,7,33},
-{24,13,15,30},
-{24,13,19,31},
-{24,13,31,30},
-{24,13,39,25},
-{24,13,47,27},
-{24,13,55,25},
-{24,13,59,24},
-{24,14,18,27},
-{24,14,27,24},
-{24,14,31,20},
-{24,14,36,16},
-{24,14,43,15},
-{24,14,51,15},
-{24,15,3,16},
-{24,15,15,15},
-{24,15,23,15},
-{24,15,35,15},
-{24,15,43,14},
-{24,15,47,13},
-{24,16,3,11},
-{24,16,15,9},
-{24,16,23,9},
-{24,16,39,8},
-{24,16,53,8},
-{24,17,7,7},
-{24,17,23,7},
-{24,17,35,7},
-{24,17,47,7},
-{24,18,3,7},
-{24,18,21,7},
-{24,18,31,7},
-{24,18,47,7},
-{24,19,3,7},
-{24,19,19,7},
-{24,19,35,7},
-{24,19,47,7},
-{24,19,59,7},
-{24,20,13,7},
-{24,20,23,7},
-{24,20,35,7},
-{24,20,51,7},
-{24,21,7,7},
-{24,21,19,7},
-{24,21,35,7},
-{24,21,47,7},
-{24,21,59,7},
-{24,22,15,9},
-{24,22,27,9},
-{24,22,39,9},
-{24,22,51,9},
-{24,23,7,9},
-{24,23,19,9},
-{24,23,27,9},
-{24,23,43,9},
-{24,23,59,9},
-{25,0,15,9},
-{25,0,27,9},
-{25,0,39,9},
-{25,0,51,9},
-{25,1,3,9},
-{25,1,15,9},
-{25,1,31,9},
-{25,1,47,9},
-{25,1,59,9},
-{25,2,15,9},
-{25,2,27,9},
-{25,2,43,9},
-{25,2,55,9},
-{25,3,7,9},
-{25,3,23,9},
-{25,3,39,9},
-{25,3,55,9},
-{25,4,11,9},
-{25,4,19,9},
-{25,4,35,9},
-{25,4,47,9, occType::OCC_NONE, true, false},
-{ },
-    };
-static const ALDataSample samplea1b[] =
-    {
-{8,0,18,7, occType::OCC_NONE, true, false},
-{8,0,30,7},
-{8,0,42,7},
-{8,0,58,7},
-{8,1,10,7},
-{8,1,22,7},
-{8,1,38,7},
-{8,1,54,7},
-{8,2,10,7},
-{8,2,22,7},
-{8,2,30,7},
-{8,2,42,7},
-{8,2,50,7},
-{8,3,2,7},
-{8,3,10,7},
-{8,3,26,7},
-{8,3,42,7},
-{8,3,58,7},
-{8,4,14,7},
-{8,4,26,7},
-{8,4,38,7},
-{8,4,50,7},
-{8,5,6,7},
-{8,5,18,7},
-{8,5,34,7},
-{8,5,42,7},
-{8,5,50,7},
-{8,6,6,7},
-{8,6,14,8},
-{8,6,18,7},
-{8,6,22,7},
-{8,6,38,7},
-{8,6,42,8},
-{8,6,55,8},
-{8,6,58,10},
-{8,7,14,15},
-{8,7,26,24},
-{8,7,38,32},
-{8,7,53,42},
-{8,8,6,56},
-{8,8,22,174},
-{8,8,30,178},
-{8,8,38,179},
-{8,8,50,180},
-{8,9,2,181},
-{8,9,14,182},
-{8,9,30,182},
-{8,9,46,182},
-{8,10,2,181},
-{8,10,14,178},
-{8,10,22,170},
-{8,10,30,179},
-{8,10,42,151},
-{8,10,45,131},
-{8,10,48,118},
-{8,10,54,105},
-{8,11,6,93},
-{8,11,14,92},
-{8,11,18,88},
-{8,11,30,79},
-{8,11,34,74},
-{8,11,42,68},
-{8,11,50,64},
-{8,11,54,66},
-{8,12,6,65},
-{8,12,10,62},
-{8,12,26,84},
-{8,12,30,87},
-{8,12,38,86},
-{8,12,46,73},
-{8,12,50,71},
-{8,13,2,76},
-{8,13,14,72},
-{8,13,22,66},
-{8,13,26,68},
-{8,13,36,63},
-{8,13,38,64},
-{8,13,50,67},
-{8,13,54,70},
-{8,14,6,59},
-{8,14,14,50},
-{8,14,22,43},
-{8,14,26,39},
-{8,14,38,32},
-{8,14,42,33},
-{8,14,51,29},
-{8,14,54,29},
-{8,15,6,30},
-{8,15,10,30},
-{8,15,20,28},
-{8,15,22,28},
-{8,15,34,20},
-{8,15,42,17},
-{8,15,46,15},
-{8,15,57,13},
-{8,15,58,12},
-{8,16,18,8},
-{8,16,30,7},
-{8,16,46,7},
-{8,17,6,7},
-{8,17,14,7},
-{8,17,26,7},
-{8,17,38,14},
-{8,17,46,14},
-{8,17,58,15},
-{8,18,2,15},
-{8,18,18,15},
-{8,18,34,15},
-{8,18,50,15},
-{8,19,6,15},
-{8,19,26,15},
-{8,19,38,15},
-{8,19,46,15},
-{8,19,58,15},
-{8,20,2,15},
-{8,20,18,15},
-{8,20,22,14},
-{8,20,30,14},
-{8,20,42,14},
-{8,20,54,15},
-{8,21,14,16},
-{8,21,26,16},
-{8,21,38,16},
-{8,21,54,16},
-{8,22,10,9},
-{8,22,22,9},
-{8,22,34,9},
-{8,22,46,8},
-{8,22,58,9},
-{8,23,2,9},
-{8,23,14,9},
-{8,23,22,9},
-{8,23,38,9},
-{8,23,45,9},
-{8,23,50,8},
-{8,23,58,7},
-{9,0,10,7},
-{9,0,26,8},
-{9,0,34,8},
-{9,0,42,7},
-{9,0,46,8},
-{9,1,2,7},
-{9,1,18,7},
-{9,1,38,7},
-{9,1,54,7},
-{9,2,2,7},
-{9,2,18,7},
-{9,2,34,7},
-{9,2,50,7},
-{9,3,6,7},
-{9,3,14,7},
-{9,3,26,7},
-{9,3,34,7},
-{9,3,41,7},
-{9,3,50,7},
-{9,4,6,7},
-{9,4,22,7},
-{9,4,38,7},
-{9,4,46,7},
-{9,5,2,7},
-{9,5,18,7},
-{9,5,26,7},
-{9,5,38,7},
-{9,5,54,7},
-{9,6,6,7},
-{9,6,18,7},
-{9,6,34,7},
-{9,6,46,7},
-{9,6,54,12},
-{9,6,58,15},
-{9,7,18,26},
-{9,7,34,29},
-{9,7,46,29},
-{9,7,58,30},
-{9,8,6,23},
-{9,8,22,26},
-{9,8,33,33},
-{9,8,34,34},
-{9,8,46,33},
-{9,8,53,33},
-{9,8,58,36},
-{9,9,6,33},
-{9,9,17,44},
-{9,9,22,50},
-{9,9,34,33},
-{9,9,38,30},
-{9,9,46,31},
-{9,10,12,36},
-{9,10,21,39},
-{9,10,30,34},
-{9,10,36,47},
-{9,10,42,34},
-{9,10,50,40},
-{9,10,54,43},
-{9,11,5,100},
-{9,11,9,112},
-{9,11,25,79},
-{9,11,30,50},
-{9,11,42,48},
-{9,11,54,33},
-{9,11,58,34},
-{9,12,2,37},
-{9,12,13,58},
-{9,12,22,74},
-{9,12,26,89},
-{9,12,38,158},
-{9,12,46,137},
-{9,12,54,95},
-{9,13,2,171},
-{9,13,6,183},
-{9,13,18,125},
-{9,13,21,98},
-{9,13,34,134},
-{9,13,37,101},
-{9,13,49,49},
-{9,13,53,69},
-{9,14,1,101},
-{9,14,9,143},
-{9,14,13,140},
-{9,14,22,92},
-{9,14,30,63},
-{9,14,33,79},
-{9,14,38,60},
-{9,14,54,69},
-{9,14,58,80},
-{9,15,10,92},
-{9,15,14,87},
-{9,15,22,71},
-{9,15,34,31},
-{9,15,38,35},
-{9,15,45,31},
-{9,15,50,27},
-{9,15,54,25},
-{9,16,3,22},
-{9,16,6,20},
-{9,16,18,13},
-{9,16,30,9},
-{9,16,41,7},
-{9,16,58,7},
-{9,17,22,8},
-{9,17,29,8},
-{9,17,46,8},
-{9,17,58,8},
-{9,18,10,8},
-{9,18,33,16},
-{9,18,38,17},
-{9,18,46,18},
-{9,18,53,18},
-{9,19,6,17},
-{9,19,17,17},
-{9,19,29,17},
-{9,19,41,17},
-{9,19,53,17},
-{9,20,5,17},
-{9,20,13,17},
-{9,20,17,16},
-{9,20,25,16},
-{9,20,38,16},
-{9,20,54,17},
-{9,21,25,17},
-{9,21,38,8},
-{9,21,50,7},
-{9,22,2,7},
-{9,22,14,7},
-{9,22,25,7},
-{9,22,30,8},
-{9,22,34,8},
-{9,22,49,7},
-{9,23,2,8},
-{9,23,13,8},
-{9,23,30,8},
-{9,23,37,7},
-{9,23,50,7},
-{10,0,1,7},
-{10,0,18,7},
-{10,1,5,7},
-{10,1,22,7},
-{10,1,37,7},
-{10,1,53,7},
-{10,2,10,7},
-{10,2,18,7},
-{10,2,34,7},
-{10,2,49,7},
-{10,3,5,7},
-{10,3,17,7},
-{10,3,30,7},
-{10,3,38,7},
-{10,3,45,7},
-{10,3,58,7},
-{10,4,9,7},
-{10,4,26,7},
-{10,4,42,7},
-{10,4,57,7},
-{10,5,13,7},
-{10,5,21,7},
-{10,5,33,7},
-{10,5,46,7},
-{10,5,53,7},
-{10,6,2,7},
-{10,6,13,7},
-{10,6,29,7},
-{10,6,41,7},
-{10,6,53,15},
-{10,7,9,16},
-{10,7,22,18},
-{10,7,33,20},
-{10,7,37,21},
-{10,7,53,27},
-{10,7,57,30},
-{10,8,5,43},
-{10,8,18,66},
-{10,8,38,69},
-{10,8,41,111},
-{10,8,45,179},
-{10,9,1,176},
-{10,9,5,179},
-{10,9,17,181},
-{10,9,25,144},
-{10,9,30,132},
-{10,9,41,71},
-{10,9,46,68},
-{10,9,53,84},
-{10,10,10,91},
-{10,10,21,176},
-{10,10,25,180},
-{10,10,38,183},
-{10,10,49,182},
-{10,10,58,182},
-{10,11,4,181},
-{10,11,9,180},
-{10,11,13,180},
-{10,11,29,183},
-{10,11,38,182},
-{10,11,49,182},
-{10,12,1,183},
-{10,12,14,181},
-{10,12,18,179},
-{10,12,30,136},
-{10,12,33,141},
-{10,12,42,141},
-{10,12,45,114},
-{10,12,48,107},
-{10,12,57,110},
-{10,13,10,66},
-{10,13,14,60},
-{10,13,17,59},
-{10,13,26,58},
-{10,13,29,73},
-{10,13,42,56},
-{10,13,45,44},
-{10,13,53,39},
-{10,14,2,45},
-{10,14,5,45},
-{10,14,18,50},
-{10,14,25,84},
-{10,14,37,64},
-{10,14,41,61},
-{10,14,45,52},
-{10,14,49,41},
-{10,14,57,39},
-{10,15,2,41},
-{10,15,5,40},
-{10,15,17,36},
-{10,15,34,37},
-{10,15,41,46},
-{10,15,49,35},
-{10,15,54,29},
-{10,16,1,24},
-{10,16,6,22},
-{10,16,13,18},
-{10,16,21,13},
-{10,16,25,11},
-{10,16,42,8},
-{10,16,57,7},
-{10,17,14,7},
-{10,17,25,7},
-{10,17,37,7},
-{10,17,45,7},
-{10,17,53,7},
-{10,18,5,7},
-{10,18,21,7},
-{10,18,33,7},
-{10,18,49,7},
-{10,19,5,8},
-{10,19,26,8},
-{10,19,37,8},
-{10,19,53,8},
-{10,20,9,8},
-{10,20,25,8},
-{10,20,37,8},
-{10,20,49,8},
-{10,20,57,8},
-{10,21,5,8},
-{10,21,21,8},
-{10,21,29,8},
-{10,21,45,8},
-{10,22,1,8},
-{10,22,21,8},
-{10,22,37,8},
-{10,22,45,8},
-{10,23,5,8},
-{10,23,21,8},
-{10,23,33,8},
-{10,23,37,8},
-{10,23,50,8},
-{11,0,9,8},
-{11,0,21,8},
-{11,0,37,8},
-{11,0,49,8},
-{11,1,5,8},
-{11,1,21,8},
-{11,1,29,8},
-{11,1,41,8},
-{11,1,53,8},
-{11,2,0,8},
-{11,2,17,8},
-{11,2,29,8},
-{11,2,45,8},
-{11,2,53,8},
-{11,3,5,8},
-{11,3,17,8},
-{11,3,25,8},
-{11,3,41,8},
-{11,3,57,8},
-{11,4,9,8},
-{11,4,21,8},
-{11,4,29,8},
-{11,4,41,8},
-{11,4,53,8},
-{11,5,5,8},
-{11,5,21,8},
-{11,5,26,8},
-{11,5,38,8},
-{11,5,49,8},
-{11,6,5,8},
-{11,6,25,8},
-{11,6,33,8},
-{11,6,45,8},
-{11,7,1,10},
-{11,7,21,17},
-{11,7,37,20},
-{11,7,49,37},
-{11,7,53,51},
-{11,8,5,58},
-{11,8,17,66},
-{11,8,21,87},
-{11,8,33,184},
-{11,8,45,186},
-{11,8,53,187},
-{11,9,5,187},
-{11,9,17,187},
-{11,9,25,186},
-{11,9,29,186},
-{11,9,41,186},
-{11,9,53,186},
-{11,10,20,185},
-{11,10,33,185},
-{11,10,41,184},
-{11,10,49,184},
-{11,10,53,184},
-{11,10,57,183},
-{11,11,13,183},
-{11,11,27,183},
-{11,11,49,183},
-{11,12,5,183},
-{11,12,17,183},
-{11,12,25,182},
-{11,12,29,182},
-{11,12,37,183},
-{11,12,41,183},
-{11,12,45,184},
-{11,12,53,185},
-{11,13,1,185},
-{11,13,5,186},
-{11,13,9,185},
-{11,13,13,184},
-{11,13,25,181},
-{11,13,32,178},
-{11,13,37,176},
-{11,13,41,175},
-{11,13,53,157},
-{11,13,57,141},
-{11,14,9,102},
-{11,14,13,96},
-{11,14,25,76},
-{11,14,29,77},
-{11,14,41,61},
-{11,14,45,61},
-{11,14,49,62},
-{11,15,1,50},
-{11,15,9,59},
-{11,15,21,33},
-{11,15,29,27},
-{11,15,33,25},
-{11,15,41,22},
-{11,15,45,20},
-{ },
-    };
-static const ALDataSample samplea2[] =
-    {
-{15,3,2,3, occType::OCC_NONE, true, false},
-{15,5,18,3},
-{15,6,14,3},
-{15,6,18,4},
-{15,6,26,7},
-{15,9,18,174},
-{15,9,30,167},
-{15,9,45,176},
-{15,10,2,172},
-{15,10,14,57},
-{15,10,18,61},
-{15,10,26,146},
-{15,10,42,171},
-{15,10,50,133},
-{15,12,22,179},
-{15,13,5,175},
-{15,14,38,173},
-{15,15,14,173},
-{15,16,42,9},
-{15,16,54,4},
-{15,17,25,3},
-{15,17,54,3},
-{15,18,14,3},
-{15,18,34,2},
-{15,18,50,3},
-{15,19,1,3},
-{15,19,30,3},
-{15,19,45,2},
-{15,19,55,3},
-{15,20,6,3},
-{15,20,17,3},
-{15,20,34,3},
-{15,20,46,3},
-{15,21,1,3},
-{15,21,12,3},
-{15,21,18,2},
-{15,21,22,3},
-{15,21,33,3},
-{15,21,46,3},
-{15,22,6,4},
-{15,22,14,4},
-{15,22,22,5},
-{15,22,26,4},
-{15,22,30,6},
-{15,22,46,4},
-{15,22,54,4},
-{15,23,5,5},
-{15,23,17,4},
-{15,23,21,5},
-{15,23,28,4},
-{15,23,41,4},
-{15,23,50,4},
-{16,0,2,4},
-{16,0,5,4},
-{16,0,14,4},
-{16,0,18,6},
-{16,0,54,6},
-{16,0,57,4},
-{16,1,2,6},
-{16,1,14,4},
-{16,1,18,4},
-{16,1,29,4},
-{16,2,1,6},
-{16,2,2,5},
-{16,2,14,5},
-{16,3,54,4},
-{16,3,58,4},
-{16,4,1,6},
-{16,4,10,6},
-{16,4,22,4},
-{16,4,30,6},
-{16,8,21,33},
-{16,8,57,29},
-{16,9,6,40},
-{16,9,21,69},
-{16,9,46,73},
-{16,9,49,101},
-{16,10,5,159},
-{16,10,9,167},
-{16,10,25,167},
-{16,10,50,175},
-{16,10,53,168},
-{16,10,58,170},
-{16,11,21,176},
-{16,11,25,176},
-{16,11,58,177},
-{16,12,2,179},
-{16,12,5,180},
-{16,12,9,179},
-{16,12,17,180},
-{16,12,21,179},
-{16,12,37,180},
-{16,12,45,179},
-{16,12,50,176},
-{16,13,1,179},
-{16,18,37,97},
-{16,18,49,101},
-{16,19,29,3},
-{16,19,41,3},
-{16,19,57,3},
-{16,20,5,3},
-{16,20,25,98},
-{16,20,53,3},
-{16,21,13,3},
-{16,21,25,3},
-{16,21,34,3},
-{16,21,50,3},
-{17,0,17,3},
-{17,2,1,3},
-{17,2,33,3},
-{17,2,49,3},
-{17,3,5,3},
-{17,3,21,3},
-{17,3,29,3},
-{17,3,49,3},
-{17,4,13,3},
-{17,5,3,3},
-{17,5,9,3},
-{17,6,33,108},
-{17,6,45,131},
-{17,7,1,58},
-{17,7,29,123},
-{17,8,1,102},
-{17,8,5,108},
-{17,8,17,108},
-{17,8,37,140},
-{17,8,49,125},
-{17,8,53,123},
-{17,9,5,174},
-{17,9,17,111},
-{17,9,28,140},
-{17,9,29,145},
-{17,9,37,151},
-{17,9,45,156},
-{17,9,49,159},
-{17,10,5,171},
-{17,10,17,173},
-{17,10,25,169},
-{17,10,29,175},
-{17,10,45,167},
-{17,10,49,169},
-{17,11,1,177},
-{17,11,13,176},
-{17,11,25,177},
-{17,11,37,156},
-{17,11,49,175},
-{17,12,5,177},
-{17,12,9,179},
-{17,12,21,179},
-{17,12,32,170},
-{17,12,51,179},
-{17,13,1,180},
-{17,13,9,178},
-{17,13,25,179},
-{17,13,29,180},
-{17,13,33,177},
-{17,13,41,171},
-{17,13,53,178},
-{17,13,57,179},
-{17,14,9,173},
-{17,14,13,176},
-{17,14,21,179},
-{17,14,33,176},
-{17,14,37,171},
-{17,15,25,180},
-{17,15,33,121},
-{17,15,42,104},
-{17,15,45,79},
-{17,16,1,22},
-{17,16,29,30},
-{17,16,41,18},
-{17,16,49,10},
-{17,17,5,4},
-{17,17,33,3},
-{17,17,45,3},
-{17,17,57,3},
-{17,18,17,3},
-{17,18,53,3},
-{17,20,5,3},
-{17,20,37,3},
-{17,20,54,3},
-{17,21,9,3},
-{17,21,29,3},
-{17,21,41,3},
-{17,21,53,3},
-{17,22,5,3},
-{17,22,17,3},
-{17,22,33,3},
-{17,22,53,3},
-{17,23,9,3},
-{17,23,21,3},
-{17,23,37,3},
-{17,23,41,3},
-{17,23,53,3},
-{18,0,5,3},
-{18,0,21,3},
-{18,0,33,3},
-{18,0,41,3},
-{18,0,47,3},
-{18,0,53,3},
-{18,1,9,3},
-{18,1,25,3},
-{18,1,37,3},
-{18,1,49,3},
-{18,2,9,3},
-{18,2,21,3},
-{18,2,33,3},
-{18,2,49,3},
-{18,3,1,3},
-{18,3,17,3},
-{18,3,25,3},
-{18,3,29,3},
-{18,3,45,3},
-{18,3,57,3},
-{18,4,9,2},
-{18,4,17,3},
-{18,4,29,2},
-{18,4,33,3},
-{18,4,49,3},
-{18,4,53,2},
-{18,5,1,2},
-{18,5,5,3},
-{18,5,9,2},
-{18,5,21,3},
-{18,5,26,2},
-{18,5,44,2},
-{18,5,57,95},
-{18,6,1,100},
-{18,6,13,93},
-{18,6,29,5},
-{18,6,45,7},
-{18,7,5,16},
-{18,7,13,23},
-{18,7,25,35},
-{18,7,37,48},
-{18,7,41,60},
-{18,7,56,64},
-{18,8,25,47},
-{18,8,45,122},
-{18,8,53,99},
-{18,9,9,150},
-{18,9,25,141},
-{18,9,57,114},
-{18,10,9,110},
-{18,10,12,142},
-{18,10,17,173},
-{18,10,25,171},
-{18,10,33,171},
-{18,10,49,155},
-{18,10,53,163},
-{18,10,57,179},
-{18,11,13,174},
-{18,11,17,140},
-{18,11,25,153},
-{18,11,33,142},
-{18,12,5,176},
-{18,12,25,178},
-{18,12,29,177},
-{18,12,57,172},
-{18,13,1,172},
-{18,13,37,177},
-{18,13,53,151},
-{18,14,17,175},
-{18,14,25,178},
-{18,14,34,179},
-{18,14,53,102},
-{18,15,9,176},
-{18,15,17,179},
-{18,15,49,179},
-{18,16,21,48},
-{18,16,41,30},
-{18,17,25,3},
-{18,17,41,2},
-{18,17,53,3},
-{18,18,5,3},
-{18,18,21,3},
-{18,18,35,3},
-{18,18,49,3},
-{18,19,1,3},
-{18,19,13,3},
-{18,19,25,3},
-{18,19,45,3},
-{18,19,57,3},
-{18,20,13,3},
-{18,20,26,3},
-{18,20,57,3},
-{18,21,27,3},
-{18,21,36,3},
-{18,21,49,3},
-{18,22,9,3},
-{18,22,21,3},
-{18,22,33,3},
-{18,22,49,3},
-{18,23,4,3},
-{18,23,17,3},
-{18,23,33,3},
-{18,23,37,3},
-{18,23,53,3},
-{19,0,1,3},
-{19,0,17,3},
-{19,0,25,3},
-{19,0,41,3},
-{19,0,53,3},
-{19,1,21,2},
-{19,1,37,2},
-{19,1,53,2},
-{19,2,1,2},
-{19,2,29,2},
-{19,2,37,2},
-{19,2,49,2},
-{19,3,1,2},
-{19,3,13,2},
-{19,3,25,2},
-{19,3,37,2},
-{19,3,45,2},
-{19,3,57,2},
-{19,4,9,2},
-{19,4,21,2},
-{19,4,41,2},
-{19,4,49,2},
-{19,5,5,2},
-{19,5,17,2},
-{19,5,21,3},
-{19,5,25,2},
-{19,5,41,3},
-{19,5,49,3},
-{19,6,49,110},
-{19,7,49,78},
-{19,7,57,79},
-{19,8,5,98},
-{19,8,9,96},
-{19,8,21,111},
-{19,8,25,127},
-{19,8,29,129},
-{19,8,45,140},
-{19,8,49,146},
-{19,9,1,116},
-{19,9,5,126},
-{19,9,13,147},
-{19,9,20,173},
-{19,9,25,172},
-{19,9,33,174},
-{19,9,49,176},
-{19,10,5,177},
-{19,10,17,177},
-{19,10,25,177},
-{19,10,29,177},
-{19,10,45,177},
-{19,10,53,177},
-{19,11,5,178},
-{19,11,25,179},
-{19,11,33,179},
-{19,11,45,177},
-{19,11,53,162},
-{19,12,1,144},
-{19,12,5,163},
-{19,12,13,175},
-{19,12,29,168},
-{19,12,45,178},
-{19,12,53,176},
-{19,12,57,176},
-{19,13,1,162},
-{19,13,9,140},
-{19,13,13,157},
-{19,13,17,172},
-{19,13,25,176},
-{19,13,29,178},
-{19,13,49,129},
-{19,13,50,120},
-{19,14,1,86},
-{19,14,5,101},
-{19,14,9,78},
-{19,14,17,47},
-{19,14,25,68},
-{19,14,29,98},
-{19,14,49,175},
-{19,15,1,76},
-{19,15,29,84},
-{19,16,37,21},
-{19,16,57,5},
-{19,18,57,3},
-{19,19,57,3},
-{19,20,17,3},
-{19,22,17,3},
-{20,7,41,72},
-{20,8,9,135},
-{20,8,21,93},
-{20,8,29,105},
-{20,9,6,161},
-{20,9,9,156},
-{20,9,15,159},
-{20,9,17,170},
-{20,10,9,169},
-{20,10,17,175},
-{20,10,25,151},
-{20,18,29,3},
-{20,18,45,3},
-{20,19,29,3},
-{20,20,13,106},
-{20,20,25,3},
-{20,21,5,3},
-{20,21,21,3},
-{20,21,37,3},
-{20,22,25,3},
-{20,22,41,3},
-{20,22,59,103},
-{20,23,9,106},
-{20,23,25,3},
-{20,23,41,3},
-{20,23,57,3},
-{21,0,5,3},
-{21,0,21,3},
-{21,0,37,3},
-{21,0,53,2},
-{21,1,9,2},
-{21,1,29,2},
-{21,1,37,2},
-{21,2,41,2},
-{21,2,53,2},
-{21,3,5,2},
-{21,3,17,2},
-{21,3,23,2},
-{21,3,37,2},
-{21,3,49,2},
-{21,4,5,2},
-{21,4,13,2},
-{21,4,29,2},
-{21,4,41,2},
-{21,4,53,2},
-{21,5,1,2},
-{21,5,5,3},
-{21,5,13,3},
-{21,5,25,3},
-{21,5,33,3},
-{21,5,45,2},
-{21,6,1,3},
-{21,6,13,3},
-{21,6,41,8},
-{21,6,45,9},
-{21,7,21,22},
-{21,9,57,178},
-{21,10,1,178},
-{21,10,13,176},
-{21,10,21,174},
-{21,10,37,179},
-{21,10,49,179},
-{21,12,45,177},
-{21,12,53,179},
-{21,13,1,179},
-{21,14,9,180},
-{21,14,13,180},
-{21,14,17,179},
-{21,15,33,116},
-{21,15,45,70},
-{21,15,57,52},
-{21,16,33,6},
-{21,17,1,3},
-{21,20,17,3},
-{22,1,29,2},
-{22,2,1,2},
-{22,2,9,2},
-{22,2,21,2},
-{22,3,29,2},
-{22,4,29,3},
-{22,4,41,3},
-{22,5,5,2},
-{22,5,17,3},
-{22,5,21,2},
-{22,5,49,2},
-{22,5,53,3},
-{22,6,25,4},
-{22,6,37,10},
-{22,6,53,25},
-{22,7,1,33},
-{22,7,13,45},
-{22,7,17,49},
-{22,7,33,62},
-{22,7,45,65},
-{22,7,53,74},
-{22,8,1,89},
-{22,8,5,90},
-{22,8,17,108},
-{22,8,33,159},
-{22,8,37,144},
-{22,9,17,72},
-{22,9,29,168},
-{22,9,37,173},
-{22,9,41,171},
-{22,9,53,176},
-{22,10,1,176},
-{22,10,17,177},
-{22,10,21,178},
-{22,10,29,178},
-{22,10,41,177},
-{22,10,49,178},
-{22,11,1,176},
-{22,11,5,177},
-{22,11,45,140},
-{22,11,49,134},
-{22,11,53,172},
-{22,12,5,176},
-{22,12,9,174},
-{22,12,13,165},
-{22,12,21,134},
-{22,12,25,143},
-{22,12,41,177},
-{22,12,45,148},
-{22,12,57,171},
-{22,13,1,169},
-{22,13,5,175},
-{22,13,17,140},
-{22,13,21,131},
-{22,13,33,147},
-{22,13,36,154},
-{22,13,37,165},
-{22,13,41,163},
-{22,13,49,169},
-{22,13,57,165},
-{22,14,3,175},
-{22,14,9,177},
-{22,14,13,174},
-{22,14,21,140},
-{22,14,41,176},
-{22,14,49,122},
-{22,14,57,81},
-{22,15,5,50},
-{22,15,9,48},
-{22,15,10,49},
-{22,15,17,55},
-{22,15,41,73},
-{22,15,49,43},
-{22,15,53,39},
-{22,15,57,38},
-{22,16,9,34},
-{22,16,13,30},
-{22,16,21,21},
-{22,16,33,14},
-{22,16,37,12},
-{22,16,41,10},
-{22,16,45,8},
-{22,16,53,6},
-{22,16,55,5},
-{22,17,5,3},
-{22,17,9,3},
-{22,17,25,2},
-{22,17,33,2},
-{22,17,45,2},
-{22,17,57,2},
-{22,18,9,3},
-{22,18,25,3},
-{22,18,45,3},
-{22,18,57,3},
-{22,19,9,3},
-{22,19,17,3},
-{22,19,25,3},
-{22,19,37,3},
-{22,19,49,3},
-{22,20,1,3},
-{22,20,13,3},
-{22,20,29,3},
-{22,20,41,3},
-{22,20,53,3},
-{22,21,13,3},
-{22,21,25,3},
-{22,21,41,3},
-{22,21,52,3},
-{22,22,5,3},
-{22,22,21,3},
-{22,22,29,3},
-{22,22,45,3},
-{22,23,9,3},
-{22,23,25,3},
-{22,23,37,3},
-{22,23,56,3},
-{23,0,1,2},
-{23,0,9,2},
-{23,0,25,2},
-{23,0,37,2},
-{23,0,45,2},
-{23,1,16,2},
-{23,1,29,2},
-{23,1,41,2},
-{23,1,53,2},
-{23,2,5,2},
-{23,2,21,2},
-{23,2,37,2},
-{23,2,53,2},
-{23,3,9,3},
-{23,3,29,3},
-{23,3,41,3},
-{23,3,45,2},
-{23,3,50,3},
-{23,4,1,3},
-{23,4,13,2},
-{23,4,21,3},
-{23,4,29,2},
-{23,4,45,3},
-{23,4,49,3},
-{23,5,1,3},
-{23,5,9,2},
-{23,5,13,2},
-{23,5,21,2},
-{23,5,37,2},
-{23,5,49,2},
-{23,6,1,3},
-{23,6,13,3},
-{23,6,21,3},
-{23,6,37,8},
-{23,6,41,10},
-{23,6,49,15},
-{23,6,57,20},
-{23,7,11,30},
-{23,7,13,32},
-{23,7,33,49},
-{23,7,37,52},
-{23,7,45,61},
-{23,7,49,70},
-{23,8,5,70},
-{23,8,25,83},
-{23,8,41,98},
-{23,8,53,106},
-{23,8,57,108},
-{23,9,5,104},
-{23,9,13,107},
-{23,9,17,108},
-{23,9,21,111},
-{23,9,29,112},
-{23,9,33,113},
-{23,9,37,120},
-{23,9,45,142},
-{23,9,51,140},
-{23,9,57,114},
-{23,10,1,116},
-{23,10,13,114},
-{23,10,17,116},
-{23,10,29,126},
-{23,10,41,155},
-{23,10,45,171},
-{23,10,57,135},
-{23,11,9,163},
-{23,11,17,174},
-{23,11,21,173},
-{23,11,25,147},
-{23,11,37,157},
-{23,11,41,165},
-{23,11,49,176},
-{23,11,57,147},
-{23,12,1,145},
-{23,12,5,139},
-{23,12,17,129},
-{23,12,21,135},
-{23,12,25,149},
-{23,12,29,175},
-{23,12,45,171},
-{23,12,53,177},
-{23,13,5,178},
-{23,13,17,176},
-{23,13,21,172},
-{23,13,25,151},
-{23,13,33,138},
-{23,13,37,174},
-{23,13,41,167},
-{23,13,49,140},
-{23,13,57,143},
-{23,14,1,144},
-{23,14,13,114},
-{23,14,17,108},
-{23,14,29,171},
-{23,14,37,151},
-{23,14,48,87},
-{23,14,53,92},
-{23,14,57,118},
-{23,15,1,146},
-{23,15,9,123},
-{23,15,13,107},
-{23,15,17,116},
-{23,15,25,122},
-{23,15,37,83},
-{23,15,41,70},
-{23,15,45,65},
-{23,16,1,38},
-{23,16,5,24},
-{23,16,17,28},
-{23,16,20,23},
-{23,16,37,10},
-{23,16,40,8},
-{23,16,53,4},
-{23,17,5,3},
-{23,17,17,3},
-{23,17,20,2},
-{23,17,29,2},
-{23,17,36,2},
-{23,17,53,3},
-{23,18,8,3},
-{23,18,25,3},
-{23,18,32,3},
-{23,18,49,5},
-{23,18,52,4},
-{23,19,5,5},
-{23,19,17,5},
-{23,19,21,5},
-{23,19,29,4},
-{23,19,41,6},
-{23,20,1,5},
-{23,20,9,4},
-{23,20,33,6},
-{23,20,37,4},
-{23,20,53,6},
-{23,21,5,5},
-{23,21,17,4},
-{23,21,29,6},
-{23,21,45,4},
-{23,21,57,5},
-{23,22,1,6},
-{23,22,5,4},
-{23,22,18,4},
-{23,22,21,6},
-{23,22,24,4},
-{23,22,32,6},
-{23,22,41,4},
-{23,22,53,4},
-{23,23,13,5},
-{23,23,24,6},
-{23,23,33,6},
-{23,23,48,4},
-{23,23,57,5},
-{24,0,1,5},
-{24,0,13,6},
-{24,0,21,6},
-{24,0,25,5},
-{24,0,41,6},
-{24,0,45,5},
-{24,0,57,6},
-{24,1,9,5},
-{24,1,13,4},
-{24,1,25,5},
-{24,1,29,4},
-{24,1,57,4},
-{24,2,5,6},
-{24,2,9,5},
-{24,2,16,4},
-{24,2,20,5},
-{24,2,25,4},
-{24,2,37,5},
-{24,2,45,4},
-{24,2,52,5},
-{24,3,5,6},
-{24,3,9,5},
-{24,3,21,4},
-{24,3,32,5},
-{24,3,37,3},
-{24,3,44,5},
-{24,4,1,6},
-{24,4,9,5},
-{24,4,13,3},
-{24,4,21,4},
-{24,4,29,4},
-{24,4,33,5},
-{24,4,41,5},
-{24,4,55,5},
-{24,5,5,5},
-{24,5,9,3},
-{24,5,29,5},
-{24,5,41,5},
-{24,5,45,6},
-{24,5,53,3},
-{24,6,5,4},
-{24,6,17,5},
-{24,6,20,4},
-{24,6,32,5},
-{24,6,37,6},
-{24,6,52,5},
-{24,6,57,7},
-{24,7,4,10},
-{24,7,17,11},
-{24,7,19,12},
-{24,7,21,14},
-{24,7,32,17},
-{24,7,45,18},
-{24,7,57,25},
-{24,8,27,65},
-{24,8,45,85},
-{24,8,56,115},
-{24,9,13,94},
-{24,9,21,98},
-{24,9,25,108},
-{24,9,37,106},
-{24,9,45,138},
-{24,9,52,145},
-{24,10,1,155},
-{24,10,4,150},
-{24,10,21,175},
-{24,10,25,172},
-{24,10,29,153},
-{24,10,37,120},
-{24,10,56,121},
-{24,11,9,97},
-{24,11,17,68},
-{24,11,24,84},
-{24,11,28,102},
-{24,11,45,110},
-{24,12,0,113},
-{24,12,5,112},
-{24,12,13,112},
-{24,12,19,118},
-{24,12,25,135},
-{24,12,28,141},
-{24,12,38,163},
-{24,12,40,160},
-{24,12,44,153},
-{24,12,56,122},
-{24,13,5,131},
-{24,13,17,129},
-{24,13,24,142},
-{24,13,37,107},
-{24,13,41,107},
-{24,13,44,115},
-{24,13,57,111},
-{24,14,5,105},
-{24,14,8,105},
-{24,14,13,114},
-{24,14,21,128},
-{24,14,25,121},
-{24,14,29,92},
-{24,14,33,68},
-{24,14,37,58},
-{24,14,41,53},
-{24,14,44,50},
-{24,14,56,46},
-{24,15,5,44},
-{24,15,12,42},
-{24,15,16,40},
-{24,15,20,41},
-{24,15,26,46},
-{24,15,37,44},
-{24,15,44,37},
-{24,15,57,28},
-{24,16,1,26},
-{24,16,13,17},
-{24,16,28,12},
-{24,16,40,7},
-{24,16,49,5},
-{24,16,57,4},
-{24,17,4,3},
-{24,17,8,3},
-{24,17,24,2},
-{24,17,48,2},
-{24,18,5,2},
-{24,18,12,2},
-{24,18,17,3},
-{24,18,20,3},
-{24,18,36,2},
-{24,18,45,2},
-{24,19,0,2},
-{24,19,13,2},
-{24,19,24,2},
-{24,19,34,2},
-{24,19,40,2},
-{24,19,48,2},
-{24,20,5,2},
-{24,20,17,2},
-{24,20,29,2},
-{24,20,45,2},
-{24,20,57,2},
-{24,21,9,2},
-{24,21,21,2},
-{24,21,32,3},
-{24,21,37,2},
-{24,21,44,2},
-{24,21,57,2},
-{24,22,4,4},
-{24,22,8,4},
-{24,22,24,4},
-{24,22,29,4},
-{24,22,44,4},
-{24,22,56,4},
-{24,23,3,5},
-{24,23,12,6},
-{24,23,20,4},
-{24,23,32,4},
-{24,23,41,4},
-{24,23,45,5},
-{25,0,1,4},
-{25,0,4,5},
-{25,0,16,4},
-{25,0,32,4},
-{25,0,45,5},
-{25,1,0,5},
-{25,1,17,4},
-{25,1,24,4},
-{25,1,36,5},
-{25,1,44,4},
-{25,1,56,6},
-{25,2,0,5},
-{25,2,12,4},
-{25,2,25,6},
-{25,2,32,5},
-{25,2,37,4},
-{25,2,41,4},
-{25,2,56,5},
-{25,3,8,5},
-{25,3,12,5},
-{25,3,24,5},
-{25,3,29,5},
-{25,3,41,5},
-{25,3,52,5},
-{25,3,56,6},
-{25,4,5,4},
-{25,4,12,4},
-{25,4,25,5},
-{25,4,28,4},
-{25,4,41,4},
-{25,4,44,6},
-{25,4,52,5, occType::OCC_NONE, true, false},
-{ },
-    };
-static const ALDataSample samplea2b[] =
-    {
-{8,0,7,2, occType::OCC_NONE, true, false},
-{8,0,19,2},
-{8,0,35,2},
-{8,0,47,2},
-{8,1,3,2},
-{8,1,11,3},
-{8,1,15,2},
-{8,1,19,2},
-{8,1,35,2},
-{8,1,47,2},
-{8,1,59,2},
-{8,2,11,2},
-{8,2,23,2},
-{8,2,39,2},
-{8,2,51,2},
-{8,3,3,2},
-{8,3,19,2},
-{8,3,35,2},
-{8,3,51,2},
-{8,4,3,2},
-{8,4,19,2},
-{8,4,27,2},
-{8,4,43,2},
-{8,4,59,2},
-{8,5,15,2},
-{8,5,23,2},
-{8,5,35,2},
-{8,5,51,2},
-{8,6,7,2},
-{8,6,23,2},
-{8,6,39,3},
-{8,6,55,4},
-{8,6,59,5},
-{8,7,3,7},
-{8,7,19,18},
-{8,7,31,29},
-{8,7,35,31},
-{8,7,47,40},
-{8,8,3,52},
-{8,8,19,59},
-{8,8,35,70},
-{8,8,47,85},
-{8,8,59,79},
-{8,9,11,86},
-{8,9,15,88},
-{8,9,31,96},
-{8,9,35,98},
-{8,9,47,112},
-{8,9,51,116},
-{8,10,3,132},
-{8,10,7,137},
-{8,10,23,162},
-{8,10,31,159},
-{8,10,35,159},
-{8,10,44,156},
-{8,10,47,158},
-{8,10,59,151},
-{8,11,3,153},
-{8,11,15,158},
-{8,11,31,157},
-{8,11,35,154},
-{8,11,43,156},
-{8,11,51,152},
-{8,11,55,152},
-{8,12,15,174},
-{8,12,31,160},
-{8,12,39,155},
-{8,12,47,142},
-{8,12,59,153},
-{8,13,3,154},
-{8,13,11,150},
-{8,13,19,142},
-{8,13,21,140},
-{8,13,31,129},
-{8,13,35,136},
-{8,13,47,135},
-{8,13,51,141},
-{8,14,3,135},
-{8,14,11,103},
-{8,14,15,86},
-{8,14,35,72},
-{8,14,47,69},
-{8,14,51,72},
-{8,14,59,65},
-{8,15,7,72},
-{8,15,11,68},
-{8,15,28,40},
-{8,15,31,36},
-{8,15,43,27},
-{8,15,47,25},
-{8,15,55,18},
-{8,16,3,10},
-{8,16,7,8},
-{8,16,19,4},
-{8,16,23,4},
-{8,16,39,3},
-{8,16,51,2},
-{8,16,55,3},
-{8,17,7,3},
-{8,17,31,88},
-{8,17,39,3},
-{8,17,55,3},
-{8,18,11,2},
-{8,18,21,2},
-{8,18,39,3},
-{8,18,53,3},
-{8,19,3,3},
-{8,19,14,3},
-{8,19,23,3},
-{8,19,31,2},
-{8,19,43,2},
-{8,19,59,2},
-{8,20,15,3},
-{8,20,23,3},
-{8,20,39,3},
-{8,20,47,3},
-{8,20,55,3},
-{8,21,11,3},
-{8,21,27,3},
-{8,21,47,3},
-{8,22,3,3},
-{8,22,11,3},
-{8,22,19,3},
-{8,22,35,3},
-{8,22,43,3},
-{8,22,55,3},
-{8,23,7,3},
-{8,23,19,3},
-{8,23,35,3},
-{8,23,51,3},
-{8,23,59,3},
-{9,0,11,3},
-{9,0,23,2},
-{9,0,35,2},
-{9,0,51,2},
-{9,1,7,2},
-{9,1,19,3},
-{9,1,35,3},
-{9,1,47,3},
-{9,1,51,2},
-{9,2,3,2},
-{9,2,19,2},
-{9,2,31,3},
-{9,2,35,2},
-{9,2,51,2},
-{9,2,59,2},
-{9,3,19,2},
-{9,3,31,2},
-{9,3,43,2},
-{9,3,55,2},
-{9,4,3,2},
-{9,4,15,2},
-{9,4,27,2},
-{9,4,39,2},
-{9,4,51,2},
-{9,5,7,2},
-{9,5,15,2},
-{9,5,31,2},
-{9,5,39,2},
-{9,5,50,2},
-{9,5,55,2},
-{9,6,11,2},
-{9,6,27,2},
-{9,6,39,2},
-{9,6,48,3},
-{9,6,51,2},
-{9,6,59,3},
-{9,7,11,79},
-{9,7,15,83},
-{9,7,27,87},
-{9,7,39,87},
-{9,7,51,87},
-{9,8,3,87},
-{9,8,11,87},
-{9,8,15,94},
-{9,8,23,11},
-{9,8,35,22},
-{9,8,39,24},
-{9,8,47,24},
-{9,9,3,30},
-{9,9,15,37},
-{9,9,19,43},
-{9,9,31,32},
-{9,9,43,31},
-{9,9,51,38},
-{9,9,55,49},
-{9,10,3,53},
-{9,10,7,63},
-{9,10,23,39},
-{9,10,27,37},
-{9,10,35,47},
-{9,10,47,43},
-{9,10,51,46},
-{9,11,3,102},
-{9,11,11,135},
-{9,11,15,173},
-{9,11,27,58},
-{9,11,31,48},
-{9,11,39,61},
-{9,11,51,36},
-{9,11,55,33},
-{9,12,3,46},
-{9,12,11,61},
-{9,12,15,79},
-{9,12,23,101},
-{9,12,27,116},
-{9,12,43,172},
-{9,12,47,107},
-{9,12,51,94},
-{9,13,7,153},
-{9,13,11,141},
-{9,13,19,86},
-{9,13,23,108},
-{9,13,31,162},
-{9,13,43,52},
-{9,13,51,62},
-{9,13,54,99},
-{9,14,7,121},
-{9,14,11,129},
-{9,14,19,126},
-{9,14,27,71},
-{9,14,31,86},
-{9,14,43,54},
-{9,14,47,64},
-{9,14,59,115},
-{9,15,7,105},
-{9,15,11,101},
-{9,15,15,128},
-{9,15,27,43},
-{9,15,35,39},
-{9,15,39,39},
-{9,15,54,28},
-{9,16,7,20},
-{9,16,11,16},
-{9,16,19,9},
-{9,16,27,6},
-{9,16,35,4},
-{9,16,39,3},
-{9,16,51,2},
-{9,16,59,2},
-{9,17,11,3},
-{9,17,27,3},
-{9,17,38,3},
-{9,17,51,3},
-{9,18,3,3},
-{9,18,11,3},
-{9,18,23,3},
-{9,18,35,3},
-{9,18,47,3},
-{9,19,10,3},
-{9,19,27,3},
-{9,19,42,3},
-{9,19,55,3},
-{9,20,11,3},
-{9,20,27,3},
-{9,20,43,3},
-{9,20,51,3},
-{9,21,3,3},
-{9,21,23,3},
-{9,21,42,3},
-{9,21,55,3},
-{9,22,15,3},
-{9,22,27,3},
-{9,22,39,3},
-{9,22,51,3},
-{9,23,3,3},
-{9,23,11,2},
-{9,23,15,2},
-{9,23,35,2},
-{9,23,50,2},
-{10,0,3,2},
-{10,0,15,2},
-{10,0,22,2},
-{10,0,27,2},
-{10,0,35,3},
-{10,1,2,2},
-{10,1,19,2},
-{10,1,26,2},
-{10,1,47,2},
-{10,1,59,2},
-{10,2,15,2},
-{10,2,30,2},
-{10,2,42,2},
-{10,3,19,2},
-{10,3,35,2},
-{10,3,43,2},
-{10,3,51,2},
-{10,4,7,2},
-{10,4,22,2},
-{10,4,35,2},
-{10,4,47,2},
-{10,5,2,2},
-{10,5,19,2},
-{10,5,30,2},
-{10,5,39,2},
-{10,5,55,2},
-{10,6,10,2},
-{10,6,26,2},
-{10,6,39,2},
-{10,6,50,3},
-{10,7,7,86},
-{10,7,15,87},
-{10,7,27,91},
-{10,7,31,95},
-{10,7,51,20},
-{10,8,2,38},
-{10,8,6,45},
-{10,8,23,56},
-{10,8,39,78},
-{10,8,50,94},
-{10,8,59,91},
-{10,9,10,114},
-{10,9,14,124},
-{10,9,23,80},
-{10,9,35,75},
-{10,9,47,76},
-{10,9,50,92},
-{10,10,3,116},
-{10,10,10,136},
-{10,10,15,145},
-{10,10,23,152},
-{10,10,27,157},
-{10,10,43,170},
-{10,10,55,172},
-{10,11,2,171},
-{10,11,11,172},
-{10,11,22,174},
-{10,11,31,174},
-{10,11,43,175},
-{10,11,51,174},
-{10,12,2,176},
-{10,12,7,179},
-{10,12,11,178},
-{10,12,27,114},
-{10,12,39,140},
-{10,12,42,154},
-{10,12,58,118},
-{10,13,2,94},
-{10,13,7,69},
-{10,13,11,74},
-{10,13,19,70},
-{10,13,26,80},
-{10,13,39,60},
-{10,13,43,48},
-{10,13,50,55},
-{10,13,58,60},
-{10,14,2,48},
-{10,14,15,78},
-{10,14,18,88},
-{10,14,31,76},
-{10,14,35,61},
-{10,14,50,50},
-{10,14,55,49},
-{10,14,58,46},
-{10,15,11,42},
-{10,15,18,43},
-{10,15,26,48},
-{10,15,34,72},
-{10,15,38,47},
-{10,15,42,49},
-{10,15,50,34},
-{10,15,59,28},
-{10,16,2,26},
-{10,16,15,17},
-{10,16,18,13},
-{10,16,35,5},
-{10,16,39,4},
-{10,16,50,3},
-{10,17,2,2},
-{10,17,7,2},
-{10,17,22,2},
-{10,17,39,2},
-{10,17,50,2},
-{10,18,7,2},
-{10,18,18,2},
-{10,18,31,2},
-{10,18,42,2},
-{10,18,54,2},
-{10,19,6,2},
-{10,19,14,3},
-{10,19,19,3},
-{10,19,30,2},
-{10,19,42,3},
-{10,19,55,2},
-{10,20,3,3},
-{10,20,6,3},
-{10,20,26,3},
-{10,20,38,3},
-{10,20,46,3},
-{10,21,2,2},
-{10,21,14,2},
-{10,21,26,2},
-{10,21,39,3},
-{10,21,52,3},
-{10,22,2,3},
-{10,22,14,3},
-{10,22,23,3},
-{10,22,35,2},
-{10,22,47,2},
-{10,22,59,2},
-{10,23,18,2},
-{10,23,30,2},
-{10,23,42,2},
-{10,23,50,3},
-{10,23,54,3},
-{11,0,22,2},
-{11,0,34,2},
-{11,0,46,2},
-{11,0,51,2},
-{11,1,6,2},
-{11,1,19,2},
-{11,1,30,2},
-{11,1,43,2},
-{11,2,10,2},
-{11,2,19,2},
-{11,2,27,2},
-{11,2,34,2},
-{11,2,42,2},
-{11,2,51,2},
-{11,3,6,2},
-{11,3,22,2},
-{11,3,30,2},
-{11,3,42,2},
-{11,3,55,2},
-{11,4,10,2},
-{11,4,26,2},
-{11,4,43,2},
-{11,4,50,2},
-{11,5,6,2},
-{11,5,14,2},
-{11,5,26,2},
-{11,5,34,2},
-{11,5,50,2},
-{11,6,2,2},
-{11,6,14,2},
-{11,6,30,2},
-{11,6,46,3},
-{11,6,58,4},
-{11,7,3,5},
-{11,7,15,85},
-{11,7,27,20},
-{11,7,34,26},
-{11,7,42,34},
-{11,7,54,44},
-{11,8,10,57},
-{11,8,23,67},
-{11,8,35,77},
-{11,8,42,89},
-{11,8,54,89},
-{11,9,6,98},
-{11,9,14,101},
-{11,9,22,105},
-{11,9,24,109},
-{11,9,34,112},
-{11,9,50,116},
-{11,10,6,115},
-{11,10,8,114},
-{11,10,14,113},
-{11,10,26,112},
-{11,10,30,114},
-{11,10,35,112},
-{11,10,50,111},
-{11,11,2,110},
-{11,11,6,111},
-{11,11,22,117},
-{11,11,26,116},
-{11,11,34,115},
-{11,11,51,112},
-{11,12,2,113},
-{11,12,14,112},
-{11,12,26,116},
-{11,12,38,116},
-{11,12,46,111},
-{11,12,50,107},
-{11,13,2,105},
-{11,13,6,104},
-{11,13,22,99},
-{11,13,30,100},
-{11,13,34,98},
-{11,13,42,96},
-{11,13,50,97},
-{11,13,58,96},
-{11,14,6,96},
-{11,14,18,95},
-{11,14,22,93},
-{11,14,30,94},
-{11,14,46,77},
-{11,14,54,67},
-{11,15,2,69},
-{11,15,6,79},
-{11,15,18,48},
-{11,15,26,38},
-{11,15,34,32},
-{11,15,46,26},
-{11,15,50,25},
-{11,15,58,20},
-{ },
-    };
-// Light sensor seems to be rarely getting adequate light.
-static const ALDataSample samplea3[] =
-    {
-{14,11,2,31, ALDataSample::NO_OCC_EXPECTATION, false, ALDataSample::UNKNOWN_ACT_OCC},
-{14,11,14,33},
-{14,11,18,8},
-{14,11,26,8},
-{14,11,42,10},
-{14,11,54,9},
-{14,12,6,9},
-{14,12,14,9},
-{14,12,26,10},
-{14,12,30,9},
-{14,12,46,9},
-{14,12,54,9},
-{14,13,6,9},
-{14,13,18,8},
-{14,13,34,8},
-{14,13,50,8},
-{14,13,58,8},
-{14,14,10,7},
-{14,14,22,8},
-{14,14,38,8},
-{14,14,46,8},
-{14,15,1,8},
-{14,15,6,8},
-{14,15,18,7},
-{14,15,22,7},
-{14,15,38,7},
-{14,15,46,7},
-{14,15,58,7},
-{14,16,10,6},
-{14,16,22,6},
-{14,16,34,6},
-{14,16,50,6},
-{14,17,1,6},
-{14,17,10,6},
-{14,17,30,6},
-{14,17,38,6},
-{14,17,50,6},
-{14,17,59,6},
-{14,18,10,6},
-{14,18,22,6},
-{14,18,34,6},
-{14,18,54,6},
-{14,19,10,6},
-{14,19,22,6},
-{14,19,37,6},
-{14,19,43,6},
-{14,19,54,6},
-{14,20,6,6},
-{14,20,18,6},
-{14,20,34,6},
-{14,20,46,6},
-{14,21,3,5},
-{14,21,14,6},
-{14,21,30,6},
-{14,21,38,6},
-{14,21,54,6},
-{14,22,6,6},
-{14,22,14,6},
-{14,22,26,6},
-{14,23,2,6},
-{14,23,26,6},
-{14,23,42,6},
-{14,23,50,6},
-{15,0,6,6},
-{15,0,18,6},
-{15,0,30,6},
-{15,0,42,6},
-{15,0,56,6},
-{15,1,6,6},
-{15,1,22,6},
-{15,1,34,6},
-{15,1,46,6},
-{15,1,58,6},
-{15,2,10,6},
-{15,2,26,6},
-{15,2,38,6},
-{15,2,50,6},
-{15,3,2,6},
-{15,3,6,6},
-{15,3,26,6},
-{15,3,38,6},
-{15,3,50,6},
-{15,3,58,6},
-{15,4,10,6, ALDataSample::NO_OCC_EXPECTATION, ALDataSample::NO_RD_EXPECTATION, false, ALDataSample::SB_ECOMAX}, // Should try and achieve some sort of setback.
-{15,4,22,6},
-{15,4,34,6},
-{15,4,42,6},
-{15,4,54,6},
-{15,5,8,6},
-{15,5,26,6},
-{15,5,38,6},
-{15,5,54,6},
-{15,6,2,6},
-{15,6,14,6},
-{15,6,30,6},
-{15,6,38,6},
-{15,6,54,6},
-{15,7,2,6},
-{15,7,14,6},
-{15,7,23,6},
-{15,7,34,6},
-{15,7,46,7},
-{15,7,54,7},
-{15,8,6,7},
-{15,8,22,7},
-{15,8,26,8},
-{15,8,38,8},
-{15,8,54,7},
-{15,9,6,8},
-{15,9,18,8},
-{15,9,30,8},
-{15,9,34,8},
-{15,9,42,9},
-{15,9,46,9},
-{15,9,58,8},
-{15,10,14,6},
-{15,10,22,7},
-{15,10,26,8},
-{15,10,38,8},
-{15,10,42,7},
-{15,10,46,7},
-{15,11,2,9},
-{15,11,6,12},
-{15,11,10,13},
-{15,11,22,9},
-{15,11,38,10},
-{15,11,42,12},
-{15,11,50,8},
-{15,11,58,11},
-{15,12,6,11},
-{15,12,10,8},
-{15,12,22,11},
-{15,12,26,11},
-{15,12,30,10},
-{15,12,38,11},
-{15,12,46,8},
-{15,12,58,10},
-{15,13,2,9},
-{15,13,10,9},
-{15,13,22,8},
-{15,13,34,11},
-{15,13,42,10},
-{15,13,50,8},
-{15,13,58,8},
-{15,14,2,10},
-{15,14,10,8},
-{15,14,14,9},
-{15,14,22,8},
-{15,14,30,7},
-{15,14,34,8},
-{15,14,41,9},
-{15,14,42,10},
-{15,14,58,8},
-{15,15,2,7},
-{15,15,10,9},
-{15,15,18,7},
-{15,15,22,7},
-{15,15,34,6},
-{15,15,46,6},
-{15,15,54,6},
-{15,16,2,6},
-{15,16,18,6},
-{15,16,30,6},
-{15,16,42,6},
-{15,16,54,7},
-{15,17,10,7},
-{15,17,22,7},
-{15,17,34,7},
-{15,17,46,7},
-{15,18,2,7},
-{15,18,18,7},
-{15,18,31,7},
-{15,18,46,7},
-{15,18,54,7},
-{15,19,2,8},
-{15,19,14,7},
-{15,19,22,7},
-{15,19,34,7},
-{15,19,50,7},
-{15,20,2,7},
-{15,20,34,7},
-{15,20,50,7},
-{15,21,2,7},
-{15,21,18,7},
-{15,21,34,7},
-{15,21,50,7},
-{15,22,6,7},
-{15,22,18,6},
-{15,22,26,6},
-{15,22,38,6},
-{15,22,58,6},
-{15,23,10,6},
-{15,23,30,6},
-{15,23,42,6},
-{15,23,54,6},
-{16,0,6,6},
-{16,0,18,6},
-{16,0,31,6},
-{16,0,42,6},
-{16,0,54,6},
-{16,1,10,6},
-{16,1,22,6},
-{16,1,38,6},
-{16,1,50,6},
-{16,2,2,6},
-{16,2,18,6},
-{16,2,30,6},
-{16,2,42,6},
-{16,2,50,6},
-{16,3,10,6},
-{16,3,22,5},
-{16,3,30,6},
-{16,3,42,6},
-{16,3,54,6},
-{16,4,6,5},
-{16,4,10,6},
-{16,4,14,5},
-{16,4,30,6},
-{16,4,34,5},
-{16,4,42,6},
-{16,4,46,5},
-{16,4,54,6},
-{16,5,2,6},
-{16,5,10,5},
-{16,5,14,5},
-{16,5,26,5},
-{16,5,38,5},
-{16,5,50,5},
-{16,5,58,6},
-{16,6,2,5},
-{16,6,10,5},
-{16,6,14,5},
-{16,6,26,5},
-{16,6,34,6},
-{16,6,38,6},
-{16,6,50,6},
-{16,7,2,6},
-{16,7,14,6},
-{16,7,26,6},
-{16,7,40,6},
-{16,7,50,6},
-{16,8,6,6},
-{16,8,11,6},
-{16,8,46,6},
-{16,9,2,6},
-{16,9,18,7},
-{16,9,30,6},
-{16,9,34,7},
-{16,9,42,7},
-{16,9,46,6},
-{16,9,54,7},
-{16,10,6,7},
-{16,10,18,8},
-{16,10,30,7},
-{16,10,34,8},
-{16,10,42,8},
-{16,10,46,8},
-{16,11,2,8},
-{16,11,6,9},
-{16,11,22,9},
-{16,11,30,10},
-{16,11,38,9},
-{16,11,42,9},
-{16,11,46,8},
-{16,11,54,9},
-{16,11,58,8},
-{16,12,2,9},
-{16,12,6,10},
-{16,12,18,9},
-{16,12,26,9},
-{16,12,34,9},
-{16,12,38,8},
-{16,12,50,7},
-{16,12,54,7},
-{16,12,58,8},
-{16,13,6,8},
-{16,13,10,7},
-{16,13,14,7},
-{16,13,30,7},
-{16,13,42,8},
-{16,13,50,7},
-{16,13,56,7},
-{16,13,58,6},
-{16,14,2,6},
-{16,14,14,6},
-{16,14,34,6},
-{16,14,44,7},
-{16,14,50,7},
-{16,14,58,6},
-{16,15,6,7},
-{16,15,10,6},
-{16,15,14,7},
-{16,15,22,7},
-{16,15,32,6},
-{16,15,46,6},
-{16,15,58,6},
-{16,16,10,6},
-{16,16,22,6},
-{16,16,34,6},
-{16,16,47,6},
-{16,16,54,6},
-{16,17,6,5},
-{16,17,10,5},
-{16,17,26,5},
-{16,17,34,15},
-{16,17,46,14},
-{16,17,54,16},
-{16,17,58,16},
-{16,18,2,14},
-{16,18,14,16},
-{16,18,18,14},
-{16,18,30,14},
-{16,18,38,17},
-{16,18,42,15},
-{16,18,50,15},
-{16,18,58,15},
-{16,19,11,17},
-{16,19,26,17},
-{16,19,34,15},
-{16,19,38,15},
-{16,19,54,17},
-{16,19,58,15},
-{16,20,6,15},
-{16,20,14,16},
-{16,20,22,6},
-{16,20,30,6},
-{16,20,42,6},
-{16,20,54,6},
-{16,21,6,6},
-{16,21,18,5},
-{16,21,30,6},
-{16,21,38,5},
-{16,21,50,5},
-{16,21,54,5},
-{16,22,6,5},
-{16,22,10,5},
-{16,22,26,5},
-{16,22,46,5},
-{16,22,58,5},
-{16,23,6,5},
-{16,23,18,5},
-{16,23,34,5},
-{16,23,50,5},
-{17,0,6,5},
-{17,0,22,5},
-{17,0,30,5},
-{17,0,38,5},
-{17,0,50,5},
-{17,1,2,5},
-{17,1,10,5},
-{17,1,26,5},
-{17,1,38,5},
-{17,1,46,5},
-{17,1,58,5},
-{17,2,10,5},
-{17,2,26,5},
-{17,2,46,5},
-{17,2,58,5},
-{17,3,6,5},
-{17,3,22,5},
-{17,3,38,5},
-{17,3,54,5},
-{17,4,10,5},
-{17,4,30,5},
-{17,4,46,5},
-{17,5,2,5},
-{17,5,14,5},
-{17,5,26,5},
-{17,5,34,5},
-{17,5,50,5},
-{17,6,10,5},
-{17,6,22,15},
-{17,6,26,16},
-{17,6,34,15},
-{17,6,42,15},
-{17,6,50,16},
-{17,6,58,16},
-{17,7,14,6},
-{17,7,22,6},
-{17,7,34,7},
-{17,7,46,6},
-{17,7,58,6},
-{17,8,10,6},
-{17,8,30,7},
-{17,8,46,11},
-{17,8,54,7},
-{17,9,2,8},
-{17,9,14,7},
-{17,9,18,8},
-{17,9,26,20},
-{17,9,38,14},
-{17,9,42,13},
-{17,9,49,12},
-{17,10,2,12},
-{17,10,14,8},
-{17,10,26,9},
-{17,10,30,11},
-{17,10,42,8},
-{17,10,54,9},
-{17,10,58,8},
-{17,11,10,7},
-{17,11,22,7},
-{17,11,30,7},
-{17,11,34,7},
-{17,11,50,7},
-{17,11,58,8},
-{17,12,2,7},
-{17,12,10,8},
-{17,12,14,8},
-{17,12,26,8},
-{17,12,34,17},
-{17,12,42,20},
-{17,12,46,18},
-{17,12,58,18},
-{17,13,10,18},
-{17,13,18,18},
-{17,13,26,18},
-{17,13,34,16},
-{17,13,36,18},
-{17,13,38,16},
-{17,13,42,16},
-{17,13,54,7},
-{17,14,2,7},
-{17,14,10,17},
-{17,14,14,16},
-{17,14,22,7},
-{17,14,26,7},
-{17,14,38,7},
-{17,14,50,7},
-{17,15,2,16},
-{17,15,6,18},
-{17,15,10,15},
-{17,15,18,15},
-{17,15,26,18},
-{17,15,30,17},
-{17,15,42,15},
-{17,15,44,15},
-{17,15,46,6},
-{17,15,50,6},
-{17,16,2,6},
-{17,16,14,6},
-{17,16,26,6},
-{17,16,38,6},
-{17,16,50,5},
-{17,16,54,5},
-{17,17,10,5},
-{17,17,26,5},
-{17,17,34,5},
-{17,17,42,5},
-{17,17,58,5},
-{17,18,10,17},
-{17,18,26,15},
-{17,18,38,15},
-{17,18,58,15},
-{17,19,10,16},
-{17,19,14,15},
-{17,19,18,15},
-{17,19,30,16},
-{17,19,42,16},
-{17,19,54,6},
-{17,20,6,5},
-{17,20,22,5},
-{17,20,34,5},
-{17,20,46,5},
-{17,21,2,5},
-{17,21,18,5},
-{17,21,30,5},
-{17,21,50,5},
-{17,22,2,5},
-{17,22,14,5},
-{17,22,30,5},
-{17,22,38,5},
-{17,22,57,5},
-{17,23,6,5},
-{17,23,22,5},
-{17,23,30,5},
-{17,23,46,5},
-{17,23,58,5},
-{18,0,10,5},
-{18,0,22,5},
-{18,0,38,5},
-{18,0,58,5},
-{18,1,10,5},
-{18,1,26,5},
-{18,1,42,5},
-{18,1,50,5},
-{18,2,2,5},
-{18,2,11,5},
-{18,2,22,5},
-{18,2,38,5},
-{18,2,50,5},
-{18,3,2,5},
-{18,3,18,5},
-{18,3,30,5},
-{18,3,42,5},
-{18,3,54,5},
-{18,4,6,5},
-{18,4,14,5},
-{18,4,26,5},
-{18,4,38,5},
-{18,4,54,5},
-{18,5,10,5},
-{18,5,26,5},
-{18,5,42,5},
-{18,5,58,5},
-{18,6,14,5},
-{18,6,30,6},
-{18,6,34,5},
-{18,6,38,6},
-{18,6,50,6},
-{18,7,2,6},
-{18,7,14,6},
-{18,7,26,6},
-{18,7,38,6},
-{18,7,54,6},
-{18,8,6,6},
-{18,8,26,6},
-{18,8,42,6},
-{18,8,54,6},
-{18,9,6,7},
-{18,9,18,7},
-{18,9,34,6},
-{18,9,50,6},
-{18,10,6,7},
-{18,10,22,8},
-{18,10,34,11},
-{18,10,46,8},
-{18,10,50,11},
-{18,11,2,8},
-{18,11,14,9},
-{18,11,18,6},
-{18,11,34,9},
-{18,11,37,8},
-{18,11,38,8},
-{18,11,46,7},
-{18,11,54,8},
-{18,12,6,8},
-{18,12,12,7},
-{18,12,18,7},
-{18,12,26,8},
-{18,12,30,8},
-{18,12,42,7},
-{18,12,46,7},
-{18,13,2,7},
-{18,13,14,7},
-{18,13,24,7},
-{18,13,34,8},
-{18,13,42,7},
-{18,13,50,6},
-{18,13,54,6},
-{18,13,58,7},
-{18,14,6,6},
-{18,14,10,7},
-{18,14,18,6},
-{18,14,26,7},
-{18,14,34,7},
-{18,14,42,6},
-{18,14,46,6},
-{18,15,2,6},
-{18,15,22,6},
-{18,15,34,6},
-{18,15,38,7},
-{18,15,46,7},
-{18,15,54,7},
-{18,16,2,6},
-{18,16,12,16},
-{18,16,22,6},
-{18,16,34,6},
-{18,16,54,5},
-{18,17,4,5},
-{18,17,10,5},
-{18,17,22,5},
-{18,17,34,5},
-{18,17,46,5},
-{18,18,2,5},
-{18,18,14,5},
-{18,18,18,6},
-{18,18,22,5},
-{18,18,34,6},
-{18,18,47,6},
-{18,18,58,18},
-{18,19,6,17},
-{18,19,14,16},
-{18,19,26,16},
-{18,19,30,17},
-{18,19,38,5},
-{18,19,50,5},
-{18,20,10,5},
-{18,20,26,5},
-{18,20,42,6},
-{18,20,58,6},
-{18,21,6,6},
-{18,21,14,6},
-{18,21,25,6},
-{18,21,30,5},
-{18,21,34,6},
-{18,21,42,5},
-{18,21,54,5},
-{18,22,6,5},
-{18,22,22,5},
-{18,22,30,5},
-{18,22,50,5},
-{18,23,2,5},
-{18,23,14,5},
-{18,23,26,5},
-{18,23,42,5},
-{18,23,54,5},
-{19,0,2,5},
-{19,0,18,5},
-{19,0,30,5},
-{19,0,42,5},
-{19,0,50,5},
-{19,1,6,5},
-{19,1,22,5},
-{19,1,30,5},
-{19,1,42,5},
-{19,1,58,5},
-{19,2,10,5},
-{19,2,26,5},
-{19,2,34,5},
-{19,2,46,5},
-{19,2,58,5},
-{19,3,2,5},
-{19,3,10,5},
-{19,3,26,5},
-{19,3,38,5},
-{19,3,50,5},
-{19,3,59,5},
-{19,4,10,5},
-{19,4,26,5},
-{19,4,38,5},
-{19,4,54,5},
-{19,5,6,5},
-{19,5,26,5},
-{19,5,38,5},
-{19,5,50,5},
-{19,6,3,17},
-{19,6,10,15},
-{19,6,18,5},
-{19,6,30,5},
-{19,6,46,5},
-{19,6,50,6},
-{19,7,1,6},
-{19,7,10,6},
-{19,7,22,6},
-{19,7,38,6},
-{19,7,50,6},
-{19,8,2,6},
-{19,8,14,6},
-{19,8,26,7},
-{19,8,38,7},
-{19,8,50,6},
-{19,9,3,6},
-{19,9,14,7},
-{19,9,22,7},
-{19,9,30,7},
-{19,9,42,7},
-{19,9,54,7},
-{19,10,2,8},
-{19,10,14,7},
-{19,10,26,7},
-{19,10,38,7},
-{19,10,50,7},
-{19,10,58,7},
-{19,11,10,7},
-{19,11,18,8},
-{19,11,26,8},
-{19,11,34,8},
-{19,11,42,7},
-{19,11,54,7},
-{19,11,58,6},
-{19,12,2,6},
-{19,12,6,7},
-{19,12,10,7},
-{19,12,22,7},
-{19,12,29,7},
-{19,12,30,7},
-{19,12,46,7},
-{19,12,54,7},
-{19,13,7,6},
-{19,13,10,6},
-{19,13,22,7},
-{19,13,34,7},
-{19,13,38,8},
-{19,13,46,6},
-{19,14,2,6},
-{19,14,14,5},
-{19,14,26,5},
-{19,14,34,6},
-{19,14,38,6},
-{19,14,46,7},
-{19,14,50,7},
-{19,14,54,6},
-{19,15,6,5},
-{19,15,18,6},
-{19,15,30,6},
-{19,15,38,5},
-{19,15,54,5},
-{19,16,10,5},
-{19,16,20,5},
-{19,16,30,5},
-{19,16,42,5},
-{19,16,50,5},
-{19,17,6,5},
-{19,17,18,15},
-{19,17,30,16},
-{19,17,42,16},
-{19,17,54,15},
-{19,18,2,15},
-{19,18,6,16},
-{19,18,14,15},
-{19,18,26,16},
-{19,18,30,15},
-{19,18,42,16},
-{19,18,54,15},
-{19,18,58,15},
-{19,19,6,17},
-{19,19,14,17},
-{19,19,18,17},
-{19,19,26,15},
-{19,19,34,15},
-{19,19,42,15},
-{19,19,57,16},
-{19,20,6,5},
-{19,20,10,6},
-{19,20,14,6},
-{19,20,26,6},
-{19,20,38,5},
-{19,20,46,5},
-{19,20,54,5},
-{19,21,6,5},
-{19,21,16,5},
-{19,21,19,5},
-{19,21,26,5},
-{19,21,42,5},
-{19,21,58,5},
-{19,22,14,5},
-{19,22,26,5},
-{19,22,42,5},
-{19,22,58,5},
-{19,23,14,5},
-{19,23,30,5},
-{19,23,46,5},
-{20,0,2,5},
-{20,0,10,5},
-{20,0,16,5},
-{20,0,26,5},
-{20,0,34,5},
-{20,0,46,5},
-{20,1,2,5},
-{20,1,18,5},
-{20,1,26,5},
-{20,1,42,5},
-{20,1,50,5},
-{20,2,2,5},
-{20,2,18,5},
-{20,2,30,5},
-{20,2,38,5},
-{20,2,46,5},
-{20,3,2,5},
-{20,3,18,5},
-{20,3,30,5},
-{20,3,34,5},
-{20,3,46,5},
-{20,4,1,5},
-{20,4,14,5},
-{20,4,26,5},
-{20,4,38,5},
-{20,4,50,5},
-{20,5,6,5},
-{20,5,18,5},
-{20,5,30,5},
-{20,5,42,5},
-{20,5,50,5},
-{20,6,5,5},
-{20,6,14,5},
-{20,6,30,5},
-{20,6,38,5},
-{20,6,51,6},
-{20,7,6,6},
-{20,7,14,6},
-{20,7,21,6},
-{20,7,38,6},
-{20,7,50,6},
-{20,8,2,6},
-{20,8,6,7},
-{20,8,14,7},
-{20,8,21,6},
-{20,8,35,17},
-{20,8,38,15},
-{20,8,50,7},
-{20,9,2,6},
-{20,9,6,16},
-{20,9,10,6},
-{20,9,25,7},
-{20,9,30,9},
-{20,9,33,7},
-{20,9,46,7},
-{20,9,54,7},
-{20,10,6,7},
-{20,10,10,11},
-{20,10,18,6},
-{20,10,29,7},
-{20,10,46,7},
-{20,10,56,10},
-{20,11,2,10},
-{20,11,10,6},
-{20,11,18,8},
-{20,11,30,10},
-{20,11,42,6},
-{20,11,46,7},
-{20,11,50,7},
-{20,12,2,7},
-{20,12,10,7},
-{20,12,14,7},
-{20,12,30,8},
-{20,12,48,7},
-{20,12,58,7},
-{20,13,6,7},
-{20,13,18,6},
-{20,13,30,6},
-{20,13,46,6},
-{20,13,57,6},
-{20,14,6,7},
-{20,14,10,7},
-{20,14,22,6},
-{20,14,38,7},
-{20,14,46,6},
-{20,14,50,6},
-{20,14,53,7},
-{20,15,1,7},
-{20,15,10,6},
-{20,15,18,5},
-{20,15,30,5},
-{20,15,46,5},
-{20,15,58,5},
-{20,16,10,11},
-{20,16,14,10},
-{20,16,19,5},
-{20,16,29,10},
-{20,16,34,11},
-{20,16,42,11},
-{20,16,49,5},
-{20,16,54,5},
-{20,17,6,5},
-{20,17,18,5},
-{20,17,22,6},
-{20,17,26,6},
-{20,17,38,6},
-{20,17,46,6},
-{20,18,2,6},
-{20,18,14,6},
-{20,18,30,6},
-{20,18,45,6},
-{20,19,2,6},
-{20,19,18,6},
-{20,19,30,6},
-{20,19,46,6},
-{20,19,57,6},
-{20,20,13,6},
-{20,20,30,6},
-{20,20,41,6},
-{20,20,58,6},
-{20,21,13,6},
-{20,21,29,6},
-{20,21,41,6},
-{20,21,53,6},
-{20,22,10,6},
-{20,22,29,6},
-{20,22,42,6},
-{20,22,58,6},
-{20,23,6,6},
-{20,23,13,5},
-{20,23,17,5},
-{20,23,33,5},
-{20,23,50,5},
-{21,0,10,5},
-{21,0,22,5},
-{21,0,38,5},
-{21,0,54,5},
-{21,1,9,5},
-{21,1,22,5},
-{21,1,38,5},
-{21,1,49,5},
-{21,1,57,5},
-{21,2,9,5},
-{21,2,17,5},
-{21,2,26,5},
-{21,2,37,5},
-{21,2,54,5},
-{21,3,10,5},
-{21,3,26,5},
-{21,3,38,5},
-{21,3,54,5},
-{21,4,2,5},
-{21,4,17,5},
-{21,4,29,5},
-{21,4,37,5},
-{21,4,57,5},
-{21,5,13,5},
-{21,5,25,5},
-{21,5,41,5},
-{21,5,57,5},
-{21,6,9,5},
-{21,6,21,5},
-{21,6,38,5},
-{21,6,49,5},
-{21,7,2,5},
-{21,7,13,5},
-{21,7,25,5},
-{21,7,41,10},
-{21,7,54,10},
-{21,7,58,5},
-{21,8,13,5},
-{21,8,25,6},
-{21,8,38,6},
-{21,8,49,6},
-{21,9,1,7},
-{21,9,10,7},
-{21,9,17,10},
-{21,9,21,11},
-{21,9,26,7},
-{21,9,33,6},
-{21,9,37,7},
-{21,9,54,7},
-{21,10,5,7},
-{21,10,14,7},
-{21,10,30,7},
-{21,10,42,7},
-{21,10,57,7},
-{21,11,9,7},
-{21,11,25,7},
-{21,11,37,8},
-{21,11,46,8},
-{21,11,58,7},
-{21,12,9,7},
-{21,12,21,8},
-{21,12,29,7},
-{21,12,38,7},
-{21,12,49,7},
-{21,12,57,7},
-{21,13,10,7},
-{21,13,21,7},
-{21,13,30,7},
-{21,13,41,7},
-{21,13,50,7},
-{21,14,5,7},
-{21,14,17,7},
-{21,14,25,5},
-{21,14,30,5},
-{21,14,41,5},
-{21,14,53,5},
-{21,15,2,5},
-{21,15,9,5},
-{21,15,17,6},
-{21,15,22,6},
-{21,15,34,6},
-{21,15,45,5},
-{21,16,2,5},
-{21,16,17,6},
-{21,16,21,5},
-{21,16,29,5},
-{21,16,46,5},
-{21,16,57,5},
-{21,17,10,5},
-{21,17,25,5},
-{21,17,37,5},
-{21,17,51,11},
-{21,18,5,10},
-{21,18,21,11},
-{21,18,38,11},
-{21,18,50,10},
-{21,18,53,11},
-{21,19,1,10},
-{21,19,13,11},
-{21,19,29,11},
-{21,19,49,11},
-{21,19,59,11},
-{21,20,9,11},
-{21,20,13,10},
-{21,20,29,11},
-{21,20,41,10},
-{21,20,54,10},
-{21,20,57,11},
-{21,21,13,11},
-{21,21,33,10},
-{21,21,49,11},
-{21,22,1,11},
-{21,22,10,11},
-{21,22,18,10},
-{21,22,21,5},
-{21,22,37,5},
-{21,22,45,5},
-{21,23,1,5},
-{21,23,18,5},
-{21,23,29,5},
-{21,23,45,5},
-{21,23,53,5},
-{22,0,9,5},
-{22,0,17,5},
-{22,0,33,5},
-{22,0,46,5},
-{22,0,58,5},
-{22,1,21,5},
-{22,1,37,5},
-{22,1,50,5},
-{22,2,5,5},
-{22,2,14,5},
-{22,2,33,5},
-{22,2,45,5},
-{22,2,53,5},
-{22,3,10,5},
-{22,3,25,5},
-{22,3,33,5},
-{22,3,45,5},
-{22,3,53,5},
-{22,4,10,5},
-{22,4,17,5},
-{22,4,33,5},
-{22,4,49,5},
-{22,5,5,5},
-{22,5,13,5},
-{22,5,33,5},
-{22,5,45,5},
-{22,6,1,5},
-{22,6,13,5},
-{22,6,25,5},
-{22,6,33,5},
-{22,6,45,5},
-{22,6,58,5},
-{22,7,5,5},
-{22,7,21,6},
-{22,7,33,6},
-{22,7,54,6},
-{22,8,5,6},
-{22,8,17,6},
-{22,8,29,7},
-{22,8,41,6},
-{22,8,53,7},
-{22,9,13,6},
-{22,9,26,7},
-{22,9,41,7},
-{22,9,53,8},
-{22,10,2,7},
-{22,10,9,8},
-{22,10,14,8},
-{22,10,25,8},
-{22,10,37,10},
-{22,10,41,8},
-{22,10,49,8},
-{22,11,1,7},
-{22,11,13,10},
-{22,11,21,9},
-{22,11,25,8},
-{22,11,41,8},
-{22,11,49,6},
-{22,11,53,9},
-{22,12,5,7},
-{22,12,17,6},
-{22,12,21,6},
-{22,12,33,8},
-{22,12,37,8},
-{22,12,53,6},
-{22,13,5,7},
-{22,13,17,6},
-{22,13,29,7},
-{22,13,37,7},
-{22,13,45,7},
-{22,14,1,7},
-{22,14,13,7},
-{22,14,21,6},
-{22,14,25,6},
-{22,14,33,7},
-{22,14,49,6},
-{22,14,57,6},
-{22,15,9,5},
-{22,15,13,5},
-{22,15,25,6},
-{22,15,37,6},
-{22,15,49,5},
-{22,15,53,5},
-{22,16,5,5},
-{22,16,21,5},
-{22,16,33,5},
-{22,16,49,5},
-{22,17,5,5},
-{22,17,17,5},
-{22,17,33,8},
-{22,17,41,9},
-{22,17,49,8},
-{22,18,1,8},
-{22,18,9,8},
-{22,18,13,8},
-{22,18,33,9},
-{22,18,49,9},
-{22,18,57,9},
-{22,19,17,5},
-{22,19,29,5},
-{22,19,45,5},
-{22,19,57,5},
-{22,20,9,5},
-{22,20,25,5},
-{22,20,33,5},
-{22,20,45,5},
-{22,21,5,5},
-{22,21,17,5},
-{22,21,33,5},
-{22,21,49,5},
-{22,21,57,5},
-{22,22,5,5},
-{22,22,17,5},
-{22,22,29,5},
-{22,22,45,5},
-{22,22,54,5},
-{22,23,7,5},
-{22,23,17,5},
-{22,23,33,5},
-{22,23,49,5},
-{23,0,5,5},
-{23,0,21,5},
-{23,0,37,5},
-{23,0,45,5},
-{23,0,53,5},
-{23,1,5,5},
-{23,1,17,5},
-{23,1,33,5},
-{23,1,49,5},
-{23,2,1,5},
-{23,2,13,5},
-{23,2,29,5},
-{23,2,37,5},
-{23,2,53,5},
-{23,3,13,5},
-{23,3,25,5},
-{23,3,33,5},
-{23,3,48,5},
-{23,3,53,5},
-{23,4,1,5},
-{23,4,17,5},
-{23,4,25,5},
-{23,4,33,5},
-{23,4,49,5},
-{23,5,17,5},
-{23,5,25,5},
-{23,5,37,5},
-{23,5,49,5},
-{23,6,5,5},
-{23,6,17,5},
-{23,6,26,5},
-{23,6,37,5},
-{23,6,49,5},
-{23,7,1,5},
-{23,7,13,5},
-{23,7,25,5},
-{23,7,35,5},
-{23,7,41,6},
-{23,7,45,5},
-{23,7,57,6},
-{23,8,1,6},
-{23,8,17,6},
-{23,8,25,6},
-{23,8,37,7},
-{23,8,49,8},
-{23,8,53,10},
-{23,8,57,9},
-{23,9,5,9},
-{23,9,13,12},
-{23,9,17,14},
-{23,9,29,11},
-{23,9,32,8},
-{23,9,45,8},
-{23,9,57,7},
-{23,10,9,7},
-{23,10,21,7},
-{23,10,29,6},
-{23,10,37,6},
-{23,10,45,7},
-{23,10,49,8},
-{23,10,53,7},
-{23,11,1,7},
-{23,11,9,6},
-{23,11,17,8},
-{23,11,25,6},
-{23,11,29,7},
-{23,11,33,7},
-{23,11,37,6},
-{23,11,45,8},
-{23,11,53,7},
-{23,12,9,7},
-{23,12,17,6},
-{23,12,33,7},
-{23,12,49,7},
-{23,13,1,7},
-{23,13,17,7},
-{23,13,21,6},
-{23,13,29,6},
-{23,13,37,7},
-{23,13,41,6},
-{23,13,53,6},
-{23,14,5,7},
-{23,14,9,6},
-{23,14,17,6},
-{23,14,29,7},
-{23,14,41,6},
-{23,14,45,6},
-{23,15,1,6},
-{23,15,13,6},
-{23,15,17,6},
-{23,15,32,6},
-{23,15,41,5},
-{23,15,57,5},
-{23,16,9,5},
-{23,16,17,5},
-{23,16,29,5},
-{23,16,41,5},
-{23,16,53,5},
-{23,17,9,5},
-{23,17,25,5},
-{23,17,41,8},
-{23,17,45,9},
-{23,17,49,8},
-{23,18,5,8},
-{23,18,9,9},
-{23,18,20,8},
-{23,18,21,9},
-{23,18,33,8},
-{23,18,43,9},
-{23,18,45,8},
-{23,19,1,8},
-{23,19,9,8},
-{23,19,25,8},
-{23,19,33,9},
-{23,19,41,9},
-{23,20,5,5},
-{23,20,17,5},
-{23,20,29,5},
-{23,20,41,5},
-{23,20,53,5},
-{23,21,5,5},
-{23,21,17,5},
-{23,21,29,5},
-{23,21,45,5},
-{23,22,1,5},
-{23,22,21,5},
-{23,22,37,5},
-{23,22,49,5},
-{23,23,5,5},
-{23,23,25,5},
-{23,23,33,5},
-{23,23,53,5},
-{24,0,5,5},
-{24,0,21,5},
-{24,0,33,5},
-{24,0,41,5},
-{24,0,57,5},
-{24,1,9,5},
-{24,1,21,5},
-{24,1,29,5},
-{24,1,41,5},
-{24,1,49,5},
-{24,1,57,5},
-{24,2,13,5},
-{24,2,25,5},
-{24,2,37,5},
-{24,2,49,5},
-{24,3,1,5},
-{24,3,17,5},
-{24,3,33,5},
-{24,3,49,5},
-{24,4,9,5},
-{24,4,21,5},
-{24,4,29,5},
-{24,4,41,5},
-{24,4,53,5},
-{24,5,5,5},
-{24,5,13,5},
-{24,5,25,5},
-{24,5,37,5},
-{24,5,47,5},
-{24,5,57,5},
-{24,6,9,5},
-{24,6,21,5},
-{24,6,33,5},
-{24,6,45,5},
-{24,6,57,5},
-{24,7,13,5},
-{24,7,23,5},
-{24,7,37,5},
-{24,7,53,5},
-{24,7,57,6},
-{24,8,1,6},
-{24,8,17,5},
-{24,8,29,5},
-{24,8,41,6},
-{24,8,53,6},
-{24,9,9,6},
-{24,9,21,6},
-{24,9,32,6},
-{24,9,45,6},
-{24,9,57,6},
-{24,10,9,7},
-{24,10,21,7},
-{24,10,33,6},
-{24,10,37,6},
-{24,10,49,6},
-{24,11,1,6},
-{24,11,13,5},
-{24,11,17,5},
-{24,11,29,6},
-{24,11,41,6},
-{24,11,53,6},
-{24,12,13,6},
-{24,12,21,6},
-{24,12,33,7},
-{24,12,49,7},
-{24,12,53,6},
-{24,13,5,6},
-{24,13,17,6},
-{24,13,25,6},
-{24,13,37,6},
-{24,13,49,6},
-{24,14,1,6},
-{24,14,13,6},
-{24,14,25,6},
-{24,14,33,5},
-{24,14,36,5},
-{24,14,49,5},
-{24,14,53,5},
-{24,15,5,5},
-{24,15,17,5},
-{24,15,29,5},
-{24,15,41,5},
-{24,15,57,5},
-{24,16,13,5},
-{24,16,25,5},
-{24,16,37,5},
-{24,16,45,5},
-{24,17,1,5},
-{24,17,13,9},
-{24,17,25,9},
-{24,17,29,8},
-{24,17,36,8},
-{24,17,41,8},
-{24,17,53,8},
-{24,18,9,8},
-{24,18,13,9},
-{24,18,25,8},
-{24,18,37,9},
-{24,18,41,9},
-{24,18,53,9},
-{24,18,57,8},
-{24,19,1,9},
-{24,19,12,9},
-{24,19,13,9},
-{24,19,17,8},
-{24,19,25,9},
-{24,19,33,8},
-{24,19,45,8},
-{24,19,57,8},
-{24,20,5,9},
-{24,20,9,8},
-{24,20,21,8},
-{24,20,33,9},
-{24,20,37,8},
-{24,20,45,8},
-{24,20,53,9},
-{24,20,57,9},
-{24,21,1,8},
-{24,21,13,9},
-{24,21,21,7},
-{24,21,29,7},
-{24,21,41,7},
-{24,21,52,7},
-{24,21,53,7},
-{24,22,1,7},
-{24,22,13,6},
-{24,22,17,7},
-{24,22,33,7},
-{24,22,49,5},
-{24,23,9,5},
-{24,23,25,5},
-{24,23,37,5},
-{24,23,53,5},
-{24,23,57,5},
-{25,0,9,5},
-{25,0,29,5},
-{25,0,37,5},
-{25,0,53,5},
-{25,1,9,5},
-{25,1,25,5},
-{25,1,41,5},
-{25,1,57,5},
-{25,2,5,5},
-{25,2,17,5},
-{25,2,25,5},
-{25,2,37,5},
-{25,2,53,5},
-{25,3,9,5},
-{25,3,21,5},
-{25,3,33,5},
-{25,3,41,5},
-{25,3,57,5},
-{25,4,9,5, ALDataSample::NO_OCC_EXPECTATION, ALDataSample::NO_RD_EXPECTATION, false, ALDataSample::SB_ECOMAX}, // Should try and achieve some sort of setback.
-{25,4,21,5},
-{25,4,33,5},
-{25,4,45,5, ALDataSample::NO_OCC_EXPECTATION, ALDataSample::NO_RD_EXPECTATION, false, ALDataSample::SB_ECOMAX}, // Should try and achieve some sort of setback.
-{ },
-    };
-static const ALDataSample samplea3b[] =
-    {
-{8,0,12,5, occType::OCC_NONE, true, false},
-{8,0,24,5},
-{8,0,40,5},
-{8,0,56,5},
-{8,1,16,5},
-{8,1,28,5},
-{8,1,44,5},
-{8,1,56,5},
-{8,2,8,5},
-{8,2,20,5},
-{8,2,36,5},
-{8,2,44,5},
-{8,2,56,5},
-{8,3,8,5},
-{8,3,24,5},
-{8,3,32,5},
-{8,3,40,5},
-{8,3,56,5},
-{8,4,16,5},
-{8,4,28,5},
-{8,4,36,5},
-{8,4,52,5},
-{8,5,4,5},
-{8,5,16,5},
-{8,5,32,5},
-{8,5,40,5},
-{8,5,56,5},
-{8,6,16,5},
-{8,6,28,5},
-{8,6,36,5},
-{8,6,42,5},
-{8,6,52,5},
-{8,7,0,5},
-{8,7,8,5},
-{8,7,28,5},
-{8,7,40,6},
-{8,7,56,6},
-{8,8,8,6},
-{8,8,20,6},
-{8,8,32,6},
-{8,8,48,6},
-{8,9,0,6},
-{8,9,10,10},
-{8,9,12,11},
-{8,9,24,8},
-{8,9,28,7},
-{8,9,36,7},
-{8,9,48,8},
-{8,9,52,9},
-{8,10,0,10},
-{8,10,16,8},
-{8,10,24,9},
-{8,10,26,8},
-{8,10,36,7},
-{8,10,47,7},
-{8,10,56,7},
-{8,11,12,7},
-{8,11,28,7},
-{8,11,36,7},
-{8,11,48,7},
-{8,12,4,7},
-{8,12,20,7},
-{8,12,36,7},
-{8,12,47,7},
-{8,13,3,7},
-{8,13,20,7},
-{8,13,24,6},
-{8,13,27,6},
-{8,13,39,7},
-{8,13,55,7},
-{8,14,3,7},
-{8,14,8,6},
-{8,14,12,6},
-{8,14,28,6},
-{8,14,44,6},
-{8,15,0,6},
-{8,15,12,6},
-{8,15,19,6},
-{8,15,32,6},
-{8,15,44,5},
-{8,15,51,5},
-{8,16,12,5},
-{8,16,24,5},
-{8,16,36,5},
-{8,16,48,5},
-{8,17,4,5},
-{8,17,20,17},
-{8,17,28,16},
-{8,17,36,17},
-{8,17,47,15},
-{8,17,52,16},
-{8,18,8,15},
-{8,18,20,17},
-{8,18,24,18},
-{8,18,28,16},
-{8,18,39,18},
-{8,18,48,17},
-{8,18,52,18},
-{8,19,3,16},
-{8,19,15,17},
-{8,19,28,17},
-{8,19,39,16},
-{8,19,52,16},
-{8,19,56,17},
-{8,20,4,17},
-{8,20,20,17},
-{8,20,32,16},
-{8,20,43,15},
-{8,21,0,17},
-{8,21,11,17},
-{8,21,24,16},
-{8,21,36,16},
-{8,21,44,16},
-{8,21,52,16},
-{8,22,8,17},
-{8,22,20,15},
-{8,22,35,17},
-{8,22,48,16},
-{8,22,55,17},
-{8,23,4,15},
-{8,23,8,16},
-{8,23,20,5},
-{8,23,28,5},
-{8,23,48,5},
-{9,0,0,5},
-{9,0,16,5},
-{9,0,35,5},
-{9,0,52,5},
-{9,0,59,5},
-{9,1,12,5},
-{9,1,24,5},
-{9,1,36,5},
-{9,1,47,5},
-{9,2,4,5},
-{9,2,20,5},
-{9,2,28,5},
-{9,2,43,5},
-{9,2,51,5},
-{9,3,8,5},
-{9,3,24,5},
-{9,3,31,5},
-{9,3,44,5},
-{9,3,59,5},
-{9,4,11,5},
-{9,4,24,5},
-{9,4,35,5},
-{9,4,43,5},
-{9,5,0,5},
-{9,5,15,5},
-{9,5,28,5},
-{9,5,39,5},
-{9,5,56,5},
-{9,6,8,5},
-{9,6,20,5},
-{9,6,36,5},
-{9,6,44,5},
-{9,6,56,5},
-{9,7,8,5},
-{9,7,24,5},
-{9,7,35,5},
-{9,7,47,5},
-{9,8,3,5},
-{9,8,15,5},
-{9,8,31,5},
-{9,8,47,5},
-{9,9,4,18},
-{9,9,8,16},
-{9,9,20,16},
-{9,9,48,5},
-{9,9,56,5},
-{9,10,8,5},
-{9,10,23,5},
-{9,10,35,5},
-{9,10,48,5},
-{9,11,3,15},
-{9,11,8,6},
-{9,11,12,6},
-{9,11,23,6},
-{9,11,36,5},
-{9,11,51,5},
-{9,12,8,5},
-{9,12,16,6},
-{9,12,31,6},
-{9,12,39,6},
-{9,12,51,6},
-{9,13,0,7},
-{9,13,4,6},
-{9,13,12,6},
-{9,13,23,6},
-{9,13,35,6},
-{9,13,44,5},
-{9,13,51,5},
-{9,14,3,6},
-{9,14,16,7},
-{9,14,24,6},
-{9,14,28,5},
-{9,14,40,6},
-{9,14,43,5},
-{9,14,55,6},
-{9,15,4,6},
-{9,15,15,6},
-{9,15,28,5},
-{9,15,35,5},
-{9,15,47,5},
-{9,15,55,5},
-{9,16,8,5},
-{9,16,23,5},
-{9,16,39,5},
-{9,16,47,5},
-{9,17,7,14},
-{9,17,19,14},
-{9,17,43,14},
-{9,17,59,14},
-{9,18,7,14},
-{9,18,12,16},
-{9,18,16,15},
-{9,18,31,14},
-{9,18,52,14},
-{9,19,3,14},
-{9,19,7,15},
-{9,19,16,15},
-{9,19,24,14},
-{9,19,31,15},
-{9,19,43,15},
-{9,19,47,15},
-{9,19,55,14},
-{9,20,11,15},
-{9,20,28,15},
-{9,20,39,15},
-{9,20,51,14},
-{9,20,53,15},
-{9,21,4,14},
-{9,21,20,14},
-{9,21,40,14},
-{9,21,51,14},
-{9,22,4,14},
-{9,22,15,14},
-{9,22,23,14},
-{9,22,32,14},
-{9,22,36,15},
-{9,22,52,14},
-{9,23,4,14},
-{9,23,8,15},
-{9,23,15,14},
-{9,23,27,15},
-{9,23,32,14},
-{9,23,44,5},
-{9,23,56,5},
-{10,0,4,5},
-{10,0,15,5},
-{10,0,27,5},
-{10,1,7,5},
-{10,1,27,5},
-{10,1,39,5},
-{10,1,55,5},
-{10,2,4,5},
-{10,2,19,5},
-{10,2,35,5},
-{10,2,47,5},
-{10,3,3,5},
-{10,3,15,5},
-{10,3,27,5},
-{10,3,32,5},
-{10,3,47,5},
-{10,4,3,5},
-{10,4,19,5},
-{10,4,28,5},
-{10,4,39,5},
-{10,4,55,5},
-{10,5,11,5},
-{10,5,23,5},
-{10,5,31,5},
-{10,5,47,5},
-{10,5,57,5},
-{10,6,3,5},
-{10,6,15,5},
-{10,6,23,5},
-{10,6,40,5},
-{10,6,47,5},
-{10,7,3,5},
-{10,7,19,5},
-{10,7,31,5},
-{10,7,39,5},
-{10,7,55,5},
-{10,8,3,5},
-{10,8,19,5},
-{10,8,27,5},
-{10,8,43,6},
-{10,8,59,6},
-{10,9,15,7},
-{10,9,21,6},
-{10,9,23,6},
-{10,9,43,15},
-{10,9,55,14},
-{10,10,7,16},
-{10,10,19,16},
-{10,10,27,7},
-{10,10,43,7},
-{10,10,55,7},
-{10,11,7,7},
-{10,11,11,7},
-{10,11,26,7},
-{10,11,35,7},
-{10,11,46,17},
-{10,11,55,16},
-{10,11,59,7},
-{10,12,7,8},
-{10,12,11,7},
-{10,12,19,7},
-{10,12,27,6},
-{10,12,28,6},
-{10,12,38,6},
-{10,12,43,7},
-{10,12,47,6},
-{10,12,59,18},
-{10,13,7,15},
-{10,13,12,15},
-{10,13,23,17},
-{10,13,27,15},
-{10,13,43,15},
-{10,13,51,16},
-{10,13,55,15},
-{10,14,3,5},
-{10,14,14,5},
-{10,14,15,6},
-{10,14,19,5},
-{10,14,31,5},
-{10,14,36,5},
-{10,14,51,5},
-{10,15,13,5},
-{10,15,19,5},
-{10,15,31,5},
-{10,15,47,5},
-{10,16,3,5},
-{10,16,11,5},
-{10,16,27,5},
-{10,16,43,16},
-{10,16,47,15},
-{10,16,55,16},
-{10,17,7,16},
-{10,17,11,15},
-{10,17,19,15},
-{10,17,27,16},
-{10,17,39,16},
-{10,17,51,16},
-{10,17,55,15},
-{10,18,11,15},
-{10,18,27,16},
-{10,18,41,15},
-{10,18,55,16},
-{10,18,59,15},
-{10,19,7,15},
-{10,19,19,16},
-{10,19,27,16},
-{10,19,31,15},
-{10,19,39,16},
-{10,19,51,15},
-{10,20,3,15},
-{10,20,7,14},
-{10,20,15,15},
-{10,20,27,16},
-{10,20,39,15},
-{10,20,47,16},
-{10,20,51,15},
-{10,21,7,16},
-{10,21,15,5},
-{10,21,31,5},
-{10,21,51,5},
-{10,22,3,5},
-{10,22,11,5},
-{10,22,27,5},
-{10,22,35,5},
-{10,22,51,5},
-{10,23,0,5},
-{10,23,11,5},
-{10,23,27,5},
-{10,23,39,5},
-{10,23,55,5},
-{11,0,11,5},
-{11,0,27,5},
-{11,0,43,5},
-{11,0,59,5},
-{11,1,7,5},
-{11,1,19,5},
-{11,1,31,5},
-{11,1,47,5},
-{11,2,3,5},
-{11,2,15,5},
-{11,2,27,5},
-{11,2,35,5},
-{11,2,47,5},
-{11,2,59,5},
-{11,3,11,5},
-{11,3,19,5},
-{11,3,35,5},
-{11,3,39,5},
-{11,3,55,5},
-{11,4,7,5},
-{11,4,19,5},
-{11,4,39,5},
-{11,4,51,5},
-{11,5,3,5},
-{11,5,11,5},
-{11,5,27,5},
-{11,5,39,5},
-{11,5,51,5},
-{11,6,7,5},
-{11,6,19,5},
-{11,6,27,5},
-{11,6,35,5},
-{11,6,47,5},
-{11,6,59,5},
-{11,7,19,5},
-{11,7,31,5},
-{11,7,47,5},
-{11,8,3,6},
-{11,8,15,5},
-{11,8,23,5},
-{11,8,35,5},
-{11,8,55,5},
-{11,9,11,8},
-{11,9,19,9},
-{11,9,27,6},
-{11,9,35,6},
-{11,9,51,6},
-{11,9,59,6},
-{11,10,15,6},
-{11,10,31,7},
-{11,10,43,7},
-{11,10,51,7},
-{11,11,3,6},
-{11,11,15,7},
-{11,11,23,7},
-{11,11,35,6},
-{11,11,39,6},
-{11,11,55,6},
-{11,12,11,6},
-{11,12,23,6},
-{11,12,35,6},
-{11,12,51,6},
-{11,12,59,6},
-{11,13,7,6},
-{11,13,23,6},
-{11,13,35,6},
-{11,13,47,6},
-{11,14,3,6},
-{11,14,15,5},
-{11,14,23,5},
-{11,14,31,5},
-{11,14,43,5},
-{11,14,59,5},
-{11,15,11,5},
-{11,15,23,5},
-{11,15,35,5},
-{11,15,47,5},
-{11,15,59,5},
-{ },
-    };
-
-
-} } }
-
-
-#endif
@@ -0,0 +1,283 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016--2018
+*/
+
+/*
+ * Host-side grid/random search over the ambient light occupancy detector
+ * tuneables (OTV0P2BASE_SensorAmbientLightOccupancy_Tuneable.h),
+ * evaluated over a trace corpus with the AmbientLightOccupancyBenchmark.h
+ * harness and run in parallel across cores.
+ *
+ * Configurations are ranked by a score combining:
+ *   * F1 of the occupancy tracker against reference occupancy
+ *   * mean onset lag (penalised)
+ *   * explicit per-sample expectation misses (penalised)
+ * The best can be written out as a replacement _Tuneable.h header.
+ *
+ * Results are collected per configuration and ranked afterwards,
+ * so they do not depend on the number of threads used.
+ */
+
+#ifndef PUT_OTRADIOLINK_AMBIENTLIGHTOCCUPANCYSWEEP_H
+#define PUT_OTRADIOLINK_AMBIENTLIGHTOCCUPANCYSWEEP_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AmbientLightOccupancyBenchmark.h"
+
+namespace ALOBM
+{
+namespace Sweep
+{
+
+// A set of traces held in memory (or mapped) for repeated evaluation.
+class Corpus final
+    {
+    private:
+        struct Samples { std::string name; const OTV0P2BASE::PortableUnitTest::ALDataSample *data; };
+        struct Log { std::string name; std::unique_ptr<MappedFile> l, o; };
+        std::vector<Samples> samples;
+        std::vector<Log> logs;
+
+    public:
+        // Add a terminated ALDataSample array; must outlive the corpus.
+        void addSamples(const char *const name, const OTV0P2BASE::PortableUnitTest::ALDataSample *const data)
+            { samples.push_back(Samples{ name, data }); }
+
+        // Add an xx.L.dat file, with xx.O.dat alongside as reference if present.
+        // Returns false if the L file cannot be read.
+        bool addLogFile(const char *const lPath)
+            {
+            Log log{ lPath, std::unique_ptr<MappedFile>(new MappedFile), std::unique_ptr<MappedFile>(new MappedFile) };
+            if(!log.l->open(lPath)) { return(false); }
+            std::string oPath(lPath);
+            const size_t dot = oPath.rfind(".L.dat");
+            if(std::string::npos != dot) { oPath.replace(dot, 6, ".O.dat"); log.o->open(oPath.c_str()); }
+            logs.push_back(std::move(log));
+            return(true);
+            }
+
+        // Number of traces.
+        size_t size() const { return(samples.size() + logs.size()); }
+
+        // Evaluate all traces with the given parameters, in corpus order.
+        // Thread-safe; the corpus is not modified.
+        Metrics evaluate(const Params &p) const
+            {
+            Metrics total;
+            for(const Samples &s : samples) { total += runSamples(s.data, p); }
+            for(const Log &l : logs) { total += runLog(l.l->data(), l.l->size(), l.o->data(), l.o->size(), p); }
+            return(total);
+            }
+    };
+
+// Inclusive range of one parameter with strictly positive step.
+struct Range
+    {
+    uint8_t lo, hi, step;
+    };
+
+// Ranges for all four parameters.
+struct Space
+    {
+    Range epsilon;
+    Range steadyTicksMinWithLightOn;
+    Range steadyTicksMinForArtificialLight;
+    Range steadyTicksMinBeforeLightOn;
+    };
+
+// Default search space, bracketing the hand-picked values.
+static constexpr Space defaultSpace = { { 1, 16, 1 }, { 0, 10, 1 }, { 10, 90, 10 }, { 1, 10, 1 } };
+
+// Every combination in the space, epsilon varying slowest; invalid combinations are omitted.
+inline std::vector<Params> grid(const Space &s)
+    {
+    std::vector<Params> out;
+    for(unsigned e = s.epsilon.lo; e <= s.epsilon.hi; e += s.epsilon.step)
+      for(unsigned w = s.steadyTicksMinWithLightOn.lo; w <= s.steadyTicksMinWithLightOn.hi; w += s.steadyTicksMinWithLightOn.step)
+        for(unsigned a = s.steadyTicksMinForArtificialLight.lo; a <= s.steadyTicksMinForArtificialLight.hi; a += s.steadyTicksMinForArtificialLight.step)
+          for(unsigned b = s.steadyTicksMinBeforeLightOn.lo; b <= s.steadyTicksMinBeforeLightOn.hi; b += s.steadyTicksMinBeforeLightOn.step)
+            {
+            const Params p(static_cast<uint8_t>(e), static_cast<uint8_t>(w), static_cast<uint8_t>(a), static_cast<uint8_t>(b));
+            if(p.isValid()) { out.push_back(p); }
+            }
+    return(out);
+    }
+
+// n reproducible random points uniformly on the space's steps; invalid points are redrawn.
+inline std::vector<Params> random(const Space &s, const size_t n, uint32_t seed = 1)
+    {
+    // Simple LCG so that searches are identical on every host.
+    auto rnd = [&seed](const Range &r) {
+        seed = seed * 1664525U + 1013904223U;
+        const unsigned steps = (unsigned(r.hi) - r.lo) / r.step + 1;
+        return(uint8_t(r.lo + r.step * (((seed >> 8) & 0xffff) % steps)));
+        };
+    std::vector<Params> out;
+    out.reserve(n);
+    while(out.size() < n)
+        {
+        const uint8_t e = rnd(s.epsilon);
+        const uint8_t w = rnd(s.steadyTicksMinWithLightOn);
+        const uint8_t a = rnd(s.steadyTicksMinForArtificialLight);
+        const uint8_t b = rnd(s.steadyTicksMinBeforeLightOn);
+        const Params p(e, w, a, b);
+        if(p.isValid()) { out.push_back(p); }
+        }
+    return(out);
+    }
+
+// Relative weights of the score penalties.
+struct Weights
+    {
+    // Subtracted per unit of mean onset lag as a fraction of Runner::MAX_ONSET_LAG_M.
+    double lag = 0.25;
+    // Subtracted per unit of expectation miss rate.
+    double expectations = 0.5;
+    };
+
+// One evaluated configuration.
+struct Result
+    {
+    Params p;
+    Metrics m;
+    double score;
+    };
+
+// Score metrics; higher is better.
+inline double score(const Metrics &m, const Weights &w = Weights())
+    {
+    const double expMiss = (0 == m.expectations) ? 0 : (m.expectationErrors / double(m.expectations));
+    return(m.f1() - w.lag * (m.meanOnsetLagM() / Runner::MAX_ONSET_LAG_M) - w.expectations * expMiss);
+    }
+
+// Evaluate all candidates over the corpus, in candidate order.
+// Candidates are handed out to worker threads one at a time.
+//   * threads  number of worker threads; 0 to use all hardware threads
+inline std::vector<Result> run(const Corpus &corpus, const std::vector<Params> &candidates,
+                               unsigned threads = 0, const Weights &w = Weights())
+    {
+    std::vector<Result> results(candidates.size(), Result{ Params(), Metrics(), 0 });
+    if(0 == threads) { threads = std::thread::hardware_concurrency(); }
+    if(0 == threads) { threads = 1; }
+    if(threads > candidates.size()) { threads = unsigned(std::max<size_t>(1, candidates.size())); }
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for(size_t i; (i = next++) < candidates.size(); )
+            {
+            const Metrics m = corpus.evaluate(candidates[i]);
+            results[i] = Result{ candidates[i], m, score(m, w) };
+            }
+        };
+    std::vector<std::thread> pool;
+    for(unsigned t = 1; t < threads; ++t) { pool.emplace_back(worker); }
+    worker();
+    for(std::thread &t : pool) { t.join(); }
+    return(results);
+    }
+
+// Sort best first: by score, then lower onset lag, then lower parameter values.
+inline void rank(std::vector<Result> &results)
+    {
+    std::stable_sort(results.begin(), results.end(), [](const Result &a, const Result &b) {
+        if(a.score != b.score) { return(a.score > b.score); }
+        const double la = a.m.meanOnsetLagM(), lb = b.m.meanOnsetLagM();
+        if(la != lb) { return(la < lb); }
+        if(a.p.epsilon != b.p.epsilon) { return(a.p.epsilon < b.p.epsilon); }
+        if(a.p.steadyTicksMinWithLightOn != b.p.steadyTicksMinWithLightOn) { return(a.p.steadyTicksMinWithLightOn < b.p.steadyTicksMinWithLightOn); }
+        if(a.p.steadyTicksMinForArtificialLight != b.p.steadyTicksMinForArtificialLight) { return(a.p.steadyTicksMinForArtificialLight < b.p.steadyTicksMinForArtificialLight); }
+        return(a.p.steadyTicksMinBeforeLightOn < b.p.steadyTicksMinBeforeLightOn);
+        });
+    }
+
+// Print one ranked result.
+inline void print(const unsigned rankNo, const Result &r)
+    {
+    std::printf("ALOccSweep #%-3u score %.4f f1 %.3f lag %.1f exp %lu/%lu epsilon %u withLightOn %u forArtificialLight %u beforeLightOn %u\n",
+        rankNo, r.score, r.m.f1(), r.m.meanOnsetLagM(),
+        r.m.expectations - r.m.expectationErrors, r.m.expectations,
+        unsigned(r.p.epsilon), unsigned(r.p.steadyTicksMinWithLightOn),
+        unsigned(r.p.steadyTicksMinForArtificialLight), unsigned(r.p.steadyTicksMinBeforeLightOn));
+    }
+
+// Text of a replacement OTV0P2BASE_SensorAmbientLightOccupancy_Tuneable.h with the given values.
+inline std::string tuneableHeader(const Result &r)
+    {
+    char buf[2048];
+    std::snprintf(buf, sizeof(buf),
+"/*\n"
+"The OpenTRV project licenses this file to you\n"
+"under the Apache Licence, Version 2.0 (the \"Licence\");\n"
+"you may not use this file except in compliance\n"
+"with the Licence. You may obtain a copy of the Licence at\n"
+"\n"
+"http://www.apache.org/licenses/LICENSE-2.0\n"
+"\n"
+"Unless required by applicable law or agreed to in writing,\n"
+"software distributed under the Licence is distributed on an\n"
+"\"AS IS\" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY\n"
+"KIND, either express or implied. See the Licence for the\n"
+"specific language governing permissions and limitations\n"
+"under the Licence.\n"
+"*/\n"
+"\n"
+"// Generated by the ALOccSweep parameter search:\n"
+"//     score %.4f, f1 %.3f, mean onset lag %.1f minutes, expectations %lu/%lu,\n"
+"//     over %lu samples.\n"
+"\n"
+"#ifndef OTV0P2BASE_SENSORAMBIENTLIGHTOCCUPANCY_TUNEABLE_H\n"
+"#define OTV0P2BASE_SENSORAMBIENTLIGHTOCCUPANCY_TUNEABLE_H\n"
+"\n"
+"// Minimum delta (rise) for probable occupancy to be detected.\n"
+"#ifndef SENSORAMBIENTLIGHTOCCUPANCY_EPSILON\n"
+"#define SENSORAMBIENTLIGHTOCCUPANCY_EPSILON %u\n"
+"#endif // SENSORAMBIENTLIGHTOCCUPANCY_EPSILON\n"
+"\n"
+"// Min steady/grace time after lights on to confirm occupancy.\n"
+"#ifndef SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinWithLightOn\n"
+"#define SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinWithLightOn %u\n"
+"#endif // SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinWithLightOn\n"
+"\n"
+"// Minimum steady time for detecting artificial light (ticks/minutes).\n"
+"#ifndef SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinForArtificialLight\n"
+"#define SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinForArtificialLight %u\n"
+"#endif // SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinForArtificialLight\n"
+"\n"
+"// Minimum steady time for detecting light on (ticks/minutes).\n"
+"#ifndef SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinBeforeLightOn\n"
+"#define SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinBeforeLightOn %u\n"
+"#endif // SENSORAMBIENTLIGHTOCCUPANCY_steadyTicksMinBeforeLightOn\n"
+"\n"
+"#endif /* OTV0P2BASE_SENSORAMBIENTLIGHTOCCUPANCY_TUNEABLE_H */\n",
+        r.score, r.m.f1(), r.m.meanOnsetLagM(),
+        r.m.expectations - r.m.expectationErrors, r.m.expectations, r.m.samples,
+        unsigned(r.p.epsilon), unsigned(r.p.steadyTicksMinWithLightOn),
+        unsigned(r.p.steadyTicksMinForArtificialLight), unsigned(r.p.steadyTicksMinBeforeLightOn));
+    return(buf);
+    }
+
+}
+}
+
+#endif // PUT_OTRADIOLINK_AMBIENTLIGHTOCCUPANCYSWEEP_H
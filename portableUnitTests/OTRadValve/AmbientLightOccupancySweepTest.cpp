@@ -0,0 +1,173 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016--2018
+*/
+
+/*
+ * Parameter search over the ambient light occupancy detector tuneables.
+ *
+ * The ALOccSweep.Search test evaluates a modest grid by default;
+ * for a fuller search set:
+ *   * OTRL_ALOCC_SWEEP_GRID=1 to search the whole default grid
+ *   * OTRL_ALOCC_SWEEP_RANDOM=n to also evaluate n random points
+ *   * OTRL_ALOCC_SWEEP_OUT=path to write the best as a _Tuneable.h header
+ * Traces are found as for the ALOccBenchmark tests
+ * (OTRL_ALOCC_DATA_DIR and OTRL_ALOCC_TRACES).
+ */
+
+#include <cstdlib>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "AmbientLightOccupancyDetectionTestData.h"
+#include "AmbientLightOccupancySweep.h"
+
+namespace ALOST
+{
+// Build the corpus from the bundled and any external traces.
+static void loadCorpus(ALOBM::Sweep::Corpus &c)
+    {
+    c.addSamples("3lSetback", OTV0P2BASE::PortableUnitTest::DATA::getSamples("sample3lSetback"));
+    c.addSamples("a0", OTV0P2BASE::PortableUnitTest::DATA::getSamples("samplea0"));
+    c.addSamples("a1", OTV0P2BASE::PortableUnitTest::DATA::getSamples("samplea1"));
+    c.addSamples("a2", OTV0P2BASE::PortableUnitTest::DATA::getSamples("samplea2"));
+    c.addSamples("a3", OTV0P2BASE::PortableUnitTest::DATA::getSamples("samplea3"));
+    const char *const env = getenv("OTRL_ALOCC_DATA_DIR");
+    const std::string dir = (NULL != env) ? env : "portableUnitTests/20161009TestData";
+    static const char *const logTraces[] = { "2b", "3l", "5s", "6k" };
+    for(const char *const t : logTraces) { c.addLogFile((dir + "/" + t + ".L.dat").c_str()); }
+    const char *const extra = getenv("OTRL_ALOCC_TRACES");
+    if(NULL != extra)
+        {
+        const std::string list(extra);
+        for(size_t start = 0; start <= list.size(); )
+            {
+            size_t colon = list.find(':', start);
+            if(std::string::npos == colon) { colon = list.size(); }
+            const std::string path = list.substr(start, colon - start);
+            start = colon + 1;
+            if(!path.empty() && !c.addLogFile(path.c_str())) { ADD_FAILURE() << "cannot read " << path; }
+            }
+        }
+    }
+}
+
+// Check that the run-time parameterised detector matches the compiled-in one by default.
+TEST(ALOccSweep, ParameterisedMatchesSimple)
+{
+    typedef OTV0P2BASE::PortableUnitTest::ALDataSample ALDataSample;
+    OTV0P2BASE::SensorAmbientLightOccupancyDetectorSimple s;
+    OTV0P2BASE::SensorAmbientLightOccupancyDetectorParameterised p;
+    const uint8_t epsilon = s.epsilon;
+    const uint8_t steadyTicksMinWithLightOn = s.steadyTicksMinWithLightOn;
+    EXPECT_EQ(epsilon, p.params.epsilon);
+    EXPECT_EQ(steadyTicksMinWithLightOn, p.params.steadyTicksMinWithLightOn);
+    OTV0P2BASE::SensorAmbientLightOccupancyDetectorParameterised q(ALOBM::Params(1, 0, 10, 1));
+    bool differs = false;
+    unsigned n = 0;
+    for(const ALDataSample *dp = OTV0P2BASE::PortableUnitTest::DATA::getSamples("samplea0"); !dp->isEnd(); ++dp)
+        {
+        // Exercise the mean/min/max paths part of the time.
+        if(0 == (n++ % 64)) { const uint8_t m = uint8_t(n & 0x7f); s.setTypMinMax(m, 2, 200); p.setTypMinMax(m, 2, 200); q.setTypMinMax(m, 2, 200); }
+        const uint8_t l = OTV0P2BASE::fnmin(dp->L, uint8_t(254));
+        const auto os = s.update(l);
+        ASSERT_EQ(os, p.update(l)) << n;
+        ASSERT_EQ(s._getSteadyTicks(), p._getSteadyTicks()) << n;
+        if(os != q.update(l)) { differs = true; }
+        }
+    EXPECT_TRUE(differs);
+}
+
+// Check candidate generation.
+TEST(ALOccSweep, Candidates)
+{
+    const ALOBM::Sweep::Space s = { { 0, 4, 2 }, { 1, 2, 1 }, { 30, 30, 1 }, { 3, 9, 3 } };
+    const std::vector<ALOBM::Params> g = ALOBM::Sweep::grid(s);
+    // Epsilon 0 is invalid so only 2 * 2 * 1 * 3.
+    ASSERT_EQ(12U, g.size());
+    EXPECT_TRUE(ALOBM::Params(2, 1, 30, 3) == g.front());
+    EXPECT_TRUE(ALOBM::Params(4, 2, 30, 9) == g.back());
+    const std::vector<ALOBM::Params> r1 = ALOBM::Sweep::random(s, 50, 42);
+    const std::vector<ALOBM::Params> r2 = ALOBM::Sweep::random(s, 50, 42);
+    ASSERT_EQ(50U, r1.size());
+    for(size_t i = 0; i < r1.size(); ++i)
+        {
+        EXPECT_TRUE(r1[i] == r2[i]);
+        EXPECT_TRUE(r1[i].isValid());
+        EXPECT_TRUE((2 == r1[i].epsilon) || (4 == r1[i].epsilon));
+        EXPECT_EQ(0, (r1[i].steadyTicksMinBeforeLightOn % 3));
+        }
+}
+
+// Run a search, check that ranking is independent of thread count, and report the best.
+TEST(ALOccSweep, Search)
+{
+    ALOBM::Sweep::Corpus corpus;
+    ALOST::loadCorpus(corpus);
+    ASSERT_LT(0U, corpus.size());
+
+    // Small grid around the defaults usable in a routine test run.
+    const bool fullGrid = (NULL != getenv("OTRL_ALOCC_SWEEP_GRID"));
+    static constexpr ALOBM::Sweep::Space routine = { { 2, 8, 2 }, { 1, 5, 2 }, { 20, 40, 10 }, { 1, 5, 2 } };
+    std::vector<ALOBM::Params> candidates = ALOBM::Sweep::grid(fullGrid ? ALOBM::Sweep::defaultSpace : routine);
+    const char *const nRandom = getenv("OTRL_ALOCC_SWEEP_RANDOM");
+    if(NULL != nRandom)
+        {
+        const std::vector<ALOBM::Params> r = ALOBM::Sweep::random(ALOBM::Sweep::defaultSpace, size_t(atol(nRandom)));
+        candidates.insert(candidates.end(), r.begin(), r.end());
+        }
+    // Always include the current defaults for comparison.
+    candidates.push_back(ALOBM::Params());
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<ALOBM::Sweep::Result> results = ALOBM::Sweep::run(corpus, candidates);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ASSERT_EQ(candidates.size(), results.size());
+    std::printf("ALOccSweep %u configurations over %u traces in %.2fs\n",
+        unsigned(results.size()), unsigned(corpus.size()), seconds);
+
+    // The default's result is as for a direct evaluation.
+    const ALOBM::Metrics mDefault = corpus.evaluate(ALOBM::Params());
+    EXPECT_EQ(mDefault.samples, results.back().m.samples);
+    EXPECT_EQ(mDefault.falseOcc, results.back().m.falseOcc);
+    EXPECT_EQ(mDefault.onsetLagM, results.back().m.onsetLagM);
+
+    // Ranking is the same with one thread, on the first few candidates.
+    std::vector<ALOBM::Params> few(candidates.begin(), candidates.begin() + std::min<size_t>(12, candidates.size()));
+    std::vector<ALOBM::Sweep::Result> a = ALOBM::Sweep::run(corpus, few, 1);
+    std::vector<ALOBM::Sweep::Result> b = ALOBM::Sweep::run(corpus, few);
+    ALOBM::Sweep::rank(a);
+    ALOBM::Sweep::rank(b);
+    for(size_t i = 0; i < a.size(); ++i) { EXPECT_TRUE(a[i].p == b[i].p) << i; EXPECT_EQ(a[i].score, b[i].score) << i; }
+
+    ALOBM::Sweep::rank(results);
+    for(size_t i = 1; i < results.size(); ++i) { EXPECT_GE(results[i-1].score, results[i].score); }
+    for(size_t i = 0; i < std::min<size_t>(10, results.size()); ++i) { ALOBM::Sweep::print(unsigned(i + 1), results[i]); }
+    for(size_t i = 0; i < results.size(); ++i)
+        { if(results[i].p == ALOBM::Params()) { ALOBM::Sweep::print(unsigned(i + 1), results[i]); break; } }
+
+    const std::string header = ALOBM::Sweep::tuneableHeader(results.front());
+    EXPECT_NE(std::string::npos, header.find("#define SENSORAMBIENTLIGHTOCCUPANCY_EPSILON " + std::to_string(results.front().p.epsilon) + "\n"));
+    EXPECT_NE(std::string::npos, header.find("#endif /* OTV0P2BASE_SENSORAMBIENTLIGHTOCCUPANCY_TUNEABLE_H */"));
+    const char *const out = getenv("OTRL_ALOCC_SWEEP_OUT");
+    if(NULL != out)
+        {
+        FILE *const f = fopen(out, "w");
+        ASSERT_TRUE(NULL != f) << out;
+        fputs(header.c_str(), f);
+        fclose(f);
+        }
+}
@@ -124,6 +124,126 @@ TEST(BoilerDriverTest, boilerHubModeIncBoilerNoCallM)
     EXPECT_TRUE(bh.isBoilerOn());
 }
 
+// Test that the zoned driver tracks per-valve demand and aggregates it.
+TEST(BoilerDriverTest, zonedDemandTable)
+{
+    constexpr uint8_t heatCallPin = 0; // unused in unit tests.
+    typedef OTRadValve::BoilerLogic::ZonedBoilerDriverLogic<decltype(BoilerDriverTest::hm), BoilerDriverTest::hm, heatCallPin, 16> zb_t;
+    zb_t zb;
+    EXPECT_EQ(0, zb.getLiveValves());
+    EXPECT_EQ(NULL, zb.find(1));
+    // Fill all but one slot; the last is kept free.
+    for(uint16_t id = 0; id < 15; ++id) { EXPECT_TRUE(zb.remoteCallForHeatRX(id * 257, 10)); }
+    EXPECT_FALSE(zb.remoteCallForHeatRX(9999, 10));
+    EXPECT_EQ(15, zb.getLiveValves());
+    EXPECT_EQ(150, zb.getDemandPC());
+    // Updates replace the old value.
+    EXPECT_TRUE(zb.remoteCallForHeatRX(3 * 257, 40));
+    EXPECT_EQ(15, zb.getLiveValves());
+    EXPECT_EQ(180, zb.getDemandPC());
+    ASSERT_NE((const zb_t::Entry *)NULL, zb.find(3 * 257));
+    EXPECT_EQ(40, zb.find(3 * 257)->percentOpen);
+    // Invalid input is rejected.
+    EXPECT_FALSE(zb.remoteCallForHeatRX(zb_t::badID, 10));
+    EXPECT_FALSE(zb.remoteCallForHeatRX(1, 101));
+    // Refresh odd IDs just before the others expire, then let the even ones go.
+    for(uint8_t m = 0; m < zb_t::VALVE_TIMEOUT_M - 1; ++m) { zb.processCallsForHeat(true, true); }
+    for(uint16_t id = 1; id < 15; id += 2) { EXPECT_TRUE(zb.remoteCallForHeatRX(id * 257, 20)); }
+    zb.processCallsForHeat(true, true);
+    EXPECT_EQ(7, zb.getLiveValves());
+    EXPECT_EQ(140, zb.getDemandPC());
+    // Every survivor must still be found after expired entries are removed.
+    for(uint16_t id = 0; id < 15; ++id) {
+        EXPECT_EQ((1 == (id & 1)), (NULL != zb.find(id * 257))) << id;
+    }
+    for(uint8_t m = 0; m < zb_t::VALVE_TIMEOUT_M; ++m) { zb.processCallsForHeat(true, true); }
+    EXPECT_EQ(0, zb.getLiveValves());
+    EXPECT_EQ(0, zb.getDemandPC());
+}
+
+// Test that the zoned driver fires on aggregate demand with hysteresis and minimum run times.
+TEST(BoilerDriverTest, zonedHeatCall)
+{
+    constexpr uint8_t heatCallPin = 0; // unused in unit tests.
+    constexpr bool inHubMode = true;
+    const uint8_t minMins = BoilerDriverTest::hm.getMinBoilerOnMinutes();
+    OTRadValve::BoilerLogic::ZonedBoilerDriverLogic<decltype(BoilerDriverTest::hm), BoilerDriverTest::hm, heatCallPin> zb;
+    // Let the minimum off time from power-up pass.
+    for(uint8_t m = 0; m <= minMins; ++m) { zb.processCallsForHeat(true, inHubMode); }
+    // One valve a little open is not enough alone.
+    zb.remoteCallForHeatRX(1, 60);
+    zb.processCallsForHeat(false, inHubMode);
+    EXPECT_FALSE(zb.isBoilerOn());
+    EXPECT_EQ(0, zb.getDemandStage());
+    // Two such valves together are.
+    zb.remoteCallForHeatRX(2, 60);
+    zb.processCallsForHeat(false, inHubMode);
+    EXPECT_TRUE(zb.isBoilerOn());
+    EXPECT_EQ(1, zb.getDemandStage());
+    // More demand raises the stage.
+    zb.remoteCallForHeatRX(3, 100);
+    zb.remoteCallForHeatRX(4, 100);
+    zb.processCallsForHeat(false, inHubMode);
+    EXPECT_EQ(2, zb.getDemandStage());
+    // Demand dropping below the start level but above the hold level keeps the boiler on.
+    zb.remoteCallForHeatRX(1, 0);
+    zb.remoteCallForHeatRX(3, 0);
+    zb.remoteCallForHeatRX(4, 0);
+    for(uint8_t m = 0; m <= minMins + 1; ++m) { zb.processCallsForHeat(true, inHubMode); }
+    EXPECT_TRUE(zb.isBoilerOn());
+    // Dropping all demand turns the boiler off, but not before its minimum on time.
+    zb.remoteCallForHeatRX(2, 0);
+    zb.processCallsForHeat(false, inHubMode);
+    EXPECT_FALSE(zb.isBoilerOn());
+    // Demand straight back is held off for the minimum off time.
+    zb.remoteCallForHeatRX(2, 100);
+    for(uint8_t m = 0; m < minMins; ++m) {
+        zb.processCallsForHeat(true, inHubMode);
+        EXPECT_FALSE(zb.isBoilerOn());
+    }
+    zb.processCallsForHeat(true, inHubMode);
+    EXPECT_TRUE(zb.isBoilerOn());
+    // Not in hub mode nothing changes.
+    zb.remoteCallForHeatRX(2, 0);
+    for(int i = 0; i < 1000; ++i) { zb.processCallsForHeat(true, false); }
+    EXPECT_TRUE(zb.isBoilerOn());
+}
+
+// Test that the zoned driver weights old reports down and recycles expired slots.
+TEST(BoilerDriverTest, zonedTimeWeighting)
+{
+    constexpr uint8_t heatCallPin = 0; // unused in unit tests.
+    constexpr bool inHubMode = true;
+    const uint8_t minMins = BoilerDriverTest::hm.getMinBoilerOnMinutes();
+    typedef OTRadValve::BoilerLogic::ZonedBoilerDriverLogic<decltype(BoilerDriverTest::hm), BoilerDriverTest::hm, heatCallPin, 4> zb_t;
+    zb_t zb;
+    for(uint8_t m = 0; m <= minMins; ++m) { zb.processCallsForHeat(true, inHubMode); }
+    // A marginal call from one valve that has gone quiet counts for half...
+    zb.remoteCallForHeatRX(1, 60);
+    for(uint8_t m = 0; m < zb_t::FRESH_M; ++m) { zb.processCallsForHeat(true, inHubMode); }
+    EXPECT_FALSE(zb.isBoilerOn());
+    EXPECT_EQ(60, zb.getDemandPC());
+    EXPECT_EQ(30, zb.getWeightedDemandPC());
+    // ...so is not enough with a second such valve...
+    zb.remoteCallForHeatRX(2, 60);
+    zb.processCallsForHeat(false, inHubMode);
+    EXPECT_FALSE(zb.isBoilerOn());
+    // ...until the first reports again.
+    zb.remoteCallForHeatRX(1, 60);
+    zb.processCallsForHeat(false, inHubMode);
+    EXPECT_TRUE(zb.isBoilerOn());
+    // Once everything has expired the (small) table can be refilled with new IDs.
+    for(uint8_t m = 0; m < zb_t::VALVE_TIMEOUT_M; ++m) { zb.processCallsForHeat(true, inHubMode); }
+    EXPECT_EQ(0, zb.getLiveValves());
+    EXPECT_EQ(0, zb.getDemandPC());
+    for(uint16_t id = 10; id < 13; ++id) { EXPECT_TRUE(zb.remoteCallForHeatRX(id, 10)) << id; }
+    EXPECT_FALSE(zb.remoteCallForHeatRX(13, 10));
+    EXPECT_EQ(3, zb.getLiveValves());
+    EXPECT_EQ(30, zb.getDemandPC());
+    EXPECT_EQ(NULL, zb.find(1));
+    EXPECT_NE((const zb_t::Entry *)NULL, zb.find(12));
+}
+
 #if 1  // Stack usage checks
 // Measure stack usage of remoteCallForHeatRX.
 // (DE20170609): 80 bytes
@@ -133,6 +133,25 @@ TEST(CurrentSenseValveMotorDirect,REV7CSVMDC)
   //    ticksFromClosedToOpen: 1295
 }
 
+// Check that the reciprocal-multiply position computation matches plain division,
+// including either side of the largest calibration it is used for.
+TEST(CurrentSenseValveMotorDirect,computePositionReciprocal)
+{
+    static constexpr uint16_t maxR = OTRadValve::CurrentSenseValveMotorDirect::CalibrationParameters::reciprocal_max_ticks;
+    const uint16_t tfos[] = { 16, 99, 100, 101, 1529, 1803, maxR - 1, maxR, 20000, 65535 };
+    for(const uint16_t tfo : tfos)
+        {
+        OTRadValve::CurrentSenseValveMotorDirect::CalibrationParameters cp;
+        cp.updateAndCompute(tfo, tfo, 8);
+        for(uint32_t t = 0; t <= tfo; ++t)
+            {
+            volatile uint16_t ticksFromOpen = uint16_t(t), ticksReverse = 0;
+            const uint8_t expected = (0 == t) ? 100 : uint8_t(((tfo - t) * 100UL) / tfo);
+            ASSERT_EQ(expected, cp.computePosition(ticksFromOpen, ticksReverse)) << tfo << " " << t;
+            }
+        }
+}
+
 class DummyHardwareDriver : public OTRadValve::HardwareMotorDriverInterface
   {
   public:
@@ -873,3 +892,201 @@ TEST(CurrentSenseValveMotorDirect,noFlappingOn1PercentDither)
         }
 
 }
+
+// Check that the movement planner coalesces target changes,
+// honours end-stop targets immediately,
+// applies a wider deadband when asked to,
+// and counts motor runs for battery-cost estimates.
+TEST(CurrentSenseValveMotorDirect,movementPlanner)
+{
+    SVL svl;
+    svl.setAllLowFlags(false);
+
+    const uint8_t subcycleTicksRoundedDown_ms = 7; // For REV7: OTV0P2BASE::SUBCYCLE_TICK_MS_RD.
+    const uint8_t gsct_max = 255; // For REV7: OTV0P2BASE::GSCT_MAX.
+    const uint8_t minimumMotorRunupTicks = 4; // For REV7: OTRadValve::ValveMotorDirectV1HardwareDriverBase::minMotorRunupTicks.
+    HardwareDriverSim shw;
+    shw.reset(HardwareDriverSim::SYMMETRIC_LOSSLESS);
+    const uint8_t minMotorDRTicks = OTRadValve::CurrentSenseValveMotorDirectBinaryOnly::computeMinMotorDRTicks(subcycleTicksRoundedDown_ms);
+    OTRadValve::CurrentSenseValveMotorDirect csv(&shw, dummyGetSubCycleTime,
+        minMotorDRTicks,
+        OTRadValve::CurrentSenseValveMotorDirectBinaryOnly::computeSctAbsLimit(subcycleTicksRoundedDown_ms,
+                                                                     gsct_max,
+                                                                     minimumMotorRunupTicks),
+        &svl,
+        [](){return(false);});
+    EXPECT_EQ(0, csv.getMotorRuns());
+    for(int i = 100; --i > 0 && !csv.isInNormalRunState(); )
+        {
+        if(csv.isWaitingForValveToBeFitted()) { csv.signalValveFitted(); }
+        csv.poll();
+        }
+    ASSERT_TRUE(csv.isInNormalRunState());
+    ASSERT_FALSE(csv.inNonProportionalMode());
+    // Calibration alone needs lots of runs.
+    EXPECT_LT(10, csv.getMotorRuns());
+    EXPECT_EQ((uint32_t)csv.getMotorRuns() * minMotorDRTicks, csv.getMotorRunTicksEstimate());
+
+    // Settle at a mid position without coalescing.
+    csv.setTargetPC(50);
+    for(int i = 0; i < 200; ++i) { csv.poll(); }
+    const uint8_t settled = csv.getCurrentPC();
+    EXPECT_TRUE(OTRadValve::CurrentSenseValveMotorDirect::closeEnoughToTarget(50, settled));
+
+    // With a window of 5 polls a burst of changes causes no move until the window elapses,
+    // and only the last target is acted upon.
+    csv.setCoalescePolls(5);
+    csv.setTargetPC(70);
+    csv.setTargetPC(75);
+    EXPECT_EQ(50, csv.getTargetPC());
+    EXPECT_EQ(75, csv.getPendingTargetPC());
+    const uint16_t runsBefore = csv.getMotorRuns();
+    for(int i = 0; i < 4; ++i) { csv.poll(); }
+    EXPECT_EQ(runsBefore, csv.getMotorRuns());
+    EXPECT_EQ(50, csv.getTargetPC());
+    csv.poll();
+    EXPECT_EQ(75, csv.getTargetPC());
+    EXPECT_LT(runsBefore, csv.getMotorRuns());
+    for(int i = 0; i < 200; ++i) { csv.poll(); }
+    EXPECT_TRUE(OTRadValve::CurrentSenseValveMotorDirect::closeEnoughToTarget(75, csv.getCurrentPC()));
+
+    // A change that is reverted within the window never moves the motor.
+    const uint16_t runsReverted = csv.getMotorRuns();
+    csv.setTargetPC(40);
+    csv.poll();
+    csv.setTargetPC(75);
+    for(int i = 0; i < 20; ++i) { csv.poll(); }
+    EXPECT_EQ(runsReverted, csv.getMotorRuns());
+
+    // End-stop targets are taken immediately.
+    csv.setTargetPC(100);
+    EXPECT_EQ(100, csv.getTargetPC());
+
+    // Deadband adapts to the calibrated precision and is capped.
+    const uint8_t eps = csv._getCP().getApproxPrecisionPC();
+    EXPECT_EQ(eps, csv.getDeadbandPC());
+    csv.setDeadbandPrecisions(0);
+    EXPECT_EQ(eps, csv.getDeadbandPC());
+    csv.setDeadbandPrecisions(255);
+    EXPECT_EQ(OTV0P2BASE::fnmin((int)OTRadValve::CurrentSenseValveMotorDirect::absTolerancePC, 8*eps), csv.getDeadbandPC());
+
+    // With a wide deadband, small target changes away from the end-stops cause no move.
+    csv.setCoalescePolls(0);
+    csv.setTargetPC(50);
+    for(int i = 0; i < 200; ++i) { csv.poll(); }
+    const uint8_t mid = csv.getCurrentPC();
+    const uint16_t runsMid = csv.getMotorRuns();
+    csv.setTargetPC((uint8_t)(mid + csv.getDeadbandPC()));
+    for(int i = 0; i < 50; ++i) { csv.poll(); }
+    EXPECT_EQ(runsMid, csv.getMotorRuns());
+    EXPECT_EQ(mid, csv.getCurrentPC());
+}
+
+// Run a new driver instance over the given hardware and store into normal state,
+// as on a restart, and return the motor runs taken.
+static uint16_t restartToNormal(HardwareDriverSim *const shw, OTRadValve::ValveCalibrationStoreBase *const store)
+    {
+    const uint8_t subcycleTicksRoundedDown_ms = 7; // For REV7: OTV0P2BASE::SUBCYCLE_TICK_MS_RD.
+    const uint8_t gsct_max = 255; // For REV7: OTV0P2BASE::GSCT_MAX.
+    const uint8_t minimumMotorRunupTicks = 4; // For REV7: OTRadValve::ValveMotorDirectV1HardwareDriverBase::minMotorRunupTicks.
+    OTRadValve::CurrentSenseValveMotorDirect csv(shw, dummyGetSubCycleTime,
+        OTRadValve::CurrentSenseValveMotorDirectBinaryOnly::computeMinMotorDRTicks(subcycleTicksRoundedDown_ms),
+        OTRadValve::CurrentSenseValveMotorDirectBinaryOnly::computeSctAbsLimit(subcycleTicksRoundedDown_ms,
+                                                                     gsct_max,
+                                                                     minimumMotorRunupTicks),
+        NULL,
+        [](){return(false);},
+        store);
+    for(int i = 200; --i > 0 && !csv.isInNormalRunState(); )
+        {
+        if(csv.isWaitingForValveToBeFitted()) { csv.signalValveFitted(); }
+        csv.poll();
+        }
+    EXPECT_TRUE(csv.isInNormalRunState());
+    EXPECT_FALSE(csv.inNonProportionalMode());
+    EXPECT_NEAR(csv._getCP().getTicksFromOpenToClosed(), shw->getNominalTicksToClosed(), shw->nominalFullTravelTicks / 4);
+    // Check that the valve can still be positioned.
+    csv.setTargetPC(50);
+    for(int i = 0; i < 200; ++i) { csv.poll(); }
+    EXPECT_TRUE(OTRadValve::CurrentSenseValveMotorDirect::closeEnoughToTarget(50, csv.getCurrentPC()));
+    EXPECT_TRUE(OTRadValve::CurrentSenseValveMotorDirect::closeEnoughToTarget(csv.getCurrentPC(), shw->getNominalPercentOpen()));
+    return(csv.getMotorRuns());
+    }
+
+// Check that a cached calibration shortens warm restarts,
+// and is ignored when corrupt or too often reused.
+TEST(CurrentSenseValveMotorDirect,calibrationCache)
+{
+    HardwareDriverSim shw;
+    shw.reset(HardwareDriverSim::SYMMETRIC_LOSSLESS);
+    OTRadValve::ValveCalibrationStoreMock store;
+
+    // Without a cache, a full calibration is done and cached.
+    restartToNormal(&shw, &store);
+    EXPECT_NE(0xff, store._getRecord()[5]);
+    EXPECT_EQ(0, store._getRecord()[4]);
+    // Motor runs for a restart with full calibration.
+    // (The very first run from power-up may differ.)
+    const uint16_t coldRuns = restartToNormal(&shw, NULL);
+
+    // Warm restarts reuse the cache, saving the run back to open.
+    for(uint8_t i = 0; i < 8; ++i)
+        {
+        const uint16_t warmRuns = restartToNormal(&shw, &store);
+        EXPECT_LT(warmRuns + coldRuns / 4, coldRuns);
+        EXPECT_EQ(i + 1, store._getRecord()[4]);
+        }
+    // Once used too often a full calibration is forced, and resets the count.
+    EXPECT_NEAR(coldRuns, restartToNormal(&shw, &store), coldRuns / 8);
+    EXPECT_EQ(0, store._getRecord()[4]);
+
+    // A corrupt cache is ignored and is rewritten after a full calibration.
+    store._getRecord()[0] ^= 0x10;
+    EXPECT_NEAR(coldRuns, restartToNormal(&shw, &store), coldRuns / 8);
+    EXPECT_GT(coldRuns, restartToNormal(&shw, &store) + coldRuns / 4);
+
+    // A cache inconsistent with the valve travel is ignored.
+    OTRadValve::ValveCalibrationStoreMock other;
+    const uint8_t bogus[OTRadValve::ValveCalibrationStoreBase::recordBytes] = { 0xff, 0xff, 0, 0, 0, 0 };
+    other.write(bogus);
+    EXPECT_NEAR(coldRuns, restartToNormal(&shw, &other), coldRuns / 8);
+    memcpy(other._getRecord(), store._getRecord(), OTRadValve::ValveCalibrationStoreBase::recordBytes);
+    const uint16_t tfotc = other._getRecord()[0] | (other._getRecord()[1] << 8);
+    const uint16_t doubled = uint16_t(tfotc * 2);
+    uint8_t longer[OTRadValve::ValveCalibrationStoreBase::recordBytes];
+    memcpy(longer, other._getRecord(), sizeof(longer));
+    longer[0] = uint8_t(doubled);
+    longer[1] = uint8_t(doubled >> 8);
+    longer[4] = 0;
+    longer[5] = OTV0P2BASE::crc7_5B_update_nz_final(OTV0P2BASE::crc7_5B_buf(0, longer, 4), longer[4]);
+    other.write(longer);
+    EXPECT_NEAR(coldRuns, restartToNormal(&shw, &other), coldRuns / 8);
+}
+
+// The motor driver defers whole polls while another high-current load
+// holds the supply current budget, and resumes once it is released.
+TEST(CurrentSenseValveMotorDirect,supplyCurrentBudgetDeferral)
+{
+    const uint8_t subcycleTicksRoundedDown_ms = 7; // For REV7: OTV0P2BASE::SUBCYCLE_TICK_MS_RD.
+    const uint8_t gsct_max = 255; // For REV7: OTV0P2BASE::GSCT_MAX.
+    const uint8_t minimumMotorRunupTicks = 4; // For REV7: OTRadValve::ValveMotorDirectV1HardwareDriverBase::minMotorRunupTicks.
+    DummyHardwareDriver dhw;
+    OTRadValve::CurrentSenseValveMotorDirect csvmd(&dhw, dummyGetSubCycleTime,
+        OTRadValve::CurrentSenseValveMotorDirectBinaryOnly::computeMinMotorDRTicks(subcycleTicksRoundedDown_ms),
+        OTRadValve::CurrentSenseValveMotorDirectBinaryOnly::computeSctAbsLimit(subcycleTicksRoundedDown_ms,
+                                                                     gsct_max,
+                                                                     minimumMotorRunupTicks));
+    EXPECT_EQ(OTRadValve::CurrentSenseValveMotorDirectBinaryOnly::init, csvmd._getState());
+    OTV0P2BASE::supplyCurrentBudget.setLimit(OTV0P2BASE::CurrentBudget::LIMIT_ONE_BIG_LOAD);
+    {
+    // Eg a radio TX in progress.
+    const OTV0P2BASE::CurrentBudgetClaim tx(OTV0P2BASE::CurrentLoad::RADIO_TX);
+    ASSERT_TRUE(tx.isGranted());
+    csvmd.poll();
+    EXPECT_EQ(OTRadValve::CurrentSenseValveMotorDirectBinaryOnly::init, csvmd._getState());
+    }
+    csvmd.poll();
+    EXPECT_EQ(OTRadValve::CurrentSenseValveMotorDirectBinaryOnly::initWaiting, csvmd._getState());
+    EXPECT_EQ(0, OTV0P2BASE::supplyCurrentBudget.getInUse());
+    OTV0P2BASE::supplyCurrentBudget.setLimit(OTV0P2BASE::CurrentBudget::LIMIT_NONE);
+}
@@ -0,0 +1,217 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Tests of the multi-house-code FHT8V scheduler and controller.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <gtest/gtest.h>
+#include <OTRadioLink.h>
+#include "OTRadValve_FHT8VMultiValve.h"
+
+#include "../OTRadioLink/SecureFrameTestDoubles.h"
+
+namespace FMV
+{
+typedef OTRadValve::FHT8VMultiValveScheduler<8> Sched8;
+
+// One command as sent, with the slot it was sent in.
+struct Sent { uint32_t slot; uint8_t valve; bool sync; uint8_t command; uint8_t extension; };
+
+// Run n slots, recording every command and checking the per-slot limit.
+template<class S, uint8_t maxTXPerSlot = 3>
+void run(S &s, const uint32_t n, std::vector<Sent> &log)
+    {
+    typename S::TX tx[maxTXPerSlot];
+    for(uint32_t i = 0; i < n; ++i)
+        {
+        const uint32_t slot = s.getNow();
+        const uint8_t k = s.nextSlot(tx);
+        ASSERT_LE(k, maxTXPerSlot);
+        for(uint8_t j = 0; j < k; ++j)
+            { log.push_back({ slot, tx[j].valve, tx[j].sync, tx[j].command.command, tx[j].command.extension }); }
+        }
+    }
+
+// Decode each FS20 frame recorded by r.
+static std::vector<OTRadValve::FHT8VRadValveUtil::fht8v_msg_t> decodeFrames(const SFTD::CaptureRadio &r)
+    {
+    std::vector<OTRadValve::FHT8VRadValveUtil::fht8v_msg_t> out;
+    for(const auto &f : r.frames)
+        {
+        OTRadValve::FHT8VRadValveUtil::fht8v_msg_t m;
+        EXPECT_TRUE(NULL != OTRadValve::FHT8VRadValveUtil::FHT8VDecodeBitStream(f.data(), f.data() + f.size() - 1, &m));
+        out.push_back(m);
+        }
+    return(out);
+    }
+}
+
+// Bad, duplicate and excess house codes are refused.
+TEST(FHT8VMultiValve,addRemove)
+{
+    OTRadValve::FHT8VMultiValveScheduler<2> s;
+    EXPECT_EQ(-1, s.addValve(100, 1));
+    EXPECT_EQ(-1, s.addValve(1, 100));
+    EXPECT_EQ(-1, s.addValve(1, 1, 101));
+    EXPECT_EQ(0, s.addValve(13, 73));
+    EXPECT_EQ(-1, s.addValve(13, 73));
+    EXPECT_EQ(1, s.addValve(13, 74));
+    EXPECT_EQ(-1, s.addValve(13, 75));
+    EXPECT_TRUE(s.removeValve(0));
+    EXPECT_FALSE(s.removeValve(0));
+    EXPECT_FALSE(s.set(0, 50));
+    EXPECT_EQ(0, s.addValve(13, 75, 20));
+    EXPECT_EQ(20, s.get(0));
+    EXPECT_FALSE(s.set(0, 101));
+    EXPECT_TRUE(s.set(0, 100));
+    EXPECT_FALSE(s.isSynced(0));
+}
+
+// One valve follows the same timeline as FHT8VRadValve:
+// 120 countdown frames 1s apart, the sync final (HC2 & 7) + 4 seconds after,
+// then valve-setting frames every 115 + (HC2 & 7) / 2 seconds.
+TEST(FHT8VMultiValve,singleValveTimeline)
+{
+    FMV::Sched8 s;
+    ASSERT_EQ(0, s.addValve(13, 73, 100));
+    std::vector<FMV::Sent> log;
+    FMV::run(s, 2000, log);
+    ASSERT_LT(122U, log.size());
+    for(uint8_t i = 0; i < 120; ++i)
+        {
+        EXPECT_EQ(uint32_t(2 * i), log[i].slot);
+        EXPECT_TRUE(log[i].sync);
+        EXPECT_EQ(0x2c, log[i].command);
+        EXPECT_EQ(241 - 2 * i, log[i].extension);
+        }
+    const uint32_t finalSlot = 239 + (73 & 7) + 8;
+    EXPECT_EQ(finalSlot, log[120].slot);
+    EXPECT_EQ(0x20, log[120].command);
+    EXPECT_EQ(0, log[120].extension);
+    for(size_t i = 121; i < log.size(); ++i)
+        {
+        EXPECT_EQ(finalSlot + (i - 120) * (230 + (73 & 7)), log[i].slot);
+        EXPECT_FALSE(log[i].sync);
+        EXPECT_EQ(0x26, log[i].command);
+        EXPECT_EQ(255, log[i].extension);
+        }
+    EXPECT_TRUE(s.isSynced(0));
+    EXPECT_EQ(0U, s.getLostSyncCount());
+}
+
+// Many valves with the same TX period share one radio:
+// all sync, are staggered onto distinct slots, and never exceed the per-slot limit.
+TEST(FHT8VMultiValve,manyValvesInterleaved)
+{
+    FMV::Sched8 s;
+    for(uint8_t i = 0; i < 8; ++i) { ASSERT_EQ(i, s.addValve(uint8_t(10 + i), 73, uint8_t(10 * i))); }
+    std::vector<FMV::Sent> log;
+    FMV::run(s, 2000, log);
+    for(uint8_t i = 0; i < 8; ++i) { EXPECT_TRUE(s.isSynced(i)) << int(i); }
+    // Once all are synced, valve-setting frames never share a slot, and each valve keeps its period.
+    std::vector<uint32_t> last(8, 0);
+    uint32_t prevSlot = 0xffffffff;
+    for(const FMV::Sent &e : log)
+        {
+        if(0x26 != e.command) { continue; }
+        EXPECT_NE(prevSlot, e.slot);
+        prevSlot = e.slot;
+        if(0 != last[e.valve]) { EXPECT_EQ(last[e.valve] + 230 + (73 & 7), e.slot); }
+        last[e.valve] = e.slot;
+        EXPECT_EQ(OTRadValve::FHT8VRadValveUtil::convertPercentTo255Scale(uint8_t(10 * e.valve)), e.extension);
+        }
+    EXPECT_EQ(0U, s.getLostSyncCount());
+}
+
+// With more frames due than fit in one slot, the overflow goes one slot late and is still sent.
+TEST(FHT8VMultiValve,slotOverflow)
+{
+    OTRadValve::FHT8VMultiValveScheduler<4, 1> s;
+    // Different periods, so with the timeline long enough they must coincide at some point.
+    for(uint8_t i = 0; i < 4; ++i) { ASSERT_EQ(i, s.addValve(uint8_t(20 + i), uint8_t(i))); }
+    std::vector<FMV::Sent> log;
+    FMV::run<OTRadValve::FHT8VMultiValveScheduler<4, 1>, 1>(s, 20000, log);
+    for(uint8_t i = 0; i < 4; ++i) { EXPECT_TRUE(s.isSynced(i)) << int(i); }
+    EXPECT_EQ(0U, s.getLostSyncCount());
+    // Each valve-setting frame is within one slot of its own timeline.
+    std::vector<uint32_t> first(4, 0), count(4, 0);
+    for(const FMV::Sent &e : log)
+        {
+        if(0x26 != e.command) { continue; }
+        if(0 == count[e.valve]) { first[e.valve] = e.slot; }
+        const uint32_t expected = first[e.valve] + count[e.valve] * (230U + e.valve);
+        EXPECT_LE(expected, e.slot + 1);
+        EXPECT_GE(expected + 1, e.slot);
+        ++count[e.valve];
+        }
+}
+
+// A valve whose frames are missed (hub busy) loses sync, is resynced, and carries on.
+TEST(FHT8VMultiValve,lostSyncRecovery)
+{
+    FMV::Sched8 s;
+    ASSERT_EQ(0, s.addValve(13, 73, 50));
+    ASSERT_EQ(1, s.addValve(14, 72, 50));
+    std::vector<FMV::Sent> log;
+    FMV::run(s, 800, log);
+    ASSERT_TRUE(s.isSynced(0));
+    ASSERT_TRUE(s.isSynced(1));
+    // One missed frame is tolerated.
+    s.skipSlots(240);
+    FMV::run(s, 1, log);
+    EXPECT_TRUE(s.isSynced(0));
+    EXPECT_EQ(1, s.getMissedTX(0));
+    // Missing a second in a row means resync.
+    s.skipSlots(250);
+    FMV::run(s, 1, log);
+    EXPECT_FALSE(s.isSynced(0));
+    EXPECT_FALSE(s.isSynced(1));
+    EXPECT_EQ(2U, s.getLostSyncCount());
+    FMV::run(s, 600, log);
+    EXPECT_TRUE(s.isSynced(0));
+    EXPECT_TRUE(s.isSynced(1));
+    EXPECT_EQ(0, s.getMissedTX(0));
+    // An explicit resync starts over.
+    s.resync(1);
+    EXPECT_FALSE(s.isSynced(1));
+}
+
+// The controller sends decodable frames, sync frames at maximum power.
+TEST(FHT8VMultiValve,controller)
+{
+    OTRadValve::FHT8VMultiValveController<4> c;
+    SFTD::CaptureRadio r;
+    ASSERT_EQ(0, c.valves().addValve(13, 73, 100));
+    // No radio: nothing sent but time moves on.
+    EXPECT_EQ(0, c.poll());
+    c.setRadio(&r);
+    for(int i = 0; i < 600; ++i) { c.poll(); }
+    const auto frames = FMV::decodeFrames(r);
+    ASSERT_LT(3U, frames.size());
+    EXPECT_EQ(13, frames[0].hc1);
+    EXPECT_EQ(73, frames[0].hc2);
+    EXPECT_EQ(0x2c, frames[0].command);
+    EXPECT_EQ(OTRadioLink::OTRadioLink::TXmax, r.powers[0]);
+    EXPECT_EQ(0x26, frames.back().command);
+    EXPECT_EQ(255, frames.back().extension);
+    EXPECT_EQ(OTRadioLink::OTRadioLink::TXnormal, r.powers.back());
+}
@@ -422,3 +422,139 @@ TEST(FHT8VRadValve,FHTEncodingHeadAndTail)
 //    #endif
 //    #endif
 }
+
+// Test that a valve-setting command can be re-encoded in place for a new position
+// from its saved prefix, identically to encoding it from scratch.
+TEST(FHT8VRadValve,FHTEncodingPrefixReuse)
+{
+    uint8_t full[OTRadValve::FHT8VRadValveUtil::MIN_FHT8V_200US_BIT_STREAM_BUF_SIZE];
+    uint8_t patched[OTRadValve::FHT8VRadValveUtil::MIN_FHT8V_200US_BIT_STREAM_BUF_SIZE];
+    OTRadValve::FHT8VRadValveUtil::fht8v_msg_t command;
+    OTRadValve::FHT8VRadValveUtil::fht8v_msg_t commandDecoded;
+    const uint8_t hcs[] = { 0, 1, 13, 73, 98, 99, 0xff };
+    for(const uint8_t hc1 : hcs) for(const uint8_t hc2 : hcs)
+        {
+        command.hc1 = hc1;
+        command.hc2 = hc2;
+#ifdef OTV0P2BASE_FHT8V_ADR_USED
+        command.address = 0;
+#endif
+        command.command = 0x26;
+        command.extension = 0;
+        uint8_t *const partial = OTRadValve::FHT8VRadValveUtil::FHT8VCreate200usBitStreamPrefixBptr(patched, &command);
+        const uint8_t prefixLen = uint8_t(partial - patched);
+        ASSERT_GT(int(OTRadValve::FHT8VRadValveUtil::MAX_FHT8V_200US_BIT_STREAM_PREFIX_BYTES), prefixLen);
+        const uint8_t partialValue = *partial;
+        for(int pc = 0; pc <= 100; ++pc)
+            {
+            command.extension = OTRadValve::FHT8VRadValveUtil::convertPercentTo255Scale(uint8_t(pc));
+            const uint8_t *const endFull = OTRadValve::FHT8VRadValveUtil::FHT8VCreate200usBitStreamBptr(full, &command);
+            // Patch the previous frame in place.
+            *partial = partialValue;
+            const uint8_t *const endPatched = OTRadValve::FHT8VRadValveUtil::FHT8VAppend200usBitStreamExtensionBptr(partial, &command);
+            ASSERT_EQ(endFull - full, endPatched - patched);
+            ASSERT_EQ(0, memcmp(full, patched, size_t(endFull - full) + 1)) << int(hc1) << ' ' << int(hc2) << ' ' << pc;
+            ASSERT_TRUE(OTRadValve::FHT8VRadValveUtil::FHT8VDecodeBitStream(patched, patched + sizeof(patched) - 1, &commandDecoded));
+            EXPECT_EQ(hc1, commandDecoded.hc1);
+            EXPECT_EQ(hc2, commandDecoded.hc2);
+            EXPECT_EQ(command.extension, commandDecoded.extension);
+            }
+        }
+}
+
+// Check that the table-driven decoder matches the bitwise one on buf[0..lastIndex].
+static void checkFHT8VDecodersAgree(const uint8_t *const buf, const size_t lastIndex)
+{
+    OTRadValve::FHT8VRadValveUtil::fht8v_msg_t a, b;
+    memset(&a, 0, sizeof(a));
+    memset(&b, 0, sizeof(b));
+    const uint8_t *const ra = OTRadValve::FHT8VRadValveUtil::FHT8VDecodeBitStream(buf, buf + lastIndex, &a);
+    const uint8_t *const rb = OTRadValve::FHT8VRadValveUtil::FHT8VDecodeBitStreamLUT(buf, buf + lastIndex, &b);
+    ASSERT_EQ(ra, rb);
+    if(NULL == ra) { return; }
+    EXPECT_EQ(a.hc1, b.hc1);
+    EXPECT_EQ(a.hc2, b.hc2);
+#ifdef OTV0P2BASE_FHT8V_ADR_USED
+    EXPECT_EQ(a.address, b.address);
+#endif
+    EXPECT_EQ(a.command, b.command);
+    EXPECT_EQ(a.extension, b.extension);
+}
+
+// Test that the table-driven decoder accepts and rejects exactly what the bitwise one does,
+// with the same trailing-data pointer,
+// for the FHTEncoding vectors and single-bit corruptions and truncations of them.
+TEST(FHT8VRadValve,FHTDecodingLUT)
+{
+    uint8_t buf[OTRadValve::FHT8VRadValveUtil::MIN_FHT8V_200US_BIT_STREAM_BUF_SIZE];
+    OTRadValve::FHT8VRadValveUtil::fht8v_msg_t command;
+    OTRadValve::FHT8VRadValveUtil::fht8v_msg_t commandDecoded;
+    const uint8_t vectors[][4] = { { 0, 0, 0, 0 }, { 0xff, 0xff, 0xff, 0xff }, { 13, 73, 0x26, 0 }, { 99, 1, 0x26, 0xb4 } };
+    for(const auto &v : vectors)
+        {
+        command.hc1 = v[0];
+        command.hc2 = v[1];
+#ifdef OTV0P2BASE_FHT8V_ADR_USED
+        command.address = 0;
+#endif
+        command.command = v[2];
+        command.extension = v[3];
+        memset(buf, 0, sizeof(buf));
+        const uint8_t *const end = OTRadValve::FHT8VRadValveUtil::FHT8VCreate200usBitStreamBptr(buf, &command);
+        const uint8_t *const trailer = OTRadValve::FHT8VRadValveUtil::FHT8VDecodeBitStreamLUT(buf, buf + sizeof(buf) - 1, &commandDecoded);
+        ASSERT_TRUE(NULL != trailer);
+        // The trailer is decoded from the byte before the terminator or the one before that.
+        EXPECT_GE(end, trailer);
+        EXPECT_EQ(v[0], commandDecoded.hc1);
+        EXPECT_EQ(v[1], commandDecoded.hc2);
+        EXPECT_EQ(v[2], commandDecoded.command);
+        EXPECT_EQ(v[3], commandDecoded.extension);
+        checkFHT8VDecodersAgree(buf, sizeof(buf) - 1);
+        // Truncated.
+        for(size_t last = 0; last < size_t(end - buf); ++last) { checkFHT8VDecodersAgree(buf, last); }
+        // Each single bit flipped, including in the padding.
+        for(size_t i = 0; i <= size_t(end - buf); ++i)
+            for(uint8_t m = 1; m != 0; m = uint8_t(m << 1))
+                {
+                buf[i] ^= m;
+                checkFHT8VDecodersAgree(buf, sizeof(buf) - 1);
+                buf[i] ^= m;
+                }
+        // Leading encoded 0s dropped, one at a time.
+        for(size_t skip = 0; skip < 6; ++skip) { checkFHT8VDecodersAgree(buf + skip, sizeof(buf) - 1 - skip); }
+        }
+}
+
+// Test that both decoders agree on random and randomly-corrupted streams.
+TEST(FHT8VRadValve,FHTDecodingLUTRandom)
+{
+    uint8_t buf[OTRadValve::FHT8VRadValveUtil::MIN_FHT8V_200US_BIT_STREAM_BUF_SIZE];
+    OTRadValve::FHT8VRadValveUtil::fht8v_msg_t command;
+    uint32_t seed = 42;
+    const auto next = [&seed]() { seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5; return(seed); };
+    for(int n = 0; n < 2000; ++n)
+        {
+        if(0 == (n & 1))
+            {
+            // Random bytes built from valid pairs, so that some get well into a frame.
+            for(uint8_t &b : buf) { const uint32_t r = next(); b = uint8_t((0 == (r & 0x100)) ? r : (0xcc | (r & 0x22))); }
+            }
+        else
+            {
+            command.hc1 = uint8_t(next());
+            command.hc2 = uint8_t(next());
+#ifdef OTV0P2BASE_FHT8V_ADR_USED
+            command.address = 0;
+#endif
+            command.command = uint8_t(next());
+            command.extension = uint8_t(next());
+            uint8_t *const end = OTRadValve::FHT8VRadValveUtil::FHT8VCreate200usBitStreamBptr(buf, &command);
+            // Corrupt up to two random bits.
+            const uint8_t len = uint8_t(end - buf + 1);
+            const uint32_t r = next();
+            if(0 != (r & 1)) { buf[(r >> 8) % len] ^= uint8_t(1 << ((r >> 4) & 7)); }
+            if(0 != (r & 2)) { buf[(r >> 16) % len] ^= uint8_t(1 << ((r >> 24) & 7)); }
+            }
+        checkFHT8VDecodersAgree(buf, sizeof(buf) - 1);
+        }
+}
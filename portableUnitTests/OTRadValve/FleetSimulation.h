@@ -0,0 +1,320 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+                           Deniz Erbilgin 2019
+*/
+
+/*
+ * Host-side simulation of a fleet of rooms, each with its own
+ * ModelledRadValveState and thermal model, run in parallel across cores.
+ *
+ * Each room is configured with its own weather, occupancy and
+ * room/radiator parameters, and is simulated independently
+ * with the same 1s step as RoomModelBasic.
+ * Per-room comfort and energy metrics are then aggregated in room order,
+ * so the results do not depend on the number of threads used.
+ *
+ * Each room can also record its hourly stats into its own EEPROM image file
+ * (see OTV0P2BASE_EEPROMImage.h), so that state persists across runs.
+ */
+
+#ifndef OTRADVALVE_FLEETSIMULATION_H
+#define OTRADVALVE_FLEETSIMULATION_H
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "OTV0P2BASE_EEPROMImage.h"
+#include "ThermalPhysicsModels.h"
+
+namespace OTRadValve
+{
+namespace PortableUnitTest
+{
+namespace TMB {
+namespace Fleet {
+
+/**
+ * @brief   Outside temperature as a daily sinusoid.
+ *
+ * Coldest at 04:00 and warmest at 16:00.
+ */
+struct Weather_t
+{
+    // Mean outside temperature in C.
+    double meanTempC;
+    // Peak-to-peak daily swing in C.
+    double dailySwingC;
+
+    double outsideTempC(const uint32_t seconds) const
+    {
+        static constexpr double pi = 3.14159265358979323846;
+        const double hours = (seconds % 86400U) / 3600.0;
+        return (meanTempC - (dailySwingC / 2) * std::cos(2 * pi * (hours - 4.0) / 24.0));
+    }
+};
+
+/**
+ * @brief   Daily occupancy trace: occupied from startH until endH.
+ *
+ * If endH is less than startH then occupancy spans midnight.
+ * The valve target is the comfort temperature while occupied
+ * else the setback temperature.
+ */
+struct Occupancy_t
+{
+    // Hour of the day [0,23] at which occupancy starts.
+    uint8_t startH;
+    // Hour of the day [0,24] at which occupancy ends.
+    uint8_t endH;
+    // Target temperatures in C while occupied and not.
+    uint8_t comfortTempC;
+    uint8_t setbackTempC;
+
+    bool isOccupied(const uint32_t seconds) const
+    {
+        const uint8_t h = (uint8_t)((seconds % 86400U) / 3600U);
+        if (startH <= endH) { return ((h >= startH) && (h < endH)); }
+        return ((h >= startH) || (h < endH));
+    }
+    uint8_t targetTempC(const uint32_t seconds) const
+        { return (isOccupied(seconds) ? comfortTempC : setbackTempC); }
+};
+
+/**
+ * @brief   Configuration of one simulated room.
+ */
+struct RoomConfig_t
+{
+    // Initial room temperature in C.
+    double initTempC;
+    RoomParams_t roomParams;
+    RadParams_t radParams;
+    Weather_t weather;
+    Occupancy_t occupancy;
+};
+
+/**
+ * @brief   Comfort and energy outcomes for one room.
+ */
+struct RoomMetrics_t
+{
+    // Heat delivered by the radiator in J.
+    double energyJ {0.0};
+    // Occupied time more than comfortMarginC below target, in degree hours.
+    double underheatDegH {0.0};
+    // Occupied time more than comfortMarginC above target, in degree hours.
+    double overheatDegH {0.0};
+    // Time occupied in hours.
+    double occupiedH {0.0};
+    // Total valve travel in %, as ModelledRadValveState::cumulativeMovementPC but unwrapped.
+    uint32_t valveMovementPC {0};
+};
+
+/**
+ * @brief   Aggregate outcomes over a fleet of rooms.
+ */
+struct FleetMetrics_t
+{
+    // Number of rooms simulated.
+    size_t rooms {0};
+    // Total heat delivered in kWh.
+    double totalEnergyKWh {0.0};
+    // Mean heat delivered per room in kWh.
+    double meanEnergyKWh {0.0};
+    // Mean underheating/overheating per room in degree hours.
+    double meanUnderheatDegH {0.0};
+    double meanOverheatDegH {0.0};
+    // Worst underheating of any room in degree hours.
+    double maxUnderheatDegH {0.0};
+    // Mean valve travel per room in %.
+    double meanValveMovementPC {0.0};
+};
+
+// Deadband around the target within which the room is considered comfortable.
+static constexpr double comfortMarginC = 1.0;
+
+/**
+ * @brief   Simulate one room for the given number of seconds.
+ *
+ * Steps as RoomModelBasic does, but with outside temperature from the weather
+ * and the valve target from the occupancy trace, updated once per valve tick.
+ *
+ * @param   stats: if non-NULL, at the end of each hour receives the room
+ *          temperature (companded) in STATS_SET_TEMP_BY_HOUR and the valve
+ *          % open in STATS_SET_USER1_BY_HOUR, as a valve would record them.
+ */
+template<class MRVS_t = OTRadValve::ModelledRadValveState<> >
+RoomMetrics_t simulateRoom(const RoomConfig_t &config, const uint32_t seconds,
+                           OTV0P2BASE::NVByHourByteStatsBase *const stats = NULL)
+{
+    RoomMetrics_t metrics;
+    ValveModel<MRVS_t> valve(config.radParams);
+    ThermalModelBasic model(config.roomParams);
+    const InitConditions_t init {
+        config.initTempC,
+        (double)config.occupancy.targetTempC(0),
+        0 };
+    valve.init(init);
+    model.init(init);
+    uint_fast8_t lastValvePCOpen = valve.getValvePCOpen();
+    for (uint32_t s = 0; s < seconds; ++s) {
+        if (0 == (s % valveUpdateTime)) {
+            valve.setTargetTempC(config.occupancy.targetTempC(s));
+            model.setOutsideTemp(config.weather.outsideTempC(s));
+        }
+        internalModelTick(s, valve, model);
+        const uint_fast8_t valvePCOpen = valve.getValvePCOpen();
+        metrics.valveMovementPC += (valvePCOpen > lastValvePCOpen) ?
+            (valvePCOpen - lastValvePCOpen) : (lastValvePCOpen - valvePCOpen);
+        lastValvePCOpen = valvePCOpen;
+        metrics.energyJ += valve.getHeatInput();
+        if (config.occupancy.isOccupied(s)) {
+            const double errorC = model.getState().roomTemp - config.occupancy.comfortTempC;
+            metrics.occupiedH += 1 / 3600.0;
+            if (errorC < -comfortMarginC) { metrics.underheatDegH += (-comfortMarginC - errorC) / 3600.0; }
+            else if (errorC > comfortMarginC) { metrics.overheatDegH += (errorC - comfortMarginC) / 3600.0; }
+        }
+        if ((NULL != stats) && (3599 == (s % 3600U))) {
+            const uint8_t hh = (uint8_t)((s % 86400U) / 3600U);
+            const int16_t tempC16 = (int16_t)std::lround(model.getState().roomTemp * 16);
+            stats->setByHourStatSimple(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_TEMP_BY_HOUR, hh,
+                                       OTV0P2BASE::compressTempC16(tempC16));
+            stats->setByHourStatSimple(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_USER1_BY_HOUR, hh,
+                                       (uint8_t)valvePCOpen);
+        }
+    }
+    return (metrics);
+}
+
+/**
+ * @brief   Aggregate per-room metrics, in room order.
+ */
+inline FleetMetrics_t aggregate(const std::vector<RoomMetrics_t> &perRoom)
+{
+    FleetMetrics_t f;
+    f.rooms = perRoom.size();
+    if (0 == f.rooms) { return (f); }
+    double movement = 0.0;
+    for (const RoomMetrics_t &r : perRoom) {
+        f.totalEnergyKWh += r.energyJ / 3.6e6;
+        f.meanUnderheatDegH += r.underheatDegH;
+        f.meanOverheatDegH += r.overheatDegH;
+        if (r.underheatDegH > f.maxUnderheatDegH) { f.maxUnderheatDegH = r.underheatDegH; }
+        movement += r.valveMovementPC;
+    }
+    f.meanEnergyKWh = f.totalEnergyKWh / f.rooms;
+    f.meanUnderheatDegH /= f.rooms;
+    f.meanOverheatDegH /= f.rooms;
+    f.meanValveMovementPC = movement / f.rooms;
+    return (f);
+}
+
+/**
+ * @brief   EEPROM image file of room i in dir, eg "dir/room3.eeprom".
+ */
+inline std::string roomImagePath(const char *const dir, const size_t i)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "/room%lu.eeprom", (unsigned long)i);
+    return (std::string(dir) + name);
+}
+
+/**
+ * @brief   Simulate every room in the fleet for the given number of seconds.
+ *
+ * Rooms are handed out to worker threads one at a time.
+ *
+ * @param   perRoomOut: if non-NULL, filled with the metrics of each room in config order.
+ * @param   threads: number of worker threads; 0 to use all hardware threads.
+ * @param   imageDir: if non-NULL, the existing directory in which room i
+ *          records its stats in its own EEPROM image, roomImagePath(imageDir, i).
+ */
+template<class MRVS_t = OTRadValve::ModelledRadValveState<> >
+FleetMetrics_t simulateFleet(
+    const std::vector<RoomConfig_t> &fleet,
+    const uint32_t seconds,
+    unsigned threads = 0,
+    std::vector<RoomMetrics_t> *const perRoomOut = NULL,
+    const char *const imageDir = NULL)
+{
+    std::vector<RoomMetrics_t> perRoom(fleet.size());
+    if (0 == threads) { threads = std::thread::hardware_concurrency(); }
+    if (0 == threads) { threads = 1; }
+    if (threads > fleet.size()) { threads = (unsigned)fleet.size(); }
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i; (i = next++) < fleet.size(); ) {
+            if (NULL == imageDir) { perRoom[i] = simulateRoom<MRVS_t>(fleet[i], seconds); continue; }
+            // Simulate without stats if the image cannot be opened.
+            OTV0P2BASE::MappedEEPROMImage image(roomImagePath(imageDir, i).c_str());
+            OTV0P2BASE::ByHourByteStatsStore<OTV0P2BASE::MappedEEPROMImage> stats(image);
+            perRoom[i] = simulateRoom<MRVS_t>(fleet[i], seconds, image.isOpen() ? &stats : NULL);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) { pool.emplace_back(worker); }
+    worker();
+    for (std::thread &t : pool) { t.join(); }
+    if (NULL != perRoomOut) { *perRoomOut = perRoom; }
+    return (aggregate(perRoom));
+}
+
+/**
+ * @brief   Generate a reproducible fleet of varied rooms.
+ *
+ * Room and radiator parameters are scaled from the defaults,
+ * and occupancy varies around a typical day;
+ * all rooms share the given weather.
+ *
+ * @param   n: number of rooms.
+ * @param   seed: seed for the parameter variation.
+ */
+inline std::vector<RoomConfig_t> makeFleet(const size_t n, const Weather_t weather, uint32_t seed = 1)
+{
+    // Simple LCG so that fleets are identical on every host.
+    auto rnd = [&seed]() { seed = seed * 1664525U + 1013904223U; return ((seed >> 8) & 0xffff) / 65536.0; };
+    std::vector<RoomConfig_t> fleet;
+    fleet.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        // Scale insulation and size by [0.5,1.5) and radiator output by [0.75,1.25).
+        const double loss = 0.5 + rnd();
+        const double size = 0.5 + rnd();
+        const double rad = 0.75 + (rnd() / 2);
+        const RoomParams_t &d = roomParams_Default;
+        const uint8_t startH = (uint8_t)(6 + 3 * rnd());
+        fleet.push_back(RoomConfig_t {
+            14.0 + 6 * rnd(),
+            RoomParams_t { d.conductance_21 * size, d.conductance_10 * loss, d.conductance_0W * loss,
+                           d.capacitance_2 * size, d.capacitance_1 * size, d.capacitance_0 * size },
+            RadParams_t { radParams_Default.conductance * rad, radParams_Default.maxTemp },
+            weather,
+            Occupancy_t { startH, (uint8_t)(startH + 12 + 4 * rnd()), (uint8_t)(19 + 3 * rnd()), 14 } });
+    }
+    return (fleet);
+}
+
+}
+}
+}
+}
+
+#endif // OTRADVALVE_FLEETSIMULATION_H
@@ -0,0 +1,120 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+                           Deniz Erbilgin 2019
+*/
+
+/*
+ * Tests of the parallel fleet simulation of ModelledRadValve rooms.
+ *
+ * Kept small so as to run quickly;
+ * larger fleets and longer runs can be used to evaluate control changes.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+#include <unistd.h>
+
+#include "FleetSimulation.h"
+using namespace OTRadValve::PortableUnitTest;
+
+// Check occupancy and weather traces.
+TEST(FleetSimulation, Traces)
+{
+    const TMB::Fleet::Occupancy_t day { 7, 22, 20, 14 };
+    EXPECT_FALSE(day.isOccupied(6 * 3600 + 3599));
+    EXPECT_TRUE(day.isOccupied(7 * 3600));
+    EXPECT_EQ(14, day.targetTempC(22 * 3600));
+    EXPECT_EQ(20, day.targetTempC(86400 + 12 * 3600));
+    const TMB::Fleet::Occupancy_t night { 22, 6, 18, 12 };
+    EXPECT_TRUE(night.isOccupied(23 * 3600));
+    EXPECT_TRUE(night.isOccupied(3600));
+    EXPECT_FALSE(night.isOccupied(12 * 3600));
+    const TMB::Fleet::Weather_t w { 5.0, 6.0 };
+    EXPECT_NEAR(2.0, w.outsideTempC(4 * 3600), 1e-9);
+    EXPECT_NEAR(8.0, w.outsideTempC(16 * 3600), 1e-9);
+}
+
+// Check that results do not depend on the number of threads,
+// and that cold weather costs energy to keep rooms comfortable.
+TEST(FleetSimulation, ParallelMatchesSerial)
+{
+    const uint32_t seconds = 8 * 3600;
+    const std::vector<TMB::Fleet::RoomConfig_t> fleet =
+        TMB::Fleet::makeFleet(8, TMB::Fleet::Weather_t { 5.0, 6.0 }, 42);
+    std::vector<TMB::Fleet::RoomMetrics_t> serialRooms, parallelRooms;
+    const TMB::Fleet::FleetMetrics_t serial =
+        TMB::Fleet::simulateFleet(fleet, seconds, 1, &serialRooms);
+    const TMB::Fleet::FleetMetrics_t parallel =
+        TMB::Fleet::simulateFleet(fleet, seconds, 4, &parallelRooms);
+    ASSERT_EQ(fleet.size(), serial.rooms);
+    ASSERT_EQ(fleet.size(), parallelRooms.size());
+    for (size_t i = 0; i < fleet.size(); ++i) {
+        EXPECT_EQ(serialRooms[i].energyJ, parallelRooms[i].energyJ) << i;
+        EXPECT_EQ(serialRooms[i].valveMovementPC, parallelRooms[i].valveMovementPC) << i;
+        EXPECT_LT(0.0, serialRooms[i].energyJ) << i;
+    }
+    EXPECT_EQ(serial.totalEnergyKWh, parallel.totalEnergyKWh);
+    EXPECT_EQ(serial.meanUnderheatDegH, parallel.meanUnderheatDegH);
+    EXPECT_NEAR(serial.totalEnergyKWh / fleet.size(), serial.meanEnergyKWh, 1e-9);
+    EXPECT_LE(serial.meanUnderheatDegH, serial.maxUnderheatDegH);
+    EXPECT_LT(0.0, serial.meanValveMovementPC);
+}
+
+// Check that a warm spell needs no heat and leaves no room underheated.
+TEST(FleetSimulation, WarmWeather)
+{
+    const std::vector<TMB::Fleet::RoomConfig_t> fleet =
+        TMB::Fleet::makeFleet(4, TMB::Fleet::Weather_t { 26.0, 2.0 }, 7);
+    std::vector<TMB::Fleet::RoomConfig_t> warm;
+    for (const TMB::Fleet::RoomConfig_t &r : fleet) {
+        warm.push_back(TMB::Fleet::RoomConfig_t { 26.0, r.roomParams, r.radParams, r.weather, r.occupancy });
+    }
+    const TMB::Fleet::FleetMetrics_t m = TMB::Fleet::simulateFleet(warm, 4 * 3600);
+    EXPECT_EQ(0.0, m.totalEnergyKWh);
+    EXPECT_EQ(0.0, m.maxUnderheatDegH);
+}
+
+#ifdef OTV0P2BASE_EEPROM_IMAGE_AVAILABLE
+// Check that each room records its hourly stats in its own EEPROM image.
+TEST(FleetSimulation, RoomImages)
+{
+    char dir[] = "/tmp/fleetimagesXXXXXX";
+    ASSERT_TRUE(NULL != mkdtemp(dir));
+    const std::vector<TMB::Fleet::RoomConfig_t> fleet =
+        TMB::Fleet::makeFleet(3, TMB::Fleet::Weather_t { 5.0, 6.0 }, 3);
+    TMB::Fleet::simulateFleet(fleet, 2 * 3600, 2, NULL, dir);
+    const uint8_t tempSet = OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_TEMP_BY_HOUR;
+    const uint8_t valveSet = OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_USER1_BY_HOUR;
+    for (size_t i = 0; i < fleet.size(); ++i) {
+        const std::string path = TMB::Fleet::roomImagePath(dir, i);
+        OTV0P2BASE::MappedEEPROMImage image(path.c_str());
+        ASSERT_TRUE(image.isOpen()) << i;
+        OTV0P2BASE::ByHourByteStatsStore<OTV0P2BASE::MappedEEPROMImage> stats(image);
+        for (uint8_t hh = 0; hh < 2; ++hh) {
+            EXPECT_NE(int(OTV0P2BASE::NVByHourByteStatsBase::UNSET_BYTE), stats.getByHourStatSimple(tempSet, hh)) << i;
+            EXPECT_GE(100, stats.getByHourStatSimple(valveSet, hh)) << i;
+        }
+        // Not yet simulated.
+        EXPECT_EQ(int(OTV0P2BASE::NVByHourByteStatsBase::UNSET_BYTE), stats.getByHourStatSimple(tempSet, 2)) << i;
+        unlink(path.c_str());
+    }
+    rmdir(dir);
+}
+#endif // OTV0P2BASE_EEPROM_IMAGE_AVAILABLE
@@ -0,0 +1,95 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * OTRadValve weather-compensated flow temperature target tests.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#include "OTRadValve_BoilerDriver.h"
+#include "OTRadValve_FlowTemperature.h"
+
+namespace FTT
+{
+OTRadValve::OTHubManager<true, true, false> hm;
+}
+
+// Heating curve, demand trim and output forms.
+TEST(FlowTemperature, Curve)
+{
+    typedef OTRadValve::FlowTemperatureTarget ft_t;
+    ft_t ft;
+    EXPECT_EQ(0, ft.getFlowC());
+    EXPECT_EQ(0, ft.getModulationPC());
+    // Wide open valves, no outside temperature: maximum.
+    ft.update(true, 100);
+    EXPECT_EQ(+ft_t::DEFAULT_MAX_FLOW_C, ft.getFlowC());
+    EXPECT_EQ(100, ft.getModulationPC());
+    EXPECT_EQ(ft_t::DEFAULT_MAX_FLOW_C << 8, ft.getOpenThermControlSetpoint());
+    // No demand clears the target.
+    ft.update(false, 100);
+    EXPECT_EQ(0, ft.getFlowC16());
+    // Mild weather: 20 + 1.5 * (20 - 10) = 35C.
+    ft.update(true, 100, 10 * 16);
+    EXPECT_EQ(35, ft.getFlowC());
+    // Freezing: 20 + 1.5 * 20 = 50C, approached a degree per update.
+    for(int i = 0; i < 5; ++i) { ft.update(true, 100, 0); }
+    EXPECT_EQ(40, ft.getFlowC());
+    for(int i = 0; i < 100; ++i) { ft.update(true, 100, 0); }
+    EXPECT_EQ(50, ft.getFlowC());
+    EXPECT_EQ(50, ft.getModulationPC());
+    // Very cold is capped at the maximum.
+    ft_t cold;
+    cold.update(true, 100, -40 * 16);
+    EXPECT_EQ(+ft_t::DEFAULT_MAX_FLOW_C, cold.getFlowC());
+    // Valves barely open: minimum flow temperature, with some modulation asked for.
+    ft_t low;
+    low.update(true, ft_t::LOW_DEMAND_PC, 0);
+    EXPECT_EQ(+ft_t::DEFAULT_MIN_FLOW_C, low.getFlowC());
+    EXPECT_EQ(1, low.getModulationPC());
+    // Halfway between: halfway between minimum and curve (30 and 50).
+    ft_t mid;
+    mid.update(true, (ft_t::LOW_DEMAND_PC + ft_t::HIGH_DEMAND_PC) / 2, 0);
+    EXPECT_EQ(40, mid.getFlowC());
+    // Bad limits fall back to the defaults.
+    ft_t bad(60, 40);
+    bad.update(true, 100);
+    EXPECT_EQ(+ft_t::DEFAULT_MAX_FLOW_C, bad.getFlowC());
+}
+
+// Driven from the zoned boiler driver's time-weighted mean demand.
+TEST(FlowTemperature, FromZonedDriver)
+{
+    OTRadValve::BoilerLogic::ZonedBoilerDriverLogic<decltype(FTT::hm), FTT::hm, 0, 8> zb;
+    OTRadValve::FlowTemperatureTarget ft;
+    EXPECT_EQ(0, zb.getMeanDemandPC());
+    for(uint8_t m = 0; m <= FTT::hm.getMinBoilerOnMinutes(); ++m) { zb.processCallsForHeat(true, true); }
+    zb.remoteCallForHeatRX(1, 100);
+    zb.remoteCallForHeatRX(2, 50);
+    zb.processCallsForHeat(false, true);
+    ASSERT_TRUE(zb.isBoilerOn());
+    EXPECT_EQ(75, zb.getMeanDemandPC());
+    ft.updateFrom(zb);
+    EXPECT_EQ(+OTRadValve::FlowTemperatureTarget::DEFAULT_MAX_FLOW_C, ft.getFlowC());
+    // Older reports weigh half in the mean.
+    for(uint8_t m = 0; m < decltype(zb)::FRESH_M; ++m) { zb.processCallsForHeat(true, true); }
+    zb.remoteCallForHeatRX(2, 50);
+    EXPECT_EQ((2 * 50 + 100) / 3, zb.getMeanDemandPC());
+}
@@ -107,3 +107,64 @@ TEST(ModeButtonAndPotActuatorPhysicalUI,startState)
         ASSERT_FALSE(occupancy.reportedNewOccupancyRecently()) << "Forcing WARM mode should not trigger any occupancy indication";
     }
 }
+
+namespace nonBlocking
+  {
+bool lit;
+void on() { lit = true; }
+void off() { lit = false; }
+  }
+// With an LED pattern player, read() leaves the flashes to the player.
+TEST(ModeButtonAndPotActuatorPhysicalUI,nonBlockingLED)
+{
+    OTRadValve::ValveMode vm;
+    OTRadValve::NULLTempControl tc;
+    OTRadValve::NULLRadValve rv;
+    OTV0P2BASE::PseudoSensorOccupancyTracker occupancy;
+    OTV0P2BASE::SensorAmbientLightAdaptiveMock ambLight;
+    OTRadValve::ModeButtonAndPotActuatorPhysicalUI mbpUI(
+          &vm, &tc, &rv, &occupancy, &ambLight, NULL, NULL,
+          nonBlocking::on, nonBlocking::off, NULL);
+    OTV0P2BASE::LEDPatternPlayer player(nonBlocking::on, nonBlocking::off);
+    mbpUI.setLEDPatternPlayer(&player);
+    nonBlocking::lit = false;
+    // Just touched: flash shown.
+    mbpUI.markUIControlUsed();
+    mbpUI.read();
+    EXPECT_TRUE(player.isActive());
+    EXPECT_TRUE(nonBlocking::lit);
+    // The player finishes the pattern, dark.
+    uint32_t t = 0;
+    while(player.tick(t)) { ++t; ASSERT_LT(t, 100U); }
+    EXPECT_FALSE(nonBlocking::lit);
+    // Still very recently touched: shown again on the next read().
+    mbpUI.read();
+    EXPECT_TRUE(player.isActive());
+    EXPECT_TRUE(nonBlocking::lit);
+    player.stop();
+}
+
+// The cycling MODE button can be read from interrupt-captured button state.
+TEST(ModeButtonAndPotActuatorPhysicalUI,modeButtonState)
+{
+    OTRadValve::ValveMode vm;
+    OTRadValve::NULLTempControl tc;
+    OTRadValve::NULLRadValve rv;
+    OTV0P2BASE::PseudoSensorOccupancyTracker occupancy;
+    OTV0P2BASE::SensorAmbientLightAdaptiveMock ambLight;
+    OTRadValve::CycleModeAndLearnButtonsAndPotActuatorPhysicalUI<5> cmUI(
+          &vm, &tc, &rv, &occupancy, &ambLight, NULL, NULL,
+          [](){}, [](){}, NULL);
+    // MODE on port bit 5, active low.
+    OTV0P2BASE::ButtonEventCapture<> buttons(0x20);
+    cmUI.setModeButtonState(&buttons, 5);
+    ASSERT_FALSE(vm.inWarmMode());
+    buttons.captureFromISR(0x00, 10);
+    cmUI.read(); // Held: FROST -> WARM putatively.
+    EXPECT_FALSE(vm.inWarmMode());
+    EXPECT_TRUE(cmUI.recentUIControlUse());
+    buttons.captureFromISR(0x20, 300);
+    cmUI.read(); // Released: applied.
+    EXPECT_TRUE(vm.inWarmMode());
+    EXPECT_FALSE(vm.inBakeMode());
+}
@@ -0,0 +1,130 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * OTRadValve ModelledRadValveMulti tests.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#include "OTRadValve_AbstractRadValve.h"
+#include "OTRadValve_ModelledRadValveMulti.h"
+
+
+namespace MRVM
+    {
+    // Settable valve that counts polls.
+    class CountingValve final : public OTRadValve::AbstractRadValve
+      {
+      public:
+        uint16_t polls = 0;
+        virtual uint8_t read() override { ++polls; return(get()); }
+        virtual bool set(const uint8_t newValue) override
+          { if(!isValid(newValue)) { return(false); } value = newValue; return(true); }
+      };
+    // Instances with linkage to support the test.
+    static OTRadValve::ValveMode valveMode;
+    static OTV0P2BASE::TemperatureC16Mock roomTemp;
+    static OTRadValve::TempControlSimpleVCP<OTRadValve::DEFAULT_ValveControlParameters> tempControl;
+    static OTV0P2BASE::PseudoSensorOccupancyTracker occupancy;
+    static OTV0P2BASE::SensorAmbientLightAdaptiveMock ambLight;
+    static OTRadValve::NULLActuatorPhysicalUI physicalUI;
+    static OTRadValve::NULLValveSchedule schedule;
+    static OTV0P2BASE::NULLByHourByteStats byHourStats;
+    typedef OTRadValve::ModelledRadValveComputeTargetTempBasic<
+        OTRadValve::DEFAULT_ValveControlParameters,
+        &valveMode,
+        decltype(roomTemp),                    &roomTemp,
+        decltype(tempControl),                 &tempControl,
+        decltype(occupancy),                   &occupancy,
+        decltype(ambLight),                    &ambLight,
+        decltype(physicalUI),                  &physicalUI,
+        decltype(schedule),                    &schedule,
+        decltype(byHourStats),                 &byHourStats
+        > ctt_t;
+    }
+
+// Two radiators from one board: both open for a cold room
+// from the one shared computation, each within its own calibration,
+// and both close again once the room is warm.
+TEST(ModelledRadValveMulti,SharedInputsPerValveCalibration)
+{
+    MRVM::valveMode.setWarmModeDebounced(true);
+    MRVM::occupancy.reset();
+    MRVM::occupancy.markAsOccupied();
+    MRVM::ambLight.set(255, 0, false);
+    MRVM::ambLight.read();
+    const uint8_t w = OTRadValve::DEFAULT_ValveControlParameters::WARM;
+    MRVM::roomTemp.set((w - 5) << 4);
+
+    const MRVM::ctt_t ctt;
+    MRVM::CountingValve v0, v1;
+    OTRadValve::ModelledRadValveMulti<2> mrv(&ctt, &MRVM::valveMode, &MRVM::tempControl);
+    EXPECT_EQ(2, mrv.getValveCount());
+    OTRadValve::ModelledRadValveMulti<2>::Calibration half;
+    half.maxPCOpen = 50;
+    mrv.setValve(0, &v0);
+    mrv.setValve(1, &v1, half);
+
+    mrv.read();
+    EXPECT_EQ(w, mrv.getTargetTempC());
+    EXPECT_EQ(100, mrv.getValvePC(0));
+    EXPECT_EQ(50, mrv.getValvePC(1));
+    EXPECT_EQ(100, v0.get());
+    EXPECT_EQ(50, v1.get());
+    EXPECT_EQ(100, mrv.get()) << "most open valve";
+    EXPECT_TRUE(mrv.isUnderTarget());
+    EXPECT_TRUE(mrv.isCallingForHeat());
+
+    // Warm room: both valves close.
+    MRVM::roomTemp.set((w + 3) << 4);
+    for(int i = 0; i < 60; ++i) { mrv.read(); }
+    EXPECT_EQ(0, mrv.getValvePC(0));
+    EXPECT_EQ(0, mrv.getValvePC(1));
+    EXPECT_EQ(0, v0.get());
+    EXPECT_EQ(0, v1.get());
+    EXPECT_FALSE(mrv.isUnderTarget());
+    EXPECT_FALSE(mrv.isCallingForHeat());
+}
+
+// Motors are polled strictly one at a time in turn.
+TEST(ModelledRadValveMulti,StaggeredMotorPolls)
+{
+    const MRVM::ctt_t ctt;
+    MRVM::CountingValve v0, v2;
+    OTRadValve::ModelledRadValveMulti<3> mrv(&ctt, &MRVM::valveMode, &MRVM::tempControl);
+    mrv.setValve(0, &v0);
+    // Valve 1 has no physical device.
+    mrv.setValve(2, &v2);
+    mrv.pollMotors();
+    EXPECT_EQ(1, v0.polls);
+    EXPECT_EQ(0, v2.polls);
+    mrv.pollMotors();
+    EXPECT_EQ(1, v0.polls);
+    EXPECT_EQ(0, v2.polls);
+    mrv.pollMotors();
+    EXPECT_EQ(1, v0.polls);
+    EXPECT_EQ(1, v2.polls);
+    for(int i = 0; i < 30; ++i) { mrv.pollMotors(); }
+    EXPECT_EQ(11, v0.polls);
+    EXPECT_EQ(11, v2.polls);
+    // Out-of-range valve is ignored.
+    mrv.setValve(3, &v0);
+    EXPECT_EQ(0, mrv.getValvePC(3));
+}
@@ -0,0 +1,91 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * OTRadValve ModelledRadValveStateBatch tests.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#include "OTRadValve_ModelledRadValveStateBatch.h"
+
+namespace MRVSB
+{
+// Tick a batch and the same number of individual instances with the same
+// varied inputs, and check that every lane matches its scalar twin exactly.
+template<size_t N, bool BINARY>
+static void checkMatchesScalar(const uint32_t seed, const bool alwaysGlacial)
+    {
+    uint32_t r = seed;
+    auto rnd = [&r](const uint32_t n) { r = r * 1664525U + 1013904223U; return((r >> 8) % n); };
+    OTRadValve::ModelledRadValveStateBatch<N, BINARY> b(alwaysGlacial);
+    typedef typename OTRadValve::ModelledRadValveStateBatch<N, BINARY>::scalar_t scalar_t;
+    std::vector<scalar_t> s(N, scalar_t(alwaysGlacial));
+    OTRadValve::ModelledRadValveInputState is[N];
+    uint8_t bPC[N];
+    volatile uint8_t sPC[N];
+    int_fast16_t tempC16[N];
+    for(size_t i = 0; i < N; ++i)
+        {
+        bPC[i] = sPC[i] = (uint8_t)rnd(101);
+        tempC16[i] = (int_fast16_t)((14 << 4) + rnd(10 << 4));
+        is[i].targetTempC = (uint8_t)(16 + rnd(6));
+        }
+    for(int t = 0; t < 2000; ++t)
+        {
+        for(size_t i = 0; i < N; ++i)
+            {
+            // Mostly small drift with occasional jumps to force filtering on.
+            tempC16[i] += (0 == rnd(50)) ? (int_fast16_t)rnd(64) - 32 : (int_fast16_t)rnd(5) - 2;
+            if(0 == rnd(200)) { is[i].targetTempC = (uint8_t)(12 + rnd(12)); }
+            is[i].widenDeadband = (0 == rnd(4));
+            is[i].glacial = (0 == rnd(8));
+            is[i].fastResponseRequired = (0 == rnd(16));
+            is[i].hasEcoBias = (0 == rnd(2));
+            is[i].setReferenceTemperatures(tempC16[i]);
+            s[i].tick(sPC[i], is[i], NULL);
+            }
+        b.tick(bPC, is);
+        for(size_t i = 0; i < N; ++i)
+            {
+            ASSERT_EQ(sPC[i], bPC[i]) << "t=" << t << " i=" << i;
+            ASSERT_EQ(s[i].isFiltering, b.isFiltering[i]) << t;
+            ASSERT_EQ(s[i].valveMoved, b.valveMoved[i]) << t;
+            ASSERT_EQ(s[i].valveTurndownCountdownM, b.valveTurndownCountdownM[i]) << t;
+            ASSERT_EQ(s[i].valveTurnupCountdownM, b.valveTurnupCountdownM[i]) << t;
+            ASSERT_EQ(s[i].cumulativeMovementPC, b.cumulativeMovementPC[i]) << t;
+            ASSERT_EQ(s[i].getSmoothedRecent(), b.getSmoothedRecent(i)) << t;
+            ASSERT_EQ(s[i].getRawDelta(), b.getRawDelta(i, 1)) << t;
+            }
+        }
+    }
+}
+
+// Check that batched proportional valves match individual instances.
+TEST(ModelledRadValveStateBatch, MatchesScalar)
+{
+    MRVSB::checkMatchesScalar<7, false>(1, false);
+    MRVSB::checkMatchesScalar<16, false>(2, true);
+}
+
+// Check that batched binary valves match individual instances.
+TEST(ModelledRadValveStateBatch, MatchesScalarBinary)
+{
+    MRVSB::checkMatchesScalar<5, true>(3, false);
+}
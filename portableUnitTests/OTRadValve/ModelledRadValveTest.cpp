@@ -287,6 +287,135 @@ TEST(ModelledRadValve,MRVExtremesInt)
     EXPECT_EQ(100, mrv.get());
 }
 
+// Run a ModelledRadValve through a temperature trace with long plateaus
+// and return the valve position, call for heat and movement each minute,
+// and the number of minutes found steady.
+static int runSteadyTrace(const bool skip, uint8_t pc[], bool cfh[], uint16_t cm[], const int minutes)
+{
+    MRVEI::valveMode.setWarmModeDebounced(true);
+    MRVEI::occupancy.reset();
+    MRVEI::ambLight.set(0, 0, false);
+    typedef OTRadValve::DEFAULT_ValveControlParameters parameters;
+    OTRadValve::ModelledRadValveComputeTargetTempBasic<
+       parameters,
+        &MRVEI::valveMode,
+        decltype(MRVEI::roomTemp),                    &MRVEI::roomTemp,
+        decltype(MRVEI::tempControl),                 &MRVEI::tempControl,
+        decltype(MRVEI::occupancy),                   &MRVEI::occupancy,
+        decltype(MRVEI::ambLight),                    &MRVEI::ambLight,
+        decltype(MRVEI::physicalUI),                  &MRVEI::physicalUI,
+        decltype(MRVEI::schedule),                    &MRVEI::schedule,
+        decltype(MRVEI::byHourStats),                 &MRVEI::byHourStats
+        > cttb;
+    OTRadValve::ModelledRadValve mrv(&cttb, &MRVEI::valveMode, &MRVEI::tempControl, NULL);
+    mrv.setSteadyStateSkipping(skip);
+    int steady = 0;
+    for(int m = 0; m < minutes; ++m)
+        {
+        // Plateaus an hour long either side of the WARM target.
+        const int16_t t = int16_t((parameters::WARM << 4) - 64 + 24 * ((m / 60) % 7));
+        MRVEI::roomTemp.set(t);
+        mrv.read();
+        pc[m] = mrv.get();
+        cfh[m] = mrv.isCallingForHeat();
+        cm[m] = mrv.getCumulativeMovementPC();
+        if(mrv.isSteadyState()) { ++steady; }
+        }
+    return(steady);
+}
+
+// Run a ModelledRadValveState at a flat temperature a little below target
+// and return the valve position each minute,
+// skipping tick() whenever isSteady() as ModelledRadValve does if skip is true.
+template<class MRVS>
+static void runFlatStateTrace(const bool skip, uint8_t pc[], const int minutes)
+{
+    OTRadValve::ModelledRadValveInputState is0((19 << 4) - 8);
+    is0.targetTempC = 19;
+    MRVS rs0;
+    volatile uint8_t valvePCOpen = 50;
+    for(int m = 0; m < minutes; ++m)
+        {
+        if(!skip || !rs0.isSteady(is0)) { rs0.tick(valvePCOpen, is0, NULL); }
+        pc[m] = valvePCOpen;
+        }
+}
+
+// Check that skipping the full computation in a steady state changes no results.
+TEST(ModelledRadValve,steadyStateSkip)
+{
+    constexpr int minutes = 24 * 60;
+    static uint8_t pc0[minutes], pc1[minutes];
+    static bool cfh0[minutes], cfh1[minutes];
+    static uint16_t cm0[minutes], cm1[minutes];
+    EXPECT_EQ(0, runSteadyTrace(false, pc0, cfh0, cm0, minutes));
+    const int steady = runSteadyTrace(true, pc1, cfh1, cm1, minutes);
+    // Many minutes on a plateau should be skipped once the valve has settled,
+    // but the valve should still move.
+    EXPECT_LT(minutes / 5, steady);
+    EXPECT_LT(0, cm1[minutes - 1]);
+    for(int m = 0; m < minutes; ++m)
+        {
+        ASSERT_EQ(pc0[m], pc1[m]) << m;
+        ASSERT_EQ(cfh0[m], cfh1[m]) << m;
+        ASSERT_EQ(cm0[m], cm1[m]) << m;
+        }
+    // The PI controller keeps integrating a steady error
+    // so must never be skipped, eg flat just below target.
+    constexpr int piMinutes = 120;
+    static uint8_t pi0[piMinutes], pi1[piMinutes];
+    runFlatStateTrace<OTRadValve::ModelledRadValveState<false, false, true>>(false, pi0, piMinutes);
+    runFlatStateTrace<OTRadValve::ModelledRadValveState<false, false, true>>(true, pi1, piMinutes);
+    EXPECT_LT(50, pi0[piMinutes - 1]);
+    for(int m = 0; m < piMinutes; ++m) { ASSERT_EQ(pi0[m], pi1[m]) << m; }
+}
+
+// Check that a humidity boost lifts any setback only for a while, and asks for a fast response.
+TEST(ModelledRadValve,humidityBoost)
+{
+    typedef OTRadValve::DEFAULT_ValveControlParameters parameters;
+    const uint8_t w = parameters::WARM;
+    MRVEI::valveMode.setWarmModeDebounced(true);
+    MRVEI::occupancy.reset();
+    // Dark and vacant for hours so a setback applies.
+    MRVEI::ambLight.set(0, 12*60U, false);
+    MRVEI::ambLight.read();
+    MRVEI::roomTemp.set((w - 1) << 4);
+    OTRadValve::ModelledRadValveComputeTargetTempBasic<
+       parameters,
+        &MRVEI::valveMode,
+        decltype(MRVEI::roomTemp),                    &MRVEI::roomTemp,
+        decltype(MRVEI::tempControl),                 &MRVEI::tempControl,
+        decltype(MRVEI::occupancy),                   &MRVEI::occupancy,
+        decltype(MRVEI::ambLight),                    &MRVEI::ambLight,
+        decltype(MRVEI::physicalUI),                  &MRVEI::physicalUI,
+        decltype(MRVEI::schedule),                    &MRVEI::schedule,
+        decltype(MRVEI::byHourStats),                 &MRVEI::byHourStats
+        > cttb;
+    OTRadValve::ModelledRadValve mrv(&cttb, &MRVEI::valveMode, &MRVEI::tempControl, NULL);
+    for(int i = 0; i < 5; ++i) { mrv.read(); }
+    const uint8_t setbackTarget = mrv.getTargetTempC();
+    ASSERT_GT(w, setbackTarget);
+    EXPECT_FALSE(mrv.isHumidityBoosted());
+    // Target lifted immediately, without waiting for a tick.
+    mrv.humidityBoost();
+    EXPECT_TRUE(mrv.isHumidityBoosted());
+    EXPECT_EQ(w, mrv.getTargetTempC());
+    EXPECT_EQ(0, mrv.getSetbackC());
+    // The valve opens on the next tick(s) to heat towards WARM.
+    mrv.read();
+    EXPECT_LT(0, mrv.get());
+    for(int i = 2; i < int(mrv.HUMIDITY_BOOST_M); ++i) { mrv.read(); EXPECT_EQ(w, mrv.getTargetTempC()) << i; }
+    // Then the setback resumes.
+    mrv.read();
+    EXPECT_FALSE(mrv.isHumidityBoosted());
+    EXPECT_EQ(setbackTarget, mrv.getTargetTempC());
+    // No boost in FROST mode.
+    MRVEI::valveMode.setWarmModeDebounced(false);
+    mrv.humidityBoost();
+    EXPECT_GT(w, mrv.getTargetTempC());
+}
+
 // Test the logic in ModelledRadValveState for starting from extreme positions.
 //
 // Adapted 2016/10/16 from test_VALVEMODEL.ino testMRVSExtremes().
@@ -384,7 +513,7 @@ TEST(ModelledRadValve,MRVSExtremes)
     // Filtering should not have been engaged
     // and velocity should be zero (temperature is flat).
     for(int i = OTRadValve::ModelledRadValveState<>::filterLength; --i >= 0; )
-        { ASSERT_EQ(100<<4, rs1.prevRawTempC16[i]); }
+        { ASSERT_EQ(100<<4, rs1.getPrevRawTempC16(i)); }
     EXPECT_EQ(100<<4, rs1.getSmoothedRecent());
     //  AssertIsEqual(0, rs1.getVelocityC16PerTick());
     EXPECT_TRUE(!rs1.isFiltering);
@@ -551,6 +680,324 @@ TEST(ModelledRadValve,ModelledRadValveComputeTargetTempBasic)
     EXPECT_EQ(w+bu, cttb0.computeTargetTemp()) << "BAKE should win and force full uplift from WARM";
 }
 
+// Test that the basic target computation only reads the inputs it needs.
+namespace MRVCTTBL
+    {
+    // Schedule that counts queries.
+    class CountingSchedule final : public OTRadValve::SimpleValveScheduleBase
+      {
+      public:
+        mutable uint8_t queries = 0;
+        virtual uint8_t maxSchedules() const override { return(0); }
+        virtual uint8_t onTime() const override { return(1); }
+        virtual uint_least16_t getSimpleScheduleOff(uint8_t) const override { return(uint_least16_t(~0)); }
+        virtual uint_least16_t getSimpleScheduleOn(uint8_t) const override { return(uint_least16_t(~0)); }
+        virtual bool setSimpleSchedule(uint_least16_t, uint8_t) override { return(false); }
+        virtual void clearSimpleSchedule(uint8_t) override { }
+        virtual bool isAnyScheduleOnWARMNow(uint_least16_t) const override { ++queries; return(false); }
+        virtual bool isAnyScheduleOnWARMSoon(uint_least16_t) const override { ++queries; return(false); }
+        virtual bool isAnySimpleScheduleSet() const override { return(false); }
+      };
+    // Empty stats that count reads.
+    class CountingStats final : public OTV0P2BASE::NVByHourByteStatsBase
+      {
+      public:
+        mutable uint16_t reads = 0;
+        virtual bool zapStats(uint16_t = 0) override { return(true); }
+        virtual uint8_t getByHourStatSimple(uint8_t, uint8_t) const override { ++reads; return(UNSET_BYTE); }
+        virtual void setByHourStatSimple(uint8_t, uint8_t, uint8_t = UNSET_BYTE) override { }
+        virtual uint8_t getHour() const override { return(0); }
+      };
+    // Instances with linkage to support the test.
+    static OTRadValve::ValveMode valveMode;
+    static OTV0P2BASE::TemperatureC16Mock roomTemp;
+    static OTRadValve::TempControlSimpleVCP<OTRadValve::DEFAULT_ValveControlParameters> tempControl;
+    static OTV0P2BASE::PseudoSensorOccupancyTracker occupancy;
+    static OTV0P2BASE::SensorAmbientLightAdaptiveMock ambLight;
+    static OTRadValve::NULLActuatorPhysicalUI physicalUI;
+    static CountingSchedule schedule;
+    static CountingStats byHourStats;
+    }
+TEST(ModelledRadValve,ModelledRadValveComputeTargetTempBasicLazyInputs)
+{
+    // Reset static state to make tests re-runnable.
+    MRVCTTBL::valveMode.setWarmModeDebounced(false);
+    MRVCTTBL::occupancy.reset();
+    MRVCTTBL::ambLight.set(255, 0, false);
+    MRVCTTBL::ambLight.read();
+
+    OTRadValve::ModelledRadValveComputeTargetTempBasic<
+        OTRadValve::DEFAULT_ValveControlParameters,
+        &MRVCTTBL::valveMode,
+        decltype(MRVCTTBL::roomTemp),                    &MRVCTTBL::roomTemp,
+        decltype(MRVCTTBL::tempControl),                 &MRVCTTBL::tempControl,
+        decltype(MRVCTTBL::occupancy),                   &MRVCTTBL::occupancy,
+        decltype(MRVCTTBL::ambLight),                    &MRVCTTBL::ambLight,
+        decltype(MRVCTTBL::physicalUI),                  &MRVCTTBL::physicalUI,
+        decltype(MRVCTTBL::schedule),                    &MRVCTTBL::schedule,
+        decltype(MRVCTTBL::byHourStats),                 &MRVCTTBL::byHourStats
+        > cttb;
+    const uint8_t f = OTRadValve::DEFAULT_ValveControlParameters::FROST;
+    const uint8_t w = OTRadValve::DEFAULT_ValveControlParameters::WARM;
+
+    // FROST mode only looks for a schedule due soon, never at the stats.
+    MRVCTTBL::schedule.queries = 0;
+    MRVCTTBL::byHourStats.reads = 0;
+    EXPECT_EQ(f, cttb.computeTargetTemp());
+    EXPECT_EQ(1, MRVCTTBL::schedule.queries);
+    EXPECT_EQ(0, MRVCTTBL::byHourStats.reads);
+
+    // Occupied WARM allows no setback so needs neither.
+    MRVCTTBL::valveMode.setWarmModeDebounced(true);
+    MRVCTTBL::occupancy.markAsOccupied();
+    MRVCTTBL::schedule.queries = 0;
+    MRVCTTBL::byHourStats.reads = 0;
+    EXPECT_EQ(w, cttb.computeTargetTemp());
+    EXPECT_EQ(0, MRVCTTBL::schedule.queries);
+    EXPECT_EQ(0, MRVCTTBL::byHourStats.reads);
+
+    // Long vacant and dark for hours goes straight to FULL setback.
+    MRVCTTBL::occupancy.setHolidayMode();
+    MRVCTTBL::ambLight.set(0, 12*60U, false);
+    MRVCTTBL::ambLight.read();
+    MRVCTTBL::schedule.queries = 0;
+    MRVCTTBL::byHourStats.reads = 0;
+    const uint8_t sbFULL = OTRadValve::DEFAULT_ValveControlParameters::SETBACK_FULL;
+    EXPECT_EQ(w-sbFULL, cttb.computeTargetTemp());
+    EXPECT_EQ(0, MRVCTTBL::schedule.queries);
+    EXPECT_EQ(0, MRVCTTBL::byHourStats.reads);
+
+    // Vacant but not long vacant in a lit room does need the schedule and stats.
+    MRVCTTBL::occupancy.reset();
+    MRVCTTBL::ambLight.set(255, 0, false);
+    MRVCTTBL::ambLight.read();
+    EXPECT_TRUE(MRVCTTBL::occupancy.isLikelyUnoccupied());
+    MRVCTTBL::schedule.queries = 0;
+    MRVCTTBL::byHourStats.reads = 0;
+    EXPECT_GT(w, cttb.computeTargetTemp());
+    EXPECT_EQ(2, MRVCTTBL::schedule.queries);
+    EXPECT_LT(0, MRVCTTBL::byHourStats.reads);
+}
+
+// Test that ModelledRadValveComputeTargetTemp2016 computes the same targets
+// when subscribed to occupancy state changes as when polling.
+namespace MRVCTT2016
+    {
+    // Instances with linkage to support the test.
+    static OTRadValve::ValveMode valveMode;
+    static OTV0P2BASE::TemperatureC16Mock roomTemp;
+    static OTRadValve::TempControlSimpleVCP<OTRadValve::DEFAULT_ValveControlParameters> tempControl;
+    static OTV0P2BASE::PseudoSensorOccupancyTracker occupancy;
+    static OTV0P2BASE::SensorAmbientLightAdaptiveMock ambLight;
+    static OTRadValve::NULLActuatorPhysicalUI physicalUI;
+    static OTRadValve::NULLValveSchedule schedule;
+    static OTV0P2BASE::NVByHourByteStatsMock byHourStats;
+    typedef OTRadValve::ModelledRadValveComputeTargetTemp2016<
+        OTRadValve::DEFAULT_ValveControlParameters,
+        &valveMode,
+        decltype(roomTemp),                    &roomTemp,
+        decltype(tempControl),                 &tempControl,
+        decltype(occupancy),                   &occupancy,
+        decltype(ambLight),                    &ambLight,
+        decltype(physicalUI),                  &physicalUI,
+        decltype(schedule),                    &schedule,
+        decltype(byHourStats),                 &byHourStats
+        > ctt_t;
+    static OTV0P2BASE::ByHourOccupancyPredictionCache occPred;
+    typedef OTRadValve::ModelledRadValveComputeTargetTemp2016<
+        OTRadValve::DEFAULT_ValveControlParameters,
+        &valveMode,
+        decltype(roomTemp),                    &roomTemp,
+        decltype(tempControl),                 &tempControl,
+        decltype(occupancy),                   &occupancy,
+        decltype(ambLight),                    &ambLight,
+        decltype(physicalUI),                  &physicalUI,
+        decltype(schedule),                    &schedule,
+        decltype(byHourStats),                 &byHourStats,
+        OTV0P2BASE::HumiditySensorBase,        static_cast<const OTV0P2BASE::HumiditySensorBase *>(NULL),
+        ((bool(*)())NULL),
+        ((bool(*)())NULL),
+        &occPred
+        > ctt_pred_t;
+    static bool lockedOut;
+    static bool isLockedOut() { return(lockedOut); }
+    typedef OTRadValve::ModelledRadValveComputeTargetTemp2016<
+        OTRadValve::DEFAULT_ValveControlParameters,
+        &valveMode,
+        decltype(roomTemp),                    &roomTemp,
+        decltype(tempControl),                 &tempControl,
+        decltype(occupancy),                   &occupancy,
+        decltype(ambLight),                    &ambLight,
+        decltype(physicalUI),                  &physicalUI,
+        decltype(schedule),                    &schedule,
+        decltype(byHourStats),                 &byHourStats,
+        OTV0P2BASE::HumiditySensorBase,        static_cast<const OTV0P2BASE::HumiditySensorBase *>(NULL),
+        isLockedOut
+        > ctt_lockout_t;
+    static OTRadValve::SetbackPlan plan;
+    typedef OTRadValve::ModelledRadValveComputeTargetTemp2016<
+        OTRadValve::DEFAULT_ValveControlParameters,
+        &valveMode,
+        decltype(roomTemp),                    &roomTemp,
+        decltype(tempControl),                 &tempControl,
+        decltype(occupancy),                   &occupancy,
+        decltype(ambLight),                    &ambLight,
+        decltype(physicalUI),                  &physicalUI,
+        decltype(schedule),                    &schedule,
+        decltype(byHourStats),                 &byHourStats,
+        OTV0P2BASE::HumiditySensorBase,        static_cast<const OTV0P2BASE::HumiditySensorBase *>(NULL),
+        ((bool(*)())NULL),
+        ((bool(*)())NULL),
+        static_cast<const OTV0P2BASE::ByHourOccupancyPredictionCache *>(NULL),
+        &plan
+        > ctt_plan_t;
+    }
+TEST(ModelledRadValve,ModelledRadValveComputeTargetTemp2016Subscribed)
+{
+    // Reset static state to make tests re-runnable.
+    MRVCTT2016::valveMode.setWarmModeDebounced(true);
+    MRVCTT2016::roomTemp.set(18 << 4);
+    MRVCTT2016::occupancy.reset();
+    MRVCTT2016::ambLight.set(0, 0, false);
+    MRVCTT2016::byHourStats.zapStats();
+    for(uint8_t hh = 0; hh < 24; ++hh)
+        { MRVCTT2016::byHourStats.setByHourStatSimple(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED, hh, uint8_t(hh * 4)); }
+
+    MRVCTT2016::ctt_t polled;
+    MRVCTT2016::ctt_t subscribed;
+    ASSERT_TRUE(MRVCTT2016::occupancy.addStateListener(&subscribed));
+    const uint8_t w = OTRadValve::DEFAULT_ValveControlParameters::WARM;
+    EXPECT_GT(w, subscribed.computeTargetTemp()) << "no signs of activity";
+
+    // Run for a couple of days with a burst of occupancy at the start,
+    // with the target computed after occupancy read() as on each tick.
+    MRVCTT2016::occupancy.markAsOccupied();
+    bool sawWarm = false, sawSetback = false;
+    for(int m = 0; m < 48 * 60; ++m)
+        {
+        MRVCTT2016::byHourStats._setHour(uint8_t((m / 60) % 24));
+        if(600 == m) { MRVCTT2016::ambLight.set(0, 12*60U, false); MRVCTT2016::ambLight.read(); }
+        MRVCTT2016::occupancy.read();
+        const uint8_t t = subscribed.computeTargetTemp();
+        ASSERT_EQ(polled.computeTargetTemp(), t) << m;
+        if(w == t) { sawWarm = true; } else { sawSetback = true; }
+        }
+    EXPECT_TRUE(sawWarm);
+    EXPECT_TRUE(sawSetback);
+    EXPECT_TRUE(MRVCTT2016::occupancy.longVacant());
+    MRVCTT2016::occupancy.removeStateListener(&subscribed);
+}
+
+// Test that ModelledRadValveComputeTargetTemp2016 computes the same targets
+// from the occupancy prediction cache as from the stats directly.
+TEST(ModelledRadValve,ModelledRadValveComputeTargetTemp2016Predicted)
+{
+    // Seed random() for use in simulator; --gtest_shuffle will force it to change.
+    srandom((unsigned) ::testing::UnitTest::GetInstance()->random_seed());
+
+    // Reset static state to make tests re-runnable.
+    MRVCTT2016::valveMode.setWarmModeDebounced(true);
+    MRVCTT2016::roomTemp.set(18 << 4);
+    MRVCTT2016::occupancy.reset();
+    MRVCTT2016::ambLight.set(0, 0, false);
+    MRVCTT2016::byHourStats.zapStats();
+    MRVCTT2016::occPred.invalidate();
+
+    MRVCTT2016::ctt_t polled;
+    MRVCTT2016::ctt_pred_t predicted;
+    // Falls back to the stats until built.
+    EXPECT_EQ(polled.computeTargetTemp(), predicted.computeTargetTemp());
+
+    // Run for a couple of days with a burst of occupancy at the start,
+    // with the smoothed occupancy stats and predictions updated hourly.
+    MRVCTT2016::occupancy.markAsOccupied();
+    bool sawWarm = false, sawSetback = false;
+    const uint8_t w = OTRadValve::DEFAULT_ValveControlParameters::WARM;
+    for(int m = 0; m < 48 * 60; ++m)
+        {
+        const uint8_t hh = uint8_t((m / 60) % 24);
+        MRVCTT2016::byHourStats._setHour(hh);
+        if(0 == (m % 60))
+            {
+            MRVCTT2016::byHourStats.setByHourStatSimple(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED, hh,
+                (0 == (random() & 7)) ? OTV0P2BASE::NVByHourByteStatsBase::UNSET_BYTE : uint8_t(random() % 101));
+            MRVCTT2016::occPred.rebuild(MRVCTT2016::byHourStats);
+            }
+        if(600 == m) { MRVCTT2016::ambLight.set(0, 12*60U, false); MRVCTT2016::ambLight.read(); }
+        MRVCTT2016::occupancy.read();
+        const uint8_t t = predicted.computeTargetTemp();
+        ASSERT_EQ(polled.computeTargetTemp(), t) << m;
+        if(w == t) { sawWarm = true; } else { sawSetback = true; }
+        }
+    EXPECT_TRUE(sawWarm);
+    EXPECT_TRUE(sawSetback);
+}
+
+// Test that ModelledRadValveComputeTargetTemp2016 computes the same targets
+// from an hourly setback plan as from the stats and lockout directly.
+TEST(ModelledRadValve,ModelledRadValveComputeTargetTemp2016Planned)
+{
+    // Seed random() for use in simulator; --gtest_shuffle will force it to change.
+    srandom((unsigned) ::testing::UnitTest::GetInstance()->random_seed());
+
+    // Reset static state to make tests re-runnable.
+    MRVCTT2016::valveMode.setWarmModeDebounced(true);
+    MRVCTT2016::roomTemp.set(18 << 4);
+    MRVCTT2016::occupancy.reset();
+    MRVCTT2016::ambLight.set(0, 0, false);
+    MRVCTT2016::byHourStats.zapStats();
+    MRVCTT2016::lockedOut = false;
+    MRVCTT2016::plan.invalidate();
+
+    MRVCTT2016::ctt_lockout_t direct;
+    MRVCTT2016::ctt_plan_t planned;
+    // Falls back to the stats until built.
+    EXPECT_EQ(direct.computeTargetTemp(), planned.computeTargetTemp());
+
+    // Run for a few days with bursts of occupancy, and a day locked out,
+    // with the stats updated and the plan rebuilt hourly.
+    bool sawWarm = false, sawSetback = false, sawVacantLast = false;
+    const uint8_t w = OTRadValve::DEFAULT_ValveControlParameters::WARM;
+    for(int m = 0; m < 96 * 60; ++m)
+        {
+        const uint8_t hh = uint8_t((m / 60) % 24);
+        MRVCTT2016::byHourStats._setHour(hh);
+        if(0 == (m % 60))
+            {
+            MRVCTT2016::lockedOut = ((m / (24 * 60)) == 2);
+            const uint8_t occ = (0 == (random() & 3)) ? 0 : uint8_t(random() % 101);
+            MRVCTT2016::byHourStats.setByHourStatSimple(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR, hh, occ);
+            MRVCTT2016::byHourStats.setByHourStatSimple(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED, hh,
+                (0 == (random() & 7)) ? OTV0P2BASE::NVByHourByteStatsBase::UNSET_BYTE : uint8_t(random() % 101));
+            MRVCTT2016::plan.rebuild(MRVCTT2016::byHourStats, MRVCTT2016::lockedOut);
+            if(0 == (random() & 3)) { MRVCTT2016::occupancy.markAsOccupied(); }
+            }
+        if(600 == (m % (24 * 60))) { MRVCTT2016::ambLight.set(0, 12*60U, false); MRVCTT2016::ambLight.read(); }
+        if(1200 == (m % (24 * 60))) { MRVCTT2016::ambLight.set(255, 0, false); MRVCTT2016::ambLight.read(); }
+        MRVCTT2016::occupancy.read();
+        const uint8_t t = planned.computeTargetTemp();
+        ASSERT_EQ(direct.computeTargetTemp(), t) << m;
+        if(w == t) { sawWarm = true; } else { sawSetback = true; }
+        if(MRVCTT2016::plan.wasVacantLast(hh)) { sawVacantLast = true; }
+        }
+    EXPECT_TRUE(sawWarm);
+    EXPECT_TRUE(sawSetback);
+    EXPECT_TRUE(sawVacantLast);
+
+    // The plan matches the prediction cache and the raw stats hour by hour.
+    MRVCTT2016::occPred.rebuild(MRVCTT2016::byHourStats);
+    for(uint8_t hh = 0; hh < 24; ++hh)
+        {
+        EXPECT_EQ(MRVCTT2016::occPred.getHoursLessOccupiedThan(hh), MRVCTT2016::plan.getHoursLessOccupiedThan(hh));
+        EXPECT_EQ(0 == MRVCTT2016::byHourStats.getByHourStatSimple(OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR, hh),
+                  MRVCTT2016::plan.wasVacantLast(hh));
+        }
+    EXPECT_EQ(MRVCTT2016::occPred.getHoursLessOccupiedThan(24), MRVCTT2016::plan.getHoursLessOccupiedThan(24));
+    // Lockout can be changed between rebuilds.
+    MRVCTT2016::plan.setLockedOut(true);
+    EXPECT_EQ(w, planned.computeTargetTemp());
+}
+
 // Test the logic in ModelledRadValveState to open fast from well below target (TODO-593).
 // This is to cover the case where the use manually turns on/up the valve
 // and expects quick response from the valve and the remote boiler
@@ -804,7 +1251,7 @@ TEST(ModelledRadValve,MRVSFilteringOnOff)
         const int16_t bigOffsetC16 = 5 << 4; // 5C perturbation.
         rs0.isFiltering = OTV0P2BASE::randRNG8NextBoolean(); // Futz it.
         rs0._backfillTemperatures(ambientTempC16);
-        rs0.prevRawTempC16[2] += bigOffsetC16;
+        rs0._adjustPrevRawTempC16(2, bigOffsetC16);
         rs0.tick(valvePCOpen, is0, NULL);
         // Should be able to see that mean is now very different to current temp.
         const uint8_t mtj = rs0.MAX_TEMP_JUMP_C16;
@@ -813,7 +1260,7 @@ TEST(ModelledRadValve,MRVSFilteringOnOff)
         // Set hugely-off point near one end other way; filtering should come on.
         rs0.isFiltering = OTV0P2BASE::randRNG8NextBoolean(); // Futz it.
         rs0._backfillTemperatures(ambientTempC16);
-        rs0.prevRawTempC16[2] -= bigOffsetC16;
+        rs0._adjustPrevRawTempC16(2, -bigOffsetC16);
         rs0.tick(valvePCOpen, is0, NULL);
         // Should be able to see that mean is now very different to current temp.
         EXPECT_GT(OTV0P2BASE::fnabsdiff(rs0.getSmoothedRecent(), ambientTempC16), mtj);
@@ -822,8 +1269,8 @@ TEST(ModelledRadValve,MRVSFilteringOnOff)
         // Mean should barely be affected but filtering should stay on.
         rs0.isFiltering = OTV0P2BASE::randRNG8NextBoolean(); // Futz it.
         rs0._backfillTemperatures(ambientTempC16);
-        rs0.prevRawTempC16[rs0.filterLength - 2] += bigOffsetC16;
-        rs0.prevRawTempC16[2] -= bigOffsetC16;
+        rs0._adjustPrevRawTempC16(rs0.filterLength - 2, bigOffsetC16);
+        rs0._adjustPrevRawTempC16(2, -bigOffsetC16);
         rs0.tick(valvePCOpen, is0, NULL);
         // Should be able to see that mean is unchanged.
         EXPECT_EQ(OTV0P2BASE::fnabsdiff(rs0.getSmoothedRecent(), ambientTempC16), 0);
@@ -831,14 +1278,45 @@ TEST(ModelledRadValve,MRVSFilteringOnOff)
         // Reversing the direction should make no difference.
         rs0.isFiltering = OTV0P2BASE::randRNG8NextBoolean(); // Futz it.
         rs0._backfillTemperatures(ambientTempC16);
-        rs0.prevRawTempC16[rs0.filterLength - 2] -= bigOffsetC16;
-        rs0.prevRawTempC16[2] += bigOffsetC16;
+        rs0._adjustPrevRawTempC16(rs0.filterLength - 2, -bigOffsetC16);
+        rs0._adjustPrevRawTempC16(2, bigOffsetC16);
         rs0.tick(valvePCOpen, is0, NULL);
         // Should be able to see that mean is unchanged.
         EXPECT_EQ(OTV0P2BASE::fnabsdiff(rs0.getSmoothedRecent(), ambientTempC16), 0);
         }
 }
 
+// Check that the temperature history ring buffer and its running mean
+// match a plain shifted history over several wraps.
+TEST(ModelledRadValve,MRVSHistoryRing)
+{
+    typedef OTRadValve::ModelledRadValveState<> rs_t;
+    constexpr size_t fl = rs_t::filterLength;
+    const int_fast16_t startC16 = 18 << 4;
+    OTRadValve::ModelledRadValveInputState is0(startC16);
+    is0.targetTempC = 18;
+    rs_t rs0(is0);
+    int_fast16_t expected[fl];
+    for(size_t i = 0; i < fl; ++i) { expected[i] = rs0.computeRawTemp16(is0); }
+    volatile uint8_t valvePCOpen = 0;
+    for(int t = 0; t < 3 * int(fl) + 5; ++t)
+        {
+        const int_fast16_t tempC16 = startC16 + ((t * 7) % 23) - 11;
+        is0.setReferenceTemperatures(tempC16);
+        rs0.tick(valvePCOpen, is0, NULL);
+        for(size_t i = fl; --i > 0; ) { expected[i] = expected[i-1]; }
+        expected[0] = rs0.computeRawTemp16(is0);
+        for(size_t i = 0; i < fl; ++i) { ASSERT_EQ(expected[i], rs0.getPrevRawTempC16(uint8_t(i))) << t; }
+        ASSERT_EQ(OTRadValve::smallIntMean<fl>(expected), rs0.getSmoothedRecent()) << t;
+        ASSERT_EQ(expected[0] - expected[1], rs0.getRawDelta());
+        ASSERT_EQ(expected[0] - expected[fl-1], rs0.getRawDelta(255));
+        ASSERT_EQ(expected[1] - expected[2], rs0.getPrevRawDelta());
+        }
+    rs0._adjustPrevRawTempC16(3, 32);
+    expected[3] += 32;
+    EXPECT_EQ(OTRadValve::smallIntMean<fl>(expected), rs0.getSmoothedRecent());
+}
+
 // Test that the cold draught detector works, with simple synthetic case.
 // Check that a sufficiently sharp drop in temperature
 // (when already below target temperature)
@@ -2065,6 +2543,64 @@ Starred items are tested.
 
 
 
+// Check the incremental PI controller: minimum step, saturation without windup, and bumpless tracking.
+TEST(ModelledRadValve,PIController)
+{
+    typedef OTRadValve::ModelledRadValvePIController pi_t;
+    pi_t pi;
+    static constexpr int_fast16_t t = 19 << 4;
+    // Small constant error: output creeps up, but the valve only moves in steps of at least minStepPC.
+    uint8_t v = 50;
+    for(int i = 0; i < 30; ++i)
+        {
+        const uint8_t nv = pi.step(v, t, 8, 100, false, false);
+        EXPECT_LE(v, nv);
+        if(nv != v) { EXPECT_LE(int(pi_t::minStepPC), nv - v); }
+        v = nv;
+        }
+    EXPECT_LT(50, v);
+    // Large error for hours saturates at the maximum open...
+    for(int i = 0; i < 300; ++i) { v = pi.step(v, t, 64, 80, false, false); }
+    EXPECT_EQ(80, v);
+    EXPECT_EQ(80U << 8, pi.outQ8);
+    // ...with no windup, so closing starts as soon as the error reverses.
+    v = pi.step(v, t + 64, -32, 80, false, false);
+    EXPECT_GT(80, v);
+    // A move by other logic is tracked.
+    v = pi.step(10, t + 64, 0, 80, false, false);
+    EXPECT_EQ(10, v);
+    EXPECT_EQ(10U << 8, pi.outQ8);
+    // Glacial limits the rate of change to 1% per step.
+    v = 50;
+    pi.track(v, t);
+    for(int i = 0; i < 10; ++i) { v = pi.step(v, t, 64, 100, false, true); }
+    EXPECT_GE(60, v);
+    EXPECT_EQ(60U << 8, pi.outQ8);
+}
+
+// PI control mode follows the rule-based algorithm outside the proportional band.
+TEST(ModelledRadValve,PIControlOuterBand)
+{
+    OTRadValve::ModelledRadValveInputState is0(10 << 4);
+    is0.targetTempC = 25;
+    OTRadValve::ModelledRadValveState<false, false, true> rs0;
+    volatile uint8_t valvePCOpen = 0;
+    rs0.tick(valvePCOpen, is0, NULL);
+    EXPECT_EQ(100, valvePCOpen);
+    // Closes once the anti-seek delay has expired.
+    is0.setReferenceTemperatures(40 << 4);
+    rs0._backfillTemperatures(rs0.computeRawTemp16(is0));
+    for(int i = OTRadValve::DEFAULT_ANTISEEK_VALVE_RECLOSE_DELAY_M + 1; --i >= 0; )
+        { rs0.tick(valvePCOpen, is0, NULL); }
+    EXPECT_EQ(0, valvePCOpen);
+    // Back within the band, control is bumpless from the closed position.
+    is0.setReferenceTemperatures((25 << 4) + 4);
+    rs0._backfillTemperatures(rs0.computeRawTemp16(is0));
+    rs0.isFiltering = 0;
+    rs0.tick(valvePCOpen, is0, NULL);
+    EXPECT_GE(10, valvePCOpen);
+}
+
 /*
 FIXME: tests pending...  See also TODO-1028.
 
@@ -114,6 +114,68 @@ TEST(ModelledRadValveThermalModel, roomHot)
 }
 
 
+namespace MRVTMPI
+{
+// Regulation, movement and energy of one run.
+struct Benchmark_t
+{
+    // Extremes of the temperature seen by the valve relative to the
+    // sweet-spot centre, after the warm-up, in C.
+    double overshootC;
+    double undershootC;
+    // Total valve travel in %.
+    uint32_t movementPC;
+    // Heat delivered in MJ.
+    double energyMJ;
+};
+
+// Run the room from cold to target for the given valve state type.
+template<class MRVS_t>
+Benchmark_t runFromCold(const uint32_t seconds)
+{
+    const TMB::InitConditions_t initCond {
+        16.0f, // room temp in C
+        19.0f, // target temp in C
+        0,     // Valve position in %
+    };
+    TMB::ValveModel<MRVS_t> vm;
+    TMB::ThermalModelBasic tm;
+    TMB::RoomModelBasic rm(initCond, vm, tm);
+    // The valve regulates the temperature at its own sensor,
+    // just above the raw target by the centre offset.
+    const double centreC = initCond.targetTempC
+        + (MRVS_t::centreOffsetC16 - OTRadValve::ModelledRadValveInputState::refTempOffsetC16) / 16.0;
+    TMB::TempBoundsC_t bounds;
+    for(uint32_t i = 0; i < seconds; ++i) {
+        rm.tick(i);
+        if(i > (60 * bounds.startDelayM)) { TMB::updateTempBounds(bounds, vm.getValveTemp()); }
+    }
+    return(Benchmark_t { bounds.max - centreC, centreC - bounds.min, vm.getMovementPC(), vm.getEnergyJ() / 1e6 });
+}
+}
+
+// Benchmark the PI controller against the rule-based algorithm
+// for an all-in-one valve warming a cold room.
+// The PI controller should hold the temperature at least as closely,
+// with far less valve movement and no more heat.
+TEST(ModelledRadValveThermalModel, roomColdPIBenchmark)
+{
+    TMB::verbose = false;
+    static constexpr uint32_t seconds = 12 * 3600;
+    const MRVTMPI::Benchmark_t rb = MRVTMPI::runFromCold<OTRadValve::ModelledRadValveState<>>(seconds);
+    const MRVTMPI::Benchmark_t pi = MRVTMPI::runFromCold<OTRadValve::ModelledRadValveState<false, false, true>>(seconds);
+    if(TMB::verbose) {
+        fprintf(stderr, "rule-based: overshoot %.2fC, undershoot %.2fC, movement %u%%, energy %.2fMJ\n", rb.overshootC, rb.undershootC, unsigned(rb.movementPC), rb.energyMJ);
+        fprintf(stderr, "PI:         overshoot %.2fC, undershoot %.2fC, movement %u%%, energy %.2fMJ\n", pi.overshootC, pi.undershootC, unsigned(pi.movementPC), pi.energyMJ);
+    }
+    EXPECT_GT(1.0, pi.overshootC);
+    EXPECT_GT(1.0, pi.undershootC);
+    EXPECT_GE(rb.overshootC, pi.overshootC);
+    EXPECT_GE(rb.undershootC, pi.undershootC);
+    EXPECT_GT(rb.movementPC, 4 * pi.movementPC);
+    EXPECT_GE(rb.energyMJ, pi.energyMJ);
+}
+
 /* TODO
 
 Test for sticky / jammed / closed value calling for heat in stable temp room running boiler continually: TODO-1096
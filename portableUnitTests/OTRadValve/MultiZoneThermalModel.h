@@ -0,0 +1,250 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+                           Deniz Erbilgin 2019
+*/
+
+/*
+ * Fast coupled multi-zone lumped thermal model of a building,
+ * a C++ port and extension of model/room_model/room_model*.py.
+ *
+ * Each zone has four thermal masses:
+ *   - a radiator, heated by boiler flow in proportion to valve opening,
+ *   - the room air,
+ *   - the inner and outer layers of its external wall
+ *     (as ThermalModelBasic, with the same RoomParams_t),
+ * and zones exchange heat air-to-air through inter-room conductances
+ * (internal walls, doors left open, etc).
+ * Weather is applied as an outside temperature plus per-zone solar/casual gains.
+ *
+ * The model is a fixed-size array of doubles stepped with explicit Euler,
+ * with no virtual calls or allocation, so it can be stepped millions of times
+ * per second, allowing weeks or seasons of control to be evaluated in a test.
+ * The step must not exceed maxStableStepS().
+ */
+
+#ifndef OTRADVALVE_MULTIZONETHERMALMODEL_H
+#define OTRADVALVE_MULTIZONETHERMALMODEL_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "ThermalPhysicsModels.h"
+
+namespace OTRadValve
+{
+namespace PortableUnitTest
+{
+namespace TMB {
+namespace MultiZone {
+
+/**
+ * @brief   Physical constants of one radiator and its valve.
+ */
+struct RadiatorParams_t
+{
+    // Heat capacity of the radiator and its water in J/K.
+    double capacitance;
+    // Conductance from the radiator to the room air in W/K.
+    double conductanceToAir;
+    // Conductance from the boiler flow to the radiator with the valve fully open in W/K,
+    // ie (mass flow) * (specific heat of water).
+    double flowConductance;
+};
+// Roughly a 1kW (at 50K above air) panel radiator on a 0.02kg/s flow.
+static constexpr RadiatorParams_t radiatorParams_Default { 50000.0, 20.0, 84.0 };
+
+/**
+ * @brief   Physical constants of one zone.
+ */
+struct ZoneParams_t
+{
+    // Air and external wall, as for ThermalModelBasic.
+    RoomParams_t room;
+    RadiatorParams_t radiator;
+};
+
+/**
+ * @brief   Coupled thermal model of zones rooms.
+ *
+ * Zones are numbered [0,zones).
+ * Temperatures are in C, heat flows in W, heat in J and times in s.
+ */
+template<size_t zones>
+class MultiZoneThermalModel final
+{
+    static_assert(zones > 0, "need at least one zone");
+
+private:
+    // Working copy of one zone's parameters, with reciprocal capacitances.
+    struct Zone_t
+    {
+        double g21, g10, g0W, gRad, gFlow;
+        double cRad, c2, c1, c0;
+        double invCRad, invC2, invC1, invC0;
+    };
+    Zone_t params[zones];
+    // Air-to-air conductance between zones in W/K; symmetric with a zero diagonal.
+    double coupling[zones][zones];
+
+    // State.
+    double airC[zones];
+    double innerWallC[zones];
+    double outerWallC[zones];
+    double radiatorC[zones];
+    // Valve opening as a fraction [0,1].
+    double valveFraction[zones];
+    // Solar and casual gains directly into the air, in W.
+    double gainW[zones];
+    double outsideC = 0.0;
+    double flowC = 70.0;
+    bool boilerOn = true;
+
+    // Cumulative heat from the boiler flow into each radiator, in J.
+    double heatDeliveredJ[zones];
+
+public:
+    /**
+     * @param   p: parameters of every zone.
+     * @param   initTempC: initial temperature of everything but the radiators,
+     *          which start at the same temperature.
+     */
+    MultiZoneThermalModel(const ZoneParams_t &p, const double initTempC)
+    {
+        for (size_t z = 0; z < zones; ++z) { setZoneParams(z, p); }
+        for (size_t a = 0; a < zones; ++a) { for (size_t b = 0; b < zones; ++b) { coupling[a][b] = 0.0; } }
+        reset(initTempC);
+    }
+
+    // Put all masses at tempC, close all valves and clear gains and totals.
+    void reset(const double tempC)
+    {
+        for (size_t z = 0; z < zones; ++z) {
+            airC[z] = innerWallC[z] = outerWallC[z] = radiatorC[z] = tempC;
+            valveFraction[z] = 0.0;
+            gainW[z] = 0.0;
+            heatDeliveredJ[z] = 0.0;
+        }
+    }
+
+    // Set the parameters of one zone.
+    void setZoneParams(const size_t z, const ZoneParams_t &p)
+    {
+        assert(z < zones);
+        Zone_t &d = params[z];
+        d.g21 = p.room.conductance_21;
+        d.g10 = p.room.conductance_10;
+        d.g0W = p.room.conductance_0W;
+        d.gRad = p.radiator.conductanceToAir;
+        d.gFlow = p.radiator.flowConductance;
+        d.cRad = p.radiator.capacitance;
+        d.c2 = p.room.capacitance_2;
+        d.c1 = p.room.capacitance_1;
+        d.c0 = p.room.capacitance_0;
+        d.invCRad = 1 / d.cRad;
+        d.invC2 = 1 / d.c2;
+        d.invC1 = 1 / d.c1;
+        d.invC0 = 1 / d.c0;
+    }
+    // Set the air-to-air conductance between two distinct zones in W/K.
+    void setCoupling(const size_t a, const size_t b, const double conductance)
+    {
+        assert((a < zones) && (b < zones) && (a != b));
+        coupling[a][b] = coupling[b][a] = conductance;
+    }
+
+    // Valve position of zone z in %, clamped to [0,100].
+    void setValvePCOpen(const size_t z, const uint_fast8_t pc)
+        { assert(z < zones); valveFraction[z] = ((pc > 100) ? 100 : pc) / 100.0; }
+    // Solar/casual gains of zone z in W.
+    void setGain(const size_t z, const double w) { assert(z < zones); gainW[z] = w; }
+    void setOutsideTemp(const double tempC) { outsideC = tempC; }
+    // Boiler flow temperature, and whether the boiler is firing at all.
+    void setFlowTemp(const double tempC) { flowC = tempC; }
+    void setBoilerOn(const bool on) { boilerOn = on; }
+
+    double getAirTemp(const size_t z) const { return (airC[z]); }
+    double getRadiatorTemp(const size_t z) const { return (radiatorC[z]); }
+    double getInnerWallTemp(const size_t z) const { return (innerWallC[z]); }
+    double getOuterWallTemp(const size_t z) const { return (outerWallC[z]); }
+    double getHeatDeliveredJ(const size_t z) const { return (heatDeliveredJ[z]); }
+    double getTotalHeatDeliveredJ() const
+    {
+        double t = 0.0;
+        for (size_t z = 0; z < zones; ++z) { t += heatDeliveredJ[z]; }
+        return (t);
+    }
+
+    /**
+     * @brief   Largest step (in s) for which explicit Euler is stable,
+     *          ie the smallest (heat capacity / total conductance) over all masses.
+     */
+    double maxStableStepS() const
+    {
+        double m = 1e30;
+        for (size_t z = 0; z < zones; ++z) {
+            const Zone_t &p = params[z];
+            double airG = p.g21 + p.gRad;
+            for (size_t o = 0; o < zones; ++o) { airG += coupling[z][o]; }
+            const double tau[4] = {
+                p.cRad / (p.gFlow + p.gRad),
+                p.c2 / airG,
+                p.c1 / (p.g21 + p.g10),
+                p.c0 / (p.g10 + p.g0W) };
+            for (const double t : tau) { if (t < m) { m = t; } }
+        }
+        return (m);
+    }
+
+    /**
+     * @brief   Advance the model by dtS seconds.
+     *
+     * All flows are computed from the state at the start of the step.
+     */
+    void step(const double dtS)
+    {
+        double airIn[zones];
+        for (size_t z = 0; z < zones; ++z) {
+            const Zone_t &p = params[z];
+            const double flowG = boilerOn ? (valveFraction[z] * p.gFlow) : 0.0;
+            // The flow can only heat the radiator.
+            const double flowIn = (flowC > radiatorC[z]) ? (flowG * (flowC - radiatorC[z])) : 0.0;
+            const double radOut = TMHelper::heatTransfer(p.gRad, radiatorC[z], airC[z]);
+            const double air21 = TMHelper::heatTransfer(p.g21, airC[z], innerWallC[z]);
+            const double wall10 = TMHelper::heatTransfer(p.g10, innerWallC[z], outerWallC[z]);
+            const double wall0W = TMHelper::heatTransfer(p.g0W, outerWallC[z], outsideC);
+            double couplingOut = 0.0;
+            for (size_t o = 0; o < zones; ++o) {
+                couplingOut += TMHelper::heatTransfer(coupling[z][o], airC[z], airC[o]);
+            }
+            heatDeliveredJ[z] += flowIn * dtS;
+            radiatorC[z] += (flowIn - radOut) * dtS * p.invCRad;
+            innerWallC[z] += (air21 - wall10) * dtS * p.invC1;
+            outerWallC[z] += (wall10 - wall0W) * dtS * p.invC0;
+            airIn[z] = radOut + gainW[z] - air21 - couplingOut;
+        }
+        // Air last, so that coupling uses start-of-step air temperatures throughout.
+        for (size_t z = 0; z < zones; ++z) { airC[z] += airIn[z] * dtS * params[z].invC2; }
+    }
+};
+
+}
+}
+}
+}
+
+#endif // OTRADVALVE_MULTIZONETHERMALMODEL_H
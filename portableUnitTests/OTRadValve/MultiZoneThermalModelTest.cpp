@@ -0,0 +1,146 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+                           Deniz Erbilgin 2019
+*/
+
+/*
+ * Tests of the coupled multi-zone thermal model,
+ * including a weeks-long run under ModelledRadValve control.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#include "MultiZoneThermalModel.h"
+#include "FleetSimulation.h"
+using namespace OTRadValve::PortableUnitTest;
+
+namespace {
+const TMB::MultiZone::ZoneParams_t zoneParams { TMB::roomParams_Default, TMB::MultiZone::radiatorParams_Default };
+// Step used by the tests; well inside maxStableStepS() for the default parameters.
+const double stepS = 10.0;
+}
+
+// With nothing heating and everything at the outside temperature there is no change.
+TEST(MultiZoneThermalModel, Equilibrium)
+{
+    TMB::MultiZone::MultiZoneThermalModel<2> m(zoneParams, 12.0);
+    m.setOutsideTemp(12.0);
+    m.setCoupling(0, 1, 100.0);
+    EXPECT_LT(stepS, m.maxStableStepS());
+    for (int i = 0; i < 10000; ++i) { m.step(stepS); }
+    EXPECT_DOUBLE_EQ(12.0, m.getAirTemp(0));
+    EXPECT_DOUBLE_EQ(12.0, m.getAirTemp(1));
+    EXPECT_DOUBLE_EQ(0.0, m.getTotalHeatDeliveredJ());
+}
+
+// A single zone with the valve fully open settles to the series-conductance steady state.
+TEST(MultiZoneThermalModel, SingleZoneSteadyState)
+{
+    const double flowC = 70.0;
+    const double outsideC = 0.0;
+    TMB::MultiZone::MultiZoneThermalModel<1> m(zoneParams, outsideC);
+    m.setOutsideTemp(outsideC);
+    m.setFlowTemp(flowC);
+    m.setValvePCOpen(0, 100);
+    // 60 days, long enough for the outer wall to settle.
+    const double seconds = 60 * 86400.0;
+    for (double t = 0; t < seconds; t += stepS) { m.step(stepS); }
+
+    const TMB::MultiZone::RadiatorParams_t &rp = zoneParams.radiator;
+    const TMB::RoomParams_t &room = zoneParams.room;
+    const double r = (1 / rp.flowConductance) + (1 / rp.conductanceToAir) +
+        (1 / room.conductance_21) + (1 / room.conductance_10) + (1 / room.conductance_0W);
+    const double q = (flowC - outsideC) / r;
+    const double radC = flowC - (q / rp.flowConductance);
+    const double airC = radC - (q / rp.conductanceToAir);
+    EXPECT_NEAR(radC, m.getRadiatorTemp(0), 0.05);
+    EXPECT_NEAR(airC, m.getAirTemp(0), 0.05);
+    EXPECT_NEAR(outsideC + (q / room.conductance_0W), m.getOuterWallTemp(0), 0.05);
+    // And the boiler has been supplying about q on average.
+    EXPECT_NEAR(q, m.getHeatDeliveredJ(0) / seconds, 0.1 * q);
+}
+
+// Heat only reaches an unheated zone through the inter-room coupling.
+TEST(MultiZoneThermalModel, Coupling)
+{
+    TMB::MultiZone::MultiZoneThermalModel<2> isolated(zoneParams, 5.0);
+    TMB::MultiZone::MultiZoneThermalModel<2> coupled(zoneParams, 5.0);
+    coupled.setCoupling(0, 1, 100.0);
+    for (auto *m : { &isolated, &coupled }) {
+        m->setOutsideTemp(5.0);
+        m->setValvePCOpen(0, 100);
+        for (int i = 0; i < 4 * 8640; ++i) { m->step(stepS); }
+    }
+    EXPECT_DOUBLE_EQ(5.0, isolated.getAirTemp(1));
+    EXPECT_DOUBLE_EQ(0.0, isolated.getHeatDeliveredJ(1));
+    EXPECT_GT(coupled.getAirTemp(1), 8.0);
+    // The heated zone loses some of its heat to its neighbour.
+    EXPECT_LT(coupled.getAirTemp(0), isolated.getAirTemp(0));
+    EXPECT_LT(coupled.getAirTemp(1), coupled.getAirTemp(0));
+    // Valve closed and boiler off: no more heat goes in.
+    const double delivered = coupled.getTotalHeatDeliveredJ();
+    coupled.setBoilerOn(false);
+    coupled.step(stepS);
+    EXPECT_DOUBLE_EQ(delivered, coupled.getTotalHeatDeliveredJ());
+}
+
+// Four weeks of three coupled rooms in a winter climate,
+// each under its own ModelledRadValveState, ticked once per valve update.
+// After the first day every room should be held near its target.
+TEST(MultiZoneThermalModel, LongHorizonControl)
+{
+    const size_t zones = 3;
+    const TMB::Fleet::Weather_t weather { 3.0, 5.0 };
+    const uint8_t targetC = 20;
+    TMB::MultiZone::MultiZoneThermalModel<zones> m(zoneParams, 10.0);
+    m.setCoupling(0, 1, 60.0);
+    m.setCoupling(1, 2, 60.0);
+    // A sunnier room at one end.
+    m.setGain(2, 100.0);
+    std::vector<TMB::ValveModel<> > valves(zones);
+    for (auto &v : valves) {
+        v.init(TMB::InitConditions_t { 10.0, (double)targetC, 0 });
+        v.setTargetTempC(targetC);
+    }
+
+    const uint32_t days = 28;
+    const uint32_t stepsPerTick = TMB::valveUpdateTime / uint32_t(stepS);
+    double worstErrorC = 0.0;
+    double sumErrorC = 0.0;
+    uint32_t samples = 0;
+    for (uint32_t s = 0; s < days * 86400; s += TMB::valveUpdateTime) {
+        m.setOutsideTemp(weather.outsideTempC(s));
+        for (size_t z = 0; z < zones; ++z) {
+            valves[z].tick(m.getAirTemp(z));
+            m.setValvePCOpen(z, valves[z].getValvePCOpen());
+        }
+        for (uint32_t i = 0; i < stepsPerTick; ++i) { m.step(stepS); }
+        if (s < 86400) { continue; }
+        for (size_t z = 0; z < zones; ++z) {
+            const double errorC = m.getAirTemp(z) - targetC;
+            const double absErrorC = (errorC < 0) ? -errorC : errorC;
+            if (absErrorC > worstErrorC) { worstErrorC = absErrorC; }
+            sumErrorC += absErrorC;
+            ++samples;
+        }
+    }
+    EXPECT_LT(sumErrorC / samples, 0.75);
+    EXPECT_LT(worstErrorC, 2.5);
+    EXPECT_GT(m.getTotalHeatDeliveredJ(), 0.0);
+}
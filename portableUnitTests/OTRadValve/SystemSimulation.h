@@ -0,0 +1,324 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Host-side whole-system simulation in virtual time:
+ * a building of rooms, each with a thermal model, ModelledRadValve valve
+ * and occupancy tracker, whose valves report over a shared simulated radio
+ * medium to a hub running a boiler driver that gates all the radiators.
+ *
+ * All components are driven from one event queue in virtual time,
+ * so weeks or months can be simulated in seconds,
+ * and all randomness comes from a seeded LCG,
+ * so a run is exactly repeatable from its configuration.
+ *
+ * Per-room comfort, energy and airtime, and boiler metrics, are reported.
+ */
+
+#ifndef OTRADVALVE_SYSTEMSIMULATION_H
+#define OTRADVALVE_SYSTEMSIMULATION_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include <OTV0p2Base.h>
+#include <OTRadValve.h>
+
+#include "FleetSimulation.h"
+#include "../OTRadioLink/RadioMediumSimulation.h"
+
+namespace OTRadValve
+{
+namespace PortableUnitTest
+{
+namespace TMB {
+namespace System {
+
+/**
+ * @brief   Runs callbacks in virtual time order.
+ *
+ * Events at the same time run in the order they were scheduled,
+ * so that runs are deterministic.
+ */
+class EventScheduler
+{
+private:
+    struct Event_t
+    {
+        uint64_t atUs;
+        uint64_t seq;
+        std::function<void()> fn;
+    };
+    struct Later
+    {
+        bool operator()(const Event_t &a, const Event_t &b) const
+            { return ((a.atUs != b.atUs) ? (a.atUs > b.atUs) : (a.seq > b.seq)); }
+    };
+    std::priority_queue<Event_t, std::vector<Event_t>, Later> queue;
+    uint64_t nowUs = 0;
+    uint64_t seq = 0;
+    uint64_t processed = 0;
+
+public:
+    // Current virtual time in microseconds.
+    uint64_t now() const { return (nowUs); }
+    // Number of events run so far.
+    uint64_t getProcessed() const { return (processed); }
+    size_t pending() const { return (queue.size()); }
+
+    // Schedule fn at virtual time atUs; times in the past run next.
+    void at(const uint64_t atUs, std::function<void()> fn)
+        { queue.push(Event_t { (atUs < nowUs) ? nowUs : atUs, seq++, std::move(fn) }); }
+    // Schedule fn delayUs after now.
+    void after(const uint64_t delayUs, std::function<void()> fn) { at(nowUs + delayUs, std::move(fn)); }
+
+    // Run events up to and including endUs, then set the time to endUs.
+    void runUntil(const uint64_t endUs)
+    {
+        while (!queue.empty() && (queue.top().atUs <= endUs)) {
+            // Copy out before popping, as the callback may schedule more.
+            const Event_t e = queue.top();
+            queue.pop();
+            nowUs = e.atUs;
+            ++processed;
+            e.fn();
+        }
+        if (endUs > nowUs) { nowUs = endUs; }
+    }
+};
+
+// Hub manager for the default boiler driver: always a hub, with no EEPROM.
+static OTRadValve::OTHubManager<false, false, false> systemHubManager;
+typedef OTRadValve::BoilerLogic::OnOffBoilerDriverLogic<decltype(systemHubManager), systemHubManager, 0> OnOffBoiler_t;
+
+/**
+ * @brief   Configuration of a simulated building.
+ *
+ * Rooms are generated by Fleet::makeFleet() from the seed,
+ * with valves scattered within radiusM of the hub.
+ */
+struct SystemConfig_t
+{
+    size_t rooms = 8;
+    uint32_t seconds = 86400;
+    Fleet::Weather_t weather { 5.0, 6.0 };
+    uint32_t seed = 1;
+    double radiusM = 15.0;
+    // Mean interval between each valve's reports, and the random +/- jitter on each.
+    uint32_t txPeriodS = 240;
+    uint32_t txJitterS = 30;
+    // Bytes on air per report, eg as for a secure frame.
+    uint8_t frameBytes = 24;
+    // Chance each minute that an occupant is noticed, eg by light or controls.
+    double activityPerMinute = 0.2;
+    RMSim::MediumParams_t medium;
+};
+
+// Outcomes for one room and its valve.
+struct RoomResults_t
+{
+    Fleet::RoomMetrics_t comfort;
+    // Reports sent, and their total airtime.
+    uint32_t framesSent = 0;
+    uint64_t airtimeUs = 0;
+    // Minutes the valve was targeting comfort as the room seemed occupied.
+    uint32_t likelyOccupiedM = 0;
+};
+
+// Outcomes for the hub and boiler.
+struct HubResults_t
+{
+    // Reports received and passed to the boiler driver.
+    uint32_t framesReceived = 0;
+    // Time the boiler was firing, and the number of times it was started.
+    double boilerOnH = 0.0;
+    uint32_t boilerStarts = 0;
+};
+
+struct SystemResults_t
+{
+    std::vector<RoomResults_t> rooms;
+    HubResults_t hub;
+    // Room comfort and energy metrics aggregated as for a fleet.
+    Fleet::FleetMetrics_t fleet;
+    RMSim::MediumStats_t medium;
+    // Events run, as a measure of simulation cost.
+    uint64_t events = 0;
+};
+
+/**
+ * @brief   Simulate the building for config.seconds of virtual time.
+ *
+ * Each room steps its thermal model at 1s and its valve and occupancy once a
+ * minute as in Fleet::simulateRoom(), except that a radiator only delivers
+ * heat while the boiler is on (sampled once a minute).
+ * Each valve reports its % open periodically over the radio medium,
+ * and the hub passes the reports it receives to the boiler driver
+ * which it polls every main tick (OTV0P2BASE::MAIN_TICK_S).
+ *
+ * @param   boiler_t: boiler driver, as OnOffBoilerDriverLogic or ZonedBoilerDriverLogic.
+ */
+template<class boiler_t = OnOffBoiler_t, class MRVS_t = OTRadValve::ModelledRadValveState<> >
+SystemResults_t simulateSystem(const SystemConfig_t &c)
+{
+    uint32_t seed = c.seed;
+    // Simple LCG so that runs are identical on every host.
+    auto rnd = [&seed]() { seed = seed * 1664525U + 1013904223U; return (((seed >> 8) & 0xffff) / 65536.0); };
+    const std::vector<Fleet::RoomConfig_t> configs = Fleet::makeFleet(c.rooms, c.weather, c.seed);
+
+    struct Room_t
+    {
+        const Fleet::RoomConfig_t &config;
+        ValveModel<MRVS_t> valve;
+        ThermalModelBasic model;
+        OTV0P2BASE::PseudoSensorOccupancyTracker occupancy;
+        RMSim::SimRadioNode radio;
+        uint_fast8_t lastValvePCOpen;
+        RoomResults_t results;
+        Room_t(const Fleet::RoomConfig_t &config_, RMSim::RadioMedium &medium, const double x, const double y)
+          : config(config_), valve(config_.radParams), model(config_.roomParams),
+            radio(medium, x, y), lastValvePCOpen(0) { }
+    };
+
+    EventScheduler sched;
+    RMSim::RadioMedium medium(c.medium);
+    RMSim::SimRadioNode hubRadio(medium, 0, 0);
+    hubRadio.listen(true, 0);
+    boiler_t boiler;
+    bool boilerOn = false;
+    SystemResults_t results;
+
+    std::vector<std::unique_ptr<Room_t> > rooms;
+    for (size_t i = 0; i < configs.size(); ++i) {
+        const double r = c.radiusM * std::sqrt(rnd());
+        const double a = 2 * 3.14159265358979323846 * rnd();
+        rooms.emplace_back(new Room_t(configs[i], medium, r * std::cos(a), r * std::sin(a)));
+        Room_t &room = *rooms.back();
+        const InitConditions_t init { room.config.initTempC, (double)room.config.occupancy.setbackTempC, 0 };
+        room.valve.init(init);
+        room.model.init(init);
+        room.lastValvePCOpen = room.valve.getValvePCOpen();
+    }
+
+    // Each room: one minute of thermal model, then its valve and occupancy.
+    std::function<void(size_t)> roomMinute = [&](const size_t i) {
+        Room_t &room = *rooms[i];
+        const uint32_t s0 = (uint32_t)(sched.now() / 1000000U);
+        const Fleet::Occupancy_t &occ = room.config.occupancy;
+        if (occ.isOccupied(s0) && (rnd() < c.activityPerMinute)) { room.occupancy.markAsOccupied(); }
+        room.occupancy.read();
+        const bool likely = room.occupancy.isLikelyOccupied();
+        if (likely) { ++room.results.likelyOccupiedM; }
+        room.valve.setTargetTempC(likely ? occ.comfortTempC : occ.setbackTempC);
+        room.model.setOutsideTemp(room.config.weather.outsideTempC(s0));
+        room.valve.tick(room.valve.getValveTemp());
+        Fleet::RoomMetrics_t &m = room.results.comfort;
+        for (uint32_t s = s0; s < s0 + valveUpdateTime; ++s) {
+            const double roomTemp = room.model.getState().roomTemp;
+            const double heatIn = boilerOn ? room.valve.calcHeatFlowRad(roomTemp) : 0.0;
+            room.model.calcNewAirTemperature(heatIn);
+            room.valve.setValveTemp(TMHelper::calcValveTemp(roomTemp, room.valve.getValveTemp(), heatIn));
+            m.energyJ += heatIn;
+            if (occ.isOccupied(s)) {
+                const double errorC = roomTemp - occ.comfortTempC;
+                m.occupiedH += 1 / 3600.0;
+                if (errorC < -Fleet::comfortMarginC) { m.underheatDegH += (-Fleet::comfortMarginC - errorC) / 3600.0; }
+                else if (errorC > Fleet::comfortMarginC) { m.overheatDegH += (errorC - Fleet::comfortMarginC) / 3600.0; }
+            }
+        }
+        const uint_fast8_t pc = room.valve.getValvePCOpen();
+        m.valveMovementPC += (pc > room.lastValvePCOpen) ? (pc - room.lastValvePCOpen) : (room.lastValvePCOpen - pc);
+        room.lastValvePCOpen = pc;
+        sched.after(valveUpdateTime * 1000000ULL, [&roomMinute, i]() { roomMinute(i); });
+    };
+
+    // Each valve: report its ID and % open to the hub.
+    std::function<void(size_t)> roomReport = [&](const size_t i) {
+        Room_t &room = *rooms[i];
+        medium.advanceTo(sched.now());
+        uint8_t frame[RMSim::maxFrameBytes] = { 'H', (uint8_t)((i + 1) >> 8), (uint8_t)(i + 1), (uint8_t)room.valve.getValvePCOpen() };
+        if (room.radio.sendRaw(frame, c.frameBytes)) {
+            ++room.results.framesSent;
+            room.results.airtimeUs += medium.airtimeUs(c.frameBytes);
+        }
+        const double jitterS = ((2 * rnd()) - 1) * c.txJitterS;
+        sched.after((uint64_t)((c.txPeriodS + jitterS) * 1e6), [&roomReport, i]() { roomReport(i); });
+    };
+
+    // Hub: pass on received reports, then poll the boiler driver and record its state.
+    constexpr uint64_t tickUs = OTV0P2BASE::MAIN_TICK_S * 1000000ULL;
+    std::function<void()> hubTick = [&]() {
+        medium.advanceTo(sched.now());
+        const uint32_t s = (uint32_t)(sched.now() / 1000000U);
+        for (const volatile uint8_t *f; NULL != (f = hubRadio.peekRXMsg()); hubRadio.removeRXMsg()) {
+            if ((f[-1] < 4) || ('H' != f[0])) { continue; }
+            ++results.hub.framesReceived;
+            boiler.remoteCallForHeatRX((uint16_t)((f[1] << 8) | f[2]), f[3], (uint8_t)(s / 60U));
+        }
+        boiler.processCallsForHeat(0 == (s % 60U), true);
+        const bool on = boiler.isBoilerOn();
+        if (on && !boilerOn) { ++results.hub.boilerStarts; }
+        boilerOn = on;
+        if (on) { results.hub.boilerOnH += OTV0P2BASE::MAIN_TICK_S / 3600.0; }
+        sched.after(tickUs, hubTick);
+    };
+
+    sched.at(0, hubTick);
+    for (size_t i = 0; i < rooms.size(); ++i) {
+        sched.at(0, [&roomMinute, i]() { roomMinute(i); });
+        sched.at((uint64_t)(rnd() * c.txPeriodS * 1e6), [&roomReport, i]() { roomReport(i); });
+    }
+    sched.runUntil((uint64_t)c.seconds * 1000000U - 1);
+
+    std::vector<Fleet::RoomMetrics_t> comfort;
+    for (const std::unique_ptr<Room_t> &r : rooms) {
+        results.rooms.push_back(r->results);
+        comfort.push_back(r->results.comfort);
+    }
+    results.fleet = Fleet::aggregate(comfort);
+    results.medium = medium.getStats();
+    results.events = sched.getProcessed();
+    return (results);
+}
+
+/**
+ * @brief   Write per-room results as CSV, with a header line.
+ */
+inline void writeRoomsCSV(FILE *const out, const SystemResults_t &r)
+{
+    fprintf(out, "room,energyKWh,underheatDegH,overheatDegH,occupiedH,valveMovementPC,framesSent,airtimeS,likelyOccupiedH\n");
+    for (size_t i = 0; i < r.rooms.size(); ++i) {
+        const RoomResults_t &room = r.rooms[i];
+        fprintf(out, "%lu,%.3f,%.3f,%.3f,%.2f,%lu,%lu,%.3f,%.2f\n", (unsigned long)i,
+                room.comfort.energyJ / 3.6e6, room.comfort.underheatDegH, room.comfort.overheatDegH,
+                room.comfort.occupiedH, (unsigned long)room.comfort.valveMovementPC,
+                (unsigned long)room.framesSent, room.airtimeUs / 1e6, room.likelyOccupiedM / 60.0);
+    }
+}
+
+}
+}
+}
+}
+
+#endif // OTRADVALVE_SYSTEMSIMULATION_H
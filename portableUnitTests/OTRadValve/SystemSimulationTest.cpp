@@ -0,0 +1,122 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Tests of the whole-system virtual-time simulation.
+ *
+ * Kept to a few simulated days so as to run quickly;
+ * longer runs can be used to evaluate control and protocol changes.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#include "SystemSimulation.h"
+using namespace OTRadValve::PortableUnitTest;
+
+// Events run in time order, and in scheduling order at equal times.
+TEST(SystemSimulation, Scheduler)
+{
+    TMB::System::EventScheduler s;
+    std::vector<int> order;
+    s.at(200, [&]() { order.push_back(2); });
+    s.at(100, [&]() { order.push_back(1); s.after(100, [&]() { order.push_back(3); }); });
+    s.at(200, [&]() { order.push_back(4); });
+    s.at(301, [&]() { order.push_back(5); });
+    s.runUntil(300);
+    ASSERT_EQ(4U, order.size());
+    EXPECT_EQ(1, order[0]);
+    EXPECT_EQ(2, order[1]);
+    EXPECT_EQ(4, order[2]);
+    EXPECT_EQ(3, order[3]);
+    EXPECT_EQ(300U, s.now());
+    EXPECT_EQ(1U, s.pending());
+    EXPECT_EQ(4U, s.getProcessed());
+}
+
+// A cold building calls for heat over the radio and is kept mostly comfortable,
+// and identical configurations give identical results.
+TEST(SystemSimulation, ColdBuilding)
+{
+    TMB::System::SystemConfig_t c;
+    c.rooms = 6;
+    c.seconds = 2 * 86400;
+    c.seed = 42;
+    const TMB::System::SystemResults_t r = TMB::System::simulateSystem<>(c);
+    ASSERT_EQ(c.rooms, r.rooms.size());
+    EXPECT_LT(0U, r.hub.boilerStarts);
+    EXPECT_LT(1.0, r.hub.boilerOnH);
+    EXPECT_GT(48.0, r.hub.boilerOnH);
+    EXPECT_LT(0.0, r.fleet.totalEnergyKWh);
+    uint32_t sent = 0;
+    for (const TMB::System::RoomResults_t &room : r.rooms) {
+        EXPECT_NEAR(2 * 86400 / 240.0, room.framesSent, 20);
+        EXPECT_NEAR(room.framesSent * 4.6e3, (double)room.airtimeUs, room.framesSent * 1e3);
+        EXPECT_LT(0U, room.likelyOccupiedM);
+        EXPECT_LT(0.0, room.comfort.occupiedH);
+        sent += room.framesSent;
+    }
+    // Almost every report reaches the hub.
+    EXPECT_LE(0.95 * sent, r.hub.framesReceived);
+    EXPECT_GE(sent, r.hub.framesReceived);
+    // Comfort and energy much as for the same rooms with an always-available boiler.
+    const TMB::Fleet::FleetMetrics_t f =
+        TMB::Fleet::simulateFleet(TMB::Fleet::makeFleet(c.rooms, c.weather, c.seed), c.seconds, 1);
+    EXPECT_NEAR(f.meanUnderheatDegH, r.fleet.meanUnderheatDegH, 0.1 * f.meanUnderheatDegH);
+    EXPECT_NEAR(f.totalEnergyKWh, r.fleet.totalEnergyKWh, 0.1 * f.totalEnergyKWh);
+    EXPECT_LT(uint64_t(2 * 86400 / OTV0P2BASE::MAIN_TICK_S), r.events);
+
+    const TMB::System::SystemResults_t again = TMB::System::simulateSystem<>(c);
+    EXPECT_EQ(r.fleet.totalEnergyKWh, again.fleet.totalEnergyKWh);
+    EXPECT_EQ(r.hub.boilerOnH, again.hub.boilerOnH);
+    EXPECT_EQ(r.hub.framesReceived, again.hub.framesReceived);
+    EXPECT_EQ(r.events, again.events);
+    c.seed = 43;
+    EXPECT_NE(r.fleet.totalEnergyKWh, TMB::System::simulateSystem<>(c).fleet.totalEnergyKWh);
+}
+
+// Without the radio the boiler never fires and the rooms go cold.
+TEST(SystemSimulation, NoRadio)
+{
+    TMB::System::SystemConfig_t c;
+    c.rooms = 4;
+    c.seconds = 86400;
+    const TMB::System::SystemResults_t withRadio = TMB::System::simulateSystem<>(c);
+    c.medium.sensitivityDBm = 0;
+    const TMB::System::SystemResults_t r = TMB::System::simulateSystem<>(c);
+    EXPECT_EQ(0U, r.hub.framesReceived);
+    EXPECT_EQ(0U, r.hub.boilerStarts);
+    EXPECT_EQ(0.0, r.fleet.totalEnergyKWh);
+    EXPECT_LT(0U, r.medium.lostWeak);
+    EXPECT_LT(withRadio.fleet.meanUnderheatDegH, r.fleet.meanUnderheatDegH);
+}
+
+// Milder weather needs less boiler time.
+TEST(SystemSimulation, Weather)
+{
+    TMB::System::SystemConfig_t c;
+    c.rooms = 4;
+    c.seconds = 86400;
+    const TMB::System::SystemResults_t cold = TMB::System::simulateSystem<>(c);
+    c.weather = TMB::Fleet::Weather_t { 15.0, 4.0 };
+    const TMB::System::SystemResults_t mild = TMB::System::simulateSystem<>(c);
+    EXPECT_GT(cold.hub.boilerOnH, mild.hub.boilerOnH);
+    EXPECT_GT(cold.fleet.totalEnergyKWh, mild.fleet.totalEnergyKWh);
+    EXPECT_GE(cold.fleet.meanUnderheatDegH, mild.fleet.meanUnderheatDegH);
+}
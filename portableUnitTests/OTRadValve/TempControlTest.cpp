@@ -206,3 +206,42 @@ TEST(TempControl,FROSTRH)
      const uint8_t hft = TRV1ValveControlParameters::FROST_COM;
      EXPECT_EQ(hft, tctp.getFROSTTargetC());
 }
+
+// Cached FROST and WARM targets follow pot and humidity changes.
+namespace FROSTCache {
+  constexpr uint8_t loEndStop = 10;
+  constexpr uint8_t hiEndStop = 245;
+  OTV0P2BASE::SensorTemperaturePotMock tp(loEndStop, hiEndStop);
+  OTV0P2BASE::HumiditySensorMock rh;
+  }
+TEST(TempControl,FROSTWARMCache)
+{
+    typedef OTRadValve::DEFAULT_ValveControlParameters vcp;
+    OTRadValve::TempControlTempPot
+        <
+        decltype(FROSTCache::tp), &FROSTCache::tp,
+        vcp,
+        decltype(FROSTCache::rh), &FROSTCache::rh
+        > tctp;
+    FROSTCache::rh.set(0, false);
+    // Coldest: eco bias.
+    FROSTCache::tp.set(0);
+    EXPECT_EQ(int(vcp::TEMP_SCALE_MIN), tctp.getWARMTargetC());
+    EXPECT_EQ(int(vcp::FROST_ECO), tctp.getFROSTTargetC());
+    EXPECT_EQ(int(vcp::FROST_ECO), tctp.getFROSTTargetC());
+    // Humidity change alone is seen.
+    FROSTCache::rh.set(100, true);
+    EXPECT_EQ(int(vcp::FROST_COM), tctp.getFROSTTargetC());
+    FROSTCache::rh.set(0, false);
+    EXPECT_EQ(int(vcp::FROST_ECO), tctp.getFROSTTargetC());
+    // Pot change alone is seen, first through FROST.
+    FROSTCache::tp.set(255);
+    EXPECT_EQ(int(vcp::FROST_COM), tctp.getFROSTTargetC());
+    EXPECT_EQ(int(vcp::TEMP_SCALE_MAX), tctp.getWARMTargetC());
+    EXPECT_FALSE(tctp.hasEcoBias());
+    // And first through WARM.
+    FROSTCache::tp.set(0);
+    EXPECT_EQ(int(vcp::TEMP_SCALE_MIN), tctp.getWARMTargetC());
+    EXPECT_EQ(int(vcp::FROST_ECO), tctp.getFROSTTargetC());
+    EXPECT_TRUE(tctp.hasEcoBias());
+}
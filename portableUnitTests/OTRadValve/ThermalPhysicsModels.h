@@ -179,6 +179,10 @@ private:
     // Delay in radiator responding to change in valvePCOpen. Should possibly be asymmetric.
     std::vector<uint_fast8_t> responseDelay = {0, 0, 0, 0, 0};
 
+    // Total valve movement in %, and heat delivered in J.
+    uint32_t movementPC = 0;
+    double energyJ = 0.0;
+
 public:
     ValveModel(const RadParams_t _radParams = radParams_Default) : radParams(_radParams) {}
 
@@ -200,7 +204,9 @@ public:
      */
     void tick(const double curTempC) override {
         is0.setReferenceTemperatures((uint_fast16_t)(curTempC * 16));
+        const uint_fast8_t oldValvePCOpen = state.valvePCOpen;
         rs0.tick(state.valvePCOpen, is0, NULL);
+        movementPC += OTV0P2BASE::fnabsdiff(oldValvePCOpen, uint_fast8_t(state.valvePCOpen));
 
         // May make more sense in the thermal model, but only needs to be run
         // once every time this function is called.
@@ -218,6 +224,8 @@ public:
         const double heatFlow = (radTemp > airTempC) ? 
             (TMHelper::heatTransfer(radParams.conductance, scaledRadTemp, airTempC)) : 0.0;
         state.radHeatFlow = heatFlow;
+        // Called once per second.
+        energyJ += heatFlow;
         return (heatFlow);
     }
 
@@ -225,9 +233,15 @@ public:
     uint_fast8_t getValvePCOpen() const override { return (state.valvePCOpen); }
     uint_fast8_t getEffectiveValvePCOpen() const override { return (responseDelay.front()); }
     double getTargetTempC() const override { return (is0.targetTempC); }
+    // Set target temperature in C, eg to follow an occupancy schedule.
+    void setTargetTempC(const uint8_t tempC) { is0.targetTempC = tempC; }
     void setValveTemp(double tempC) override { state.valveTemp = tempC; }
     double getValveTemp() const override { return (state.valveTemp); }
     double getHeatInput() const override { return (state.radHeatFlow); }
+    // Total valve movement in % since init, eg as a proxy for motor energy and noise.
+    uint32_t getMovementPC() const { return (movementPC); }
+    // Total heat delivered by the radiator in J since init.
+    double getEnergyJ() const { return (energyJ); }
 };
 
 
@@ -0,0 +1,161 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * OTRadValve hub-pushed valve command tests.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+
+#include "OTRadValve_ValveCommand.h"
+
+namespace VCT
+{
+// Settable targets that keep FROST <= WARM as the real ones do.
+class SettableTargets final : public OTRadValve::TempControlSettableInterface
+    {
+    public:
+        uint8_t frost = 6;
+        uint8_t warm = 18;
+        virtual bool setFROSTTargetC(const uint8_t tempC) override
+            { if((tempC < OTRadValve::MIN_TARGET_C) || (tempC > warm)) { return(false); } frost = tempC; return(true); }
+        virtual bool setWARMTargetC(const uint8_t tempC) override
+            { if((tempC > OTRadValve::MAX_TARGET_C) || (tempC < frost)) { return(false); } warm = tempC; return(true); }
+    };
+static const uint8_t id1[8] = { 0x81, 1, 2, 3, 4, 5, 6, 7 };
+static const uint8_t id2[8] = { 0x82, 1, 2, 3, 4, 5, 6, 7 };
+}
+
+// Commands survive encoding and bad ones are rejected.
+TEST(ValveCommand, EncodeDecode)
+{
+    OTRadValve::ValveCommand c;
+    uint8_t buf[OTRadValve::VALVE_COMMAND_BODY_BYTES + 2];
+    // Empty command is invalid.
+    EXPECT_EQ(0, OTRadValve::encodeValveCommand(buf, sizeof(buf), c));
+    c.setWARMTargetC(21);
+    c.setMode(OTRadValve::ValveMode::VMODE_BAKE);
+    c.seq = 42;
+    EXPECT_EQ(0, OTRadValve::encodeValveCommand(buf, OTRadValve::VALVE_COMMAND_BODY_BYTES - 1, c));
+    ASSERT_EQ(OTRadValve::VALVE_COMMAND_BODY_BYTES, OTRadValve::encodeValveCommand(buf, sizeof(buf), c));
+    OTRadValve::ValveCommand d;
+    ASSERT_TRUE(OTRadValve::decodeValveCommand(buf, sizeof(buf), d));
+    EXPECT_TRUE(d.sameState(c));
+    EXPECT_EQ(42, d.seq);
+    // Out of range target.
+    buf[2] = OTRadValve::MAX_TARGET_C + 1;
+    EXPECT_FALSE(OTRadValve::decodeValveCommand(buf, sizeof(buf), d));
+    buf[2] = 21;
+    // Unknown field.
+    buf[1] |= 0x80;
+    EXPECT_FALSE(OTRadValve::decodeValveCommand(buf, sizeof(buf), d));
+    buf[1] &= 0x7f;
+    // Wrong format byte or too short.
+    EXPECT_FALSE(OTRadValve::decodeValveCommand(buf, OTRadValve::VALVE_COMMAND_BODY_BYTES - 1, d));
+    buf[0] = 'K';
+    EXPECT_FALSE(OTRadValve::decodeValveCommand(buf, sizeof(buf), d));
+}
+
+// The hub merges superseded commands and resends until confirmed.
+TEST(ValveCommand, QueueCoalescing)
+{
+    OTRadValve::ValveCommandQueue<2, 3> q;
+    OTRadValve::ValveCommand c;
+    c.setWARMTargetC(19);
+    ASSERT_TRUE(q.set(VCT::id1, c));
+    OTRadValve::ValveCommand c2;
+    c2.setWARMTargetC(20);
+    c2.setMode(OTRadValve::ValveMode::VMODE_WARM);
+    ASSERT_TRUE(q.set(VCT::id1, c2));
+    OTRadValve::ValveCommand c3;
+    c3.setFROSTTargetC(7);
+    ASSERT_TRUE(q.set(VCT::id1, c3));
+    EXPECT_EQ(2, q.getCoalesced());
+    EXPECT_EQ(1, q.getPendingCount());
+    // Same state again is not a new command.
+    ASSERT_TRUE(q.set(VCT::id1, c3));
+    EXPECT_EQ(2, q.getCoalesced());
+    // Second valve, then table full.
+    ASSERT_TRUE(q.set(VCT::id2, c));
+    const uint8_t id3[8] = { 0x83 };
+    EXPECT_FALSE(q.set(id3, c));
+
+    // Delivered by ID prefix, after an ack body.
+    uint8_t body[32];
+    memset(body, 'K', 7);
+    EXPECT_EQ(0, q.appendFor(id3, 4, body + 7, sizeof(body) - 7));
+    ASSERT_EQ(OTRadValve::VALVE_COMMAND_BODY_BYTES, q.appendFor(VCT::id1, 4, body + 7, sizeof(body) - 7));
+    OTRadValve::ValveCommand d;
+    ASSERT_TRUE(OTRadValve::decodeValveCommand(body + 7, sizeof(body) - 7, d));
+    EXPECT_EQ(20, d.warmC);
+    EXPECT_EQ(7, d.frostC);
+    EXPECT_EQ(OTRadValve::ValveMode::VMODE_WARM, d.mode);
+    // Wrong seq does not confirm; right one clears.
+    EXPECT_FALSE(q.confirm(VCT::id1, 4, uint8_t(d.seq + 1)));
+    EXPECT_TRUE(q.confirm(VCT::id1, 4, d.seq));
+    EXPECT_EQ(0, q.appendFor(VCT::id1, 4, body, sizeof(body)));
+    // Unconfirmed commands are dropped after maxDeliveries.
+    for(int i = 0; i < 3; ++i) { EXPECT_NE(0, q.appendFor(VCT::id2, 2, body, sizeof(body))); }
+    EXPECT_EQ(0, q.appendFor(VCT::id2, 2, body, sizeof(body)));
+    EXPECT_EQ(1, q.getDropped());
+    EXPECT_EQ(0, q.getPendingCount());
+}
+
+// The valve applies each new command once, keeping FROST <= WARM.
+TEST(ValveCommand, Applier)
+{
+    OTRadValve::ValveMode vm;
+    VCT::SettableTargets t;
+    OTRadValve::ValveCommandApplier a(vm, &t);
+    uint8_t seq;
+    EXPECT_FALSE(a.getLastSeq(seq));
+    // Raising FROST above the old WARM needs WARM to go first.
+    OTRadValve::ValveCommand c;
+    c.setWARMTargetC(25);
+    c.setFROSTTargetC(20);
+    c.setMode(OTRadValve::ValveMode::VMODE_WARM);
+    c.seq = 9;
+    uint8_t body[OTRadValve::VALVE_COMMAND_BODY_BYTES];
+    ASSERT_NE(0, OTRadValve::encodeValveCommand(body, sizeof(body), c));
+    EXPECT_TRUE(a.applyBody(body, sizeof(body)));
+    EXPECT_EQ(25, t.warm);
+    EXPECT_EQ(20, t.frost);
+    EXPECT_TRUE(vm.inWarmMode());
+    ASSERT_TRUE(a.getLastSeq(seq));
+    EXPECT_EQ(9, seq);
+    // A repeat is ignored.
+    vm.setWarmModeDebounced(false);
+    EXPECT_FALSE(a.applyBody(body, sizeof(body)));
+    EXPECT_FALSE(vm.inWarmMode());
+    // Lowering WARM below the old FROST needs FROST to go first.
+    OTRadValve::ValveCommand c2;
+    c2.setWARMTargetC(10);
+    c2.setFROSTTargetC(8);
+    c2.seq = 10;
+    EXPECT_TRUE(a.apply(c2));
+    EXPECT_EQ(10, t.warm);
+    EXPECT_EQ(8, t.frost);
+    // Mode only, without settable targets.
+    OTRadValve::ValveCommandApplier a2(vm, NULL);
+    OTRadValve::ValveCommand c3;
+    c3.setMode(OTRadValve::ValveMode::VMODE_BAKE);
+    EXPECT_TRUE(a2.apply(c3));
+    EXPECT_TRUE(vm.inBakeMode());
+}
@@ -0,0 +1,125 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for ValveControlProfileTable tests.
+ */
+
+#include <gtest/gtest.h>
+
+#include "OTRadValve_Parameters.h"
+#include "OTRadValve_ValveControlProfiles.h"
+
+
+// Profiles are kept sorted and found by ID whatever the insertion order.
+TEST(ValveControlProfiles, lookup)
+{
+    OTRadValve::ValveControlProfileTable<8> t;
+    typedef OTRadValve::ValveControlProfileTable<8> table_t;
+    EXPECT_EQ(0, t.size());
+    EXPECT_EQ(int(table_t::NOT_FOUND), t.indexOf(3));
+    const uint8_t ids[] = { 40, 3, 200, 17, 0 };
+    for(uint8_t i = 0; i < sizeof(ids); ++i)
+        { EXPECT_TRUE(t.set(ids[i], uint8_t(6 + i), uint8_t(18 + i), 10, 3, 6)); }
+    EXPECT_EQ(5, t.size());
+    for(uint8_t s = 1; s < t.size(); ++s) { EXPECT_LT(t.getID(uint8_t(s-1)), t.getID(s)); }
+    for(uint8_t i = 0; i < sizeof(ids); ++i)
+        {
+        const uint8_t s = t.indexOf(ids[i]);
+        ASSERT_NE(int(table_t::NOT_FOUND), s);
+        EXPECT_EQ(ids[i], t.getID(s));
+        EXPECT_EQ(6 + i, t.getFROSTTargetC(s));
+        EXPECT_EQ(18 + i, t.getWARMTargetC(s));
+        }
+    EXPECT_EQ(int(table_t::NOT_FOUND), t.indexOf(41));
+    // Replacing keeps the size.
+    EXPECT_TRUE(t.set(17, 7, 21, 5, 2, 4));
+    EXPECT_EQ(5, t.size());
+    const uint8_t s17 = t.indexOf(17);
+    EXPECT_EQ(21, t.getWARMTargetC(s17));
+    EXPECT_EQ(5, t.getBakeUpliftC(s17));
+    EXPECT_EQ(2, t.getSetbackECOC(s17));
+    EXPECT_EQ(4, t.getSetbackFULLC(s17));
+    const OTRadValve::ValveControlParametersRTBase rt = t.getRT(s17);
+    EXPECT_EQ(5, rt.BAKE_UPLIFT);
+    EXPECT_EQ(2, rt.SETBACK_ECO);
+    EXPECT_EQ(4, rt.SETBACK_FULL);
+    t.clear();
+    EXPECT_EQ(0, t.size());
+    EXPECT_EQ(int(table_t::NOT_FOUND), t.indexOf(17));
+}
+
+// Invalid profiles and overflow are refused.
+TEST(ValveControlProfiles, validation)
+{
+    OTRadValve::ValveControlProfileTable<2> t;
+    EXPECT_FALSE(t.set(1, 4, 18, 10, 3, 6)); // FROST below minimum.
+    EXPECT_FALSE(t.set(1, 18, 18, 10, 3, 6)); // WARM not above FROST.
+    EXPECT_FALSE(t.set(1, 6, 96, 10, 3, 6)); // WARM above maximum.
+    EXPECT_FALSE(t.set(1, 6, 18, 0, 3, 6)); // No BAKE uplift.
+    EXPECT_FALSE(t.set(1, 6, 18, 10, 1, 6)); // ECO setback not above default.
+    EXPECT_FALSE(t.set(1, 6, 18, 10, 6, 6)); // FULL setback not above ECO.
+    EXPECT_EQ(0, t.size());
+    EXPECT_TRUE(t.setFrom<OTRadValve::DEFAULT_ValveControlParameters>(1));
+    EXPECT_TRUE(t.setFrom<OTRadValve::DEFAULT_DHW_ValveControlParameters>(2));
+    EXPECT_FALSE(t.set(3, 6, 18, 10, 3, 6)); // Full.
+    EXPECT_TRUE(t.set(2, 6, 18, 10, 3, 6)); // Replacing is still allowed.
+    EXPECT_EQ(int(OTRadValve::DEFAULT_ValveControlParameters::WARM), t.getWARMTargetC(t.indexOf(1)));
+    EXPECT_EQ(int(OTRadValve::DEFAULT_ValveControlParameters::FROST), t.getFROSTTargetC(t.indexOf(1)));
+}
+
+// Packed image loading skips bad and partial records.
+TEST(ValveControlProfiles, load)
+{
+    OTRadValve::ValveControlProfileTable<4> t;
+    const uint8_t image[] =
+        {
+        9, 7, 19, 10, 3, 6,
+        2, 6, 5, 10, 3, 6, // Bad: WARM below FROST.
+        5, 12, 22, 8, 2, 5,
+        1, 6, 18, // Partial.
+        };
+    EXPECT_EQ(0, t.load(NULL, 10));
+    EXPECT_EQ(2, t.load(image, sizeof(image)));
+    EXPECT_EQ(2, t.size());
+    EXPECT_EQ(22, t.getWARMTargetC(t.indexOf(5)));
+    EXPECT_EQ(19, t.getWARMTargetC(t.indexOf(9)));
+    EXPECT_EQ(int(OTRadValve::ValveControlProfileTable<4>::NOT_FOUND), t.indexOf(2));
+}
+
+// TempControl for a profile reads the table, falling back to the defaults.
+TEST(ValveControlProfiles, tempControl)
+{
+    typedef OTRadValve::DEFAULT_ValveControlParameters vcp;
+    OTRadValve::ValveControlProfileTable<4> t;
+    EXPECT_TRUE(t.set(3, 8, 20, 10, 3, 6));
+    const OTRadValve::TempControlProfile<4, vcp> tc(t, 3);
+    EXPECT_TRUE(tc.isValid());
+    EXPECT_EQ(8, tc.getFROSTTargetC());
+    EXPECT_EQ(20, tc.getWARMTargetC());
+    EXPECT_EQ(int(vcp::TEMP_SCALE_MIN), tc.getMinWARMTargetC());
+    EXPECT_FALSE(tc.hasEcoBias());
+    // Values replaced in place are seen.
+    EXPECT_TRUE(t.set(3, 8, 17, 10, 3, 6));
+    EXPECT_EQ(17, tc.getWARMTargetC());
+    EXPECT_TRUE(tc.hasEcoBias());
+    const OTRadValve::TempControlProfile<4, vcp> missing(t, 4);
+    EXPECT_FALSE(missing.isValid());
+    EXPECT_EQ(int(vcp::FROST), missing.getFROSTTargetC());
+    EXPECT_EQ(int(vcp::WARM), missing.getWARMTargetC());
+}
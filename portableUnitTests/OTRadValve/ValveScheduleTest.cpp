@@ -127,5 +127,45 @@ TEST(SimpleValveSchedule,isAnyScheduleOnWARMNow0)
         }
 }
 
+// Check that the cached transitions give the same answers as decoding each schedule,
+// through whole days with random and overlapping/wrapping schedules.
+TEST(SimpleValveSchedule,transitionCache)
+{
+    srandom((unsigned)::testing::UnitTest::GetInstance()->random_seed()); // Seed random() for use in tests; --gtest_shuffle will force it to change.
+
+    constexpr uint8_t nSched = OTRadValve::SimpleValveScheduleParams::MAX_CACHED_SCHEDULES;
+    // Cached.
+    OTRadValve::SimpleValveScheduleMock<nSched> svsc;
+    // Too many schedules to cache, so decodes the programme bytes on every call.
+    OTRadValve::SimpleValveScheduleMock<nSched + 1> svsd;
+    for(int r = 0; r < 20; ++r)
+        {
+        for(uint8_t i = 0; i < nSched; ++i)
+            {
+            // Sometimes leave cleared; cluster the rest near midnight to force overlaps and wraps.
+            const long v = random() % 4;
+            if(0 == v) { svsc.clearSimpleSchedule(i); svsd.clearSimpleSchedule(i); continue; }
+            const uint16_t time = (1 == v) ? (uint16_t)(random() % 120) :
+                (uint16_t)(((unsigned)random()) % OTV0P2BASE::MINS_PER_DAY);
+            svsc.setSimpleSchedule(time, i);
+            svsd.setSimpleSchedule(time, i);
+            }
+        for(uint16_t m = 0; m < OTV0P2BASE::MINS_PER_DAY; ++m)
+            {
+            ASSERT_EQ(svsd.isAnyScheduleOnWARMNow(m), svsc.isAnyScheduleOnWARMNow(m)) << m;
+            ASSERT_EQ(svsd.isAnyScheduleOnWARMSoon(m), svsc.isAnyScheduleOnWARMSoon(m)) << m;
+            const uint16_t lead = (uint16_t)(random() % OTV0P2BASE::MINS_PER_DAY);
+            ASSERT_EQ(svsd.isAnyScheduleOnWARMWithin(m, lead), svsc.isAnyScheduleOnWARMWithin(m, lead)) << m << " " << lead;
+            }
+        }
+    // Clearing everything leaves no WARM time.
+    for(uint8_t i = 0; i < nSched; ++i) { svsc.clearSimpleSchedule(i); }
+    for(uint16_t m = 0; m < OTV0P2BASE::MINS_PER_DAY; ++m)
+        {
+        EXPECT_FALSE(svsc.isAnyScheduleOnWARMNow(m));
+        EXPECT_FALSE(svsc.isAnyScheduleOnWARMWithin(m, OTV0P2BASE::MINS_PER_DAY - 1));
+        }
+}
+
 
 // TODO: needs more thorough checking, eg through a whole simulated day.
@@ -0,0 +1,115 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * OTRadValve WarmupRateEstimator tests.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <OTRadValve.h>
+
+// Check the variable look-ahead of schedules, including across midnight.
+TEST(WarmupRateEstimator, ScheduleWithin)
+{
+    OTRadValve::SimpleValveScheduleMock<> svs;
+    EXPECT_FALSE(svs.isAnyScheduleOnWARMWithin(0, 1439));
+    // On at 06:00 less the fixed pre-warm.
+    svs.setSimpleSchedule(6 * 60, 0);
+    const uint16_t on = svs.getSimpleScheduleOn(0);
+    EXPECT_TRUE(svs.isAnyScheduleOnWARMWithin(on - 100, 100));
+    EXPECT_FALSE(svs.isAnyScheduleOnWARMWithin(on - 101, 100));
+    // Every minute in between too, unlike a single-point check.
+    EXPECT_TRUE(svs.isAnyScheduleOnWARMWithin(on - 50, 100));
+    // While on.
+    EXPECT_TRUE(svs.isAnyScheduleOnWARMWithin(on + 10, 0));
+    // Across midnight.
+    svs.setSimpleSchedule(0, 0);
+    const uint16_t on2 = svs.getSimpleScheduleOn(0);
+    ASSERT_GT(on2, 1200);
+    EXPECT_TRUE(svs.isAnyScheduleOnWARMWithin(on2 - 30, 30));
+    EXPECT_FALSE(svs.isAnyScheduleOnWARMWithin(on2 - 31, 30));
+    EXPECT_FALSE(svs.isAnyScheduleOnWARMWithin(OTV0P2BASE::MINS_PER_DAY, 1000));
+}
+
+// Check learning of the warm-up rate and derived lead times.
+TEST(WarmupRateEstimator, Learn)
+{
+    typedef OTV0P2BASE::NVByHourByteStatsBase s_t;
+    OTV0P2BASE::NVByHourByteStatsMock stats;
+    OTRadValve::WarmupRateEstimator w;
+    EXPECT_EQ(0, w.getRateC16PerH());
+    EXPECT_EQ(0, w.getLeadMins(15 << 4, 20));
+    // 1C rise over 06:00 to 07:00 with the valve open.
+    stats.setByHourStatSimple(s_t::STATS_SET_TEMP_BY_HOUR, 6, OTV0P2BASE::compressTempC16(16 << 4));
+    stats.setByHourStatSimple(s_t::STATS_SET_TEMP_BY_HOUR, 7, OTV0P2BASE::compressTempC16(17 << 4));
+    // Valve not open long enough: ignored.
+    for(int i = 0; i < 44; ++i) { w.tickMinute(100); }
+    for(int i = 0; i < 16; ++i) { w.tickMinute(0); }
+    w.endOfHour(stats, 7);
+    EXPECT_EQ(0, w.getRateC16PerH());
+    for(int i = 0; i < 60; ++i) { w.tickMinute(OTRadValve::DEFAULT_VALVE_PC_SAFER_OPEN); }
+    w.endOfHour(stats, 7);
+    EXPECT_EQ(16, w.getRateC16PerH());
+    // 3C short at 1C/h.
+    EXPECT_EQ(180, w.getLeadMins(17 << 4, 20));
+    EXPECT_EQ(0, w.getLeadMins(20 << 4, 20));
+    EXPECT_EQ(240, w.getLeadMins(10 << 4, 20));
+    // No rise with the valve open counts as slow and pulls the rate down.
+    stats.setByHourStatSimple(s_t::STATS_SET_TEMP_BY_HOUR, 7, OTV0P2BASE::compressTempC16(16 << 4));
+    for(int i = 0; i < 60; ++i) { w.tickMinute(100); }
+    w.endOfHour(stats, 7);
+    EXPECT_EQ(13, w.getRateC16PerH());
+    // Missing samples are ignored.
+    for(int i = 0; i < 60; ++i) { w.tickMinute(100); }
+    w.endOfHour(stats, 9);
+    EXPECT_EQ(13, w.getRateC16PerH());
+    w.reset();
+    EXPECT_EQ(0, w.getRateC16PerH());
+}
+
+// Check that pre-warm starts earlier than the fixed pre-pre-warm only when the room is slow to warm.
+TEST(WarmupRateEstimator, PreWarm)
+{
+    typedef OTV0P2BASE::NVByHourByteStatsBase s_t;
+    OTV0P2BASE::NVByHourByteStatsMock stats;
+    OTRadValve::WarmupRateEstimator w;
+    OTRadValve::SimpleValveScheduleMock<> svs;
+    svs.setSimpleSchedule(8 * 60, 0);
+    const uint16_t on = svs.getSimpleScheduleOn(0);
+    // Unknown rate: nothing beyond the fixed behaviour.
+    EXPECT_FALSE(w.isPreWarmDue(svs, on - 120, 14 << 4, 20));
+    // Learn 1C/h.
+    stats.setByHourStatSimple(s_t::STATS_SET_TEMP_BY_HOUR, 2, OTV0P2BASE::compressTempC16(16 << 4));
+    stats.setByHourStatSimple(s_t::STATS_SET_TEMP_BY_HOUR, 3, OTV0P2BASE::compressTempC16(17 << 4));
+    for(int i = 0; i < 60; ++i) { w.tickMinute(100); }
+    w.endOfHour(stats, 3);
+    ASSERT_EQ(16, w.getRateC16PerH());
+    // 2C short needs 120 minutes.
+    EXPECT_TRUE(w.isPreWarmDue(svs, on - 120, 18 << 4, 20));
+    EXPECT_FALSE(w.isPreWarmDue(svs, on - 121, 18 << 4, 20));
+    // 0.5C short needs 30 minutes: within the fixed pre-pre-warm, so left to that.
+    EXPECT_FALSE(w.isPreWarmDue(svs, on - 30, (19 << 4) + 8, 20));
+    // Predicted occupancy for the next hour.
+    EXPECT_FALSE(w.isOccupancyPreWarmDue(stats, 6, 40, 19 << 4, 20));
+    stats.setByHourStatSimple(s_t::STATS_SET_OCCPC_BY_HOUR_SMOOTHED, 7, 80);
+    EXPECT_TRUE(w.isOccupancyPreWarmDue(stats, 6, 60, 19 << 4, 20));
+    EXPECT_FALSE(w.isOccupancyPreWarmDue(stats, 6, 61, 19 << 4, 20));
+    stats.setByHourStatSimple(s_t::STATS_SET_OCCPC_BY_HOUR_SMOOTHED, 0, 80);
+    EXPECT_TRUE(w.isOccupancyPreWarmDue(stats, 23, 10, 19 << 4, 20));
+}
@@ -0,0 +1,139 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Deniz Erbilgin 2017
+*/
+
+/*
+ * Tests of frame operations deferred until after RX handling.
+ */
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTRadioLink.h>
+
+namespace DFOT
+{
+typedef OTRadioLink::OTDeferredFrameOpQueue<2> queue_t;
+// Not static: used as a template argument.
+queue_t q;
+
+// What the recording operator last saw.
+static int calls;
+static uint8_t seenSeq;
+static uint8_t seenPtext[OTRadioLink::ENC_BODY_SMALL_FIXED_CTEXT_SIZE];
+static uint8_t seenPtextLen;
+static uint8_t seenID[OTV0P2BASE::OpenTRV_Node_ID_Bytes];
+static uint8_t seenCtext[64];
+static bool recordOp(const OTRadioLink::OTDecodeData_T &fd)
+    {
+    ++calls;
+    seenSeq = fd.sfh.getSeq();
+    memcpy(seenPtext, fd.ptext, fd.ptextLen);
+    seenPtextLen = fd.ptextLen;
+    memcpy(seenID, fd.id, sizeof(seenID));
+    memcpy(seenCtext, fd.ctext, fd.ctextLen + 1);
+    return(true);
+    }
+static bool pollIO(bool) { return(false); }
+
+// Build a valid (non-secure) frame into raw, with a decoded view of it in fd.
+struct TestFrame
+    {
+    uint8_t raw[64];
+    uint8_t ptext[OTRadioLink::ENC_BODY_SMALL_FIXED_CTEXT_SIZE];
+    OTRadioLink::OTDecodeData_T fd;
+    TestFrame(const uint8_t seq) : raw(), ptext(), fd(raw, ptext)
+        {
+        uint8_t body[] = { 0x7f, 0x10, '{', 'b', 'x' };
+        const uint8_t id[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+        OTRadioLink::OTEncodeData_T ed(body, sizeof(body), raw, sizeof(raw));
+        ed.ptextLen = sizeof(body);
+        ed.fType = OTRadioLink::FTS_BasicSensorOrValve;
+        EXPECT_NE(0, OTRadioLink::encodeNonsecure(ed, seq, id, 2));
+        EXPECT_NE(0, fd.sfh.decodeHeader(raw, raw[0] + 1));
+        memcpy(fd.id, id, sizeof(id));
+        memcpy(ptext, body, sizeof(body));
+        fd.ptextLen = sizeof(body);
+        }
+    };
+}
+
+// Check that a deferred operation runs later on a faithful copy of the frame data.
+TEST(DeferredFrameOp, RunsLaterOnCopy)
+{
+    DFOT::calls = 0;
+    uint8_t expectedRaw[64];
+    {
+        DFOT::TestFrame f(5);
+        memcpy(expectedRaw, f.raw, sizeof(expectedRaw));
+        EXPECT_TRUE((OTRadioLink::deferredFrameOperation<DFOT::queue_t, DFOT::q, DFOT::recordOp>(f.fd)));
+        EXPECT_EQ(0, DFOT::calls);
+        EXPECT_EQ(1, DFOT::q.pending());
+        // The RX buffers are reused once the handler returns.
+        memset(f.raw, 0xaa, sizeof(f.raw));
+        memset(f.ptext, 0xaa, sizeof(f.ptext));
+    }
+    EXPECT_EQ(1, DFOT::q.run());
+    EXPECT_EQ(0, DFOT::q.pending());
+    ASSERT_EQ(1, DFOT::calls);
+    EXPECT_EQ(5, DFOT::seenSeq);
+    EXPECT_EQ(5, DFOT::seenPtextLen);
+    EXPECT_EQ('{', DFOT::seenPtext[2]);
+    EXPECT_EQ(8, DFOT::seenID[7]);
+    EXPECT_EQ(0, memcmp(expectedRaw, DFOT::seenCtext, expectedRaw[0] + 1));
+    // Nothing left to run.
+    EXPECT_EQ(0, DFOT::q.run());
+}
+
+// Check FIFO order, maxOps, and immediate fallback when full.
+TEST(DeferredFrameOp, OrderAndOverflow)
+{
+    DFOT::calls = 0;
+    DFOT::TestFrame f1(1), f2(2), f3(3);
+    EXPECT_TRUE(DFOT::q.defer(DFOT::recordOp, f1.fd));
+    EXPECT_TRUE(DFOT::q.defer(DFOT::recordOp, f2.fd));
+    // Full: runs at once.
+    EXPECT_FALSE(DFOT::q.defer(DFOT::recordOp, f3.fd));
+    EXPECT_EQ(1, DFOT::calls);
+    EXPECT_EQ(3, DFOT::seenSeq);
+    EXPECT_EQ(1, DFOT::q.run(1));
+    EXPECT_EQ(1, DFOT::seenSeq);
+    DFOT::TestFrame f4(4);
+    EXPECT_TRUE(DFOT::q.defer(DFOT::recordOp, f4.fd));
+    EXPECT_EQ(2, DFOT::q.run());
+    EXPECT_EQ(4, DFOT::seenSeq);
+    EXPECT_EQ(4, DFOT::calls);
+}
+
+// Check that the message queue handler runs pending deferred operations even with nothing RXed.
+TEST(DeferredFrameOp, RunByMessageQueueHandler)
+{
+    DFOT::calls = 0;
+    OTRadioLink::OTMessageQueueHandler<
+        DFOT::pollIO, 4800,
+        OTRadioLink::decodeAndHandleDummyFrame,
+        OTRadioLink::decodeAndHandleDummyFrame,
+        1,
+        OTRadioLink::OTDeferredFrameOps<DFOT::queue_t, DFOT::q> > mh;
+    OTRadioLink::OTNullRadioLink rl;
+    EXPECT_FALSE(mh.handle(false, rl));
+    DFOT::TestFrame f(7);
+    DFOT::q.defer(DFOT::recordOp, f.fd);
+    EXPECT_TRUE(mh.handle(false, rl));
+    EXPECT_EQ(1, DFOT::calls);
+    EXPECT_EQ(7, DFOT::seenSeq);
+    EXPECT_EQ(0, DFOT::q.pending());
+}
@@ -0,0 +1,89 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Deniz Erbilgin 2017
+*/
+
+/*
+ * Tests of dispatch of RXed frames to handlers by frame type.
+ */
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTRadioLink.h>
+
+namespace FDT
+{
+// Calls of each handler since last reset.
+static int oCalls, oFallbackCalls, beaconCalls;
+static bool oResult;
+static bool pollIO(bool) { return(false); }
+static void reset() { oCalls = 0; oFallbackCalls = 0; beaconCalls = 0; oResult = true; }
+static bool handleO(volatile const uint8_t *const /*msg*/) { ++oCalls; return(oResult); }
+static bool handleOFallback(volatile const uint8_t *const /*msg*/) { ++oFallbackCalls; return(true); }
+static bool handleBeacon(volatile const uint8_t *const msg) { ++beaconCalls; return((OTRadioLink::FTS_ALIVE | 0x80) == msg[0]); }
+
+typedef OTRadioLink::FrameTypeDispatcher<
+    OTRadioLink::FrameTypeHandlers<'O' | 0x80, handleO, handleOFallback>,
+    OTRadioLink::FrameTypeHandlers<OTRadioLink::FTS_ALIVE | 0x80, handleBeacon>
+    > dispatcher_t;
+
+// Frame with length byte in front, as in the RX queue; msg points past the length.
+static const uint8_t secureO[] = { 4, 'O' | 0x80, 0x10, 0, 0 };
+static const uint8_t secureBeacon[] = { 4, OTRadioLink::FTS_ALIVE | 0x80, 0x10, 0, 0 };
+static const uint8_t insecureO[] = { 4, 'O', 0x10, 0, 0 };
+static const uint8_t tooShort[] = { 1, 'O' | 0x80 };
+}
+
+// Check that each frame reaches only the handlers for its type.
+TEST(FrameDispatch, OnlyHandlersForType)
+{
+    static_assert(FDT::dispatcher_t::hasType('O' | 0x80), "");
+    static_assert(!FDT::dispatcher_t::hasType('O'), "");
+    FDT::reset();
+    EXPECT_TRUE(FDT::dispatcher_t::dispatch(FDT::secureO + 1));
+    EXPECT_EQ(1, FDT::oCalls);
+    EXPECT_EQ(0, FDT::oFallbackCalls);
+    EXPECT_EQ(0, FDT::beaconCalls);
+    FDT::reset();
+    EXPECT_TRUE(FDT::dispatcher_t::dispatch(FDT::secureBeacon + 1));
+    EXPECT_EQ(0, FDT::oCalls);
+    EXPECT_EQ(1, FDT::beaconCalls);
+    // Unregistered types and runts go to no handler at all.
+    FDT::reset();
+    EXPECT_FALSE(FDT::dispatcher_t::dispatch(FDT::insecureO + 1));
+    EXPECT_FALSE(FDT::dispatcher_t::dispatch(FDT::tooShort + 1));
+    EXPECT_EQ(0, FDT::oCalls + FDT::oFallbackCalls + FDT::beaconCalls);
+}
+
+// Check that handlers for one type are tried in order until the first success.
+TEST(FrameDispatch, HandlersTriedInOrder)
+{
+    FDT::reset();
+    FDT::oResult = false;
+    EXPECT_TRUE(FDT::dispatcher_t::dispatch(FDT::secureO + 1));
+    EXPECT_EQ(1, FDT::oCalls);
+    EXPECT_EQ(1, FDT::oFallbackCalls);
+}
+
+// Check that the dispatcher plugs into the message queue handler.
+TEST(FrameDispatch, WithMessageQueueHandler)
+{
+    OTRadioLink::OTMessageQueueHandler<
+        FDT::pollIO, 4800,
+        FDT::dispatcher_t::dispatch> mh;
+    OTRadioLink::OTNullRadioLink rl;
+    EXPECT_FALSE(mh.handle(false, rl));
+}
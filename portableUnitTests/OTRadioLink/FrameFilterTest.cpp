@@ -0,0 +1,116 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * OTRadioLink composable quick RX frame filter tests.
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <OTV0p2Base.h>
+#include <OTRadioLink.h>
+
+#include "OTRadioLink_FrameFilter.h"
+
+namespace FFT
+{
+// Cache of associated node IDs; must have static storage duration to be a template argument.
+OTRadioLink::NodeIDPrefixCache<4, 2> ids;
+// Secureable 'O' or '!' frames of at least 4 bytes from associated nodes.
+typedef OTRadioLink::FrameFilterChain<
+    OTRadioLink::FrameFilterMinLength<4>,
+    OTRadioLink::FrameFilterSecureableType<OTRadioLink::FTS_BasicSensorOrValve, OTRadioLink::FTS_ALIVE>,
+    OTRadioLink::FrameFilterSecureableIDPrefix<OTRadioLink::NodeIDPrefixCache<4, 2>, ids> > secureFilter;
+// Non-secureable JSON or FS20 frames, with trailing zeros trimmed first.
+typedef OTRadioLink::FrameFilterChain<
+    OTRadioLink::FrameFilterTrimTrailingZeros,
+    OTRadioLink::FrameFilterLeadingByte<OTRadioLink::FTp2_JSONRaw, OTRadioLink::FTp2_FS20_native> > oldFilter;
+}
+
+// Check that simple stages and chains accept and reject as expected.
+TEST(FrameFilter,Basics)
+{
+    // Empty chain accepts all.
+    const volatile uint8_t f0[] = { 0 };
+    volatile uint8_t len = 0;
+    EXPECT_TRUE(OTRadioLink::FrameFilterChain<>::filter(f0, len));
+    // Chain type is usable as a quickFrameFilter_t.
+    OTRadioLink::quickFrameFilter_t *const qff = FFT::oldFilter::filter;
+    // JSON frame with trailing zeros is accepted and trimmed.
+    const volatile uint8_t f1[] = { '{', 'a', '}', 0, 0, 0 };
+    len = sizeof(f1);
+    EXPECT_TRUE(qff(f1, len));
+    EXPECT_EQ(4, len);
+    // Unknown leading byte is rejected.
+    const volatile uint8_t f2[] = { 'x', 1, 2 };
+    len = sizeof(f2);
+    EXPECT_FALSE(qff(f2, len));
+    // Empty frame is rejected.
+    len = 0;
+    EXPECT_FALSE(qff(f2, len));
+    // Minimum length.
+    len = 3;
+    EXPECT_FALSE(OTRadioLink::FrameFilterMinLength<4>::apply(f2, len));
+    len = 4;
+    EXPECT_TRUE(OTRadioLink::FrameFilterMinLength<4>::apply(f2, len));
+}
+
+// Check ID prefix matching against a cache loaded from the node association table.
+TEST(FrameFilter,SecureableIDPrefix)
+{
+    OTV0P2BASE::NodeAssociationTableMock table;
+    table._reset();
+    const uint8_t id1[] = { 0x88, 0x81, 1, 2, 3, 4, 5, 6 };
+    const uint8_t id2[] = { 0xa0, 0xb1, 1, 2, 3, 4, 5, 6 };
+    ASSERT_TRUE(table.set(0, id1));
+    ASSERT_TRUE(table.set(1, id2));
+    FFT::ids.clear();
+    // 'O' frame header: fl, type (secure), seq/il=2, ID, ...
+    const volatile uint8_t fO[] = { 10, 0x80 | 'O', 0x02, 0xa0, 0xb1, 0, 0, 0 };
+    volatile uint8_t len = sizeof(fO);
+    // Nothing matches an empty cache.
+    EXPECT_FALSE(FFT::secureFilter::filter(fO, len));
+    EXPECT_EQ(2, FFT::ids.load(table, 255));
+    EXPECT_EQ(2, FFT::ids.size());
+    len = sizeof(fO);
+    EXPECT_TRUE(FFT::secureFilter::filter(fO, len));
+    // Truncated ID is rejected.
+    len = 4;
+    EXPECT_FALSE(FFT::secureFilter::filter(fO, len));
+    // A 1-byte ID matching a prefix is accepted.
+    const volatile uint8_t fA[] = { 4, '!', 0x01, 0x88, 0, 0 };
+    len = sizeof(fA);
+    EXPECT_TRUE(FFT::secureFilter::filter(fA, len));
+    // Anonymous frames and unknown IDs are rejected.
+    const volatile uint8_t fAnon[] = { 4, '!', 0x00, 0, 0, 0 };
+    len = sizeof(fAnon);
+    EXPECT_FALSE(FFT::secureFilter::filter(fAnon, len));
+    const volatile uint8_t fU[] = { 10, 'O', 0x02, 0x88, 0xb1, 0, 0, 0 };
+    len = sizeof(fU);
+    EXPECT_FALSE(FFT::secureFilter::filter(fU, len));
+    // Wrong frame type is rejected even with a good ID.
+    const volatile uint8_t fT[] = { 10, 'G', 0x02, 0xa0, 0xb1, 0, 0, 0 };
+    len = sizeof(fT);
+    EXPECT_FALSE(FFT::secureFilter::filter(fT, len));
+    // Limit on number loaded is honoured.
+    EXPECT_EQ(1, FFT::ids.load(table, 1));
+    len = sizeof(fO);
+    EXPECT_FALSE(FFT::secureFilter::filter(fO, len));
+}
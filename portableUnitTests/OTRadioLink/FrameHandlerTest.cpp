@@ -102,6 +102,9 @@ namespace OTFHT
     OTRadioLink::OTNullRadioLink rt;
     OTRadValve::OTHubManager<false, false> hm;  // no EEPROM so parameters don't matter
     OTRadValve::BoilerLogic::OnOffBoilerDriverLogic<decltype(hm), hm, heatCallPin> b0;
+    OTRadioLink::OTNodeLastSeenTable<> lastSeen;
+    uint16_t nowM = 0;
+    uint8_t rssi = 0;
 
     // like Nullframe operation but sets a flag
     volatile bool frameOperationCalledFlag = false;
@@ -623,6 +626,20 @@ TEST(FrameHandlerTest, authAndDecodeSecurableFrameFull)
             >(fd, sW);
     EXPECT_TRUE(test1);
     EXPECT_EQ(0, strncmp((const char *) fd.ptext, (const char *) OTFHT::minimumSecureFrame::body, sizeof(OTFHT::minimumSecureFrame::body)));
+    // The mock association lookup matches slot 0.
+    EXPECT_EQ(0, fd.assocIndex);
+
+    // The sender can then be recorded as seen.
+    OTFHT::lastSeen.clear();
+    OTFHT::nowM = 42;
+    OTFHT::rssi = 150;
+    EXPECT_TRUE((OTRadioLink::nodeLastSeenFrameOperation<decltype(OTFHT::lastSeen), OTFHT::lastSeen, OTFHT::nowM, OTFHT::rssi>(fd)));
+    const auto *const e = OTFHT::lastSeen.get(0);
+    ASSERT_NE(nullptr, e);
+    EXPECT_EQ(42, e->lastSeenM);
+    EXPECT_EQ(150, e->rssi);
+    EXPECT_EQ(0x19, e->ctrLSB);
+    EXPECT_EQ(100, e->valvePC);
 }
 
 TEST(FrameHandlerTest, decodeAndHandleOTSecurableFrameDecryptSuccess)
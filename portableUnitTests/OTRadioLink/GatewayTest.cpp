@@ -0,0 +1,259 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Tests of the host gateway runtime (portableGateway/Gateway.h), using the NULL crypto.
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <OTRadioLink.h>
+
+#include "Gateway.h"
+#include "SecureFrameTestDoubles.h"
+
+namespace GWT
+{
+static const uint8_t key[16] = {};
+
+// Full ID of valve n; the first byte varies so that valves spread across shards.
+static void valveID(const uint8_t n, uint8_t *const id)
+    {
+    id[0] = uint8_t(0x80 + n);
+    for(uint8_t i = 1; i < OTV0P2BASE::OpenTRV_Node_ID_Bytes; ++i) { id[i] = uint8_t(0x80 + i); }
+    }
+
+// Transmitting valve with a RAM message counter.
+class ValveTX final : public SFTD::RAMCtrTXBase
+    {
+    private:
+        uint8_t id[OTV0P2BASE::OpenTRV_Node_ID_Bytes];
+    public:
+        explicit ValveTX(const uint8_t n) { valveID(n, id); }
+        virtual bool getTXID(uint8_t *buf) const override { memcpy(buf, id, sizeof(id)); return(true); }
+
+        // Secure 'O' frame (without its length byte) with JSON body {"b":b}; returns its length.
+        uint8_t frame(const uint8_t b, uint8_t *const out)
+            {
+            uint8_t body[OTRadioLink::ENC_BODY_SMALL_FIXED_CTEXT_SIZE];
+            // Valve % unknown, JSON flag, then JSON without its closing brace.
+            const int n = snprintf(reinterpret_cast<char *>(body + 2), sizeof(body) - 2, "{\"b\":%u", b);
+            body[0] = 0x7f;
+            body[1] = 0x10;
+            uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encode_total_scratch_usage_OTAESGCM_2p0];
+            OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+            uint8_t encoded[OTRadioLink::SecurableFrameHeader::maxSmallFrameSize];
+            OTRadioLink::OTEncodeData_T fd(body, sizeof(body), encoded, sizeof(encoded));
+            fd.ptextLen = uint8_t(2 + n);
+            fd.fType = OTRadioLink::FTS_BasicSensorOrValve;
+            const uint8_t l = encode(fd, 4, OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleEnc_NULL_IMPL, sW, key);
+            if(l < 2) { return(0); }
+            memcpy(out, encoded + 1, l - 1U);
+            return(uint8_t(l - 1));
+            }
+    };
+
+// Thread-safe record of published messages.
+struct Published final
+    {
+    std::mutex m;
+    std::vector<std::string> msgs;
+    OTGW::Gateway::Publisher publisher()
+        { return([this](const std::string &s) { std::lock_guard<std::mutex> lock(m); msgs.push_back(s); }); }
+    };
+
+static OTGW::Gateway *makeGateway(const uint8_t shards)
+    { return(new OTGW::Gateway(key, shards, 4, OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL, 1)); }
+}
+
+// Each hub output format is parsed to the same frame; other lines are not frames.
+TEST(Gateway,parseHubLine)
+{
+    static const uint8_t expected[5] = { 0x61, 0x7b, 0x20, 0x81, 0xfd };
+    OTGW::RawFrame f;
+    std::string json;
+    const char *const lines[] = { "|5  a {  81FD\r\n", ":61 7b 20 81 fd\n", "61 7B 20 81 FD" };
+    for(const char *l : lines)
+        {
+        ASSERT_EQ(OTGW::HubLine::FRAME, OTGW::parseHubLine(l, f, json)) << l;
+        ASSERT_EQ(5, f.len());
+        EXPECT_EQ(0, memcmp(expected, f.buf + 1, 5)) << l;
+        }
+    // One-digit bytes only from the sniffer.
+    EXPECT_EQ(OTGW::HubLine::FRAME, OTGW::parseHubLine(":4f 2 a", f, json));
+    EXPECT_EQ(2, f.buf[2]);
+    EXPECT_EQ(OTGW::HubLine::OTHER, OTGW::parseHubLine("4f 2 a", f, json));
+    // Length must match for printRXMsg().
+    EXPECT_EQ(OTGW::HubLine::OTHER, OTGW::parseHubLine("|4  a {  81FD", f, json));
+    EXPECT_EQ(OTGW::HubLine::OTHER, OTGW::parseHubLine("=F0%@18C6;X0", f, json));
+    EXPECT_EQ(OTGW::HubLine::OTHER, OTGW::parseHubLine(":4f", f, json));
+    EXPECT_EQ(OTGW::HubLine::OTHER, OTGW::parseHubLine("", f, json));
+    ASSERT_EQ(OTGW::HubLine::JSON, OTGW::parseHubLine("{\"@\":\"98a4\",\"L\":146}\r\n", f, json));
+    EXPECT_EQ("{\"@\":\"98a4\",\"L\":146}", json);
+}
+
+// Frames from many nodes are decoded across the shards, in order per node.
+TEST(Gateway,decodeSharded)
+{
+    static constexpr uint8_t valves = 24;
+    static constexpr uint8_t rounds = 5;
+    GWT::Published pub;
+    std::unique_ptr<OTGW::Gateway> gw(GWT::makeGateway(4));
+    std::vector<GWT::ValveTX> txs;
+    for(uint8_t i = 0; i < valves; ++i)
+        {
+        txs.emplace_back(i);
+        uint8_t id[8];
+        GWT::valveID(i, id);
+        EXPECT_TRUE(gw->addNode(id));
+        }
+    EXPECT_EQ(valves, gw->nodes());
+    gw->start(pub.publisher());
+    uint8_t buf[OTGW::maxFrameLen];
+    for(uint8_t r = 0; r < rounds; ++r)
+        {
+        for(uint8_t i = 0; i < valves; ++i)
+            {
+            const uint8_t l = txs[i].frame(r, buf);
+            ASSERT_NE(0, l);
+            EXPECT_TRUE(gw->submit(buf, l));
+            }
+        }
+    gw->stop();
+    const OTGW::GatewayStats s = gw->stats();
+    EXPECT_EQ(uint64_t(valves) * rounds, s.frames);
+    EXPECT_EQ(uint64_t(valves) * rounds, s.decoded);
+    EXPECT_EQ(0U, s.rejected);
+    ASSERT_EQ(size_t(valves) * rounds, pub.msgs.size());
+    std::set<std::string> unique(pub.msgs.begin(), pub.msgs.end());
+    EXPECT_EQ(pub.msgs.size(), unique.size());
+    // Stats as the hub would print them.
+    const std::string first = "{\"@\":\"8081828384858687\",\"+\":1,\"b\":0}";
+    EXPECT_EQ(1U, unique.count(first)) << pub.msgs[0];
+}
+
+// Replays, unknown nodes and other frames are not published.
+TEST(Gateway,rejects)
+{
+    GWT::Published pub;
+    std::unique_ptr<OTGW::Gateway> gw(GWT::makeGateway(2));
+    uint8_t id[8];
+    GWT::valveID(1, id);
+    gw->addNode(id);
+    GWT::ValveTX known(1), unknown(2);
+    uint8_t buf[OTGW::maxFrameLen];
+    // Not running yet.
+    const uint8_t l = known.frame(7, buf);
+    EXPECT_FALSE(gw->submit(buf, l));
+    gw->start(pub.publisher());
+    // No changes to nodes while running.
+    EXPECT_FALSE(gw->addNode(id));
+    EXPECT_TRUE(gw->submit(buf, l));
+    EXPECT_TRUE(gw->submit(buf, l));
+    uint8_t ubuf[OTGW::maxFrameLen];
+    const uint8_t ul = unknown.frame(7, ubuf);
+    EXPECT_TRUE(gw->submit(ubuf, ul));
+    // Non-secure frame.
+    static const uint8_t junk[] = { 'O', 0x02, 0x00, 0x00 };
+    EXPECT_FALSE(gw->submit(junk, sizeof(junk)));
+    gw->publishJSON("{\"@\":\"98a4\"}");
+    gw->stop();
+    const OTGW::GatewayStats s = gw->stats();
+    EXPECT_EQ(1U, s.decoded);
+    EXPECT_EQ(2U, s.rejected);
+    EXPECT_EQ(2U, s.ignored);
+    EXPECT_EQ(2U, s.published);
+    ASSERT_EQ(2U, pub.msgs.size());
+}
+
+// The hub's framed binary output is decoded across noise, split reads and corruption,
+// and each record type is handled as the hub's text output would be.
+TEST(Gateway,hubBinary)
+{
+    // Captures output bytes.
+    class PrintVector final : public Print
+        {
+        public:
+            std::vector<uint8_t> out;
+            using Print::write;
+            virtual size_t write(const uint8_t b) override { out.push_back(b); return(1); }
+        };
+    PrintVector p;
+    GWT::ValveTX tx(3);
+    uint8_t buf[OTGW::maxFrameLen];
+    const uint8_t l = tx.frame(5, buf);
+    ASSERT_NE(0, l);
+    // Noise, including a stray sync byte, before the first record.
+    p.out = { 0x00, OTRadioLink::HUB_BINARY_SYNC, 0x01, 0x33 };
+    EXPECT_TRUE(OTRadioLink::outputHubBinaryRawRX(p, buf, l, -60));
+    // A record with a corrupted body is dropped.
+    const size_t bad = p.out.size();
+    EXPECT_TRUE(OTRadioLink::outputHubBinaryRawRX(p, buf, l));
+    p.out[bad + 6] ^= 1;
+    static const uint8_t json[] = "{\"@\":\"98a4\"}";
+    EXPECT_TRUE(OTRadioLink::outputHubBinaryJSON(p, json, sizeof(json)));
+    // Decoded stats: sequence number then plaintext body, as for serialFrameOperation().
+    uint8_t id[8];
+    GWT::valveID(4, id);
+    static const uint8_t db[] = { 0x7f, 0x10, '{', '"', 'b', '"', ':', '2' };
+    const uint8_t seq = 9;
+    EXPECT_TRUE(OTRadioLink::outputHubBinary(p, OTRadioLink::HBT_DECODED_O, id, 8, 0, &seq, 1, db, sizeof(db)));
+
+    OTGW::HubBinaryDecoder d;
+    std::vector<OTGW::HubBinaryRecord> records;
+    // Feed in uneven chunks.
+    for(size_t i = 0; i < p.out.size(); i += 7)
+        {
+        d.feed(p.out.data() + i, std::min<size_t>(7, p.out.size() - i),
+            [&records](const OTGW::HubBinaryRecord &r) { records.push_back(r); });
+        }
+    ASSERT_EQ(3U, records.size());
+    EXPECT_EQ(2U, d.badRecords());
+    EXPECT_EQ(OTRadioLink::HBT_RAW_FRAME, records[0].type);
+    EXPECT_EQ(-60, records[0].rssi);
+    ASSERT_EQ(l, records[0].bodyLen);
+    EXPECT_EQ(0, memcmp(buf, records[0].body, l));
+    EXPECT_EQ(OTRadioLink::HBT_JSON, records[1].type);
+    EXPECT_EQ(OTRadioLink::HUB_BINARY_RSSI_UNKNOWN, records[1].rssi);
+    EXPECT_EQ(OTRadioLink::HBT_DECODED_O, records[2].type);
+    EXPECT_EQ(8, records[2].idLen);
+
+    GWT::Published pub;
+    std::unique_ptr<OTGW::Gateway> gw(GWT::makeGateway(2));
+    GWT::valveID(3, id);
+    gw->addNode(id);
+    gw->start(pub.publisher());
+    for(const OTGW::HubBinaryRecord &r : records) { EXPECT_TRUE(gw->submit(r)); }
+    OTGW::HubBinaryRecord unknown = records[1];
+    unknown.type = 'Z';
+    EXPECT_FALSE(gw->submit(unknown));
+    gw->stop();
+    const OTGW::GatewayStats s = gw->stats();
+    EXPECT_EQ(1U, s.decoded);
+    EXPECT_EQ(1U, s.ignored);
+    ASSERT_EQ(3U, pub.msgs.size());
+    const std::set<std::string> unique(pub.msgs.begin(), pub.msgs.end());
+    EXPECT_EQ(1U, unique.count("{\"@\":\"8381828384858687\",\"+\":1,\"b\":5}"));
+    EXPECT_EQ(1U, unique.count("{\"@\":\"98a4\"}"));
+    EXPECT_EQ(1U, unique.count("{\"@\":\"8481828384858687\",\"+\":9,\"b\":2}"));
+}
@@ -0,0 +1,106 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Tests of the framed binary hub output (OTRadioLink_HubBinaryOutput.h).
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <vector>
+
+#include <OTV0p2Base.h>
+#include <OTRadioLink.h>
+
+namespace HBOT
+{
+// Captures output bytes.
+class PrintVector final : public Print
+    {
+    public:
+        std::vector<uint8_t> out;
+        using Print::write;
+        virtual size_t write(const uint8_t b) override { out.push_back(b); return(1); }
+    };
+
+// CRC of a whole record from its len byte to the end of its body.
+static uint16_t recordCRC(const std::vector<uint8_t> &r)
+    { return(OTV0P2BASE::crc16_A001_buf(0xffff, r.data() + 1, uint8_t(r.size() - 3))); }
+static uint16_t trailer(const std::vector<uint8_t> &r)
+    { return(uint16_t(r[r.size() - 2] | (r[r.size() - 1] << 8))); }
+}
+
+// Raw frame record layout and CRC.
+TEST(HubBinaryOutput,rawFrame)
+{
+    static const uint8_t frame[] = { 0x4f, 0x02, 0x7f, 0x11 };
+    HBOT::PrintVector p;
+    EXPECT_TRUE(OTRadioLink::outputHubBinaryRawRX(p, frame, sizeof(frame), -70));
+    ASSERT_EQ(2U + 3U + sizeof(frame) + 2U, p.out.size());
+    EXPECT_EQ(OTRadioLink::HUB_BINARY_SYNC, p.out[0]);
+    EXPECT_EQ(3U + sizeof(frame), p.out[1]);
+    EXPECT_EQ('R', p.out[2]);
+    EXPECT_EQ(0, p.out[3]);
+    EXPECT_EQ(-70, int8_t(p.out[4]));
+    EXPECT_EQ(0, memcmp(frame, p.out.data() + 5, sizeof(frame)));
+    EXPECT_EQ(HBOT::recordCRC(p.out), HBOT::trailer(p.out));
+    // Nothing written for an empty frame.
+    p.out.clear();
+    EXPECT_FALSE(OTRadioLink::outputHubBinaryRawRX(p, frame, 0));
+    EXPECT_TRUE(p.out.empty());
+}
+
+// A split body is written as one, and bad arguments write nothing.
+TEST(HubBinaryOutput,limits)
+{
+    static const uint8_t id[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    static const uint8_t body[64] = { };
+    HBOT::PrintVector p;
+    EXPECT_TRUE(OTRadioLink::outputHubBinary(p, 'X', id, 8, 0, body, 2, body + 2, 62));
+    EXPECT_EQ(OTRadioLink::HUB_BINARY_MAX_LEN, p.out[1]);
+    EXPECT_EQ(HBOT::recordCRC(p.out), HBOT::trailer(p.out));
+    const std::vector<uint8_t> whole(p.out);
+    p.out.clear();
+    EXPECT_TRUE(OTRadioLink::outputHubBinary(p, 'X', id, 8, 0, body, 64));
+    EXPECT_EQ(whole, p.out);
+    p.out.clear();
+    EXPECT_FALSE(OTRadioLink::outputHubBinary(p, 'X', id, 9, 0, body, 1));
+    EXPECT_FALSE(OTRadioLink::outputHubBinary(p, 'X', id, 8, 0, body, 64, body, 1));
+    EXPECT_FALSE(OTRadioLink::outputHubBinary(p, 'X', NULL, 1, 0, body, 1));
+    EXPECT_TRUE(p.out.empty());
+}
+
+// JSON is written without its terminator, whichever form it takes.
+TEST(HubBinaryOutput,json)
+{
+    HBOT::PrintVector p;
+    uint8_t buf[16] = "{\"b\":1}";
+    EXPECT_TRUE(OTRadioLink::outputHubBinaryJSON(p, buf, sizeof(buf)));
+    ASSERT_EQ(2U + 3U + 7U + 2U, p.out.size());
+    EXPECT_EQ('J', p.out[2]);
+    EXPECT_EQ(0, memcmp("{\"b\":1}", p.out.data() + 5, 7));
+    const std::vector<uint8_t> plain(p.out);
+    p.out.clear();
+    buf[6] = '}' | 0x80;
+    buf[7] = 0xff;
+    EXPECT_TRUE(OTRadioLink::outputHubBinaryJSON(p, buf, sizeof(buf)));
+    EXPECT_EQ(plain, p.out);
+    p.out.clear();
+    EXPECT_FALSE(OTRadioLink::outputHubBinaryJSON(p, buf, 6));
+    EXPECT_TRUE(p.out.empty());
+}
@@ -0,0 +1,167 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * OTRadioLink ISR RX queue tests.
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <OTRadioLink.h>
+
+#include "OTRadioLink_ISRRXQueue.h"
+
+
+// Basic claim/commit/peek/release on the lock-free SPSC queue.
+TEST(ISRRXQueue,SPSCBasics)
+{
+    OTRadioLink::ISRRXQueueSPSC<8, 2> q;
+    EXPECT_TRUE(q.isEmpty());
+    EXPECT_FALSE(q.isFull());
+    EXPECT_EQ(0, q.getRXMsgsQueued());
+    uint8_t len = 42;
+    EXPECT_TRUE(NULL == q.peek(len));
+    EXPECT_EQ(0, len);
+    q.release(); // Harmless when empty.
+    EXPECT_TRUE(q.isEmpty());
+    // Bad lengths cannot be claimed.
+    EXPECT_TRUE(NULL == q.claim(0));
+    EXPECT_TRUE(NULL == q.claim(9));
+    // Claim, then abandon.
+    ASSERT_TRUE(NULL != q.claim(8));
+    q.commit(0);
+    EXPECT_TRUE(q.isEmpty());
+    // Claim and commit a short frame.
+    volatile uint8_t *bp = q.claim(8);
+    ASSERT_TRUE(NULL != bp);
+    bp[0] = 'a'; bp[1] = 'b'; bp[2] = 'c';
+    q.commit(3);
+    EXPECT_FALSE(q.isEmpty());
+    EXPECT_EQ(1, q.getRXMsgsQueued());
+    const volatile uint8_t *pp = q.peek(len);
+    ASSERT_TRUE(NULL != pp);
+    EXPECT_EQ(3, len);
+    EXPECT_EQ(3, pp[-1]);
+    EXPECT_EQ('a', pp[0]);
+    EXPECT_EQ('c', pp[2]);
+    EXPECT_EQ(pp, q.peekRXMsg());
+    q.release();
+    EXPECT_TRUE(q.isEmpty());
+    EXPECT_EQ(0, q.getRXMsgsQueued());
+    // Commit of more than claimed is trimmed.
+    bp = q.claim(2);
+    ASSERT_TRUE(NULL != bp);
+    q.commit(5);
+    ASSERT_TRUE(NULL != q.peek(len));
+    EXPECT_EQ(2, len);
+    q.removeRXMsg();
+    EXPECT_TRUE(q.isEmpty());
+}
+
+// Run many frames of varying length through the SPSC queue,
+// checking content and order survive wrap-around,
+// and that the advertised minimum full-size capacity is always available.
+TEST(ISRRXQueue,SPSCWrapAndCapacity)
+{
+    static constexpr uint8_t maxLen = 10;
+    OTRadioLink::ISRRXQueueSPSC<maxLen, 3> q;
+    uint8_t minCap, maxRX;
+    q.getRXCapacity(minCap, maxRX);
+    EXPECT_EQ(maxLen, maxRX);
+    EXPECT_LE(3, minCap);
+    uint8_t nextIn = 0, nextOut = 0;
+    for(int round = 0; round < 200; ++round)
+        {
+        // Pseudo-randomly add some frames.
+        const int nAdd = random() % 5;
+        for(int i = 0; i < nAdd; ++i)
+            {
+            const uint8_t l = 1 + (random() % maxLen);
+            volatile uint8_t *bp = q.claim(l);
+            if(NULL == bp) { EXPECT_LE(minCap, q.getRXMsgsQueued()); break; }
+            for(int j = 0; j < l; ++j) { bp[j] = nextIn; }
+            q.commit(l);
+            ++nextIn;
+            }
+        // Pseudo-randomly remove some frames, checking content.
+        const int nRemove = random() % 5;
+        for(int i = 0; i < nRemove; ++i)
+            {
+            uint8_t l;
+            const volatile uint8_t *pp = q.peek(l);
+            if(NULL == pp) { EXPECT_EQ(nextIn, nextOut); break; }
+            ASSERT_LE(1, l);
+            ASSERT_GE(maxLen, l);
+            for(int j = 0; j < l; ++j) { ASSERT_EQ(nextOut, pp[j]); }
+            q.release();
+            ++nextOut;
+            }
+        EXPECT_EQ((uint8_t)(nextIn - nextOut), q.getRXMsgsQueued());
+        }
+    // Drain, then check that full-size frames can be queued up to capacity.
+    while(!q.isEmpty()) { q.release(); }
+    for(int i = 0; i < minCap; ++i)
+        {
+        EXPECT_FALSE(q.isFull());
+        volatile uint8_t *bp = q._getRXBufForInbound();
+        ASSERT_TRUE(NULL != bp);
+        q._loadedBuf(maxLen);
+        }
+    EXPECT_EQ(minCap, q.getRXMsgsQueued());
+}
+
+// Occupancy stats and self-check on the variable-length queue.
+TEST(ISRRXQueue,VarLenStatsAndSelfCheck)
+{
+    OTRadioLink::ISRRXQueueVarLenMsg<8, 2> q;
+    OTRadioLink::ISRRXQueueStats s;
+    q.setStats(&s);
+    EXPECT_EQ(0, s.highWaterMsgs);
+    EXPECT_TRUE(q.selfCheck());
+    q.sampleOccupancy();
+    EXPECT_EQ(1, s.samples);
+    EXPECT_EQ(0, s.fullSamples);
+    // Fill with short and full-size frames until full.
+    uint8_t loaded = 0;
+    for(uint8_t len = 3; NULL != q._getRXBufForInbound(); len = 8)
+        { q._loadedBuf(len); ++loaded; EXPECT_TRUE(q.selfCheck()); }
+    EXPECT_TRUE(q.isFull());
+    EXPECT_EQ(loaded, s.highWaterMsgs);
+    EXPECT_EQ(1, s.fullEvents);
+    EXPECT_EQ(1, s.lengthHistogram[OTRadioLink::ISRRXQueueStats::lengthBin(3)]);
+    EXPECT_EQ(loaded - 1, s.lengthHistogram[OTRadioLink::ISRRXQueueStats::lengthBin(8)]);
+    q.sampleOccupancy();
+    EXPECT_EQ(2, s.samples);
+    EXPECT_EQ(1, s.fullSamples);
+    EXPECT_EQ(4 + (9 * (loaded - 1)), s.highWaterBytes);
+    // Draining leaves the high-water marks.
+    while(!q.isEmpty()) { q.removeRXMsg(); EXPECT_TRUE(q.selfCheck()); }
+    q.sampleOccupancy();
+    EXPECT_EQ(1, s.fullSamples);
+    EXPECT_EQ(loaded, s.highWaterMsgs);
+    // Long frames all land in the last bin.
+    EXPECT_EQ(OTRadioLink::ISRRXQueueStats::LENGTH_HISTOGRAM_BINS - 1, OTRadioLink::ISRRXQueueStats::lengthBin(255));
+    // Stats can be detached.
+    q.setStats(NULL);
+    ASSERT_TRUE(NULL != q._getRXBufForInbound());
+    q._loadedBuf(2);
+    EXPECT_EQ(1, s.lengthHistogram[OTRadioLink::ISRRXQueueStats::lengthBin(3)]);
+    EXPECT_TRUE(q.selfCheck());
+}
@@ -0,0 +1,117 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Tests of JeeLabs/OEM packet encoding, decoding and quick RX filters.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <OTRadioLink.h>
+#include "OTRadioLink_JeelabsOemPacket.h"
+
+namespace JOPT
+{
+// Default group 100, node 5.
+typedef OTRadioLink::FrameFilterChain<
+    OTRadioLink::FrameFilterJeelabsGroup<100>,
+    OTRadioLink::FrameFilterJeelabsNode<5>,
+    OTRadioLink::FrameFilterJeelabsCRC> filter100_5;
+
+// Encode payload of len bytes into a 64-byte RX-style buffer; returns frame length.
+static uint8_t frame(uint8_t *const buf, const uint8_t len, const uint8_t nodeID = 0, const bool dest = false)
+    {
+    memset(buf, 0xaa, 64);
+    for(uint8_t i = 0; i < len; ++i) { buf[i] = uint8_t('a' + i); }
+    OTRadioLink::JeelabsOemPacket p;
+    return(p.encode(buf, len, nodeID, dest));
+    }
+}
+
+// Encode then filter and decode round trip.
+TEST(JeelabsOemPacket,roundTrip)
+{
+    uint8_t buf[64];
+    const uint8_t fl = JOPT::frame(buf, 10);
+    ASSERT_EQ(15, fl);
+    EXPECT_EQ(100, buf[0]);
+    EXPECT_EQ(5, buf[1]);
+    EXPECT_EQ(10, buf[2]);
+    volatile uint8_t buflen = 64;
+    EXPECT_TRUE(OTRadioLink::JeelabsOemPacket::filter(buf, buflen));
+    EXPECT_EQ(15, buflen);
+    OTRadioLink::JeelabsOemPacket p;
+    uint8_t len = 15, nodeID = 0;
+    bool dest = true, ackReq = true, ackConf = true;
+    EXPECT_EQ(10, p.decode(buf, len, nodeID, dest, ackReq, ackConf));
+    EXPECT_EQ(10, len);
+    EXPECT_EQ(5, nodeID);
+    EXPECT_FALSE(dest);
+    EXPECT_FALSE(ackReq);
+    EXPECT_FALSE(ackConf);
+    EXPECT_EQ(0, memcmp(buf, "abcdefghij", 10));
+}
+
+// The quick filter stages reject by group, node, length and CRC.
+TEST(JeelabsOemPacket,filterStages)
+{
+    uint8_t buf[64];
+    volatile uint8_t buflen;
+    // Broadcast from our group passes, trimmed.
+    JOPT::frame(buf, 20);
+    buflen = 64;
+    EXPECT_TRUE(JOPT::filter100_5::filter(buf, buflen));
+    EXPECT_EQ(25, buflen);
+    // Addressed to us passes, to another node does not.
+    JOPT::frame(buf, 20, 5, true);
+    buflen = 64;
+    EXPECT_TRUE(JOPT::filter100_5::filter(buf, buflen));
+    JOPT::frame(buf, 20, 6, true);
+    buflen = 64;
+    EXPECT_FALSE(JOPT::filter100_5::filter(buf, buflen));
+    // Another group fails before the CRC is checked (so even with a good CRC).
+    JOPT::frame(buf, 20);
+    buflen = 64;
+    typedef OTRadioLink::FrameFilterChain<OTRadioLink::FrameFilterJeelabsGroup<210> > other;
+    EXPECT_FALSE(other::filter(buf, buflen));
+    // Corrupt byte.
+    JOPT::frame(buf, 20);
+    buf[7] ^= 1;
+    buflen = 64;
+    EXPECT_FALSE(JOPT::filter100_5::filter(buf, buflen));
+    EXPECT_FALSE(OTRadioLink::JeelabsOemPacket::filter(buf, buflen = 64));
+    // Length byte beyond the received data.
+    JOPT::frame(buf, 20);
+    buflen = 24;
+    EXPECT_FALSE(JOPT::filter100_5::filter(buf, buflen));
+    buflen = 25;
+    EXPECT_TRUE(JOPT::filter100_5::filter(buf, buflen));
+    buf[2] = 250;
+    buflen = 64;
+    EXPECT_FALSE(OTRadioLink::JeelabsOemPacket::filter(buf, buflen));
+    buflen = 4;
+    EXPECT_FALSE(OTRadioLink::FrameFilterJeelabsLength::apply(buf, buflen));
+    buflen = 0;
+    EXPECT_FALSE(JOPT::filter100_5::filter(buf, buflen));
+    // Largest frame that fits the buffer.
+    EXPECT_EQ(64, JOPT::frame(buf, 59));
+    buflen = 64;
+    EXPECT_TRUE(JOPT::filter100_5::filter(buf, buflen));
+    EXPECT_EQ(64, buflen);
+}
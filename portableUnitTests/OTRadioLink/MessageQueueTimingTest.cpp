@@ -0,0 +1,100 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2018
+*/
+
+/*
+ * Tests of RX handling timing stats for the message queue handler.
+ */
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTRadioLink.h>
+
+namespace MQTT
+{
+static bool pollIO(bool) { return(false); }
+}
+
+// Check histogram binning, max, budget overruns and saturation.
+TEST(MessageQueueTiming, Record)
+{
+    typedef OTRadioLink::OTMessageQueueTimingStats s_t;
+    EXPECT_EQ(0, s_t::ticksBin(0));
+    EXPECT_EQ(0, s_t::ticksBin(15));
+    EXPECT_EQ(1, s_t::ticksBin(16));
+    EXPECT_EQ(2, s_t::ticksBin(63));
+    EXPECT_EQ(3, s_t::ticksBin(64));
+    EXPECT_EQ(3, s_t::ticksBin(255));
+    s_t s;
+    s.clear();
+    s.recordFrame(3);
+    s.recordFrame(60);
+    s.recordFrame(20);
+    EXPECT_EQ(3, s.frames);
+    EXPECT_EQ(60, s.maxTicksPerFrame);
+    EXPECT_EQ(1, s.ticksHistogram[0]);
+    EXPECT_EQ(1, s.ticksHistogram[1]);
+    EXPECT_EQ(1, s.ticksHistogram[2]);
+    EXPECT_EQ(0, s.ticksHistogram[3]);
+    s.recordCall(64, 64);
+    EXPECT_EQ(0, s.budgetOverruns);
+    s.recordCall(65, 64);
+    EXPECT_EQ(1, s.budgetOverruns);
+    s.budgetOverruns = 0xffff;
+    s.recordCall(255, 0);
+    EXPECT_EQ(0xffff, s.budgetOverruns);
+}
+
+// Check export into keys reserved in a JSON stats holder.
+TEST(MessageQueueTiming, JSONStats)
+{
+    OTRadioLink::OTMessageQueueTimingStats s;
+    s.clear();
+    s.recordFrame(42);
+    s.budgetOverruns = 0xffff;
+    auto sh = OTV0P2BASE::makeJSONStatsHolder(V0p2_SENSOR_TAG_F("rxT"), V0p2_SENSOR_TAG_F("rxB"));
+    EXPECT_EQ(2, sh.ss.getCapacity());
+    EXPECT_TRUE(sh.putOrRemoveAll());
+    EXPECT_EQ(0, sh.ss.size());
+    EXPECT_TRUE(OTRadioLink::putMessageQueueTimingStats(sh.ss, s));
+    EXPECT_EQ(2, sh.ss.size());
+    sh.ss.setID(V0p2_SENSOR_TAG_F(""));
+    sh.ss.enableCount(false);
+    char buf[OTV0P2BASE::MSG_JSON_MAX_LENGTH + 2];
+    EXPECT_NE(0, sh.ss.writeJSON((uint8_t *)buf, sizeof(buf), 0, true));
+    EXPECT_STREQ("{\"rxT\":42,\"rxB\":32767}", buf);
+}
+
+// Check that timing stats can be attached to a budgeted handler.
+// The sub-cycle time is not available on the host so nothing is recorded.
+TEST(MessageQueueTiming, Handler)
+{
+    OTRadioLink::OTMessageQueueHandler<
+        MQTT::pollIO, 4800,
+        OTRadioLink::decodeAndHandleDummyFrame,
+        OTRadioLink::decodeAndHandleDummyFrame,
+        1, OTRadioLink::OTNoDeferredFrameOps, 32> mh;
+    OTRadioLink::OTMessageQueueTimingStats s;
+    s.frames = 1;
+    mh.setTimingStats(&s);
+    EXPECT_EQ(0, s.frames);
+    OTRadioLink::OTNullRadioLink rl;
+    EXPECT_FALSE(mh.handle(false, rl));
+    EXPECT_EQ(0, s.frames);
+    EXPECT_EQ(0, s.budgetOverruns);
+    mh.setTimingStats(nullptr);
+}
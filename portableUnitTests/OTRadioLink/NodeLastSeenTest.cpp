@@ -0,0 +1,117 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Tests of the hub last-seen node table.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <OTRadioLink.h>
+
+namespace NLST
+{
+typedef OTRadioLink::OTNodeLastSeenTable<8> Table;
+Table table;
+uint16_t nowM;
+uint8_t rssi;
+}
+
+// Nodes are recorded per slot, and aged modulo 2^16 minutes.
+TEST(NodeLastSeen, Update)
+{
+    NLST::Table t;
+    EXPECT_FALSE(t.isSeen(0));
+    EXPECT_EQ(NULL, t.get(0));
+    EXPECT_EQ(int(NLST::Table::NEVER), t.ageM(0, 10));
+    EXPECT_FALSE(t.update(-1, 10, 0, 0));
+    EXPECT_FALSE(t.update(8, 10, 0, 0));
+    EXPECT_TRUE(t.update(3, 0xfff0, 120, 7, 55));
+    ASSERT_NE((void *)NULL, t.get(3));
+    EXPECT_EQ(120, t.get(3)->rssi);
+    EXPECT_EQ(7, t.get(3)->ctrLSB);
+    EXPECT_EQ(55, t.get(3)->valvePC);
+    EXPECT_EQ(1, t.get(3)->frames);
+    EXPECT_EQ(0x20, t.ageM(3, 0x10));
+    // Invalid valve % is held as unknown.
+    EXPECT_TRUE(t.update(3, 0x10, 121, 8, 0x7f));
+    EXPECT_EQ(int(NLST::Table::VALVE_PC_UNKNOWN), t.get(3)->valvePC);
+    EXPECT_EQ(2, t.get(3)->frames);
+    EXPECT_EQ(0, t.ageM(3, 0x10));
+    // Forgetting restarts the frame count.
+    t.forget(3);
+    EXPECT_FALSE(t.isSeen(3));
+    EXPECT_TRUE(t.update(3, 0x11, 0, 0));
+    EXPECT_EQ(1, t.get(3)->frames);
+    t.clear();
+    EXPECT_FALSE(t.isSeen(3));
+}
+
+// Stale and never-seen slots are summarised compactly.
+TEST(NodeLastSeen, Missing)
+{
+    NLST::Table t;
+    EXPECT_EQ(0x1fU, t.missingMask(100, 60, 5));
+    EXPECT_EQ(5, t.missingCount(100, 60, 5));
+    t.update(0, 90, 0, 0);
+    t.update(2, 10, 0, 0);
+    t.update(4, 40, 0, 0);
+    EXPECT_EQ(0x0eU, t.missingMask(100, 60, 5));
+    EXPECT_EQ(0x1eU, t.missingMask(101, 60, 5));
+    EXPECT_EQ(0xfeU, t.missingMask(101, 60));
+    EXPECT_EQ(4, t.missingCount(101, 60, 5));
+    char buf[28];
+    EXPECT_EQ(20, t.writeMissingJSON(buf, sizeof(buf), 101, 60, 5));
+    EXPECT_STREQ("{\"miss\":4,\"mm\":\"1e\"}", buf);
+    // None missing.
+    EXPECT_EQ(19, t.writeMissingJSON(buf, sizeof(buf), 101, 60, 1));
+    EXPECT_STREQ("{\"miss\":0,\"mm\":\"0\"}", buf);
+    // Too small.
+    EXPECT_EQ(0, t.writeMissingJSON(buf, 19, 101, 60, 1));
+    // Largest.
+    OTRadioLink::OTNodeLastSeenTable<32> big;
+    EXPECT_EQ(27, big.writeMissingJSON(buf, sizeof(buf), 0, 0));
+    EXPECT_STREQ("{\"miss\":32,\"mm\":\"ffffffff\"}", buf);
+}
+
+// The frame operation records the sender by association slot.
+TEST(NodeLastSeen, FrameOperation)
+{
+    // Minimal secure-looking frame: 4-byte header ID, 0 body, 23-byte trailer starting with the counter.
+    uint8_t msgBuf[1 + 4 + 4 + 23] = { 8 + 23, 0xcf, 0x04, 1, 2, 3, 4, 0 };
+    const uint8_t ctr[6] = { 0, 0, 1, 0, 2, 0x33 };
+    memcpy(msgBuf + 8, ctr, sizeof(ctr));
+    uint8_t ptext[OTRadioLink::OTDecodeData_T::ptextLenMax] = { 42, 0x10 };
+    OTRadioLink::OTDecodeData_T fd(msgBuf, ptext);
+    fd.sfh.decodeHeader(msgBuf, sizeof(msgBuf));
+    ASSERT_EQ(8, fd.sfh.getTrailerOffset());
+    fd.ptextLen = 2;
+    NLST::nowM = 5;
+    NLST::rssi = 99;
+    // Not a known association.
+    EXPECT_FALSE((OTRadioLink::nodeLastSeenFrameOperation<decltype(NLST::table), NLST::table, NLST::nowM, NLST::rssi>(fd)));
+    fd.assocIndex = 6;
+    EXPECT_TRUE((OTRadioLink::nodeLastSeenFrameOperation<decltype(NLST::table), NLST::table, NLST::nowM, NLST::rssi>(fd)));
+    const NLST::Table::Entry_t *const e = NLST::table.get(6);
+    ASSERT_NE((void *)NULL, e);
+    EXPECT_EQ(5, e->lastSeenM);
+    EXPECT_EQ(99, e->rssi);
+    EXPECT_EQ(0x33, e->ctrLSB);
+    EXPECT_EQ(42, e->valvePC);
+}
@@ -0,0 +1,223 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * OTRFM23BLink tests (portable parts only).
+ */
+
+#include <gtest/gtest.h>
+
+#include <OTRadioLink.h>
+
+#include "OTRFM23BLink_OTRFM23BLink.h"
+#include "OTRFM23BLink_RegConfig.h"
+
+// Check wake-up timer and LDC register settings for duty-cycled RX.
+TEST(OTRFM23BLink,lowDutyCycleConfig)
+{
+    OTRFM23BLink::RFM23BLowDutyCycleConfig c;
+    EXPECT_FALSE(c.isEnabled());
+    // 1s period with ~1ms sniffs fits at the finest resolution.
+    ASSERT_TRUE(OTRFM23BLink::RFM23BLowDutyCycleConfig::compute(1000, 1000, c));
+    EXPECT_TRUE(c.isEnabled());
+    EXPECT_EQ(0, c.wtr);
+    EXPECT_EQ(8192, c.wtm);
+    EXPECT_EQ(9, c.ldc);
+    EXPECT_EQ(1000U, c.getPeriodMs());
+    EXPECT_EQ(1098U, c.getOnUs());
+    EXPECT_EQ(1098U, c.getDutyPPM());
+    // A long period needs a coarser tick, rounding the on time up.
+    ASSERT_TRUE(OTRFM23BLink::RFM23BLowDutyCycleConfig::compute(60000, 2000, c));
+    EXPECT_EQ(3, c.wtr);
+    EXPECT_EQ(61440, c.wtm);
+    EXPECT_EQ(3, c.ldc);
+    EXPECT_EQ(60000U, c.getPeriodMs());
+    EXPECT_LE(2000U, c.getOnUs());
+    // Long on time limited by the 8-bit LDC.
+    ASSERT_TRUE(OTRFM23BLink::RFM23BLowDutyCycleConfig::compute(100, 50000, c));
+    EXPECT_EQ(1, c.wtr);
+    EXPECT_LE(50000U, c.getOnUs());
+    EXPECT_EQ(100U, c.getPeriodMs());
+    // Invalid: no on time, or on for the whole period.
+    EXPECT_FALSE(OTRFM23BLink::RFM23BLowDutyCycleConfig::compute(1000, 0, c));
+    EXPECT_FALSE(c.isEnabled());
+    EXPECT_FALSE(OTRFM23BLink::RFM23BLowDutyCycleConfig::compute(10, 10000, c));
+    EXPECT_FALSE(c.isEnabled());
+    // Every representable request gives at least the on time, and the period to within a tick.
+    for(uint16_t periodMs = 1; periodMs < 65000; periodMs = uint16_t(periodMs * 3 + 1))
+        for(uint16_t onUs = 100; onUs < 60000; onUs = uint16_t(onUs * 2 + 7))
+            {
+            if(!OTRFM23BLink::RFM23BLowDutyCycleConfig::compute(periodMs, onUs, c)) { continue; }
+            EXPECT_LE(onUs, c.getOnUs() + 1);
+            const uint32_t tickMs = ((1UL << c.wtr) * 125 + 1023) / 1024;
+            EXPECT_LE(periodMs, c.getPeriodMs() + tickMs) << periodMs << ' ' << onUs;
+            EXPECT_GE(periodMs + tickMs, c.getPeriodMs()) << periodMs << ' ' << onUs;
+            EXPECT_LT(c.ldc, c.wtm);
+            }
+}
+
+// Check the sender preamble needed to reach a duty-cycled receiver.
+TEST(OTRFM23BLink,minPreambleBits)
+{
+    // Sniffing every 30ms for 1ms at 57.6kbps needs ~1.8k bits, within the 2044-bit hardware maximum.
+    EXPECT_EQ(1806U, OTRFM23BLink::RFM23BLowDutyCycleConfig::minPreambleBits(30, 1000, 57600));
+    EXPECT_EQ(5U + 20U, OTRFM23BLink::RFM23BLowDutyCycleConfig::minPreambleBits(1, 0, 5000));
+    EXPECT_EQ(5U, OTRFM23BLink::RFM23BLowDutyCycleConfig::minPreambleBits(1, 0, 5000, 0));
+}
+
+// Quieter TX power hints step TXPOW down from the configured value, keeping other bits.
+TEST(OTRFM23BLink,txPowerReg)
+{
+    typedef OTRadioLink::OTRadioLink ORL;
+    // As configured: LNA_SW=1, TXPOW=3.
+    EXPECT_EQ(0x0b, OTRFM23BLink::RFM23BTXPowerReg(0x0b, ORL::TXmax));
+    EXPECT_EQ(0x0b, OTRFM23BLink::RFM23BTXPowerReg(0x0b, ORL::TXloud));
+    EXPECT_EQ(0x0b, OTRFM23BLink::RFM23BTXPowerReg(0x0b, ORL::TXnormal));
+    EXPECT_EQ(0x0a, OTRFM23BLink::RFM23BTXPowerReg(0x0b, ORL::TXquiet));
+    EXPECT_EQ(0x08, OTRFM23BLink::RFM23BTXPowerReg(0x0b, ORL::TXmin));
+    // Never below the minimum TXPOW.
+    EXPECT_EQ(0x08, OTRFM23BLink::RFM23BTXPowerReg(0x09, ORL::TXmin));
+    EXPECT_EQ(0x08, OTRFM23BLink::RFM23BTXPowerReg(0x08, ORL::TXquiet));
+    EXPECT_EQ(0x0c, OTRFM23BLink::RFM23BTXPowerReg(0x0f, ORL::TXmin));
+}
+
+// Packet-handler RX reads exactly the reported length, and wakes on hardware CRC errors iff CRC is on.
+TEST(OTRFM23BLink,packetRX)
+{
+    // Data Access Control as in StandardRegSettingsGFSK57600 and StandardRegSettingsGFSK57600CRC.
+    EXPECT_EQ(0x02, OTRFM23BLink::RFM23BPacketIRQEnable1(0x88));
+    EXPECT_EQ(0x03, OTRFM23BLink::RFM23BPacketIRQEnable1(0x8d));
+    EXPECT_EQ(1, OTRFM23BLink::RFM23BPacketRXBytes(1, 64));
+    EXPECT_EQ(23, OTRFM23BLink::RFM23BPacketRXBytes(23, 64));
+    EXPECT_EQ(64, OTRFM23BLink::RFM23BPacketRXBytes(64, 64));
+    // Empty and over-long frames are dropped unread.
+    EXPECT_EQ(0, OTRFM23BLink::RFM23BPacketRXBytes(0, 64));
+    EXPECT_EQ(0, OTRFM23BLink::RFM23BPacketRXBytes(65, 64));
+    EXPECT_EQ(0, OTRFM23BLink::RFM23BPacketRXBytes(255, 64));
+}
+
+namespace RFMRCT
+{
+// As StandardRegSettingsGFSK57600.
+constexpr OTRFM23BLink::RFM23BChannelDesc gfsk57600 =
+    { 868500000UL, 57600, 28750, true, 40, 20, 2, 0x2dd40000UL, false, false, 50000, 0x0b };
+// Slow FSK in the low band with a long preamble, 4-byte sync and CRC.
+constexpr OTRFM23BLink::RFM23BChannelDesc fsk4800 =
+    { 434000000UL, 4800, 5000, false, 1024, 32, 4, 0x2dd4aa55UL, true, true, 10000, 0x08 };
+}
+
+// Register tables computed from a channel description match the hand-derived ones.
+TEST(OTRFM23BLink,regConfig)
+{
+    typedef OTRFM23BLink::RFM23BRegConfig<RFMRCT::gfsk57600> G;
+    static const uint8_t expected[][2] =
+        {
+        { 0x1c, 0x06 }, { 0x20, 0x45 }, { 0x21, 0x01 }, { 0x22, 0xd7 }, { 0x23, 0xdc },
+        { 0x2a, 0x28 }, { 0x30, 0x88 }, { 0x33, 0x02 }, { 0x34, 0x0a }, { 0x35, 0x2a },
+        { 0x36, 0x2d }, { 0x37, 0xd4 }, { 0x38, 0x00 }, { 0x39, 0x00 }, { 0x6d, 0x0b },
+        { 0x6e, 0x0e }, { 0x6f, 0xbf }, { 0x70, 0x0c }, { 0x71, 0x23 }, { 0x72, 0x2e },
+        { 0x75, 0x73 }, { 0x76, 0x6a }, { 0x77, 0x40 },
+        };
+    for(const auto &e : expected)
+        {
+        bool found = false;
+        for(uint8_t i = 0; 0xff != G::values[i][0]; ++i)
+            { if(e[0] == G::values[i][0]) { EXPECT_EQ(e[1], G::values[i][1]) << std::hex << int(e[0]); found = true; } }
+        EXPECT_TRUE(found) << std::hex << int(e[0]);
+        }
+    // AN440 timing loop gain; within 0.2% of the hand-derived 0x76e.
+    EXPECT_NEAR(0x76e, OTRFM23BLink::RFM23BCRGain(RFMRCT::gfsk57600), 3);
+    // Ascending, in the same bursts as StandardRegSettingsGFSK57600.
+    EXPECT_EQ(16, OTRFM23BLink::RFM23BRegRuns(G::values));
+    EXPECT_EQ(0xff, G::values[G::ROWS - 1][0]);
+
+    // Low band, scaled data rate, narrow filter.
+    typedef OTRFM23BLink::RFM23BRegConfig<RFMRCT::fsk4800> F;
+    EXPECT_EQ(0x40 | 19, OTRFM23BLink::RFM23BBandSelectReg(RFMRCT::fsk4800));
+    EXPECT_EQ(25600, OTRFM23BLink::RFM23BCarrierReg(RFMRCT::fsk4800));
+    EXPECT_EQ(10066, OTRFM23BLink::RFM23BDataRateReg(RFMRCT::fsk4800)); // 4800 * 2^21 / 1e6.
+    EXPECT_EQ(0x36, OTRFM23BLink::RFM23BIFFilterReg(RFMRCT::fsk4800)); // 14.8kHz needed, so 16.2kHz.
+    EXPECT_EQ(8, OTRFM23BLink::RFM23BDeviationReg(RFMRCT::fsk4800));
+    EXPECT_EQ(16, OTRFM23BLink::RFM23BAFCLimitReg(RFMRCT::fsk4800));
+    EXPECT_EQ(16, OTRFM23BLink::RFM23BRegRuns(F::values));
+    for(uint8_t i = 0; 0xff != F::values[i][0]; ++i)
+        {
+        switch(F::values[i][0])
+            {
+            case 0x30: EXPECT_EQ(0x8d, F::values[i][1]); break;
+            case 0x33: EXPECT_EQ(0x08 | 0x06 | 0x01, F::values[i][1]); break;
+            case 0x34: EXPECT_EQ(0, F::values[i][1]); break;
+            case 0x35: EXPECT_EQ((8 << 3) | 2, F::values[i][1]); break;
+            case 0x39: EXPECT_EQ(0x55, F::values[i][1]); break;
+            case 0x70: EXPECT_EQ(0x2c, F::values[i][1]); break;
+            case 0x71: EXPECT_EQ(0x22, F::values[i][1]); break;
+            }
+        }
+
+    // Too wide for the IF filters covered, and out of band.
+    constexpr OTRFM23BLink::RFM23BChannelDesc wide =
+        { 868000000UL, 49261, 90000, false, 24, 16, 1, 0x2d000000UL, false, true, 50000, 0x0b };
+    EXPECT_FALSE(OTRFM23BLink::RFM23BChannelDescOK(wide));
+    EXPECT_TRUE(OTRFM23BLink::RFM23BChannelDescOK(RFMRCT::gfsk57600));
+    constexpr OTRFM23BLink::RFM23BChannelDesc oob =
+        { 100000000UL, 57600, 28750, true, 40, 20, 2, 0x2dd40000UL, false, false, 50000, 0x0b };
+    EXPECT_FALSE(OTRFM23BLink::RFM23BChannelDescOK(oob));
+    // Out of order tables are flagged.
+    static const uint8_t unsorted[][2] = { { 0x10, 0 }, { 0x11, 0 }, { 0x05, 0 }, { 0xff, 0xff } };
+    EXPECT_EQ(0, OTRFM23BLink::RFM23BRegRuns(unsorted));
+}
+
+// Check listen-before-talk settings and the adaptive noise floor.
+TEST(OTRFM23BLink,listenBeforeTalk)
+{
+    const OTRFM23BLink::RFM23BListenBeforeTalkConfig off;
+    for(int8_t c = -1; c < 9; ++c) { EXPECT_FALSE(off.isEnabledFor(c)); }
+    const OTRFM23BLink::RFM23BListenBeforeTalkConfig lbt(0x02, 10, 3, 4);
+    EXPECT_FALSE(lbt.isEnabledFor(0));
+    EXPECT_TRUE(lbt.isEnabledFor(1));
+    EXPECT_FALSE(lbt.isEnabledFor(-1));
+    EXPECT_FALSE(lbt.isEnabledFor(8));
+    // Backoff is always in [1,maxBackoffSlots].
+    for(int r = 0; r < 256; ++r)
+        {
+        const uint8_t b = lbt.backoffSlots(uint8_t(r));
+        EXPECT_LE(1, b);
+        EXPECT_GE(4, b);
+        }
+    EXPECT_EQ(1, OTRFM23BLink::RFM23BListenBeforeTalkConfig(1, 10, 3, 0).backoffSlots(0xff));
+
+    OTRFM23BLink::RFM23BNoiseFloor nf;
+    EXPECT_EQ(0, nf.getFloor());
+    // First sample seeds the floor.
+    EXPECT_TRUE(nf.isClear(60, 10));
+    EXPECT_EQ(60, nf.getFloor());
+    // A quieter sample pulls the floor down quickly.
+    EXPECT_TRUE(nf.isClear(40, 10));
+    EXPECT_EQ(50, nf.getFloor());
+    // Within the margin is clear and moves the floor up only a little.
+    EXPECT_TRUE(nf.isClear(60, 10));
+    EXPECT_EQ(51, nf.getFloor());
+    // Well above the floor is busy and is not learnt as noise...
+    EXPECT_FALSE(nf.isClear(120, 10));
+    EXPECT_EQ(52, nf.getFloor());
+    // ...though a lasting rise in the background is eventually accepted.
+    int busy = 0;
+    while(!nf.isClear(80, 10)) { ASSERT_GT(100, ++busy); }
+    EXPECT_LT(0, busy);
+    EXPECT_LE(70, nf.getFloor());
+}
@@ -0,0 +1,127 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * OTRN2483Link tests (portable parts only).
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <OTRadioLink.h>
+
+#include "OTRN2483Link_OTRN2483Link.h"
+
+// Feed a string to the parser, returning the number of frames completed.
+static int feed(OTRN2483Link::OTRN2483RXParser &p, const char *s)
+{
+    int n = 0;
+    while('\0' != *s) { if(p.handleByte((uint8_t)*s++)) { ++n; } }
+    return(n);
+}
+
+// Check that received-frame responses are decoded and other lines ignored.
+TEST(OTRN2483Link,RXParser)
+{
+    OTRadioLink::ISRRXQueueVarLenMsg<8, 2> q;
+    OTRN2483Link::OTRN2483RXParser p(q, 8);
+    // Ordinary responses are ignored.
+    EXPECT_EQ(0, feed(p, "ok\r\nmac_tx_ok\r\ninvalid_param\r\nradio_err\r\n"));
+    EXPECT_TRUE(q.isEmpty());
+    // Raw radio frame, mixed case hex.
+    EXPECT_EQ(1, feed(p, "radio_rx  01aB\r\n"));
+    ASSERT_EQ(1, q.getRXMsgsQueued());
+    const volatile uint8_t *m = q.peekRXMsg();
+    ASSERT_TRUE(NULL != m);
+    EXPECT_EQ(2, m[-1]);
+    EXPECT_EQ(0x01, m[0]);
+    EXPECT_EQ(0xab, m[1]);
+    q.removeRXMsg();
+    // LoRaWAN downlink, port discarded; bare LF terminator.
+    EXPECT_EQ(1, feed(p, "mac_rx 12 DEADBEEF\n"));
+    m = q.peekRXMsg();
+    ASSERT_TRUE(NULL != m);
+    EXPECT_EQ(4, m[-1]);
+    EXPECT_EQ(0xde, m[0]);
+    EXPECT_EQ(0xef, m[3]);
+    q.removeRXMsg();
+    // Malformed frames are rejected without being queued.
+    EXPECT_EQ(0, feed(p, "radio_rx  abc\r\n")); // Odd nibble count.
+    EXPECT_EQ(0, feed(p, "radio_rx  zz\r\n")); // Not hex.
+    EXPECT_EQ(0, feed(p, "mac_rx 1\r\n")); // No data.
+    EXPECT_EQ(0, feed(p, "mac_rxx 1 00\r\n")); // Bad prefix.
+    EXPECT_EQ(0, feed(p, "xradio_rx  00\r\n")); // Not at start of line.
+    EXPECT_TRUE(q.isEmpty());
+    EXPECT_EQ(0, p.getDroppedCount());
+    // Frame too long for the queue is dropped and counted.
+    EXPECT_EQ(0, feed(p, "radio_rx  000102030405060708\r\n"));
+    EXPECT_TRUE(q.isEmpty());
+    EXPECT_EQ(1, p.getDroppedCount());
+    // Parser recovers for the next line, even split across calls.
+    EXPECT_EQ(0, feed(p, "radio_r"));
+    EXPECT_EQ(0, feed(p, "x  4"));
+    EXPECT_EQ(1, feed(p, "2\r\n"));
+    m = q.peekRXMsg();
+    ASSERT_TRUE(NULL != m);
+    EXPECT_EQ(1, m[-1]);
+    EXPECT_EQ(0x42, m[0]);
+    // Fill the queue and check that overflow is counted.
+    int queued = 1;
+    while(!q.isFull()) { ASSERT_EQ(1, feed(p, "radio_rx  0102030405060708\r\n")); ++queued; }
+    EXPECT_EQ(queued, q.getRXMsgsQueued());
+    EXPECT_EQ(0, feed(p, "radio_rx  01\r\n"));
+    EXPECT_EQ(2, p.getDroppedCount());
+    EXPECT_EQ(queued, q.getRXMsgsQueued());
+}
+
+// Check the command response helpers used to detect a saved MAC session.
+TEST(OTRN2483Link,Response)
+{
+    const char *const r = "02011123\r\n";
+    EXPECT_TRUE(OTRN2483Link::OTRN2483Response::matches(r, (uint8_t)strlen(r), "02011123"));
+    EXPECT_TRUE(OTRN2483Link::OTRN2483Response::matches("00ab\n", 5, "00AB"));
+    EXPECT_FALSE(OTRN2483Link::OTRN2483Response::matches(r, (uint8_t)strlen(r), "0201112"));
+    EXPECT_FALSE(OTRN2483Link::OTRN2483Response::matches(r, (uint8_t)strlen(r), "020111230"));
+    EXPECT_FALSE(OTRN2483Link::OTRN2483Response::matches("invalid_param\r\n", 15, "02011123"));
+    // Truncated (timed out) response.
+    EXPECT_FALSE(OTRN2483Link::OTRN2483Response::matches(r, 4, "02011123"));
+    EXPECT_FALSE(OTRN2483Link::OTRN2483Response::matches(NULL, 0, "02011123"));
+
+    uint32_t v = 7;
+    EXPECT_TRUE(OTRN2483Link::OTRN2483Response::parseU32("4294967295\r\n", 12, v));
+    EXPECT_EQ(4294967295U, v);
+    EXPECT_TRUE(OTRN2483Link::OTRN2483Response::parseU32("0", 1, v));
+    EXPECT_EQ(0U, v);
+    v = 7;
+    EXPECT_FALSE(OTRN2483Link::OTRN2483Response::parseU32("4294967296", 10, v));
+    EXPECT_FALSE(OTRN2483Link::OTRN2483Response::parseU32("\r\n", 2, v));
+    EXPECT_FALSE(OTRN2483Link::OTRN2483Response::parseU32("12a", 3, v));
+    EXPECT_EQ(7U, v);
+
+    char buf[11];
+    char *const e = OTRN2483Link::OTRN2483Response::formatU32(buf, 4294967295U);
+    EXPECT_STREQ("4294967295", buf);
+    EXPECT_EQ(buf + 10, e);
+    OTRN2483Link::OTRN2483Response::formatU32(buf, 0);
+    EXPECT_STREQ("0", buf);
+    OTRN2483Link::OTRN2483Response::formatU32(buf, 1032);
+    EXPECT_TRUE(OTRN2483Link::OTRN2483Response::parseU32(buf, sizeof(buf), v));
+    EXPECT_EQ(1032U, v);
+}
@@ -0,0 +1,497 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * OTRadioLink base class tests.
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <OTV0p2Base.h>
+#include <OTRadioLink.h>
+
+#include "OTRadioLink_ISRRXQueue.h"
+
+namespace ORLT
+{
+// Minimal radio backed by a real RX queue, with frames injected by the test.
+class QueueRadioLinkMock final : public OTRadioLink::OTRadioLink
+    {
+    public:
+        ::OTRadioLink::ISRRXQueueVarLenMsg<16, 4> queueRX;
+        // Inject a frame as if from the RX ISR; returns false if no space.
+        bool inject(const uint8_t *buf, const uint8_t len)
+            {
+            volatile uint8_t *bp = queueRX._getRXBufForInbound();
+            if(NULL == bp) { return(false); }
+            for(uint8_t i = 0; i < len; ++i) { bp[i] = buf[i]; }
+            queueRX._loadedBuf(len);
+            _stampRXQueued();
+            return(true);
+            }
+        virtual void getCapacity(uint8_t &queueRXMsgsMin, uint8_t &maxRXMsgLen, uint8_t &maxTXMsgLen) const override
+            { queueRX.getRXCapacity(queueRXMsgsMin, maxRXMsgLen); maxTXMsgLen = 0; }
+        virtual uint8_t getRXMsgsQueued() const override { return(queueRX.getRXMsgsQueued()); }
+        virtual const volatile uint8_t *peekRXMsg() const override { return(queueRX.peekRXMsg()); }
+        virtual void removeRXMsg() override { queueRX.removeRXMsg(); _stampRXRemoved(); }
+        // Expose the driver-side stats hooks to the test.
+        void statsRXQueued(int8_t channel, uint8_t rssi) { _statsRXQueued(channel, rssi); }
+        void statsRXDropped(int8_t channel) { _statsRXDropped(channel); }
+        void statsRXFiltered(int8_t channel) { _statsRXFiltered(channel); }
+        void statsRXCRCError(int8_t channel) { _statsRXCRCError(channel); }
+        void statsTXAttempt(int8_t channel) { _statsTXAttempt(channel); }
+        // Pretend to transmit, recording the airtime.
+        virtual bool sendRaw(const uint8_t *, uint8_t buflen, int8_t channel, TXpower, bool) override { _recordTX(channel, buflen); return(true); }
+    private:
+        virtual void _dolisten() override { }
+    };
+
+// Record of frames seen by the drain handler.
+static uint8_t seenCount;
+static uint8_t seenFirstBytes[8];
+static uint8_t seenLens[8];
+static void recordFrame(volatile const uint8_t *msg)
+    {
+    if(seenCount < sizeof(seenLens)) { seenFirstBytes[seenCount] = msg[0]; seenLens[seenCount] = msg[-1]; }
+    ++seenCount;
+    }
+}
+
+// Check that drainRX() visits queued frames in order and honours maxFrames.
+TEST(OTRadioLink,drainRX)
+{
+    ORLT::QueueRadioLinkMock rl;
+    ORLT::seenCount = 0;
+    // Nothing to do with no handler or nothing queued.
+    EXPECT_EQ(0, rl.drainRX(NULL));
+    EXPECT_EQ(0, rl.drainRX(ORLT::recordFrame));
+    EXPECT_EQ(0, ORLT::seenCount);
+    // Queue some frames of different lengths.
+    const uint8_t f1[] = { 1, 2, 3 };
+    const uint8_t f2[] = { 4 };
+    const uint8_t f3[] = { 5, 6 };
+    ASSERT_TRUE(rl.inject(f1, sizeof(f1)));
+    ASSERT_TRUE(rl.inject(f2, sizeof(f2)));
+    ASSERT_TRUE(rl.inject(f3, sizeof(f3)));
+    EXPECT_EQ(3, rl.getRXMsgsQueued());
+    // Limit to a single frame.
+    EXPECT_EQ(1, rl.drainRX(ORLT::recordFrame, 1));
+    EXPECT_EQ(1, ORLT::seenCount);
+    EXPECT_EQ(2, rl.getRXMsgsQueued());
+    // Drain the rest in one pass.
+    EXPECT_EQ(2, rl.drainRX(ORLT::recordFrame));
+    EXPECT_EQ(3, ORLT::seenCount);
+    EXPECT_EQ(0, rl.getRXMsgsQueued());
+    EXPECT_EQ(1, ORLT::seenFirstBytes[0]);
+    EXPECT_EQ(3, ORLT::seenLens[0]);
+    EXPECT_EQ(4, ORLT::seenFirstBytes[1]);
+    EXPECT_EQ(1, ORLT::seenLens[1]);
+    EXPECT_EQ(5, ORLT::seenFirstBytes[2]);
+    EXPECT_EQ(2, ORLT::seenLens[2]);
+    EXPECT_TRUE(NULL == rl.peekRXMsg());
+}
+
+namespace ORLT
+{
+// Fake tick source for RX arrival stamps.
+static uint16_t fakeTicks;
+static uint16_t getFakeTicks() { return(fakeTicks); }
+// Drain handler that takes 3 ticks per frame.
+static void slowFrame(volatile const uint8_t *) { fakeTicks += 3; }
+}
+
+// Check that RX queueing latency is recorded per frame class by drainRX().
+TEST(OTRadioLink,rxLatency)
+{
+    ORLT::QueueRadioLinkMock rl;
+    OTRadioLink::OTRXArrivalStamps stamps(ORLT::getFakeTicks);
+    OTRadioLink::OTRXLatencyStats stats;
+    rl.setRXLatency(&stamps, &stats);
+    ORLT::fakeTicks = 0xfff0; // Check across a wrap.
+    const uint8_t valve[] = { 'O' | 0x80, 1 };
+    const uint8_t beacon[] = { '!', 2 };
+    const uint8_t other[] = { 'x', 3 };
+    ASSERT_TRUE(rl.inject(valve, sizeof(valve)));
+    ORLT::fakeTicks += 10;
+    ASSERT_TRUE(rl.inject(beacon, sizeof(beacon)));
+    ASSERT_TRUE(rl.inject(other, sizeof(other)));
+    ORLT::fakeTicks += 100;
+    EXPECT_EQ(3, rl.drainRX(ORLT::slowFrame));
+    // Valve waited 113 ticks, beacon 106, other 109.
+    EXPECT_EQ(1U, stats.getCount(OTRadioLink::OTRXLatencyStats::FC_VALVE));
+    EXPECT_EQ(1U, stats.getCount(OTRadioLink::OTRXLatencyStats::FC_BEACON));
+    EXPECT_EQ(1U, stats.getCount(OTRadioLink::OTRXLatencyStats::FC_OTHER));
+    EXPECT_EQ(127, stats.getPercentileTicks(OTRadioLink::OTRXLatencyStats::FC_VALVE, 50));
+    EXPECT_EQ(0, stamps.stamped);
+    EXPECT_EQ(0, stamps.queued);
+
+    // Percentiles over many frames of one class.
+    stats.clear();
+    for(int i = 0; i < 98; ++i) { stats.record('O', 2); }
+    stats.record('O', 40);
+    stats.record('O', 5000);
+    EXPECT_EQ(3, stats.getPercentileTicks(OTRadioLink::OTRXLatencyStats::FC_VALVE, 50));
+    EXPECT_EQ(63, stats.getPercentileTicks(OTRadioLink::OTRXLatencyStats::FC_VALVE, 99));
+    EXPECT_EQ(0xffff, stats.getPercentileTicks(OTRadioLink::OTRXLatencyStats::FC_VALVE, 100));
+    EXPECT_EQ(0, stats.getPercentileTicks(OTRadioLink::OTRXLatencyStats::FC_BEACON, 50));
+
+    // Only the oldest frames are stamped when more are queued than stamps held,
+    // and later frames stay unstamped until the stamped ones are gone.
+    stats.clear();
+    OTRadioLink::OTRXArrivalStamps s2(ORLT::getFakeTicks);
+    for(uint8_t i = 0; i < OTRadioLink::OTRXArrivalStamps::MAX_STAMPS + 2; ++i) { s2.noteQueued(); }
+    EXPECT_EQ(+OTRadioLink::OTRXArrivalStamps::MAX_STAMPS, s2.stamped);
+    s2.noteRemoved();
+    s2.noteQueued();
+    EXPECT_EQ(+OTRadioLink::OTRXArrivalStamps::MAX_STAMPS - 1, s2.stamped);
+    for(uint8_t i = 0; i < OTRadioLink::OTRXArrivalStamps::MAX_STAMPS - 1; ++i) { s2.noteRemoved(); }
+    uint16_t t;
+    EXPECT_FALSE(s2.peekOldest(t));
+    EXPECT_EQ(3, s2.queued);
+    rl.setRXLatency(NULL, NULL);
+}
+
+// Check basic FIFO behaviour of TXQueue, including wrap-around and the stub.
+TEST(OTRadioLink,TXQueue)
+{
+    OTRadioLink::TXQueue<3, 4> q;
+    EXPECT_EQ(3, q.capacity);
+    EXPECT_TRUE(q.isEmpty());
+    uint8_t len, power;
+    int8_t channel;
+    EXPECT_TRUE(NULL == q.peek(len, channel, power));
+    const uint8_t f[] = { 10, 11, 12, 13, 14 };
+    // Bad frames are rejected.
+    EXPECT_FALSE(q.push(NULL, 1));
+    EXPECT_FALSE(q.push(f, 0));
+    EXPECT_FALSE(q.push(f, 5));
+    // Fill.
+    EXPECT_TRUE(q.push(f, 1, 0, OTRadioLink::OTRadioLink::TXnormal));
+    EXPECT_TRUE(q.push(f + 1, 2, 1, OTRadioLink::OTRadioLink::TXmax));
+    EXPECT_TRUE(q.push(f + 2, 3));
+    EXPECT_TRUE(q.isFull());
+    EXPECT_FALSE(q.push(f, 1));
+    EXPECT_EQ(3, q.size());
+    // Drain one and add one to force a wrap.
+    const uint8_t *bp = q.peek(len, channel, power);
+    ASSERT_TRUE(NULL != bp);
+    EXPECT_EQ(1, len);
+    EXPECT_EQ(0, channel);
+    EXPECT_EQ(OTRadioLink::OTRadioLink::TXnormal, power);
+    EXPECT_EQ(10, bp[0]);
+    q.pop();
+    EXPECT_TRUE(q.push(f + 3, 1));
+    bp = q.peek(len, channel, power);
+    ASSERT_TRUE(NULL != bp);
+    EXPECT_EQ(2, len);
+    EXPECT_EQ(1, channel);
+    EXPECT_EQ(OTRadioLink::OTRadioLink::TXmax, power);
+    EXPECT_EQ(11, bp[0]);
+    EXPECT_EQ(12, bp[1]);
+    q.pop();
+    q.pop();
+    bp = q.peek(len, channel, power);
+    ASSERT_TRUE(NULL != bp);
+    EXPECT_EQ(1, len);
+    EXPECT_EQ(13, bp[0]);
+    q.pop();
+    EXPECT_TRUE(q.isEmpty());
+    q.pop(); // Harmless.
+    EXPECT_TRUE(q.isEmpty());
+    // Stub queue never accepts anything.
+    OTRadioLink::TXQueue<0, 4> qs;
+    EXPECT_TRUE(qs.isEmpty());
+    EXPECT_TRUE(qs.isFull());
+    EXPECT_FALSE(qs.push(f, 1));
+    EXPECT_TRUE(NULL == qs.peek(len, channel, power));
+    EXPECT_TRUE(NULL == qs.reserve());
+    EXPECT_FALSE(qs.commit(1));
+}
+
+// Check building frames in place with TXQueue reserve()/commit().
+TEST(OTRadioLink,TXQueueReserve)
+{
+    OTRadioLink::TXQueue<2, 4> q;
+    uint8_t len, power;
+    int8_t channel;
+    // Nothing is queued until the commit.
+    uint8_t *b = q.reserve();
+    ASSERT_TRUE(NULL != b);
+    b[0] = 42; b[1] = 43;
+    EXPECT_TRUE(q.isEmpty());
+    EXPECT_FALSE(q.commit(0));
+    EXPECT_FALSE(q.commit(5));
+    EXPECT_TRUE(q.commit(2, 1, OTRadioLink::OTRadioLink::TXquiet));
+    EXPECT_EQ(1, q.size());
+    // Mixes with push(), including across a wrap.
+    const uint8_t f[] = { 7 };
+    EXPECT_TRUE(q.push(f, 1));
+    EXPECT_TRUE(NULL == q.reserve());
+    EXPECT_FALSE(q.commit(1));
+    const uint8_t *bp = q.peek(len, channel, power);
+    ASSERT_TRUE(NULL != bp);
+    EXPECT_EQ(2, len);
+    EXPECT_EQ(1, channel);
+    EXPECT_EQ(OTRadioLink::OTRadioLink::TXquiet, power);
+    EXPECT_EQ(42, bp[0]);
+    EXPECT_EQ(43, bp[1]);
+    q.pop();
+    b = q.reserve();
+    ASSERT_TRUE(NULL != b);
+    b[0] = 44;
+    EXPECT_TRUE(q.commit(1));
+    q.pop();
+    bp = q.peek(len, channel, power);
+    ASSERT_TRUE(NULL != bp);
+    EXPECT_EQ(1, len);
+    EXPECT_EQ(44, bp[0]);
+}
+
+// Check per-channel stats collection, printing and export as JSON stats.
+TEST(OTRadioLink,channelStats)
+{
+    ORLT::QueueRadioLinkMock rl;
+    OTRadioLink::OTRadioChannelStats out;
+    // No stats until storage is supplied, and the hooks are harmless.
+    EXPECT_FALSE(rl.getChannelStats(0, out));
+    rl.statsRXQueued(0, 0);
+    rl.statsTXAttempt(0);
+    // Supply storage for two channels (which should be cleared).
+    OTRadioLink::OTRadioChannelStats stats[2];
+    memset(stats, 0xff, sizeof(stats));
+    rl.setChannelStats(stats, 2);
+    ASSERT_TRUE(rl.getChannelStats(1, out));
+    EXPECT_EQ(0U, out.rxFrames);
+    EXPECT_EQ(0, out.rssiHistogram[7]);
+    EXPECT_FALSE(rl.getChannelStats(2, out));
+    EXPECT_FALSE(rl.getChannelStats(-1, out));
+    // Out-of-range channels are ignored.
+    rl.statsRXQueued(2, 0);
+    rl.statsRXQueued(-1, 0);
+    // Record some activity on channel 0 only.
+    rl.statsRXQueued(0, 0);
+    rl.statsRXQueued(0, 31);
+    rl.statsRXQueued(0, 255);
+    rl.statsRXDropped(0);
+    rl.statsRXFiltered(0);
+    rl.statsRXFiltered(0);
+    rl.statsRXCRCError(0);
+    rl.statsTXAttempt(0);
+    ASSERT_TRUE(rl.getChannelStats(0, out));
+    EXPECT_EQ(3U, out.rxFrames);
+    EXPECT_EQ(1, out.rxDropped);
+    EXPECT_EQ(2, out.rxFiltered);
+    EXPECT_EQ(1, out.rxCRCErrors);
+    EXPECT_EQ(1, out.txAttempts);
+    EXPECT_EQ(2, out.rssiHistogram[0]);
+    EXPECT_EQ(0, out.rssiHistogram[1]);
+    EXPECT_EQ(1, out.rssiHistogram[7]);
+    ASSERT_TRUE(rl.getChannelStats(1, out));
+    EXPECT_EQ(0U, out.rxFrames);
+    // 16-bit counters saturate.
+    stats[1].rxDropped = 0xfffe;
+    rl.statsRXDropped(1);
+    rl.statsRXDropped(1);
+    EXPECT_EQ(0xffff, stats[1].rxDropped);
+    // Human-readable form.
+    char buf[80];
+    OTV0P2BASE::BufPrint bp(buf, sizeof(buf));
+    OTRadioLink::printChannelStats(&bp, stats[0]);
+    EXPECT_STREQ("rx 3 drop 1 filt 2 crc 1 tx 1 rssi 2 0 0 0 0 0 0 1\r\n", buf);
+    // Export into a JSON stats rotation.
+    OTV0P2BASE::SimpleStatsRotation<6> ss;
+    EXPECT_TRUE(OTRadioLink::putChannelStats(ss, stats[0]));
+    EXPECT_EQ(5, ss.size());
+    // Detach.
+    rl.setChannelStats(NULL, 0);
+    EXPECT_FALSE(rl.getChannelStats(0, out));
+}
+
+// Check sliding-window airtime accounting and the duty-cycle send gate.
+TEST(OTRadioLink,dutyCycle)
+{
+    // Airtime calculation, rounding up, with unknown bitrate as zero.
+    EXPECT_EQ(0U, OTRadioLink::OTRadioDutyCycle::frameAirtimeMs(10, 0));
+    EXPECT_EQ(8U, OTRadioLink::OTRadioDutyCycle::frameAirtimeMs(2, 10000));
+    EXPECT_EQ(29U, OTRadioLink::OTRadioDutyCycle::frameAirtimeMs(10, 5000));
+    EXPECT_EQ(1U, OTRadioLink::OTRadioDutyCycle::frameAirtimeMs(0, 100000, 1));
+    // 1% of a 6 * 10s window is 600ms.
+    OTRadioLink::OTRadioDutyCycle dc(10, 10);
+    EXPECT_EQ(600U, dc.getLimitMs());
+    EXPECT_EQ(0U, dc.getAirtimeMs());
+    EXPECT_TRUE(dc.canSend(600));
+    EXPECT_FALSE(dc.canSend(601));
+    dc.record(500);
+    EXPECT_TRUE(dc.canSend(100));
+    EXPECT_FALSE(dc.canSend(101));
+    // Airtime is forgotten once its period leaves the window.
+    for(uint8_t i = 1; i < OTRadioLink::OTRadioDutyCycle::BUCKETS; ++i) { dc.advance(); EXPECT_EQ(500U, dc.getAirtimeMs()); }
+    dc.record(100);
+    dc.advance();
+    EXPECT_EQ(100U, dc.getAirtimeMs());
+    // Saturates rather than wrapping.
+    dc.record(0xfffffff0UL);
+    dc.record(0x100);
+    EXPECT_EQ(0xffffffffUL, dc.getAirtimeMs());
+    EXPECT_FALSE(dc.canSend(0));
+    dc.clear();
+    EXPECT_EQ(0U, dc.getAirtimeMs());
+
+    // Channel 0 at 5000bps (29ms for a 10-byte frame); channel 1 bitrate unknown.
+    const OTRadioLink::OTRadioChannelConfig configs[2] =
+        {
+        OTRadioLink::OTRadioChannelConfig(NULL, true, true, true, false, false, false, 5000),
+        OTRadioLink::OTRadioChannelConfig(NULL, true)
+        };
+    ORLT::QueueRadioLinkMock rl;
+    ASSERT_TRUE(rl.configure(2, configs));
+    EXPECT_EQ(29U, rl.getFrameAirtimeMs(0, 10));
+    EXPECT_EQ(0U, rl.getFrameAirtimeMs(1, 10));
+    EXPECT_EQ(0U, rl.getFrameAirtimeMs(2, 10));
+    const uint8_t f[10] = { };
+    // With no accountant anything goes.
+    EXPECT_TRUE(rl.canSendNow(0, 10, OTRadioLink::OTRadioLink::TXmax));
+    // Allow 60ms in the window, ie 2 frames.
+    OTRadioLink::OTRadioDutyCycle dc2(10, 1);
+    EXPECT_EQ(60U, dc2.getLimitMs());
+    rl.setDutyCycle(&dc2);
+    EXPECT_TRUE(rl.queueToSend(f, sizeof(f)));
+    EXPECT_EQ(29U, dc2.getAirtimeMs());
+    // A double TX would not fit, but a single one would.
+    EXPECT_FALSE(rl.canSendNow(0, 10, OTRadioLink::OTRadioLink::TXmax));
+    EXPECT_FALSE(rl.queueToSend(f, sizeof(f), 0, OTRadioLink::OTRadioLink::TXmax));
+    EXPECT_TRUE(rl.queueToSend(f, sizeof(f)));
+    EXPECT_FALSE(rl.queueToSend(f, sizeof(f)));
+    EXPECT_EQ(58U, dc2.getAirtimeMs());
+    // Untimed channel is unaffected.
+    EXPECT_TRUE(rl.queueToSend(f, sizeof(f), 1));
+    EXPECT_EQ(58U, dc2.getAirtimeMs());
+    rl.setDutyCycle(NULL);
+    EXPECT_TRUE(rl.queueToSend(f, sizeof(f)));
+}
+
+// Check listen plan dwell, hold on activity, hold timeout and stats.
+TEST(OTRadioLink,listenPlan)
+{
+    const OTRadioLink::OTRadioListenSlot slots[] = { { 0, 100 }, { 1, 50 } };
+    OTRadioLink::OTRadioListenSlotStats stats[2];
+    OTRadioLink::OTRadioListenPlan p(slots, 2, stats, 200);
+    EXPECT_EQ(0, p.restart(1000));
+    EXPECT_EQ(1U, stats[0].visits);
+    // Dwell on each in turn, wrapping round.
+    EXPECT_EQ(0, p.update(1099, false, false));
+    EXPECT_EQ(1, p.update(1100, false, false));
+    EXPECT_EQ(1, p.update(1149, false, false));
+    EXPECT_EQ(0, p.update(1150, false, false));
+    EXPECT_EQ(100U, stats[0].listenMs);
+    EXPECT_EQ(50U, stats[1].listenMs);
+    EXPECT_EQ(2U, stats[0].visits);
+    // Activity holds past the dwell, for at most the hold time, not extended by more activity.
+    EXPECT_EQ(0, p.update(1240, true, false));
+    EXPECT_TRUE(p.isHolding());
+    EXPECT_EQ(0, p.update(1300, false, false));
+    EXPECT_EQ(0, p.update(1400, true, false));
+    EXPECT_EQ(1, p.update(1440, false, false));
+    EXPECT_FALSE(p.isHolding());
+    EXPECT_EQ(1U, stats[0].holds);
+    EXPECT_EQ(1U, stats[0].holdTimeouts);
+    // A frame ends the hold and restarts the dwell.
+    EXPECT_EQ(1, p.update(1460, true, false));
+    EXPECT_EQ(1, p.update(1480, false, true));
+    EXPECT_FALSE(p.isHolding());
+    EXPECT_EQ(1, p.update(1529, false, false));
+    EXPECT_EQ(0, p.update(1530, false, false));
+    EXPECT_EQ(1U, stats[1].frames);
+    EXPECT_EQ(0U, stats[1].holdTimeouts);
+    EXPECT_EQ(140U, stats[1].listenMs);
+    // Time may wrap.
+    EXPECT_EQ(0, p.restart(0xffffffc0UL));
+    EXPECT_EQ(0U, stats[0].listenMs);
+    EXPECT_EQ(0, p.update(0x20, false, false));
+    EXPECT_EQ(1, p.update(0x24, false, false));
+    EXPECT_EQ(NULL, p.getStats(2));
+    // Without stats or hold.
+    OTRadioLink::OTRadioListenPlan q(slots, 2, NULL, 0);
+    q.restart(0);
+    EXPECT_EQ(0, q.update(50, true, false));
+    EXPECT_FALSE(q.isHolding());
+    EXPECT_EQ(1, q.update(100, true, false));
+    EXPECT_EQ(NULL, q.getStats(0));
+}
+
+namespace ORLT
+{
+// Radio recording its listen channel changes.
+class ListenRadioLinkMock final : public OTRadioLink::OTRadioLink
+    {
+    public:
+        uint8_t dolistens = 0;
+        virtual void getCapacity(uint8_t &queueRXMsgsMin, uint8_t &maxRXMsgLen, uint8_t &maxTXMsgLen) const override
+            { queueRXMsgsMin = 0; maxRXMsgLen = 0; maxTXMsgLen = 0; }
+        virtual uint8_t getRXMsgsQueued() const override { return(0); }
+        virtual const volatile uint8_t *peekRXMsg() const override { return(NULL); }
+        virtual void removeRXMsg() override { }
+        virtual bool sendRaw(const uint8_t *, uint8_t, int8_t, TXpower, bool) override { return(true); }
+        // As the driver's poll() would.
+        void pollListenPlan(uint32_t nowMs, bool activity, bool frame) { _pollListenPlan(nowMs, activity, frame); }
+    private:
+        virtual void _dolisten() override { ++dolistens; }
+    };
+}
+
+// Check that a radio follows its listen plan only while listening.
+TEST(OTRadioLink,listenPlanRadio)
+{
+    const OTRadioLink::OTRadioChannelConfig configs[] = { OTRadioLink::OTRadioChannelConfig(NULL, true), OTRadioLink::OTRadioChannelConfig(NULL, true) };
+    const OTRadioLink::OTRadioListenSlot slots[] = { { 1, 30 }, { 0, 20 } };
+    OTRadioLink::OTRadioListenPlan p(slots, 2);
+    ORLT::ListenRadioLinkMock rl;
+    ASSERT_TRUE(rl.configure(2, configs));
+    // Not listening: plan is started but not followed.
+    rl.setListenPlan(&p, 0);
+    EXPECT_EQ(&p, rl.getListenPlan());
+    EXPECT_EQ(-1, rl.getListenChannel());
+    rl.pollListenPlan(5, false, false);
+    EXPECT_EQ(-1, rl.getListenChannel());
+    EXPECT_EQ(0, rl.dolistens);
+    // Listening: corrected to the plan's channel, then hops.
+    rl.listen(true, 0);
+    EXPECT_EQ(1, rl.dolistens);
+    rl.pollListenPlan(10, false, false);
+    EXPECT_EQ(1, rl.getListenChannel());
+    EXPECT_EQ(2, rl.dolistens);
+    rl.pollListenPlan(200, false, false);
+    EXPECT_EQ(0, rl.getListenChannel());
+    EXPECT_EQ(3, rl.dolistens);
+    // Restarting while listening switches at once, reapplying even if unchanged.
+    rl.setListenPlan(&p, 300);
+    EXPECT_EQ(1, rl.getListenChannel());
+    EXPECT_EQ(4, rl.dolistens);
+    rl.setListenPlan(&p, 310);
+    EXPECT_EQ(5, rl.dolistens);
+    // Cleared: stays put.
+    rl.setListenPlan(NULL, 400);
+    EXPECT_EQ(1, rl.getListenChannel());
+    EXPECT_EQ(6, rl.dolistens);
+    rl.pollListenPlan(1000, false, false);
+    EXPECT_EQ(1, rl.getListenChannel());
+    rl.listen(false);
+    EXPECT_EQ(-1, rl.getListenChannel());
+}
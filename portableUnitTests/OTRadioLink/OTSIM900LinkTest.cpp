@@ -76,6 +76,7 @@ struct SIM900Commands {
     static const char * CIPSTATUS;
     static const char * CIPSTART;
     static const char * CIPSEND;
+    static const char * CSCLK;
 };
 const char * SIM900Commands::AT = "AT";
 const char * SIM900Commands::CPIN = "AT+CPIN?";
@@ -86,6 +87,7 @@ const char * SIM900Commands::CIFSR = "AT+CIFSR";
 const char * SIM900Commands::CIPSTATUS = "AT+CIPSTATUS";
 const char * SIM900Commands::CIPSTART = "AT+CIPSTART=\"UDP\",\"0.0.0.0\",\"9999\"";
 const char * SIM900Commands::CIPSEND = "AT+CIPSEND=3";
+const char * SIM900Commands::CSCLK = "AT+CSCLK=2";
 
 struct SIM900Replies {
     static const char * AT;
@@ -107,6 +109,7 @@ struct SIM900Replies {
     static const char * CIPSTART_TRUE;
     static const char * CIPSEND_FALSE; // TODO CHECK
     static const char * CIPSEND_TRUE;
+    static const char * CSCLK_TRUE;
 };
 const char * SIM900Replies::AT = "AT\r\n\r\nOK\r\n";
 const char * SIM900Replies::CPIN_TRUE = "AT+CPIN?\r\n\r\n+CPIN: READY\r\n\r\nOK\r\n";
@@ -127,6 +130,7 @@ const char * SIM900Replies::CIPSTART_FALSE = "AT+CIPSTART=\"UDP\",\"0.0.0.0\",\"
 const char * SIM900Replies::CIPSTART_TRUE = "AT+CIPSTART=\"UDP\",\"0.0.0.0\",\"9999\"\r\n\r\nOK\r\n\r\nCONNECT OK\r\n" ;
 const char * SIM900Replies::CIPSEND_FALSE = "AT+CIPSEND=3\r\n\r\nERROR" ; // TODO CHECK
 const char * SIM900Replies::CIPSEND_TRUE = "AT+CIPSEND=3\r\n\r\n>" ;
+const char * SIM900Replies::CSCLK_TRUE = "AT+CSCLK=2\r\n\r\nOK\r\n" ;
 
 /**
  * @brief   Simple emulator for keeping track of SIM900 state and providing appropriate responses.
@@ -259,6 +263,8 @@ public:
      * @note    APN must be set to "apn" with no quotes to be accepted.
      */
     void poll(std::string const &command, std::string &reply) {
+        // A command sent while asleep just wakes the SIM900 and is lost.
+        if (asleep) { asleep = false; return; }
         // Respond to particular commands when not powered down...
         switch (myState) {
         case POWER_OFF: break;  // do nothing
@@ -351,6 +357,7 @@ public:
             else if(commands.CIPSTATUS == command) { reply.append(replies.CIPSTATUS_CONNECTED); }
             else if(commands.CIPSTART == command) { reply.append(replies.CIPSTART_FALSE); }
             else if(commands.CIPSEND == command) { reply.append(replies.CIPSEND_TRUE); }
+            else if(commands.CSCLK == command) { reply.append(replies.CSCLK_TRUE); }
             else if("123" == command) { reply = "123\r\nSEND OK\r\n"; }  // todo this must depend on the cipsend being asked.
             break;
         case UDP_CLOSING:
@@ -406,6 +413,9 @@ public:
     // This triggers a fail state where the SIM900 carries on responding normally.
     void triggerInvisibleFail() { myState = INVISIBLE_FAIL; }
 
+    // True when in (serial-idle) sleep; set by the test.
+    bool asleep = false;
+
     // emulate pin toggle:
     bool oldPinState;
     uint_fast8_t startTime;
@@ -415,7 +425,7 @@ public:
     /**
      * @brief   Set all state back to defaults.
      */
-    void reset() { myState = POWER_OFF; verbose = false; oldPinState = false, startTime = 0; }
+    void reset() { myState = POWER_OFF; verbose = false; asleep = false; oldPinState = false, startTime = 0; }
 
 
     /**
@@ -1305,3 +1315,250 @@ TEST(OTSIM900Link, PDPDeactResetTest)
         l0.end();
 }
 
+
+// Check that the incremental response matcher finds terminators split across feeds,
+// and keeps only what fits in its buffer.
+TEST(OTSIM900Link, ResponseMatcherTest)
+{
+    OTSIM900Link::SIM900ResponseMatcher<8> m;
+    m.start("OK");
+    EXPECT_EQ(0, m.size());
+    const char *const r1 = "AT\r\n\r\nO";
+    for(const char *p = r1; '\0' != *p; ++p) { EXPECT_FALSE(m.feed(*p)); }
+    EXPECT_FALSE(m.isFound());
+    EXPECT_TRUE(m.feed('K'));
+    EXPECT_TRUE(m.isFound());
+    EXPECT_EQ(8, m.size());
+    EXPECT_EQ('A', m.data()[0]);
+    EXPECT_EQ('K', m.data()[7]);
+    // Excess chars are discarded but do not unset the match.
+    EXPECT_TRUE(m.feed('x'));
+    EXPECT_EQ(8, m.size());
+    // A partial match that fails must be able to restart.
+    m.start("OK");
+    EXPECT_EQ('\0', m.data()[0]);
+    EXPECT_FALSE(m.feed('O'));
+    EXPECT_FALSE(m.feed('O'));
+    EXPECT_TRUE(m.feed('K'));
+    // Terminator beyond the end of the buffer is still found.
+    m.start(">");
+    for(int i = 0; i < 20; ++i) { EXPECT_FALSE(m.feed('a')); }
+    EXPECT_TRUE(m.feed('>'));
+    // With no terminator nothing ever matches.
+    m.start(NULL);
+    EXPECT_FALSE(m.feed('O'));
+    EXPECT_FALSE(m.feed('K'));
+    EXPECT_EQ(2, m.size());
+    EXPECT_EQ(8, m.capacity());
+}
+
+// Check that the response matcher spots every token, including after partial overlapping matches,
+// completes on its done tokens, and parses the numeric fields after a field token.
+TEST(OTSIM900Link, ResponseTokensTest)
+{
+    namespace T = OTSIM900Link::SIM900Token;
+    // KMP-style fallback keeps the overlapping prefix.
+    EXPECT_EQ(2, T::step("SEND OK", T::step("SEND OK", 0, 'S'), 'E'));
+    EXPECT_EQ(2, T::step("aab", 2, 'a'));
+    EXPECT_EQ(3, T::step("aab", 2, 'b'));
+    OTSIM900Link::SIM900ResponseMatcher<16> m;
+    m.start(NULL, T::OK | T::ERROR);
+    const char *const r1 = "AT+CREG?\r\n\r\n+CREG: 0,5\r\n\r\nO";
+    for(const char *p = r1; '\0' != *p; ++p) { EXPECT_FALSE(m.feed(*p)); }
+    EXPECT_TRUE(m.hasSeen(T::CREG));
+    EXPECT_FALSE(m.hasSeen(T::OK));
+    EXPECT_EQ(2, m.fieldCount());
+    EXPECT_EQ(0, m.field(0));
+    EXPECT_EQ(5, m.field(1));
+    EXPECT_EQ(0, m.field(2));
+    EXPECT_TRUE(m.feed('K'));
+    EXPECT_TRUE(m.hasSeen(T::OK));
+    EXPECT_FALSE(m.hasSeen(T::ERROR | T::PROMPT));
+    // Tokens not in the done set are noted but do not complete the response.
+    m.start(NULL, T::PROMPT);
+    const char *const r2 = "AT+CSQ\r\n+CSQ: 17,0\r\nSSEND OK\r\nOK>";
+    for(const char *p = r2; '>' != *p; ++p) { EXPECT_FALSE(m.feed(*p)); }
+    EXPECT_TRUE(m.hasSeen(T::CSQ | T::OK));
+    EXPECT_TRUE(m.hasSeen(T::SEND_OK));
+    EXPECT_EQ(2, m.fieldCount());
+    EXPECT_EQ(17, m.field(0));
+    EXPECT_TRUE(m.feed('>'));
+    // Oversized numbers saturate, and a malformed field list stops parsing.
+    m.start(NULL);
+    const char *const r3 = "+CSQ: 999,,1";
+    for(const char *p = r3; '\0' != *p; ++p) { m.feed(*p); }
+    EXPECT_EQ(1, m.fieldCount());
+    EXPECT_EQ(255, m.field(0));
+    EXPECT_FALSE(m.isFound());
+}
+
+namespace B3 {
+// Count of (valid) send requests seen by the emulator.
+// The emulator ignores a request that immediately follows a frame's payload
+// (as the payload is not newline-terminated) and so OTSIM900Link retries it.
+static int sendsSeen;
+static void countingWriteCallback()
+{
+    const std::string &w = SIM900Emu::serialConnection.written;
+    if(!w.empty() && ('\n' == w.back()) && (0 == w.compare(0, 11, "AT+CIPSEND="))) { ++sendsSeen; }
+    SIM900Emu::sim900.poll();
+}
+}
+// Check that frames queued while the link is still coming up are kept (up to the queue depth)
+// and are all sent once the UDP connection is open.
+TEST(OTSIM900Link, TXQueueWhileStartingTest)
+{
+    srandom((unsigned)::testing::UnitTest::GetInstance()->random_seed()); // Seed random() for use in simulator; --gtest_shuffle will force it to change.
+
+    // Clear out any old state.
+    SIM900Emu::serialConnection.reset();
+    SIM900Emu::serialConnection.writeCallback = B3::countingWriteCallback;
+    SIM900Emu::sim900.reset();
+    SIM900Emu::sim900.emu.myState = SIM900Emu::SIM900StateEmulator::POWERING_UP; // Start from here to simplify startup process.
+    B3::sendsSeen = 0;
+
+    const char message[] = "123";
+    const char SIM900_PIN[] = "1111";
+    const char SIM900_APN[] = "apn";
+    const char SIM900_UDP_ADDR[] = "0.0.0.0"; // ORS server
+    const char SIM900_UDP_PORT[] = "9999";
+    const OTSIM900Link::OTSIM900LinkConfig_t SIM900Config(false, SIM900_PIN, SIM900_APN, SIM900_UDP_ADDR, SIM900_UDP_PORT);
+    const OTRadioLink::OTRadioChannelConfig l0Config(&SIM900Config, true);
+    OTSIM900Link::OTSIM900Link<0, 0, 0, SIM900Emu::getSecondsVT, SIM900Emu::SoftSerialSimulator, 3> l0;
+    EXPECT_TRUE(l0.configure(1, &l0Config));
+    EXPECT_TRUE(l0.begin());
+
+    // Bad frames are rejected.
+    EXPECT_FALSE(l0.queueToSend(NULL, 1));
+    EXPECT_FALSE(l0.queueToSend((const uint8_t *)message, 0));
+    // Queue more frames than fit.
+    for(int i = 0; i < 4; ++i) { EXPECT_TRUE(l0.queueToSend((const uint8_t *)message, (uint8_t)sizeof(message)-1)); }
+    EXPECT_EQ(3, l0.getTXMsgsQueued());
+
+    // Frames survive start-up and are all sent back-to-back.
+    for(int i = 0; i < 200; ++i) {
+        SIM900Emu::vt.incrementVTOneCycle();
+        l0.poll();
+        if((OTSIM900Link::IDLE == l0._getState()) && (0 == l0.getTXMsgsQueued())) break;
+    }
+    EXPECT_EQ(OTSIM900Link::IDLE, l0._getState());
+    EXPECT_EQ(0, l0.getTXMsgsQueued());
+    EXPECT_EQ(3, B3::sendsSeen);
+    l0.end();
+}
+
+// Check that a frame queued when the SIM900 has to be reset is kept,
+// and is sent once it has re-registered and reopened the UDP connection.
+TEST(OTSIM900Link, TXQueueKeptAcrossResetTest)
+{
+    srandom((unsigned)::testing::UnitTest::GetInstance()->random_seed()); // Seed random() for use in simulator; --gtest_shuffle will force it to change.
+
+    // Clear out any old state.
+    SIM900Emu::serialConnection.reset();
+    SIM900Emu::serialConnection.writeCallback = B3::countingWriteCallback;
+    SIM900Emu::sim900.reset();
+    SIM900Emu::sim900.emu.myState = SIM900Emu::SIM900StateEmulator::POWERING_UP; // Start from here to simplify startup process.
+    B3::sendsSeen = 0;
+
+    const char message[] = "123";
+    const char SIM900_PIN[] = "1111";
+    const char SIM900_APN[] = "apn";
+    const char SIM900_UDP_ADDR[] = "0.0.0.0"; // ORS server
+    const char SIM900_UDP_PORT[] = "9999";
+    const OTSIM900Link::OTSIM900LinkConfig_t SIM900Config(false, SIM900_PIN, SIM900_APN, SIM900_UDP_ADDR, SIM900_UDP_PORT);
+    const OTRadioLink::OTRadioChannelConfig l0Config(&SIM900Config, true);
+    OTSIM900Link::OTSIM900Link<0, 0, 0, SIM900Emu::getSecondsVT, SIM900Emu::SoftSerialSimulator> l0;
+    EXPECT_TRUE(l0.configure(1, &l0Config));
+    EXPECT_TRUE(l0.begin());
+
+    // Get to IDLE state.
+    for(int i = 0; i < 100; ++i) { l0.poll(); SIM900Emu::vt.incrementVTOneCycle(); if(l0._getState() == OTSIM900Link::IDLE) break;}
+    EXPECT_EQ(OTSIM900Link::IDLE, l0._getState());
+
+    // The connection dies, so the attempt to send the frame forces a reset.
+    SIM900Emu::sim900.triggerPDPDeactFail();
+    EXPECT_TRUE(l0.queueToSend((const uint8_t *)message, (uint8_t)sizeof(message)-1));
+    for(int i = 0; i < 100; ++i) {
+        SIM900Emu::vt.incrementVTOneCycle();
+        l0.poll();
+        if(OTSIM900Link::IDLE > l0._getState()) break;
+    }
+    EXPECT_GT(OTSIM900Link::IDLE, l0._getState());
+    EXPECT_EQ(1, l0.getTXMsgsQueued());
+    EXPECT_EQ(0, B3::sendsSeen);
+
+    // The power cycle brings the SIM900 back, and the frame goes once connected again.
+    SIM900Emu::sim900.emu.myState = SIM900Emu::SIM900StateEmulator::POWERING_UP;
+    for(int i = 0; i < 200; ++i) {
+        SIM900Emu::vt.incrementVTOneCycle();
+        l0.poll();
+        if((OTSIM900Link::IDLE == l0._getState()) && (0 == l0.getTXMsgsQueued())) break;
+    }
+    EXPECT_EQ(OTSIM900Link::IDLE, l0._getState());
+    EXPECT_EQ(0, l0.getTXMsgsQueued());
+    EXPECT_EQ(1, B3::sendsSeen);
+    l0.end();
+}
+
+// Check that in connected sleep a frame is sent with just a wake and AT+CIPSEND,
+// and that a connection dropped during sleep is found and reopened without re-registering.
+TEST(OTSIM900Link, ConnectedSleepTest)
+{
+    srandom((unsigned)::testing::UnitTest::GetInstance()->random_seed()); // Seed random() for use in simulator; --gtest_shuffle will force it to change.
+
+    // Clear out any old state.
+    SIM900Emu::serialConnection.reset();
+    SIM900Emu::serialConnection.writeCallback = B3::countingWriteCallback;
+    SIM900Emu::sim900.reset();
+    SIM900Emu::sim900.emu.myState = SIM900Emu::SIM900StateEmulator::POWERING_UP; // Start from here to simplify startup process.
+    B3::sendsSeen = 0;
+
+    const char message[] = "123";
+    const char SIM900_PIN[] = "1111";
+    const char SIM900_APN[] = "apn";
+    const char SIM900_UDP_ADDR[] = "0.0.0.0"; // ORS server
+    const char SIM900_UDP_PORT[] = "9999";
+    const OTSIM900Link::OTSIM900LinkConfig_t SIM900Config(false, SIM900_PIN, SIM900_APN, SIM900_UDP_ADDR, SIM900_UDP_PORT);
+    const OTRadioLink::OTRadioChannelConfig l0Config(&SIM900Config, true);
+    OTSIM900Link::OTSIM900Link<0, 0, 0, SIM900Emu::getSecondsVT, SIM900Emu::SoftSerialSimulator> l0;
+    EXPECT_TRUE(l0.configure(1, &l0Config));
+    l0.setConnectedSleep(true);
+    EXPECT_TRUE(l0.begin());
+    EXPECT_FALSE(l0.isInConnectedSleep());
+
+    // Get to IDLE state, having enabled sleep.
+    for(int i = 0; i < 100; ++i) { l0.poll(); SIM900Emu::vt.incrementVTOneCycle(); if(l0._getState() == OTSIM900Link::IDLE) break;}
+    EXPECT_EQ(OTSIM900Link::IDLE, l0._getState());
+    EXPECT_TRUE(l0.isInConnectedSleep());
+    EXPECT_EQ(SIM900Emu::SIM900StateEmulator::UDP_CONNECT_OK,  SIM900Emu::sim900.emu.myState);
+
+    // Send while asleep: the wake is lost but the frame goes, without leaving the connected states.
+    SIM900Emu::sim900.emu.asleep = true;
+    EXPECT_TRUE(l0.queueToSend((const uint8_t *)message, (uint8_t)sizeof(message)-1));
+    for(int i = 0; i < 50; ++i) {
+        SIM900Emu::vt.incrementVTOneCycle();
+        l0.poll();
+        EXPECT_LE(OTSIM900Link::IDLE, l0._getState());
+        if((OTSIM900Link::IDLE == l0._getState()) && (0 == l0.getTXMsgsQueued())) break;
+    }
+    EXPECT_EQ(0, l0.getTXMsgsQueued());
+    EXPECT_EQ(1, B3::sendsSeen);
+    EXPECT_FALSE(SIM900Emu::sim900.emu.asleep);
+    EXPECT_TRUE(l0.isInConnectedSleep());
+
+    // The network drops the socket; the periodic check reopens it.
+    SIM900Emu::sim900.emu.myState = SIM900Emu::SIM900StateEmulator::IP_GPRSACT;
+    bool reopened = false;
+    for(int i = 0; i < 400; ++i) {
+        SIM900Emu::vt.incrementVTOneCycle();
+        l0.poll();
+        EXPECT_LE(OTSIM900Link::START_GPRS, l0._getState());
+        if(OTSIM900Link::OPEN_UDP == l0._getState()) { reopened = true; }
+        if(reopened && (OTSIM900Link::IDLE == l0._getState())) break;
+    }
+    EXPECT_TRUE(reopened);
+    EXPECT_EQ(OTSIM900Link::IDLE, l0._getState());
+    EXPECT_TRUE(l0.isInConnectedSleep());
+    EXPECT_EQ(SIM900Emu::SIM900StateEmulator::UDP_CONNECT_OK,  SIM900Emu::sim900.emu.myState);
+    l0.end();
+}
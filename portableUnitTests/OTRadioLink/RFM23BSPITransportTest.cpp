@@ -0,0 +1,152 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Tests of the RFM23B register protocol over the SPI transport abstraction.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+
+#include <OTRFM23BLink.h>
+
+namespace RFMSPIT
+{
+// Minimal RFM23B on the end of an SPI link: a register file and a FIFO.
+// Optionally holds bursts started with startBurst() until complete() is called,
+// as a DMA transport would.
+class MockRFM23B final : public OTRFM23BLink::RFM23BSPITransport
+    {
+    public:
+        uint8_t regs[128];
+        uint8_t fifo[64];
+        uint8_t fifoRead = 0, fifoWritten = 0;
+        bool selected = false;
+        int selects = 0;
+        bool holdAsync = false;
+
+        MockRFM23B() { memset(regs, 0, sizeof(regs)); memset(fifo, 0, sizeof(fifo)); }
+
+        virtual void select() override { EXPECT_FALSE(selected); selected = true; ++selects; first = true; }
+        virtual void deselect() override { EXPECT_TRUE(selected); selected = false; }
+        virtual uint8_t io(const uint8_t data) override
+            {
+            EXPECT_TRUE(selected);
+            if(first) { first = false; addr = data & 0x7f; write = (0 != (data & 0x80)); return(0); }
+            uint8_t r = 0;
+            if(0x7f == addr) { if(write) { fifo[fifoWritten++ & 63] = data; } else { r = fifo[fifoRead++ & 63]; } }
+            else { if(write) { regs[addr] = data; } else { r = regs[addr]; } addr = (addr + 1) & 0x7f; }
+            return(r);
+            }
+        virtual bool startBurst(const uint8_t *const tx, uint8_t *const rx, const uint8_t n,
+                                burstDone_fn_t *const done, void *const ctx) override
+            {
+            if(!holdAsync) { return(RFM23BSPITransport::startBurst(tx, rx, n, done, ctx)); }
+            if(busy) { return(false); }
+            busy = true; ptx = tx; prx = rx; pn = n; pdone = done; pctx = ctx;
+            return(true);
+            }
+        virtual bool isBusy() const override { return(busy); }
+        // Finish a held burst, as from the DMA ISR.
+        void complete()
+            {
+            ASSERT_TRUE(busy);
+            burst(ptx, prx, pn);
+            busy = false;
+            deselect();
+            if(NULL != pdone) { pdone(pctx); }
+            }
+
+    private:
+        bool first = false, write = false;
+        uint8_t addr = 0;
+        bool busy = false;
+        const uint8_t *ptx = NULL;
+        uint8_t *prx = NULL;
+        uint8_t pn = 0;
+        burstDone_fn_t *pdone = NULL;
+        void *pctx = NULL;
+    };
+
+void countDone(void *const ctx) { ++*static_cast<int *>(ctx); }
+}
+
+// Register and burst access use one select cycle each, auto-incrementing except for the FIFO.
+TEST(RFM23BSPITransport, Registers)
+{
+    RFMSPIT::MockRFM23B m;
+    OTRFM23BLink::RFM23BRegisters r(m);
+    m.regs[0] = 0x08;
+    m.regs[1] = 0x06;
+    EXPECT_EQ(0x08, r.read8(0));
+    EXPECT_EQ(0x0806, r.read16(0));
+    r.write8(0x6d, 0x0b);
+    EXPECT_EQ(0x0b, m.regs[0x6d]);
+    // Address top bit is forced for reads and writes.
+    EXPECT_EQ(0x0b, r.read8(0xed));
+    const uint8_t hdr[4] = { 1, 2, 3, 4 };
+    r.writeBurst(0x3a, hdr, sizeof(hdr));
+    EXPECT_EQ(0, memcmp(m.regs + 0x3a, hdr, sizeof(hdr)));
+    uint8_t b[4];
+    r.readBurst(0x3a, b, sizeof(b));
+    EXPECT_EQ(0, memcmp(b, hdr, sizeof(hdr)));
+    EXPECT_EQ(6, m.selects);
+    EXPECT_FALSE(m.selected);
+    // FIFO bursts do not increment the address.
+    r.writeBurst(OTRFM23BLink::RFM23BRegisters::REG_FIFO, hdr, sizeof(hdr));
+    EXPECT_EQ(4, m.fifoWritten);
+    EXPECT_EQ(0, m.regs[0x7f]);
+    r.readBurst(OTRFM23BLink::RFM23BRegisters::REG_FIFO, b, 2);
+    EXPECT_EQ(1, b[0]);
+    EXPECT_EQ(2, b[1]);
+}
+
+// Async FIFO bursts signal completion once deselected; a synchronous transport completes at once.
+TEST(RFM23BSPITransport, AsyncFIFO)
+{
+    RFMSPIT::MockRFM23B m;
+    OTRFM23BLink::RFM23BRegisters r(m);
+    for(uint8_t i = 0; i < 64; ++i) { m.fifo[i] = uint8_t(i + 100); }
+    int done = 0;
+    uint8_t buf[64];
+    EXPECT_TRUE(r.startReadFIFO(buf, 10, RFMSPIT::countDone, &done));
+    EXPECT_EQ(1, done);
+    EXPECT_FALSE(m.selected);
+    EXPECT_EQ(100, buf[0]);
+    EXPECT_EQ(109, buf[9]);
+    // Held as if by DMA.
+    m.holdAsync = true;
+    EXPECT_TRUE(r.startReadFIFO(buf, 54, RFMSPIT::countDone, &done));
+    EXPECT_TRUE(r.isBusy());
+    EXPECT_TRUE(m.selected);
+    EXPECT_EQ(1, done);
+    EXPECT_FALSE(r.startWriteFIFO(buf, 1, RFMSPIT::countDone, &done));
+    m.complete();
+    EXPECT_FALSE(r.isBusy());
+    EXPECT_FALSE(m.selected);
+    EXPECT_EQ(2, done);
+    EXPECT_EQ(110, buf[0]);
+    EXPECT_EQ(163, buf[53]);
+    // Write, with no callback.
+    EXPECT_TRUE(r.startWriteFIFO(buf, 3, NULL, NULL));
+    m.complete();
+    EXPECT_EQ(3, m.fifoWritten);
+    EXPECT_EQ(110, m.fifo[0]);
+    EXPECT_EQ(2, done);
+}
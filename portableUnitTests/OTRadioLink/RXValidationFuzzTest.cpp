@@ -0,0 +1,96 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+
+/*
+ * Driver for the RX validation fuzz targets in portableFuzz/,
+ * run over a deterministic generated corpus with exactly-sized inputs
+ * so that their invariants are checked on every build,
+ * plus regressions for inputs the fuzzers found.
+ */
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "RXValidationFuzz.h"
+
+namespace {
+// Run target over each input as an exactly-sized heap copy; returns the number accepted.
+size_t runAll(bool (*const target)(const uint8_t *, size_t), const std::vector<std::vector<uint8_t>> &in)
+    {
+    size_t accepted = 0;
+    for(const auto &v : in)
+        {
+        std::unique_ptr<uint8_t[]> copy(new uint8_t[v.size() + 1]);
+        std::copy(v.begin(), v.end(), copy.get());
+        if(target(copy.get(), v.size())) { ++accepted; }
+        }
+    return(accepted);
+    }
+}
+
+// Every valid header is accepted, and malformed headers never break the invariants.
+TEST(RXValidationFuzz,decodeHeader)
+{
+    const OTFZ::Corpus c = OTFZ::makeHeaderCorpus(2000);
+    EXPECT_EQ(c.valid.size(), runAll(OTFZ::fuzzDecodeHeader, c.valid));
+    EXPECT_GT(c.random.size() / 10, runAll(OTFZ::fuzzDecodeHeader, c.random));
+    runAll(OTFZ::fuzzDecodeHeader, c.mutated);
+    runAll(OTFZ::fuzzDecodeHeader, c.truncated);
+    EXPECT_FALSE(c.worstCase.empty());
+    EXPECT_EQ(0U, runAll(OTFZ::fuzzDecodeHeader, c.worstCase));
+}
+
+TEST(RXValidationFuzz,checkJSONMsgRXCRC)
+{
+    const OTFZ::Corpus c = OTFZ::makeJSONRXCorpus(2000);
+    EXPECT_EQ(c.valid.size(), runAll(OTFZ::fuzzCheckJSONMsgRXCRC, c.valid));
+    EXPECT_EQ(0U, runAll(OTFZ::fuzzCheckJSONMsgRXCRC, c.random));
+    runAll(OTFZ::fuzzCheckJSONMsgRXCRC, c.mutated);
+    runAll(OTFZ::fuzzCheckJSONMsgRXCRC, c.truncated);
+    EXPECT_EQ(0U, runAll(OTFZ::fuzzCheckJSONMsgRXCRC, c.worstCase));
+}
+
+TEST(RXValidationFuzz,quickValidateRawSimpleJSONMessage)
+{
+    const OTFZ::Corpus c = OTFZ::makeJSONRawCorpus(2000);
+    EXPECT_EQ(c.valid.size(), runAll(OTFZ::fuzzQuickValidateRawSimpleJSONMessage, c.valid));
+    EXPECT_EQ(0U, runAll(OTFZ::fuzzQuickValidateRawSimpleJSONMessage, c.random));
+    runAll(OTFZ::fuzzQuickValidateRawSimpleJSONMessage, c.mutated);
+    EXPECT_EQ(0U, runAll(OTFZ::fuzzQuickValidateRawSimpleJSONMessage, c.truncated));
+    EXPECT_EQ(0U, runAll(OTFZ::fuzzQuickValidateRawSimpleJSONMessage, c.worstCase));
+}
+
+// checkJSONMsgRXCRC() used to read the byte after a terminating '}' at the end of the buffer:
+// with a '\0' just beyond bufLen the message was wrongly accepted as raw JSON.
+TEST(RXValidationFuzz,checkJSONMsgRXCRCBufferEnd)
+{
+    const uint8_t buf[] = { '{', '"', 'a', '"', ':', '1', '}', '\0' };
+    EXPECT_EQ(7, OTV0P2BASE::checkJSONMsgRXCRC(buf, sizeof(buf)));
+    EXPECT_EQ(-1, OTV0P2BASE::checkJSONMsgRXCRC(buf, sizeof(buf) - 1));
+    // Likewise for the CRC byte after '}'|0x80.
+    uint8_t crcbuf[] = { '{', '"', 'a', '"', ':', '1', '}', 0 };
+    char tx[sizeof(crcbuf)];
+    memcpy(tx, crcbuf, sizeof(tx));
+    const uint8_t crc = OTV0P2BASE::adjustJSONMsgForTXAndComputeCRC(tx);
+    memcpy(crcbuf, tx, sizeof(crcbuf));
+    crcbuf[7] = crc;
+    EXPECT_EQ(7, OTV0P2BASE::checkJSONMsgRXCRC(crcbuf, sizeof(crcbuf)));
+    EXPECT_EQ(-1, OTV0P2BASE::checkJSONMsgRXCRC(crcbuf, sizeof(crcbuf) - 1));
+    // An empty buffer is not read at all.
+    EXPECT_EQ(-1, OTV0P2BASE::checkJSONMsgRXCRC(buf, 0));
+}
@@ -0,0 +1,396 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Discrete-event simulation of a shared radio channel between many nodes.
+ *
+ * Each SimRadioNode is an OTRadioLink whose sendRaw() puts the frame on air
+ * in a RadioMedium for its airtime at the channel bitrate.
+ * When a frame's airtime ends it is delivered into the ISRRXQueue
+ * of each node listening on that channel, as a driver's RX ISR would,
+ * unless for that receiver:
+ *   - it was itself transmitting during the frame (half duplex),
+ *   - the signal after log-distance path loss is below sensitivity,
+ *   - or other overlapping frames leave it less than the capture margin
+ *     above the total interference (so a much stronger frame can survive).
+ *
+ * Time is simulated in microseconds and only moves in advanceTo(),
+ * so results are exactly reproducible.
+ * simulateStarTraffic() measures the delivered-frame rate at a hub
+ * for a number of periodically-transmitting nodes,
+ * to evaluate TX scheduling or backoff changes.
+ *
+ * Not thread-safe.
+ */
+
+#ifndef PUT_OTRADIOLINK_RADIOMEDIUMSIMULATION_H
+#define PUT_OTRADIOLINK_RADIOMEDIUMSIMULATION_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <OTRadioLink.h>
+#include "OTRadioLink_ISRRXQueue.h"
+
+namespace RMSim
+{
+
+// Largest frame, as for OTRadioLinkMock.
+static constexpr uint8_t maxFrameBytes = 64;
+
+// Channel and propagation parameters.
+struct MediumParams_t
+    {
+    // Over-the-air bit rate in bits/s, eg as for the RFM23B GFSK configuration.
+    uint32_t bitrate = 49260;
+    // Bytes sent per frame beyond its buffer, eg preamble, sync and CRC.
+    uint8_t overheadBytes = OTRadioLink::OTRadioDutyCycle::DEFAULT_OVERHEAD_BYTES;
+    // Log-distance path loss: refLossDB at 1m, rising 10*pathLossExponent dB per decade.
+    double refLossDB = 40.0;
+    double pathLossExponent = 3.0;
+    // Weakest receivable signal.
+    double sensitivityDBm = -100.0;
+    // Margin by which a frame must exceed the total interference to be captured.
+    double captureDB = 6.0;
+    // Radiated power for each OTRadioLink::TXpower value, TXmin to TXmax.
+    double txPowerDBm[5] = { -8.0, 0.0, 7.0, 10.0, 13.0 };
+    };
+
+// Per-(frame, listening receiver) outcomes.
+struct MediumStats_t
+    {
+    uint64_t txFrames = 0;
+    uint64_t delivered = 0;
+    uint64_t lostHalfDuplex = 0;
+    uint64_t lostWeak = 0;
+    uint64_t lostCollision = 0;
+    uint64_t lostQueueFull = 0;
+    uint64_t lostFiltered = 0;
+    };
+
+class SimRadioNode;
+
+class RadioMedium final
+    {
+    private:
+        struct Tx
+            {
+            SimRadioNode *from;
+            uint64_t startUs;
+            uint64_t endUs;
+            int8_t channel;
+            double dBm;
+            uint8_t len;
+            uint8_t buf[maxFrameBytes];
+            bool done;
+            };
+
+        const MediumParams_t p;
+        std::vector<SimRadioNode *> nodes;
+        // Frames on air, plus finished ones that may still overlap those on air.
+        std::vector<Tx> txs;
+        uint64_t nowUs = 0;
+        MediumStats_t stats;
+
+        static bool overlaps(const Tx &a, const Tx &b) { return((a.startUs < b.endUs) && (b.startUs < a.endUs)); }
+
+        inline double rxDBm(const Tx &t, const SimRadioNode &to) const;
+        inline void resolve(size_t i);
+
+        // Forget finished frames that cannot overlap any frame still on air.
+        void prune()
+            {
+            uint64_t oldestStart = nowUs;
+            for(const Tx &t : txs) { if(!t.done && (t.startUs < oldestStart)) { oldestStart = t.startUs; } }
+            size_t k = 0;
+            for(size_t i = 0; i < txs.size(); ++i) { if(!txs[i].done || (txs[i].endUs > oldestStart)) { txs[k++] = txs[i]; } }
+            txs.resize(k);
+            }
+
+    public:
+        explicit RadioMedium(const MediumParams_t &p_ = MediumParams_t()) : p(p_) { }
+
+        const MediumParams_t &params() const { return(p); }
+        const MediumStats_t &getStats() const { return(stats); }
+        uint64_t now() const { return(nowUs); }
+        // Airtime of a frame of len bytes.
+        uint64_t airtimeUs(const uint8_t len) const
+            { return(((uint64_t(len) + p.overheadBytes) * 8000000ULL + p.bitrate - 1) / p.bitrate); }
+        // Path loss over d metres.
+        double pathLossDB(const double d) const
+            { return(p.refLossDB + (10.0 * p.pathLossExponent * std::log10((d < 1.0) ? 1.0 : d))); }
+
+        // Called by SimRadioNode.
+        void add(SimRadioNode *const n) { nodes.push_back(n); }
+
+        // True while from has a frame on air.
+        bool isTransmitting(const SimRadioNode &from) const
+            {
+            for(const Tx &t : txs) { if(!t.done && (&from == t.from)) { return(true); } }
+            return(false);
+            }
+
+        // Put a frame on air from now; returns false if from is already transmitting.
+        bool transmit(SimRadioNode &from, const uint8_t *const buf, const uint8_t len, const int8_t channel,
+                      const OTRadioLink::OTRadioLink::TXpower power)
+            {
+            if((0 == len) || (len > maxFrameBytes) || isTransmitting(from)) { return(false); }
+            Tx t;
+            t.from = &from;
+            t.startUs = nowUs;
+            t.endUs = nowUs + airtimeUs(len);
+            t.channel = channel;
+            t.dBm = p.txPowerDBm[(power > 4) ? 4 : power];
+            t.len = len;
+            memcpy(t.buf, buf, len);
+            t.done = false;
+            txs.push_back(t);
+            ++stats.txFrames;
+            return(true);
+            }
+
+        // True if a frame on channel is on air and receivable at node, eg for carrier-sense backoff.
+        inline bool carrierSense(const SimRadioNode &at, int8_t channel) const;
+
+        // Run time forward to tUs, delivering each frame as its airtime ends.
+        void advanceTo(const uint64_t tUs)
+            {
+            for( ; ; )
+                {
+                size_t next = txs.size();
+                for(size_t i = 0; i < txs.size(); ++i)
+                    {
+                    if(txs[i].done || (txs[i].endUs > tUs)) { continue; }
+                    if((txs.size() == next) || (txs[i].endUs < txs[next].endUs)) { next = i; }
+                    }
+                if(txs.size() == next) { break; }
+                nowUs = txs[next].endUs;
+                resolve(next);
+                }
+            if(tUs > nowUs) { nowUs = tUs; }
+            prune();
+            }
+    };
+
+// Radio for one simulated node at (x, y) metres, on one channel at the medium bitrate.
+// TXmax is sent once, as a louder frame.
+class SimRadioNode final : public OTRadioLink::OTRadioLink
+    {
+    private:
+        RadioMedium &medium;
+        const double x, y;
+        const ::OTRadioLink::OTRadioChannelConfig_t config;
+        ::OTRadioLink::ISRRXQueueVarLenMsg<maxFrameBytes, 4> queueRX;
+
+        virtual void _dolisten() override { }
+
+    public:
+        enum RXResult : uint8_t { QUEUED, DROPPED, FILTERED };
+
+        SimRadioNode(RadioMedium &medium_, const double x_, const double y_)
+          : medium(medium_), x(x_), y(y_), config(NULL, true, true, true, false, false, false, medium_.params().bitrate)
+            {
+            configure(1, &config);
+            medium.add(this);
+            }
+
+        double getX() const { return(x); }
+        double getY() const { return(y); }
+        double distanceTo(const SimRadioNode &o) const { return(std::hypot(x - o.x, y - o.y)); }
+
+        virtual bool begin() override { return(true); }
+        virtual void getCapacity(uint8_t &queueRXMsgsMin, uint8_t &maxRXMsgLen, uint8_t &maxTXMsgLen) const override
+            {
+            queueRX.getRXCapacity(queueRXMsgsMin, maxRXMsgLen);
+            maxTXMsgLen = maxFrameBytes;
+            }
+        virtual uint8_t getRXMsgsQueued() const override { return(queueRX.getRXMsgsQueued()); }
+        virtual const volatile uint8_t *peekRXMsg() const override { return(queueRX.peekRXMsg()); }
+        virtual void removeRXMsg() override { queueRX.removeRXMsg(); }
+
+        // Starts the frame on air and returns at once; false if still sending the previous frame.
+        virtual bool sendRaw(const uint8_t *const buf, const uint8_t buflen, const int8_t channel = 0,
+                             const TXpower power = TXnormal, const bool /*listenAfter*/ = false) override
+            {
+            _statsTXAttempt(channel);
+            if(!medium.transmit(*this, buf, buflen, channel, power)) { return(false); }
+            _recordTX(channel, buflen);
+            return(true);
+            }
+
+        // True if the channel being listened on (else channel 0) is busy here.
+        bool channelBusy() const
+            { const int8_t c = getListenChannel(); return(medium.carrierSense(*this, (c < 0) ? 0 : c)); }
+
+        // Called by RadioMedium for a received frame, as the RX ISR of a driver.
+        RXResult _deliver(const uint8_t *const buf, const uint8_t len, const uint8_t rssi)
+            {
+            volatile uint8_t *const b = queueRX._getRXBufForInbound();
+            const int8_t lc = getListenChannel();
+            if(NULL == b) { ++droppedRXedMessageCountRecent; _statsRXDropped(lc); return(DROPPED); }
+            for(uint8_t i = 0; i < len; ++i) { b[i] = buf[i]; }
+            volatile uint8_t l = len;
+            quickFrameFilter_t *const f = filterRXISR;
+            if((NULL != f) && !f(b, l))
+                {
+                ++filteredRXedMessageCountRecent;
+                _statsRXFiltered(lc);
+                queueRX._loadedBuf(0);
+                return(FILTERED);
+                }
+            queueRX._loadedBuf(l);
+            _statsRXQueued(lc, rssi);
+            return(QUEUED);
+            }
+    };
+
+double RadioMedium::rxDBm(const Tx &t, const SimRadioNode &to) const
+    { return(t.dBm - pathLossDB(t.from->distanceTo(to))); }
+
+bool RadioMedium::carrierSense(const SimRadioNode &at, const int8_t channel) const
+    {
+    for(const Tx &t : txs)
+        {
+        if(t.done || (&at == t.from) || (channel != t.channel) || (t.startUs > nowUs)) { continue; }
+        if(rxDBm(t, at) >= p.sensitivityDBm) { return(true); }
+        }
+    return(false);
+    }
+
+void RadioMedium::resolve(const size_t i)
+    {
+    txs[i].done = true;
+    const Tx &t = txs[i];
+    for(SimRadioNode *const r : nodes)
+        {
+        if((t.from == r) || (r->getListenChannel() != t.channel)) { continue; }
+        // Deaf while transmitting.
+        bool sending = false;
+        double interferenceMW = 0;
+        for(size_t j = 0; j < txs.size(); ++j)
+            {
+            const Tx &o = txs[j];
+            if((j == i) || !overlaps(t, o)) { continue; }
+            if(r == o.from) { sending = true; break; }
+            if(o.channel == t.channel) { interferenceMW += std::pow(10.0, rxDBm(o, *r) / 10.0); }
+            }
+        if(sending) { ++stats.lostHalfDuplex; continue; }
+        const double s = rxDBm(t, *r);
+        if(s < p.sensitivityDBm) { ++stats.lostWeak; continue; }
+        if((interferenceMW > 0) && ((s - (10.0 * std::log10(interferenceMW))) < p.captureDB)) { ++stats.lostCollision; continue; }
+        // RSSI byte as for OTRadioChannelStats, in 0.5dB steps above -128dBm.
+        const double rssi = (s + 128.0) * 2;
+        switch(r->_deliver(t.buf, t.len, uint8_t((rssi < 0) ? 0 : ((rssi > 255) ? 255 : rssi))))
+            {
+            case SimRadioNode::QUEUED: ++stats.delivered; break;
+            case SimRadioNode::DROPPED: ++stats.lostQueueFull; break;
+            case SimRadioNode::FILTERED: ++stats.lostFiltered; break;
+            }
+        }
+    }
+
+// Star traffic: nodes scattered around a listening hub, each sending periodically.
+struct TrafficConfig_t
+    {
+    unsigned nodes = 10;
+    // Nodes are placed uniformly within this distance of the hub.
+    double radiusM = 20.0;
+    uint8_t frameBytes = 32;
+    // Mean interval between each node's frames, and the random +/- jitter on each.
+    uint32_t periodMs = 4000;
+    uint32_t jitterMs = 500;
+    uint32_t durationMs = 600000;
+    // If true, a node that senses the channel busy backs off instead of sending,
+    // up to maxBackoffs times per frame by [1,backoffMaxMs] each.
+    bool carrierSense = false;
+    uint8_t maxBackoffs = 4;
+    uint32_t backoffMaxMs = 50;
+    uint32_t seed = 1;
+    MediumParams_t medium;
+    };
+
+struct TrafficResult_t
+    {
+    // Frames put on air, and received by the hub.
+    uint64_t sent = 0;
+    uint64_t received = 0;
+    // Frames abandoned after maxBackoffs.
+    uint64_t abandoned = 0;
+    MediumStats_t medium;
+    double deliveryRatio() const { return((0 == sent) ? 1.0 : (double(received) / double(sent))); }
+    };
+
+inline TrafficResult_t simulateStarTraffic(const TrafficConfig_t &c)
+    {
+    uint32_t seed = c.seed;
+    // Simple LCG so that runs are identical on every host.
+    auto rnd = [&seed]() { seed = seed * 1664525U + 1013904223U; return(((seed >> 8) & 0xffff) / 65536.0); };
+    RadioMedium medium(c.medium);
+    SimRadioNode hub(medium, 0, 0);
+    hub.listen(true, 0);
+    std::vector<std::unique_ptr<SimRadioNode>> nodes;
+    std::vector<uint64_t> nextUs;
+    std::vector<uint8_t> backoffs;
+    for(unsigned i = 0; i < c.nodes; ++i)
+        {
+        const double r = c.radiusM * std::sqrt(rnd());
+        const double a = 2 * 3.14159265358979323846 * rnd();
+        nodes.emplace_back(new SimRadioNode(medium, r * std::cos(a), r * std::sin(a)));
+        nextUs.push_back(uint64_t(rnd() * c.periodMs * 1000));
+        backoffs.push_back(0);
+        }
+    TrafficResult_t result;
+    uint8_t frame[maxFrameBytes];
+    const uint64_t endUs = uint64_t(c.durationMs) * 1000;
+    for( ; ; )
+        {
+        size_t n = nodes.size();
+        for(size_t i = 0; i < nodes.size(); ++i) { if((nodes.size() == n) || (nextUs[i] < nextUs[n])) { n = i; } }
+        if((nodes.size() == n) || (nextUs[n] >= endUs)) { break; }
+        medium.advanceTo(nextUs[n]);
+        while(NULL != hub.peekRXMsg()) { ++result.received; hub.removeRXMsg(); }
+        SimRadioNode &s = *nodes[n];
+        if(c.carrierSense && s.channelBusy() && !medium.isTransmitting(s))
+            {
+            if(backoffs[n]++ < c.maxBackoffs)
+                { nextUs[n] += 1000 * (1 + uint64_t(rnd() * c.backoffMaxMs)); continue; }
+            ++result.abandoned;
+            }
+        else
+            {
+            frame[0] = uint8_t(n);
+            for(uint8_t b = 1; b < c.frameBytes; ++b) { frame[b] = b; }
+            if(s.sendRaw(frame, c.frameBytes)) { ++result.sent; }
+            }
+        backoffs[n] = 0;
+        const double jitter = ((2 * rnd()) - 1) * c.jitterMs;
+        nextUs[n] += uint64_t((c.periodMs + jitter) * 1000);
+        }
+    // Let the last frames land.
+    medium.advanceTo(endUs + medium.airtimeUs(maxFrameBytes));
+    while(NULL != hub.peekRXMsg()) { ++result.received; hub.removeRXMsg(); }
+    result.medium = medium.getStats();
+    return(result);
+    }
+
+}
+
+#endif // PUT_OTRADIOLINK_RADIOMEDIUMSIMULATION_H
@@ -0,0 +1,132 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Tests of the shared radio medium simulation (RadioMediumSimulation.h).
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include "RadioMediumSimulation.h"
+
+namespace RMST
+{
+static const uint8_t frame[16] = { 'O', 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+}
+
+// A frame arrives in the receiver's queue only once its airtime has passed.
+TEST(RadioMedium,delivery)
+{
+    RMSim::RadioMedium m;
+    RMSim::SimRadioNode tx(m, 0, 0), rx(m, 10, 0), deaf(m, 5, 5);
+    rx.listen(true);
+    ASSERT_TRUE(tx.sendRaw(RMST::frame, sizeof(RMST::frame)));
+    // Still on air.
+    EXPECT_FALSE(tx.sendRaw(RMST::frame, sizeof(RMST::frame)));
+    const uint64_t airtime = m.airtimeUs(sizeof(RMST::frame));
+    EXPECT_NEAR(3900, double(airtime), 100);
+    m.advanceTo(airtime - 1);
+    EXPECT_EQ(0, rx.getRXMsgsQueued());
+    EXPECT_TRUE(rx.channelBusy());
+    m.advanceTo(airtime);
+    ASSERT_EQ(1, rx.getRXMsgsQueued());
+    const volatile uint8_t *const f = rx.peekRXMsg();
+    ASSERT_TRUE(NULL != f);
+    EXPECT_EQ(sizeof(RMST::frame), f[-1]);
+    EXPECT_EQ('O', f[0]);
+    EXPECT_EQ(15, f[15]);
+    // Not listening, so not counted.
+    EXPECT_EQ(0, deaf.getRXMsgsQueued());
+    EXPECT_EQ(1U, m.getStats().delivered);
+    EXPECT_FALSE(rx.channelBusy());
+}
+
+// Range, collisions, capture and half duplex.
+TEST(RadioMedium,losses)
+{
+    RMSim::RadioMedium m;
+    RMSim::SimRadioNode hub(m, 0, 0), near(m, 2, 0), far1(m, 30, 0), far2(m, -30, 0), outOfRange(m, 5000, 0);
+    hub.listen(true);
+    // Too weak.
+    outOfRange.sendRaw(RMST::frame, sizeof(RMST::frame));
+    m.advanceTo(m.now() + 100000);
+    EXPECT_EQ(1U, m.getStats().lostWeak);
+    // Two equally strong frames destroy each other.
+    far1.sendRaw(RMST::frame, sizeof(RMST::frame));
+    m.advanceTo(m.now() + 1000);
+    far2.sendRaw(RMST::frame, sizeof(RMST::frame));
+    m.advanceTo(m.now() + 100000);
+    EXPECT_EQ(2U, m.getStats().lostCollision);
+    EXPECT_EQ(0, hub.getRXMsgsQueued());
+    // A much stronger frame is captured despite the other.
+    far1.sendRaw(RMST::frame, sizeof(RMST::frame));
+    near.sendRaw(RMST::frame, sizeof(RMST::frame));
+    m.advanceTo(m.now() + 100000);
+    EXPECT_EQ(3U, m.getStats().lostCollision);
+    EXPECT_EQ(1, hub.getRXMsgsQueued());
+    hub.removeRXMsg();
+    // The hub hears nothing while itself sending.
+    hub.sendRaw(RMST::frame, sizeof(RMST::frame));
+    near.sendRaw(RMST::frame, sizeof(RMST::frame));
+    m.advanceTo(m.now() + 100000);
+    EXPECT_EQ(1U, m.getStats().lostHalfDuplex);
+    EXPECT_EQ(0, hub.getRXMsgsQueued());
+}
+
+// A full RX queue drops frames as a driver would.
+TEST(RadioMedium,queueFull)
+{
+    RMSim::RadioMedium m;
+    RMSim::SimRadioNode tx(m, 0, 0), rx(m, 1, 0);
+    rx.listen(true);
+    uint8_t queueMin, maxRX, maxTX;
+    rx.getCapacity(queueMin, maxRX, maxTX);
+    for(int i = 0; i < 20; ++i)
+        {
+        ASSERT_TRUE(tx.sendRaw(RMST::frame, sizeof(RMST::frame)));
+        m.advanceTo(m.now() + 10000);
+        }
+    EXPECT_LE(queueMin, rx.getRXMsgsQueued());
+    EXPECT_EQ(20U, m.getStats().delivered + m.getStats().lostQueueFull);
+    EXPECT_LT(0U, m.getStats().lostQueueFull);
+    EXPECT_EQ(m.getStats().lostQueueFull & 0xff, rx.getRXMsgsDroppedRecent());
+}
+
+// Delivery falls as the node count rises, and carrier sense recovers some of it.
+TEST(RadioMedium,deliveryVsNodes)
+{
+    RMSim::TrafficConfig_t c;
+    c.durationMs = 120000;
+    c.periodMs = 2000;
+    c.frameBytes = 64;
+    c.nodes = 1;
+    EXPECT_EQ(1.0, RMSim::simulateStarTraffic(c).deliveryRatio());
+    c.nodes = 5;
+    const RMSim::TrafficResult_t few = RMSim::simulateStarTraffic(c);
+    c.nodes = 100;
+    const RMSim::TrafficResult_t many = RMSim::simulateStarTraffic(c);
+    c.carrierSense = true;
+    const RMSim::TrafficResult_t manyCS = RMSim::simulateStarTraffic(c);
+    EXPECT_LT(0.9, few.deliveryRatio());
+    EXPECT_GT(few.deliveryRatio(), many.deliveryRatio());
+    EXPECT_LT(0U, many.medium.lostCollision);
+    EXPECT_GT(manyCS.deliveryRatio(), many.deliveryRatio());
+    // Repeatable.
+    EXPECT_EQ(manyCS.received, RMSim::simulateStarTraffic(c).received);
+}
@@ -0,0 +1,105 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Tests of relay deduplication of recently-relayed frames.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <OTRadioLink.h>
+
+#include "SecureFrameTestDoubles.h"
+
+namespace RDT
+{
+SFTD::CaptureRadio rt;
+typedef OTRadioLink::OTRelayDedupCache<4, 2> Dedup;
+Dedup dedup;
+}
+
+// Frames are remembered until aged out, and the oldest is displaced when full.
+TEST(RelayDedup, Cache)
+{
+    RDT::Dedup c;
+    const uint8_t f1[] = { 1, 2, 3 }, f2[] = { 1, 2, 4 }, f3[] = { 1, 2 };
+    EXPECT_EQ(0, c.size());
+    EXPECT_FALSE(c.seen(f1, sizeof(f1)));
+    c.add(f1, sizeof(f1));
+    EXPECT_TRUE(c.seen(f1, sizeof(f1)));
+    EXPECT_FALSE(c.seen(f2, sizeof(f2)));
+    EXPECT_FALSE(c.seen(f3, sizeof(f3)));
+    EXPECT_NE(RDT::Dedup::keyOf(f1, sizeof(f1)), RDT::Dedup::keyOf(f2, sizeof(f2)));
+    // Adding again does not use another entry.
+    c.add(f1, sizeof(f1));
+    EXPECT_EQ(1, c.size());
+    c.tick();
+    EXPECT_TRUE(c.seen(f1, sizeof(f1))); // Restarts its age.
+    c.tick();
+    EXPECT_TRUE(c.seen(f1, sizeof(f1)));
+    c.tick();
+    c.tick();
+    EXPECT_FALSE(c.seen(f1, sizeof(f1)));
+    EXPECT_EQ(0, c.size());
+    c.add(f3, sizeof(f3));
+    c.clear();
+    EXPECT_EQ(0, c.size());
+    // Fill, then displace the oldest.
+    OTRadioLink::OTRelayDedupCache<4, 10> l;
+    const uint8_t f[4][2] = { { 9, 0 }, { 9, 1 }, { 9, 2 }, { 9, 3 } };
+    for(uint8_t i = 0; i < 4; ++i) { l.add(f[i], 2); l.tick(); }
+    EXPECT_EQ(4, l.size());
+    EXPECT_TRUE(l.seen(f[0], 2));
+    l.add(f2, sizeof(f2));
+    EXPECT_EQ(4, l.size());
+    EXPECT_TRUE(l.seen(f[0], 2));
+    EXPECT_FALSE(l.seen(f[1], 2));
+    EXPECT_TRUE(l.seen(f[2], 2));
+    EXPECT_TRUE(l.seen(f2, sizeof(f2)));
+}
+
+// A frame is relayed once, and not again while remembered.
+TEST(RelayDedup, FrameOperation)
+{
+    const uint8_t msgBuf[] = { 5,    0,1,2,3,4 };
+    const uint8_t decrypted[] = { 0, 0x10, '{', 'b', 'c'};
+    uint8_t decryptedBodyOut[OTRadioLink::OTDecodeData_T::ptextLenMax];
+    OTRadioLink::OTDecodeData_T fd(&msgBuf[1], decryptedBodyOut);
+    memcpy(fd.ptext, decrypted, sizeof(decrypted));
+    fd.ptextLen = sizeof(decrypted);
+    RDT::dedup.clear();
+    RDT::rt.clear();
+    // Not remembered if it could not be queued.
+    RDT::rt.fail = true;
+    EXPECT_FALSE((OTRadioLink::relayDedupFrameOperation<decltype(RDT::rt), RDT::rt, decltype(RDT::dedup), RDT::dedup>(fd)));
+    EXPECT_EQ(0, RDT::dedup.size());
+    RDT::rt.fail = false;
+    EXPECT_TRUE((OTRadioLink::relayDedupFrameOperation<decltype(RDT::rt), RDT::rt, decltype(RDT::dedup), RDT::dedup>(fd)));
+    EXPECT_FALSE((OTRadioLink::relayDedupFrameOperation<decltype(RDT::rt), RDT::rt, decltype(RDT::dedup), RDT::dedup>(fd)));
+    EXPECT_EQ(1, RDT::rt.sent());
+    // Once aged out it may be relayed again.
+    for(int i = 0; i < 2; ++i) { RDT::dedup.tick(); }
+    EXPECT_TRUE((OTRadioLink::relayDedupFrameOperation<decltype(RDT::rt), RDT::rt, decltype(RDT::dedup), RDT::dedup>(fd)));
+    EXPECT_EQ(2, RDT::rt.sent());
+    // Invalid frames are not relayed, as for relayFrameOperation.
+    fd.ptext[2] = 's';
+    RDT::dedup.clear();
+    EXPECT_FALSE((OTRadioLink::relayDedupFrameOperation<decltype(RDT::rt), RDT::rt, decltype(RDT::dedup), RDT::dedup>(fd)));
+    EXPECT_EQ(2, RDT::rt.sent());
+}
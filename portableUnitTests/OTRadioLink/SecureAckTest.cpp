@@ -0,0 +1,243 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Tests of acknowledged secure frame delivery.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <OTRadioLink.h>
+
+#include "SecureFrameTestDoubles.h"
+
+namespace SACK
+{
+static const uint8_t key[16] = {};
+static const uint8_t nodeID[8] = { 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88 };
+static const uint8_t hubID[8] = { 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98 };
+
+// Encode an empty secure beacon from tx into frame; returns its length.
+static uint8_t makeFrame(SFTD::FixedIDTX &tx, uint8_t (&frame)[64])
+    {
+    OTRadioLink::OTBuf_t buf(frame, sizeof(frame));
+    uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encode_total_scratch_usage_OTAESGCM_2p0];
+    OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+    return(tx.generateSecureBeacon(buf, 4, OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleEnc_NULL_IMPL, sW, key));
+    }
+}
+
+// Timers expire exactly on time, including beyond one turn of the wheel.
+TEST(SecureAck,timerWheel)
+{
+    OTRadioLink::OTTimerWheel<8, 3> w;
+    EXPECT_EQ(0, w.getPending());
+    EXPECT_TRUE(w.schedule(0, 3));
+    EXPECT_TRUE(w.schedule(1, 20));
+    EXPECT_TRUE(w.schedule(2, 8));
+    EXPECT_FALSE(w.schedule(3, 1));
+    EXPECT_EQ(0, w.advance(2));
+    EXPECT_EQ(1, w.advance(1));
+    EXPECT_FALSE(w.isPending(0));
+    EXPECT_EQ(0, w.advance(4));
+    EXPECT_EQ(4, w.advance(1));
+    // Timer 1 shares a bucket with timer 0's but is two turns out.
+    for(int t = 9; t < 20; ++t) { EXPECT_EQ(0, w.advance(1)) << t; }
+    EXPECT_EQ(2, w.advance(1));
+    EXPECT_EQ(0, w.getPending());
+    // Rescheduling replaces, and cancel stops.
+    w.schedule(0, 5);
+    w.schedule(0, 10);
+    w.schedule(1, 2);
+    w.cancel(1);
+    EXPECT_EQ(0, w.advance(9));
+    EXPECT_EQ(1, w.advance(100));
+    // Idle advances still keep time.
+    w.advance(13);
+    w.schedule(2, 4);
+    EXPECT_EQ(4, w.advance(4));
+}
+
+// The sub-cycle clock drives the wheel across the end of the cycle.
+TEST(SecureAck,advanceTo)
+{
+    OTRadioLink::OTTimerWheel<32, 1> w;
+    EXPECT_EQ(0, w.advanceTo(200));
+    w.schedule(0, 100);
+    EXPECT_EQ(0, w.advanceTo(40));
+    EXPECT_EQ(0, w.advanceTo(43));
+    EXPECT_EQ(1, w.advanceTo(44));
+}
+
+// Monotonic ticks drive the wheel with any gap between calls.
+TEST(SecureAck,advanceToTicks)
+{
+    OTRadioLink::OTTimerWheel<32, 2> w;
+    const uint32_t start = 0xffffff00UL;
+    EXPECT_EQ(0, w.advanceToTicks(start));
+    w.schedule(0, 300);
+    w.schedule(1, 1000);
+    EXPECT_EQ(0, w.advanceToTicks(start + 299));
+    // Across the wrap of the ticks.
+    EXPECT_EQ(1, w.advanceToTicks(start + 300));
+    // A long gap expires everything pending.
+    EXPECT_EQ(2, w.advanceToTicks(start + 100000));
+    EXPECT_EQ(0, w.getPending());
+}
+
+// An acked frame is sent just once.
+TEST(SecureAck,ackedFirstTime)
+{
+    SFTD::CaptureRadio r;
+    SFTD::FixedIDTX tx(SACK::nodeID);
+    OTRadioLink::OTSecureAckTracker<> t(r);
+    uint8_t frame[64];
+    const uint8_t len = SACK::makeFrame(tx, frame);
+    ASSERT_EQ(31, len);
+    ASSERT_TRUE(t.send(frame, len));
+    EXPECT_EQ(1, r.sent());
+    EXPECT_EQ(len, r.lastLen());
+    EXPECT_EQ(0, memcmp(frame, r.last(), len));
+    EXPECT_EQ(1, t.getInFlight());
+    uint8_t ctr[6];
+    ASSERT_TRUE(OTRadioLink::getSecureFrameMsgCtr(frame, len, ctr));
+    EXPECT_TRUE(t.isInFlight(ctr));
+    EXPECT_TRUE(t.onAck(ctr));
+    EXPECT_FALSE(t.onAck(ctr));
+    EXPECT_EQ(0, t.getInFlight());
+    t.advance(10000);
+    EXPECT_EQ(1, r.sent());
+    EXPECT_EQ(1, t.getAcked());
+    EXPECT_EQ(0, t.getRetransmits());
+    EXPECT_EQ(0, t.getFailed());
+}
+
+// Unacked frames are retried with doubling delays, then given up.
+TEST(SecureAck,backoff)
+{
+    SFTD::CaptureRadio r;
+    SFTD::FixedIDTX tx(SACK::nodeID);
+    OTRadioLink::OTSecureAckTracker<1> t(r, 16, 4);
+    uint8_t frame[64];
+    const uint8_t len = SACK::makeFrame(tx, frame);
+    ASSERT_TRUE(t.send(frame, len));
+    int sendTimes[4] = { 0 };
+    int n = 1;
+    for(int tick = 1; tick < 1000; ++tick)
+        {
+        t.advance(1);
+        if(r.sent() > n) { ASSERT_LT(n, 4); sendTimes[n++] = tick; }
+        }
+    EXPECT_EQ(4, r.sent());
+    EXPECT_EQ(3, t.getRetransmits());
+    EXPECT_EQ(1, t.getFailed());
+    EXPECT_EQ(0, t.getInFlight());
+    // Each gap is the nominal delay plus at most a quarter.
+    for(int i = 1; i < 4; ++i)
+        {
+        const int gap = sendTimes[i] - sendTimes[i-1];
+        const int nominal = 16 << (i - 1);
+        EXPECT_GE(gap, nominal) << i;
+        EXPECT_LE(gap, nominal + nominal / 4) << i;
+        }
+}
+
+// In-flight state is bounded, and only secure frames are accepted.
+TEST(SecureAck,bounded)
+{
+    SFTD::CaptureRadio r;
+    SFTD::FixedIDTX tx(SACK::nodeID);
+    OTRadioLink::OTSecureAckTracker<2> t(r);
+    uint8_t f1[64], f2[64], f3[64];
+    const uint8_t l1 = SACK::makeFrame(tx, f1);
+    const uint8_t l2 = SACK::makeFrame(tx, f2);
+    const uint8_t l3 = SACK::makeFrame(tx, f3);
+    EXPECT_TRUE(t.send(f1, l1));
+    EXPECT_TRUE(t.send(f2, l2));
+    EXPECT_FALSE(t.send(f3, l3));
+    EXPECT_EQ(2, r.sent());
+    uint8_t ctr[6];
+    ASSERT_TRUE(OTRadioLink::getSecureFrameMsgCtr(f1, l1, ctr));
+    EXPECT_TRUE(t.onAck(ctr));
+    EXPECT_TRUE(t.send(f3, l3));
+    // Frames acked out of order.
+    ASSERT_TRUE(OTRadioLink::getSecureFrameMsgCtr(f3, l3, ctr));
+    EXPECT_TRUE(t.onAck(ctr));
+    EXPECT_EQ(1, t.getInFlight());
+    t.clear();
+    EXPECT_EQ(0, t.getInFlight());
+    EXPECT_EQ(0, t.getFailed());
+
+    // Not secure, or truncated.
+    uint8_t bad[64];
+    memcpy(bad, f1, l1);
+    bad[1] &= 0x7f;
+    EXPECT_FALSE(t.send(bad, l1));
+    EXPECT_FALSE(t.send(f1, uint8_t(l1 - 1)));
+    EXPECT_FALSE(t.send(NULL, l1));
+    EXPECT_FALSE(t.onAck(NULL));
+    EXPECT_EQ(3, r.sent());
+}
+
+// A frame is acked by the recipient's authenticated beacon.
+TEST(SecureAck,secureRoundTrip)
+{
+    SFTD::CaptureRadio r;
+    SFTD::FixedIDTX nodeTX(SACK::nodeID);
+    OTRadioLink::OTSecureAckTracker<> t(r);
+    uint8_t frame[64];
+    const uint8_t len = SACK::makeFrame(nodeTX, frame);
+    ASSERT_TRUE(t.send(frame, len));
+
+    // Hub authenticates the frame as heard, then acks its counter.
+    uint8_t decWorkspace[OTRadioLink::SimpleSecureFrame32or0BodyRXBase::decode_total_scratch_usage_OTAESGCM_3p0 + 1];
+    OTV0P2BASE::ScratchSpaceL sWDec(decWorkspace, sizeof(decWorkspace));
+    {
+    uint8_t ptext[OTRadioLink::OTDecodeData_T::ptextLenMax];
+    OTRadioLink::OTDecodeData_T fd(r.last(), ptext);
+    ASSERT_NE(0, fd.sfh.decodeHeader(r.last(), r.lastLen()));
+    SFTD::SingleNodeRX hubRX(SACK::nodeID);
+    ASSERT_NE(0, hubRX.decode(fd, OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL, sWDec, SACK::key));
+    }
+    uint8_t ctr[6];
+    ASSERT_TRUE(OTRadioLink::getSecureFrameMsgCtr(r.last(), r.lastLen(), ctr));
+    uint8_t _body[OTRadioLink::ENC_BODY_SMALL_FIXED_CTEXT_SIZE];
+    const uint8_t bodyLen = OTRadioLink::encodeSecureAck(_body, sizeof(_body), ctr);
+    ASSERT_EQ(OTRadioLink::SECURE_ACK_BODY_BYTES, bodyLen);
+    OTRadioLink::OTBuf_t body(_body, sizeof(_body));
+    uint8_t _ack[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::generateSecureBeaconWithBodyMaxBufSize];
+    OTRadioLink::OTBuf_t ack(_ack, sizeof(_ack));
+    uint8_t encWorkspace[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encode_total_scratch_usage_OTAESGCM_2p0];
+    OTV0P2BASE::ScratchSpaceL sWEnc(encWorkspace, sizeof(encWorkspace));
+    SFTD::FixedIDTX hubTX(SACK::hubID);
+    const uint8_t ackLen = hubTX.generateSecureBeacon(ack, 4, body, bodyLen,
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleEnc_NULL_IMPL, sWEnc, SACK::key);
+    ASSERT_NE(0, ackLen);
+
+    // Node authenticates the ack and stops retrying.
+    uint8_t ptext[OTRadioLink::OTDecodeData_T::ptextLenMax];
+    OTRadioLink::OTDecodeData_T fd(_ack, ptext);
+    ASSERT_NE(0, fd.sfh.decodeHeader(_ack, ackLen));
+    SFTD::SingleNodeRX nodeRX(SACK::hubID);
+    ASSERT_NE(0, nodeRX.decode(fd, OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL, sWDec, SACK::key));
+    EXPECT_FALSE(t.onAckBody(ptext, uint8_t(fd.ptextLen - 1)));
+    EXPECT_TRUE(t.onAckBody(ptext, fd.ptextLen));
+    t.advance(10000);
+    EXPECT_EQ(1, r.sent());
+}
@@ -0,0 +1,122 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Tests of prebuilt secure beacon templates, using the NULL crypto.
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <OTRadioLink.h>
+
+#include "SecureFrameTestDoubles.h"
+
+namespace SBTT
+{
+// NULL crypto that also folds the authenticated text into the tag,
+// so that differences in the AAD show up in the frame.
+static bool enc(uint8_t *workspace, size_t workspaceSize,
+                const uint8_t *key, const uint8_t *iv,
+                const uint8_t *authtext, uint8_t authtextSize,
+                const uint8_t *plaintext,
+                uint8_t *ciphertextOut, uint8_t *tagOut)
+    {
+    if(!OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleEnc_NULL_IMPL(workspace, workspaceSize,
+            key, iv, authtext, authtextSize, plaintext, ciphertextOut, tagOut)) { return(false); }
+    for(uint8_t i = 0; i < authtextSize; ++i) { tagOut[12 + (i & 3)] ^= uint8_t(authtext[i] + i); }
+    tagOut[15] ^= authtextSize;
+    return(true);
+    }
+
+static const uint8_t key[16] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+
+// TX base with an incrementing counter and a settable ID.
+class CountingTX final : public SFTD::RAMCtrTXBase
+    {
+    public:
+        uint8_t idByte = 0x80;
+        virtual bool getTXID(uint8_t *id) const override
+            { for(uint8_t i = 0; i < OTV0P2BASE::OpenTRV_Node_ID_Bytes; ++i) { id[i] = uint8_t(idByte + i); } return(true); }
+    };
+}
+
+// Beacons from the template should be identical to generateSecureBeacon() ones.
+TEST(SecureBeaconTemplate, MatchesGenerateSecureBeacon)
+{
+    uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encode_total_scratch_usage_OTAESGCM_2p0];
+    OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+    uint8_t _expected[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::generateSecureBeaconMaxBufSize];
+    OTRadioLink::OTBuf_t expected(_expected, sizeof(_expected));
+    uint8_t _actual[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::generateSecureBeaconMaxBufSize];
+    OTRadioLink::OTBuf_t actual(_actual, sizeof(_actual));
+
+    for(uint8_t il = 0; il <= 8; ++il)
+        {
+        SBTT::CountingTX txRef, txFast;
+        OTRadioLink::SimpleSecureBeaconTemplate bt;
+        // Fails until prepared.
+        EXPECT_EQ(0, bt.generate(txFast, actual, SBTT::enc, sW, SBTT::key));
+        ASSERT_TRUE(bt.prepare(txFast, il));
+        // Run past a sequence number wrap.
+        for(int i = 0; i < 20; ++i)
+            {
+            const uint8_t le = txRef.generateSecureBeacon(expected, il, SBTT::enc, sW, SBTT::key);
+            ASSERT_EQ(27 + il, le);
+            ASSERT_EQ(le, bt.generate(txFast, actual, SBTT::enc, sW, SBTT::key));
+            ASSERT_EQ(0, memcmp(_expected, _actual, le));
+            }
+        }
+}
+
+// The template follows an ID change, and fails safe on bad arguments.
+TEST(SecureBeaconTemplate, IDChangeAndErrors)
+{
+    uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encode_total_scratch_usage_OTAESGCM_2p0];
+    OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+    uint8_t _expected[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::generateSecureBeaconMaxBufSize];
+    OTRadioLink::OTBuf_t expected(_expected, sizeof(_expected));
+    uint8_t _actual[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::generateSecureBeaconMaxBufSize];
+    OTRadioLink::OTBuf_t actual(_actual, sizeof(_actual));
+
+    SBTT::CountingTX txRef, txFast;
+    OTRadioLink::SimpleSecureBeaconTemplate bt;
+    ASSERT_TRUE(bt.prepare(txFast, 4));
+    txRef.idByte = txFast.idByte = 0x90;
+    const uint8_t le = txRef.generateSecureBeacon(expected, 4, SBTT::enc, sW, SBTT::key);
+    ASSERT_NE(0, le);
+    ASSERT_EQ(le, bt.generate(txFast, actual, SBTT::enc, sW, SBTT::key));
+    EXPECT_EQ(0, memcmp(_expected, _actual, le));
+
+    // Too small a buffer or scratch space fails.
+    OTRadioLink::OTBuf_t small(_actual, le - 1);
+    EXPECT_EQ(0, bt.generate(txFast, small, SBTT::enc, sW, SBTT::key));
+    OTV0P2BASE::ScratchSpaceL sSmall(workspace, OTRadioLink::SimpleSecureBeaconTemplate::generate_total_scratch_usage_OTAESGCM_2p0 - 1);
+    EXPECT_EQ(0, bt.generate(txFast, actual, SBTT::enc, sSmall, SBTT::key));
+    // Key cache overload.
+    uint8_t space[OTRadioLink::SimpleSecureFrame32or0BodyBase::keySchedule_size_AES128];
+    OTRadioLink::SimpleSecureKeyCache kc(OTV0P2BASE::ScratchSpaceL(space, sizeof(space)));
+    EXPECT_EQ(0, bt.generate(txFast, actual, SBTT::enc, sW, kc));
+    ASSERT_TRUE(kc.setKey(SBTT::key, OTRadioLink::aes128KeyExpand_NULL_IMPL));
+    EXPECT_EQ(le, bt.generate(txFast, actual, SBTT::enc, sW, kc));
+    // Bad ID length.
+    EXPECT_FALSE(bt.prepare(txFast, 9));
+    EXPECT_FALSE(bt.isValid());
+    EXPECT_EQ(0, bt.generate(txFast, actual, SBTT::enc, sW, SBTT::key));
+}
@@ -0,0 +1,178 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * Tests of batch and zero-copy decoding of secure frames, using the NULL crypto.
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+#include <OTRadioLink.h>
+
+namespace SFBT
+{
+// Full IDs of two associated nodes.
+static const uint8_t idA[8] = { 0x88, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87 };
+static const uint8_t idB[8] = { 0x99, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97 };
+// Minimal receiver with two associations and RAM counters,
+// counting association lookups.
+class TestRX final : public OTRadioLink::SimpleSecureFrame32or0BodyRXBase
+    {
+    private:
+        uint8_t counters[2][6] = {};
+        int8_t find(const uint8_t *id, const uint8_t il) const
+            {
+            if(0 == memcmp(id, idA, il)) { return(0); }
+            if(0 == memcmp(id, idB, il)) { return(1); }
+            return(-1);
+            }
+        virtual int8_t _getNextMatchingNodeID(const uint8_t, const OTRadioLink::SecurableFrameHeader *const sfh, uint8_t *nodeID) const override
+            {
+            ++lookups;
+            const int8_t i = find(sfh->id, sfh->getIl());
+            if(i >= 0) { memcpy(nodeID, (0 == i) ? idA : idB, 8); }
+            return(i);
+            }
+    public:
+        mutable int lookups = 0;
+        virtual bool getLastRXMsgCtr(const uint8_t *const ID, uint8_t *counter) const override
+            {
+            const int8_t i = find(ID, 8);
+            if(i < 0) { return(false); }
+            memcpy(counter, counters[i], 6);
+            return(true);
+            }
+        virtual bool authAndUpdateRXMsgCtr(const uint8_t *ID, const uint8_t *newCounterValue) override
+            {
+            if(!validateRXMsgCtr(ID, newCounterValue)) { return(false); }
+            memcpy(counters[find(ID, 8)], newCounterValue, 6);
+            return(true);
+            }
+    };
+// Encode a secure frame from the given node with the given counter lsbyte.
+static uint8_t encode(uint8_t *buf, const uint8_t bufSize, const uint8_t *id, const uint8_t ctr)
+    {
+    static const uint8_t key[16] = {};
+    uint8_t iv[12] = {};
+    memcpy(iv, id, 6);
+    iv[11] = ctr;
+    uint8_t body[32] = { 'x', ctr };
+    uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::workspaceRequred_GCM32B16B_OTAESGCM_2p0];
+    OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+    OTRadioLink::OTEncodeData_T fd(body, sizeof(body), buf, bufSize);
+    fd.ptextLen = 2;
+    fd.fType = OTRadioLink::FTS_BasicSensorOrValve;
+    return(OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encodeRaw(fd, id, 4, iv,
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleEnc_NULL_IMPL, sW, key));
+    }
+}
+
+// Check that a batch decodes as individual decode() calls would,
+// rejecting replays and unknown senders,
+// while looking up each run of frames from the same sender only once.
+TEST(SecureFrameBatch, DecodeBatch)
+{
+    static const uint8_t key[16] = {};
+    const uint8_t idC[8] = { 0xaa, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7 };
+    // Frames: A1 A2 A3 B1 B1(replay) C1(unknown) C1 A2(replay) A4.
+    const uint8_t *const ids[] = { SFBT::idA, SFBT::idA, SFBT::idA, SFBT::idB, SFBT::idB, idC, idC, SFBT::idA, SFBT::idA };
+    const uint8_t ctrs[] = { 1, 2, 3, 1, 1, 1, 1, 2, 4 };
+    const bool expectOK[] = { true, true, true, true, false, false, false, false, true };
+    constexpr uint8_t n = sizeof(ctrs);
+    uint8_t bufs[n][64];
+    uint8_t ptexts[n][OTRadioLink::OTDecodeData_T::ptextLenMax];
+    OTRadioLink::OTDecodeData_T *fds[n];
+    for(uint8_t i = 0; i < n; ++i)
+        {
+        const uint8_t l = SFBT::encode(bufs[i], sizeof(bufs[i]), ids[i], ctrs[i]);
+        ASSERT_NE(0, l);
+        fds[i] = new OTRadioLink::OTDecodeData_T(bufs[i], ptexts[i]);
+        ASSERT_NE(0, fds[i]->sfh.decodeHeader(bufs[i], l));
+        }
+    SFBT::TestRX rx;
+    uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyRXBase::decodeBatch_total_scratch_usage_OTAESGCM_3p0 + 64];
+    OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+    uint8_t results[n];
+    memset(results, 0xff, sizeof(results));
+    EXPECT_EQ(5, rx.decodeBatch(fds, n, OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL, sW, key, results));
+    for(uint8_t i = 0; i < n; ++i)
+        {
+        EXPECT_EQ(expectOK[i], 0 != results[i]) << int(i);
+        if(expectOK[i])
+            {
+            EXPECT_EQ(0, memcmp(ids[i], fds[i]->id, 8));
+            EXPECT_EQ(2, fds[i]->ptextLen);
+            EXPECT_EQ(ctrs[i], fds[i]->ptext[1]);
+            }
+        }
+    // One lookup each for the runs A, B, C (negative result reused) and A,
+    // plus one more after the failed replay of A.
+    EXPECT_EQ(5, rx.lookups);
+    // Too small a scratch space fails cleanly.
+    OTV0P2BASE::ScratchSpaceL sSmall(workspace, OTRadioLink::SimpleSecureFrame32or0BodyRXBase::decodeBatch_scratch_usage);
+    EXPECT_EQ(0, rx.decodeBatch(fds, n, OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL, sSmall, key, results));
+    for(uint8_t i = 0; i < n; ++i) { EXPECT_EQ(0, results[i]); delete fds[i]; }
+}
+
+// Check that zero-copy decode writes the body straight into the caller's buffer
+// using no scratch for it, giving the same result as the copying form,
+// and clears the buffer on failure.
+TEST(SecureFrameBatch, DecodeRawInPlace)
+{
+    static const uint8_t key[16] = {};
+    uint8_t buf[64];
+    const uint8_t l = SFBT::encode(buf, sizeof(buf), SFBT::idA, 42);
+    ASSERT_NE(0, l);
+    uint8_t iv[12] = {};
+    memcpy(iv, SFBT::idA, 6);
+    iv[11] = 42;
+    // Copying form, with its full scratch requirement.
+    uint8_t ptext[OTRadioLink::OTDecodeData_T::ptextLenMax];
+    OTRadioLink::OTDecodeData_T fdCopy(buf, ptext);
+    ASSERT_NE(0, fdCopy.sfh.decodeHeader(buf, l));
+    EXPECT_FALSE(fdCopy.ptextInPlace);
+    uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyRXBase::decodeRaw_total_scratch_usage_OTAESGCM_3p0];
+    OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+    EXPECT_EQ(l, OTRadioLink::SimpleSecureFrame32or0BodyRXBase::decodeRaw(fdCopy,
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL, sW, key, iv));
+    // Zero-copy form, with no scratch beyond the (here trivial) decryption function's.
+    uint8_t block[OTRadioLink::ENC_BODY_SMALL_FIXED_CTEXT_SIZE];
+    OTRadioLink::OTDecodeData_T fdInPlace(buf, block, OTRadioLink::OTDecodeData_T::PTEXT_IN_PLACE);
+    ASSERT_NE(0, fdInPlace.sfh.decodeHeader(buf, l));
+    EXPECT_TRUE(fdInPlace.ptextInPlace);
+    OTV0P2BASE::ScratchSpaceL sNone(workspace, 1);
+    EXPECT_EQ(0, OTRadioLink::SimpleSecureFrame32or0BodyRXBase::decodeRaw(fdCopy,
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL, sNone, key, iv));
+    EXPECT_EQ(l, OTRadioLink::SimpleSecureFrame32or0BodyRXBase::decodeRaw(fdInPlace,
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL, sNone, key, iv));
+    ASSERT_EQ(2, fdInPlace.ptextLen);
+    EXPECT_EQ(fdCopy.ptextLen, fdInPlace.ptextLen);
+    EXPECT_EQ(0, memcmp(ptext, block, fdInPlace.ptextLen));
+    // Tampered tag: fails and leaves nothing in the buffer.
+    uint8_t bad[64];
+    memcpy(bad, buf, sizeof(bad));
+    bad[l - 2] ^= 1;
+    OTRadioLink::OTDecodeData_T fdBad(bad, block, OTRadioLink::OTDecodeData_T::PTEXT_IN_PLACE);
+    ASSERT_NE(0, fdBad.sfh.decodeHeader(bad, l));
+    EXPECT_EQ(0, OTRadioLink::SimpleSecureFrame32or0BodyRXBase::decodeRaw(fdBad,
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL, sNone, key, iv));
+    for(const auto b : block) { ASSERT_EQ(0, b); }
+}
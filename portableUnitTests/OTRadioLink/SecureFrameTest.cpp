@@ -32,6 +32,8 @@ Author(s) / Copyright (s): Damon Hart-Davis 2016
 #include <OTAESGCM.h>
 #include <OTRadioLink.h>
 
+#include "SecureFrameTestVectors.h"
+
 
 static const int AES_KEY_SIZE = 128; // in bits
 static const int GCM_NONCE_LENGTH = 12; // in bytes
@@ -578,10 +580,10 @@ TEST(OTAESGCMSecureFrame, CryptoAccess)
 TEST(Main,GCMVS1ViaFixed32BTextSizeWITHWORKSPACE)
 {
     // Inputs to encryption.
-    static const uint8_t input[32] = { 0xcc, 0x38, 0xbc, 0xcd, 0x6b, 0xc5, 0x36, 0xad, 0x91, 0x9b, 0x13, 0x95, 0xf5, 0xd6, 0x38, 0x01, 0xf9, 0x9f, 0x80, 0x68, 0xd6, 0x5c, 0xa5, 0xac, 0x63, 0x87, 0x2d, 0xaf, 0x16, 0xb9, 0x39, 0x01 };
-    static const uint8_t key[AES_KEY_SIZE/8] = { 0x29, 0x8e, 0xfa, 0x1c, 0xcf, 0x29, 0xcf, 0x62, 0xae, 0x68, 0x24, 0xbf, 0xc1, 0x95, 0x57, 0xfc };
-    static const uint8_t nonce[GCM_NONCE_LENGTH] = { 0x6f, 0x58, 0xa9, 0x3f, 0xe1, 0xd2, 0x07, 0xfa, 0xe4, 0xed, 0x2f, 0x6d };
-    static const uint8_t aad[16] = { 0x02, 0x1f, 0xaf, 0xd2, 0x38, 0x46, 0x39, 0x73, 0xff, 0xe8, 0x02, 0x56, 0xe5, 0xb1, 0xc6, 0xb1 };
+    const uint8_t (&input)[32] = SFTV::GCMVS1PT;
+    const uint8_t (&key)[AES_KEY_SIZE/8] = SFTV::GCMVS1Key;
+    const uint8_t (&nonce)[GCM_NONCE_LENGTH] = SFTV::GCMVS1IV;
+    const uint8_t (&aad)[16] = SFTV::GCMVS1AAD;
     // Space for outputs from encryption.
     uint8_t tag[GCM_TAG_LENGTH]; // Space for tag.
     uint8_t cipherText[OTV0P2BASE::fnmax(32, (int)sizeof(input))]; // Space for encrypted text.
@@ -626,8 +628,8 @@ TEST(Main,GCMVS1ViaFixed32BTextSizeWITHWORKSPACE)
     // Security: ensure that no part of the workspace has been left unzeroed.
     for(int i = workspaceRequired; --i >= 0; ) { ASSERT_EQ(0, workspace[i]); }
     // Check some of the tag.
-    EXPECT_EQ(0x57, tag[1]);
-    EXPECT_EQ(0x25, tag[14]);
+    EXPECT_EQ(SFTV::GCMVS1AuthOnlyTag1, tag[1]);
+    EXPECT_EQ(SFTV::GCMVS1AuthOnlyTag14, tag[14]);
     // Auth/decrypt (auth should still succeed).
     EXPECT_TRUE(OTAESGCM::fixed32BTextSize12BNonce16BTagSimpleDec_DEFAULT_WITH_LWORKSPACE(
             workspace, workspaceRequired,
@@ -1196,7 +1198,7 @@ TEST(OTAESGCMSecureFrame, OFrameEncoding)
     constexpr uint8_t valvePC = 0x7f;
 
     // Expected result.
-    const uint8_t expected[63] = {62,207,4,128,128,128,128,32,102,58,109,143,127,209,106,16,122,170,41,17,135,168,193,220,188,110,36,204,190,21,125,138,196,172,122,155,149,87,43,4,0,0,0,0,0,0,162,222,15,42,215,77,210,0,127,19,255,121,139,199,19,12,128};
+    const uint8_t *const expected = SFTV::OFrameZeroKey;
 
     // Encrypt empty (no-JSON) O frame via the explicit workspace API.
     uint8_t _bufW[encBufSize];
@@ -1221,6 +1223,38 @@ TEST(OTAESGCMSecureFrame, OFrameEncoding)
     for(int i = 0; i < bodylenW; ++i) { ASSERT_EQ(expected[i], bufW.buf[i]); }
 }
 
+// Test encoding an O frame straight into a TX queue slot, as via OTRadioLink::reserveToSend().
+TEST(OTAESGCMSecureFrame, OFrameEncodingInPlace)
+{
+    TXBaseMock mockTX;
+    const uint8_t *const key = zeroBlock;
+    const uint8_t txIDLen = 4;
+    constexpr uint8_t valvePC = 0x7f;
+    const uint8_t *const expected = SFTV::OFrameZeroKey;
+
+    OTRadioLink::TXQueue<1, 64> q;
+    uint8_t *const slot = q.reserve();
+    ASSERT_TRUE(NULL != slot);
+
+    uint8_t _rawFrame[34] = {};
+    constexpr size_t workspaceSize = OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encodeValveFrame_total_scratch_usage_OTAESGCM_2p0;
+    uint8_t workspace[workspaceSize];
+    OTV0P2BASE::ScratchSpaceL sW(workspace, workspaceSize);
+    OTRadioLink::SimpleSecureFrame32or0BodyTXBase::fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t &eW = OTAESGCM::fixed32BTextSize12BNonce16BTagSimpleEnc_DEFAULT_WITH_LWORKSPACE;
+
+    OTRadioLink::OTEncodeData_T fd(_rawFrame, sizeof(_rawFrame), slot, q.maxLen);
+    const uint8_t len = mockTX.encodeValveFrame(fd, txIDLen, valvePC, eW, sW, key);
+    ASSERT_EQ(63, len);
+    ASSERT_TRUE(q.commit(len));
+
+    uint8_t qlen, power;
+    int8_t channel;
+    const uint8_t *const bp = q.peek(qlen, channel, power);
+    ASSERT_TRUE(bp == slot);
+    EXPECT_EQ(63, qlen);
+    for(int i = 0; i < qlen; ++i) { ASSERT_EQ(expected[i], bp[i]); }
+}
+
 // Test encoding of generic frames through to final byte pattern.
 TEST(OTAESGCMSecureFrame, GenericFrameEncodingValidity)
 {
@@ -1313,7 +1347,7 @@ TEST(OTAESGCMSecureFrame, GenericFrameEncoding)
     constexpr uint8_t valvePC = 0x7f;
 
     // Expected result.
-    const uint8_t expected[63] = {62,207,4,128,128,128,128,32,102,58,109,143,127,209,106,16,122,170,41,17,135,168,193,220,188,110,36,204,190,21,125,138,196,172,122,155,149,87,43,4,0,0,0,0,0,0,162,222,15,42,215,77,210,0,127,19,255,121,139,199,19,12,128};
+    const uint8_t *const expected = SFTV::OFrameZeroKey;
 
     // Encrypt empty (no-JSON) O frame via the explicit workspace API.
     uint8_t _bufW[encBufSize];
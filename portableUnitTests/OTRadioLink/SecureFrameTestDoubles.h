@@ -0,0 +1,139 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * Host-side secure frame TX/RX stand-ins, crypto selection and a capturing radio,
+ * shared between the tests and benchmarks that encode, decode and send frames.
+ */
+
+#ifndef PUT_OTRADIOLINK_SECUREFRAMETESTDOUBLES_H
+#define PUT_OTRADIOLINK_SECUREFRAMETESTDOUBLES_H
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include <OTV0p2Base.h>
+#include <OTRadioLink.h>
+#if defined(EXT_AVAILABLE_ARDUINO_LIB_OTAESGCM)
+#include <OTAESGCM.h>
+#endif
+
+namespace SFTD
+{
+
+// Enc/dec: OTAESGCM where available, else the NULL crypto.
+#if defined(EXT_AVAILABLE_ARDUINO_LIB_OTAESGCM)
+static constexpr const char *impl = "AESGCM";
+static constexpr OTRadioLink::SimpleSecureFrame32or0BodyTXBase::fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t &enc =
+    OTAESGCM::fixed32BTextSize12BNonce16BTagSimpleEnc_DEFAULT_WITH_LWORKSPACE;
+static constexpr OTRadioLink::SimpleSecureFrame32or0BodyRXBase::fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &dec =
+    OTAESGCM::fixed32BTextSize12BNonce16BTagSimpleDec_DEFAULT_WITH_LWORKSPACE;
+static constexpr size_t decWorkspace = OTAESGCM::OTAES128GCMGenericWithWorkspace<>::workspaceRequiredDec;
+#else
+static constexpr const char *impl = "NULL";
+static constexpr OTRadioLink::SimpleSecureFrame32or0BodyTXBase::fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t &enc =
+    OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleEnc_NULL_IMPL;
+static constexpr OTRadioLink::SimpleSecureFrame32or0BodyRXBase::fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &dec =
+    OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL;
+// The NULL decryption needs a non-NULL workspace.
+static constexpr size_t decWorkspace = 1;
+#endif
+
+// Secure TX with a RAM message counter that never repeats,
+// and no non-volatile prefix to reset or increment.
+// Derived classes supply the ID.
+class RAMCtrTXBase : public OTRadioLink::SimpleSecureFrame32or0BodyTXBase
+    {
+    protected:
+        uint8_t ctr[6] = {};
+    public:
+        virtual bool getTXNVCtrPrefix(uint8_t *buf) const override { memcpy(buf, ctr, 3); return(true); }
+        virtual bool resetTXNVCtrPrefix(bool /*allZeros*/ = false) override { return(false); }
+        virtual bool incrementTXNVCtrPrefix() override { return(false); }
+        virtual bool getNextTXMsgCtr(uint8_t *buf) override
+            {
+            if(!OTRadioLink::SimpleSecureFrame32or0BodyRXBase::msgcounteradd(ctr, 1)) { return(false); }
+            memcpy(buf, ctr, 6);
+            return(true);
+            }
+    };
+
+// Secure TX with the given (full) ID and a RAM message counter.
+class FixedIDTX final : public RAMCtrTXBase
+    {
+    private:
+        const uint8_t *const id;
+    public:
+        explicit FixedIDTX(const uint8_t *const id_) : id(id_) { }
+        virtual bool getTXID(uint8_t *buf) const override { memcpy(buf, id, OTV0P2BASE::OpenTRV_Node_ID_Bytes); return(true); }
+    };
+
+// Secure RX associated with the given (full) node ID only,
+// accepting any counter above zero so that the same frames can be decoded repeatedly.
+class SingleNodeRX final : public OTRadioLink::SimpleSecureFrame32or0BodyRXBase
+    {
+    private:
+        const uint8_t *const id;
+        virtual int8_t _getNextMatchingNodeID(const uint8_t index, const OTRadioLink::SecurableFrameHeader *const sfh, uint8_t *nodeID) const override
+            {
+            if((0 != index) || (0 != memcmp(sfh->id, id, sfh->getIl()))) { return(-1); }
+            memcpy(nodeID, id, OTV0P2BASE::OpenTRV_Node_ID_Bytes);
+            return(0);
+            }
+    public:
+        explicit SingleNodeRX(const uint8_t *const id_) : id(id_) { }
+        virtual bool getLastRXMsgCtr(const uint8_t *const /*ID*/, uint8_t *counter) const override { memset(counter, 0, 6); return(true); }
+        virtual bool authAndUpdateRXMsgCtr(const uint8_t *ID, const uint8_t *newCounterValue) override
+            { return(validateRXMsgCtr(ID, newCounterValue)); }
+    };
+
+// TX-only radio that records each frame it is asked to send, and its TX power.
+// Set fail to have sendRaw() fail and record nothing.
+class CaptureRadio final : public OTRadioLink::OTRadioLink
+    {
+    public:
+        static constexpr uint8_t maxTXMsgLen = 64;
+        // Frames sent, oldest first, and the TX power of each.
+        std::vector<std::vector<uint8_t>> frames;
+        std::vector<TXpower> powers;
+        bool fail = false;
+        int sent() const { return(int(frames.size())); }
+        // The last frame sent; there must be one.
+        const uint8_t *last() const { return(frames.back().data()); }
+        uint8_t lastLen() const { return(uint8_t(frames.back().size())); }
+        void clear() { frames.clear(); powers.clear(); }
+        virtual void getCapacity(uint8_t &queueRXMsgsMin, uint8_t &maxRXMsgLen, uint8_t &maxTXMsgLen_) const override
+            { queueRXMsgsMin = 0; maxRXMsgLen = 0; maxTXMsgLen_ = maxTXMsgLen; }
+        virtual uint8_t getRXMsgsQueued() const override { return(0); }
+        virtual const volatile uint8_t *peekRXMsg() const override { return(NULL); }
+        virtual void removeRXMsg() override { }
+        virtual bool sendRaw(const uint8_t *buf, uint8_t buflen, int8_t, TXpower power, bool) override
+            {
+            if(fail || (buflen > maxTXMsgLen)) { return(false); }
+            frames.emplace_back(buf, buf + buflen);
+            powers.push_back(power);
+            return(true);
+            }
+    private:
+        virtual void _dolisten() override { }
+    };
+
+}
+
+#endif // PUT_OTRADIOLINK_SECUREFRAMETESTDOUBLES_H
@@ -0,0 +1,51 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * Known-answer vectors for secure frame crypto,
+ * shared between the tests of each enc/dec implementation.
+ */
+
+#ifndef PUT_OTRADIOLINK_SECUREFRAMETESTVECTORS_H
+#define PUT_OTRADIOLINK_SECUREFRAMETESTVECTORS_H
+
+#include <stdint.h>
+
+namespace SFTV
+{
+
+// NIST GCMVS test vector.
+// See http://csrc.nist.gov/groups/STM/cavp/documents/mac/gcmvs.pdf
+// keylen = 128, ivlen = 96, ptlen = 256, aadlen = 128, taglen = 128, count = 0
+static const uint8_t GCMVS1Key[16] = { 0x29, 0x8e, 0xfa, 0x1c, 0xcf, 0x29, 0xcf, 0x62, 0xae, 0x68, 0x24, 0xbf, 0xc1, 0x95, 0x57, 0xfc };
+static const uint8_t GCMVS1IV[12] = { 0x6f, 0x58, 0xa9, 0x3f, 0xe1, 0xd2, 0x07, 0xfa, 0xe4, 0xed, 0x2f, 0x6d };
+static const uint8_t GCMVS1AAD[16] = { 0x02, 0x1f, 0xaf, 0xd2, 0x38, 0x46, 0x39, 0x73, 0xff, 0xe8, 0x02, 0x56, 0xe5, 0xb1, 0xc6, 0xb1 };
+static const uint8_t GCMVS1PT[32] = { 0xcc, 0x38, 0xbc, 0xcd, 0x6b, 0xc5, 0x36, 0xad, 0x91, 0x9b, 0x13, 0x95, 0xf5, 0xd6, 0x38, 0x01, 0xf9, 0x9f, 0x80, 0x68, 0xd6, 0x5c, 0xa5, 0xac, 0x63, 0x87, 0x2d, 0xaf, 0x16, 0xb9, 0x39, 0x01 };
+static const uint8_t GCMVS1CT[32] = { 0xdf, 0xce, 0x4e, 0x9c, 0xd2, 0x91, 0x10, 0x3d, 0x7f, 0xe4, 0xe6, 0x33, 0x51, 0xd9, 0xe7, 0x9d, 0x3d, 0xfd, 0x39, 0x1e, 0x32, 0x67, 0x10, 0x46, 0x58, 0x21, 0x2d, 0xa9, 0x65, 0x21, 0xb7, 0xdb };
+static const uint8_t GCMVS1Tag[16] = { 0x54, 0x24, 0x65, 0xef, 0x59, 0x93, 0x16, 0xf7, 0x3a, 0x7a, 0x56, 0x05, 0x09, 0xa2, 0xd9, 0xf2 };
+// Selected bytes of the tag with the same key, IV and AAD and no plaintext.
+static const uint8_t GCMVS1AuthOnlyTag1 = 0x57;
+static const uint8_t GCMVS1AuthOnlyTag14 = 0x25;
+
+// Empty (no-JSON) O frame with valve position 0x7f from a 4-byte ID of 0x80s,
+// all-zeros key, restart counter prefix and message counter.
+static const uint8_t OFrameZeroKey[63] = {62,207,4,128,128,128,128,32,102,58,109,143,127,209,106,16,122,170,41,17,135,168,193,220,188,110,36,204,190,21,125,138,196,172,122,155,149,87,43,4,0,0,0,0,0,0,162,222,15,42,215,77,210,0,127,19,255,121,139,199,19,12,128};
+
+}
+
+#endif // PUT_OTRADIOLINK_SECUREFRAMETESTVECTORS_H
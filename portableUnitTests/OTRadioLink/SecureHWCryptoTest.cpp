@@ -0,0 +1,235 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * Tests of the pluggable block-cipher (eg hardware) crypto backend for secure frames,
+ * against the same vectors as the OTAESGCM-based tests in SecureFrameTest.cpp.
+ *
+ * On the host a small reference software AES-128 stands in for the
+ * hardware block primitive.
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <OTRadioLink.h>
+
+#include "SecureFrameTestVectors.h"
+
+namespace SHWCT
+{
+
+// Reference (slow, not constant-time) AES-128 block encryption, FIPS-197.
+static const uint8_t sbox[256] = {
+    0x63,0x7c,0x77,0x7b,0xf2,0x6b,0x6f,0xc5,0x30,0x01,0x67,0x2b,0xfe,0xd7,0xab,0x76,
+    0xca,0x82,0xc9,0x7d,0xfa,0x59,0x47,0xf0,0xad,0xd4,0xa2,0xaf,0x9c,0xa4,0x72,0xc0,
+    0xb7,0xfd,0x93,0x26,0x36,0x3f,0xf7,0xcc,0x34,0xa5,0xe5,0xf1,0x71,0xd8,0x31,0x15,
+    0x04,0xc7,0x23,0xc3,0x18,0x96,0x05,0x9a,0x07,0x12,0x80,0xe2,0xeb,0x27,0xb2,0x75,
+    0x09,0x83,0x2c,0x1a,0x1b,0x6e,0x5a,0xa0,0x52,0x3b,0xd6,0xb3,0x29,0xe3,0x2f,0x84,
+    0x53,0xd1,0x00,0xed,0x20,0xfc,0xb1,0x5b,0x6a,0xcb,0xbe,0x39,0x4a,0x4c,0x58,0xcf,
+    0xd0,0xef,0xaa,0xfb,0x43,0x4d,0x33,0x85,0x45,0xf9,0x02,0x7f,0x50,0x3c,0x9f,0xa8,
+    0x51,0xa3,0x40,0x8f,0x92,0x9d,0x38,0xf5,0xbc,0xb6,0xda,0x21,0x10,0xff,0xf3,0xd2,
+    0xcd,0x0c,0x13,0xec,0x5f,0x97,0x44,0x17,0xc4,0xa7,0x7e,0x3d,0x64,0x5d,0x19,0x73,
+    0x60,0x81,0x4f,0xdc,0x22,0x2a,0x90,0x88,0x46,0xee,0xb8,0x14,0xde,0x5e,0x0b,0xdb,
+    0xe0,0x32,0x3a,0x0a,0x49,0x06,0x24,0x5c,0xc2,0xd3,0xac,0x62,0x91,0x95,0xe4,0x79,
+    0xe7,0xc8,0x37,0x6d,0x8d,0xd5,0x4e,0xa9,0x6c,0x56,0xf4,0xea,0x65,0x7a,0xae,0x08,
+    0xba,0x78,0x25,0x2e,0x1c,0xa6,0xb4,0xc6,0xe8,0xdd,0x74,0x1f,0x4b,0xbd,0x8b,0x8a,
+    0x70,0x3e,0xb5,0x66,0x48,0x03,0xf6,0x0e,0x61,0x35,0x57,0xb9,0x86,0xc1,0x1d,0x9e,
+    0xe1,0xf8,0x98,0x11,0x69,0xd9,0x8e,0x94,0x9b,0x1e,0x87,0xe9,0xce,0x55,0x28,0xdf,
+    0x8c,0xa1,0x89,0x0d,0xbf,0xe6,0x42,0x68,0x41,0x99,0x2d,0x0f,0xb0,0x54,0xbb,0x16 };
+static uint8_t xtime(const uint8_t x) { return((uint8_t)((x << 1) ^ ((x & 0x80) ? 0x1b : 0))); }
+static unsigned blockCalls;
+static bool aes128BlockEncRef(const uint8_t *const key, const uint8_t *const in, uint8_t *const out)
+    {
+    if((NULL == key) || (NULL == in) || (NULL == out)) { return(false); }
+    ++blockCalls;
+    uint8_t rk[16], s[16];
+    memcpy(rk, key, 16);
+    for(int i = 0; i < 16; ++i) { s[i] = in[i] ^ rk[i]; }
+    uint8_t rcon = 1;
+    for(int round = 1; round <= 10; ++round)
+        {
+        // Next round key.
+        uint8_t t[4] = { sbox[rk[13]], sbox[rk[14]], sbox[rk[15]], sbox[rk[12]] };
+        t[0] ^= rcon; rcon = xtime(rcon);
+        for(int i = 0; i < 16; ++i) { rk[i] ^= (i < 4) ? t[i] : rk[i-4]; }
+        // SubBytes and ShiftRows (state is column-major).
+        uint8_t u[16];
+        for(int c = 0; c < 4; ++c) { for(int r = 0; r < 4; ++r) { u[4*c + r] = sbox[s[(4*(c + r) + r) & 15]]; } }
+        // MixColumns, except in the last round.
+        for(int c = 0; c < 4; ++c)
+            {
+            uint8_t *const col = u + 4*c;
+            if(round < 10)
+                {
+                const uint8_t a0 = col[0], a1 = col[1], a2 = col[2], a3 = col[3];
+                const uint8_t all = a0 ^ a1 ^ a2 ^ a3;
+                col[0] ^= all ^ xtime(a0 ^ a1);
+                col[1] ^= all ^ xtime(a1 ^ a2);
+                col[2] ^= all ^ xtime(a2 ^ a3);
+                col[3] ^= all ^ xtime(a3 ^ a0);
+                }
+            }
+        for(int i = 0; i < 16; ++i) { s[i] = u[i] ^ rk[i]; }
+        }
+    memcpy(out, s, 16);
+    return(true);
+    }
+
+// Always-failing block primitive, eg peripheral fault.
+static bool aes128BlockEncFail(const uint8_t *, const uint8_t *, uint8_t *) { return(false); }
+
+// Mock TX base: all zeros fixed IV and counters, valid fixed ID; as in SecureFrameTest.cpp.
+class TXBaseMock final : public OTRadioLink::SimpleSecureFrame32or0BodyTXBase
+  {
+  public:
+    virtual bool getTXID(uint8_t *id) const override { memset(id, 0x80, OTV0P2BASE::OpenTRV_Node_ID_Bytes); return(true); }
+    virtual bool getTXNVCtrPrefix(uint8_t *buf) const override { memset(buf, 0, 3); return(true); }
+    virtual bool resetTXNVCtrPrefix(bool /*allZeros*/ = false) override { return(false); }
+    virtual bool incrementTXNVCtrPrefix() override { return(false); }
+    virtual bool getNextTXMsgCtr(uint8_t *buf) override { memset(buf, 0, 6); return(true); }
+  };
+
+}
+
+// Check the reference block cipher against the FIPS-197 Appendix C.1 vector.
+TEST(SecureHWCrypto, ReferenceAES128)
+{
+    const uint8_t key[16] = { 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15 };
+    const uint8_t pt[16] = { 0x00,0x11,0x22,0x33,0x44,0x55,0x66,0x77,0x88,0x99,0xaa,0xbb,0xcc,0xdd,0xee,0xff };
+    const uint8_t ct[16] = { 0x69,0xc4,0xe0,0xd8,0x6a,0x7b,0x04,0x30,0xd8,0xcd,0xb7,0x80,0x70,0xb4,0xc5,0x5a };
+    uint8_t out[16];
+    ASSERT_TRUE(SHWCT::aes128BlockEncRef(key, pt, out));
+    EXPECT_EQ(0, memcmp(ct, out, 16));
+}
+
+// Check enc/dec over a block primitive against the NIST GCMVS vector, as in SecureFrameTest.cpp.
+TEST(SecureHWCrypto, GCMVS1ViaBlock)
+{
+    OTRadioLink::SimpleSecureFrame32or0BodyTXBase::fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t &e =
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleEnc_BLOCK<SHWCT::aes128BlockEncRef>;
+    OTRadioLink::SimpleSecureFrame32or0BodyRXBase::fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &d =
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_BLOCK<SHWCT::aes128BlockEncRef>;
+    const size_t workspaceRequired = OTRadioLink::workspaceRequired_GCM32B16B_BLOCK;
+    uint8_t workspace[workspaceRequired];
+    uint8_t tag[16];
+    uint8_t cipherText[32];
+    ASSERT_TRUE(e(workspace, sizeof(workspace), SFTV::GCMVS1Key, SFTV::GCMVS1IV,
+                  SFTV::GCMVS1AAD, sizeof(SFTV::GCMVS1AAD), SFTV::GCMVS1PT, cipherText, tag));
+    for(int i = workspaceRequired; --i >= 0; ) { ASSERT_EQ(0, workspace[i]); }
+    EXPECT_EQ(0, memcmp(SFTV::GCMVS1CT, cipherText, 32));
+    EXPECT_EQ(0, memcmp(SFTV::GCMVS1Tag, tag, 16));
+    // Decrypt, including in place.
+    uint8_t decoded[32];
+    EXPECT_TRUE(d(workspace, sizeof(workspace), SFTV::GCMVS1Key, SFTV::GCMVS1IV,
+                  SFTV::GCMVS1AAD, sizeof(SFTV::GCMVS1AAD), cipherText, tag, decoded));
+    for(int i = workspaceRequired; --i >= 0; ) { ASSERT_EQ(0, workspace[i]); }
+    EXPECT_EQ(0, memcmp(SFTV::GCMVS1PT, decoded, 32));
+    EXPECT_TRUE(d(workspace, sizeof(workspace), SFTV::GCMVS1Key, SFTV::GCMVS1IV,
+                  SFTV::GCMVS1AAD, sizeof(SFTV::GCMVS1AAD), cipherText, tag, cipherText));
+    EXPECT_EQ(0, memcmp(SFTV::GCMVS1PT, cipherText, 32));
+    // A tampered tag, text or AAD is rejected and the output left untouched.
+    memcpy(cipherText, SFTV::GCMVS1CT, 32);
+    memset(decoded, 0xa5, sizeof(decoded));
+    tag[15] ^= 1;
+    EXPECT_FALSE(d(workspace, sizeof(workspace), SFTV::GCMVS1Key, SFTV::GCMVS1IV,
+                   SFTV::GCMVS1AAD, sizeof(SFTV::GCMVS1AAD), cipherText, tag, decoded));
+    tag[15] ^= 1;
+    cipherText[31] ^= 0x80;
+    EXPECT_FALSE(d(workspace, sizeof(workspace), SFTV::GCMVS1Key, SFTV::GCMVS1IV,
+                   SFTV::GCMVS1AAD, sizeof(SFTV::GCMVS1AAD), cipherText, tag, decoded));
+    cipherText[31] ^= 0x80;
+    EXPECT_FALSE(d(workspace, sizeof(workspace), SFTV::GCMVS1Key, SFTV::GCMVS1IV,
+                   SFTV::GCMVS1AAD, sizeof(SFTV::GCMVS1AAD) - 1, cipherText, tag, decoded));
+    for(int i = 0; i < 32; ++i) { ASSERT_EQ(0xa5, decoded[i]); }
+    for(int i = workspaceRequired; --i >= 0; ) { ASSERT_EQ(0, workspace[i]); }
+    // Authentication only.
+    EXPECT_TRUE(e(workspace, sizeof(workspace), SFTV::GCMVS1Key, SFTV::GCMVS1IV,
+                  SFTV::GCMVS1AAD, sizeof(SFTV::GCMVS1AAD), NULL, cipherText, tag));
+    EXPECT_EQ(SFTV::GCMVS1AuthOnlyTag1, tag[1]);
+    EXPECT_EQ(SFTV::GCMVS1AuthOnlyTag14, tag[14]);
+    EXPECT_TRUE(d(workspace, sizeof(workspace), SFTV::GCMVS1Key, SFTV::GCMVS1IV,
+                  SFTV::GCMVS1AAD, sizeof(SFTV::GCMVS1AAD), NULL, tag, decoded));
+    for(int i = 0; i < 32; ++i) { ASSERT_EQ(0xa5, decoded[i]); }
+    // Too-small or NULL workspaces are rejected, oversize ones accepted.
+    EXPECT_FALSE(e(NULL, workspaceRequired, SFTV::GCMVS1Key, SFTV::GCMVS1IV,
+                   SFTV::GCMVS1AAD, sizeof(SFTV::GCMVS1AAD), SFTV::GCMVS1PT, cipherText, tag));
+    EXPECT_FALSE(e(workspace, workspaceRequired - 1, SFTV::GCMVS1Key, SFTV::GCMVS1IV,
+                   SFTV::GCMVS1AAD, sizeof(SFTV::GCMVS1AAD), SFTV::GCMVS1PT, cipherText, tag));
+    EXPECT_FALSE(d(workspace, workspaceRequired - 1, SFTV::GCMVS1Key, SFTV::GCMVS1IV,
+                   SFTV::GCMVS1AAD, sizeof(SFTV::GCMVS1AAD), SFTV::GCMVS1CT, SFTV::GCMVS1Tag, decoded));
+    uint8_t bigWorkspace[workspaceRequired + 1];
+    EXPECT_TRUE(d(bigWorkspace, sizeof(bigWorkspace), SFTV::GCMVS1Key, SFTV::GCMVS1IV,
+                  SFTV::GCMVS1AAD, sizeof(SFTV::GCMVS1AAD), SFTV::GCMVS1CT, SFTV::GCMVS1Tag, decoded));
+    EXPECT_EQ(0, memcmp(SFTV::GCMVS1PT, decoded, 32));
+}
+
+// A failing block primitive (eg peripheral fault) fails the operation and still clears the workspace.
+TEST(SecureHWCrypto, BlockFailure)
+{
+    OTRadioLink::SimpleSecureFrame32or0BodyTXBase::fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t &e =
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleEnc_BLOCK<SHWCT::aes128BlockEncFail>;
+    uint8_t workspace[OTRadioLink::workspaceRequired_GCM32B16B_BLOCK];
+    memset(workspace, 0xff, sizeof(workspace));
+    uint8_t tag[16], cipherText[32];
+    EXPECT_FALSE(e(workspace, sizeof(workspace), SFTV::GCMVS1Key, SFTV::GCMVS1IV,
+                   SFTV::GCMVS1AAD, sizeof(SFTV::GCMVS1AAD), SFTV::GCMVS1PT, cipherText, tag));
+    for(size_t i = 0; i < sizeof(workspace); ++i) { ASSERT_EQ(0, workspace[i]); }
+}
+
+// Encode an O frame over the block backend through to the same byte pattern as with OTAESGCM.
+TEST(SecureHWCrypto, OFrameEncodingViaBlock)
+{
+    SHWCT::TXBaseMock mockTX;
+    const uint8_t key[16] = { };
+    constexpr uint8_t txIDLen = 4;
+    constexpr uint8_t valvePC = 0x7f;
+    uint8_t _bufW[64];
+    uint8_t _rawFrame[34] = {};
+    uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encodeValveFrame_total_scratch_usage_OTAESGCM_2p0];
+    OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+    OTRadioLink::SimpleSecureFrame32or0BodyTXBase::fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t &eW =
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleEnc_BLOCK<SHWCT::aes128BlockEncRef>;
+    OTRadioLink::OTEncodeData_T fd(_rawFrame, sizeof(_rawFrame), _bufW, sizeof(_bufW));
+    const uint8_t bodylenW = mockTX.encodeValveFrame(fd, txIDLen, valvePC, eW, sW, key);
+    ASSERT_EQ(sizeof(SFTV::OFrameZeroKey), bodylenW);
+    for(int i = 0; i < bodylenW; ++i) { ASSERT_EQ(SFTV::OFrameZeroKey[i], _bufW[i]); }
+}
+
+// Without a hardware backend the HW_OR_SW wrappers are exactly the software implementation.
+TEST(SecureHWCrypto, FallbackToSoftware)
+{
+    OTRadioLink::SimpleSecureFrame32or0BodyTXBase::fixed32BTextSize12BNonce16BTagSimpleEnc_fn_t &e =
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleEnc_HW_OR_SW<OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleEnc_BLOCK<SHWCT::aes128BlockEncRef> >;
+    OTRadioLink::SimpleSecureFrame32or0BodyRXBase::fixed32BTextSize12BNonce16BTagSimpleDec_fn_t &d =
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_HW_OR_SW<OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_BLOCK<SHWCT::aes128BlockEncRef> >;
+    uint8_t workspace[OTRadioLink::workspaceRequired_GCM32B16B_BLOCK];
+    uint8_t tag[16], cipherText[32], decoded[32];
+    SHWCT::blockCalls = 0;
+    ASSERT_TRUE(e(workspace, sizeof(workspace), SFTV::GCMVS1Key, SFTV::GCMVS1IV,
+                  SFTV::GCMVS1AAD, sizeof(SFTV::GCMVS1AAD), SFTV::GCMVS1PT, cipherText, tag));
+    EXPECT_TRUE(d(workspace, sizeof(workspace), SFTV::GCMVS1Key, SFTV::GCMVS1IV,
+                  SFTV::GCMVS1AAD, sizeof(SFTV::GCMVS1AAD), cipherText, tag, decoded));
+    EXPECT_EQ(0, memcmp(SFTV::GCMVS1Tag, tag, 16));
+    EXPECT_EQ(0, memcmp(SFTV::GCMVS1PT, decoded, 32));
+#ifndef OTRADIOLINK_SECUREFRAME_HW_CRYPTO
+    // H, two counter blocks and J0 for each of enc and dec.
+    EXPECT_EQ(8U, SHWCT::blockCalls);
+#endif
+}
@@ -0,0 +1,116 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * Tests of cached key schedules for secure frames, using the NULL crypto.
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <OTRadioLink.h>
+
+namespace SKCT
+{
+// Count of key expansions performed.
+static int expansions;
+static bool countingExpand(uint8_t *schedule, const uint8_t *key)
+    { ++expansions; return(OTRadioLink::aes128KeyExpand_NULL_IMPL(schedule, key)); }
+// Current key returned by getKey(), and whether it is available.
+static uint8_t currentKey[16];
+static bool keyAvailable;
+static bool getKey(uint8_t *key)
+    { if(!keyAvailable) { return(false); } memcpy(key, currentKey, 16); return(true); }
+}
+
+// Check that the schedule is only re-expanded when the key changes.
+TEST(SecureKeyCache, RefreshOnlyOnChange)
+{
+    SKCT::expansions = 0;
+    SKCT::keyAvailable = true;
+    memset(SKCT::currentKey, 1, sizeof(SKCT::currentKey));
+    // Too small a space gives a cache that is never valid.
+    uint8_t small[OTRadioLink::SimpleSecureFrame32or0BodyBase::keySchedule_size_AES128 - 1];
+    OTRadioLink::SimpleSecureKeyCache kcSmall(OTV0P2BASE::ScratchSpaceL(small, sizeof(small)));
+    EXPECT_FALSE(kcSmall.refresh(SKCT::getKey, SKCT::countingExpand));
+    EXPECT_TRUE(NULL == kcSmall.getSchedule());
+    EXPECT_EQ(0, SKCT::expansions);
+
+    uint8_t space[OTRadioLink::SimpleSecureFrame32or0BodyBase::keySchedule_size_AES128];
+    OTRadioLink::SimpleSecureKeyCache kc(OTV0P2BASE::ScratchSpaceL(space, sizeof(space)));
+    EXPECT_TRUE(NULL == kc.getSchedule());
+    EXPECT_TRUE(kc.refresh(SKCT::getKey, SKCT::countingExpand));
+    EXPECT_EQ(1, SKCT::expansions);
+    ASSERT_TRUE(NULL != kc.getSchedule());
+    EXPECT_EQ(0, memcmp(SKCT::currentKey, kc.getSchedule(), 16));
+    // Same key: no re-expansion.
+    for(int i = 0; i < 5; ++i) { EXPECT_TRUE(kc.refresh(SKCT::getKey, SKCT::countingExpand)); }
+    EXPECT_EQ(1, SKCT::expansions);
+    // Changed key: re-expanded.
+    SKCT::currentKey[15] = 2;
+    EXPECT_TRUE(kc.refresh(SKCT::getKey, SKCT::countingExpand));
+    EXPECT_EQ(2, SKCT::expansions);
+    EXPECT_EQ(2, kc.getSchedule()[15]);
+    // Key unavailable: cache invalidated and wiped.
+    SKCT::keyAvailable = false;
+    EXPECT_FALSE(kc.refresh(SKCT::getKey, SKCT::countingExpand));
+    EXPECT_TRUE(NULL == kc.getSchedule());
+    for(size_t i = 0; i < sizeof(space); ++i) { ASSERT_EQ(0, space[i]); }
+    // Back again needs a fresh expansion.
+    SKCT::keyAvailable = true;
+    EXPECT_TRUE(kc.setKey(SKCT::currentKey, SKCT::countingExpand));
+    EXPECT_EQ(3, SKCT::expansions);
+    kc.invalidate();
+    EXPECT_TRUE(NULL == kc.getSchedule());
+}
+
+// Check encode/decode round trip via the key cache overloads.
+TEST(SecureKeyCache, EncodeDecodeRaw)
+{
+    uint8_t space[OTRadioLink::SimpleSecureFrame32or0BodyBase::keySchedule_size_AES128];
+    OTRadioLink::SimpleSecureKeyCache kc(OTV0P2BASE::ScratchSpaceL(space, sizeof(space)));
+    const uint8_t key[16] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+    const uint8_t id[] = { 0x80, 0x81, 0x82, 0x83 };
+    const uint8_t iv[12] = { 0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0, 0, 1, 0, 0, 0x2a };
+    uint8_t body[32] = { 'a', 'b', 'c' };
+    uint8_t buf[64];
+    uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::workspaceRequred_GCM32B16B_KS_OTAESGCM_2p0 + 32];
+    OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+    OTRadioLink::OTEncodeData_T fdTX(body, sizeof(body), buf, sizeof(buf));
+    fdTX.ptextLen = 3;
+    fdTX.fType = OTRadioLink::FTS_BasicSensorOrValve;
+    // Fails with an invalid cache.
+    EXPECT_EQ(0, OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encodeRaw(fdTX, id, sizeof(id), iv,
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleEnc_NULL_IMPL, sW, kc));
+    ASSERT_TRUE(kc.setKey(key, OTRadioLink::aes128KeyExpand_NULL_IMPL));
+    const uint8_t encodedLength = OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encodeRaw(fdTX, id, sizeof(id), iv,
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleEnc_NULL_IMPL, sW, kc);
+    ASSERT_NE(0, encodedLength);
+    // Decode.
+    uint8_t decrypted[32];
+    OTRadioLink::OTDecodeData_T fdRX(buf, decrypted);
+    ASSERT_NE(0, fdRX.sfh.decodeHeader(buf, encodedLength));
+    EXPECT_NE(0, OTRadioLink::SimpleSecureFrame32or0BodyRXBase::decodeRaw(fdRX,
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL, sW, kc, iv));
+    EXPECT_EQ(3, fdRX.ptextLen);
+    EXPECT_EQ(0, memcmp("abc", decrypted, 3));
+    kc.invalidate();
+    EXPECT_EQ(0, OTRadioLink::SimpleSecureFrame32or0BodyRXBase::decodeRaw(fdRX,
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL, sW, kc, iv));
+}
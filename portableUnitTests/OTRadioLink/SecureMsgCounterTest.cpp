@@ -0,0 +1,101 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * Tests of secure frame message counter arithmetic,
+ * checking the word-at-a-time versions against the bytewise reference.
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <OTRadioLink.h>
+
+
+// Sign of an int16_t as -1, 0 or +1.
+static int sgn(const int16_t v) { return((v > 0) - (v < 0)); }
+
+// Check compare and add against the bytewise reference over edge cases and random values.
+TEST(SecureMsgCounter, WordMatchesBytewise)
+{
+    typedef OTRadioLink::SimpleSecureFrame32or0BodyRXBase rx;
+    const uint8_t edges[][6] = {
+        { 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 1 },
+        { 0, 0, 0, 0, 0, 0xff },
+        { 0, 0, 0, 0, 0xff, 0xff },
+        { 0, 0xff, 0xff, 0xff, 0xff, 0xff },
+        { 1, 0, 0, 0, 0, 0 },
+        { 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff },
+        { 0x80, 0, 0, 0, 0, 0 },
+        { 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe },
+        { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff },
+        };
+    constexpr int nEdges = sizeof(edges) / sizeof(edges[0]);
+    constexpr int nRandom = 1000;
+    srandom(42);
+    for(int i = 0; i < nEdges + nRandom; ++i)
+        {
+        uint8_t a[6], b[6];
+        if(i < nEdges) { memcpy(a, edges[i], 6); memcpy(b, edges[(i * 7 + 3) % nEdges], 6); }
+        else
+            {
+            for(int j = 0; j < 6; ++j) { a[j] = uint8_t(random()); b[j] = uint8_t(random()); }
+            // Often share a prefix to exercise the low-order bytes.
+            if(0 == (i & 1)) { memcpy(b, a, 1 + (i % 5)); }
+            }
+        EXPECT_EQ(sgn(rx::msgcountercmpBytewise(a, b)), rx::msgcountercmp(a, b));
+        EXPECT_EQ(sgn(rx::msgcountercmpBytewise(b, a)), rx::msgcountercmp(b, a));
+        EXPECT_EQ(0, rx::msgcountercmp(a, a));
+        const uint8_t deltas[] = { 0, 1, 2, 0x80, 0xff };
+        for(const uint8_t delta : deltas)
+            {
+            uint8_t w[6], r[6];
+            memcpy(w, a, 6);
+            memcpy(r, a, 6);
+            EXPECT_EQ(rx::msgcounteraddBytewise(r, delta), rx::msgcounteradd(w, delta));
+            EXPECT_EQ(0, memcmp(r, w, 6));
+            }
+        }
+}
+
+// Check that a carry ripples all the way into the top byte,
+// and that the value round-trips through load/store.
+TEST(SecureMsgCounter, CarryIntoTopByte)
+{
+    typedef OTRadioLink::SimpleSecureFrame32or0BodyRXBase rx;
+    const uint8_t expected[6] = { 1, 0, 0, 0, 0, 0 };
+    uint8_t c[6] = { 0, 0xff, 0xff, 0xff, 0xff, 0xff };
+    EXPECT_EQ(0xffffffffffULL, rx::msgcounterload(c));
+    ASSERT_TRUE(rx::msgcounteraddBytewise(c, 1));
+    EXPECT_EQ(0, memcmp(expected, c, 6));
+    const uint8_t c2init[6] = { 0, 0xff, 0xff, 0xff, 0xff, 0xff };
+    uint8_t c2[6];
+    memcpy(c2, c2init, 6);
+    ASSERT_TRUE(rx::msgcounteradd(c2, 1));
+    EXPECT_EQ(0, memcmp(expected, c2, 6));
+    EXPECT_EQ(0x10000000000ULL, rx::msgcounterload(c2));
+    uint8_t s[6];
+    rx::msgcounterstore(s, 0x0123456789abULL);
+    const uint8_t sExpected[6] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab };
+    EXPECT_EQ(0, memcmp(sExpected, s, 6));
+    const uint64_t max = rx::msgcountermax;
+    const uint8_t cMax[6] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+    EXPECT_EQ(max, rx::msgcounterload(cMax));
+}
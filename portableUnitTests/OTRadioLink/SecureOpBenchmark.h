@@ -0,0 +1,165 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * Reusable harness for measuring stack, heap and host time
+ * of secure frame operations over a corpus of inputs,
+ * and for checking the results against a thresholds file.
+ *
+ * Stack use is as seen by OTV0P2BASE::MemoryChecks,
+ * ie the deepest recordIfMinSP() call reached below the harness,
+ * so it covers the library's own frames (eg encodeRaw()/decodeRaw())
+ * but not any deeper calls inside an external crypto library.
+ *
+ * Heap use is counted only through the replacement global operator new
+ * supplied by exactly one translation unit (see SecureOpBenchmarkTest.cpp);
+ * the library is expected never to allocate, so anything non-zero is a bug.
+ *
+ * Host times are wall-clock and noisy (eg unoptimised/debug builds, loaded CI machines)
+ * so thresholds for them are intended to catch gross regressions only.
+ */
+
+#ifndef PUT_OTRADIOLINK_SECUREOPBENCHMARK_H
+#define PUT_OTRADIOLINK_SECUREOPBENCHMARK_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <OTV0p2Base.h>
+
+namespace SOBM
+{
+
+// Heap allocations seen while counting is enabled.
+// Storage and the operator new hooks that feed it are in one test translation unit.
+struct HeapCounter
+    {
+    static bool enabled;
+    static size_t allocs;
+    static size_t bytes;
+    static void record(const size_t n) { if(enabled) { ++allocs; bytes += n; } }
+    };
+
+// Measured results for one operation over a corpus.
+struct OpResult
+    {
+    // Operation name, as in the thresholds file.
+    const char *op;
+    // Total number of calls, and number that reported failure.
+    unsigned runs;
+    unsigned failures;
+    // Maximum stack depth in bytes seen in any one call.
+    size_t maxStack;
+    // Total heap allocations and bytes over all calls.
+    size_t heapAllocs;
+    size_t heapBytes;
+    // Mean host wall-clock time per call.
+    double nsPerOp;
+    };
+
+// Limits for one operation with one crypto implementation.
+struct Threshold
+    {
+    std::string op;
+    std::string impl;
+    size_t maxStack;
+    size_t maxHeapBytes;
+    double maxNsPerOp;
+    };
+
+// Run op(i) for each i in [0,corpusSize), repeats times over, measuring as described above.
+// op must return true on success.
+// The first pass is also measured, so any one-off lazy initialisation shows up in stack/heap.
+template <class Op>
+OpResult measure(const char *const name, const unsigned corpusSize, const unsigned repeats, Op op)
+    {
+    OpResult r = { name, 0, 0, 0, 0, 0, 0 };
+    std::chrono::steady_clock::duration total = std::chrono::steady_clock::duration::zero();
+    for(unsigned rep = 0; rep < repeats; ++rep)
+        {
+        for(unsigned i = 0; i < corpusSize; ++i)
+            {
+            OTV0P2BASE::RAMEND = OTV0P2BASE::getSP();
+            OTV0P2BASE::MemoryChecks::resetMinSP();
+            OTV0P2BASE::MemoryChecks::recordIfMinSP();
+            const size_t baseStack = OTV0P2BASE::MemoryChecks::getMinSP();
+            HeapCounter::allocs = 0;
+            HeapCounter::bytes = 0;
+            HeapCounter::enabled = true;
+            const auto start = std::chrono::steady_clock::now();
+            const bool ok = op(i);
+            const auto end = std::chrono::steady_clock::now();
+            HeapCounter::enabled = false;
+            total += end - start;
+            const size_t stack = baseStack - OTV0P2BASE::MemoryChecks::getMinSP();
+            if(stack > r.maxStack) { r.maxStack = stack; }
+            r.heapAllocs += HeapCounter::allocs;
+            r.heapBytes += HeapCounter::bytes;
+            if(!ok) { ++r.failures; }
+            ++r.runs;
+            }
+        }
+    if(0 != r.runs)
+        { r.nsPerOp = double(std::chrono::duration_cast<std::chrono::nanoseconds>(total).count()) / r.runs; }
+    return(r);
+    }
+
+// Print one result in a fixed format, for eyeballing and for updating the thresholds file.
+inline void print(const OpResult &r, const char *const impl)
+    {
+    std::printf("SecureOpBenchmark %-20s %-6s runs %5u fail %u stack %5u heap %u/%u ns/op %.0f\n",
+        r.op, impl, r.runs, r.failures, unsigned(r.maxStack),
+        unsigned(r.heapAllocs), unsigned(r.heapBytes), r.nsPerOp);
+    }
+
+// Load thresholds from a text file; returns false if it cannot be read.
+// Each non-blank line not starting with '#' is:
+//     op impl maxStackBytes maxHeapBytes maxNsPerOp
+// where a limit of 0 for maxNsPerOp means unchecked.
+inline bool loadThresholds(const char *const path, std::vector<Threshold> &out)
+    {
+    if(NULL == path) { return(false); }
+    FILE *const f = std::fopen(path, "r");
+    if(NULL == f) { return(false); } // ERROR
+    char line[256];
+    while(NULL != std::fgets(line, sizeof(line), f))
+        {
+        char op[64], impl[16];
+        unsigned long stack, heap;
+        double ns;
+        if('#' == line[0]) { continue; }
+        if(5 != std::sscanf(line, "%63s %15s %lu %lu %lf", op, impl, &stack, &heap, &ns)) { continue; }
+        out.push_back(Threshold{ op, impl, size_t(stack), size_t(heap), ns });
+        }
+    std::fclose(f);
+    return(true);
+    }
+
+// Find the threshold for the given op and impl, or NULL if none.
+inline const Threshold *findThreshold(const std::vector<Threshold> &ts, const char *const op, const char *const impl)
+    {
+    for(const Threshold &t : ts) { if((t.op == op) && (t.impl == impl)) { return(&t); } }
+    return(NULL);
+    }
+
+}
+
+#endif // PUT_OTRADIOLINK_SECUREOPBENCHMARK_H
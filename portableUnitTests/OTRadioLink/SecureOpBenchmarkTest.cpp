@@ -0,0 +1,187 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * Benchmarks of secure frame encode/decode over a corpus of frames:
+ * max stack, heap (which must be zero) and host ns per op.
+ *
+ * Uses OTAESGCM where available, else the NULL crypto
+ * (which still exercises all of this library's framing code).
+ *
+ * Results are always printed, and heap use and failures always checked.
+ * If OTRL_SECURE_OP_THRESHOLDS names a thresholds file
+ * (as for the secure_op_benchmark meson test)
+ * results are also checked against the limits in it.
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+
+#include <OTV0p2Base.h>
+#include <OTRadioLink.h>
+
+#include "SecureFrameTestDoubles.h"
+#include "SecureOpBenchmark.h"
+
+
+// Heap accounting for the whole test binary: counts only while measuring.
+// Other test translation units must not replace these.
+bool SOBM::HeapCounter::enabled;
+size_t SOBM::HeapCounter::allocs;
+size_t SOBM::HeapCounter::bytes;
+void *operator new(const std::size_t n)
+    {
+    SOBM::HeapCounter::record(n);
+    void *const p = malloc((0 == n) ? 1 : n);
+    if(NULL == p) { throw std::bad_alloc(); }
+    return(p);
+    }
+void *operator new[](const std::size_t n) { return(::operator new(n)); }
+void operator delete(void *const p) noexcept { free(p); }
+void operator delete[](void *const p) noexcept { free(p); }
+
+
+namespace SOBT
+{
+// All-zeros key.
+static const uint8_t key[16] = {};
+// Full ID of the benchmark transmitter.
+static const uint8_t txID[8] = { 0x88, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87 };
+// Number of times to run over each corpus, for more stable times.
+static constexpr unsigned repeats = 20;
+
+// Corpus for encode() and decode(): frame type, header ID length and body length.
+// With a body the ID can be at most 4 bytes to fit in a small frame.
+struct FrameSpec { OTRadioLink::FrameType_Secureable fType; uint8_t il; uint8_t bodyLen; };
+static const FrameSpec frames[] = {
+    { OTRadioLink::FTS_ALIVE, 1, 0 },
+    { OTRadioLink::FTS_ALIVE, 4, 0 },
+    { OTRadioLink::FTS_ALIVE, 8, 0 },
+    { OTRadioLink::FTS_BasicSensorOrValve, 1, 1 },
+    { OTRadioLink::FTS_BasicSensorOrValve, 2, 2 },
+    { OTRadioLink::FTS_BasicSensorOrValve, 4, 8 },
+    { OTRadioLink::FTS_BasicSensorOrValve, 3, 16 },
+    { OTRadioLink::FTS_BasicSensorOrValve, 4, 24 },
+    { OTRadioLink::FTS_BasicSensorOrValve, 4, OTRadioLink::ENC_BODY_SMALL_FIXED_PTEXT_MAX_SIZE },
+    };
+static constexpr unsigned nFrames = sizeof(frames) / sizeof(frames[0]);
+// Corpus for generateSecureBeacon(): header ID lengths.
+static const uint8_t beaconIls[] = { 1, 2, 4, 6, 8 };
+// Corpus for encodeValveFrame(): valve % and JSON stats (may be empty).
+struct ValveSpec { uint8_t valvePC; const char *json; };
+static const ValveSpec valves[] = {
+    { 0x7f, "" },
+    { 0, "{\"b\":1}" },
+    { 50, "{\"T|C16\":299,\"H|%\":83}" },
+    { 100, "{\"@\":\"f9ce\",\"L\":14,\"O\":1}" },
+    };
+static constexpr unsigned nValves = sizeof(valves) / sizeof(valves[0]);
+
+// Encode frame i of the corpus into buf; returns length or 0 on failure.
+static uint8_t encodeFrame(SFTD::FixedIDTX &tx, const unsigned i, uint8_t *const buf, const uint8_t bufSize)
+    {
+    const FrameSpec &s = frames[i];
+    uint8_t body[OTRadioLink::ENC_BODY_SMALL_FIXED_CTEXT_SIZE];
+    for(uint8_t j = 0; j < s.bodyLen; ++j) { body[j] = uint8_t(0x20 + i + j); }
+    uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encode_total_scratch_usage_OTAESGCM_2p0];
+    OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+    OTRadioLink::OTEncodeData_T fd((0 == s.bodyLen) ? NULL : body, (0 == s.bodyLen) ? 0 : sizeof(body), buf, bufSize);
+    fd.ptextLen = s.bodyLen;
+    fd.fType = s.fType;
+    return(tx.encode(fd, s.il, SFTD::enc, sW, key));
+    }
+
+// Check one result: no failures or heap use, and within any configured thresholds.
+static void check(const SOBM::OpResult &r, const std::vector<SOBM::Threshold> &ts, const bool haveThresholds)
+    {
+    SOBM::print(r, SFTD::impl);
+    EXPECT_NE(0U, r.runs) << r.op;
+    EXPECT_EQ(0U, r.failures) << r.op;
+    EXPECT_EQ(0U, r.heapAllocs) << r.op;
+    EXPECT_NE(0U, r.maxStack) << r.op; // Make sure the stack check was reached.
+    if(!haveThresholds) { return; }
+    const SOBM::Threshold *const t = SOBM::findThreshold(ts, r.op, SFTD::impl);
+    ASSERT_TRUE(NULL != t) << "no threshold for " << r.op << " " << SFTD::impl;
+    EXPECT_GE(t->maxStack, r.maxStack) << r.op;
+    EXPECT_GE(t->maxHeapBytes, r.heapBytes) << r.op;
+    if(0 != t->maxNsPerOp) { EXPECT_GE(t->maxNsPerOp, r.nsPerOp) << r.op; }
+    }
+}
+
+
+// Run each secure operation over its corpus, reporting and checking stack, heap and time.
+TEST(SecureOpBenchmark, EncodeDecodeCorpus)
+{
+    const char *const path = getenv("OTRL_SECURE_OP_THRESHOLDS");
+    std::vector<SOBM::Threshold> ts;
+    const bool haveThresholds = (NULL != path);
+    if(haveThresholds) { ASSERT_TRUE(SOBM::loadThresholds(path, ts)) << path; }
+
+    SFTD::FixedIDTX tx(SOBT::txID);
+    const SOBM::OpResult rEncode = SOBM::measure("encode", SOBT::nFrames, SOBT::repeats,
+        [&](const unsigned i) {
+            uint8_t buf[OTRadioLink::SecurableFrameHeader::maxSmallFrameSize];
+            return(0 != SOBT::encodeFrame(tx, i, buf, sizeof(buf)));
+            });
+    SOBT::check(rEncode, ts, haveThresholds);
+
+    const SOBM::OpResult rBeacon = SOBM::measure("generateSecureBeacon", sizeof(SOBT::beaconIls), SOBT::repeats,
+        [&](const unsigned i) {
+            uint8_t _buf[OTRadioLink::SecurableFrameHeader::maxSmallFrameSize];
+            OTRadioLink::OTBuf_t buf(_buf, sizeof(_buf));
+            uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encode_total_scratch_usage_OTAESGCM_2p0];
+            OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+            return(0 != tx.generateSecureBeacon(buf, SOBT::beaconIls[i], SFTD::enc, sW, SOBT::key));
+            });
+    SOBT::check(rBeacon, ts, haveThresholds);
+
+    const SOBM::OpResult rValve = SOBM::measure("encodeValveFrame", SOBT::nValves, SOBT::repeats,
+        [&](const unsigned i) {
+            uint8_t buf[OTRadioLink::SecurableFrameHeader::maxSmallFrameSize];
+            // Body: valve %, stats flag, then any JSON, as the caller lays it out.
+            uint8_t body[OTRadioLink::ENC_BODY_SMALL_FIXED_CTEXT_SIZE + 2] = {};
+            strcpy((char *)body + 2, SOBT::valves[i].json);
+            uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encodeValveFrame_total_scratch_usage_OTAESGCM_2p0];
+            OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+            OTRadioLink::OTEncodeData_T fd(body, sizeof(body), buf, sizeof(buf));
+            return(0 != tx.encodeValveFrame(fd, 4, SOBT::valves[i].valvePC, SFTD::enc, sW, SOBT::key));
+            });
+    SOBT::check(rValve, ts, haveThresholds);
+
+    // Build the decode corpus outside the measurement.
+    uint8_t encoded[SOBT::nFrames][OTRadioLink::SecurableFrameHeader::maxSmallFrameSize];
+    uint8_t encodedLen[SOBT::nFrames];
+    for(unsigned i = 0; i < SOBT::nFrames; ++i)
+        {
+        encodedLen[i] = SOBT::encodeFrame(tx, i, encoded[i], sizeof(encoded[i]));
+        ASSERT_NE(0, encodedLen[i]) << i;
+        }
+    SFTD::SingleNodeRX rx(SOBT::txID);
+    const SOBM::OpResult rDecode = SOBM::measure("decode", SOBT::nFrames, SOBT::repeats,
+        [&](const unsigned i) {
+            uint8_t ptext[OTRadioLink::OTDecodeData_T::ptextLenMax];
+            OTRadioLink::OTDecodeData_T fd(encoded[i], ptext);
+            if(0 == fd.sfh.decodeHeader(encoded[i], encodedLen[i])) { return(false); }
+            uint8_t workspace[OTRadioLink::SimpleSecureFrame32or0BodyRXBase::decode_total_scratch_usage_OTAESGCM_3p0 + SFTD::decWorkspace];
+            OTV0P2BASE::ScratchSpaceL sW(workspace, sizeof(workspace));
+            return((0 != rx.decode(fd, SFTD::dec, sW, SOBT::key)) && (SOBT::frames[i].bodyLen == fd.ptextLen));
+            });
+    SOBT::check(rDecode, ts, haveThresholds);
+}
@@ -0,0 +1,254 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2016
+*/
+
+/*
+ * Tests of the RAM RX message counter cache for secure frames.
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <OTRadioLink.h>
+
+
+// Check basic get/set/advance behaviour within a reservation.
+TEST(SecureRXMsgCtrCache, AdvanceWithinReservation)
+{
+    OTRadioLink::SimpleSecureRXMsgCtrCache<2, 4> cache;
+    uint8_t c[6];
+    EXPECT_FALSE(cache.get(0, c));
+    EXPECT_FALSE(cache.get(2, c));
+    const uint8_t base[6] = { 0, 0, 1, 0, 0, 0xfe };
+    // Nothing reserved ahead: no RAM-only advance possible.
+    cache.set(0, base, 0);
+    ASSERT_TRUE(cache.get(0, c));
+    EXPECT_EQ(0, memcmp(base, c, 6));
+    uint8_t next[6] = { 0, 0, 1, 0, 0, 0xff };
+    EXPECT_FALSE(cache.advanceInRAM(0, next));
+    // Reserve 4 ahead, ie up to ...01:00:00:02 persisted.
+    cache.set(0, base, 4);
+    EXPECT_TRUE(cache.advanceInRAM(0, next));
+    ASSERT_TRUE(cache.get(0, c));
+    EXPECT_EQ(0, memcmp(next, c, 6));
+    // Same value again (replay) is refused.
+    EXPECT_FALSE(cache.advanceInRAM(0, next));
+    // A jump of two across the byte boundary is accepted, to the reservation.
+    const uint8_t skip[6] = { 0, 0, 1, 0, 1, 1 };
+    EXPECT_TRUE(cache.advanceInRAM(0, skip));
+    const uint8_t last[6] = { 0, 0, 1, 0, 1, 2 };
+    EXPECT_TRUE(cache.advanceInRAM(0, last));
+    // Beyond the reservation must be persisted first.
+    const uint8_t beyond[6] = { 0, 0, 1, 0, 1, 3 };
+    EXPECT_FALSE(cache.advanceInRAM(0, beyond));
+    ASSERT_TRUE(cache.get(0, c));
+    EXPECT_EQ(0, memcmp(last, c, 6));
+    // Other slot unaffected; invalidation and clearing work.
+    EXPECT_FALSE(cache.get(1, c));
+    cache.set(1, base, 1);
+    cache.invalidate(0);
+    EXPECT_FALSE(cache.get(0, c));
+    EXPECT_TRUE(cache.get(1, c));
+    cache.clear();
+    EXPECT_FALSE(cache.get(1, c));
+}
+
+// Simulate a receiver persisting reservations as the V0p2 RX implementation does,
+// and check that after a 'reset' (losing the cache) no previously-accepted counter is accepted again,
+// while EEPROM writes are reduced by the reservation interval.
+TEST(SecureRXMsgCtrCache, ReplaySafeAcrossReset)
+{
+    typedef OTRadioLink::SimpleSecureRXMsgCtrCache<1> cache_t;
+    uint8_t persisted[6] = {};
+    int writes = 0;
+    cache_t cache;
+    // Accept a counter as authAndUpdateRXMsgCtr() does; false if rejected.
+    auto accept = [&](const uint8_t *newCounter) -> bool {
+        uint8_t last[6];
+        if(!cache.get(0, last)) { memcpy(last, persisted, 6); cache.set(0, last, 0); }
+        if(OTRadioLink::SimpleSecureFrame32or0BodyRXBase::msgcountercmp(newCounter, last) <= 0) { return(false); }
+        if(cache.advanceInRAM(0, newCounter)) { return(true); }
+        uint8_t reserved[6];
+        memcpy(reserved, newCounter, 6);
+        const uint8_t ahead = OTRadioLink::SimpleSecureFrame32or0BodyRXBase::msgcounteradd(reserved, cache.interval) ? cache.interval : 0;
+        memcpy(persisted, reserved, 6);
+        ++writes;
+        cache.set(0, newCounter, ahead);
+        return(true);
+        };
+    uint8_t ctr[6] = { 0, 0, 0, 0, 0, 0 };
+    const int n = 100;
+    for(int i = 0; i < n; ++i)
+        {
+        ASSERT_TRUE(OTRadioLink::SimpleSecureFrame32or0BodyRXBase::msgcounteradd(ctr, 1));
+        ASSERT_TRUE(accept(ctr));
+        }
+    EXPECT_EQ((n + cache_t::interval) / (cache_t::interval + 1), writes);
+    // Reset: lose RAM state.
+    cache.clear();
+    // Every counter accepted so far must be rejected.
+    uint8_t old[6] = {};
+    for(int i = 0; i < n; ++i)
+        {
+        ASSERT_TRUE(OTRadioLink::SimpleSecureFrame32or0BodyRXBase::msgcounteradd(old, 1));
+        EXPECT_FALSE(accept(old));
+        }
+    // A counter past the reservation is accepted.
+    uint8_t fresh[6];
+    memcpy(fresh, persisted, 6);
+    ASSERT_TRUE(OTRadioLink::SimpleSecureFrame32or0BodyRXBase::msgcounteradd(fresh, 1));
+    EXPECT_TRUE(accept(fresh));
+}
+
+// Check that late counters within the replay window are accepted exactly once,
+// and that nothing below the highest is accepted when the window state is unknown.
+TEST(SecureRXMsgCtrCache, ReplayWindow)
+{
+    typedef OTRadioLink::SimpleSecureRXMsgCtrCache<1, 4, 8> cache_t;
+    cache_t cache;
+    const uint8_t base[6] = { 0, 0, 0, 0, 0, 20 };
+    // Freshly loaded: all below the base counts as seen.
+    cache.set(0, base, 4);
+    const uint8_t c19[6] = { 0, 0, 0, 0, 0, 19 };
+    EXPECT_FALSE(cache.inReplayWindow(0, c19));
+    EXPECT_FALSE(cache.inReplayWindow(0, base));
+    // Skip 21 and 22 (eg frames still on their way via a relay).
+    const uint8_t c23[6] = { 0, 0, 0, 0, 0, 23 };
+    ASSERT_TRUE(cache.advanceInRAM(0, c23));
+    const uint8_t c21[6] = { 0, 0, 0, 0, 0, 21 };
+    const uint8_t c22[6] = { 0, 0, 0, 0, 0, 22 };
+    EXPECT_FALSE(cache.inReplayWindow(0, base));
+    EXPECT_FALSE(cache.inReplayWindow(0, c23));
+    EXPECT_TRUE(cache.inReplayWindow(0, c21));
+    EXPECT_TRUE(cache.acceptInReplayWindow(0, c22));
+    EXPECT_FALSE(cache.acceptInReplayWindow(0, c22));
+    // Highest is unchanged by late arrivals.
+    uint8_t c[6];
+    ASSERT_TRUE(cache.get(0, c));
+    EXPECT_EQ(0, memcmp(c23, c, 6));
+    // Move past the reservation via set(), as after persisting: the window slides, keeping 21 unseen.
+    const uint8_t c25[6] = { 0, 0, 0, 0, 0, 25 };
+    cache.set(0, c25, 4);
+    EXPECT_TRUE(cache.acceptInReplayWindow(0, c21));
+    EXPECT_FALSE(cache.inReplayWindow(0, c21));
+    EXPECT_FALSE(cache.inReplayWindow(0, c22));
+    EXPECT_FALSE(cache.inReplayWindow(0, c23));
+    const uint8_t c24[6] = { 0, 0, 0, 0, 0, 24 };
+    EXPECT_TRUE(cache.inReplayWindow(0, c24));
+    // A jump beyond the window leaves only the skipped counters within it acceptable.
+    const uint8_t c40[6] = { 0, 0, 0, 0, 0, 40 };
+    cache.set(0, c40, 0);
+    EXPECT_FALSE(cache.inReplayWindow(0, c24));
+    const uint8_t c31[6] = { 0, 0, 0, 0, 0, 31 };
+    const uint8_t c32[6] = { 0, 0, 0, 0, 0, 32 };
+    EXPECT_FALSE(cache.inReplayWindow(0, c31));
+    EXPECT_TRUE(cache.inReplayWindow(0, c32));
+    // After a reset (cache lost) nothing below the reloaded value is accepted.
+    cache.clear();
+    EXPECT_FALSE(cache.inReplayWindow(0, c32));
+    cache.set(0, c40, 0);
+    EXPECT_FALSE(cache.acceptInReplayWindow(0, c32));
+}
+
+// Stand-in for the non-volatile RX counter store.
+namespace SRXMC {
+static uint8_t persisted[6];
+static bool persistFails;
+static int persists;
+static bool persist(const uint8_t slot, const uint8_t *const counter)
+    {
+    if((0 != slot) || persistFails) { return(false); }
+    memcpy(persisted, counter, sizeof(persisted));
+    ++persists;
+    return(true);
+    }
+}
+
+// Check that acceptAndPersist() (as used by authAndUpdateRXMsgCtr())
+// only persists when past the reservation,
+// that a late counter skipped before a persist is still accepted (once) after it,
+// and that a failed persist drops the entry so that it is reloaded.
+TEST(SecureRXMsgCtrCache, ReplayWindowKeptAcrossPersist)
+{
+    typedef OTRadioLink::SimpleSecureRXMsgCtrCache<1, 4, 8> cache_t;
+    cache_t cache;
+    const uint8_t c20[6] = { 0, 0, 0, 0, 0, 20 };
+    memcpy(SRXMC::persisted, c20, 6);
+    SRXMC::persistFails = false;
+    SRXMC::persists = 0;
+    // Not loaded: rejected without persisting.
+    const uint8_t c21[6] = { 0, 0, 0, 0, 0, 21 };
+    EXPECT_FALSE(cache.acceptAndPersist(0, c21, SRXMC::persist));
+    EXPECT_EQ(0, SRXMC::persists);
+    // Loaded as getLastRXMsgCtr() does, with nothing reserved ahead.
+    cache.set(0, SRXMC::persisted, 0);
+    const uint8_t c22[6] = { 0, 0, 0, 0, 0, 22 };
+    const uint8_t c23[6] = { 0, 0, 0, 0, 0, 23 };
+    // First frame persists a reservation (21+4); 22 is then skipped without persisting.
+    ASSERT_TRUE(cache.acceptAndPersist(0, c21, SRXMC::persist));
+    EXPECT_EQ(1, SRXMC::persists);
+    EXPECT_EQ(25, SRXMC::persisted[5]);
+    ASSERT_TRUE(cache.acceptAndPersist(0, c23, SRXMC::persist));
+    EXPECT_EQ(1, SRXMC::persists);
+    // Past the reservation so persisted again.
+    const uint8_t c27[6] = { 0, 0, 0, 0, 0, 27 };
+    const uint8_t c26[6] = { 0, 0, 0, 0, 0, 26 };
+    ASSERT_TRUE(cache.acceptAndPersist(0, c27, SRXMC::persist));
+    EXPECT_EQ(2, SRXMC::persists);
+    EXPECT_EQ(31, SRXMC::persisted[5]);
+    // The late frames from before the persist are still accepted, exactly once.
+    EXPECT_TRUE(cache.acceptAndPersist(0, c22, SRXMC::persist));
+    EXPECT_FALSE(cache.acceptAndPersist(0, c22, SRXMC::persist));
+    EXPECT_TRUE(cache.acceptAndPersist(0, c26, SRXMC::persist));
+    EXPECT_FALSE(cache.acceptAndPersist(0, c26, SRXMC::persist));
+    EXPECT_FALSE(cache.acceptAndPersist(0, c21, SRXMC::persist));
+    EXPECT_FALSE(cache.acceptAndPersist(0, c23, SRXMC::persist));
+    EXPECT_FALSE(cache.acceptAndPersist(0, c27, SRXMC::persist));
+    EXPECT_EQ(2, SRXMC::persists);
+    // A failed persist rejects the frame and drops the RAM state,
+    // so the window is lost and the value is reloaded from what was persisted.
+    const uint8_t c33[6] = { 0, 0, 0, 0, 0, 33 };
+    const uint8_t c32[6] = { 0, 0, 0, 0, 0, 32 };
+    SRXMC::persistFails = true;
+    EXPECT_FALSE(cache.acceptAndPersist(0, c33, SRXMC::persist));
+    uint8_t c[6];
+    EXPECT_FALSE(cache.get(0, c));
+    SRXMC::persistFails = false;
+    cache.set(0, SRXMC::persisted, 0);
+    EXPECT_FALSE(cache.acceptAndPersist(0, c26, SRXMC::persist));
+    EXPECT_TRUE(cache.acceptAndPersist(0, c33, SRXMC::persist));
+    EXPECT_EQ(37, SRXMC::persisted[5]);
+    // Only counters above the reloaded (reserved) value are then in the window.
+    const uint8_t c31[6] = { 0, 0, 0, 0, 0, 31 };
+    EXPECT_FALSE(cache.acceptAndPersist(0, c31, SRXMC::persist));
+    EXPECT_TRUE(cache.acceptAndPersist(0, c32, SRXMC::persist));
+    EXPECT_FALSE(cache.acceptAndPersist(0, c32, SRXMC::persist));
+}
+
+// With the default (no) window only increasing counters are accepted, as before.
+TEST(SecureRXMsgCtrCache, NoReplayWindowByDefault)
+{
+    OTRadioLink::SimpleSecureRXMsgCtrCache<1> cache;
+    const uint8_t base[6] = { 0, 0, 0, 0, 0, 20 };
+    cache.set(0, base, 16);
+    const uint8_t c23[6] = { 0, 0, 0, 0, 0, 23 };
+    ASSERT_TRUE(cache.advanceInRAM(0, c23));
+    const uint8_t c21[6] = { 0, 0, 0, 0, 0, 21 };
+    EXPECT_FALSE(cache.acceptInReplayWindow(0, c21));
+}
@@ -0,0 +1,164 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Tests of the capacity-aware stats TX interval and hub backpressure.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <gtest/gtest.h>
+#include <OTRadioLink.h>
+
+TEST(StatsTXRate,beaconBody)
+{
+    uint8_t body[OTRadioLink::BACKPRESSURE_BEACON_BODY_BYTES];
+    EXPECT_EQ(0, OTRadioLink::encodeBackpressureBeacon(body, 1, 7));
+    ASSERT_EQ(2, OTRadioLink::encodeBackpressureBeacon(body, sizeof(body), 200));
+    uint8_t level = 0;
+    EXPECT_TRUE(OTRadioLink::decodeBackpressureBeacon(body, sizeof(body), level));
+    EXPECT_EQ(200, level);
+    EXPECT_FALSE(OTRadioLink::decodeBackpressureBeacon(body, 1, level));
+    body[0] = OTRadioLink::TXSLOT_BEACON_FORMAT;
+    EXPECT_FALSE(OTRadioLink::decodeBackpressureBeacon(body, sizeof(body), level));
+    EXPECT_FALSE(OTRadioLink::decodeBackpressureBeacon(NULL, 2, level));
+}
+
+// Losses or airtime saturate the level; it rises at once and decays gradually.
+TEST(StatsTXRate,hubBackpressure)
+{
+    OTRadioLink::OTHubBackpressure h;
+    EXPECT_EQ(0, h.getLevel());
+    // Quiet: 10 frames, none lost, 1% busy.
+    EXPECT_EQ(25, h.update(10, 0, 600, 60000));
+    // Few frames without losses is not pressure.
+    EXPECT_EQ(12, h.update(3, 0, 0, 60000));
+    // 5% lost is half way.
+    EXPECT_EQ(127, h.update(95, 5, 0, 60000));
+    // 10% busy saturates.
+    EXPECT_EQ(255, h.update(10, 0, 6000, 60000));
+    EXPECT_EQ(255, h.update(10, 0, 60000, 60000));
+    // Decays by half the difference each window.
+    EXPECT_EQ(127, h.update(0, 0, 0, 60000));
+    EXPECT_EQ(63, h.update(0, 0, 0, 60000));
+    h.reset();
+    EXPECT_EQ(0, h.getLevel());
+}
+
+// From channel stats: deltas between snapshots, including counter wrap.
+TEST(StatsTXRate,hubBackpressureFromStats)
+{
+    OTRadioLink::OTHubBackpressure h;
+    OTRadioLink::OTRadioChannelStats s;
+    s.clear();
+    s.rxFrames = 0xfffffff0UL;
+    s.rxDropped = 0xfffe;
+    EXPECT_EQ(0, h.update(s, 100, 60000));
+    // 32 frames heard, plus 2 dropped and 2 CRC errors: ~11% lost, ~6% busy.
+    s.rxFrames += 32;
+    s.rxDropped = 0;
+    s.rxCRCErrors = 2;
+    EXPECT_EQ(255, h.update(s, 100, 60000));
+    // Then 20 frames cleanly, ~3% busy, halving back.
+    s.rxFrames += 20;
+    EXPECT_EQ(170, h.update(s, 100, 60000));
+}
+
+// The interval grows while nothing changes and stretches with backpressure, to the maximum.
+TEST(StatsTXRate,interval)
+{
+    OTRadioLink::StatsTXRateController c(4, 60);
+    EXPECT_TRUE(c.isDue(0, false));
+    EXPECT_EQ(4, c.getInterval(false));
+    c.sent(0, true);
+    EXPECT_FALSE(c.isDue(3, true));
+    EXPECT_TRUE(c.isDue(4, true));
+    c.sent(4, false);
+    EXPECT_EQ(8, c.getInterval(false));
+    EXPECT_EQ(4, c.getInterval(true));
+    c.sent(12, false);
+    c.sent(28, false);
+    c.sent(60, false);
+    EXPECT_EQ(60, c.getInterval(false));
+    c.sent(120, false);
+    EXPECT_EQ(60, c.getInterval(false));
+    // A change resets the growth.
+    c.sent(121, true);
+    EXPECT_EQ(4, c.getInterval(false));
+    // Saturated hub: ~5x.
+    c.setBackpressure(255);
+    EXPECT_EQ(19, c.getInterval(true));
+    EXPECT_FALSE(c.isDue(121 + 18, true));
+    EXPECT_TRUE(c.isDue(121 + 19, true));
+    // Hint halves with each send without a fresh one.
+    c.sent(140, true);
+    EXPECT_EQ(127, c.getBackpressure());
+    EXPECT_EQ(11, c.getInterval(true));
+    // Never beyond the maximum.
+    c.setBackpressure(255);
+    c.sent(151, false);
+    c.sent(160, false);
+    c.setBackpressure(255);
+    EXPECT_EQ(60, c.getInterval(false));
+}
+
+// Power-save doublings stretch the interval, still within the maximum.
+TEST(StatsTXRate,powerSave)
+{
+    OTRadioLink::StatsTXRateController c(4, 60);
+    c.setPowerSaveShift(1);
+    EXPECT_EQ(8, c.getInterval(true));
+    c.setPowerSaveShift(2);
+    EXPECT_EQ(16, c.getInterval(true));
+    c.setPowerSaveShift(200);
+    EXPECT_EQ(60, c.getInterval(true));
+    c.setPowerSaveShift(0);
+    EXPECT_EQ(4, c.getInterval(true));
+}
+
+// A crowd of changing nodes offers less load once the hub reports its backpressure.
+TEST(StatsTXRate,crowd)
+{
+    static constexpr int n = 60;
+    OTRadioLink::OTHubBackpressure h;
+    std::vector<OTRadioLink::StatsTXRateController> nodes(n, OTRadioLink::StatsTXRateController(60, 3600));
+    // Each send takes 200ms of airtime; 1-minute windows, time in seconds.
+    // The hub starts reporting after 10 minutes.
+    uint32_t sendsUnloaded = 0;
+    uint32_t sendsLoaded = 0;
+    for(uint32_t minute = 0; minute < 30; ++minute)
+        {
+        uint32_t frames = 0;
+        for(uint32_t s = minute * 60; s < (minute + 1) * 60; ++s)
+            {
+            for(int i = 0; i < n; ++i)
+                {
+                const uint32_t t = s + uint32_t(i);
+                if(nodes[i].isDue(t, true)) { nodes[i].sent(t, true); ++frames; }
+                }
+            }
+        if((minute >= 5) && (minute < 10)) { sendsUnloaded += frames; }
+        else if(minute >= 25) { sendsLoaded += frames; }
+        const uint8_t level = h.update(frames, 0, frames * 200U, 60000);
+        if(minute >= 10) { for(int i = 0; i < n; ++i) { nodes[i].setBackpressure(level); } }
+        }
+    EXPECT_EQ(5U * n, sendsUnloaded);
+    EXPECT_NE(0, h.getLevel());
+    EXPECT_LT(sendsLoaded * 3, sendsUnloaded * 2);
+}
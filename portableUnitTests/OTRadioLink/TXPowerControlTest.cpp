@@ -0,0 +1,126 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Tests of per-destination adaptive TX power.
+ */
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTRadioLink.h>
+
+typedef OTRadioLink::OTRadioLink ORL;
+
+// Strong links step down slowly, weak or lossy links step up at once.
+TEST(TXPowerControl,steps)
+{
+    OTRadioLink::OTTXPowerController<2> c;
+    EXPECT_EQ(ORL::TXnormal, c.getPower(0));
+    EXPECT_EQ(ORL::TXnormal, c.getPower(1));
+    // Out of range is safe and at normal power.
+    c.reportMissed(2);
+    EXPECT_EQ(ORL::TXnormal, c.getPower(2));
+    // Needs a run of strong reports to step down.
+    for(int i = 0; i < 3; ++i) { c.reportRSSI(0, 200); }
+    EXPECT_EQ(ORL::TXnormal, c.getPower(0));
+    c.reportRSSI(0, 200);
+    EXPECT_EQ(ORL::TXquiet, c.getPower(0));
+    // A middling report restarts the run.
+    for(int i = 0; i < 3; ++i) { c.reportRSSI(0, 200); }
+    c.reportRSSI(0, 100);
+    for(int i = 0; i < 3; ++i) { c.reportRSSI(0, 200); }
+    EXPECT_EQ(ORL::TXquiet, c.getPower(0));
+    c.reportRSSI(0, 200);
+    EXPECT_EQ(ORL::TXmin, c.getPower(0));
+    // Not below the minimum.
+    for(int i = 0; i < 20; ++i) { c.reportRSSI(0, 255); }
+    EXPECT_EQ(ORL::TXmin, c.getPower(0));
+    // Destinations are independent.
+    EXPECT_EQ(ORL::TXnormal, c.getPower(1));
+    // Weak and missed each step up one, to the maximum.
+    c.reportRSSI(0, 10);
+    EXPECT_EQ(ORL::TXquiet, c.getPower(0));
+    c.reportMissed(0);
+    EXPECT_EQ(ORL::TXnormal, c.getPower(0));
+    c.reportMissed(0);
+    c.reportMissed(0);
+    c.reportMissed(0);
+    EXPECT_EQ(ORL::TXmax, c.getPower(0));
+    c.reset(0);
+    EXPECT_EQ(ORL::TXnormal, c.getPower(0));
+}
+
+// Limits and thresholds can be set, eg to avoid double TX or leave TXmin for pairing.
+TEST(TXPowerControl,limits)
+{
+    OTRadioLink::OTTXPowerController<1> c(150, 50, 1, ORL::TXquiet, ORL::TXloud);
+    c.reportRSSI(0, 149);
+    EXPECT_EQ(ORL::TXnormal, c.getPower(0));
+    c.reportRSSI(0, 150);
+    EXPECT_EQ(ORL::TXquiet, c.getPower(0));
+    c.reportRSSI(0, 150);
+    EXPECT_EQ(ORL::TXquiet, c.getPower(0));
+    c.reportRSSI(0, 50);
+    EXPECT_EQ(ORL::TXquiet, c.getPower(0));
+    c.reportRSSI(0, 49);
+    c.reportRSSI(0, 49);
+    c.reportRSSI(0, 49);
+    EXPECT_EQ(ORL::TXloud, c.getPower(0));
+}
+
+// On a simulated link the power settles where reports stay above weak,
+// and losses from a fade are recovered from.
+TEST(TXPowerControl,settles)
+{
+    OTRadioLink::OTTXPowerController<1> c;
+    // Received RSSI falls ~6 raw units (~3dB) per power step below TXnormal.
+    int pathRSSI = 160;
+    int lowSteps = 0;
+    for(int i = 0; i < 200; ++i)
+        {
+        if(150 == i) { pathRSSI = 70; } // Fade.
+        const int rssi = pathRSSI - 6 * (ORL::TXnormal - int(c.getPower(0)));
+        if(rssi < 55) { c.reportMissed(0); }
+        else { c.reportRSSI(0, uint8_t(rssi)); }
+        if(c.getPower(0) < ORL::TXnormal) { ++lowSteps; }
+        }
+    EXPECT_GT(lowSteps, 100);
+    // After the fade, back up to a level the destination hears above weak.
+    EXPECT_GT(c.getPower(0), ORL::TXmin);
+    EXPECT_GE(pathRSSI - 6 * (ORL::TXnormal - int(c.getPower(0))), 60);
+}
+
+// A power-save cap limits every link but keeps what was learnt.
+TEST(TXPowerControl,powerSave)
+{
+    OTRadioLink::OTTXPowerController<2> c;
+    c.reportMissed(0);
+    c.reportMissed(0);
+    EXPECT_EQ(ORL::TXmax, c.getPower(0));
+    c.setPowerSaveSteps(1);
+    EXPECT_EQ(ORL::TXloud, c.getPower(0));
+    EXPECT_EQ(ORL::TXnormal, c.getPower(1));
+    c.setPowerSaveSteps(3);
+    EXPECT_EQ(ORL::TXquiet, c.getPower(0));
+    EXPECT_EQ(ORL::TXquiet, c.getPower(1));
+    // Not below the minimum.
+    c.setPowerSaveSteps(200);
+    EXPECT_EQ(ORL::TXmin, c.getPower(0));
+    c.setPowerSaveSteps(0);
+    EXPECT_EQ(ORL::TXmax, c.getPower(0));
+}
@@ -0,0 +1,278 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Tests of hub-coordinated TX time slots.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <OTRadioLink.h>
+
+#include "SecureFrameTestDoubles.h"
+
+namespace TXST
+{
+// Association table large enough for a big hub; node i has ID { i, 0x80|i, 0x55, ... }.
+class BigAssociationTable final : public OTV0P2BASE::NodeAssociationTableBase
+    {
+    public:
+        static constexpr uint8_t maxSets = 64;
+        virtual bool set(uint8_t /*index*/, const uint8_t * /*src*/) override { return(false); }
+        virtual void get(uint8_t index, uint8_t *dest) const override
+            {
+            memset(dest, 0x55, OTV0P2BASE::OpenTRV_Node_ID_Bytes);
+            dest[0] = index;
+            dest[1] = uint8_t(0x80 | index);
+            }
+    };
+static void nodeID(const uint8_t index, uint8_t *const id) { BigAssociationTable().get(index, id); }
+
+// Feeds a client each beacon page in turn until it has its slot.
+static void syncClient(OTRadioLink::TXSlotClient &c, OTRadioLink::TXSlotBeaconPager &p,
+                       const uint8_t n, const uint8_t index, const uint32_t hubNowS, const uint32_t nodeNowS)
+    {
+    uint8_t id[OTV0P2BASE::OpenTRV_Node_ID_Bytes];
+    nodeID(index, id);
+    uint8_t body[OTRadioLink::TXSLOT_BEACON_MAX_BODY_BYTES];
+    for(uint8_t page = 0; (page <= n / OTRadioLink::TXSLOT_BEACON_MAX_ENTRIES) && !c.isSynced(nodeNowS); ++page)
+        {
+        const uint8_t len = p.nextPage(body, sizeof(body), n, hubNowS);
+        ASSERT_NE(0, len);
+        ASSERT_TRUE(c.onBeacon(body, len, id, nodeNowS));
+        }
+    }
+}
+
+// Pages of the beacon cover every association in turn and decode back.
+TEST(TXSlots,pager)
+{
+    TXST::BigAssociationTable t;
+    OTRadioLink::TXSlotBeaconPager p(t, 4);
+    uint8_t body[OTRadioLink::TXSLOT_BEACON_MAX_BODY_BYTES];
+    EXPECT_EQ(0, p.nextPage(body, sizeof(body), 0, 0));
+    EXPECT_EQ(0, p.nextPage(body, sizeof(body) - 1, 20, 0));
+    EXPECT_EQ(84U, p.getSuperframeS(20));
+    const uint8_t expectedFirst[] = { 0, 8, 16, 0 };
+    const uint8_t expectedN[] = { 8, 8, 4, 8 };
+    for(uint8_t page = 0; page < 4; ++page)
+        {
+        const uint8_t len = p.nextPage(body, sizeof(body), 20, 1000 + page);
+        ASSERT_EQ(OTRadioLink::TXSLOT_BEACON_HEADER_BYTES + 3 * expectedN[page], len);
+        OTRadioLink::TXSlotBeacon b;
+        ASSERT_TRUE(b.decode(body, len));
+        EXPECT_EQ(4, b.slotS);
+        EXPECT_EQ(20, b.nSlots);
+        EXPECT_EQ((1000U + page) % 84U, b.phaseS);
+        EXPECT_EQ(expectedFirst[page], b.firstIndex);
+        EXPECT_EQ(expectedN[page], b.nEntries);
+        for(uint8_t i = 0; i < b.nEntries; ++i)
+            {
+            uint8_t id[OTV0P2BASE::OpenTRV_Node_ID_Bytes];
+            TXST::nodeID(b.firstIndex + i, id);
+            EXPECT_EQ(0, memcmp(id, b.entries + 3 * i, 3));
+            }
+        }
+    // Hub's own view of the slots.
+    EXPECT_TRUE(p.isBeaconSlot(20, 84 * 10 + 3));
+    EXPECT_EQ(-1, p.getSlotAt(20, 84 * 10 + 3));
+    EXPECT_EQ(0, p.getSlotAt(20, 84 * 10 + 4));
+    EXPECT_EQ(19, p.getSlotAt(20, 84 * 10 + 83));
+}
+
+// Malformed bodies are rejected.
+TEST(TXSlots,decodeInvalid)
+{
+    OTRadioLink::TXSlotBeacon b;
+    const uint8_t ok[] = { OTRadioLink::TXSLOT_BEACON_FORMAT, 4, 2, 0, 11, 1, 1, 2, 3 };
+    EXPECT_TRUE(b.decode(ok, sizeof(ok)));
+    EXPECT_FALSE(b.decode(NULL, sizeof(ok)));
+    EXPECT_FALSE(b.decode(ok, 5));
+    EXPECT_FALSE(b.decode(ok, 8));
+    uint8_t bad[sizeof(ok)];
+    memcpy(bad, ok, sizeof(ok)); bad[0] = 0;
+    EXPECT_FALSE(b.decode(bad, sizeof(bad)));
+    memcpy(bad, ok, sizeof(ok)); bad[1] = 0;
+    EXPECT_FALSE(b.decode(bad, sizeof(bad)));
+    memcpy(bad, ok, sizeof(ok)); bad[2] = 0;
+    EXPECT_FALSE(b.decode(bad, sizeof(bad)));
+    // Phase must be within the 12s superframe.
+    memcpy(bad, ok, sizeof(ok)); bad[4] = 12;
+    EXPECT_FALSE(b.decode(bad, sizeof(bad)));
+    // Entries must be within the slots.
+    memcpy(bad, ok, sizeof(ok)); bad[5] = 2;
+    EXPECT_FALSE(b.decode(bad, sizeof(bad)));
+}
+
+// A node learns its slot and sends once per superframe in it, allowing for clock offset.
+TEST(TXSlots,clientTiming)
+{
+    TXST::BigAssociationTable t;
+    OTRadioLink::TXSlotBeaconPager p(t, 4);
+    OTRadioLink::TXSlotClient c;
+    // Node's clock is well behind the hub's; node is at index 10.
+    const uint32_t hubNowS = 100000;
+    const uint32_t nodeNowS = 7;
+    EXPECT_FALSE(c.isSynced(nodeNowS));
+    EXPECT_FALSE(c.txDue(nodeNowS));
+    EXPECT_EQ(0xffff, c.secondsUntilSlot(nodeNowS));
+    TXST::syncClient(c, p, 20, 10, hubNowS, nodeNowS);
+    ASSERT_TRUE(c.isSynced(nodeNowS));
+    EXPECT_EQ(10, c.getSlot());
+    // Slot 10 is [44,48) hub phase, usable [45,47).
+    const uint32_t offset = hubNowS - nodeNowS;
+    uint32_t sends = 0;
+    for(uint32_t s = nodeNowS; s < nodeNowS + 84 * 3; ++s)
+        {
+        const uint16_t hubPhase = uint16_t((s + offset) % 84);
+        EXPECT_EQ(c.getPhaseS(s), hubPhase);
+        EXPECT_EQ((hubPhase >= 45) && (hubPhase < 47), c.isInSlot(s)) << s;
+        EXPECT_EQ(hubPhase < 4, c.isBeaconSlot(s)) << s;
+        if(c.txDue(s)) { ++sends; EXPECT_EQ(45, hubPhase); }
+        }
+    EXPECT_EQ(3U, sends);
+    // Time to the slot and beacon, including across the end of the superframe.
+    const uint32_t atPhase50 = nodeNowS + ((50 + 84 - (hubNowS % 84)) % 84);
+    EXPECT_EQ(50, c.getPhaseS(atPhase50));
+    EXPECT_EQ(84 - 50 + 45, c.secondsUntilSlot(atPhase50));
+    EXPECT_EQ(84 - 50, c.secondsUntilBeaconSlot(atPhase50));
+    EXPECT_EQ(45 - 40, c.secondsUntilSlot(atPhase50 - 10));
+    // Without beacons the timing goes stale and the node falls back to its own.
+    const uint32_t stale = nodeNowS + OTRadioLink::TXSlotClient::MAX_MISSED_SUPERFRAMES * 84 + 1;
+    EXPECT_FALSE(c.isSynced(stale));
+    EXPECT_FALSE(c.isBeaconSlot(stale));
+    for(uint32_t s = stale; s < stale + 84; ++s) { EXPECT_FALSE(c.txDue(s)); }
+}
+
+// A node loses its slot when the hub's shape changes or another node is given it.
+TEST(TXSlots,clientReassigned)
+{
+    OTRadioLink::TXSlotClient c;
+    const uint8_t me[] = { 1, 2, 3 };
+    const uint8_t mine[] = { OTRadioLink::TXSLOT_BEACON_FORMAT, 4, 3, 0, 0, 0, 9, 9, 9, 1, 2, 3 };
+    EXPECT_TRUE(c.onBeacon(mine, sizeof(mine), me, 0));
+    EXPECT_EQ(1, c.getSlot());
+    // A page not mentioning the node leaves it in place.
+    const uint8_t other[] = { OTRadioLink::TXSLOT_BEACON_FORMAT, 4, 3, 0, 0, 2, 7, 7, 7 };
+    EXPECT_TRUE(c.onBeacon(other, sizeof(other), me, 16));
+    EXPECT_EQ(1, c.getSlot());
+    // Slot 1 given to someone else.
+    const uint8_t taken[] = { OTRadioLink::TXSLOT_BEACON_FORMAT, 4, 3, 0, 0, 1, 7, 7, 7 };
+    EXPECT_TRUE(c.onBeacon(taken, sizeof(taken), me, 32));
+    EXPECT_EQ(-1, c.getSlot());
+    EXPECT_FALSE(c.isSynced(32));
+    // Reassigned, then the superframe grows.
+    EXPECT_TRUE(c.onBeacon(mine, sizeof(mine), me, 48));
+    EXPECT_TRUE(c.isSynced(48));
+    const uint8_t grown[] = { OTRadioLink::TXSLOT_BEACON_FORMAT, 4, 4, 0, 0, 3, 7, 7, 7 };
+    EXPECT_TRUE(c.onBeacon(grown, sizeof(grown), me, 64));
+    EXPECT_FALSE(c.isSynced(64));
+    // Garbage is ignored.
+    EXPECT_FALSE(c.onBeacon(me, sizeof(me), me, 80));
+    c.reset();
+    EXPECT_EQ(-1, c.getSlot());
+}
+
+// With slots, many nodes with unrelated clocks never send in the same second;
+// with random timing over the same period collisions are expected.
+TEST(TXSlots,noCollisions)
+{
+    static constexpr uint8_t n = 50;
+    TXST::BigAssociationTable t;
+    OTRadioLink::TXSlotBeaconPager p(t, 4);
+    const uint16_t sf = p.getSuperframeS(n);
+    OTRadioLink::TXSlotClient c[n];
+    uint32_t offset[n];
+    uint32_t seed = 1;
+    for(uint8_t i = 0; i < n; ++i)
+        {
+        seed = seed * 1103515245U + 12345U;
+        offset[i] = seed >> 4;
+        }
+    const uint32_t hubStartS = 1234567;
+    for(uint8_t i = 0; i < n; ++i) { TXST::syncClient(c[i], p, n, i, hubStartS, hubStartS + offset[i]); }
+    // Run three superframes on the hub's clock, polling every 2s as a valve would.
+    uint8_t sendsPerSecond[3 * 204] = {};
+    ASSERT_EQ(204, sf);
+    uint32_t sends = 0;
+    for(uint32_t s = 0; s < 3U * sf; s += 2)
+        {
+        for(uint8_t i = 0; i < n; ++i)
+            {
+            if(c[i].txDue(hubStartS + s + offset[i])) { ++sendsPerSecond[s]; ++sends; }
+            }
+        }
+    EXPECT_EQ(3U * n, sends);
+    for(uint32_t s = 0; s < 3U * sf; ++s) { EXPECT_GE(1, sendsPerSecond[s]) << s; }
+    // Same number of sends at random even seconds: some share a second.
+    uint8_t randomSends[3 * 204] = {};
+    bool collided = false;
+    for(uint32_t k = 0; k < 3U * n; ++k)
+        {
+        seed = seed * 1103515245U + 12345U;
+        const uint32_t s = 2 * ((seed >> 8) % (3U * sf / 2));
+        if(0 != randomSends[s]++) { collided = true; }
+        }
+    EXPECT_TRUE(collided);
+}
+
+// The assignments round-trip through the hub's secure beacon.
+TEST(TXSlots,secureBeacon)
+{
+    static const uint8_t key[16] = {};
+    static const uint8_t hubID[8] = { 0x88, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87 };
+
+    TXST::BigAssociationTable t;
+    OTRadioLink::TXSlotBeaconPager p(t, 4);
+    uint8_t _body[OTRadioLink::ENC_BODY_SMALL_FIXED_CTEXT_SIZE];
+    const uint8_t bodyLen = p.nextPage(_body, sizeof(_body), 8, 4000);
+    ASSERT_EQ(OTRadioLink::TXSLOT_BEACON_MAX_BODY_BYTES, bodyLen);
+    OTRadioLink::OTBuf_t body(_body, sizeof(_body));
+    uint8_t _frame[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::generateSecureBeaconWithBodyMaxBufSize];
+    OTRadioLink::OTBuf_t frame(_frame, sizeof(_frame));
+    uint8_t encWorkspace[OTRadioLink::SimpleSecureFrame32or0BodyTXBase::encode_total_scratch_usage_OTAESGCM_2p0];
+    OTV0P2BASE::ScratchSpaceL sWEnc(encWorkspace, sizeof(encWorkspace));
+    SFTD::FixedIDTX tx(hubID);
+    const uint8_t frameLen = tx.generateSecureBeacon(frame, 4, body, bodyLen,
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleEnc_NULL_IMPL, sWEnc, key);
+    ASSERT_EQ(63, frameLen);
+
+    uint8_t ptext[OTRadioLink::OTDecodeData_T::ptextLenMax];
+    OTRadioLink::OTDecodeData_T fd(_frame, ptext);
+    ASSERT_NE(0, fd.sfh.decodeHeader(_frame, frameLen));
+    EXPECT_TRUE(fd.sfh.isSecure());
+    EXPECT_EQ(OTRadioLink::FTS_ALIVE, fd.sfh.fType & 0x7f);
+    uint8_t decWorkspace[OTRadioLink::SimpleSecureFrame32or0BodyRXBase::decode_total_scratch_usage_OTAESGCM_3p0 + 1];
+    OTV0P2BASE::ScratchSpaceL sWDec(decWorkspace, sizeof(decWorkspace));
+    SFTD::SingleNodeRX rx(hubID);
+    ASSERT_NE(0, rx.decode(fd, OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleDec_NULL_IMPL, sWDec, key));
+    ASSERT_EQ(bodyLen, fd.ptextLen);
+
+    uint8_t id[OTV0P2BASE::OpenTRV_Node_ID_Bytes];
+    TXST::nodeID(5, id);
+    OTRadioLink::TXSlotClient c;
+    EXPECT_TRUE(c.onBeacon(ptext, fd.ptextLen, id, 10));
+    EXPECT_TRUE(c.isSynced(10));
+    EXPECT_EQ(5, c.getSlot());
+    EXPECT_EQ((4000U % 36U), c.getPhaseS(10));
+
+    // Too long an ID to fit with the body.
+    EXPECT_EQ(0, tx.generateSecureBeacon(frame, 5, body, bodyLen,
+        OTRadioLink::fixed32BTextSize12BNonce16BTagSimpleEnc_NULL_IMPL, sWEnc, key));
+}
@@ -0,0 +1,89 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2018
+*/
+
+/*
+ * Tests of hub-side batching of frames into uplink messages.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <OTRadioLink.h>
+
+#include "SecureFrameTestDoubles.h"
+
+namespace UBT
+{
+static const uint8_t idA[OTV0P2BASE::OpenTRV_Node_ID_Bytes] = { 1, 1, 1, 1, 1, 1, 1, 1 };
+static const uint8_t idB[OTV0P2BASE::OpenTRV_Node_ID_Bytes] = { 2, 2, 2, 2, 2, 2, 2, 2 };
+static const uint8_t idC[OTV0P2BASE::OpenTRV_Node_ID_Bytes] = { 3, 3, 3, 3, 3, 3, 3, 3 };
+}
+
+// Check that frames from several nodes go out in one message, newest per node, on age.
+TEST(UplinkBatch, BatchAndAge)
+{
+    SFTD::CaptureRadio ul;
+    OTRadioLink::OTUplinkBatch<16, 3, 2> b(ul);
+    const uint8_t f1[] = { 'a', 'a' }, f2[] = { 'b', 'b', 'b' }, f3[] = { 'A' };
+    EXPECT_FALSE(b.tick());
+    EXPECT_TRUE(b.add(UBT::idA, f1, sizeof(f1)));
+    EXPECT_TRUE(b.add(UBT::idB, f2, sizeof(f2)));
+    // Newer frame from A replaces the older one, and goes after B.
+    EXPECT_TRUE(b.add(UBT::idA, f3, sizeof(f3)));
+    EXPECT_EQ(2, b.size());
+    EXPECT_EQ(6, b.bytes());
+    EXPECT_FALSE(b.tick());
+    EXPECT_EQ(0, ul.sent());
+    EXPECT_TRUE(b.tick());
+    ASSERT_EQ(1, ul.sent());
+    const uint8_t expected[] = { 3, 'b', 'b', 'b', 1, 'A' };
+    ASSERT_EQ(sizeof(expected), ul.lastLen());
+    EXPECT_EQ(0, memcmp(expected, ul.last(), sizeof(expected)));
+    EXPECT_TRUE(b.isEmpty());
+    EXPECT_FALSE(b.tick());
+    EXPECT_EQ(1, ul.sent());
+}
+
+// Check that the batch is sent first when a frame would not fit, by bytes or by nodes.
+TEST(UplinkBatch, FlushOnFull)
+{
+    SFTD::CaptureRadio ul;
+    OTRadioLink::OTUplinkBatch<8, 2, 100> b(ul);
+    const uint8_t f4[] = { 1, 2, 3, 4 }, f1[] = { 9 };
+    EXPECT_TRUE(b.add(UBT::idA, f4, sizeof(f4)));
+    // 5 + 5 bytes would exceed 8.
+    EXPECT_TRUE(b.add(UBT::idB, f4, sizeof(f4)));
+    EXPECT_EQ(1, ul.sent());
+    EXPECT_EQ(5, ul.lastLen());
+    EXPECT_EQ(1, b.size());
+    // Third node exceeds the node limit.
+    EXPECT_TRUE(b.add(UBT::idC, f1, sizeof(f1)));
+    EXPECT_EQ(7, b.bytes());
+    EXPECT_TRUE(b.add(UBT::idA, f1, sizeof(f1)));
+    EXPECT_EQ(2, ul.sent());
+    EXPECT_EQ(7, ul.lastLen());
+    // Never fits.
+    const uint8_t big[8] = { };
+    EXPECT_FALSE(b.add(UBT::idA, big, sizeof(big)));
+    EXPECT_FALSE(b.add(UBT::idA, f1, 0));
+    EXPECT_TRUE(b.flush());
+    EXPECT_EQ(3, ul.sent());
+    EXPECT_EQ(2, ul.lastLen());
+    EXPECT_TRUE(b.flush());
+    EXPECT_EQ(3, ul.sent());
+}
@@ -146,3 +146,51 @@ TEST(AmbientLight,setTypMinMax)
     EXPECT_FALSE(alm.isRoomVeryDark());
     EXPECT_EQ(0, alm.getDarkMinutes());
 }
+
+
+// Test adaptive sampling: backing off while stable or dark, and snapping back.
+TEST(AmbientLight,adaptiveSampling)
+{
+    OTV0P2BASE::SensorAmbientLightAdaptiveMock alm;
+    // Off by default: every poll samples.
+    for(int i = 0; i < 5; ++i) { EXPECT_TRUE(alm.sample(200)); alm.read(); }
+    EXPECT_EQ(1, alm.getSampleInterval());
+
+    alm.setAdaptiveSampling(true);
+    const uint8_t lit = 200;
+    ASSERT_LT(lit, 254 - OTV0P2BASE::SensorAmbientLightAdaptiveMock::epsilon);
+    // Stable and lit: interval doubles at each sample up to the cap.
+    EXPECT_TRUE(alm.sample(lit)); alm.read();
+    EXPECT_EQ(2, alm.getSampleInterval());
+    EXPECT_FALSE(alm.sample(lit+1)); alm.read();
+    EXPECT_TRUE(alm.sample(lit+1)); alm.read();
+    EXPECT_EQ(4, alm.getSampleInterval());
+    for(int i = 0; i < 3; ++i) { EXPECT_FALSE(alm.sample(lit)); alm.read(); }
+    EXPECT_TRUE(alm.sample(lit)); alm.read();
+    EXPECT_EQ(+OTV0P2BASE::SensorAmbientLightAdaptiveMock::MAX_SAMPLE_INTERVAL_STABLE, alm.getSampleInterval());
+
+    // A skipped poll holds the last value, and a change snaps back.
+    for(int i = 0; i < 3; ++i) { EXPECT_FALSE(alm.sample(0)); EXPECT_EQ(lit, alm.read()); }
+    EXPECT_TRUE(alm.sample(0)); EXPECT_EQ(0, alm.read());
+    EXPECT_EQ(1, alm.getSampleInterval());
+    EXPECT_TRUE(alm.isRoomDark());
+
+    // Dark: backs off further, while darkTicks still counts every poll.
+    const uint16_t dm0 = alm.getDarkMinutes();
+    int samples = 0;
+    for(int i = 0; i < 40; ++i) { if(alm.sample(1)) { ++samples; } alm.read(); }
+    EXPECT_EQ(dm0 + 40, alm.getDarkMinutes());
+    EXPECT_EQ(+OTV0P2BASE::SensorAmbientLightAdaptiveMock::MAX_SAMPLE_INTERVAL_DARK, alm.getSampleInterval());
+    EXPECT_GT(10, samples);
+
+    // An occupancy event snaps back to sampling on every poll.
+    alm.wakeSampling();
+    EXPECT_EQ(1, alm.getSampleInterval());
+    EXPECT_TRUE(alm.sample(1)); alm.read();
+
+    // Reset turns adaptive sampling off again.
+    alm.reset();
+    EXPECT_TRUE(alm.sample(0));
+    EXPECT_TRUE(alm.sample(0));
+    EXPECT_EQ(1, alm.getSampleInterval());
+}
@@ -0,0 +1,85 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Battery state estimate and policy tests.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#include "OTV0P2BASE_BatteryPolicy.h"
+
+typedef OTV0P2BASE::BatteryStateEstimator BSE;
+
+// A battery with a healthy resting voltage but growing sag under load
+// steps down through the levels, and recovers with hysteresis.
+TEST(BatteryPolicy,sagDrivesLevel)
+{
+    BSE b;
+    EXPECT_EQ(BSE::NORMAL, b.getLevel());
+    b.sampleUnderLoad(200);
+    EXPECT_EQ(0, b.getSagCV()) << "ignored before a resting sample";
+    b.sampleRest(280);
+    EXPECT_EQ(280, b.getRestCV());
+    EXPECT_EQ(BSE::NORMAL, b.getLevel());
+    b.sampleUnderLoad(270);
+    EXPECT_EQ(10, b.getSagCV());
+    EXPECT_EQ(BSE::NORMAL, b.getLevel());
+    EXPECT_EQ(1, b.getMotorDeadbandPrecisions());
+    // Sag grows as the battery tires.
+    for(int i = 0; i < 20; ++i) { b.sampleUnderLoad(255); }
+    EXPECT_NEAR(25, b.getSagCV(), 1);
+    EXPECT_EQ(BSE::CONSERVE, b.getLevel());
+    EXPECT_EQ(1, b.getStatsIntervalShift());
+    EXPECT_EQ(1, b.getTXPowerStepsDown());
+    EXPECT_EQ(3, b.getMotorDeadbandPrecisions());
+    EXPECT_EQ(150, b.getCLIListenMaxSCT(100, 200));
+    for(int i = 0; i < 20; ++i) { b.sampleUnderLoad(235); }
+    EXPECT_EQ(BSE::SURVIVE, b.getLevel());
+    EXPECT_EQ(6, b.getMotorDeadbandPrecisions());
+    EXPECT_EQ(125, b.getCLIListenMaxSCT(100, 200));
+    EXPECT_EQ(90, b.getCLIListenMaxSCT(100, 90));
+    // Just back over the threshold is not enough to relax.
+    for(int i = 0; i < 20; ++i) { b.sampleUnderLoad(BSE::SURVIVE_LOADED_cV + 2); }
+    EXPECT_EQ(BSE::SURVIVE, b.getLevel());
+    for(int i = 0; i < 20; ++i) { b.sampleUnderLoad(BSE::SURVIVE_LOADED_cV + BSE::HYSTERESIS_cV + 2); }
+    EXPECT_EQ(BSE::CONSERVE, b.getLevel());
+    for(int i = 0; i < 20; ++i) { b.sampleUnderLoad(275); }
+    EXPECT_EQ(BSE::NORMAL, b.getLevel());
+}
+
+// Mains power is always normal; sample() classifies by the motor's current claim.
+TEST(BatteryPolicy,mainsAndSampleClassification)
+{
+    BSE b;
+    b.sampleRest(330);
+    b.sampleUnderLoad(200);
+    EXPECT_EQ(BSE::NORMAL, b.getLevel());
+    b.reset();
+    b.sample(280);
+    EXPECT_EQ(280, b.getRestCV());
+    {
+    const OTV0P2BASE::CurrentBudgetClaim motor(OTV0P2BASE::CurrentLoad::MOTOR);
+    ASSERT_TRUE(motor.isGranted());
+    b.sample(250);
+    }
+    EXPECT_EQ(280, b.getRestCV());
+    EXPECT_EQ(30, b.getSagCV());
+    EXPECT_EQ(BSE::CONSERVE, b.getLevel());
+}
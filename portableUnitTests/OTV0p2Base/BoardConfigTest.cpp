@@ -0,0 +1,83 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Board descriptor tests.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#include "OTV0P2BASE_BoardConfig.h"
+
+// Descriptors are usable as template arguments.
+template<bool allowRX> struct RXPart { static constexpr uint8_t size = allowRX ? 64 : 0; };
+static_assert(0 == RXPart<OTV0P2BASE::BoardConfigREV7::radioRX>::size, "REV7 never listens");
+static_assert(64 == RXPart<OTV0P2BASE::BoardConfigREV8::radioRX>::size, "REV8 listens as a hub");
+
+// A learn button and stats TX alone.
+struct LearnOnly : OTV0P2BASE::BoardConfigDefaults
+    {
+    static constexpr bool singletonSchedule = false;
+    static constexpr bool statsTX = true;
+    static constexpr bool jsonOutput = false;
+    static constexpr bool boilerHub = false;
+    static constexpr bool statsRX = false;
+    static constexpr bool radioRX = false;
+    };
+
+// Fixups apply the implied features as OTV0p2_valve_ENABLE_fixups.h does.
+TEST(BoardConfig,fixups)
+{
+    typedef OTV0P2BASE::BoardConfig<LearnOnly> B;
+    EXPECT_TRUE(bool(B::singletonSchedule));
+    EXPECT_TRUE(bool(B::jsonOutput));
+    EXPECT_FALSE(bool(B::hubListen));
+    EXPECT_FALSE(bool(B::radioRX));
+    EXPECT_FALSE(bool(B::continuousRX));
+    // Untouched members pass through.
+    EXPECT_TRUE(bool(B::localTRV));
+}
+
+// Each REV descriptor keeps the key features of its macro config.
+TEST(BoardConfig,revs)
+{
+    typedef OTV0P2BASE::BoardConfigREV7 R7;
+    EXPECT_EQ(7, +R7::rev);
+    EXPECT_TRUE(bool(R7::localTRV));
+    EXPECT_TRUE(bool(R7::directMotorDrive));
+    EXPECT_FALSE(bool(R7::radioRX));
+    EXPECT_FALSE(bool(R7::continuousRX));
+    EXPECT_TRUE(bool(R7::secureFrames));
+    EXPECT_TRUE(bool(R7::jsonOutput));
+    typedef OTV0P2BASE::BoardConfigREV8 R8;
+    EXPECT_EQ(8, +R8::rev);
+    EXPECT_FALSE(bool(R8::localTRV));
+    EXPECT_TRUE(bool(R8::hubListen));
+    EXPECT_TRUE(bool(R8::continuousRX));
+    typedef OTV0P2BASE::BoardConfigREV10 R10;
+    EXPECT_EQ(10, +R10::rev);
+    EXPECT_TRUE(bool(R10::radioRX));
+    EXPECT_TRUE(bool(R10::continuousRX));
+    EXPECT_FALSE(bool(R10::boilerHub));
+    typedef OTV0P2BASE::BoardConfigREV11 R11;
+    EXPECT_EQ(11, +R11::rev);
+    EXPECT_FALSE(bool(R11::radioRX));
+    EXPECT_FALSE(bool(R11::continuousRX));
+    EXPECT_TRUE(bool(R11::statsTX));
+}
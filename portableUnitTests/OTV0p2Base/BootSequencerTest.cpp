@@ -0,0 +1,106 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2018
+*/
+
+/*
+ * Driver for BootSequencer tests.
+ */
+
+
+#include <stdint.h>
+#include <string>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_BootSequencer.h"
+
+
+namespace BSTest
+{
+// Step log, and how many more runs each step fails before succeeding.
+static std::string ran;
+struct S { char name; int failsLeft; };
+static bool step(void *const c)
+    {
+    S &s = *static_cast<S *>(c);
+    ran += s.name;
+    return(s.failsLeft-- <= 0);
+    }
+}
+
+// Critical steps and their dependencies run first; deferred ones later, one at a time.
+TEST(BootSequencer,criticalFirst)
+{
+    BSTest::ran.clear();
+    BSTest::S power{'p', 0}, osc{'o', 0}, seed{'s', 0}, rtc{'r', 0}, radio{'R', 0}, cal{'c', 0};
+    OTV0P2BASE::BootSequencer<> boot;
+    const int8_t p = boot.add(BSTest::step, &power, OTV0P2BASE::BOOT_CRITICAL);
+    const int8_t o = boot.add(BSTest::step, &osc, OTV0P2BASE::BOOT_DEFERRED, OTV0P2BASE::bootDep(p));
+    const int8_t s = boot.add(BSTest::step, &seed, OTV0P2BASE::BOOT_DEFERRED, OTV0P2BASE::bootDep(o));
+    const int8_t r = boot.add(BSTest::step, &rtc, OTV0P2BASE::BOOT_CRITICAL, OTV0P2BASE::bootDep(p));
+    boot.add(BSTest::step, &radio, OTV0P2BASE::BOOT_CRITICAL, OTV0P2BASE::bootDep(p));
+    boot.add(BSTest::step, &cal, OTV0P2BASE::BOOT_DEFERRED, OTV0P2BASE::bootDep(r) | OTV0P2BASE::bootDep(s));
+    EXPECT_EQ(6, boot.size());
+    EXPECT_TRUE(boot.runCritical());
+    EXPECT_EQ("prR", BSTest::ran);
+    EXPECT_FALSE(boot.isDone(o));
+    EXPECT_EQ(3, boot.pending());
+    EXPECT_TRUE(boot.runIdle());
+    EXPECT_TRUE(boot.runIdle());
+    EXPECT_TRUE(boot.runIdle());
+    EXPECT_FALSE(boot.runIdle());
+    EXPECT_EQ("prRosc", BSTest::ran);
+    EXPECT_TRUE(boot.isComplete());
+}
+
+// A deferred step needed by a critical one is promoted.
+TEST(BootSequencer,promotesDependencies)
+{
+    BSTest::ran.clear();
+    BSTest::S seed{'s', 0}, key{'k', 0};
+    OTV0P2BASE::BootSequencer<4> boot;
+    const int8_t s = boot.add(BSTest::step, &seed, OTV0P2BASE::BOOT_DEFERRED);
+    boot.add(BSTest::step, &key, OTV0P2BASE::BOOT_CRITICAL, OTV0P2BASE::bootDep(s));
+    EXPECT_TRUE(boot.runCritical());
+    EXPECT_EQ("sk", BSTest::ran);
+    EXPECT_TRUE(boot.isComplete());
+    // Forward and self dependencies are refused.
+    EXPECT_EQ(-1, boot.add(BSTest::step, &key, OTV0P2BASE::BOOT_DEFERRED, OTV0P2BASE::bootDep(2)));
+    EXPECT_EQ(-1, boot.add(NULL, &key, OTV0P2BASE::BOOT_DEFERRED));
+}
+
+// Unfinished steps are retried, without starving other deferred steps.
+TEST(BootSequencer,retries)
+{
+    BSTest::ran.clear();
+    BSTest::S radio{'R', 1}, diag{'d', 5}, seed{'s', 0};
+    OTV0P2BASE::BootSequencer<4> boot;
+    const int8_t R = boot.add(BSTest::step, &radio, OTV0P2BASE::BOOT_CRITICAL);
+    const int8_t d = boot.add(BSTest::step, &diag, OTV0P2BASE::BOOT_DEFERRED);
+    boot.add(BSTest::step, &seed, OTV0P2BASE::BOOT_DEFERRED);
+    EXPECT_FALSE(boot.runCritical());
+    EXPECT_EQ(1, boot.getRetries(R));
+    // Outstanding critical work comes first even in idle slots.
+    EXPECT_TRUE(boot.runIdle());
+    EXPECT_TRUE(boot.isCriticalDone());
+    EXPECT_TRUE(boot.runIdle());
+    EXPECT_TRUE(boot.runIdle());
+    EXPECT_EQ("RRds", BSTest::ran);
+    EXPECT_EQ(1, boot.getRetries(d));
+    while(boot.runIdle()) { }
+    EXPECT_TRUE(boot.isComplete());
+    EXPECT_EQ(5, boot.getRetries(d));
+}
@@ -0,0 +1,100 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for ButtonEventCapture tests.
+ */
+
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+
+
+// Active-low buttons: presses and releases come out in order with their times.
+TEST(ButtonEvents,basics)
+{
+    // Buttons on bits 0 and 5, pulled up.
+    OTV0P2BASE::ButtonEventCapture<4> c(0x21);
+    OTV0P2BASE::ButtonEvent e;
+    EXPECT_FALSE(c.pop(e));
+    // Released, and unwatched pins changing, give nothing.
+    EXPECT_EQ(0, c.captureFromISR(0xff, 10));
+    EXPECT_EQ(0, c.captureFromISR(0x21, 11));
+    EXPECT_EQ(0, c.available());
+    // Press bit 5.
+    EXPECT_EQ(0x20, c.captureFromISR(0x01, 20));
+    EXPECT_TRUE(c.isPressed(5));
+    EXPECT_FALSE(c.isPressed(0));
+    EXPECT_EQ(0x20, c.getPressedMask());
+    // Press bit 0 too.
+    EXPECT_EQ(0x01, c.captureFromISR(0x00, 30));
+    // Release both.
+    EXPECT_EQ(0, c.captureFromISR(0xff, 40));
+    EXPECT_EQ(0, c.getPressedMask());
+    EXPECT_EQ(4, c.available());
+    ASSERT_TRUE(c.pop(e));
+    EXPECT_EQ(5, e.button); EXPECT_TRUE(e.pressed); EXPECT_EQ(20U, e.ticks);
+    ASSERT_TRUE(c.pop(e));
+    EXPECT_EQ(0, e.button); EXPECT_TRUE(e.pressed); EXPECT_EQ(30U, e.ticks);
+    ASSERT_TRUE(c.pop(e));
+    EXPECT_EQ(0, e.button); EXPECT_FALSE(e.pressed); EXPECT_EQ(40U, e.ticks);
+    ASSERT_TRUE(c.pop(e));
+    EXPECT_EQ(5, e.button); EXPECT_FALSE(e.pressed);
+    EXPECT_FALSE(c.pop(e));
+}
+
+// Bounces within the lock-out are ignored, and a release hidden by it is caught later.
+TEST(ButtonEvents,debounce)
+{
+    // Active-high button on bit 2, 4-tick lock-out.
+    OTV0P2BASE::ButtonEventCapture<8> c(0x04, 0x04, 4);
+    EXPECT_EQ(0x04, c.captureFromISR(0x04, 100));
+    // Bounce.
+    EXPECT_EQ(0, c.captureFromISR(0x00, 101));
+    EXPECT_EQ(0, c.captureFromISR(0x04, 102));
+    EXPECT_EQ(0, c.captureFromISR(0x00, 103));
+    EXPECT_TRUE(c.isPressed(2));
+    EXPECT_EQ(1, c.available());
+    // Released during the lock-out: seen on the next call after it.
+    EXPECT_EQ(0, c.captureFromISR(0x00, 104));
+    EXPECT_FALSE(c.isPressed(2));
+    EXPECT_EQ(2, c.available());
+    // Lock-out is correct across the tick wrap.
+    EXPECT_EQ(0x04, c.captureFromISR(0x04, 0xfffffffeUL));
+    EXPECT_EQ(0, c.captureFromISR(0x00, 0x00000001UL));
+    EXPECT_TRUE(c.isPressed(2));
+    EXPECT_EQ(0, c.captureFromISR(0x00, 0x00000002UL));
+    EXPECT_FALSE(c.isPressed(2));
+}
+
+// Overflow keeps the oldest events and the state.
+TEST(ButtonEvents,overflow)
+{
+    OTV0P2BASE::ButtonEventCapture<2> c(0x01, 0, 0);
+    for(uint8_t i = 0; i < 5; ++i) { c.captureFromISR(uint8_t(i & 1), i); }
+    EXPECT_EQ(2, c.available());
+    EXPECT_EQ(3, c.getDropped());
+    // Five transitions from released ends pressed.
+    EXPECT_TRUE(c.isPressed(0));
+    OTV0P2BASE::ButtonEvent e;
+    ASSERT_TRUE(c.pop(e));
+    EXPECT_EQ(0U, e.ticks);
+    c.clearDropped();
+    EXPECT_EQ(0, c.getDropped());
+}
@@ -21,6 +21,8 @@ Author(s) / Copyright (s): Damon Hart-Davis 2016
  */
 
 #include <stdint.h>
+#include <algorithm>
+#include <vector>
 #include <gtest/gtest.h>
 #include <OTV0p2Base.h>
 
@@ -47,6 +49,38 @@ TEST(Stats,TempCompand)
     ASSERT_EQ(ui, OTV0P2BASE::expandTempC16(ub));
 }
 
+// Test that the bulk companding functions match the single-value ones.
+TEST(Stats,TempCompandBulk)
+{
+    const int16_t ui = OTV0P2BASE::NVByHourByteStatsBase::UNSET_INT;
+    // Spot checks at the range boundaries.
+    EXPECT_EQ(0, OTV0P2BASE::expandTempC16(0));
+    EXPECT_EQ(248, OTV0P2BASE::expandTempC16(31));
+    EXPECT_EQ(256, OTV0P2BASE::expandTempC16(32));
+    EXPECT_EQ(382, OTV0P2BASE::expandTempC16(95));
+    EXPECT_EQ(384, OTV0P2BASE::expandTempC16(96));
+    EXPECT_EQ(100<<4, OTV0P2BASE::expandTempC16(OTV0P2BASE::COMPRESSION_C16_CEIL_VAL_AFTER));
+    EXPECT_EQ(ui, OTV0P2BASE::expandTempC16(OTV0P2BASE::COMPRESSION_C16_CEIL_VAL_AFTER + 1));
+    // Every compressed value.
+    uint8_t c[256];
+    int16_t t[256];
+    for(int i = 0; i < 256; ++i) { c[i] = uint8_t(i); }
+    OTV0P2BASE::expandTempC16(c, t, 256);
+    for(int i = 0; i < 256; ++i) { ASSERT_EQ(OTV0P2BASE::expandTempC16(c[i]), t[i]) << i; }
+    // Every input from below 0C to above 100C, plus the extremes.
+    static const int n = 1800;
+    int16_t in[n];
+    uint8_t out[n];
+    for(int i = 0; i < n; ++i) { in[i] = int16_t(i - 100); }
+    in[0] = INT16_MIN;
+    in[n - 1] = INT16_MAX;
+    OTV0P2BASE::compressTempC16(in, out, n);
+    for(int i = 0; i < n; ++i) { ASSERT_EQ(OTV0P2BASE::compressTempC16(in[i]), out[i]) << in[i]; }
+    // Zero-length calls are harmless.
+    OTV0P2BASE::compressTempC16(in, NULL, 0);
+    OTV0P2BASE::expandTempC16(c, NULL, 0);
+}
+
 // Test handling of ByHourByteStats stats.
 //
 // Verify that the simple smoothing function never generates an out of range value.
@@ -62,6 +96,50 @@ TEST(ByHourByteStats,SmoothStatsValue)
         { EXPECT_EQ(i, OTV0P2BASE::NVByHourByteStatsBase::smoothStatsValue((uint8_t)i, (uint8_t)i)); }
 }
 
+// Test that the bulk smoothing kernel matches the firmware hourly update bit for bit
+// when given the rounding offsets that the firmware draws.
+TEST(ByHourByteStats,SmoothStatsBulk)
+{
+    typedef OTV0P2BASE::NVByHourByteStatsBase B;
+    // Kernel is stable, bounded and never unset.
+    for(int o = 0; o < 255; ++o)
+        for(int v = 0; v < 255; v += 7)
+            for(uint8_t r = 0; r < 8; ++r)
+                {
+                const uint8_t k = B::smoothStatsKernel(uint8_t(o), uint8_t(v), r);
+                EXPECT_LE(k, std::max(o, v));
+                EXPECT_GE(k, std::min(o, v));
+                if(o == v) { EXPECT_EQ(o, k); }
+                }
+    EXPECT_EQ(B::smoothStatsKernel(100, 200, 3), B::smoothStatsKernel(100, 200, 0xfb));
+
+    // Many values at once, including unset old and new values.
+    static constexpr size_t n = 1000;
+    std::vector<uint8_t> smoothed(n), values(n), offsets(n), expected(n);
+    for(size_t i = 0; i < n; ++i)
+        {
+        smoothed[i] = (0 == (i % 17)) ? B::UNSET_BYTE : uint8_t(random() % 255);
+        values[i] = (0 == (i % 23)) ? B::UNSET_BYTE : uint8_t(random() % 255);
+        if(0 == (i % 5)) { values[i] = smoothed[i]; }
+        }
+    // Firmware path, drawing rounding offsets only where it needs them.
+    OTV0P2BASE::_resetRNG8();
+    for(size_t i = 0; i < n; ++i)
+        {
+        if(B::UNSET_BYTE == values[i]) { expected[i] = smoothed[i]; continue; }
+        expected[i] = (B::UNSET_BYTE == smoothed[i]) ? values[i] : B::smoothStatsValue(smoothed[i], values[i]);
+        }
+    // Same offsets replayed.
+    OTV0P2BASE::_resetRNG8();
+    for(size_t i = 0; i < n; ++i)
+        {
+        const bool draws = (B::UNSET_BYTE != values[i]) && (B::UNSET_BYTE != smoothed[i]) && (values[i] != smoothed[i]);
+        offsets[i] = draws ? OTV0P2BASE::randRNG8() : uint8_t(random());
+        }
+    B::smoothStatsBulk(smoothed.data(), values.data(), offsets.data(), n);
+    EXPECT_EQ(expected, smoothed);
+}
+
 // Test some basic behaviour of the support/calc routines on emoty stats container.
 // In particular exercises failure paths as there are no valid stats sets.
 TEST(Stats, empty)
@@ -405,3 +483,315 @@ TEST(Stats, ByHourSimpleStatsUpdater)
     EXPECT_EQ(al01, BHSSU::ms.getByHourStatRTC(BHSSU::ms.STATS_SET_AMBLIGHT_BY_HOUR, BHSSU::ms.SPECIAL_HOUR_NEXT_HOUR));
     EXPECT_EQ(al01, BHSSU::ms.getByHourStatRTC(BHSSU::ms.STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED, BHSSU::ms.SPECIAL_HOUR_NEXT_HOUR));
 }
+
+// Test that the cached smoothed ambient light aggregates track a full rescan.
+namespace BHSSUCache
+    {
+    OTV0P2BASE::NVByHourByteStatsMock ms;
+    OTV0P2BASE::SensorAmbientLightAdaptiveMock ambLight;
+    OTV0P2BASE::ByHourSimpleStatsUpdaterSampleStats <
+        decltype(ms), &ms,
+        OTV0P2BASE::SimpleTSUint8Sensor, nullptr,
+        decltype(ambLight), &ambLight
+        > su;
+    }
+TEST(Stats, ByHourSimpleStatsUpdaterAmbLightCache)
+{
+    // Seed random() for use in simulator; --gtest_shuffle will force it to change.
+    srandom((unsigned) ::testing::UnitTest::GetInstance()->random_seed());
+
+    const uint8_t unset = OTV0P2BASE::NVByHourByteStatsBase::UNSET_BYTE;
+    const uint8_t set = OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED;
+    BHSSUCache::ms.zapStats();
+    BHSSUCache::su.reset();
+    EXPECT_EQ(unset, BHSSUCache::su.getAmbLightTypMin());
+    EXPECT_EQ(unset, BHSSUCache::su.getAmbLightTypMax());
+    EXPECT_EQ(unset, BHSSUCache::su.getAmbLightTypForHour(3));
+    EXPECT_EQ(unset, BHSSUCache::su.getAmbLightTypForHour(24));
+
+    // Stats written before the first query are picked up by the initial scan.
+    BHSSUCache::ms.setByHourStatSimple(set, 5, 17);
+    BHSSUCache::ms.setByHourStatSimple(set, 6, 90);
+    BHSSUCache::su.reset();
+    EXPECT_EQ(17, BHSSUCache::su.getAmbLightTypMin());
+    EXPECT_EQ(90, BHSSUCache::su.getAmbLightTypMax());
+
+    // Random hourly updates, including big swings to move the extremes both ways.
+    for(int i = 0; i < 2000; ++i)
+        {
+        const uint8_t hh = uint8_t(random() % 24);
+        const long r = random();
+        BHSSUCache::ambLight.set(uint8_t((r & 0x100) ? (r & 0xff) : ((r & 0x200) ? 0 : 254)));
+        BHSSUCache::su.sampleStats(true, hh);
+        ASSERT_EQ(BHSSUCache::ms.getMinByHourStat(set), BHSSUCache::su.getAmbLightTypMin()) << i;
+        ASSERT_EQ(BHSSUCache::ms.getMaxByHourStat(set), BHSSUCache::su.getAmbLightTypMax()) << i;
+        const uint8_t qh = uint8_t(random() % 24);
+        ASSERT_EQ(BHSSUCache::ms.getByHourStatSimple(set, qh), BHSSUCache::su.getAmbLightTypForHour(qh)) << i;
+        // Repeat query for the same hour hits the cache and is updated when that hour is written.
+        BHSSUCache::su.sampleStats(true, qh);
+        ASSERT_EQ(BHSSUCache::ms.getByHourStatSimple(set, qh), BHSSUCache::su.getAmbLightTypForHour(qh)) << i;
+        }
+}
+
+// Test that the occupancy predictions match scans of the smoothed occupancy stats.
+namespace BHSSUOccPred
+    {
+    OTV0P2BASE::NVByHourByteStatsMock ms;
+    // Simple settable percentage sensor standing in for occupancy.
+    OTV0P2BASE::HumiditySensorMock occupancy;
+    OTV0P2BASE::ByHourOccupancyPredictionCache pred;
+    OTV0P2BASE::ByHourSimpleStatsUpdaterSampleStats <
+        decltype(ms), &ms,
+        decltype(occupancy), &occupancy,
+        OTV0P2BASE::SimpleTSUint8Sensor, nullptr,
+        OTV0P2BASE::Sensor<int16_t>, nullptr,
+        OTV0P2BASE::SimpleTSUint8Sensor, nullptr,
+        2,
+        &pred
+        > su;
+    }
+TEST(Stats, ByHourOccupancyPredictionCache)
+{
+    // Seed random() for use in simulator; --gtest_shuffle will force it to change.
+    srandom((unsigned) ::testing::UnitTest::GetInstance()->random_seed());
+
+    const uint8_t set = OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR_SMOOTHED;
+    BHSSUOccPred::ms.zapStats();
+    BHSSUOccPred::su.reset();
+    EXPECT_FALSE(BHSSUOccPred::pred.isValid());
+    // Built at the first sample, with nothing likely occupied.
+    BHSSUOccPred::su.sampleStats(false, 0);
+    EXPECT_TRUE(BHSSUOccPred::pred.isValid());
+    EXPECT_EQ(0U, BHSSUOccPred::pred.getLikelyOccupiedBitmap());
+    EXPECT_EQ(0xff, BHSSUOccPred::pred.getNextLikelyOccupiedHour(3));
+    EXPECT_EQ(0, BHSSUOccPred::pred.getHoursLessOccupiedThan(3));
+
+    // Occupied only for the evening.
+    for(uint8_t hh = 0; hh < 24; ++hh)
+        {
+        BHSSUOccPred::occupancy.set(((hh >= 18) && (hh <= 22)) ? 80 : 5);
+        BHSSUOccPred::su.sampleStats(true, hh);
+        }
+    EXPECT_EQ(0x7cU << 16, BHSSUOccPred::pred.getLikelyOccupiedBitmap());
+    EXPECT_TRUE(BHSSUOccPred::pred.isLikelyOccupiedHour(18));
+    EXPECT_FALSE(BHSSUOccPred::pred.isLikelyOccupiedHour(17));
+    EXPECT_FALSE(BHSSUOccPred::pred.isLikelyOccupiedHour(24));
+    EXPECT_EQ(18, BHSSUOccPred::pred.getNextLikelyOccupiedHour(9));
+    EXPECT_EQ(20, BHSSUOccPred::pred.getNextLikelyOccupiedHour(19));
+    EXPECT_EQ(18, BHSSUOccPred::pred.getNextLikelyOccupiedHour(23));
+    EXPECT_EQ(0xff, BHSSUOccPred::pred.getNextLikelyOccupiedHour(24));
+    EXPECT_EQ(24, BHSSUOccPred::pred.getHoursLessOccupiedThan(0xff));
+
+    // Random hourly updates, including unset hours.
+    for(int i = 0; i < 500; ++i)
+        {
+        const uint8_t hh = uint8_t(random() % 24);
+        BHSSUOccPred::occupancy.set(uint8_t(random() % 101));
+        if(0 == (i % 37)) { BHSSUOccPred::ms.setByHourStatSimple(set, hh); BHSSUOccPred::su.reset(); }
+        else { BHSSUOccPred::su.sampleStats(true, hh); }
+        BHSSUOccPred::su.sampleStats(false, hh);
+        ASSERT_TRUE(BHSSUOccPred::pred.isValid());
+        for(uint8_t qh = 0; qh <= 24; ++qh)
+            {
+            const uint8_t expected = BHSSUOccPred::ms.countStatSamplesBelow(set, BHSSUOccPred::ms.getByHourStatSimple(set, qh));
+            ASSERT_EQ(expected, BHSSUOccPred::pred.getHoursLessOccupiedThan(qh)) << i;
+            }
+        }
+}
+
+namespace BHBSRC
+{
+// Mock counting reads from the backing store.
+class CountingStatsMock final : public OTV0P2BASE::NVByHourByteStatsMock
+{
+public:
+    mutable unsigned reads = 0;
+    virtual uint8_t getByHourStatSimple(uint8_t statsSet, uint8_t hh) const override
+        { ++reads; return(NVByHourByteStatsMock::getByHourStatSimple(statsSet, hh)); }
+};
+}
+
+// Test the read-through RAM cache in front of a stats store.
+TEST(Stats, ByHourByteStatsRAMCache)
+{
+    typedef OTV0P2BASE::NVByHourByteStatsBase B;
+    const uint8_t unset = B::UNSET_BYTE;
+    BHBSRC::CountingStatsMock backing;
+    for(uint8_t hh = 0; hh < 24; ++hh) { backing.setByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED, hh, uint8_t(hh * 3)); }
+    backing._setHour(5);
+    OTV0P2BASE::ByHourByteStatsRAMCache<(1U << B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED) | (1U << B::STATS_SET_OCCPC_BY_HOUR_SMOOTHED)> c(backing);
+    EXPECT_EQ(5, c.getHour());
+    // Repeated scans of a cached set hit the backing store once.
+    for(int i = 0; i < 5; ++i)
+        {
+        EXPECT_EQ(0, c.getMinByHourStat(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED));
+        EXPECT_EQ(69, c.getMaxByHourStat(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED));
+        EXPECT_EQ(15, c.getByHourStatRTC(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED));
+        }
+    EXPECT_EQ(24U, backing.reads);
+    // Uncached sets pass through.
+    c.getByHourStatSimple(B::STATS_SET_TEMP_BY_HOUR, 1);
+    EXPECT_EQ(25U, backing.reads);
+    EXPECT_EQ(unset, c.getByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED, 24));
+    // Writes go through and stay in step.
+    c.setByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED, 7, 200);
+    c.setByHourStatSimple(B::STATS_SET_OCCPC_BY_HOUR_SMOOTHED, 7, 50);
+    EXPECT_EQ(200, backing.getByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED, 7));
+    backing.reads = 0;
+    EXPECT_EQ(200, c.getMaxByHourStat(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED));
+    EXPECT_EQ(0U, backing.reads);
+    EXPECT_EQ(50, c.getByHourStatSimple(B::STATS_SET_OCCPC_BY_HOUR_SMOOTHED, 7));
+    EXPECT_EQ(24U, backing.reads);
+    // Direct writes to the backing store need invalidate().
+    backing.setByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED, 7, 1);
+    EXPECT_EQ(200, c.getByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED, 7));
+    c.invalidate();
+    EXPECT_EQ(1, c.getByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED, 7));
+    EXPECT_TRUE(c.zapStats());
+    EXPECT_EQ(unset, c.getByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED, 7));
+    // Caching nothing is a pass-through.
+    OTV0P2BASE::ByHourByteStatsRAMCache<0> n(backing);
+    n.setByHourStatSimple(B::STATS_SET_TEMP_BY_HOUR, 2, 9);
+    EXPECT_EQ(9, n.getByHourStatSimple(B::STATS_SET_TEMP_BY_HOUR, 2));
+}
+
+// Test that staged writes reach the backing store a few at a time, and are visible at once via the stager.
+namespace BHSSUStaged
+    {
+    OTV0P2BASE::NVByHourByteStatsMock backing;
+    OTV0P2BASE::ByHourByteStatsStagedWriter<> ms(backing);
+    OTV0P2BASE::SensorAmbientLightAdaptiveMock ambLight;
+    OTV0P2BASE::TemperatureC16Mock tempC16;
+    OTV0P2BASE::HumiditySensorMock rh;
+    OTV0P2BASE::ByHourSimpleStatsUpdaterSampleStats <
+        decltype(ms), &ms,
+        OTV0P2BASE::SimpleTSUint8Sensor, nullptr,
+        decltype(ambLight), &ambLight,
+        decltype(tempC16), &tempC16,
+        decltype(rh), &rh,
+        1
+        > su;
+    }
+TEST(Stats, ByHourByteStatsStagedWriter)
+{
+    typedef OTV0P2BASE::NVByHourByteStatsBase B;
+    const uint8_t unset = B::UNSET_BYTE;
+    BHSSUStaged::ms.zapStats();
+    BHSSUStaged::su.reset();
+    BHSSUStaged::backing._setHour(9);
+    EXPECT_EQ(9, BHSSUStaged::ms.getHour());
+    BHSSUStaged::ambLight.set(100);
+    BHSSUStaged::tempC16.set(20 << 4);
+    BHSSUStaged::rh.set(50);
+    const uint8_t temp = OTV0P2BASE::compressTempC16(20 << 4);
+
+    // The full sample stages a last and a smoothed value for each of the three sets, writing nothing.
+    BHSSUStaged::su.sampleStats(true, 9);
+    EXPECT_EQ(6, BHSSUStaged::ms.getPendingCount());
+    EXPECT_EQ(unset, BHSSUStaged::backing.getByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR, 9));
+    EXPECT_EQ(100, BHSSUStaged::ms.getByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR, 9));
+    EXPECT_EQ(100, BHSSUStaged::ms.getByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED, 9));
+    EXPECT_EQ(100, BHSSUStaged::su.getAmbLightTypForHour(9));
+    EXPECT_EQ(temp, BHSSUStaged::ms.getByHourStatSimple(B::STATS_SET_TEMP_BY_HOUR_SMOOTHED, 9));
+    EXPECT_EQ(50, BHSSUStaged::ms.getByHourStatRTC(B::STATS_SET_RHPC_BY_HOUR));
+
+    // Two writes per commit, each last value before its smoothed value.
+    EXPECT_FALSE(BHSSUStaged::ms.commitPending());
+    EXPECT_EQ(4, BHSSUStaged::ms.getPendingCount());
+    EXPECT_EQ(100, BHSSUStaged::backing.getByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR, 9));
+    EXPECT_EQ(100, BHSSUStaged::backing.getByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED, 9));
+    EXPECT_EQ(unset, BHSSUStaged::backing.getByHourStatSimple(B::STATS_SET_TEMP_BY_HOUR, 9));
+    EXPECT_FALSE(BHSSUStaged::ms.commitPending(1));
+    EXPECT_EQ(temp, BHSSUStaged::backing.getByHourStatSimple(B::STATS_SET_TEMP_BY_HOUR, 9));
+    EXPECT_EQ(unset, BHSSUStaged::backing.getByHourStatSimple(B::STATS_SET_TEMP_BY_HOUR_SMOOTHED, 9));
+    EXPECT_FALSE(BHSSUStaged::ms.commitPending());
+    EXPECT_TRUE(BHSSUStaged::ms.commitPending());
+    EXPECT_EQ(0, BHSSUStaged::ms.getPendingCount());
+    EXPECT_EQ(50, BHSSUStaged::backing.getByHourStatSimple(B::STATS_SET_RHPC_BY_HOUR_SMOOTHED, 9));
+    EXPECT_TRUE(BHSSUStaged::ms.commitPending());
+
+    // Smoothing folds into the staged value; a rewrite of a staged slot replaces it.
+    BHSSUStaged::ambLight.set(200);
+    BHSSUStaged::su.sampleStats(true, 9);
+    const uint8_t sm = BHSSUStaged::ms.getByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED, 9);
+    EXPECT_NEAR(B::smoothStatsValue(100, 200), sm, 1); // Stochastic rounding.
+    BHSSUStaged::ms.setByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR, 9, 201);
+    EXPECT_EQ(6, BHSSUStaged::ms.getPendingCount());
+    BHSSUStaged::ms.flush();
+    EXPECT_EQ(201, BHSSUStaged::backing.getByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR, 9));
+    EXPECT_EQ(sm, BHSSUStaged::backing.getByHourStatSimple(B::STATS_SET_AMBLIGHT_BY_HOUR_SMOOTHED, 9));
+
+    // When full the oldest staged write is committed to make room.
+    OTV0P2BASE::ByHourByteStatsStagedWriter<2> s2(BHSSUStaged::backing);
+    s2.setByHourStatSimple(B::STATS_SET_USER1_BY_HOUR, 1, 1);
+    s2.setByHourStatSimple(B::STATS_SET_USER1_BY_HOUR, 2, 2);
+    s2.setByHourStatSimple(B::STATS_SET_USER1_BY_HOUR, 3, 3);
+    EXPECT_EQ(2, s2.getPendingCount());
+    EXPECT_EQ(1, BHSSUStaged::backing.getByHourStatSimple(B::STATS_SET_USER1_BY_HOUR, 1));
+    EXPECT_EQ(unset, BHSSUStaged::backing.getByHourStatSimple(B::STATS_SET_USER1_BY_HOUR, 2));
+    // Zapping drops staged writes.
+    EXPECT_TRUE(s2.zapStats());
+    EXPECT_EQ(0, s2.getPendingCount());
+    EXPECT_EQ(unset, s2.getByHourStatSimple(B::STATS_SET_USER1_BY_HOUR, 3));
+}
+
+// Check that a full by-hour stats history survives bulk upload in 32-byte frames.
+TEST(Stats, ByHourStatsBulkUpload)
+{
+    typedef OTV0P2BASE::NVByHourByteStatsBase B;
+    const uint8_t unset = B::UNSET_BYTE;
+    OTV0P2BASE::NVByHourByteStatsMock src;
+    // Smooth values in most sets, a few jumps, some unset.
+    for(uint8_t s = 0; s < B::STATS_SETS_COUNT - 2; ++s)
+        for(uint8_t hh = 0; hh < 24; ++hh)
+            { src.setByHourStatSimple(s, hh, uint8_t(100 + 10*s + ((hh < 12) ? hh : 24 - hh))); }
+    src.setByHourStatSimple(B::STATS_SET_OCCPC_BY_HOUR, 7, 0);
+    src.setByHourStatSimple(B::STATS_SET_OCCPC_BY_HOUR, 8, 254);
+    src.setByHourStatSimple(B::STATS_SET_CO2_BY_HOUR, 23, unset);
+
+    OTV0P2BASE::ByHourStatsBulkWriter w(src);
+    OTV0P2BASE::NVByHourByteStatsMock dst;
+    uint8_t buf[32];
+    uint8_t nextSet = 0, nextHour = 0;
+    int chunks = 0;
+    while(!w.isComplete())
+        {
+        const uint8_t l = w.writeNextChunk(buf, sizeof(buf));
+        ASSERT_NE(0, l);
+        ASSERT_GE(sizeof(buf), l);
+        // Each chunk follows on from the last.
+        EXPECT_EQ(nextSet, buf[1]);
+        EXPECT_EQ(nextHour, buf[2]);
+        ASSERT_TRUE(OTV0P2BASE::applyByHourStatsBulkChunk(buf, l, dst, nextSet, nextHour));
+        EXPECT_EQ(w.getNextSet(), nextSet);
+        EXPECT_EQ(w.getNextHour(), nextHour);
+        ++chunks;
+        }
+    EXPECT_EQ(0, w.writeNextChunk(buf, sizeof(buf)));
+    for(uint8_t s = 0; s < B::STATS_SETS_COUNT; ++s)
+        for(uint8_t hh = 0; hh < 24; ++hh)
+            { EXPECT_EQ(src.getByHourStatSimple(s, hh), dst.getByHourStatSimple(s, hh)) << int(s) << " " << int(hh); }
+    // Fewer frames than one per set, which raw bytes would need.
+    EXPECT_LT(chunks, B::STATS_SETS_COUNT);
+
+    // Resume from a reported gap.
+    EXPECT_FALSE(w.resumeFrom(B::STATS_SETS_COUNT));
+    EXPECT_FALSE(w.resumeFrom(0, 24));
+    EXPECT_TRUE(w.resumeFrom(B::STATS_SET_RHPC_BY_HOUR, 5));
+    const uint8_t l = w.writeNextChunk(buf, sizeof(buf));
+    ASSERT_NE(0, l);
+    EXPECT_EQ(B::STATS_SET_RHPC_BY_HOUR, buf[1]);
+    EXPECT_EQ(5, buf[2]);
+    // Too small a buffer for any value.
+    EXPECT_EQ(0, w.writeNextChunk(buf, OTV0P2BASE::MSG_BYHOUR_STATS_BULK_HEADER_BYTES));
+
+    // Malformed chunks are rejected without writing anything.
+    OTV0P2BASE::NVByHourByteStatsMock empty;
+    const uint8_t truncated[] = { OTV0P2BASE::MSG_BYHOUR_STATS_BULK_LEADING_BYTE, 0, 0, 2, 0x80 };
+    EXPECT_FALSE(OTV0P2BASE::applyByHourStatsBulkChunk(truncated, sizeof(truncated), empty, nextSet, nextHour));
+    EXPECT_EQ(unset, empty.getByHourStatSimple(0, 0));
+    const uint8_t badHour[] = { OTV0P2BASE::MSG_BYHOUR_STATS_BULK_LEADING_BYTE, 0, 24, 2 };
+    EXPECT_FALSE(OTV0P2BASE::applyByHourStatsBulkChunk(badHour, sizeof(badHour), empty, nextSet, nextHour));
+    const uint8_t badLead[] = { 0, 0, 0, 2 };
+    EXPECT_FALSE(OTV0P2BASE::applyByHourStatsBulkChunk(badLead, sizeof(badLead), empty, nextSet, nextHour));
+}
@@ -0,0 +1,121 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for CLI tests.
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_CLI.h"
+
+
+namespace CLIT
+{
+// Stream serving a fixed string, collecting anything written.
+class StringStream final : public Stream
+    {
+    private:
+        const char *in;
+    public:
+        std::string out;
+        explicit StringStream(const char *s = "") : in(s) { }
+        void feed(const char *s) { in = s; }
+        virtual size_t write(uint8_t c) override { out += char(c); return(1); }
+        virtual int available() override { return(int(strlen(in))); }
+        virtual int read() override { return(('\0' == *in) ? -1 : uint8_t(*in++)); }
+        virtual int peek() override { return(('\0' == *in) ? -1 : uint8_t(*in)); }
+        virtual void flush() override { }
+    };
+// Records the last line it was given.
+class RecordingEntry final : public OTV0P2BASE::CLIEntryBase
+    {
+    public:
+        std::string last;
+        uint8_t lastLen = 0;
+        int calls = 0;
+        virtual bool doCommand(char *buf, uint8_t buflen) override
+            { last = buf; lastLen = buflen; ++calls; return(false); }
+    };
+static RecordingEntry entryT;
+static OTV0P2BASE::CLIEntryBase *select(const char c) { return(('T' == c) ? &entryT : NULL); }
+}
+
+// Lines are filtered like promptAndReadCommandLine(), echoed, and dispatched once complete.
+TEST(CLI,lineAssemblerPumpAndDispatch)
+{
+    OTV0P2BASE::CLI::CLILineAssembler<15> a;
+    CLIT::entryT = CLIT::RecordingEntry();
+    CLIT::StringStream s("\r\n 1t 12");
+    EXPECT_FALSE(a.pump(s, &s));
+    EXPECT_FALSE(a.isLineReady());
+    EXPECT_FALSE(a.dispatch(CLIT::select));
+    // Leading junk dropped and the command letter upper-cased.
+    EXPECT_EQ("T 12", s.out);
+    s.feed(" 34\r\nX");
+    EXPECT_TRUE(a.pump(s, &s));
+    EXPECT_EQ("T 12 34\r\n", s.out);
+    // Input while a line is ready is dropped.
+    EXPECT_EQ(1, a.getDropped());
+    bool status = true;
+    EXPECT_TRUE(a.dispatch(CLIT::select, &status));
+    EXPECT_FALSE(status);
+    EXPECT_EQ("T 12 34", CLIT::entryT.last);
+    EXPECT_EQ(7, CLIT::entryT.lastLen);
+    EXPECT_FALSE(a.isLineReady());
+    // Unknown command is taken but runs nothing.
+    s.feed("?\n");
+    EXPECT_TRUE(a.pump(s));
+    status = true;
+    EXPECT_TRUE(a.dispatch(CLIT::select, &status));
+    EXPECT_TRUE(status);
+    EXPECT_EQ(1, CLIT::entryT.calls);
+}
+
+// ISR feed; over-long lines are cut at the buffer size and the remainder discarded.
+TEST(CLI,lineAssemblerISR)
+{
+    OTV0P2BASE::CLI::CLILineAssembler<4> a;
+    CLIT::entryT = CLIT::RecordingEntry();
+    const char *in = "t\x01" "23456\r\nt9\r";
+    int completed = 0;
+    for(const char *p = in; '\0' != *p; ++p)
+        {
+        if(a.captureFromISR(*p)) { ++completed; EXPECT_TRUE(a.dispatch(CLIT::select)); }
+        }
+    EXPECT_EQ(2, completed);
+    EXPECT_EQ(2, CLIT::entryT.calls);
+    EXPECT_EQ("T9", CLIT::entryT.last);
+    EXPECT_EQ(0, a.getDropped());
+    // First line was "T234".
+    a.captureFromISR('T');
+    a.captureFromISR('a');
+    a.captureFromISR('b');
+    a.captureFromISR('c');
+    EXPECT_TRUE(a.isLineReady());
+    a.release();
+    EXPECT_FALSE(a.isLineReady());
+    // Rest of the over-long line discarded.
+    EXPECT_FALSE(a.captureFromISR('d'));
+    EXPECT_FALSE(a.captureFromISR('\n'));
+    EXPECT_FALSE(a.isLineReady());
+}
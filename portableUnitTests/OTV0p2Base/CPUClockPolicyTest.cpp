@@ -0,0 +1,90 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for CPUClockPolicy tests.
+ */
+
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_CPUClockPolicy.h"
+
+
+// Reduced clock stays fast enough for the RTC.
+TEST(CPUClockPolicy, reducedCPUShift)
+{
+    // Usual 1MHz V0p2: 250kHz is the slowest at least 131072Hz.
+    EXPECT_EQ(2, OTV0P2BASE::reducedCPUShift(1000000UL, 5, OTV0P2BASE::MIN_CPU_HZ_FOR_RTC));
+    // Capped by the available prescale.
+    EXPECT_EQ(1, OTV0P2BASE::reducedCPUShift(1000000UL, 1, OTV0P2BASE::MIN_CPU_HZ_FOR_RTC));
+    EXPECT_EQ(0, OTV0P2BASE::reducedCPUShift(1000000UL, 0, OTV0P2BASE::MIN_CPU_HZ_FOR_RTC));
+    // 16MHz.
+    EXPECT_EQ(6, OTV0P2BASE::reducedCPUShift(16000000UL, 8, OTV0P2BASE::MIN_CPU_HZ_FOR_RTC));
+    // Exact halving to the minimum is allowed.
+    EXPECT_EQ(1, OTV0P2BASE::reducedCPUShift(262144UL, 5, OTV0P2BASE::MIN_CPU_HZ_FOR_RTC));
+    // Already at or below the minimum.
+    EXPECT_EQ(0, OTV0P2BASE::reducedCPUShift(131072UL, 5, OTV0P2BASE::MIN_CPU_HZ_FOR_RTC));
+    EXPECT_EQ(0, OTV0P2BASE::reducedCPUShift(100000UL, 5, OTV0P2BASE::MIN_CPU_HZ_FOR_RTC));
+    // Usable at compile time.
+    static_assert(2 == OTV0P2BASE::reducedCPUShift(1000000UL, 5, 4 * 32768UL), "reducedCPUShift");
+}
+
+// Full-speed sections override reduced ones, and both nest.
+TEST(CPUClockPolicy, nesting)
+{
+    OTV0P2BASE::CPUClockPolicy p;
+    EXPECT_FALSE(p.inReduced());
+    EXPECT_FALSE(p.inFull());
+    EXPECT_EQ(0, p.wantedShift(2, true));
+    p.enterReduced();
+    EXPECT_EQ(2, p.wantedShift(2, true));
+    // Something else (eg the UART) needs full speed.
+    EXPECT_EQ(0, p.wantedShift(2, false));
+    p.enterReduced();
+    p.enterFull();
+    EXPECT_EQ(0, p.wantedShift(2, true));
+    p.enterFull();
+    p.exitFull();
+    EXPECT_EQ(0, p.wantedShift(2, true));
+    p.exitFull();
+    EXPECT_EQ(2, p.wantedShift(2, true));
+    p.exitReduced();
+    EXPECT_EQ(2, p.wantedShift(2, true));
+    p.exitReduced();
+    EXPECT_EQ(0, p.wantedShift(2, true));
+    // Unbalanced exits are harmless.
+    p.exitReduced();
+    p.exitFull();
+    EXPECT_FALSE(p.inReduced());
+    EXPECT_FALSE(p.inFull());
+    p.enterReduced();
+    EXPECT_EQ(2, p.wantedShift(2, true));
+}
+
+// Guards compile and do nothing off AVR.
+TEST(CPUClockPolicy, guards)
+{
+    {
+    OTV0P2BASE::RAII_CPUReducedClock slow;
+    OTV0P2BASE::RAII_CPUFullSpeed fast;
+    OTV0P2BASE::applyCPUClockPolicy();
+    }
+    SUCCEED();
+}
@@ -0,0 +1,323 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Stress tests of ISR/main-loop shared queues and rings,
+ * with the ISR side emulated on its own thread (see ISREmulation.h),
+ * reporting throughput.
+ *
+ * Run under ThreadSanitizer to check the handover as well as the data;
+ * set OTRL_STRESS_SCALE to run longer.
+ */
+
+#include <stdint.h>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include <OTRadioLink.h>
+
+#include "OTV0P2BASE_SoftSerialEdgeDecoder.h"
+#include "OTV0P2BASE_SoftSerialTxQueue.h"
+#include "ISREmulation.h"
+
+namespace CST
+{
+using OTV0P2BASE::PortableUnitTest::ISREmulator;
+using OTV0P2BASE::PortableUnitTest::StressTimer;
+using OTV0P2BASE::PortableUnitTest::randomPause;
+using OTV0P2BASE::PortableUnitTest::stressScale;
+
+// Fill a test frame of len bytes for sequence number seq.
+template<typename p_t>
+void fillFrame(p_t bp, const uint8_t len, const uint32_t seq)
+    { for(uint8_t i = 0; i < len; ++i) { bp[i] = uint8_t(seq + i); } }
+// True if a frame of len bytes is intact, setting seq from its first byte.
+template<typename p_t>
+bool checkFrame(p_t bp, const uint8_t len, uint8_t &seq)
+    {
+    seq = bp[0];
+    for(uint8_t i = 1; i < len; ++i) { if(uint8_t(seq + i) != bp[i]) { return(false); } }
+    return(true);
+    }
+}
+
+// Radio RX ISR loading variable-length frames against the main loop draining them.
+TEST(ConcurrencyStress,ISRRXQueueVarLenMsg)
+{
+    static constexpr uint8_t maxLen = 20;
+    OTRadioLink::ISRRXQueueVarLenMsg<maxLen, 2> q;
+    const uint32_t n = 5000 * CST::stressScale();
+    // ISR-side state, touched only while holding the emulated CPU.
+    uint32_t produced = 0, dropped = 0;
+    CST::ISREmulator e(1);
+    CST::StressTimer t;
+    e.start([&]()
+        {
+        if(produced >= n) { return; }
+        volatile uint8_t *const bp = q._getRXBufForInbound();
+        if(NULL == bp) { ++dropped; ++produced; return; }
+        const uint8_t len = uint8_t(1 + (produced % maxLen));
+        CST::fillFrame(bp, len, produced);
+        q._loadedBuf(len);
+        ++produced;
+        });
+    uint32_t received = 0;
+    uint8_t lastSeq = 0xff;
+    bool ok = true;
+    while(ok && ((produced < n) || !q.isEmpty()))
+        {
+        e.preemptionPoint();
+        const volatile uint8_t *const m = q.peekRXMsg();
+        if(NULL == m) { continue; }
+        // A frame may arrive while this one is being handled.
+        e.preemptionPoint();
+        uint8_t seq;
+        ok = CST::checkFrame(m, m[-1], seq) && (m[-1] <= maxLen) && (seq != lastSeq);
+        lastSeq = seq;
+        q.removeRXMsg();
+        ++received;
+        if(0 == (received & 0xff)) { ok = ok && q.selfCheck(); }
+        }
+    e.stop();
+    t.report("ISRRXQueueVarLenMsg frames", received);
+    EXPECT_TRUE(ok);
+    EXPECT_TRUE(q.selfCheck());
+    EXPECT_EQ(n, produced);
+    EXPECT_EQ(n, received + dropped);
+    EXPECT_LT(0U, received);
+}
+
+// Lock-free radio RX queue with the ISR side on a free-running thread.
+TEST(ConcurrencyStress,ISRRXQueueSPSC)
+{
+    static constexpr uint8_t maxLen = 20;
+    OTRadioLink::ISRRXQueueSPSC<maxLen, 3> q;
+    const uint32_t n = 50000 * CST::stressScale();
+    CST::StressTimer t;
+    std::thread producer([&q, n]()
+        {
+        std::minstd_rand r(2);
+        for(uint32_t i = 0; i < n; )
+            {
+            const uint8_t len = uint8_t(1 + (i % maxLen));
+            volatile uint8_t *const bp = q.claim(len);
+            if(NULL == bp) { std::this_thread::yield(); continue; }
+            CST::fillFrame(bp, len, i);
+            CST::randomPause(r, 8);
+            q.commit(len);
+            ++i;
+            }
+        });
+    std::minstd_rand r(3);
+    uint32_t received = 0;
+    bool ok = true;
+    while(ok && (received < n))
+        {
+        uint8_t len;
+        const volatile uint8_t *const m = q.peek(len);
+        if(NULL == m) { std::this_thread::yield(); continue; }
+        uint8_t seq;
+        ok = CST::checkFrame(m, len, seq) && (uint8_t(received) == seq) && (len == 1 + (received % maxLen));
+        CST::randomPause(r, 8);
+        q.release();
+        ++received;
+        }
+    producer.join();
+    t.report("ISRRXQueueSPSC frames", received);
+    EXPECT_TRUE(ok);
+    EXPECT_TRUE(q.isEmpty());
+}
+
+// Lock-free record queue with both sides free-running.
+TEST(ConcurrencyStress,SPSCQueue)
+{
+    struct R { uint32_t seq; uint32_t check; };
+    OTV0P2BASE::SPSCQueue<R, 8> q;
+    const uint32_t n = 200000 * CST::stressScale();
+    CST::StressTimer t;
+    std::thread producer([&q, n]()
+        {
+        std::minstd_rand r(4);
+        for(uint32_t i = 0; i < n; )
+            {
+            R *const p = q.reserve();
+            if(NULL == p) { std::this_thread::yield(); continue; }
+            p->seq = i;
+            p->check = ~i;
+            if(0 == (i & 0xf)) { CST::randomPause(r, 8); }
+            q.commit();
+            ++i;
+            }
+        });
+    uint32_t received = 0;
+    bool ok = true;
+    while(ok && (received < n))
+        {
+        R v;
+        if(!q.pop(v)) { std::this_thread::yield(); continue; }
+        ok = (received == v.seq) && (~received == v.check);
+        ++received;
+        }
+    producer.join();
+    t.report("SPSCQueue records", received);
+    EXPECT_TRUE(ok);
+}
+
+// Main loop queueing soft-serial TX bytes against the bit timer ISR sending them.
+TEST(ConcurrencyStress,SoftSerialTxQueue)
+{
+    OTV0P2BASE::SoftSerialTxQueue<16> q;
+    const uint32_t n = 1000 * CST::stressScale();
+    // ISR-side state.
+    bool timerRunning = false;
+    std::vector<uint8_t> sent;
+    uint16_t frame = 0;
+    uint8_t levels = 0;
+    bool framingOK = true;
+    CST::ISREmulator e(5);
+    CST::StressTimer t;
+    e.start([&]()
+        {
+        if(!timerRunning) { return; }
+        const int8_t l = q.nextLevelFromISR();
+        if(l < 0) { timerRunning = false; framingOK = framingOK && (0 == levels); return; }
+        frame = uint16_t(frame | (uint16_t(l) << levels));
+        if(10 == ++levels)
+            {
+            // Start bit low, stop bit high.
+            framingOK = framingOK && (0 == (frame & 1)) && (0 != (frame & 0x200));
+            sent.push_back(uint8_t(frame >> 1));
+            frame = 0;
+            levels = 0;
+            }
+        });
+    uint32_t queued = 0;
+    while(queued < n)
+        {
+        e.preemptionPoint();
+        if(!q.put(uint8_t(queued * 7))) { continue; }
+        ++queued;
+        e.preemptionPoint();
+        if(q.start()) { timerRunning = true; }
+        }
+    while(q.isBusy()) { e.preemptionPoint(); }
+    e.stop();
+    t.report("SoftSerialTxQueue bytes", uint32_t(sent.size()));
+    EXPECT_TRUE(framingOK);
+    ASSERT_EQ(n, sent.size());
+    for(uint32_t i = 0; i < n; ++i) { ASSERT_EQ(uint8_t(i * 7), sent[i]) << i; }
+}
+
+// RX pin-change ISR capturing soft-serial edges against the main loop decoding them.
+TEST(ConcurrencyStress,SoftSerialEdgeDecoder)
+{
+    static constexpr uint16_t bitTicks = 32;
+    OTV0P2BASE::SoftSerialEdgeDecoder<64, 16> d(bitTicks);
+    const uint32_t n = 500 * CST::stressScale();
+    // Shared line state: timer and bytes sent, touched only while holding the emulated CPU.
+    uint16_t now = 0;
+    uint32_t sentBytes = 0;
+    // ISR-side: position within the byte being sent, in bit times from its start bit.
+    uint16_t byteStart = 0;
+    uint8_t bit = 0;
+    bool sending = false;
+    uint8_t prevLevel = 1;
+    uint32_t received = 0;
+    CST::ISREmulator e(6);
+    CST::StressTimer t;
+    e.start([&]()
+        {
+        // The timer runs on; each run stands for a line edge or a quarter bit of idle.
+        now = uint16_t(now + (bitTicks / 4));
+        if(!sending)
+            {
+            // Limit bytes in flight so that no queue can overflow; leave idle time between bytes.
+            if((sentBytes >= n) || (sentBytes - received >= 4)) { return; }
+            sending = true;
+            byteStart = now;
+            bit = 0;
+            }
+        const uint16_t elapsed = uint16_t(now - byteStart);
+        if(elapsed < bit * bitTicks) { return; }
+        // Bit levels: 0 start, 1..8 data lsb first, 9 stop, 10 and 11 idle.
+        const uint8_t b = uint8_t(sentBytes * 13);
+        const uint8_t level = (0 == bit) ? 0 : ((bit <= 8) ? ((b >> (bit - 1)) & 1) : 1);
+        if(level != prevLevel) { d.captureEdgeFromISR(uint16_t(byteStart + bit * bitTicks), 0 != level); prevLevel = level; }
+        if(++bit > 11) { sending = false; ++sentBytes; }
+        });
+    bool ok = true;
+    while(ok && (received < n))
+        {
+        e.preemptionPoint();
+        if(0 == d.available(now)) { continue; }
+        e.preemptionPoint();
+        const int c = d.read();
+        ok = (uint8_t(received * 13) == c);
+        ++received;
+        }
+    e.stop();
+    t.report("SoftSerialEdgeDecoder bytes", received);
+    EXPECT_TRUE(ok) << received;
+    EXPECT_EQ(0, d.getEdgesDropped());
+    EXPECT_EQ(0, d.getBytesDropped());
+    EXPECT_EQ(0, d.getFramingErrors());
+}
+
+// ISR trace records against the main loop pausing to take snapshots.
+TEST(ConcurrencyStress,TraceRing)
+{
+    OTV0P2BASE::TraceRing<16> tr;
+    const uint32_t n = 10000 * CST::stressScale();
+    // ISR-side count of record() calls.
+    uint32_t calls = 0;
+    CST::ISREmulator e(7);
+    CST::StressTimer t;
+    e.start([&]()
+        {
+        if(calls >= n) { return; }
+        tr.record(uint16_t(calls), OTV0P2BASE::TraceId::APP, uint16_t(calls));
+        ++calls;
+        });
+    uint32_t snapshots = 0;
+    uint16_t lastSeen = 0;
+    bool ok = true;
+    while(ok && (calls < n))
+        {
+        e.preemptionPoint();
+        tr.pause(true);
+        // Entries recorded while paused are lost, not reordered.
+        e.preemptionPoint();
+        const uint8_t s = tr.size();
+        ok = (s <= tr.capacity());
+        OTV0P2BASE::TraceEntry te;
+        for(uint8_t i = 0; ok && (i < s); ++i)
+            {
+            ok = tr.get(i, te) && (te.value == uint16_t((uint16_t(te.cycle) << 8) | te.sct)) &&
+                 ((0 == i) || (int16_t(te.value - lastSeen) > 0));
+            lastSeen = te.value;
+            }
+        ok = ok && !tr.get(s, te);
+        tr.pause(false);
+        ++snapshots;
+        }
+    e.stop();
+    t.report("TraceRing records", calls);
+    EXPECT_TRUE(ok);
+    EXPECT_LT(0U, snapshots);
+}
@@ -21,6 +21,7 @@ Author(s) / Copyright (s): Damon Hart-Davis 2016
  */
 
 #include <stdint.h>
+#include <thread>
 #include <gtest/gtest.h>
 #include <OTV0p2Base.h>
 
@@ -53,3 +54,103 @@ TEST(Concurrency,AtomicUInt8T)
         }
 }
 
+
+// SPSC records come out in order, full pushes are refused and counted,
+// and the free-running indexes wrap cleanly.
+TEST(Concurrency,SPSCQueue)
+{
+    struct R { uint8_t a; uint16_t b; };
+    OTV0P2BASE::SPSCQueue<R, 4> q;
+    EXPECT_TRUE(q.isEmpty());
+    EXPECT_EQ(4, q.space());
+    R r;
+    EXPECT_FALSE(q.pop(r));
+    EXPECT_TRUE(NULL == q.front());
+    for(uint16_t i = 0; i < 600; ++i)
+        {
+        EXPECT_TRUE(q.push(R{uint8_t(i), uint16_t(i * 3)}));
+        EXPECT_TRUE(q.push(R{uint8_t(i + 1), 0}));
+        ASSERT_TRUE(q.pop(r));
+        EXPECT_EQ(uint8_t(i), r.a);
+        EXPECT_EQ(uint16_t(i * 3), r.b);
+        ASSERT_TRUE(NULL != q.front());
+        EXPECT_EQ(uint8_t(i + 1), q.front()->a);
+        q.release();
+        EXPECT_TRUE(q.isEmpty());
+        }
+    for(uint8_t i = 0; i < 4; ++i) { EXPECT_TRUE(q.push(R{i, 0})); }
+    EXPECT_TRUE(q.isFull());
+    EXPECT_FALSE(q.push(R{9, 0}));
+    EXPECT_TRUE(NULL == q.reserve());
+    EXPECT_EQ(2, q.getDropped());
+    q.clearDropped();
+    EXPECT_EQ(0, q.getDropped());
+    ASSERT_TRUE(q.pop(r));
+    EXPECT_EQ(0, r.a);
+    // Fill in place.
+    R *const p = q.reserve();
+    ASSERT_TRUE(NULL != p);
+    p->a = 42;
+    EXPECT_EQ(3, q.size());
+    q.commit();
+    EXPECT_EQ(4, q.size());
+    for(uint8_t i = 1; i < 4; ++i) { ASSERT_TRUE(q.pop(r)); EXPECT_EQ(i, r.a); }
+    ASSERT_TRUE(q.pop(r));
+    EXPECT_EQ(42, r.a);
+}
+
+// Bulk byte pushes are all or nothing.
+TEST(Concurrency,SPSCByteRing)
+{
+    OTV0P2BASE::SPSCByteRing<8> b;
+    const uint8_t s[] = { 1, 2, 3, 4, 5, 6 };
+    EXPECT_TRUE(b.push(s, 6));
+    EXPECT_FALSE(b.push(s, 3));
+    EXPECT_EQ(6, b.size());
+    EXPECT_EQ(1, b.getDropped());
+    EXPECT_TRUE(b.push(s, 2));
+    EXPECT_TRUE(b.isFull());
+    uint8_t c;
+    for(uint8_t i = 0; i < 6; ++i) { ASSERT_TRUE(b.pop(c)); EXPECT_EQ(i + 1, c); }
+    ASSERT_TRUE(b.pop(c)); EXPECT_EQ(1, c);
+    ASSERT_TRUE(b.pop(c)); EXPECT_EQ(2, c);
+    EXPECT_FALSE(b.pop(c));
+}
+
+// A producer thread and a consumer thread pass every record through intact.
+TEST(Concurrency,SPSCQueueThreaded)
+{
+    OTV0P2BASE::SPSCQueue<uint16_t, 16> q;
+    static constexpr uint16_t n = 20000;
+    std::thread producer([&q]()
+        {
+        for(uint16_t i = 0; i < n; ) { if(q.push(i)) { ++i; } else { std::this_thread::yield(); } }
+        });
+    uint16_t expected = 0;
+    while(expected < n)
+        {
+        uint16_t v;
+        if(!q.pop(v)) { std::this_thread::yield(); continue; }
+        ASSERT_EQ(expected, v);
+        ++expected;
+        }
+    producer.join();
+    EXPECT_TRUE(q.isEmpty());
+}
+
+// Flags are raised, tested and taken independently.
+TEST(Concurrency,EventFlags)
+{
+    OTV0P2BASE::EventFlags f;
+    EXPECT_EQ(0, f.get());
+    f.set(0x01);
+    f.set(0x80);
+    EXPECT_TRUE(f.test(0x81));
+    EXPECT_FALSE(f.test(0x02));
+    EXPECT_EQ(0x80, f.take(0x82));
+    EXPECT_EQ(0x01, f.get());
+    f.set(0x06);
+    f.clear(0x02);
+    EXPECT_EQ(0x05, f.take());
+    EXPECT_EQ(0, f.get());
+}
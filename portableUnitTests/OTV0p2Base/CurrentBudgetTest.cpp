@@ -0,0 +1,71 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Supply current budget tests.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#include "OTV0P2BASE_CurrentBudget.h"
+
+
+// By default everything is admitted together.
+TEST(CurrentBudget,DefaultUnlimited)
+{
+    OTV0P2BASE::CurrentBudget b;
+    EXPECT_TRUE(b.tryClaim(OTV0P2BASE::CurrentLoad::MOTOR));
+    EXPECT_TRUE(b.tryClaim(OTV0P2BASE::CurrentLoad::RADIO_TX));
+    EXPECT_TRUE(b.tryClaim(OTV0P2BASE::CurrentLoad::LED));
+    b.release(OTV0P2BASE::CurrentLoad::LED);
+    b.release(OTV0P2BASE::CurrentLoad::RADIO_TX);
+    b.release(OTV0P2BASE::CurrentLoad::MOTOR);
+    EXPECT_EQ(0, b.getInUse());
+}
+
+// With one big load at a time, motor and radio TX are staggered
+// but the LED may join either.
+TEST(CurrentBudget,OneBigLoad)
+{
+    OTV0P2BASE::CurrentBudget b(OTV0P2BASE::CurrentBudget::LIMIT_ONE_BIG_LOAD);
+    {
+    const OTV0P2BASE::CurrentBudgetClaim motor(OTV0P2BASE::CurrentLoad::MOTOR, b);
+    EXPECT_TRUE(motor.isGranted());
+    EXPECT_FALSE(b.wouldGrant(OTV0P2BASE::CurrentLoad::RADIO_TX));
+    const OTV0P2BASE::CurrentBudgetClaim tx(OTV0P2BASE::CurrentLoad::RADIO_TX, b);
+    EXPECT_FALSE(tx.isGranted());
+    const OTV0P2BASE::CurrentBudgetClaim led(OTV0P2BASE::CurrentLoad::LED, b);
+    EXPECT_TRUE(led.isGranted());
+    EXPECT_EQ(OTV0P2BASE::CurrentLoad::MOTOR + OTV0P2BASE::CurrentLoad::LED, b.getInUse());
+    }
+    // All released at the end of scope, refused claim included.
+    EXPECT_EQ(0, b.getInUse());
+    {
+    const OTV0P2BASE::CurrentBudgetClaim tx(OTV0P2BASE::CurrentLoad::RADIO_TX, b);
+    EXPECT_TRUE(tx.isGranted());
+    EXPECT_FALSE(b.wouldGrant(OTV0P2BASE::CurrentLoad::MOTOR));
+    }
+    // A single load over the limit may still run alone.
+    b.setLimit(1);
+    EXPECT_TRUE(b.wouldGrant(OTV0P2BASE::CurrentLoad::MOTOR));
+    EXPECT_TRUE(b.tryClaim(OTV0P2BASE::CurrentLoad::MOTOR));
+    EXPECT_FALSE(b.tryClaim(OTV0P2BASE::CurrentLoad::LED));
+    b.release(OTV0P2BASE::CurrentLoad::MOTOR);
+    EXPECT_EQ(0, b.getInUse());
+}
@@ -0,0 +1,110 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for CycleTaskRunner tests.
+ */
+
+
+#include <stdint.h>
+#include <vector>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_CycleTaskRunner.h"
+
+
+namespace CTRTest
+{
+// Simulated sub-cycle time.
+static uint8_t sct;
+static uint8_t now() { return(sct); }
+// Task log and each task's simulated run time.
+static std::vector<int> ran;
+struct T { int id; uint8_t takes; };
+static void run(void *const c)
+    {
+    const T *const t = static_cast<const T *>(c);
+    ran.push_back(t->id);
+    sct = uint8_t(sct + t->takes);
+    }
+}
+
+// Phase order, periods, and next due time.
+TEST(CycleTaskRunner,schedule)
+{
+    CTRTest::sct = 0;
+    CTRTest::ran.clear();
+    OTV0P2BASE::CycleTaskRunner<4> r(CTRTest::now);
+    const uint16_t noneDue = r.NONE_DUE;
+    EXPECT_EQ(noneDue, r.nextDue());
+    CTRTest::T radio = { 1, 2 }, motor = { 2, 5 }, stats = { 3, 10 };
+    EXPECT_TRUE(r.add(CTRTest::run, &motor, 64, 16));
+    EXPECT_TRUE(r.add(CTRTest::run, &radio, 0, 4));
+    EXPECT_TRUE(r.add(CTRTest::run, &stats, 128, 40, 3));
+    EXPECT_FALSE(r.add(CTRTest::run, &stats, 0, 1, 0));
+    EXPECT_EQ(3, r.size());
+    for(int cycle = 0; cycle < 6; ++cycle)
+        {
+        SCOPED_TRACE(cycle);
+        if(0 != cycle) { r.newCycle(); }
+        CTRTest::sct = 0;
+        CTRTest::ran.clear();
+        EXPECT_EQ(1, r.runDue());
+        EXPECT_EQ(64, r.nextDue());
+        // Sleeping to the due time.
+        for(uint16_t next; (next = r.nextDue()) <= 255; )
+            { CTRTest::sct = uint8_t(next); r.runDue(); }
+        const bool statsDue = (0 == (cycle % 3));
+        ASSERT_EQ(statsDue ? 3U : 2U, CTRTest::ran.size());
+        EXPECT_EQ(1, CTRTest::ran[0]);
+        EXPECT_EQ(2, CTRTest::ran[1]);
+        if(statsDue) { EXPECT_EQ(3, CTRTest::ran[2]); }
+        // Next is the radio, next cycle.
+        EXPECT_EQ(256, r.nextDue());
+        }
+    for(uint8_t i = 0; i < 3; ++i) { EXPECT_EQ(0, r.getStats(i).overruns); EXPECT_EQ(0, r.getStats(i).deferred); }
+    EXPECT_EQ(10, r.getStats(2).worstTicks);
+}
+
+// Budget enforcement and overrun reporting.
+TEST(CycleTaskRunner,budgets)
+{
+    CTRTest::sct = 0;
+    CTRTest::ran.clear();
+    OTV0P2BASE::CycleTaskRunner<> r(CTRTest::now, 240);
+    CTRTest::T slow = { 1, 30 }, late = { 2, 1 };
+    r.add(CTRTest::run, &slow, 10, 20);
+    r.add(CTRTest::run, &late, 220, 30);
+    // Late waking: both due; the slow one overruns its budget.
+    CTRTest::sct = 225;
+    EXPECT_EQ(0, r.runDue());
+    EXPECT_EQ(1, r.getStats(0).deferred);
+    EXPECT_EQ(1, r.getStats(1).deferred);
+    r.newCycle();
+    CTRTest::sct = 10;
+    EXPECT_EQ(1, r.runDue());
+    EXPECT_EQ(1, r.getStats(0).overruns);
+    EXPECT_EQ(30, r.getStats(0).worstTicks);
+    EXPECT_EQ(1, r.getTotalOverruns());
+    // Not run this cycle: counted as deferred at the roll.
+    r.newCycle();
+    EXPECT_EQ(2, r.getStats(1).deferred);
+    r.clearStats();
+    EXPECT_EQ(0, r.getTotalOverruns());
+    EXPECT_EQ(0, r.getStats(5).worstTicks);
+}
@@ -0,0 +1,187 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for EEPROM image and store-backed table tests.
+ */
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_EEPROMImage.h"
+
+
+namespace EIT
+{
+typedef OTV0P2BASE::EEPROMJournalMockStore<1024> Store;
+
+#ifdef OTV0P2BASE_EEPROM_IMAGE_AVAILABLE
+// Unique temporary file path, removed on destruction.
+struct TempPath final
+    {
+    std::string path;
+    TempPath()
+        {
+        char p[] = "/tmp/eepromimageXXXXXX";
+        const int fd = mkstemp(p);
+        if(fd >= 0) { close(fd); unlink(p); }
+        path = p;
+        }
+    ~TempPath() { unlink(path.c_str()); }
+    const char *c_str() const { return(path.c_str()); }
+    };
+#endif
+}
+
+// Node associations in the V0p2 layout over a store.
+TEST(EEPROMImage,nodeAssociationTableStore)
+{
+    EIT::Store store;
+    OTV0P2BASE::NodeAssociationTableStore<EIT::Store> table(store);
+    static const uint8_t id[8] = { 0x81, 2, 3, 4, 5, 6, 7, 8 };
+    EXPECT_TRUE(table.set(1, id));
+    EXPECT_FALSE(table.set(table.maxSets, id));
+    EXPECT_FALSE(table.set(0, NULL));
+    for(uint8_t i = 0; i < 8; ++i)
+        { EXPECT_EQ(id[i], store.read(OTV0P2BASE::V0P2BASE_EE_START_NODE_ASSOCIATIONS + OTV0P2BASE::V0P2BASE_EE_NODE_ASSOCIATIONS_SET_SIZE + i)); }
+    uint8_t buf[8];
+    table.get(1, buf);
+    EXPECT_EQ(0, memcmp(id, buf, sizeof(buf)));
+    table.get(0, buf);
+    EXPECT_EQ(0xff, buf[0]);
+    // Usable through the generic association helpers.
+    EXPECT_TRUE(table.set(0, id));
+    OTV0P2BASE::NodeAssociationIndex index;
+    EXPECT_EQ(2, index.build(table));
+}
+
+// By-hour stats in the V0p2 layout over a store.
+TEST(EEPROMImage,byHourByteStatsStore)
+{
+    EIT::Store store;
+    OTV0P2BASE::ByHourByteStatsStore<EIT::Store> stats(store);
+    const uint8_t set = OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_OCCPC_BY_HOUR;
+    EXPECT_EQ(int(OTV0P2BASE::NVByHourByteStatsBase::UNSET_BYTE), stats.getByHourStatSimple(set, 5));
+    stats.setByHourStatSimple(set, 5, 42);
+    EXPECT_EQ(42, stats.getByHourStatSimple(set, 5));
+    EXPECT_EQ(42, store.read(V0P2BASE_EE_STATS_START_ADDR(set) + 5));
+    // Out of range is ignored.
+    stats.setByHourStatSimple(set, 24, 1);
+    stats.setByHourStatSimple(OTV0P2BASE::NVByHourByteStatsBase::STATS_SETS_COUNT, 0, 1);
+    EXPECT_EQ(1, store.writes);
+    stats.setHour(5);
+    EXPECT_EQ(42, stats.getByHourStatRTC(set));
+    stats.setHour(24);
+    EXPECT_EQ(5, stats.getHour());
+    // Erasing stops after the limit of bytes actually erased.
+    stats.setByHourStatSimple(set, 6, 43);
+    EXPECT_FALSE(stats.zapStats(1));
+    EXPECT_TRUE(stats.zapStats());
+    EXPECT_EQ(int(OTV0P2BASE::NVByHourByteStatsBase::UNSET_BYTE), stats.getByHourStatSimple(set, 6));
+}
+
+#ifdef OTV0P2BASE_EEPROM_IMAGE_AVAILABLE
+// A new image is erased, and writes persist across reopening.
+TEST(EEPROMImage,persists)
+{
+    const EIT::TempPath path;
+    {
+    OTV0P2BASE::MappedEEPROMImage image(path.c_str());
+    ASSERT_TRUE(image.isOpen());
+    EXPECT_EQ(size_t(OTV0P2BASE::MappedEEPROMImage::DEFAULT_SIZE), image.size());
+    for(size_t i = 0; i < image.size(); ++i) { ASSERT_EQ(0xff, image.read(i)); }
+    EXPECT_TRUE(image.update(10, 0x5a));
+    EXPECT_FALSE(image.update(10, 0x5a));
+    EXPECT_FALSE(image.update(image.size(), 0));
+    EXPECT_EQ(0xff, image.read(image.size()));
+    static const uint8_t block[3] = { 1, 2, 0xff };
+    EXPECT_EQ(2U, image.updateBlock(20, block, sizeof(block)));
+    EXPECT_EQ(3U, image.getWrites());
+    EXPECT_TRUE(image.sync());
+    }
+    OTV0P2BASE::MappedEEPROMImage image(path.c_str());
+    ASSERT_TRUE(image.isOpen());
+    EXPECT_EQ(0x5a, image.read(10));
+    uint8_t buf[3];
+    image.readBlock(buf, 20, sizeof(buf));
+    EXPECT_EQ(1, buf[0]);
+    EXPECT_EQ(2, buf[1]);
+    EXPECT_EQ(0xff, buf[2]);
+    image.erase();
+    EXPECT_EQ(0xff, image.read(10));
+}
+
+// Two mappings of one file see each other's writes at once.
+TEST(EEPROMImage,shared)
+{
+    const EIT::TempPath path;
+    OTV0P2BASE::MappedEEPROMImage a(path.c_str()), b(path.c_str());
+    ASSERT_TRUE(a.isOpen() && b.isOpen());
+    a.update(100, 7);
+    EXPECT_EQ(7, b.read(100));
+}
+
+// Growing an image keeps its contents and erases the new bytes.
+TEST(EEPROMImage,grow)
+{
+    const EIT::TempPath path;
+    OTV0P2BASE::MappedEEPROMImage image;
+    ASSERT_TRUE(image.open(path.c_str(), 16));
+    image.update(3, 0);
+    ASSERT_TRUE(image.open(path.c_str(), 64));
+    EXPECT_EQ(64U, image.size());
+    EXPECT_EQ(0, image.read(3));
+    EXPECT_EQ(0xff, image.read(16));
+    EXPECT_EQ(0xff, image.read(63));
+    image.close();
+    EXPECT_FALSE(image.isOpen());
+    EXPECT_FALSE(image.open("/nonexistent/dir/image"));
+}
+
+// The store-backed tables and the event log keep node state in an image across runs.
+TEST(EEPROMImage,tablesPersist)
+{
+    const EIT::TempPath path;
+    static const uint8_t id[8] = { 0x81, 2, 3, 4, 5, 6, 7, 8 };
+    const uint8_t set = OTV0P2BASE::NVByHourByteStatsBase::STATS_SET_TEMP_BY_HOUR;
+    {
+    OTV0P2BASE::MappedEEPROMImage image(path.c_str());
+    OTV0P2BASE::NodeAssociationTableStore<OTV0P2BASE::MappedEEPROMImage>(image).set(0, id);
+    OTV0P2BASE::ByHourByteStatsStore<OTV0P2BASE::MappedEEPROMImage>(image).setByHourStatSimple(set, 23, 99);
+    OTV0P2BASE::EventLog<OTV0P2BASE::MappedEEPROMImage> log(image, OTV0P2BASE::V0P2BASE_EE_START_EVENT_LOG, OTV0P2BASE::V0P2BASE_EE_EVENT_LOG_SLOTS);
+    log.log(5, 1, 1000);
+    log.flush();
+    }
+    OTV0P2BASE::MappedEEPROMImage image(path.c_str());
+    uint8_t buf[8];
+    OTV0P2BASE::NodeAssociationTableStore<OTV0P2BASE::MappedEEPROMImage>(image).get(0, buf);
+    EXPECT_EQ(0, memcmp(id, buf, sizeof(buf)));
+    EXPECT_EQ(99, OTV0P2BASE::ByHourByteStatsStore<OTV0P2BASE::MappedEEPROMImage>(image).getByHourStatSimple(set, 23));
+    OTV0P2BASE::EventLog<OTV0P2BASE::MappedEEPROMImage> log(image, OTV0P2BASE::V0P2BASE_EE_START_EVENT_LOG, OTV0P2BASE::V0P2BASE_EE_EVENT_LOG_SLOTS);
+    OTV0P2BASE::EventRecord r;
+    ASSERT_TRUE(log.get(0, r));
+    EXPECT_EQ(5, r.code);
+    EXPECT_EQ(1000, r.time);
+}
+#endif // OTV0P2BASE_EEPROM_IMAGE_AVAILABLE
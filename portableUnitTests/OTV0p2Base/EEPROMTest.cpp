@@ -43,3 +43,80 @@ TEST(EEPROM, UnaryEncoding)
   EXPECT_EQ(-1, OTV0P2BASE::eeprom_unary_1byte_decode(0xef));
   EXPECT_EQ(-1, OTV0P2BASE::eeprom_unary_2byte_decode(0xccccU));
   }
+
+// Test batching and coalescing of updates in EEPROMWriteJournal.
+TEST(EEPROM, WriteJournal)
+  {
+  OTV0P2BASE::EEPROMJournalMockStore<64> store;
+  OTV0P2BASE::EEPROMWriteJournal<decltype(store), 3> j(store);
+  EXPECT_EQ(0xff, j.read(10));
+  // Repeated writes to one hot location cost one EEPROM write.
+  for(int i = 0; i < 20; ++i) { EXPECT_FALSE(j.update(10, uint8_t(i))); }
+  EXPECT_EQ(19, j.read(10));
+  EXPECT_EQ(0xff, store.read(10));
+  EXPECT_EQ(1, j.pendingCount());
+  // Unchanged values are not queued.
+  EXPECT_FALSE(j.update(11, 0xff));
+  EXPECT_EQ(1, j.pendingCount());
+  j.clearBits(12, 0xf0);
+  EXPECT_EQ(0xf0, j.read(12));
+  j.update(13, 7);
+  EXPECT_EQ(3, j.pendingCount());
+  EXPECT_EQ(0, store.writes);
+  // Full: the oldest is written to make room.
+  EXPECT_TRUE(j.update(14, 8));
+  EXPECT_EQ(1, store.writes);
+  EXPECT_EQ(19, store.read(10));
+  EXPECT_EQ(3, j.pendingCount());
+  // Partial then full flush.
+  EXPECT_EQ(1, j.flush(1));
+  EXPECT_EQ(0xf0, store.read(12));
+  EXPECT_EQ(2, j.flush());
+  EXPECT_EQ(0, j.pendingCount());
+  EXPECT_EQ(4, store.writes);
+  EXPECT_EQ(7, store.read(13));
+  EXPECT_EQ(8, store.read(14));
+  // A pending update back to the stored value writes nothing.
+  j.update(14, 9);
+  j.update(14, 8);
+  EXPECT_EQ(0, j.flush());
+  j.update(15, 1);
+  j.discard();
+  EXPECT_EQ(0xff, j.read(15));
+  }
+
+// Test wear-levelled byte, directly and through a journal.
+TEST(EEPROM, WearLevelledByte)
+  {
+  OTV0P2BASE::EEPROMJournalMockStore<64> store;
+  OTV0P2BASE::WearLevelledEEPROMByte<decltype(store), 4> b(store, 8);
+  EXPECT_EQ(0xff, b.get());
+  EXPECT_FALSE(b.set(0xff));
+  for(int i = 0; i < 11; ++i)
+    {
+    EXPECT_TRUE(b.set(uint8_t(i)));
+    EXPECT_EQ(i, b.get());
+    // A fresh instance (eg after restart) finds the same value.
+    OTV0P2BASE::WearLevelledEEPROMByte<decltype(store), 4> r(store, 8);
+    EXPECT_EQ(i, r.get()) << i;
+    }
+  // Writes are spread over the slots: 11 values and 11 sequence bytes over 8 bytes.
+  EXPECT_EQ(22, store.writes);
+  for(uint8_t a = 0; a < 8; ++a) { EXPECT_EQ(0xff, store.read(a)); }
+  for(uint8_t a = 16; a < 64; ++a) { EXPECT_EQ(0xff, store.read(a)); }
+  EXPECT_FALSE(b.set(10));
+  // Interrupted update (value but no sequence byte) leaves the old value.
+  store.update(8 + 0, 99);
+  OTV0P2BASE::WearLevelledEEPROMByte<decltype(store), 4> r(store, 8);
+  EXPECT_EQ(10, r.get());
+  // Batched through a journal.
+  OTV0P2BASE::EEPROMWriteJournal<decltype(store), 4> j(store);
+  OTV0P2BASE::WearLevelledEEPROMByte<decltype(j), 4> bj(j, 32);
+  bj.set(1);
+  bj.set(2);
+  EXPECT_EQ(2, bj.get());
+  EXPECT_EQ(4, j.pendingCount());
+  j.flush();
+  OTV0P2BASE::WearLevelledEEPROMByte<decltype(store), 4> r2(store, 32);
+  EXPECT_EQ(2, r2.get());
+  }
@@ -0,0 +1,115 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for SecureRandomPool tests.
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_EntropyPool.h"
+
+
+// ChaCha20 block function against the RFC 8439 section 2.3.2 test vector.
+TEST(EntropyPool,chacha20Block)
+{
+    uint8_t key[32];
+    for(uint8_t i = 0; i < sizeof(key); ++i) { key[i] = i; }
+    const uint8_t nonce[12] = { 0, 0, 0, 9, 0, 0, 0, 0x4a, 0, 0, 0, 0 };
+    static const uint8_t expected[64] = {
+        0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15, 0x50, 0x0f, 0xdd, 0x1f, 0xa3, 0x20, 0x71, 0xc4,
+        0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0, 0x68, 0x03, 0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e,
+        0xd2, 0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09, 0x14, 0xc2, 0xd7, 0x05, 0xd9, 0x8b, 0x02, 0xa2,
+        0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e, 0xb9, 0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e,
+        };
+    uint8_t out[64];
+    OTV0P2BASE::chacha20Block(key, 1, nonce, out);
+    EXPECT_EQ(0, memcmp(expected, out, sizeof(out)));
+}
+
+namespace EPT
+{
+static uint8_t sourceCalls;
+// Deterministic stand-in for a slow noise source.
+static uint8_t source() { return(uint8_t(0x5a + 37 * sourceCalls++)); }
+}
+
+// Nothing is released until seeded; refill then serves bytes without touching the source.
+TEST(EntropyPool,seedingAndBuffering)
+{
+    EPT::sourceCalls = 0;
+    OTV0P2BASE::SecureRandomPool<8> p(EPT::source, 4);
+    EXPECT_FALSE(p.isSeeded());
+    uint8_t b;
+    EXPECT_FALSE(p.get(b));
+    // First refill seeds: 128 bits at 4 bits/byte.
+    EXPECT_EQ(8, p.refill());
+    EXPECT_TRUE(p.isSeeded());
+    EXPECT_EQ(32, EPT::sourceCalls);
+    // Full buffer: refill does no work.
+    EXPECT_EQ(8, p.refill());
+    EXPECT_EQ(32, EPT::sourceCalls);
+    // Bytes are taken at once, and not repeated wholesale across refills.
+    uint8_t first[8], second[8];
+    for(uint8_t i = 0; i < 8; ++i) { EXPECT_TRUE(p.get(first[i])); }
+    EXPECT_EQ(0, p.available());
+    EXPECT_FALSE(p.get(b));
+    EXPECT_EQ(8, p.refill());
+    EXPECT_EQ(33, EPT::sourceCalls);
+    EXPECT_TRUE(p.get(second, sizeof(second)));
+    EXPECT_NE(0, memcmp(first, second, sizeof(first)));
+    // Bulk get refills transparently.
+    uint8_t many[20];
+    EXPECT_TRUE(p.get(many, sizeof(many)));
+    EXPECT_EQ(4, p.available());
+    p.discard();
+    EXPECT_EQ(0, p.available());
+}
+
+// Without a source the pool is seeded only by credited entropy.
+TEST(EntropyPool,addEntropyOnly)
+{
+    OTV0P2BASE::SecureRandomPool<> p;
+    uint8_t out[4];
+    EXPECT_FALSE(p.get(out, sizeof(out)));
+    // Uncredited input is mixed in but does not count.
+    for(uint8_t i = 0; i < 100; ++i) { p.addEntropy(i, 0); }
+    EXPECT_FALSE(p.isSeeded());
+    for(uint8_t i = 0; i < 15; ++i) { p.addEntropy(i, 8); }
+    EXPECT_FALSE(p.isSeeded());
+    // Over-estimates are clamped to 8 bits.
+    p.addEntropy(0xff, 200);
+    EXPECT_TRUE(p.isSeeded());
+    EXPECT_EQ(16, p.refill());
+    EXPECT_TRUE(p.get(out, sizeof(out)));
+    EXPECT_EQ(12, p.available());
+    // Same inputs give the same output; different inputs differ.
+    OTV0P2BASE::SecureRandomPool<> q, r;
+    for(uint8_t i = 0; i < 16; ++i) { q.addEntropy(i, 8); r.addEntropy(i ^ (15 == i), 8); }
+    uint8_t oq[16], oq2[16], or_[16];
+    EXPECT_TRUE(q.get(oq, sizeof(oq)));
+    OTV0P2BASE::SecureRandomPool<> q2;
+    for(uint8_t i = 0; i < 16; ++i) { q2.addEntropy(i, 8); }
+    EXPECT_TRUE(q2.get(oq2, sizeof(oq2)));
+    EXPECT_EQ(0, memcmp(oq, oq2, sizeof(oq)));
+    EXPECT_TRUE(r.get(or_, sizeof(or_)));
+    EXPECT_NE(0, memcmp(oq, or_, sizeof(oq)));
+}
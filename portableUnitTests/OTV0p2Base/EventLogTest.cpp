@@ -0,0 +1,187 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for EventLog tests.
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_EventLog.h"
+
+
+namespace ELT
+{
+typedef OTV0P2BASE::EEPROMJournalMockStore<64> Store;
+typedef OTV0P2BASE::EventLog<Store, 4> Log;
+// Log area within the store.
+static constexpr uintptr_t START = 8;
+static constexpr uint8_t SLOTS = 6;
+
+// Stats sink remembering the last value put for each key.
+struct Stats final
+    {
+    const char *keys[4];
+    int16_t values[4];
+    uint8_t n = 0;
+    bool put(const char *const key, const int16_t v, const bool lowPriority)
+        {
+        EXPECT_TRUE(lowPriority);
+        keys[n] = key; values[n] = v; ++n;
+        return(true);
+        }
+    int16_t get(const char *const key) const
+        {
+        for(uint8_t i = 0; i < n; ++i) { if(0 == strcmp(key, keys[i])) { return(values[i]); } }
+        return(-1);
+        }
+    };
+}
+
+// Events are held in RAM until flushed, then read back oldest first.
+TEST(EventLog,flushAndRead)
+{
+    ELT::Store store;
+    ELT::Log l(store, ELT::START, ELT::SLOTS);
+    EXPECT_EQ(5, l.capacity());
+    EXPECT_EQ(0, l.size());
+    l.log(5, 1, 100);
+    l.log(-21, 2, 101);
+    // Code 0 is not logged.
+    l.log(0, 3, 102);
+    EXPECT_EQ(2, l.pending());
+    EXPECT_EQ(0, l.size());
+    EXPECT_EQ(0, store.writes);
+    EXPECT_EQ(2, l.flush());
+    EXPECT_EQ(0, l.pending());
+    EXPECT_EQ(2, l.size());
+    OTV0P2BASE::EventRecord r;
+    ASSERT_TRUE(l.get(0, r));
+    EXPECT_EQ(100, r.time);
+    EXPECT_EQ(5, r.code);
+    EXPECT_EQ(1, r.arg);
+    ASSERT_TRUE(l.get(1, r));
+    EXPECT_EQ(101, r.time);
+    EXPECT_EQ(-21, r.code);
+    EXPECT_EQ(2, r.arg);
+    EXPECT_FALSE(l.get(2, r));
+    // Nothing is written outside the area.
+    for(uintptr_t a = 0; a < ELT::START; ++a) { EXPECT_EQ(0xff, store.read(a)); }
+    for(uintptr_t a = ELT::START + (ELT::SLOTS * OTV0P2BASE::EVENT_RECORD_BYTES); a < 64; ++a) { EXPECT_EQ(0xff, store.read(a)); }
+    // Nothing to do with nothing pending.
+    const uint16_t w = store.writes;
+    EXPECT_EQ(0, l.flush());
+    EXPECT_EQ(w, store.writes);
+}
+
+// The EEPROM ring keeps the newest capacity() events and wraps round all slots.
+TEST(EventLog,wrap)
+{
+    ELT::Store store;
+    ELT::Log l(store, ELT::START, ELT::SLOTS);
+    for(uint8_t i = 1; i <= 12; ++i) { l.log(int8_t(i), i, i); l.flush(); }
+    EXPECT_EQ(5, l.size());
+    OTV0P2BASE::EventRecord r;
+    for(uint8_t i = 0; i < 5; ++i)
+        {
+        ASSERT_TRUE(l.get(i, r));
+        EXPECT_EQ(8 + i, r.code);
+        }
+    EXPECT_EQ(0, l.getDropped());
+    // Each slot's code byte has been written.
+    for(uint8_t s = 0; s < ELT::SLOTS; ++s)
+        { EXPECT_NE(0xff, store.read(ELT::START + (s * OTV0P2BASE::EVENT_RECORD_BYTES) + 2)); }
+}
+
+// The log carries on from where it was after a restart.
+TEST(EventLog,restart)
+{
+    ELT::Store store;
+        {
+        ELT::Log l(store, ELT::START, ELT::SLOTS);
+        for(uint8_t i = 1; i <= 7; ++i) { l.log(int8_t(i), 0, i); }
+        // Full RAM ring drops the oldest pending.
+        EXPECT_EQ(4, l.pending());
+        EXPECT_EQ(3, l.getDropped());
+        EXPECT_EQ(4, l.flush());
+        }
+    ELT::Log l(store, ELT::START, ELT::SLOTS);
+    EXPECT_EQ(4, l.size());
+    l.log(20, 0, 20);
+    l.log(21, 0, 21);
+    l.flush();
+    EXPECT_EQ(5, l.size());
+    OTV0P2BASE::EventRecord r;
+    ASSERT_TRUE(l.get(0, r));
+    EXPECT_EQ(5, r.code);
+    ASSERT_TRUE(l.get(4, r));
+    EXPECT_EQ(21, r.code);
+}
+
+// A flush larger than the EEPROM ring keeps only the newest.
+TEST(EventLog,appendOverCapacity)
+{
+    ELT::Store store;
+    ELT::Log l(store, ELT::START, ELT::SLOTS);
+    OTV0P2BASE::EventRecord buf[7];
+    for(uint8_t i = 0; i < 7; ++i) { buf[i].time = i; buf[i].code = int8_t(i + 1); buf[i].arg = 0; }
+    EXPECT_EQ(5, l.append(buf, 7));
+    EXPECT_EQ(2, l.getDropped());
+    OTV0P2BASE::EventRecord r;
+    ASSERT_TRUE(l.get(0, r));
+    EXPECT_EQ(3, r.code);
+}
+
+// clear() erases the area and counts.
+TEST(EventLog,clear)
+{
+    ELT::Store store;
+    ELT::Log l(store, ELT::START, ELT::SLOTS);
+    l.log(1, 0, 0);
+    l.flush();
+    l.log(2, 0, 0);
+    l.clear();
+    EXPECT_EQ(0, l.size());
+    EXPECT_EQ(0, l.pending());
+    EXPECT_EQ(0, l.getTotal());
+    for(uintptr_t a = 0; a < 64; ++a) { EXPECT_EQ(0xff, store.read(a)); }
+    l.log(3, 0, 0);
+    l.flush();
+    EXPECT_EQ(1, l.size());
+}
+
+// Stats summary: total since start-up, and the last code once there is one.
+TEST(EventLog,stats)
+{
+    ELT::Store store;
+    ELT::Log l(store, ELT::START, ELT::SLOTS);
+    ELT::Stats ss0;
+    OTV0P2BASE::putEventLogStats(ss0, l);
+    EXPECT_EQ(1, ss0.n);
+    EXPECT_EQ(0, ss0.get("ev"));
+    l.log(5, 0, 0);
+    l.log(-5, 0, 0);
+    ELT::Stats ss;
+    OTV0P2BASE::putEventLogStats(ss, l);
+    EXPECT_EQ(2, ss.n);
+    EXPECT_EQ(2, ss.get("ev"));
+    EXPECT_EQ(-5, ss.get("evL"));
+}
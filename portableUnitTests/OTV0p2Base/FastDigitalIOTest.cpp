@@ -0,0 +1,66 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2018
+*/
+
+/*
+ * Driver for OTV0p2Base fast digital I/O pin mapping tests.
+ */
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+
+
+// Arduino pin numbers map to the ATmega328P ports and bits.
+TEST(FastDigitalIO,mapATmega328P)
+{
+    typedef OTV0P2BASE::FastPinMapATmega328P m;
+    static_assert(0 == m::port(7) && 7 == m::bit(7), "PD7");
+    static_assert(1 == m::port(13) && 5 == m::bit(13), "PB5");
+    static_assert(2 == m::port(14) && 0 == m::bit(14), "PC0");
+    EXPECT_EQ(0x80, m::mask(7));
+    EXPECT_EQ(0x20, m::mask(13));
+    EXPECT_EQ(0x20, m::mask(19));
+    EXPECT_EQ(0, m::mask(20));
+    EXPECT_EQ(int(m::invalidPort), m::port(20));
+}
+
+// EFR32 pin numbers round-trip through the mapping.
+TEST(FastDigitalIO,mapEFR32)
+{
+    typedef OTV0P2BASE::FastPinMapEFR32 m;
+    constexpr uint8_t pf3 = OTV0P2BASE::efr32Pin(5, 3);
+    static_assert((5 == m::port(pf3)) && (3 == m::bit(pf3)), "PF3");
+    EXPECT_EQ(0x8000, m::mask(OTV0P2BASE::efr32Pin(0, 15)));
+    EXPECT_EQ(int(m::invalidPort), m::port(OTV0P2BASE::efr32Pin(12, 0)));
+}
+
+// Group masks combine pins on one port.
+TEST(FastDigitalIO,pinGroup)
+{
+    // V0p2 SPI nSS (D10), MOSI (D11) and SCK (D13), all on port B.
+    typedef OTV0P2BASE::FastPinGroupT<OTV0P2BASE::FastPinMapATmega328P, 10, 11, 13> spi;
+    const uint8_t port = spi::port;
+    const uint16_t mask = spi::mask;
+    EXPECT_EQ(1, port);
+    EXPECT_EQ(0x2c, mask);
+    EXPECT_EQ(0x04, spi::bitOf(10));
+    typedef OTV0P2BASE::FastPinGroupT<OTV0P2BASE::FastPinMapEFR32, OTV0P2BASE::efr32Pin(2, 6), OTV0P2BASE::efr32Pin(2, 9)> efr;
+    const uint16_t efrMask = efr::mask;
+    EXPECT_EQ(0x240, efrMask);
+    // Pins on different ports fail to compile, eg FastPinGroup<7, 8>.
+}
@@ -0,0 +1,105 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for OTV0p2Base fast integer formatting tests.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+
+#include "OTV0P2BASE_FastFormat.h"
+
+
+// Every value formats as printf() would, with the end pointer at the '\0'.
+TEST(FastFormat,Exhaustive)
+{
+    char expected[16];
+    char buf[16];
+    for(uint16_t v = 0; v <= 255; ++v)
+        {
+        snprintf(expected, sizeof(expected), "%u", unsigned(v));
+        const char *const e = OTV0P2BASE::formatU8(buf, uint8_t(v));
+        ASSERT_STREQ(expected, buf);
+        ASSERT_EQ(strlen(expected), size_t(e - buf));
+        ASSERT_LT(size_t(e - buf), size_t(OTV0P2BASE::FORMAT_U8_CHARS));
+        }
+    for(uint32_t v = 0; v <= 0xffff; ++v)
+        {
+        snprintf(expected, sizeof(expected), "%u", unsigned(v));
+        const char *e = OTV0P2BASE::formatU16(buf, uint16_t(v));
+        ASSERT_STREQ(expected, buf);
+        ASSERT_EQ(strlen(expected), size_t(e - buf));
+        snprintf(expected, sizeof(expected), "%d", int(int16_t(v)));
+        e = OTV0P2BASE::formatI16(buf, int16_t(v));
+        ASSERT_STREQ(expected, buf);
+        ASSERT_EQ(strlen(expected), size_t(e - buf));
+        ASSERT_LT(size_t(e - buf), size_t(OTV0P2BASE::FORMAT_I16_CHARS));
+        snprintf(expected, sizeof(expected), "%X", unsigned(v));
+        e = OTV0P2BASE::formatHex16(buf, uint16_t(v));
+        ASSERT_STREQ(expected, buf);
+        ASSERT_EQ(strlen(expected), size_t(e - buf));
+        }
+}
+
+// Output matches Print, so the two can be swapped in existing output.
+TEST(FastFormat,MatchesPrint)
+{
+    char p[16];
+    char buf[16];
+    const int16_t values[] = { 0, 9, 10, 99, 100, 999, 1000, 4095, 32767, -1, -10, -32768 };
+    for(const int16_t v : values)
+        {
+        OTV0P2BASE::BufPrint bp(p, sizeof(p));
+        bp.print(int(v));
+        OTV0P2BASE::formatI16(buf, v);
+        EXPECT_STREQ(p, buf);
+        }
+}
+
+// C16 temperatures round to the nearest tenth.
+TEST(FastFormat,C16)
+{
+    char buf[OTV0P2BASE::FORMAT_C16_CHARS];
+    OTV0P2BASE::formatC16(buf, (18 << 4) + 8);
+    EXPECT_STREQ("18.5", buf);
+    OTV0P2BASE::formatC16(buf, 0);
+    EXPECT_STREQ("0.0", buf);
+    OTV0P2BASE::formatC16(buf, 1); // 0.0625
+    EXPECT_STREQ("0.1", buf);
+    OTV0P2BASE::formatC16(buf, 4); // 0.25
+    EXPECT_STREQ("0.3", buf);
+    OTV0P2BASE::formatC16(buf, 15); // 0.9375
+    EXPECT_STREQ("0.9", buf);
+    OTV0P2BASE::formatC16(buf, -((5 << 4) + 8));
+    EXPECT_STREQ("-5.5", buf);
+    const char *const e = OTV0P2BASE::formatC16(buf, INT16_MIN);
+    EXPECT_STREQ("-2048.0", buf);
+    EXPECT_EQ(OTV0P2BASE::FORMAT_C16_CHARS - 1, e - buf);
+    // Each value is within half a tenth.
+    for(int32_t c16 = -2048; c16 <= 2048; ++c16)
+        {
+        OTV0P2BASE::formatC16(buf, int16_t(c16));
+        const double shown = atof(buf);
+        ASSERT_NEAR(c16 / 16.0, shown, 0.05 + 1e-9) << c16;
+        }
+}
@@ -0,0 +1,154 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for flash EEPROM emulation tests.
+ */
+
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_FlashEEPROM.h"
+
+
+namespace FET
+{
+typedef OTV0P2BASE::FlashEEPROMMockFlash<2048> Flash;
+typedef OTV0P2BASE::FlashEEPROM<Flash> EE;
+}
+
+// A fresh flash is formatted as erased, and flushed bytes survive a restart.
+TEST(FlashEEPROM,persists)
+{
+    FET::Flash flash;
+    {
+    FET::EE ee(flash);
+    EXPECT_FALSE(ee.begin());
+    EXPECT_EQ(0xff, ee.read(0));
+    EXPECT_TRUE(ee.update(OTV0P2BASE::V0P2BASE_EE_START_EVENT_LOG, 42));
+    EXPECT_FALSE(ee.update(OTV0P2BASE::V0P2BASE_EE_START_EVENT_LOG, 42));
+    EXPECT_TRUE(ee.update(1023, 0));
+    EXPECT_FALSE(ee.update(1024, 0));
+    EXPECT_EQ(2, ee.pending());
+    EXPECT_EQ(2, ee.flush());
+    EXPECT_EQ(0, ee.pending());
+    // Not yet flushed, so lost.
+    ee.update(5, 5);
+    }
+    FET::EE ee(flash);
+    EXPECT_TRUE(ee.begin());
+    EXPECT_EQ(42, ee.read(OTV0P2BASE::V0P2BASE_EE_START_EVENT_LOG));
+    EXPECT_EQ(0, ee.read(1023));
+    EXPECT_EQ(0xff, ee.read(5));
+    EXPECT_EQ(0xff, ee.read(1024));
+}
+
+// Many writes cost one erase per compaction, not one per byte.
+TEST(FlashEEPROM,compaction)
+{
+    FET::Flash flash;
+    FET::EE ee(flash);
+    ee.begin();
+    const uint16_t erasesAtStart = flash.erases;
+    const uint32_t writes = 10000;
+    for(uint32_t i = 0; i < writes; ++i) { ee.update(uint16_t((i * 7) % 1024), uint8_t(i)); }
+    ee.flush();
+    EXPECT_LT(0, ee.getCompactions());
+    EXPECT_EQ(flash.erases - erasesAtStart, ee.getCompactions());
+    EXPECT_GT(writes / 100, uint32_t(flash.erases));
+    // The image survives intact.
+    uint8_t expected[1024];
+    for(uint16_t a = 0; a < 1024; ++a) { expected[a] = ee.read(a); }
+    FET::EE ee2(flash);
+    EXPECT_TRUE(ee2.begin());
+    for(uint16_t a = 0; a < 1024; ++a) { ASSERT_EQ(expected[a], ee2.read(a)) << a; }
+}
+
+// Background compaction proceeds in small steps and keeps concurrent updates.
+TEST(FlashEEPROM,poll)
+{
+    FET::Flash flash;
+    FET::EE ee(flash);
+    ee.begin();
+    EXPECT_FALSE(ee.poll());
+    // Fill the log to the compaction threshold.
+    uint16_t a = 0;
+    while(ee.logFree() > (FET::EE::PAGE_WORDS - FET::EE::COMPACT_AT))
+        { ee.update(a, uint8_t(a)); ee.flush(); ++a; }
+    EXPECT_TRUE(ee.poll(8)); // Erase.
+    EXPECT_TRUE(ee.poll(8));
+    // Update both an already-copied and a not-yet-copied byte mid-compaction.
+    ee.update(0, 0x55);
+    ee.update(1000, 0x66);
+    while(ee.poll(8)) { }
+    EXPECT_EQ(1, ee.getCompactions());
+    EXPECT_EQ(int(FET::EE::LOG_RECORDS), ee.logFree());
+    ee.flush();
+    FET::EE ee2(flash);
+    EXPECT_TRUE(ee2.begin());
+    EXPECT_EQ(0x55, ee2.read(0));
+    EXPECT_EQ(0x66, ee2.read(1000));
+    EXPECT_EQ(7, ee2.read(7));
+}
+
+// A power failure at any point in flushing loses at most the unflushed updates.
+TEST(FlashEEPROM,powerFailure)
+{
+    for(int32_t failAt = 0; failAt < 300; failAt += 7)
+        {
+        FET::Flash flash;
+        FET::EE ee(flash);
+        ee.begin();
+        // Fill the log to just before forced compaction.
+        for(uint16_t i = 0; ee.logFree() > 1; ++i) { ee.update(uint16_t(i % 64), uint8_t(i)); ee.flush(); }
+        uint8_t before[1024];
+        for(uint16_t a = 0; a < 1024; ++a) { before[a] = ee.read(a); }
+        flash.writesUntilFailure = failAt;
+        for(uint16_t a = 100; a < 110; ++a) { ee.update(a, 0); }
+        ee.flush();
+        FET::EE ee2(flash);
+        EXPECT_TRUE(ee2.begin());
+        // Each byte is either as before or as updated.
+        for(uint16_t a = 0; a < 1024; ++a)
+            {
+            const uint8_t v = ee2.read(a);
+            if((a >= 100) && (a < 110)) { ASSERT_TRUE((before[a] == v) || (0 == v)) << failAt << " " << a; }
+            else { ASSERT_EQ(before[a], v) << failAt << " " << a; }
+            }
+        }
+}
+
+// Usable as a store, eg for the event log at its normal address.
+TEST(FlashEEPROM,store)
+{
+    FET::Flash flash;
+    FET::EE ee(flash);
+    ee.begin();
+    OTV0P2BASE::EventLog<FET::EE> log(ee, OTV0P2BASE::V0P2BASE_EE_START_EVENT_LOG, OTV0P2BASE::V0P2BASE_EE_EVENT_LOG_SLOTS);
+    log.log(3, 4, 100);
+    log.flush();
+    ee.flush();
+    FET::EE ee2(flash);
+    ee2.begin();
+    OTV0P2BASE::EventLog<FET::EE> log2(ee2, OTV0P2BASE::V0P2BASE_EE_START_EVENT_LOG, OTV0P2BASE::V0P2BASE_EE_EVENT_LOG_SLOTS);
+    OTV0P2BASE::EventRecord r;
+    ASSERT_TRUE(log2.get(0, r));
+    EXPECT_EQ(3, r.code);
+    EXPECT_EQ(4, r.arg);
+}
@@ -0,0 +1,161 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Host-side emulation of an ISR preempting the main loop,
+ * for stress tests of ISR/main-loop shared structures.
+ *
+ * An 'ISR' body runs repeatedly on its own thread, but as on a
+ * single-core MCU it never runs alongside the main thread:
+ * the main thread owns the emulated CPU and gives it up only at
+ * its preemption points, where any pending ISR runs to completion.
+ * Preemption points are where interrupts would be enabled,
+ * ie between calls on the structure under test,
+ * and are taken at random as well as whenever an ISR is pending.
+ *
+ * The handover is through a mutex, so when built with
+ * ThreadSanitizer (-fsanitize=thread, eg meson -Db_sanitize=thread)
+ * any access to shared state that escapes the emulated CPU is reported.
+ *
+ * Structures meant to be lock-free across real cores (eg SPSCQueue)
+ * can instead be run on free-running threads,
+ * with randomPause() between operations to vary the interleavings.
+ */
+
+#ifndef OTV0P2BASE_ISREMULATION_H
+#define OTV0P2BASE_ISREMULATION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace OTV0P2BASE
+{
+namespace PortableUnitTest
+{
+
+// Multiplier for stress test iteration counts from OTRL_STRESS_SCALE; at least 1.
+inline uint32_t stressScale()
+    {
+    const char *const s = std::getenv("OTRL_STRESS_SCALE");
+    const long v = (NULL == s) ? 1 : std::atol(s);
+    return((v < 1) ? 1 : uint32_t(v));
+    }
+
+// Spin for a random short while, sometimes yielding, to vary interleavings.
+template<class rng_t>
+inline void randomPause(rng_t &rng, const uint8_t maxSpins = 64)
+    {
+    const uint32_t r = uint32_t(rng());
+    if(0 == (r & 0xf)) { std::this_thread::yield(); return; }
+    for(volatile uint32_t i = (r >> 4) % (1U + maxSpins); i > 0; i = i - 1) { }
+    }
+
+// Emulates one ISR preempting the main (constructing) thread.
+// Construct, call start() with the ISR body,
+// call preemptionPoint() often from the main thread, then stop().
+class ISREmulator final
+    {
+    private:
+        // The emulated CPU: held by whichever side is running.
+        std::mutex cpu;
+        // True while the ISR thread wants the CPU.
+        std::atomic<bool> pending;
+        std::atomic<bool> stopping;
+        std::thread isrThread;
+        // Main-side randomness for taking preemption points.
+        std::minstd_rand rng;
+        // ISR bodies run.
+        std::atomic<uint32_t> isrRuns;
+
+    public:
+        explicit ISREmulator(const uint32_t seed)
+          : pending(false), stopping(false), rng(seed), isrRuns(0)
+            { cpu.lock(); }
+        ~ISREmulator() { stop(); cpu.unlock(); }
+
+        // Start running isr repeatedly, with random gaps between runs.
+        void start(std::function<void()> isr)
+            {
+            const uint32_t seed = uint32_t(rng());
+            isrThread = std::thread([this, isr, seed]()
+                {
+                std::minstd_rand r(seed);
+                while(!stopping.load())
+                    {
+                    randomPause(r);
+                    pending.store(true);
+                        {
+                        std::lock_guard<std::mutex> g(cpu);
+                        if(!stopping.load()) { isr(); isrRuns.fetch_add(1); }
+                        }
+                    pending.store(false);
+                    }
+                });
+            }
+
+        // Main thread only: let a pending ISR run once here, and sometimes give up the CPU anyway.
+        void preemptionPoint()
+            {
+            if(!pending.load() && (0 != (rng() & 7))) { return; }
+            const uint32_t runs = isrRuns.load();
+            cpu.unlock();
+            while(pending.load() && (runs == isrRuns.load())) { std::this_thread::yield(); }
+            cpu.lock();
+            }
+
+        // Main thread only: stop the ISR thread and release the CPU.
+        void stop()
+            {
+            if(!isrThread.joinable()) { return; }
+            stopping.store(true);
+            cpu.unlock();
+            isrThread.join();
+            cpu.lock();
+            }
+
+        // ISR bodies run so far.
+        uint32_t getISRRuns() const { return(isrRuns.load()); }
+    };
+
+// Wall-clock timer for throughput reports.
+class StressTimer final
+    {
+    private:
+        const std::chrono::steady_clock::time_point t0;
+    public:
+        StressTimer() : t0(std::chrono::steady_clock::now()) { }
+        // Print items per second since construction, labelled.
+        void report(const char *const label, const uint32_t items) const
+            {
+            const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            std::printf("ConcurrencyStress %s: %lu in %.3fs, %.0f/s\n",
+                label, (unsigned long)items, s, (s > 0) ? (items / s) : 0.0);
+            }
+    };
+
+}
+}
+
+#endif
@@ -0,0 +1,192 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for ISRLatencyMonitor tests,
+ * including RFM23B RX coexistence with bit-banged soft serial on a mock timer.
+ */
+
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_ISRLatency.h"
+
+namespace ILP = OTV0P2BASE::ISRLatencyPath;
+
+
+// Nested sections count against the outermost, with a max and count per path.
+TEST(ISRLatency,masking)
+{
+    OTV0P2BASE::ISRLatencyMonitor<8> m;
+    EXPECT_FALSE(m.isMasked());
+    m.maskBegin(ILP::RFM23B_POLL, 100);
+    m.maskBegin(ILP::RFM23B_RXFIFO, 110);
+    EXPECT_TRUE(m.isMasked());
+    m.maskEnd(150);
+    EXPECT_TRUE(m.isMasked());
+    m.maskEnd(300);
+    EXPECT_FALSE(m.isMasked());
+    EXPECT_EQ(200U, m.getMaxMaskedTicks(ILP::RFM23B_POLL));
+    EXPECT_EQ(0U, m.getMaxMaskedTicks(ILP::RFM23B_RXFIFO));
+    m.maskBegin(ILP::RFM23B_POLL, 400);
+    m.maskEnd(450);
+    EXPECT_EQ(200U, m.getMaxMaskedTicks(ILP::RFM23B_POLL));
+    EXPECT_EQ(2U, m.getMaskedCount(ILP::RFM23B_POLL));
+    // Unbalanced ends are ignored.
+    m.maskEnd(500);
+    EXPECT_EQ(2U, m.getMaskedCount(ILP::RFM23B_POLL));
+    // Out-of-range paths go to the last slot.
+    m.maskBegin(ILP::APP, 1000);
+    m.maskEnd(1007);
+    EXPECT_EQ(7U, m.getMaxMaskedTicks(7));
+}
+
+// An IRQ raised while masked waits for the outermost section to end.
+TEST(ISRLatency,entryLatency)
+{
+    OTV0P2BASE::ISRLatencyMonitor<> m;
+    // Interrupts enabled: entered at once.
+    m.irqRaised(10);
+    EXPECT_FALSE(m.isPending());
+    EXPECT_EQ(0U, m.getWorstEntryLatencyTicks());
+    m.maskBegin(ILP::SOFTSERIAL_TX, 100);
+    m.irqRaised(120);
+    EXPECT_TRUE(m.isPending());
+    // A second edge while pending does not restart the wait.
+    m.irqRaised(500);
+    m.maskEnd(1140);
+    EXPECT_FALSE(m.isPending());
+    EXPECT_EQ(1020U, m.getMaxEntryLatencyTicks(ILP::SOFTSERIAL_TX));
+    EXPECT_EQ(0U, m.getMaxEntryLatencyTicks(ILP::RFM23B_POLL));
+    // Explicit entry time, eg including the CPU's own entry overhead.
+    m.irqRaised(2000, false);
+    EXPECT_TRUE(m.isPending());
+    m.isrEntered(2004);
+    EXPECT_EQ(4U, m.getMaxEntryLatencyTicks(ILP::NONE));
+    EXPECT_EQ(1020U, m.getWorstEntryLatencyTicks());
+    // Nothing pending: ignored.
+    m.isrEntered(5000);
+    EXPECT_EQ(4U, m.getMaxEntryLatencyTicks(ILP::NONE));
+}
+
+// Bounds report the first failing path; zero bounds are unchecked.
+TEST(ISRLatency,bounds)
+{
+    OTV0P2BASE::ISRLatencyMonitor<> m;
+    m.maskBegin(ILP::RFM23B_POLL, 0);
+    m.maskEnd(800);
+    m.maskBegin(ILP::SOFTSERIAL_TX, 1000);
+    m.irqRaised(1000);
+    m.maskEnd(2100);
+    const OTV0P2BASE::ISRLatencyBound ok[] = {
+        { ILP::RFM23B_POLL, 800, 0 },
+        { ILP::SOFTSERIAL_TX, 0, 1100 },
+        };
+    uint8_t failed = 0xff;
+    EXPECT_TRUE(m.withinBounds(ok, 2, failed));
+    EXPECT_EQ(0xff, failed);
+    const OTV0P2BASE::ISRLatencyBound tight[] = {
+        { ILP::RFM23B_POLL, 800, 0 },
+        { ILP::SOFTSERIAL_TX, 0, 1099 },
+        { ILP::RFM23B_POLL, 799, 0 },
+        };
+    EXPECT_FALSE(m.withinBounds(tight, 3, failed));
+    EXPECT_EQ(ILP::SOFTSERIAL_TX, failed);
+    EXPECT_FALSE(m.withinBounds(tight + 2, 1, failed));
+    EXPECT_EQ(ILP::RFM23B_POLL, failed);
+}
+
+TEST(ISRLatency,rxFIFOHeadroom)
+{
+    // RFM23B: 64-byte FIFO, default almost-full threshold of 55, at 57600bps.
+    EXPECT_EQ(1250U, OTV0P2BASE::rxFIFOHeadroomUs(64, 55, 57600));
+    EXPECT_EQ(5000U, OTV0P2BASE::rxFIFOHeadroomUs(64, 61, 4800));
+    EXPECT_EQ(0U, OTV0P2BASE::rxFIFOHeadroomUs(64, 64, 57600));
+}
+
+namespace {
+// Event-driven run of the main loop and ISRs against a mock us timer.
+class Coexistence final
+    {
+    public:
+        OTV0P2BASE::ISRLatencyMonitor<> m;
+        uint32_t nowUs = 0;
+        // Deterministic pseudo-random IRQ placement.
+        uint32_t seed = 1;
+        uint32_t next(const uint32_t n) { seed = seed * 1103515245U + 12345U; return((seed >> 8) % n); }
+
+        // Run a masked section for durationUs, raising the radio IRQ irqAtUs into it (if less).
+        // The ISR runs as soon as interrupts are re-enabled.
+        void masked(const uint8_t path, const uint32_t durationUs, const uint32_t irqAtUs)
+            {
+            m.maskBegin(path, nowUs);
+            bool raised = false;
+            if(irqAtUs < durationUs) { m.irqRaised(nowUs + irqAtUs); raised = true; }
+            nowUs += durationUs;
+            m.maskEnd(nowUs);
+            if(raised) { isr(); }
+            }
+        // The RFM23B ISR, itself masked, draining a frame at ~12us/byte
+        // (see OTRFM23BLink::_handleInterruptNonVirtual()).
+        void isr()
+            {
+            m.maskBegin(ILP::RFM23B_ISR, nowUs);
+            nowUs += 100 + (12 * 64);
+            m.maskEnd(nowUs);
+            }
+        // Blocking soft-serial TX of len bytes at baud, each byte masked for its 10 bit times,
+        // with ~20us of loop overhead with interrupts enabled between bytes;
+        // one radio IRQ lands at a random point of every 4th byte.
+        void softSerialTX(const uint32_t baud, const uint16_t len)
+            {
+            const uint32_t byteUs = (10 * 1000000UL) / baud;
+            for(uint16_t i = 0; i < len; ++i)
+                {
+                masked(ILP::SOFTSERIAL_TX, byteUs, (0 == (i & 3)) ? next(byteUs) : byteUs);
+                nowUs += 20;
+                }
+            }
+    };
+}
+
+// Bit-banged serial TX to a modem must not delay the RFM23B ISR
+// past the RX FIFO headroom, else frames arriving meanwhile are lost.
+TEST(ISRLatency,softSerialCoexistence)
+{
+    const uint32_t headroomUs = OTV0P2BASE::rxFIFOHeadroomUs(64, 55, 57600);
+    const OTV0P2BASE::ISRLatencyBound rxBounds[] = {
+        { ILP::SOFTSERIAL_TX, headroomUs, headroomUs },
+        { ILP::RFM23B_POLL, headroomUs, headroomUs },
+        };
+    uint8_t failed;
+
+    // 9600 baud: ~1042us per masked byte fits.
+    Coexistence c9600;
+    c9600.softSerialTX(9600, 200);
+    EXPECT_TRUE(c9600.m.withinBounds(rxBounds, 2, failed)) << int(failed);
+    EXPECT_EQ(1041U, c9600.m.getMaxMaskedTicks(ILP::SOFTSERIAL_TX));
+    EXPECT_GT(c9600.m.getMaxEntryLatencyTicks(ILP::SOFTSERIAL_TX), 900U);
+    EXPECT_EQ(50U, c9600.m.getMaskedCount(ILP::RFM23B_ISR));
+
+    // 4800 baud masks for twice as long and would overrun the FIFO.
+    Coexistence c4800;
+    c4800.softSerialTX(4800, 200);
+    EXPECT_FALSE(c4800.m.withinBounds(rxBounds, 2, failed));
+    EXPECT_EQ(ILP::SOFTSERIAL_TX, failed);
+}
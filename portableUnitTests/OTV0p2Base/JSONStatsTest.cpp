@@ -163,6 +163,14 @@ TEST(JSONStats,JSONForTX)
   EXPECT_TRUE(!(crc2 & 0x80));
   // Check for expected CRC value.
   EXPECT_TRUE(0x77 == crc2);
+  // Check that RX accepts the TX form with its CRC, and rejects a bad CRC.
+  const int l2 = (int)strlen(buf);
+  buf[l2] = char(crc2);
+  EXPECT_EQ(l2, OTV0P2BASE::checkJSONMsgRXCRC((const uint8_t *)buf, sizeof(buf)));
+  buf[l2] = char(crc2 ^ 1);
+  EXPECT_EQ(-1, OTV0P2BASE::checkJSONMsgRXCRC((const uint8_t *)buf, sizeof(buf)));
+  buf[l2] = '\0';
+  buf[l2-1] = '}';
 // FIXME
 //  // Check that TX-format can be converted for RX.
 //  const int l2o = strlen(buf);
@@ -175,6 +183,318 @@ TEST(JSONStats,JSONForTX)
   }
 
 
+// Check that caching rendered values gives exactly the same output as always
+// rendering afresh, through value changes, removal (which moves stats) and rotation.
+TEST(JSONStats,RenderCache)
+{
+    OTV0P2BASE::SimpleStatsRotation<4> plain;
+    OTV0P2BASE::SimpleStatsRotation<4, true> cached;
+    OTV0P2BASE::SimpleStatsRotationBase *const ss[2] = { &plain, &cached };
+    char buf[2][OTV0P2BASE::MSG_JSON_MAX_LENGTH + 2];
+    for(int round = 0; round < 40; ++round)
+        {
+        const int16_t v = (int16_t)((round * 997) - 20000);
+        for(int i = 0; i < 2; ++i)
+            {
+            ss[i]->setID(V0p2_SENSOR_TAG_F("1234"));
+            ss[i]->put(V0p2_SENSOR_TAG_F("a"), (int16_t)(round / 4));
+            ss[i]->put(V0p2_SENSOR_TAG_F("bb"), v);
+            ss[i]->put(V0p2_SENSOR_TAG_F("c|%"), (int16_t)-12345, true);
+            if(0 == (round % 7)) { ss[i]->remove(V0p2_SENSOR_TAG_F("a")); }
+            else { ss[i]->put(V0p2_SENSOR_TAG_F("d"), (int16_t)(round & 3) * 111); }
+            EXPECT_NE(0, ss[i]->writeJSON((uint8_t *)buf[i], sizeof(buf[i]), 0, 0 != (round & 1)));
+            }
+        EXPECT_STREQ(buf[0], buf[1]) << round;
+        }
+}
+
+// Check that keys are found whether or not they are the same pointer
+// as the one first put, and in whatever order they are put.
+TEST(JSONStats,FindByKey)
+{
+    OTV0P2BASE::SimpleStatsRotation<4> ss;
+    ss.put(V0p2_SENSOR_TAG_F("a"), 1);
+    ss.put(V0p2_SENSOR_TAG_F("b"), 2);
+    ss.put(V0p2_SENSOR_TAG_F("c"), 3);
+    // Equal keys in distinct storage.
+    char a[] = "a", b[] = "b", c[] = "c", d[] = "d";
+    EXPECT_TRUE(ss.containsKey(c));
+    EXPECT_TRUE(ss.containsKey(a));
+    EXPECT_TRUE(ss.containsKey(b));
+    EXPECT_FALSE(ss.containsKey(d));
+    // Updates in reverse order hit the existing entries.
+    EXPECT_TRUE(ss.put(c, 30));
+    EXPECT_TRUE(ss.put(b, 20));
+    EXPECT_TRUE(ss.put(a, 10));
+    EXPECT_EQ(3, ss.size());
+    // Removal moves the last entry down; all must still be found.
+    EXPECT_TRUE(ss.remove(a));
+    EXPECT_FALSE(ss.containsKey(V0p2_SENSOR_TAG_F("a")));
+    EXPECT_TRUE(ss.containsKey(V0p2_SENSOR_TAG_F("b")));
+    EXPECT_TRUE(ss.containsKey(V0p2_SENSOR_TAG_F("c")));
+    ss.setID(V0p2_SENSOR_TAG_F(""));
+    char buf[OTV0P2BASE::MSG_JSON_MAX_LENGTH + 2];
+    EXPECT_NE(0, ss.writeJSON((uint8_t *)buf, sizeof(buf), 0, true));
+    EXPECT_STREQ("{\"c\":30,\"b\":20}", buf);
+}
+
+// Check compact binary stats encoding, decoding and expansion to JSON.
+TEST(JSONStats,BinaryStats)
+{
+    const OTV0P2BASE::MSG_JSON_SimpleStatsKey_t keyTable[] = { "T|C16", "H|%", "L", "B|cV", "vac|h", "O" };
+    const OTV0P2BASE::SimpleStatsKeyTable keys(keyTable, sizeof(keyTable)/sizeof(keyTable[0]));
+    EXPECT_EQ(1, keys.idOf("H|%"));
+    EXPECT_EQ(-1, keys.idOf("bogus"));
+    OTV0P2BASE::SimpleStatsRotation<8> ss;
+    ss.put("T|C16", 321);
+    ss.put("H|%", 65);
+    ss.put("L", -64);
+    ss.put("B|cV", 32767, true);
+    ss.put("vac|h", -32768);
+    ss.put("notInTable", 1);
+    uint8_t buf[32];
+    const uint8_t l = ss.writeBinary(buf, sizeof(buf), keys);
+    // Header plus 3 + 3 + 2 + 4 + 4.
+    ASSERT_EQ(17, l);
+    EXPECT_EQ(OTV0P2BASE::MSG_BINARY_STATS_LEADING_BYTE, buf[0]);
+    // Decode back.
+    OTV0P2BASE::SimpleBinaryStatsReader r(buf, l);
+    uint8_t id;
+    int16_t v;
+    int fields = 0;
+    while(r.next(id, v))
+        {
+        ++fields;
+        switch(id)
+            {
+            case 0: EXPECT_EQ(321, v); break;
+            case 1: EXPECT_EQ(65, v); break;
+            case 2: EXPECT_EQ(-64, v); break;
+            case 3: EXPECT_EQ(32767, v); break;
+            case 4: EXPECT_EQ(-32768, v); break;
+            default: ADD_FAILURE() << (int)id; break;
+            }
+        }
+    EXPECT_TRUE(r.isComplete());
+    EXPECT_EQ(5, fields);
+    // Expand to JSON.
+    char json[OTV0P2BASE::MSG_JSON_MAX_LENGTH + 2];
+    char bigJSON[80];
+    EXPECT_EQ(58, OTV0P2BASE::expandSimpleBinaryStatsToJSON(buf, l, keys, bigJSON, sizeof(bigJSON)));
+    EXPECT_STREQ("{\"T|C16\":321,\"H|%\":65,\"L\":-64,\"B|cV\":32767,\"vac|h\":-32768}", bigJSON);
+    EXPECT_EQ(0, OTV0P2BASE::expandSimpleBinaryStatsToJSON(buf, l, keys, json, sizeof(json))) << "must not fit";
+    // Malformed: truncated value, bad header, unknown key.
+    EXPECT_EQ(0, OTV0P2BASE::expandSimpleBinaryStatsToJSON(buf, l - 1, keys, bigJSON, sizeof(bigJSON)));
+    const uint8_t badHeader[] = { '{', 0, 0 };
+    EXPECT_EQ(0, OTV0P2BASE::expandSimpleBinaryStatsToJSON(badHeader, sizeof(badHeader), keys, bigJSON, sizeof(bigJSON)));
+    const uint8_t unknownKey[] = { OTV0P2BASE::MSG_BINARY_STATS_LEADING_BYTE, 99, 0 };
+    EXPECT_EQ(0, OTV0P2BASE::expandSimpleBinaryStatsToJSON(unknownKey, sizeof(unknownKey), keys, bigJSON, sizeof(bigJSON)));
+    const uint8_t tooBig[] = { OTV0P2BASE::MSG_BINARY_STATS_LEADING_BYTE, 0, 0xff, 0xff, 0x07 };
+    EXPECT_EQ(0, OTV0P2BASE::expandSimpleBinaryStatsToJSON(tooBig, sizeof(tooBig), keys, bigJSON, sizeof(bigJSON)));
+    const uint8_t empty[] = { OTV0P2BASE::MSG_BINARY_STATS_LEADING_BYTE };
+    EXPECT_EQ(2, OTV0P2BASE::expandSimpleBinaryStatsToJSON(empty, sizeof(empty), keys, bigJSON, sizeof(bigJSON)));
+    EXPECT_STREQ("{}", bigJSON);
+    // Small buffer: a changed value goes first, and unchanged values rotate.
+    uint8_t small[5];
+    ss.put("O", 2);
+    EXPECT_EQ(3, ss.writeBinary(small, sizeof(small), keys));
+    EXPECT_EQ(5, small[1]);
+    EXPECT_EQ(4, small[2]);
+    bool seen[6] = { };
+    for(int i = 0; i < 6; ++i)
+        {
+        OTV0P2BASE::SimpleBinaryStatsReader rs(small, ss.writeBinary(small, sizeof(small), keys));
+        while(rs.next(id, v)) { ASSERT_GT(6, id); seen[id] = true; }
+        EXPECT_TRUE(rs.isComplete());
+        }
+    for(int i = 0; i < 6; ++i) { EXPECT_TRUE(seen[i]) << i; }
+}
+
+// Registered keys for the KeyRegistry test.
+namespace KeyRegistry
+{
+V0p2_SIMPLE_STATS_KEY_TEXT(keyTextT, "T|C16");
+V0p2_SIMPLE_STATS_KEY_TEXT(keyTextH, "H|%");
+V0p2_SIMPLE_STATS_KEY_TEXT(keyTextB, "B|cV");
+constexpr OTV0P2BASE::SimpleStatsKey statsKeys[] = { { keyTextT, 0 }, { keyTextH, 1 }, { keyTextB, 2, true } };
+static_assert(OTV0P2BASE::isWellFormedSimpleStatsKeyRegistry(statsKeys), "bad stats keys");
+// Badly-formed registries are rejected at compile time.
+constexpr OTV0P2BASE::SimpleStatsKey badID[] = { { "a", 0 }, { "b", 2 } };
+static_assert(!OTV0P2BASE::isWellFormedSimpleStatsKeyRegistry(badID), "IDs must be indexes");
+constexpr OTV0P2BASE::SimpleStatsKey dupText[] = { { "a", 0 }, { "b", 1 }, { "a", 2 } };
+static_assert(!OTV0P2BASE::isWellFormedSimpleStatsKeyRegistry(dupText), "text must be unique");
+constexpr OTV0P2BASE::SimpleStatsKey badText[] = { { "a\"", 0 } };
+static_assert(!OTV0P2BASE::isWellFormedSimpleStatsKeyRegistry(badText), "text must not need escaping");
+constexpr OTV0P2BASE::SimpleStatsKey emptyText[] = { { "", 0 } };
+static_assert(!OTV0P2BASE::isWellFormedSimpleStatsKeyRegistry(emptyText), "text must not be empty");
+}
+
+// Check stats put by registered key, and binary encoding with the registry IDs.
+TEST(JSONStats,KeyRegistry)
+{
+    using KeyRegistry::statsKeys;
+    const OTV0P2BASE::SimpleStatsKeyTable keys(statsKeys, sizeof(statsKeys)/sizeof(statsKeys[0]));
+    EXPECT_EQ(2, keys.idOf("B|cV"));
+    EXPECT_STREQ("H|%", keys.keyOf(1));
+    EXPECT_TRUE(NULL == keys.keyOf(3));
+    OTV0P2BASE::SimpleStatsRotation<4> ss;
+    ss.setID(V0p2_SENSOR_TAG_F(""));
+    EXPECT_TRUE(ss.put(statsKeys[0], 321));
+    EXPECT_TRUE(ss.put(statsKeys[2], 250));
+    // Registry priority is used.
+    EXPECT_TRUE(ss.isLowPriority(V0p2_SENSOR_TAG_F("B|cV")));
+    EXPECT_FALSE(ss.isLowPriority(V0p2_SENSOR_TAG_F("T|C16")));
+    // A stat put by text is the same stat as put by registered key.
+    EXPECT_TRUE(ss.put("H|%", 60));
+    EXPECT_TRUE(ss.put(statsKeys[1], 65));
+    EXPECT_TRUE(ss.put(statsKeys[0], 322));
+    EXPECT_EQ(3, ss.size());
+    char json[OTV0P2BASE::MSG_JSON_MAX_LENGTH + 2];
+    EXPECT_NE(0, ss.writeJSON((uint8_t *)json, sizeof(json), 0, true, true));
+    EXPECT_STREQ("{\"T|C16\":322,\"B|cV\":250,\"H|%\":65}", json);
+    // Binary round trip via the registry.
+    uint8_t buf[16];
+    const uint8_t l = ss.writeBinary(buf, sizeof(buf), keys);
+    ASSERT_NE(0, l);
+    char bigJSON[80];
+    EXPECT_NE(0, OTV0P2BASE::expandSimpleBinaryStatsToJSON(buf, l, keys, bigJSON, sizeof(bigJSON)));
+    EXPECT_STREQ("{\"T|C16\":322,\"B|cV\":250,\"H|%\":65}", bigJSON);
+    // Removal by registered key.
+    EXPECT_TRUE(ss.remove(statsKeys[2]));
+    EXPECT_FALSE(ss.remove(statsKeys[2]));
+    EXPECT_FALSE(ss.containsKey(V0p2_SENSOR_TAG_F("B|cV")));
+    EXPECT_EQ(2, ss.size());
+}
+
+// Check that scheduled writing always includes changed normal-priority stats
+// and shares the rest of the space by staleness.
+TEST(JSONStats,Scheduled)
+{
+    OTV0P2BASE::SimpleStatsRotation<8> ss;
+    ss.setID(V0p2_SENSOR_TAG_F(""));
+    ss.enableCount(false);
+    static const char *const normal[] = { "a", "b", "c", "d" };
+    for(int i = 0; i < 4; ++i) { EXPECT_TRUE(ss.put(normal[i], 100 + i)); }
+    EXPECT_TRUE(ss.put(V0p2_SENSOR_TAG_F("L"), 200, true));
+    EXPECT_TRUE(ss.put(V0p2_SENSOR_TAG_F("B"), 300, true));
+    EXPECT_TRUE(ss.setMaxAge(V0p2_SENSOR_TAG_F("L"), 2));
+    EXPECT_FALSE(ss.setMaxAge(V0p2_SENSOR_TAG_F("x"), 2));
+    // Room for three fields per frame.
+    char buf[28];
+    static const char *const all[] = { "\"a\":", "\"b\":", "\"c\":", "\"d\":", "\"L\":", "\"B\":" };
+    int lastSeen[6];
+    int maxGap[6];
+    for(int k = 0; k < 6; ++k) { lastSeen[k] = 0; maxGap[k] = 0; }
+    for(int frame = 1; frame <= 64; ++frame)
+        {
+        // Keep changing one normal-priority stat.
+        EXPECT_TRUE(ss.put(V0p2_SENSOR_TAG_F("a"), 1000 + frame));
+        ASSERT_NE(0, ss.writeJSONScheduled((uint8_t *)buf, sizeof(buf), 0)) << frame;
+        // The changed normal-priority stat is in every frame.
+        EXPECT_TRUE(NULL != strstr(buf, all[0])) << buf;
+        for(int k = 0; k < 6; ++k)
+            {
+            if(NULL == strstr(buf, all[k])) { continue; }
+            if(frame - lastSeen[k] > maxGap[k]) { maxGap[k] = frame - lastSeen[k]; }
+            lastSeen[k] = frame;
+            }
+        }
+    // Each stat is sent within its target maximum age.
+    for(int k = 1; k < 4; ++k) { EXPECT_LE(maxGap[k], (int)OTV0P2BASE::SIMPLE_STATS_DEFAULT_MAX_AGE) << all[k]; }
+    EXPECT_LE(maxGap[4], 2);
+    EXPECT_LE(maxGap[5], (int)OTV0P2BASE::SIMPLE_STATS_DEFAULT_MAX_AGE_LOW_PRIORITY);
+    // A changed low-priority stat is sent sooner than its target age,
+    // but does not displace a changed normal-priority one.
+    for(int frame = 0; frame < 4; ++frame) { ASSERT_NE(0, ss.writeJSONScheduled((uint8_t *)buf, sizeof(buf), 0)); }
+    EXPECT_TRUE(ss.put(V0p2_SENSOR_TAG_F("B"), 301, true));
+    EXPECT_TRUE(ss.put(V0p2_SENSOR_TAG_F("c"), 999));
+    ASSERT_NE(0, ss.writeJSONScheduled((uint8_t *)buf, sizeof(buf), 0));
+    EXPECT_TRUE(NULL != strstr(buf, "\"c\":999")) << buf;
+    EXPECT_TRUE(NULL != strstr(buf, "\"B\":301")) << buf;
+    EXPECT_FALSE(ss.changedValue());
+}
+
+// Check that small changes within a stat's deadband are not marked as changed.
+TEST(JSONStats,Deadband)
+{
+    OTV0P2BASE::SimpleStatsRotation<2> ss;
+    ss.setID(V0p2_SENSOR_TAG_F(""));
+    char buf[OTV0P2BASE::MSG_JSON_MAX_LENGTH + 2];
+    EXPECT_TRUE(ss.put("T", 1));
+    EXPECT_TRUE(ss.putDescriptor(OTV0P2BASE::GenericStatsDescriptor("L", false, 5)));
+    EXPECT_TRUE(ss.put("L", 100));
+    EXPECT_TRUE(ss.changedValue());
+    EXPECT_NE(0, ss.writeJSON((uint8_t *)buf, sizeof(buf), 0, true));
+    EXPECT_FALSE(ss.changedValue());
+    // Within 5 of the value last marked changed: value updated but not changed.
+    EXPECT_TRUE(ss.put("L", 103));
+    EXPECT_TRUE(ss.put("L", 95));
+    EXPECT_FALSE(ss.changedValue());
+    // The latest value is still sent in normal rotation.
+    EXPECT_NE(0, ss.writeJSON((uint8_t *)buf, sizeof(buf), 0, true));
+    EXPECT_TRUE(NULL != strstr(buf, "\"L\":95"));
+    // Beyond the deadband.
+    EXPECT_TRUE(ss.put("L", 94));
+    EXPECT_TRUE(ss.changedValue());
+    EXPECT_NE(0, ss.writeJSON((uint8_t *)buf, sizeof(buf), 0, true));
+    // Now relative to 94.
+    EXPECT_TRUE(ss.put("L", 99));
+    EXPECT_FALSE(ss.changedValue());
+    EXPECT_TRUE(ss.put("L", 100));
+    EXPECT_TRUE(ss.changedValue());
+}
+
+// Check streaming tokenisation of received JSON stats.
+TEST(JSONStats,Reader)
+{
+    // Adjust for TX and check as for RX.
+    char buf[OTV0P2BASE::MSG_JSON_MAX_LENGTH + 2] = { };
+    strcpy(buf, "{\"@\":\"414a\",\"+\":2,\"T|C16\":321,\"L\":-32768,\"vC|%\":0}");
+    const uint8_t crc = OTV0P2BASE::adjustJSONMsgForTXAndComputeCRC(buf);
+    const size_t l = strlen(buf);
+    buf[l] = char(crc);
+    const int8_t rxl = OTV0P2BASE::checkJSONMsgRXCRC((const uint8_t *)buf, sizeof(buf));
+    ASSERT_EQ((int)l, rxl);
+    OTV0P2BASE::SimpleJSONStatsReader r((const uint8_t *)buf, (uint8_t)rxl);
+    OTV0P2BASE::SimpleJSONStatsField f;
+    ASSERT_TRUE(r.next(f));
+    EXPECT_TRUE(f.keyIs("@"));
+    ASSERT_TRUE(f.isString);
+    EXPECT_EQ(0, strncmp("414a", f.str, f.strLen));
+    EXPECT_EQ(4, f.strLen);
+    ASSERT_TRUE(r.next(f));
+    EXPECT_TRUE(f.keyIs("+"));
+    int16_t total = 0;
+    int stats = 0;
+    while(r.next(f))
+        {
+        EXPECT_FALSE(f.isString);
+        EXPECT_FALSE(f.keyIs("T|C"));
+        if(f.keyIs("T|C16")) { EXPECT_EQ(321, f.value); }
+        if(f.keyIs("L")) { EXPECT_EQ(-32768, f.value); }
+        total = (int16_t)(total + f.value);
+        ++stats;
+        }
+    EXPECT_TRUE(r.isComplete());
+    EXPECT_EQ(3, stats);
+    EXPECT_EQ((int16_t)(321 - 32768), total);
+    // Malformed messages stop the reader.
+    const char *const bad[] = {
+        "{\"a\":1,}", "{\"a\":}", "{\"a\"1}", "{a:1}", "{\"a\":32768}",
+        "{\"a\":-32769}", "{\"a\":\"x}", "{\"a\":1\"b\":2}", "{\"a\":1.5}", "{\"a\":1",
+        };
+    for(size_t i = 0; i < sizeof(bad)/sizeof(bad[0]); ++i)
+        {
+        OTV0P2BASE::SimpleJSONStatsReader rb((const uint8_t *)bad[i], (uint8_t)strlen(bad[i]));
+        while(rb.next(f)) { }
+        EXPECT_FALSE(rb.isComplete()) << bad[i];
+        }
+    // Empty object.
+    OTV0P2BASE::SimpleJSONStatsReader re((const uint8_t *)"{}", 2);
+    EXPECT_FALSE(re.next(f));
+    EXPECT_TRUE(re.isComplete());
+}
+
 // Testing stats object sizing with placeholders.
 TEST(JSONStats,VariadicJSON0)
 {
@@ -271,6 +591,66 @@ TEST(JSONStats,VariadicJSON2)
     EXPECT_TRUE((0 == strcmp(buf, "{\"H|%\":9,\"L\":41}")) || (0 == strcmp(buf, "{\"L\":41,\"H|%\":9}")));
 }
 
+// Sensors and power hooks for the VariadicJSONGrouped test, logging reads and power changes.
+namespace VJG
+    {
+    static char log[32];
+    static void note(const char c) { const size_t l = strlen(log); if(l < sizeof(log) - 1) { log[l] = c; } }
+    // Sensor on resource R that logs c when read.
+    template <uint8_t R, char c>
+    class ResourceSensor final : public OTV0P2BASE::SimpleTSUint8Sensor
+        {
+        public:
+            static constexpr uint8_t sensorResource = R;
+            uint8_t read() override { note(c); return(++value); }
+            OTV0P2BASE::Sensor_tag_t tag() const override { static const char t[2] = { c, '\0' }; return(t); }
+        };
+    // Sensor with no declared resource.
+    class PlainSensor final : public OTV0P2BASE::SimpleTSUint8Sensor
+        {
+        public:
+            uint8_t read() override { note('p'); return(++value); }
+            OTV0P2BASE::Sensor_tag_t tag() const override { return(V0p2_SENSOR_TAG_F("p")); }
+        };
+    struct LoggingPower final
+        {
+        void powerUp(const uint8_t r) { note('+'); note(char('0' + r)); }
+        void powerDown(const uint8_t r) { note('-'); note(char('0' + r)); }
+        };
+    }
+
+// Testing that sensors sharing a resource are read in one power-up window.
+TEST(JSONStats,VariadicJSONGrouped)
+{
+    static_assert(OTV0P2BASE::PowerDomain::TWI == OTV0P2BASE::SensorResourceOf<VJG::ResourceSensor<OTV0P2BASE::PowerDomain::TWI, 'a'> &>::value, "");
+    static_assert(OTV0P2BASE::SENSOR_NO_RESOURCE == OTV0P2BASE::SensorResourceOf<VJG::PlainSensor>::value, "");
+    static_assert(OTV0P2BASE::SENSOR_NO_RESOURCE == OTV0P2BASE::SensorResourceOf<int>::value, "");
+    VJG::ResourceSensor<OTV0P2BASE::PowerDomain::TWI, 'a'> a;
+    VJG::ResourceSensor<OTV0P2BASE::PowerDomain::ANALOGUE, 'b'> b;
+    VJG::ResourceSensor<OTV0P2BASE::PowerDomain::TWI, 'c'> c;
+    VJG::PlainSensor p;
+    VJG::ResourceSensor<OTV0P2BASE::PowerDomain::ANALOGUE, 'd'> d;
+    auto ssh = OTV0P2BASE::makeJSONStatsHolder(a, b, V0p2_SENSOR_TAG_F("x"), c, p, d);
+    auto &ss = ssh.ss;
+    ss.setID(V0p2_SENSOR_TAG_F(""));
+    ss.enableCount(false);
+    EXPECT_EQ(6, ss.getCapacity());
+    VJG::LoggingPower power;
+    memset(VJG::log, 0, sizeof(VJG::log));
+    ASSERT_TRUE(ssh.readAndPutOrRemoveAll(power));
+    // Each resource is powered up once, for all of its sensors.
+    EXPECT_STREQ("+3ac-3+1bd-1p", VJG::log);
+    EXPECT_EQ(5, ss.size());
+    char buf[OTV0P2BASE::MSG_JSON_MAX_LENGTH + 2];
+    EXPECT_NE(0, ss.writeJSON((uint8_t*)buf, sizeof(buf), 0, true, true));
+    EXPECT_STREQ("{\"a\":1,\"b\":1,\"c\":1,\"p\":1,\"d\":1}", buf);
+    // Without hooks all the sensors are still read, in the same order.
+    memset(VJG::log, 0, sizeof(VJG::log));
+    ssh.readAll();
+    EXPECT_STREQ("acbdp", VJG::log);
+    EXPECT_EQ(2, a.get());
+}
+
 //// Testing simplified argument passing with SubSensors.
 //TEST(JSONStats,SubSensorsOcc)
 //{
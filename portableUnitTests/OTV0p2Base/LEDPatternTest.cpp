@@ -0,0 +1,106 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for LEDPattern and LEDPatternPlayer tests.
+ */
+
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+
+
+// Pattern building and tick conversion.
+TEST(LEDPattern,build)
+{
+    OTV0P2BASE::LEDPattern p;
+    EXPECT_TRUE(p.isEmpty());
+    EXPECT_FALSE(p.add(0));
+    EXPECT_TRUE(p.add(5));
+    p.extend(5);
+    EXPECT_EQ(1, p.size());
+    EXPECT_EQ(10, p.getStepMs(0));
+    for(uint8_t i = 1; i < OTV0P2BASE::LEDPattern::MAX_STEPS; ++i) { EXPECT_TRUE(p.add(120)); }
+    EXPECT_FALSE(p.add(1));
+    p.extend(200);
+    EXPECT_EQ(255, p.getStepMs(OTV0P2BASE::LEDPattern::MAX_STEPS - 1));
+    EXPECT_TRUE(OTV0P2BASE::LEDPattern::isLitStep(0));
+    EXPECT_FALSE(OTV0P2BASE::LEDPattern::isLitStep(1));
+    EXPECT_EQ(1, OTV0P2BASE::LEDPattern::ticksFromMs(1));
+    EXPECT_EQ(1, OTV0P2BASE::LEDPattern::ticksFromMs(5));
+    EXPECT_EQ(2, OTV0P2BASE::LEDPattern::ticksFromMs(15));
+    EXPECT_EQ(8, OTV0P2BASE::LEDPattern::ticksFromMs(60));
+    EXPECT_EQ(16, OTV0P2BASE::LEDPattern::ticksFromMs(120));
+    p.clear();
+    EXPECT_TRUE(p.isEmpty());
+}
+
+namespace LEDP
+    {
+    bool lit;
+    int switches;
+    void on() { lit = true; ++switches; }
+    void off() { lit = false; ++switches; }
+    }
+
+// Player steps through the pattern at tick boundaries and ends dark.
+TEST(LEDPattern,player)
+{
+    LEDP::lit = false;
+    LEDP::switches = 0;
+    OTV0P2BASE::LEDPatternPlayer player(LEDP::on, LEDP::off);
+    EXPECT_FALSE(player.isActive());
+    EXPECT_FALSE(player.tick(0));
+    OTV0P2BASE::LEDPattern p;
+    p.add(15);  // 2 ticks lit.
+    p.add(120); // 16 ticks dark.
+    p.add(5);   // 1 tick lit.
+    player.start(p);
+    EXPECT_TRUE(player.isActive());
+    EXPECT_TRUE(LEDP::lit);
+    // First step timed from the first tick.
+    EXPECT_TRUE(player.tick(1000));
+    EXPECT_TRUE(LEDP::lit);
+    EXPECT_TRUE(player.tick(1001));
+    EXPECT_TRUE(LEDP::lit);
+    EXPECT_TRUE(player.tick(1002));
+    EXPECT_FALSE(LEDP::lit);
+    EXPECT_TRUE(player.tick(1017));
+    EXPECT_FALSE(LEDP::lit);
+    EXPECT_TRUE(player.tick(1018));
+    EXPECT_TRUE(LEDP::lit);
+    EXPECT_FALSE(player.tick(1019));
+    EXPECT_FALSE(LEDP::lit);
+    EXPECT_FALSE(player.isActive());
+
+    // A long gap between ticks skips to the end, dark.
+    player.start(p);
+    EXPECT_TRUE(player.tick(5));
+    EXPECT_FALSE(player.tick(500));
+    EXPECT_FALSE(LEDP::lit);
+
+    // Stopping and empty patterns leave the LED off.
+    player.start(p);
+    player.stop();
+    EXPECT_FALSE(LEDP::lit);
+    EXPECT_FALSE(player.isActive());
+    player.start(OTV0P2BASE::LEDPattern());
+    EXPECT_FALSE(player.isActive());
+    EXPECT_FALSE(LEDP::lit);
+}
@@ -0,0 +1,170 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2018
+*/
+
+/*
+ * Driver for scalable node association store tests.
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include <OTRadioLink.h>
+#include "OTV0P2BASE_EEPROMImage.h"
+
+
+namespace NAST
+{
+typedef OTV0P2BASE::EEPROMJournalMockStore<8192> Store;
+static constexpr uint16_t nSlots = 500;
+typedef OTV0P2BASE::NodeAssociationStoreExtended<Store, nSlots, 16> Extended;
+
+// Distinct IDs, many sharing leading bytes so as to exercise the full-ID check.
+static void makeID(const uint16_t n, uint8_t *const id)
+    {
+    id[0] = uint8_t(0x80 | (n % 3));
+    id[1] = uint8_t(n % 5);
+    for(uint8_t i = 2; i < 8; ++i) { id[i] = uint8_t((n >> (i & 1 ? 8 : 0)) + i); }
+    }
+}
+
+// The extended layout holds IDs and counters within its own address range.
+TEST(NodeAssociationStore,extendedLayout)
+{
+    NAST::Store store;
+    NAST::Extended ext(store);
+    EXPECT_EQ(NAST::nSlots, ext.capacity());
+    const uintptr_t end = NAST::Extended::endAddr;
+    EXPECT_EQ(16U + 14U * NAST::nSlots, end);
+    static const uint8_t id[8] = { 0x81, 2, 3, 4, 5, 6, 7, 8 };
+    static const uint8_t ctr[6] = { 0, 0, 0, 1, 2, 3 };
+    EXPECT_TRUE(ext.set(1, id));
+    EXPECT_TRUE(ext.setRXCounter(1, ctr));
+    EXPECT_FALSE(ext.set(NAST::nSlots, id));
+    EXPECT_FALSE(ext.setRXCounter(0, NULL));
+    EXPECT_EQ(0x81, store.read(16 + 14));
+    EXPECT_EQ(3, store.read(16 + 14 + 8 + 5));
+    EXPECT_EQ(0xff, store.read(15));
+    uint8_t buf[8];
+    EXPECT_TRUE(ext.get(1, buf));
+    EXPECT_EQ(0, memcmp(id, buf, 8));
+    EXPECT_TRUE(ext.getRXCounter(1, buf));
+    EXPECT_EQ(0, memcmp(ctr, buf, 6));
+    EXPECT_TRUE(ext.get(0, buf));
+    EXPECT_EQ(0xff, buf[0]);
+    ext.clear();
+    EXPECT_TRUE(ext.get(1, buf));
+    EXPECT_EQ(0xff, buf[0]);
+}
+
+// The existing 8-slot table can be indexed, but holds no counters.
+TEST(NodeAssociationStore,tableAdapter)
+{
+    NAST::Store store;
+    OTV0P2BASE::NodeAssociationTableStore<NAST::Store> table(store);
+    OTV0P2BASE::NodeAssociationStoreTable<OTV0P2BASE::NodeAssociationTableStore<NAST::Store>> adapter(table);
+    EXPECT_EQ(OTV0P2BASE::V0P2BASE_EE_NODE_ASSOCIATIONS_MAX_SETS, adapter.capacity());
+    OTV0P2BASE::NodeAssociationStoreIndex<16> index;
+    uint8_t id[8];
+    for(uint16_t i = 0; i < 8; ++i) { NAST::makeID(i, id); EXPECT_EQ(int16_t(i), index.add(adapter, id)); }
+    NAST::makeID(8, id);
+    EXPECT_EQ(-1, index.add(adapter, id));
+    uint8_t ctr[6];
+    EXPECT_FALSE(adapter.getRXCounter(0, ctr));
+    // A fresh index built from the table finds the same entries.
+    OTV0P2BASE::NodeAssociationStoreIndex<16> index2;
+    EXPECT_EQ(8, index2.build(adapter));
+    NAST::makeID(5, id);
+    EXPECT_EQ(5, index2.find(adapter, id));
+}
+
+// Hundreds of associations, found by prefix and by full ID.
+TEST(NodeAssociationStore,indexManyNodes)
+{
+    NAST::Store store;
+    NAST::Extended ext(store);
+    ext.clear();
+    OTV0P2BASE::NodeAssociationStoreIndex<NAST::nSlots> index;
+    EXPECT_FALSE(index.isValid());
+    uint8_t id[8];
+    for(uint16_t i = 0; i < NAST::nSlots; ++i) { NAST::makeID(i, id); ASSERT_EQ(int16_t(i), index.add(ext, id)); }
+    EXPECT_EQ(NAST::nSlots, index.size());
+    NAST::makeID(NAST::nSlots, id);
+    EXPECT_EQ(-1, index.add(ext, id));
+    // Re-adding is idempotent.
+    NAST::makeID(7, id);
+    EXPECT_EQ(7, index.add(ext, id));
+    uint8_t ctr[6];
+    EXPECT_TRUE(ext.getRXCounter(7, ctr));
+    EXPECT_EQ(0, ctr[5]);
+    // A rebuilt index agrees, and bumps the generation.
+    const uint8_t g = index.getGeneration();
+    index.invalidate();
+    uint8_t out[8];
+    for(uint16_t i = 0; i < NAST::nSlots; i += 37)
+        {
+        NAST::makeID(i, id);
+        EXPECT_EQ(int16_t(i), index.getNextMatch(ext, 0, id, 8, out));
+        EXPECT_EQ(0, memcmp(id, out, 8));
+        }
+    EXPECT_NE(g, index.getGeneration());
+    // Prefix matches count as expected and come back in leading-byte order.
+    const uint8_t prefix[1] = { 0x81 };
+    uint16_t matches = 0;
+    uint8_t prev[2] = { };
+    while(index.getNextMatch(ext, matches, prefix, 1, out) >= 0)
+        {
+        EXPECT_EQ(0x81, out[0]);
+        EXPECT_LE(0, memcmp(out, prev, 2));
+        memcpy(prev, out, 2);
+        ++matches;
+        }
+    EXPECT_EQ(167, matches);
+    // Unknown IDs and bad prefixes.
+    const uint8_t unknown[8] = { 0x81, 0, 0, 0, 0, 0, 0, 0 };
+    EXPECT_EQ(-1, index.find(ext, unknown));
+    EXPECT_EQ(-1, index.getNextMatch(ext, 0, prefix, 0, out));
+}
+
+// Secure frame RX counters kept in an extended store.
+TEST(NodeAssociationStore,secureFrameRXStore)
+{
+    NAST::Store store;
+    NAST::Extended ext(store);
+    ext.clear();
+    OTRadioLink::SimpleSecureFrame32or0BodyRXStore<NAST::nSlots> rx(ext);
+    uint8_t id[8];
+    for(uint16_t i = 0; i < 300; ++i) { NAST::makeID(i, id); ASSERT_TRUE(rx.addNode(id)); }
+    NAST::makeID(299, id);
+    uint8_t ctr[6];
+    ASSERT_TRUE(rx.getLastRXMsgCtr(id, ctr));
+    const uint8_t zeros[6] = { };
+    EXPECT_EQ(0, memcmp(zeros, ctr, 6));
+    const uint8_t next[6] = { 0, 0, 0, 0, 1, 0 };
+    EXPECT_TRUE(rx.authAndUpdateRXMsgCtr(id, next));
+    // Replays are rejected.
+    EXPECT_FALSE(rx.authAndUpdateRXMsgCtr(id, next));
+    // The counter persists in the store, across a fresh RX object.
+    OTRadioLink::SimpleSecureFrame32or0BodyRXStore<NAST::nSlots> rx2(ext);
+    ASSERT_TRUE(rx2.getLastRXMsgCtr(id, ctr));
+    EXPECT_EQ(0, memcmp(next, ctr, 6));
+    const uint8_t unknown[8] = { 0x81, 0, 0, 0, 0, 0, 0, 0 };
+    EXPECT_FALSE(rx2.getLastRXMsgCtr(unknown, ctr));
+    EXPECT_FALSE(rx2.authAndUpdateRXMsgCtr(unknown, next));
+}
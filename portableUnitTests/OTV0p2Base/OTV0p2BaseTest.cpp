@@ -38,3 +38,125 @@ TEST(OTV0p2Base,parseHex)
     // The compiler can't find this for some reason (function def in source file).
     EXPECT_EQ(10, OTV0P2BASE::parseHexByte(s));
 }
+
+// Check the 7-bit CRC (table-driven on the host by default)
+// against a bit-by-bit reference, and the bulk form against the byte form.
+TEST(OTV0p2Base,crc7_5B)
+{
+    for(int crc = 0; crc < 256; ++crc)
+        {
+        for(int datum = 0; datum < 256; ++datum)
+            {
+            uint8_t ref = (uint8_t)crc;
+            for(uint8_t i = 0x80; i != 0; i >>= 1)
+                {
+                const bool bit = (0 != (ref & 0x40)) != (0 != (datum & i));
+                ref = (uint8_t)(ref << 1);
+                if(bit) { ref ^= 0x37; }
+                }
+            ASSERT_EQ(ref & 0x7f, OTV0P2BASE::crc7_5B_update((uint8_t)crc, (uint8_t)datum)) << crc << " " << datum;
+            }
+        }
+    const uint8_t buf[] = { 0x7f, 0x10, '{', 'b', 0x80, 0xff, 0 };
+    uint8_t crc = 0x7f;
+    for(uint8_t i = 0; i < sizeof(buf); ++i) { crc = OTV0P2BASE::crc7_5B_update(crc, buf[i]); }
+    EXPECT_EQ(crc, OTV0P2BASE::crc7_5B_buf(0x7f, buf, sizeof(buf)));
+    EXPECT_EQ(0x55, OTV0P2BASE::crc7_5B_buf(0x55, buf, 0));
+}
+
+// Check the 16-bit CRC against the CRC-16/MODBUS check value,
+// and the bulk (table-driven on the host) forms against the byte form.
+TEST(OTV0p2Base,crc16_A001)
+{
+    const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    uint16_t crc = 0xffff;
+    for(uint8_t i = 0; i < sizeof(check); ++i) { crc = OTV0P2BASE::crc16_A001_update(crc, check[i]); }
+    EXPECT_EQ(0x4b37, crc);
+    EXPECT_EQ(0x4b37, OTV0P2BASE::crc16_A001_buf(0xffff, check, sizeof(check)));
+    uint8_t buf[64];
+    for(uint8_t i = 0; i < sizeof(buf); ++i) { buf[i] = uint8_t(i * 37 + 11); }
+    const volatile uint8_t *const vbuf = buf;
+    for(uint8_t len = 0; len <= sizeof(buf); ++len)
+        {
+        uint16_t ref = 0xffff;
+        for(uint8_t i = 0; i < len; ++i) { ref = OTV0P2BASE::crc16_A001_update(ref, buf[i]); }
+        ASSERT_EQ(ref, OTV0P2BASE::crc16_A001_buf(0xffff, buf, len)) << int(len);
+        ASSERT_EQ(ref, OTV0P2BASE::crc16_A001_buf(0xffff, vbuf, len)) << int(len);
+        }
+    // Appending the CRC (low byte first) leaves zero.
+    const uint16_t c = OTV0P2BASE::crc16_A001_buf(0xffff, check, sizeof(check));
+    const uint8_t tail[] = { uint8_t(c), uint8_t(c >> 8) };
+    EXPECT_EQ(0, OTV0P2BASE::crc16_A001_buf(c, tail, 2));
+}
+
+// Check the table-driven CRC-CCITT (as used to hash memory for entropy) against the check value and bitwise reference.
+TEST(OTV0p2Base,crc_ccitt_8408)
+{
+    const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    EXPECT_EQ(0x6f91, OTV0P2BASE::crc_ccitt_8408_buf(0xffff, check, sizeof(check)));
+    uint8_t buf[64];
+    for(uint8_t i = 0; i < sizeof(buf); ++i) { buf[i] = uint8_t(i * 37 + 11); }
+    uint16_t ref = 0xffff;
+    for(uint8_t i = 0; i < sizeof(buf); ++i)
+        {
+        ref ^= buf[i];
+        for(uint8_t b = 0; b < 8; ++b) { ref = (ref & 1) ? ((ref >> 1) ^ 0x8408) : (ref >> 1); }
+        ASSERT_EQ(ref, OTV0P2BASE::crc_ccitt_8408_buf(0xffff, buf, uint8_t(i + 1))) << int(i);
+        }
+}
+
+// Check the SHT21 raw-to-value conversions against the datasheet formulae.
+TEST(OTV0p2Base,SHT21Conversions)
+{
+    // Datasheet example: S_RH 0x6350 is 42.5%RH.
+    EXPECT_EQ(42, OTV0P2BASE::SHT21_rawToRHPC(0x6350));
+    // Status bits are ignored.
+    EXPECT_EQ(OTV0P2BASE::SHT21_rawToRHPC(0x6350), OTV0P2BASE::SHT21_rawToRHPC(0x6353));
+    EXPECT_EQ(OTV0P2BASE::SHT21_rawToC16(0x6350), OTV0P2BASE::SHT21_rawToC16(0x6353));
+    for(uint32_t raw = 0; raw <= 0xffff; raw += 4)
+        {
+        const double c = -46.85 + (175.72 * raw) / 65536.0;
+        // The integer approximation truncates, so allow a little over 1/16C.
+        ASSERT_NEAR(c * 16, OTV0P2BASE::SHT21_rawToC16((uint16_t)raw), 1.5) << raw;
+        const double rh = -6 + (125.0 * raw) / 65536.0;
+        if((rh >= 0) && (rh <= 100)) { ASSERT_NEAR(rh, OTV0P2BASE::SHT21_rawToRHPC((uint16_t)raw), 1.0) << raw; }
+        }
+}
+
+namespace RHRise
+{
+int calls;
+void countCall() { ++calls; }
+}
+// Check that a rapid RH% rise (eg a shower) is detected promptly, and slow drift is not.
+TEST(OTV0p2Base,HumidityRapidRise)
+{
+    OTV0P2BASE::HumiditySensorMock rh;
+    RHRise::calls = 0;
+    rh.setRapidRiseCallback(RHRise::countCall);
+    // Slow occupancy-like drift and jitter over a few hours.
+    for(int m = 0; m < 240; ++m)
+        {
+        rh.set(uint8_t(45 + (m / 20) + (m & 1)));
+        ASSERT_FALSE(rh.isRHRisingRapidly()) << m;
+        }
+    EXPECT_EQ(0, RHRise::calls);
+    // A shower: 4% per minute is seen within a couple of readings.
+    uint8_t v = 57;
+    int m = 0;
+    for( ; !rh.isRHRisingRapidly() && (m < 10); ++m) { v = uint8_t(v + 4); rh.set(v); }
+    EXPECT_GE(2, m);
+    EXPECT_EQ(1, RHRise::calls);
+    EXPECT_LT(0, rh.getRHSlopeQ4());
+    // Staying high but steady ends the rise without another callback.
+    for(m = 0; m < 10; ++m) { rh.set(v); }
+    EXPECT_FALSE(rh.isRHRisingRapidly());
+    // Invalid readings are ignored.
+    rh.set(OTV0P2BASE::HumiditySensorBase::INVALID_RH);
+    EXPECT_FALSE(rh.isRHRisingRapidly());
+    rh.set(uint8_t(v + 1));
+    EXPECT_FALSE(rh.isRHRisingRapidly());
+    EXPECT_EQ(1, RHRise::calls);
+    rh.reset();
+    EXPECT_EQ(0, rh.getRHSlopeQ4());
+}
@@ -0,0 +1,96 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Occupancy fusion tests.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#include "OTV0P2BASE_OccupancyFusion.h"
+
+typedef OTV0P2BASE::OccupancyFusion OF;
+
+// Strong sources mark the room occupied at once;
+// weaker ones alone do not.
+TEST(OccupancyFusion,singleSources)
+{
+    OTV0P2BASE::PseudoSensorOccupancyTracker o;
+    OF f(o);
+    EXPECT_EQ(0, f.getScore());
+    EXPECT_EQ(+OF::OCCUPIED_SCORE, f.noteEvent(OF::SRC_PIR));
+    EXPECT_TRUE(o.isLikelyRecentlyOccupied());
+    EXPECT_TRUE(o.reportedNewOccupancyRecently());
+
+    OTV0P2BASE::PseudoSensorOccupancyTracker o2;
+    OF f2(o2);
+    // A light event alone is only 'possibly' occupied.
+    f2.noteEvent(OF::SRC_LIGHT);
+    EXPECT_TRUE(o2.isLikelyOccupied());
+    EXPECT_FALSE(o2.isLikelyRecentlyOccupied());
+    // A weak RH event alone falls below every threshold.
+    OTV0P2BASE::PseudoSensorOccupancyTracker o3;
+    OF f3(o3);
+    EXPECT_GT(+OF::WEAK_SCORE, f3.noteEvent(OF::SRC_RH, false));
+    EXPECT_FALSE(o3.isLikelyOccupied());
+    // Bad source is ignored.
+    EXPECT_EQ(0, f3.noteEvent(OF::SRC_COUNT));
+}
+
+// Corroborating sources together reach 'occupied'.
+TEST(OccupancyFusion,corroboration)
+{
+    OTV0P2BASE::PseudoSensorOccupancyTracker o;
+    OF f(o);
+    f.noteEvent(OF::SRC_VOICE);
+    EXPECT_FALSE(o.isLikelyRecentlyOccupied());
+    f.tick();
+    EXPECT_LE(+OF::OCCUPIED_SCORE, f.noteEvent(OF::SRC_LIGHT));
+    EXPECT_TRUE(o.isLikelyRecentlyOccupied());
+}
+
+// Evidence decays by half-lives, and old evidence does not corroborate.
+TEST(OccupancyFusion,decay)
+{
+    OTV0P2BASE::PseudoSensorOccupancyTracker o;
+    OF f(o);
+    f.setSource(OF::SRC_VOICE, 64, 4);
+    f.noteEvent(OF::SRC_VOICE);
+    EXPECT_EQ(64, f.getSourceScore(OF::SRC_VOICE));
+    for(int i = 0; i < 3; ++i) { f.tick(); }
+    EXPECT_EQ(64, f.getSourceScore(OF::SRC_VOICE));
+    f.tick();
+    EXPECT_EQ(32, f.getSourceScore(OF::SRC_VOICE));
+    for(int i = 0; i < 4; ++i) { f.tick(); }
+    EXPECT_EQ(16, f.getSourceScore(OF::SRC_VOICE));
+    for(int i = 0; i < 4 * OF::MAX_HALF_LIVES; ++i) { f.tick(); }
+    EXPECT_EQ(0, f.getScore());
+    // Repeated events build up, saturating.
+    for(int i = 0; i < 10; ++i) { f.noteEvent(OF::SRC_VOICE); }
+    EXPECT_EQ(255, f.getSourceScore(OF::SRC_VOICE));
+    // Scores are forgotten when the minute count wraps.
+    for(uint32_t i = 0; i < 65536; ++i) { f.tick(); }
+    EXPECT_EQ(0, f.getScore());
+    f.noteEvent(OF::SRC_VOICE);
+    f.reset();
+    EXPECT_EQ(0, f.getScore());
+    // Bad settings are ignored.
+    f.setSource(OF::SRC_VOICE, 10, 0);
+    EXPECT_EQ(64, f.noteEvent(OF::SRC_VOICE));
+}
@@ -0,0 +1,77 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2018
+*/
+
+/*
+ * Driver for OTV0p2Base RC oscillator calibration tests.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+
+
+namespace OCT
+{
+static constexpr uint8_t target = 200;
+// Simulated RC clock: each OSCCAL step moves the count by about 1.5,
+// plus drift, plus +/-1 count of measurement jitter.
+static uint8_t measure(const int osccal, const int drift, const bool jitter)
+    {
+    const int j = jitter ? ((rand() % 3) - 1) : 0;
+    return(uint8_t(target + drift + ((osccal * 3) / 2) + j));
+    }
+}
+
+// Converges from a large error, then tracks drift one step at a time.
+TEST(OscCalibration,tracksDrift)
+{
+    OTV0P2BASE::RCOscCalibrator c(OCT::target);
+    int osccal = 0;
+    int drift = 12;
+    for(int i = 0; i < 40; ++i) { osccal += c.update(OCT::measure(osccal, drift, false)); }
+    EXPECT_TRUE(c.isLocked());
+    EXPECT_EQ(-8, osccal);
+    EXPECT_EQ(-8, c.getNetSteps());
+    EXPECT_EQ(12, c.getMaxAbsError());
+    // Warming up speeds the clock a little: followed without over-correcting.
+    drift = 18;
+    c.resetStats();
+    for(int i = 0; i < 40; ++i) { osccal += c.update(OCT::measure(osccal, drift, true)); }
+    EXPECT_TRUE(c.isLocked());
+    EXPECT_GE(2, abs(int(OCT::target) - int(OCT::measure(osccal, drift, false))));
+    EXPECT_EQ(-4, c.getNetSteps());
+    EXPECT_EQ(40, c.getMeasurements());
+}
+
+// Jitter within the deadband does not cause steps, and failures are ignored.
+TEST(OscCalibration,ignoresNoise)
+{
+    OTV0P2BASE::RCOscCalibrator c(OCT::target);
+    const uint8_t counts[] = { 200, 201, 199, 200, 0, 201, 200, 199 };
+    for(const uint8_t n : counts) { EXPECT_EQ(0, c.update(n)); }
+    EXPECT_EQ(0, c.getNetSteps());
+    EXPECT_EQ(1, c.getFailures());
+    EXPECT_EQ(7, c.getMeasurements());
+    EXPECT_EQ(-1, c.getLastError());
+    // A refused step is not counted as drift.
+    const int8_t s = c.update(210);
+    EXPECT_EQ(-1, s);
+    c.stepRefused(s);
+    EXPECT_EQ(0, c.getNetSteps());
+}
@@ -0,0 +1,93 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for PinChangeCapture tests.
+ */
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+
+
+// Capture, ordering, masking and overflow.
+TEST(PinChangeCapture,basics)
+{
+    // Watch bits 2 and 5, initially both low.
+    OTV0P2BASE::PinChangeCapture<4> c(0x24);
+    OTV0P2BASE::PinChangeEdge e;
+    EXPECT_EQ(0, c.available());
+    EXPECT_FALSE(c.pop(e));
+    // Unwatched pin changes are not handled.
+    EXPECT_FALSE(c.captureFromISR(0x01, 10));
+    EXPECT_EQ(0, c.available());
+    // Rising edge on bit 2 then falling.
+    EXPECT_TRUE(c.captureFromISR(0x05, 11));
+    EXPECT_TRUE(c.captureFromISR(0x01, 12));
+    // No change since last seen.
+    EXPECT_FALSE(c.captureFromISR(0x01, 13));
+    ASSERT_EQ(2, c.available());
+    ASSERT_TRUE(c.pop(e));
+    EXPECT_EQ(11, e.subCycleTime);
+    EXPECT_EQ(0x04, e.changed);
+    EXPECT_EQ(0x04, e.pins);
+    EXPECT_TRUE(e.anyBecameActive(0x04));
+    EXPECT_FALSE(e.anyBecameActive(0x04, 0x00)) << "went high, so not active if active low";
+    EXPECT_FALSE(e.anyBecameActive(0x20));
+    ASSERT_TRUE(c.pop(e));
+    EXPECT_EQ(12, e.subCycleTime);
+    EXPECT_EQ(0x00, e.pins);
+    EXPECT_FALSE(e.anyBecameActive(0x04));
+    EXPECT_TRUE(e.anyBecameActive(0x04, 0x00));
+    EXPECT_FALSE(c.pop(e));
+
+    // Fill and overflow: the oldest are kept and the excess counted,
+    // and the index wrap is handled correctly.
+    for(int round = 0; round < 100; ++round)
+        {
+        for(uint8_t i = 0; i < 6; ++i) { EXPECT_TRUE(c.captureFromISR((i & 1) ? 0 : 0x20, i)); }
+        EXPECT_EQ(4, c.available());
+        EXPECT_EQ(2, c.getDropped());
+        for(uint8_t i = 0; i < 4; ++i) { ASSERT_TRUE(c.pop(e)); EXPECT_EQ(i, e.subCycleTime); EXPECT_EQ(0x20, e.changed); }
+        EXPECT_FALSE(c.pop(e));
+        c.clearDropped();
+        }
+    EXPECT_EQ(0, c.getDropped());
+}
+
+// Short pulses captured between polls reach the occupancy tracker.
+TEST(PinChangeCapture,feedOccupancy)
+{
+    // PIR active high on bit 0, voice active low on bit 1 (initially high).
+    OTV0P2BASE::PinChangeCapture<> c(0x03, 0x02);
+    OTV0P2BASE::PseudoSensorOccupancyTracker occ;
+    EXPECT_EQ(0, OTV0P2BASE::feedOccupancy(c, occ, 0x01, 0x02, 0x01));
+    EXPECT_FALSE(occ.isLikelyOccupied());
+    // Voice pulse only: possibly occupied.
+    c.captureFromISR(0x00, 1);
+    c.captureFromISR(0x02, 2);
+    EXPECT_EQ(2, OTV0P2BASE::feedOccupancy(c, occ, 0x01, 0x02, 0x01));
+    EXPECT_TRUE(occ.isLikelyOccupied());
+    EXPECT_FALSE(occ.isLikelyRecentlyOccupied());
+    // Brief PIR pulse, long gone by the time of the drain: occupied.
+    c.captureFromISR(0x03, 3);
+    c.captureFromISR(0x02, 4);
+    EXPECT_EQ(2, OTV0P2BASE::feedOccupancy(c, occ, 0x01, 0x02, 0x01));
+    EXPECT_TRUE(occ.isLikelyRecentlyOccupied());
+    EXPECT_EQ(0, c.available());
+}
@@ -0,0 +1,126 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for PowerStateMeter tests.
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_PowerAccounting.h"
+
+
+namespace PAT
+{
+// Stats sink remembering the last value put for each key.
+struct Stats final
+    {
+    const char *keys[8];
+    int16_t values[8];
+    uint8_t n = 0;
+    bool put(const char *const key, const int16_t v, const bool lowPriority)
+        {
+        EXPECT_TRUE(lowPriority);
+        keys[n] = key; values[n] = v; ++n;
+        return(true);
+        }
+    int16_t get(const char *const key) const
+        {
+        for(uint8_t i = 0; i < n; ++i) { if(0 == strcmp(key, keys[i])) { return(values[i]); } }
+        return(-1);
+        }
+    };
+}
+
+// On-time accumulates per domain, with repeats ignored and the current period included.
+TEST(PowerAccounting,domains)
+{
+    OTV0P2BASE::PowerStateMeter m(100);
+    const uint8_t spi = OTV0P2BASE::PowerDomain::SPI_BUS;
+    const uint8_t motor = OTV0P2BASE::PowerDomain::MOTOR;
+    EXPECT_FALSE(m.isOn(spi));
+    m.on(spi, 110);
+    m.on(spi, 115); // Already on.
+    EXPECT_TRUE(m.isOn(spi));
+    EXPECT_EQ(5U, m.getOnTicks(spi, 115));
+    m.off(spi, 120);
+    m.off(spi, 130); // Already off.
+    EXPECT_EQ(10U, m.getOnTicks(spi, 200));
+    m.on(motor, 150);
+    EXPECT_EQ(50U, m.getOnTicks(motor, 200));
+    m.on(spi, 190);
+    m.off(spi, 192);
+    EXPECT_EQ(12U, m.getOnTicks(spi, 200));
+    EXPECT_EQ(100U, m.getElapsedTicks(200));
+    EXPECT_EQ(120, m.perMille(m.getOnTicks(spi, 200), 200));
+    EXPECT_EQ(500, m.perMille(m.getOnTicks(motor, 200), 200));
+    // Out of range is ignored.
+    m.on(OTV0P2BASE::PowerDomain::COUNT, 200);
+    EXPECT_EQ(0U, m.getOnTicks(OTV0P2BASE::PowerDomain::COUNT, 300));
+}
+
+// Exactly one CPU state accumulates at a time.
+TEST(PowerAccounting,cpu)
+{
+    OTV0P2BASE::PowerStateMeter m(0);
+    EXPECT_EQ(OTV0P2BASE::CPUPowerState::ACTIVE, m.getCPUState());
+    m.setCPUState(OTV0P2BASE::CPUPowerState::POWER_SAVE, 10);
+    m.setCPUState(OTV0P2BASE::CPUPowerState::ACTIVE, 250);
+    m.setCPUState(OTV0P2BASE::CPUPowerState::IDLE, 256);
+    m.setCPUState(OTV0P2BASE::CPUPowerState::ACTIVE, 266);
+    EXPECT_EQ(20U, m.getCPUTicks(OTV0P2BASE::CPUPowerState::ACTIVE, 270));
+    EXPECT_EQ(10U, m.getCPUTicks(OTV0P2BASE::CPUPowerState::IDLE, 270));
+    EXPECT_EQ(240U, m.getCPUTicks(OTV0P2BASE::CPUPowerState::POWER_SAVE, 270));
+    // Reset keeps the current state running.
+    m.reset(300);
+    EXPECT_EQ(0U, m.getCPUTicks(OTV0P2BASE::CPUPowerState::POWER_SAVE, 310));
+    EXPECT_EQ(10U, m.getCPUTicks(OTV0P2BASE::CPUPowerState::ACTIVE, 310));
+    EXPECT_EQ(1000, m.perMille(m.getCPUTicks(OTV0P2BASE::CPUPowerState::ACTIVE, 310), 310));
+}
+
+// Long runs and the monotonic wrap do not overflow the ratio.
+TEST(PowerAccounting,longRun)
+{
+    const uint32_t start = 0xfffff000UL;
+    OTV0P2BASE::PowerStateMeter m(start);
+    m.on(OTV0P2BASE::PowerDomain::RADIO_RX, start);
+    const uint32_t later = uint32_t(start + 0x40000000UL);
+    m.off(OTV0P2BASE::PowerDomain::RADIO_RX, uint32_t(start + 0x10000000UL));
+    EXPECT_EQ(250, m.perMille(m.getOnTicks(OTV0P2BASE::PowerDomain::RADIO_RX, later), later));
+    EXPECT_EQ(0, m.perMille(0, start));
+}
+
+// Stats carry the main consumers in parts per thousand.
+TEST(PowerAccounting,stats)
+{
+    OTV0P2BASE::PowerStateMeter m(0);
+    m.on(OTV0P2BASE::PowerDomain::RADIO_TX, 0);
+    m.off(OTV0P2BASE::PowerDomain::RADIO_TX, 5);
+    m.setCPUState(OTV0P2BASE::CPUPowerState::POWER_SAVE, 100);
+    PAT::Stats ss;
+    OTV0P2BASE::putPowerStats(ss, m, 1000);
+    EXPECT_EQ(5, ss.n);
+    EXPECT_EQ(100, ss.get("pwA"));
+    EXPECT_EQ(0, ss.get("pwI"));
+    EXPECT_EQ(0, ss.get("pwR"));
+    EXPECT_EQ(5, ss.get("pwT"));
+    EXPECT_EQ(0, ss.get("pwM"));
+}
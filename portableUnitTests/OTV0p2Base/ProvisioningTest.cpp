@@ -0,0 +1,139 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for bulk provisioning tests.
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+
+
+namespace PT
+{
+typedef OTV0P2BASE::EEPROMJournalMockStore<1024> Store;
+
+static const uint8_t key[16] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+static const uint8_t id[8] = { 0x98, 0xa4, 0xf5, 0x99, 0xe3, 0x94, 0xa8, 0xc2 };
+static const uint8_t assocs[3*8] =
+    {
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+    };
+
+static uintptr_t assocAddr(const uint8_t s) { return(OTV0P2BASE::V0P2BASE_EE_START_NODE_ASSOCIATIONS + (s * OTV0P2BASE::V0P2BASE_EE_NODE_ASSOCIATIONS_SET_SIZE)); }
+
+// Build a full transaction.
+static uint8_t buildFull(uint8_t *const buf)
+    {
+    OTV0P2BASE::ProvisioningBuilder b(buf, OTV0P2BASE::PROVISION_MAX_BYTES);
+    EXPECT_TRUE(b.addKey(key));
+    EXPECT_TRUE(b.addID(id));
+    EXPECT_TRUE(b.addAssociations(assocs, 3));
+    return(b.finish());
+    }
+}
+
+// A complete transaction is written and reported.
+TEST(Provisioning, FullTransaction)
+{
+    uint8_t buf[OTV0P2BASE::PROVISION_MAX_BYTES];
+    const uint8_t len = PT::buildFull(buf);
+    ASSERT_NE(0, len);
+    PT::Store s;
+    // Existing associations beyond those provisioned are removed.
+    for(uint8_t i = 0; i < 8; ++i) { s.update(PT::assocAddr(5) + i, 0xb0); }
+    OTV0P2BASE::ProvisioningSummary summary;
+    EXPECT_EQ(OTV0P2BASE::PROVISION_OK, OTV0P2BASE::applyProvisioning(s, buf, len, &summary));
+    EXPECT_TRUE(summary.keySet);
+    EXPECT_FALSE(summary.keyCleared);
+    EXPECT_TRUE(summary.idSet);
+    EXPECT_EQ(3, summary.associations);
+    for(uint8_t i = 0; i < 16; ++i) { EXPECT_EQ(PT::key[i], s.read(OTV0P2BASE::PROVISION_EE_START_KEY + i)); }
+    for(uint8_t i = 0; i < 8; ++i) { EXPECT_EQ(PT::id[i], s.read(OTV0P2BASE::PROVISION_EE_START_ID + i)); }
+    for(uint8_t n = 0; n < 3; ++n)
+        { for(uint8_t i = 0; i < 8; ++i) { EXPECT_EQ(PT::assocs[(n*8)+i], s.read(PT::assocAddr(n) + i)); } }
+    EXPECT_EQ(0xff, s.read(PT::assocAddr(3)));
+    EXPECT_EQ(0xff, s.read(PT::assocAddr(5)));
+    // Re-applying writes nothing.
+    const uint16_t w = s.writes;
+    EXPECT_EQ(OTV0P2BASE::PROVISION_OK, OTV0P2BASE::applyProvisioning(s, buf, len));
+    EXPECT_EQ(w, s.writes);
+}
+
+// Any damage is detected before anything is written.
+TEST(Provisioning, RejectsDamage)
+{
+    uint8_t buf[OTV0P2BASE::PROVISION_MAX_BYTES];
+    const uint8_t len = PT::buildFull(buf);
+    PT::Store s;
+    // Truncated.
+    EXPECT_EQ(OTV0P2BASE::PROVISION_BAD_CRC, OTV0P2BASE::applyProvisioning(s, buf, 2 + 16));
+    EXPECT_EQ(OTV0P2BASE::PROVISION_BAD_FORMAT, OTV0P2BASE::applyProvisioning(s, buf, len - 1));
+    // Corrupted payload.
+    buf[5] ^= 1;
+    EXPECT_EQ(OTV0P2BASE::PROVISION_BAD_CRC, OTV0P2BASE::applyProvisioning(s, buf, len));
+    buf[5] ^= 1;
+    // Unknown record type.
+    buf[0] = 'Q';
+    EXPECT_EQ(OTV0P2BASE::PROVISION_BAD_FORMAT, OTV0P2BASE::applyProvisioning(s, buf, len));
+    EXPECT_EQ(0, s.writes);
+    // Invalid ID byte with a good CRC.
+    uint8_t bad[8];
+    memcpy(bad, PT::id, sizeof(bad));
+    bad[3] = 0x7f;
+    OTV0P2BASE::ProvisioningBuilder b(buf, sizeof(buf));
+    EXPECT_TRUE(b.addID(bad));
+    const uint8_t l2 = b.finish();
+    EXPECT_EQ(OTV0P2BASE::PROVISION_BAD_VALUE, OTV0P2BASE::applyProvisioning(s, buf, l2));
+    EXPECT_EQ(0, s.writes);
+}
+
+// Clearing the key and keeping RX counters of unchanged associations.
+TEST(Provisioning, KeyClearAndCounters)
+{
+    PT::Store s;
+    uint8_t buf[OTV0P2BASE::PROVISION_MAX_BYTES];
+    const uint8_t len = PT::buildFull(buf);
+    ASSERT_EQ(OTV0P2BASE::PROVISION_OK, OTV0P2BASE::applyProvisioning(s, buf, len));
+    // Simulate RX counters for slots 0 and 1.
+    s.update(PT::assocAddr(0) + 8, 0x12);
+    s.update(PT::assocAddr(1) + 8, 0x34);
+    // Slot 0 unchanged, slot 1 replaced.
+    uint8_t a2[16];
+    memcpy(a2, PT::assocs, sizeof(a2));
+    a2[15] = 0xfe;
+    OTV0P2BASE::ProvisioningBuilder b(buf, sizeof(buf));
+    EXPECT_TRUE(b.addKey(NULL));
+    EXPECT_TRUE(b.addAssociations(a2, 2));
+    const uint8_t l2 = b.finish();
+    OTV0P2BASE::ProvisioningSummary summary;
+    EXPECT_EQ(OTV0P2BASE::PROVISION_OK, OTV0P2BASE::applyProvisioning(s, buf, l2, &summary));
+    EXPECT_TRUE(summary.keyCleared);
+    EXPECT_FALSE(summary.idSet);
+    EXPECT_EQ(2, summary.associations);
+    for(uint8_t i = 0; i < 16; ++i) { EXPECT_EQ(0xff, s.read(OTV0P2BASE::PROVISION_EE_START_KEY + i)); }
+    EXPECT_EQ(0x12, s.read(PT::assocAddr(0) + 8));
+    EXPECT_EQ(0xff, s.read(PT::assocAddr(1) + 8));
+    EXPECT_EQ(0xfe, s.read(PT::assocAddr(1) + 7));
+    EXPECT_EQ(0xff, s.read(PT::assocAddr(2)));
+}
@@ -136,3 +136,71 @@ TEST(PseudoSensorOccupancyTracker,basics)
     ASSERT_FALSE(o1.reportedNewOccupancyRecently());
     EXPECT_EQ(2, o1.twoBitOccupancyValue());
 }
+
+// Test notification of changes of coarse occupancy state.
+namespace PSOTState
+    {
+    class Listener final : public OTV0P2BASE::OccupancyStateListener
+        {
+        public:
+            int calls = 0;
+            OTV0P2BASE::occState last = OTV0P2BASE::OCC_STATE_UNKNOWN;
+            virtual void occupancyStateChanged(const OTV0P2BASE::occState s) override { ++calls; last = s; }
+        };
+    }
+TEST(PseudoSensorOccupancyTracker,stateListeners)
+{
+    OTV0P2BASE::PseudoSensorOccupancyTracker o1;
+    PSOTState::Listener l1, l2, l3;
+    EXPECT_FALSE(o1.addStateListener(NULL));
+    // Told the current state at once.
+    ASSERT_TRUE(o1.addStateListener(&l1));
+    EXPECT_EQ(1, l1.calls);
+    EXPECT_EQ(OTV0P2BASE::OCC_STATE_VACANT, l1.last);
+    // Adding again is harmless.
+    ASSERT_TRUE(o1.addStateListener(&l1));
+    EXPECT_EQ(1, l1.calls);
+    ASSERT_TRUE(o1.addStateListener(&l2));
+    EXPECT_FALSE(o1.addStateListener(&l3)) << "full";
+
+    // No change, no notification.
+    for(int i = 0; i < 10; ++i) { o1.read(); }
+    EXPECT_EQ(1, l1.calls);
+
+    // Occupancy is seen at the next read() only, once.
+    o1.markAsOccupied();
+    EXPECT_EQ(OTV0P2BASE::OCC_STATE_VACANT, o1.getState());
+    EXPECT_EQ(1, l1.calls);
+    o1.read();
+    EXPECT_EQ(OTV0P2BASE::OCC_STATE_OCCUPIED, o1.getState());
+    EXPECT_EQ(2, l1.calls);
+    EXPECT_EQ(OTV0P2BASE::OCC_STATE_OCCUPIED, l1.last);
+    EXPECT_EQ(OTV0P2BASE::OCC_STATE_OCCUPIED, l2.last);
+    o1.markAsOccupied();
+    o1.read();
+    EXPECT_EQ(2, l1.calls);
+
+    // Run through vacancy to long and long long vacancy, checking each transition.
+    o1.removeStateListener(&l2);
+    int transitions = 0;
+    OTV0P2BASE::occState prev = o1.getState();
+    for(int m = 0; m < 48 * 60; ++m)
+        {
+        o1.read();
+        const OTV0P2BASE::occState s = o1.getState();
+        if(s != prev) { ++transitions; EXPECT_EQ(s, l1.last) << m; EXPECT_EQ(prev + 1, s) << m; }
+        prev = s;
+        // State agrees with the polled views.
+        EXPECT_EQ(o1.isLikelyOccupied(), (OTV0P2BASE::OCC_STATE_OCCUPIED == s));
+        EXPECT_EQ(o1.longVacant(), (s >= OTV0P2BASE::OCC_STATE_LONG_VACANT));
+        EXPECT_EQ(o1.longLongVacant(), (OTV0P2BASE::OCC_STATE_LONG_LONG_VACANT == s));
+        }
+    EXPECT_EQ(3, transitions);
+    EXPECT_EQ(2 + 3, l1.calls);
+    EXPECT_EQ(OTV0P2BASE::OCC_STATE_OCCUPIED, l2.last) << "removed listener not told";
+
+    // Reset is reported.
+    o1.reset();
+    EXPECT_EQ(OTV0P2BASE::OCC_STATE_VACANT, l1.last);
+    EXPECT_EQ(2 + 3 + 1, l1.calls);
+}
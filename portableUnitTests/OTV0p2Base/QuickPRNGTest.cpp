@@ -0,0 +1,90 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for QuickPRNG tests.
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_QuickPRNG.h"
+
+
+// PCG32 matches the reference implementation (pcg32-demo seeded with 42, 54).
+TEST(QuickPRNG,PCG32Reference)
+{
+    OTV0P2BASE::PCG32 r(42, 54);
+    EXPECT_EQ(0xa15c02b7U, r.next32());
+    EXPECT_EQ(0x7b47f409U, r.next32());
+    EXPECT_EQ(0xba1d3330U, r.next32());
+    EXPECT_EQ(0x83d2f293U, r.next32());
+    EXPECT_EQ(0xbfa4784bU, r.next32());
+    EXPECT_EQ(0xcbed606eU, r.next32());
+}
+
+// Jump-ahead lands exactly where stepping would, and can step back.
+TEST(QuickPRNG,PCG32Advance)
+{
+    OTV0P2BASE::PCG32 stepped(1234, 5), jumped(1234, 5);
+    for(int i = 0; i < 1000; ++i) { stepped.next32(); }
+    jumped.advance(1000);
+    EXPECT_TRUE(stepped == jumped);
+    EXPECT_EQ(stepped.next32(), jumped.next32());
+    jumped.advance(uint64_t(0) - 1001);
+    const OTV0P2BASE::PCG32 fresh(1234, 5);
+    EXPECT_TRUE(fresh == jumped);
+}
+
+// Streams with the same seed differ; same seed and stream reproduce.
+TEST(QuickPRNG,PCG32Streams)
+{
+    OTV0P2BASE::PCG32 a(99, 1), b(99, 2), a2(99, 1);
+    EXPECT_TRUE(a != b);
+    uint8_t ba[37], bb[37], ba2[37];
+    a.fill(ba, sizeof(ba));
+    b.fill(bb, sizeof(bb));
+    a2.fill(ba2, sizeof(ba2));
+    EXPECT_EQ(0, memcmp(ba, ba2, sizeof(ba)));
+    EXPECT_NE(0, memcmp(ba, bb, sizeof(ba)));
+    // fill() is little-endian next32() output.
+    OTV0P2BASE::PCG32 c(42, 54);
+    uint8_t bc[5];
+    c.fill(bc, sizeof(bc));
+    EXPECT_EQ(0xb7, bc[0]);
+    EXPECT_EQ(0xa1, bc[3]);
+    EXPECT_EQ(0x09, bc[4]);
+}
+
+// Bounded values stay in range and cover it.
+TEST(QuickPRNG,PCG32Bounded)
+{
+    OTV0P2BASE::PCG32 r(7, 7);
+    uint16_t counts[6] = { };
+    for(int i = 0; i < 6000; ++i)
+        {
+        const uint32_t v = r.nextBounded(6);
+        ASSERT_GT(6U, v);
+        ++counts[v];
+        }
+    for(int i = 0; i < 6; ++i) { EXPECT_LT(800, counts[i]); EXPECT_GT(1200, counts[i]); }
+    EXPECT_EQ(0U, r.nextBounded(0));
+    EXPECT_EQ(0U, r.nextBounded(1));
+}
@@ -40,3 +40,46 @@ TEST(RTC,getElapsedSecondsLT)
     EXPECT_EQ(59, OTV0P2BASE::getElapsedSecondsLT(2, 1));
 }
 
+
+// Monotonic ticks and ms combine the cycle count with the sub-cycle time.
+TEST(RTC,monotonicFrom)
+{
+    EXPECT_EQ(0U, OTV0P2BASE::monotonicTicksFrom(0, 0));
+    EXPECT_EQ(255U, OTV0P2BASE::monotonicTicksFrom(0, 255));
+    EXPECT_EQ(256U + 7, OTV0P2BASE::monotonicTicksFrom(1, 7));
+    EXPECT_EQ(0U, OTV0P2BASE::monotonicMsFrom(0, 0));
+    EXPECT_EQ(1000U, OTV0P2BASE::monotonicMsFrom(0, 128));
+    EXPECT_EQ(1992U, OTV0P2BASE::monotonicMsFrom(0, 255));
+    EXPECT_EQ(6000U + 7, OTV0P2BASE::monotonicMsFrom(3, 1));
+    // Successive ticks never go backwards in ms, including across a cycle.
+    uint32_t last = 0;
+    for(uint32_t c = 0; c < 3; ++c)
+        {
+        for(uint16_t s = 0; s < 256; ++s)
+            {
+            const uint32_t ms = OTV0P2BASE::monotonicMsFrom(c, uint8_t(s));
+            EXPECT_LE(last, ms);
+            EXPECT_GE(8U, ms - last);
+            last = ms;
+            }
+        }
+}
+
+// Comparisons stay correct across the 32-bit wrap.
+TEST(RTC,monotonicCompare)
+{
+    EXPECT_EQ(10U, OTV0P2BASE::monotonicElapsed(100, 110));
+    EXPECT_EQ(20U, OTV0P2BASE::monotonicElapsed(0xfffffff6UL, 10));
+    EXPECT_TRUE(OTV0P2BASE::monotonicReached(110, 110));
+    EXPECT_TRUE(OTV0P2BASE::monotonicReached(111, 110));
+    EXPECT_FALSE(OTV0P2BASE::monotonicReached(109, 110));
+    EXPECT_TRUE(OTV0P2BASE::monotonicReached(5, 0xfffffff0UL));
+    EXPECT_FALSE(OTV0P2BASE::monotonicReached(0xfffffff0UL, 5));
+    EXPECT_TRUE(OTV0P2BASE::monotonicIsAfter(5, 0xfffffff0UL));
+    EXPECT_FALSE(OTV0P2BASE::monotonicIsAfter(5, 5));
+    EXPECT_FALSE(OTV0P2BASE::monotonicIsAfter(4, 5));
+    // ms from the full cycle count run on smoothly across the ms wrap.
+    const uint32_t c = 0xffffffffUL / 2000;
+    EXPECT_EQ(8U, OTV0P2BASE::monotonicElapsed(OTV0P2BASE::monotonicMsFrom(c, 255), OTV0P2BASE::monotonicMsFrom(c + 1, 0)));
+    EXPECT_TRUE(OTV0P2BASE::monotonicIsAfter(OTV0P2BASE::monotonicMsFrom(c + 1, 10), OTV0P2BASE::monotonicMsFrom(c, 200)));
+}
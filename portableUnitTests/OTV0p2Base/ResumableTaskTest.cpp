@@ -0,0 +1,136 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for ResumableTask tests.
+ */
+
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_ResumableTask.h"
+
+
+namespace RTTest
+{
+typedef OTV0P2BASE::ResumableTask RT;
+// A modem-like sequence: retry a command until it is accepted, then a second one.
+class Sequence final
+    {
+    public:
+        RT rt;
+        // Simulated replies: true when the modem has answered; accepted if ok.
+        bool replied = false, ok = false;
+        int sent = 0, retries = 0, steps = 0;
+        // Nested task and the number of times it has run to completion.
+        RT child;
+        int childDone = 0;
+
+        RT::Status sub()
+            {
+            OT_RT_BEGIN(child);
+            OT_RT_YIELD(child);
+            OT_RT_YIELD(child);
+            ++childDone;
+            OT_RT_END(child);
+            }
+
+        RT::Status step()
+            {
+            ++steps;
+            OT_RT_BEGIN(rt);
+            for(retries = 0; retries < 3; ++retries)
+                {
+                ++sent;
+                OT_RT_AWAIT_OR_POLLS(rt, replied, 4);
+                if(rt.isTimedOut()) { continue; }
+                replied = false;
+                if(ok) { break; }
+                OT_RT_YIELD(rt);
+                }
+            if(retries >= 3) { OT_RT_EXIT(rt); }
+            OT_RT_AWAIT(rt, RT::DONE == sub());
+            OT_RT_END(rt);
+            }
+    };
+}
+
+// A sequence written linearly resumes at its await points and reports DONE once.
+TEST(ResumableTask, Sequence)
+{
+    RTTest::Sequence s;
+    EXPECT_FALSE(s.rt.isRunning());
+    EXPECT_EQ(RTTest::RT::WAITING, s.step());
+    EXPECT_TRUE(s.rt.isRunning());
+    EXPECT_EQ(1, s.sent);
+    // Rejected: yields once then resends.
+    s.replied = true;
+    EXPECT_EQ(RTTest::RT::WAITING, s.step());
+    EXPECT_EQ(1, s.sent);
+    EXPECT_EQ(RTTest::RT::WAITING, s.step());
+    EXPECT_EQ(2, s.sent);
+    EXPECT_EQ(1, s.retries);
+    // Times out on the 4th poll without a reply, and resends at once.
+    EXPECT_EQ(RTTest::RT::WAITING, s.step());
+    EXPECT_EQ(RTTest::RT::WAITING, s.step());
+    EXPECT_EQ(2, s.sent);
+    EXPECT_EQ(RTTest::RT::WAITING, s.step());
+    EXPECT_EQ(3, s.sent);
+    EXPECT_EQ(2, s.retries);
+    EXPECT_FALSE(s.rt.isTimedOut());
+    // Accepted: on to the nested task, which takes three runs.
+    s.replied = true;
+    s.ok = true;
+    EXPECT_EQ(RTTest::RT::WAITING, s.step());
+    EXPECT_EQ(RTTest::RT::WAITING, s.step());
+    EXPECT_EQ(0, s.childDone);
+    EXPECT_EQ(RTTest::RT::DONE, s.step());
+    EXPECT_EQ(1, s.childDone);
+    EXPECT_FALSE(s.rt.isRunning());
+    EXPECT_FALSE(s.child.isRunning());
+    EXPECT_EQ(3, s.sent);
+    // Runs again from the top.
+    s.replied = false;
+    EXPECT_EQ(RTTest::RT::WAITING, s.step());
+    EXPECT_EQ(4, s.sent);
+    EXPECT_EQ(0, s.retries);
+}
+
+// Exhausting the retries exits early; restart() abandons a sequence part way through.
+TEST(ResumableTask, ExitAndRestart)
+{
+    RTTest::Sequence s;
+    RTTest::RT::Status r = RTTest::RT::WAITING;
+    int n = 0;
+    while((RTTest::RT::WAITING == r) && (n++ < 100)) { r = s.step(); }
+    EXPECT_EQ(RTTest::RT::DONE, r);
+    EXPECT_EQ(3, s.sent);
+    EXPECT_EQ(10, n);
+    EXPECT_FALSE(s.rt.isRunning());
+    EXPECT_EQ(0, s.childDone);
+    // Restart mid-way.
+    s.step();
+    EXPECT_EQ(4, s.sent);
+    s.step();
+    s.rt.restart();
+    EXPECT_FALSE(s.rt.isRunning());
+    s.step();
+    EXPECT_EQ(5, s.sent);
+    EXPECT_EQ(0, s.retries);
+}
@@ -0,0 +1,165 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for SPIFlashTimeSeries tests.
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_SPIFlashTimeSeries.h"
+
+
+namespace SFTS
+{
+typedef OTV0P2BASE::SPINORFlashMock<> flash_t; // 4 sectors.
+typedef OTV0P2BASE::SPIFlashTimeSeries<flash_t, 4> ts_t;
+void payloadFor(const uint32_t t, uint8_t *const p) { p[0] = uint8_t(t); p[1] = uint8_t(t >> 8); p[2] = 0x5a; p[3] = uint8_t(~t); }
+}
+
+// Records are batched a page at a time and read back in order.
+TEST(SPIFlashTimeSeries, basics)
+{
+    static SFTS::flash_t f;
+    SFTS::ts_t ts(f);
+    EXPECT_FALSE(ts.begin());
+    EXPECT_TRUE(ts.isEmpty());
+    EXPECT_EQ(uint32_t(SFTS::ts_t::NO_TIME), ts.getFirstTime());
+    uint8_t p[4];
+    // 30 records fill the rest of the first page after the sector header.
+    for(uint32_t t = 100; t < 129; ++t) { SFTS::payloadFor(t, p); ASSERT_TRUE(ts.append(t, p)); }
+    EXPECT_EQ(1U, f.programs); // Just the header.
+    EXPECT_EQ(1, f.erases);
+    EXPECT_EQ(29, ts.getBuffered());
+    SFTS::payloadFor(129, p);
+    ASSERT_TRUE(ts.append(129, p));
+    EXPECT_EQ(2U, f.programs);
+    EXPECT_EQ(0, ts.getBuffered());
+    // Time may not go backwards, and NO_TIME is reserved.
+    EXPECT_FALSE(ts.append(128, p));
+    EXPECT_FALSE(ts.append(SFTS::ts_t::NO_TIME, p));
+    ASSERT_TRUE(ts.append(129, p));
+    // Unflushed records are not visible to readers.
+    SFTS::ts_t::Reader r(ts);
+    uint32_t t;
+    uint8_t q[4];
+    for(uint32_t i = 100; i < 130; ++i)
+        {
+        ASSERT_TRUE(r.next(t, q));
+        EXPECT_EQ(i, t);
+        SFTS::payloadFor(i, p);
+        EXPECT_EQ(0, memcmp(p, q, 4));
+        }
+    EXPECT_FALSE(r.next(t, q));
+    ASSERT_TRUE(ts.flush());
+    EXPECT_TRUE(r.next(t, q));
+    EXPECT_EQ(129U, t);
+    EXPECT_EQ(100U, ts.getFirstTime());
+    EXPECT_EQ(129U, ts.getLastTime());
+    EXPECT_TRUE(ts.clear());
+    EXPECT_TRUE(ts.isEmpty());
+    SFTS::ts_t::Reader r2(ts);
+    EXPECT_FALSE(r2.next(t, q));
+}
+
+// Weeks of minutes wrap the sector ring, dropping the oldest; the log survives a restart; days are found by seek.
+TEST(SPIFlashTimeSeries, wrapRecoverSeek)
+{
+    static SFTS::flash_t f;
+    SFTS::ts_t ts(f);
+    ts.begin();
+    uint8_t p[4], q[4];
+    const uint32_t n = 4000; // Nearly 8 sectors' worth.
+    for(uint32_t i = 0; i < n; ++i) { SFTS::payloadFor(i * 5, p); ASSERT_TRUE(ts.append(i * 5, p)); }
+    // Ends part way through a page.
+    EXPECT_NE(0, ts.getBuffered());
+    ASSERT_TRUE(ts.flush());
+    EXPECT_EQ(4, ts.getSectorsUsed());
+    const uint32_t first = ts.getFirstTime();
+    EXPECT_LT(0U, first);
+    EXPECT_EQ(0U, first % 5);
+    // Each sector holds 510 records, so there are at least 3 full sectors' worth.
+    EXPECT_GE((n * 5 - first) / 5, 3U * uint32_t(SFTS::ts_t::RECORDS_PER_SECTOR));
+
+    // Restart.
+    SFTS::ts_t ts2(f);
+    ASSERT_TRUE(ts2.begin());
+    EXPECT_EQ(4, ts2.getSectorsUsed());
+    EXPECT_EQ(first, ts2.getFirstTime());
+    EXPECT_EQ((n - 1) * 5, ts2.getLastTime());
+    SFTS::ts_t::Reader r(ts2);
+    uint32_t t, expected = first;
+    while(r.next(t, q))
+        {
+        ASSERT_EQ(expected, t);
+        SFTS::payloadFor(t, p);
+        ASSERT_EQ(0, memcmp(p, q, 4));
+        expected += 5;
+        }
+    EXPECT_EQ(n * 5, expected);
+    // Carry on appending after the restart.
+    SFTS::payloadFor(n * 5, p);
+    ASSERT_TRUE(ts2.append(n * 5, p));
+    ASSERT_TRUE(ts2.flush());
+
+    // Seek to days, including before the start and after the end.
+    const uint32_t day = first / 1440 + 1;
+    SFTS::ts_t::Reader rd(ts2);
+    rd.seekDay(day);
+    ASSERT_TRUE(rd.next(t, q));
+    EXPECT_EQ(day * 1440, t); // 1440 is a multiple of 5.
+    rd.seek(first + 3);
+    ASSERT_TRUE(rd.next(t, q));
+    EXPECT_EQ(first + 5, t);
+    rd.seek(0);
+    ASSERT_TRUE(rd.next(t, q));
+    EXPECT_EQ(first, t);
+    rd.seek(n * 5);
+    ASSERT_TRUE(rd.next(t, q));
+    EXPECT_EQ(n * 5, t);
+    EXPECT_FALSE(rd.next(t, q));
+    rd.seek(n * 5 + 1);
+    EXPECT_FALSE(rd.next(t, q));
+}
+
+// Records that straddle page boundaries are split into programs within pages.
+TEST(SPIFlashTimeSeries, oddRecordSize)
+{
+    static OTV0P2BASE::SPINORFlashMock<8192> f;
+    OTV0P2BASE::SPIFlashTimeSeries<decltype(f), 5, 64> ts(f);
+    ts.begin();
+    uint8_t p[5], q[5];
+    for(uint32_t i = 0; i < 1000; ++i)
+        {
+        for(uint8_t j = 0; j < 5; ++j) { p[j] = uint8_t(i * 7 + j); }
+        ASSERT_TRUE(ts.append(i, p)) << i;
+        }
+    ASSERT_TRUE(ts.flush());
+    decltype(ts)::Reader r(ts);
+    uint32_t t, expected = ts.getFirstTime();
+    while(r.next(t, q))
+        {
+        ASSERT_EQ(expected, t);
+        for(uint8_t j = 0; j < 5; ++j) { ASSERT_EQ(uint8_t(t * 7 + j), q[j]); }
+        ++expected;
+        }
+    EXPECT_EQ(1000U, expected);
+}
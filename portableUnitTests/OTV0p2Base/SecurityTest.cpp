@@ -500,3 +500,97 @@ TEST(getNextMatchingNodeID, ReturnCorrectIDWithPartialPrefix)
     EXPECT_EQ(7, i7);
     EXPECT_THAT(outbuf, ::testing::ElementsAreArray(id7));
 }
+
+
+// Test that NodeAssociationIndex gives the same answers as the linear scan,
+// including for shared prefixes, short prefixes and start indexes,
+// and that it picks up table changes only once invalidated.
+TEST(NodeAssociationIndex, MatchesLinearScan)
+{
+    GNMNID::nodes._reset();
+    OTV0P2BASE::NodeAssociationIndex index;
+    EXPECT_FALSE(index.isValid());
+    // Unsorted IDs, some sharing a key prefix, in slots 0--5.
+    const uint8_t ids[][GNMNID::nodes.idLength] = {
+        { 0x90, 0x01, 1, 1, 1, 1, 1, 1 },
+        { 0x10, 0x02, 0, 0, 0, 0, 0, 0 },
+        { 0x90, 0x01, 2, 2, 2, 2, 2, 2 },
+        { 0x10, 0x01, 0, 0, 0, 0, 0, 0 },
+        { 0x90, 0x00, 0, 0, 0, 0, 0, 0 },
+        { 0x90, 0x01, 1, 1, 1, 1, 1, 1 },
+        };
+    const uint8_t nIDs = sizeof(ids) / sizeof(ids[0]);
+    for (uint8_t i = 0; i != nIDs; ++i) { ASSERT_TRUE(GNMNID::nodes.set(i, ids[i])); }
+    EXPECT_EQ(nIDs, index.build(GNMNID::nodes));
+    EXPECT_TRUE(index.isValid());
+    EXPECT_EQ(nIDs, index.size());
+
+    const uint8_t probes[][GNMNID::nodes.idLength] = {
+        { 0x90, 0x01, 1, 1, 1, 1, 1, 1 },
+        { 0x90, 0x01, 2, 2, 2, 2, 2, 2 },
+        { 0x90, 0x01, 3, 3, 3, 3, 3, 3 },
+        { 0x10, 0x01, 0, 0, 0, 0, 0, 0 },
+        { 0x10, 0x03, 0, 0, 0, 0, 0, 0 },
+        { 0x00, 0x00, 0, 0, 0, 0, 0, 0 },
+        { 0xf0, 0x00, 0, 0, 0, 0, 0, 0 },
+        };
+    for (const auto &p : probes) {
+        for (uint8_t len = 0; len <= GNMNID::nodes.idLength; ++len) {
+            for (uint8_t start = 0; start != GNMNID::nodes.maxSets; ++start) {
+                uint8_t expectedID[GNMNID::nodes.idLength] = {};
+                uint8_t actualID[GNMNID::nodes.idLength] = {};
+                const int8_t expected = GNMNID::getNextMatchingNodeID(start, p, len, expectedID);
+                const int8_t actual = index.getNextMatchingNodeID(GNMNID::nodes, start, p, len, actualID);
+                ASSERT_EQ(expected, actual) << "len " << int(len) << " start " << int(start);
+                if (expected >= 0) { ASSERT_EQ(0, memcmp(expectedID, actualID, sizeof(actualID))); }
+            }
+        }
+    }
+
+    // A new entry is not seen until the index is invalidated.
+    const uint8_t newID[GNMNID::nodes.idLength] = { 0xf0, 0, 0, 0, 0, 0, 0, 0 };
+    ASSERT_TRUE(GNMNID::nodes.set(nIDs, newID));
+    EXPECT_EQ(-1, index.getNextMatchingNodeID(GNMNID::nodes, 0, newID, sizeof(newID), NULL));
+    index.invalidate();
+    EXPECT_EQ(nIDs, index.getNextMatchingNodeID(GNMNID::nodes, 0, newID, sizeof(newID), NULL));
+    EXPECT_EQ(nIDs + 1, index.size());
+    // Invalid inputs are rejected as for the linear scan.
+    EXPECT_EQ(-1, index.getNextMatchingNodeID(GNMNID::nodes, GNMNID::nodes.maxSets, newID, 1, NULL));
+    EXPECT_EQ(-1, index.getNextMatchingNodeID(GNMNID::nodes, 0, newID, GNMNID::nodes.idLength + 1, NULL));
+}
+
+// Test the shared NodeIDPrefixIndex core directly:
+// keys kept sorted with ties in slot order, and a full index refuses more entries.
+TEST(NodeAssociationIndex, PrefixIndexCore)
+{
+    OTV0P2BASE::NodeIDPrefixIndex<uint16_t, 4, 1> index;
+    EXPECT_FALSE(index.isValid());
+    const uint8_t a[] = { 0x90, 1, 1, 1, 1, 1, 1, 1 };
+    const uint8_t b[] = { 0x10, 2, 2, 2, 2, 2, 2, 2 };
+    const uint8_t c[] = { 0x90, 3, 3, 3, 3, 3, 3, 3 };
+    EXPECT_TRUE(index.insert(a, 300));
+    EXPECT_TRUE(index.insert(b, 301));
+    EXPECT_TRUE(index.insert(c, 302));
+    EXPECT_EQ(3, index.size());
+    EXPECT_EQ(301, index.slotAt(0));
+    EXPECT_EQ(300, index.slotAt(1));
+    EXPECT_EQ(302, index.slotAt(2));
+    EXPECT_EQ(1, index.lowerBound(c, 1));
+    EXPECT_TRUE(index.keyMatches(2, c, 1));
+    EXPECT_FALSE(index.keyMatches(3, c, 1));
+    EXPECT_TRUE(index.hasKeyPrefix(b, 1));
+    const uint8_t d[] = { 0x50, 0, 0, 0, 0, 0, 0, 0 };
+    EXPECT_FALSE(index.hasKeyPrefix(d, 1));
+    EXPECT_TRUE(index.insert(d, 303));
+    EXPECT_FALSE(index.insert(d, 304));
+    EXPECT_EQ(4, index.size());
+    // Building from a table replaces the contents and bumps the generation.
+    GNMNID::nodes._reset();
+    ASSERT_TRUE(GNMNID::nodes.set(0, c));
+    const uint8_t g = index.getGeneration();
+    EXPECT_EQ(1, index.build(GNMNID::nodes, 4));
+    EXPECT_TRUE(index.isValid());
+    EXPECT_NE(g, index.getGeneration());
+    EXPECT_EQ(0, index.slotAt(0));
+    EXPECT_FALSE(index.hasKeyPrefix(b, 1));
+}
@@ -0,0 +1,118 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for SensorHistoryRing tests.
+ */
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_SensorHistory.h"
+
+
+namespace SHT
+{
+bool same(const OTV0P2BASE::SensorHistorySample &a, const OTV0P2BASE::SensorHistorySample &b)
+    { return((a.tempC16 == b.tempC16) && (a.ambLight == b.ambLight) && (a.valvePC == b.valvePC) && (a.occpc == b.occpc)); }
+}
+
+// Basic encoding: unchanged minutes share a byte, small changes take two.
+TEST(SensorHistory, basics)
+{
+    OTV0P2BASE::SensorHistoryRing<> h;
+    OTV0P2BASE::SensorHistorySample s;
+    EXPECT_TRUE(h.isEmpty());
+    EXPECT_FALSE(h.getMinutesAgo(0, s));
+    OTV0P2BASE::SensorHistoryRing<>::Reader r0(h);
+    EXPECT_FALSE(r0.next(s));
+
+    const OTV0P2BASE::SensorHistorySample a = { 19 << 4, 40, 0, 0 };
+    for(int i = 0; i < 16; ++i) { h.add(a); }
+    EXPECT_EQ(16, h.getMinutes());
+    EXPECT_EQ(1, h.getBytesUsed());
+    h.add(a);
+    EXPECT_EQ(2, h.getBytesUsed());
+    OTV0P2BASE::SensorHistorySample b = a;
+    b.tempC16 = int16_t(b.tempC16 + 1);
+    h.add(b);
+    EXPECT_EQ(4, h.getBytesUsed());
+    b.valvePC = 100; // Big swing: 2-byte varint.
+    b.ambLight = 0;
+    h.add(b);
+    EXPECT_EQ(8, h.getBytesUsed());
+    EXPECT_EQ(19, h.getMinutes());
+    EXPECT_TRUE(SHT::same(b, h.getLatest()));
+    ASSERT_TRUE(h.getMinutesAgo(0, s));
+    EXPECT_TRUE(SHT::same(b, s));
+    ASSERT_TRUE(h.getMinutesAgo(2, s));
+    EXPECT_TRUE(SHT::same(a, s));
+    ASSERT_TRUE(h.getMinutesAgo(18, s));
+    EXPECT_TRUE(SHT::same(a, s));
+    EXPECT_FALSE(h.getMinutesAgo(19, s));
+    h.clear();
+    EXPECT_TRUE(h.isEmpty());
+    EXPECT_EQ(0, h.getBytesUsed());
+}
+
+// Random walks, checked against a plain copy of every sample, with the oldest dropped to fit.
+TEST(SensorHistory, randomWalk)
+{
+    // Seed random() for use in simulator; --gtest_shuffle will force it to change.
+    srandom((unsigned) ::testing::UnitTest::GetInstance()->random_seed());
+    static const int n = 2000;
+    static OTV0P2BASE::SensorHistorySample all[n];
+    OTV0P2BASE::SensorHistoryRing<16> small;
+    OTV0P2BASE::SensorHistoryRing<256> h;
+    OTV0P2BASE::SensorHistorySample s = { 18 << 4, 100, 50, 0 };
+    for(int i = 0; i < n; ++i)
+        {
+        const long r = random();
+        if(r & 1) { s.tempC16 = int16_t(s.tempC16 + ((r >> 1) & 3) - 1); }
+        if(0 == (r & 0x30)) { s.ambLight = uint8_t(r >> 8); }
+        if(0 == (r & 0xc0)) { s.valvePC = uint8_t((r >> 16) % 101); }
+        if(0 == (r & 0x300)) { s.occpc = uint8_t((r >> 20) % 101); }
+        // Occasional extreme temperatures.
+        if(0 == (r % 97)) { s.tempC16 = int16_t((r & 0x8000) ? INT16_MIN : INT16_MAX); }
+        all[i] = s;
+        h.add(s);
+        small.add(s);
+        ASSERT_LE(h.getBytesUsed(), 256);
+        ASSERT_LE(small.getBytesUsed(), 16);
+        ASSERT_GT(small.getMinutes(), 0);
+        ASSERT_TRUE(SHT::same(s, h.getLatest()));
+        }
+    // A 256-byte ring holds well over an hour of this fairly busy history.
+    EXPECT_GT(h.getMinutes(), 60);
+    OTV0P2BASE::SensorHistoryRing<256>::Reader rd(h);
+    for(int i = n - h.getMinutes(); i < n; ++i)
+        {
+        OTV0P2BASE::SensorHistorySample t;
+        ASSERT_TRUE(rd.next(t));
+        ASSERT_TRUE(SHT::same(all[i], t)) << i;
+        }
+    OTV0P2BASE::SensorHistorySample t;
+    EXPECT_FALSE(rd.next(t));
+    for(uint16_t m = 0; m < small.getMinutes(); ++m)
+        {
+        ASSERT_TRUE(small.getMinutesAgo(m, t));
+        ASSERT_TRUE(SHT::same(all[n - 1 - m], t)) << m;
+        }
+}
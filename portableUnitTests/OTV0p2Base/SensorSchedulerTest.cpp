@@ -0,0 +1,119 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for SensorScheduler tests.
+ */
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+
+
+namespace SSTest
+{
+// Sensor that counts its reads.
+template<class T>
+class CountingSensor final : public OTV0P2BASE::Sensor<T>
+    {
+    private:
+        const uint8_t pollS;
+    public:
+        int reads = 0;
+        explicit CountingSensor(const uint8_t p) : pollS(p) { }
+        virtual T read() override { ++reads; return(T(reads)); }
+        virtual T get() const override { return(T(reads)); }
+        virtual uint8_t preferredPollInterval_s() const override { return(pollS); }
+    };
+}
+
+// Reads follow the poll intervals, and the sub-cycle window.
+TEST(SensorScheduler,intervals)
+{
+    SSTest::CountingSensor<int16_t> temp(60);
+    SSTest::CountingSensor<uint16_t> supply(0);
+    SSTest::CountingSensor<uint8_t> light(60);
+    OTV0P2BASE::SensorScheduler<4> s;
+    const uint8_t noneDue = s.NONE_DUE;
+    EXPECT_EQ(noneDue, s.nextDueInS());
+    EXPECT_TRUE(s.add(temp));
+    EXPECT_FALSE(s.add(supply)) << "no poll interval";
+    EXPECT_TRUE(s.add(supply, s.NO_GROUP, false, 120));
+    EXPECT_TRUE(s.add(light, s.NO_GROUP, false, 30));
+    EXPECT_EQ(3, s.size());
+    EXPECT_EQ(0, s.nextDueInS());
+
+    // All read at the first tick.
+    EXPECT_EQ(3, s.tick(0, 0));
+    EXPECT_EQ(30, s.nextDueInS());
+    // Two hours of 2s cycles.
+    for(int t = 2; t <= 7200; t += 2) { s.tick(2, 0); }
+    EXPECT_EQ(1 + 7200/60, temp.reads);
+    EXPECT_EQ(1 + 7200/120, supply.reads);
+    EXPECT_EQ(1 + 7200/30, light.reads);
+
+    // Outside the window nothing is read, and it stays due.
+    s.setWindow(64, 191);
+    EXPECT_EQ(0, s.tick(30, 10));
+    EXPECT_EQ(0, s.nextDueInS());
+    EXPECT_EQ(1, s.tick(0, 64));
+    EXPECT_EQ(2 + 7200/30, light.reads);
+    EXPECT_EQ(0, s.tick(0, 192));
+}
+
+// Group members are read together; low priority can be held off.
+TEST(SensorScheduler,groupsAndPriority)
+{
+    // Two I2C sensors and one low-priority ADC sensor.
+    const uint8_t I2C = 1, ADC = 2;
+    SSTest::CountingSensor<int16_t> tmp112(60);
+    SSTest::CountingSensor<uint8_t> sht21(60);
+    SSTest::CountingSensor<uint16_t> battery(60);
+    OTV0P2BASE::SensorScheduler<> s(10);
+    ASSERT_TRUE(s.add(tmp112, I2C));
+    ASSERT_TRUE(s.add(sht21, I2C, false, 50));
+    ASSERT_TRUE(s.add(battery, ADC, true));
+    EXPECT_EQ(3, s.tick(0, 0));
+
+    // At 50s the SHT21 is due, and the TMP112 (due in 10s) goes with it.
+    EXPECT_EQ(0, s.tick(40, 0));
+    EXPECT_GE(10, s.nextDueInS(false));
+    EXPECT_EQ(2, s.tick(10, 0, false));
+    EXPECT_EQ(2, tmp112.reads);
+    EXPECT_EQ(2, sht21.reads);
+    EXPECT_EQ(1, battery.reads);
+    // The battery is due at 60s, but held off.
+    EXPECT_EQ(10, s.nextDueInS());
+    EXPECT_EQ(0, s.tick(10, 0, false));
+    EXPECT_EQ(0, s.nextDueInS());
+    EXPECT_EQ(40, s.nextDueInS(false));
+    EXPECT_EQ(1, s.tick(2, 0, true));
+    EXPECT_EQ(2, battery.reads);
+
+    // Over a long run grouping never makes a sensor late, and the I2C wakes are shared.
+    int i2cWakes = 0;
+    for(int t = 0; t < 3600; t += 2)
+        {
+        const int before = tmp112.reads + sht21.reads;
+        s.tick(2, 0);
+        if(tmp112.reads + sht21.reads != before) { ++i2cWakes; }
+        }
+    EXPECT_LE(3600/60, tmp112.reads - 2);
+    EXPECT_LE(3600/50, sht21.reads - 2);
+    EXPECT_GT((tmp112.reads + sht21.reads - 4), i2cWakes) << "some reads shared a wake";
+}
@@ -0,0 +1,87 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for OTV0p2Base SerialTXRing tests.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+
+#include "OTV0P2BASE_SerialTXRing.h"
+
+
+// Whole pushes only, FIFO order, and wrap-around of the indices.
+TEST(SerialTXRing,PushPop)
+{
+    OTV0P2BASE::SerialTXRing<8> r;
+    EXPECT_TRUE(r.isEmpty());
+    EXPECT_EQ(8, r.space());
+    uint8_t c;
+    EXPECT_FALSE(r.pop(c));
+    EXPECT_FALSE(r.push((const uint8_t *)NULL, 1));
+    EXPECT_TRUE(r.push("abcde", 5));
+    EXPECT_EQ(5, r.queued());
+    EXPECT_FALSE(r.push("wxyz", 4));
+    EXPECT_EQ(5, r.queued());
+    EXPECT_EQ(1, r.getDropped());
+    EXPECT_TRUE(r.push("xyz", 3));
+    EXPECT_EQ(0, r.space());
+    const char expected[] = "abcdexyz";
+    for(int i = 0; i < 8; ++i) { ASSERT_TRUE(r.pop(c)); EXPECT_EQ(expected[i], char(c)); }
+    EXPECT_TRUE(r.isEmpty());
+    // Run the free-running indices round several times.
+    uint8_t v = 0;
+    for(int i = 0; i < 300; ++i)
+        {
+        const uint8_t b[3] = { v, uint8_t(v + 1), uint8_t(v + 2) };
+        ASSERT_TRUE(r.push(b, sizeof(b)));
+        for(int j = 0; j < 3; ++j) { ASSERT_TRUE(r.pop(c)); ASSERT_EQ(v++, c); }
+        }
+    EXPECT_TRUE(r.isEmpty());
+    EXPECT_EQ(1, r.getDropped());
+}
+
+// Pumping never writes more than asked.
+TEST(SerialTXRing,PumpTo)
+{
+    char buf[16];
+    OTV0P2BASE::BufPrint bp(buf, sizeof(buf));
+    OTV0P2BASE::SerialTXRing<16> r;
+    EXPECT_EQ(0, r.pumpTo(bp, 4));
+    ASSERT_TRUE(r.push("hello\r\n", 7));
+    EXPECT_EQ(0, r.pumpTo(bp, 0));
+    EXPECT_EQ(2, r.pumpTo(bp, 2));
+    EXPECT_STREQ("he", buf);
+    EXPECT_EQ(5, r.pumpTo(bp, 10));
+    EXPECT_STREQ("hello\r\n", buf);
+    EXPECT_TRUE(r.isEmpty());
+}
+
+// Non-flushing serial output stays pending until drained before sleep.
+TEST(SerialTXRing,FlushBeforeSleep)
+{
+    OTV0P2BASE::flushBeforeSleep();
+    EXPECT_FALSE(OTV0P2BASE::serialOutputPending());
+    OTV0P2BASE::serialWrite("", 0);
+    EXPECT_TRUE(OTV0P2BASE::serialOutputPending());
+    OTV0P2BASE::nap(0);
+    EXPECT_FALSE(OTV0P2BASE::serialOutputPending());
+}
@@ -0,0 +1,122 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for SoftSerialEdgeDecoder tests.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+#include <gtest/gtest.h>
+#include "OTV0P2BASE_SoftSerialEdgeDecoder.h"
+
+
+namespace SSEDTest
+{
+// Simulated RX line feeding edges to a decoder with ISR latency jitter.
+template<class decoder_t>
+class Line final
+    {
+    private:
+        decoder_t &d;
+        const uint16_t bitTicks;
+        const uint16_t maxLatency;
+        bool level = true;
+    public:
+        // Timer now; wraps.
+        uint16_t t;
+        Line(decoder_t &d_, const uint16_t b, const uint16_t lat, const uint16_t t0)
+          : d(d_), bitTicks(b), maxLatency(lat), t(t0) { }
+        void setLevel(const bool l)
+            {
+            if(l != level) { d.captureEdgeFromISR(uint16_t(t + ((0 == maxLatency) ? 0 : (random() % maxLatency))), l); }
+            level = l;
+            }
+        // Send an 8N1 frame, optionally with a bad (low) stop bit.
+        void send(const uint8_t b, const bool badStop = false)
+            {
+            setLevel(false); t += bitTicks;
+            for(int i = 0; i < 8; ++i) { setLevel(0 != (b & (1 << i))); t += bitTicks; }
+            setLevel(!badStop); t += bitTicks;
+            if(badStop) { t += bitTicks; setLevel(true); }
+            }
+        void idle(const uint16_t bits) { t += uint16_t(bits * bitTicks); }
+    };
+}
+
+// Decode of back-to-back and spaced bytes, ending on timeout, with jitter and timer wrap.
+TEST(SoftSerialEdgeDecoder,decode)
+{
+    srandom((unsigned) ::testing::UnitTest::GetInstance()->random_seed());
+    // 9600 baud with a 1MHz timer; 19200 baud.
+    for(const uint16_t bitTicks : { uint16_t(104), uint16_t(52) })
+        {
+        SCOPED_TRACE(bitTicks);
+        typedef OTV0P2BASE::SoftSerialEdgeDecoder<128, 128> d_t;
+        d_t d(bitTicks);
+        SSEDTest::Line<d_t> line(d, bitTicks, uint16_t(bitTicks / 4), uint16_t(65536 - 500));
+        EXPECT_EQ(0, d.available(line.t));
+        EXPECT_EQ(-1, d.read());
+        std::vector<uint8_t> sent;
+        // Extremes, then random, partly back-to-back (no idle after the stop bit).
+        for(const uint8_t b : { 0x00, 0xff, 0x55, 0xaa, 0x01, 0x80, 0x7f, 0xfe }) { sent.push_back(b); line.send(b); }
+        for(int i = 0; i < 8; ++i) { if(random() & 1) { line.idle(uint16_t(random() % 20)); } const uint8_t b = uint8_t(random()); sent.push_back(b); line.send(b); }
+        // The last byte is not complete until its stop bit has been seen to pass.
+        ASSERT_EQ(sent.size() - 1, d.available(uint16_t(line.t - bitTicks)));
+        ASSERT_EQ(sent.size(), d.available(line.t));
+        EXPECT_EQ(sent[0], d.peek());
+        for(const uint8_t b : sent) { EXPECT_EQ(b, d.read()); }
+        EXPECT_EQ(-1, d.read());
+        EXPECT_EQ(0, d.getFramingErrors());
+        EXPECT_EQ(0, d.getEdgesDropped());
+        EXPECT_EQ(0, d.getBytesDropped());
+        }
+}
+
+// Framing errors, overflow and clear.
+TEST(SoftSerialEdgeDecoder,errors)
+{
+    typedef OTV0P2BASE::SoftSerialEdgeDecoder<16, 2> d_t;
+    d_t d(104);
+    SSEDTest::Line<d_t> line(d, 104, 0, 0);
+    line.send(0x42, true);
+    line.idle(2);
+    line.send(0x43);
+    line.idle(2);
+    EXPECT_EQ(1, d.available(line.t));
+    EXPECT_EQ(1, d.getFramingErrors());
+    EXPECT_EQ(0x43, d.read());
+    // Byte queue overflow keeps the oldest.
+    for(uint8_t b = 1; b <= 3; ++b) { line.send(b); line.idle(1); EXPECT_LE(1, d.available(line.t)); }
+    EXPECT_EQ(2, d.available(line.t));
+    EXPECT_EQ(1, d.getBytesDropped());
+    EXPECT_EQ(1, d.read());
+    EXPECT_EQ(2, d.read());
+    // Edge queue overflow: 0x55 has 10 edges, more than 16 for two bytes.
+    line.send(0x55); line.send(0x55);
+    d.available(line.t);
+    EXPECT_LT(0, d.getEdgesDropped());
+    d.clear();
+    EXPECT_EQ(0, d.available(line.t));
+    line.idle(2);
+    line.send(0x99);
+    line.idle(1);
+    EXPECT_EQ(1, d.available(line.t));
+    EXPECT_EQ(0x99, d.read());
+}
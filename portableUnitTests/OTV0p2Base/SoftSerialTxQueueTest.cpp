@@ -0,0 +1,122 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for SoftSerialTxQueue tests.
+ */
+
+
+#include <stdint.h>
+#include <vector>
+#include <gtest/gtest.h>
+#include "OTV0P2BASE_SoftSerialTxQueue.h"
+
+
+namespace SSTXQTest
+{
+static int completions;
+static void onComplete(void *const context) { ++completions; *static_cast<int *>(context) += 1; }
+
+// Run the ISR until idle, appending the line levels.
+template<class q_t>
+static void drain(q_t &q, std::vector<int> &levels)
+    {
+    for(int i = 0; i < 10000; ++i)
+        {
+        const int8_t l = q.nextLevelFromISR();
+        if(l < 0) { return; }
+        levels.push_back(l);
+        }
+    FAIL() << "did not go idle";
+    }
+
+// Decode 8N1 from one level per bit time.
+static std::vector<uint8_t> decode(const std::vector<int> &levels)
+    {
+    std::vector<uint8_t> out;
+    size_t i = 0;
+    while(i < levels.size())
+        {
+        if(1 == levels[i]) { ++i; continue; }
+        EXPECT_LE(i + 10, levels.size());
+        if(i + 10 > levels.size()) { break; }
+        uint8_t b = 0;
+        for(int j = 0; j < 8; ++j) { if(levels[i + 1 + j]) { b |= uint8_t(1 << j); } }
+        EXPECT_EQ(1, levels[i + 9]);
+        out.push_back(b);
+        i += 10;
+        }
+    return(out);
+    }
+}
+
+// Bytes are framed back-to-back and the timer is only started when idle.
+TEST(SoftSerialTxQueue,frames)
+{
+    OTV0P2BASE::SoftSerialTxQueue<4> q;
+    EXPECT_FALSE(q.isBusy());
+    EXPECT_FALSE(q.start());
+    EXPECT_EQ(4, q.space());
+    int ctx = 0;
+    SSTXQTest::completions = 0;
+    q.setCompletionCallback(SSTXQTest::onComplete, &ctx);
+    const uint8_t msg[] = { 0x00, 0xff, 0x55, 0xa3 };
+    for(const uint8_t b : msg) { EXPECT_TRUE(q.put(b)); }
+    EXPECT_FALSE(q.put(0x12));
+    EXPECT_EQ(0, q.space());
+    EXPECT_TRUE(q.start());
+    EXPECT_FALSE(q.start());
+    EXPECT_TRUE(q.isBusy());
+    std::vector<int> levels;
+    // More can be queued once the first byte is taken.
+    levels.push_back(q.nextLevelFromISR());
+    EXPECT_EQ(0, levels[0]);
+    EXPECT_TRUE(q.put(0x12));
+    EXPECT_FALSE(q.start());
+    SSTXQTest::drain(q, levels);
+    EXPECT_EQ(50U, levels.size());
+    EXPECT_FALSE(q.isBusy());
+    EXPECT_EQ(1, SSTXQTest::completions);
+    EXPECT_EQ(1, ctx);
+    const std::vector<uint8_t> got = SSTXQTest::decode(levels);
+    ASSERT_EQ(5U, got.size());
+    for(size_t i = 0; i < 4; ++i) { EXPECT_EQ(msg[i], got[i]); }
+    EXPECT_EQ(0x12, got[4]);
+    // Idle: restarting needs start() again.
+    EXPECT_TRUE(q.put(0x34));
+    EXPECT_TRUE(q.start());
+    levels.clear();
+    SSTXQTest::drain(q, levels);
+    ASSERT_EQ(1U, SSTXQTest::decode(levels).size());
+    EXPECT_EQ(0x34, SSTXQTest::decode(levels)[0]);
+    EXPECT_EQ(2, SSTXQTest::completions);
+}
+
+// clear() lets the frame in progress finish.
+TEST(SoftSerialTxQueue,clear)
+{
+    OTV0P2BASE::SoftSerialTxQueue<> q;
+    for(uint8_t b = 0; b < 5; ++b) { q.put(b); }
+    q.start();
+    std::vector<int> levels;
+    for(int i = 0; i < 3; ++i) { levels.push_back(q.nextLevelFromISR()); }
+    q.clear();
+    SSTXQTest::drain(q, levels);
+    EXPECT_EQ(10U, levels.size());
+    EXPECT_FALSE(q.isBusy());
+}
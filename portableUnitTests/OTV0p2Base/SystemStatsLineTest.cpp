@@ -22,6 +22,7 @@ Author(s) / Copyright (s): Damon Hart-Davis 2017
 
 #include <stdint.h>
 #include <gtest/gtest.h>
+#include <type_traits>
 #include <OTV0p2Base.h>
 #include <OTRadValve.h>
 
@@ -129,3 +130,128 @@ TEST(SystemStatsLine,Basics)
 //    ASSERT_EQ('\0', Basics::buf[0]);
 }
 
+
+// The buffered line matches the Print version, and can go via a TX ring.
+TEST(SystemStatsLine,Buffered)
+{
+    Basics::bp.reset();
+    Basics::valveMode.reset();
+    Basics::modelledRadValve.reset();
+    Basics::tempC16.reset();
+    Basics::rh.reset();
+    Basics::ambLight.reset();
+    Basics::occupancy.reset();
+
+    // Below zero, with the 16ths still from the arithmetic shift.
+    Basics::tempC16.set(int16_t(-(5 << 4) + 3));
+    Basics::rh.set(50);
+
+    OTV0P2BASE::SystemStatsLine<
+        decltype(Basics::valveMode), &Basics::valveMode,
+        decltype(Basics::modelledRadValve), &Basics::modelledRadValve,
+        decltype(Basics::tempC16), &Basics::tempC16,
+        decltype(Basics::rh), &Basics::rh,
+        decltype(Basics::ambLight), &Basics::ambLight,
+        decltype(Basics::occupancy), &Basics::occupancy,
+        decltype(Basics::schedule), &Basics::schedule,
+        false, // No JSON stats, as they rotate between calls.
+        decltype(Basics::bp), &Basics::bp> ssl;
+
+    char line[decltype(ssl)::MAX_STATUS_LINE_CHARS];
+    EXPECT_EQ(0, ssl.formatStatusReport(line, sizeof(line) - 1));
+    const uint8_t len = ssl.formatStatusReport(line, sizeof(line));
+    EXPECT_STREQ("=F0%@-5C3\r\n", line);
+    EXPECT_EQ(strlen(line), len);
+    ssl.serialStatusReport();
+    EXPECT_STREQ(line, Basics::buf);
+
+    // Queued whole, then pumped out in non-blocking chunks.
+    Basics::bp.reset();
+    OTV0P2BASE::SerialTXRing<16> ring;
+    ASSERT_TRUE(ssl.queueStatusReport(ring));
+    EXPECT_EQ(len, ring.queued());
+    // No room for a second whole line.
+    EXPECT_FALSE(ssl.queueStatusReport(ring));
+    EXPECT_EQ(1, ring.getDropped());
+    EXPECT_EQ(4, ring.pumpTo(Basics::bp, 4));
+    EXPECT_EQ(len - 4, ring.pumpTo(Basics::bp, 64));
+    EXPECT_TRUE(ring.isEmpty());
+    EXPECT_STREQ(line, Basics::buf);
+
+    // Largest values fit the buffer, with JSON.
+    Basics::bp.reset();
+    Basics::valveMode.setWarmModeDebounced(true);
+    Basics::modelledRadValve.set(100);
+    Basics::tempC16.set(INT16_MIN);
+    OTV0P2BASE::SystemStatsLine<
+        decltype(Basics::valveMode), &Basics::valveMode,
+        decltype(Basics::modelledRadValve), &Basics::modelledRadValve,
+        decltype(Basics::tempC16), &Basics::tempC16,
+        decltype(Basics::rh), &Basics::rh,
+        decltype(Basics::ambLight), &Basics::ambLight,
+        decltype(Basics::occupancy), &Basics::occupancy,
+        decltype(Basics::schedule), &Basics::schedule,
+        true, // Enable JSON stats.
+        decltype(Basics::bp), &Basics::bp> sslJ;
+    sslJ.serialStatusReport();
+    EXPECT_STREQ("=W100%@-2048C0;{\"@\":\"\",\"H|%\":50,\"L\":0,\"occ|%\":0}\r\n", Basics::buf);
+}
+
+
+// Static-dispatch (CRTP) sensors work as SystemStatsLine parameters without a vtable,
+// and can still be used through the virtual Sensor interface via an adapter.
+namespace StaticSensors
+    {
+    class RHStatic final : public OTV0P2BASE::SimpleTSUint8SensorStatic<RHStatic>
+        {
+        public:
+            uint8_t next = 0;
+            uint8_t read() { value = next; return(value); }
+            OTV0P2BASE::Sensor_tag_t tag() const { return(V0p2_SENSOR_TAG_F("H|%")); }
+            bool isValid(const uint8_t v) const { return(v <= 100); }
+        };
+    static RHStatic rh;
+    }
+TEST(SystemStatsLine,StaticSensors)
+{
+    EXPECT_FALSE(std::is_polymorphic<StaticSensors::RHStatic>::value);
+    StaticSensors::rh.next = 42;
+    EXPECT_EQ(42, StaticSensors::rh.read());
+    EXPECT_EQ(42, StaticSensors::rh.get());
+    EXPECT_TRUE(StaticSensors::rh.isAvailable());
+
+    Basics::bp.reset();
+    Basics::valveMode.reset();
+    Basics::valveMode.setWarmModeDebounced(false);
+    Basics::modelledRadValve.reset();
+    Basics::tempC16.reset();
+    Basics::ambLight.reset();
+    Basics::occupancy.reset();
+    Basics::tempC16.set((18 << 4) + 14);
+    OTV0P2BASE::SystemStatsLine<
+        decltype(Basics::valveMode), &Basics::valveMode,
+        decltype(Basics::modelledRadValve), &Basics::modelledRadValve,
+        decltype(Basics::tempC16), &Basics::tempC16,
+        decltype(StaticSensors::rh), &StaticSensors::rh,
+        decltype(Basics::ambLight), &Basics::ambLight,
+        decltype(Basics::occupancy), &Basics::occupancy,
+        decltype(Basics::schedule), &Basics::schedule,
+        true, // Enable JSON stats.
+        decltype(Basics::bp), &Basics::bp> ssl;
+    ssl.serialStatusReport();
+    EXPECT_STREQ("=F0%@18CE;{\"@\":\"\",\"H|%\":42,\"L\":0,\"occ|%\":0}\r\n", Basics::buf);
+
+    // Via the virtual interface.
+    OTV0P2BASE::SensorVirtualAdapter<StaticSensors::RHStatic> a(StaticSensors::rh);
+    OTV0P2BASE::Sensor<uint8_t> &v = a;
+    StaticSensors::rh.next = 43;
+    EXPECT_EQ(43, v.read());
+    EXPECT_EQ(43, StaticSensors::rh.get());
+    EXPECT_EQ(43, v.get());
+    EXPECT_TRUE(v.isAvailable());
+    EXPECT_FALSE(v.isValid(101));
+    EXPECT_TRUE(v.isValid(100));
+    EXPECT_EQ(0, v.preferredPollInterval_s());
+    EXPECT_FALSE(v.handleInterruptSimple());
+    EXPECT_STREQ("H|%", v.tag());
+}
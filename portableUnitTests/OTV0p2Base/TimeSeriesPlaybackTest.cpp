@@ -0,0 +1,164 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for sensor time-series playback tests.
+ */
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+
+
+#ifdef OTV0P2BASE_TIME_SERIES_PLAYBACK_AVAILABLE
+namespace TSPT
+{
+// Unique temporary file path, removed on destruction.
+struct TempPath final
+    {
+    std::string path;
+    TempPath()
+        {
+        char p[] = "/tmp/timeseriesXXXXXX";
+        const int fd = mkstemp(p);
+        if(fd >= 0) { close(fd); unlink(p); }
+        path = p;
+        }
+    ~TempPath() { unlink(path.c_str()); }
+    const char *c_str() const { return(path.c_str()); }
+    };
+
+static void writeText(const TempPath &p, const char *const text)
+    {
+    FILE *const f = fopen(p.c_str(), "w");
+    ASSERT_TRUE(NULL != f);
+    fputs(text, f);
+    fclose(f);
+    }
+}
+
+// CSV parsing, including colon-separated times, comments and bad lines.
+TEST(TimeSeriesPlayback,csv)
+{
+    TSPT::TempPath p;
+    TSPT::writeText(p,
+        "# d:H:M:S light temp\n"
+        "0:0:1:0, 47, 320\n"
+        "\n"
+        "1:2:3:4 5\r\n"
+        "bad line\n"
+        "90 -7 12 3\n"
+        "  100,32767,-32768");
+    OTV0P2BASE::MappedTimeSeries ts(p.c_str());
+    ASSERT_TRUE(ts.isOpen());
+    EXPECT_FALSE(ts.isBinary());
+    OTV0P2BASE::TimeSeriesSample s;
+    ASSERT_TRUE(ts.next(s));
+    EXPECT_EQ(60U, s.t);
+    EXPECT_EQ(2, s.columns);
+    EXPECT_EQ(47, s.v[0]);
+    EXPECT_EQ(320, s.v[1]);
+    ASSERT_TRUE(ts.next(s));
+    EXPECT_EQ(((24U + 2U) * 60U + 3U) * 60U + 4U, s.t);
+    EXPECT_EQ(1, s.columns);
+    ASSERT_TRUE(ts.next(s));
+    EXPECT_EQ(90U, s.t);
+    EXPECT_EQ(3, s.columns);
+    EXPECT_EQ(-7, s.v[0]);
+    ASSERT_TRUE(ts.next(s));
+    EXPECT_EQ(100U, s.t);
+    EXPECT_EQ(32767, s.v[0]);
+    EXPECT_EQ(-32768, s.v[1]);
+    EXPECT_FALSE(ts.next(s));
+    ts.rewind();
+    ASSERT_TRUE(ts.next(s));
+    EXPECT_EQ(60U, s.t);
+    // Missing and empty files cannot be opened.
+    EXPECT_FALSE(ts.open("/nonexistent/trace.csv"));
+    EXPECT_FALSE(ts.isOpen());
+    TSPT::writeText(p, "");
+    EXPECT_FALSE(ts.open(p.c_str()));
+}
+
+// Binary round trip.
+TEST(TimeSeriesPlayback,binary)
+{
+    TSPT::TempPath p;
+    OTV0P2BASE::TimeSeriesSample in[3];
+    for(uint8_t i = 0; i < 3; ++i) { in[i].t = 100000UL * i; in[i].columns = 2; in[i].v[0] = i; in[i].v[1] = -1000 * i; }
+    in[2].columns = 1; // Missing column written as 0.
+    ASSERT_TRUE(OTV0P2BASE::writeBinaryTimeSeries(p.c_str(), in, 3, 2));
+    OTV0P2BASE::MappedTimeSeries ts(p.c_str());
+    ASSERT_TRUE(ts.isOpen());
+    EXPECT_TRUE(ts.isBinary());
+    OTV0P2BASE::TimeSeriesSample s;
+    for(uint8_t i = 0; i < 3; ++i)
+        {
+        ASSERT_TRUE(ts.next(s));
+        EXPECT_EQ(in[i].t, s.t);
+        EXPECT_EQ(2, s.columns);
+        EXPECT_EQ(i, s.v[0]);
+        EXPECT_EQ((2 == i) ? 0 : (-1000 * i), s.v[1]);
+        }
+    EXPECT_FALSE(ts.next(s));
+    EXPECT_FALSE(OTV0P2BASE::writeBinaryTimeSeries(p.c_str(), in, 3, 0));
+}
+
+// Driving sensor mocks by virtual time, holding values between samples.
+TEST(TimeSeriesPlayback,drivesMocks)
+{
+    TSPT::TempPath p;
+    TSPT::writeText(p,
+        "0 10 200\n"
+        "60 20\n"
+        "120 30 250\n");
+    OTV0P2BASE::MappedTimeSeries ts(p.c_str());
+    ASSERT_TRUE(ts.isOpen());
+    OTV0P2BASE::SensorAmbientLightAdaptiveMock light;
+    OTV0P2BASE::TemperatureC16Mock temp;
+    OTV0P2BASE::SensorPlayback<2> pb(ts);
+    EXPECT_TRUE(pb.bind(0, light));
+    EXPECT_TRUE(pb.bind(1, temp));
+    EXPECT_FALSE(pb.bind(0, light)); // Out of bindings.
+    uint32_t t;
+    ASSERT_TRUE(pb.peekTime(t));
+    EXPECT_EQ(0U, t);
+    EXPECT_EQ(1U, pb.advanceTo(59));
+    EXPECT_EQ(10, light.get());
+    EXPECT_EQ(200, temp.read());
+    // Missing column leaves the temperature as is.
+    EXPECT_EQ(1U, pb.advanceTo(119));
+    EXPECT_EQ(20, light.get());
+    EXPECT_EQ(200, temp.read());
+    EXPECT_FALSE(pb.isFinished());
+    EXPECT_EQ(1U, pb.advanceTo(1000));
+    EXPECT_EQ(30, light.get());
+    EXPECT_EQ(250, temp.read());
+    EXPECT_TRUE(pb.isFinished());
+    EXPECT_EQ(3U, pb.getApplied());
+    EXPECT_EQ(0U, pb.advanceTo(2000));
+    pb.rewind();
+    EXPECT_EQ(3U, pb.advanceTo(1000));
+}
+#endif // OTV0P2BASE_TIME_SERIES_PLAYBACK_AVAILABLE
@@ -0,0 +1,113 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for TraceRing tests.
+ */
+
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_Trace.h"
+
+
+// Entries come back oldest first until the ring fills.
+TEST(Trace,basics)
+{
+    OTV0P2BASE::TraceRing<4> r;
+    EXPECT_EQ(0, r.size());
+    OTV0P2BASE::TraceEntry e;
+    EXPECT_FALSE(r.get(0, e));
+    r.record(10, OTV0P2BASE::TraceId::SLEEP_ENTER, 7);
+    r.record(200, OTV0P2BASE::TraceId::SLEEP_EXIT, 8);
+    EXPECT_EQ(2, r.size());
+    ASSERT_TRUE(r.get(0, e));
+    EXPECT_EQ(10, e.sct);
+    EXPECT_EQ(OTV0P2BASE::TraceId::SLEEP_ENTER, e.id);
+    EXPECT_EQ(7, e.value);
+    ASSERT_TRUE(r.get(1, e));
+    EXPECT_EQ(200, e.sct);
+    EXPECT_EQ(8, e.value);
+    EXPECT_FALSE(r.get(2, e));
+    EXPECT_EQ(0, r.getOverwritten());
+}
+
+// When full the oldest entries are overwritten and counted.
+TEST(Trace,wrap)
+{
+    OTV0P2BASE::TraceRing<3> r;
+    for(uint8_t i = 0; i < 5; ++i) { r.record(i, OTV0P2BASE::TraceId::APP, uint16_t(1000 + i)); }
+    EXPECT_EQ(3, r.size());
+    EXPECT_EQ(2, r.getOverwritten());
+    OTV0P2BASE::TraceEntry e;
+    for(uint8_t i = 0; i < 3; ++i)
+        {
+        ASSERT_TRUE(r.get(i, e));
+        EXPECT_EQ(2 + i, e.sct);
+        EXPECT_EQ(1002 + i, e.value);
+        }
+    r.clear();
+    EXPECT_EQ(0, r.size());
+    EXPECT_EQ(0, r.getOverwritten());
+    r.record(9, 1, 2);
+    ASSERT_TRUE(r.get(0, e));
+    EXPECT_EQ(9, e.sct);
+}
+
+// Nothing is recorded while paused.
+TEST(Trace,pause)
+{
+    OTV0P2BASE::TraceRing<2> r;
+    r.record(1, 1, 1);
+    r.pause(true);
+    EXPECT_TRUE(r.isPaused());
+    r.record(2, 2, 2);
+    EXPECT_EQ(1, r.size());
+    r.pause(false);
+    r.record(3, 3, 3);
+    EXPECT_EQ(2, r.size());
+    OTV0P2BASE::TraceEntry e;
+    ASSERT_TRUE(r.get(1, e));
+    EXPECT_EQ(3, e.id);
+}
+
+// Monotonic ticks record the cycle as well as the sub-cycle time.
+TEST(Trace,cycle)
+{
+    OTV0P2BASE::TraceRing<2> r;
+    r.record(uint16_t((5U << 8) | 250), 1, 1);
+    r.record(uint16_t((6U << 8) | 3), 2, 2);
+    OTV0P2BASE::TraceEntry e;
+    ASSERT_TRUE(r.get(0, e));
+    EXPECT_EQ(5, e.cycle);
+    EXPECT_EQ(250, e.sct);
+    ASSERT_TRUE(r.get(1, e));
+    EXPECT_EQ(6, e.cycle);
+    EXPECT_EQ(3, e.sct);
+}
+
+// Disabled trace points compile away without evaluating their arguments.
+TEST(Trace,disabled)
+{
+#ifndef OTV0P2BASE_TRACE
+    int evaluated = 0;
+    OT_TRACE(OTV0P2BASE::TraceId::APP, ++evaluated);
+    EXPECT_EQ(0, evaluated);
+#endif
+}
@@ -109,3 +109,59 @@ TEST(ScratchSpace,basics)
     EXPECT_EQ(sizeof(buf)-4, sss4.bufsize);
 }
 
+namespace SSPT
+{
+// Stand-in for a routine using n bytes of its scratch space.
+static void useScratch(OTV0P2BASE::ScratchSpaceL &s, OTV0P2BASE::ScratchSpaceUsage &u, const size_t n)
+    {
+    OTV0P2BASE::ScratchSpaceProbe probe(s, u);
+    for(size_t i = 0; (i < n) && (i < s.bufsize); ++i) { s.buf[i] = uint8_t(i); }
+    }
+}
+
+// Test scratch space high-water mark probing.
+TEST(ScratchSpace,probe)
+{
+    uint8_t buf[64];
+    OTV0P2BASE::ScratchSpaceL s(buf, sizeof(buf));
+    OTV0P2BASE::ScratchSpaceUsage u;
+    EXPECT_EQ(0U, u.highWater);
+    SSPT::useScratch(s, u, 10);
+    EXPECT_EQ(10U, u.highWater);
+    SSPT::useScratch(s, u, 30);
+    SSPT::useScratch(s, u, 5);
+    EXPECT_EQ(30U, u.highWater);
+    EXPECT_EQ(3U, u.calls);
+    EXPECT_EQ(sizeof(buf), u.minSize);
+    OTV0P2BASE::ScratchSpaceL sub(s, 16);
+    SSPT::useScratch(sub, u, 1);
+    EXPECT_EQ(48U, u.minSize);
+    EXPECT_EQ(0U, OTV0P2BASE::scratchSpaceUsed(NULL, 10));
+    // Empty space is harmless.
+    OTV0P2BASE::ScratchSpaceL e(NULL, 0);
+    SSPT::useScratch(e, u, 1);
+    EXPECT_EQ(0U, u.minSize);
+}
+
+// Test exclusive leases on a shared scratch arena.
+TEST(ScratchSpace,sharedArena)
+{
+    static OTV0P2BASE::SharedScratchArena<100> arena;
+    EXPECT_FALSE(arena.isInUse());
+        {
+        OTV0P2BASE::SharedScratchArena<100>::Lease tx(arena);
+        EXPECT_TRUE(tx.isHeld());
+        EXPECT_TRUE(arena.isInUse());
+        EXPECT_EQ(100U, tx.space.bufsize);
+        EXPECT_TRUE(NULL != tx.space.buf);
+        // Overlapping use gets nothing.
+        OTV0P2BASE::SharedScratchArena<100>::Lease rx(arena);
+        EXPECT_FALSE(rx.isHeld());
+        EXPECT_EQ(NULL, rx.space.buf);
+        EXPECT_EQ(0U, rx.space.bufsize);
+        }
+    EXPECT_FALSE(arena.isInUse());
+    OTV0P2BASE::SharedScratchArena<100>::Lease rx(arena);
+    EXPECT_TRUE(rx.isHeld());
+}
+
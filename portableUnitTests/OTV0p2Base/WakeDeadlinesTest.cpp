@@ -0,0 +1,89 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for WakeDeadlines tests.
+ */
+
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_WakeDeadlines.h"
+
+
+// Earliest deadline, one-shot clearing and carrying over cycles.
+TEST(WakeDeadlines,basics)
+{
+    OTV0P2BASE::WakeDeadlines<4> d;
+    const uint16_t none = d.NONE;
+    EXPECT_EQ(none, d.next());
+    EXPECT_FALSE(d.isDue(0, 255));
+    // Radio listen at tick 200, sensor poll in 1s (128 ticks) from tick 10, stats TX in 3s.
+    d.setAt(0, 200);
+    d.setInSeconds(1, 10, 1);
+    d.setInSeconds(2, 10, 3);
+    EXPECT_EQ(138, d.next());
+    EXPECT_EQ(10 + 3*128, d.get(2));
+    EXPECT_FALSE(d.isDue(1, 137));
+    EXPECT_TRUE(d.isDue(1, 138));
+    d.clearDue(150);
+    EXPECT_EQ(none, d.get(1));
+    EXPECT_EQ(200, d.next());
+    // Only brings the deadline forward.
+    d.setNoLaterThan(0, 220);
+    EXPECT_EQ(200, d.get(0));
+    d.setNoLaterThan(0, 180);
+    EXPECT_EQ(180, d.get(0));
+    // Out of range slot ignored.
+    d.setAt(4, 1);
+    EXPECT_EQ(none, d.get(4));
+    EXPECT_EQ(180, d.next());
+    // Roll: the missed deadline is due at once; later ones are brought forward.
+    d.newCycle();
+    EXPECT_EQ(0, d.get(0));
+    EXPECT_EQ(10 + 3*128 - 256, d.get(2));
+    d.clearDue(0);
+    EXPECT_EQ(138, d.next());
+    d.newCycle();
+    EXPECT_EQ(0, d.next());
+    d.clearAll();
+    EXPECT_EQ(none, d.next());
+    // Far deadlines saturate rather than wrap.
+    d.setInTicks(3, 255, 0xffff);
+    EXPECT_EQ(none - 1, d.get(3));
+    d.clear(3);
+    EXPECT_EQ(none, d.next());
+}
+
+// Absolute monotonic deadlines map onto this cycle, including across a wrap.
+TEST(WakeDeadlines,monotonic)
+{
+    OTV0P2BASE::WakeDeadlines<2> d;
+    // Now is tick 10 of some cycle; the deadline is 300 ticks on.
+    const uint32_t now = (123UL << 8) | 10;
+    d.setAtMonotonic(0, now, now + 300);
+    EXPECT_EQ(310, d.get(0));
+    // Already reached: due now.
+    d.setAtMonotonic(1, now, now - 5);
+    EXPECT_EQ(10, d.get(1));
+    EXPECT_TRUE(d.isDue(1, 10));
+    // Across the wrap of the monotonic ticks.
+    d.setAtMonotonic(0, 0xfffffff0UL, 0x10);
+    EXPECT_EQ(0xf0 + 0x20, d.get(0));
+}
@@ -0,0 +1,78 @@
+/*
+The OpenTRV project licenses this file to you
+under the Apache Licence, Version 2.0 (the "Licence");
+you may not use this file except in compliance
+with the Licence. You may obtain a copy of the Licence at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the Licence is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied. See the Licence for the
+specific language governing permissions and limitations
+under the Licence.
+
+Author(s) / Copyright (s): Damon Hart-Davis 2019
+*/
+
+/*
+ * Driver for WakeTimeProfile tests.
+ */
+
+
+#include <stdint.h>
+#include <gtest/gtest.h>
+#include <OTV0p2Base.h>
+#include "OTV0P2BASE_WakeProfile.h"
+
+
+// Awake time is split by the latest mark; sleep and wakeups are counted separately.
+TEST(WakeProfile,attribution)
+{
+    namespace WPS = OTV0P2BASE::WakeProfileSubsystem;
+    OTV0P2BASE::WakeTimeProfile<8> p(1000);
+    // Boot until cycle 1100, then the sleep loop.
+    p.mark(WPS::SLEEP_LOOP, 1100);
+    p.sleep(1150);
+    p.wake(2000);
+    p.mark(WPS::SENSORS, 2010);
+    p.mark(WPS::MAIN, 2050);
+    p.mark(WPS::SLEEP_LOOP, 2060);
+    p.sleep(2070);
+    // Out-of-range subsystems go to the last slot.
+    p.wake(3000);
+    p.mark(200, 3000);
+    p.advance(3100);
+    EXPECT_EQ(100U, p.getAwakeCycles(WPS::BOOT));
+    EXPECT_EQ(50U + 10 + 10, p.getAwakeCycles(WPS::SLEEP_LOOP));
+    EXPECT_EQ(40U, p.getAwakeCycles(WPS::SENSORS));
+    EXPECT_EQ(10U, p.getAwakeCycles(WPS::MAIN));
+    EXPECT_EQ(100U, p.getAwakeCycles(7));
+    EXPECT_EQ(100U, p.getAwakeCycles(99));
+    EXPECT_EQ(850U + 930, p.getSleepCycles());
+    EXPECT_EQ(2U, p.getWakeups());
+    EXPECT_EQ(2100U, p.getElapsedCycles());
+    EXPECT_EQ(p.getElapsedCycles(), p.getTotalAwakeCycles() + p.getSleepCycles());
+    // Time going backwards is ignored.
+    p.advance(3050);
+    EXPECT_EQ(2100U, p.getElapsedCycles());
+    // A wake without a preceding sleep is not a wakeup.
+    p.wake(3100);
+    EXPECT_EQ(2U, p.getWakeups());
+}
+
+// Scaling to per-hour figures.
+TEST(WakeProfile,perHour)
+{
+    OTV0P2BASE::WakeTimeProfile<4> p;
+    EXPECT_EQ(0, p.perHour(1, 1000000));
+    EXPECT_EQ(0, p.dutyCycle());
+    // 1s at 1MHz: 1000 cycles in MAIN, rest asleep.
+    p.mark(OTV0P2BASE::WakeProfileSubsystem::MAIN, 0);
+    p.sleep(1000);
+    p.wake(1000000);
+    EXPECT_DOUBLE_EQ(3600.0 * 1000, p.awakeCyclesPerHour(OTV0P2BASE::WakeProfileSubsystem::MAIN, 1000000));
+    EXPECT_DOUBLE_EQ(3600.0, p.perHour(p.getWakeups(), 1000000));
+    EXPECT_DOUBLE_EQ(0.001, p.dutyCycle());
+}